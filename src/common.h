@@ -10,11 +10,14 @@
 #include "common/ansicc.h"
 #include "common/args.h"
 #include "common/ascii.h"
+#include "common/atomic.h"
 #include "common/bitops.h"
 #include "common/id.h"
 #include "common/inline.h"
 #include "common/pragma.h"
+#include "common/prefetch.h"
 #include "common/static_assert.h"
+#include "common/thread_local.h"
 #include "common/types.h"
 #include "common/units.h"
 #include "common/version.h"
@@ -0,0 +1,546 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file common/atomic.h
+ * @brief Functions and preprocessor bindings which implement atomic operations
+ * and memory fences on 32-bit values, 64-bit values and pointers.
+ * 
+ * Implemented with the GNU C __atomic builtins (GCC, clang) or with MSVC
+ * intrinsics, as selected by platform/detect.h. The MSVC implementation
+ * assumes an x86 target, where every interlocked operation is a full barrier.
+ */
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include "common/inline.h"
+#include "common/types.h"
+
+#include "platform/detect.h"
+
+#if PLATFORM_COMPILER_MSVC == 1
+    #include <intrin.h>
+#endif
+
+/**
+ * @brief Size (in bytes) of the unit of memory kept coherent between cores.
+ * Data written by different threads should be at least this far apart to
+ * avoid false sharing.
+ */
+#if PLATFORM_APPLE == 1 && PLATFORM_ARCH_ARM == 1
+    #define CACHE_LINE_SIZE 128
+#else
+    #define CACHE_LINE_SIZE 64
+#endif
+
+/** @brief Type and instance definitions for memory orders. */
+#if PLATFORM_COMPILER_MSVC == 1
+typedef enum
+{
+    ATOMIC_RELAXED
+,   ATOMIC_ACQUIRE
+,   ATOMIC_RELEASE
+,   ATOMIC_ACQ_REL
+,   ATOMIC_SEQ_CST
+}
+ATOMIC_ORDER;
+#else
+typedef enum
+{
+    ATOMIC_RELAXED = __ATOMIC_RELAXED
+,   ATOMIC_ACQUIRE = __ATOMIC_ACQUIRE
+,   ATOMIC_RELEASE = __ATOMIC_RELEASE
+,   ATOMIC_ACQ_REL = __ATOMIC_ACQ_REL
+,   ATOMIC_SEQ_CST = __ATOMIC_SEQ_CST
+}
+ATOMIC_ORDER;
+#endif
+
+/**
+ * @brief Hints to the processor that the calling thread is spinning in a
+ * busy-wait loop (x86 pause, ARM yield).
+ */
+INLINE
+void
+atomic_pause
+( void )
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    #if PLATFORM_ARCH_ARM == 1
+        __yield ();
+    #else
+        _mm_pause ();
+    #endif
+#else
+    #if PLATFORM_ARCH_X86 == 1
+        __builtin_ia32_pause ();
+    #elif PLATFORM_ARCH_ARM == 1
+        __asm__ __volatile__ ( "yield" );
+    #endif
+#endif
+}
+
+/**
+ * @brief Issues a memory fence.
+ * 
+ * @param order The memory order to enforce.
+ */
+INLINE
+void
+atomic_fence
+(   const ATOMIC_ORDER order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    if ( order == ATOMIC_SEQ_CST )
+    {
+        _mm_mfence ();
+    }
+    else
+    {
+        _ReadWriteBarrier ();
+    }
+#else
+    __atomic_thread_fence ( order );
+#endif
+}
+
+/**
+ * @brief Atomically reads a 32-bit value.
+ * 
+ * @param x The value to read. Must be non-zero.
+ * @param order The memory order (ATOMIC_RELAXED, ATOMIC_ACQUIRE or
+ * ATOMIC_SEQ_CST).
+ * @return *x.
+ */
+INLINE
+u32
+atomic_load_u32
+(   const u32*          x
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    const u32 value = *( ( const volatile u32* ) x );
+    _ReadWriteBarrier ();
+    return value;
+#else
+    return __atomic_load_n ( x , order );
+#endif
+}
+
+/**
+ * @brief Atomically writes a 32-bit value.
+ * 
+ * @param x The value to write to. Must be non-zero.
+ * @param value The value to write.
+ * @param order The memory order (ATOMIC_RELAXED, ATOMIC_RELEASE or
+ * ATOMIC_SEQ_CST).
+ */
+INLINE
+void
+atomic_store_u32
+(   u32*                x
+,   const u32           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    if ( order == ATOMIC_SEQ_CST )
+    {
+        _InterlockedExchange ( ( volatile long* ) x , ( long ) value );
+    }
+    else
+    {
+        _ReadWriteBarrier ();
+        *( ( volatile u32* ) x ) = value;
+    }
+#else
+    __atomic_store_n ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically replaces a 32-bit value.
+ * 
+ * @param x The value to replace. Must be non-zero.
+ * @param value The replacement value.
+ * @param order The memory order.
+ * @return The previous value of *x.
+ */
+INLINE
+u32
+atomic_exchange_u32
+(   u32*                x
+,   const u32           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    return ( u32 ) _InterlockedExchange ( ( volatile long* ) x , ( long ) value );
+#else
+    return __atomic_exchange_n ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically replaces a 32-bit value if it holds an expected value.
+ * 
+ * @param x The value to replace. Must be non-zero.
+ * @param expected The expected value. Must be non-zero. On failure, it is
+ * overwritten with the value actually held by *x.
+ * @param desired The replacement value.
+ * @param success The memory order if the value is replaced.
+ * @param failure The memory order if the value is not replaced (no stronger
+ * than success; may not be ATOMIC_RELEASE or ATOMIC_ACQ_REL).
+ * @return true if *x was replaced; false otherwise.
+ */
+INLINE
+bool
+atomic_compare_exchange_u32
+(   u32*                x
+,   u32*                expected
+,   const u32           desired
+,   const ATOMIC_ORDER  success
+,   const ATOMIC_ORDER  failure
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    const u32 previous = ( u32 ) _InterlockedCompareExchange ( ( volatile long* ) x
+                                                             , ( long ) desired
+                                                             , ( long )( *expected )
+                                                             );
+    if ( previous == *expected )
+    {
+        return true;
+    }
+    *expected = previous;
+    return false;
+#else
+    return __atomic_compare_exchange_n ( x , expected , desired , false , success , failure );
+#endif
+}
+
+/**
+ * @brief Atomically adds to a 32-bit value.
+ * 
+ * @param x The value to add to. Must be non-zero.
+ * @param value The amount to add.
+ * @param order The memory order.
+ * @return The previous value of *x.
+ */
+INLINE
+u32
+atomic_fetch_add_u32
+(   u32*                x
+,   const u32           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    return ( u32 ) _InterlockedExchangeAdd ( ( volatile long* ) x , ( long ) value );
+#else
+    return __atomic_fetch_add ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically subtracts from a 32-bit value.
+ * 
+ * @param x The value to subtract from. Must be non-zero.
+ * @param value The amount to subtract.
+ * @param order The memory order.
+ * @return The previous value of *x.
+ */
+INLINE
+u32
+atomic_fetch_sub_u32
+(   u32*                x
+,   const u32           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    return ( u32 ) _InterlockedExchangeAdd ( ( volatile long* ) x , -( ( long ) value ) );
+#else
+    return __atomic_fetch_sub ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically reads a 64-bit value.
+ * 
+ * @param x The value to read. Must be non-zero.
+ * @param order The memory order (ATOMIC_RELAXED, ATOMIC_ACQUIRE or
+ * ATOMIC_SEQ_CST).
+ * @return *x.
+ */
+INLINE
+u64
+atomic_load_u64
+(   const u64*          x
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    const u64 value = *( ( const volatile u64* ) x );
+    _ReadWriteBarrier ();
+    return value;
+#else
+    return __atomic_load_n ( x , order );
+#endif
+}
+
+/**
+ * @brief Atomically writes a 64-bit value.
+ * 
+ * @param x The value to write to. Must be non-zero.
+ * @param value The value to write.
+ * @param order The memory order (ATOMIC_RELAXED, ATOMIC_RELEASE or
+ * ATOMIC_SEQ_CST).
+ */
+INLINE
+void
+atomic_store_u64
+(   u64*                x
+,   const u64           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    if ( order == ATOMIC_SEQ_CST )
+    {
+        _InterlockedExchange64 ( ( volatile __int64* ) x , ( __int64 ) value );
+    }
+    else
+    {
+        _ReadWriteBarrier ();
+        *( ( volatile u64* ) x ) = value;
+    }
+#else
+    __atomic_store_n ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically replaces a 64-bit value.
+ * 
+ * @param x The value to replace. Must be non-zero.
+ * @param value The replacement value.
+ * @param order The memory order.
+ * @return The previous value of *x.
+ */
+INLINE
+u64
+atomic_exchange_u64
+(   u64*                x
+,   const u64           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    return ( u64 ) _InterlockedExchange64 ( ( volatile __int64* ) x , ( __int64 ) value );
+#else
+    return __atomic_exchange_n ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically replaces a 64-bit value if it holds an expected value.
+ * 
+ * @param x The value to replace. Must be non-zero.
+ * @param expected The expected value. Must be non-zero. On failure, it is
+ * overwritten with the value actually held by *x.
+ * @param desired The replacement value.
+ * @param success The memory order if the value is replaced.
+ * @param failure The memory order if the value is not replaced (no stronger
+ * than success; may not be ATOMIC_RELEASE or ATOMIC_ACQ_REL).
+ * @return true if *x was replaced; false otherwise.
+ */
+INLINE
+bool
+atomic_compare_exchange_u64
+(   u64*                x
+,   u64*                expected
+,   const u64           desired
+,   const ATOMIC_ORDER  success
+,   const ATOMIC_ORDER  failure
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    const u64 previous = ( u64 ) _InterlockedCompareExchange64 ( ( volatile __int64* ) x
+                                                               , ( __int64 ) desired
+                                                               , ( __int64 )( *expected )
+                                                               );
+    if ( previous == *expected )
+    {
+        return true;
+    }
+    *expected = previous;
+    return false;
+#else
+    return __atomic_compare_exchange_n ( x , expected , desired , false , success , failure );
+#endif
+}
+
+/**
+ * @brief Atomically adds to a 64-bit value.
+ * 
+ * @param x The value to add to. Must be non-zero.
+ * @param value The amount to add.
+ * @param order The memory order.
+ * @return The previous value of *x.
+ */
+INLINE
+u64
+atomic_fetch_add_u64
+(   u64*                x
+,   const u64           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    return ( u64 ) _InterlockedExchangeAdd64 ( ( volatile __int64* ) x , ( __int64 ) value );
+#else
+    return __atomic_fetch_add ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically subtracts from a 64-bit value.
+ * 
+ * @param x The value to subtract from. Must be non-zero.
+ * @param value The amount to subtract.
+ * @param order The memory order.
+ * @return The previous value of *x.
+ */
+INLINE
+u64
+atomic_fetch_sub_u64
+(   u64*                x
+,   const u64           value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    return ( u64 ) _InterlockedExchangeAdd64 ( ( volatile __int64* ) x , -( ( __int64 ) value ) );
+#else
+    return __atomic_fetch_sub ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically reads a pointer.
+ * 
+ * @param x The pointer to read. Must be non-zero.
+ * @param order The memory order (ATOMIC_RELAXED, ATOMIC_ACQUIRE or
+ * ATOMIC_SEQ_CST).
+ * @return *x.
+ */
+INLINE
+void*
+atomic_load_ptr
+(   void* const*        x
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    void* const value = *( ( void* const volatile* ) x );
+    _ReadWriteBarrier ();
+    return value;
+#else
+    return __atomic_load_n ( x , order );
+#endif
+}
+
+/**
+ * @brief Atomically writes a pointer.
+ * 
+ * @param x The pointer to write to. Must be non-zero.
+ * @param value The value to write.
+ * @param order The memory order (ATOMIC_RELAXED, ATOMIC_RELEASE or
+ * ATOMIC_SEQ_CST).
+ */
+INLINE
+void
+atomic_store_ptr
+(   void**              x
+,   void*               value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    if ( order == ATOMIC_SEQ_CST )
+    {
+        _InterlockedExchangePointer ( ( void* volatile* ) x , value );
+    }
+    else
+    {
+        _ReadWriteBarrier ();
+        *( ( void* volatile* ) x ) = value;
+    }
+#else
+    __atomic_store_n ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically replaces a pointer.
+ * 
+ * @param x The pointer to replace. Must be non-zero.
+ * @param value The replacement value.
+ * @param order The memory order.
+ * @return The previous value of *x.
+ */
+INLINE
+void*
+atomic_exchange_ptr
+(   void**              x
+,   void*               value
+,   const ATOMIC_ORDER  order
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    return _InterlockedExchangePointer ( ( void* volatile* ) x , value );
+#else
+    return __atomic_exchange_n ( x , value , order );
+#endif
+}
+
+/**
+ * @brief Atomically replaces a pointer if it holds an expected value.
+ * 
+ * @param x The pointer to replace. Must be non-zero.
+ * @param expected The expected value. Must be non-zero. On failure, it is
+ * overwritten with the value actually held by *x.
+ * @param desired The replacement value.
+ * @param success The memory order if the value is replaced.
+ * @param failure The memory order if the value is not replaced (no stronger
+ * than success; may not be ATOMIC_RELEASE or ATOMIC_ACQ_REL).
+ * @return true if *x was replaced; false otherwise.
+ */
+INLINE
+bool
+atomic_compare_exchange_ptr
+(   void**              x
+,   void**              expected
+,   void*               desired
+,   const ATOMIC_ORDER  success
+,   const ATOMIC_ORDER  failure
+)
+{
+#if PLATFORM_COMPILER_MSVC == 1
+    void* const previous = _InterlockedCompareExchangePointer ( ( void* volatile* ) x
+                                                              , desired
+                                                              , *expected
+                                                              );
+    if ( previous == *expected )
+    {
+        return true;
+    }
+    *expected = previous;
+    return false;
+#else
+    return __atomic_compare_exchange_n ( x , expected , desired , false , success , failure );
+#endif
+}
+
+#endif  // ATOMIC_H
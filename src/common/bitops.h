@@ -10,6 +10,10 @@
 #include "common/inline.h"
 #include "common/types.h"
 
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
 // Internal preprocessor bindings.
 // Use inline functions instead for type safety.
 
@@ -87,4 +91,131 @@ bitswp
     return BITSWP ( x , n );
 }
 
+/**
+ * @brief Computes the index of the least significant set bit of a 64-bit
+ * value.
+ * 
+ * @param x A 64-bit value. Must be non-zero.
+ * @return The index of the least significant set bit of x.
+ */
+INLINE
+u8
+bitscan_forward
+(   const u64 x
+)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64 ( &index , x );
+    return ( u8 ) index;
+#else
+    return ( u8 ) __builtin_ctzll ( x );
+#endif
+}
+
+/**
+ * @brief Computes the index of the most significant set bit of a 64-bit value
+ * (i.e. floor ( log2 ( x ) ) ).
+ * 
+ * @param x A 64-bit value. Must be non-zero.
+ * @return The index of the most significant set bit of x.
+ */
+INLINE
+u8
+bitscan_reverse
+(   const u64 x
+)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64 ( &index , x );
+    return ( u8 ) index;
+#else
+    return ( u8 )( 63 - __builtin_clzll ( x ) );
+#endif
+}
+
+/**
+ * @brief Counts the set bits of a 64-bit value.
+ * 
+ * Uses the hardware instruction where the target guarantees one; otherwise a
+ * branch-free SWAR reduction (rather than the libgcc table lookup).
+ * 
+ * @param x A 64-bit value.
+ * @return The number of set bits in x.
+ */
+INLINE
+u8
+popcount64
+(   u64 x
+)
+{
+#ifdef _MSC_VER
+    return ( u8 ) __popcnt64 ( x );
+#elif defined ( __POPCNT__ ) || defined ( __aarch64__ )
+    return ( u8 ) __builtin_popcountll ( x );
+#else
+    x = x - ( ( x >> 1 ) & 0x5555555555555555ULL );
+    x = ( x & 0x3333333333333333ULL ) + ( ( x >> 2 ) & 0x3333333333333333ULL );
+    x = ( x + ( x >> 4 ) ) & 0x0F0F0F0F0F0F0F0FULL;
+    return ( u8 )( ( x * 0x0101010101010101ULL ) >> 56 );
+#endif
+}
+
+/**
+ * @brief Rotates the bits of a 64-bit value left.
+ * 
+ * @param x A 64-bit value.
+ * @param n The number of bits to rotate by. Must be less than 64.
+ * @return x rotated left by n bits.
+ */
+INLINE
+u64
+rotl64
+(   const u64   x
+,   const u8    n
+)
+{
+    return ( x << n ) | ( x >> ( ( 64 - n ) & 63 ) );
+}
+
+/**
+ * @brief Rotates the bits of a 64-bit value right.
+ * 
+ * @param x A 64-bit value.
+ * @param n The number of bits to rotate by. Must be less than 64.
+ * @return x rotated right by n bits.
+ */
+INLINE
+u64
+rotr64
+(   const u64   x
+,   const u8    n
+)
+{
+    return ( x >> n ) | ( x << ( ( 64 - n ) & 63 ) );
+}
+
+/**
+ * @brief Computes the upper 64 bits of the full 128-bit product of two 64-bit
+ * values.
+ * 
+ * @param x A 64-bit value.
+ * @param y A 64-bit value.
+ * @return ( x * y ) >> 64.
+ */
+INLINE
+u64
+mulhi64
+(   const u64 x
+,   const u64 y
+)
+{
+#ifdef _MSC_VER
+    return __umulh ( x , y );
+#else
+    return ( u64 )( ( ( unsigned __int128 ) x * y ) >> 64 );
+#endif
+}
+
 #endif  // BITOPS_H
\ No newline at end of file
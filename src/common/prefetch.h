@@ -0,0 +1,35 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file common/prefetch.h
+ * @brief Preprocessor bindings to implement software prefetching.
+ * 
+ * A prefetch hints that the cache line containing an address will soon be
+ * read (PREFETCH) or written (PREFETCH_WRITE), so that the memory access may
+ * overlap with other work. It never faults, and may be ignored.
+ */
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include "platform/detect.h"
+
+#if PLATFORM_COMPILER_MSVC == 1
+    #include <intrin.h>
+    #if PLATFORM_ARCH_X86 == 1
+        #define PREFETCH(address) \
+            _mm_prefetch ( ( const char* )( address ) , _MM_HINT_T0 )
+        #define PREFETCH_WRITE(address) \
+            _m_prefetchw ( ( const void* )( address ) )
+    #else
+        #define PREFETCH(address) \
+            __prefetch ( ( const void* )( address ) )
+        #define PREFETCH_WRITE(address) \
+            __prefetchw ( ( const void* )( address ) )
+    #endif
+#else
+    #define PREFETCH(address) \
+        __builtin_prefetch ( ( address ) , 0 , 3 )
+    #define PREFETCH_WRITE(address) \
+        __builtin_prefetch ( ( address ) , 1 , 3 )
+#endif
+
+#endif  // PREFETCH_H
\ No newline at end of file
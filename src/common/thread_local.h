@@ -0,0 +1,15 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file common/thread_local.h
+ * @brief Preprocessor binding to implement thread-local storage.
+ */
+#ifndef THREAD_LOCAL_H
+#define THREAD_LOCAL_H
+
+#ifdef _MSC_VER
+    #define THREAD_LOCAL    __declspec ( thread )
+#else
+    #define THREAD_LOCAL    __thread
+#endif
+
+#endif  // THREAD_LOCAL_H
\ No newline at end of file
@@ -6,11 +6,23 @@
  */
 #include "container/array.h"
 
+#include "core/image.h"
 #include "core/logger.h"
 #include "core/memory.h"
 
 #include "math/math.h"
 
+/** @brief Version of the resizable array image layout (see array_to_image). */
+#define ARRAY_IMAGE_VERSION 1
+
+/** @brief Type and instance definitions for resizable array image parameters. */
+typedef enum
+{
+    ARRAY_IMAGE_STRIDE
+,   ARRAY_IMAGE_LENGTH
+}
+ARRAY_IMAGE_PARAMETER;
+
 array_t*
 _array_create
 (   ARRAY_FIELD initial_capacity
@@ -35,7 +47,6 @@ _array_create
     const u64 size = header_size + content_size;
 
     u64* array = memory_allocate ( size , MEMORY_TAG_ARRAY );
-    memory_clear ( array , size );
 
     array[ ARRAY_FIELD_CAPACITY ] = initial_capacity;
     array[ ARRAY_FIELD_LENGTH ]   = 0;
@@ -73,6 +84,105 @@ _array_create_from
     return array;
 }
 
+const array_t*
+_array_create_from_image
+(   const void* image
+,   u64         size
+,   ARRAY_FIELD stride
+,   bool        verify
+)
+{
+    if ( ( ( u64 ) image ) % 8 )
+    {
+        LOGERROR ( "_array_create_from_image: Image must be 8-byte aligned." );
+        return 0;
+    }
+
+    const image_header_t* header = image_header_read ( "_array_create_from_image"
+                                                     , image
+                                                     , size
+                                                     , IMAGE_TYPE_ARRAY
+                                                     , ARRAY_IMAGE_VERSION
+                                                     , verify
+                                                     );
+    if ( !header )
+    {
+        return 0;
+    }
+
+    const u64* parameters = ( *header ).parameters;
+    if ( parameters[ ARRAY_IMAGE_STRIDE ] != stride )
+    {
+        LOGERROR ( "_array_create_from_image: Expected elements of %u bytes, but the image holds elements of %u bytes."
+                 , stride , parameters[ ARRAY_IMAGE_STRIDE ]
+                 );
+        return 0;
+    }
+
+    // The payload is the array header followed by its content.
+    const u64 available = ( *header ).size - IMAGE_HEADER_SIZE;
+    const u64 header_size = ARRAY_FIELD_COUNT * sizeof ( u64 );
+    const u64* array = ( const u64* )( ( ( u64 ) image ) + IMAGE_HEADER_SIZE );
+    if ( !stride
+         || available < header_size
+         || parameters[ ARRAY_IMAGE_LENGTH ] > ( available - header_size ) / stride
+         || array[ ARRAY_FIELD_LENGTH ] != parameters[ ARRAY_IMAGE_LENGTH ]
+         || array[ ARRAY_FIELD_STRIDE ] != stride
+       )
+    {
+        LOGERROR ( "_array_create_from_image: Image is malformed." );
+        return 0;
+    }
+    return array + ARRAY_FIELD_COUNT;
+}
+
+bool
+array_to_image
+(   const array_t*  array
+,   u64*            image_size
+,   void*           image
+)
+{
+    if ( !image_size )
+    {
+        LOGERROR ( "array_to_image: Missing argument: image_size (output buffer)." );
+        return false;
+    }
+
+    const u64 length = array_length ( array );
+    const u64 stride = array_stride ( array );
+    const u64 header_size = ARRAY_FIELD_COUNT * sizeof ( u64 );
+    const u64 size = IMAGE_HEADER_SIZE + header_size + length * stride;
+    *image_size = size;
+    if ( !image )
+    {
+        return true;
+    }
+    if ( ( ( u64 ) image ) % 8 )
+    {
+        LOGERROR ( "array_to_image: Image must be 8-byte aligned." );
+        return false;
+    }
+
+    // The array is written with no spare capacity.
+    u64* dst = ( u64* )( ( ( u64 ) image ) + IMAGE_HEADER_SIZE );
+    dst[ ARRAY_FIELD_CAPACITY ] = length;
+    dst[ ARRAY_FIELD_LENGTH ]   = length;
+    dst[ ARRAY_FIELD_STRIDE ]   = stride;
+    memory_copy ( dst + ARRAY_FIELD_COUNT , array , length * stride );
+
+    u64 parameters[ IMAGE_PARAMETER_COUNT ] = { 0 };
+    parameters[ ARRAY_IMAGE_STRIDE ] = stride;
+    parameters[ ARRAY_IMAGE_LENGTH ] = length;
+    image_header_write ( IMAGE_TYPE_ARRAY
+                       , ARRAY_IMAGE_VERSION
+                       , parameters
+                       , size
+                       , image
+                       );
+    return true;
+}
+
 array_t*
 __array_copy
 (   const array_t* src
@@ -133,12 +243,18 @@ _array_resize
 
     const u64 length = MIN ( array_length ( old_array ) , minimum_capacity );
     const u64 stride = array_stride ( old_array );
+    const u64 header_size = ARRAY_FIELD_COUNT * sizeof ( u64 );
 
-    void* new_array = _array_create ( minimum_capacity , stride );
-    memory_copy ( new_array , old_array , length * stride );
-    _array_field_set ( new_array , ARRAY_FIELD_LENGTH , length );
-    _array_destroy ( old_array );
-    return new_array;
+    // Grows (or shrinks) in place where the memory subsystem can; otherwise,
+    // the header and content are moved to a new block.
+    u64* array = memory_reallocate ( ( ( u64* ) old_array ) - ARRAY_FIELD_COUNT
+                                   , array_size ( old_array )
+                                   , header_size + minimum_capacity * stride
+                                   , MEMORY_TAG_ARRAY
+                                   );
+    array[ ARRAY_FIELD_CAPACITY ] = minimum_capacity;
+    array[ ARRAY_FIELD_LENGTH ]   = length;
+    return array + ARRAY_FIELD_COUNT;
 }
 
 array_t*
@@ -253,4 +369,229 @@ _array_remove
                 );
     _array_field_set ( array , ARRAY_FIELD_LENGTH , length );
     return array;
+}
+
+array_t*
+_array_remove_swap
+(   array_t*    array
+,   u64         index
+,   void*       dst
+)
+{
+    if ( !array_length ( array ) )
+    {
+        LOGWARN ( "_array_remove_swap: Array is empty." );
+        return array;
+    }
+
+    const u64 length = array_length ( array ) - 1;
+    const u64 stride = array_stride ( array );
+
+    if ( index > length )
+    {
+        LOGERROR ( "_array_remove_swap: Called with out of bounds index: %i (index) >= %i (array length)."
+                 , index , length + 1
+                 );
+        return array;
+    }
+
+    const u64 src = ( ( u64 ) array );
+    if ( dst )
+    {
+        memory_copy ( dst , ( void* )( src + index * stride ) , stride );
+    }
+    if ( index != length )
+    {
+        memory_copy ( ( void* )( src + index * stride )
+                    , ( void* )( src + length * stride )
+                    , stride
+                    );
+    }
+    _array_field_set ( array , ARRAY_FIELD_LENGTH , length );
+    return array;
+}
+
+u64
+_array_remove_if
+(   array_t*                    array
+,   array_predicate_function_t  predicate
+,   void*                       args
+)
+{
+    if ( !predicate )
+    {
+        LOGERROR ( "_array_remove_if: Missing argument: predicate." );
+        return 0;
+    }
+
+    const u64 length = array_length ( array );
+    const u64 stride = array_stride ( array );
+    u8* const elements = array;
+
+    // Each run of kept elements is moved down in one piece, once the next
+    // removed element (or the end of the array) terminates it.
+    u64 write = 0;
+    u64 run = 0;
+    for ( u64 read = 0; read < length; ++read )
+    {
+        if ( !predicate ( elements + read * stride , args ) )
+        {
+            continue;
+        }
+        if ( read > run && write != run )
+        {
+            memory_move ( elements + write * stride
+                        , elements + run * stride
+                        , ( read - run ) * stride
+                        );
+        }
+        write += read - run;
+        run = read + 1;
+    }
+    if ( length > run && write != run )
+    {
+        memory_move ( elements + write * stride
+                    , elements + run * stride
+                    , ( length - run ) * stride
+                    );
+    }
+    write += length - run;
+
+    _array_field_set ( array , ARRAY_FIELD_LENGTH , write );
+    return length - write;
+}
+
+array_t*
+_array_reserve
+(   array_t*    array
+,   ARRAY_FIELD capacity
+)
+{
+    if ( capacity <= array_capacity ( array ) )
+    {
+        return array;
+    }
+    return _array_resize ( array , capacity );
+}
+
+array_t*
+_array_push_n
+(   array_t*    array
+,   const void* src
+,   u64         count
+)
+{
+    if ( !count )
+    {
+        return array;
+    }
+
+    const u64 length = array_length ( array );
+    const u64 stride = array_stride ( array );
+
+    if ( length + count > array_capacity ( array ) )
+    {
+        array = array_resize ( array , length + count );
+    }
+
+    const u64 dst = ( ( u64 ) array ) + length * stride;
+    memory_copy ( ( void* ) dst , src , count * stride );
+    _array_field_set ( array , ARRAY_FIELD_LENGTH , length + count );
+    return array;
+}
+
+array_t*
+_array_extend_from
+(   array_t*        array
+,   const array_t*  src
+)
+{
+    if ( array_stride ( src ) != array_stride ( array ) )
+    {
+        LOGERROR ( "_array_extend_from: Stride mismatch: %i (src stride) != %i (array stride)."
+                 , array_stride ( src ) , array_stride ( array )
+                 );
+        return array;
+    }
+
+    if ( src != array )
+    {
+        return _array_push_n ( array , src , array_length ( src ) );
+    }
+
+    // Self-extension: src may move when the array grows, so grow first.
+    const u64 length = array_length ( array );
+    array = _array_reserve ( array , length << 1 );
+    return _array_push_n ( array , array , length );
+}
+
+array_t*
+_array_insert_n
+(   array_t*    array
+,   u64         index
+,   const void* src
+,   u64         count
+)
+{
+    const u64 length = array_length ( array );
+    const u64 stride = array_stride ( array );
+
+    if ( index > length )
+    {
+        LOGERROR ( "_array_insert_n: Called with out of bounds index: %i (index) > %i (array length)."
+                 , index , length
+                 );
+        return array;
+    }
+
+    if ( !count )
+    {
+        return array;
+    }
+
+    if ( length + count > array_capacity ( array ) )
+    {
+        array = array_resize ( array , length + count );
+    }
+
+    const u64 dst = ( ( u64 ) array );
+    memory_move ( ( void* )( dst + ( index + count ) * stride )
+                , ( void* )( dst + index * stride )
+                , ( length - index ) * stride
+                );
+    memory_copy ( ( void* )( dst + index * stride ) , src , count * stride );
+    _array_field_set ( array , ARRAY_FIELD_LENGTH , length + count );
+    return array;
+}
+
+array_t*
+_array_remove_range
+(   array_t*    array
+,   u64         index
+,   u64         count
+,   void*       dst
+)
+{
+    const u64 length = array_length ( array );
+    const u64 stride = array_stride ( array );
+
+    if ( index > length || count > length - index )
+    {
+        LOGERROR ( "_array_remove_range: Called with illegal index or count: (index %i + count %i) > %i (array length)."
+                 , index , count , length
+                 );
+        return array;
+    }
+
+    const u64 src = ( ( u64 ) array );
+    if ( dst )
+    {
+        memory_copy ( dst , ( void* )( src + index * stride ) , count * stride );
+    }
+    memory_move ( ( void* )( src + index * stride )
+                , ( void* )( src + ( index + count ) * stride )
+                , ( length - index - count ) * stride
+                );
+    _array_field_set ( array , ARRAY_FIELD_LENGTH , length - count );
+    return array;
 }
\ No newline at end of file
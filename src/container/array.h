@@ -7,6 +7,7 @@
 #define ARRAY_H
 
 #include "core/array.h"
+#include "core/hash.h"
 
 /** @brief Type declaration for a resizable array. */
 typedef void array_t;
@@ -22,6 +23,16 @@ typedef enum
 }
 ARRAY_FIELD;
 
+/**
+ * @brief Type definition for an 'array predicate' callback function (see
+ * array_remove_if).
+ *
+ * @param element The address of an array element.
+ * @param args Internal state arguments.
+ * @return true to remove the element; false to keep it.
+ */
+typedef bool ( *array_predicate_function_t )( const void* element , void* args );
+
 /** @brief Array default capacity. */
 #define ARRAY_DEFAULT_CAPACITY 10
 
@@ -77,6 +88,61 @@ _array_create_from
 #define array_create_from(type,array,length) \
     _array_create_from ( (array) , (length) , sizeof ( type ) )
 
+/**
+ * @brief Obtains a resizable array from an image in place (see array_to_image
+ * and core/image.h), e.g. one within a memory-mapped file, instead of copying
+ * it. O(1), or O(n) if verifying the image.
+ * 
+ * Performs no memory allocation: the array is a read-only view into the
+ * image, valid until the image is freed (or unmapped). It must not be passed
+ * to array_destroy, or to any function which mutates the array.
+ * 
+ * @param image The image. Must be 8-byte aligned.
+ * @param size The number of bytes available at image (e.g. the size of the
+ * mapped file).
+ * @param stride The fixed element size in bytes. Must match the image.
+ * @param verify Verify the checksum of the whole image? Y/N (if not, only the
+ * header is checked, and no page of the image beyond the first is read until
+ * the array is accessed)
+ * @return The array, or 0 if the image is invalid or damaged.
+ */
+const array_t*
+_array_create_from_image
+(   const void* image
+,   u64         size
+,   ARRAY_FIELD stride
+,   bool        verify
+);
+
+/** @param type C data type of the array. */
+#define array_create_from_image(type,image,size,verify) \
+    _array_create_from_image ( (image) , (size) , sizeof ( type ) , (verify) )
+
+/**
+ * @brief Writes a position-independent image of a resizable array, which may
+ * be saved to a file and later used in place (see _array_create_from_image).
+ * O(n).
+ * 
+ * Elements are written as raw bytes; an element which holds an address is
+ * therefore only meaningful in the process which wrote it.
+ * 
+ * Call once with image set to 0 to get the image size; call a second time
+ * passing in a buffer of that size.
+ * 
+ * @param array The resizable array to write. Must be non-zero.
+ * @param image_size Output buffer for the image size (in bytes). Must be
+ * non-zero.
+ * @param image Output buffer for the image. Must be 8-byte aligned, and hold
+ * at least image_size bytes. Pass 0 to read the image size.
+ * @return true on success; false otherwise.
+ */
+bool
+array_to_image
+(   const array_t*  array
+,   u64*            image_size
+,   void*           image
+);
+
 /**
  * @brief Frees the memory used by a resizable array.
  * 
@@ -239,6 +305,153 @@ _array_remove
 #define array_remove(array,index,dst) \
     _array_remove ( (array) , (index) , (dst) )
 
+/**
+ * @brief Removes an element from a resizable array at a specified index by
+ * moving the last element into its place. Does not preserve the order of the
+ * elements. O(1).
+ *
+ * @param array The resizable array to mutate. Must be non-zero.
+ * @param index The index of the element to remove.
+ * @param dst Output buffer to store the element that was removed. Pass 0 to
+ * retrieve nothing.
+ * @return The array.
+ */
+array_t*
+_array_remove_swap
+(   array_t*    array
+,   u64         index
+,   void*       dst
+);
+
+#define array_remove_swap(array,index,dst) \
+    _array_remove_swap ( (array) , (index) , (dst) )
+
+/**
+ * @brief Removes every element of a resizable array which satisfies a
+ * predicate, in a single pass. Preserves the order of the remaining elements.
+ * O(n).
+ *
+ * The predicate is called exactly once per element, in order.
+ *
+ * @param array The resizable array to mutate. Must be non-zero.
+ * @param predicate A function which returns true for each element to remove.
+ * Must be non-zero.
+ * @param args Internal state arguments passed to each predicate call.
+ * @return The number of elements removed.
+ */
+u64
+_array_remove_if
+(   array_t*                    array
+,   array_predicate_function_t  predicate
+,   void*                       args
+);
+
+#define array_remove_if(array,predicate,args) \
+    _array_remove_if ( (array) , (predicate) , (args) )
+
+/**
+ * @brief Reserves capacity in a resizable array for at least a specified
+ * number of elements. O(n) if the array grows; otherwise, O(1).
+ *
+ * Unlike array_resize, grows to exactly the requested capacity (no
+ * ARRAY_SCALE_FACTOR), and never shrinks the array. Call before a bulk load
+ * of known size, so that it costs one growth.
+ *
+ * @param array The resizable array to reserve space in. Must be non-zero.
+ * @param capacity The number of elements the array is required to hold.
+ * @return The array (possibly with new address).
+ */
+array_t*
+_array_reserve
+(   array_t*    array
+,   ARRAY_FIELD capacity
+);
+
+#define array_reserve(array,capacity) \
+    _array_reserve ( (array) , (capacity) )
+
+/**
+ * @brief Appends several elements to a resizable array, with at most one
+ * growth and one copy. O(n) in count, on average.
+ *
+ * @param array The resizable array to append to. Must be non-zero.
+ * @param src The elements to append. Must be non-zero if count is non-zero,
+ * and must not point into array.
+ * @param count The number of elements to append.
+ * @return The array (possibly with new address).
+ */
+array_t*
+_array_push_n
+(   array_t*    array
+,   const void* src
+,   u64         count
+);
+
+#define array_push_n(array,src,count) \
+    ( (array) = _array_push_n ( (array) , (src) , (count) ) )
+
+/**
+ * @brief Appends the contents of one resizable array to another, with at most
+ * one growth and one copy. O(n) in the length of src.
+ *
+ * @param array The resizable array to append to. Must be non-zero.
+ * @param src The resizable array to copy elements from. Must be non-zero, and
+ * have the same stride as array. May be array itself.
+ * @return The array (possibly with new address).
+ */
+array_t*
+_array_extend_from
+(   array_t*        array
+,   const array_t*  src
+);
+
+#define array_extend_from(array,src) \
+    ( (array) = _array_extend_from ( (array) , (src) ) )
+
+/**
+ * @brief Inserts several elements into a resizable array at a specified
+ * index, with at most one growth and one move of the elements after it. O(n).
+ *
+ * @param array The resizable array to insert into. Must be non-zero.
+ * @param index The index to insert at.
+ * @param src The elements to insert. Must be non-zero if count is non-zero,
+ * and must not point into array.
+ * @param count The number of elements to insert.
+ * @return The array (possibly with new address).
+ */
+array_t*
+_array_insert_n
+(   array_t*    array
+,   u64         index
+,   const void* src
+,   u64         count
+);
+
+#define array_insert_n(array,index,src,count) \
+    ( (array) = _array_insert_n ( (array) , (index) , (src) , (count) ) )
+
+/**
+ * @brief Removes a contiguous range of elements from a resizable array, with
+ * one move of the elements after it. O(n).
+ *
+ * @param array The resizable array to mutate. Must be non-zero.
+ * @param index The index of the first element to remove.
+ * @param count The number of elements to remove.
+ * @param dst Output buffer to store the count elements that were removed.
+ * Pass 0 to retrieve nothing.
+ * @return The array.
+ */
+array_t*
+_array_remove_range
+(   array_t*    array
+,   u64         index
+,   u64         count
+,   void*       dst
+);
+
+#define array_remove_range(array,index,count,dst) \
+    _array_remove_range ( (array) , (index) , (count) , (dst) )
+
 
 /**
  * @brief Copies a resizable array. O(n).
@@ -290,4 +503,192 @@ __array_copy
                , (comparator)           \
                )
 
+/**
+ * @brief Alias for calling array_sort_radix on a resizable array.
+ * (see core/array.h)
+ */
+#define _array_sort_radix(array,key_offset,key) \
+    array_sort_radix ( (array)                  \
+                     , array_length ( array )   \
+                     , array_stride ( array )   \
+                     , (key_offset)             \
+                     , (key)                    \
+                     )
+
+/**
+ * @brief Alias for calling array_sort_parallel on a resizable array.
+ * (see core/array.h)
+ */
+#define _array_sort_parallel(array,comparator)  \
+    array_sort_parallel ( (array)                \
+                        , array_length ( array ) \
+                        , array_stride ( array ) \
+                        , (comparator)           \
+                        )
+
+/**
+ * @brief Alias for calling hash64 on the contents of a resizable array.
+ * (see core/hash.h)
+ */
+#define _array_hash(array,seed)                                     \
+    ({                                                              \
+        const array_t* array__ = (array);                           \
+        hash64 ( array__                                            \
+               , array_length ( array__ ) * array_stride ( array__ ) \
+               , (seed)                                             \
+               );                                                   \
+    })
+
+/**
+ * @brief Defines inline functions for a resizable array of a specific element
+ * type (a typed array), e.g. ARRAY_DEFINE ( u64 ) at file scope.
+ *
+ * The generic functions read the stride from the header and copy elements with
+ * memory_copy; the typed functions know the element size at compile time, and
+ * copy elements by assignment, so that they may be inlined into (and
+ * vectorized with) the loops that call them. A typed array has the same header
+ * layout as any other resizable array, so it may be passed to the generic
+ * functions as well (e.g. array_destroy, _array_sort); only growth and errors
+ * are handled out of line, by the generic functions.
+ *
+ * ARRAY_DEFINE ( u64 ) defines:
+ *
+ *   u64* array_u64_create ( u64 initial_capacity );
+ *   u64  array_u64_length ( const u64* array );
+ *   u64  array_u64_capacity ( const u64* array );
+ *   u64* array_u64_reserve ( u64* array , u64 capacity );
+ *   u64* array_u64_push ( u64* array , u64 value );
+ *   bool array_u64_pop ( u64* array , u64* dst );
+ *   bool array_u64_remove_swap ( u64* array , u64 index , u64* dst );
+ *   void array_u64_clear ( u64* array );
+ *
+ * As with the generic functions, those which may grow the array return it
+ * (possibly with new address), and pop and remove_swap accept 0 for dst.
+ *
+ * @param type C data type of the elements. Must be a single identifier; use
+ * ARRAY_DEFINE_NAMED for any other type (e.g. a pointer type).
+ */
+#define ARRAY_DEFINE(type) \
+    ARRAY_DEFINE_NAMED ( type , type )
+
+/**
+ * @brief Variant of ARRAY_DEFINE which specifies the infix of the function
+ * names separately from the element type.
+ *
+ * @param name Infix of the function names (array_<name>_push, etc.).
+ * @param type C data type of the elements.
+ */
+#define ARRAY_DEFINE_NAMED(name,type)                                           \
+    INLINE type*                                                                \
+    array_##name##_create                                                       \
+    (   const u64 initial_capacity                                              \
+    )                                                                           \
+    {                                                                           \
+        return _array_create ( initial_capacity , sizeof ( type ) );            \
+    }                                                                           \
+                                                                                \
+    INLINE u64                                                                  \
+    array_##name##_length                                                       \
+    (   const type* array                                                       \
+    )                                                                           \
+    {                                                                           \
+        return ( ( const u64* ) array )[ ARRAY_FIELD_LENGTH                     \
+                                       - ARRAY_FIELD_COUNT                      \
+                                       ];                                       \
+    }                                                                           \
+                                                                                \
+    INLINE u64                                                                  \
+    array_##name##_capacity                                                     \
+    (   const type* array                                                       \
+    )                                                                           \
+    {                                                                           \
+        return ( ( const u64* ) array )[ ARRAY_FIELD_CAPACITY                   \
+                                       - ARRAY_FIELD_COUNT                      \
+                                       ];                                       \
+    }                                                                           \
+                                                                                \
+    INLINE type*                                                                \
+    array_##name##_reserve                                                      \
+    (   type*       array                                                       \
+    ,   const u64   capacity                                                    \
+    )                                                                           \
+    {                                                                           \
+        if ( capacity > array_##name##_capacity ( array ) )                     \
+        {                                                                       \
+            return _array_reserve ( array , capacity );                         \
+        }                                                                       \
+        return array;                                                           \
+    }                                                                           \
+                                                                                \
+    INLINE type*                                                                \
+    array_##name##_push                                                         \
+    (   type*       array                                                       \
+    ,   const type  value                                                       \
+    )                                                                           \
+    {                                                                           \
+        u64* header = ( ( u64* ) array ) - ARRAY_FIELD_COUNT;                   \
+        const u64 length = header[ ARRAY_FIELD_LENGTH ];                        \
+        if ( length >= header[ ARRAY_FIELD_CAPACITY ] )                         \
+        {                                                                       \
+            array = _array_resize ( array                                       \
+                                  , ARRAY_SCALE_FACTOR ( length + 1 )           \
+                                  );                                            \
+            header = ( ( u64* ) array ) - ARRAY_FIELD_COUNT;                    \
+        }                                                                       \
+        array[ length ] = value;                                                \
+        header[ ARRAY_FIELD_LENGTH ] = length + 1;                              \
+        return array;                                                           \
+    }                                                                           \
+                                                                                \
+    INLINE bool                                                                 \
+    array_##name##_pop                                                          \
+    (   type*   array                                                           \
+    ,   type*   dst                                                             \
+    )                                                                           \
+    {                                                                           \
+        u64* header = ( ( u64* ) array ) - ARRAY_FIELD_COUNT;                   \
+        if ( !header[ ARRAY_FIELD_LENGTH ] )                                    \
+        {                                                                       \
+            return _array_pop ( array , dst );                                  \
+        }                                                                       \
+        const u64 length = header[ ARRAY_FIELD_LENGTH ] - 1;                    \
+        if ( dst )                                                              \
+        {                                                                       \
+            *dst = array[ length ];                                             \
+        }                                                                       \
+        header[ ARRAY_FIELD_LENGTH ] = length;                                  \
+        return true;                                                            \
+    }                                                                           \
+                                                                                \
+    INLINE bool                                                                 \
+    array_##name##_remove_swap                                                  \
+    (   type*       array                                                       \
+    ,   const u64   index                                                       \
+    ,   type*       dst                                                         \
+    )                                                                           \
+    {                                                                           \
+        u64* header = ( ( u64* ) array ) - ARRAY_FIELD_COUNT;                   \
+        if ( index >= header[ ARRAY_FIELD_LENGTH ] )                            \
+        {                                                                       \
+            _array_remove_swap ( array , index , dst );                         \
+            return false;                                                       \
+        }                                                                       \
+        const u64 length = header[ ARRAY_FIELD_LENGTH ] - 1;                    \
+        if ( dst )                                                              \
+        {                                                                       \
+            *dst = array[ index ];                                              \
+        }                                                                       \
+        array[ index ] = array[ length ];                                       \
+        header[ ARRAY_FIELD_LENGTH ] = length;                                  \
+        return true;                                                            \
+    }                                                                           \
+                                                                                \
+    INLINE void                                                                 \
+    array_##name##_clear                                                        \
+    (   type* array                                                             \
+    )                                                                           \
+    {                                                                           \
+        ( ( u64* ) array )[ ARRAY_FIELD_LENGTH - ARRAY_FIELD_COUNT ] = 0;       \
+    }
+
 #endif  // ARRAY_H
\ No newline at end of file
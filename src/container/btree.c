@@ -0,0 +1,1531 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/btree.c
+ * @brief Implementation of the container/btree header.
+ * (see container/btree.h for additional details)
+ */
+#include "container/btree.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+#include "memory/pool_allocator.h"
+
+/** @brief Minimum number of keys a node can hold. */
+#define BTREE_MINIMUM_CAPACITY 4
+
+/**
+ * @brief Maximum height of a B+tree. Every node other than the root has at
+ * least three children, so this is never reached.
+ */
+#define BTREE_MAX_HEIGHT 48
+
+/** @brief Number of nodes per pool slab, when not bulk loading. */
+#define BTREE_POOL_CAPACITY 64
+
+/**
+ * @brief Type definition for a node header.
+ *
+ * A leaf is followed by its keys, then its values; an internal node is
+ * followed by its count + 1 child pointers, then its count keys. Every key in
+ * child i of an internal node orders before key i, and no key in child i + 1
+ * orders before it.
+ */
+typedef struct node_t
+{
+    struct node_t*  prev;   // Adjacent leaves, in key order (leaves only).
+    struct node_t*  next;
+    u32             count;  // Number of keys.
+    u32             leaf;
+}
+node_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64                     key_stride;
+    u64                     value_stride;
+    comparator_function_t   comparator;
+
+    // Node geometry. Keys and values are padded to 8 bytes within a node.
+    u64                     node_size;
+    u64                     key_slot;
+    u64                     value_slot;
+    u64                     leaf_capacity;
+    u64                     internal_capacity;
+
+    pool_allocator_t*       pool;
+    node_t*                 root;
+    u64                     height;
+    u64                     length;
+
+    // Holds the children and keys of an internal node being split, and the
+    // separator key being inserted into its parent (follows the state).
+    node_t**                scratch_children;
+    void*                   scratch_keys;
+    void*                   separator;
+}
+state_t;
+
+/**
+ * @brief Compares two keys.
+ *
+ * @param state Internal state arguments.
+ * @param a A key.
+ * @param b A key.
+ * @return A negative value if a orders before b, a positive value if a orders
+ * after b, or 0 if they are equal.
+ */
+i32
+btree_compare
+(   const state_t*  state
+,   const void*     a
+,   const void*     b
+);
+
+/**
+ * @brief Retrieves a key of a node.
+ *
+ * @param state Internal state arguments.
+ * @param node The node.
+ * @param index The key index.
+ * @return The address of key index of node.
+ */
+void*
+btree_key
+(   const state_t*  state
+,   const node_t*   node
+,   const u64       index
+);
+
+/**
+ * @brief Retrieves a value of a leaf.
+ *
+ * @param state Internal state arguments.
+ * @param node The leaf.
+ * @param index The value index.
+ * @return The address of value index of node.
+ */
+void*
+btree_value
+(   const state_t*  state
+,   const node_t*   node
+,   const u64       index
+);
+
+/**
+ * @brief Retrieves the children of an internal node.
+ *
+ * @param node The internal node.
+ * @return The address of the first child pointer of node.
+ */
+node_t**
+btree_children
+(   const node_t* node
+);
+
+/**
+ * @brief Binary searches the keys of a node. O(log capacity).
+ *
+ * @param state Internal state arguments.
+ * @param node The node.
+ * @param key The key to search for.
+ * @param upper If true, finds the first key which orders after key; otherwise,
+ * the first which does not order before it.
+ * @return The index of the key found, or the node key count if none.
+ */
+u64
+btree_bound
+(   const state_t*  state
+,   const node_t*   node
+,   const void*     key
+,   const bool      upper
+);
+
+/**
+ * @brief Descends from the root to the leaf which holds (or would hold) a key.
+ *
+ * @param state Internal state arguments.
+ * @param key The key. Must be non-zero.
+ * @param path Output buffer for the node at each level, root first. Pass 0 to
+ * record nothing.
+ * @param indices Output buffer for the index of the child descended into at
+ * each level. Pass 0 to record nothing.
+ * @return The leaf.
+ */
+node_t*
+btree_descend
+(   const state_t*  state
+,   const void*     key
+,   node_t**        path
+,   u64*            indices
+);
+
+/**
+ * @brief Initializes a node allocated from the pool.
+ *
+ * @param node The node.
+ * @param leaf true if node is a leaf; false otherwise.
+ */
+void
+btree_node_init
+(   node_t*     node
+,   const bool  leaf
+);
+
+/**
+ * @brief Queries the least number of keys a non-root node may hold.
+ *
+ * @param state Internal state arguments.
+ * @param node The node.
+ * @return The minimum key count of node.
+ */
+u64
+btree_node_minimum
+(   const state_t*  state
+,   const node_t*   node
+);
+
+/**
+ * @brief Inserts an entry into a leaf which is not full.
+ *
+ * @param state Internal state arguments.
+ * @param node The leaf.
+ * @param index The index to insert at.
+ * @param key The key.
+ * @param value The value.
+ */
+void
+btree_leaf_insert
+(   state_t*    state
+,   node_t*     node
+,   const u64   index
+,   const void* key
+,   const void* value
+);
+
+/**
+ * @brief Removes an entry from a leaf.
+ *
+ * @param state Internal state arguments.
+ * @param node The leaf.
+ * @param index The index of the entry.
+ */
+void
+btree_leaf_erase
+(   state_t*    state
+,   node_t*     node
+,   const u64   index
+);
+
+/**
+ * @brief Splits a full leaf in two, inserting an entry into whichever half
+ * it orders in, and copies the least key of the right half to the separator.
+ *
+ * @param state Internal state arguments.
+ * @param node The full leaf (left half).
+ * @param right An unused node (right half).
+ * @param index The index to insert at.
+ * @param key The key.
+ * @param value The value.
+ */
+void
+btree_leaf_split
+(   state_t*    state
+,   node_t*     node
+,   node_t*     right
+,   const u64   index
+,   const void* key
+,   const void* value
+);
+
+/**
+ * @brief Inserts the separator and a child to its right into an internal node
+ * which is not full.
+ *
+ * @param state Internal state arguments.
+ * @param node The internal node.
+ * @param index The key index to insert the separator at.
+ * @param child The child to insert at index + 1.
+ */
+void
+btree_internal_insert
+(   state_t*    state
+,   node_t*     node
+,   const u64   index
+,   node_t*     child
+);
+
+/**
+ * @brief Splits a full internal node in two, inserting the separator and a
+ * child to its right into it, and copies the median key (which moves up to
+ * the parent) to the separator.
+ *
+ * @param state Internal state arguments.
+ * @param node The full internal node (left half).
+ * @param right An unused node (right half).
+ * @param index The key index to insert the separator at.
+ * @param child The child to insert at index + 1.
+ */
+void
+btree_internal_split
+(   state_t*    state
+,   node_t*     node
+,   node_t*     right
+,   const u64   index
+,   node_t*     child
+);
+
+/**
+ * @brief Restores the minimum key count of every node on a path after a
+ * removal, by borrowing from or merging with siblings, bottom-up.
+ *
+ * @param state Internal state arguments.
+ * @param path The node at each level, root first.
+ * @param indices The index of the child descended into at each level.
+ */
+void
+btree_rebalance
+(   state_t*        state
+,   node_t**        path
+,   const u64*      indices
+);
+
+/**
+ * @brief Moves the last entry of a node's left sibling to the front of the
+ * node, via their parent.
+ *
+ * @param state Internal state arguments.
+ * @param parent The parent.
+ * @param index The child index of node in parent.
+ * @param left The left sibling.
+ * @param node The node.
+ */
+void
+btree_borrow_left
+(   state_t*    state
+,   node_t*     parent
+,   const u64   index
+,   node_t*     left
+,   node_t*     node
+);
+
+/**
+ * @brief Moves the first entry of a node's right sibling to the back of the
+ * node, via their parent.
+ *
+ * @param state Internal state arguments.
+ * @param parent The parent.
+ * @param index The child index of node in parent.
+ * @param node The node.
+ * @param right The right sibling.
+ */
+void
+btree_borrow_right
+(   state_t*    state
+,   node_t*     parent
+,   const u64   index
+,   node_t*     node
+,   node_t*     right
+);
+
+/**
+ * @brief Merges a node into its left sibling, and removes it (and the key
+ * which separates them) from their parent.
+ *
+ * @param state Internal state arguments.
+ * @param parent The parent.
+ * @param index The index of the key which separates left and right in parent.
+ * @param left The left sibling.
+ * @param right The node to merge into left; freed.
+ */
+void
+btree_merge
+(   state_t*    state
+,   node_t*     parent
+,   const u64   index
+,   node_t*     left
+,   node_t*     right
+);
+
+/**
+ * @brief Frees a node and every node beneath it.
+ *
+ * @param state Internal state arguments.
+ * @param node The node.
+ */
+void
+btree_free
+(   state_t*    state
+,   node_t*     node
+);
+
+bool
+_btree_create
+(   u64                     key_stride
+,   u64                     value_stride
+,   u64                     node_size
+,   comparator_function_t   comparator
+,   btree_t**               tree
+)
+{
+    return _btree_create_from ( key_stride , value_stride , node_size
+                              , comparator , 0 , 0 , 0 , tree
+                              );
+}
+
+bool
+_btree_create_from
+(   u64                     key_stride
+,   u64                     value_stride
+,   u64                     node_size
+,   comparator_function_t   comparator
+,   const void*             keys
+,   const void*             values
+,   u64                     length
+,   btree_t**               tree
+)
+{
+    if ( !key_stride || ( !comparator && key_stride != sizeof ( u64 ) ) )
+    {
+        if ( !key_stride )
+        {
+            LOGERROR ( "btree_create: Value of key_stride argument must be non-zero." );
+        }
+        else
+        {
+            LOGERROR ( "btree_create: Value of key_stride argument must be %i when ordering by integer key (no comparator)."
+                     , sizeof ( u64 )
+                     );
+        }
+        return false;
+    }
+    if ( !tree )
+    {
+        LOGERROR ( "btree_create: Missing argument: tree (output buffer)." );
+        return false;
+    }
+    if ( length && ( !keys || ( value_stride && !values ) ) )
+    {
+        if ( !keys )
+        {
+            LOGERROR ( "btree_create_from: Missing argument: keys." );
+        }
+        else
+        {
+            LOGERROR ( "btree_create_from: Missing argument: values." );
+        }
+        return false;
+    }
+
+    // Node geometry: a whole number of cache lines, large enough for at least
+    // BTREE_MINIMUM_CAPACITY keys.
+    const u64 key_slot = aligned ( key_stride , sizeof ( u64 ) );
+    const u64 value_slot = aligned ( value_stride , sizeof ( u64 ) );
+    const u64 leaf_minimum = sizeof ( node_t )
+                           + BTREE_MINIMUM_CAPACITY * ( key_slot + value_slot )
+                           ;
+    const u64 internal_minimum = sizeof ( node_t )
+                               + ( BTREE_MINIMUM_CAPACITY + 1 ) * sizeof ( node_t* )
+                               + BTREE_MINIMUM_CAPACITY * key_slot
+                               ;
+    node_size = MAX ( node_size , MAX ( leaf_minimum , internal_minimum ) );
+    node_size = aligned ( node_size , CACHE_LINE_SIZE );
+    const u64 leaf_capacity = ( node_size - sizeof ( node_t ) )
+                            / ( key_slot + value_slot )
+                            ;
+    const u64 internal_capacity = ( node_size - sizeof ( node_t ) - sizeof ( node_t* ) )
+                                / ( key_slot + sizeof ( node_t* ) )
+                                ;
+
+    // Validate the key order before allocating anything.
+    for ( u64 i = 1; i < length; ++i )
+    {
+        const void* a = ( void* )( ( ( u64 ) keys ) + ( i - 1 ) * key_stride );
+        const void* b = ( void* )( ( ( u64 ) keys ) + i * key_stride );
+        const i32 order = comparator ? comparator ( a , b )
+                                     : ( *( ( u64* ) a ) < *( ( u64* ) b ) ) ? -1 : 1
+                                     ;
+        if ( order >= 0 )
+        {
+            LOGERROR ( "btree_create_from: Keys must be in strictly ascending order (key %u does not order after key %u)."
+                     , i , i - 1
+                     );
+            return false;
+        }
+    }
+
+    // Size the pool slabs to hold the whole bulk-loaded tree, so that its
+    // leaves are contiguous.
+    const u64 leaf_count = ( length + leaf_capacity - 1 ) / leaf_capacity;
+    u64 node_count = leaf_count;
+    for ( u64 count = leaf_count; count > 1; )
+    {
+        count = ( count + internal_capacity ) / ( internal_capacity + 1 );
+        node_count += count;
+    }
+
+    const u64 scratch_size = ( internal_capacity + 2 ) * ( key_slot + sizeof ( node_t* ) );
+    state_t* state = memory_allocate ( sizeof ( state_t ) + scratch_size , MEMORY_TAG_ARRAY );
+    ( *state ).key_stride = key_stride;
+    ( *state ).value_stride = value_stride;
+    ( *state ).comparator = comparator;
+    ( *state ).node_size = node_size;
+    ( *state ).key_slot = key_slot;
+    ( *state ).value_slot = value_slot;
+    ( *state ).leaf_capacity = leaf_capacity;
+    ( *state ).internal_capacity = internal_capacity;
+    ( *state ).scratch_children = ( node_t** )( ( ( u64 ) state ) + sizeof ( state_t ) );
+    ( *state ).scratch_keys = ( void* )( ( ( u64 ) ( *state ).scratch_children )
+                                       + ( internal_capacity + 2 ) * sizeof ( node_t* )
+                                       );
+    ( *state ).separator = ( void* )( ( ( u64 ) ( *state ).scratch_keys )
+                                    + ( internal_capacity + 1 ) * key_slot
+                                    );
+    if ( !pool_allocator_create ( node_size
+                                , MAX ( node_count , ( u64 ) BTREE_POOL_CAPACITY )
+                                , 0
+                                , 0
+                                , &( *state ).pool
+                                ))
+    {
+        LOGERROR ( "btree_create: Failed to create node pool." );
+        memory_free ( state , sizeof ( state_t ) + scratch_size , MEMORY_TAG_ARRAY );
+        return false;
+    }
+
+    if ( !length )
+    {
+        *tree = state;
+        return true;
+    }
+
+    // Bulk load: fill the leaves in order, spreading the entries evenly so
+    // that every leaf holds at least the minimum, then build each level of
+    // internal nodes over the level beneath it. nodes and minimums hold the
+    // nodes of the current level, and the least key beneath each.
+    node_t** nodes = memory_allocate ( 2 * leaf_count * sizeof ( node_t* ) , MEMORY_TAG_ARRAY );
+    const void** minimums = ( const void** )( nodes + leaf_count );
+    u64 offset = 0;
+    node_t* prev = 0;
+    for ( u64 i = 0; i < leaf_count; ++i )
+    {
+        node_t* node = pool_allocator_allocate ( ( *state ).pool );
+        if ( !node )
+        {
+            memory_free ( nodes , 2 * leaf_count * sizeof ( node_t* ) , MEMORY_TAG_ARRAY );
+            btree_destroy ( ( btree_t** ) &state );
+            return false;
+        }
+        btree_node_init ( node , true );
+        ( *node ).count = length / leaf_count + ( i < length % leaf_count );
+        for ( u64 j = 0; j < ( *node ).count; ++j )
+        {
+            memory_copy ( btree_key ( state , node , j )
+                        , ( void* )( ( ( u64 ) keys ) + ( offset + j ) * key_stride )
+                        , key_stride
+                        );
+            if ( value_stride )
+            {
+                memory_copy ( btree_value ( state , node , j )
+                            , ( void* )( ( ( u64 ) values ) + ( offset + j ) * value_stride )
+                            , value_stride
+                            );
+            }
+        }
+        ( *node ).prev = prev;
+        if ( prev )
+        {
+            ( *prev ).next = node;
+        }
+        prev = node;
+        offset += ( *node ).count;
+        nodes[ i ] = node;
+        minimums[ i ] = btree_key ( state , node , 0 );
+    }
+    ( *state ).height = 1;
+
+    for ( u64 count = leaf_count; count > 1; )
+    {
+        const u64 parent_count = ( count + internal_capacity ) / ( internal_capacity + 1 );
+        u64 read = 0;
+        for ( u64 i = 0; i < parent_count; ++i )
+        {
+            node_t* node = pool_allocator_allocate ( ( *state ).pool );
+            if ( !node )
+            {
+                memory_free ( nodes , 2 * leaf_count * sizeof ( node_t* ) , MEMORY_TAG_ARRAY );
+                btree_destroy ( ( btree_t** ) &state );
+                return false;
+            }
+            btree_node_init ( node , false );
+            const u64 child_count = count / parent_count + ( i < count % parent_count );
+            node_t** children = btree_children ( node );
+            for ( u64 j = 0; j < child_count; ++j )
+            {
+                children[ j ] = nodes[ read + j ];
+                if ( j )
+                {
+                    memory_copy ( btree_key ( state , node , j - 1 )
+                                , minimums[ read + j ]
+                                , key_stride
+                                );
+                }
+            }
+            ( *node ).count = child_count - 1;
+            nodes[ i ] = node;
+            minimums[ i ] = minimums[ read ];
+            read += child_count;
+        }
+        count = parent_count;
+        ( *state ).height += 1;
+    }
+
+    ( *state ).root = nodes[ 0 ];
+    ( *state ).length = length;
+    memory_free ( nodes , 2 * leaf_count * sizeof ( node_t* ) , MEMORY_TAG_ARRAY );
+
+    *tree = state;
+    return true;
+}
+
+void
+btree_destroy
+(   btree_t** tree
+)
+{
+    if ( !tree || !*tree )
+    {
+        return;
+    }
+
+    // Every node is freed with the pool.
+    state_t* state = *tree;
+    pool_allocator_destroy ( &( *state ).pool );
+    memory_free ( state
+                , sizeof ( state_t ) + ( ( *state ).internal_capacity + 2 )
+                                     * ( ( *state ).key_slot + sizeof ( node_t* ) )
+                , MEMORY_TAG_ARRAY
+                );
+
+    *tree = 0;
+}
+
+u64
+btree_length
+(   const btree_t* tree
+)
+{
+    return ( *( ( state_t* ) tree ) ).length;
+}
+
+u64
+btree_height
+(   const btree_t* tree
+)
+{
+    return ( *( ( state_t* ) tree ) ).height;
+}
+
+u64
+btree_node_size
+(   const btree_t* tree
+)
+{
+    return ( *( ( state_t* ) tree ) ).node_size;
+}
+
+bool
+btree_set
+(   btree_t*    tree
+,   const void* key
+,   const void* value
+)
+{
+    state_t* state = tree;
+
+    if ( !key || ( ( *state ).value_stride && !value ) )
+    {
+        if ( !key )
+        {
+            LOGERROR ( "btree_set: Missing argument: key." );
+        }
+        else
+        {
+            LOGERROR ( "btree_set: Missing argument: value." );
+        }
+        return false;
+    }
+
+    if ( !( *state ).root )
+    {
+        node_t* root = pool_allocator_allocate ( ( *state ).pool );
+        if ( !root )
+        {
+            return false;
+        }
+        btree_node_init ( root , true );
+        ( *state ).root = root;
+        ( *state ).height = 1;
+    }
+
+    node_t* path[ BTREE_MAX_HEIGHT ];
+    u64 indices[ BTREE_MAX_HEIGHT ];
+    node_t* leaf = btree_descend ( state , key , path , indices );
+
+    // Overwrite?
+    const u64 index = btree_bound ( state , leaf , key , false );
+    if ( index < ( *leaf ).count && !btree_compare ( state , btree_key ( state , leaf , index ) , key ) )
+    {
+        if ( ( *state ).value_stride )
+        {
+            memory_copy ( btree_value ( state , leaf , index ) , value , ( *state ).value_stride );
+        }
+        return true;
+    }
+
+    if ( ( *leaf ).count < ( *state ).leaf_capacity )
+    {
+        btree_leaf_insert ( state , leaf , index , key , value );
+        ( *state ).length += 1;
+        return true;
+    }
+
+    // The leaf is full, and splits; so does each full ancestor in turn, and the
+    // root, if every ancestor is full. Allocate every node this requires
+    // before modifying the tree, so that an allocation failure leaves it
+    // intact.
+    node_t* spares[ BTREE_MAX_HEIGHT + 1 ];
+    u64 spare_count = 1;
+    u64 level = ( *state ).height - 1;
+    while ( level && ( *( path[ level - 1 ] ) ).count == ( *state ).internal_capacity )
+    {
+        spare_count += 1;
+        level -= 1;
+    }
+    if ( !level )
+    {
+        spare_count += 1;
+    }
+    for ( u64 i = 0; i < spare_count; ++i )
+    {
+        spares[ i ] = pool_allocator_allocate ( ( *state ).pool );
+        if ( !spares[ i ] )
+        {
+            while ( i )
+            {
+                i -= 1;
+                pool_allocator_free ( ( *state ).pool , spares[ i ] );
+            }
+            return false;
+        }
+    }
+
+    node_t* right = spares[ 0 ];
+    btree_node_init ( right , true );
+    btree_leaf_split ( state , leaf , right , index , key , value );
+    ( *state ).length += 1;
+
+    for ( level = ( *state ).height - 1; level; --level )
+    {
+        node_t* parent = path[ level - 1 ];
+        if ( ( *parent ).count < ( *state ).internal_capacity )
+        {
+            btree_internal_insert ( state , parent , indices[ level - 1 ] , right );
+            return true;
+        }
+        node_t* sibling = spares[ ( *state ).height - level ];
+        btree_node_init ( sibling , false );
+        btree_internal_split ( state , parent , sibling , indices[ level - 1 ] , right );
+        right = sibling;
+    }
+
+    // The root split; grow the tree by one level.
+    node_t* root = spares[ spare_count - 1 ];
+    btree_node_init ( root , false );
+    btree_children ( root )[ 0 ] = ( *state ).root;
+    btree_children ( root )[ 1 ] = right;
+    memory_copy ( btree_key ( state , root , 0 ) , ( *state ).separator , ( *state ).key_stride );
+    ( *root ).count = 1;
+    ( *state ).root = root;
+    ( *state ).height += 1;
+    return true;
+}
+
+bool
+btree_get
+(   const btree_t*  tree
+,   const void*     key
+,   void*           value
+)
+{
+    const state_t* state = tree;
+
+    if ( !( *state ).root )
+    {
+        return false;
+    }
+
+    const node_t* leaf = btree_descend ( state , key , 0 , 0 );
+    const u64 index = btree_bound ( state , leaf , key , false );
+    if ( index == ( *leaf ).count || btree_compare ( state , btree_key ( state , leaf , index ) , key ) )
+    {
+        return false;
+    }
+    if ( value )
+    {
+        memory_copy ( value , btree_value ( state , leaf , index ) , ( *state ).value_stride );
+    }
+    return true;
+}
+
+bool
+btree_contains
+(   const btree_t*  tree
+,   const void*     key
+)
+{
+    return btree_get ( tree , key , 0 );
+}
+
+bool
+btree_remove
+(   btree_t*    tree
+,   const void* key
+,   void*       value
+)
+{
+    state_t* state = tree;
+
+    if ( !( *state ).root )
+    {
+        return false;
+    }
+
+    node_t* path[ BTREE_MAX_HEIGHT ];
+    u64 indices[ BTREE_MAX_HEIGHT ];
+    node_t* leaf = btree_descend ( state , key , path , indices );
+    const u64 index = btree_bound ( state , leaf , key , false );
+    if ( index == ( *leaf ).count || btree_compare ( state , btree_key ( state , leaf , index ) , key ) )
+    {
+        return false;
+    }
+    if ( value )
+    {
+        memory_copy ( value , btree_value ( state , leaf , index ) , ( *state ).value_stride );
+    }
+
+    // Separators in ancestors are not updated if the least key of the leaf is
+    // removed: they remain valid bounds for the keys beneath them.
+    btree_leaf_erase ( state , leaf , index );
+    ( *state ).length -= 1;
+    btree_rebalance ( state , path , indices );
+    return true;
+}
+
+void
+btree_clear
+(   btree_t* tree
+)
+{
+    state_t* state = tree;
+    if ( ( *state ).root )
+    {
+        btree_free ( state , ( *state ).root );
+    }
+    ( *state ).root = 0;
+    ( *state ).height = 0;
+    ( *state ).length = 0;
+}
+
+bool
+btree_first
+(   const btree_t*      tree
+,   btree_iterator_t*   iterator
+)
+{
+    const state_t* state = tree;
+    node_t* node = ( *state ).root;
+    while ( node && !( *node ).leaf )
+    {
+        node = btree_children ( node )[ 0 ];
+    }
+    ( *iterator ).tree = tree;
+    ( *iterator ).node = node;
+    ( *iterator ).index = 0;
+    return node;
+}
+
+bool
+btree_last
+(   const btree_t*      tree
+,   btree_iterator_t*   iterator
+)
+{
+    const state_t* state = tree;
+    node_t* node = ( *state ).root;
+    while ( node && !( *node ).leaf )
+    {
+        node = btree_children ( node )[ ( *node ).count ];
+    }
+    ( *iterator ).tree = tree;
+    ( *iterator ).node = node;
+    ( *iterator ).index = node ? ( *node ).count - 1 : 0;
+    return node;
+}
+
+bool
+btree_lower_bound
+(   const btree_t*      tree
+,   const void*         key
+,   btree_iterator_t*   iterator
+)
+{
+    const state_t* state = tree;
+    ( *iterator ).tree = tree;
+    ( *iterator ).node = 0;
+    ( *iterator ).index = 0;
+    if ( !( *state ).root )
+    {
+        return false;
+    }
+
+    node_t* leaf = btree_descend ( state , key , 0 , 0 );
+    const u64 index = btree_bound ( state , leaf , key , false );
+    if ( index < ( *leaf ).count )
+    {
+        ( *iterator ).node = leaf;
+        ( *iterator ).index = index;
+    }
+    else
+    {
+        ( *iterator ).node = ( *leaf ).next;
+    }
+    return ( *iterator ).node;
+}
+
+bool
+btree_upper_bound
+(   const btree_t*      tree
+,   const void*         key
+,   btree_iterator_t*   iterator
+)
+{
+    const state_t* state = tree;
+    ( *iterator ).tree = tree;
+    ( *iterator ).node = 0;
+    ( *iterator ).index = 0;
+    if ( !( *state ).root )
+    {
+        return false;
+    }
+
+    node_t* leaf = btree_descend ( state , key , 0 , 0 );
+    const u64 index = btree_bound ( state , leaf , key , true );
+    if ( index < ( *leaf ).count )
+    {
+        ( *iterator ).node = leaf;
+        ( *iterator ).index = index;
+    }
+    else
+    {
+        ( *iterator ).node = ( *leaf ).next;
+    }
+    return ( *iterator ).node;
+}
+
+bool
+btree_iterator_valid
+(   const btree_iterator_t* iterator
+)
+{
+    return ( *iterator ).node;
+}
+
+bool
+btree_iterator_next
+(   btree_iterator_t* iterator
+)
+{
+    const node_t* node = ( *iterator ).node;
+    if ( !node )
+    {
+        return false;
+    }
+    ( *iterator ).index += 1;
+    if ( ( *iterator ).index == ( *node ).count )
+    {
+        ( *iterator ).node = ( *node ).next;
+        ( *iterator ).index = 0;
+    }
+    return ( *iterator ).node;
+}
+
+bool
+btree_iterator_prev
+(   btree_iterator_t* iterator
+)
+{
+    const node_t* node = ( *iterator ).node;
+    if ( !node )
+    {
+        return false;
+    }
+    if ( ( *iterator ).index )
+    {
+        ( *iterator ).index -= 1;
+        return true;
+    }
+    node = ( *node ).prev;
+    ( *iterator ).node = ( void* ) node;
+    ( *iterator ).index = node ? ( *node ).count - 1 : 0;
+    return node;
+}
+
+const void*
+btree_iterator_key
+(   const btree_iterator_t* iterator
+)
+{
+    if ( !( *iterator ).node )
+    {
+        return 0;
+    }
+    return btree_key ( ( *iterator ).tree , ( *iterator ).node , ( *iterator ).index );
+}
+
+void*
+btree_iterator_value
+(   const btree_iterator_t* iterator
+)
+{
+    if ( !( *iterator ).node )
+    {
+        return 0;
+    }
+    return btree_value ( ( *iterator ).tree , ( *iterator ).node , ( *iterator ).index );
+}
+
+i32
+btree_compare
+(   const state_t*  state
+,   const void*     a
+,   const void*     b
+)
+{
+    if ( ( *state ).comparator )
+    {
+        return ( *state ).comparator ( a , b );
+    }
+    const u64 a_ = *( ( u64* ) a );
+    const u64 b_ = *( ( u64* ) b );
+    return ( a_ > b_ ) - ( a_ < b_ );
+}
+
+void*
+btree_key
+(   const state_t*  state
+,   const node_t*   node
+,   const u64       index
+)
+{
+    u64 offset = sizeof ( node_t ) + index * ( *state ).key_slot;
+    if ( !( *node ).leaf )
+    {
+        offset += ( ( *state ).internal_capacity + 1 ) * sizeof ( node_t* );
+    }
+    return ( void* )( ( ( u64 ) node ) + offset );
+}
+
+void*
+btree_value
+(   const state_t*  state
+,   const node_t*   node
+,   const u64       index
+)
+{
+    return ( void* )( ( ( u64 ) node )
+                    + sizeof ( node_t )
+                    + ( *state ).leaf_capacity * ( *state ).key_slot
+                    + index * ( *state ).value_slot
+                    );
+}
+
+node_t**
+btree_children
+(   const node_t* node
+)
+{
+    return ( node_t** )( ( ( u64 ) node ) + sizeof ( node_t ) );
+}
+
+u64
+btree_bound
+(   const state_t*  state
+,   const node_t*   node
+,   const void*     key
+,   const bool      upper
+)
+{
+    u64 low = 0;
+    u64 high = ( *node ).count;
+    while ( low < high )
+    {
+        const u64 mid = low + ( high - low ) / 2;
+        const i32 order = btree_compare ( state , btree_key ( state , node , mid ) , key );
+        if ( order < 0 || ( upper && !order ) )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+node_t*
+btree_descend
+(   const state_t*  state
+,   const void*     key
+,   node_t**        path
+,   u64*            indices
+)
+{
+    node_t* node = ( *state ).root;
+    u64 level = 0;
+    while ( !( *node ).leaf )
+    {
+        const u64 index = btree_bound ( state , node , key , true );
+        if ( path )
+        {
+            path[ level ] = node;
+            indices[ level ] = index;
+        }
+        node = btree_children ( node )[ index ];
+        level += 1;
+    }
+    if ( path )
+    {
+        path[ level ] = node;
+    }
+    return node;
+}
+
+void
+btree_node_init
+(   node_t*     node
+,   const bool  leaf
+)
+{
+    ( *node ).prev = 0;
+    ( *node ).next = 0;
+    ( *node ).count = 0;
+    ( *node ).leaf = leaf;
+}
+
+u64
+btree_node_minimum
+(   const state_t*  state
+,   const node_t*   node
+)
+{
+    return ( ( *node ).leaf ? ( *state ).leaf_capacity
+                            : ( *state ).internal_capacity
+                            ) / 2;
+}
+
+void
+btree_leaf_insert
+(   state_t*    state
+,   node_t*     node
+,   const u64   index
+,   const void* key
+,   const void* value
+)
+{
+    const u64 count = ( *node ).count;
+    memory_move ( btree_key ( state , node , index + 1 )
+                , btree_key ( state , node , index )
+                , ( count - index ) * ( *state ).key_slot
+                );
+    memory_copy ( btree_key ( state , node , index ) , key , ( *state ).key_stride );
+    if ( ( *state ).value_stride )
+    {
+        memory_move ( btree_value ( state , node , index + 1 )
+                    , btree_value ( state , node , index )
+                    , ( count - index ) * ( *state ).value_slot
+                    );
+        memory_copy ( btree_value ( state , node , index ) , value , ( *state ).value_stride );
+    }
+    ( *node ).count += 1;
+}
+
+void
+btree_leaf_erase
+(   state_t*    state
+,   node_t*     node
+,   const u64   index
+)
+{
+    const u64 count = ( *node ).count;
+    memory_move ( btree_key ( state , node , index )
+                , btree_key ( state , node , index + 1 )
+                , ( count - index - 1 ) * ( *state ).key_slot
+                );
+    if ( ( *state ).value_stride )
+    {
+        memory_move ( btree_value ( state , node , index )
+                    , btree_value ( state , node , index + 1 )
+                    , ( count - index - 1 ) * ( *state ).value_slot
+                    );
+    }
+    ( *node ).count -= 1;
+}
+
+void
+btree_leaf_split
+(   state_t*    state
+,   node_t*     node
+,   node_t*     right
+,   const u64   index
+,   const void* key
+,   const void* value
+)
+{
+    // Move the upper half to the right leaf, leaving room for the new entry
+    // in whichever half it belongs to, so that the halves end up balanced.
+    const u64 capacity = ( *state ).leaf_capacity;
+    const u64 split = ( capacity + 1 ) / 2;
+    const u64 from = ( index < split ) ? split - 1 : split;
+    memory_copy ( btree_key ( state , right , 0 )
+                , btree_key ( state , node , from )
+                , ( capacity - from ) * ( *state ).key_slot
+                );
+    if ( ( *state ).value_stride )
+    {
+        memory_copy ( btree_value ( state , right , 0 )
+                    , btree_value ( state , node , from )
+                    , ( capacity - from ) * ( *state ).value_slot
+                    );
+    }
+    ( *right ).count = capacity - from;
+    ( *node ).count = from;
+    if ( index < split )
+    {
+        btree_leaf_insert ( state , node , index , key , value );
+    }
+    else
+    {
+        btree_leaf_insert ( state , right , index - from , key , value );
+    }
+
+    ( *right ).prev = node;
+    ( *right ).next = ( *node ).next;
+    if ( ( *node ).next )
+    {
+        ( *( ( *node ).next ) ).prev = right;
+    }
+    ( *node ).next = right;
+
+    memory_copy ( ( *state ).separator , btree_key ( state , right , 0 ) , ( *state ).key_stride );
+}
+
+void
+btree_internal_insert
+(   state_t*    state
+,   node_t*     node
+,   const u64   index
+,   node_t*     child
+)
+{
+    const u64 count = ( *node ).count;
+    node_t** children = btree_children ( node );
+    memory_move ( btree_key ( state , node , index + 1 )
+                , btree_key ( state , node , index )
+                , ( count - index ) * ( *state ).key_slot
+                );
+    memory_copy ( btree_key ( state , node , index ) , ( *state ).separator , ( *state ).key_stride );
+    memory_move ( &children[ index + 2 ]
+                , &children[ index + 1 ]
+                , ( count - index ) * sizeof ( node_t* )
+                );
+    children[ index + 1 ] = child;
+    ( *node ).count += 1;
+}
+
+void
+btree_internal_split
+(   state_t*    state
+,   node_t*     node
+,   node_t*     right
+,   const u64   index
+,   node_t*     child
+)
+{
+    const u64 capacity = ( *state ).internal_capacity;
+    const u64 key_slot = ( *state ).key_slot;
+    node_t** children = btree_children ( node );
+    node_t** scratch_children = ( *state ).scratch_children;
+    u8* scratch_keys = ( *state ).scratch_keys;
+
+    // Gather the capacity + 1 keys and capacity + 2 children into scratch.
+    memory_copy ( scratch_keys , btree_key ( state , node , 0 ) , index * key_slot );
+    memory_copy ( scratch_keys + index * key_slot , ( *state ).separator , ( *state ).key_stride );
+    memory_copy ( scratch_keys + ( index + 1 ) * key_slot
+                , btree_key ( state , node , index )
+                , ( capacity - index ) * key_slot
+                );
+    memory_copy ( scratch_children , children , ( index + 1 ) * sizeof ( node_t* ) );
+    scratch_children[ index + 1 ] = child;
+    memory_copy ( &scratch_children[ index + 2 ]
+                , &children[ index + 1 ]
+                , ( capacity - index ) * sizeof ( node_t* )
+                );
+
+    // Split around the median key, which moves up to the parent.
+    const u64 median = ( capacity + 1 ) / 2;
+    memory_copy ( btree_key ( state , node , 0 ) , scratch_keys , median * key_slot );
+    memory_copy ( children , scratch_children , ( median + 1 ) * sizeof ( node_t* ) );
+    ( *node ).count = median;
+    memory_copy ( btree_key ( state , right , 0 )
+                , scratch_keys + ( median + 1 ) * key_slot
+                , ( capacity - median ) * key_slot
+                );
+    memory_copy ( btree_children ( right )
+                , &scratch_children[ median + 1 ]
+                , ( capacity - median + 1 ) * sizeof ( node_t* )
+                );
+    ( *right ).count = capacity - median;
+    memory_copy ( ( *state ).separator , scratch_keys + median * key_slot , ( *state ).key_stride );
+}
+
+void
+btree_rebalance
+(   state_t*        state
+,   node_t**        path
+,   const u64*      indices
+)
+{
+    for ( u64 level = ( *state ).height - 1; level; --level )
+    {
+        node_t* node = path[ level ];
+        const u64 minimum = btree_node_minimum ( state , node );
+        if ( ( *node ).count >= minimum )
+        {
+            return;
+        }
+
+        node_t* parent = path[ level - 1 ];
+        const u64 index = indices[ level - 1 ];
+        node_t** children = btree_children ( parent );
+        node_t* left = index ? children[ index - 1 ] : 0;
+        node_t* right = ( index < ( *parent ).count ) ? children[ index + 1 ] : 0;
+        if ( left && ( *left ).count > minimum )
+        {
+            btree_borrow_left ( state , parent , index , left , node );
+            return;
+        }
+        if ( right && ( *right ).count > minimum )
+        {
+            btree_borrow_right ( state , parent , index , node , right );
+            return;
+        }
+        if ( left )
+        {
+            btree_merge ( state , parent , index - 1 , left , node );
+        }
+        else
+        {
+            btree_merge ( state , parent , index , node , right );
+        }
+    }
+
+    // Shrink the tree by one level if the root has only one child left, or
+    // empty it if the root is a leaf with no keys left.
+    node_t* root = ( *state ).root;
+    if ( ( *root ).count )
+    {
+        return;
+    }
+    ( *state ).root = ( *root ).leaf ? 0 : btree_children ( root )[ 0 ];
+    ( *state ).height -= 1;
+    pool_allocator_free ( ( *state ).pool , root );
+}
+
+void
+btree_borrow_left
+(   state_t*    state
+,   node_t*     parent
+,   const u64   index
+,   node_t*     left
+,   node_t*     node
+)
+{
+    const u64 last = ( *left ).count - 1;
+    if ( ( *node ).leaf )
+    {
+        btree_leaf_insert ( state , node , 0
+                          , btree_key ( state , left , last )
+                          , btree_value ( state , left , last )
+                          );
+        ( *left ).count -= 1;
+        memory_copy ( btree_key ( state , parent , index - 1 )
+                    , btree_key ( state , node , 0 )
+                    , ( *state ).key_stride
+                    );
+        return;
+    }
+
+    // Rotate right through the parent: the separator moves down to the front
+    // of node, and the last key of left moves up to replace it.
+    const u64 count = ( *node ).count;
+    node_t** children = btree_children ( node );
+    memory_move ( btree_key ( state , node , 1 )
+                , btree_key ( state , node , 0 )
+                , count * ( *state ).key_slot
+                );
+    memory_copy ( btree_key ( state , node , 0 )
+                , btree_key ( state , parent , index - 1 )
+                , ( *state ).key_stride
+                );
+    memory_move ( &children[ 1 ] , &children[ 0 ] , ( count + 1 ) * sizeof ( node_t* ) );
+    children[ 0 ] = btree_children ( left )[ last + 1 ];
+    memory_copy ( btree_key ( state , parent , index - 1 )
+                , btree_key ( state , left , last )
+                , ( *state ).key_stride
+                );
+    ( *left ).count -= 1;
+    ( *node ).count += 1;
+}
+
+void
+btree_borrow_right
+(   state_t*    state
+,   node_t*     parent
+,   const u64   index
+,   node_t*     node
+,   node_t*     right
+)
+{
+    const u64 count = ( *node ).count;
+    if ( ( *node ).leaf )
+    {
+        btree_leaf_insert ( state , node , count
+                          , btree_key ( state , right , 0 )
+                          , btree_value ( state , right , 0 )
+                          );
+        btree_leaf_erase ( state , right , 0 );
+        memory_copy ( btree_key ( state , parent , index )
+                    , btree_key ( state , right , 0 )
+                    , ( *state ).key_stride
+                    );
+        return;
+    }
+
+    // Rotate left through the parent: the separator moves down to the back of
+    // node, and the first key of right moves up to replace it.
+    node_t** right_children = btree_children ( right );
+    memory_copy ( btree_key ( state , node , count )
+                , btree_key ( state , parent , index )
+                , ( *state ).key_stride
+                );
+    btree_children ( node )[ count + 1 ] = right_children[ 0 ];
+    memory_copy ( btree_key ( state , parent , index )
+                , btree_key ( state , right , 0 )
+                , ( *state ).key_stride
+                );
+    memory_move ( btree_key ( state , right , 0 )
+                , btree_key ( state , right , 1 )
+                , ( ( *right ).count - 1 ) * ( *state ).key_slot
+                );
+    memory_move ( &right_children[ 0 ]
+                , &right_children[ 1 ]
+                , ( *right ).count * sizeof ( node_t* )
+                );
+    ( *right ).count -= 1;
+    ( *node ).count += 1;
+}
+
+void
+btree_merge
+(   state_t*    state
+,   node_t*     parent
+,   const u64   index
+,   node_t*     left
+,   node_t*     right
+)
+{
+    const u64 count = ( *left ).count;
+    if ( ( *left ).leaf )
+    {
+        memory_copy ( btree_key ( state , left , count )
+                    , btree_key ( state , right , 0 )
+                    , ( *right ).count * ( *state ).key_slot
+                    );
+        if ( ( *state ).value_stride )
+        {
+            memory_copy ( btree_value ( state , left , count )
+                        , btree_value ( state , right , 0 )
+                        , ( *right ).count * ( *state ).value_slot
+                        );
+        }
+        ( *left ).count += ( *right ).count;
+        ( *left ).next = ( *right ).next;
+        if ( ( *right ).next )
+        {
+            ( *( ( *right ).next ) ).prev = left;
+        }
+    }
+    else
+    {
+        // The separator moves down between the keys of left and right.
+        memory_copy ( btree_key ( state , left , count )
+                    , btree_key ( state , parent , index )
+                    , ( *state ).key_stride
+                    );
+        memory_copy ( btree_key ( state , left , count + 1 )
+                    , btree_key ( state , right , 0 )
+                    , ( *right ).count * ( *state ).key_slot
+                    );
+        memory_copy ( &btree_children ( left )[ count + 1 ]
+                    , btree_children ( right )
+                    , ( ( *right ).count + 1 ) * sizeof ( node_t* )
+                    );
+        ( *left ).count += ( *right ).count + 1;
+    }
+    pool_allocator_free ( ( *state ).pool , right );
+
+    // Remove the separator and right from the parent.
+    const u64 parent_count = ( *parent ).count;
+    node_t** children = btree_children ( parent );
+    memory_move ( btree_key ( state , parent , index )
+                , btree_key ( state , parent , index + 1 )
+                , ( parent_count - index - 1 ) * ( *state ).key_slot
+                );
+    memory_move ( &children[ index + 1 ]
+                , &children[ index + 2 ]
+                , ( parent_count - index - 1 ) * sizeof ( node_t* )
+                );
+    ( *parent ).count -= 1;
+}
+
+void
+btree_free
+(   state_t*    state
+,   node_t*     node
+)
+{
+    if ( !( *node ).leaf )
+    {
+        node_t** children = btree_children ( node );
+        for ( u64 i = 0; i <= ( *node ).count; ++i )
+        {
+            btree_free ( state , children[ i ] );
+        }
+    }
+    pool_allocator_free ( ( *state ).pool , node );
+}
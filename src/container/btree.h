@@ -0,0 +1,374 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/btree.h
+ * @brief Provides an interface for a B+tree (sorted map).
+ *
+ * A B+tree maps fixed-size keys to fixed-size values, and keeps the keys in
+ * order (by a comparator, or as u64 integers). Lookup, insertion and removal
+ * cost O(log n), compared to O(n) insertion and removal for a sorted resizable
+ * array; in addition, the entries may be iterated in order from any key, for
+ * range scans.
+ *
+ *   btree_t* index;
+ *   btree_create ( u64 , record_t* , 0 , &index );
+ *   btree_set ( index , &id , &record );
+ *   ...
+ *   btree_iterator_t iterator;
+ *   for ( bool found = btree_lower_bound ( index , &low , &iterator )
+ *       ; found && *( ( u64* ) btree_iterator_key ( &iterator ) ) < high
+ *       ; found = btree_iterator_next ( &iterator )
+ *       )
+ *   { ... }
+ *
+ * Every node is a whole number of cache lines (BTREE_DEFAULT_NODE_SIZE, by
+ * default), so that a search touches a few cache lines per level, and the tree
+ * is shallow: internal nodes hold only keys and child pointers, and the entries
+ * are held in the leaves, which are linked in order so that a scan never
+ * revisits an internal node. Nodes are allocated from a pool (see
+ * memory/pool_allocator.h), so insertion and removal do not call the general
+ * purpose allocator, and nodes are packed into contiguous, cache-line-aligned
+ * slabs.
+ *
+ * Keys are unique; setting an existing key overwrites its value.
+ *
+ * Mutating a B+tree invalidates every iterator over it, and any key or value
+ * address retrieved from one.
+ */
+#ifndef BTREE_H
+#define BTREE_H
+
+#include "common.h"
+
+/** @brief Type declaration for a B+tree. */
+typedef void btree_t;
+
+/** @brief B+tree default node size (in bytes). */
+#define BTREE_DEFAULT_NODE_SIZE ( 4 * CACHE_LINE_SIZE )
+
+/**
+ * @brief Type definition for a B+tree iterator. Refers to an entry of the tree,
+ * or to none (past either end).
+ */
+typedef struct
+{
+    const btree_t*  tree;
+    void*           node;
+    u64             index;
+}
+btree_iterator_t;
+
+/**
+ * @brief Initializes a B+tree.
+ *
+ * Use _btree_create to explicitly specify the node size, or btree_create to
+ * use the default.
+ *
+ * Uses dynamic memory allocation. Call btree_destroy to free.
+ *
+ * @param key_stride The fixed key size in bytes. Must be non-zero.
+ * @param value_stride The fixed value size in bytes. Pass 0 to store keys only
+ * (a sorted set).
+ * @param node_size The node size in bytes. Rounded up to a multiple of
+ * CACHE_LINE_SIZE, and up to the size of a node of at least four entries.
+ * @param comparator A function which compares two keys. Pass 0 to order the
+ * keys as u64 integers instead (key_stride must then be 8).
+ * @param tree Output buffer for the tree. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+_btree_create
+(   u64                     key_stride
+,   u64                     value_stride
+,   u64                     node_size
+,   comparator_function_t   comparator
+,   btree_t**               tree
+);
+
+/**
+ * @param key_type C data type of the keys.
+ * @param value_type C data type of the values.
+ */
+#define btree_create(key_type,value_type,comparator,tree)                 \
+    _btree_create ( sizeof ( key_type ) , sizeof ( value_type )         \
+                  , BTREE_DEFAULT_NODE_SIZE , (comparator) , (tree)     \
+                  )
+
+/**
+ * @brief Initializes a B+tree from arrays of sorted keys and values (bulk
+ * load). O(n).
+ *
+ * Builds the tree bottom-up, with full leaves, rather than with one insertion
+ * per entry: this is several times faster, and the leaves are laid out in key
+ * order in a single slab.
+ *
+ * Uses dynamic memory allocation. Call btree_destroy to free.
+ *
+ * @param key_stride The fixed key size in bytes. Must be non-zero.
+ * @param value_stride The fixed value size in bytes (see _btree_create).
+ * @param node_size The node size in bytes (see _btree_create).
+ * @param comparator A function which compares two keys (see _btree_create).
+ * @param keys The keys, contiguous in memory, in strictly ascending order. Must
+ * be non-zero if length is non-zero.
+ * @param values The values, contiguous in memory, in the same order as keys.
+ * Must be non-zero if length and value_stride are non-zero.
+ * @param length The number of entries.
+ * @param tree Output buffer for the tree. Must be non-zero.
+ * @return true on success; false otherwise (including if the keys are not in
+ * strictly ascending order).
+ */
+bool
+_btree_create_from
+(   u64                     key_stride
+,   u64                     value_stride
+,   u64                     node_size
+,   comparator_function_t   comparator
+,   const void*             keys
+,   const void*             values
+,   u64                     length
+,   btree_t**               tree
+);
+
+/**
+ * @param key_type C data type of the keys.
+ * @param value_type C data type of the values.
+ */
+#define btree_create_from(key_type,value_type,comparator,keys,values,length,tree) \
+    _btree_create_from ( sizeof ( key_type ) , sizeof ( value_type )            \
+                       , BTREE_DEFAULT_NODE_SIZE , (comparator) , (keys)        \
+                       , (values) , (length) , (tree)                           \
+                       )
+
+/**
+ * @brief Frees the memory used by a B+tree.
+ *
+ * @param tree Handle to the tree to free.
+ */
+void
+btree_destroy
+(   btree_t** tree
+);
+
+/**
+ * @brief Queries the number of entries in a B+tree.
+ *
+ * @param tree The tree to query. Must be non-zero.
+ * @return The number of entries.
+ */
+u64
+btree_length
+(   const btree_t* tree
+);
+
+/**
+ * @brief Queries the height of a B+tree.
+ *
+ * @param tree The tree to query. Must be non-zero.
+ * @return The number of nodes on a path from the root to a leaf (0 if the tree
+ * is empty).
+ */
+u64
+btree_height
+(   const btree_t* tree
+);
+
+/**
+ * @brief Queries the node size of a B+tree.
+ *
+ * @param tree The tree to query. Must be non-zero.
+ * @return The size of each node in bytes.
+ */
+u64
+btree_node_size
+(   const btree_t* tree
+);
+
+/**
+ * @brief Inserts an entry into a B+tree, or overwrites the value of an
+ * existing key. O(log n).
+ *
+ * @param tree The tree to mutate. Must be non-zero.
+ * @param key The key. Must be non-zero.
+ * @param value The value. Must be non-zero if the tree has values.
+ * @return true on success; false otherwise.
+ */
+bool
+btree_set
+(   btree_t*    tree
+,   const void* key
+,   const void* value
+);
+
+/**
+ * @brief Retrieves the value of a key in a B+tree. O(log n).
+ *
+ * @param tree The tree to query. Must be non-zero.
+ * @param key The key. Must be non-zero.
+ * @param value Output buffer for the value. Pass 0 to retrieve nothing.
+ * @return true if key is present; false otherwise.
+ */
+bool
+btree_get
+(   const btree_t*  tree
+,   const void*     key
+,   void*           value
+);
+
+/**
+ * @brief Queries whether a key is present in a B+tree. O(log n).
+ *
+ * @param tree The tree to query. Must be non-zero.
+ * @param key The key. Must be non-zero.
+ * @return true if key is present; false otherwise.
+ */
+bool
+btree_contains
+(   const btree_t*  tree
+,   const void*     key
+);
+
+/**
+ * @brief Removes an entry from a B+tree. O(log n).
+ *
+ * @param tree The tree to mutate. Must be non-zero.
+ * @param key The key. Must be non-zero.
+ * @param value Output buffer for the value. Pass 0 to retrieve nothing.
+ * @return true if key was present; false otherwise.
+ */
+bool
+btree_remove
+(   btree_t*    tree
+,   const void* key
+,   void*       value
+);
+
+/**
+ * @brief Removes every entry from a B+tree. O(n).
+ *
+ * @param tree The tree to clear. Must be non-zero.
+ */
+void
+btree_clear
+(   btree_t* tree
+);
+
+/**
+ * @brief Initializes an iterator to the least entry of a B+tree. O(log n).
+ *
+ * @param tree The tree to iterate over. Must be non-zero.
+ * @param iterator Output buffer for the iterator. Must be non-zero.
+ * @return true if the iterator refers to an entry; false if tree empty.
+ */
+bool
+btree_first
+(   const btree_t*      tree
+,   btree_iterator_t*   iterator
+);
+
+/**
+ * @brief Initializes an iterator to the greatest entry of a B+tree. O(log n).
+ *
+ * @param tree The tree to iterate over. Must be non-zero.
+ * @param iterator Output buffer for the iterator. Must be non-zero.
+ * @return true if the iterator refers to an entry; false if tree empty.
+ */
+bool
+btree_last
+(   const btree_t*      tree
+,   btree_iterator_t*   iterator
+);
+
+/**
+ * @brief Initializes an iterator to the least entry of a B+tree whose key does
+ * not order before a key. O(log n).
+ *
+ * @param tree The tree to iterate over. Must be non-zero.
+ * @param key The key. Must be non-zero.
+ * @param iterator Output buffer for the iterator. Must be non-zero.
+ * @return true if the iterator refers to an entry; false if every key orders
+ * before key.
+ */
+bool
+btree_lower_bound
+(   const btree_t*      tree
+,   const void*         key
+,   btree_iterator_t*   iterator
+);
+
+/**
+ * @brief Initializes an iterator to the least entry of a B+tree whose key
+ * orders after a key. O(log n).
+ *
+ * @param tree The tree to iterate over. Must be non-zero.
+ * @param key The key. Must be non-zero.
+ * @param iterator Output buffer for the iterator. Must be non-zero.
+ * @return true if the iterator refers to an entry; false if no key orders
+ * after key.
+ */
+bool
+btree_upper_bound
+(   const btree_t*      tree
+,   const void*         key
+,   btree_iterator_t*   iterator
+);
+
+/**
+ * @brief Queries whether an iterator refers to an entry.
+ *
+ * @param iterator The iterator to query. Must be non-zero.
+ * @return true if iterator refers to an entry; false if it is past either end.
+ */
+bool
+btree_iterator_valid
+(   const btree_iterator_t* iterator
+);
+
+/**
+ * @brief Advances an iterator to the next entry, in key order. O(1).
+ *
+ * @param iterator The iterator to mutate. Must be non-zero.
+ * @return true if the iterator refers to an entry; false if it is past the
+ * end.
+ */
+bool
+btree_iterator_next
+(   btree_iterator_t* iterator
+);
+
+/**
+ * @brief Moves an iterator back to the previous entry, in key order. O(1).
+ *
+ * @param iterator The iterator to mutate. Must be non-zero.
+ * @return true if the iterator refers to an entry; false if it is past the
+ * beginning.
+ */
+bool
+btree_iterator_prev
+(   btree_iterator_t* iterator
+);
+
+/**
+ * @brief Retrieves the key of the entry an iterator refers to.
+ *
+ * @param iterator The iterator to query. Must be non-zero.
+ * @return The address of the key (owned by the tree), or 0 if the iterator
+ * does not refer to an entry.
+ */
+const void*
+btree_iterator_key
+(   const btree_iterator_t* iterator
+);
+
+/**
+ * @brief Retrieves the value of the entry an iterator refers to. The value may
+ * be modified in place.
+ *
+ * @param iterator The iterator to query. Must be non-zero.
+ * @return The address of the value (owned by the tree), or 0 if the iterator
+ * does not refer to an entry.
+ */
+void*
+btree_iterator_value
+(   const btree_iterator_t* iterator
+);
+
+#endif  // BTREE_H
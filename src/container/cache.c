@@ -0,0 +1,714 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/cache.c
+ * @brief Implementation of the container/cache header.
+ * (see container/cache.h for additional details)
+ */
+#include "container/cache.h"
+
+#include "core/hash.h"
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+/** @brief Sentinel slot index: the end of a chain, or no slot at all. */
+#define CACHE_NONE 0xFFFFFFFF
+
+/**
+ * @brief Type definition for a cache slot.
+ *
+ * Each slot is followed in memory by key_capacity bytes of key, then by the
+ * value (both padded to 8 bytes).
+ */
+typedef struct
+{
+    u64     hash;
+    u64     key_length;
+
+    // Number of bytes charged against the budget.
+    u64     size;
+
+    // Next slot in the same bucket if occupied; next free slot otherwise.
+    u32     next;
+
+    bool    occupied;
+
+    // Set on every hit; cleared as the CLOCK hand passes.
+    bool    referenced;
+}
+slot_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64     stride;
+    u32     capacity;
+    u32     key_capacity;
+    u64     budget;
+    u64     slot_size;
+    u64     bucket_mask;
+    u64     memory_requirement;
+    u64     seed;
+
+    u64     length;
+    u64     size;
+    u32     free;
+    u32     hand;
+
+    u64     hits;
+    u64     misses;
+    u64     insertions;
+    u64     evictions;
+
+    cache_evict_function_t  evict;
+    void*                   evict_args;
+
+    bool    owns_memory;
+
+    u32*    buckets;
+    void*   slots;
+}
+state_t;
+
+/**
+ * @brief Computes the number of buckets for a given capacity.
+ *
+ * The number of buckets is always a power of two, so that a hash can be
+ * reduced to a bucket index with a mask instead of a modulo.
+ *
+ * @param capacity The maximum number of entries.
+ * @return The number of buckets.
+ */
+u64
+cache_bucket_count
+(   const u64 capacity
+);
+
+/**
+ * @brief Retrieves a slot of the cache content.
+ *
+ * @param state Internal state arguments.
+ * @param index The slot index.
+ * @return The slot at index.
+ */
+slot_t*
+cache_slot
+(   const state_t*  state
+,   const u32       index
+);
+
+/**
+ * @brief Retrieves the key of a slot.
+ *
+ * @param slot The slot. Must be non-zero.
+ * @return The address of the slot key.
+ */
+void*
+cache_slot_key
+(   const slot_t* slot
+);
+
+/**
+ * @brief Retrieves the value of a slot.
+ *
+ * @param state Internal state arguments.
+ * @param slot The slot. Must be non-zero.
+ * @return The address of the slot value.
+ */
+void*
+cache_slot_value
+(   const state_t*  state
+,   const slot_t*   slot
+);
+
+/**
+ * @brief Searches a cache for a key.
+ *
+ * @param state Internal state arguments.
+ * @param key The key to search for.
+ * @param key_length The length of key in bytes.
+ * @param hash The hash of key.
+ * @param link Output buffer for the address of the link which refers to the
+ * slot holding the key (for unlinking). Pass 0 to ignore.
+ * @return The index of the slot holding the key, or CACHE_NONE if it is not
+ * present.
+ */
+u32
+cache_find
+(   const state_t*  state
+,   const void*     key
+,   const u64       key_length
+,   const u64       hash
+,   u32**           link
+);
+
+/**
+ * @brief Removes an entry from a cache, optionally invoking the eviction
+ * callback on its value.
+ *
+ * @param state Internal state arguments.
+ * @param index The index of the slot holding the entry.
+ * @param link The address of the link which refers to the slot, or 0 to
+ * search the bucket for it.
+ * @param discard Invoke the eviction callback?
+ */
+void
+cache_release
+(   state_t*    state
+,   const u32   index
+,   u32*        link
+,   const bool  discard
+);
+
+/**
+ * @brief Evicts the entry under the CLOCK hand which was least recently used,
+ * advancing the hand past it.
+ *
+ * Entries which were used since the hand last passed them are given a second
+ * chance: their referenced flag is cleared, and the hand moves on. The search
+ * therefore ends within two sweeps.
+ *
+ * @param state The cache state. Must hold at least one entry besides keep.
+ * @param keep The index of a slot which must not be evicted, or CACHE_NONE.
+ */
+void
+cache_evict_one
+(   state_t*    state
+,   const u32   keep
+);
+
+/**
+ * @brief Empties a cache without invoking the eviction callback.
+ *
+ * @param state Internal state arguments.
+ */
+void
+cache_reset
+(   state_t* state
+);
+
+bool
+cache_create
+(   u64                     stride
+,   u32                     capacity
+,   u32                     key_capacity
+,   u64                     budget
+,   cache_evict_function_t  evict
+,   void*                   evict_args
+,   u64*                    memory_requirement_
+,   void*                   memory_
+,   cache_t**               cache
+)
+{
+    if ( !capacity || !stride || capacity == CACHE_NONE )
+    {
+        if ( !capacity )
+        {
+            LOGERROR ( "cache_create: Value of capacity argument must be non-zero." );
+        }
+        if ( !stride )
+        {
+            LOGERROR ( "cache_create: Value of stride argument must be non-zero." );
+        }
+        if ( capacity == CACHE_NONE )
+        {
+            LOGERROR ( "cache_create: Value of capacity argument must be less than %u."
+                     , CACHE_NONE
+                     );
+        }
+        return false;
+    }
+
+    const u64 bucket_count = cache_bucket_count ( capacity );
+    const u64 slot_size = sizeof ( slot_t )
+                        + aligned ( key_capacity , 8 )
+                        + aligned ( stride , 8 )
+                        ;
+    const u64 memory_requirement = sizeof ( state_t )
+                                 + aligned ( bucket_count * sizeof ( u32 ) , 8 )
+                                 + capacity * slot_size
+                                 ;
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_uninit ( memory_requirement , MEMORY_TAG_HASHTABLE );
+    }
+
+    if ( !cache )
+    {
+        LOGERROR ( "cache_create: Missing argument: cache (output buffer)." );
+        if ( !memory_ )
+        {
+            memory_free ( memory , memory_requirement , MEMORY_TAG_HASHTABLE );
+        }
+        return false;
+    }
+
+    memory_clear ( memory , memory_requirement );
+
+    state_t* state = memory;
+    ( *state ).stride = stride;
+    ( *state ).capacity = capacity;
+    ( *state ).key_capacity = key_capacity;
+    ( *state ).budget = budget;
+    ( *state ).slot_size = slot_size;
+    ( *state ).bucket_mask = bucket_count - 1;
+    ( *state ).memory_requirement = memory_requirement;
+    ( *state ).seed = ( u64 ) random64 ();
+    ( *state ).evict = evict;
+    ( *state ).evict_args = evict_args;
+    ( *state ).owns_memory = !memory_;
+    ( *state ).buckets = ( u32* )( ( ( u64 ) memory ) + sizeof ( state_t ) );
+    ( *state ).slots = ( void* )( ( ( u64 ) ( *state ).buckets )
+                                + aligned ( bucket_count * sizeof ( u32 ) , 8 )
+                                );
+    cache_reset ( state );
+
+    *cache = state;
+    return true;
+}
+
+void
+cache_destroy
+(   cache_t** cache
+)
+{
+    if ( !cache )
+    {
+        return;
+    }
+
+    state_t* state = *cache;
+    if ( !state )
+    {
+        return;
+    }
+
+    cache_clear ( state );
+
+    const u64 memory_requirement = ( *state ).memory_requirement;
+    if ( ( *state ).owns_memory )
+    {
+        memory_free ( state , memory_requirement , MEMORY_TAG_HASHTABLE );
+    }
+    else
+    {
+        memory_clear ( state , memory_requirement );
+    }
+
+    *cache = 0;
+}
+
+u64
+cache_capacity
+(   const cache_t* cache
+)
+{
+    return ( *( ( state_t* ) cache ) ).capacity;
+}
+
+u64
+cache_budget
+(   const cache_t* cache
+)
+{
+    return ( *( ( state_t* ) cache ) ).budget;
+}
+
+u64
+cache_length
+(   const cache_t* cache
+)
+{
+    return ( *( ( state_t* ) cache ) ).length;
+}
+
+u64
+cache_size
+(   const cache_t* cache
+)
+{
+    return ( *( ( state_t* ) cache ) ).size;
+}
+
+void
+cache_stats
+(   const cache_t*  cache
+,   cache_stats_t*  stats
+)
+{
+    const state_t* state = cache;
+    ( *stats ).hits = ( *state ).hits;
+    ( *stats ).misses = ( *state ).misses;
+    ( *stats ).insertions = ( *state ).insertions;
+    ( *stats ).evictions = ( *state ).evictions;
+    ( *stats ).length = ( *state ).length;
+    ( *stats ).size = ( *state ).size;
+}
+
+void
+cache_stats_reset
+(   cache_t* cache
+)
+{
+    state_t* state = cache;
+    ( *state ).hits = 0;
+    ( *state ).misses = 0;
+    ( *state ).insertions = 0;
+    ( *state ).evictions = 0;
+}
+
+bool
+_cache_get
+(   cache_t*    cache
+,   const void* key
+,   const u64   key_length
+,   void*       value
+)
+{
+    state_t* state = cache;
+    const u64 hash = hash64 ( key , key_length , ( *state ).seed );
+    const u32 index = cache_find ( state , key , key_length , hash , 0 );
+    if ( index == CACHE_NONE )
+    {
+        ( *state ).misses += 1;
+        return false;
+    }
+
+    ( *state ).hits += 1;
+    slot_t* slot = cache_slot ( state , index );
+    ( *slot ).referenced = true;
+    if ( value )
+    {
+        memory_copy ( value , cache_slot_value ( state , slot ) , ( *state ).stride );
+    }
+    return true;
+}
+
+bool
+_cache_contains
+(   const cache_t*  cache
+,   const void*     key
+,   const u64       key_length
+)
+{
+    const state_t* state = cache;
+    const u64 hash = hash64 ( key , key_length , ( *state ).seed );
+    return cache_find ( state , key , key_length , hash , 0 ) != CACHE_NONE;
+}
+
+bool
+_cache_set
+(   cache_t*    cache
+,   const void* key
+,   const u64   key_length
+,   const void* value
+,   const u64   size
+)
+{
+    state_t* state = cache;
+    if ( !value )
+    {
+        LOGERROR ( "cache_set: Missing argument: value." );
+        return false;
+    }
+    if ( key_length > ( *state ).key_capacity )
+    {
+        LOGERROR ( "cache_set: Key length (%u) exceeds the key capacity of the cache (%u)."
+                 , key_length , ( *state ).key_capacity
+                 );
+        return false;
+    }
+    if ( ( *state ).budget && size > ( *state ).budget )
+    {
+        LOGERROR ( "cache_set: Size of value (%u) exceeds the budget of the cache (%u)."
+                 , size , ( *state ).budget
+                 );
+        return false;
+    }
+
+    const u64 hash = hash64 ( key , key_length , ( *state ).seed );
+    u32 index = cache_find ( state , key , key_length , hash , 0 );
+    slot_t* slot;
+
+    // Overwrite?
+    if ( index != CACHE_NONE )
+    {
+        slot = cache_slot ( state , index );
+        if ( ( *state ).evict )
+        {
+            ( *state ).evict ( ( *state ).evict_args
+                             , cache_slot_key ( slot )
+                             , ( *slot ).key_length
+                             , cache_slot_value ( state , slot )
+                             , ( *slot ).size
+                             );
+        }
+        memory_copy ( cache_slot_value ( state , slot ) , value , ( *state ).stride );
+        ( *state ).size = ( *state ).size - ( *slot ).size + size;
+        ( *slot ).size = size;
+        ( *slot ).referenced = true;
+
+        // A larger value may push the cache over budget; evict others to make
+        // room, never the value which was just set.
+        while ( ( *state ).budget && ( *state ).size > ( *state ).budget )
+        {
+            cache_evict_one ( state , index );
+        }
+        return true;
+    }
+
+    // Make room. An empty cache always fits the new entry, since its size
+    // is within the budget.
+    while ( ( *state ).length == ( *state ).capacity
+            || ( ( *state ).budget && ( *state ).size + size > ( *state ).budget )
+          )
+    {
+        cache_evict_one ( state , CACHE_NONE );
+    }
+
+    index = ( *state ).free;
+    slot = cache_slot ( state , index );
+    ( *state ).free = ( *slot ).next;
+
+    u32* bucket = &( *state ).buckets[ hash & ( *state ).bucket_mask ];
+    ( *slot ).hash = hash;
+    ( *slot ).key_length = key_length;
+    ( *slot ).size = size;
+    ( *slot ).next = *bucket;
+    ( *slot ).occupied = true;
+    ( *slot ).referenced = true;
+    *bucket = index;
+
+    memory_copy ( cache_slot_key ( slot ) , key , key_length );
+    memory_copy ( cache_slot_value ( state , slot ) , value , ( *state ).stride );
+
+    ( *state ).length += 1;
+    ( *state ).size += size;
+    ( *state ).insertions += 1;
+    return true;
+}
+
+bool
+_cache_remove
+(   cache_t*    cache
+,   const void* key
+,   const u64   key_length
+,   void*       value
+)
+{
+    state_t* state = cache;
+    const u64 hash = hash64 ( key , key_length , ( *state ).seed );
+    u32* link;
+    const u32 index = cache_find ( state , key , key_length , hash , &link );
+    if ( index == CACHE_NONE )
+    {
+        return false;
+    }
+
+    if ( value )
+    {
+        memory_copy ( value
+                    , cache_slot_value ( state , cache_slot ( state , index ) )
+                    , ( *state ).stride
+                    );
+    }
+    cache_release ( state , index , link , !value );
+    return true;
+}
+
+void
+cache_clear
+(   cache_t* cache
+)
+{
+    state_t* state = cache;
+    if ( ( *state ).evict && ( *state ).length )
+    {
+        for ( u32 i = 0; i < ( *state ).capacity; ++i )
+        {
+            slot_t* slot = cache_slot ( state , i );
+            if ( !( *slot ).occupied )
+            {
+                continue;
+            }
+            ( *state ).evict ( ( *state ).evict_args
+                             , cache_slot_key ( slot )
+                             , ( *slot ).key_length
+                             , cache_slot_value ( state , slot )
+                             , ( *slot ).size
+                             );
+        }
+    }
+    cache_reset ( state );
+}
+
+u64
+cache_bucket_count
+(   const u64 capacity
+)
+{
+    return ( capacity > 1 ) ? ( ( u64 ) 1 ) << ( bitscan_reverse ( capacity - 1 ) + 1 )
+                            : 1
+                            ;
+}
+
+slot_t*
+cache_slot
+(   const state_t*  state
+,   const u32       index
+)
+{
+    return ( slot_t* )( ( ( u64 ) ( *state ).slots ) + index * ( *state ).slot_size );
+}
+
+void*
+cache_slot_key
+(   const slot_t* slot
+)
+{
+    return ( void* )( ( ( u64 ) slot ) + sizeof ( slot_t ) );
+}
+
+void*
+cache_slot_value
+(   const state_t*  state
+,   const slot_t*   slot
+)
+{
+    return ( void* )( ( ( u64 ) slot ) + sizeof ( slot_t )
+                    + aligned ( ( *state ).key_capacity , 8 )
+                    );
+}
+
+u32
+cache_find
+(   const state_t*  state
+,   const void*     key
+,   const u64       key_length
+,   const u64       hash
+,   u32**           link
+)
+{
+    u32* link_ = &( *state ).buckets[ hash & ( *state ).bucket_mask ];
+    while ( *link_ != CACHE_NONE )
+    {
+        slot_t* slot = cache_slot ( state , *link_ );
+        if ( ( *slot ).hash == hash
+             && ( *slot ).key_length == key_length
+             && memory_equal ( cache_slot_key ( slot ) , key , key_length )
+           )
+        {
+            if ( link )
+            {
+                *link = link_;
+            }
+            return *link_;
+        }
+        link_ = &( *slot ).next;
+    }
+    return CACHE_NONE;
+}
+
+void
+cache_release
+(   state_t*    state
+,   const u32   index
+,   u32*        link
+,   const bool  discard
+)
+{
+    slot_t* slot = cache_slot ( state , index );
+    if ( discard && ( *state ).evict )
+    {
+        ( *state ).evict ( ( *state ).evict_args
+                         , cache_slot_key ( slot )
+                         , ( *slot ).key_length
+                         , cache_slot_value ( state , slot )
+                         , ( *slot ).size
+                         );
+    }
+
+    if ( !link )
+    {
+        link = &( *state ).buckets[ ( *slot ).hash & ( *state ).bucket_mask ];
+        while ( *link != index )
+        {
+            link = &( *cache_slot ( state , *link ) ).next;
+        }
+    }
+    *link = ( *slot ).next;
+
+    ( *state ).length -= 1;
+    ( *state ).size -= ( *slot ).size;
+
+    ( *slot ).occupied = false;
+    ( *slot ).referenced = false;
+    ( *slot ).next = ( *state ).free;
+    ( *state ).free = index;
+}
+
+void
+cache_evict_one
+(   state_t*    state
+,   const u32   keep
+)
+{
+    for (;;)
+    {
+        const u32 index = ( *state ).hand;
+        ( *state ).hand = ( index + 1 == ( *state ).capacity ) ? 0 : index + 1;
+
+        slot_t* slot = cache_slot ( state , index );
+        if ( !( *slot ).occupied || index == keep )
+        {
+            continue;
+        }
+        if ( ( *slot ).referenced )
+        {
+            ( *slot ).referenced = false;
+            continue;
+        }
+
+        cache_release ( state , index , 0 , true );
+        ( *state ).evictions += 1;
+        return;
+    }
+}
+
+void
+cache_reset
+(   state_t* state
+)
+{
+    const u64 bucket_count = ( *state ).bucket_mask + 1;
+    for ( u64 i = 0; i < bucket_count; ++i )
+    {
+        ( *state ).buckets[ i ] = CACHE_NONE;
+    }
+    for ( u32 i = 0; i < ( *state ).capacity; ++i )
+    {
+        slot_t* slot = cache_slot ( state , i );
+        ( *slot ).occupied = false;
+        ( *slot ).referenced = false;
+        ( *slot ).next = ( i + 1 < ( *state ).capacity ) ? i + 1 : CACHE_NONE;
+    }
+    ( *state ).free = 0;
+    ( *state ).hand = 0;
+    ( *state ).length = 0;
+    ( *state ).size = 0;
+}
@@ -0,0 +1,370 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/cache.h
+ * @brief Provides an interface for a bounded key-value cache with CLOCK
+ * eviction.
+ *
+ * A cache is a hashtable (see container/hashtable.h) which holds at most a
+ * fixed number of entries and, optionally, at most a fixed number of bytes.
+ * Inserting an entry which would exceed either bound first evicts entries
+ * which have not been used recently, chosen by the CLOCK algorithm: a hand
+ * sweeps over the entries, evicting the first one which has not been read or
+ * written since the hand last passed it. This approximates least-recently-used
+ * eviction in O(1) amortized time, without reordering a list on every hit.
+ *
+ *   cache_t* textures;
+ *   cache_create ( sizeof ( texture_t* ) , 256 , 64 , MiB ( 512 )
+ *                , texture_evict , 0 , 0 , 0 , &textures
+ *                );
+ *   texture_t* texture;
+ *   if ( !cache_get ( textures , path , &texture ) )
+ *   {
+ *       texture = texture_load ( path );
+ *       cache_set ( textures , path , &texture , texture_size ( texture ) );
+ *   }
+ *
+ * Keys are arbitrary binary strings of up to a fixed length, and are copied
+ * into the cache; values are copied in and out. Each entry is charged a
+ * caller-specified number of bytes against the byte budget, so the budget may
+ * account for memory which the values own (e.g. the texture above), rather
+ * than only for the cache itself. An eviction callback is invoked on each
+ * value which the cache discards, so that it can release what the value owns.
+ *
+ * All memory is allocated once, on creation, so a cache may be carved out of a
+ * pre-allocated buffer (e.g. from memory/linear_allocator.h).
+ *
+ * Not thread-safe; for a cache shared between threads, guard each call with a
+ * lock (see platform/lock.h), or see container/concurrent_hashtable.h.
+ */
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "common.h"
+
+#include "core/string.h"
+
+/** @brief Type declaration for a cache. */
+typedef void cache_t;
+
+/**
+ * @brief Type definition for an eviction callback.
+ *
+ * Invoked on each value which a cache discards: on eviction, when a value is
+ * overwritten by cache_set, when a key is removed without retrieving its value,
+ * and on cache_clear and cache_destroy. Must not access the cache.
+ *
+ * @param args The eviction arguments passed to cache_create.
+ * @param key The key of the discarded value.
+ * @param key_length The length of key in bytes.
+ * @param value The address of the discarded value (owned by the cache).
+ * @param size The number of bytes the value was charged (see cache_set).
+ */
+typedef void ( *cache_evict_function_t )( void*         args
+                                        , const void*   key
+                                        , u64           key_length
+                                        , void*         value
+                                        , u64           size
+                                        );
+
+/** @brief Type definition for a container to hold cache usage statistics. */
+typedef struct
+{
+    // Number of queries which found their key, and which did not.
+    u64 hits;
+    u64 misses;
+
+    // Number of keys inserted (not counting overwrites).
+    u64 insertions;
+
+    // Number of entries evicted to make room for others.
+    u64 evictions;
+
+    // Current number of entries, and the sum of their charged sizes.
+    u64 length;
+    u64 size;
+}
+cache_stats_t;
+
+/**
+ * @brief Initializes a cache.
+ *
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size.
+ *
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h). Call cache_destroy to
+ *   free.
+ *
+ * Either way, the cache never allocates memory after it is created.
+ *
+ * @param stride The size of each value in bytes. Must be non-zero.
+ * @param capacity The maximum number of entries. Must be non-zero.
+ * @param key_capacity The maximum key length in bytes.
+ * @param budget The maximum sum of the sizes charged to the entries (see
+ * cache_set). Pass 0 to bound the number of entries only.
+ * @param evict The eviction callback. Pass 0 for none.
+ * @param evict_args Arguments passed to evict.
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required to operate the cache. Only applicable if pre-allocating a memory
+ * buffer of the required size. Pass 0 to use implicit memory allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @param cache Output buffer for cache.
+ * @return true on success; false otherwise.
+ */
+bool
+cache_create
+(   u64                     stride
+,   u32                     capacity
+,   u32                     key_capacity
+,   u64                     budget
+,   cache_evict_function_t  evict
+,   void*                   evict_args
+,   u64*                    memory_requirement
+,   void*                   memory
+,   cache_t**               cache
+);
+
+/**
+ * @brief Frees the memory used by a cache, invoking the eviction callback on
+ * each value it still holds.
+ *
+ * If the cache was not pre-allocated, this function will free the memory
+ * implicitly (see core/memory.h).
+ *
+ * @param cache Handle to the cache to free.
+ */
+void
+cache_destroy
+(   cache_t** cache
+);
+
+/**
+ * @brief Queries the maximum number of entries a cache may hold.
+ *
+ * @param cache The cache to query. Must be non-zero.
+ * @return The capacity of cache.
+ */
+u64
+cache_capacity
+(   const cache_t* cache
+);
+
+/**
+ * @brief Queries the maximum sum of the sizes charged to the entries of a
+ * cache.
+ *
+ * @param cache The cache to query. Must be non-zero.
+ * @return The byte budget of cache, or 0 if it has none.
+ */
+u64
+cache_budget
+(   const cache_t* cache
+);
+
+/**
+ * @brief Queries the number of entries in a cache.
+ *
+ * @param cache The cache to query. Must be non-zero.
+ * @return The number of entries.
+ */
+u64
+cache_length
+(   const cache_t* cache
+);
+
+/**
+ * @brief Queries the sum of the sizes charged to the entries of a cache.
+ *
+ * @param cache The cache to query. Must be non-zero.
+ * @return The size of cache (in bytes).
+ */
+u64
+cache_size
+(   const cache_t* cache
+);
+
+/**
+ * @brief Queries the usage statistics of a cache.
+ *
+ * @param cache The cache to query. Must be non-zero.
+ * @param stats Output buffer for the statistics. Must be non-zero.
+ */
+void
+cache_stats
+(   const cache_t*  cache
+,   cache_stats_t*  stats
+);
+
+/**
+ * @brief Resets the hit, miss, insertion and eviction counters of a cache.
+ *
+ * @param cache The cache to mutate. Must be non-zero.
+ */
+void
+cache_stats_reset
+(   cache_t* cache
+);
+
+/**
+ * @brief Queries a cache value, and marks the entry as recently used. O(1).
+ *
+ * Use _cache_get to explicitly specify key length, cache_get to compute the
+ * length of a null-terminated key, or cache_get_view to pass the key as a
+ * string view (see core/string.h).
+ *
+ * @param cache The cache to query. Must be non-zero.
+ * @param key The key whose value will be read. Must be non-zero if key_length
+ * is non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value Output buffer for the value. Only written to if the key is
+ * present within the cache. Pass 0 to retrieve nothing.
+ * @return true if the key is present within the cache (a hit); false
+ * otherwise (a miss).
+ */
+bool
+_cache_get
+(   cache_t*    cache
+,   const void* key
+,   const u64   key_length
+,   void*       value
+);
+
+#define cache_get(cache,key,value)                                        \
+    ({                                                                    \
+        const char* key__ = (key);                                        \
+        _cache_get ( (cache) , key__ , _string_length ( key__ ) , (value) ); \
+    })
+
+#define cache_get_view(cache,key,value)                                   \
+    ({                                                                    \
+        const string_view_t key__ = (key);                                \
+        _cache_get ( (cache) , key__.string , key__.length , (value) );   \
+    })
+
+/**
+ * @brief Queries whether a key is present within a cache, without marking the
+ * entry as recently used or counting a hit or miss. O(1).
+ *
+ * @param cache The cache to query. Must be non-zero.
+ * @param key The key to search for. Must be non-zero if key_length is
+ * non-zero.
+ * @param key_length The length of key in bytes.
+ * @return true if the key is present within the cache; false otherwise.
+ */
+bool
+_cache_contains
+(   const cache_t*  cache
+,   const void*     key
+,   const u64       key_length
+);
+
+#define cache_contains(cache,key)                                         \
+    ({                                                                    \
+        const char* key__ = (key);                                        \
+        _cache_contains ( (cache) , key__ , _string_length ( key__ ) );   \
+    })
+
+#define cache_contains_view(cache,key)                                    \
+    ({                                                                    \
+        const string_view_t key__ = (key);                                \
+        _cache_contains ( (cache) , key__.string , key__.length );        \
+    })
+
+/**
+ * @brief Sets a cache value, and marks the entry as recently used. Inserts
+ * the key if it is not already present, evicting entries as needed to stay
+ * within the capacity and budget. O(1), on average.
+ *
+ * Use _cache_set to explicitly specify key length, cache_set to compute the
+ * length of a null-terminated key, or cache_set_view to pass the key as a
+ * string view (see core/string.h).
+ *
+ * @param cache The cache to mutate. Must be non-zero.
+ * @param key The key whose value will be set. Must be non-zero if key_length
+ * is non-zero.
+ * @param key_length The length of key in bytes. Must not exceed the key
+ * capacity.
+ * @param value The address of the value to copy in. Must be non-zero.
+ * @param size The number of bytes to charge the entry against the budget.
+ * Must not exceed the budget.
+ * @return true on success; false otherwise.
+ */
+bool
+_cache_set
+(   cache_t*    cache
+,   const void* key
+,   const u64   key_length
+,   const void* value
+,   const u64   size
+);
+
+#define cache_set(cache,key,value,size)                                   \
+    ({                                                                    \
+        const char* key__ = (key);                                        \
+        _cache_set ( (cache) , key__ , _string_length ( key__ ) , (value) \
+                   , (size)                                               \
+                   );                                                     \
+    })
+
+#define cache_set_view(cache,key,value,size)                              \
+    ({                                                                    \
+        const string_view_t key__ = (key);                                \
+        _cache_set ( (cache) , key__.string , key__.length , (value)      \
+                   , (size)                                               \
+                   );                                                     \
+    })
+
+/**
+ * @brief Removes a key and its value from a cache. O(1), on average.
+ *
+ * Use _cache_remove to explicitly specify key length, cache_remove to compute
+ * the length of a null-terminated key, or cache_remove_view to pass the key as
+ * a string view (see core/string.h).
+ *
+ * @param cache The cache to mutate. Must be non-zero.
+ * @param key The key to remove. Must be non-zero if key_length is non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value Output buffer for the value of the removed key; the caller
+ * takes over anything it owns. Pass 0 to discard the value (invoking the
+ * eviction callback) instead.
+ * @return true if the key was present within the cache; false otherwise.
+ */
+bool
+_cache_remove
+(   cache_t*    cache
+,   const void* key
+,   const u64   key_length
+,   void*       value
+);
+
+#define cache_remove(cache,key,value)                                     \
+    ({                                                                    \
+        const char* key__ = (key);                                        \
+        _cache_remove ( (cache) , key__ , _string_length ( key__ )        \
+                      , (value)                                           \
+                      );                                                  \
+    })
+
+#define cache_remove_view(cache,key,value)                                \
+    ({                                                                    \
+        const string_view_t key__ = (key);                                \
+        _cache_remove ( (cache) , key__.string , key__.length , (value) ); \
+    })
+
+/**
+ * @brief Removes every entry from a cache, invoking the eviction callback on
+ * each value. O(capacity).
+ *
+ * Does not reset the statistics (see cache_stats_reset).
+ *
+ * @param cache The cache to clear. Must be non-zero.
+ */
+void
+cache_clear
+(   cache_t* cache
+);
+
+#endif  // CACHE_H
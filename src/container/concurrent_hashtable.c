@@ -0,0 +1,1080 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/concurrent_hashtable.c
+ * @brief Implementation of the container/concurrent_hashtable header.
+ * (see container/concurrent_hashtable.h for additional details)
+ */
+#include "container/concurrent_hashtable.h"
+
+#include "container/array.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+#include "platform/lock.h"
+
+/**
+ * @brief Number of counters across which queries announce their epoch. Each
+ * thread always uses the same counter, and each counter has a cache line of
+ * its own, so concurrent queries from different threads rarely contend.
+ */
+#define CONCURRENT_HASHTABLE_READER_SLOT_COUNT 16
+
+/**
+ * @brief Alignment of each entry and table (in bytes). The memory subsystem
+ * does not otherwise align blocks, and the links within them are accessed
+ * atomically.
+ */
+#define CONCURRENT_HASHTABLE_ALIGNMENT 8
+
+/**
+ * @brief Type definition for a hashtable entry. The key is stored directly
+ * after the entry header, and the value after the key (aligned to 8 bytes).
+ *
+ * Only next may change once an entry has been linked into a bucket; setting a
+ * key's value replaces its entry.
+ */
+typedef struct entry_t
+{
+    struct entry_t* next;
+    u64             hash;
+    u64             key_length;
+}
+entry_t;
+
+/**
+ * @brief Type definition for a table of buckets.
+ *
+ * While the hashtable is resizing, the table being resized links to the table
+ * which replaces it, and each of its buckets is replaced by
+ * concurrent_hashtable_moved once its entries have been copied across.
+ */
+typedef struct table_t
+{
+    struct table_t* next;
+    u64             bucket_count;
+
+    // Next bucket to be claimed for migration to the next table.
+    u64             migrate_next;
+
+    // Number of buckets which have been migrated to the next table.
+    u64             migrated;
+
+    entry_t*        buckets[];
+}
+table_t;
+
+/** @brief Type definition for memory awaiting reclamation. */
+typedef struct
+{
+    void*   memory;
+    u64     size;
+
+    // The epoch the memory was retired in.
+    u64     epoch;
+}
+retired_t;
+
+/** @brief Type definition for a lock stripe. */
+typedef struct
+{
+    lock_t      lock;
+    u32         padding0;
+
+    // Retired memory, in order of retirement (so also in order of epoch).
+    // Guarded by lock.
+    retired_t*  retired;
+    u64         retired_size;
+
+    u8          padding1[ CACHE_LINE_SIZE - 3 * sizeof ( u64 ) ];
+}
+stripe_t;
+
+/**
+ * @brief Type definition for a reader slot: the number of queries in progress
+ * which started in an even or an odd epoch, respectively.
+ */
+typedef struct
+{
+    u64 count[ 2 ];
+    u8  padding[ CACHE_LINE_SIZE - 2 * sizeof ( u64 ) ];
+}
+reader_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    // Read-only after initialization.
+    u64             stride;
+    u64             seed;
+    hash_function_t hash_function;
+
+    // Read by every operation, but rarely written.
+    table_t*        table;
+    u64             epoch;
+
+    u8              padding0[ CACHE_LINE_SIZE - 4 * sizeof ( u64 ) - sizeof ( hash_function_t ) ];
+
+    // Written by every insertion and removal.
+    u64             length;
+    u8              padding1[ CACHE_LINE_SIZE - sizeof ( u64 ) ];
+
+    stripe_t        stripes[ CONCURRENT_HASHTABLE_STRIPE_COUNT ];
+    reader_t        readers[ CONCURRENT_HASHTABLE_READER_SLOT_COUNT ];
+}
+state_t;
+
+/**
+ * @brief Type definition for a container to hold the kind of mutation
+ * performed by _concurrent_hashtable_mutate.
+ */
+typedef enum
+{
+    CONCURRENT_HASHTABLE_SET
+,   CONCURRENT_HASHTABLE_INSERT
+,   CONCURRENT_HASHTABLE_REMOVE
+}
+CONCURRENT_HASHTABLE_MUTATION;
+
+/** @brief Placeholder for a bucket which has been migrated to the next table. */
+static entry_t concurrent_hashtable_moved;
+
+/** @brief Source of reader slot assignments (shared by every hashtable). */
+static u32 concurrent_hashtable_next_slot = 0;
+
+/** @brief Reader slot of the calling thread, plus one; zero if unassigned. */
+static THREAD_LOCAL u32 concurrent_hashtable_slot = 0;
+
+/**
+ * @brief Atomically loads a link to an entry.
+ *
+ * @param link The link to load.
+ * @param order The memory order.
+ * @return The entry link points to.
+ */
+INLINE
+entry_t*
+_concurrent_hashtable_load
+(   entry_t* const*     link
+,   const ATOMIC_ORDER  order
+)
+{
+    return atomic_load_ptr ( ( void* const* ) link , order );
+}
+
+/**
+ * @brief Atomically stores a link to an entry.
+ *
+ * @param link The link to store to.
+ * @param entry The entry to link to.
+ * @param order The memory order.
+ */
+INLINE
+void
+_concurrent_hashtable_store
+(   entry_t**           link
+,   entry_t*            entry
+,   const ATOMIC_ORDER  order
+)
+{
+    atomic_store_ptr ( ( void** ) link , entry , order );
+}
+
+/**
+ * @brief Computes the size of a hashtable entry.
+ *
+ * @param key_length The length of the key in bytes.
+ * @param stride The size of the value in bytes.
+ * @return The size of an entry (in bytes).
+ */
+INLINE
+u64
+_concurrent_hashtable_entry_size
+(   const u64   key_length
+,   const u64   stride
+)
+{
+    return sizeof ( entry_t ) + aligned ( key_length , sizeof ( u64 ) ) + stride;
+}
+
+/**
+ * @brief Obtains the value of a hashtable entry.
+ *
+ * @param entry The entry.
+ * @return The address of the value.
+ */
+INLINE
+void*
+_concurrent_hashtable_entry_value
+(   const entry_t* entry
+)
+{
+    return ( ( u8* )( entry + 1 ) ) + aligned ( ( *entry ).key_length , sizeof ( u64 ) );
+}
+
+/**
+ * @brief Does a hashtable entry hold a key? Y/N
+ *
+ * @param entry The entry.
+ * @param hash The hash of key.
+ * @param key The key.
+ * @param key_length The length of key in bytes.
+ * @return true if entry holds key; false otherwise.
+ */
+INLINE
+bool
+_concurrent_hashtable_entry_match
+(   const entry_t*  entry
+,   const u64       hash
+,   const void*     key
+,   const u64       key_length
+)
+{
+    return ( *entry ).hash == hash
+        && ( *entry ).key_length == key_length
+        && memory_equal ( entry + 1 , key , key_length )
+        ;
+}
+
+/**
+ * @brief Computes the size of a table.
+ *
+ * @param bucket_count The number of buckets.
+ * @return The size of a table with bucket_count buckets (in bytes).
+ */
+INLINE
+u64
+_concurrent_hashtable_table_size
+(   const u64 bucket_count
+)
+{
+    return sizeof ( table_t ) + bucket_count * sizeof ( entry_t* );
+}
+
+/**
+ * @brief Allocates an empty table.
+ *
+ * @param bucket_count The number of buckets. Must be a power of two.
+ * @return An empty table.
+ */
+table_t*
+_concurrent_hashtable_table_create
+(   const u64 bucket_count
+);
+
+/**
+ * @brief Announces that the calling thread has started a query (or a
+ * mutation), so nothing it may read is reclaimed until it has finished.
+ *
+ * @param state Internal state.
+ * @return A handle to pass to _concurrent_hashtable_leave.
+ */
+u64*
+_concurrent_hashtable_enter
+(   state_t* state
+);
+
+/**
+ * @brief Announces that the calling thread has finished a query (or a
+ * mutation).
+ *
+ * @param reader The handle returned by _concurrent_hashtable_enter.
+ */
+INLINE
+void
+_concurrent_hashtable_leave
+(   u64* reader
+)
+{
+    atomic_fetch_sub_u64 ( reader , 1 , ATOMIC_RELEASE );
+}
+
+/**
+ * @brief Advances the epoch, if no query which started in the previous epoch
+ * is still in progress.
+ *
+ * @param state Internal state.
+ */
+void
+_concurrent_hashtable_advance
+(   state_t* state
+);
+
+/**
+ * @brief Retires memory which has been unlinked from the hashtable, to be
+ * freed once no query can still be reading it.
+ *
+ * Requires: the stripe lock is held.
+ *
+ * @param state Internal state.
+ * @param stripe The lock stripe which retires the memory.
+ * @param memory The memory to retire.
+ * @param size The size of memory (in bytes).
+ */
+void
+_concurrent_hashtable_retire
+(   state_t*    state
+,   stripe_t*   stripe
+,   void*       memory
+,   const u64   size
+);
+
+/**
+ * @brief Frees the retired memory of a lock stripe which no query can still
+ * be reading.
+ *
+ * Requires: the stripe lock is held.
+ *
+ * @param state Internal state.
+ * @param stripe The lock stripe.
+ */
+void
+_concurrent_hashtable_collect
+(   state_t*    state
+,   stripe_t*   stripe
+);
+
+/**
+ * @brief Migrates a bucket of a table which is being resized to the next
+ * table, and retires the table once every bucket has been migrated.
+ *
+ * Requires: the stripe lock of the bucket is held.
+ *
+ * @param state Internal state.
+ * @param table The table being resized.
+ * @param index The index of the bucket to migrate.
+ */
+void
+_concurrent_hashtable_migrate
+(   state_t*    state
+,   table_t*    table
+,   const u64   index
+);
+
+/**
+ * @brief Obtains the table a key may be mutated in, first migrating the
+ * key's bucket out of any table which is being resized.
+ *
+ * Requires: the stripe lock of the key is held.
+ *
+ * @param state Internal state.
+ * @param hash The hash of the key.
+ * @return The newest table.
+ */
+table_t*
+_concurrent_hashtable_writable
+(   state_t*    state
+,   const u64   hash
+);
+
+/**
+ * @brief Performs an increment of work on a resize: migrates up to
+ * CONCURRENT_HASHTABLE_MIGRATE_COUNT buckets if one is in progress, or starts
+ * one if the hashtable is full.
+ *
+ * Requires: no stripe lock is held.
+ *
+ * @param state Internal state.
+ */
+void
+_concurrent_hashtable_help
+(   state_t* state
+);
+
+/**
+ * @brief Implementation of _concurrent_hashtable_set,
+ * _concurrent_hashtable_insert and _concurrent_hashtable_remove.
+ *
+ * @param state Internal state.
+ * @param key The key.
+ * @param key_length The length of key in bytes.
+ * @param value The value to copy in or out.
+ * @param mutation The kind of mutation.
+ * @return true if the hashtable was mutated; false otherwise.
+ */
+bool
+_concurrent_hashtable_mutate
+(   state_t*                        state
+,   const void*                     key
+,   const u64                       key_length
+,   void*                           value
+,   CONCURRENT_HASHTABLE_MUTATION   mutation
+);
+
+bool
+_concurrent_hashtable_create
+(   u64                         stride
+,   u64                         capacity
+,   hash_function_t             hash_function
+,   u64                         seed
+,   concurrent_hashtable_t**    hashtable
+)
+{
+    if ( !stride || !hashtable )
+    {
+        if ( !stride )
+        {
+            LOGERROR ( "_concurrent_hashtable_create: Value of stride argument must be non-zero." );
+        }
+        if ( !hashtable )
+        {
+            LOGERROR ( "_concurrent_hashtable_create: Missing argument: hashtable (output buffer)." );
+        }
+        return false;
+    }
+
+    // Round the bucket count up to a power of two, so buckets can be indexed
+    // with a mask, and so every bucket of a table maps to a single bucket of
+    // the table it is resized from. There are at least as many buckets as
+    // stripes, so each bucket (and each bucket it is migrated to) is guarded
+    // by a single stripe.
+    u64 bucket_count = MAX ( capacity , ( u64 ) CONCURRENT_HASHTABLE_STRIPE_COUNT );
+    if ( bucket_count & ( bucket_count - 1 ) )
+    {
+        bucket_count = ( ( u64 ) 1 ) << ( bitscan_reverse ( bucket_count ) + 1 );
+    }
+
+    state_t* state = memory_allocate_aligned ( sizeof ( state_t )
+                                             , CACHE_LINE_SIZE
+                                             , MEMORY_TAG_HASHTABLE
+                                             );
+    ( *state ).stride = stride;
+    ( *state ).seed = seed;
+    ( *state ).hash_function = ( hash_function ) ? hash_function : hash64;
+    ( *state ).table = _concurrent_hashtable_table_create ( bucket_count );
+
+    *hashtable = state;
+    return true;
+}
+
+void
+concurrent_hashtable_destroy
+(   concurrent_hashtable_t** hashtable
+)
+{
+    if ( !hashtable || !*hashtable )
+    {
+        return;
+    }
+    state_t* state = *hashtable;
+
+    // Free every live entry. Migrated buckets have been emptied; their
+    // entries were retired.
+    table_t* table = ( *state ).table;
+    while ( table )
+    {
+        for ( u64 i = 0; i < ( *table ).bucket_count; ++i )
+        {
+            entry_t* entry = ( *table ).buckets[ i ];
+            if ( entry == &concurrent_hashtable_moved )
+            {
+                continue;
+            }
+            while ( entry )
+            {
+                entry_t* next = ( *entry ).next;
+                memory_free_aligned ( entry
+                                    , _concurrent_hashtable_entry_size ( ( *entry ).key_length
+                                                                       , ( *state ).stride
+                                                                       )
+                                    , CONCURRENT_HASHTABLE_ALIGNMENT
+                                    , MEMORY_TAG_HASHTABLE
+                                    );
+                entry = next;
+            }
+        }
+        table_t* next = ( *table ).next;
+        memory_free_aligned ( table
+                            , _concurrent_hashtable_table_size ( ( *table ).bucket_count )
+                            , CONCURRENT_HASHTABLE_ALIGNMENT
+                            , MEMORY_TAG_HASHTABLE
+                            );
+        table = next;
+    }
+
+    // Free every retired entry (and table).
+    for ( u64 i = 0; i < CONCURRENT_HASHTABLE_STRIPE_COUNT; ++i )
+    {
+        retired_t* retired = ( *state ).stripes[ i ].retired;
+        if ( !retired )
+        {
+            continue;
+        }
+        for ( u64 j = 0; j < array_length ( retired ); ++j )
+        {
+            memory_free_aligned ( retired[ j ].memory
+                                , retired[ j ].size
+                                , CONCURRENT_HASHTABLE_ALIGNMENT
+                                , MEMORY_TAG_HASHTABLE
+                                );
+        }
+        array_destroy ( retired );
+    }
+
+    memory_free_aligned ( state
+                        , sizeof ( state_t )
+                        , CACHE_LINE_SIZE
+                        , MEMORY_TAG_HASHTABLE
+                        );
+    *hashtable = 0;
+}
+
+u64
+concurrent_hashtable_stride
+(   const concurrent_hashtable_t* hashtable
+)
+{
+    return ( *( ( const state_t* ) hashtable ) ).stride;
+}
+
+u64
+concurrent_hashtable_capacity
+(   const concurrent_hashtable_t* hashtable
+)
+{
+    state_t* state = ( state_t* ) hashtable;
+    u64* reader = _concurrent_hashtable_enter ( state );
+    table_t* table = atomic_load_ptr ( ( void* const* ) &( *state ).table , ATOMIC_ACQUIRE );
+    for ( table_t* next = table; next; next = atomic_load_ptr ( ( void* const* ) &( *table ).next , ATOMIC_ACQUIRE ) )
+    {
+        table = next;
+    }
+    const u64 capacity = ( *table ).bucket_count;
+    _concurrent_hashtable_leave ( reader );
+    return capacity;
+}
+
+u64
+concurrent_hashtable_length
+(   const concurrent_hashtable_t* hashtable
+)
+{
+    return atomic_load_u64 ( &( *( ( state_t* ) hashtable ) ).length , ATOMIC_RELAXED );
+}
+
+bool
+_concurrent_hashtable_set
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   const void*             value
+)
+{
+    if ( !hashtable || ( key_length && !key ) || !value )
+    {
+        if ( !hashtable )
+        {
+            LOGERROR ( "_concurrent_hashtable_set: Missing argument: hashtable." );
+        }
+        if ( key_length && !key )
+        {
+            LOGERROR ( "_concurrent_hashtable_set: Missing argument: key." );
+        }
+        if ( !value )
+        {
+            LOGERROR ( "_concurrent_hashtable_set: Missing argument: value." );
+        }
+        return false;
+    }
+    return _concurrent_hashtable_mutate ( hashtable
+                                        , key
+                                        , key_length
+                                        , ( void* ) value
+                                        , CONCURRENT_HASHTABLE_SET
+                                        );
+}
+
+bool
+_concurrent_hashtable_insert
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   void*                   value
+)
+{
+    if ( !hashtable || ( key_length && !key ) || !value )
+    {
+        if ( !hashtable )
+        {
+            LOGERROR ( "_concurrent_hashtable_insert: Missing argument: hashtable." );
+        }
+        if ( key_length && !key )
+        {
+            LOGERROR ( "_concurrent_hashtable_insert: Missing argument: key." );
+        }
+        if ( !value )
+        {
+            LOGERROR ( "_concurrent_hashtable_insert: Missing argument: value." );
+        }
+        return false;
+    }
+    return _concurrent_hashtable_mutate ( hashtable
+                                        , key
+                                        , key_length
+                                        , value
+                                        , CONCURRENT_HASHTABLE_INSERT
+                                        );
+}
+
+bool
+_concurrent_hashtable_get
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   void*                   value
+)
+{
+    if ( !hashtable || ( key_length && !key ) )
+    {
+        if ( !hashtable )
+        {
+            LOGERROR ( "_concurrent_hashtable_get: Missing argument: hashtable." );
+        }
+        if ( key_length && !key )
+        {
+            LOGERROR ( "_concurrent_hashtable_get: Missing argument: key." );
+        }
+        return false;
+    }
+    state_t* state = hashtable;
+    const u64 hash = ( *state ).hash_function ( key , key_length , ( *state ).seed );
+
+    u64* reader = _concurrent_hashtable_enter ( state );
+
+    // Follow the bucket to the newest table it has been migrated to.
+    table_t* table = atomic_load_ptr ( ( void* const* ) &( *state ).table , ATOMIC_ACQUIRE );
+    entry_t* entry = _concurrent_hashtable_load ( &( *table ).buckets[ hash & ( ( *table ).bucket_count - 1 ) ]
+                                                , ATOMIC_ACQUIRE
+                                                );
+    while ( entry == &concurrent_hashtable_moved )
+    {
+        table = atomic_load_ptr ( ( void* const* ) &( *table ).next , ATOMIC_ACQUIRE );
+        entry = _concurrent_hashtable_load ( &( *table ).buckets[ hash & ( ( *table ).bucket_count - 1 ) ]
+                                           , ATOMIC_ACQUIRE
+                                           );
+    }
+
+    while ( entry && !_concurrent_hashtable_entry_match ( entry , hash , key , key_length ) )
+    {
+        entry = _concurrent_hashtable_load ( &( *entry ).next , ATOMIC_ACQUIRE );
+    }
+    if ( entry && value )
+    {
+        memory_copy ( value
+                    , _concurrent_hashtable_entry_value ( entry )
+                    , ( *state ).stride
+                    );
+    }
+
+    _concurrent_hashtable_leave ( reader );
+    return entry;
+}
+
+bool
+_concurrent_hashtable_remove
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   void*                   value
+)
+{
+    if ( !hashtable || ( key_length && !key ) )
+    {
+        if ( !hashtable )
+        {
+            LOGERROR ( "_concurrent_hashtable_remove: Missing argument: hashtable." );
+        }
+        if ( key_length && !key )
+        {
+            LOGERROR ( "_concurrent_hashtable_remove: Missing argument: key." );
+        }
+        return false;
+    }
+    return _concurrent_hashtable_mutate ( hashtable
+                                        , key
+                                        , key_length
+                                        , value
+                                        , CONCURRENT_HASHTABLE_REMOVE
+                                        );
+}
+
+u64
+concurrent_hashtable_reclaim
+(   concurrent_hashtable_t* hashtable
+)
+{
+    state_t* state = hashtable;
+
+    // Finish any resize in progress, so the old table is retired as well.
+    u64* reader = _concurrent_hashtable_enter ( state );
+    table_t* table = atomic_load_ptr ( ( void* const* ) &( *state ).table , ATOMIC_ACQUIRE );
+    while ( atomic_load_ptr ( ( void* const* ) &( *table ).next , ATOMIC_ACQUIRE ) )
+    {
+        for ( u64 i = 0; i < ( *table ).bucket_count; ++i )
+        {
+            stripe_t* stripe = &( *state ).stripes[ i & ( CONCURRENT_HASHTABLE_STRIPE_COUNT - 1 ) ];
+            lock_acquire ( &( *stripe ).lock );
+            _concurrent_hashtable_migrate ( state , table , i );
+            lock_release ( &( *stripe ).lock );
+        }
+        table = ( *table ).next;
+    }
+    _concurrent_hashtable_leave ( reader );
+
+    // Memory retired in an epoch may be freed two epochs later.
+    _concurrent_hashtable_advance ( state );
+    _concurrent_hashtable_advance ( state );
+
+    u64 remaining = 0;
+    for ( u64 i = 0; i < CONCURRENT_HASHTABLE_STRIPE_COUNT; ++i )
+    {
+        stripe_t* stripe = &( *state ).stripes[ i ];
+        lock_acquire ( &( *stripe ).lock );
+        _concurrent_hashtable_collect ( state , stripe );
+        remaining += ( *stripe ).retired_size;
+        lock_release ( &( *stripe ).lock );
+    }
+    return remaining;
+}
+
+table_t*
+_concurrent_hashtable_table_create
+(   const u64 bucket_count
+)
+{
+    table_t* table = memory_allocate_aligned ( _concurrent_hashtable_table_size ( bucket_count )
+                                             , CONCURRENT_HASHTABLE_ALIGNMENT
+                                             , MEMORY_TAG_HASHTABLE
+                                             );
+    ( *table ).bucket_count = bucket_count;
+    return table;
+}
+
+u64*
+_concurrent_hashtable_enter
+(   state_t* state
+)
+{
+    if ( !concurrent_hashtable_slot )
+    {
+        concurrent_hashtable_slot = atomic_fetch_add_u32 ( &concurrent_hashtable_next_slot , 1 , ATOMIC_RELAXED )
+                                  % CONCURRENT_HASHTABLE_READER_SLOT_COUNT
+                                  + 1
+                                  ;
+    }
+    reader_t* reader = &( *state ).readers[ concurrent_hashtable_slot - 1 ];
+
+    // Count the query against the epoch it observed, then confirm the epoch
+    // did not advance in between; otherwise, the advance may have missed the
+    // query. Sequentially consistent, so that either the query observes an
+    // advance, or the advance observes the query.
+    for (;;)
+    {
+        const u64 epoch = atomic_load_u64 ( &( *state ).epoch , ATOMIC_SEQ_CST );
+        u64* count = &( *reader ).count[ epoch & 1 ];
+        atomic_fetch_add_u64 ( count , 1 , ATOMIC_SEQ_CST );
+        if ( atomic_load_u64 ( &( *state ).epoch , ATOMIC_SEQ_CST ) == epoch )
+        {
+            return count;
+        }
+        atomic_fetch_sub_u64 ( count , 1 , ATOMIC_RELEASE );
+    }
+}
+
+void
+_concurrent_hashtable_advance
+(   state_t* state
+)
+{
+    // Queries which started in the previous epoch are counted with those which
+    // will start in the next one.
+    u64 epoch = atomic_load_u64 ( &( *state ).epoch , ATOMIC_SEQ_CST );
+    for ( u64 i = 0; i < CONCURRENT_HASHTABLE_READER_SLOT_COUNT; ++i )
+    {
+        if ( atomic_load_u64 ( &( *state ).readers[ i ].count[ ( epoch + 1 ) & 1 ] , ATOMIC_SEQ_CST ) )
+        {
+            return;
+        }
+    }
+    atomic_compare_exchange_u64 ( &( *state ).epoch
+                                , &epoch
+                                , epoch + 1
+                                , ATOMIC_SEQ_CST
+                                , ATOMIC_SEQ_CST
+                                );
+}
+
+void
+_concurrent_hashtable_retire
+(   state_t*    state
+,   stripe_t*   stripe
+,   void*       memory
+,   const u64   size
+)
+{
+    // Order the store which unlinked the memory before reading the epoch: any
+    // query which observes a later epoch must not observe the memory.
+    atomic_fence ( ATOMIC_SEQ_CST );
+
+    retired_t retired;
+    retired.memory = memory;
+    retired.size = size;
+    retired.epoch = atomic_load_u64 ( &( *state ).epoch , ATOMIC_SEQ_CST );
+
+    if ( !( *stripe ).retired )
+    {
+        ( *stripe ).retired = array_create ( retired_t , CONCURRENT_HASHTABLE_RECLAIM_THRESHOLD );
+    }
+    array_push ( ( *stripe ).retired , retired );
+    ( *stripe ).retired_size += size;
+
+    if ( array_length ( ( *stripe ).retired ) >= CONCURRENT_HASHTABLE_RECLAIM_THRESHOLD )
+    {
+        _concurrent_hashtable_advance ( state );
+        _concurrent_hashtable_collect ( state , stripe );
+    }
+}
+
+void
+_concurrent_hashtable_collect
+(   state_t*    state
+,   stripe_t*   stripe
+)
+{
+    retired_t* retired = ( *stripe ).retired;
+    if ( !retired )
+    {
+        return;
+    }
+
+    // Every query which started in or before the epoch some memory was retired
+    // in has finished once the epoch has advanced twice since.
+    const u64 epoch = atomic_load_u64 ( &( *state ).epoch , ATOMIC_SEQ_CST );
+    const u64 length = array_length ( retired );
+    u64 count = 0;
+    while ( count < length && retired[ count ].epoch + 2 <= epoch )
+    {
+        memory_free_aligned ( retired[ count ].memory
+                            , retired[ count ].size
+                            , CONCURRENT_HASHTABLE_ALIGNMENT
+                            , MEMORY_TAG_HASHTABLE
+                            );
+        ( *stripe ).retired_size -= retired[ count ].size;
+        count += 1;
+    }
+    if ( count )
+    {
+        array_remove_range ( retired , 0 , count , 0 );
+    }
+}
+
+void
+_concurrent_hashtable_migrate
+(   state_t*    state
+,   table_t*    table
+,   const u64   index
+)
+{
+    entry_t* head = _concurrent_hashtable_load ( &( *table ).buckets[ index ] , ATOMIC_RELAXED );
+    if ( head == &concurrent_hashtable_moved )
+    {
+        return;
+    }
+    table_t* next = atomic_load_ptr ( ( void* const* ) &( *table ).next , ATOMIC_ACQUIRE );
+    stripe_t* stripe = &( *state ).stripes[ index & ( CONCURRENT_HASHTABLE_STRIPE_COUNT - 1 ) ];
+
+    // Copy the entries rather than relinking them: a query may be walking the
+    // bucket, and must not be diverted into a bucket of the next table.
+    for ( entry_t* entry = head; entry; entry = ( *entry ).next )
+    {
+        const u64 size = _concurrent_hashtable_entry_size ( ( *entry ).key_length
+                                                          , ( *state ).stride
+                                                          );
+        entry_t* copy = memory_allocate_aligned_uninit ( size
+                                                       , CONCURRENT_HASHTABLE_ALIGNMENT
+                                                       , MEMORY_TAG_HASHTABLE
+                                                       );
+        memory_copy ( copy , entry , size );
+        entry_t** bucket = &( *next ).buckets[ ( *entry ).hash & ( ( *next ).bucket_count - 1 ) ];
+        ( *copy ).next = *bucket;
+        _concurrent_hashtable_store ( bucket , copy , ATOMIC_RELEASE );
+    }
+    _concurrent_hashtable_store ( &( *table ).buckets[ index ]
+                                , &concurrent_hashtable_moved
+                                , ATOMIC_RELEASE
+                                );
+    while ( head )
+    {
+        entry_t* entry = head;
+        head = ( *head ).next;
+        _concurrent_hashtable_retire ( state
+                                     , stripe
+                                     , entry
+                                     , _concurrent_hashtable_entry_size ( ( *entry ).key_length
+                                                                        , ( *state ).stride
+                                                                        )
+                                     );
+    }
+
+    // Once every bucket has been migrated, the next table takes over.
+    if ( atomic_fetch_add_u64 ( &( *table ).migrated , 1 , ATOMIC_SEQ_CST ) + 1 == ( *table ).bucket_count )
+    {
+        atomic_store_ptr ( ( void** ) &( *state ).table , next , ATOMIC_RELEASE );
+        _concurrent_hashtable_retire ( state
+                                     , stripe
+                                     , table
+                                     , _concurrent_hashtable_table_size ( ( *table ).bucket_count )
+                                     );
+    }
+}
+
+table_t*
+_concurrent_hashtable_writable
+(   state_t*    state
+,   const u64   hash
+)
+{
+    // A resize which starts after this check cannot migrate the key's bucket
+    // until the caller releases the stripe lock.
+    table_t* table = atomic_load_ptr ( ( void* const* ) &( *state ).table , ATOMIC_ACQUIRE );
+    for (;;)
+    {
+        table_t* next = atomic_load_ptr ( ( void* const* ) &( *table ).next , ATOMIC_ACQUIRE );
+        if ( !next )
+        {
+            return table;
+        }
+        _concurrent_hashtable_migrate ( state , table , hash & ( ( *table ).bucket_count - 1 ) );
+        table = next;
+    }
+}
+
+void
+_concurrent_hashtable_help
+(   state_t* state
+)
+{
+    table_t* table = atomic_load_ptr ( ( void* const* ) &( *state ).table , ATOMIC_ACQUIRE );
+    table_t* next = atomic_load_ptr ( ( void* const* ) &( *table ).next , ATOMIC_ACQUIRE );
+
+    if ( !next )
+    {
+        if ( atomic_load_u64 ( &( *state ).length , ATOMIC_RELAXED ) <= ( *table ).bucket_count )
+        {
+            return;
+        }
+
+        // Start a resize, unless another thread just did.
+        next = _concurrent_hashtable_table_create ( ( *table ).bucket_count << 1 );
+        void* expected = 0;
+        if ( !atomic_compare_exchange_ptr ( ( void** ) &( *table ).next
+                                          , &expected
+                                          , next
+                                          , ATOMIC_RELEASE
+                                          , ATOMIC_RELAXED
+                                          ))
+        {
+            memory_free_aligned ( next
+                                , _concurrent_hashtable_table_size ( ( *next ).bucket_count )
+                                , CONCURRENT_HASHTABLE_ALIGNMENT
+                                , MEMORY_TAG_HASHTABLE
+                                );
+            return;
+        }
+    }
+
+    for ( u64 i = 0; i < CONCURRENT_HASHTABLE_MIGRATE_COUNT; ++i )
+    {
+        const u64 index = atomic_fetch_add_u64 ( &( *table ).migrate_next , 1 , ATOMIC_RELAXED );
+        if ( index >= ( *table ).bucket_count )
+        {
+            return;
+        }
+        stripe_t* stripe = &( *state ).stripes[ index & ( CONCURRENT_HASHTABLE_STRIPE_COUNT - 1 ) ];
+        lock_acquire ( &( *stripe ).lock );
+        _concurrent_hashtable_migrate ( state , table , index );
+        lock_release ( &( *stripe ).lock );
+    }
+}
+
+bool
+_concurrent_hashtable_mutate
+(   state_t*                        state
+,   const void*                     key
+,   const u64                       key_length
+,   void*                           value
+,   CONCURRENT_HASHTABLE_MUTATION   mutation
+)
+{
+    const u64 stride = ( *state ).stride;
+    const u64 hash = ( *state ).hash_function ( key , key_length , ( *state ).seed );
+    stripe_t* stripe = &( *state ).stripes[ hash & ( CONCURRENT_HASHTABLE_STRIPE_COUNT - 1 ) ];
+
+    u64* reader = _concurrent_hashtable_enter ( state );
+    lock_acquire ( &( *stripe ).lock );
+
+    table_t* table = _concurrent_hashtable_writable ( state , hash );
+    entry_t** link = &( *table ).buckets[ hash & ( ( *table ).bucket_count - 1 ) ];
+    entry_t* entry = *link;
+    while ( entry && !_concurrent_hashtable_entry_match ( entry , hash , key , key_length ) )
+    {
+        link = &( *entry ).next;
+        entry = *link;
+    }
+
+    bool mutated;
+    if ( mutation == CONCURRENT_HASHTABLE_REMOVE || ( entry && mutation == CONCURRENT_HASHTABLE_INSERT ) )
+    {
+        if ( entry && value )
+        {
+            memory_copy ( value , _concurrent_hashtable_entry_value ( entry ) , stride );
+        }
+        mutated = entry && mutation == CONCURRENT_HASHTABLE_REMOVE;
+        if ( mutated )
+        {
+            _concurrent_hashtable_store ( link , ( *entry ).next , ATOMIC_RELEASE );
+            _concurrent_hashtable_retire ( state
+                                         , stripe
+                                         , entry
+                                         , _concurrent_hashtable_entry_size ( key_length , stride )
+                                         );
+            atomic_fetch_sub_u64 ( &( *state ).length , 1 , ATOMIC_RELAXED );
+        }
+    }
+    else
+    {
+        // Build the new entry in full before linking it in, in place of the
+        // old entry (if there is one).
+        const u64 size = _concurrent_hashtable_entry_size ( key_length , stride );
+        entry_t* created = memory_allocate_aligned_uninit ( size
+                                                          , CONCURRENT_HASHTABLE_ALIGNMENT
+                                                          , MEMORY_TAG_HASHTABLE
+                                                          );
+        ( *created ).next = ( entry ) ? ( *entry ).next : 0;
+        ( *created ).hash = hash;
+        ( *created ).key_length = key_length;
+        if ( key_length )
+        {
+            memory_copy ( created + 1 , key , key_length );
+        }
+        memory_copy ( _concurrent_hashtable_entry_value ( created ) , value , stride );
+        _concurrent_hashtable_store ( link , created , ATOMIC_RELEASE );
+
+        if ( entry )
+        {
+            _concurrent_hashtable_retire ( state , stripe , entry , size );
+        }
+        else
+        {
+            atomic_fetch_add_u64 ( &( *state ).length , 1 , ATOMIC_RELAXED );
+        }
+        mutated = true;
+    }
+
+    lock_release ( &( *stripe ).lock );
+    _concurrent_hashtable_help ( state );
+    _concurrent_hashtable_leave ( reader );
+    return mutated;
+}
@@ -0,0 +1,363 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/concurrent_hashtable.h
+ * @brief Provides an interface for a thread-safe hashtable, for lookup tables
+ * which are shared between threads (such as caches).
+ *
+ * Any number of threads may query and mutate the hashtable concurrently:
+ *
+ *   concurrent_hashtable_t* cache;
+ *   concurrent_hashtable_create ( sizeof ( resource_t ) , 1024 , &cache );
+ *   ...
+ *   resource_t resource;
+ *   if ( !concurrent_hashtable_get ( cache , path , &resource ) )
+ *   {
+ *       resource_load ( path , &resource );
+ *       concurrent_hashtable_insert ( cache , path , &resource );
+ *   }
+ *
+ * Queries never lock, and never wait for a mutation: each bucket is a linked
+ * list of immutable entries, so a mutation builds a new entry and links it in
+ * with a single atomic store, and a query sees either the old entry or the
+ * new one. Mutations lock one of CONCURRENT_HASHTABLE_STRIPE_COUNT locks,
+ * chosen by the hash of the key, so mutations of unrelated keys rarely
+ * contend.
+ *
+ * The hashtable doubles its bucket count once it holds more keys than it has
+ * buckets. The resize is incremental: each mutation which follows it moves a
+ * few buckets to the new table, so no single operation pays for moving every
+ * entry. Queries follow a moved bucket to the new table.
+ *
+ * Replaced and removed entries (and old tables) are reclaimed by epoch: each
+ * query announces the epoch it started in, and memory retired in an epoch is
+ * freed only once every query which started in or before that epoch has
+ * finished. Reclamation runs as part of mutations; call
+ * concurrent_hashtable_reclaim to free what remains once the hashtable is
+ * quiet.
+ *
+ * Values are copied in and out (as with a data-valued hashtable; see
+ * container/hashtable.h), never referenced, since the entry which holds a
+ * value may be reclaimed as soon as the operation returns. To share pointers,
+ * use a stride of sizeof ( void* ).
+ */
+#ifndef CONCURRENT_HASHTABLE_H
+#define CONCURRENT_HASHTABLE_H
+
+#include "common.h"
+
+#include "core/hash.h"
+#include "core/string.h"
+
+#include "math/random64.h"
+
+/** @brief Type declaration for a concurrent hashtable. */
+typedef void concurrent_hashtable_t;
+
+/**
+ * @brief Number of locks which guard the mutations of a concurrent hashtable
+ * (and the minimum number of buckets).
+ */
+#define CONCURRENT_HASHTABLE_STRIPE_COUNT 64
+
+/**
+ * @brief Number of buckets a mutation moves to the new table while a
+ * concurrent hashtable is resizing.
+ */
+#define CONCURRENT_HASHTABLE_MIGRATE_COUNT 8
+
+/**
+ * @brief Number of retired allocations a lock stripe may accumulate before a
+ * mutation attempts to reclaim them.
+ */
+#define CONCURRENT_HASHTABLE_RECLAIM_THRESHOLD 32
+
+/**
+ * @brief Initializes a concurrent hashtable.
+ *
+ * Use _concurrent_hashtable_create to explicitly specify the hash function and
+ * seed, or concurrent_hashtable_create to use hash64 with a random seed (see
+ * core/hash.h).
+ *
+ * Uses dynamic memory allocation (see core/memory.h). Call
+ * concurrent_hashtable_destroy to free.
+ *
+ * @param stride The size of each value in bytes. Must be non-zero.
+ * @param capacity The number of keys the hashtable may hold before it needs to
+ * grow. Rounded up to a power of two (minimum
+ * CONCURRENT_HASHTABLE_STRIPE_COUNT).
+ * @param hash_function The function used to hash keys. Pass 0 to use hash64.
+ * @param seed The seed passed to hash_function.
+ * @param hashtable Output buffer for the hashtable. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+_concurrent_hashtable_create
+(   u64                         stride
+,   u64                         capacity
+,   hash_function_t             hash_function
+,   u64                         seed
+,   concurrent_hashtable_t**    hashtable
+);
+
+#define concurrent_hashtable_create(stride,capacity,hashtable)           \
+    _concurrent_hashtable_create ( (stride)                              \
+                                 , (capacity)                            \
+                                 , hash64                                \
+                                 , ( u64 ) random64 ()                   \
+                                 , (hashtable)                           \
+                                 )
+
+/**
+ * @brief Frees the memory used by a concurrent hashtable, including every
+ * entry which is still awaiting reclamation.
+ *
+ * Must not be called while any other thread is accessing the hashtable.
+ *
+ * @param hashtable Handle to the hashtable to free.
+ */
+void
+concurrent_hashtable_destroy
+(   concurrent_hashtable_t** hashtable
+);
+
+/**
+ * @brief Queries the size of each value of a concurrent hashtable.
+ *
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @return The stride of hashtable (in bytes).
+ */
+u64
+concurrent_hashtable_stride
+(   const concurrent_hashtable_t* hashtable
+);
+
+/**
+ * @brief Queries the capacity of a concurrent hashtable.
+ *
+ * While the hashtable is resizing, this is the capacity it is resizing to.
+ *
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @return The number of keys hashtable may hold before it needs to grow.
+ */
+u64
+concurrent_hashtable_capacity
+(   const concurrent_hashtable_t* hashtable
+);
+
+/**
+ * @brief Queries the number of keys stored in a concurrent hashtable.
+ *
+ * If other threads are mutating the hashtable, the result may already be out
+ * of date by the time it is returned.
+ *
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @return The number of keys stored in hashtable.
+ */
+u64
+concurrent_hashtable_length
+(   const concurrent_hashtable_t* hashtable
+);
+
+/**
+ * @brief Sets a concurrent hashtable value, inserting the key if it is not
+ * already present. O(1), on average.
+ *
+ * Use _concurrent_hashtable_set to explicitly specify key length,
+ * concurrent_hashtable_set to compute the length of a null-terminated key, or
+ * concurrent_hashtable_set_view to pass the key as a string view (see
+ * core/string.h).
+ *
+ * @param hashtable The hashtable to mutate. Must be non-zero.
+ * @param key The key whose value will be set. Must be non-zero if key_length
+ * is non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value The address of the value to copy in. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+_concurrent_hashtable_set
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   const void*             value
+);
+
+#define concurrent_hashtable_set(hashtable,key,value)                        \
+    ({                                                                       \
+        const char* key__ = (key);                                           \
+        _concurrent_hashtable_set ( (hashtable) , key__                      \
+                                  , _string_length ( key__ ) , (value)       \
+                                  );                                         \
+    })
+
+#define concurrent_hashtable_set_view(hashtable,key,value)                   \
+    ({                                                                       \
+        const string_view_t key__ = (key);                                   \
+        _concurrent_hashtable_set ( (hashtable) , key__.string               \
+                                  , key__.length , (value)                   \
+                                  );                                         \
+    })
+
+/**
+ * @brief Inserts a key and its value into a concurrent hashtable, unless the
+ * key is already present. O(1), on average.
+ *
+ * Of several threads which insert the same key at once, exactly one succeeds;
+ * the others obtain the value it inserted. Use this to fill a cache without
+ * overwriting a value which another thread has just filled in.
+ *
+ * Use _concurrent_hashtable_insert to explicitly specify key length,
+ * concurrent_hashtable_insert to compute the length of a null-terminated key,
+ * or concurrent_hashtable_insert_view to pass the key as a string view (see
+ * core/string.h).
+ *
+ * @param hashtable The hashtable to mutate. Must be non-zero.
+ * @param key The key to insert. Must be non-zero if key_length is non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value The address of the value to copy in. Must be non-zero. If the
+ * key is already present, its value is copied out to this address instead.
+ * @return true if the key was inserted; false if it was already present (or
+ * on error).
+ */
+bool
+_concurrent_hashtable_insert
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   void*                   value
+);
+
+#define concurrent_hashtable_insert(hashtable,key,value)                     \
+    ({                                                                       \
+        const char* key__ = (key);                                           \
+        _concurrent_hashtable_insert ( (hashtable) , key__                   \
+                                     , _string_length ( key__ ) , (value)    \
+                                     );                                      \
+    })
+
+#define concurrent_hashtable_insert_view(hashtable,key,value)                \
+    ({                                                                       \
+        const string_view_t key__ = (key);                                   \
+        _concurrent_hashtable_insert ( (hashtable) , key__.string            \
+                                     , key__.length , (value)                \
+                                     );                                      \
+    })
+
+/**
+ * @brief Queries a concurrent hashtable value without locking. O(1), on
+ * average.
+ *
+ * Use _concurrent_hashtable_get to explicitly specify key length,
+ * concurrent_hashtable_get to compute the length of a null-terminated key, or
+ * concurrent_hashtable_get_view to pass the key as a string view (see
+ * core/string.h).
+ *
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @param key The key whose value will be read. Must be non-zero if key_length
+ * is non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value Output buffer for the value. Only written to if the key is
+ * present within the hashtable. Pass 0 to retrieve nothing.
+ * @return true if the key is present within the hashtable; false otherwise.
+ */
+bool
+_concurrent_hashtable_get
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   void*                   value
+);
+
+#define concurrent_hashtable_get(hashtable,key,value)                        \
+    ({                                                                       \
+        const char* key__ = (key);                                           \
+        _concurrent_hashtable_get ( (hashtable) , key__                      \
+                                  , _string_length ( key__ ) , (value)       \
+                                  );                                         \
+    })
+
+#define concurrent_hashtable_get_view(hashtable,key,value)                   \
+    ({                                                                       \
+        const string_view_t key__ = (key);                                   \
+        _concurrent_hashtable_get ( (hashtable) , key__.string               \
+                                  , key__.length , (value)                   \
+                                  );                                         \
+    })
+
+/**
+ * @brief Queries whether a key is present within a concurrent hashtable
+ * without locking. O(1), on average.
+ *
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @param key The key to search for. Must be non-zero if key_length is
+ * non-zero.
+ * @param key_length The length of key in bytes.
+ * @return true if the key is present within the hashtable; false otherwise.
+ */
+#define _concurrent_hashtable_contains(hashtable,key,key_length) \
+    _concurrent_hashtable_get ( (hashtable) , (key) , (key_length) , 0 )
+
+#define concurrent_hashtable_contains(hashtable,key) \
+    concurrent_hashtable_get ( (hashtable) , (key) , 0 )
+
+#define concurrent_hashtable_contains_view(hashtable,key) \
+    concurrent_hashtable_get_view ( (hashtable) , (key) , 0 )
+
+/**
+ * @brief Removes a key and its value from a concurrent hashtable. O(1), on
+ * average.
+ *
+ * Use _concurrent_hashtable_remove to explicitly specify key length,
+ * concurrent_hashtable_remove to compute the length of a null-terminated key,
+ * or concurrent_hashtable_remove_view to pass the key as a string view (see
+ * core/string.h).
+ *
+ * @param hashtable The hashtable to mutate. Must be non-zero.
+ * @param key The key to remove. Must be non-zero if key_length is non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value Output buffer for the value of the removed key. Pass 0 to
+ * retrieve nothing.
+ * @return true if the key was present within the hashtable; false otherwise.
+ */
+bool
+_concurrent_hashtable_remove
+(   concurrent_hashtable_t* hashtable
+,   const void*             key
+,   const u64               key_length
+,   void*                   value
+);
+
+#define concurrent_hashtable_remove(hashtable,key,value)                     \
+    ({                                                                       \
+        const char* key__ = (key);                                           \
+        _concurrent_hashtable_remove ( (hashtable) , key__                   \
+                                     , _string_length ( key__ ) , (value)    \
+                                     );                                      \
+    })
+
+#define concurrent_hashtable_remove_view(hashtable,key,value)                \
+    ({                                                                       \
+        const string_view_t key__ = (key);                                   \
+        _concurrent_hashtable_remove ( (hashtable) , key__.string            \
+                                     , key__.length , (value)                \
+                                     );                                      \
+    })
+
+/**
+ * @brief Frees every retired entry of a concurrent hashtable which no query
+ * can still be reading.
+ *
+ * Mutations reclaim memory as they go; this only needs to be called to
+ * release memory promptly after the last mutation in a while. Queries may run
+ * concurrently, but delay the reclamation of anything retired before they
+ * started.
+ *
+ * @param hashtable The hashtable to reclaim memory from. Must be non-zero.
+ * @return The number of bytes which remain retired but not yet freed.
+ */
+u64
+concurrent_hashtable_reclaim
+(   concurrent_hashtable_t* hashtable
+);
+
+#endif  // CONCURRENT_HASHTABLE_H
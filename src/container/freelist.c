@@ -6,6 +6,7 @@
  */
 #include "container/freelist.h"
 
+#include "core/bitv.h"
 #include "core/logger.h"
 #include "core/memory.h"
 #include "core/string.h"
@@ -19,44 +20,164 @@ typedef struct node_t
     u64             size;
     struct node_t*  next;
 
+    // First-fit only.
+    struct node_t*  left;
+    struct node_t*  right;
+    u64             largest;    // Largest block size within the subtree.
 }
 node_t;
 
+/**
+ * @brief Type definition for a block of additional node storage, which holds
+ * its nodes immediately after this header (see freelist_add_nodes).
+ */
+typedef struct chunk_t
+{
+    struct chunk_t* next;
+    u64             count;
+    bool            owned;  // Allocated by the freelist (see freelist_grow)?
+}
+chunk_t;
+
+/** @brief Minimum number of nodes by which an owned freelist grows. */
+#define FREELIST_MINIMUM_GROWTH 64
+
+/** @brief Number of segregated-fit size classes (one per power of two). */
+#define FREELIST_BIN_COUNT 64
+
 /** @brief Type definition for internal state. */
 typedef struct
 {
-    u64     capacity;
-    u64     max_entries;
-    bool    owns_memory;
-    node_t* head;
-    node_t* content;
+    FREELIST_MODE   mode;
+    u64             capacity;
+    u64             max_entries;
+    bool            owns_memory;
+    u64             free;
+    node_t*         content;
+    node_t*         unused;
+    u64             unused_count;
+    u64             node_count;
+    chunk_t*        chunks;
+
+    // First-fit only.
+    node_t*         root;
+
+    // Segregated-fit only.
+    u8              bitmap[ FREELIST_BIN_COUNT / 8 ];   // Non-empty bins.
+    node_t*         bins[ FREELIST_BIN_COUNT ];
 }
 state_t;
 
 /**
- * @brief Obtains a handle to the first empty node within a freelist.
+ * @brief Pops a node from the unused node stack of a freelist. If the stack is
+ * empty and the freelist owns its memory, the node storage grows first (see
+ * freelist_grow).
  * 
- * @param freelist The freelist to query.  Must be non-zero.
- * @return A handle to the first empty block within freelist.
+ * @param state Internal state arguments.
+ * @return An unused node, or 0 if the node storage is exhausted.
  */
 node_t*
 freelist_get_node
-(   freelist_t* freelist
+(   state_t* state
 );
 
 /**
- * @brief Clears a node within a freelist.
+ * @brief Clears a node within a freelist and pushes it onto the unused node
+ * stack.
  * 
+ * @param state Internal state arguments.
  * @param node The freelist node to clear. Must be non-zero.
  */
 void
 freelist_return_node
-(   node_t* node
+(   state_t*    state
+,   node_t*     node
+);
+
+/**
+ * @brief Retrieves the nodes of a block of additional node storage.
+ * 
+ * @param chunk The block. Must be non-zero.
+ * @return The first of the ( *chunk ).count nodes.
+ */
+node_t*
+freelist_chunk_content
+(   chunk_t* chunk
+);
+
+/**
+ * @brief Links a block of additional node storage into a freelist and pushes
+ * each of its nodes onto the unused node stack. Existing nodes are never
+ * moved, so no node is copied and every node address remains valid.
+ * 
+ * @param state Internal state arguments.
+ * @param chunk The block. Must be non-zero, with count nodes after the header.
+ * @param count The number of nodes.
+ * @param owned Whether the block was allocated by the freelist.
+ */
+void
+freelist_add_chunk
+(   state_t*    state
+,   chunk_t*    chunk
+,   u64         count
+,   bool        owned
+);
+
+/**
+ * @brief Allocates an additional block of node storage with as many nodes as
+ * the freelist already has (doubling it), so that growth costs amortized O(1)
+ * per node. Only valid if the freelist owns its memory.
+ * 
+ * @param state Internal state arguments.
+ */
+void
+freelist_grow
+(   state_t* state
+);
+
+/**
+ * @brief Sorts each node of the additional node storage of a freelist into the
+ * search structure of its mode, if it is a free block, or onto the unused node
+ * stack otherwise (see freelist_first_fit_init, freelist_segregated_init).
+ * 
+ * @param state Internal state arguments.
+ */
+void
+freelist_chunks_init
+(   state_t* state
 );
 
+// Implementation of the first-fit allocation strategy
+// ( see FREELIST_MODE_FIRST_FIT ).
+void freelist_first_fit_init ( state_t* state , u64 live_nodes );
+u64 freelist_tree_priority ( const node_t* node );
+void freelist_tree_update ( node_t* node );
+void freelist_tree_split ( node_t* node , const u64 offset , node_t** left , node_t** right );
+node_t* freelist_tree_merge ( node_t* left , node_t* right );
+void freelist_tree_insert ( state_t* state , node_t* node );
+node_t* freelist_tree_remove ( node_t* node , const u64 offset );
+void freelist_tree_refresh ( node_t* node , const u64 offset );
+bool freelist_first_fit_allocate ( state_t* state , const u64 size , u64* offset );
+bool freelist_first_fit_free ( state_t* state , const u64 size , const u64 offset );
+bool freelist_first_fit_extend ( state_t* state , const u64 end , const u64 additional );
+
+// Implementation of the segregated-fit allocation strategy
+// ( see FREELIST_MODE_SEGREGATED_FIT ).
+void freelist_segregated_init ( state_t* state , u64 live_nodes );
+void freelist_segregated_bin_insert ( state_t* state , node_t* node );
+node_t* freelist_segregated_bin_take ( state_t* state , const u64 size );
+node_t* freelist_segregated_get_node ( state_t* state );
+void freelist_segregated_coalesce ( state_t* state );
+void freelist_segregated_coalesce_walk ( state_t* state , node_t* node , node_t** previous_node );
+bool freelist_segregated_allocate ( state_t* state , const u64 size , u64* offset );
+bool freelist_segregated_free ( state_t* state , const u64 size , const u64 offset );
+bool freelist_segregated_extend ( state_t* state , const u64 end , const u64 additional );
+
 bool
-freelist_create
+_freelist_create
 (   u64             capacity
+,   FREELIST_MODE   mode
+,   u64             node_count
 ,   u64*            memory_requirement_
 ,   void*           memory_
 ,   freelist_t**    freelist
@@ -67,10 +188,16 @@ freelist_create
         LOGERROR ( "freelist_create: Value of capacity argument must be non-zero." );
         return false;
     }
+    if ( mode >= FREELIST_MODE_COUNT )
+    {
+        LOGERROR ( "freelist_create: Value of mode argument is not a valid freelist mode." );
+        return false;
+    }
 
-    const u64 max_entries = MAX ( 20U
-                                , capacity / ( sizeof ( void* ) * sizeof ( node_t ) )
-                                );
+    const u64 max_entries = ( node_count ) ? node_count
+                                           : MAX ( 20U
+                                                 , capacity / ( sizeof ( void* ) * sizeof ( node_t ) )
+                                                 );
     const u64 memory_requirement = sizeof ( state_t ) + max_entries
                                                       * sizeof ( node_t )
                                                       ;
@@ -90,7 +217,7 @@ freelist_create
     }
     else
     {
-        memory = memory_allocate ( memory_requirement , MEMORY_TAG_FREELIST );
+        memory = memory_allocate_uninit ( memory_requirement , MEMORY_TAG_FREELIST );
     }
 
     if ( !freelist )
@@ -120,14 +247,24 @@ freelist_create
     memory_clear ( memory , memory_requirement );
     
     state_t* state = memory;
+    ( *state ).mode = mode;
     ( *state ).owns_memory = !memory_;
     ( *state ).content = ( void* )( ( ( u64 ) memory ) + sizeof ( state_t ) );
     ( *state ).max_entries = max_entries;
+    ( *state ).node_count = max_entries;
     ( *state ).capacity = capacity;
-    ( *state ).head = &( *state ).content[ 0 ];
-    ( *( ( *state ).head ) ).offset = 0;
-    ( *( ( *state ).head ) ).size = capacity;
-    ( *( ( *state ).head ) ).next = 0;
+    ( *state ).free = capacity;
+    ( *state ).content[ 0 ].offset = 0;
+    ( *state ).content[ 0 ].size = capacity;
+
+    if ( mode == FREELIST_MODE_SEGREGATED_FIT )
+    {
+        freelist_segregated_init ( state , 1 );
+    }
+    else
+    {
+        freelist_first_fit_init ( state , 1 );
+    }
 
     *freelist = state;
     return true;
@@ -149,6 +286,20 @@ freelist_destroy
         return;
     }
 
+    chunk_t* chunk = ( *state ).chunks;
+    while ( chunk )
+    {
+        chunk_t* next = ( *chunk ).next;
+        if ( ( *chunk ).owned )
+        {
+            memory_free ( chunk
+                        , sizeof ( chunk_t ) + ( *chunk ).count * sizeof ( node_t )
+                        , MEMORY_TAG_FREELIST
+                        );
+        }
+        chunk = next;
+    }
+
     const u64 memory_requirement = sizeof ( state_t ) + ( *state ).max_entries
                                                       * sizeof ( node_t )
                                                       ;
@@ -172,6 +323,14 @@ freelist_owns_memory
     return ( *( ( state_t* ) freelist ) ).owns_memory;
 }
 
+FREELIST_MODE
+freelist_mode
+(   const freelist_t* freelist
+)
+{
+    return ( *( ( state_t* ) freelist ) ).mode;
+}
+
 bool
 freelist_allocate
 (   freelist_t* freelist
@@ -180,40 +339,14 @@ freelist_allocate
 )
 {
     state_t* state = freelist;
-    node_t* current_node = ( *state ).head;
-    node_t* previous_node = 0;
-
-    while ( current_node )
+    if ( ( *state ).mode == FREELIST_MODE_SEGREGATED_FIT )
     {
-        if ( ( *current_node ).size == size )
-        {
-            *offset = ( *current_node ).offset;
-            
-            node_t* output_node = 0;
-            if ( previous_node )
-            {
-                ( *previous_node ).next = ( *current_node ).next;
-                output_node = current_node;
-            }
-            else
-            {
-                output_node = ( *state ).head;
-                ( *state ).head = ( *current_node ).next;
-            }
-
-            freelist_return_node ( output_node );
-            return true;
-        }
-        else if ( ( *current_node ).size > size )
-        {
-            *offset = ( *current_node ).offset;
-            ( *current_node ).size -= size;
-            ( *current_node ).offset += size;
-            return true;
-        }
+        return freelist_segregated_allocate ( state , size , offset );
+    }
 
-        previous_node = current_node;
-        current_node = ( *current_node ).next;
+    if ( freelist_first_fit_allocate ( state , size , offset ) )
+    {
+        return true;
     }
 
     f64 req_amount;    
@@ -236,101 +369,28 @@ freelist_free
 )
 {
     state_t* state = freelist;
-    node_t* current_node = ( *state ).head;
-    node_t* previous_node = 0;
-
-    if ( !current_node )
+    if ( ( *state ).mode == FREELIST_MODE_SEGREGATED_FIT )
     {
-        node_t* new_node = freelist_get_node ( freelist );
-        ( *new_node ).offset = offset;
-        ( *new_node ).size = size;
-        ( *new_node ).next = 0;
-        ( *state ).head = new_node;
-        return true;
+        return freelist_segregated_free ( state , size , offset );
     }
+    return freelist_first_fit_free ( state , size , offset );
+}
 
-    while ( current_node )
+bool
+freelist_extend
+(   freelist_t* freelist
+,   u64         size
+,   u64         offset
+,   u64         additional
+)
+{
+    state_t* state = freelist;
+    const u64 end = offset + size;
+    if ( ( *state ).mode == FREELIST_MODE_SEGREGATED_FIT )
     {
-        if ( ( *current_node ).offset + ( *current_node ).size == offset )
-        {
-            ( *current_node ).size += size;
-            if (   ( *current_node ).next
-                && ( *current_node ).offset + ( *current_node ).size == ( *( ( *current_node ).next ) ).offset
-               )
-            {
-                ( *current_node ).size += ( *( ( *current_node ).next ) ).size;
-                node_t* output_node = ( *current_node ).next;
-                ( *current_node ).next = ( *( ( *current_node ).next ) ).next;
-                freelist_return_node ( output_node );
-            }
-            return true;
-        }
-        else if ( ( *current_node ).offset == offset )
-        {
-            LOGERROR ( "freelist_free: Double free occurred at memory offset %@."
-                     , ( *current_node ).offset
-                     );
-            return false;
-        }
-        else if ( ( *current_node ).offset > offset )
-        {
-            node_t* new_node = freelist_get_node ( freelist );
-            ( *new_node ).offset = offset;
-            ( *new_node ).size = size;
-
-            if ( previous_node )
-            {
-                ( *previous_node ).next = new_node;
-                ( *new_node ).next = current_node;
-            }
-            else
-            {
-                ( *new_node ).next = current_node;
-                ( *state ).head = new_node;
-            }
-
-            if (    ( *new_node ).next
-                 && ( *new_node ).offset + ( *new_node ).size == ( *( ( *new_node ).next ) ).offset
-               )
-            {
-                ( *new_node ).size += ( *( ( *new_node ).next ) ).size;
-                node_t* output_node = ( *new_node ).next;
-                ( *new_node ).next = ( *output_node ).next;
-                freelist_return_node ( output_node );
-            }
-            if (    previous_node
-                 && ( *previous_node ).offset + ( *previous_node ).size == ( *new_node ).offset
-               )
-            {
-                ( *previous_node ).size += ( *new_node ).size;
-                node_t* output_node = new_node;
-                ( *previous_node ).next = ( *output_node ).next;
-                freelist_return_node ( output_node );
-            }
-
-            return true;
-        }
-
-        if (    !( *current_node ).next
-             && ( *current_node ).offset + ( *current_node ).size < offset
-           )
-        {
-            node_t* new_node = freelist_get_node ( freelist );
-            ( *new_node ).offset = offset;
-            ( *new_node ).size = size;
-            ( *new_node ).next = 0;
-            ( *current_node ).next = new_node;
-            return true;
-        }
-
-        previous_node = current_node;
-        current_node = ( *current_node ).next;
-
-    }// End while.
-
-    LOGWARN ( "freelist_free: Did not find a block to free. Memory corruption probable." );
-    
-    return false;
+        return freelist_segregated_extend ( state , end , additional );
+    }
+    return freelist_first_fit_extend ( state , end , additional );
 }
 
 bool
@@ -354,8 +414,10 @@ freelist_resize
         return false;
     }
 
-    const u64 max_entries = MAX ( 20U
-                                , minimum_capacity / ( sizeof ( void* ) )
+    const u64 max_entries = MAX ( MAX ( 20U
+                                      , minimum_capacity / ( sizeof ( void* ) )
+                                      )
+                                , ( *state ).max_entries
                                 );
     const u64 memory_requirement = sizeof ( state_t ) + sizeof ( node_t )
                                                       * max_entries
@@ -380,9 +442,9 @@ freelist_resize
     }
     else
     {
-        new_memory = memory_allocate ( memory_requirement
-                                     , MEMORY_TAG_FREELIST
-                                     );
+        new_memory = memory_allocate_uninit ( memory_requirement
+                                            , MEMORY_TAG_FREELIST
+                                            );
     }
 
     state_t* old_state = old_memory;
@@ -390,59 +452,59 @@ freelist_resize
 
     state = new_memory;
     memory_clear ( state , memory_requirement );
+    ( *state ).mode = ( *old_state ).mode;
     ( *state ).owns_memory = !new_memory_;
-    ( *state ).content = ( void* )( ( ( u64 ) new_memory_ )
+    ( *state ).content = ( void* )( ( ( u64 ) new_memory )
                                   + sizeof ( state_t )
                                   );
     ( *state ).max_entries = max_entries;
     ( *state ).capacity = minimum_capacity;
-    ( *state ).head = &( *state ).content[ 0 ];
 
-    node_t* current_node_new = ( *state ).head;
-    node_t* current_node_old = ( *old_state ).head;
-
-    if ( !current_node_old )
-    {
-        ( *( ( *state ).head ) ).offset = ( *old_state ).capacity;
-        ( *( ( *state ).head ) ).size = capacity_difference;
-        ( *( ( *state ).head ) ).next = 0;
-        return true;
-    }
-    
-    while ( current_node_old )
+    // Additional node storage is handed over as-is: its free blocks stay where
+    // they are. Every free block of the old node array is copied, then the new
+    // tail block is added; in either mode, it is merged with the old final
+    // block if adjacent.
+    ( *state ).chunks = ( *old_state ).chunks;
+    ( *state ).node_count = ( *old_state ).node_count
+                          - ( *old_state ).max_entries
+                          + max_entries
+                          ;
+    u64 live_nodes = 0;
+    for ( u64 i = 0; i < ( *old_state ).max_entries; ++i )
     {
-        node_t* new_node = freelist_get_node ( freelist );
-
-        ( *new_node ).offset = ( *current_node_old ).offset;
-        ( *new_node ).size = ( *current_node_old ).size;
-        ( *new_node ).next = 0;
-        ( *current_node_new ).next = new_node;
-
-        current_node_new = ( *current_node_new ).next;
-        
-        if ( ( *current_node_old ).next )
-        {
-            current_node_old = ( *current_node_old ).next;
-        }
-        else
+        if ( ( *old_state ).content[ i ].size )
         {
-            if ( ( *current_node_old ).offset + ( *current_node_old ).size == ( *old_state ).capacity )
-            {
-                ( *new_node ).size += capacity_difference;
-            }
-            else
-            {
-                node_t* new_tail = freelist_get_node ( freelist );
-                ( *new_tail ).offset = ( *old_state ).capacity;
-                ( *new_tail ).size = capacity_difference;
-                ( *new_tail ).next = 0;
-                ( *new_node ).next = new_tail;
-            }
-
-            break;
+            ( *state ).content[ live_nodes ].offset = ( *old_state ).content[ i ].offset;
+            ( *state ).content[ live_nodes ].size = ( *old_state ).content[ i ].size;
+            live_nodes += 1;
         }
     }
+    ( *state ).free = ( *old_state ).free;
+    if ( ( *state ).mode == FREELIST_MODE_SEGREGATED_FIT )
+    {
+        freelist_segregated_init ( state , live_nodes );
+        freelist_segregated_free ( state
+                                 , capacity_difference
+                                 , ( *old_state ).capacity
+                                 );
+        freelist_segregated_coalesce ( state );
+    }
+    else
+    {
+        freelist_first_fit_init ( state , live_nodes );
+        freelist_first_fit_free ( state
+                                , capacity_difference
+                                , ( *old_state ).capacity
+                                );
+    }
 
+    if ( !memory_requirement_ && ( *old_state ).owns_memory )
+    {
+        memory_free ( old_state
+                    , sizeof ( state_t ) + sizeof ( node_t ) * ( *old_state ).max_entries
+                    , MEMORY_TAG_FREELIST
+                    );
+    }
     *freelist = state;
     return true;
 }
@@ -456,52 +518,1003 @@ freelist_reset
     memory_clear ( ( *state ).content
                  , sizeof ( node_t ) * ( *state ).max_entries
                  );
-    ( *( ( *state ).head ) ).offset = 0;
-    ( *( ( *state ).head ) ).size = ( *state ).capacity;
-    ( *( ( *state ).head ) ).next = 0;
+    for ( chunk_t* chunk = ( *state ).chunks; chunk; chunk = ( *chunk ).next )
+    {
+        memory_clear ( freelist_chunk_content ( chunk )
+                     , sizeof ( node_t ) * ( *chunk ).count
+                     );
+    }
+    ( *state ).free = ( *state ).capacity;
+    ( *state ).content[ 0 ].offset = 0;
+    ( *state ).content[ 0 ].size = ( *state ).capacity;
+
+    if ( ( *state ).mode == FREELIST_MODE_SEGREGATED_FIT )
+    {
+        freelist_segregated_init ( state , 1 );
+    }
+    else
+    {
+        freelist_first_fit_init ( state , 1 );
+    }
 }
 
-// Expensive!
 u64
 freelist_query_free
 (   freelist_t* freelist
 )
+{
+    return ( *( ( state_t* ) freelist ) ).free;
+}
+
+u64
+freelist_query_largest_free
+(   freelist_t* freelist
+)
 {
     state_t* state = freelist;
-    u64 sum = 0;
-    node_t* node = ( *state ).head;
-    while ( node )
+    if ( ( *state ).mode == FREELIST_MODE_SEGREGATED_FIT )
     {
-        sum += ( *node ).size;
-        node = ( *node ).next;
+        const u64 count = bitv_count ( ( *state ).bitmap , FREELIST_BIN_COUNT );
+        if ( !count )
+        {
+            return 0;
+        }
+        // The largest block is within the highest non-empty bin.
+        const u64 bin = bitv_select ( ( *state ).bitmap , FREELIST_BIN_COUNT , count - 1 );
+        u64 largest = 0;
+        node_t* node = ( *state ).bins[ bin ];
+        while ( node )
+        {
+            largest = MAX ( largest , ( *node ).size );
+            node = ( *node ).next;
+        }
+        return largest;
+    }
+    return ( *state ).root ? ( *( ( *state ).root ) ).largest : 0;
+}
+
+f64
+freelist_query_fragmentation
+(   freelist_t* freelist
+)
+{
+    const u64 free = freelist_query_free ( freelist );
+    if ( !free )
+    {
+        return 0;
+    }
+    return 1.0 - ( ( f64 ) freelist_query_largest_free ( freelist ) ) / ( ( f64 ) free );
+}
+
+bool
+freelist_add_nodes
+(   freelist_t* freelist
+,   void*       memory
+,   u64         size
+)
+{
+    if ( !memory || size < freelist_node_size ( 1 ) )
+    {
+        LOGERROR ( "freelist_add_nodes: Memory buffer must be non-zero and hold at least one node." );
+        return false;
     }
-    return sum;
+    const u64 count = ( size - sizeof ( chunk_t ) ) / sizeof ( node_t );
+    freelist_add_chunk ( freelist , memory , count , false );
+    return true;
+}
+
+u64
+freelist_node_size
+(   u64 count
+)
+{
+    return sizeof ( chunk_t ) + count * sizeof ( node_t );
+}
+
+u64
+freelist_query_unused_nodes
+(   freelist_t* freelist
+)
+{
+    return ( *( ( state_t* ) freelist ) ).unused_count;
 }
 
 node_t*
 freelist_get_node
-(   freelist_t* freelist
+(   state_t* state
 )
 {
-    state_t* state = freelist;
-    for ( u64 i = 1; i < ( *state ).max_entries; ++i )
+    if ( !( *state ).unused && ( *state ).owns_memory )
+    {
+        freelist_grow ( state );
+    }
+    node_t* node = ( *state ).unused;
+    if ( node )
+    {
+        ( *state ).unused = ( *node ).next;
+        ( *state ).unused_count -= 1;
+        ( *node ).next = 0;
+    }
+    return node;
+}
+
+void
+freelist_return_node
+(   state_t*    state
+,   node_t*     node
+)
+{
+    memory_clear ( node , sizeof ( node_t ) );
+    ( *node ).next = ( *state ).unused;
+    ( *state ).unused = node;
+    ( *state ).unused_count += 1;
+}
+
+node_t*
+freelist_chunk_content
+(   chunk_t* chunk
+)
+{
+    return ( void* )( ( ( u64 ) chunk ) + sizeof ( chunk_t ) );
+}
+
+void
+freelist_add_chunk
+(   state_t*    state
+,   chunk_t*    chunk
+,   u64         count
+,   bool        owned
+)
+{
+    ( *chunk ).next = ( *state ).chunks;
+    ( *chunk ).count = count;
+    ( *chunk ).owned = owned;
+    ( *state ).chunks = chunk;
+    ( *state ).node_count += count;
+
+    node_t* content = freelist_chunk_content ( chunk );
+    for ( u64 i = count; i; --i )
+    {
+        freelist_return_node ( state , &content[ i - 1 ] );
+    }
+}
+
+void
+freelist_grow
+(   state_t* state
+)
+{
+    const u64 count = MAX ( ( u64 ) FREELIST_MINIMUM_GROWTH , ( *state ).node_count );
+    chunk_t* chunk = memory_allocate_uninit ( sizeof ( chunk_t ) + count * sizeof ( node_t )
+                                            , MEMORY_TAG_FREELIST
+                                            );
+    if ( !chunk )
+    {
+        return;
+    }
+    freelist_add_chunk ( state , chunk , count , true );
+}
+
+void
+freelist_chunks_init
+(   state_t* state
+)
+{
+    for ( chunk_t* chunk = ( *state ).chunks; chunk; chunk = ( *chunk ).next )
     {
-        if ( ( *state ).content[ i ].size == 0 )
+        node_t* content = freelist_chunk_content ( chunk );
+        for ( u64 i = ( *chunk ).count; i; --i )
         {
-            ( *state ).content[ i ].next = 0;
-            ( *state ).content[ i ].offset = 0;
-            return &( *state ).content[ i ];
+            node_t* node = &content[ i - 1 ];
+            if ( !( *node ).size )
+            {
+                freelist_return_node ( state , node );
+            }
+            else if ( ( *state ).mode == FREELIST_MODE_SEGREGATED_FIT )
+            {
+                freelist_segregated_bin_insert ( state , node );
+            }
+            else
+            {
+                freelist_tree_insert ( state , node );
+            }
         }
     }
-    return 0;
 }
 
+/**
+ * @brief Rebuilds the first-fit search tree of a freelist.
+ * 
+ * The first live_nodes entries of the node array are treated as free blocks
+ * and inserted into the tree; every remaining entry is cleared and pushed onto
+ * the unused node stack. The additional node storage is then sorted likewise
+ * (see freelist_chunks_init).
+ * 
+ * @param state Internal state arguments.
+ * @param live_nodes The number of free blocks packed at the front of the node
+ * storage.
+ */
 void
-freelist_return_node
-(   node_t* node
+freelist_first_fit_init
+(   state_t*    state
+,   u64         live_nodes
 )
 {
-    ( *node ).offset = 0;
-    ( *node ).size = 0;
-    ( *node ).next = 0;
+    ( *state ).root = 0;
+    for ( u64 i = 0; i < live_nodes; ++i )
+    {
+        freelist_tree_insert ( state , &( *state ).content[ i ] );
+    }
+    ( *state ).unused = 0;
+    ( *state ).unused_count = 0;
+    for ( u64 i = ( *state ).max_entries; i > live_nodes; --i )
+    {
+        freelist_return_node ( state , &( *state ).content[ i - 1 ] );
+    }
+    freelist_chunks_init ( state );
 }
+
+/**
+ * @brief Computes the heap priority of a first-fit tree node.
+ * 
+ * The tree is a treap: ordered by offset, and heap-ordered by a priority
+ * which is a hash of the node address, so that it is balanced with high
+ * probability regardless of the order in which blocks are freed.
+ * 
+ * @param node The node. Must be non-zero.
+ * @return The priority of node.
+ */
+u64
+freelist_tree_priority
+(   const node_t* node
+)
+{
+    u64 x = ( u64 ) node;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief Recomputes the largest block size within the subtree of a node from
+ * its children.
+ * 
+ * @param node The node. Must be non-zero.
+ */
+void
+freelist_tree_update
+(   node_t* node
+)
+{
+    u64 largest = ( *node ).size;
+    if ( ( *node ).left && ( *( ( *node ).left ) ).largest > largest )
+    {
+        largest = ( *( ( *node ).left ) ).largest;
+    }
+    if ( ( *node ).right && ( *( ( *node ).right ) ).largest > largest )
+    {
+        largest = ( *( ( *node ).right ) ).largest;
+    }
+    ( *node ).largest = largest;
+}
+
+/**
+ * @brief Splits a subtree into the nodes which precede an offset and the
+ * nodes which do not. O(log n).
+ * 
+ * @param node The root of the subtree.
+ * @param offset The offset to split at.
+ * @param left Output buffer for the root of the nodes which precede offset.
+ * @param right Output buffer for the root of the remaining nodes.
+ */
+void
+freelist_tree_split
+(   node_t*     node
+,   const u64   offset
+,   node_t**    left
+,   node_t**    right
+)
+{
+    if ( !node )
+    {
+        *left = 0;
+        *right = 0;
+        return;
+    }
+    if ( ( *node ).offset < offset )
+    {
+        freelist_tree_split ( ( *node ).right , offset , &( *node ).right , right );
+        *left = node;
+    }
+    else
+    {
+        freelist_tree_split ( ( *node ).left , offset , left , &( *node ).left );
+        *right = node;
+    }
+    freelist_tree_update ( node );
+}
+
+/**
+ * @brief Joins two subtrees, every node of the first of which precedes every
+ * node of the second. O(log n).
+ * 
+ * @param left The root of the first subtree.
+ * @param right The root of the second subtree.
+ * @return The root of the joined tree.
+ */
+node_t*
+freelist_tree_merge
+(   node_t* left
+,   node_t* right
+)
+{
+    if ( !left )
+    {
+        return right;
+    }
+    if ( !right )
+    {
+        return left;
+    }
+    if ( freelist_tree_priority ( left ) > freelist_tree_priority ( right ) )
+    {
+        ( *left ).right = freelist_tree_merge ( ( *left ).right , right );
+        freelist_tree_update ( left );
+        return left;
+    }
+    ( *right ).left = freelist_tree_merge ( left , ( *right ).left );
+    freelist_tree_update ( right );
+    return right;
+}
+
+/**
+ * @brief Inserts a free block into the first-fit tree. O(log n).
+ * 
+ * @param state Internal state arguments.
+ * @param node The free block. Must be non-zero, with non-zero size.
+ */
+void
+freelist_tree_insert
+(   state_t*    state
+,   node_t*     node
+)
+{
+    node_t* left;
+    node_t* right;
+    ( *node ).left = 0;
+    ( *node ).right = 0;
+    ( *node ).next = 0;
+    freelist_tree_update ( node );
+    freelist_tree_split ( ( *state ).root , ( *node ).offset , &left , &right );
+    ( *state ).root = freelist_tree_merge ( freelist_tree_merge ( left , node )
+                                          , right
+                                          );
+}
+
+/**
+ * @brief Unlinks the free block at an offset from a subtree. O(log n).
+ * 
+ * @param node The root of the subtree. Must contain a block at offset.
+ * @param offset The offset of the block.
+ * @return The new root of the subtree.
+ */
+node_t*
+freelist_tree_remove
+(   node_t*     node
+,   const u64   offset
+)
+{
+    if ( ( *node ).offset == offset )
+    {
+        return freelist_tree_merge ( ( *node ).left , ( *node ).right );
+    }
+    if ( offset < ( *node ).offset )
+    {
+        ( *node ).left = freelist_tree_remove ( ( *node ).left , offset );
+    }
+    else
+    {
+        ( *node ).right = freelist_tree_remove ( ( *node ).right , offset );
+    }
+    freelist_tree_update ( node );
+    return node;
+}
+
+/**
+ * @brief Recomputes the largest block size of every node on the path to the
+ * block at an offset, after the size of that block changed. O(log n).
+ * 
+ * @param node The root of the subtree. Must contain a block at offset.
+ * @param offset The offset of the block.
+ */
+void
+freelist_tree_refresh
+(   node_t*     node
+,   const u64   offset
+)
+{
+    if ( ( *node ).offset != offset )
+    {
+        freelist_tree_refresh ( ( offset < ( *node ).offset ) ? ( *node ).left
+                                                              : ( *node ).right
+                              , offset
+                              );
+    }
+    freelist_tree_update ( node );
+}
+
+/**
+ * @brief Implementation of freelist_allocate for FREELIST_MODE_FIRST_FIT.
+ * 
+ * Finds the lowest-addressed free block which fits by descending the tree,
+ * skipping every subtree whose largest block is too small. O(log n).
+ * 
+ * @param state Internal state arguments.
+ * @param size The block size. Must be non-zero.
+ * @param offset Output buffer for block offset. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_first_fit_allocate
+(   state_t*    state
+,   const u64   size
+,   u64*        offset
+)
+{
+    node_t* node = ( *state ).root;
+    if ( !node || ( *node ).largest < size )
+    {
+        return false;
+    }
+    for (;;)
+    {
+        if ( ( *node ).left && ( *( ( *node ).left ) ).largest >= size )
+        {
+            node = ( *node ).left;
+        }
+        else if ( ( *node ).size >= size )
+        {
+            break;
+        }
+        else
+        {
+            node = ( *node ).right;
+        }
+    }
+
+    *offset = ( *node ).offset;
+    if ( ( *node ).size == size )
+    {
+        ( *state ).root = freelist_tree_remove ( ( *state ).root , ( *node ).offset );
+        freelist_return_node ( state , node );
+    }
+    else
+    {
+        // Taking from the front of the block preserves the address order.
+        ( *node ).offset += size;
+        ( *node ).size -= size;
+        freelist_tree_refresh ( ( *state ).root , ( *node ).offset );
+    }
+    ( *state ).free -= size;
+    return true;
+}
+
+/**
+ * @brief Implementation of freelist_free for FREELIST_MODE_FIRST_FIT.
+ * 
+ * Finds the free blocks on either side of the block by descending the tree,
+ * and coalesces the block with either or both of them if adjacent. O(log n).
+ * 
+ * @param state Internal state arguments.
+ * @param size The block size. Must be non-zero.
+ * @param offset The block offset.
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_first_fit_free
+(   state_t*    state
+,   const u64   size
+,   const u64   offset
+)
+{
+    if ( offset + size > ( *state ).capacity )
+    {
+        LOGERROR ( "freelist_free: Block [%u .. %u] lies outside of the freelist range [0 .. %u]."
+                 , offset , offset + size
+                 , ( *state ).capacity
+                 );
+        return false;
+    }
+
+    node_t* previous_node = 0;
+    node_t* next_node = 0;
+    node_t* node = ( *state ).root;
+    while ( node )
+    {
+        if ( ( *node ).offset < offset )
+        {
+            previous_node = node;
+            node = ( *node ).right;
+        }
+        else
+        {
+            next_node = node;
+            node = ( *node ).left;
+        }
+    }
+
+    if (   ( previous_node && ( *previous_node ).offset + ( *previous_node ).size > offset )
+        || ( next_node && ( *next_node ).offset < offset + size )
+       )
+    {
+        LOGERROR ( "freelist_free: Double free occurred at memory offset %@."
+                 , offset
+                 );
+        return false;
+    }
+
+    const bool merge_previous = previous_node
+                             && ( *previous_node ).offset + ( *previous_node ).size == offset
+                              ;
+    const bool merge_next = next_node && offset + size == ( *next_node ).offset;
+    if ( merge_previous && merge_next )
+    {
+        ( *previous_node ).size += size + ( *next_node ).size;
+        ( *state ).root = freelist_tree_remove ( ( *state ).root , ( *next_node ).offset );
+        freelist_return_node ( state , next_node );
+        freelist_tree_refresh ( ( *state ).root , ( *previous_node ).offset );
+    }
+    else if ( merge_previous )
+    {
+        ( *previous_node ).size += size;
+        freelist_tree_refresh ( ( *state ).root , ( *previous_node ).offset );
+    }
+    else if ( merge_next )
+    {
+        // Growing the block backwards preserves the address order.
+        ( *next_node ).offset = offset;
+        ( *next_node ).size += size;
+        freelist_tree_refresh ( ( *state ).root , ( *next_node ).offset );
+    }
+    else
+    {
+        node_t* new_node = freelist_get_node ( state );
+        if ( !new_node )
+        {
+            LOGERROR ( "freelist_free: Node storage exhausted; cannot track any more free blocks." );
+            return false;
+        }
+        ( *new_node ).offset = offset;
+        ( *new_node ).size = size;
+        freelist_tree_insert ( state , new_node );
+    }
+    ( *state ).free += size;
+    return true;
+}
+
+/**
+ * @brief Implementation of freelist_extend for FREELIST_MODE_FIRST_FIT.
+ * O(log n).
+ * 
+ * @param state Internal state arguments.
+ * @param end The offset of the end of the block to grow.
+ * @param additional The number of bytes to add to the block.
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_first_fit_extend
+(   state_t*    state
+,   const u64   end
+,   const u64   additional
+)
+{
+    node_t* node = ( *state ).root;
+    while ( node && ( *node ).offset != end )
+    {
+        node = ( end < ( *node ).offset ) ? ( *node ).left : ( *node ).right;
+    }
+    if ( !node || ( *node ).size < additional )
+    {
+        return false;
+    }
+
+    if ( ( *node ).size == additional )
+    {
+        ( *state ).root = freelist_tree_remove ( ( *state ).root , end );
+        freelist_return_node ( state , node );
+    }
+    else
+    {
+        ( *node ).offset += additional;
+        ( *node ).size -= additional;
+        freelist_tree_refresh ( ( *state ).root , ( *node ).offset );
+    }
+    ( *state ).free -= additional;
+    return true;
+}
+
+/**
+ * @brief Rebuilds the segregated-fit bins of a freelist.
+ * 
+ * The first live_nodes entries of the node array are treated as free blocks
+ * and sorted into their size classes; every remaining entry is cleared and
+ * pushed onto the unused node stack. The additional node storage is then
+ * sorted likewise (see freelist_chunks_init).
+ * 
+ * @param state Internal state arguments.
+ * @param live_nodes The number of free blocks packed at the front of the node
+ * storage.
+ */
+void
+freelist_segregated_init
+(   state_t*    state
+,   u64         live_nodes
+)
+{
+    bitv_clr_all ( ( *state ).bitmap , FREELIST_BIN_COUNT );
+    memory_clear ( ( *state ).bins , sizeof ( node_t* ) * FREELIST_BIN_COUNT );
+    for ( u64 i = 0; i < live_nodes; ++i )
+    {
+        freelist_segregated_bin_insert ( state , &( *state ).content[ i ] );
+    }
+    ( *state ).unused = 0;
+    ( *state ).unused_count = 0;
+    for ( u64 i = ( *state ).max_entries; i > live_nodes; --i )
+    {
+        freelist_return_node ( state , &( *state ).content[ i - 1 ] );
+    }
+    freelist_chunks_init ( state );
+}
+
+/**
+ * @brief Pushes a free block onto the bin for its size class.
+ * 
+ * @param state Internal state arguments.
+ * @param node The free block. Must be non-zero, with non-zero size.
+ */
+void
+freelist_segregated_bin_insert
+(   state_t*    state
+,   node_t*     node
+)
+{
+    const u8 bin = bitscan_reverse ( ( *node ).size );
+    ( *node ).next = ( *state ).bins[ bin ];
+    ( *state ).bins[ bin ] = node;
+    bitv_set ( ( *state ).bitmap , bin );
+}
+
+/**
+ * @brief Unlinks a free block of at least the requested size from the bins.
+ * 
+ * Every block in bin i has a size within [ 2^i , 2^(i+1) ), so any block in
+ * the lowest non-empty bin at or above ceil ( log2 ( size ) ) fits; that bin is
+ * found with a single bit scan. Only if there is none is the bin containing
+ * size itself searched.
+ * 
+ * @param state Internal state arguments.
+ * @param size The requested size. Must be non-zero.
+ * @return A free block of at least size bytes, or 0 if there is none.
+ */
+node_t*
+freelist_segregated_bin_take
+(   state_t*    state
+,   const u64   size
+)
+{
+    const u8 floor_bin = bitscan_reverse ( size );
+    const u8 ceil_bin = floor_bin + ( ( size & ( size - 1 ) ) != 0 );
+    if ( ceil_bin < FREELIST_BIN_COUNT )
+    {
+        const u64 bin = bitv_next_set ( ( *state ).bitmap , FREELIST_BIN_COUNT , ceil_bin );
+        if ( bin < FREELIST_BIN_COUNT )
+        {
+            node_t* node = ( *state ).bins[ bin ];
+            ( *state ).bins[ bin ] = ( *node ).next;
+            if ( !( *state ).bins[ bin ] )
+            {
+                bitv_clr ( ( *state ).bitmap , bin );
+            }
+            ( *node ).next = 0;
+            return node;
+        }
+    }
+    if ( ceil_bin == floor_bin )
+    {
+        return 0;
+    }
+    node_t* previous_node = 0;
+    node_t* node = ( *state ).bins[ floor_bin ];
+    while ( node )
+    {
+        if ( ( *node ).size >= size )
+        {
+            if ( previous_node )
+            {
+                ( *previous_node ).next = ( *node ).next;
+            }
+            else
+            {
+                ( *state ).bins[ floor_bin ] = ( *node ).next;
+                if ( !( *state ).bins[ floor_bin ] )
+                {
+                    bitv_clr ( ( *state ).bitmap , floor_bin );
+                }
+            }
+            ( *node ).next = 0;
+            return node;
+        }
+        previous_node = node;
+        node = ( *node ).next;
+    }
+    return 0;
+}
+
+/**
+ * @brief Pops a node from the unused node stack, coalescing the free blocks
+ * first if the stack is empty.
+ * 
+ * @param state Internal state arguments.
+ * @return An unused node, or 0 if the node storage is exhausted.
+ */
+node_t*
+freelist_segregated_get_node
+(   state_t* state
+)
+{
+    if ( !( *state ).unused )
+    {
+        freelist_segregated_coalesce ( state );
+    }
+    return freelist_get_node ( state );
+}
+
+/**
+ * @brief Merges all adjacent free blocks, then rebuilds the bins.
+ * 
+ * The free blocks are sorted by address by inserting them into the first-fit
+ * search tree (see freelist_tree_insert), which, unlike an in-place sort, does
+ * not require the nodes to be contiguous. O(n log(n)) in the number of free
+ * blocks; only invoked when an allocation cannot otherwise be satisfied, or
+ * when the node storage is exhausted.
+ * 
+ * @param state Internal state arguments.
+ */
+void
+freelist_segregated_coalesce
+(   state_t* state
+)
+{
+    ( *state ).root = 0;
+    for ( u64 i = 0; i < FREELIST_BIN_COUNT; ++i )
+    {
+        node_t* node = ( *state ).bins[ i ];
+        while ( node )
+        {
+            node_t* next = ( *node ).next;
+            freelist_tree_insert ( state , node );
+            node = next;
+        }
+    }
+    bitv_clr_all ( ( *state ).bitmap , FREELIST_BIN_COUNT );
+    memory_clear ( ( *state ).bins , sizeof ( node_t* ) * FREELIST_BIN_COUNT );
+
+    ( *state ).free = 0;
+    node_t* previous_node = 0;
+    freelist_segregated_coalesce_walk ( state , ( *state ).root , &previous_node );
+    if ( previous_node )
+    {
+        ( *state ).free += ( *previous_node ).size;
+        freelist_segregated_bin_insert ( state , previous_node );
+    }
+    ( *state ).root = 0;
+}
+
+/**
+ * @brief Visits the free blocks of a subtree in address order, merging each
+ * into the preceding block if adjacent, and otherwise sorting the preceding
+ * block into its bin (see freelist_segregated_coalesce).
+ * 
+ * @param state Internal state arguments.
+ * @param node The root of the subtree.
+ * @param previous_node The preceding free block, which is yet to be binned (0
+ * if there is none).
+ */
+void
+freelist_segregated_coalesce_walk
+(   state_t*    state
+,   node_t*     node
+,   node_t**    previous_node
+)
+{
+    if ( !node )
+    {
+        return;
+    }
+    node_t* right = ( *node ).right;
+    freelist_segregated_coalesce_walk ( state , ( *node ).left , previous_node );
+
+    node_t* previous = *previous_node;
+    const u64 previous_end = previous ? ( *previous ).offset + ( *previous ).size : 0;
+    if ( previous && previous_end >= ( *node ).offset )
+    {
+        if ( previous_end > ( *node ).offset )
+        {
+            LOGERROR ( "freelist_free: Double free occurred at memory offset %@."
+                     , ( *node ).offset
+                     );
+        }
+        ( *previous ).size = MAX ( previous_end
+                                 , ( *node ).offset + ( *node ).size
+                                 )
+                           - ( *previous ).offset
+                           ;
+        freelist_return_node ( state , node );
+    }
+    else
+    {
+        if ( previous )
+        {
+            ( *state ).free += ( *previous ).size;
+            freelist_segregated_bin_insert ( state , previous );
+        }
+        *previous_node = node;
+    }
+
+    freelist_segregated_coalesce_walk ( state , right , previous_node );
+}
+
+/**
+ * @brief Implementation of freelist_allocate for
+ * FREELIST_MODE_SEGREGATED_FIT.
+ * 
+ * @param state Internal state arguments.
+ * @param size The block size. Must be non-zero.
+ * @param offset Output buffer for block offset. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_segregated_allocate
+(   state_t*    state
+,   const u64   size
+,   u64*        offset
+)
+{
+    node_t* node = freelist_segregated_bin_take ( state , size );
+    if ( !node )
+    {
+        freelist_segregated_coalesce ( state );
+        node = freelist_segregated_bin_take ( state , size );
+    }
+    if ( node )
+    {
+        *offset = ( *node ).offset;
+        if ( ( *node ).size == size )
+        {
+            freelist_return_node ( state , node );
+        }
+        else
+        {
+            ( *node ).offset += size;
+            ( *node ).size -= size;
+            freelist_segregated_bin_insert ( state , node );
+        }
+        ( *state ).free -= size;
+        return true;
+    }
+
+    f64 req_amount;    
+    f64 rem_amount;
+    const char* req_unit = string_bytesize ( size , &req_amount );
+    const char* rem_unit = string_bytesize ( freelist_query_free ( state ) , &rem_amount );
+    LOGWARN ( "freelist_allocate: No block with enough free space found (requested: %.2f %s, available: %.2f %s)."
+            , &req_amount , req_unit
+            , &rem_amount , rem_unit
+            );
+
+    return false;
+}
+
+/**
+ * @brief Implementation of freelist_free for FREELIST_MODE_SEGREGATED_FIT.
+ * 
+ * @param state Internal state arguments.
+ * @param size The block size. Must be non-zero.
+ * @param offset The block offset.
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_segregated_free
+(   state_t*    state
+,   const u64   size
+,   const u64   offset
+)
+{
+    if ( offset + size > ( *state ).capacity )
+    {
+        LOGERROR ( "freelist_free: Block [%u .. %u] lies outside of the freelist range [0 .. %u]."
+                 , offset , offset + size
+                 , ( *state ).capacity
+                 );
+        return false;
+    }
+    node_t* node = freelist_segregated_get_node ( state );
+    if ( !node )
+    {
+        LOGERROR ( "freelist_free: Node storage exhausted; cannot track any more free blocks." );
+        return false;
+    }
+    ( *node ).offset = offset;
+    ( *node ).size = size;
+    freelist_segregated_bin_insert ( state , node );
+    ( *state ).free += size;
+    return true;
+}
+
+/**
+ * @brief Implementation of freelist_extend for FREELIST_MODE_SEGREGATED_FIT.
+ * 
+ * O(n) in the number of free blocks, as the bins are not address-ordered.
+ * 
+ * @param state Internal state arguments.
+ * @param end The offset of the end of the block to grow.
+ * @param additional The number of bytes to add to the block.
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_segregated_extend
+(   state_t*    state
+,   const u64   end
+,   const u64   additional
+)
+{
+    const u8* bitmap = ( *state ).bitmap;
+    for ( u64 bin = bitv_first_set ( bitmap , FREELIST_BIN_COUNT ); bin < FREELIST_BIN_COUNT; bin = bitv_next_set ( bitmap , FREELIST_BIN_COUNT , bin + 1 ) )
+    {
+        node_t* previous_node = 0;
+        node_t* node = ( *state ).bins[ bin ];
+        while ( node && ( *node ).offset != end )
+        {
+            previous_node = node;
+            node = ( *node ).next;
+        }
+        if ( !node )
+        {
+            continue;
+        }
+        if ( ( *node ).size < additional )
+        {
+            return false;
+        }
+
+        if ( previous_node )
+        {
+            ( *previous_node ).next = ( *node ).next;
+        }
+        else
+        {
+            ( *state ).bins[ bin ] = ( *node ).next;
+            if ( !( *state ).bins[ bin ] )
+            {
+                bitv_clr ( ( *state ).bitmap , bin );
+            }
+        }
+
+        if ( ( *node ).size == additional )
+        {
+            freelist_return_node ( state , node );
+        }
+        else
+        {
+            ( *node ).offset += additional;
+            ( *node ).size -= additional;
+            freelist_segregated_bin_insert ( state , node );
+        }
+        ( *state ).free -= additional;
+        return true;
+    }
+    return false;
+}
\ No newline at end of file
@@ -11,9 +11,37 @@
 /** @brief Type declaration for a freelist. */
 typedef void freelist_t;
 
+/** @brief Type and instance definitions for freelist allocation strategies. */
+typedef enum
+{
+    /**
+     * @brief First-fit: free blocks are kept in an address-ordered balanced
+     * search tree (a treap), each node of which records the largest block
+     * within its subtree. Allocation finds the lowest-addressed block which
+     * fits by descending the tree; release finds both neighbours of a block by
+     * address and coalesces it with them immediately. O(log n) in the number
+     * of free blocks.
+     */
+    FREELIST_MODE_FIRST_FIT
+
+    /**
+     * @brief Segregated-fit: free blocks are binned by power-of-two size class,
+     * with a bitmap of non-empty classes. Allocation and release are O(1);
+     * adjacent free blocks are coalesced lazily (only when an allocation
+     * cannot otherwise be satisfied, or when the node storage is exhausted).
+     * Double frees are detected during coalescing rather than on release.
+     */
+,   FREELIST_MODE_SEGREGATED_FIT
+
+,   FREELIST_MODE_COUNT
+}
+FREELIST_MODE;
+
 /**
  * @brief Initializes a freelist.
  * 
+ * Use freelist_create to initialize a first-fit freelist.
+ * 
  * If pre-allocating a memory buffer:
  *   Call once to get the memory requirement; call a second time passing in a
  *   valid memory buffer of the required size.
@@ -22,7 +50,20 @@ typedef void freelist_t;
  *   Uses dynamic memory allocation (see core/memory.h). Call freelist_destroy
  *   to free.
  * 
+ * Each free block is tracked by a node. The node storage sized here holds
+ * node_count nodes; by default, capacity / 384 (at least 20). If it runs out,
+ * a freelist using implicit memory allocation grows it by allocating
+ * additional blocks of nodes, so that existing nodes are never copied and
+ * freelist_free never fails for lack of one; a freelist using a pre-allocated
+ * buffer must be supplied with additional node storage by the caller instead
+ * (see freelist_add_nodes).
+ * 
  * @param capacity The requested capacity in bytes.
+ * @param mode The allocation strategy (see FREELIST_MODE).
+ * @param node_count The number of nodes to pre-allocate, or 0 for the default.
+ * The node storage is cleared on creation, so a freelist of large capacity
+ * whose node storage is grown on demand may pass a small count to be created
+ * in O(1).
  * @param memory_requirement Output buffer to hold the actual number of bytes
  * required to operate the freelist. Only applicable if pre-allocating a memory
  * buffer of the required size. Pass 0 to use implicit memory allocation.
@@ -33,13 +74,25 @@ typedef void freelist_t;
  * @return true on success; false otherwise.
  */
 bool
-freelist_create
+_freelist_create
 (   u64             capacity
+,   FREELIST_MODE   mode
+,   u64             node_count
 ,   u64*            memory_requirement
 ,   void*           memory
 ,   freelist_t**    freelist
 );
 
+/** @brief Alias for calling _freelist_create with FREELIST_MODE_FIRST_FIT. */
+#define freelist_create(capacity,memory_requirement,memory,freelist) \
+    _freelist_create ( (capacity)                                    \
+                     , FREELIST_MODE_FIRST_FIT                       \
+                     , 0                                             \
+                     , (memory_requirement)                          \
+                     , (memory)                                      \
+                     , (freelist)                                    \
+                     )
+
 /**
  * @brief Frees the memory used by a freelist.
  * 
@@ -66,6 +119,17 @@ freelist_owns_memory
 (   const freelist_t* freelist
 );
 
+/**
+ * @brief Queries the allocation strategy of a freelist.
+ * 
+ * @param freelist The freelist to query. Must be non-zero.
+ * @return The allocation strategy of freelist (see FREELIST_MODE).
+ */
+FREELIST_MODE
+freelist_mode
+(   const freelist_t* freelist
+);
+
 /**
  * @brief Allocates a memory block within a freelist.
  * 
@@ -96,6 +160,76 @@ freelist_free
 ,   u64         offset
 );
 
+/**
+ * @brief Grows an existing memory block within a freelist in place, by taking
+ * space from the free block which immediately follows it.
+ * 
+ * Fails without modifying the freelist if the block is not immediately
+ * followed by at least additional bytes of free space. In segregated-fit
+ * mode, free blocks are coalesced lazily, so space which is free but not yet
+ * merged into a single block is not considered.
+ * 
+ * @param freelist The freelist to mutate. Must be non-zero.
+ * @param size The current block size. Must be non-zero.
+ * @param offset The block offset.
+ * @param additional The number of bytes to add to the block. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_extend
+(   freelist_t* freelist
+,   u64         size
+,   u64         offset
+,   u64         additional
+);
+
+/**
+ * @brief Supplies a freelist with additional node storage. O(n) in the number
+ * of nodes added.
+ * 
+ * Intended for a freelist using a pre-allocated buffer, which cannot grow its
+ * node storage on its own (see _freelist_create); the caller may, for instance,
+ * carve the buffer from the region the freelist manages. The buffer is held
+ * until the freelist is destroyed, and is never freed by the freelist.
+ * 
+ * @param freelist The freelist to mutate. Must be non-zero.
+ * @param memory The buffer. Must be aligned to at least eight bytes.
+ * @param size The size of memory in bytes. At least freelist_node_size ( 1 ).
+ * @return true on success; false otherwise.
+ */
+bool
+freelist_add_nodes
+(   freelist_t* freelist
+,   void*       memory
+,   u64         size
+);
+
+/**
+ * @brief Computes the size of a buffer holding a given number of nodes (see
+ * freelist_add_nodes).
+ * 
+ * @param count The number of nodes.
+ * @return The buffer size in bytes.
+ */
+u64
+freelist_node_size
+(   u64 count
+);
+
+/**
+ * @brief Queries the number of unused nodes of a freelist, i.e. the number of
+ * additional free blocks it can track before its node storage must grow.
+ * 
+ * Each call to freelist_free uses at most one node.
+ * 
+ * @param freelist The freelist to query. Must be non-zero.
+ * @return The number of unused nodes.
+ */
+u64
+freelist_query_unused_nodes
+(   freelist_t* freelist
+);
+
 /**
  * @brief Resizes a freelist to accomodate a new maximum capacity.
  *
@@ -144,10 +278,7 @@ freelist_reset
 );
 
 /**
- * @brief Queries the amount of free space remaining within a freelist.
- * 
- * This function is expensive and should be used sparingly, but it is useful for
- * unit testing.
+ * @brief Queries the amount of free space remaining within a freelist. O(1).
  * 
  * @param freelist The freelist to query. Must be non-zero.
  * @return The number of bytes of free space remaining within freelist.
@@ -157,4 +288,36 @@ freelist_query_free
 (   freelist_t* freelist
 );
 
+/**
+ * @brief Queries the size of the largest free block within a freelist, i.e.
+ * the largest allocation which is guaranteed to succeed.
+ * 
+ * O(1) in first-fit mode; in segregated-fit mode, O(n) in the number of free
+ * blocks in the highest size class.
+ * 
+ * @param freelist The freelist to query. Must be non-zero.
+ * @return The size of the largest free block in bytes (0 if there is none).
+ */
+u64
+freelist_query_largest_free
+(   freelist_t* freelist
+);
+
+/**
+ * @brief Queries the external fragmentation of a freelist:
+ * 1 - ( largest free block / total free space ).
+ * 
+ * 0 means the free space is a single block; values near 1 mean it is scattered
+ * across many small blocks, so that large allocations may fail even though
+ * enough total space is free. In segregated-fit mode, adjacent free blocks are
+ * coalesced lazily, so the value may be overstated until the next coalescing.
+ * 
+ * @param freelist The freelist to query. Must be non-zero.
+ * @return The fragmentation in [ 0 , 1 ] (0 if there is no free space).
+ */
+f64
+freelist_query_fragmentation
+(   freelist_t* freelist
+);
+
 #endif  // FREELIST_H
\ No newline at end of file
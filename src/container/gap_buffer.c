@@ -0,0 +1,331 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/gap_buffer.c
+ * @brief Implementation of the container/gap_buffer header.
+ * (see container/gap_buffer.h for additional details)
+ */
+#include "container/gap_buffer.h"
+
+#include "container/string.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    char*   content;
+    u64     capacity;
+
+    // The gap occupies content[ gap_start ] through content[ gap_end - 1 ].
+    u64     gap_start;
+    u64     gap_end;
+}
+state_t;
+
+/**
+ * @brief Queries the number of characters in a gap buffer.
+ *
+ * @param state Internal state.
+ * @return The length of the text.
+ */
+INLINE
+u64
+_gap_buffer_length
+(   const state_t* state
+)
+{
+    return ( *state ).capacity - ( ( *state ).gap_end - ( *state ).gap_start );
+}
+
+/**
+ * @brief Moves the gap of a gap buffer to a specified index, by moving the
+ * text between its old and new position across it.
+ *
+ * @param state Internal state.
+ * @param index The new position of the gap. Must not exceed the length.
+ */
+void
+_gap_buffer_move
+(   state_t*    state
+,   const u64   index
+);
+
+/**
+ * @brief Ensures the gap of a gap buffer is at least a specified size,
+ * growing the buffer if it is not.
+ *
+ * @param state Internal state.
+ * @param size The required gap size (in characters).
+ */
+void
+_gap_buffer_reserve
+(   state_t*    state
+,   const u64   size
+);
+
+gap_buffer_t*
+_gap_buffer_create
+(   const char* src
+,   u64         length
+,   u64         initial_capacity
+)
+{
+    if ( length && !src )
+    {
+        LOGERROR ( "_gap_buffer_create: Missing argument: src." );
+        return 0;
+    }
+
+    state_t* state = memory_allocate ( sizeof ( state_t ) , MEMORY_TAG_STRING );
+    ( *state ).capacity = MAX ( MAX ( initial_capacity , length ) , ( u64 ) 1 );
+    ( *state ).content = memory_allocate_uninit ( ( *state ).capacity , MEMORY_TAG_STRING );
+    if ( length )
+    {
+        memory_copy ( ( *state ).content , src , length );
+    }
+    ( *state ).gap_start = length;
+    ( *state ).gap_end = ( *state ).capacity;
+    return state;
+}
+
+void
+gap_buffer_destroy
+(   gap_buffer_t* buffer
+)
+{
+    if ( !buffer )
+    {
+        return;
+    }
+    state_t* state = buffer;
+    memory_free ( ( *state ).content , ( *state ).capacity , MEMORY_TAG_STRING );
+    memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_STRING );
+}
+
+u64
+gap_buffer_length
+(   const gap_buffer_t* buffer
+)
+{
+    return _gap_buffer_length ( buffer );
+}
+
+u64
+gap_buffer_cursor
+(   const gap_buffer_t* buffer
+)
+{
+    return ( *( ( const state_t* ) buffer ) ).gap_start;
+}
+
+void
+gap_buffer_move
+(   gap_buffer_t*   buffer
+,   u64             index
+)
+{
+    state_t* state = buffer;
+    _gap_buffer_move ( state , MIN ( index , _gap_buffer_length ( state ) ) );
+}
+
+bool
+gap_buffer_insert
+(   gap_buffer_t*   buffer
+,   u64             index
+,   const char*     src
+,   u64             length
+)
+{
+    return gap_buffer_replace ( buffer , index , 0 , src , length );
+}
+
+bool
+gap_buffer_remove
+(   gap_buffer_t*   buffer
+,   u64             index
+,   u64             count
+)
+{
+    return gap_buffer_replace ( buffer , index , count , 0 , 0 );
+}
+
+bool
+gap_buffer_replace
+(   gap_buffer_t*   buffer
+,   u64             index
+,   u64             count
+,   const char*     src
+,   u64             length
+)
+{
+    state_t* state = buffer;
+    const u64 old_length = _gap_buffer_length ( state );
+    if ( index > old_length || count > old_length - index )
+    {
+        LOGERROR ( "gap_buffer_replace: Called with illegal index or count: (index %i + count %i) > %i (length)."
+                 , index , count , old_length
+                 );
+        return false;
+    }
+    if ( length && !src )
+    {
+        LOGERROR ( "gap_buffer_replace: Missing argument: src." );
+        return false;
+    }
+
+    // Removing the range only widens the gap.
+    _gap_buffer_move ( state , index );
+    ( *state ).gap_end += count;
+
+    if ( length )
+    {
+        _gap_buffer_reserve ( state , length );
+        memory_copy ( ( *state ).content + ( *state ).gap_start , src , length );
+        ( *state ).gap_start += length;
+    }
+    return true;
+}
+
+char
+gap_buffer_get
+(   const gap_buffer_t* buffer
+,   u64                 index
+)
+{
+    const state_t* state = buffer;
+    if ( index >= ( *state ).gap_start )
+    {
+        index += ( *state ).gap_end - ( *state ).gap_start;
+    }
+    return ( *state ).content[ index ];
+}
+
+void
+gap_buffer_segments
+(   const gap_buffer_t* buffer
+,   string_view_t*      before
+,   string_view_t*      after
+)
+{
+    const state_t* state = buffer;
+    ( *before ).string = ( *state ).content;
+    ( *before ).length = ( *state ).gap_start;
+    ( *after ).string = ( *state ).content + ( *state ).gap_end;
+    ( *after ).length = ( *state ).capacity - ( *state ).gap_end;
+}
+
+bool
+gap_buffer_read
+(   const gap_buffer_t* buffer
+,   u64                 index
+,   u64                 count
+,   char*               dst
+)
+{
+    const state_t* state = buffer;
+    const u64 length = _gap_buffer_length ( state );
+    if ( index > length || count > length - index )
+    {
+        LOGERROR ( "gap_buffer_read: Called with illegal index or count: (index %i + count %i) > %i (length)."
+                 , index , count , length
+                 );
+        return false;
+    }
+
+    // Copy the part of the range before the gap, then the part after it.
+    const u64 gap_size = ( *state ).gap_end - ( *state ).gap_start;
+    const u64 before = ( index < ( *state ).gap_start )
+                     ? MIN ( count , ( *state ).gap_start - index )
+                     : 0
+                     ;
+    if ( before )
+    {
+        memory_copy ( dst , ( *state ).content + index , before );
+    }
+    if ( count > before )
+    {
+        memory_copy ( dst + before
+                    , ( *state ).content + index + before + gap_size
+                    , count - before
+                    );
+    }
+    return true;
+}
+
+char*
+gap_buffer_flatten
+(   const gap_buffer_t* buffer
+)
+{
+    string_view_t before;
+    string_view_t after;
+    gap_buffer_segments ( buffer , &before , &after );
+
+    //                                                      v terminator, and
+    //                                                        room to push
+    //                                                        without growing.
+    char* string = _string_create ( before.length + after.length + 2 );
+    string_push ( string , before.string , before.length );
+    string_push ( string , after.string , after.length );
+    return string;
+}
+
+void
+_gap_buffer_move
+(   state_t*    state
+,   const u64   index
+)
+{
+    char* content = ( *state ).content;
+    const u64 gap_start = ( *state ).gap_start;
+    const u64 gap_end = ( *state ).gap_end;
+    if ( index < gap_start )
+    {
+        // Move the text between index and the gap to after the gap.
+        const u64 distance = gap_start - index;
+        memory_move ( content + gap_end - distance , content + index , distance );
+        ( *state ).gap_start = index;
+        ( *state ).gap_end = gap_end - distance;
+    }
+    else if ( index > gap_start )
+    {
+        // Move the text between the gap and index to before the gap.
+        const u64 distance = index - gap_start;
+        memory_move ( content + gap_start , content + gap_end , distance );
+        ( *state ).gap_start = index;
+        ( *state ).gap_end = gap_end + distance;
+    }
+}
+
+void
+_gap_buffer_reserve
+(   state_t*    state
+,   const u64   size
+)
+{
+    const u64 gap_size = ( *state ).gap_end - ( *state ).gap_start;
+    if ( gap_size >= size )
+    {
+        return;
+    }
+
+    const u64 old_capacity = ( *state ).capacity;
+    const u64 tail = old_capacity - ( *state ).gap_end;
+    const u64 capacity = GAP_BUFFER_SCALE_FACTOR ( old_capacity - gap_size + size );
+
+    // Grow the block, then move the text after the gap to its new end.
+    ( *state ).content = memory_reallocate ( ( *state ).content
+                                           , old_capacity
+                                           , capacity
+                                           , MEMORY_TAG_STRING
+                                           );
+    memory_move ( ( *state ).content + capacity - tail
+                , ( *state ).content + ( *state ).gap_end
+                , tail
+                );
+    ( *state ).capacity = capacity;
+    ( *state ).gap_end = capacity - tail;
+}
@@ -0,0 +1,235 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/gap_buffer.h
+ * @brief Provides an interface for a gap buffer: a text container for
+ * repeated edits in the middle of large text.
+ *
+ * The text is stored in one buffer with a gap of unused capacity at the
+ * cursor. An edit at the cursor only fills or widens the gap; moving the
+ * cursor moves only the text between its old and new position. A sequence of
+ * edits which are close together therefore costs time proportional to the
+ * size of the edits and the distance between them, rather than to the length
+ * of the text (as with string_insert and string_remove in
+ * container/string.h, which move the entire tail on every edit).
+ *
+ * The text is contiguous only in two segments, before and after the gap (see
+ * gap_buffer_segments). Call gap_buffer_flatten to obtain a resizable string.
+ */
+#ifndef GAP_BUFFER_H
+#define GAP_BUFFER_H
+
+#include "common.h"
+
+#include "core/string.h"
+
+/** @brief Type declaration for a gap buffer. */
+typedef void gap_buffer_t;
+
+/** @brief Gap buffer default capacity (in characters). */
+#define GAP_BUFFER_DEFAULT_CAPACITY 256
+
+/** @brief Gap buffer rescale factor. */
+#define GAP_BUFFER_SCALE_FACTOR(capacity) \
+    ( ( 3 * (capacity) ) >> 1 )
+
+/**
+ * @brief Allocates memory for a gap buffer, and copies initial text into it.
+ *
+ * Use gap_buffer_create for an empty gap buffer, or gap_buffer_create_from to
+ * copy a null-terminated string.
+ *
+ * Uses dynamic memory allocation. Call gap_buffer_destroy to free.
+ *
+ * @param src The initial text. Must be non-zero if length is non-zero.
+ * @param length The number of characters in src.
+ * @param initial_capacity The initial capacity (in characters). Raised to
+ * length if it is smaller.
+ * @return A gap buffer containing src, with the cursor at its end.
+ */
+gap_buffer_t*
+_gap_buffer_create
+(   const char* src
+,   u64         length
+,   u64         initial_capacity
+);
+
+#define gap_buffer_create() \
+    _gap_buffer_create ( 0 , 0 , GAP_BUFFER_DEFAULT_CAPACITY )
+
+#define gap_buffer_create_from(string)                                  \
+    ({                                                                  \
+        const char* string__ = (string);                                \
+        const u64 length__ = _string_length ( string__ );               \
+        _gap_buffer_create ( string__                                   \
+                           , length__                                   \
+                           , length__ + GAP_BUFFER_DEFAULT_CAPACITY     \
+                           );                                           \
+    })
+
+/**
+ * @brief Frees the memory used by a gap buffer.
+ *
+ * @param buffer The gap buffer to free.
+ */
+void
+gap_buffer_destroy
+(   gap_buffer_t* buffer
+);
+
+/**
+ * @brief Queries the number of characters in a gap buffer. O(1).
+ *
+ * @param buffer The gap buffer to query. Must be non-zero.
+ * @return The length of the text.
+ */
+u64
+gap_buffer_length
+(   const gap_buffer_t* buffer
+);
+
+/**
+ * @brief Queries the position of the cursor (the gap) in a gap buffer. O(1).
+ *
+ * @param buffer The gap buffer to query. Must be non-zero.
+ * @return The index of the character after the cursor.
+ */
+u64
+gap_buffer_cursor
+(   const gap_buffer_t* buffer
+);
+
+/**
+ * @brief Moves the cursor of a gap buffer. O(distance).
+ *
+ * Edits move the cursor automatically; call this only to prepare for a
+ * sequence of edits, or to choose where the segments split.
+ *
+ * @param buffer The gap buffer to mutate. Must be non-zero.
+ * @param index The new position of the cursor. Clamped to the length.
+ */
+void
+gap_buffer_move
+(   gap_buffer_t*   buffer
+,   u64             index
+);
+
+/**
+ * @brief Inserts text into a gap buffer, and leaves the cursor after it.
+ * O(length + distance moved), on average.
+ *
+ * @param buffer The gap buffer to insert into. Must be non-zero.
+ * @param index The index to insert at.
+ * @param src The text to insert. Must be non-zero if length is non-zero, and
+ * must not point into the gap buffer.
+ * @param length The number of characters in src.
+ * @return true on success; false if index is out of bounds.
+ */
+bool
+gap_buffer_insert
+(   gap_buffer_t*   buffer
+,   u64             index
+,   const char*     src
+,   u64             length
+);
+
+/**
+ * @brief Removes a range of text from a gap buffer, and leaves the cursor in
+ * its place. O(distance moved).
+ *
+ * @param buffer The gap buffer to remove from. Must be non-zero.
+ * @param index The index of the first character to remove.
+ * @param count The number of characters to remove.
+ * @return true on success; false if the range is out of bounds.
+ */
+bool
+gap_buffer_remove
+(   gap_buffer_t*   buffer
+,   u64             index
+,   u64             count
+);
+
+/**
+ * @brief Replaces a range of text in a gap buffer, and leaves the cursor
+ * after the replacement. O(length + distance moved), on average.
+ *
+ * @param buffer The gap buffer to mutate. Must be non-zero.
+ * @param index The index of the first character to replace.
+ * @param count The number of characters to replace.
+ * @param src The replacement text. Must be non-zero if length is non-zero,
+ * and must not point into the gap buffer.
+ * @param length The number of characters in src.
+ * @return true on success; false if the range is out of bounds.
+ */
+bool
+gap_buffer_replace
+(   gap_buffer_t*   buffer
+,   u64             index
+,   u64             count
+,   const char*     src
+,   u64             length
+);
+
+/**
+ * @brief Obtains a character of a gap buffer. O(1).
+ *
+ * @param buffer The gap buffer to query. Must be non-zero.
+ * @param index The index of the character. Must be less than the length.
+ * @return The character at index.
+ */
+char
+gap_buffer_get
+(   const gap_buffer_t* buffer
+,   u64                 index
+);
+
+/**
+ * @brief Obtains the text of a gap buffer as two views: the text before the
+ * cursor, and the text after it. O(1).
+ *
+ * Iterate over both views, in order, to visit every character without
+ * copying. The views are invalidated by any edit.
+ *
+ * @param buffer The gap buffer to query. Must be non-zero.
+ * @param before Output buffer for the text before the cursor. Must be
+ * non-zero.
+ * @param after Output buffer for the text after the cursor. Must be non-zero.
+ */
+void
+gap_buffer_segments
+(   const gap_buffer_t* buffer
+,   string_view_t*      before
+,   string_view_t*      after
+);
+
+/**
+ * @brief Copies a range of text out of a gap buffer. O(count).
+ *
+ * @param buffer The gap buffer to query. Must be non-zero.
+ * @param index The index of the first character to copy.
+ * @param count The number of characters to copy.
+ * @param dst Output buffer for count characters (not null-terminated). Must
+ * be non-zero.
+ * @return true on success; false if the range is out of bounds.
+ */
+bool
+gap_buffer_read
+(   const gap_buffer_t* buffer
+,   u64                 index
+,   u64                 count
+,   char*               dst
+);
+
+/**
+ * @brief Copies the text of a gap buffer into a new resizable string. O(n).
+ *
+ * Uses dynamic memory allocation. Call string_destroy to free.
+ *
+ * @param buffer The gap buffer to copy. Must be non-zero.
+ * @return A resizable string containing the text.
+ */
+char*
+gap_buffer_flatten
+(   const gap_buffer_t* buffer
+);
+
+#endif  // GAP_BUFFER_H
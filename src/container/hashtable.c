@@ -6,38 +6,281 @@
  */
 #include "container/hashtable.h"
 
+#include "core/image.h"
 #include "core/logger.h"
 #include "core/memory.h"
 
+#include "math/math.h"
+
+/** @brief Type definition for a hashtable slot. */
+typedef struct
+{
+    u64     hash;
+    u64     key_length;
+    union
+    {
+        u8      inline_key[ HASHTABLE_KEY_INLINE_CAPACITY ];
+        void*   key;
+    }
+    key;
+
+    // Distance from the home slot plus one; zero if the slot is empty.
+    u64     distance;
+}
+slot_t;
+
 /** @brief Type definition for internal state. */
 typedef struct
 {
     u64     stride;
     u32     capacity;
+    u64     length;
+    u64     slot_count;
+    u64     entry_size;
+    u64     memory_requirement;
+    u64     seed;
+
+    hash_function_t hash_function;
+
     bool    pointer;
     bool    owns_memory;
     void*   content;
+
+    // The image used in place, or 0 (see _hashtable_create_from_image). The
+    // long keys of an image hold offsets from its start instead of addresses.
+    const u8*   image;
 }
 state_t;
 
+/**
+ * @brief Number of spare entries at the end of the hashtable content, used as
+ * scratch space while displacing entries.
+ */
+#define HASHTABLE_SCRATCH_ENTRY_COUNT 2
+
+/**
+ * @brief Number of keys hashed and prefetched together by the batch
+ * operations, i.e. the number of cache misses kept in flight at once.
+ */
+#define HASHTABLE_BATCH_SIZE 16
+
+/** @brief Version of the hashtable image layout (see hashtable_to_image). */
+#define HASHTABLE_IMAGE_VERSION 1
+
+/** @brief Type and instance definitions for hashtable image parameters. */
+typedef enum
+{
+    HASHTABLE_IMAGE_STRIDE
+,   HASHTABLE_IMAGE_CAPACITY
+,   HASHTABLE_IMAGE_LENGTH
+,   HASHTABLE_IMAGE_SEED
+,   HASHTABLE_IMAGE_HASH_CHECK
+}
+HASHTABLE_IMAGE_PARAMETER;
+
 /**
  * @brief Key hash generation.
- * 
- * @param name Key name string. Must be non-zero.
- * @param hashtable_capacity Hashtable capacity.
+ *
+ * @param state Internal state arguments.
+ * @param key Key. Must be non-zero.
+ * @param key_length The length of key in bytes.
  * @return Key hashcode.
  */
 u64
 hashtable_key_hash
-(   const char* name
-,   const u32   hashtable_capacity
+(   const state_t*  state
+,   const void*     key
+,   const u64       key_length
+);
+
+/**
+ * @brief Computes the number of slots needed to store a given number of
+ * elements without exceeding the maximum load factor (7/8).
+ *
+ * The number of slots is always a power of two, so that a hash can be reduced
+ * to a slot index with a mask instead of a modulo.
+ *
+ * @param capacity The number of elements.
+ * @return The number of slots.
+ */
+u64
+hashtable_slot_count
+(   const u64 capacity
 );
 
+/**
+ * @brief Computes the size of each hashtable entry (slot and value) in bytes.
+ *
+ * @param stride The value size in bytes.
+ * @return The entry size in bytes.
+ */
+u64
+hashtable_entry_size
+(   const u64 stride
+);
+
+/**
+ * @brief Computes the size of the hashtable content in bytes.
+ *
+ * @param slot_count The number of slots.
+ * @param entry_size The entry size in bytes.
+ * @return The content size in bytes.
+ */
+u64
+hashtable_content_size
+(   const u64 slot_count
+,   const u64 entry_size
+);
+
+/**
+ * @brief Retrieves an entry of the hashtable content.
+ *
+ * Indices at or above the slot count address the scratch entries.
+ *
+ * @param state Internal state arguments.
+ * @param index The entry index.
+ * @return The slot of the entry at index.
+ */
+slot_t*
+hashtable_entry
+(   const state_t*  state
+,   const u64       index
+);
+
+/**
+ * @brief Retrieves the value of an entry.
+ *
+ * @param slot The entry slot. Must be non-zero.
+ * @return The address of the entry value.
+ */
+void*
+hashtable_entry_value
+(   const slot_t* slot
+);
+
+/**
+ * @brief Retrieves the key of an entry.
+ *
+ * @param state Internal state arguments.
+ * @param slot The entry slot. Must be non-zero.
+ * @return The address of the entry key.
+ */
+const void*
+hashtable_entry_key
+(   const state_t*  state
+,   const slot_t*   slot
+);
+
+/**
+ * @brief Fails a mutation of a hashtable which uses an image in place.
+ *
+ * @param state Internal state arguments.
+ * @param caller The name of the calling function, for error messages.
+ * @return true if the hashtable may be mutated; false otherwise (which is
+ * logged).
+ */
 bool
-hashtable_create
+hashtable_mutable
+(   const state_t*  state
+,   const char*     caller
+);
+
+/**
+ * @brief Hashes a fixed string, so that an image records which hash function
+ * and seed placed its keys.
+ *
+ * @param hash_function The hash function.
+ * @param seed The seed.
+ * @return The hashcode of the fixed string.
+ */
+u64
+hashtable_hash_check
+(   hash_function_t hash_function
+,   const u64       seed
+);
+
+/**
+ * @brief Searches the hashtable for a key.
+ *
+ * @param state Internal state arguments.
+ * @param key The key. Must be non-zero.
+ * @param key_length The length of key in bytes.
+ * @param hash The key hashcode.
+ * @param index Output buffer for the index of the slot holding the key.
+ * @return true if the key was found; false otherwise.
+ */
+bool
+hashtable_find
+(   const state_t*  state
+,   const void*     key
+,   const u64       key_length
+,   const u64       hash
+,   u64*            index
+);
+
+/**
+ * @brief Implementation of _hashtable_set for a key whose hashcode has already
+ * been computed. Arguments are not validated.
+ *
+ * @param state Internal state arguments.
+ * @param key The key. Must be non-zero.
+ * @param key_length The length of key in bytes.
+ * @param hash The key hashcode.
+ * @param src The address of the stride bytes to copy in as the value.
+ * @return true on success; false otherwise.
+ */
+bool
+hashtable_set_hashed
+(   state_t*    state
+,   const void* key
+,   const u64   key_length
+,   const u64   hash
+,   const void* src
+);
+
+/**
+ * @brief Inserts the entry held in the first scratch entry into the hashtable
+ * using Robin Hood probing.
+ *
+ * The key of the entry must not already be present within the hashtable, and
+ * there must be at least one empty slot.
+ *
+ * @param state Internal state arguments.
+ */
+void
+hashtable_insert
+(   state_t* state
+);
+
+/**
+ * @brief Doubles the capacity of a hashtable which uses implicit memory
+ * allocation.
+ *
+ * @param state Internal state arguments.
+ * @return true on success; false otherwise.
+ */
+bool
+hashtable_grow
+(   state_t* state
+);
+
+/**
+ * @brief Frees any memory allocated for the keys of a hashtable.
+ *
+ * @param state Internal state arguments.
+ */
+void
+hashtable_free_keys
+(   state_t* state
+);
+
+bool
+_hashtable_create
 (   bool            pointer
 ,   u64             stride
 ,   u32             capacity
+,   hash_function_t hash_function
+,   u64             seed
 ,   u64*            memory_requirement_
 ,   void*           memory_
 ,   hashtable_t**   hashtable
@@ -60,7 +303,12 @@ hashtable_create
         return false;
     }
 
-    const u64 memory_requirement = sizeof ( state_t ) + capacity * stride;
+    const u64 slot_count = hashtable_slot_count ( capacity );
+    const u64 entry_size = hashtable_entry_size ( stride );
+    const u64 memory_requirement = sizeof ( state_t )
+                                 + hashtable_content_size ( slot_count
+                                                          , entry_size
+                                                          );
     if ( memory_requirement_ )
     {
         *memory_requirement_ = memory_requirement;
@@ -77,7 +325,7 @@ hashtable_create
     }
     else
     {
-        memory = memory_allocate ( memory_requirement , MEMORY_TAG_HASHTABLE );
+        memory = memory_allocate_uninit ( memory_requirement , MEMORY_TAG_HASHTABLE );
     }
 
     if ( !hashtable )
@@ -95,6 +343,12 @@ hashtable_create
     state_t* state = memory;
     ( *state ).capacity = capacity;
     ( *state ).stride = stride;
+    ( *state ).length = 0;
+    ( *state ).slot_count = slot_count;
+    ( *state ).entry_size = entry_size;
+    ( *state ).memory_requirement = memory_requirement;
+    ( *state ).hash_function = ( hash_function ) ? hash_function : hash64;
+    ( *state ).seed = seed;
     ( *state ).pointer = pointer;
     ( *state ).owns_memory = !memory_;
     ( *state ).content = ( void* )( ( ( u64 ) memory ) + sizeof ( state_t ) );
@@ -103,6 +357,101 @@ hashtable_create
     return true;
 }
 
+bool
+_hashtable_create_from_image
+(   const void*     image
+,   u64             size
+,   u64             stride
+,   hash_function_t hash_function
+,   bool            verify
+,   u64*            memory_requirement_
+,   void*           memory_
+,   hashtable_t**   hashtable
+)
+{
+    const u64 memory_requirement = sizeof ( state_t );
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    if ( !hashtable )
+    {
+        LOGERROR ( "hashtable_create_from_image: Missing argument: hashtable (output buffer)." );
+        return false;
+    }
+    if ( ( ( u64 ) image ) % 8 )
+    {
+        LOGERROR ( "hashtable_create_from_image: Image must be 8-byte aligned." );
+        return false;
+    }
+
+    const image_header_t* header = image_header_read ( "hashtable_create_from_image"
+                                                     , image
+                                                     , size
+                                                     , IMAGE_TYPE_HASHTABLE
+                                                     , HASHTABLE_IMAGE_VERSION
+                                                     , verify
+                                                     );
+    if ( !header )
+    {
+        return false;
+    }
+
+    const u64* parameters = ( *header ).parameters;
+    if ( parameters[ HASHTABLE_IMAGE_STRIDE ] != stride )
+    {
+        LOGERROR ( "hashtable_create_from_image: Expected elements of %u bytes, but the image holds elements of %u bytes."
+                 , stride , parameters[ HASHTABLE_IMAGE_STRIDE ]
+                 );
+        return false;
+    }
+    const u64 capacity = parameters[ HASHTABLE_IMAGE_CAPACITY ];
+    if ( !stride
+         || !capacity
+         || capacity > 0xFFFFFFFF
+         || parameters[ HASHTABLE_IMAGE_LENGTH ] > capacity
+         || IMAGE_HEADER_SIZE + hashtable_slot_count ( capacity ) * hashtable_entry_size ( stride ) > ( *header ).size
+       )
+    {
+        LOGERROR ( "hashtable_create_from_image: Image is malformed." );
+        return false;
+    }
+    if ( !hash_function )
+    {
+        hash_function = hash64;
+    }
+    if ( hashtable_hash_check ( hash_function , parameters[ HASHTABLE_IMAGE_SEED ] ) != parameters[ HASHTABLE_IMAGE_HASH_CHECK ] )
+    {
+        LOGERROR ( "hashtable_create_from_image: Image was written by a hashtable with a different hash function." );
+        return false;
+    }
+
+    state_t* state = ( memory_ ) ? memory_
+                                 : memory_allocate ( memory_requirement , MEMORY_TAG_HASHTABLE )
+                                 ;
+    memory_clear ( state , memory_requirement );
+    ( *state ).capacity = capacity;
+    ( *state ).stride = stride;
+    ( *state ).length = parameters[ HASHTABLE_IMAGE_LENGTH ];
+    ( *state ).slot_count = hashtable_slot_count ( capacity );
+    ( *state ).entry_size = hashtable_entry_size ( stride );
+    ( *state ).memory_requirement = memory_requirement;
+    ( *state ).hash_function = hash_function;
+    ( *state ).seed = parameters[ HASHTABLE_IMAGE_SEED ];
+    ( *state ).pointer = false;
+    ( *state ).owns_memory = !memory_;
+    ( *state ).content = ( void* )( ( ( u64 ) image ) + IMAGE_HEADER_SIZE );
+    ( *state ).image = image;
+
+    *hashtable = state;
+    return true;
+}
+
 void
 hashtable_destroy
 (   hashtable_t** hashtable
@@ -119,9 +468,26 @@ hashtable_destroy
         return;
     }
 
-    const u64 memory_requirement = sizeof ( state_t ) + ( *state ).capacity
-                                                      * ( *state ).stride
-                                                      ;
+    // The keys and content of an image belong to the image.
+    if ( !( *state ).image )
+    {
+        hashtable_free_keys ( state );
+    }
+
+    // Free the content if it was reallocated by hashtable_grow.
+    if ( !( *state ).image
+         && ( *state ).content != ( void* )( ( ( u64 ) state ) + sizeof ( state_t ) )
+       )
+    {
+        memory_free ( ( *state ).content
+                    , hashtable_content_size ( ( *state ).slot_count
+                                             , ( *state ).entry_size
+                                             )
+                    , MEMORY_TAG_HASHTABLE
+                    );
+    }
+
+    const u64 memory_requirement = ( *state ).memory_requirement;
     if ( ( *state ).owns_memory )
     {
         memory_free ( state , memory_requirement , MEMORY_TAG_HASHTABLE );
@@ -150,6 +516,22 @@ hashtable_capacity
     return ( *( ( state_t* ) hashtable ) ).capacity;
 }
 
+u64
+hashtable_length
+(   const hashtable_t* hashtable
+)
+{
+    return ( *( ( state_t* ) hashtable ) ).length;
+}
+
+u64
+hashtable_seed
+(   const hashtable_t* hashtable
+)
+{
+    return ( *( ( state_t* ) hashtable ) ).seed;
+}
+
 bool
 hashtable_pointer
 (   const hashtable_t* hashtable
@@ -158,6 +540,14 @@ hashtable_pointer
     return ( *( ( state_t* ) hashtable ) ).pointer;
 }
 
+bool
+hashtable_read_only
+(   const hashtable_t* hashtable
+)
+{
+    return ( *( ( state_t* ) hashtable ) ).image != 0;
+}
+
 bool
 hashtable_owns_memory
 (   const hashtable_t* hashtable
@@ -167,59 +557,338 @@ hashtable_owns_memory
 }
 
 bool
-hashtable_set
+_hashtable_set
 (   hashtable_t*    hashtable
-,   const char*     key
+,   const void*     key
+,   const u64       key_length
 ,   const void*     value
 )
 {
     state_t* state = hashtable;
-    if ( !value && !( *state ).pointer )
+    if ( !hashtable_mutable ( state , "hashtable_set" ) )
     {
-        LOGERROR ( "hashtable_set: Missing argument: value." );
+        return false;
+    }
+    if ( !key || ( !value && !( *state ).pointer ) )
+    {
+        if ( !key )
+        {
+            LOGERROR ( "hashtable_set: Missing argument: key." );
+        }
+        if ( !value && !( *state ).pointer )
+        {
+            LOGERROR ( "hashtable_set: Missing argument: value." );
+        }
         return false;
     }
 
-    const u64 index = hashtable_key_hash ( key , ( *state ).capacity );
-    if ( ( *state ).pointer )
+    const void* src = ( ( *state ).pointer ) ? ( const void* ) &value : value;
+    return hashtable_set_hashed ( state
+                                , key
+                                , key_length
+                                , hashtable_key_hash ( state , key , key_length )
+                                , src
+                                );
+}
+
+bool
+hashtable_set_batch
+(   hashtable_t*    hashtable
+,   const void*     keys
+,   const u64       key_length
+,   const u64       count
+,   const void*     values
+)
+{
+    state_t* state = hashtable;
+    if ( !hashtable_mutable ( state , "hashtable_set_batch" ) )
+    {
+        return false;
+    }
+    if ( !count )
+    {
+        return true;
+    }
+    if ( !keys || !values )
+    {
+        if ( !keys )
+        {
+            LOGERROR ( "hashtable_set_batch: Missing argument: keys." );
+        }
+        if ( !values )
+        {
+            LOGERROR ( "hashtable_set_batch: Missing argument: values." );
+        }
+        return false;
+    }
+
+    u64 hashes[ HASHTABLE_BATCH_SIZE ];
+    for ( u64 i = 0; i < count; i += HASHTABLE_BATCH_SIZE )
     {
-        memory_copy ( ( void* )( ( ( u64 )( ( *state ).content ) )
-                               + index * ( *state ).stride
-                               )
-                    , &value
+        const u64 batch = MIN ( count - i , ( u64 ) HASHTABLE_BATCH_SIZE );
+        const u64 mask = ( *state ).slot_count - 1;
+        for ( u64 j = 0; j < batch; ++j )
+        {
+            const void* key = ( const void* )( ( ( u64 ) keys ) + ( i + j ) * key_length );
+            hashes[ j ] = hashtable_key_hash ( state , key , key_length );
+            PREFETCH_WRITE ( hashtable_entry ( state , hashes[ j ] & mask ) );
+        }
+        for ( u64 j = 0; j < batch; ++j )
+        {
+            if ( !hashtable_set_hashed ( state
+                                       , ( const void* )( ( ( u64 ) keys ) + ( i + j ) * key_length )
+                                       , key_length
+                                       , hashes[ j ]
+                                       , ( const void* )( ( ( u64 ) values ) + ( i + j ) * ( *state ).stride )
+                                       ))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool
+hashtable_set_hashed
+(   state_t*    state
+,   const void* key
+,   const u64   key_length
+,   const u64   hash
+,   const void* src
+)
+{
+    u64 index;
+
+    // Key already present? Overwrite its value.
+    if ( hashtable_find ( state , key , key_length , hash , &index ) )
+    {
+        memory_copy ( hashtable_entry_value ( hashtable_entry ( state , index ) )
+                    , src
                     , ( *state ).stride
                     );
+        return true;
+    }
+
+    if ( ( *state ).length >= ( *state ).capacity )
+    {
+        if ( !( *state ).owns_memory )
+        {
+            LOGERROR ( "hashtable_set: Hashtable is full and cannot grow, because it was pre-allocated (capacity: %u)."
+                     , ( *state ).capacity
+                     );
+            return false;
+        }
+        if ( !hashtable_grow ( state ) )
+        {
+            LOGERROR ( "hashtable_set: Failed to grow hashtable." );
+            return false;
+        }
+    }
+
+    // Stage the new entry in scratch space, then insert it.
+    slot_t* entry = hashtable_entry ( state , ( *state ).slot_count );
+    ( *entry ).hash = hash;
+    ( *entry ).key_length = key_length;
+    ( *entry ).distance = 1;
+    if ( key_length > HASHTABLE_KEY_INLINE_CAPACITY )
+    {
+        ( *entry ).key.key = memory_allocate ( key_length , MEMORY_TAG_HASHTABLE );
+        memory_copy ( ( *entry ).key.key , key , key_length );
     }
     else
     {
-        memory_copy ( ( void* )( ( ( u64 )( ( *state ).content ) )
-                               + index * ( *state ).stride
-                               )
-                    , value
+        memory_copy ( ( *entry ).key.inline_key , key , key_length );
+    }
+    memory_copy ( hashtable_entry_value ( entry ) , src , ( *state ).stride );
+    hashtable_insert ( state );
+    ( *state ).length += 1;
+    return true;
+}
+
+bool
+_hashtable_get
+(   const hashtable_t*  hashtable
+,   const void*         key
+,   const u64           key_length
+,   void*               value
+)
+{
+    const state_t* state = hashtable;
+    u64 index;
+    if ( !hashtable_find ( state
+                         , key
+                         , key_length
+                         , hashtable_key_hash ( state , key , key_length )
+                         , &index
+                         ))
+    {
+        return false;
+    }
+    if ( value )
+    {
+        memory_copy ( value
+                    , hashtable_entry_value ( hashtable_entry ( state , index ) )
                     , ( *state ).stride
                     );
     }
     return true;
 }
 
+u64
+hashtable_get_batch
+(   const hashtable_t*  hashtable
+,   const void*         keys
+,   const u64           key_length
+,   const u64           count
+,   void*               values
+,   bool*               found
+)
+{
+    const state_t* state = hashtable;
+    const u64 mask = ( *state ).slot_count - 1;
+    u64 hashes[ HASHTABLE_BATCH_SIZE ];
+    u64 found_count = 0;
+    for ( u64 i = 0; i < count; i += HASHTABLE_BATCH_SIZE )
+    {
+        const u64 batch = MIN ( count - i , ( u64 ) HASHTABLE_BATCH_SIZE );
+
+        // Hash every key of the batch first, and prefetch each home slot, so
+        // that the cache misses of the batch overlap with each other instead
+        // of being taken one at a time.
+        for ( u64 j = 0; j < batch; ++j )
+        {
+            const void* key = ( const void* )( ( ( u64 ) keys ) + ( i + j ) * key_length );
+            hashes[ j ] = hashtable_key_hash ( state , key , key_length );
+            PREFETCH ( hashtable_entry ( state , hashes[ j ] & mask ) );
+        }
+
+        for ( u64 j = 0; j < batch; ++j )
+        {
+            u64 index;
+            const bool present = hashtable_find ( state
+                                                , ( const void* )( ( ( u64 ) keys ) + ( i + j ) * key_length )
+                                                , key_length
+                                                , hashes[ j ]
+                                                , &index
+                                                );
+            if ( found )
+            {
+                found[ i + j ] = present;
+            }
+            if ( !present )
+            {
+                continue;
+            }
+            found_count += 1;
+            if ( values )
+            {
+                memory_copy ( ( void* )( ( ( u64 ) values ) + ( i + j ) * ( *state ).stride )
+                            , hashtable_entry_value ( hashtable_entry ( state , index ) )
+                            , ( *state ).stride
+                            );
+            }
+        }
+    }
+    return found_count;
+}
+
 bool
-hashtable_get
+_hashtable_remove
 (   hashtable_t*    hashtable
-,   const char*     key
+,   const void*     key
+,   const u64       key_length
 ,   void*           value
 )
 {
     state_t* state = hashtable;
-    const u64 index = hashtable_key_hash ( key , ( *state ).capacity );
-    memory_copy ( value
-                , ( void* )( ( ( u64 )( ( *state ).content ) )
-                           + index * ( *state ).stride
-                           )
-                , ( *state ).stride
-                );
+    if ( !hashtable_mutable ( state , "hashtable_remove" ) )
+    {
+        return false;
+    }
+    u64 index;
+    if ( !hashtable_find ( state
+                         , key
+                         , key_length
+                         , hashtable_key_hash ( state , key , key_length )
+                         , &index
+                         ))
+    {
+        return false;
+    }
+
+    slot_t* slot = hashtable_entry ( state , index );
+    if ( value )
+    {
+        memory_copy ( value , hashtable_entry_value ( slot ) , ( *state ).stride );
+    }
+    if ( ( *slot ).key_length > HASHTABLE_KEY_INLINE_CAPACITY )
+    {
+        memory_free ( ( *slot ).key.key
+                    , ( *slot ).key_length
+                    , MEMORY_TAG_HASHTABLE
+                    );
+    }
+
+    // Backward-shift deletion: pull each subsequent displaced entry one slot
+    // closer to its home slot, so no tombstone is left behind.
+    for (;;)
+    {
+        const u64 next_index = ( index + 1 ) & ( ( *state ).slot_count - 1 );
+        slot_t* next = hashtable_entry ( state , next_index );
+        if ( ( *next ).distance <= 1 )
+        {
+            memory_clear ( slot , ( *state ).entry_size );
+            break;
+        }
+        memory_copy ( slot , next , ( *state ).entry_size );
+        ( *slot ).distance -= 1;
+        slot = next;
+        index = next_index;
+    }
+
+    ( *state ).length -= 1;
     return true;
 }
 
+bool
+hashtable_iterate
+(   const hashtable_t*  hashtable
+,   u64*                iterator
+,   const void**        key
+,   u64*                key_length
+,   void*               value
+)
+{
+    const state_t* state = hashtable;
+    while ( *iterator < ( *state ).slot_count )
+    {
+        const slot_t* slot = hashtable_entry ( state , *iterator );
+        *iterator += 1;
+        if ( !( *slot ).distance )
+        {
+            continue;
+        }
+        if ( key )
+        {
+            *key = hashtable_entry_key ( state , slot );
+        }
+        if ( key_length )
+        {
+            *key_length = ( *slot ).key_length;
+        }
+        if ( value )
+        {
+            memory_copy ( value
+                        , hashtable_entry_value ( slot )
+                        , ( *state ).stride
+                        );
+        }
+        return true;
+    }
+    return false;
+}
+
 bool
 hashtable_fill
 (   hashtable_t*    hashtable
@@ -233,31 +902,361 @@ hashtable_fill
         LOGERROR ( "hashtable_fill: May not be used on a pointer-valued hashtable." );
         return false;
     }
+    if ( !hashtable_mutable ( state , "hashtable_fill" ) )
+    {
+        return false;
+    }
+
+    for ( u64 i = 0; i < ( *state ).slot_count; ++i )
+    {
+        slot_t* slot = hashtable_entry ( state , i );
+        if ( ( *slot ).distance )
+        {
+            memory_copy ( hashtable_entry_value ( slot )
+                        , value
+                        , ( *state ).stride
+                        );
+        }
+    }
+    return true;
+}
+
+bool
+hashtable_to_image
+(   const hashtable_t*  hashtable
+,   u64*                image_size
+,   void*               image
+)
+{
+    const state_t* state = hashtable;
+    if ( !image_size )
+    {
+        LOGERROR ( "hashtable_to_image: Missing argument: image_size (output buffer)." );
+        return false;
+    }
+    if ( ( *state ).pointer )
+    {
+        LOGERROR ( "hashtable_to_image: May not be used on a pointer-valued hashtable." );
+        return false;
+    }
 
-    for ( u64 i = 0; i < ( *state ).capacity; ++i )
+    // Long keys follow the slots.
+    const u64 content_size = ( *state ).slot_count * ( *state ).entry_size;
+    u64 size = IMAGE_HEADER_SIZE + content_size;
+    for ( u64 i = 0; i < ( *state ).slot_count; ++i )
+    {
+        const slot_t* slot = hashtable_entry ( state , i );
+        if ( ( *slot ).distance && ( *slot ).key_length > HASHTABLE_KEY_INLINE_CAPACITY )
+        {
+            size += ( *slot ).key_length;
+        }
+    }
+    *image_size = size;
+    if ( !image )
+    {
+        return true;
+    }
+    if ( ( ( u64 ) image ) % 8 )
     {
-        memory_copy ( ( void* )( ( ( u64 )( ( *state ).content ) )
-                               + i * ( *state ).stride
-                               )
-                    , value
+        LOGERROR ( "hashtable_to_image: Image must be 8-byte aligned." );
+        return false;
+    }
+
+    u8* content = ( ( u8* ) image ) + IMAGE_HEADER_SIZE;
+    u64 offset = IMAGE_HEADER_SIZE + content_size;
+    for ( u64 i = 0; i < ( *state ).slot_count; ++i )
+    {
+        const slot_t* slot = hashtable_entry ( state , i );
+        slot_t* dst = ( void* )( content + i * ( *state ).entry_size );
+        if ( !( *slot ).distance )
+        {
+            memory_clear ( dst , ( *state ).entry_size );
+            continue;
+        }
+
+        // Copy the entry, zeroing any bytes it does not use, so that equal
+        // hashtables write equal images.
+        memory_clear ( dst , ( *state ).entry_size );
+        ( *dst ).hash = ( *slot ).hash;
+        ( *dst ).key_length = ( *slot ).key_length;
+        ( *dst ).distance = ( *slot ).distance;
+        memory_copy ( hashtable_entry_value ( dst )
+                    , hashtable_entry_value ( slot )
                     , ( *state ).stride
                     );
+        if ( ( *slot ).key_length > HASHTABLE_KEY_INLINE_CAPACITY )
+        {
+            memory_copy ( ( ( u8* ) image ) + offset
+                        , hashtable_entry_key ( state , slot )
+                        , ( *slot ).key_length
+                        );
+            ( *dst ).key.key = ( void* ) offset;
+            offset += ( *slot ).key_length;
+        }
+        else
+        {
+            memory_copy ( ( *dst ).key.inline_key
+                        , ( *slot ).key.inline_key
+                        , ( *slot ).key_length
+                        );
+        }
     }
+
+    u64 parameters[ IMAGE_PARAMETER_COUNT ] = { 0 };
+    parameters[ HASHTABLE_IMAGE_STRIDE ]     = ( *state ).stride;
+    parameters[ HASHTABLE_IMAGE_CAPACITY ]   = ( *state ).capacity;
+    parameters[ HASHTABLE_IMAGE_LENGTH ]     = ( *state ).length;
+    parameters[ HASHTABLE_IMAGE_SEED ]       = ( *state ).seed;
+    parameters[ HASHTABLE_IMAGE_HASH_CHECK ] = hashtable_hash_check ( ( *state ).hash_function
+                                                                    , ( *state ).seed
+                                                                    );
+    image_header_write ( IMAGE_TYPE_HASHTABLE
+                       , HASHTABLE_IMAGE_VERSION
+                       , parameters
+                       , size
+                       , image
+                       );
     return true;
 }
 
 u64
 hashtable_key_hash
-(   const char* name
-,   const u32   hashtable_capacity
+(   const state_t*  state
+,   const void*     key
+,   const u64       key_length
 )
 {
-    static const u64 prime = 97;
-    u64 hash = 0;
-    for ( const u8* i = ( const u8* ) name; *i; ++i )
+    return ( *state ).hash_function ( key , key_length , ( *state ).seed );
+}
+
+u64
+hashtable_slot_count
+(   const u64 capacity
+)
+{
+    const u64 minimum = capacity + capacity / 7 + 1;
+    const u8 bit = bitscan_reverse ( minimum );
+    return ( minimum == ( ( u64 ) 1 ) << bit ) ? minimum
+                                                : ( ( u64 ) 1 ) << ( bit + 1 )
+                                                ;
+}
+
+u64
+hashtable_entry_size
+(   const u64 stride
+)
+{
+    // Round up so that every slot is 8-byte aligned.
+    return sizeof ( slot_t ) + ( ( stride + 7 ) & ~( ( u64 ) 7 ) );
+}
+
+u64
+hashtable_content_size
+(   const u64 slot_count
+,   const u64 entry_size
+)
+{
+    return ( slot_count + HASHTABLE_SCRATCH_ENTRY_COUNT ) * entry_size;
+}
+
+slot_t*
+hashtable_entry
+(   const state_t*  state
+,   const u64       index
+)
+{
+    return ( void* )( ( ( u64 )( ( *state ).content ) )
+                    + index * ( *state ).entry_size
+                    );
+}
+
+void*
+hashtable_entry_value
+(   const slot_t* slot
+)
+{
+    return ( void* )( ( ( u64 ) slot ) + sizeof ( slot_t ) );
+}
+
+const void*
+hashtable_entry_key
+(   const state_t*  state
+,   const slot_t*   slot
+)
+{
+    if ( ( *slot ).key_length <= HASHTABLE_KEY_INLINE_CAPACITY )
     {
-        hash = hash * prime + *i;
+        return ( *slot ).key.inline_key;
+    }
+    return ( ( *state ).image ) ? ( *state ).image + ( u64 )( ( *slot ).key.key )
+                                : ( *slot ).key.key
+                                ;
+}
+
+bool
+hashtable_mutable
+(   const state_t*  state
+,   const char*     caller
+)
+{
+    if ( ( *state ).image )
+    {
+        LOGERROR ( "%s: Hashtable is read-only, because it was created from an image."
+                 , caller
+                 );
+        return false;
+    }
+    return true;
+}
+
+u64
+hashtable_hash_check
+(   hash_function_t hash_function
+,   const u64       seed
+)
+{
+    static const char check[] = "hashtable_image";
+    return hash_function ( check , sizeof ( check ) - 1 , seed );
+}
+
+bool
+hashtable_find
+(   const state_t*  state
+,   const void*     key
+,   const u64       key_length
+,   const u64       hash
+,   u64*            index
+)
+{
+    u64 i = hash & ( ( *state ).slot_count - 1 );
+    for ( u64 distance = 1; ; ++distance )
+    {
+        const slot_t* slot = hashtable_entry ( state , i );
+
+        // An empty slot, or an entry closer to its home slot than the key
+        // would be, ends the probe sequence (Robin Hood invariant).
+        if ( ( *slot ).distance < distance )
+        {
+            return false;
+        }
+        if ( ( *slot ).hash == hash
+             && ( *slot ).key_length == key_length
+             && memory_equal ( hashtable_entry_key ( state , slot ) , key , key_length )
+           )
+        {
+            *index = i;
+            return true;
+        }
+        i = ( i + 1 ) & ( ( *state ).slot_count - 1 );
+    }
+}
+
+void
+hashtable_insert
+(   state_t* state
+)
+{
+    slot_t* entry = hashtable_entry ( state , ( *state ).slot_count );
+    slot_t* swap = hashtable_entry ( state , ( *state ).slot_count + 1 );
+    u64 i = ( *entry ).hash & ( ( *state ).slot_count - 1 );
+    for (;;)
+    {
+        slot_t* slot = hashtable_entry ( state , i );
+        if ( !( *slot ).distance )
+        {
+            memory_copy ( slot , entry , ( *state ).entry_size );
+            return;
+        }
+
+        // Displace any entry which is closer to its home slot than the entry
+        // being inserted, and continue inserting the displaced entry instead.
+        if ( ( *slot ).distance < ( *entry ).distance )
+        {
+            memory_copy ( swap , slot , ( *state ).entry_size );
+            memory_copy ( slot , entry , ( *state ).entry_size );
+            memory_copy ( entry , swap , ( *state ).entry_size );
+        }
+        ( *entry ).distance += 1;
+        i = ( i + 1 ) & ( ( *state ).slot_count - 1 );
+    }
+}
+
+bool
+hashtable_grow
+(   state_t* state
+)
+{
+    const u64 capacity = 2 * ( ( u64 )( *state ).capacity );
+    if ( capacity > 0xFFFFFFFF )
+    {
+        LOGERROR ( "hashtable_grow: Hashtable capacity cannot exceed %u elements."
+                 , 0xFFFFFFFF
+                 );
+        return false;
+    }
+
+    const u64 old_slot_count = ( *state ).slot_count;
+    void* old_content = ( *state ).content;
+    const u64 slot_count = hashtable_slot_count ( capacity );
+    const u64 content_size = hashtable_content_size ( slot_count
+                                                    , ( *state ).entry_size
+                                                    );
+
+    void* content = memory_allocate ( content_size , MEMORY_TAG_HASHTABLE );
+    if ( !content )
+    {
+        return false;
+    }
+
+    ( *state ).capacity = capacity;
+    ( *state ).slot_count = slot_count;
+    ( *state ).content = content;
+
+    // Rehash every entry into the new content. Keys are moved, not copied.
+    for ( u64 i = 0; i < old_slot_count; ++i )
+    {
+        const slot_t* slot = ( void* )( ( ( u64 ) old_content )
+                                      + i * ( *state ).entry_size
+                                      );
+        if ( !( *slot ).distance )
+        {
+            continue;
+        }
+        slot_t* entry = hashtable_entry ( state , slot_count );
+        memory_copy ( entry , slot , ( *state ).entry_size );
+        ( *entry ).distance = 1;
+        hashtable_insert ( state );
+    }
+
+    // Free the old content if it was not part of the state memory block.
+    if ( old_content != ( void* )( ( ( u64 ) state ) + sizeof ( state_t ) ) )
+    {
+        memory_free ( old_content
+                    , hashtable_content_size ( old_slot_count
+                                             , ( *state ).entry_size
+                                             )
+                    , MEMORY_TAG_HASHTABLE
+                    );
+    }
+    return true;
+}
+
+void
+hashtable_free_keys
+(   state_t* state
+)
+{
+    for ( u64 i = 0; i < ( *state ).slot_count; ++i )
+    {
+        slot_t* slot = hashtable_entry ( state , i );
+        if ( ( *slot ).distance
+             && ( *slot ).key_length > HASHTABLE_KEY_INLINE_CAPACITY
+           )
+        {
+            memory_free ( ( *slot ).key.key
+                        , ( *slot ).key_length
+                        , MEMORY_TAG_HASHTABLE
+                        );
+        }
     }
-    hash %= hashtable_capacity;
-    return hash;
 }
@@ -8,9 +8,18 @@
 
 #include "common.h"
 
+#include "core/hash.h"
+#include "core/string.h"
+
+#include "math/random64.h"
+
 /** @brief Type declaration for a hashtable. */
 typedef void hashtable_t;
 
+/** @brief Maximum key length (in bytes) which can be stored without performing
+ * an additional memory allocation. */
+#define HASHTABLE_KEY_INLINE_CAPACITY 16
+
 /**
  * @brief Initializes a hashtable.
  * 
@@ -29,12 +38,31 @@ typedef void hashtable_t;
  * needs to be handled externally. A data-valued hashtable consists of key-value
  * pairs whose values are to be interpreted as raw data.
  * 
+ * Keys are arbitrary binary strings of explicit length, and are copied into the
+ * hashtable. Keys of up to HASHTABLE_KEY_INLINE_CAPACITY bytes are stored
+ * directly within the hashtable; longer keys are copied using dynamic memory
+ * allocation (see core/memory.h), regardless of whether the hashtable itself
+ * was pre-allocated.
+ * 
+ * Collisions are resolved by open addressing with Robin Hood probing: an entry
+ * which has probed further from its home slot displaces one which has not, so
+ * probe sequences remain short even at high load.
+ * 
+ * Use _hashtable_create to explicitly specify the hash function and seed, or
+ * hashtable_create to use hash64 with a random seed (see core/hash.h). Since
+ * the seed is random, iteration order may differ between hashtables holding
+ * the same keys.
+ * 
  * @param pointer Pass true if the output should be a pointer-valued hashtable;
  * pass false if it should be data-valued.
  * @param stride The size of each element in bytes (only applicable for data-
  * valued hashtables).
- * @param capacity The maximum number of elements the hashtable may hold. Cannot
- * be resized.
+ * @param capacity The number of elements the hashtable may hold before it needs
+ * to grow. If the hashtable uses implicit memory allocation, it doubles its
+ * capacity whenever it is full; a pre-allocated hashtable cannot grow, and
+ * insertions fail once it is full.
+ * @param hash_function The function used to hash keys. Pass 0 to use hash64.
+ * @param seed The seed passed to hash_function.
  * @param memory_requirement Output buffer to hold the actual number of bytes
  * required to operate the dynamic allocator. Only applicable if pre-allocating
  * a memory buffer of the required size. Pass 0 to use implicit memory
@@ -46,15 +74,91 @@ typedef void hashtable_t;
  * @return true on success; false otherwise.
  */
 bool
-hashtable_create
+_hashtable_create
 (   bool            pointer
 ,   u64             stride
 ,   u32             capacity
+,   hash_function_t hash_function
+,   u64             seed
 ,   u64*            memory_requirement
 ,   void*           memory
 ,   hashtable_t**   hashtable
 );
 
+#define hashtable_create(pointer,stride,capacity,memory_requirement,memory,hashtable) \
+    _hashtable_create ( (pointer)                                                      \
+                      , (stride)                                                       \
+                      , (capacity)                                                     \
+                      , hash64                                                         \
+                      , ( u64 ) random64 ()                                            \
+                      , (memory_requirement)                                           \
+                      , (memory)                                                       \
+                      , (hashtable)                                                    \
+                      )
+
+/**
+ * @brief Variant of _hashtable_create which uses a hashtable image in place
+ * (see hashtable_to_image and core/image.h), e.g. one within a memory-mapped
+ * file, instead of rebuilding the hashtable key by key. O(1), or O(n) if
+ * verifying the image.
+ * 
+ * Only the hashtable's internal state is allocated; its keys and values are
+ * read directly from the image, which must remain valid (e.g. mapped) until
+ * the hashtable is destroyed. The hashtable is read-only: hashtable_set,
+ * hashtable_remove and hashtable_fill fail.
+ * 
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size.
+ * 
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h). Call hashtable_destroy
+ *   to free.
+ * 
+ * Use _hashtable_create_from_image to explicitly specify the hash function,
+ * or hashtable_create_from_image to use hash64. It must be the hash function
+ * the image was written with.
+ * 
+ * @param image The image. Must be 8-byte aligned.
+ * @param size The number of bytes available at image (e.g. the size of the
+ * mapped file).
+ * @param stride The size of each element in bytes. Must match the image.
+ * @param hash_function The function used to hash keys. Pass 0 to use hash64.
+ * @param verify Verify the checksum of the whole image? Y/N (if not, only the
+ * header is checked, and no page of the image beyond the first is read until
+ * the hashtable is accessed)
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required. Only applicable if pre-allocating a memory buffer of the required
+ * size. Pass 0 to use implicit memory allocation.
+ * @param memory Optional pre-allocated memory buffer. Pass 0 to read memory
+ * requirement; otherwise, pass a pre-allocated buffer of the required size.
+ * @param hashtable Output buffer for hashtable.
+ * @return true on success; false otherwise (e.g. if the image is damaged or
+ * was written by a different hash function).
+ */
+bool
+_hashtable_create_from_image
+(   const void*     image
+,   u64             size
+,   u64             stride
+,   hash_function_t hash_function
+,   bool            verify
+,   u64*            memory_requirement
+,   void*           memory
+,   hashtable_t**   hashtable
+);
+
+#define hashtable_create_from_image(image,size,stride,verify,memory_requirement,memory,hashtable) \
+    _hashtable_create_from_image ( (image)                                                          \
+                                 , (size)                                                           \
+                                 , (stride)                                                         \
+                                 , hash64                                                           \
+                                 , (verify)                                                         \
+                                 , (memory_requirement)                                             \
+                                 , (memory)                                                         \
+                                 , (hashtable)                                                      \
+                                 )
+
 /**
  * @brief Frees the memory used by a hashtable.
  * 
@@ -80,16 +184,38 @@ hashtable_stride
 );
 
 /**
- * @brief Queries the maximum capacity of a hashtable.
+ * @brief Queries the capacity of a hashtable.
  * 
  * @param hashtable The hashtable to query. Must be non-zero.
- * @return Tthe maximum capacity of hashtable.
+ * @return The number of elements hashtable may hold before it needs to grow.
  */
 u64
 hashtable_capacity
 (   const hashtable_t* hashtable
 );
 
+/**
+ * @brief Queries the number of keys stored in a hashtable.
+ * 
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @return The number of keys stored in hashtable.
+ */
+u64
+hashtable_length
+(   const hashtable_t* hashtable
+);
+
+/**
+ * @brief Queries the seed a hashtable passes to its hash function.
+ * 
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @return The seed of hashtable.
+ */
+u64
+hashtable_seed
+(   const hashtable_t* hashtable
+);
+
 /**
  * @brief Queries whether a hashtable is pointer-valued or data-valued.
  * 
@@ -101,6 +227,18 @@ hashtable_pointer
 (   const hashtable_t* hashtable
 );
 
+/**
+ * @brief Queries whether a hashtable uses an image in place (see
+ * _hashtable_create_from_image), and so is read-only.
+ * 
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @return true if hashtable was created from an image; false otherwise.
+ */
+bool
+hashtable_read_only
+(   const hashtable_t* hashtable
+);
+
 /**
  * @brief Queries whether a hashtable was created with implicit memory
  * allocation.
@@ -115,39 +253,237 @@ hashtable_owns_memory
 );
 
 /**
- * @brief Sets a hashtable value. O(1).
+ * @brief Sets a hashtable value. Amortized O(1).
+ * 
+ * Inserts the key if it is not already present within the hashtable.
+ * 
+ * Use _hashtable_set to explicitly specify key length, hashtable_set to
+ * compute the length of a null-terminated key, or hashtable_set_view to pass
+ * the key as a string view (see core/string.h).
  * 
  * @param hashtable The hashtable to mutate. Must be non-zero.
- * @param key The key whose value will be set. Must be a null-terminated string.
+ * @param key The key whose value will be set. Must be non-zero.
+ * @param key_length The length of key in bytes.
  * @param value Handle to the data to set as the key's value. If hashtable is
  * data-valued, this must be set to the address of the data to copy in; if
  * hashtable is pointer-valued, 0 may be passed to set the value of the key to
- * a null pointer (effectively removing the pointer value from the hashtable).
+ * a null pointer.
  * @return true on success; false otherwise.
  */
 bool
-hashtable_set
+_hashtable_set
 (   hashtable_t*    hashtable
-,   const char*     key
+,   const void*     key
+,   const u64       key_length
 ,   const void*     value
 );
 
+#define hashtable_set(hashtable,key,value)                                \
+    ({                                                                    \
+        const char* key__ = (key);                                        \
+        _hashtable_set ( (hashtable) , key__ , _string_length ( key__ )   \
+                       , (value)                                          \
+                       );                                                 \
+    })
+
+#define hashtable_set_view(hashtable,key,value)                           \
+    ({                                                                    \
+        const string_view_t key__ = (key);                                \
+        _hashtable_set ( (hashtable) , key__.string , key__.length        \
+                       , (value)                                          \
+                       );                                                 \
+    })
+
+/**
+ * @brief Sets the values of a batch of keys of equal length. Amortized O(1)
+ * per key.
+ * 
+ * Equivalent to calling _hashtable_set for each key in order, but faster for
+ * large hashtables: the keys are hashed, and their slots prefetched, several
+ * at a time before any of them is inserted, so that the cache misses overlap.
+ * 
+ * @param hashtable The hashtable to mutate. Must be non-zero.
+ * @param keys The keys, contiguous in memory. Must be non-zero if count is
+ * non-zero.
+ * @param key_length The length of each key in bytes.
+ * @param count The number of keys.
+ * @param values The values, contiguous in memory, in the same order as keys
+ * (stride bytes each; for a pointer-valued hashtable, an array of pointers).
+ * Must be non-zero if count is non-zero.
+ * @return true on success; false otherwise (the keys preceding the one which
+ * failed remain set).
+ */
+bool
+hashtable_set_batch
+(   hashtable_t*    hashtable
+,   const void*     keys
+,   const u64       key_length
+,   const u64       count
+,   const void*     values
+);
+
 /**
  * @brief Queries a hashtable value. O(1).
  * 
+ * Use _hashtable_get to explicitly specify key length, hashtable_get to
+ * compute the length of a null-terminated key, or hashtable_get_view to pass
+ * the key as a string view (see core/string.h).
+ * 
  * @param hashtable The hashtable to query. Must be non-zero.
- * @param key The key whose value will be read. Must be a null-terminated
- * string.
- * @param value Output buffer for the value. Must be non-zero.
- * @return true on success; false otherwise.
+ * @param key The key whose value will be read. Must be non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value Output buffer for the value. Only written to if the key is
+ * present within the hashtable. Pass 0 to retrieve nothing.
+ * @return true if the key is present within the hashtable; false otherwise.
  */
 bool
-hashtable_get
+_hashtable_get
+(   const hashtable_t*  hashtable
+,   const void*         key
+,   const u64           key_length
+,   void*               value
+);
+
+#define hashtable_get(hashtable,key,value)                                \
+    ({                                                                    \
+        const char* key__ = (key);                                        \
+        _hashtable_get ( (hashtable) , key__ , _string_length ( key__ )   \
+                       , (value)                                          \
+                       );                                                 \
+    })
+
+#define hashtable_get_view(hashtable,key,value)                           \
+    ({                                                                    \
+        const string_view_t key__ = (key);                                \
+        _hashtable_get ( (hashtable) , key__.string , key__.length        \
+                       , (value)                                          \
+                       );                                                 \
+    })
+
+/**
+ * @brief Queries the values of a batch of keys of equal length. O(1) per key.
+ * 
+ * Equivalent to calling _hashtable_get for each key, but faster for hashtables
+ * which do not fit in cache, as when probing with every key of a join: the
+ * keys are hashed, and their slots prefetched, several at a time before any of
+ * them is looked up, so that the cache misses overlap instead of being taken
+ * one at a time.
+ * 
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @param keys The keys, contiguous in memory. Must be non-zero if count is
+ * non-zero.
+ * @param key_length The length of each key in bytes.
+ * @param count The number of keys.
+ * @param values Output buffer for the values, contiguous in memory, in the
+ * same order as keys (stride bytes each). The value of a key which is not
+ * present is not written to. Pass 0 to retrieve nothing.
+ * @param found Output buffer for whether each key is present (count entries).
+ * Pass 0 to retrieve nothing.
+ * @return The number of keys present within the hashtable.
+ */
+u64
+hashtable_get_batch
+(   const hashtable_t*  hashtable
+,   const void*         keys
+,   const u64           key_length
+,   const u64           count
+,   void*               values
+,   bool*               found
+);
+
+/**
+ * @brief Queries whether a key is present within a hashtable. O(1).
+ * 
+ * Use _hashtable_contains to explicitly specify key length,
+ * hashtable_contains to compute the length of a null-terminated key, or
+ * hashtable_contains_view to pass the key as a string view (see
+ * core/string.h).
+ * 
+ * @param hashtable The hashtable to query. Must be non-zero.
+ * @param key The key to search for. Must be non-zero.
+ * @param key_length The length of key in bytes.
+ * @return true if the key is present within the hashtable; false otherwise.
+ */
+#define _hashtable_contains(hashtable,key,key_length) \
+    _hashtable_get ( (hashtable) , (key) , (key_length) , 0 )
+
+#define hashtable_contains(hashtable,key) \
+    hashtable_get ( (hashtable) , (key) , 0 )
+
+#define hashtable_contains_view(hashtable,key) \
+    hashtable_get_view ( (hashtable) , (key) , 0 )
+
+/**
+ * @brief Removes a key and its value from a hashtable. O(1).
+ * 
+ * Use _hashtable_remove to explicitly specify key length, hashtable_remove
+ * to compute the length of a null-terminated key, or hashtable_remove_view to
+ * pass the key as a string view (see core/string.h).
+ * 
+ * @param hashtable The hashtable to mutate. Must be non-zero.
+ * @param key The key to remove. Must be non-zero.
+ * @param key_length The length of key in bytes.
+ * @param value Output buffer for the value of the removed key. Pass 0 to
+ * retrieve nothing.
+ * @return true if the key was present within the hashtable; false otherwise.
+ */
+bool
+_hashtable_remove
 (   hashtable_t*    hashtable
-,   const char*     key
+,   const void*     key
+,   const u64       key_length
 ,   void*           value
 );
 
+#define hashtable_remove(hashtable,key,value)                               \
+    ({                                                                      \
+        const char* key__ = (key);                                          \
+        _hashtable_remove ( (hashtable) , key__ , _string_length ( key__ )  \
+                          , (value)                                         \
+                          );                                                \
+    })
+
+#define hashtable_remove_view(hashtable,key,value)                          \
+    ({                                                                      \
+        const string_view_t key__ = (key);                                  \
+        _hashtable_remove ( (hashtable) , key__.string , key__.length       \
+                          , (value)                                         \
+                          );                                                \
+    })
+
+/**
+ * @brief Advances an iterator over the key-value pairs of a hashtable.
+ * 
+ * Iteration order is unspecified. Mutating the hashtable invalidates both the
+ * iterator and any key previously retrieved with it.
+ * 
+ * Usage:
+ *   u64 iterator = 0;
+ *   while ( hashtable_iterate ( hashtable , &iterator , &key , &key_length
+ *                             , &value
+ *                             ))
+ *   { ... }
+ * 
+ * @param hashtable The hashtable to iterate over. Must be non-zero.
+ * @param iterator Iterator state. Must be non-zero. Set to 0 before the
+ * first call.
+ * @param key Output buffer for the address of the key. The key is owned by the
+ * hashtable. Pass 0 to retrieve nothing.
+ * @param key_length Output buffer for the length of the key in bytes. Pass 0
+ * to retrieve nothing.
+ * @param value Output buffer for the value. Pass 0 to retrieve nothing.
+ * @return true if a key-value pair was retrieved; false if there are no more
+ * key-value pairs.
+ */
+bool
+hashtable_iterate
+(   const hashtable_t*  hashtable
+,   u64*                iterator
+,   const void**        key
+,   u64*                key_length
+,   void*               value
+);
+
 /**
  * @brief Sets the values for all keys in the hashtable to a default value.
  * O(n).
@@ -165,4 +501,32 @@ hashtable_fill
 ,   void*           value
 );
 
+/**
+ * @brief Writes a position-independent image of a data-valued hashtable, which
+ * may be saved to a file and later used in place (see
+ * _hashtable_create_from_image). O(n).
+ * 
+ * The image holds the hashtable's slots, its long keys, and its values as
+ * raw bytes; a value which holds an address is therefore only meaningful in
+ * the process which wrote it. Images of pointer-valued hashtables are not
+ * supported.
+ * 
+ * Call once with image set to 0 to get the image size; call a second time
+ * passing in a buffer of that size. The size changes whenever the hashtable
+ * is mutated.
+ * 
+ * @param hashtable The hashtable to write. Must be non-zero.
+ * @param image_size Output buffer for the image size (in bytes). Must be
+ * non-zero.
+ * @param image Output buffer for the image. Must be 8-byte aligned, and hold
+ * at least image_size bytes. Pass 0 to read the image size.
+ * @return true on success; false otherwise.
+ */
+bool
+hashtable_to_image
+(   const hashtable_t*  hashtable
+,   u64*                image_size
+,   void*               image
+);
+
 #endif  // HASHTABLE_H
\ No newline at end of file
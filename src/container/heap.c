@@ -0,0 +1,601 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/heap.c
+ * @brief Implementation of the container/heap header.
+ * (see container/heap.h for additional details)
+ */
+#include "container/heap.h"
+
+#include "container/array.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64                     arity;
+    u64                     stride;
+    comparator_function_t   comparator;
+
+    // The elements, in heap order.
+    array_t*                elements;
+
+    // The handle of each element (by index into elements).
+    array_t*                handles;
+
+    // The index of each element (by handle), or HEAP_HANDLE_INVALID.
+    array_t*                positions;
+
+    // Handles available for reuse.
+    array_t*                free;
+
+    // Holds the element being sifted (stride bytes follow the state).
+    void*                   scratch;
+}
+state_t;
+
+/**
+ * @brief Retrieves an element of the heap.
+ *
+ * @param state Internal state arguments.
+ * @param index The element index.
+ * @return The address of the element at index.
+ */
+void*
+heap_element
+(   const state_t*  state
+,   const u64       index
+);
+
+/**
+ * @brief Compares two heap elements.
+ *
+ * @param state Internal state arguments.
+ * @param a An element.
+ * @param b An element.
+ * @return true if a orders strictly before b; false otherwise.
+ */
+bool
+heap_less
+(   const state_t*  state
+,   const void*     a
+,   const void*     b
+);
+
+/**
+ * @brief Writes the element held in scratch to an index, with a handle.
+ *
+ * @param state Internal state arguments.
+ * @param index The element index.
+ * @param handle The element handle.
+ */
+void
+heap_place
+(   state_t*    state
+,   const u64   index
+,   const u64   handle
+);
+
+/**
+ * @brief Moves an element to another index, updating its handle.
+ *
+ * @param state Internal state arguments.
+ * @param dst The index to move to.
+ * @param src The index to move from.
+ */
+void
+heap_move
+(   state_t*    state
+,   const u64   dst
+,   const u64   src
+);
+
+/**
+ * @brief Places the element held in scratch at an index or above it, moving
+ * the parents which order after it down. O(log n).
+ *
+ * @param state Internal state arguments.
+ * @param index The index of the hole to start from.
+ * @param handle The handle of the element held in scratch.
+ */
+void
+heap_sift_up
+(   state_t*    state
+,   u64         index
+,   const u64   handle
+);
+
+/**
+ * @brief Places the element held in scratch at an index or below it, moving
+ * the least children which order before it up. O(arity * log n).
+ *
+ * @param state Internal state arguments.
+ * @param index The index of the hole to start from.
+ * @param handle The handle of the element held in scratch.
+ */
+void
+heap_sift_down
+(   state_t*    state
+,   u64         index
+,   const u64   handle
+);
+
+/**
+ * @brief Places the element held in scratch at an index, sifting it in
+ * whichever direction restores the heap order. O(arity * log n).
+ *
+ * @param state Internal state arguments.
+ * @param index The index of the hole.
+ * @param handle The handle of the element held in scratch.
+ */
+void
+heap_sift
+(   state_t*    state
+,   const u64   index
+,   const u64   handle
+);
+
+/**
+ * @brief Removes the element at an index, filling the hole with the last
+ * element.
+ *
+ * @param state Internal state arguments.
+ * @param index The element index. Must be less than the heap length.
+ */
+void
+heap_remove_at
+(   state_t*    state
+,   const u64   index
+);
+
+/**
+ * @brief Validates a handle.
+ *
+ * @param state Internal state arguments.
+ * @param handle The handle.
+ * @return The index of the element with handle, or HEAP_HANDLE_INVALID.
+ */
+u64
+heap_position
+(   const state_t*  state
+,   const u64       handle
+);
+
+bool
+_heap_create
+(   u64                     arity
+,   u64                     stride
+,   comparator_function_t   comparator
+,   heap_t**                heap
+)
+{
+    return _heap_create_from ( arity , stride , comparator , 0 , 0 , heap );
+}
+
+bool
+_heap_create_from
+(   u64                     arity
+,   u64                     stride
+,   comparator_function_t   comparator
+,   const void*             src
+,   u64                     length
+,   heap_t**                heap
+)
+{
+    if ( arity < 2 || !stride || ( !comparator && stride < sizeof ( u64 ) ) )
+    {
+        if ( arity < 2 )
+        {
+            LOGERROR ( "heap_create: Value of arity argument must be at least 2." );
+        }
+        if ( !stride )
+        {
+            LOGERROR ( "heap_create: Value of stride argument must be non-zero." );
+        }
+        else if ( !comparator && stride < sizeof ( u64 ) )
+        {
+            LOGERROR ( "heap_create: Value of stride argument must be at least %i when ordering by priority (no comparator)."
+                     , sizeof ( u64 )
+                     );
+        }
+        return false;
+    }
+    if ( !heap )
+    {
+        LOGERROR ( "heap_create: Missing argument: heap (output buffer)." );
+        return false;
+    }
+    if ( !src && length )
+    {
+        LOGERROR ( "heap_create_from: Missing argument: src." );
+        return false;
+    }
+
+    const u64 capacity = ( length > HEAP_DEFAULT_CAPACITY ) ? length
+                                                            : HEAP_DEFAULT_CAPACITY
+                                                            ;
+
+    state_t* state = memory_allocate ( sizeof ( state_t ) + stride , MEMORY_TAG_ARRAY );
+    ( *state ).arity = arity;
+    ( *state ).stride = stride;
+    ( *state ).comparator = comparator;
+    ( *state ).elements = _array_create ( capacity , stride );
+    ( *state ).handles = array_create ( u64 , capacity );
+    ( *state ).positions = array_create ( u64 , capacity );
+    ( *state ).free = array_create ( u64 , HEAP_DEFAULT_CAPACITY );
+    ( *state ).scratch = ( void* )( ( ( u64 ) state ) + sizeof ( state_t ) );
+
+    if ( length )
+    {
+        memory_copy ( ( *state ).elements , src , length * stride );
+        for ( u64 i = 0; i < length; ++i )
+        {
+            ( ( u64* )( ( *state ).handles ) )[ i ] = i;
+            ( ( u64* )( ( *state ).positions ) )[ i ] = i;
+        }
+        _array_field_set ( ( *state ).elements , ARRAY_FIELD_LENGTH , length );
+        _array_field_set ( ( *state ).handles , ARRAY_FIELD_LENGTH , length );
+        _array_field_set ( ( *state ).positions , ARRAY_FIELD_LENGTH , length );
+
+        // Heapify: sift each parent down, starting with the last.
+        for ( u64 i = ( length + arity - 2 ) / arity; i; --i )
+        {
+            memory_copy ( ( *state ).scratch
+                        , heap_element ( state , i - 1 )
+                        , stride
+                        );
+            heap_sift_down ( state , i - 1 , ( ( u64* )( ( *state ).handles ) )[ i - 1 ] );
+        }
+    }
+
+    *heap = state;
+    return true;
+}
+
+void
+heap_destroy
+(   heap_t** heap
+)
+{
+    if ( !heap || !*heap )
+    {
+        return;
+    }
+
+    state_t* state = *heap;
+    array_destroy ( ( *state ).elements );
+    array_destroy ( ( *state ).handles );
+    array_destroy ( ( *state ).positions );
+    array_destroy ( ( *state ).free );
+    memory_free ( state , sizeof ( state_t ) + ( *state ).stride , MEMORY_TAG_ARRAY );
+
+    *heap = 0;
+}
+
+u64
+heap_length
+(   const heap_t* heap
+)
+{
+    return array_length ( ( *( ( state_t* ) heap ) ).elements );
+}
+
+u64
+heap_stride
+(   const heap_t* heap
+)
+{
+    return ( *( ( state_t* ) heap ) ).stride;
+}
+
+u64
+heap_arity
+(   const heap_t* heap
+)
+{
+    return ( *( ( state_t* ) heap ) ).arity;
+}
+
+u64
+heap_push
+(   heap_t*     heap
+,   const void* src
+)
+{
+    state_t* state = heap;
+
+    // Reuse a handle if any are free.
+    u64 handle;
+    if ( !array_pop ( ( *state ).free , &handle ) )
+    {
+        handle = array_length ( ( *state ).positions );
+        array_push ( ( *state ).positions , HEAP_HANDLE_INVALID );
+    }
+
+    // Grow the arrays by one element, then sift the new element up from the
+    // end.
+    const u64 index = array_length ( ( *state ).elements );
+    array_push_n ( ( *state ).elements , src , 1 );
+    array_push ( ( *state ).handles , handle );
+    memory_copy ( ( *state ).scratch , src , ( *state ).stride );
+    heap_sift_up ( state , index , handle );
+
+    return handle;
+}
+
+bool
+heap_peek
+(   const heap_t*   heap
+,   void*           dst
+)
+{
+    const state_t* state = heap;
+    if ( !array_length ( ( *state ).elements ) )
+    {
+        return false;
+    }
+    memory_copy ( dst , heap_element ( state , 0 ) , ( *state ).stride );
+    return true;
+}
+
+bool
+heap_pop
+(   heap_t* heap
+,   void*   dst
+)
+{
+    state_t* state = heap;
+    if ( !array_length ( ( *state ).elements ) )
+    {
+        return false;
+    }
+    if ( dst )
+    {
+        memory_copy ( dst , heap_element ( state , 0 ) , ( *state ).stride );
+    }
+    heap_remove_at ( state , 0 );
+    return true;
+}
+
+bool
+heap_contains
+(   const heap_t*   heap
+,   u64             handle
+)
+{
+    return heap_position ( heap , handle ) != HEAP_HANDLE_INVALID;
+}
+
+bool
+heap_get
+(   const heap_t*   heap
+,   u64             handle
+,   void*           dst
+)
+{
+    const state_t* state = heap;
+    const u64 index = heap_position ( state , handle );
+    if ( index == HEAP_HANDLE_INVALID )
+    {
+        return false;
+    }
+    memory_copy ( dst , heap_element ( state , index ) , ( *state ).stride );
+    return true;
+}
+
+bool
+heap_update
+(   heap_t*     heap
+,   u64         handle
+,   const void* src
+)
+{
+    state_t* state = heap;
+    const u64 index = heap_position ( state , handle );
+    if ( index == HEAP_HANDLE_INVALID )
+    {
+        return false;
+    }
+    memory_copy ( ( *state ).scratch , src , ( *state ).stride );
+    heap_sift ( state , index , handle );
+    return true;
+}
+
+bool
+heap_remove
+(   heap_t* heap
+,   u64     handle
+,   void*   dst
+)
+{
+    state_t* state = heap;
+    const u64 index = heap_position ( state , handle );
+    if ( index == HEAP_HANDLE_INVALID )
+    {
+        return false;
+    }
+    if ( dst )
+    {
+        memory_copy ( dst , heap_element ( state , index ) , ( *state ).stride );
+    }
+    heap_remove_at ( state , index );
+    return true;
+}
+
+void
+heap_clear
+(   heap_t* heap
+)
+{
+    state_t* state = heap;
+    _array_field_set ( ( *state ).elements , ARRAY_FIELD_LENGTH , 0 );
+    _array_field_set ( ( *state ).handles , ARRAY_FIELD_LENGTH , 0 );
+    _array_field_set ( ( *state ).positions , ARRAY_FIELD_LENGTH , 0 );
+    _array_field_set ( ( *state ).free , ARRAY_FIELD_LENGTH , 0 );
+}
+
+void*
+heap_element
+(   const state_t*  state
+,   const u64       index
+)
+{
+    return ( void* )( ( ( u64 ) ( *state ).elements ) + index * ( *state ).stride );
+}
+
+bool
+heap_less
+(   const state_t*  state
+,   const void*     a
+,   const void*     b
+)
+{
+    if ( ( *state ).comparator )
+    {
+        return ( *state ).comparator ( a , b ) < 0;
+    }
+    return *( ( const u64* ) a ) < *( ( const u64* ) b );
+}
+
+void
+heap_place
+(   state_t*    state
+,   const u64   index
+,   const u64   handle
+)
+{
+    memory_copy ( heap_element ( state , index ) , ( *state ).scratch , ( *state ).stride );
+    ( ( u64* )( ( *state ).handles ) )[ index ] = handle;
+    ( ( u64* )( ( *state ).positions ) )[ handle ] = index;
+}
+
+void
+heap_move
+(   state_t*    state
+,   const u64   dst
+,   const u64   src
+)
+{
+    const u64 handle = ( ( u64* )( ( *state ).handles ) )[ src ];
+    memory_copy ( heap_element ( state , dst )
+                , heap_element ( state , src )
+                , ( *state ).stride
+                );
+    ( ( u64* )( ( *state ).handles ) )[ dst ] = handle;
+    ( ( u64* )( ( *state ).positions ) )[ handle ] = dst;
+}
+
+void
+heap_sift_up
+(   state_t*    state
+,   u64         index
+,   const u64   handle
+)
+{
+    while ( index )
+    {
+        const u64 parent = ( index - 1 ) / ( *state ).arity;
+        if ( !heap_less ( state , ( *state ).scratch , heap_element ( state , parent ) ) )
+        {
+            break;
+        }
+        heap_move ( state , index , parent );
+        index = parent;
+    }
+    heap_place ( state , index , handle );
+}
+
+void
+heap_sift_down
+(   state_t*    state
+,   u64         index
+,   const u64   handle
+)
+{
+    const u64 length = array_length ( ( *state ).elements );
+    const u64 arity = ( *state ).arity;
+    for (;;)
+    {
+        const u64 first = index * arity + 1;
+        if ( first >= length )
+        {
+            break;
+        }
+
+        // Find the least child.
+        const u64 last = ( first + arity < length ) ? first + arity : length;
+        u64 least = first;
+        for ( u64 child = first + 1; child < last; ++child )
+        {
+            if ( heap_less ( state , heap_element ( state , child ) , heap_element ( state , least ) ) )
+            {
+                least = child;
+            }
+        }
+
+        if ( !heap_less ( state , heap_element ( state , least ) , ( *state ).scratch ) )
+        {
+            break;
+        }
+        heap_move ( state , index , least );
+        index = least;
+    }
+    heap_place ( state , index , handle );
+}
+
+void
+heap_sift
+(   state_t*    state
+,   const u64   index
+,   const u64   handle
+)
+{
+    if ( index && heap_less ( state
+                            , ( *state ).scratch
+                            , heap_element ( state , ( index - 1 ) / ( *state ).arity )
+                            ))
+    {
+        heap_sift_up ( state , index , handle );
+    }
+    else
+    {
+        heap_sift_down ( state , index , handle );
+    }
+}
+
+void
+heap_remove_at
+(   state_t*    state
+,   const u64   index
+)
+{
+    const u64 handle = ( ( u64* )( ( *state ).handles ) )[ index ];
+    ( ( u64* )( ( *state ).positions ) )[ handle ] = HEAP_HANDLE_INVALID;
+    array_push ( ( *state ).free , handle );
+
+    // Detach the last element, and sift it into the hole (unless the hole was
+    // the last element).
+    const u64 last = array_length ( ( *state ).elements ) - 1;
+    const u64 last_handle = ( ( u64* )( ( *state ).handles ) )[ last ];
+    memory_copy ( ( *state ).scratch , heap_element ( state , last ) , ( *state ).stride );
+    array_pop ( ( *state ).elements , 0 );
+    array_pop ( ( *state ).handles , 0 );
+    if ( index != last )
+    {
+        heap_sift ( state , index , last_handle );
+    }
+}
+
+u64
+heap_position
+(   const state_t*  state
+,   const u64       handle
+)
+{
+    if ( handle >= array_length ( ( *state ).positions ) )
+    {
+        return HEAP_HANDLE_INVALID;
+    }
+    return ( ( u64* )( ( *state ).positions ) )[ handle ];
+}
@@ -0,0 +1,274 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/heap.h
+ * @brief Provides an interface for a d-ary heap (priority queue).
+ *
+ * A heap holds fixed-size elements, and always yields the least of them first
+ * (by a comparator, or by an integer priority). Push and pop cost O(log n),
+ * compared to O(n) for keeping a resizable array sorted with array_insert.
+ *
+ *   heap_t* timers;
+ *   heap_create_priority ( timer_t , &timers );
+ *   const u64 handle = heap_push ( timers , &timer );
+ *   ...
+ *   timer.deadline = sooner;
+ *   heap_update ( timers , handle , &timer );
+ *   ...
+ *   while ( heap_peek ( timers , &timer ) && timer.deadline <= now )
+ *   {
+ *       heap_pop ( timers , 0 );
+ *       ...
+ *   }
+ *
+ * Each node has arity children (default HEAP_DEFAULT_ARITY). A larger arity
+ * makes the heap shallower, so that pushes are cheaper and the children of a
+ * node share fewer cache lines, at the cost of more comparisons per pop.
+ *
+ * Pushing an element returns a handle to it, which remains valid until the
+ * element leaves the heap (by heap_pop, heap_remove or heap_clear), and which
+ * may then be reused for a later element. A handle is used to update the
+ * element in place, e.g. to decrease its key, or to remove it.
+ *
+ * Storage is a resizable array (see container/array.h), and grows by its
+ * growth policy.
+ */
+#ifndef HEAP_H
+#define HEAP_H
+
+#include "common.h"
+
+/** @brief Type declaration for a heap. */
+typedef void heap_t;
+
+/** @brief Heap default arity. */
+#define HEAP_DEFAULT_ARITY 4
+
+/** @brief Heap default capacity. */
+#define HEAP_DEFAULT_CAPACITY 16
+
+/** @brief Value of an invalid heap handle. */
+#define HEAP_HANDLE_INVALID ( ( u64 ) -1 )
+
+/**
+ * @brief Initializes a heap.
+ *
+ * Use _heap_create to explicitly specify the arity, heap_create to order the
+ * elements with a comparator, or heap_create_priority to order them by an
+ * integer priority.
+ *
+ * Uses dynamic memory allocation. Call heap_destroy to free.
+ *
+ * @param arity The number of children of each node. Must be at least 2.
+ * @param stride The fixed element size in bytes. Must be non-zero.
+ * @param comparator A function which compares two elements; the element which
+ * compares least is yielded first. Pass 0 to order the elements by a u64
+ * priority stored in the first 8 bytes of each element instead, least first
+ * (stride must then be at least 8).
+ * @param heap Output buffer for the heap. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+_heap_create
+(   u64                     arity
+,   u64                     stride
+,   comparator_function_t   comparator
+,   heap_t**                heap
+);
+
+/** @param type C data type of the heap. */
+#define heap_create(type,comparator,heap) \
+    _heap_create ( HEAP_DEFAULT_ARITY , sizeof ( type ) , (comparator) , (heap) )
+
+/** @param type C data type of the heap; must begin with a u64 priority. */
+#define heap_create_priority(type,heap) \
+    _heap_create ( HEAP_DEFAULT_ARITY , sizeof ( type ) , 0 , (heap) )
+
+/**
+ * @brief Initializes a heap from an array of elements. O(n).
+ *
+ * Builds the heap bottom-up (Floyd's method), rather than with one push per
+ * element. Element i of src is given handle i.
+ *
+ * Uses dynamic memory allocation. Call heap_destroy to free.
+ *
+ * @param arity The number of children of each node. Must be at least 2.
+ * @param stride The fixed element size in bytes. Must be non-zero.
+ * @param comparator A function which compares two elements (see
+ * _heap_create).
+ * @param src The elements, contiguous in memory. Must be non-zero if length is
+ * non-zero.
+ * @param length The number of elements in src.
+ * @param heap Output buffer for the heap. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+_heap_create_from
+(   u64                     arity
+,   u64                     stride
+,   comparator_function_t   comparator
+,   const void*             src
+,   u64                     length
+,   heap_t**                heap
+);
+
+/** @param type C data type of the heap. */
+#define heap_create_from(type,comparator,src,length,heap)                     \
+    _heap_create_from ( HEAP_DEFAULT_ARITY , sizeof ( type ) , (comparator) \
+                      , (src) , (length) , (heap)                           \
+                      )
+
+/**
+ * @brief Frees the memory used by a heap.
+ *
+ * @param heap Handle to the heap to free.
+ */
+void
+heap_destroy
+(   heap_t** heap
+);
+
+/**
+ * @brief Queries the number of elements in a heap.
+ *
+ * @param heap The heap to query. Must be non-zero.
+ * @return The number of elements.
+ */
+u64
+heap_length
+(   const heap_t* heap
+);
+
+/**
+ * @brief Queries the element size of a heap.
+ *
+ * @param heap The heap to query. Must be non-zero.
+ * @return The fixed element size in bytes.
+ */
+u64
+heap_stride
+(   const heap_t* heap
+);
+
+/**
+ * @brief Queries the arity of a heap.
+ *
+ * @param heap The heap to query. Must be non-zero.
+ * @return The number of children of each node.
+ */
+u64
+heap_arity
+(   const heap_t* heap
+);
+
+/**
+ * @brief Inserts an element into a heap. O(log n), on average.
+ *
+ * @param heap The heap to insert into. Must be non-zero.
+ * @param src The element to insert. Must be non-zero.
+ * @return A handle to the element.
+ */
+u64
+heap_push
+(   heap_t*     heap
+,   const void* src
+);
+
+/**
+ * @brief Retrieves the least element of a heap, without removing it. O(1).
+ *
+ * @param heap The heap to query. Must be non-zero.
+ * @param dst Output buffer for the element, if present. Must be non-zero.
+ * @return true on success; false if heap empty.
+ */
+bool
+heap_peek
+(   const heap_t*   heap
+,   void*           dst
+);
+
+/**
+ * @brief Removes the least element of a heap. O(log n).
+ *
+ * @param heap The heap to remove from. Must be non-zero.
+ * @param dst Output buffer for the element, if present. Pass 0 to retrieve
+ * nothing.
+ * @return true on success; false if heap empty.
+ */
+bool
+heap_pop
+(   heap_t* heap
+,   void*   dst
+);
+
+/**
+ * @brief Queries whether a handle refers to an element of a heap. O(1).
+ *
+ * @param heap The heap to query. Must be non-zero.
+ * @param handle The handle.
+ * @return true if handle refers to an element of heap; false otherwise.
+ */
+bool
+heap_contains
+(   const heap_t*   heap
+,   u64             handle
+);
+
+/**
+ * @brief Retrieves an element of a heap by handle. O(1).
+ *
+ * @param heap The heap to query. Must be non-zero.
+ * @param handle The handle of the element.
+ * @param dst Output buffer for the element. Must be non-zero.
+ * @return true on success; false if handle is invalid.
+ */
+bool
+heap_get
+(   const heap_t*   heap
+,   u64             handle
+,   void*           dst
+);
+
+/**
+ * @brief Overwrites an element of a heap by handle, and restores the heap
+ * order. O(log n).
+ *
+ * The new element may order before the old one (decrease-key) or after it.
+ *
+ * @param heap The heap to mutate. Must be non-zero.
+ * @param handle The handle of the element.
+ * @param src The new element. Must be non-zero.
+ * @return true on success; false if handle is invalid.
+ */
+bool
+heap_update
+(   heap_t*     heap
+,   u64         handle
+,   const void* src
+);
+
+/**
+ * @brief Removes an element from a heap by handle. O(log n).
+ *
+ * @param heap The heap to mutate. Must be non-zero.
+ * @param handle The handle of the element.
+ * @param dst Output buffer for the element. Pass 0 to retrieve nothing.
+ * @return true on success; false if handle is invalid.
+ */
+bool
+heap_remove
+(   heap_t* heap
+,   u64     handle
+,   void*   dst
+);
+
+/**
+ * @brief Removes every element from a heap, invalidating every handle. O(1).
+ *
+ * @param heap The heap to clear. Must be non-zero.
+ */
+void
+heap_clear
+(   heap_t* heap
+);
+
+#endif  // HEAP_H
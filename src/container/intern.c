@@ -0,0 +1,252 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/intern.c
+ * @brief Implementation of the container/intern header.
+ * (see container/intern.h for additional details)
+ */
+#include "container/intern.h"
+
+#include "container/array.h"
+#include "container/hashtable.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "memory/arena.h"
+
+#include "platform/lock.h"
+
+/** @brief Default capacity of the lookup table of a pool (in strings). */
+#define INTERN_POOL_DEFAULT_CAPACITY 64
+
+/** @brief Block size of the string storage of a pool (in bytes). */
+#define INTERN_POOL_BLOCK_SIZE ( KiB ( 16 ) )
+
+/**
+ * @brief Type definition for the header which precedes each interned string
+ * in the string storage of a pool.
+ */
+typedef struct
+{
+    u64 length;
+    u32 id;
+    u32 padding;
+}
+entry_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    // Maps the characters of each interned string to its interned copy.
+    hashtable_t*    table;
+
+    // Interned copies, indexed by ID.
+    const char**    strings;
+
+    // Storage for every interned copy (and its header). Never moves, so
+    // interned strings remain valid until the pool is destroyed.
+    arena_t*        storage;
+
+    rwlock_t        lock;
+}
+state_t;
+
+/**
+ * @brief Obtains the header of an interned string.
+ *
+ * @param string An interned string.
+ * @return The header of string.
+ */
+INLINE
+const entry_t*
+_intern_entry
+(   const char* string
+)
+{
+    return ( ( const entry_t* ) string ) - 1;
+}
+
+bool
+intern_pool_create
+(   intern_pool_t** pool
+)
+{
+    if ( !pool )
+    {
+        LOGERROR ( "intern_pool_create: Missing argument: pool (output buffer)." );
+        return false;
+    }
+
+    state_t* state = memory_allocate ( sizeof ( state_t ) , MEMORY_TAG_STRING );
+    if ( !hashtable_create ( true
+                           , sizeof ( const char* )
+                           , INTERN_POOL_DEFAULT_CAPACITY
+                           , 0
+                           , 0
+                           , &( *state ).table
+                           ))
+    {
+        memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_STRING );
+        return false;
+    }
+    if ( !arena_create ( INTERN_POOL_BLOCK_SIZE , &( *state ).storage ) )
+    {
+        hashtable_destroy ( &( *state ).table );
+        memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_STRING );
+        return false;
+    }
+    ( *state ).strings = array_create ( const char* , INTERN_POOL_DEFAULT_CAPACITY );
+
+    *pool = state;
+    return true;
+}
+
+void
+intern_pool_destroy
+(   intern_pool_t** pool
+)
+{
+    if ( !pool || !*pool )
+    {
+        return;
+    }
+    state_t* state = *pool;
+    hashtable_destroy ( &( *state ).table );
+    arena_destroy ( &( *state ).storage );
+    array_destroy ( ( *state ).strings );
+    memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_STRING );
+    *pool = 0;
+}
+
+u64
+intern_pool_count
+(   intern_pool_t* pool
+)
+{
+    state_t* state = pool;
+    rwlock_acquire_read ( &( *state ).lock );
+    const u64 count = array_length ( ( *state ).strings );
+    rwlock_release_read ( &( *state ).lock );
+    return count;
+}
+
+const char*
+intern_pool_get
+(   intern_pool_t*  pool
+,   u32             id
+)
+{
+    state_t* state = pool;
+    rwlock_acquire_read ( &( *state ).lock );
+    const char* string = ( id < array_length ( ( *state ).strings ) )
+                       ? ( *state ).strings[ id ]
+                       : 0
+                       ;
+    rwlock_release_read ( &( *state ).lock );
+    return string;
+}
+
+const char*
+_intern_string
+(   intern_pool_t*  pool
+,   const char*     string
+,   u64             length
+)
+{
+    state_t* state = pool;
+    if ( length && !string )
+    {
+        LOGERROR ( "_intern_string: Missing argument: string." );
+        return 0;
+    }
+    if ( !string )
+    {
+        string = "";
+    }
+
+    // Common case: the string is already interned.
+    const char* interned = _intern_find ( pool , string , length );
+    if ( interned )
+    {
+        return interned;
+    }
+
+    rwlock_acquire_write ( &( *state ).lock );
+
+    // Another thread may have interned the string since the lookup.
+    if ( _hashtable_get ( ( *state ).table , string , length , &interned ) )
+    {
+        rwlock_release_write ( &( *state ).lock );
+        return interned;
+    }
+
+    entry_t* entry = _arena_allocate ( ( *state ).storage
+                                     , sizeof ( entry_t ) + length + 1
+                                     , sizeof ( entry_t )
+                                     );
+    if ( !entry )
+    {
+        rwlock_release_write ( &( *state ).lock );
+        return 0;
+    }
+    ( *entry ).length = length;
+    ( *entry ).id = array_length ( ( *state ).strings );
+    ( *entry ).padding = 0;
+    char* copy = ( char* )( entry + 1 );
+    if ( length )
+    {
+        memory_copy ( copy , string , length );
+    }
+    copy[ length ] = 0;
+
+    if ( !_hashtable_set ( ( *state ).table , copy , length , copy ) )
+    {
+        rwlock_release_write ( &( *state ).lock );
+        return 0;
+    }
+    array_push ( ( *state ).strings , ( const char* ) copy );
+
+    rwlock_release_write ( &( *state ).lock );
+    return copy;
+}
+
+const char*
+_intern_find
+(   intern_pool_t*  pool
+,   const char*     string
+,   u64             length
+)
+{
+    state_t* state = pool;
+    if ( length && !string )
+    {
+        LOGERROR ( "_intern_find: Missing argument: string." );
+        return 0;
+    }
+    if ( !string )
+    {
+        string = "";
+    }
+
+    const char* interned = 0;
+    rwlock_acquire_read ( &( *state ).lock );
+    _hashtable_get ( ( *state ).table , string , length , &interned );
+    rwlock_release_read ( &( *state ).lock );
+    return interned;
+}
+
+u64
+intern_length
+(   const char* string
+)
+{
+    return ( *_intern_entry ( string ) ).length;
+}
+
+u32
+intern_id
+(   const char* string
+)
+{
+    return ( *_intern_entry ( string ) ).id;
+}
@@ -0,0 +1,176 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/intern.h
+ * @brief Provides an interface for a thread-safe string interning pool.
+ *
+ * Interning a string returns the pool's one copy of it: every call with equal
+ * characters returns the same address, so interned strings are compared for
+ * equality by address, and each distinct string is stored once however often
+ * it is interned. Each interned string also has a small integer ID, assigned
+ * in the order the strings were first interned, for use as a compact key.
+ *
+ *   const char* a = intern_string ( pool , "position" );
+ *   const char* b = intern_view ( pool , field_name );
+ *   if ( a == b ) { ... }
+ *
+ * Interned strings are null-terminated and immutable, and remain valid (at the
+ * same address) until the pool is destroyed. Lookups of strings which are
+ * already interned only take the pool's lock for reading, so any number of
+ * threads may intern concurrently.
+ *
+ * The lookup table is a hashtable (see container/hashtable.h) keyed by the
+ * characters of each interned string. Strings longer than
+ * HASHTABLE_KEY_INLINE_CAPACITY are therefore held twice: once as the
+ * interned copy, and once as the table's key.
+ */
+#ifndef INTERN_H
+#define INTERN_H
+
+#include "common.h"
+
+#include "core/string.h"
+
+/** @brief Type declaration for a string interning pool. */
+typedef void intern_pool_t;
+
+/**
+ * @brief Initializes a string interning pool.
+ *
+ * Uses dynamic memory allocation. Call intern_pool_destroy to free.
+ *
+ * @param pool Output buffer for the pool. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+intern_pool_create
+(   intern_pool_t** pool
+);
+
+/**
+ * @brief Frees the memory used by a string interning pool, including every
+ * string interned in it.
+ *
+ * @param pool Handle to the pool to free.
+ */
+void
+intern_pool_destroy
+(   intern_pool_t** pool
+);
+
+/**
+ * @brief Queries the number of distinct strings interned in a pool.
+ *
+ * @param pool The pool to query. Must be non-zero.
+ * @return The number of interned strings.
+ */
+u64
+intern_pool_count
+(   intern_pool_t* pool
+);
+
+/**
+ * @brief Obtains an interned string by its ID. O(1).
+ *
+ * @param pool The pool to query. Must be non-zero.
+ * @param id The ID of the string (see intern_id).
+ * @return The interned string, or 0 if no string has that ID.
+ */
+const char*
+intern_pool_get
+(   intern_pool_t*  pool
+,   u32             id
+);
+
+/**
+ * @brief Interns a string, copying it into the pool if no equal string is
+ * interned yet. O(length), on average.
+ *
+ * Use _intern_string to explicitly specify string length, intern_string to
+ * compute the length of a null-terminated string, or intern_view to pass a
+ * string view (see core/string.h).
+ *
+ * @param pool The pool to intern the string in. Must be non-zero.
+ * @param string The characters to intern. Must be non-zero if length is
+ * non-zero; may contain null characters.
+ * @param length The number of characters in string.
+ * @return The interned copy of string (null-terminated).
+ */
+const char*
+_intern_string
+(   intern_pool_t*  pool
+,   const char*     string
+,   u64             length
+);
+
+#define intern_string(pool,string)                                          \
+    ({                                                                      \
+        const char* string__ = (string);                                    \
+        _intern_string ( (pool) , string__ , _string_length ( string__ ) ); \
+    })
+
+#define intern_view(pool,view)                                              \
+    ({                                                                      \
+        const string_view_t view__ = (view);                                \
+        _intern_string ( (pool) , view__.string , view__.length );          \
+    })
+
+/**
+ * @brief Looks up the interned copy of a string, without interning it.
+ * O(length), on average.
+ *
+ * @param pool The pool to query. Must be non-zero.
+ * @param string The characters to look up. Must be non-zero if length is
+ * non-zero.
+ * @param length The number of characters in string.
+ * @return The interned copy of string, or 0 if it has not been interned.
+ */
+const char*
+_intern_find
+(   intern_pool_t*  pool
+,   const char*     string
+,   u64             length
+);
+
+#define intern_find(pool,string)                                            \
+    ({                                                                      \
+        const char* string__ = (string);                                    \
+        _intern_find ( (pool) , string__ , _string_length ( string__ ) );   \
+    })
+
+/**
+ * @brief Queries the length of an interned string. O(1).
+ *
+ * @param string A string returned by an intern function. Must be non-zero.
+ * @return The number of characters in string.
+ */
+u64
+intern_length
+(   const char* string
+);
+
+/**
+ * @brief Queries the ID of an interned string. O(1).
+ *
+ * IDs are assigned from 0, in the order strings are first interned in a pool.
+ *
+ * @param string A string returned by an intern function. Must be non-zero.
+ * @return The ID of string within its pool.
+ */
+u32
+intern_id
+(   const char* string
+);
+
+/**
+ * @brief Obtains a string view of an interned string. O(1).
+ *
+ * @param string A string returned by an intern function. Must be non-zero.
+ * @return A view of string.
+ */
+#define intern_view_of(string)                                              \
+    ({                                                                      \
+        const char* string__ = (string);                                    \
+        string_view ( string__ , intern_length ( string__ ) );              \
+    })
+
+#endif  // INTERN_H
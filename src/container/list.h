@@ -0,0 +1,565 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/list.h
+ * @brief Provides an interface for intrusive linked lists: a doubly linked
+ * list, and a lock-free stack.
+ *
+ * An intrusive list does not allocate: each element embeds a node, and the
+ * list links the nodes together. An element may therefore be inserted or
+ * removed in O(1) given only its address, and lists may be spliced together
+ * in O(1).
+ *
+ *   typedef struct
+ *   {
+ *       u64         key;
+ *       list_node_t lru;
+ *   }
+ *   entry_t;
+ *
+ *   list_t lru;
+ *   list_init ( &lru );
+ *   list_push_front ( &lru , &( *entry ).lru );
+ *   ...
+ *   list_move_front ( &lru , &( *entry ).lru );        // On access.
+ *   ...
+ *   entry_t* oldest = list_entry ( list_pop_back ( &lru ) , entry_t , lru );
+ *
+ * A node may be on at most one list at a time (per node it embeds). Lists are
+ * not thread-safe; atomic_stack_t is the exception.
+ */
+#ifndef LIST_H
+#define LIST_H
+
+#include "common.h"
+
+/** @brief Type definition for a list node, embedded in each element. */
+typedef struct list_node_t
+{
+    struct list_node_t* prev;
+    struct list_node_t* next;
+}
+list_node_t;
+
+/**
+ * @brief Type definition for a doubly linked list. Circular, through a
+ * sentinel node, so that no operation branches on the ends. Initialize with
+ * list_init; must not be copied once initialized.
+ */
+typedef struct
+{
+    list_node_t head;
+}
+list_t;
+
+/**
+ * @brief Obtains the address of the element which embeds a node.
+ *
+ * @param node The node (may be 0).
+ * @param type C data type of the element.
+ * @param member The name of the node member of type.
+ * @return The address of the element, or 0 if node is 0.
+ */
+#define list_entry(node,type,member)                                        \
+    ({                                                                      \
+        list_node_t* node__ = (node);                                       \
+        node__ ? ( ( type* )( ( ( u64 ) node__ )                            \
+                            - ( ( u64 ) &( *( ( type* ) 0 ) ).member )      \
+                            ))                                              \
+               : ( type* ) 0                                                \
+               ;                                                            \
+    })
+
+/**
+ * @brief Initializes an empty list.
+ *
+ * @param list The list to initialize. Must be non-zero.
+ */
+INLINE
+void
+list_init
+(   list_t* list
+)
+{
+    ( *list ).head.prev = &( *list ).head;
+    ( *list ).head.next = &( *list ).head;
+}
+
+/**
+ * @brief Queries whether a list is empty. O(1).
+ *
+ * @param list The list to query. Must be non-zero.
+ * @return true if list is empty; false otherwise.
+ */
+INLINE
+bool
+list_empty
+(   const list_t* list
+)
+{
+    return ( *list ).head.next == &( *list ).head;
+}
+
+/**
+ * @brief Counts the nodes in a list. O(n).
+ *
+ * @param list The list to query. Must be non-zero.
+ * @return The number of nodes.
+ */
+INLINE
+u64
+list_length
+(   const list_t* list
+)
+{
+    u64 length = 0;
+    for ( const list_node_t* node = ( *list ).head.next
+        ; node != &( *list ).head
+        ; node = ( *node ).next
+        )
+    {
+        length += 1;
+    }
+    return length;
+}
+
+/**
+ * @brief Retrieves the first node of a list. O(1).
+ *
+ * @param list The list to query. Must be non-zero.
+ * @return The first node, or 0 if list is empty.
+ */
+INLINE
+list_node_t*
+list_front
+(   const list_t* list
+)
+{
+    return list_empty ( list ) ? 0 : ( *list ).head.next;
+}
+
+/**
+ * @brief Retrieves the last node of a list. O(1).
+ *
+ * @param list The list to query. Must be non-zero.
+ * @return The last node, or 0 if list is empty.
+ */
+INLINE
+list_node_t*
+list_back
+(   const list_t* list
+)
+{
+    return list_empty ( list ) ? 0 : ( *list ).head.prev;
+}
+
+/**
+ * @brief Retrieves the node after a node of a list. O(1).
+ *
+ * Usage:
+ *   for ( list_node_t* node = list_front ( list ); node; node = list_next ( list , node ) )
+ *   { ... }
+ *
+ * @param list The list node is on. Must be non-zero.
+ * @param node A node on list. Must be non-zero.
+ * @return The next node, or 0 if node is the last.
+ */
+INLINE
+list_node_t*
+list_next
+(   const list_t*       list
+,   const list_node_t*  node
+)
+{
+    return ( ( *node ).next == &( *list ).head ) ? 0 : ( *node ).next;
+}
+
+/**
+ * @brief Retrieves the node before a node of a list. O(1).
+ *
+ * @param list The list node is on. Must be non-zero.
+ * @param node A node on list. Must be non-zero.
+ * @return The previous node, or 0 if node is the first.
+ */
+INLINE
+list_node_t*
+list_prev
+(   const list_t*       list
+,   const list_node_t*  node
+)
+{
+    return ( ( *node ).prev == &( *list ).head ) ? 0 : ( *node ).prev;
+}
+
+/**
+ * @brief Inserts a node after a node already on a list. O(1).
+ *
+ * @param position A node on a list (or the head of a list). Must be non-zero.
+ * @param node The node to insert. Must be non-zero, and not on a list.
+ */
+INLINE
+void
+list_insert_after
+(   list_node_t*    position
+,   list_node_t*    node
+)
+{
+    ( *node ).prev = position;
+    ( *node ).next = ( *position ).next;
+    ( *( ( *position ).next ) ).prev = node;
+    ( *position ).next = node;
+}
+
+/**
+ * @brief Inserts a node before a node already on a list. O(1).
+ *
+ * @param position A node on a list (or the head of a list). Must be non-zero.
+ * @param node The node to insert. Must be non-zero, and not on a list.
+ */
+INLINE
+void
+list_insert_before
+(   list_node_t*    position
+,   list_node_t*    node
+)
+{
+    list_insert_after ( ( *position ).prev , node );
+}
+
+/**
+ * @brief Inserts a node at the front of a list. O(1).
+ *
+ * @param list The list to insert into. Must be non-zero.
+ * @param node The node to insert. Must be non-zero, and not on a list.
+ */
+INLINE
+void
+list_push_front
+(   list_t*         list
+,   list_node_t*    node
+)
+{
+    list_insert_after ( &( *list ).head , node );
+}
+
+/**
+ * @brief Inserts a node at the back of a list. O(1).
+ *
+ * @param list The list to insert into. Must be non-zero.
+ * @param node The node to insert. Must be non-zero, and not on a list.
+ */
+INLINE
+void
+list_push_back
+(   list_t*         list
+,   list_node_t*    node
+)
+{
+    list_insert_after ( ( *list ).head.prev , node );
+}
+
+/**
+ * @brief Removes a node from the list it is on. O(1).
+ *
+ * @param node The node to remove. Must be non-zero, and on a list. Its links
+ * are cleared.
+ */
+INLINE
+void
+list_remove
+(   list_node_t* node
+)
+{
+    ( *( ( *node ).prev ) ).next = ( *node ).next;
+    ( *( ( *node ).next ) ).prev = ( *node ).prev;
+    ( *node ).prev = 0;
+    ( *node ).next = 0;
+}
+
+/**
+ * @brief Removes the first node of a list. O(1).
+ *
+ * @param list The list to remove from. Must be non-zero.
+ * @return The node removed, or 0 if list is empty.
+ */
+INLINE
+list_node_t*
+list_pop_front
+(   list_t* list
+)
+{
+    list_node_t* node = list_front ( list );
+    if ( node )
+    {
+        list_remove ( node );
+    }
+    return node;
+}
+
+/**
+ * @brief Removes the last node of a list. O(1).
+ *
+ * @param list The list to remove from. Must be non-zero.
+ * @return The node removed, or 0 if list is empty.
+ */
+INLINE
+list_node_t*
+list_pop_back
+(   list_t* list
+)
+{
+    list_node_t* node = list_back ( list );
+    if ( node )
+    {
+        list_remove ( node );
+    }
+    return node;
+}
+
+/**
+ * @brief Moves a node to the front of a list (e.g. on access, for LRU
+ * ordering). O(1).
+ *
+ * @param list The list to move node to. Must be non-zero.
+ * @param node A node on any list. Must be non-zero.
+ */
+INLINE
+void
+list_move_front
+(   list_t*         list
+,   list_node_t*    node
+)
+{
+    list_remove ( node );
+    list_push_front ( list , node );
+}
+
+/**
+ * @brief Moves a node to the back of a list. O(1).
+ *
+ * @param list The list to move node to. Must be non-zero.
+ * @param node A node on any list. Must be non-zero.
+ */
+INLINE
+void
+list_move_back
+(   list_t*         list
+,   list_node_t*    node
+)
+{
+    list_remove ( node );
+    list_push_back ( list , node );
+}
+
+/**
+ * @brief Moves every node of a list to the back of another, in order, leaving
+ * it empty. O(1).
+ *
+ * @param list The list to append to. Must be non-zero.
+ * @param other The list to append. Must be non-zero, and not list.
+ */
+INLINE
+void
+list_splice_back
+(   list_t* list
+,   list_t* other
+)
+{
+    if ( list_empty ( other ) )
+    {
+        return;
+    }
+    list_node_t* first = ( *other ).head.next;
+    list_node_t* last = ( *other ).head.prev;
+    ( *first ).prev = ( *list ).head.prev;
+    ( *( ( *list ).head.prev ) ).next = first;
+    ( *last ).next = &( *list ).head;
+    ( *list ).head.prev = last;
+    list_init ( other );
+}
+
+/**
+ * @brief Moves every node of a list to the front of another, in order,
+ * leaving it empty. O(1).
+ *
+ * @param list The list to prepend to. Must be non-zero.
+ * @param other The list to prepend. Must be non-zero, and not list.
+ */
+INLINE
+void
+list_splice_front
+(   list_t* list
+,   list_t* other
+)
+{
+    if ( list_empty ( other ) )
+    {
+        return;
+    }
+    list_node_t* first = ( *other ).head.next;
+    list_node_t* last = ( *other ).head.prev;
+    ( *last ).next = ( *list ).head.next;
+    ( *( ( *list ).head.next ) ).prev = last;
+    ( *first ).prev = &( *list ).head;
+    ( *list ).head.next = first;
+    list_init ( other );
+}
+
+/**
+ * @brief Type definition for a lock-free stack node, embedded in each element.
+ */
+typedef struct atomic_stack_node_t
+{
+    struct atomic_stack_node_t* next;
+}
+atomic_stack_node_t;
+
+/**
+ * @brief Type definition for a lock-free intrusive stack (Treiber stack).
+ * Initialize with atomic_stack_init.
+ *
+ * Any number of threads may push and pop concurrently. The head is a tagged
+ * pointer: the node address in the low ATOMIC_STACK_POINTER_BITS bits, and a
+ * counter which is incremented by every push and pop in the rest, so that a
+ * pop which raced with the node being popped and pushed back again (ABA)
+ * fails and retries, rather than corrupting the stack.
+ *
+ * A pop reads the link of the top node, which another thread may pop (and
+ * reuse) concurrently; the memory of a node must therefore remain readable for
+ * as long as the stack may be used, e.g. by being allocated from a pool
+ * (see memory/pool_allocator.h) which outlives it.
+ */
+typedef struct
+{
+    u64 head;
+}
+atomic_stack_t;
+
+/**
+ * @brief Number of bits of a tagged pointer which hold the node address. The
+ * user address space of every supported platform fits in 48 bits.
+ */
+#define ATOMIC_STACK_POINTER_BITS 48
+#define ATOMIC_STACK_POINTER_MASK ( ( ( ( u64 ) 1 ) << ATOMIC_STACK_POINTER_BITS ) - 1 )
+#define ATOMIC_STACK_TAG_INCREMENT ( ( ( u64 ) 1 ) << ATOMIC_STACK_POINTER_BITS )
+
+/**
+ * @brief Initializes an empty lock-free stack.
+ *
+ * @param stack The stack to initialize. Must be non-zero.
+ */
+INLINE
+void
+atomic_stack_init
+(   atomic_stack_t* stack
+)
+{
+    atomic_store_u64 ( &( *stack ).head , 0 , ATOMIC_RELAXED );
+}
+
+/**
+ * @brief Queries whether a lock-free stack is empty. The result may be stale
+ * by the time it is used.
+ *
+ * @param stack The stack to query. Must be non-zero.
+ * @return true if stack is empty; false otherwise.
+ */
+INLINE
+bool
+atomic_stack_empty
+(   const atomic_stack_t* stack
+)
+{
+    return !( atomic_load_u64 ( &( *stack ).head , ATOMIC_RELAXED ) & ATOMIC_STACK_POINTER_MASK );
+}
+
+/**
+ * @brief Pushes a node onto a lock-free stack. Lock-free.
+ *
+ * @param stack The stack to push onto. Must be non-zero.
+ * @param node The node to push. Must be non-zero, and not on a stack.
+ */
+INLINE
+void
+atomic_stack_push
+(   atomic_stack_t*         stack
+,   atomic_stack_node_t*    node
+)
+{
+    u64 head = atomic_load_u64 ( &( *stack ).head , ATOMIC_RELAXED );
+    u64 desired;
+    do
+    {
+        atomic_store_ptr ( ( void** ) &( *node ).next
+                         , ( void* )( head & ATOMIC_STACK_POINTER_MASK )
+                         , ATOMIC_RELAXED
+                         );
+        desired = ( ( u64 ) node )
+                | ( ( head + ATOMIC_STACK_TAG_INCREMENT ) & ~ATOMIC_STACK_POINTER_MASK )
+                ;
+    }
+    while ( !atomic_compare_exchange_u64 ( &( *stack ).head , &head , desired
+                                         , ATOMIC_RELEASE , ATOMIC_RELAXED
+                                         ));
+}
+
+/**
+ * @brief Pops the top node of a lock-free stack. Lock-free.
+ *
+ * @param stack The stack to pop from. Must be non-zero.
+ * @return The node popped, or 0 if stack is empty.
+ */
+INLINE
+atomic_stack_node_t*
+atomic_stack_pop
+(   atomic_stack_t* stack
+)
+{
+    u64 head = atomic_load_u64 ( &( *stack ).head , ATOMIC_ACQUIRE );
+    while ( head & ATOMIC_STACK_POINTER_MASK )
+    {
+        atomic_stack_node_t* node = ( atomic_stack_node_t* )( head & ATOMIC_STACK_POINTER_MASK );
+
+        // May read a stale link if node was popped concurrently; the tag then
+        // differs, and the exchange fails.
+        const u64 next = ( u64 ) atomic_load_ptr ( ( void* const* ) &( *node ).next , ATOMIC_RELAXED );
+        const u64 desired = next
+                          | ( ( head + ATOMIC_STACK_TAG_INCREMENT ) & ~ATOMIC_STACK_POINTER_MASK )
+                          ;
+        if ( atomic_compare_exchange_u64 ( &( *stack ).head , &head , desired
+                                         , ATOMIC_ACQUIRE , ATOMIC_ACQUIRE
+                                         ))
+        {
+            return node;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Pops every node of a lock-free stack at once. Lock-free.
+ *
+ * @param stack The stack to pop from. Must be non-zero.
+ * @return The top node, linked to the rest in pop order (the last links to 0),
+ * or 0 if stack is empty.
+ */
+INLINE
+atomic_stack_node_t*
+atomic_stack_pop_all
+(   atomic_stack_t* stack
+)
+{
+    u64 head = atomic_load_u64 ( &( *stack ).head , ATOMIC_RELAXED );
+    while ( head & ATOMIC_STACK_POINTER_MASK )
+    {
+        const u64 desired = ( head + ATOMIC_STACK_TAG_INCREMENT ) & ~ATOMIC_STACK_POINTER_MASK;
+        if ( atomic_compare_exchange_u64 ( &( *stack ).head , &head , desired
+                                         , ATOMIC_ACQUIRE , ATOMIC_RELAXED
+                                         ))
+        {
+            return ( atomic_stack_node_t* )( head & ATOMIC_STACK_POINTER_MASK );
+        }
+    }
+    return 0;
+}
+
+#endif  // LIST_H
@@ -0,0 +1,327 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/mpmc_queue.c
+ * @brief Implementation of the container/mpmc_queue header.
+ * (see container/mpmc_queue.h for additional details)
+ */
+#include "container/mpmc_queue.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+/**
+ * @brief Type definition for a queue cell. The element is stored directly
+ * after the cell header.
+ */
+typedef struct
+{
+    u64 sequence;
+}
+cell_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    // Read-only after initialization.
+    u64     stride;
+    u64     capacity;
+    u64     cell_size;
+    u64     memory_requirement;
+    bool    owns_memory;
+    void*   content;
+    u8      padding0[ CACHE_LINE_SIZE - 5 * sizeof ( u64 ) - sizeof ( void* ) ];
+
+    // Next position to push to; shared by all producers.
+    u64     tail;
+    u8      padding1[ CACHE_LINE_SIZE - sizeof ( u64 ) ];
+
+    // Next position to pop from; shared by all consumers.
+    u64     head;
+    u8      padding2[ CACHE_LINE_SIZE - sizeof ( u64 ) ];
+}
+state_t;
+
+/**
+ * @brief Retrieves a queue cell.
+ * 
+ * @param state Internal state arguments.
+ * @param position A queue position (reduced modulo the capacity).
+ * @return The cell for position.
+ */
+cell_t*
+mpmc_queue_cell
+(   state_t*    state
+,   const u64   position
+);
+
+bool
+mpmc_queue_create
+(   u64             stride
+,   u64             capacity
+,   u64*            memory_requirement_
+,   void*           memory_
+,   mpmc_queue_t**  queue
+)
+{
+    if ( !stride || !capacity )
+    {
+        if ( !stride )
+        {
+            LOGERROR ( "mpmc_queue_create: Value of stride argument must be non-zero." );
+        }
+        if ( !capacity )
+        {
+            LOGERROR ( "mpmc_queue_create: Value of capacity argument must be non-zero." );
+        }
+        return false;
+    }
+
+    // Round capacity up to a power of two (at least 2), so positions can be
+    // reduced with a mask, and so the sequence numbers of a full and an empty
+    // cell are always distinguishable.
+    if ( capacity < 2 )
+    {
+        capacity = 2;
+    }
+    else if ( capacity & ( capacity - 1 ) )
+    {
+        capacity = ( ( u64 ) 1 ) << ( bitscan_reverse ( capacity ) + 1 );
+    }
+
+    const u64 cell_size = aligned ( sizeof ( cell_t ) + stride , sizeof ( cell_t ) );
+    const u64 memory_requirement = sizeof ( state_t ) + capacity * cell_size;
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_aligned_uninit ( memory_requirement
+                                                , CACHE_LINE_SIZE
+                                                , MEMORY_TAG_QUEUE
+                                                );
+    }
+
+    if ( !queue )
+    {
+        LOGERROR ( "mpmc_queue_create: Missing argument: queue (output buffer)." );
+        if ( !memory_ )
+        {
+            memory_free_aligned ( memory
+                                , memory_requirement
+                                , CACHE_LINE_SIZE
+                                , MEMORY_TAG_QUEUE
+                                );
+        }
+        return false;
+    }
+
+    memory_clear ( memory , memory_requirement );
+
+    state_t* state = memory;
+    ( *state ).stride = stride;
+    ( *state ).capacity = capacity;
+    ( *state ).cell_size = cell_size;
+    ( *state ).memory_requirement = memory_requirement;
+    ( *state ).owns_memory = !memory_;
+    ( *state ).content = ( void* )( ( ( u64 ) memory ) + sizeof ( state_t ) );
+
+    // Cell i is initially ready to be written at position i.
+    for ( u64 i = 0; i < capacity; ++i )
+    {
+        ( *mpmc_queue_cell ( state , i ) ).sequence = i;
+    }
+
+    *queue = state;
+    return true;
+}
+
+void
+mpmc_queue_destroy
+(   mpmc_queue_t** queue
+)
+{
+    if ( !queue )
+    {
+        return;
+    }
+
+    state_t* state = *queue;
+    if ( !state )
+    {
+        return;
+    }
+
+    const u64 memory_requirement = ( *state ).memory_requirement;
+    if ( ( *state ).owns_memory )
+    {
+        memory_free_aligned ( state
+                            , memory_requirement
+                            , CACHE_LINE_SIZE
+                            , MEMORY_TAG_QUEUE
+                            );
+    }
+    else
+    {
+        memory_clear ( state , memory_requirement );
+    }
+
+    *queue = 0;
+}
+
+u64
+mpmc_queue_capacity
+(   const mpmc_queue_t* queue
+)
+{
+    return ( *( ( state_t* ) queue ) ).capacity;
+}
+
+u64
+mpmc_queue_stride
+(   const mpmc_queue_t* queue
+)
+{
+    return ( *( ( state_t* ) queue ) ).stride;
+}
+
+u64
+mpmc_queue_length
+(   const mpmc_queue_t* queue
+)
+{
+    state_t* state = ( state_t* ) queue;
+    const u64 head = atomic_load_u64 ( &( *state ).head , ATOMIC_ACQUIRE );
+    const u64 tail = atomic_load_u64 ( &( *state ).tail , ATOMIC_ACQUIRE );
+    return ( tail > head ) ? tail - head : 0;
+}
+
+bool
+mpmc_queue_push
+(   mpmc_queue_t*   queue
+,   const void*     src
+)
+{
+    state_t* state = queue;
+    cell_t* cell;
+    u64 position = atomic_load_u64 ( &( *state ).tail , ATOMIC_RELAXED );
+    for (;;)
+    {
+        cell = mpmc_queue_cell ( state , position );
+        const i64 difference = ( i64 )( atomic_load_u64 ( &( *cell ).sequence , ATOMIC_ACQUIRE ) )
+                             - ( i64 ) position
+                             ;
+
+        // Cell is free at this position? Try to claim it.
+        if ( !difference )
+        {
+            if ( atomic_compare_exchange_u64 ( &( *state ).tail
+                                             , &position
+                                             , position + 1
+                                             , ATOMIC_RELAXED
+                                             , ATOMIC_RELAXED
+                                             ) )
+            {
+                break;
+            }
+        }
+
+        // Cell still holds the element from one lap ago: queue is full.
+        else if ( difference < 0 )
+        {
+            return false;
+        }
+
+        // Another producer claimed the position first.
+        else
+        {
+            position = atomic_load_u64 ( &( *state ).tail , ATOMIC_RELAXED );
+        }
+    }
+
+    memory_copy ( ( void* )( ( ( u64 ) cell ) + sizeof ( cell_t ) )
+                , src
+                , ( *state ).stride
+                );
+
+    // Publish the element to the consumers.
+    atomic_store_u64 ( &( *cell ).sequence , position + 1 , ATOMIC_RELEASE );
+    return true;
+}
+
+bool
+mpmc_queue_pop
+(   mpmc_queue_t*   queue
+,   void*           dst
+)
+{
+    state_t* state = queue;
+    cell_t* cell;
+    u64 position = atomic_load_u64 ( &( *state ).head , ATOMIC_RELAXED );
+    for (;;)
+    {
+        cell = mpmc_queue_cell ( state , position );
+        const i64 difference = ( i64 )( atomic_load_u64 ( &( *cell ).sequence , ATOMIC_ACQUIRE ) )
+                             - ( i64 )( position + 1 )
+                             ;
+
+        // Cell holds a published element at this position? Try to claim it.
+        if ( !difference )
+        {
+            if ( atomic_compare_exchange_u64 ( &( *state ).head
+                                             , &position
+                                             , position + 1
+                                             , ATOMIC_RELAXED
+                                             , ATOMIC_RELAXED
+                                             ) )
+            {
+                break;
+            }
+        }
+
+        // Cell has not been written for this position yet: queue is empty.
+        else if ( difference < 0 )
+        {
+            return false;
+        }
+
+        // Another consumer claimed the position first.
+        else
+        {
+            position = atomic_load_u64 ( &( *state ).head , ATOMIC_RELAXED );
+        }
+    }
+
+    if ( dst )
+    {
+        memory_copy ( dst
+                    , ( void* )( ( ( u64 ) cell ) + sizeof ( cell_t ) )
+                    , ( *state ).stride
+                    );
+    }
+
+    // Release the cell to the producers for the next lap.
+    atomic_store_u64 ( &( *cell ).sequence , position + ( *state ).capacity , ATOMIC_RELEASE );
+    return true;
+}
+
+cell_t*
+mpmc_queue_cell
+(   state_t*    state
+,   const u64   position
+)
+{
+    return ( void* )( ( ( u64 )( ( *state ).content ) )
+                    + ( position & ( ( *state ).capacity - 1 ) ) * ( *state ).cell_size
+                    );
+}
@@ -0,0 +1,134 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/mpmc_queue.h
+ * @brief Provides an interface for a bounded, lock-free, multi-producer
+ * multi-consumer FIFO queue.
+ */
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include "common.h"
+
+/** @brief Type declaration for a multi-producer multi-consumer queue. */
+typedef void mpmc_queue_t;
+
+/**
+ * @brief Initializes a multi-producer multi-consumer queue.
+ * 
+ * Any number of threads may push to and pop from the queue concurrently,
+ * without locking. Based on Dmitry Vyukov's bounded MPMC queue: every cell
+ * carries a sequence number which tells producers and consumers whether it is
+ * ready to be written or read, so each operation costs a single
+ * compare-and-swap on an uncontended queue. The producer and consumer indices
+ * are kept on separate cache lines.
+ * 
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size. The buffer should be aligned to
+ *   a cache line (64 bytes) to avoid false sharing.
+ * 
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h). Call
+ *   mpmc_queue_destroy to free.
+ * 
+ * @param stride The fixed element size in bytes. Must be non-zero.
+ * @param capacity The minimum number of elements the queue must be able to
+ * hold. Rounded up to the nearest power of two (minimum 2). Cannot be resized.
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required to operate the queue. Only applicable if pre-allocating a memory
+ * buffer of the required size. Pass 0 to use implicit memory allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @param queue Output buffer for queue.
+ * @return true on success; false otherwise.
+ */
+bool
+mpmc_queue_create
+(   u64             stride
+,   u64             capacity
+,   u64*            memory_requirement
+,   void*           memory
+,   mpmc_queue_t**  queue
+);
+
+/**
+ * @brief Frees the memory used by a multi-producer multi-consumer queue.
+ * 
+ * If the queue was not pre-allocated, this function will free the memory
+ * implicitly (see core/memory.h). Must not be called while any other thread
+ * is accessing the queue.
+ * 
+ * @param queue Handle to the queue to free.
+ */
+void
+mpmc_queue_destroy
+(   mpmc_queue_t** queue
+);
+
+/**
+ * @brief Queries the capacity of a multi-producer multi-consumer queue.
+ * 
+ * @param queue The queue to query. Must be non-zero.
+ * @return The maximum number of elements the queue may hold.
+ */
+u64
+mpmc_queue_capacity
+(   const mpmc_queue_t* queue
+);
+
+/**
+ * @brief Queries the element size of a multi-producer multi-consumer queue.
+ * 
+ * @param queue The queue to query. Must be non-zero.
+ * @return The size of each element in bytes.
+ */
+u64
+mpmc_queue_stride
+(   const mpmc_queue_t* queue
+);
+
+/**
+ * @brief Queries the number of elements in a multi-producer multi-consumer
+ * queue.
+ * 
+ * If the queue is accessed concurrently, the result is only an estimate, and
+ * may already be out of date.
+ * 
+ * @param queue The queue to query. Must be non-zero.
+ * @return The number of elements in the queue.
+ */
+u64
+mpmc_queue_length
+(   const mpmc_queue_t* queue
+);
+
+/**
+ * @brief Appends an element to a multi-producer multi-consumer queue. O(1).
+ * Lock-free. Thread-safe.
+ * 
+ * @param queue The queue to append to. Must be non-zero.
+ * @param src The element to append. Must be non-zero.
+ * @return true on success; false if the queue is full.
+ */
+bool
+mpmc_queue_push
+(   mpmc_queue_t*   queue
+,   const void*     src
+);
+
+/**
+ * @brief Removes the head of a multi-producer multi-consumer queue. O(1).
+ * Lock-free. Thread-safe.
+ * 
+ * @param queue The queue to remove from. Must be non-zero.
+ * @param dst Optional output buffer for the head, if present.
+ * @return true on success; false if the queue is empty.
+ */
+bool
+mpmc_queue_pop
+(   mpmc_queue_t*   queue
+,   void*           dst
+);
+
+#endif  // MPMC_QUEUE_H
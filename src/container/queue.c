@@ -9,6 +9,8 @@
 #include "core/logger.h"
 #include "core/memory.h"
 
+#include "math/math.h"
+
 /**
  * @brief Sets the value of a resizable queue field. O(1).
  * 
@@ -25,7 +27,10 @@ _queue_field_set
 
 /**
  * @brief Ensures that an existing queue has a capacity greater than or equal to
- * some minimum number of elements. The queue is resized, if needed.
+ * some minimum number of elements. If it does not, the queue is resized to
+ * QUEUE_SCALE_FACTOR ( minimum_capacity ) elements (in place, where possible).
+ * If the content wraps around the end of the old buffer, the part before the
+ * wrap is moved to the end of the new buffer.
  * 
  * @param queue The queue to resize. Must be non-zero.
  * @param minimum_capacity The minimum number of elements the new queue is
@@ -62,11 +67,11 @@ _queue_create
     const u64 size = header_size + content_size;
 
     u64* queue = memory_allocate ( size , MEMORY_TAG_QUEUE );
-    memory_clear ( queue , size );
 
     queue[ QUEUE_FIELD_ALLOCATED ] = content_size;
     queue[ QUEUE_FIELD_LENGTH ]    = 0;
     queue[ QUEUE_FIELD_STRIDE ]    = stride;
+    queue[ QUEUE_FIELD_HEAD ]      = 0;
     
     return queue + QUEUE_FIELD_COUNT;
 }
@@ -118,21 +123,68 @@ _queue_size
     return header_size + content_size;
 }
 
+void*
+_queue_element
+(   const queue_t*  queue
+,   u64             index
+)
+{
+    const u64 allocated = queue_allocated ( queue );
+    u64 offset = ( queue_head ( queue ) + index ) * queue_stride ( queue );
+    if ( offset >= allocated )
+    {
+        offset -= allocated;
+    }
+    return ( void* )( ( ( u64 ) queue ) + offset );
+}
+
 queue_t*
 _queue_push
 (   queue_t*    queue
 ,   const void* src
 )
 {
-    const u64 stride = queue_stride ( queue );
+    return _queue_push_n ( queue , src , 1 );
+}
+
+queue_t*
+_queue_push_n
+(   queue_t*    queue
+,   const void* src
+,   u64         count
+)
+{
+    if ( !count )
+    {
+        return queue;
+    }
+
     const u64 old_length = queue_length ( queue );
-    const u64 new_length = old_length + 1;
-    queue = queue_resize_if_needed ( queue , new_length );
-    memory_copy ( ( void* )( ( ( u64 ) queue ) + old_length * stride )
+    queue = queue_resize_if_needed ( queue , old_length + count );
+
+    // Copy in at the tail, wrapping around the end of the buffer if needed.
+    const u64 stride = queue_stride ( queue );
+    const u64 allocated = queue_allocated ( queue );
+    const u64 size = count * stride;
+    u64 offset = ( queue_head ( queue ) + old_length ) * stride;
+    if ( offset >= allocated )
+    {
+        offset -= allocated;
+    }
+    const u64 size_before_wrap = MIN ( size , allocated - offset );
+    memory_copy ( ( void* )( ( ( u64 ) queue ) + offset )
                 , src
-                , stride
+                , size_before_wrap
                 );
-    _queue_field_set ( queue , QUEUE_FIELD_LENGTH , new_length );
+    if ( size_before_wrap < size )
+    {
+        memory_copy ( queue
+                    , ( void* )( ( ( u64 ) src ) + size_before_wrap )
+                    , size - size_before_wrap
+                    );
+    }
+
+    _queue_field_set ( queue , QUEUE_FIELD_LENGTH , old_length + count );
     return queue;
 }
 
@@ -147,7 +199,7 @@ _queue_peek
         LOGWARN ( "_queue_peek: Queue is empty." );
         return false;
     }
-    memory_copy ( dst , queue , queue_stride ( queue ) );
+    memory_copy ( dst , _queue_element ( queue , 0 ) , queue_stride ( queue ) );
     return true;
 }
 
@@ -157,25 +209,73 @@ _queue_pop
 ,   void*       dst
 )
 {
-    const u64 stride = queue_stride ( queue );
-    const u64 old_length = queue_length ( queue );
-    const u64 new_length = old_length - 1;
-
-    if ( !old_length )
+    if ( !queue_length ( queue ) )
     {
         LOGWARN ( "_queue_pop: Queue is empty." );
         return false;
     }
+    return _queue_pop_n ( queue , dst , 1 );
+}
+
+bool
+_queue_pop_n
+(   queue_t*    queue
+,   void*       dst
+,   u64         count
+)
+{
+    const u64 old_length = queue_length ( queue );
+    if ( old_length < count )
+    {
+        LOGWARN ( "_queue_pop_n: Queue holds fewer than the requested number of elements (requested: %u, length: %u)."
+                , count , old_length
+                );
+        return false;
+    }
+
+    const u64 stride = queue_stride ( queue );
+    const u64 allocated = queue_allocated ( queue );
+    const u64 size = count * stride;
+    const u64 offset = queue_head ( queue ) * stride;
+    const u64 size_before_wrap = MIN ( size , allocated - offset );
 
+    // Copy out from the head, wrapping around the end of the buffer if needed.
     if ( dst )
     {
-        memory_copy ( dst , queue , stride );
+        memory_copy ( dst
+                    , ( void* )( ( ( u64 ) queue ) + offset )
+                    , size_before_wrap
+                    );
+        if ( size_before_wrap < size )
+        {
+            memory_copy ( ( void* )( ( ( u64 ) dst ) + size_before_wrap )
+                        , queue
+                        , size - size_before_wrap
+                        );
+        }
     }
-    memory_copy ( queue
-                , ( void* )( ( ( u64 ) queue ) + stride )
-                , old_length * stride
-                );
-    _queue_field_set ( queue , QUEUE_FIELD_LENGTH , new_length );
+
+    // Advance the head. Reset it once the queue is empty, so that subsequent
+    // pushes are less likely to wrap around.
+    u64 head;
+    if ( old_length == count )
+    {
+        head = 0;
+    }
+    else if ( size_before_wrap < size )
+    {
+        head = ( size - size_before_wrap ) / stride;
+    }
+    else
+    {
+        head = queue_head ( queue ) + count;
+        if ( head * stride == allocated )
+        {
+            head = 0;
+        }
+    }
+    _queue_field_set ( queue , QUEUE_FIELD_HEAD , head );
+    _queue_field_set ( queue , QUEUE_FIELD_LENGTH , old_length - count );
     return true;
 }
 
@@ -194,12 +294,31 @@ queue_resize_if_needed
         return old_queue;
     }
 
-    queue_t* new_queue = _queue_create ( minimum_capacity , stride );
-    memory_copy ( new_queue , old_queue , old_size );
-    _queue_field_set ( new_queue
-                     , QUEUE_FIELD_LENGTH
-                     , queue_length ( old_queue )
-                     );
-    _queue_destroy ( old_queue );
-    return new_queue;
-}
\ No newline at end of file
+    const u64 header_size = QUEUE_FIELD_COUNT * sizeof ( u64 );
+    const u64 new_allocated = QUEUE_SCALE_FACTOR ( minimum_capacity ) * stride;
+    u64* queue = memory_reallocate ( ( ( u64* ) old_queue ) - QUEUE_FIELD_COUNT
+                                   , header_size + old_size
+                                   , header_size + new_allocated
+                                   , MEMORY_TAG_QUEUE
+                                   );
+    queue[ QUEUE_FIELD_ALLOCATED ] = new_allocated;
+    queue += QUEUE_FIELD_COUNT;
+
+    // If the content wraps, move the part before the wrap to the end of the
+    // new buffer, so that the content is contiguous modulo the new capacity.
+    const u64 size = queue_length ( queue ) * stride;
+    const u64 offset = queue_head ( queue ) * stride;
+    if ( offset + size > old_size )
+    {
+        const u64 size_before_wrap = old_size - offset;
+        memory_move ( ( void* )( ( ( u64 ) queue ) + new_allocated - size_before_wrap )
+                    , ( void* )( ( ( u64 ) queue ) + offset )
+                    , size_before_wrap
+                    );
+        _queue_field_set ( queue
+                         , QUEUE_FIELD_HEAD
+                         , ( new_allocated - size_before_wrap ) / stride
+                         );
+    }
+    return queue;
+}
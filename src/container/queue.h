@@ -8,7 +8,13 @@
 
 #include "common.h"
 
-/** @brief Type declaration for a queue. */
+/**
+ * @brief Type declaration for a queue.
+ * 
+ * A queue is a circular buffer: elements are stored in order starting at the
+ * head index, and wrap around to the start of the buffer. Use queue_element
+ * to address an element, rather than indexing into the queue directly.
+ */
 typedef void queue_t;
 
 /** @brief Type and instance definitions for queue fields. */
@@ -17,6 +23,7 @@ typedef enum
     QUEUE_FIELD_ALLOCATED
 ,   QUEUE_FIELD_LENGTH
 ,   QUEUE_FIELD_STRIDE
+,   QUEUE_FIELD_HEAD
 
 ,   QUEUE_FIELD_COUNT
 }
@@ -25,6 +32,10 @@ QUEUE_FIELD;
 /** @brief Queue default capacity. */
 #define QUEUE_DEFAULT_CAPACITY 1
 
+/** @brief Queue rescale factor. */
+#define QUEUE_SCALE_FACTOR(capacity) \
+    ( ( 3 * (capacity) ) >> 1 )
+
 /**
  * @brief Allocates memory for a queue.
  * 
@@ -85,6 +96,10 @@ _queue_field_get
 #define queue_stride(queue) \
     _queue_field_get ( (queue) , QUEUE_FIELD_STRIDE )
 
+/** @brief Get queue field: head. */
+#define queue_head(queue) \
+    _queue_field_get ( (queue) , QUEUE_FIELD_HEAD )
+
 /**
  * @brief Computes the size in bytes of a queue data structure. O(1).
  * 
@@ -99,6 +114,23 @@ _queue_size
 #define queue_size(queue) \
     _queue_size ( queue )
 
+/**
+ * @brief Computes the address of a queue element. O(1).
+ * 
+ * @param queue The queue to query. Must be non-zero.
+ * @param index The position of the element, counting from the head of the
+ * queue. Must be less than the queue length.
+ * @return The address of the element.
+ */
+void*
+_queue_element
+(   const queue_t*  queue
+,   u64             index
+);
+
+#define queue_element(queue,index) \
+    _queue_element ( (queue) , (index) )
+
 /**
  * @brief Appends an element to a queue. O(1), on average.
  *
@@ -115,6 +147,25 @@ _queue_push
 #define queue_push(queue,src) \
     ( (queue) = _queue_push ( (queue) , (src) ) )
 
+/**
+ * @brief Appends multiple elements to a queue. O(count), on average.
+ *
+ * @param queue The queue to append to. Must be non-zero.
+ * @param src The elements to append, contiguous in memory. Must be non-zero
+ * if count is non-zero.
+ * @param count The number of elements to append.
+ * @return The queue (possibly with new address).
+ */
+queue_t*
+_queue_push_n
+(   queue_t*    queue
+,   const void* src
+,   u64         count
+);
+
+#define queue_push_n(queue,src,count) \
+    ( (queue) = _queue_push_n ( (queue) , (src) , (count) ) )
+
 /**
  * @brief Retrieves the head of the queue. O(1).
  *
@@ -132,7 +183,7 @@ _queue_peek
     _queue_peek ( (queue) , (dst) )
 
 /**
- * @brief Removes the head of the queue. O(n).
+ * @brief Removes the head of the queue. O(1).
  *
  * @param queue The queue to remove from. Must be non-zero.
  * @param dst Optional output buffer for the head, if present.
@@ -147,4 +198,160 @@ _queue_pop
 #define queue_pop(queue,dst) \
     _queue_pop ( (queue) , (dst) )
 
+/**
+ * @brief Removes multiple elements from the head of the queue. O(count).
+ *
+ * Fails without removing anything if the queue holds fewer than count
+ * elements.
+ *
+ * @param queue The queue to remove from. Must be non-zero.
+ * @param dst Optional output buffer for the removed elements, in order. Must
+ * be large enough to hold count elements.
+ * @param count The number of elements to remove.
+ * @return true on success; false if the queue holds fewer than count elements.
+ */
+bool
+_queue_pop_n
+(   queue_t*    queue
+,   void*       dst
+,   u64         count
+);
+
+#define queue_pop_n(queue,dst,count) \
+    _queue_pop_n ( (queue) , (dst) , (count) )
+
+/**
+ * @brief Defines inline functions for a queue of a specific element type (a
+ * typed queue), e.g. QUEUE_DEFINE ( job_t ) at file scope.
+ *
+ * The typed functions know the element size at compile time, and copy elements
+ * by assignment rather than with memory_copy, so that they may be inlined into
+ * the loops that call them. A typed queue has the same header layout as any
+ * other queue, so it may be passed to the generic functions as well (e.g.
+ * queue_destroy, queue_push_n); only growth and errors are handled out of
+ * line, by the generic functions.
+ *
+ * QUEUE_DEFINE ( job_t ) defines:
+ *
+ *   job_t* queue_job_t_create ( void );
+ *   u64    queue_job_t_length ( const job_t* queue );
+ *   job_t* queue_job_t_element ( job_t* queue , u64 index );
+ *   job_t* queue_job_t_push ( job_t* queue , job_t value );
+ *   bool   queue_job_t_peek ( const job_t* queue , job_t* dst );
+ *   bool   queue_job_t_pop ( job_t* queue , job_t* dst );
+ *
+ * As with the generic functions, push returns the queue (possibly with new
+ * address), and pop accepts 0 for dst.
+ *
+ * @param type C data type of the elements. Must be a single identifier; use
+ * QUEUE_DEFINE_NAMED for any other type (e.g. a pointer type).
+ */
+#define QUEUE_DEFINE(type) \
+    QUEUE_DEFINE_NAMED ( type , type )
+
+/**
+ * @brief Variant of QUEUE_DEFINE which specifies the infix of the function
+ * names separately from the element type.
+ *
+ * @param name Infix of the function names (queue_<name>_push, etc.).
+ * @param type C data type of the elements.
+ */
+#define QUEUE_DEFINE_NAMED(name,type)                                           \
+    INLINE type*                                                                \
+    queue_##name##_create                                                       \
+    ( void )                                                                    \
+    {                                                                           \
+        return _queue_create ( QUEUE_DEFAULT_CAPACITY , sizeof ( type ) );      \
+    }                                                                           \
+                                                                                \
+    INLINE u64                                                                  \
+    queue_##name##_length                                                       \
+    (   const type* queue                                                       \
+    )                                                                           \
+    {                                                                           \
+        return ( ( const u64* ) queue )[ QUEUE_FIELD_LENGTH                     \
+                                       - QUEUE_FIELD_COUNT                      \
+                                       ];                                       \
+    }                                                                           \
+                                                                                \
+    INLINE type*                                                                \
+    queue_##name##_element                                                      \
+    (   type*       queue                                                       \
+    ,   const u64   index                                                       \
+    )                                                                           \
+    {                                                                           \
+        const u64* header = ( ( u64* ) queue ) - QUEUE_FIELD_COUNT;             \
+        const u64 capacity = header[ QUEUE_FIELD_ALLOCATED ] / sizeof ( type ); \
+        u64 i = header[ QUEUE_FIELD_HEAD ] + index;                             \
+        if ( i >= capacity )                                                    \
+        {                                                                       \
+            i -= capacity;                                                      \
+        }                                                                       \
+        return &queue[ i ];                                                     \
+    }                                                                           \
+                                                                                \
+    INLINE type*                                                                \
+    queue_##name##_push                                                         \
+    (   type*       queue                                                       \
+    ,   const type  value                                                       \
+    )                                                                           \
+    {                                                                           \
+        u64* header = ( ( u64* ) queue ) - QUEUE_FIELD_COUNT;                   \
+        const u64 capacity = header[ QUEUE_FIELD_ALLOCATED ] / sizeof ( type ); \
+        const u64 length = header[ QUEUE_FIELD_LENGTH ];                        \
+        if ( length >= capacity )                                               \
+        {                                                                       \
+            return _queue_push ( queue , &value );                              \
+        }                                                                       \
+        u64 i = header[ QUEUE_FIELD_HEAD ] + length;                            \
+        if ( i >= capacity )                                                    \
+        {                                                                       \
+            i -= capacity;                                                      \
+        }                                                                       \
+        queue[ i ] = value;                                                     \
+        header[ QUEUE_FIELD_LENGTH ] = length + 1;                              \
+        return queue;                                                           \
+    }                                                                           \
+                                                                                \
+    INLINE bool                                                                 \
+    queue_##name##_peek                                                         \
+    (   const type* queue                                                       \
+    ,   type*       dst                                                         \
+    )                                                                           \
+    {                                                                           \
+        const u64* header = ( ( const u64* ) queue ) - QUEUE_FIELD_COUNT;       \
+        if ( !header[ QUEUE_FIELD_LENGTH ] )                                    \
+        {                                                                       \
+            return _queue_peek ( queue , dst );                                 \
+        }                                                                       \
+        *dst = queue[ header[ QUEUE_FIELD_HEAD ] ];                             \
+        return true;                                                            \
+    }                                                                           \
+                                                                                \
+    INLINE bool                                                                 \
+    queue_##name##_pop                                                          \
+    (   type*   queue                                                           \
+    ,   type*   dst                                                             \
+    )                                                                           \
+    {                                                                           \
+        u64* header = ( ( u64* ) queue ) - QUEUE_FIELD_COUNT;                   \
+        const u64 length = header[ QUEUE_FIELD_LENGTH ];                        \
+        if ( !length )                                                          \
+        {                                                                       \
+            return _queue_pop ( queue , dst );                                  \
+        }                                                                       \
+        const u64 capacity = header[ QUEUE_FIELD_ALLOCATED ] / sizeof ( type ); \
+        const u64 head = header[ QUEUE_FIELD_HEAD ];                            \
+        if ( dst )                                                              \
+        {                                                                       \
+            *dst = queue[ head ];                                               \
+        }                                                                       \
+        header[ QUEUE_FIELD_HEAD ] = ( length == 1 || head + 1 == capacity )    \
+                                   ? 0                                          \
+                                   : head + 1                                   \
+                                   ;                                            \
+        header[ QUEUE_FIELD_LENGTH ] = length - 1;                              \
+        return true;                                                            \
+    }
+
 #endif  // QUEUE_H
\ No newline at end of file
@@ -0,0 +1,535 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/soa.c
+ * @brief Implementation of the container/soa header.
+ * (see container/soa.h for additional details)
+ */
+#include "container/soa.h"
+
+#include "container/array.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+/** @brief The size of each radix sort key type (in bytes). */
+static const u8 soa_sort_key_size[ SORT_KEY_COUNT ] = { 1 , 2 , 4 , 8   // SORT_KEY_U*
+                                                      , 1 , 2 , 4 , 8   // SORT_KEY_I*
+                                                      , 4 , 8           // SORT_KEY_F*
+                                                      };
+
+/** @brief Type definition for a column. */
+typedef struct
+{
+    u64     stride;
+    u8*     data;
+}
+column_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64         length;
+    u64         capacity;
+    u64         column_count;
+
+    // Every column, in one SOA_ALIGNMENT-aligned block.
+    void*       memory;
+    u64         memory_size;
+
+    column_t    columns[];
+}
+state_t;
+
+/**
+ * @brief Computes the size of the block which holds every column of a
+ * structure-of-arrays (in bytes). Each column occupies a whole number of
+ * SOA_ALIGNMENT-byte lines, and is preceded by one line which holds its array
+ * header.
+ *
+ * @param state Internal state.
+ * @param capacity The capacity of each column (in elements).
+ * @return The block size (in bytes).
+ */
+u64
+_soa_memory_size
+(   const state_t*  state
+,   const u64       capacity
+);
+
+/**
+ * @brief Moves every column of a structure-of-arrays to a new block of a
+ * specified capacity. O(n).
+ *
+ * @param state Internal state.
+ * @param capacity The new capacity (in records). Must be at least the length.
+ */
+void
+_soa_resize
+(   state_t*    state
+,   const u64   capacity
+);
+
+/**
+ * @brief Updates the array header of every column to match the length and
+ * capacity of the structure-of-arrays.
+ *
+ * @param state Internal state.
+ */
+void
+_soa_update_headers
+(   state_t* state
+);
+
+/**
+ * @brief Sorts the records of a structure-of-arrays by one column: sorts a
+ * copy of the key column in which each element is followed by its record
+ * index, then applies the resulting permutation to every column.
+ *
+ * @param state Internal state.
+ * @param column The index of the key column.
+ * @param comparator A function which compares two elements of the key column,
+ * or 0 to sort by radix instead.
+ * @param key The type of the key (for a radix sort).
+ */
+void
+_soa_sort
+(   state_t*                state
+,   const u64               column
+,   comparator_function_t   comparator
+,   const SORT_KEY          key
+);
+
+soa_t*
+_soa_create
+(   const u64*  strides
+,   u64         column_count
+,   u64         initial_capacity
+)
+{
+    if ( !strides || !column_count || !initial_capacity )
+    {
+        if ( !strides )
+        {
+            LOGERROR ( "_soa_create: Missing argument: strides." );
+        }
+        if ( !column_count )
+        {
+            LOGERROR ( "_soa_create: Value of column_count argument must be non-zero." );
+        }
+        if ( !initial_capacity )
+        {
+            LOGERROR ( "_soa_create: Value of initial_capacity argument must be non-zero." );
+        }
+        return 0;
+    }
+    for ( u64 i = 0; i < column_count; ++i )
+    {
+        if ( !strides[ i ] )
+        {
+            LOGERROR ( "_soa_create: Stride of column %u must be non-zero." , i );
+            return 0;
+        }
+    }
+
+    const u64 state_size = sizeof ( state_t ) + column_count * sizeof ( column_t );
+    state_t* state = memory_allocate ( state_size , MEMORY_TAG_ARRAY );
+    ( *state ).column_count = column_count;
+    for ( u64 i = 0; i < column_count; ++i )
+    {
+        ( *state ).columns[ i ].stride = strides[ i ];
+    }
+    _soa_resize ( state , initial_capacity );
+    return state;
+}
+
+void
+soa_destroy
+(   soa_t* soa
+)
+{
+    if ( !soa )
+    {
+        return;
+    }
+    state_t* state = soa;
+    memory_free_aligned ( ( *state ).memory
+                        , ( *state ).memory_size
+                        , SOA_ALIGNMENT
+                        , MEMORY_TAG_ARRAY
+                        );
+    memory_free ( state
+                , sizeof ( state_t ) + ( *state ).column_count * sizeof ( column_t )
+                , MEMORY_TAG_ARRAY
+                );
+}
+
+u64
+soa_length
+(   const soa_t* soa
+)
+{
+    return ( *( ( const state_t* ) soa ) ).length;
+}
+
+u64
+soa_capacity
+(   const soa_t* soa
+)
+{
+    return ( *( ( const state_t* ) soa ) ).capacity;
+}
+
+u64
+soa_column_count
+(   const soa_t* soa
+)
+{
+    return ( *( ( const state_t* ) soa ) ).column_count;
+}
+
+void*
+soa_column
+(   const soa_t*    soa
+,   u64             column
+)
+{
+    const state_t* state = soa;
+    if ( column >= ( *state ).column_count )
+    {
+        LOGERROR ( "soa_column: Called with out of bounds column: %u (column) >= %u (column count)."
+                 , column , ( *state ).column_count
+                 );
+        return 0;
+    }
+    return ( *state ).columns[ column ].data;
+}
+
+void
+soa_reserve
+(   soa_t*  soa
+,   u64     capacity
+)
+{
+    state_t* state = soa;
+    if ( capacity > ( *state ).capacity )
+    {
+        _soa_resize ( state , capacity );
+    }
+}
+
+bool
+_soa_push
+(   soa_t*              soa
+,   const void* const*  src
+,   u64                 count
+)
+{
+    state_t* state = soa;
+    if ( count != ( *state ).column_count )
+    {
+        LOGERROR ( "_soa_push: Record has %u fields, but the structure-of-arrays has %u columns."
+                 , count , ( *state ).column_count
+                 );
+        return false;
+    }
+
+    const u64 length = ( *state ).length;
+    if ( length >= ( *state ).capacity )
+    {
+        _soa_resize ( state , SOA_SCALE_FACTOR ( length + 1 ) );
+    }
+
+    for ( u64 i = 0; i < count; ++i )
+    {
+        const column_t* column = &( *state ).columns[ i ];
+        memory_copy ( ( *column ).data + length * ( *column ).stride
+                    , src[ i ]
+                    , ( *column ).stride
+                    );
+    }
+    ( *state ).length = length + 1;
+    _soa_update_headers ( state );
+    return true;
+}
+
+bool
+_soa_pop
+(   soa_t*          soa
+,   void* const*    dst
+,   u64             count
+)
+{
+    state_t* state = soa;
+    if ( !( *state ).length )
+    {
+        LOGWARN ( "_soa_pop: Structure-of-arrays is empty." );
+        return false;
+    }
+
+    const u64 length = ( *state ).length - 1;
+    if ( dst )
+    {
+        count = MIN ( count , ( *state ).column_count );
+        for ( u64 i = 0; i < count; ++i )
+        {
+            if ( !dst[ i ] )
+            {
+                continue;
+            }
+            const column_t* column = &( *state ).columns[ i ];
+            memory_copy ( dst[ i ]
+                        , ( *column ).data + length * ( *column ).stride
+                        , ( *column ).stride
+                        );
+        }
+    }
+    ( *state ).length = length;
+    _soa_update_headers ( state );
+    return true;
+}
+
+bool
+_soa_remove_swap
+(   soa_t*          soa
+,   u64             index
+,   void* const*    dst
+,   u64             count
+)
+{
+    state_t* state = soa;
+    if ( index >= ( *state ).length )
+    {
+        LOGERROR ( "_soa_remove_swap: Called with out of bounds index: %u (index) >= %u (length)."
+                 , index , ( *state ).length
+                 );
+        return false;
+    }
+
+    const u64 last = ( *state ).length - 1;
+    count = dst ? MIN ( count , ( *state ).column_count ) : 0;
+    for ( u64 i = 0; i < ( *state ).column_count; ++i )
+    {
+        const column_t* column = &( *state ).columns[ i ];
+        const u64 stride = ( *column ).stride;
+        if ( i < count && dst[ i ] )
+        {
+            memory_copy ( dst[ i ] , ( *column ).data + index * stride , stride );
+        }
+        if ( index != last )
+        {
+            memory_copy ( ( *column ).data + index * stride
+                        , ( *column ).data + last * stride
+                        , stride
+                        );
+        }
+    }
+    ( *state ).length = last;
+    _soa_update_headers ( state );
+    return true;
+}
+
+void
+soa_permute
+(   soa_t*      soa
+,   const u64*  permutation
+)
+{
+    state_t* state = soa;
+    const u64 length = ( *state ).length;
+    if ( length < 2 )
+    {
+        return;
+    }
+
+    u64 max_stride = 0;
+    for ( u64 i = 0; i < ( *state ).column_count; ++i )
+    {
+        max_stride = MAX ( max_stride , ( *state ).columns[ i ].stride );
+    }
+
+    // Gather each column into scratch memory, then copy it back.
+    u8* scratch = memory_allocate_uninit ( length * max_stride , MEMORY_TAG_ARRAY );
+    for ( u64 i = 0; i < ( *state ).column_count; ++i )
+    {
+        const column_t* column = &( *state ).columns[ i ];
+        const u64 stride = ( *column ).stride;
+        for ( u64 j = 0; j < length; ++j )
+        {
+            memory_copy ( scratch + j * stride
+                        , ( *column ).data + permutation[ j ] * stride
+                        , stride
+                        );
+        }
+        memory_copy ( ( *column ).data , scratch , length * stride );
+    }
+    memory_free ( scratch , length * max_stride , MEMORY_TAG_ARRAY );
+}
+
+bool
+soa_sort
+(   soa_t*                  soa
+,   u64                     column
+,   comparator_function_t   comparator
+)
+{
+    state_t* state = soa;
+    if ( column >= ( *state ).column_count )
+    {
+        LOGERROR ( "soa_sort: Called with out of bounds column: %u (column) >= %u (column count)."
+                 , column , ( *state ).column_count
+                 );
+        return false;
+    }
+    _soa_sort ( state , column , comparator , SORT_KEY_COUNT );
+    return true;
+}
+
+bool
+soa_sort_radix
+(   soa_t*      soa
+,   u64         column
+,   SORT_KEY    key
+)
+{
+    state_t* state = soa;
+    if ( column >= ( *state ).column_count )
+    {
+        LOGERROR ( "soa_sort_radix: Called with out of bounds column: %u (column) >= %u (column count)."
+                 , column , ( *state ).column_count
+                 );
+        return false;
+    }
+    if ( key >= SORT_KEY_COUNT || soa_sort_key_size[ key ] != ( *state ).columns[ column ].stride )
+    {
+        LOGERROR ( "soa_sort_radix: Key type does not match the stride of column %u (%u bytes)."
+                 , column , ( *state ).columns[ column ].stride
+                 );
+        return false;
+    }
+    _soa_sort ( state , column , 0 , key );
+    return true;
+}
+
+u64
+_soa_memory_size
+(   const state_t*  state
+,   const u64       capacity
+)
+{
+    u64 size = 0;
+    for ( u64 i = 0; i < ( *state ).column_count; ++i )
+    {
+        const u64 column_size = capacity * ( *state ).columns[ i ].stride;
+        size += SOA_ALIGNMENT
+              + ( ( column_size + SOA_ALIGNMENT - 1 ) & ~( ( u64 ) SOA_ALIGNMENT - 1 ) )
+              ;
+    }
+    return size;
+}
+
+void
+_soa_resize
+(   state_t*    state
+,   const u64   capacity
+)
+{
+    const u64 memory_size = _soa_memory_size ( state , capacity );
+    u8* memory = memory_allocate_aligned_uninit ( memory_size
+                                                , SOA_ALIGNMENT
+                                                , MEMORY_TAG_ARRAY
+                                                );
+
+    u8* data = memory;
+    for ( u64 i = 0; i < ( *state ).column_count; ++i )
+    {
+        column_t* column = &( *state ).columns[ i ];
+        const u64 column_size = capacity * ( *column ).stride;
+        data += SOA_ALIGNMENT;
+        if ( ( *state ).length )
+        {
+            memory_copy ( data
+                        , ( *column ).data
+                        , ( *state ).length * ( *column ).stride
+                        );
+        }
+        ( *column ).data = data;
+        data += ( column_size + SOA_ALIGNMENT - 1 ) & ~( ( u64 ) SOA_ALIGNMENT - 1 );
+    }
+
+    if ( ( *state ).memory )
+    {
+        memory_free_aligned ( ( *state ).memory
+                            , ( *state ).memory_size
+                            , SOA_ALIGNMENT
+                            , MEMORY_TAG_ARRAY
+                            );
+    }
+    ( *state ).memory = memory;
+    ( *state ).memory_size = memory_size;
+    ( *state ).capacity = capacity;
+    _soa_update_headers ( state );
+}
+
+void
+_soa_update_headers
+(   state_t* state
+)
+{
+    for ( u64 i = 0; i < ( *state ).column_count; ++i )
+    {
+        const column_t* column = &( *state ).columns[ i ];
+        u64* header = ( ( u64* )( *column ).data ) - ARRAY_FIELD_COUNT;
+        header[ ARRAY_FIELD_CAPACITY ] = ( *state ).capacity;
+        header[ ARRAY_FIELD_LENGTH ]   = ( *state ).length;
+        header[ ARRAY_FIELD_STRIDE ]   = ( *column ).stride;
+    }
+}
+
+void
+_soa_sort
+(   state_t*                state
+,   const u64               column
+,   comparator_function_t   comparator
+,   const SORT_KEY          key
+)
+{
+    const u64 length = ( *state ).length;
+    if ( length < 2 )
+    {
+        return;
+    }
+
+    // Each record holds the key, then (8-byte aligned) its index.
+    const u64 key_stride = ( *state ).columns[ column ].stride;
+    const u64 index_offset = ( key_stride + sizeof ( u64 ) - 1 ) & ~( sizeof ( u64 ) - 1 );
+    const u64 record_stride = index_offset + sizeof ( u64 );
+    const u64 records_size = length * record_stride + length * sizeof ( u64 );
+    u8* records = memory_allocate_uninit ( records_size , MEMORY_TAG_ARRAY );
+    u64* permutation = ( u64* )( records + length * record_stride );
+
+    const u8* keys = ( *state ).columns[ column ].data;
+    for ( u64 i = 0; i < length; ++i )
+    {
+        u8* record = records + i * record_stride;
+        memory_copy ( record , keys + i * key_stride , key_stride );
+        *( ( u64* )( record + index_offset ) ) = i;
+    }
+
+    if ( comparator )
+    {
+        array_sort ( records , length , record_stride , comparator );
+    }
+    else
+    {
+        array_sort_radix ( records , length , record_stride , 0 , key );
+    }
+
+    for ( u64 i = 0; i < length; ++i )
+    {
+        permutation[ i ] = *( ( u64* )( records + i * record_stride + index_offset ) );
+    }
+    soa_permute ( state , permutation );
+    memory_free ( records , records_size , MEMORY_TAG_ARRAY );
+}
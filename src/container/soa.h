@@ -0,0 +1,291 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/soa.h
+ * @brief Provides an interface for a structure-of-arrays data structure.
+ *
+ * A structure-of-arrays stores a sequence of records column by column: each
+ * field of every record is kept in its own contiguous column, so a loop which
+ * reads one field across many records touches only that field's memory (and
+ * can process it with vector instructions; see math/batch.h).
+ *
+ * Each column begins on a SOA_ALIGNMENT-byte boundary, and is preceded by a
+ * resizable array header (see container/array.h), so soa_column returns a
+ * read-only view of the column which works with array_length, array_stride,
+ * the _array_sort class of aliases and the %a format modifier (see
+ * container/string/format.h):
+ *
+ *   soa_t* particles = soa_create ( 1024 , sizeof ( f32 ) , sizeof ( u32 ) );
+ *   soa_push ( particles , &mass , &id );
+ *   ...
+ *   const f32 total = math_sum_array ( soa_column ( particles , 0 )
+ *                                    , soa_length ( particles )
+ *                                    );
+ *   string_format ( "%au" , soa_column ( particles , 1 ) );
+ *
+ * A column view must never be passed to a function which resizes, appends to,
+ * removes from or frees a resizable array. Sorting one in place reorders that
+ * column alone; use soa_sort to keep the columns in step.
+ */
+#ifndef SOA_H
+#define SOA_H
+
+#include "common.h"
+
+#include "core/array.h"
+#include "core/sort.h"
+
+/** @brief Type declaration for a structure-of-arrays. */
+typedef void soa_t;
+
+/** @brief Structure-of-arrays default capacity. */
+#define SOA_DEFAULT_CAPACITY 16
+
+/** @brief Structure-of-arrays rescale factor. */
+#define SOA_SCALE_FACTOR(capacity) \
+    ( ( 3 * (capacity) ) >> 1 )
+
+/** @brief Alignment of each column (in bytes). Wide enough for any vector register. */
+#define SOA_ALIGNMENT 64
+
+/**
+ * @brief Allocates memory for a structure-of-arrays.
+ *
+ * Use _soa_create to pass the column strides as an array, or soa_create to
+ * list them.
+ *
+ * Uses dynamic memory allocation. Call soa_destroy to free.
+ *
+ * @param strides The element size of each column (in bytes). Must be
+ * non-zero, and so must each stride.
+ * @param column_count The number of columns. Must be non-zero.
+ * @param initial_capacity The initial capacity (in records). Must be
+ * non-zero.
+ * @return An empty structure-of-arrays, or 0 on error.
+ */
+soa_t*
+_soa_create
+(   const u64*  strides
+,   u64         column_count
+,   u64         initial_capacity
+);
+
+/**
+ * @param initial_capacity The initial capacity (in records).
+ * @param ... The element size of each column, in order (e.g. sizeof ( f32 )).
+ */
+#define soa_create(initial_capacity,...)                                  \
+    _soa_create ( ( const u64[] ){ __VA_ARGS__ }                          \
+                , sizeof ( ( const u64[] ){ __VA_ARGS__ } ) / sizeof ( u64 ) \
+                , (initial_capacity)                                      \
+                )
+
+/**
+ * @brief Frees the memory used by a structure-of-arrays.
+ *
+ * @param soa The structure-of-arrays to free.
+ */
+void
+soa_destroy
+(   soa_t* soa
+);
+
+/**
+ * @brief Queries the number of records in a structure-of-arrays. O(1).
+ *
+ * @param soa The structure-of-arrays to query. Must be non-zero.
+ * @return The number of records.
+ */
+u64
+soa_length
+(   const soa_t* soa
+);
+
+/**
+ * @brief Queries the number of records a structure-of-arrays can hold before
+ * it must grow. O(1).
+ *
+ * @param soa The structure-of-arrays to query. Must be non-zero.
+ * @return The capacity (in records).
+ */
+u64
+soa_capacity
+(   const soa_t* soa
+);
+
+/**
+ * @brief Queries the number of columns in a structure-of-arrays. O(1).
+ *
+ * @param soa The structure-of-arrays to query. Must be non-zero.
+ * @return The number of columns.
+ */
+u64
+soa_column_count
+(   const soa_t* soa
+);
+
+/**
+ * @brief Obtains a view of one column of a structure-of-arrays. O(1).
+ *
+ * The view is a SOA_ALIGNMENT-aligned array of soa_length elements, which is
+ * also a read-only resizable array (see container/soa.h). It is invalidated
+ * by any operation which grows the structure-of-arrays.
+ *
+ * @param soa The structure-of-arrays to query. Must be non-zero.
+ * @param column The index of the column. Must be less than the column count.
+ * @return The first element of the column.
+ */
+void*
+soa_column
+(   const soa_t*    soa
+,   u64             column
+);
+
+/**
+ * @brief Ensures a structure-of-arrays can hold at least a specified number
+ * of records without growing. Grows to exactly that capacity; never shrinks.
+ * O(n) if it grows; otherwise, O(1).
+ *
+ * @param soa The structure-of-arrays to reserve space in. Must be non-zero.
+ * @param capacity The number of records the structure-of-arrays is required
+ * to hold.
+ */
+void
+soa_reserve
+(   soa_t*  soa
+,   u64     capacity
+);
+
+/**
+ * @brief Appends a record to a structure-of-arrays. O(1), on average.
+ *
+ * @param soa The structure-of-arrays to append to. Must be non-zero.
+ * @param src The address of each field of the record, in column order. Must
+ * be non-zero, and so must each address.
+ * @param count The number of addresses in src. Must equal the column count.
+ * @return true on success; false otherwise.
+ */
+bool
+_soa_push
+(   soa_t*              soa
+,   const void* const*  src
+,   u64                 count
+);
+
+/** @param ... The address of each field of the record, in column order. */
+#define soa_push(soa,...)                                                    \
+    _soa_push ( (soa)                                                        \
+              , ( const void*[] ){ __VA_ARGS__ }                             \
+              , sizeof ( ( const void*[] ){ __VA_ARGS__ } ) / sizeof ( void* ) \
+              )
+
+/**
+ * @brief Removes the last record from a structure-of-arrays. O(1).
+ *
+ * @param soa The structure-of-arrays to remove from. Must be non-zero.
+ * @param dst Output buffer for each field of the removed record, in column
+ * order. Pass 0 (for dst, or for any one field) to retrieve nothing.
+ * @param count The number of output buffers in dst. Fields of columns beyond
+ * count are not retrieved.
+ * @return true on success; false if the structure-of-arrays is empty.
+ */
+bool
+_soa_pop
+(   soa_t*          soa
+,   void* const*    dst
+,   u64             count
+);
+
+/** @param ... Output buffer for each field of the removed record, in column order. */
+#define soa_pop(soa,...)                                               \
+    _soa_pop ( (soa)                                                   \
+             , ( void*[] ){ __VA_ARGS__ }                              \
+             , sizeof ( ( void*[] ){ __VA_ARGS__ } ) / sizeof ( void* ) \
+             )
+
+/**
+ * @brief Removes a record from a structure-of-arrays by moving the last record
+ * into its place. Does not preserve the order of the records. O(1).
+ *
+ * @param soa The structure-of-arrays to remove from. Must be non-zero.
+ * @param index The index of the record to remove.
+ * @param dst Output buffer for each field of the removed record, in column
+ * order. Pass 0 (for dst, or for any one field) to retrieve nothing.
+ * @param count The number of output buffers in dst. Fields of columns beyond
+ * count are not retrieved.
+ * @return true on success; false if index is out of bounds.
+ */
+bool
+_soa_remove_swap
+(   soa_t*          soa
+,   u64             index
+,   void* const*    dst
+,   u64             count
+);
+
+/** @param ... Output buffer for each field of the removed record, in column order. */
+#define soa_remove_swap(soa,index,...)                                         \
+    _soa_remove_swap ( (soa)                                                   \
+                     , (index)                                                 \
+                     , ( void*[] ){ __VA_ARGS__ }                              \
+                     , sizeof ( ( void*[] ){ __VA_ARGS__ } ) / sizeof ( void* ) \
+                     )
+
+/**
+ * @brief Reorders the records of a structure-of-arrays: the record at index i
+ * afterwards is the one which was at index permutation[ i ]. O(n).
+ *
+ * @param soa The structure-of-arrays to reorder. Must be non-zero.
+ * @param permutation An array of soa_length indices, each of which must occur
+ * exactly once. Must be non-zero.
+ */
+void
+soa_permute
+(   soa_t*      soa
+,   const u64*  permutation
+);
+
+/**
+ * @brief Sorts the records of a structure-of-arrays by one column, keeping
+ * the other columns in step (see array_sort in core/array.h).
+ *
+ * The key column is sorted together with the index of each record, and the
+ * resulting permutation is then applied to every column (see soa_permute).
+ *
+ * Not stable.
+ * TIME COMPLEXITY : O(n log(n))
+ *
+ * @param soa The structure-of-arrays to sort. Must be non-zero.
+ * @param column The index of the key column.
+ * @param comparator A function which compares two elements of the key column.
+ * Must be non-zero.
+ * @return true on success; false if column is out of bounds.
+ */
+bool
+soa_sort
+(   soa_t*                  soa
+,   u64                     column
+,   comparator_function_t   comparator
+);
+
+/**
+ * @brief Sorts the records of a structure-of-arrays by an integer or floating
+ * point key column, in ascending order, keeping the other columns in step
+ * (see array_sort_radix in core/array.h).
+ *
+ * Stable.
+ * TIME COMPLEXITY : O(n * key size)
+ *
+ * @param soa The structure-of-arrays to sort. Must be non-zero.
+ * @param column The index of the key column.
+ * @param key The type of the key. Must match the stride of the column.
+ * @return true on success; false if column is out of bounds or key does not
+ * match its stride.
+ */
+bool
+soa_sort_radix
+(   soa_t*      soa
+,   u64         column
+,   SORT_KEY    key
+);
+
+#endif  // SOA_H
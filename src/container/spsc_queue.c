@@ -0,0 +1,232 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/spsc_queue.c
+ * @brief Implementation of the container/spsc_queue header.
+ * (see container/spsc_queue.h for additional details)
+ */
+#include "container/spsc_queue.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    // Read-only after initialization.
+    u64     stride;
+    u64     capacity;
+    u64     memory_requirement;
+    bool    owns_memory;
+    void*   content;
+    u8      padding0[ CACHE_LINE_SIZE - 4 * sizeof ( u64 ) - sizeof ( void* ) ];
+
+    // Written by the producer only. The producer keeps a private copy of the
+    // consumer index, and only re-reads the shared one when the queue appears
+    // to be full.
+    u64     tail;
+    u64     cached_head;
+    u8      padding1[ CACHE_LINE_SIZE - 2 * sizeof ( u64 ) ];
+
+    // Written by the consumer only (see above).
+    u64     head;
+    u64     cached_tail;
+    u8      padding2[ CACHE_LINE_SIZE - 2 * sizeof ( u64 ) ];
+}
+state_t;
+
+bool
+spsc_queue_create
+(   u64             stride
+,   u64             capacity
+,   u64*            memory_requirement_
+,   void*           memory_
+,   spsc_queue_t**  queue
+)
+{
+    if ( !stride || !capacity )
+    {
+        if ( !stride )
+        {
+            LOGERROR ( "spsc_queue_create: Value of stride argument must be non-zero." );
+        }
+        if ( !capacity )
+        {
+            LOGERROR ( "spsc_queue_create: Value of capacity argument must be non-zero." );
+        }
+        return false;
+    }
+
+    // Round capacity up to a power of two, so indices can be reduced with a mask.
+    if ( capacity & ( capacity - 1 ) )
+    {
+        capacity = ( ( u64 ) 1 ) << ( bitscan_reverse ( capacity ) + 1 );
+    }
+
+    const u64 memory_requirement = sizeof ( state_t ) + capacity * stride;
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_aligned_uninit ( memory_requirement
+                                                , CACHE_LINE_SIZE
+                                                , MEMORY_TAG_QUEUE
+                                                );
+    }
+
+    if ( !queue )
+    {
+        LOGERROR ( "spsc_queue_create: Missing argument: queue (output buffer)." );
+        if ( !memory_ )
+        {
+            memory_free_aligned ( memory
+                                , memory_requirement
+                                , CACHE_LINE_SIZE
+                                , MEMORY_TAG_QUEUE
+                                );
+        }
+        return false;
+    }
+
+    memory_clear ( memory , memory_requirement );
+
+    state_t* state = memory;
+    ( *state ).stride = stride;
+    ( *state ).capacity = capacity;
+    ( *state ).memory_requirement = memory_requirement;
+    ( *state ).owns_memory = !memory_;
+    ( *state ).content = ( void* )( ( ( u64 ) memory ) + sizeof ( state_t ) );
+
+    *queue = state;
+    return true;
+}
+
+void
+spsc_queue_destroy
+(   spsc_queue_t** queue
+)
+{
+    if ( !queue )
+    {
+        return;
+    }
+
+    state_t* state = *queue;
+    if ( !state )
+    {
+        return;
+    }
+
+    const u64 memory_requirement = ( *state ).memory_requirement;
+    if ( ( *state ).owns_memory )
+    {
+        memory_free_aligned ( state
+                            , memory_requirement
+                            , CACHE_LINE_SIZE
+                            , MEMORY_TAG_QUEUE
+                            );
+    }
+    else
+    {
+        memory_clear ( state , memory_requirement );
+    }
+
+    *queue = 0;
+}
+
+u64
+spsc_queue_capacity
+(   const spsc_queue_t* queue
+)
+{
+    return ( *( ( state_t* ) queue ) ).capacity;
+}
+
+u64
+spsc_queue_stride
+(   const spsc_queue_t* queue
+)
+{
+    return ( *( ( state_t* ) queue ) ).stride;
+}
+
+u64
+spsc_queue_length
+(   const spsc_queue_t* queue
+)
+{
+    state_t* state = ( state_t* ) queue;
+    const u64 head = atomic_load_u64 ( &( *state ).head , ATOMIC_ACQUIRE );
+    const u64 tail = atomic_load_u64 ( &( *state ).tail , ATOMIC_ACQUIRE );
+    return tail - head;
+}
+
+bool
+spsc_queue_push
+(   spsc_queue_t*   queue
+,   const void*     src
+)
+{
+    state_t* state = queue;
+    const u64 tail = ( *state ).tail;
+    if ( tail - ( *state ).cached_head == ( *state ).capacity )
+    {
+        ( *state ).cached_head = atomic_load_u64 ( &( *state ).head , ATOMIC_ACQUIRE );
+        if ( tail - ( *state ).cached_head == ( *state ).capacity )
+        {
+            return false;
+        }
+    }
+    memory_copy ( ( void* )( ( ( u64 )( ( *state ).content ) )
+                           + ( tail & ( ( *state ).capacity - 1 ) ) * ( *state ).stride
+                           )
+                , src
+                , ( *state ).stride
+                );
+
+    // Publish the element to the consumer.
+    atomic_store_u64 ( &( *state ).tail , tail + 1 , ATOMIC_RELEASE );
+    return true;
+}
+
+bool
+spsc_queue_pop
+(   spsc_queue_t*   queue
+,   void*           dst
+)
+{
+    state_t* state = queue;
+    const u64 head = ( *state ).head;
+    if ( head == ( *state ).cached_tail )
+    {
+        ( *state ).cached_tail = atomic_load_u64 ( &( *state ).tail , ATOMIC_ACQUIRE );
+        if ( head == ( *state ).cached_tail )
+        {
+            return false;
+        }
+    }
+    if ( dst )
+    {
+        memory_copy ( dst
+                    , ( void* )( ( ( u64 )( ( *state ).content ) )
+                               + ( head & ( ( *state ).capacity - 1 ) ) * ( *state ).stride
+                               )
+                    , ( *state ).stride
+                    );
+    }
+
+    // Release the slot back to the producer.
+    atomic_store_u64 ( &( *state ).head , head + 1 , ATOMIC_RELEASE );
+    return true;
+}
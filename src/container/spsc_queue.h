@@ -0,0 +1,131 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/spsc_queue.h
+ * @brief Provides an interface for a bounded, lock-free, single-producer
+ * single-consumer FIFO queue.
+ */
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include "common.h"
+
+/** @brief Type declaration for a single-producer single-consumer queue. */
+typedef void spsc_queue_t;
+
+/**
+ * @brief Initializes a single-producer single-consumer queue.
+ * 
+ * Exactly one thread may push to the queue, and exactly one (possibly
+ * different) thread may pop from it, concurrently and without locking. The
+ * producer and consumer indices are kept on separate cache lines.
+ * 
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size. The buffer should be aligned to
+ *   a cache line (64 bytes) to avoid false sharing.
+ * 
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h). Call
+ *   spsc_queue_destroy to free.
+ * 
+ * @param stride The fixed element size in bytes. Must be non-zero.
+ * @param capacity The minimum number of elements the queue must be able to
+ * hold. Rounded up to the nearest power of two. Cannot be resized.
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required to operate the queue. Only applicable if pre-allocating a memory
+ * buffer of the required size. Pass 0 to use implicit memory allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @param queue Output buffer for queue.
+ * @return true on success; false otherwise.
+ */
+bool
+spsc_queue_create
+(   u64             stride
+,   u64             capacity
+,   u64*            memory_requirement
+,   void*           memory
+,   spsc_queue_t**  queue
+);
+
+/**
+ * @brief Frees the memory used by a single-producer single-consumer queue.
+ * 
+ * If the queue was not pre-allocated, this function will free the memory
+ * implicitly (see core/memory.h). Must not be called while any other thread
+ * is accessing the queue.
+ * 
+ * @param queue Handle to the queue to free.
+ */
+void
+spsc_queue_destroy
+(   spsc_queue_t** queue
+);
+
+/**
+ * @brief Queries the capacity of a single-producer single-consumer queue.
+ * 
+ * @param queue The queue to query. Must be non-zero.
+ * @return The maximum number of elements the queue may hold.
+ */
+u64
+spsc_queue_capacity
+(   const spsc_queue_t* queue
+);
+
+/**
+ * @brief Queries the element size of a single-producer single-consumer queue.
+ * 
+ * @param queue The queue to query. Must be non-zero.
+ * @return The size of each element in bytes.
+ */
+u64
+spsc_queue_stride
+(   const spsc_queue_t* queue
+);
+
+/**
+ * @brief Queries the number of elements in a single-producer single-consumer
+ * queue.
+ * 
+ * If the queue is accessed concurrently, the result is only a snapshot, and
+ * may already be out of date.
+ * 
+ * @param queue The queue to query. Must be non-zero.
+ * @return The number of elements in the queue.
+ */
+u64
+spsc_queue_length
+(   const spsc_queue_t* queue
+);
+
+/**
+ * @brief Appends an element to a single-producer single-consumer queue. O(1).
+ * Wait-free. May only be called from the producer thread.
+ * 
+ * @param queue The queue to append to. Must be non-zero.
+ * @param src The element to append. Must be non-zero.
+ * @return true on success; false if the queue is full.
+ */
+bool
+spsc_queue_push
+(   spsc_queue_t*   queue
+,   const void*     src
+);
+
+/**
+ * @brief Removes the head of a single-producer single-consumer queue. O(1).
+ * Wait-free. May only be called from the consumer thread.
+ * 
+ * @param queue The queue to remove from. Must be non-zero.
+ * @param dst Optional output buffer for the head, if present.
+ * @return true on success; false if the queue is empty.
+ */
+bool
+spsc_queue_pop
+(   spsc_queue_t*   queue
+,   void*           dst
+);
+
+#endif  // SPSC_QUEUE_H
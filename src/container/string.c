@@ -11,6 +11,33 @@
 
 #include "math/math.h"
 
+/**
+ * @brief Number of occurrences __string_replace can record without allocating
+ * memory (see __string_replace).
+ */
+#define STRING_REPLACE_STACK_INDICES 256
+
+/**
+ * @brief Stride recorded in the header of a string which lives in small string
+ * storage. _array_create rejects a zero stride, so no dynamically allocated
+ * string can have it (see __string_create_small).
+ */
+#define STRING_SMALL_STRIDE 0
+
+/**
+ * @brief Resizes a resizable string, moving it to dynamic memory if it lives
+ * in small string storage.
+ * 
+ * @param string The resizable string to resize. Must be non-zero.
+ * @param capacity The new capacity.
+ * @return The resized string.
+ */
+char*
+_string_resize
+(   char*       string
+,   const u64   capacity
+);
+
 char*
 __string_create
 (   ARRAY_FIELD initial_capacity
@@ -40,12 +67,32 @@ __string_copy
     return string;
 }
 
+char*
+__string_create_small
+(   string_small_t* small
+,   const char*     src
+,   const u64       src_length
+)
+{//                 v terminator
+    if ( src_length + 1 > STRING_SMALL_CAPACITY )
+    {
+        return __string_copy ( src , src_length );
+    }
+
+    ( *small ).header[ ARRAY_FIELD_CAPACITY ] = STRING_SMALL_CAPACITY;
+    ( *small ).header[ ARRAY_FIELD_LENGTH ]   = src_length + 1;
+    ( *small ).header[ ARRAY_FIELD_STRIDE ]   = STRING_SMALL_STRIDE;
+    memory_copy ( ( *small ).data , src , src_length );
+    ( *small ).data[ src_length ] = 0;
+    return ( *small ).data;
+}
+
 void
 string_destroy
 (   char* string
 )
 {
-    if ( !string )
+    if ( !string || !string_owns_memory ( string ) )
     {
         return;
     }
@@ -61,6 +108,14 @@ string_length
     return array_length ( string ) - 1;
 }
 
+bool
+string_owns_memory
+(   const char* string
+)
+{
+    return array_stride ( string ) != STRING_SMALL_STRIDE;
+}
+
 char*
 __string_push
 (   char*       string
@@ -71,11 +126,11 @@ __string_push
     const u64 old_size = array_length ( string );
     const u64 new_size = old_size + src_length;
     const u64 new_length = string_length ( string ) + src_length;
-    const u64 stride = array_stride ( string );
+    const u64 stride = sizeof ( char );
 
     if ( new_size >= array_capacity ( string ) )
     {
-        string = array_resize ( string , new_size );
+        string = _string_resize ( string , new_size );
     }
 
     memory_copy ( ( void* )( ( ( u64 ) string )
@@ -92,6 +147,53 @@ __string_push
     return string;
 }
 
+char*
+__string_push_hex
+(   char*       string
+,   const void* src
+,   const u64   size
+,   const bool  uppercase
+)
+{
+    const u64 length = STRING_HEX_LENGTH ( size );
+    const u64 new_size = array_length ( string ) + length;
+
+    if ( new_size >= array_capacity ( string ) )
+    {
+        string = _string_resize ( string , new_size );
+    }
+
+    const u64 old_length = string_length ( string );
+    string_hex_encode ( src , size , uppercase , string + old_length );
+    string[ old_length + length ] = 0; // Append terminator.
+    _array_field_set ( string , ARRAY_FIELD_LENGTH , new_size );
+
+    return string;
+}
+
+char*
+__string_push_base64
+(   char*       string
+,   const void* src
+,   const u64   size
+)
+{
+    const u64 length = STRING_BASE64_LENGTH ( size );
+    const u64 new_size = array_length ( string ) + length;
+
+    if ( new_size >= array_capacity ( string ) )
+    {
+        string = _string_resize ( string , new_size );
+    }
+
+    const u64 old_length = string_length ( string );
+    string_base64_encode ( src , size , string + old_length );
+    string[ old_length + length ] = 0; // Append terminator.
+    _array_field_set ( string , ARRAY_FIELD_LENGTH , new_size );
+
+    return string;
+}
+
 char*
 __string_insert
 (   char*       string
@@ -103,7 +205,7 @@ __string_insert
     const u64 old_length = string_length ( string );
     const u64 old_size = array_length ( string );
     const u64 new_size = old_size + src_length;
-    const u64 stride = array_stride ( string );
+    const u64 stride = sizeof ( char );
     
     if ( index > old_length )
     {
@@ -115,7 +217,7 @@ __string_insert
 
     if ( new_size >= array_capacity ( string ) )
     {
-        string = array_resize ( string , new_size );
+        string = _string_resize ( string , new_size );
     }
 
     memory_move ( ( void* )( ( ( u64 ) string )
@@ -148,7 +250,7 @@ __string_remove
     const u64 old_length = string_length ( string );
     const u64 old_size = array_length ( string );
     const u64 new_size = old_size - count;
-    const u64 stride = array_stride ( string );
+    const u64 stride = sizeof ( char );
 
     if ( index + count > old_length )
     {
@@ -168,6 +270,36 @@ __string_remove
     return string;
 }
 
+char*
+__string_remove_if
+(   char*                       string
+,   array_predicate_function_t  predicate
+,   void*                       args
+)
+{
+    if ( !predicate )
+    {
+        LOGERROR ( "__string_remove_if: Missing argument: predicate." );
+        return string;
+    }
+
+    // The stride field of a small string is not its character size, so this
+    // cannot defer to array_remove_if.
+    const u64 old_length = string_length ( string );
+    u64 length = 0;
+    for ( u64 i = 0; i < old_length; ++i )
+    {
+        if ( !predicate ( &string[ i ] , args ) )
+        {
+            string[ length ] = string[ i ];
+            length += 1;
+        }
+    }
+    string[ length ] = 0; // Append terminator.
+    _array_field_set ( string , ARRAY_FIELD_LENGTH , length + 1 );
+    return string;
+}
+
 char*
 __string_clear
 (   char* string
@@ -184,25 +316,20 @@ __string_trim
 )
 {
     const u64 length = string_length ( string );
-    u64 i;
-    
-    // Compute index of first non-whitespace character.
-    for ( i = 0; i < length && whitespace ( string[ i ] ); ++i );
-    char* const from = string + i;
+    const u64 from = string_leading_whitespace ( string , length );
 
     // Whitespace-only case.
-    if ( i == length - 1 )
+    if ( from == length )
     {
         return string_clear ( string );
     }
 
-    // Compute index of final non-whitespace character.
-    for ( i = length; i && whitespace ( string[ i - 1 ] ); --i );
-    char* const to = string + i;
+    const u64 size = length - from - string_trailing_whitespace ( string + from
+                                                                , length - from
+                                                                );
 
     // Copy memory range in-place.
-    const u64 size = MAX ( 0 , to - from );
-    memory_move ( string , from , size );
+    memory_move ( string , string + from , size );
     string[ size ] = 0; // Append terminator.
 
     _array_field_set ( string , ARRAY_FIELD_LENGTH , size + 1 );
@@ -244,88 +371,116 @@ __string_replace
         }
     }
 
-    // CASE: Substring to remove and replacement substring are the same length.
-    else if ( remove_length == replace_length )
-    {
-        u64 index = 0;
-        while ( string_contains ( string + index
-                                , string_length ( string ) - index
-                                , remove
-                                , remove_length
-                                , false
-                                , &index
-                                ))
-        {
-            memory_copy ( string + index , replace , replace_length );
-        }
-    }
-
-    // CASE: Substring to remove and replacement substring differ in length.
+    // CASE: Substring to remove is non-empty. Every occurrence is found up
+    //       front, so each character is moved at most once.
     else
-    {
-        u64 index = 0;
-        u64 index_;
-        while ( string_contains ( string + index
-                                , string_length ( string ) - index
-                                , remove
-                                , remove_length
-                                , false
-                                , &index_
-                                ))
-        {
-            index += index_;
-            string_remove ( string , index , remove_length );
-            string_insert ( string , index , replace , replace_length );
-        }
-    }
-
-    return string;
-}
-
-char*
-__string_strip_ansi
-(   char* string
-)
-{
-    u64 i = 0;
-    for (;;)
     {
         const u64 length = string_length ( string );
-        if ( !length || i >=  length - 1 )
+        u64 stack_indices[ STRING_REPLACE_STACK_INDICES ];
+        u64* indices = stack_indices;
+        const u64 count = string_find_all ( string , length
+                                          , remove , remove_length
+                                          , indices
+                                          , STRING_REPLACE_STACK_INDICES
+                                          );
+        if ( !count )
         {
-            break;
+            return string;
         }
-
-        if ( string[ i ] != '\033' || string[ i + 1 ]  != '[' )
+        if ( count > STRING_REPLACE_STACK_INDICES )
         {
-            i += 1;
-            continue;
+            indices = memory_allocate_uninit ( count * sizeof ( u64 ) , MEMORY_TAG_STRING );
+            string_find_all ( string , length
+                            , remove , remove_length
+                            , indices
+                            , count
+                            );
         }
 
-        u64 j = i + 2;
-        for (;;)
+        // CASE: Replacement substring is no longer: compact from the front.
+        if ( replace_length <= remove_length )
         {
-            if ( j >= string_length ( string ) )
+            u64 read = 0;
+            u64 write = 0;
+            for ( u64 i = 0; i < count; ++i )
             {
-                i += 1;
-                break;
+                const u64 segment = indices[ i ] - read;
+                if ( write != read )
+                {
+                    memory_move ( string + write , string + read , segment );
+                }
+                write += segment;
+                memory_copy ( string + write , replace , replace_length );
+                write += replace_length;
+                read = indices[ i ] + remove_length;
             }
-
-            if ( string[ j ] == 'm' )
+            if ( write != read )
             {
-                string_remove ( string , i , j - i + 1 );
-                break;
+                memory_move ( string + write , string + read , length - read );
             }
+            write += length - read;
+            string[ write ] = 0; // Append terminator.
+            _array_field_set ( string , ARRAY_FIELD_LENGTH , write + 1 );
+        }
 
-            if ( !digit ( string[ j ] ) && string[ j ] != ';' )
+        // CASE: Replacement substring is longer: resize once, then expand from
+        //       the back.
+        else
+        {
+            const u64 new_length = length + count * ( replace_length - remove_length );
+            if ( new_length + 1 > array_capacity ( string ) )
             {
-                i += 1;
-                break;
+                string = _string_resize ( string , new_length + 1 );
             }
+            u64 read = length;
+            u64 write = new_length;
+            for ( u64 i = count; i; --i )
+            {
+                const u64 end = indices[ i - 1 ] + remove_length;
+                write -= read - end;
+                memory_move ( string + write , string + end , read - end );
+                write -= replace_length;
+                memory_copy ( string + write , replace , replace_length );
+                read = indices[ i - 1 ];
+            }
+            string[ new_length ] = 0; // Append terminator.
+            _array_field_set ( string , ARRAY_FIELD_LENGTH , new_length + 1 );
+        }
 
-            j += 1;
+        if ( indices != stack_indices )
+        {
+            memory_free ( indices , count * sizeof ( u64 ) , MEMORY_TAG_STRING );
         }
     }
 
     return string;
 }
+
+char*
+__string_strip_ansi
+(   char* string
+)
+{
+    const u64 length = string_strip_ansi_to ( string , string , string_length ( string ) );
+    string[ length ] = 0; // Append terminator.
+    _array_field_set ( string , ARRAY_FIELD_LENGTH , length + 1 );
+    return string;
+}
+
+char*
+_string_resize
+(   char*       string
+,   const u64   capacity
+)
+{
+    if ( string_owns_memory ( string ) )
+    {
+        return array_resize ( string , capacity );
+    }
+
+    const u64 length = array_length ( string );
+    char* resized = array_create ( char , capacity );
+    memory_copy ( resized , string , length );
+    _array_field_set ( resized , ARRAY_FIELD_LENGTH , length );
+    return resized;
+}
@@ -16,6 +16,24 @@
 /** @brief Defines resizable string default capacity. */
 #define STRING_DEFAULT_CAPACITY 64
 
+/** @brief Defines small string capacity, including the terminator (see
+ * string_small_t). */
+#define STRING_SMALL_CAPACITY 40
+
+/**
+ * @brief Type definition for small string storage.
+ * 
+ * Holds a resizable string header and contents inline, so that a short string
+ * may be kept on the stack or within another structure rather than allocated
+ * (see __string_create_small).
+ */
+typedef struct
+{
+    u64     header[ ARRAY_FIELD_COUNT ];
+    char    data[ STRING_SMALL_CAPACITY ];
+}
+string_small_t;
+
 /**
  * @brief Generates a handle to an empty resizable string.
  * 
@@ -75,6 +93,48 @@ __string_copy
 #define _string_copy(string,length) \
     __string_copy ( (string) , (length) )
 
+/**
+ * @brief Creates a resizable string within small string storage. O(n).
+ * 
+ * If the copy fits within STRING_SMALL_CAPACITY (including the terminator),
+ * no memory is allocated: the string lives in small, and is valid only as long
+ * as small is. Otherwise, this is equivalent to __string_copy. The result is
+ * an ordinary resizable string, and may be passed to any function in this
+ * header; if it outgrows small, it is moved to dynamic memory, which is why
+ * string_destroy must still be called once it is no longer needed. While it
+ * lives in small, it may not be passed to the container/array.h functions.
+ * 
+ * Use _string_create_small to explicitly specify string length,
+ * string_create_small_from to compute the length of a null-terminated string,
+ * or string_create_small to create an empty string.
+ * 
+ * @param small Storage for the string. Must be non-zero.
+ * @param src The string to copy. Must be non-zero if src_length is non-zero.
+ * @param src_length The number of characters to copy from src.
+ * @return A resizable copy of src.
+ */
+char*
+__string_create_small
+(   string_small_t* small
+,   const char*     src
+,   const u64       src_length
+);
+
+#define string_create_small(small) \
+    __string_create_small ( (small) , "" , 0 )
+
+#define string_create_small_from(small,string)                    \
+    ({                                                            \
+        const char* string__ = (string);                          \
+        __string_create_small ( (small)                           \
+                              , string__                          \
+                              , _string_length ( string__ )       \
+                              );                                  \
+    })
+
+#define _string_create_small(small,string,length) \
+    __string_create_small ( (small) , (string) , (length) )
+
 /**
  * @brief Frees the memory used by a provided resizable string.
  * 
@@ -96,6 +156,30 @@ string_length
 (   const char* string
 );
 
+/**
+ * @brief Queries whether a resizable string was allocated dynamically. O(1).
+ * 
+ * @param string A resizable string. Must be non-zero.
+ * @return false if string still lives in small string storage (see
+ * __string_create_small); true otherwise.
+ */
+bool
+string_owns_memory
+(   const char* string
+);
+
+/**
+ * @brief Creates a view of a resizable string. O(1).
+ * 
+ * The view is invalidated by any operation which may change the address of
+ * the string.
+ */
+#define string_view_of(string)                                \
+    ({                                                        \
+        const char* string__ = (string);                      \
+        string_view ( string__ , string_length ( string__ ) ); \
+    })
+
 /**
  * @brief Appends to a resizable string. O(1), on average.
  * 
@@ -127,6 +211,48 @@ __string_push
                                  );                         \
     })
 
+/**
+ * @brief Appends the hexadecimal encoding of a sequence of bytes to a
+ * resizable string (see string_hex_encode in core/string.h). Encodes directly
+ * into the string, resizing it at most once. O(n).
+ * 
+ * @param string The resizable string to append to. Must be non-zero.
+ * @param src The bytes to encode. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to encode.
+ * @param uppercase Use uppercase letters? Y/N
+ * @return The resizable string (possibly with new address).
+ */
+char*
+__string_push_hex
+(   char*       string
+,   const void* src
+,   const u64   size
+,   const bool  uppercase
+);
+
+#define string_push_hex(string,src,size,uppercase) \
+    ( (string) = __string_push_hex ( (string) , (src) , (size) , (uppercase) ) )
+
+/**
+ * @brief Appends the base64 encoding of a sequence of bytes to a resizable
+ * string (see string_base64_encode in core/string.h). Encodes directly into
+ * the string, resizing it at most once. O(n).
+ * 
+ * @param string The resizable string to append to. Must be non-zero.
+ * @param src The bytes to encode. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to encode.
+ * @return The resizable string (possibly with new address).
+ */
+char*
+__string_push_base64
+(   char*       string
+,   const void* src
+,   const u64   size
+);
+
+#define string_push_base64(string,src,size) \
+    ( (string) = __string_push_base64 ( (string) , (src) , (size) ) )
+
 /**
  * @brief Inserts into a resizable string. O(n).
  * 
@@ -179,6 +305,26 @@ __string_remove
 #define string_remove(string,index,count) \
     __string_remove ( (string) , (index) , (count) )
 
+/**
+ * @brief Removes every character of a resizable string which satisfies a
+ * predicate, in a single pass (see array_remove_if). O(n).
+ *
+ * @param string The resizable string to remove from. Must be non-zero.
+ * @param predicate A function which is passed the address of each character,
+ * and returns true for each one to remove. Must be non-zero.
+ * @param args Internal state arguments passed to each predicate call.
+ * @return The resizable string with the characters removed.
+ */
+char*
+__string_remove_if
+(   char*                       string
+,   array_predicate_function_t  predicate
+,   void*                       args
+);
+
+#define string_remove_if(string,predicate,args) \
+    __string_remove_if ( (string) , (predicate) , (args) )
+
 /**
  * @brief **Effectively** clears a resizable string. O(1).
  * 
@@ -213,6 +359,10 @@ __string_trim
  * @brief Replaces all instances of a substring within a string with a different
  * substring. O(n).
  * 
+ * Instances are found from left to right and do not overlap (see
+ * string_find_all). The string is resized at most once, and each character is
+ * moved at most once.
+ * 
  * Use string_replace to explicitly specify string length, or _string_replace
  * to compute the lengths of null-terminated strings before passing them to
  * __string_replace.
@@ -267,4 +417,23 @@ __string_strip_ansi
 #define string_strip_ansi(string) \
     __string_strip_ansi ( string )
 
+/**
+ * @brief Alias for calling hash64 on the contents of a resizable string.
+ * O(n). (see core/hash.h)
+ * 
+ * To hash a null-terminated string, call hash64 directly.
+ */
+#define string_hash(string,seed)                                    \
+    ({                                                              \
+        const char* string__ = (string);                            \
+        hash64 ( string__ , string_length ( string__ ) , (seed) );  \
+    })
+
+/** @brief Alias for calling hash64 on the contents of a string view. O(n). */
+#define string_view_hash(view,seed)                         \
+    ({                                                      \
+        const string_view_t view__ = (view);                \
+        hash64 ( view__.string , view__.length , (seed) );  \
+    })
+
 #endif  // STRING_H
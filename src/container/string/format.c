@@ -13,12 +13,15 @@
 #include "core/assert.h"
 #include "core/logger.h"
 #include "core/memory.h"
+#include "core/profile.h"
 
 #include "math/math.h"
 
 // Global constants.
 #define STRING_FORMAT_MAX_FLOATING_POINT_STRING_LENGTH             2048 /** @brief Maximum floating point string buffer length. */
 #define STRING_FORMAT_MAX_FLOATING_POINT_ABBREVIATED_STRING_LENGTH 64   /** @brief Maximum abbreviated floating point string buffer length. */
+#define STRING_FORMAT_DEFAULT_FLOATING_POINT_PRECISION             6    /** @brief Floating point precision if no fix-precision modifier is set. */
+#define STRING_FORMAT_CONTAINER_BUFFER_SIZE                        4096 /** @brief Size of the buffer which stages the output of an array or queue argument. */
 
 /** @brief Type and instance definitions for string padding tag. */
 typedef enum
@@ -76,6 +79,9 @@ STRING_FORMAT_CONTAINER;
 typedef struct
 {
     STRING_FORMAT_CONTAINER tag;
+
+    // Maximum number of elements to print, or 0 to print them all.
+    u64                     limit;
 }
 string_format_container_t;
 
@@ -106,10 +112,55 @@ typedef struct
     const char* copy_start;
     const char* copy_end;
 
+    // Output: a resizable string, or a fixed-size buffer if dst is non-zero
+    // (see _string_format_to).
     char*       string;
+    char*       dst;
+    u64         dst_capacity;
+    u64         dst_length;
+
+    // Staging buffer for the output, or 0 if writing to the output directly
+    // (see _string_format_parse_argument_container).
+    char*       buffer;
+    u64         buffer_length;
 }
 state_t;
 
+/** @brief Type and instance definitions for a precompiled formatting step tag. */
+typedef enum
+{
+    STRING_FORMAT_STEP_INVALID
+,   STRING_FORMAT_STEP_IGNORE
+,   STRING_FORMAT_STEP_SPECIFIER
+}
+STRING_FORMAT_STEP;
+
+/**
+ * @brief Type definition for a container to hold a single precompiled
+ * formatting step: one iteration of _string_format_run which reaches a format
+ * specifier token.
+ */
+typedef struct
+{
+    STRING_FORMAT_STEP          tag;
+    u64                         read;       // Index of the format specifier token.
+    u64                         copy_start; // Index of the next literal span once the step has executed.
+    string_format_specifier_t   format_specifier;
+}
+string_format_step_t;
+
+/** @brief Type definition for a precompiled formatting string. */
+typedef struct
+{
+    const char*             format;
+    u64                     format_length;
+    string_format_step_t*   steps;
+    u64                     step_count;
+    u64                     memory_requirement;
+    bool                    owns_memory;
+}
+template_t;
+
 /** @brief Defines next copy size. */
 #define STRING_FORMAT_COPY_SIZE(state) \
     MAX ( 0 , ( *(state) ).copy_end - ( *(state) ).copy_start )
@@ -157,11 +208,16 @@ void _string_format_validate_format_specifier_address ( state_t* state , const c
 void _string_format_validate_format_specifier_character ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
 void _string_format_validate_format_specifier_string ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
 void _string_format_validate_format_specifier_resizable_string ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
+void _string_format_validate_format_specifier_string_view ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
+void _string_format_validate_format_specifier_hex ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
+void _string_format_validate_format_specifier_hex_uppercase ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
+void _string_format_validate_format_specifier_base64 ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
 void _string_format_validate_format_modifier_pad ( state_t* state , const char** read , const bool fixed , string_format_specifier_t* format_specifier );
 void _string_format_validate_format_modifier_sign ( state_t* state , const char** read , STRING_FORMAT_SIGN sign, string_format_specifier_t* format_specifier );
 void _string_format_validate_format_modifier_fix_precision ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
 void _string_format_validate_format_modifier_array ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
 void _string_format_validate_format_modifier_queue ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
+void _string_format_validate_format_modifier_container_limit ( state_t* state , const char** read , string_format_specifier_t* format_specifier );
 
 /**
  * @brief Parses the next argument according to the current format specifier and
@@ -190,14 +246,188 @@ u64 _string_format_parse_argument_address ( state_t* state , const string_format
 u64 _string_format_parse_argument_character ( state_t* state , const string_format_specifier_t* format_specifier , const char arg );
 u64 _string_format_parse_argument_string ( state_t* state , const string_format_specifier_t* format_specifier , const char* arg );
 u64 _string_format_parse_argument_resizable_string ( state_t* state , const string_format_specifier_t* format_specifier , const char* arg );
-u64 _string_format_parse_argument_array ( state_t* state , const string_format_specifier_t* format_specifier , const array_t* arg );
-u64 _string_format_parse_argument_queue ( state_t* state , const string_format_specifier_t* format_specifier , const queue_t* arg );
+u64 _string_format_parse_argument_string_view ( state_t* state , const string_format_specifier_t* format_specifier , const string_view_t* arg );
+u64 _string_format_parse_argument_bytes ( state_t* state , const string_format_specifier_t* format_specifier , const string_view_t* arg );
+u64 _string_format_parse_argument_container ( state_t* state , const string_format_specifier_t* format_specifier , const void* arg );
+
+/**
+ * @brief Parses a single element of an array or queue argument according to
+ * the format specifier and the stride of the container.
+ * 
+ * @param state Internal state arguments.
+ * @param format_specifier A format specifier.
+ * @param element The address of the element.
+ * @param stride The stride of the container.
+ * @return The number of characters written.
+ */
+u64
+_string_format_parse_argument_element
+(   state_t*                            state
+,   const string_format_specifier_t*    format_specifier
+,   const void*                         element
+,   const u64                           stride
+);
+
+/**
+ * @brief Stringifies a floating point argument, respecting the fix-precision
+ * and sign format modifiers.
+ * 
+ * @param dst Output buffer for string (see string_f64).
+ * @param value The floating point argument.
+ * @param abbreviated Use abbreviated (scientific) notation? Y/N
+ * @param format_specifier A format specifier.
+ * @return The number of characters written to dst.
+ */
+u64
+_string_format_stringify_f64
+(   char*                               dst
+,   const f64                           value
+,   const bool                          abbreviated
+,   const string_format_specifier_t*    format_specifier
+);
+
+/**
+ * @brief Appends to the string being constructed. If writing to a fixed-size
+ * buffer, characters which do not fit are counted, but discarded.
+ * 
+ * If the staging buffer is set, the characters are collected there instead,
+ * and reach the output when it fills (see _string_format_flush).
+ * 
+ * @param state Internal state arguments.
+ * @param src The string to append.
+ * @param src_length The number of characters contained by src.
+ */
+void
+_string_format_write
+(   state_t*    state
+,   const char* src
+,   const u64   src_length
+);
+
+/**
+ * @brief Implementation of _string_format_write: appends to the output,
+ * bypassing the staging buffer.
+ * 
+ * @param state Internal state arguments.
+ * @param src The string to append.
+ * @param src_length The number of characters contained by src.
+ */
+void
+_string_format_write_output
+(   state_t*    state
+,   const char* src
+,   const u64   src_length
+);
+
+/**
+ * @brief Moves the contents of the staging buffer to the output.
+ * 
+ * @param state Internal state arguments.
+ */
+void
+_string_format_flush
+(   state_t* state
+);
+
+/** @brief Alias for calling _string_format_write on a null-terminated string. */
+#define _string_format_write_string(state,src)                 \
+    ({                                                         \
+        const char* src__ = (src);                             \
+        _string_format_write ( (state)                         \
+                             , src__                           \
+                             , _string_length ( src__ )        \
+                             );                                \
+    })
+
+/**
+ * @brief Encodes bytes as they are appended to the string being constructed
+ * (see _string_format_write), a chunk at a time, so that the encoded string
+ * is never stored in full.
+ * 
+ * @param state Internal state arguments.
+ * @param src The bytes to encode.
+ * @param size The number of bytes contained by src.
+ * @param limit The maximum number of characters to append.
+ * @param format_specifier A format specifier: %x, %X or %b.
+ */
+void
+_string_format_write_bytes
+(   state_t*                            state
+,   const char*                         src
+,   const u64                           size
+,   const u64                           limit
+,   const string_format_specifier_t*    format_specifier
+);
+
+/**
+ * @brief Queries the length of the string being constructed (including any
+ * characters discarded by a fixed-size buffer).
+ * 
+ * @param state Internal state arguments.
+ * @return The number of characters written so far.
+ */
+u64
+_string_format_written
+(   const state_t* state
+);
+
+/**
+ * @brief Determines which kind of argument a format specifier consumes
+ * (see string_format_arguments).
+ * 
+ * @param format_specifier A valid format specifier.
+ * @return The argument kind.
+ */
+STRING_FORMAT_ARGUMENT
+_string_format_argument
+(   const string_format_specifier_t* format_specifier
+);
+
+/**
+ * @brief Implementation of _string_format, _string_format_to and
+ * _string_format_append: formats the string, once the output has been
+ * prepared.
+ * 
+ * @param state Internal state arguments.
+ */
+void
+_string_format_run
+(   state_t* state
+);
+
+/**
+ * @brief Resolves every format specifier of a formatting string into a list
+ * of precompiled formatting steps, in the order _string_format_run would
+ * reach them if it never ran out of arguments.
+ * 
+ * @param state Internal state arguments.
+ * @param steps Output buffer for the steps. Pass 0 to count them only.
+ * @return The number of steps.
+ */
+u64
+_string_format_compile
+(   state_t*                state
+,   string_format_step_t*   steps
+);
+
+/**
+ * @brief Variant of _string_format_run which executes a precompiled
+ * formatting string instead of parsing ( *state ).format.
+ * 
+ * @param state Internal state arguments.
+ * @param template The template. Its format string must be ( *state ).format.
+ */
+void
+_string_format_run_template
+(   state_t*            state
+,   const template_t*   template
+);
 
 /**
- * @brief Wrapper for string_push that respects the left- and right- 'padding'
- * format modifiers, if they are set.
+ * @brief Wrapper for _string_format_write that respects the left- and right-
+ * 'padding' format modifiers, if they are set.
  * 
- * @param string The handle to a resizable string to append to.
+ * @param state Internal state arguments.
  * @param src The string to append.
  * @param src_length The number of characters contained by src.
  * @param format_specifier A format specifier.
@@ -205,7 +435,7 @@ u64 _string_format_parse_argument_queue ( state_t* state , const string_format_s
  */
 u64
 _string_format_push
-(   char**                              string
+(   state_t*                            state
 ,   const char*                         src
 ,   const u64                           src_length
 ,   const string_format_specifier_t*    format_specifier
@@ -217,6 +447,8 @@ _string_format
 ,   args_t      args
 )
 {
+    PROFILE_FUNCTION ();
+
     if ( !format || ( args.arg_count && !args.args ) )
     {
         if ( !format )
@@ -237,15 +469,329 @@ _string_format
     state.format = format;
     state.format_length = _string_length ( format );
     state.args = args;
-    state.next_arg = state.args.args;
-    state.args_remaining = state.args.arg_count;
     state.string = _string_create ( state.format_length + 1 );
+    state.dst = 0;
+    _string_format_run ( &state );
+    return state.string;
+}
 
-    const char* read = state.format;
-    state.copy_start = read;
+u64
+_string_format_to
+(   char*       dst
+,   const u64   dst_capacity
+,   const char* format
+,   args_t      args
+)
+{
+    if ( !dst || !dst_capacity || !format || ( args.arg_count && !args.args ) )
+    {
+        if ( !dst )
+        {
+            LOGERROR ( "_string_format_to: Missing argument: dst (output buffer)." );
+        }
+        if ( !dst_capacity )
+        {
+            LOGERROR ( "_string_format_to: Value of dst_capacity argument must be non-zero." );
+        }
+        if ( !format )
+        {
+            LOGERROR ( "_string_format_to: Missing argument: format." );
+        }
+        if ( args.arg_count && !args.args )
+        {
+            LOGERROR ( "_string_format_to: Invalid argument: args. List is null, but count indicates it should contain %u element%s."
+                     , args.arg_count
+                     , ( args.arg_count > 1 ) ? "s" : ""
+                     );
+        }
+        if ( dst && dst_capacity )
+        {
+            *dst = 0;
+        }
+        return 0;
+    }
+
+    state_t state;
+    state.format = format;
+    state.format_length = _string_length ( format );
+    state.args = args;
+    state.string = 0;
+    state.dst = dst;
+    state.dst_capacity = dst_capacity;
+    state.dst_length = 0;
+    _string_format_run ( &state );
+
+    // Append terminator.
+    dst[ MIN ( state.dst_length , dst_capacity - 1 ) ] = 0;
+    return state.dst_length;
+}
+
+char*
+_string_format_append
+(   char*       string
+,   const char* format
+,   args_t      args
+)
+{
+    if ( !string || !format || ( args.arg_count && !args.args ) )
+    {
+        if ( !string )
+        {
+            LOGERROR ( "_string_format_append: Missing argument: string." );
+        }
+        if ( !format )
+        {
+            LOGERROR ( "_string_format_append: Missing argument: format." );
+        }
+        if ( args.arg_count && !args.args )
+        {
+            LOGERROR ( "_string_format_append: Invalid argument: args. List is null, but count indicates it should contain %u element%s."
+                     , args.arg_count
+                     , ( args.arg_count > 1 ) ? "s" : ""
+                     );
+        }
+        return string;
+    }
+
+    state_t state;
+    state.format = format;
+    state.format_length = _string_length ( format );
+    state.args = args;
+    state.string = string;
+    state.dst = 0;
+    _string_format_run ( &state );
+    return state.string;
+}
+
+bool
+string_format_compile
+(   const char*                 format
+,   u64*                        memory_requirement_
+,   void*                       memory_
+,   string_format_template_t**  template_
+)
+{
+    if ( !format )
+    {
+        LOGERROR ( "string_format_compile: Missing argument: format." );
+        return false;
+    }
+
+    state_t state;
+    state.format = format;
+    state.format_length = _string_length ( format );
+    const u64 step_count = _string_format_compile ( &state , 0 );
+
+    const u64 memory_requirement = sizeof ( template_t )
+                                 + step_count * sizeof ( string_format_step_t )
+                                 + state.format_length + 1
+                                 ;
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    if ( !template_ )
+    {
+        LOGERROR ( "string_format_compile: Missing argument: template (output buffer)." );
+        return false;
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_uninit ( memory_requirement , MEMORY_TAG_STRING );
+    }
+    memory_clear ( memory , memory_requirement );
+
+    template_t* template = memory;
+    ( *template ).steps = ( void* )( ( ( u64 ) memory ) + sizeof ( template_t ) );
+    ( *template ).step_count = step_count;
+    ( *template ).memory_requirement = memory_requirement;
+    ( *template ).owns_memory = !memory_;
+
+    // Compile against the template's own copy of the formatting string, so the
+    // caller's copy need not outlive the template.
+    char* format_copy = ( void* )( ( ( u64 ) ( *template ).steps ) + step_count * sizeof ( string_format_step_t ) );
+    memory_copy ( format_copy , format , state.format_length );
+    format_copy[ state.format_length ] = 0;
+    ( *template ).format = format_copy;
+    ( *template ).format_length = state.format_length;
+
+    state.format = ( *template ).format;
+    _string_format_compile ( &state , ( *template ).steps );
+
+    *template_ = template;
+    return true;
+}
+
+void
+string_format_template_destroy
+(   string_format_template_t** template_
+)
+{
+    if ( !template_ || !( *template_ ) )
+    {
+        return;
+    }
+
+    template_t* template = *template_;
+    const u64 memory_requirement = ( *template ).memory_requirement;
+    if ( ( *template ).owns_memory )
+    {
+        memory_free ( template , memory_requirement , MEMORY_TAG_STRING );
+    }
+    else
+    {
+        memory_clear ( template , memory_requirement );
+    }
+
+    *template_ = 0;
+}
+
+char*
+_string_format_with
+(   const string_format_template_t* template
+,   args_t                          args
+)
+{
+    if ( !template || ( args.arg_count && !args.args ) )
+    {
+        if ( !template )
+        {
+            LOGERROR ( "_string_format_with: Missing argument: template." );
+        }
+        if ( args.arg_count && !args.args )
+        {
+            LOGERROR ( "_string_format_with: Invalid argument: args. List is null, but count indicates it should contain %u element%s."
+                     , args.arg_count
+                     , ( args.arg_count > 1 ) ? "s" : ""
+                     );
+        }
+        return string_create_from ( "" );
+    }
+
+    state_t state;
+    state.format = ( *( ( template_t* ) template ) ).format;
+    state.format_length = ( *( ( template_t* ) template ) ).format_length;
+    state.args = args;
+    state.string = _string_create ( state.format_length + 1 );
+    state.dst = 0;
+    _string_format_run_template ( &state , template );
+    return state.string;
+}
+
+u64
+_string_format_to_with
+(   char*                           dst
+,   const u64                       dst_capacity
+,   const string_format_template_t* template
+,   args_t                          args
+)
+{
+    if ( !dst || !dst_capacity || !template || ( args.arg_count && !args.args ) )
+    {
+        if ( !dst )
+        {
+            LOGERROR ( "_string_format_to_with: Missing argument: dst (output buffer)." );
+        }
+        if ( !dst_capacity )
+        {
+            LOGERROR ( "_string_format_to_with: Value of dst_capacity argument must be non-zero." );
+        }
+        if ( !template )
+        {
+            LOGERROR ( "_string_format_to_with: Missing argument: template." );
+        }
+        if ( args.arg_count && !args.args )
+        {
+            LOGERROR ( "_string_format_to_with: Invalid argument: args. List is null, but count indicates it should contain %u element%s."
+                     , args.arg_count
+                     , ( args.arg_count > 1 ) ? "s" : ""
+                     );
+        }
+        if ( dst && dst_capacity )
+        {
+            *dst = 0;
+        }
+        return 0;
+    }
+
+    state_t state;
+    state.format = ( *( ( template_t* ) template ) ).format;
+    state.format_length = ( *( ( template_t* ) template ) ).format_length;
+    state.args = args;
+    state.string = 0;
+    state.dst = dst;
+    state.dst_capacity = dst_capacity;
+    state.dst_length = 0;
+    _string_format_run_template ( &state , template );
+
+    // Append terminator.
+    dst[ MIN ( state.dst_length , dst_capacity - 1 ) ] = 0;
+    return state.dst_length;
+}
+
+char*
+_string_format_append_with
+(   char*                           string
+,   const string_format_template_t* template
+,   args_t                          args
+)
+{
+    if ( !string || !template || ( args.arg_count && !args.args ) )
+    {
+        if ( !string )
+        {
+            LOGERROR ( "_string_format_append_with: Missing argument: string." );
+        }
+        if ( !template )
+        {
+            LOGERROR ( "_string_format_append_with: Missing argument: template." );
+        }
+        if ( args.arg_count && !args.args )
+        {
+            LOGERROR ( "_string_format_append_with: Invalid argument: args. List is null, but count indicates it should contain %u element%s."
+                     , args.arg_count
+                     , ( args.arg_count > 1 ) ? "s" : ""
+                     );
+        }
+        return string;
+    }
+
+    state_t state;
+    state.format = ( *( ( template_t* ) template ) ).format;
+    state.format_length = ( *( ( template_t* ) template ) ).format_length;
+    state.args = args;
+    state.string = string;
+    state.dst = 0;
+    _string_format_run_template ( &state , template );
+    return state.string;
+}
+
+void
+_string_format_run
+(   state_t* state
+)
+{
+    ( *state ).next_arg = ( *state ).args.args;
+    ( *state ).args_remaining = ( *state ).args.arg_count;
+    ( *state ).buffer = 0;
+    ( *state ).buffer_length = 0;
+
+    const char* read = ( *state ).format;
+    ( *state ).copy_start = read;
     for (;;)
     {
-        if ( !state.args_remaining || read >= STRING_FORMAT_READ_LIMIT ( &state ) )
+        if ( !( *state ).args_remaining || read >= STRING_FORMAT_READ_LIMIT ( state ) )
         {
             break;
         }
@@ -257,21 +803,21 @@ _string_format
         }
         
         string_format_specifier_t format_specifier;
-        _string_format_validate_format_specifier ( &state
+        _string_format_validate_format_specifier ( state
                                                  , read + 1
                                                  , &format_specifier
                                                  );
                                                  
         if ( format_specifier.tag == STRING_FORMAT_SPECIFIER_INVALID )
         {
-            if ( state.args_remaining )
+            if ( ( *state ).args_remaining )
             {
                 LOGWARN ( "_string_format: Illegal format specifier encountered on index %i of the formatting string. Skipping argument %i.\n\t                `%s`"
-                        , read - state.format
-                        , state.args.arg_count - state.args_remaining + 1
-                        , state.format
+                        , read - ( *state ).format
+                        , ( *state ).args.arg_count - ( *state ).args_remaining + 1
+                        , ( *state ).format
                         );
-                _string_format_consume_next_argument ( &state );
+                _string_format_consume_next_argument ( state );
             }
             read += 1;
             continue;
@@ -279,32 +825,147 @@ _string_format
 
         if ( format_specifier.tag == STRING_FORMAT_SPECIFIER_IGNORE )
         {
-            string_push ( state.string
-                        , string_char ( STRING_FORMAT_SPECIFIER_TOKEN_IGNORE )
-                        , 1
-                        );
+            _string_format_write ( state
+                                 , string_char ( STRING_FORMAT_SPECIFIER_TOKEN_IGNORE )
+                                 , 1
+                                 );
             read += 2;
             continue;
         }
         
-        state.copy_end = read;
-        string_push ( state.string
-                    , state.copy_start
-                    , STRING_FORMAT_COPY_SIZE ( &state )
-                    );
-        state.copy_start = state.copy_end + format_specifier.length;
-
-        _string_format_parse_next_argument ( &state , &format_specifier );
+        ( *state ).copy_end = read;
+        _string_format_write ( state
+                             , ( *state ).copy_start
+                             , STRING_FORMAT_COPY_SIZE ( state )
+                             );
+        ( *state ).copy_start = ( *state ).copy_end + format_specifier.length;
+
+        _string_format_parse_next_argument ( state , &format_specifier );
         read += 1;
     }
 
-    state.copy_end = STRING_FORMAT_READ_LIMIT ( &state );
-    string_push ( state.string
-                , state.copy_start
-                , STRING_FORMAT_COPY_SIZE ( &state )
-                );
-                
-    return state.string;
+    ( *state ).copy_end = STRING_FORMAT_READ_LIMIT ( state );
+    _string_format_write ( state
+                         , ( *state ).copy_start
+                         , STRING_FORMAT_COPY_SIZE ( state )
+                         );
+}
+
+u64
+_string_format_compile
+(   state_t*                state
+,   string_format_step_t*   steps
+)
+{
+    // Same traversal as _string_format_run, except it never runs out of
+    // arguments.
+    u64 count = 0;
+    u64 copy_start = 0;
+    const char* read = ( *state ).format;
+    while ( read < STRING_FORMAT_READ_LIMIT ( state ) )
+    {
+        if ( *read != STRING_FORMAT_SPECIFIER_TOKEN_ID )
+        {
+            read += 1;
+            continue;
+        }
+
+        string_format_specifier_t format_specifier;
+        _string_format_validate_format_specifier ( state
+                                                 , read + 1
+                                                 , &format_specifier
+                                                 );
+
+        STRING_FORMAT_STEP tag;
+        u64 advance;
+        if ( format_specifier.tag == STRING_FORMAT_SPECIFIER_INVALID )
+        {
+            tag = STRING_FORMAT_STEP_INVALID;
+            advance = 1;
+        }
+        else if ( format_specifier.tag == STRING_FORMAT_SPECIFIER_IGNORE )
+        {
+            tag = STRING_FORMAT_STEP_IGNORE;
+            advance = 2;
+        }
+        else
+        {
+            tag = STRING_FORMAT_STEP_SPECIFIER;
+            advance = 1;
+            copy_start = read - ( *state ).format + format_specifier.length;
+        }
+
+        if ( steps )
+        {
+            steps[ count ].tag = tag;
+            steps[ count ].read = read - ( *state ).format;
+            steps[ count ].copy_start = copy_start;
+            steps[ count ].format_specifier = format_specifier;
+        }
+        count += 1;
+        read += advance;
+    }
+    return count;
+}
+
+void
+_string_format_run_template
+(   state_t*            state
+,   const template_t*   template
+)
+{
+    ( *state ).next_arg = ( *state ).args.args;
+    ( *state ).args_remaining = ( *state ).args.arg_count;
+    ( *state ).copy_start = ( *state ).format;
+    ( *state ).buffer = 0;
+    ( *state ).buffer_length = 0;
+
+    // Replays _string_format_run step by step. The only decision left to make
+    // at runtime is whether the arguments have run out.
+    for ( u64 i = 0; i < ( *template ).step_count && ( *state ).args_remaining; ++i )
+    {
+        const string_format_step_t* step = &( *template ).steps[ i ];
+        switch ( ( *step ).tag )
+        {
+            case STRING_FORMAT_STEP_INVALID:
+            {
+                LOGWARN ( "_string_format: Illegal format specifier encountered on index %i of the formatting string. Skipping argument %i.\n\t                `%s`"
+                        , ( *step ).read
+                        , ( *state ).args.arg_count - ( *state ).args_remaining + 1
+                        , ( *state ).format
+                        );
+                _string_format_consume_next_argument ( state );
+                break;
+            }
+
+            case STRING_FORMAT_STEP_IGNORE:
+            {
+                _string_format_write ( state
+                                     , string_char ( STRING_FORMAT_SPECIFIER_TOKEN_IGNORE )
+                                     , 1
+                                     );
+                break;
+            }
+
+            case STRING_FORMAT_STEP_SPECIFIER:
+            {
+                ( *state ).copy_end = ( *state ).format + ( *step ).read;
+                _string_format_write ( state
+                                     , ( *state ).copy_start
+                                     , STRING_FORMAT_COPY_SIZE ( state )
+                                     );
+                ( *state ).copy_start = ( *state ).format + ( *step ).copy_start;
+                _string_format_parse_next_argument ( state , &( *step ).format_specifier );
+                break;
+            }
+        }
+    }
+
+    ( *state ).copy_end = STRING_FORMAT_READ_LIMIT ( state );
+    _string_format_write ( state
+                         , ( *state ).copy_start
+                         , STRING_FORMAT_COPY_SIZE ( state )
+                         );
 }
 
 void
@@ -342,6 +1003,7 @@ _string_format_validate_format_specifier
     ( *format_specifier ).fix_precision.tag = false;
     ( *format_specifier ).fix_precision.precision = 6;
     ( *format_specifier ).container.tag = STRING_FORMAT_CONTAINER_NONE;
+    ( *format_specifier ).container.limit = 0;
 
     switch ( *read )
     {
@@ -411,6 +1073,30 @@ _string_format_validate_format_specifier
             ( *format_specifier ).length = read - read_ + 1;
             return;
         }
+        case STRING_FORMAT_SPECIFIER_TOKEN_STRING_VIEW:
+        {
+            _string_format_validate_format_specifier_string_view ( state , &read , format_specifier );
+            ( *format_specifier ).length = read - read_ + 1;
+            return;
+        }
+        case STRING_FORMAT_SPECIFIER_TOKEN_HEX:
+        {
+            _string_format_validate_format_specifier_hex ( state , &read , format_specifier );
+            ( *format_specifier ).length = read - read_ + 1;
+            return;
+        }
+        case STRING_FORMAT_SPECIFIER_TOKEN_HEX_UPPERCASE:
+        {
+            _string_format_validate_format_specifier_hex_uppercase ( state , &read , format_specifier );
+            ( *format_specifier ).length = read - read_ + 1;
+            return;
+        }
+        case STRING_FORMAT_SPECIFIER_TOKEN_BASE64:
+        {
+            _string_format_validate_format_specifier_base64 ( state , &read , format_specifier );
+            ( *format_specifier ).length = read - read_ + 1;
+            return;
+        }
     }
 
     for ( STRING_FORMAT_MODIFIER i = 0; i < STRING_FORMAT_MODIFIER_COUNT; ++i )
@@ -519,6 +1205,30 @@ _string_format_validate_format_specifier
                 ( *format_specifier ).length = read - read_ + 1;
                 return;
             }
+            case STRING_FORMAT_SPECIFIER_TOKEN_STRING_VIEW:
+            {
+                _string_format_validate_format_specifier_string_view ( state , &read , format_specifier );
+                ( *format_specifier ).length = read - read_ + 1;
+                return;
+            }
+            case STRING_FORMAT_SPECIFIER_TOKEN_HEX:
+            {
+                _string_format_validate_format_specifier_hex ( state , &read , format_specifier );
+                ( *format_specifier ).length = read - read_ + 1;
+                return;
+            }
+            case STRING_FORMAT_SPECIFIER_TOKEN_HEX_UPPERCASE:
+            {
+                _string_format_validate_format_specifier_hex_uppercase ( state , &read , format_specifier );
+                ( *format_specifier ).length = read - read_ + 1;
+                return;
+            }
+            case STRING_FORMAT_SPECIFIER_TOKEN_BASE64:
+            {
+                _string_format_validate_format_specifier_base64 ( state , &read , format_specifier );
+                ( *format_specifier ).length = read - read_ + 1;
+                return;
+            }
         }
     }
     ( *format_specifier ).tag = STRING_FORMAT_SPECIFIER_INVALID;
@@ -645,6 +1355,50 @@ _string_format_validate_format_specifier_resizable_string
     *read += 1;
 }
 
+void
+_string_format_validate_format_specifier_string_view
+(   state_t*                    state
+,   const char**                read
+,   string_format_specifier_t*  format_specifier
+)
+{
+    ( *format_specifier ).tag = STRING_FORMAT_SPECIFIER_STRING_VIEW;
+    *read += 1;
+}
+
+void
+_string_format_validate_format_specifier_hex
+(   state_t*                    state
+,   const char**                read
+,   string_format_specifier_t*  format_specifier
+)
+{
+    ( *format_specifier ).tag = STRING_FORMAT_SPECIFIER_HEX;
+    *read += 1;
+}
+
+void
+_string_format_validate_format_specifier_hex_uppercase
+(   state_t*                    state
+,   const char**                read
+,   string_format_specifier_t*  format_specifier
+)
+{
+    ( *format_specifier ).tag = STRING_FORMAT_SPECIFIER_HEX_UPPERCASE;
+    *read += 1;
+}
+
+void
+_string_format_validate_format_specifier_base64
+(   state_t*                    state
+,   const char**                read
+,   string_format_specifier_t*  format_specifier
+)
+{
+    ( *format_specifier ).tag = STRING_FORMAT_SPECIFIER_BASE64;
+    *read += 1;
+}
+
 void
 _string_format_validate_format_modifier_pad
 (   state_t*                    state
@@ -796,6 +1550,7 @@ _string_format_validate_format_modifier_array
     ( *format_specifier ).container.tag = STRING_FORMAT_CONTAINER_ARRAY;
     ( *format_specifier ).modifiers[ STRING_FORMAT_MODIFIER_ARRAY ] = true;
     *read += 1;
+    _string_format_validate_format_modifier_container_limit ( state , read , format_specifier );
 }
 
 void
@@ -815,6 +1570,37 @@ _string_format_validate_format_modifier_queue
     ( *format_specifier ).container.tag = STRING_FORMAT_CONTAINER_QUEUE;
     ( *format_specifier ).modifiers[ STRING_FORMAT_MODIFIER_QUEUE ] = true;
     *read += 1;
+    _string_format_validate_format_modifier_container_limit ( state , read , format_specifier );
+}
+
+void
+_string_format_validate_format_modifier_container_limit
+(   state_t*                    state
+,   const char**                read
+,   string_format_specifier_t*  format_specifier
+)
+{
+    if ( *read >= STRING_FORMAT_READ_LIMIT ( state ) || !digit ( **read ) )
+    {
+        return;
+    }
+    u64 limit = to_digit ( **read );
+    if ( !limit )
+    {
+        ( *format_specifier ).tag = STRING_FORMAT_SPECIFIER_INVALID;
+        return;
+    }
+    *read += 1;
+    while ( *read < STRING_FORMAT_READ_LIMIT ( state ) )
+    {
+        if ( !digit ( **read ) )
+        {
+            break;
+        }
+        limit = limit * 10 + to_digit ( **read );
+        *read += 1;
+    }
+    ( *format_specifier ).container.limit = limit;
 }
 
 void
@@ -826,12 +1612,7 @@ _string_format_parse_next_argument
     const arg_t arg = *( ( *state ).next_arg );
     if ( ( *format_specifier ).container.tag != STRING_FORMAT_CONTAINER_NONE )
     {
-        switch ( ( *format_specifier ).container.tag )
-        {
-            case STRING_FORMAT_CONTAINER_ARRAY:     _string_format_parse_argument_array ( state , format_specifier , ( void* ) arg )            ;break;
-            case STRING_FORMAT_CONTAINER_QUEUE:     _string_format_parse_argument_queue ( state , format_specifier , ( queue_t* ) arg )         ;break;
-            default:                                                                                                                             break;
-        }
+        _string_format_parse_argument_container ( state , format_specifier , ( const void* ) arg );
     }
     else
     {
@@ -847,6 +1628,10 @@ _string_format_parse_next_argument
             case STRING_FORMAT_SPECIFIER_ADDRESS:                        _string_format_parse_argument_address ( state , format_specifier , ( const void* ) arg )                       ;break;
             case STRING_FORMAT_SPECIFIER_STRING:                         _string_format_parse_argument_string ( state , format_specifier , ( const char* ) arg )                        ;break;
             case STRING_FORMAT_SPECIFIER_RESIZABLE_STRING:               _string_format_parse_argument_resizable_string ( state , format_specifier , ( const char* ) arg )              ;break;
+            case STRING_FORMAT_SPECIFIER_STRING_VIEW:                    _string_format_parse_argument_string_view ( state , format_specifier , ( const string_view_t* ) arg )          ;break;
+            case STRING_FORMAT_SPECIFIER_HEX:
+            case STRING_FORMAT_SPECIFIER_HEX_UPPERCASE:
+            case STRING_FORMAT_SPECIFIER_BASE64:                         _string_format_parse_argument_bytes ( state , format_specifier , ( const string_view_t* ) arg )                ;break;
             default:                                                                                                                                                                    ;break;
         }
     }
@@ -863,7 +1648,7 @@ _string_format_parse_argument_raw
     char string[ 65 ];
     const u8 radix = 10;
     const u64 string_length = string_u64 ( arg , radix , string );
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , string
                                , string_length
                                , format_specifier
@@ -901,16 +1686,13 @@ _string_format_parse_argument_integer
     {
         string_length = string_i64 ( arg , radix , string );
     }
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , string
                                , string_length
                                , format_specifier
                                );
 }
 
-// TODO: Implement everything beneath this dependency to remove it.
-#include <stdio.h>
-
 u64
 _string_format_parse_argument_floating_point
 (   state_t*                            state
@@ -927,86 +1709,29 @@ _string_format_parse_argument_floating_point
     }
 
     char string[ STRING_FORMAT_MAX_FLOATING_POINT_STRING_LENGTH ];
-    const char* format;
-    if ( ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_NONE )
-    {
-        if ( ( *format_specifier ).fix_precision.tag )
-        {
-            switch ( ( *format_specifier ).fix_precision.precision )
-            {
-                case 0:  format = "%.0lf" ;break;
-                case 1:  format = "%.1lf" ;break;
-                case 2:  format = "%.2lf" ;break;
-                case 3:  format = "%.3lf" ;break;
-                case 4:  format = "%.4lf" ;break;
-                case 5:  format = "%.5lf" ;break;
-                case 6:  format = "%.6lf" ;break;
-                case 7:  format = "%.7lf" ;break;
-                case 8:  format = "%.8lf" ;break;
-                case 9:  format = "%.9lf" ;break;
-                default: format = "%.lf"  ;break;
-            }
-        }
-        else
-        {
-            format = "%lf";
-        }
-    }
-    else
-    {
-        if ( ( *format_specifier ).fix_precision.tag )
-        {
-            switch ( ( *format_specifier ).fix_precision.precision )
-            {
-                case 0:  format = "%+.0lf" ;break;
-                case 1:  format = "%+.1lf" ;break;
-                case 2:  format = "%+.2lf" ;break;
-                case 3:  format = "%+.3lf" ;break;
-                case 4:  format = "%+.4lf" ;break;
-                case 5:  format = "%+.5lf" ;break;
-                case 6:  format = "%+.6lf" ;break;
-                case 7:  format = "%+.7lf" ;break;
-                case 8:  format = "%+.8lf" ;break;
-                case 9:  format = "%+.9lf" ;break;
-                default: format = "%+.lf"  ;break;
-            }
-        }
-        else
-        {
-            format = "%+lf";
-        }
-    }
-
     f64 value = *arg;
     u64 integer = value;
     f64 fractional = value - integer;
-    i32 snprintf_result = snprintf ( string
-                                   , STRING_FORMAT_MAX_FLOATING_POINT_STRING_LENGTH
-                                   , format
-                                   , value
-                                   );
-    if ( ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_HIDE )
-    {
-        snprintf_result -= 1;
-        memory_move ( string , string + 1 , snprintf_result );
-        string[ snprintf_result ] = 0; // Append terminator.
-    }
+    u64 string_length = _string_format_stringify_f64 ( string
+                                                     , value
+                                                     , false
+                                                     , format_specifier
+                                                     );
     if ( !fractional )
     {
         u64 index;
-        if ( string_contains ( string , snprintf_result
-                            , string_char ( '.' ) , 1
-                            , false
-                            , &index
-                            ))
+        if ( string_contains ( string , string_length
+                             , string_char ( '.' ) , 1
+                             , false
+                             , &index
+                             ))
         {
-            snprintf_result = index;
-            string[ snprintf_result ] = 0;
+            string_length = index;
         }
     }
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , string
-                               , snprintf_result
+                               , string_length
                                , format_specifier
                                );
 }
@@ -1027,152 +1752,42 @@ _string_format_parse_argument_floating_point_show_fractional
     }
 
     char string[ STRING_FORMAT_MAX_FLOATING_POINT_STRING_LENGTH ];
-    const char* format;
-    if ( ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_NONE )
-    {
-        if ( ( *format_specifier ).fix_precision.tag )
-        {
-            switch ( ( *format_specifier ).fix_precision.precision )
-            {
-                case 0:  format = "%.0lf" ;break;
-                case 1:  format = "%.1lf" ;break;
-                case 2:  format = "%.2lf" ;break;
-                case 3:  format = "%.3lf" ;break;
-                case 4:  format = "%.4lf" ;break;
-                case 5:  format = "%.5lf" ;break;
-                case 6:  format = "%.6lf" ;break;
-                case 7:  format = "%.7lf" ;break;
-                case 8:  format = "%.8lf" ;break;
-                case 9:  format = "%.9lf" ;break;
-                default: format = "%.lf"  ;break;
-            }
-        }
-        else
-        {
-            format = "%lf";
-        }
-    }
-    else
-    {
-        if ( ( *format_specifier ).fix_precision.tag )
-        {
-            switch ( ( *format_specifier ).fix_precision.precision )
-            {
-                case 0:  format = "%+.0lf" ;break;
-                case 1:  format = "%+.1lf" ;break;
-                case 2:  format = "%+.2lf" ;break;
-                case 3:  format = "%+.3lf" ;break;
-                case 4:  format = "%+.4lf" ;break;
-                case 5:  format = "%+.5lf" ;break;
-                case 6:  format = "%+.6lf" ;break;
-                case 7:  format = "%+.7lf" ;break;
-                case 8:  format = "%+.8lf" ;break;
-                case 9:  format = "%+.9lf" ;break;
-                default: format = "%+.lf"  ;break;
-            }
-        }
-        else
-        {
-            format = "%+lf";
-        }
-    }
-    i32 snprintf_result = snprintf ( string
-                                   , STRING_FORMAT_MAX_FLOATING_POINT_STRING_LENGTH
-                                   , format
-                                   , *arg
-                                   );
-    if ( ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_HIDE )
-    {
-        snprintf_result -= 1;
-        memory_move ( string , string + 1 , snprintf_result );
-        string[ snprintf_result ] = 0; // Append terminator.
-    }
-    return _string_format_push ( &( *state ).string
+    const u64 string_length = _string_format_stringify_f64 ( string
+                                                           , *arg
+                                                           , false
+                                                           , format_specifier
+                                                           );
+    return _string_format_push ( state
                                , string
-                               , snprintf_result
+                               , string_length
                                , format_specifier
                                );
 }
 
 u64
-_string_format_parse_argument_floating_point_abbreviated
-(   state_t*                            state
-,   const string_format_specifier_t*    format_specifier
-,   const f64*                          arg
-)
-{
-    if ( !arg )
-    {
-        return _string_format_parse_argument_string ( state
-                                                    , format_specifier
-                                                    , ( const char* ) arg
-                                                    );
-    }
-
-    char string[ STRING_FORMAT_MAX_FLOATING_POINT_ABBREVIATED_STRING_LENGTH ];
-    const char* format;
-    if ( ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_NONE )
-    {
-        if ( ( *format_specifier ).fix_precision.tag )
-        {
-            switch ( ( *format_specifier ).fix_precision.precision )
-            {
-                case 0:  format = "%.0E" ;break;
-                case 1:  format = "%.1E" ;break;
-                case 2:  format = "%.2E" ;break;
-                case 3:  format = "%.3E" ;break;
-                case 4:  format = "%.4E" ;break;
-                case 5:  format = "%.5E" ;break;
-                case 6:  format = "%.6E" ;break;
-                case 7:  format = "%.7E" ;break;
-                case 8:  format = "%.8E" ;break;
-                case 9:  format = "%.9E" ;break;
-                default: format = "%.E"  ;break;
-            }
-        }
-        else
-        {
-            format = "%E";
-        }
-    }
-    else
-    {
-        if ( ( *format_specifier ).fix_precision.tag )
-        {
-            switch ( ( *format_specifier ).fix_precision.precision )
-            {
-                case 0:  format = "%+.0E" ;break;
-                case 1:  format = "%+.1E" ;break;
-                case 2:  format = "%+.2E" ;break;
-                case 3:  format = "%+.3E" ;break;
-                case 4:  format = "%+.4E" ;break;
-                case 5:  format = "%+.5E" ;break;
-                case 6:  format = "%+.6E" ;break;
-                case 7:  format = "%+.7E" ;break;
-                case 8:  format = "%+.8E" ;break;
-                case 9:  format = "%+.9E" ;break;
-                default: format = "%+.E"  ;break;
-            }
-        }
-        else
-        {
-            format = "%+E";
-        }
-    }
-    i32 snprintf_result = snprintf ( string
-                                   , STRING_FORMAT_MAX_FLOATING_POINT_ABBREVIATED_STRING_LENGTH
-                                   , format
-                                   , *arg
-                                   );
-    if ( ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_HIDE )
+_string_format_parse_argument_floating_point_abbreviated
+(   state_t*                            state
+,   const string_format_specifier_t*    format_specifier
+,   const f64*                          arg
+)
+{
+    if ( !arg )
     {
-        snprintf_result -= 1;
-        memory_move ( string , string + 1 , snprintf_result );
-        string[ snprintf_result ] = 0; // Append terminator.
+        return _string_format_parse_argument_string ( state
+                                                    , format_specifier
+                                                    , ( const char* ) arg
+                                                    );
     }
-    return _string_format_push ( &( *state ).string
+
+    char string[ STRING_FORMAT_MAX_FLOATING_POINT_ABBREVIATED_STRING_LENGTH ];
+    const u64 string_length = _string_format_stringify_f64 ( string
+                                                           , *arg
+                                                           , true
+                                                           , format_specifier
+                                                           );
+    return _string_format_push ( state
                                , string
-                               , snprintf_result
+                               , string_length
                                , format_specifier
                                );
 }
@@ -1193,55 +1808,61 @@ _string_format_parse_argument_floating_point_fractional_only
     }
 
     char string[ STRING_FORMAT_MAX_FLOATING_POINT_STRING_LENGTH ];
-    const char* format;
-    if ( ( *format_specifier ).fix_precision.tag )
-    {
-        switch ( ( *format_specifier ).fix_precision.precision )
-        {
-            case 0:  format = "%.0lf" ;break;
-            case 1:  format = "%.1lf" ;break;
-            case 2:  format = "%.2lf" ;break;
-            case 3:  format = "%.3lf" ;break;
-            case 4:  format = "%.4lf" ;break;
-            case 5:  format = "%.5lf" ;break;
-            case 6:  format = "%.6lf" ;break;
-            case 7:  format = "%.7lf" ;break;
-            case 8:  format = "%.8lf" ;break;
-            case 9:  format = "%.9lf" ;break;
-            default: format = "%.lf"  ;break;
-        }
-    }
-    else
-    {
-        format = "%lf";
-    }
-    i32 snprintf_result = snprintf ( string
-                                   , STRING_FORMAT_MAX_FLOATING_POINT_STRING_LENGTH
-                                   , format
-                                   , *arg
-                                   );
+    const u8 precision = ( ( *format_specifier ).fix_precision.tag ) ? ( *format_specifier ).fix_precision.precision
+                                                                     : STRING_FORMAT_DEFAULT_FLOATING_POINT_PRECISION
+                                                                     ;
+    u64 string_length = string_f64 ( *arg , precision , false , string );
     u64 index;
-    if ( string_contains ( string , snprintf_result
+    if ( string_contains ( string , string_length
                          , string_char ( '.' ) , 1
                          , false
                          , &index
                          ))
     {
         index += 1;
-        snprintf_result -= index;
+        string_length -= index;
         memory_move ( string
                     , string + index
-                    , snprintf_result
+                    , string_length
                     );
-        string[ snprintf_result ] = 0;
     }
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , string
-                               , snprintf_result
+                               , string_length
                                , format_specifier
                                );
 }
-// END <stdio.h> DEPENDENCY.
+
+u64
+_string_format_stringify_f64
+(   char*                               dst
+,   const f64                           value
+,   const bool                          abbreviated
+,   const string_format_specifier_t*    format_specifier
+)
+{
+    const u8 precision = ( ( *format_specifier ).fix_precision.tag ) ? ( *format_specifier ).fix_precision.precision
+                                                                     : STRING_FORMAT_DEFAULT_FLOATING_POINT_PRECISION
+                                                                     ;
+    const bool show_sign = ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_SHOW;
+    u64 length = string_f64 ( value , precision , abbreviated , dst + show_sign );
+    if ( !show_sign )
+    {
+        if ( ( *format_specifier ).sign.tag == STRING_FORMAT_SIGN_HIDE && *dst == '-' )
+        {
+            length -= 1;
+            memory_move ( dst , dst + 1 , length );
+        }
+        return length;
+    }
+    if ( dst[ 1 ] == '-' )
+    {
+        memory_move ( dst , dst + 1 , length );
+        return length;
+    }
+    *dst = '+';
+    return length + 1;
+}
 
 u64
 _string_format_parse_argument_address
@@ -1260,7 +1881,7 @@ _string_format_parse_argument_address
                                          )
                             + _string_length ( prefix )
                             ;
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , string
                                , string_length
                                , format_specifier
@@ -1278,7 +1899,7 @@ _string_format_parse_argument_character
     {
         return 0;
     }
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , &arg
                                , 1
                                , format_specifier
@@ -1294,7 +1915,7 @@ _string_format_parse_argument_string
 {
     const char* string = arg ? arg : "";
     const u64 length = _string_length ( string );
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , string
                                , length
                                , format_specifier
@@ -1317,7 +1938,7 @@ _string_format_parse_argument_resizable_string
     }
 
     const u64 length = string_length ( arg );
-    return _string_format_push ( &( *state ).string
+    return _string_format_push ( state
                                , arg
                                , length
                                , format_specifier
@@ -1325,340 +1946,309 @@ _string_format_parse_argument_resizable_string
 }
 
 u64
-_string_format_parse_argument_array
+_string_format_parse_argument_string_view
 (   state_t*                            state
 ,   const string_format_specifier_t*    format_specifier
-,   const array_t*                      arg
+,   const string_view_t*                arg
 )
 {
-    const u64 old_length = string_length ( ( *state ).string );
-    const u64 array_length = array_length ( arg );
-    const u64 array_stride = array_stride ( arg );
+    if ( !arg )
+    {
+        return _string_format_parse_argument_string ( state
+                                                    , format_specifier
+                                                    , 0
+                                                    );
+    }
 
-    _string_push ( ( *state ).string , "{ " );
+    return _string_format_push ( state
+                               , ( *arg ).string
+                               , ( *arg ).length
+                               , format_specifier
+                               );
+}
 
-    for ( u64 i = 0; i < array_length; ++i )
+u64
+_string_format_parse_argument_bytes
+(   state_t*                            state
+,   const string_format_specifier_t*    format_specifier
+,   const string_view_t*                arg
+)
+{
+    if ( !arg )
     {
-        _string_push ( ( *state ).string , "`" );
+        return _string_format_parse_argument_string ( state
+                                                    , format_specifier
+                                                    , 0
+                                                    );
+    }
 
-        // Retrieve the array element address.
-        const void* element = ( const void* )( ( ( u64 ) arg )
-                                             + i * array_stride
-                                             );
-        
-        // Attempt to parse address value according to the format specifier and array stride.
-        // TODO: Improve this. Fails if array stride does not correspond to provided format specifier.
-        switch ( ( *format_specifier ).tag )
+    // As _string_format_push, but the bytes are encoded as they are written,
+    // so the encoded string is never stored in full.
+    const u64 length = ( ( *format_specifier ).tag == STRING_FORMAT_SPECIFIER_BASE64 )
+                     ? STRING_BASE64_LENGTH ( ( *arg ).length )
+                     : STRING_HEX_LENGTH ( ( *arg ).length )
+                     ;
+    if ( ( *format_specifier ).padding.tag == STRING_FORMAT_PADDING_NONE )
+    {
+        _string_format_write_bytes ( state , ( *arg ).string , ( *arg ).length , length , format_specifier );
+        return length;
+    }
+    if ( ( *format_specifier ).padding.length <= length )
+    {
+        const u64 limit = ( ( *format_specifier ).padding.fixed ) ? ( *format_specifier ).padding.length
+                                                                  : length
+                                                                  ;
+        _string_format_write_bytes ( state , ( *arg ).string , ( *arg ).length , limit , format_specifier );
+        return limit;
+    }
+    const u64 pad_length = ( *format_specifier ).padding.length - length;
+    if ( ( *format_specifier ).padding.tag == STRING_FORMAT_PADDING_LEFT )
+    {
+        for ( u64 pad = pad_length; pad; --pad )
         {
-            case STRING_FORMAT_SPECIFIER_RAW:
-            {
-                u64 value;
-                switch ( array_stride )
-                {
-                    case sizeof ( u8 ):  value = *( ( u8* ) element )  ;break;
-                    case sizeof ( u16 ): value = *( ( u16* ) element ) ;break;
-                    case sizeof ( u32 ): value = *( ( u32* ) element ) ;break;
-                    case sizeof ( u64 ): value = *( ( u64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_raw ( state , format_specifier , value );
-            }
-            break;
-
-            case STRING_FORMAT_SPECIFIER_CHARACTER:
-            {
-                const char value = *( ( char* ) element );
-                _string_format_parse_argument_character ( state , format_specifier , value );
-            }
-            break;
-
-            case STRING_FORMAT_SPECIFIER_INTEGER:
-            {
-                i64 value;
-                switch ( array_stride )
-                {
-                    case sizeof ( i8 ):  value = *( ( i8* ) element )  ;break;
-                    case sizeof ( i16 ): value = *( ( i16* ) element ) ;break;
-                    case sizeof ( i32 ): value = *( ( i32* ) element ) ;break;
-                    case sizeof ( i64 ): value = *( ( i64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_integer ( state , format_specifier , value );
-            }
-            break;
+            _string_format_write ( state , &( *format_specifier ).padding.value , 1 );
+        }
+    }
+    _string_format_write_bytes ( state , ( *arg ).string , ( *arg ).length , length , format_specifier );
+    if ( ( *format_specifier ).padding.tag == STRING_FORMAT_PADDING_RIGHT )
+    {
+        for ( u64 pad = pad_length; pad; --pad )
+        {
+            _string_format_write ( state , &( *format_specifier ).padding.value , 1 );
+        }
+    }
+    return ( *format_specifier ).padding.length;
+}
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT:
-            {
-                f64 value;
-                switch ( array_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point ( state , format_specifier , &value );
-            }
-            break;
+u64
+_string_format_parse_argument_container
+(   state_t*                            state
+,   const string_format_specifier_t*    format_specifier
+,   const void*                         arg
+)
+{
+    const bool queue = ( *format_specifier ).container.tag == STRING_FORMAT_CONTAINER_QUEUE;
+    const u64 length = ( queue ) ? queue_length ( arg ) : array_length ( arg );
+    const u64 stride = ( queue ) ? queue_stride ( arg ) : array_stride ( arg );
+    const u64 count = ( ( *format_specifier ).container.limit ) ? MIN ( length , ( *format_specifier ).container.limit )
+                                                                 : length
+                                                                 ;
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT_SHOW_FRACTIONAL:
-            {
-                f64 value;
-                switch ( array_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point_show_fractional ( state , format_specifier , &value );
-            }
-            break;
+    // Stage the output, so that it grows a chunk at a time rather than a few
+    // characters at a time.
+    char buffer[ STRING_FORMAT_CONTAINER_BUFFER_SIZE ];
+    ( *state ).buffer = buffer;
+    ( *state ).buffer_length = 0;
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT_ABBREVIATED:
-            {
-                f64 value;
-                switch ( array_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point_abbreviated ( state , format_specifier , &value );
-            }
-            break;
+    const u64 old_length = _string_format_written ( state );
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT_FRACTIONAL_ONLY:
-            {
-                f64 value;
-                switch ( array_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point_fractional_only ( state , format_specifier , &value );
-            }
-            break;
+    _string_format_write_string ( state , "{ " );
 
-            case STRING_FORMAT_SPECIFIER_ADDRESS:
-            {
-                void* value;
-                switch ( array_stride )
-                {
-                    case sizeof ( void* ): value = *( ( void** ) element );break;
-                    default:               value = 0                      ;break;
-                }
-                _string_format_parse_argument_address ( state , format_specifier , value );
-            }
-            break;
+    for ( u64 i = 0; i < count; ++i )
+    {
+        _string_format_write_string ( state , ( i ) ? ", `" : "`" );
 
-            case STRING_FORMAT_SPECIFIER_STRING:
-            {
-                char* value;
-                switch ( array_stride )
-                {
-                    case sizeof ( char* ): value = *( ( char** ) element );break;
-                    default:               value = 0                      ;break;
-                }
-                _string_format_parse_argument_string ( state , format_specifier , value );
-            }
-            break;
+        // Retrieve the element address.
+        const void* element = ( queue ) ? queue_element ( arg , i )
+                                        : ( const void* )( ( ( u64 ) arg ) + i * stride )
+                                        ;
+        _string_format_parse_argument_element ( state , format_specifier , element , stride );
 
-            case STRING_FORMAT_SPECIFIER_RESIZABLE_STRING:
-            {
-                char* value;
-                switch ( array_stride )
-                {
-                    case sizeof ( char* ): value = *( ( char** ) element );break;
-                    default:               value = 0                      ;break;
-                }
-                _string_format_parse_argument_resizable_string ( state , format_specifier , value );
-            }
-            break;
-            
-            default:
-            {}
-            break;
-        }
+        _string_format_write_string ( state , "`" );
+    }
 
-        _string_push ( ( *state ).string
-                     , ( i < array_length - 1 ) ? "`, " : "`"
-                     );
+    // Elide the elements beyond the limit.
+    if ( count < length )
+    {
+        char remaining[ STRING_INTEGER_MAX_LENGTH ];
+        _string_format_write_string ( state , ", ... (" );
+        _string_format_write ( state , remaining , string_u64 ( length - count , 10 , remaining ) );
+        _string_format_write_string ( state , " more)" );
     }
 
-    _string_push ( ( *state ).string , " }" );
+    _string_format_write_string ( state , " }" );
 
-    return string_length ( ( *state ).string ) - old_length;
+    const u64 written = _string_format_written ( state ) - old_length;
+    _string_format_flush ( state );
+    ( *state ).buffer = 0;
+    return written;
 }
 
 u64
-_string_format_parse_argument_queue
+_string_format_parse_argument_element
 (   state_t*                            state
 ,   const string_format_specifier_t*    format_specifier
-,   const queue_t*                      arg
+,   const void*                         element
+,   const u64                           stride
 )
 {
-    const u64 old_length = string_length ( ( *state ).string );
-    const u64 queue_length = queue_length ( arg );
-    const u64 queue_stride = queue_stride ( arg );
+    const u64 old_length = _string_format_written ( state );
 
-    _string_push ( ( *state ).string , "{ " );
-
-    for ( u64 i = 0; i < queue_length ( arg ); ++i )
+    // Attempt to parse address value according to the format specifier and stride.
+    // TODO: Improve this. Fails if stride does not correspond to provided format specifier.
+    switch ( ( *format_specifier ).tag )
     {
-        _string_push ( ( *state ).string , "`" );
+        case STRING_FORMAT_SPECIFIER_RAW:
+        {
+            u64 value;
+            switch ( stride )
+            {
+                case sizeof ( u8 ):  value = *( ( u8* ) element )  ;break;
+                case sizeof ( u16 ): value = *( ( u16* ) element ) ;break;
+                case sizeof ( u32 ): value = *( ( u32* ) element ) ;break;
+                case sizeof ( u64 ): value = *( ( u64* ) element ) ;break;
+                default:             value = 0                     ;break;
+            }
+            _string_format_parse_argument_raw ( state , format_specifier , value );
+        }
+        break;
 
-        // Retrieve the queue element address.
-        const void* element = ( const void* )( ( ( u64 ) arg )
-                                             + i * queue_stride
-                                             );
-        
-        // Attempt to parse address value according to the format specifier and queue stride.
-        // TODO: Improve this. Fails if array stride does not correspond to provided format specifier.
-        switch ( ( *format_specifier ).tag )
+        case STRING_FORMAT_SPECIFIER_CHARACTER:
+        {
+            const char value = *( ( char* ) element );
+            _string_format_parse_argument_character ( state , format_specifier , value );
+        }
+        break;
+
+        case STRING_FORMAT_SPECIFIER_INTEGER:
         {
-            case STRING_FORMAT_SPECIFIER_RAW:
+            i64 value;
+            switch ( stride )
             {
-                u64 value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( u8 ):  value = *( ( u8* ) element )  ;break;
-                    case sizeof ( u16 ): value = *( ( u16* ) element ) ;break;
-                    case sizeof ( u32 ): value = *( ( u32* ) element ) ;break;
-                    case sizeof ( u64 ): value = *( ( u64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_raw ( state , format_specifier , value );
+                case sizeof ( i8 ):  value = *( ( i8* ) element )  ;break;
+                case sizeof ( i16 ): value = *( ( i16* ) element ) ;break;
+                case sizeof ( i32 ): value = *( ( i32* ) element ) ;break;
+                case sizeof ( i64 ): value = *( ( i64* ) element ) ;break;
+                default:             value = 0                     ;break;
             }
-            break;
+            _string_format_parse_argument_integer ( state , format_specifier , value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_CHARACTER:
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT:
+        {
+            f64 value;
+            switch ( stride )
             {
-                const char value = *( ( char* ) element );
-                _string_format_parse_argument_character ( state , format_specifier , value );
+                case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
+                case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
+                default:             value = 0                     ;break;
             }
-            break;
+            _string_format_parse_argument_floating_point ( state , format_specifier , &value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_INTEGER:
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT_SHOW_FRACTIONAL:
+        {
+            f64 value;
+            switch ( stride )
             {
-                i64 value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( i8 ):  value = *( ( i8* ) element )  ;break;
-                    case sizeof ( i16 ): value = *( ( i16* ) element ) ;break;
-                    case sizeof ( i32 ): value = *( ( i32* ) element ) ;break;
-                    case sizeof ( i64 ): value = *( ( i64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_integer ( state , format_specifier , value );
+                case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
+                case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
+                default:             value = 0                     ;break;
             }
-            break;
+            _string_format_parse_argument_floating_point_show_fractional ( state , format_specifier , &value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT:
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT_ABBREVIATED:
+        {
+            f64 value;
+            switch ( stride )
             {
-                f64 value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point ( state , format_specifier , &value );
+                case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
+                case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
+                default:             value = 0                     ;break;
             }
-            break;
+            _string_format_parse_argument_floating_point_abbreviated ( state , format_specifier , &value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT_SHOW_FRACTIONAL:
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT_FRACTIONAL_ONLY:
+        {
+            f64 value;
+            switch ( stride )
             {
-                f64 value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point_show_fractional ( state , format_specifier , &value );
+                case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
+                case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
+                default:             value = 0                     ;break;
             }
-            break;
+            _string_format_parse_argument_floating_point_fractional_only ( state , format_specifier , &value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT_ABBREVIATED:
+        case STRING_FORMAT_SPECIFIER_ADDRESS:
+        {
+            void* value;
+            switch ( stride )
             {
-                f64 value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point_abbreviated ( state , format_specifier , &value );
+                case sizeof ( void* ): value = *( ( void** ) element );break;
+                default:               value = 0                      ;break;
             }
-            break;
+            _string_format_parse_argument_address ( state , format_specifier , value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_FLOATING_POINT_FRACTIONAL_ONLY:
+        case STRING_FORMAT_SPECIFIER_STRING:
+        {
+            char* value;
+            switch ( stride )
             {
-                f64 value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( f32 ): value = *( ( f32* ) element ) ;break;
-                    case sizeof ( f64 ): value = *( ( f64* ) element ) ;break;
-                    default:             value = 0                     ;break;
-                }
-                _string_format_parse_argument_floating_point_fractional_only ( state , format_specifier , &value );
+                case sizeof ( char* ): value = *( ( char** ) element );break;
+                default:               value = 0                      ;break;
             }
-            break;
+            _string_format_parse_argument_string ( state , format_specifier , value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_ADDRESS:
+        case STRING_FORMAT_SPECIFIER_RESIZABLE_STRING:
+        {
+            char* value;
+            switch ( stride )
             {
-                void* value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( void* ): value = *( ( void** ) element );break;
-                    default:               value = 0                      ;break;
-                }
-                _string_format_parse_argument_address ( state , format_specifier , value );
+                case sizeof ( char* ): value = *( ( char** ) element );break;
+                default:               value = 0                      ;break;
             }
-            break;
+            _string_format_parse_argument_resizable_string ( state , format_specifier , value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_STRING:
+        case STRING_FORMAT_SPECIFIER_STRING_VIEW:
+        {
+            string_view_t* value;
+            switch ( stride )
             {
-                char* value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( char* ): value = *( ( char** ) element );break;
-                    default:               value = 0                      ;break;
-                }
-                _string_format_parse_argument_string ( state , format_specifier , value );
+                case sizeof ( string_view_t ): value = ( string_view_t* ) element;break;
+                default:                       value = 0                         ;break;
             }
-            break;
+            _string_format_parse_argument_string_view ( state , format_specifier , value );
+        }
+        break;
 
-            case STRING_FORMAT_SPECIFIER_RESIZABLE_STRING:
+        case STRING_FORMAT_SPECIFIER_HEX:
+        case STRING_FORMAT_SPECIFIER_HEX_UPPERCASE:
+        case STRING_FORMAT_SPECIFIER_BASE64:
+        {
+            string_view_t* value;
+            switch ( stride )
             {
-                char* value;
-                switch ( queue_stride )
-                {
-                    case sizeof ( char* ): value = *( ( char** ) element );break;
-                    default:               value = 0                      ;break;
-                }
-                _string_format_parse_argument_resizable_string ( state , format_specifier , value );
+                case sizeof ( string_view_t ): value = ( string_view_t* ) element;break;
+                default:                       value = 0                         ;break;
             }
-            break;
-            
-            default:
-            {}
-            break;
+            _string_format_parse_argument_bytes ( state , format_specifier , value );
         }
+        break;
 
-        _string_push ( ( *state ).string
-                     , ( i < queue_length - 1 ) ? "`, " : "`"
-                     );
+        default:
+        {}
+        break;
     }
-
-    _string_push ( ( *state ).string , " }" );
-
-    return string_length ( ( *state ).string ) - old_length;
+    return _string_format_written ( state ) - old_length;
 }
 
 u64
 _string_format_push
-(   char**                              string
+(   state_t*                            state
 ,   const char*                         src
 ,   const u64                           src_length
 ,   const string_format_specifier_t*    format_specifier
@@ -1666,22 +2256,22 @@ _string_format_push
 {
     if ( ( *format_specifier ).padding.tag == STRING_FORMAT_PADDING_NONE )
     {
-        string_push ( *string , src , src_length );
+        _string_format_write ( state , src , src_length );
         return src_length;
     }
     if ( ( *format_specifier ).padding.length <= src_length )
     {
         if ( ( *format_specifier ).padding.fixed )
         {
-            string_push ( *string
-                        , src
-                        , ( *format_specifier ).padding.length
-                        );
+            _string_format_write ( state
+                                 , src
+                                 , ( *format_specifier ).padding.length
+                                 );
             return ( *format_specifier ).padding.length;
         }
         else
         {
-            string_push ( *string , src , src_length );
+            _string_format_write ( state , src , src_length );
             return src_length;
         }
     }
@@ -1690,16 +2280,206 @@ _string_format_push
     {
         for ( u64 pad = pad_length; pad; --pad )
         {
-            string_push ( *string , &( *format_specifier ).padding.value , 1 );
+            _string_format_write ( state , &( *format_specifier ).padding.value , 1 );
         }
     }
-    string_push ( *string , src , src_length );
+    _string_format_write ( state , src , src_length );
     if ( ( *format_specifier ).padding.tag == STRING_FORMAT_PADDING_RIGHT )
     {
         for ( u64 pad = pad_length; pad; --pad )
         {
-            string_push ( *string , &( *format_specifier ).padding.value , 1 );
+            _string_format_write ( state , &( *format_specifier ).padding.value , 1 );
         }
     }
     return ( *format_specifier ).padding.length;
 }
+
+void
+_string_format_write
+(   state_t*    state
+,   const char* src
+,   const u64   src_length
+)
+{
+    if ( !( *state ).buffer )
+    {
+        _string_format_write_output ( state , src , src_length );
+        return;
+    }
+    if ( ( *state ).buffer_length + src_length > STRING_FORMAT_CONTAINER_BUFFER_SIZE )
+    {
+        _string_format_flush ( state );
+        if ( src_length > STRING_FORMAT_CONTAINER_BUFFER_SIZE )
+        {
+            _string_format_write_output ( state , src , src_length );
+            return;
+        }
+    }
+    memory_copy ( ( *state ).buffer + ( *state ).buffer_length , src , src_length );
+    ( *state ).buffer_length += src_length;
+}
+
+void
+_string_format_write_output
+(   state_t*    state
+,   const char* src
+,   const u64   src_length
+)
+{
+    if ( !( *state ).dst )
+    {
+        string_push ( ( *state ).string , src , src_length );
+        return;
+    }
+
+    // Leave room for the terminator.
+    if ( ( *state ).dst_length < ( *state ).dst_capacity - 1 )
+    {
+        memory_copy ( ( *state ).dst + ( *state ).dst_length
+                    , src
+                    , MIN ( src_length , ( *state ).dst_capacity - 1 - ( *state ).dst_length )
+                    );
+    }
+    ( *state ).dst_length += src_length;
+}
+
+void
+_string_format_write_bytes
+(   state_t*                            state
+,   const char*                         src
+,   const u64                           size
+,   const u64                           limit
+,   const string_format_specifier_t*    format_specifier
+)
+{
+    char buffer[ 1024 ];
+
+    // Whole base64 groups per chunk, so only the last chunk may be padded.
+    const bool base64 = ( *format_specifier ).tag == STRING_FORMAT_SPECIFIER_BASE64;
+    const u64 chunk_size = ( base64 ) ? sizeof ( buffer ) / 4 * 3
+                                      : sizeof ( buffer ) / 2
+                                      ;
+    u64 written = 0;
+    for ( u64 i = 0; i < size && written < limit; i += chunk_size )
+    {
+        const u64 count = MIN ( size - i , chunk_size );
+        const u64 length = ( base64 ) ? string_base64_encode ( src + i , count , buffer )
+                                      : string_hex_encode ( src + i
+                                                          , count
+                                                          , ( *format_specifier ).tag == STRING_FORMAT_SPECIFIER_HEX_UPPERCASE
+                                                          , buffer
+                                                          )
+                                      ;
+        const u64 write_length = MIN ( length , limit - written );
+        _string_format_write ( state , buffer , write_length );
+        written += write_length;
+    }
+}
+
+u64
+_string_format_written
+(   const state_t* state
+)
+{
+    return ( ( ( *state ).dst ) ? ( *state ).dst_length
+                                : string_length ( ( *state ).string )
+                                )
+         + ( *state ).buffer_length
+         ;
+}
+
+void
+_string_format_flush
+(   state_t* state
+)
+{
+    const u64 buffer_length = ( *state ).buffer_length;
+    ( *state ).buffer_length = 0;
+    _string_format_write_output ( state , ( *state ).buffer , buffer_length );
+}
+
+u64
+string_format_arguments
+(   const char*             format
+,   const u64               format_length
+,   STRING_FORMAT_ARGUMENT* dst
+,   const u64               dst_capacity
+)
+{
+    if ( !format || ( dst_capacity && !dst ) )
+    {
+        if ( !format )
+        {
+            LOGERROR ( "string_format_arguments: Missing argument: format." );
+        }
+        if ( dst_capacity && !dst )
+        {
+            LOGERROR ( "string_format_arguments: Missing argument: dst (output buffer)." );
+        }
+        return 0;
+    }
+
+    // Same traversal as _string_format_run, except it never runs out of
+    // arguments.
+    state_t state;
+    state.format = format;
+    state.format_length = format_length;
+
+    u64 count = 0;
+    const char* read = format;
+    while ( read < STRING_FORMAT_READ_LIMIT ( &state ) )
+    {
+        if ( *read != STRING_FORMAT_SPECIFIER_TOKEN_ID )
+        {
+            read += 1;
+            continue;
+        }
+
+        string_format_specifier_t format_specifier;
+        _string_format_validate_format_specifier ( &state
+                                                 , read + 1
+                                                 , &format_specifier
+                                                 );
+        if ( format_specifier.tag == STRING_FORMAT_SPECIFIER_IGNORE )
+        {
+            read += 2;
+            continue;
+        }
+
+        if ( count < dst_capacity )
+        {
+            dst[ count ] = ( format_specifier.tag == STRING_FORMAT_SPECIFIER_INVALID )
+                         ? STRING_FORMAT_ARGUMENT_VALUE
+                         : _string_format_argument ( &format_specifier )
+                         ;
+        }
+        count += 1;
+        read += 1;
+    }
+    return count;
+}
+
+STRING_FORMAT_ARGUMENT
+_string_format_argument
+(   const string_format_specifier_t* format_specifier
+)
+{
+    if ( ( *format_specifier ).container.tag != STRING_FORMAT_CONTAINER_NONE )
+    {
+        return STRING_FORMAT_ARGUMENT_CONTAINER;
+    }
+    switch ( ( *format_specifier ).tag )
+    {
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT:
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT_SHOW_FRACTIONAL:
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT_ABBREVIATED:
+        case STRING_FORMAT_SPECIFIER_FLOATING_POINT_FRACTIONAL_ONLY: return STRING_FORMAT_ARGUMENT_FLOATING_POINT;
+        case STRING_FORMAT_SPECIFIER_STRING:                         return STRING_FORMAT_ARGUMENT_STRING;
+        case STRING_FORMAT_SPECIFIER_RESIZABLE_STRING:               return STRING_FORMAT_ARGUMENT_RESIZABLE_STRING;
+        case STRING_FORMAT_SPECIFIER_STRING_VIEW:
+        case STRING_FORMAT_SPECIFIER_HEX:
+        case STRING_FORMAT_SPECIFIER_HEX_UPPERCASE:
+        case STRING_FORMAT_SPECIFIER_BASE64:                         return STRING_FORMAT_ARGUMENT_STRING_VIEW;
+        default:                                                     return STRING_FORMAT_ARGUMENT_VALUE;
+    }
+}
@@ -22,6 +22,10 @@ typedef enum
 ,   STRING_FORMAT_SPECIFIER_CHARACTER
 ,   STRING_FORMAT_SPECIFIER_STRING
 ,   STRING_FORMAT_SPECIFIER_RESIZABLE_STRING
+,   STRING_FORMAT_SPECIFIER_STRING_VIEW
+,   STRING_FORMAT_SPECIFIER_HEX
+,   STRING_FORMAT_SPECIFIER_HEX_UPPERCASE
+,   STRING_FORMAT_SPECIFIER_BASE64
 
 ,   STRING_FORMAT_SPECIFIER_COUNT
 }
@@ -42,6 +46,23 @@ typedef enum
 }
 STRING_FORMAT_MODIFIER;
 
+/**
+ * @brief Type and instance definitions for the kind of argument which a format
+ * specifier consumes (see string_format_arguments).
+ */
+typedef enum
+{
+    STRING_FORMAT_ARGUMENT_VALUE            /** @brief Passed by value (e.g. %u, %i, %c, %@). */
+,   STRING_FORMAT_ARGUMENT_FLOATING_POINT   /** @brief The address of an f64 (e.g. %f). */
+,   STRING_FORMAT_ARGUMENT_STRING           /** @brief A null-terminated string (%s). */
+,   STRING_FORMAT_ARGUMENT_RESIZABLE_STRING /** @brief A resizable string (%S). */
+,   STRING_FORMAT_ARGUMENT_STRING_VIEW      /** @brief The address of a string view (%v, %x, %X, %b). */
+,   STRING_FORMAT_ARGUMENT_CONTAINER        /** @brief A resizable array or queue (a and q modifiers). */
+
+,   STRING_FORMAT_ARGUMENT_COUNT
+}
+STRING_FORMAT_ARGUMENT;
+
 #define STRING_FORMAT_SPECIFIER_INVALID STRING_FORMAT_SPECIFIER_COUNT /** @brief An alias for detecting an invalid format specifier tag. */
 #define STRING_FORMAT_MODIFIER_INVALID  STRING_FORMAT_MODIFIER_COUNT  /** @brief An alias for detecting an invalid format modifier tag. */
 
@@ -58,6 +79,10 @@ STRING_FORMAT_MODIFIER;
 #define STRING_FORMAT_SPECIFIER_TOKEN_CHARACTER                      'c' /** @brief Format specifier: character. */
 #define STRING_FORMAT_SPECIFIER_TOKEN_STRING                         's' /** @brief Format specifier: string. */
 #define STRING_FORMAT_SPECIFIER_TOKEN_RESIZABLE_STRING               'S' /** @brief Format specifier: resizable string. */
+#define STRING_FORMAT_SPECIFIER_TOKEN_STRING_VIEW                    'v' /** @brief Format specifier: string view. */
+#define STRING_FORMAT_SPECIFIER_TOKEN_HEX                            'x' /** @brief Format specifier: hexadecimal bytes. */
+#define STRING_FORMAT_SPECIFIER_TOKEN_HEX_UPPERCASE                  'X' /** @brief Format specifier: hexadecimal bytes (uppercase). */
+#define STRING_FORMAT_SPECIFIER_TOKEN_BASE64                         'b' /** @brief Format specifier: base64 bytes. */
                                                                      
 #define STRING_FORMAT_MODIFIER_TOKEN_PAD                             'P' /** @brief Format modifier: pad. */
 #define STRING_FORMAT_MODIFIER_TOKEN_PAD_MINIMUM                     'p' /** @brief Format modifier: pad (minimum width). */
@@ -101,6 +126,15 @@ STRING_FORMAT_MODIFIER;
  * %S : Resizable string of characters.
  *      This includes any string created with the __string_create class of
  *      functions. Length is fetched at runtime via O(1) string_length.
+ * %v : String view. The corresponding argument must be the address of a
+ *      string_view_t (see core/string.h). The view need not be
+ *      null-terminated.
+ * %x : Bytes, as hexadecimal digits (lowercase). The corresponding argument
+ *      must be the address of a string_view_t whose characters are the bytes
+ *      to encode (see string_hex_encode in core/string.h).
+ * %X : Bytes, as hexadecimal digits (uppercase). As %x.
+ * %b : Bytes, as base64 (padded with '='). As %x (see string_base64_encode in
+ *      core/string.h).
  *      
  * FORMAT MODIFIERS :
  * 
@@ -135,6 +169,10 @@ STRING_FORMAT_MODIFIER;
  *       function.
  *       Works with any format specifier; the format specifier specifies the
  *       print method for each queue element.
+ * - a<number>, q<number> : As a and q, but print at most <number> elements;
+ *                          the rest are elided, and counted instead, e.g.
+ *                          "{ `1`, `2`, ... (98 more) }". Useful for logging
+ *                          large containers.
  *
  * @param format Formatting string.
  * @param args Variadic argument list (see common/args.h).
@@ -154,4 +192,210 @@ _string_format
         REENABLE_WARNING ()                                 \
     })
 
+/**
+ * @brief Variant of _string_format which writes to a caller-supplied buffer
+ * instead of allocating a resizable string. Never allocates memory.
+ * 
+ * Output which does not fit is discarded, but the terminator is always
+ * written. As with snprintf, the return value is the length of the complete
+ * formatted string, so the output was truncated if it is not less than
+ * dst_capacity.
+ * 
+ * @param dst Output buffer. Must be non-zero.
+ * @param dst_capacity The capacity of dst (in characters), including the
+ * terminator. Must be non-zero.
+ * @param format Formatting string (see _string_format).
+ * @param args Variadic argument list (see common/args.h).
+ * @return The length of the complete formatted string (in characters).
+ */
+u64
+_string_format_to
+(   char*       dst
+,   const u64   dst_capacity
+,   const char* format
+,   args_t      args
+);
+
+/** @brief Alias for calling _string_format_to with __VA_ARGS__. */
+#define string_format_to(dst,dst_capacity,format,...)                                   \
+    ({                                                                                  \
+        DISABLE_WARNING ( -Wint-conversion )                                            \
+        _string_format_to ( (dst) , (dst_capacity) , (format) , ARGS ( __VA_ARGS__ ) ); \
+        REENABLE_WARNING ()                                                             \
+    })
+
+/**
+ * @brief Variant of _string_format which appends to an existing resizable
+ * string instead of creating a new one.
+ * 
+ * Allocates memory only if the string must grow to hold the output. A string
+ * which is cleared and reused across calls (see string_clear) stops
+ * allocating once it is large enough.
+ * 
+ * @param string The resizable string to append to. Must be non-zero.
+ * @param format Formatting string (see _string_format).
+ * @param args Variadic argument list (see common/args.h).
+ * @return The resizable string (possibly with new address).
+ */
+char*
+_string_format_append
+(   char*       string
+,   const char* format
+,   args_t      args
+);
+
+/** @brief Alias for calling _string_format_append with __VA_ARGS__. */
+#define string_format_append(string,format,...)                                          \
+    ({                                                                                   \
+        DISABLE_WARNING ( -Wint-conversion )                                             \
+        (string) = _string_format_append ( (string) , (format) , ARGS ( __VA_ARGS__ ) ); \
+        REENABLE_WARNING ()                                                              \
+    })
+
+/** @brief Type definition for a precompiled formatting string. */
+typedef void string_format_template_t;
+
+/**
+ * @brief Parses and validates a formatting string once, so that it may be
+ * executed any number of times by _string_format_with without re-parsing it.
+ * 
+ * The template holds a private copy of the formatting string, along with the
+ * literal spans between its format specifiers and each resolved specifier
+ * (including modifiers). Executing the template produces exactly the same
+ * output as passing the original formatting string to _string_format.
+ * 
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size.
+ * 
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h). Call
+ *   string_format_template_destroy to free.
+ * 
+ * @param format Formatting string (see _string_format). Must be non-zero.
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required by the template. Only applicable if pre-allocating a memory buffer
+ * of the required size. Pass 0 to use implicit memory allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @param template Output buffer for template.
+ * @return true on success; false otherwise.
+ */
+bool
+string_format_compile
+(   const char*                 format
+,   u64*                        memory_requirement
+,   void*                       memory
+,   string_format_template_t**  template
+);
+
+/**
+ * @brief Frees the memory used by a precompiled formatting string.
+ * 
+ * If the template was not pre-allocated, this function will free the memory
+ * implicitly (see core/memory.h).
+ * 
+ * @param template Handle to the template to free.
+ */
+void
+string_format_template_destroy
+(   string_format_template_t** template
+);
+
+/**
+ * @brief Variant of _string_format which executes a precompiled formatting
+ * string (see string_format_compile).
+ * 
+ * @param template The template. Must be non-zero.
+ * @param args Variadic argument list (see common/args.h).
+ * @return The formatted string.
+ */
+char*
+_string_format_with
+(   const string_format_template_t* template
+,   args_t                          args
+);
+
+/** @brief Alias for calling _string_format_with with __VA_ARGS__. */
+#define string_format_with(template,...)                           \
+    ({                                                             \
+        DISABLE_WARNING ( -Wint-conversion )                       \
+        _string_format_with ( (template) , ARGS ( __VA_ARGS__ ) ); \
+        REENABLE_WARNING ()                                        \
+    })
+
+/**
+ * @brief Variant of _string_format_to which executes a precompiled formatting
+ * string (see string_format_compile). Never allocates memory.
+ * 
+ * @param dst Output buffer. Must be non-zero.
+ * @param dst_capacity The capacity of dst (in characters). Must be non-zero.
+ * @param template The template. Must be non-zero.
+ * @param args Variadic argument list (see common/args.h).
+ * @return The length of the complete formatted string (in characters).
+ */
+u64
+_string_format_to_with
+(   char*                           dst
+,   const u64                       dst_capacity
+,   const string_format_template_t* template
+,   args_t                          args
+);
+
+/** @brief Alias for calling _string_format_to_with with __VA_ARGS__. */
+#define string_format_to_with(dst,dst_capacity,template,...)                                   \
+    ({                                                                                         \
+        DISABLE_WARNING ( -Wint-conversion )                                                   \
+        _string_format_to_with ( (dst) , (dst_capacity) , (template) , ARGS ( __VA_ARGS__ ) ); \
+        REENABLE_WARNING ()                                                                    \
+    })
+
+/**
+ * @brief Variant of _string_format_append which executes a precompiled
+ * formatting string (see string_format_compile).
+ * 
+ * @param string The resizable string to append to. Must be non-zero.
+ * @param template The template. Must be non-zero.
+ * @param args Variadic argument list (see common/args.h).
+ * @return The resizable string (possibly with new address).
+ */
+char*
+_string_format_append_with
+(   char*                           string
+,   const string_format_template_t* template
+,   args_t                          args
+);
+
+/** @brief Alias for calling _string_format_append_with with __VA_ARGS__. */
+#define string_format_append_with(string,template,...)                                          \
+    ({                                                                                          \
+        DISABLE_WARNING ( -Wint-conversion )                                                    \
+        (string) = _string_format_append_with ( (string) , (template) , ARGS ( __VA_ARGS__ ) ); \
+        REENABLE_WARNING ()                                                                     \
+    })
+
+/**
+ * @brief Determines which kind of argument each format specifier of a
+ * formatting string consumes, in order, without formatting anything. Never
+ * allocates memory.
+ * 
+ * Illegal format specifiers consume an argument as well (see _string_format);
+ * they are reported as STRING_FORMAT_ARGUMENT_VALUE.
+ * 
+ * @param format Formatting string (see _string_format). Must be non-zero.
+ * @param format_length The number of characters in format.
+ * @param dst Output buffer for the argument kinds. Only the first dst_capacity
+ * are written.
+ * @param dst_capacity The capacity of dst (in elements).
+ * @return The number of arguments the formatting string consumes.
+ */
+u64
+string_format_arguments
+(   const char*             format
+,   const u64               format_length
+,   STRING_FORMAT_ARGUMENT* dst
+,   const u64               dst_capacity
+);
+
 #endif // STRING_FORMAT_H
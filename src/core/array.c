@@ -7,11 +7,82 @@
 #include "core/array.h"
 
 #include "core/memory.h"
+#include "core/sort.h"
 
 #include "math/math.h"
 
 #include "platform/platform.h"
 
+/** @brief Type definition for the random index generator used by array_shuffle. */
+typedef struct
+{
+    prng_t  prng;
+    u64     bits;           // Unused bits of the last output.
+    u32     bits_available; // Number of unused 32-bit draws in bits.
+}
+array_random_t;
+
+/**
+ * @brief Reverses the order of the elements of an array sixteen bytes at a
+ * time, working inward from both ends. Element size must divide eight.
+ * 
+ * @param array The array to reverse.
+ * @param array_length The number of elements in the array. Must be at least 2.
+ * @param array_stride The size of each array element in bytes (1, 2, 4, or 8).
+ */
+INLINE
+void
+_array_reverse_blocks
+(   u8*         array
+,   const u64   array_length
+,   const u64   array_stride
+);
+
+/**
+ * @brief Reverses the order of the elements within an eight-byte word.
+ * 
+ * @param word The word.
+ * @param array_stride The size of each array element in bytes (1, 2, 4, or 8).
+ * @return word with its elements in reverse order.
+ */
+INLINE
+u64
+_array_reverse_word
+(   u64         word
+,   const u64   array_stride
+);
+
+/**
+ * @brief Draws a uniformly distributed random integer in [ 0 , bound ).
+ * 
+ * Lemire's multiply-shift method: a product and (rarely) a retry in place of a
+ * division. Bounds which fit in 32 bits consume half of a 64-bit output each,
+ * so the generator only runs once for every two draws (see prng_bounded for
+ * larger bounds).
+ * 
+ * @param random Generator state.
+ * @param bound The (exclusive) upper bound. Must be non-zero.
+ * @return A random integer in [ 0 , bound ).
+ */
+INLINE
+u64
+_array_random_index
+(   array_random_t* random
+,   const u64       bound
+);
+
+/**
+ * @brief Draws 32 random bits, advancing the generator every second draw.
+ * 
+ * @param random Generator state.
+ * @return 32 random bits.
+ */
+INLINE
+u32
+_array_random_next_32
+(   array_random_t* random
+);
+
 void*
 array_copy
 (   const void* src
@@ -28,46 +99,32 @@ array_reverse
 (   void*       array
 ,   const u64   array_length
 ,   const u64   array_stride
-,   void*       swap_
+,   void*       swap
 )
 {
+    ( void ) swap;
+
     if ( !array_stride || array_length < 2 )
     {
         return array;
     }
 
-    void* swap;
-    if ( !swap_ )
+    switch ( array_stride )
     {
-        swap = memory_allocate ( array_stride , MEMORY_TAG_ARRAY );
-    }
-    else
-    {
-        swap = swap_;
-    }
-
-    const u64 array_ = ( ( u64 ) array );
-    u64 i;
-    u64 j;
-    for ( i = 0 , j = array_length - 1; i < j; ++i , --j )
-    {
-        memory_copy ( swap
-                    , ( void* )( array_ + i * array_stride )
-                    , array_stride
-                    );
-        memory_copy ( ( void* )( array_ + i * array_stride )
-                    , ( void* )( array_ + j * array_stride )
-                    , array_stride
-                    );
-        memory_copy ( ( void* )( array_ + j * array_stride )
-                    , swap
-                    , array_stride
-                    );
-    }
-
-    if ( !swap_ )
-    {
-        memory_free ( swap , array_stride , MEMORY_TAG_ARRAY );
+        case 1:  _array_reverse_blocks ( array , array_length , 1 ) ;break;
+        case 2:  _array_reverse_blocks ( array , array_length , 2 ) ;break;
+        case 4:  _array_reverse_blocks ( array , array_length , 4 ) ;break;
+        case 8:  _array_reverse_blocks ( array , array_length , 8 ) ;break;
+        default:
+        {
+            u8* front = array;
+            u8* back = front + ( array_length - 1 ) * array_stride;
+            for ( ; front < back; front += array_stride , back -= array_stride )
+            {
+                array_swap ( front , back , array_stride );
+            }
+            break;
+        }
     }
 
     return array;
@@ -78,45 +135,29 @@ array_shuffle
 (   void*   array
 ,   u64     array_length
 ,   u64     array_stride
-,   void*   swap_
+,   void*   swap
 )
 {
+    ( void ) swap;
+
     if ( !array_stride || array_length < 2 )
     {
         return array;
     }
 
-    void* swap;
-    if ( !swap_ )
-    {
-        swap = memory_allocate ( array_stride , MEMORY_TAG_ARRAY );
-    }
-    else
-    {
-        swap = swap_;
-    }
+    array_random_t random;
+    prng_seed ( &random.prng , prng_next ( prng_local () ) );
+    random.bits = 0;
+    random.bits_available = 0;
 
-    const u64 array_ = ( ( u64 ) array );
-    for ( u64 i = 0; i < array_length - 1; ++i )
+    u8* elements = array;
+    for ( u64 i = array_length - 1; i; --i )
     {
-        u64 j = random2 ( 0 , i );
-        memory_copy ( swap
-                    , ( void* )( array_ + i * array_stride )
-                    , array_stride
-                    );
-        memory_copy ( ( void* )( array_ + i * array_stride )
-                    , ( void* )( array_ + j * array_stride )
-                    , array_stride
-                    );
-        memory_copy ( ( void* )( array_ + j * array_stride )
-                    , swap
-                    , array_stride
-                    );
-    }
-
-    if ( !swap_ )
-    {
-        memory_free ( swap , array_stride , MEMORY_TAG_ARRAY );
+        const u64 j = _array_random_index ( &random , i + 1 );
+        array_swap ( elements + i * array_stride
+                   , elements + j * array_stride
+                   , array_stride
+                   );
     }
 
     return array;
@@ -130,6 +171,146 @@ array_sort
 ,   comparator_function_t   comparator
 )
 {
-    platform_array_sort ( array , array_stride , array_length , comparator );
+    sort ( array , array_length , array_stride , comparator );
     return array;
+}
+
+bool
+array_sort_radix
+(   void*       array
+,   u64         array_length
+,   u64         array_stride
+,   u64         key_offset
+,   SORT_KEY    key
+)
+{
+    return sort_radix ( array , array_length , array_stride , key_offset , key , 0 );
+}
+
+void*
+array_sort_parallel
+(   void*                   array
+,   u64                     array_length
+,   u64                     array_stride
+,   comparator_function_t   comparator
+)
+{
+    sort_parallel ( array , array_length , array_stride , comparator , 0 );
+    return array;
+}
+
+INLINE
+void
+_array_reverse_blocks
+(   u8*         array
+,   const u64   array_length
+,   const u64   array_stride
+)
+{
+    u8* front = array;
+    u8* back = array + array_length * array_stride;
+
+    // Exchange sixteen-byte blocks from either end, reversing the order of the
+    // elements within each block as it moves.
+    while ( back - front >= 32 )
+    {
+        u64 f[ 2 ];
+        u64 b[ 2 ];
+        __builtin_memcpy ( f , front , 16 );
+        __builtin_memcpy ( b , back - 16 , 16 );
+        const u64 front_[ 2 ] = { _array_reverse_word ( b[ 1 ] , array_stride )
+                                , _array_reverse_word ( b[ 0 ] , array_stride )
+                                };
+        const u64 back_[ 2 ] = { _array_reverse_word ( f[ 1 ] , array_stride )
+                               , _array_reverse_word ( f[ 0 ] , array_stride )
+                               };
+        __builtin_memcpy ( front , front_ , 16 );
+        __builtin_memcpy ( back - 16 , back_ , 16 );
+        front += 16;
+        back -= 16;
+    }
+
+    // Fewer than two blocks remain in the middle.
+    while ( back - front >= ( i64 )( 2 * array_stride ) )
+    {
+        back -= array_stride;
+        array_swap ( front , back , array_stride );
+        front += array_stride;
+    }
+}
+
+INLINE
+u64
+_array_reverse_word
+(   u64         word
+,   const u64   array_stride
+)
+{
+    switch ( array_stride )
+    {
+        case 1:
+        {
+            return __builtin_bswap64 ( word );
+        }
+        case 2:
+        {
+            word = ( word >> 32 ) | ( word << 32 );
+            return ( ( word >> 16 ) & 0x0000FFFF0000FFFFULL )
+                 | ( ( word & 0x0000FFFF0000FFFFULL ) << 16 )
+                 ;
+        }
+        case 4:
+        {
+            return ( word >> 32 ) | ( word << 32 );
+        }
+        default:
+        {
+            return word;
+        }
+    }
+}
+
+INLINE
+u64
+_array_random_index
+(   array_random_t* random
+,   const u64       bound
+)
+{
+    if ( bound <= 0xFFFFFFFF )
+    {
+        const u32 bound_ = bound;
+        u64 product = ( u64 ) _array_random_next_32 ( random ) * bound_;
+
+        // Reject the few low products which would bias the result. The
+        // threshold (a division) is only computed when a retry is possible.
+        if ( ( u32 ) product < bound_ )
+        {
+            const u32 threshold = ( ( u32 ) -bound_ ) % bound_;
+            while ( ( u32 ) product < threshold )
+            {
+                product = ( u64 ) _array_random_next_32 ( random ) * bound_;
+            }
+        }
+        return product >> 32;
+    }
+
+    return prng_bounded ( &( *random ).prng , bound );
+}
+
+INLINE
+u32
+_array_random_next_32
+(   array_random_t* random
+)
+{
+    if ( !( *random ).bits_available )
+    {
+        ( *random ).bits = prng_next ( &( *random ).prng );
+        ( *random ).bits_available = 2;
+    }
+    const u32 bits = ( u32 )( *random ).bits;
+    ( *random ).bits >>= 32;
+    ( *random ).bits_available -= 1;
+    return bits;
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 #include "common.h"
 
+#include "core/sort.h"
+
 /**
  * @brief Copies an array. O(n).
  * 
@@ -26,14 +28,74 @@ array_copy
 ,   void*       dst
 );
 
+/**
+ * @brief Exchanges two array elements in-place.
+ * 
+ * Elements of 1, 2, 4, 8, or 16 bytes are exchanged in registers; other sizes
+ * are exchanged eight bytes at a time. Never allocates, and reduces to a pair
+ * of loads and stores when array_stride is known at compile time.
+ * 
+ * @param a An array element. Must be non-zero.
+ * @param b An array element. Must be non-zero.
+ * @param array_stride The size of each array element in bytes.
+ */
+INLINE
+void
+array_swap
+(   void*       a_
+,   void*       b_
+,   const u64   array_stride
+)
+{
+    u8* a = a_;
+    u8* b = b_;
+    switch ( array_stride )
+    {
+        #define ARRAY_SWAP(size)                            \
+            {                                               \
+                u8 t[ size ];                               \
+                __builtin_memcpy ( t , a , size );          \
+                __builtin_memcpy ( a , b , size );          \
+                __builtin_memcpy ( b , t , size );          \
+                return;                                     \
+            }
+        case 1:  ARRAY_SWAP ( 1 )
+        case 2:  ARRAY_SWAP ( 2 )
+        case 4:  ARRAY_SWAP ( 4 )
+        case 8:  ARRAY_SWAP ( 8 )
+        case 16: ARRAY_SWAP ( 16 )
+        #undef ARRAY_SWAP
+        default:
+        {
+            u64 i = 0;
+            for ( ; i + 8 <= array_stride; i += 8 )
+            {
+                u64 t;
+                __builtin_memcpy ( &t , a + i , 8 );
+                __builtin_memcpy ( a + i , b + i , 8 );
+                __builtin_memcpy ( b + i , &t , 8 );
+            }
+            for ( ; i < array_stride; ++i )
+            {
+                const u8 t = a[ i ];
+                a[ i ] = b[ i ];
+                b[ i ] = t;
+            }
+            return;
+        }
+    }
+}
+
 /**
  * @brief Reverses an array. O(n).
  * 
+ * Arrays of 1, 2, 4, or 8-byte elements are reversed sixteen bytes at a time.
+ * 
  * @param array The array to reverse. Must be non-zero.
  * @param array_length The number of elements in the array.
  * @param array_stride The size of each array element in bytes.
- * @param swap Optional pre-allocated swap buffer. Pass 0 to use implicit memory
- * allocation.
+ * @param swap Unused; elements are exchanged in registers (see array_swap),
+ * so no swap buffer is required. Retained for compatibility; pass 0.
  * @return The array after reversal.
  */
 void*
@@ -47,11 +109,15 @@ array_reverse
 /**
  * @brief Shuffles the elements of an array. O(n).
  * 
+ * Fisher-Yates shuffle; every permutation is equally likely. Random indices
+ * are drawn from a local generator seeded once per call, so the cost per
+ * element is a multiply rather than a call to the host libc.
+ * 
  * @param array The array to shuffle. Must be non-zero.
  * @param array_length The number of elements in the array.
  * @param array_stride The size of each array element in bytes.
- * @param swap Optional pre-allocated swap buffer. Pass 0 to use implicit memory
- * allocation.
+ * @param swap Unused; elements are exchanged in registers (see array_swap),
+ * so no swap buffer is required. Retained for compatibility; pass 0.
  * @return The array with its elements shuffled.
  */
 void*
@@ -65,9 +131,9 @@ array_shuffle
 /**
  * @brief Sorts an array in-place.
  * 
- * Current implementation uses quicksort algorithm.
+ * Current implementation uses introsort (see core/sort.h).
  * AVERAGE CASE TIME COMPLEXITY : O(n log(n))
- * WORST CASE TIME COMPLEXITY   : O(n²)
+ * WORST CASE TIME COMPLEXITY   : O(n log(n))
  * 
  * @param array The array to sort. Must be non-zero.
  * @param array_length The number of elements in the array.
@@ -84,4 +150,46 @@ array_sort
 ,   comparator_function_t   comparator
 );
 
+/**
+ * @brief Sorts an array in-place by an integer or floating point key stored
+ * within each element (see sort_radix in core/sort.h).
+ * 
+ * Stable.
+ * TIME COMPLEXITY : O(n * key size)
+ * 
+ * @param array The array to sort. Must be non-zero.
+ * @param array_length The number of elements in the array.
+ * @param array_stride The size of each array element in bytes.
+ * @param key_offset The position of the key within each element (in bytes).
+ * @param key The type of the key.
+ * @return true on success; false if the key does not fit in an element.
+ */
+bool
+array_sort_radix
+(   void*       array
+,   u64         array_length
+,   u64         array_stride
+,   u64         key_offset
+,   SORT_KEY    key
+);
+
+/**
+ * @brief Sorts an array in-place using the job system (see sort_parallel in
+ * core/sort.h). Equivalent to array_sort if the job system is not running.
+ * 
+ * @param array The array to sort. Must be non-zero.
+ * @param array_length The number of elements in the array.
+ * @param array_stride The size of each array element in bytes.
+ * @param comparator A function which compares two array elements.
+ * Must be non-zero, and safe to call from several threads at once.
+ * @return The array with all elements sorted according to the comparator.
+ */
+void*
+array_sort_parallel
+(   void*                   array
+,   u64                     array_length
+,   u64                     array_stride
+,   comparator_function_t   comparator
+);
+
 #endif  // ARRAY_UTIL_H
\ No newline at end of file
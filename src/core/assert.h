@@ -25,6 +25,9 @@
 /**
  * @brief Interface for logging information on assertion failure.
  * 
+ * The message is logged at LOG_FATAL, so it is written without allocating
+ * memory or taking any lock (see logger_fatal in core/logger.h).
+ * 
  * @param expression The expression to assert. Must be non-zero.
  * @param message The message to log on assertion failure. Must be non-zero.
  * @param file The file containing the caller of the BRKDBG invocation that was
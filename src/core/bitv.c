@@ -0,0 +1,312 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bitv.c
+ * @brief Implementation of the core/bitv header.
+ * (see core/bitv.h for additional details)
+ */
+#include "core/bitv.h"
+
+/**
+ * @brief Type definition for a 128-bit SIMD block. Bitwise operators apply
+ * lane-wise, and compile to SSE2 / NEON instructions.
+ */
+typedef u64 bitv_block_t __attribute__ ( ( vector_size ( 16 ) ) );
+
+/** @brief Applies a bitwise expression to the SIMD block offset bytes past i (see BITV_APPLY). */
+#define BITV_BLOCK_APPLY(offset,expression)                                     \
+    {                                                                           \
+        bitv_block_t x;                                                         \
+        bitv_block_t y;                                                         \
+        __builtin_memcpy ( &x , a + i + (offset) , 16 );                        \
+        __builtin_memcpy ( &y , b + i + (offset) , 16 );                        \
+        x = (expression);                                                       \
+        __builtin_memcpy ( dst + i + (offset) , &x , 16 );                      \
+    }
+
+/**
+ * @brief Applies a bitwise expression of x (from a) and y (from b) to every
+ * byte of two bit vectors, a SIMD block at a time, then a word at a time, then
+ * a byte at a time; finally, to the bits of the last byte below length.
+ */
+#define BITV_APPLY(expression)                                                  \
+    {                                                                           \
+        u64 i = 0;                                                              \
+        for ( ; i + 32 <= bytes; i += 32 )                                      \
+        {                                                                       \
+            BITV_BLOCK_APPLY ( 0 , expression )                                 \
+            BITV_BLOCK_APPLY ( 16 , expression )                                \
+        }                                                                       \
+        for ( ; i + 8 <= bytes; i += 8 )                                        \
+        {                                                                       \
+            u64 x;                                                              \
+            u64 y;                                                              \
+            __builtin_memcpy ( &x , a + i , 8 );                                \
+            __builtin_memcpy ( &y , b + i , 8 );                                \
+            x = (expression);                                                   \
+            __builtin_memcpy ( dst + i , &x , 8 );                              \
+        }                                                                       \
+        for ( ; i < bytes; ++i )                                                \
+        {                                                                       \
+            const u8 x = a[ i ];                                                \
+            const u8 y = b[ i ];                                                \
+            dst[ i ] = (expression);                                            \
+        }                                                                       \
+        if ( bits )                                                             \
+        {                                                                       \
+            const u8 x = a[ bytes ];                                            \
+            const u8 y = b[ bytes ];                                            \
+            const u8 mask = ( 1 << bits ) - 1;                                  \
+            dst[ bytes ] = ( dst[ bytes ] & ~mask ) | ( (expression) & mask );  \
+        }                                                                       \
+    }
+
+/**
+ * @brief Reads one 64-bit word of a bit vector, without reading past its last
+ * byte. Bits at or beyond length read as 0.
+ *
+ * @param bitv A bit vector.
+ * @param length The number of bits in the vector.
+ * @param index The index of the word. Must be below ( length + 63 ) / 64.
+ * @return The word.
+ */
+INLINE
+u64
+_bitv_word
+(   const u8*   bitv
+,   const u64   length
+,   const u64   index
+)
+{
+    u64 word = 0;
+    const u64 remaining = length - index * 64;
+    if ( remaining >= 64 )
+    {
+        __builtin_memcpy ( &word , bitv + index * 8 , 8 );
+        return word;
+    }
+    __builtin_memcpy ( &word , bitv + index * 8 , ( remaining + 7 ) / 8 );
+    return word & ( ( ( u64 ) 1 << remaining ) - 1 );
+}
+
+/**
+ * @brief Computes a mask of the bits of a word of a bit vector which are below
+ * its length.
+ *
+ * @param length The number of bits in the vector.
+ * @param index The index of the word. Must be below ( length + 63 ) / 64.
+ * @return The mask.
+ */
+INLINE
+u64
+_bitv_word_mask
+(   const u64   length
+,   const u64   index
+)
+{
+    const u64 remaining = length - index * 64;
+    return ( remaining >= 64 ) ? ~( ( u64 ) 0 ) : ( ( ( u64 ) 1 << remaining ) - 1 );
+}
+
+void*
+bitv_and
+(   void*       dst_
+,   const void* a_
+,   const void* b_
+,   const u64   length
+)
+{
+    u8* dst = dst_;
+    const u8* a = a_;
+    const u8* b = b_;
+    const u64 bytes = length / 8;
+    const u64 bits = length % 8;
+    BITV_APPLY ( x & y );
+    return dst;
+}
+
+void*
+bitv_or
+(   void*       dst_
+,   const void* a_
+,   const void* b_
+,   const u64   length
+)
+{
+    u8* dst = dst_;
+    const u8* a = a_;
+    const u8* b = b_;
+    const u64 bytes = length / 8;
+    const u64 bits = length % 8;
+    BITV_APPLY ( x | y );
+    return dst;
+}
+
+void*
+bitv_xor
+(   void*       dst_
+,   const void* a_
+,   const void* b_
+,   const u64   length
+)
+{
+    u8* dst = dst_;
+    const u8* a = a_;
+    const u8* b = b_;
+    const u64 bytes = length / 8;
+    const u64 bits = length % 8;
+    BITV_APPLY ( x ^ y );
+    return dst;
+}
+
+void*
+bitv_andnot
+(   void*       dst_
+,   const void* a_
+,   const void* b_
+,   const u64   length
+)
+{
+    u8* dst = dst_;
+    const u8* a = a_;
+    const u8* b = b_;
+    const u64 bytes = length / 8;
+    const u64 bits = length % 8;
+    BITV_APPLY ( x & ~y );
+    return dst;
+}
+
+void*
+bitv_not
+(   void*       dst_
+,   const void* a_
+,   const u64   length
+)
+{
+    u8* dst = dst_;
+    const u8* a = a_;
+    const u8* b = a_;
+    const u64 bytes = length / 8;
+    const u64 bits = length % 8;
+    BITV_APPLY ( ~( x | y ) );  // b aliases a, so this is ~a.
+    return dst;
+}
+
+u64
+bitv_count
+(   const void* bitv_
+,   const u64   length
+)
+{
+    const u8* bitv = bitv_;
+    const u64 words = length / 64;
+
+    // Independent accumulators let consecutive popcounts overlap.
+    u64 count[ 4 ] = { 0 , 0 , 0 , 0 };
+    u64 i = 0;
+    for ( ; i + 4 <= words; i += 4 )
+    {
+        u64 x[ 4 ];
+        __builtin_memcpy ( x , bitv + i * 8 , 32 );
+        count[ 0 ] += popcount64 ( x[ 0 ] );
+        count[ 1 ] += popcount64 ( x[ 1 ] );
+        count[ 2 ] += popcount64 ( x[ 2 ] );
+        count[ 3 ] += popcount64 ( x[ 3 ] );
+    }
+    for ( ; i < ( length + 63 ) / 64; ++i )
+    {
+        count[ 0 ] += popcount64 ( _bitv_word ( bitv , length , i ) );
+    }
+    return count[ 0 ] + count[ 1 ] + count[ 2 ] + count[ 3 ];
+}
+
+u64
+bitv_next_set
+(   const void* bitv
+,   const u64   length
+,   const u64   from
+)
+{
+    if ( from >= length )
+    {
+        return length;
+    }
+
+    const u64 words = ( length + 63 ) / 64;
+    u64 i = from / 64;
+    u64 word = _bitv_word ( bitv , length , i ) & ( ~( ( u64 ) 0 ) << ( from % 64 ) );
+    while ( !word )
+    {
+        i += 1;
+        if ( i == words )
+        {
+            return length;
+        }
+        word = _bitv_word ( bitv , length , i );
+    }
+    return i * 64 + bitscan_forward ( word );
+}
+
+u64
+bitv_next_clr
+(   const void* bitv
+,   const u64   length
+,   const u64   from
+)
+{
+    if ( from >= length )
+    {
+        return length;
+    }
+
+    const u64 words = ( length + 63 ) / 64;
+    u64 i = from / 64;
+    u64 word = ~_bitv_word ( bitv , length , i )
+             & _bitv_word_mask ( length , i )
+             & ( ~( ( u64 ) 0 ) << ( from % 64 ) )
+             ;
+    while ( !word )
+    {
+        i += 1;
+        if ( i == words )
+        {
+            return length;
+        }
+        word = ~_bitv_word ( bitv , length , i ) & _bitv_word_mask ( length , i );
+    }
+    return i * 64 + bitscan_forward ( word );
+}
+
+u64
+bitv_rank
+(   const void* bitv
+,   const u64   n
+)
+{
+    return bitv_count ( bitv , n );
+}
+
+u64
+bitv_select
+(   const void* bitv
+,   const u64   length
+,   u64         k
+)
+{
+    const u64 words = ( length + 63 ) / 64;
+    for ( u64 i = 0; i < words; ++i )
+    {
+        u64 word = _bitv_word ( bitv , length , i );
+        const u64 count = popcount64 ( word );
+        if ( k < count )
+        {
+            // Discard the k lowest set bits.
+            for ( ; k; --k )
+            {
+                word &= word - 1;
+            }
+            return i * 64 + bitscan_forward ( word );
+        }
+        k -= count;
+    }
+    return length;
+}
@@ -3,6 +3,11 @@
  * @file core/bitv.h
  * @brief Functions which implement bit manipulation operations on bit vectors
  * of arbitrary length.
+ * 
+ * A bit vector of length n occupies ( n + 7 ) / 8 bytes; bit i is bit i % 8 of
+ * byte i / 8. Bulk operations (see bitv_and, bitv_count, bitv_next_set, etc.)
+ * work a 64-bit word or a SIMD block at a time, never read or write past the
+ * last byte, and leave the unused high bits of the last byte untouched.
  */
 #ifndef BITV_H
 #define BITV_H
@@ -88,6 +93,174 @@ bitv_swp
     return bitv;
 }
 
+/**
+ * @brief Computes the bitwise AND of two bit vectors: dst = a & b.
+ * 
+ * @param dst Output buffer. May be a or b. Must be non-zero.
+ * @param a A bit vector. Must be non-zero.
+ * @param b A bit vector. Must be non-zero.
+ * @param length The number of bits in each vector.
+ * @return dst.
+ */
+void*
+bitv_and
+(   void*       dst
+,   const void* a
+,   const void* b
+,   const u64   length
+);
+
+/**
+ * @brief Computes the bitwise OR of two bit vectors: dst = a | b.
+ * 
+ * @param dst Output buffer. May be a or b. Must be non-zero.
+ * @param a A bit vector. Must be non-zero.
+ * @param b A bit vector. Must be non-zero.
+ * @param length The number of bits in each vector.
+ * @return dst.
+ */
+void*
+bitv_or
+(   void*       dst
+,   const void* a
+,   const void* b
+,   const u64   length
+);
+
+/**
+ * @brief Computes the bitwise XOR of two bit vectors: dst = a ^ b.
+ * 
+ * @param dst Output buffer. May be a or b. Must be non-zero.
+ * @param a A bit vector. Must be non-zero.
+ * @param b A bit vector. Must be non-zero.
+ * @param length The number of bits in each vector.
+ * @return dst.
+ */
+void*
+bitv_xor
+(   void*       dst
+,   const void* a
+,   const void* b
+,   const u64   length
+);
+
+/**
+ * @brief Clears the bits of one bit vector which are set in another:
+ * dst = a & ~b.
+ * 
+ * @param dst Output buffer. May be a or b. Must be non-zero.
+ * @param a A bit vector. Must be non-zero.
+ * @param b A bit vector. Must be non-zero.
+ * @param length The number of bits in each vector.
+ * @return dst.
+ */
+void*
+bitv_andnot
+(   void*       dst
+,   const void* a
+,   const void* b
+,   const u64   length
+);
+
+/**
+ * @brief Computes the bitwise complement of a bit vector: dst = ~a.
+ * 
+ * @param dst Output buffer. May be a. Must be non-zero.
+ * @param a A bit vector. Must be non-zero.
+ * @param length The number of bits in the vector.
+ * @return dst.
+ */
+void*
+bitv_not
+(   void*       dst
+,   const void* a
+,   const u64   length
+);
+
+/**
+ * @brief Counts the set bits within a bit vector (population count).
+ * 
+ * @param bitv A bit vector. Must be non-zero.
+ * @param length The number of bits in the vector.
+ * @return The number of set bits.
+ */
+u64
+bitv_count
+(   const void* bitv
+,   const u64   length
+);
+
+/**
+ * @brief Finds the first set bit at or after a given position.
+ * 
+ * To visit every set bit:
+ *   for ( u64 i = bitv_first_set ( v , n ); i < n; i = bitv_next_set ( v , n , i + 1 ) )
+ * 
+ * @param bitv A bit vector. Must be non-zero.
+ * @param length The number of bits in the vector.
+ * @param from The position to start searching from.
+ * @return The index of the first set bit at or after from, or length if there
+ * is none.
+ */
+u64
+bitv_next_set
+(   const void* bitv
+,   const u64   length
+,   const u64   from
+);
+
+/**
+ * @brief Finds the first clear bit at or after a given position.
+ * 
+ * @param bitv A bit vector. Must be non-zero.
+ * @param length The number of bits in the vector.
+ * @param from The position to start searching from.
+ * @return The index of the first clear bit at or after from, or length if
+ * there is none.
+ */
+u64
+bitv_next_clr
+(   const void* bitv
+,   const u64   length
+,   const u64   from
+);
+
+#define bitv_first_set(bitv,length) \
+    bitv_next_set ( (bitv) , (length) , 0 )
+
+#define bitv_first_clr(bitv,length) \
+    bitv_next_clr ( (bitv) , (length) , 0 )
+
+/**
+ * @brief Counts the set bits before a given position (rank).
+ * 
+ * @param bitv A bit vector. Must be non-zero.
+ * @param n The position. The vector must be at least n bits long.
+ * @return The number of set bits in [ 0 , n ).
+ */
+u64
+bitv_rank
+(   const void* bitv
+,   const u64   n
+);
+
+/**
+ * @brief Finds the position of the k-th set bit (select). The inverse of
+ * bitv_rank: bitv_rank ( bitv , bitv_select ( bitv , length , k ) ) == k.
+ * 
+ * @param bitv A bit vector. Must be non-zero.
+ * @param length The number of bits in the vector.
+ * @param k The number of set bits to skip (0 selects the first).
+ * @return The index of the k-th set bit (counting from 0), or length if fewer
+ * than k + 1 bits are set.
+ */
+u64
+bitv_select
+(   const void* bitv
+,   const u64   length
+,   const u64   k
+);
+
 /**
  * @brief Sets every bit within a bit vector.
  * 
@@ -109,9 +282,9 @@ bitv_set_all
     const u64 byte = length / 8;
     const u64 bit = length % 8;
     memory_set ( bitv , -1 , byte );
-    for ( u64 i = 0; i < bit; ++i )
+    if ( bit )
     {
-        BITSET ( ( ( u8* ) bitv )[ byte ] , i );
+        ( ( u8* ) bitv )[ byte ] |= ( 1 << bit ) - 1;
     }
     return bitv;
 }
@@ -137,9 +310,9 @@ bitv_clr_all
     const u64 byte = length / 8;
     const u64 bit = length % 8;
     memory_set ( bitv , 0 , byte );
-    for ( u64 i = 0; i < bit; ++i )
+    if ( bit )
     {
-        BITCLR ( ( ( u8* ) bitv )[ byte ] , i );
+        ( ( u8* ) bitv )[ byte ] &= ~( ( 1 << bit ) - 1 );
     }
     return bitv;
 }
@@ -164,13 +337,10 @@ bitv_swp_all
     }
     const u64 byte = length / 8;
     const u64 bit = length % 8;
-    for ( u64 i = 0; i < byte; ++i )
-    {
-        ( ( u8* ) bitv )[ i ] = ~( ( ( u8* ) bitv )[ i ] );
-    }
-    for ( u64 i = 0; i < bit; ++i )
+    bitv_not ( bitv , bitv , byte * 8 );
+    if ( bit )
     {
-        BITSWP ( ( ( u8* ) bitv )[ byte ] , i );
+        ( ( u8* ) bitv )[ byte ] ^= ( 1 << bit ) - 1;
     }
     return bitv;
 }
@@ -0,0 +1,696 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/checksum.c
+ * @brief Implementation of the core/checksum header.
+ * (see core/checksum.h for additional details)
+ */
+#include "core/checksum.h"
+
+#include "math/clamp.h"
+
+#include "platform/cpu.h"
+
+// Kernels for every instruction set the compiler can target are built into
+// each binary, each function with its own target attribute; which ones run is
+// decided at runtime (see checksum_dispatch).
+#if PLATFORM_ARCH_X86 == 1 && PLATFORM_COMPILER_GCC == 1
+    #include <immintrin.h>
+    #define CHECKSUM_X86 1
+#elif defined(__aarch64__) && PLATFORM_COMPILER_GCC == 1
+    #include <arm_acle.h>
+    #define CHECKSUM_ARM 1
+#endif
+
+/** @brief CRC32C polynomial (bit-reflected). */
+#define CHECKSUM_CRC32C_POLYNOMIAL 0x82F63B78
+
+/** @brief CRC32 polynomial (bit-reflected). */
+#define CHECKSUM_CRC32_POLYNOMIAL 0xEDB88320
+
+// XXH64 primes.
+#define CHECKSUM_XXH64_PRIME_1 0x9E3779B185EBCA87ULL
+#define CHECKSUM_XXH64_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define CHECKSUM_XXH64_PRIME_3 0x165667B19E3779F9ULL
+#define CHECKSUM_XXH64_PRIME_4 0x85EBCA77C2B2AE63ULL
+#define CHECKSUM_XXH64_PRIME_5 0x27D4EB2F165667C5ULL
+
+/**
+ * @brief Type definition for a CRC kernel. Operates on the internal
+ * (inverted) CRC register.
+ *
+ * @param data The data to checksum.
+ * @param size The number of bytes to checksum.
+ * @param crc The register.
+ * @return The register after data.
+ */
+typedef u32 ( *checksum_kernel_t )( const u8* data
+                                  , u64       size
+                                  , u32       crc
+                                  );
+
+/** @brief Type definition for a set of CRC kernels. */
+typedef struct
+{
+    const char*         name;
+    checksum_kernel_t   crc32c;
+    checksum_kernel_t   crc32;
+}
+checksum_kernels_t;
+
+/**
+ * @brief Slicing-by-8 lookup tables (see _checksum_crc_scalar): entry [k][b]
+ * is the register contribution of byte b followed by k zero bytes.
+ */
+static u32 checksum_crc32c_table[ 8 ][ 256 ];
+static u32 checksum_crc32_table[ 8 ][ 256 ];
+
+/**
+ * @brief Reads four bytes as a little-endian integer. Does not require
+ * alignment.
+ *
+ * @param p Address to read from. Must be non-zero.
+ * @return The integer.
+ */
+INLINE u32
+_checksum_read4
+(   const u8* p
+)
+{
+    return ( ( u32 ) p[ 0 ] )
+         | ( ( u32 ) p[ 1 ] << 8 )
+         | ( ( u32 ) p[ 2 ] << 16 )
+         | ( ( u32 ) p[ 3 ] << 24 )
+         ;
+}
+
+/**
+ * @brief Reads eight bytes as a little-endian integer. Does not require
+ * alignment; compiles to a single load on little-endian targets.
+ *
+ * @param p Address to read from. Must be non-zero.
+ * @return The integer.
+ */
+INLINE u64
+_checksum_read8
+(   const u8* p
+)
+{
+    return ( ( u64 ) _checksum_read4 ( p ) )
+         | ( ( u64 ) _checksum_read4 ( p + 4 ) << 32 )
+         ;
+}
+
+/**
+ * @brief Rotates a 64-bit integer left.
+ */
+INLINE u64
+_checksum_rotl64
+(   u64 x
+,   u32 n
+)
+{
+    return ( x << n ) | ( x >> ( 64 - n ) );
+}
+
+/**
+ * @brief Fills the slicing-by-8 lookup tables for a polynomial. Idempotent.
+ *
+ * @param polynomial The bit-reflected polynomial.
+ * @param table The tables to fill.
+ */
+INLINE void
+_checksum_table_init
+(   u32 polynomial
+,   u32 table[ 8 ][ 256 ]
+)
+{
+    for ( u32 i = 0; i < 256; ++i )
+    {
+        u32 crc = i;
+        for ( u32 j = 0; j < 8; ++j )
+        {
+            crc = ( crc >> 1 ) ^ ( ( crc & 1 ) ? polynomial : 0 );
+        }
+        table[ 0 ][ i ] = crc;
+    }
+    for ( u32 i = 0; i < 256; ++i )
+    {
+        for ( u32 k = 1; k < 8; ++k )
+        {
+            const u32 previous = table[ k - 1 ][ i ];
+            table[ k ][ i ] = ( previous >> 8 ) ^ table[ 0 ][ previous & 0xFF ];
+        }
+    }
+}
+
+/**
+ * @brief Table-driven CRC (any host). Consumes eight bytes per step, with one
+ * lookup per byte, all independent (slicing-by-8).
+ *
+ * @param table The lookup tables of the polynomial.
+ * @param data The data to checksum.
+ * @param size The number of bytes to checksum.
+ * @param crc The register.
+ * @return The register after data.
+ */
+INLINE u32
+_checksum_crc_scalar
+(   const u32   table[ 8 ][ 256 ]
+,   const u8*   data
+,   u64         size
+,   u32         crc
+)
+{
+    while ( size >= 8 )
+    {
+        const u64 word = _checksum_read8 ( data ) ^ crc;
+        crc = table[ 7 ][ word & 0xFF ]
+            ^ table[ 6 ][ ( word >> 8 ) & 0xFF ]
+            ^ table[ 5 ][ ( word >> 16 ) & 0xFF ]
+            ^ table[ 4 ][ ( word >> 24 ) & 0xFF ]
+            ^ table[ 3 ][ ( word >> 32 ) & 0xFF ]
+            ^ table[ 2 ][ ( word >> 40 ) & 0xFF ]
+            ^ table[ 1 ][ ( word >> 48 ) & 0xFF ]
+            ^ table[ 0 ][ word >> 56 ]
+            ;
+        data += 8;
+        size -= 8;
+    }
+    while ( size )
+    {
+        crc = ( crc >> 8 ) ^ table[ 0 ][ ( crc ^ *data ) & 0xFF ];
+        data += 1;
+        size -= 1;
+    }
+    return crc;
+}
+
+static u32
+_checksum_crc32c_scalar
+(   const u8*   data
+,   u64         size
+,   u32         crc
+)
+{
+    return _checksum_crc_scalar ( checksum_crc32c_table , data , size , crc );
+}
+
+static u32
+_checksum_crc32_scalar
+(   const u8*   data
+,   u64         size
+,   u32         crc
+)
+{
+    return _checksum_crc_scalar ( checksum_crc32_table , data , size , crc );
+}
+
+static const checksum_kernels_t checksum_scalar = { "scalar"
+                                                  , _checksum_crc32c_scalar
+                                                  , _checksum_crc32_scalar
+                                                  };
+
+#if CHECKSUM_X86 == 1
+
+/**
+ * @brief CRC32C with the SSE4.2 crc32 instruction, eight bytes at a time.
+ */
+static __attribute__ ( ( target ( "sse4.2" ) ) ) u32
+_checksum_crc32c_sse42
+(   const u8*   data
+,   u64         size
+,   u32         crc
+)
+{
+    // Align, so that no load crosses a cache line.
+    while ( size && ( ( ( u64 ) data ) & 7 ) )
+    {
+        crc = _mm_crc32_u8 ( crc , *data );
+        data += 1;
+        size -= 1;
+    }
+    u64 crc64 = crc;
+    while ( size >= 32 )
+    {
+        crc64 = _mm_crc32_u64 ( crc64 , _checksum_read8 ( data ) );
+        crc64 = _mm_crc32_u64 ( crc64 , _checksum_read8 ( data + 8 ) );
+        crc64 = _mm_crc32_u64 ( crc64 , _checksum_read8 ( data + 16 ) );
+        crc64 = _mm_crc32_u64 ( crc64 , _checksum_read8 ( data + 24 ) );
+        data += 32;
+        size -= 32;
+    }
+    while ( size >= 8 )
+    {
+        crc64 = _mm_crc32_u64 ( crc64 , _checksum_read8 ( data ) );
+        data += 8;
+        size -= 8;
+    }
+    crc = ( u32 ) crc64;
+    while ( size )
+    {
+        crc = _mm_crc32_u8 ( crc , *data );
+        data += 1;
+        size -= 1;
+    }
+    return crc;
+}
+
+/**
+ * @brief CRC32 by folding with carry-less multiplication (PCLMULQDQ): four
+ * 128-bit lanes are folded forward 64 bytes at a time, then into one lane,
+ * which is reduced to 32 bits (Barrett reduction). Based on "Fast CRC
+ * Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel,
+ * 2009). Buffers shorter than 64 bytes, and the final size % 16 bytes, go
+ * through the lookup tables instead.
+ */
+static __attribute__ ( ( target ( "sse4.1,pclmul" ) ) ) u32
+_checksum_crc32_pclmul
+(   const u8*   data
+,   u64         size
+,   u32         crc
+)
+{
+    if ( size < 64 )
+    {
+        return _checksum_crc32_scalar ( data , size , crc );
+    }
+
+    // x^(4*128+32) mod P, x^(4*128-32) mod P, x^(128+32) mod P,
+    // x^(128-32) mod P, x^64 mod P; then P and floor(x^64 / P), for the
+    // Barrett reduction. Bit-reflected.
+    const __m128i k1k2 = _mm_set_epi64x ( 0x01C6E41596 , 0x0154442BD4 );
+    const __m128i k3k4 = _mm_set_epi64x ( 0x00CCAA009E , 0x01751997D0 );
+    const __m128i k5k0 = _mm_set_epi64x ( 0x0000000000 , 0x0163CD6124 );
+    const __m128i poly = _mm_set_epi64x ( 0x01F7011641 , 0x01DB710641 );
+    const __m128i mask = _mm_setr_epi32 ( ~0 , 0 , ~0 , 0 );
+
+    __m128i x1 = _mm_loadu_si128 ( ( const __m128i* )( data + 0x00 ) );
+    __m128i x2 = _mm_loadu_si128 ( ( const __m128i* )( data + 0x10 ) );
+    __m128i x3 = _mm_loadu_si128 ( ( const __m128i* )( data + 0x20 ) );
+    __m128i x4 = _mm_loadu_si128 ( ( const __m128i* )( data + 0x30 ) );
+    x1 = _mm_xor_si128 ( x1 , _mm_cvtsi32_si128 ( ( i32 ) crc ) );
+    data += 64;
+    size -= 64;
+
+    // Fold 64 bytes at a time.
+    while ( size >= 64 )
+    {
+        const __m128i x5 = _mm_clmulepi64_si128 ( x1 , k1k2 , 0x00 );
+        const __m128i x6 = _mm_clmulepi64_si128 ( x2 , k1k2 , 0x00 );
+        const __m128i x7 = _mm_clmulepi64_si128 ( x3 , k1k2 , 0x00 );
+        const __m128i x8 = _mm_clmulepi64_si128 ( x4 , k1k2 , 0x00 );
+        x1 = _mm_clmulepi64_si128 ( x1 , k1k2 , 0x11 );
+        x2 = _mm_clmulepi64_si128 ( x2 , k1k2 , 0x11 );
+        x3 = _mm_clmulepi64_si128 ( x3 , k1k2 , 0x11 );
+        x4 = _mm_clmulepi64_si128 ( x4 , k1k2 , 0x11 );
+        x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1 , x5 ) , _mm_loadu_si128 ( ( const __m128i* )( data + 0x00 ) ) );
+        x2 = _mm_xor_si128 ( _mm_xor_si128 ( x2 , x6 ) , _mm_loadu_si128 ( ( const __m128i* )( data + 0x10 ) ) );
+        x3 = _mm_xor_si128 ( _mm_xor_si128 ( x3 , x7 ) , _mm_loadu_si128 ( ( const __m128i* )( data + 0x20 ) ) );
+        x4 = _mm_xor_si128 ( _mm_xor_si128 ( x4 , x8 ) , _mm_loadu_si128 ( ( const __m128i* )( data + 0x30 ) ) );
+        data += 64;
+        size -= 64;
+    }
+
+    // Fold the four lanes into one.
+    __m128i x5 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x00 );
+    x1 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x11 );
+    x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1 , x2 ) , x5 );
+    x5 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x00 );
+    x1 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x11 );
+    x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1 , x3 ) , x5 );
+    x5 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x00 );
+    x1 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x11 );
+    x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1 , x4 ) , x5 );
+
+    // Fold 16 bytes at a time.
+    while ( size >= 16 )
+    {
+        x5 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x00 );
+        x1 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x11 );
+        x1 = _mm_xor_si128 ( _mm_xor_si128 ( x1 , _mm_loadu_si128 ( ( const __m128i* ) data ) ) , x5 );
+        data += 16;
+        size -= 16;
+    }
+
+    // Fold 128 bits to 64.
+    x2 = _mm_clmulepi64_si128 ( x1 , k3k4 , 0x10 );
+    x1 = _mm_xor_si128 ( _mm_srli_si128 ( x1 , 8 ) , x2 );
+    x2 = _mm_srli_si128 ( x1 , 4 );
+    x1 = _mm_and_si128 ( x1 , mask );
+    x1 = _mm_clmulepi64_si128 ( x1 , k5k0 , 0x00 );
+    x1 = _mm_xor_si128 ( x1 , x2 );
+
+    // Barrett reduction to 32 bits.
+    x2 = _mm_and_si128 ( x1 , mask );
+    x2 = _mm_clmulepi64_si128 ( x2 , poly , 0x10 );
+    x2 = _mm_and_si128 ( x2 , mask );
+    x2 = _mm_clmulepi64_si128 ( x2 , poly , 0x00 );
+    x1 = _mm_xor_si128 ( x1 , x2 );
+    crc = ( u32 ) _mm_extract_epi32 ( x1 , 1 );
+
+    return _checksum_crc32_scalar ( data , size , crc );
+}
+
+static const checksum_kernels_t checksum_sse42 = { "sse4.2"
+                                                 , _checksum_crc32c_sse42
+                                                 , _checksum_crc32_scalar
+                                                 };
+
+static const checksum_kernels_t checksum_sse42_pclmul = { "sse4.2+pclmul"
+                                                        , _checksum_crc32c_sse42
+                                                        , _checksum_crc32_pclmul
+                                                        };
+
+#elif CHECKSUM_ARM == 1
+
+/**
+ * @brief CRC32C or CRC32 with the ARMv8 CRC instructions, eight bytes at a
+ * time.
+ */
+#define CHECKSUM_ARM_KERNEL(name,intrinsic_8,intrinsic_64)                      \
+    static __attribute__ ( ( target ( "+crc" ) ) ) u32                          \
+    name                                                                        \
+    (   const u8*   data                                                        \
+    ,   u64         size                                                        \
+    ,   u32         crc                                                         \
+    )                                                                           \
+    {                                                                           \
+        while ( size && ( ( ( u64 ) data ) & 7 ) )                              \
+        {                                                                       \
+            crc = intrinsic_8 ( crc , *data );                                  \
+            data += 1;                                                          \
+            size -= 1;                                                          \
+        }                                                                       \
+        while ( size >= 8 )                                                     \
+        {                                                                       \
+            crc = intrinsic_64 ( crc , _checksum_read8 ( data ) );              \
+            data += 8;                                                          \
+            size -= 8;                                                          \
+        }                                                                       \
+        while ( size )                                                          \
+        {                                                                       \
+            crc = intrinsic_8 ( crc , *data );                                  \
+            data += 1;                                                          \
+            size -= 1;                                                          \
+        }                                                                       \
+        return crc;                                                             \
+    }
+
+CHECKSUM_ARM_KERNEL ( _checksum_crc32c_arm , __crc32cb , __crc32cd )
+CHECKSUM_ARM_KERNEL ( _checksum_crc32_arm , __crc32b , __crc32d )
+
+static const checksum_kernels_t checksum_arm = { "crc"
+                                               , _checksum_crc32c_arm
+                                               , _checksum_crc32_arm
+                                               };
+
+#endif
+
+// Global state.
+static const checksum_kernels_t* checksum_kernels_state = 0;
+
+/**
+ * @brief Queries the selected kernel set, selecting one for the host on the
+ * first call (see checksum_dispatch).
+ *
+ * @return The selected kernel set.
+ */
+INLINE
+const checksum_kernels_t*
+_checksum_kernels
+( void )
+{
+    const checksum_kernels_t* kernels = atomic_load_ptr ( ( void* const* ) &checksum_kernels_state
+                                                        , ATOMIC_ACQUIRE
+                                                        );
+    if ( !kernels )
+    {
+        checksum_dispatch ( cpu_features () );
+        kernels = atomic_load_ptr ( ( void* const* ) &checksum_kernels_state , ATOMIC_ACQUIRE );
+    }
+    return kernels;
+}
+
+const char*
+checksum_dispatch
+(   u32 features
+)
+{
+    // The tables are also used by the accelerated kernels, for short tails.
+    _checksum_table_init ( CHECKSUM_CRC32C_POLYNOMIAL , checksum_crc32c_table );
+    _checksum_table_init ( CHECKSUM_CRC32_POLYNOMIAL , checksum_crc32_table );
+
+    const checksum_kernels_t* kernels = &checksum_scalar;
+#if CHECKSUM_X86 == 1
+    const u32 pclmul = CPU_FEATURE_SSE41 | CPU_FEATURE_SSE42 | CPU_FEATURE_PCLMUL;
+    if ( ( features & pclmul ) == pclmul )
+    {
+        kernels = &checksum_sse42_pclmul;
+    }
+    else if ( ( features & CPU_FEATURE_SSE42 ) )
+    {
+        kernels = &checksum_sse42;
+    }
+#elif CHECKSUM_ARM == 1
+    if ( ( features & CPU_FEATURE_CRC32 ) )
+    {
+        kernels = &checksum_arm;
+    }
+#endif
+    atomic_store_ptr ( ( void** ) &checksum_kernels_state , ( void* ) kernels , ATOMIC_RELEASE );
+    return ( *kernels ).name;
+}
+
+u32
+checksum_crc32c
+(   const void* data
+,   u64         size
+,   u32         crc
+)
+{
+    return ~( *_checksum_kernels () ).crc32c ( data , size , ~crc );
+}
+
+u32
+checksum_crc32
+(   const void* data
+,   u64         size
+,   u32         crc
+)
+{
+    return ~( *_checksum_kernels () ).crc32 ( data , size , ~crc );
+}
+
+/**
+ * @brief XXH64 round: mixes one 8-byte lane into an accumulator.
+ */
+INLINE u64
+_checksum_xxh64_round
+(   u64 accumulator
+,   u64 input
+)
+{
+    accumulator += input * CHECKSUM_XXH64_PRIME_2;
+    accumulator = _checksum_rotl64 ( accumulator , 31 );
+    return accumulator * CHECKSUM_XXH64_PRIME_1;
+}
+
+/**
+ * @brief XXH64 merge: mixes an accumulator into the digest.
+ */
+INLINE u64
+_checksum_xxh64_merge
+(   u64 hash
+,   u64 accumulator
+)
+{
+    hash ^= _checksum_xxh64_round ( 0 , accumulator );
+    return hash * CHECKSUM_XXH64_PRIME_1 + CHECKSUM_XXH64_PRIME_4;
+}
+
+/**
+ * @brief Consumes whole XXH64 stripes.
+ *
+ * @param accumulators The four accumulators.
+ * @param data The data. Must hold size bytes.
+ * @param size The number of bytes to consume. Must be a multiple of
+ * CHECKSUM_XXH64_STRIPE_SIZE.
+ */
+INLINE void
+_checksum_xxh64_stripes
+(   u64         accumulators[ 4 ]
+,   const u8*   data
+,   u64         size
+)
+{
+    u64 v1 = accumulators[ 0 ];
+    u64 v2 = accumulators[ 1 ];
+    u64 v3 = accumulators[ 2 ];
+    u64 v4 = accumulators[ 3 ];
+    for ( const u8* end = data + size; data < end; data += CHECKSUM_XXH64_STRIPE_SIZE )
+    {
+        v1 = _checksum_xxh64_round ( v1 , _checksum_read8 ( data ) );
+        v2 = _checksum_xxh64_round ( v2 , _checksum_read8 ( data + 8 ) );
+        v3 = _checksum_xxh64_round ( v3 , _checksum_read8 ( data + 16 ) );
+        v4 = _checksum_xxh64_round ( v4 , _checksum_read8 ( data + 24 ) );
+    }
+    accumulators[ 0 ] = v1;
+    accumulators[ 1 ] = v2;
+    accumulators[ 2 ] = v3;
+    accumulators[ 3 ] = v4;
+}
+
+/**
+ * @brief Computes an XXH64 digest from the accumulators and the final partial
+ * stripe.
+ *
+ * @param accumulators The four accumulators.
+ * @param seed The seed.
+ * @param total The total number of bytes digested.
+ * @param data The final partial stripe.
+ * @param size The number of bytes in data (less than a stripe).
+ * @return The digest.
+ */
+INLINE u64
+_checksum_xxh64_finalize
+(   const u64   accumulators[ 4 ]
+,   u64         seed
+,   u64         total
+,   const u8*   data
+,   u64         size
+)
+{
+    u64 hash;
+    if ( total >= CHECKSUM_XXH64_STRIPE_SIZE )
+    {
+        hash = _checksum_rotl64 ( accumulators[ 0 ] , 1 )
+             + _checksum_rotl64 ( accumulators[ 1 ] , 7 )
+             + _checksum_rotl64 ( accumulators[ 2 ] , 12 )
+             + _checksum_rotl64 ( accumulators[ 3 ] , 18 )
+             ;
+        hash = _checksum_xxh64_merge ( hash , accumulators[ 0 ] );
+        hash = _checksum_xxh64_merge ( hash , accumulators[ 1 ] );
+        hash = _checksum_xxh64_merge ( hash , accumulators[ 2 ] );
+        hash = _checksum_xxh64_merge ( hash , accumulators[ 3 ] );
+    }
+    else
+    {
+        hash = seed + CHECKSUM_XXH64_PRIME_5;
+    }
+    hash += total;
+
+    while ( size >= 8 )
+    {
+        hash ^= _checksum_xxh64_round ( 0 , _checksum_read8 ( data ) );
+        hash = _checksum_rotl64 ( hash , 27 ) * CHECKSUM_XXH64_PRIME_1 + CHECKSUM_XXH64_PRIME_4;
+        data += 8;
+        size -= 8;
+    }
+    if ( size >= 4 )
+    {
+        hash ^= ( ( u64 ) _checksum_read4 ( data ) ) * CHECKSUM_XXH64_PRIME_1;
+        hash = _checksum_rotl64 ( hash , 23 ) * CHECKSUM_XXH64_PRIME_2 + CHECKSUM_XXH64_PRIME_3;
+        data += 4;
+        size -= 4;
+    }
+    while ( size )
+    {
+        hash ^= ( *data ) * CHECKSUM_XXH64_PRIME_5;
+        hash = _checksum_rotl64 ( hash , 11 ) * CHECKSUM_XXH64_PRIME_1;
+        data += 1;
+        size -= 1;
+    }
+
+    // Avalanche.
+    hash ^= hash >> 33;
+    hash *= CHECKSUM_XXH64_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= CHECKSUM_XXH64_PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+u64
+checksum_xxh64
+(   const void* data
+,   u64         size
+,   u64         seed
+)
+{
+    checksum_xxh64_t state;
+    checksum_xxh64_begin ( seed , &state );
+    const u64 stripes = size - size % CHECKSUM_XXH64_STRIPE_SIZE;
+    _checksum_xxh64_stripes ( state.accumulators , data , stripes );
+    return _checksum_xxh64_finalize ( state.accumulators
+                                    , seed
+                                    , size
+                                    , ( ( const u8* ) data ) + stripes
+                                    , size - stripes
+                                    );
+}
+
+void
+checksum_xxh64_begin
+(   u64                 seed
+,   checksum_xxh64_t*   state
+)
+{
+    ( *state ).accumulators[ 0 ] = seed + CHECKSUM_XXH64_PRIME_1 + CHECKSUM_XXH64_PRIME_2;
+    ( *state ).accumulators[ 1 ] = seed + CHECKSUM_XXH64_PRIME_2;
+    ( *state ).accumulators[ 2 ] = seed;
+    ( *state ).accumulators[ 3 ] = seed - CHECKSUM_XXH64_PRIME_1;
+    ( *state ).seed = seed;
+    ( *state ).size = 0;
+    ( *state ).buffered = 0;
+}
+
+void
+checksum_xxh64_update
+(   checksum_xxh64_t*   state
+,   const void*         data_
+,   u64                 size
+)
+{
+    const u8* data = data_;
+    ( *state ).size += size;
+
+    // Complete a partial stripe left over from the previous update.
+    if ( ( *state ).buffered )
+    {
+        const u64 fill = MIN ( size , CHECKSUM_XXH64_STRIPE_SIZE - ( *state ).buffered );
+        for ( u64 i = 0; i < fill; ++i )
+        {
+            ( *state ).buffer[ ( *state ).buffered + i ] = data[ i ];
+        }
+        ( *state ).buffered += fill;
+        data += fill;
+        size -= fill;
+        if ( ( *state ).buffered < CHECKSUM_XXH64_STRIPE_SIZE )
+        {
+            return;
+        }
+        _checksum_xxh64_stripes ( ( *state ).accumulators , ( *state ).buffer , CHECKSUM_XXH64_STRIPE_SIZE );
+        ( *state ).buffered = 0;
+    }
+
+    const u64 stripes = size - size % CHECKSUM_XXH64_STRIPE_SIZE;
+    _checksum_xxh64_stripes ( ( *state ).accumulators , data , stripes );
+    for ( u64 i = stripes; i < size; ++i )
+    {
+        ( *state ).buffer[ i - stripes ] = data[ i ];
+    }
+    ( *state ).buffered = size - stripes;
+}
+
+u64
+checksum_xxh64_end
+(   const checksum_xxh64_t* state
+)
+{
+    return _checksum_xxh64_finalize ( ( *state ).accumulators
+                                    , ( *state ).seed
+                                    , ( *state ).size
+                                    , ( *state ).buffer
+                                    , ( *state ).buffered
+                                    );
+}
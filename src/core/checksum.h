@@ -0,0 +1,150 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/checksum.h
+ * @brief Provides an interface for checksums, to verify the integrity of files
+ * and buffers.
+ *
+ * CRC32C (Castagnoli) is the checksum of choice: it detects more error
+ * patterns than CRC32, and both x86 (SSE4.2) and ARMv8 compute it in hardware.
+ * CRC32 (IEEE 802.3, as used by zlib, gzip and PNG) is provided for
+ * compatibility with those formats; on x86 it is computed by folding with
+ * carry-less multiplication (PCLMULQDQ). XXH64 is provided as a faster
+ * alternative where a 64-bit digest is preferred and compatibility with the
+ * reference xxHash implementation is required.
+ *
+ * Every checksum may be computed incrementally, so data may be checksummed as
+ * it is produced or consumed (e.g. by a buffered file writer or reader; see
+ * platform/filesystem.h), without a second pass over it:
+ *
+ *   u32 crc = 0;
+ *   crc = checksum_crc32c ( chunk0 , size0 , crc );
+ *   crc = checksum_crc32c ( chunk1 , size1 , crc );
+ *
+ * Kernels for every instruction set the compiler can target are built in; the
+ * fastest one the host supports is selected the first time a checksum is
+ * computed (see checksum_dispatch).
+ */
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include "common.h"
+
+/** @brief XXH64 stripe size (in bytes). */
+#define CHECKSUM_XXH64_STRIPE_SIZE 32
+
+/**
+ * @brief Type definition for the state of an incremental XXH64 computation
+ * (see checksum_xxh64_begin). Fields are internal.
+ */
+typedef struct
+{
+    u64 accumulators[ 4 ];
+    u64 seed;
+    u64 size;
+    u64 buffered;
+    u8  buffer[ CHECKSUM_XXH64_STRIPE_SIZE ];
+}
+checksum_xxh64_t;
+
+/**
+ * @brief Computes or continues a CRC32C (Castagnoli polynomial) checksum. O(n).
+ *
+ * @param data The data to checksum. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to checksum.
+ * @param crc The checksum of the data which precedes data, or 0 to start a new
+ * checksum.
+ * @return The checksum of the data up to and including data.
+ */
+u32
+checksum_crc32c
+(   const void* data
+,   u64         size
+,   u32         crc
+);
+
+/**
+ * @brief Computes or continues a CRC32 (IEEE 802.3 polynomial) checksum,
+ * identical to the one computed by zlib's crc32. O(n).
+ *
+ * @param data The data to checksum. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to checksum.
+ * @param crc The checksum of the data which precedes data, or 0 to start a new
+ * checksum.
+ * @return The checksum of the data up to and including data.
+ */
+u32
+checksum_crc32
+(   const void* data
+,   u64         size
+,   u32         crc
+);
+
+/**
+ * @brief Computes an XXH64 digest in one pass. O(n).
+ *
+ * @param data The data to digest. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to digest.
+ * @param seed The seed.
+ * @return The digest.
+ */
+u64
+checksum_xxh64
+(   const void* data
+,   u64         size
+,   u64         seed
+);
+
+/**
+ * @brief Starts an incremental XXH64 computation.
+ *
+ * @param seed The seed.
+ * @param state Output buffer for the state. Must be non-zero.
+ */
+void
+checksum_xxh64_begin
+(   u64                 seed
+,   checksum_xxh64_t*   state
+);
+
+/**
+ * @brief Digests more data in an incremental XXH64 computation. O(n).
+ *
+ * @param state The state to update. Must be non-zero.
+ * @param data The data to digest. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to digest.
+ */
+void
+checksum_xxh64_update
+(   checksum_xxh64_t*   state
+,   const void*         data
+,   u64                 size
+);
+
+/**
+ * @brief Computes the digest of every byte passed to an incremental XXH64
+ * computation so far. The computation may be continued afterwards.
+ *
+ * @param state The state to query. Must be non-zero.
+ * @return The digest; identical to that computed by checksum_xxh64 on the
+ * concatenation of the data.
+ */
+u64
+checksum_xxh64_end
+(   const checksum_xxh64_t* state
+);
+
+/**
+ * @brief Selects the CRC kernels, from the fastest ones a set of instruction
+ * set extensions supports. Called automatically with the host's extensions
+ * (see cpu_features in platform/cpu.h) the first time a CRC is computed;
+ * call explicitly to force slower kernels, e.g. to test or benchmark them.
+ *
+ * @param features A combination of CPU_FEATURE flags (see platform/cpu.h).
+ * @return The name of the selected kernels.
+ */
+const char*
+checksum_dispatch
+(   u32 features
+);
+
+#endif  // CHECKSUM_H
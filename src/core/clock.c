@@ -8,6 +8,56 @@
 
 #include "platform/platform.h"
 
+/** @brief Cycle counter ticks per second; 0 until calibrated (see clock_tick_frequency). */
+static u64 clock_frequency = 0;
+
+u64
+clock_time
+( void )
+{
+    return platform_absolute_time_ns ();
+}
+
+u64
+clock_tick_frequency
+( void )
+{
+    u64 frequency = atomic_load_u64 ( &clock_frequency , ATOMIC_RELAXED );
+    if ( frequency )
+    {
+        return frequency;
+    }
+
+#if PLATFORM_ARCH_X86 == 1
+    // Concurrent first calls each calibrate; any result will do.
+    const u64 start = clock_time ();
+    const u64 start_ticks = clock_ticks ();
+    u64 end;
+    do
+    {
+        end = clock_time ();
+    }
+    while ( end - start < CLOCK_CALIBRATION_TIME );
+    const u64 ticks = clock_ticks () - start_ticks;
+    frequency = ( u64 )( ( ( f64 ) ticks ) * 1.0E9 / ( ( f64 )( end - start ) ) );
+#elif defined ( __aarch64__ )
+    __asm__ volatile ( "mrs %0, cntfrq_el0" : "=r" ( frequency ) );
+#else
+    frequency = 1000000000;
+#endif
+
+    atomic_store_u64 ( &clock_frequency , frequency , ATOMIC_RELAXED );
+    return frequency;
+}
+
+u64
+clock_ticks_to_ns
+(   u64 ticks
+)
+{
+    return ( u64 )( ( ( f64 ) ticks ) * 1.0E9 / ( ( f64 ) clock_tick_frequency () ) );
+}
+
 void
 clock_update
 (   clock_t* clock
@@ -15,7 +65,7 @@ clock_update
 {
     if ( ( *clock ).start )
     {
-        ( *clock ).elapsed = platform_absolute_time () - ( *clock ).start;
+        ( *clock ).elapsed = ( *clock ).accumulated + clock_time () - ( *clock ).start;
     }
 }
 
@@ -24,7 +74,9 @@ clock_start
 (   clock_t* clock
 )
 {
-    ( *clock ).start = platform_absolute_time ();
+    ( *clock ).start = clock_time ();
+    ( *clock ).lap = ( *clock ).start;
+    ( *clock ).accumulated = 0;
     ( *clock ).elapsed = 0;
 }
 
@@ -33,5 +85,36 @@ clock_stop
 (   clock_t* clock
 )
 {
+    if ( !( *clock ).start )
+    {
+        return;
+    }
+    clock_update ( clock );
+    ( *clock ).accumulated = ( *clock ).elapsed;
     ( *clock ).start = 0;
 }
+
+void
+clock_resume
+(   clock_t* clock
+)
+{
+    if ( ( *clock ).start )
+    {
+        return;
+    }
+    ( *clock ).start = clock_time ();
+    ( *clock ).lap = ( *clock ).start;
+}
+
+u64
+clock_lap
+(   clock_t* clock
+)
+{
+    const u64 now = clock_time ();
+    const u64 lap = now - ( *clock ).lap;
+    ( *clock ).lap = now;
+    ( *clock ).elapsed = ( *clock ).accumulated + now - ( *clock ).start;
+    return lap;
+}
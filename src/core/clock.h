@@ -1,26 +1,118 @@
 /**
  * @author Matthew Weissel (mweissel3@gatech.edu)
  * @file core/clock.h
- * @brief Provides an interface for a clock data structure.
+ * @brief Provides an interface for a clock data structure, and for reading the
+ * system's monotonic clock and the processor's cycle counter.
+ *
+ * All times are integer nanoseconds from the platform's monotonic clock
+ * (see platform_absolute_time_ns), so that they are exact regardless of uptime
+ * and cost no floating point conversion per reading. Use clock_seconds to
+ * convert for display.
+ *
+ * For intervals too short for the monotonic clock (which costs a few tens of
+ * nanoseconds per reading, even through the vDSO), read the cycle counter
+ * with clock_ticks and convert the difference with clock_ticks_to_ns. The
+ * counter runs at a fixed rate (invariant TSC on x86, the generic timer on
+ * ARM64), calibrated once against the monotonic clock.
  */
 #ifndef CLOCK_H
 #define CLOCK_H
 
 #include "common.h"
 
-/** @brief Type definition for a clock. */
+/** @brief Type definition for a clock. Times are in nanoseconds. */
 typedef struct
 {
-    f64 start;
-    f64 elapsed;
+    u64 start;          // Time the clock was last started or resumed; 0 while stopped.
+    u64 lap;            // Time of the last lap (see clock_lap).
+    u64 accumulated;    // Total time of the intervals before the current one.
+    u64 elapsed;        // Total time as of the last update or stop.
 }
 clock_t;
 
+/**
+ * @brief Queries the system's monotonic clock.
+ * 
+ * @return The time in nanoseconds since an arbitrary fixed point (typically
+ * system boot).
+ */
+u64
+clock_time
+( void );
+
+/**
+ * @brief Reads the processor's cycle counter: the time-stamp counter on x86,
+ * or the virtual counter on ARM64. The rate is fixed, but not necessarily the
+ * core clock rate (see clock_tick_frequency). On other architectures, falls
+ * back on clock_time.
+ * 
+ * Not serializing: the read may be reordered with nearby instructions, which
+ * matters only for intervals of a few tens of cycles.
+ * 
+ * @return The cycle counter.
+ */
+INLINE
+u64
+clock_ticks
+( void )
+{
+#if PLATFORM_ARCH_X86 == 1
+    return __builtin_ia32_rdtsc ();
+#elif defined ( __aarch64__ )
+    u64 ticks;
+    __asm__ volatile ( "mrs %0, cntvct_el0" : "=r" ( ticks ) );
+    return ticks;
+#else
+    return clock_time ();
+#endif
+}
+
+/**
+ * @brief Queries the rate of the cycle counter (see clock_ticks).
+ * 
+ * On x86, the first call calibrates the counter against the monotonic clock,
+ * which takes CLOCK_CALIBRATION_TIME. Thread-safe.
+ * 
+ * @return The number of cycle counter ticks per second.
+ */
+u64
+clock_tick_frequency
+( void );
+
+/** @brief Duration (in nanoseconds) of cycle counter calibration (see clock_tick_frequency). */
+#define CLOCK_CALIBRATION_TIME 10000000
+
+/**
+ * @brief Converts a number of cycle counter ticks to nanoseconds.
+ * 
+ * @param ticks The difference of two clock_ticks readings.
+ * @return ticks in nanoseconds.
+ */
+u64
+clock_ticks_to_ns
+(   u64 ticks
+);
+
+/**
+ * @brief Converts nanoseconds to seconds (for display purposes).
+ * 
+ * @param ns A time in nanoseconds.
+ * @return ns in seconds.
+ */
+INLINE
+f64
+clock_seconds
+(   u64 ns
+)
+{
+    return ( ( f64 ) ns ) * 1.0E-9;
+}
+
 /**
  * @brief Updates the provided clock.
  * 
  * To be invoked just before checking the elapsed time.
- * Has no effect on clocks that have not been started.
+ * Has no effect on clocks that are stopped.
  * 
  * @param clock The clock to update. Must be non-zero.
  */
@@ -40,7 +132,10 @@ clock_start
 );
 
 /**
- * @brief Stops the provided clock.
+ * @brief Stops the provided clock. The elapsed time is updated, and kept until
+ * the clock is started again.
+ * 
+ * Has no effect on clocks that are stopped.
  * 
  * @param clock The clock to stop. Must be non-zero.
  */
@@ -49,4 +144,31 @@ clock_stop
 (   clock_t* clock
 );
 
+/**
+ * @brief Restarts a stopped clock without resetting its elapsed time, so that
+ * the clock accumulates the time of each interval between clock_resume and
+ * clock_stop.
+ * 
+ * Has no effect on clocks that are running.
+ * 
+ * @param clock The clock to resume. Must be non-zero.
+ */
+void
+clock_resume
+(   clock_t* clock
+);
+
+/**
+ * @brief Queries the time since the provided clock's last lap (or since it was
+ * started or resumed, if more recent), and begins a new lap. Also updates the
+ * elapsed time.
+ * 
+ * @param clock The clock. Must be non-zero, and running.
+ * @return The lap time in nanoseconds.
+ */
+u64
+clock_lap
+(   clock_t* clock
+);
+
 #endif  // CLOCK_H
\ No newline at end of file
@@ -0,0 +1,482 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/compress.c
+ * @brief Implementation of the core/compress header.
+ * (see core/compress.h for additional details)
+ */
+#include "core/compress.h"
+
+#include "common/bitops.h"
+
+#include "core/checksum.h"
+#include "core/memory.h"
+
+#include "math/clamp.h"
+
+/** @brief Frame header magic number ("LZF1"). */
+#define COMPRESS_FRAME_MAGIC 0x31465A4C
+
+/** @brief Set in a frame header's payload size if the content is stored as-is. */
+#define COMPRESS_FRAME_STORED 0x80000000
+
+/** @brief Shortest back-reference (in bytes). */
+#define COMPRESS_MIN_MATCH 4
+
+/**
+ * @brief Distance from the end of a block within which no back-reference may
+ * start (in bytes), and number of bytes at the end of a block which are always
+ * literals. Required by the LZ4 block format, so that a decompressor may copy
+ * in whole words.
+ */
+#define COMPRESS_MATCH_LIMIT    12
+#define COMPRESS_LAST_LITERALS  5
+
+/** @brief Furthest back-reference (in bytes). */
+#define COMPRESS_MAX_OFFSET 65535
+
+/** @brief Number of bits in a match finder hash. */
+#define COMPRESS_HASH_BITS 12
+
+/**
+ * @brief Reads four bytes as a little-endian integer. Does not require
+ * alignment.
+ *
+ * @param p Address to read from. Must be non-zero.
+ * @return The integer.
+ */
+INLINE u32
+_compress_read4
+(   const u8* p
+)
+{
+    return ( ( u32 ) p[ 0 ] )
+         | ( ( u32 ) p[ 1 ] << 8 )
+         | ( ( u32 ) p[ 2 ] << 16 )
+         | ( ( u32 ) p[ 3 ] << 24 )
+         ;
+}
+
+/**
+ * @brief Reads eight bytes as a little-endian integer. Does not require
+ * alignment; compiles to a single load on little-endian targets.
+ *
+ * @param p Address to read from. Must be non-zero.
+ * @return The integer.
+ */
+INLINE u64
+_compress_read8
+(   const u8* p
+)
+{
+    return ( ( u64 ) _compress_read4 ( p ) )
+         | ( ( u64 ) _compress_read4 ( p + 4 ) << 32 )
+         ;
+}
+
+/**
+ * @brief Writes a 32-bit integer as four little-endian bytes. Does not require
+ * alignment.
+ *
+ * @param p Address to write to. Must be non-zero.
+ * @param x The integer.
+ */
+INLINE void
+_compress_write4
+(   u8*         p
+,   const u32   x
+)
+{
+    p[ 0 ] = ( u8 ) x;
+    p[ 1 ] = ( u8 )( x >> 8 );
+    p[ 2 ] = ( u8 )( x >> 16 );
+    p[ 3 ] = ( u8 )( x >> 24 );
+}
+
+/**
+ * @brief Writes a 64-bit integer as eight little-endian bytes. Does not
+ * require alignment; compiles to a single store on little-endian targets.
+ *
+ * @param p Address to write to. Must be non-zero.
+ * @param x The integer.
+ */
+INLINE void
+_compress_write8
+(   u8*         p
+,   const u64   x
+)
+{
+    _compress_write4 ( p , ( u32 ) x );
+    _compress_write4 ( p + 4 , ( u32 )( x >> 32 ) );
+}
+
+/**
+ * @brief Hashes four bytes into a match finder slot (Fibonacci hashing).
+ *
+ * @param x Four bytes (see _compress_read4).
+ * @return The slot index.
+ */
+INLINE u32
+_compress_hash
+(   const u32 x
+)
+{
+    return ( x * 2654435761U ) >> ( 32 - COMPRESS_HASH_BITS );
+}
+
+/**
+ * @brief Writes a length which does not fit in a token as a run of 255s and a
+ * final byte.
+ *
+ * @param dst Output buffer. Must be non-zero.
+ * @param length The length, minus the 15 stored in the token.
+ * @return The new end of dst.
+ */
+INLINE u8*
+_compress_write_length
+(   u8* dst
+,   u64 length
+)
+{
+    for ( ; length >= 255; length -= 255 )
+    {
+        *dst++ = 255;
+    }
+    *dst++ = ( u8 ) length;
+    return dst;
+}
+
+/**
+ * @brief Reads a length which does not fit in a token (see
+ * _compress_write_length).
+ *
+ * @param src Read head. Must be non-zero.
+ * @param end End of the input. Must be non-zero.
+ * @param length Output buffer for the length, to which the remainder is added.
+ * Must be non-zero.
+ * @return false if the input ends before the length does; true otherwise.
+ */
+INLINE bool
+_compress_read_length
+(   const u8**  src
+,   const u8*   end
+,   u64*        length
+)
+{
+    u8 byte;
+    do
+    {
+        if ( *src >= end )
+        {
+            return false;
+        }
+        byte = *( *src )++;
+        *length += byte;
+    }
+    while ( byte == 255 );
+    return true;
+}
+
+/**
+ * @brief Writes a sequence: a run of literals, and a back-reference (if any).
+ *
+ * @param dst Output buffer. Must be non-zero.
+ * @param literals The literals. Must be non-zero if literal_count is non-zero.
+ * @param literal_count The number of literals.
+ * @param offset The distance back to the match (ignored if match_length is 0).
+ * @param match_length The length of the match, or 0 to end the block.
+ * @return The new end of dst.
+ */
+INLINE u8*
+_compress_write_sequence
+(   u8*         dst
+,   const u8*   literals
+,   const u64   literal_count
+,   const u64   offset
+,   const u64   match_length
+)
+{
+    u8* token = dst++;
+    *token = ( u8 )( MIN ( literal_count , ( u64 ) 15 ) << 4 );
+    if ( literal_count >= 15 )
+    {
+        dst = _compress_write_length ( dst , literal_count - 15 );
+    }
+    memory_copy ( dst , literals , literal_count );
+    dst += literal_count;
+
+    if ( !match_length )
+    {
+        return dst;
+    }
+
+    *dst++ = ( u8 ) offset;
+    *dst++ = ( u8 )( offset >> 8 );
+    const u64 length = match_length - COMPRESS_MIN_MATCH;
+    *token |= ( u8 ) MIN ( length , ( u64 ) 15 );
+    if ( length >= 15 )
+    {
+        dst = _compress_write_length ( dst , length - 15 );
+    }
+    return dst;
+}
+
+u64
+compress_block
+(   const void* src_
+,   const u64   size
+,   void*       dst_
+)
+{
+    const u8* src = src_;
+    u8* dst = dst_;
+    u64 anchor = 0;
+
+    if ( size > COMPRESS_MATCH_LIMIT )
+    {
+        // Position of the last occurrence of each hashed four-byte sequence.
+        // Stale entries are harmless: every candidate is verified.
+        u32 table[ 1 << COMPRESS_HASH_BITS ];
+        memory_clear ( table , sizeof ( table ) );
+
+        const u64 match_end = size - COMPRESS_LAST_LITERALS;
+        u64 i = 0;
+        while ( i + COMPRESS_MATCH_LIMIT <= size )
+        {
+            const u32 sequence = _compress_read4 ( src + i );
+            const u32 slot = _compress_hash ( sequence );
+            u64 candidate = table[ slot ];
+            table[ slot ] = ( u32 ) i;
+            if ( candidate >= i
+              || i - candidate > COMPRESS_MAX_OFFSET
+              || _compress_read4 ( src + candidate ) != sequence
+               )
+            {
+                // Skip ahead faster the longer nothing has matched, so that
+                // incompressible input passes through quickly.
+                i += 1 + ( ( i - anchor ) >> 6 );
+                continue;
+            }
+
+            // Extend the match backwards over pending literals.
+            while ( i > anchor && candidate && src[ i - 1 ] == src[ candidate - 1 ] )
+            {
+                i -= 1;
+                candidate -= 1;
+            }
+
+            // Extend the match forwards, a word at a time.
+            u64 length = COMPRESS_MIN_MATCH;
+            u64 difference = 0;
+            while ( !difference && i + length + 8 <= match_end )
+            {
+                difference = _compress_read8 ( src + i + length )
+                           ^ _compress_read8 ( src + candidate + length )
+                           ;
+                length += ( difference ) ? bitscan_forward ( difference ) >> 3
+                                         : 8
+                                         ;
+            }
+            while ( !difference && i + length < match_end && src[ i + length ] == src[ candidate + length ] )
+            {
+                length += 1;
+            }
+
+            dst = _compress_write_sequence ( dst
+                                           , src + anchor
+                                           , i - anchor
+                                           , i - candidate
+                                           , length
+                                           );
+            i += length;
+            anchor = i;
+
+            // Index a position inside the match too, so a repeat of its end is
+            // found.
+            if ( i + COMPRESS_MATCH_LIMIT <= size )
+            {
+                table[ _compress_hash ( _compress_read4 ( src + i - 2 ) ) ] = ( u32 )( i - 2 );
+            }
+        }
+    }
+
+    dst = _compress_write_sequence ( dst , src + anchor , size - anchor , 0 , 0 );
+    return ( u64 )( dst - ( u8* ) dst_ );
+}
+
+bool
+decompress_block
+(   const void* src_
+,   const u64   src_size
+,   void*       dst_
+,   const u64   dst_size
+)
+{
+    const u8* src = src_;
+    const u8* src_end = src + src_size;
+    u8* dst = dst_;
+    u8* dst_end = dst + dst_size;
+
+    for (;;)
+    {
+        if ( src >= src_end )
+        {
+            return false;
+        }
+        const u8 token = *src++;
+
+        u64 literal_count = token >> 4;
+        if ( literal_count == 15 && !_compress_read_length ( &src , src_end , &literal_count ) )
+        {
+            return false;
+        }
+        if ( literal_count > ( u64 )( src_end - src ) || literal_count > ( u64 )( dst_end - dst ) )
+        {
+            return false;
+        }
+        memory_copy ( dst , src , literal_count );
+        src += literal_count;
+        dst += literal_count;
+
+        // The last sequence has no back-reference.
+        if ( src == src_end )
+        {
+            return dst == dst_end;
+        }
+
+        if ( src_end - src < 2 )
+        {
+            return false;
+        }
+        const u64 offset = src[ 0 ] | ( ( u64 ) src[ 1 ] << 8 );
+        src += 2;
+        u64 length = token & 15;
+        if ( length == 15 && !_compress_read_length ( &src , src_end , &length ) )
+        {
+            return false;
+        }
+        length += COMPRESS_MIN_MATCH;
+        if ( !offset || offset > ( u64 )( dst - ( u8* ) dst_ ) || length > ( u64 )( dst_end - dst ) )
+        {
+            return false;
+        }
+
+        // Copy a word at a time where the match does not overlap its own
+        // output within a word, and there is room to overshoot.
+        const u8* match = dst - offset;
+        if ( offset >= 8 && length + 8 <= ( u64 )( dst_end - dst ) )
+        {
+            for ( u64 i = 0; i < length; i += 8 )
+            {
+                _compress_write8 ( dst + i , _compress_read8 ( match + i ) );
+            }
+        }
+        else
+        {
+            for ( u64 i = 0; i < length; ++i )
+            {
+                dst[ i ] = match[ i ];
+            }
+        }
+        dst += length;
+    }
+}
+
+u64
+compress_frame
+(   const void* src
+,   const u64   size
+,   void*       dst_
+)
+{
+    u8* dst = dst_;
+    u8* payload = dst + COMPRESS_FRAME_HEADER_SIZE;
+    const u32 checksum = checksum_crc32c ( src , size , 0 );
+
+    const u64 payload_size = compress_block ( src , size , payload );
+    if ( payload_size >= size )
+    {
+        memory_copy ( payload , src , size );
+        compress_frame_stored ( size , checksum , dst );
+        return COMPRESS_FRAME_HEADER_SIZE + size;
+    }
+
+    _compress_write4 ( dst , COMPRESS_FRAME_MAGIC );
+    _compress_write4 ( dst + 4 , ( u32 ) payload_size );
+    _compress_write4 ( dst + 8 , ( u32 ) size );
+    _compress_write4 ( dst + 12 , checksum );
+    return COMPRESS_FRAME_HEADER_SIZE + payload_size;
+}
+
+void
+compress_frame_stored
+(   const u64   size
+,   const u32   checksum
+,   void*       dst_
+)
+{
+    u8* dst = dst_;
+    _compress_write4 ( dst , COMPRESS_FRAME_MAGIC );
+    _compress_write4 ( dst + 4 , ( u32 ) size | COMPRESS_FRAME_STORED );
+    _compress_write4 ( dst + 8 , ( u32 ) size );
+    _compress_write4 ( dst + 12 , checksum );
+}
+
+bool
+compress_frame_parse
+(   const void* header_
+,   u64*        payload_size
+,   u64*        size
+)
+{
+    const u8* header = header_;
+    if ( _compress_read4 ( header ) != COMPRESS_FRAME_MAGIC )
+    {
+        return false;
+    }
+
+    const u32 payload = _compress_read4 ( header + 4 );
+    const u64 content = _compress_read4 ( header + 8 );
+    if ( content > COMPRESS_MAX_SIZE )
+    {
+        return false;
+    }
+    if ( payload & COMPRESS_FRAME_STORED )
+    {
+        if ( ( payload & ~COMPRESS_FRAME_STORED ) != content )
+        {
+            return false;
+        }
+        *payload_size = content;
+    }
+    else
+    {
+        if ( payload > COMPRESS_BOUND ( content ) )
+        {
+            return false;
+        }
+        *payload_size = payload;
+    }
+    *size = content;
+    return true;
+}
+
+bool
+decompress_frame
+(   const void* header_
+,   const void* payload
+,   void*       dst
+)
+{
+    const u8* header = header_;
+    const u32 payload_size = _compress_read4 ( header + 4 );
+    const u64 size = _compress_read4 ( header + 8 );
+    if ( payload_size & COMPRESS_FRAME_STORED )
+    {
+        memory_copy ( dst , payload , size );
+    }
+    else if ( !decompress_block ( payload , payload_size , dst , size ) )
+    {
+        return false;
+    }
+    return checksum_crc32c ( dst , size , 0 ) == _compress_read4 ( header + 12 );
+}
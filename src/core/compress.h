@@ -0,0 +1,158 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/compress.h
+ * @brief Provides an interface for fast lossless compression of buffers and
+ * streams.
+ *
+ * Blocks are compressed with a greedy LZ77 compressor in the LZ4 block format:
+ * a sequence of literal runs and back-references of at least four bytes into
+ * the previous 64 KiB. The compressor looks for matches through a small hash
+ * table of recent positions, and the decompressor is a copy loop with no
+ * entropy decoding, so both run at several hundred MiB/s per core; text such as
+ * log output typically shrinks to a quarter to a third of its size.
+ *
+ * Streams (e.g. a compressed file; see file_writer_create_compressed and
+ * file_reader_create_compressed in platform/filesystem.h) are sequences of
+ * frames. Each frame is a self-contained block behind a small header which
+ * records its sizes and a CRC32C of its content (see core/checksum.h), so a
+ * stream may be decoded up to its last complete frame, e.g. after a crash cut
+ * it short, and a damaged frame is detected rather than decoded into garbage.
+ *
+ *   u8* frame = memory_allocate ( COMPRESS_FRAME_BOUND ( size ) , ... );
+ *   file_write ( file , compress_frame ( src , size , frame ) , frame , ... );
+ */
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include "common.h"
+
+/**
+ * @brief Maximum number of bytes which may be compressed into a single block
+ * or frame.
+ */
+#define COMPRESS_MAX_SIZE MiB ( 64 )
+
+/** @brief Upper bound on the compressed size of a block of size bytes. */
+#define COMPRESS_BOUND(size) \
+    ( (size) + (size) / 255 + 16 )
+
+/** @brief Frame header size (in bytes). */
+#define COMPRESS_FRAME_HEADER_SIZE 16
+
+/** @brief Upper bound on the size of a frame holding size bytes. */
+#define COMPRESS_FRAME_BOUND(size) \
+    ( COMPRESS_FRAME_HEADER_SIZE + COMPRESS_BOUND ( size ) )
+
+/**
+ * @brief Compresses a block. O(n).
+ *
+ * Uses 16 KiB of stack for the match finder.
+ *
+ * @param src The data to compress. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to compress. Must not exceed
+ * COMPRESS_MAX_SIZE.
+ * @param dst Output buffer for the compressed block. Must be non-zero, and
+ * hold at least COMPRESS_BOUND ( size ) bytes.
+ * @return The size of the compressed block (in bytes).
+ */
+u64
+compress_block
+(   const void* src
+,   const u64   size
+,   void*       dst
+);
+
+/**
+ * @brief Decompresses a block (see compress_block). O(n).
+ *
+ * Every read and write is bounds-checked, so malformed input is rejected
+ * rather than overrunning either buffer.
+ *
+ * @param src The compressed block. Must be non-zero if src_size is non-zero.
+ * @param src_size The size of the compressed block (in bytes).
+ * @param dst Output buffer for the data. Must be non-zero if dst_size is
+ * non-zero.
+ * @param dst_size The exact size of the data (in bytes).
+ * @return true if the block decompressed to exactly dst_size bytes; false if
+ * it is malformed.
+ */
+bool
+decompress_block
+(   const void* src
+,   const u64   src_size
+,   void*       dst
+,   const u64   dst_size
+);
+
+/**
+ * @brief Compresses a block into a frame. If the data does not compress, it is
+ * stored as-is instead. O(n).
+ *
+ * @param src The data to compress. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to compress. Must not exceed
+ * COMPRESS_MAX_SIZE.
+ * @param dst Output buffer for the frame. Must be non-zero, and hold at least
+ * COMPRESS_FRAME_BOUND ( size ) bytes.
+ * @return The size of the frame (in bytes).
+ */
+u64
+compress_frame
+(   const void* src
+,   const u64   size
+,   void*       dst
+);
+
+/**
+ * @brief Writes the header of a frame which stores its content as-is, so that
+ * the content may be written directly after it without being copied. Does not
+ * allocate memory or take a lock, so it may be used while reporting a failure.
+ *
+ * @param size The size of the content (in bytes). Must not exceed
+ * COMPRESS_MAX_SIZE.
+ * @param checksum The CRC32C of the content (see checksum_crc32c).
+ * @param dst Output buffer for the header. Must be non-zero, and hold at least
+ * COMPRESS_FRAME_HEADER_SIZE bytes.
+ */
+void
+compress_frame_stored
+(   const u64   size
+,   const u32   checksum
+,   void*       dst
+);
+
+/**
+ * @brief Parses a frame header.
+ *
+ * @param header The header. Must be non-zero, and hold at least
+ * COMPRESS_FRAME_HEADER_SIZE bytes.
+ * @param payload_size Output buffer for the number of bytes which follow the
+ * header. Must be non-zero.
+ * @param size Output buffer for the size of the frame's content (in bytes).
+ * Must be non-zero.
+ * @return true if header is a well-formed frame header; false otherwise.
+ */
+bool
+compress_frame_parse
+(   const void* header
+,   u64*        payload_size
+,   u64*        size
+);
+
+/**
+ * @brief Decompresses the content of a frame, and verifies its checksum. O(n).
+ *
+ * @param header The frame header. Must be non-zero, and well-formed (see
+ * compress_frame_parse).
+ * @param payload The bytes which follow the header. Must be non-zero.
+ * @param dst Output buffer for the content. Must be non-zero, and hold at
+ * least the content size reported by compress_frame_parse.
+ * @return true on success; false if the frame is malformed or damaged.
+ */
+bool
+decompress_frame
+(   const void* header
+,   const void* payload
+,   void*       dst
+);
+
+#endif  // COMPRESS_H
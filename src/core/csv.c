@@ -0,0 +1,939 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/csv.c
+ * @brief Implementation of the core/csv header.
+ * (see core/csv.h for additional details)
+ */
+#include "core/csv.h"
+
+#if PLATFORM_SIMD_AVX2
+    #include <immintrin.h>
+#elif PLATFORM_SIMD_SSE2
+    #include <emmintrin.h>
+#elif PLATFORM_SIMD_NEON && defined ( __aarch64__ )
+    #include <arm_neon.h>
+#endif
+
+#include "common/bitops.h"
+
+#include "core/job.h"
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/clamp.h"
+
+/** @brief Number of bytes classified at once (one bit per byte of a u64). */
+#define CSV_BLOCK_SIZE 64
+
+/** @brief Initial capacity of a parser's field array. */
+#define CSV_FIELD_CAPACITY 16
+
+/** @brief Type and instance definitions for the outcome of a record scan. */
+typedef enum
+{
+    CSV_SCAN_RECORD     // A whole record was found.
+,   CSV_SCAN_PARTIAL    // The input ends before the record does.
+,   CSV_SCAN_END        // No input remains.
+,   CSV_SCAN_MALFORMED  // The input ends within a quoted field.
+}
+CSV_SCAN;
+
+/** @brief Type definition for the bitmasks of a classified block. */
+typedef struct
+{
+    u64 quotes;
+    u64 delimiters;
+    u64 newlines;
+}
+csv_block_t;
+
+/** @brief Type definition for a chunk of a parallel parse. */
+typedef struct
+{
+    const char*             data;
+    u64                     begin;
+    u64                     end;
+    char                    delimiter;
+    char                    quote;
+    u64                     index;
+    csv_record_function_t   function;
+    void*                   args;
+
+    // Does the chunk contain an odd number of quotes? Y/N
+    bool                    odd;
+
+    bool                    success;
+}
+csv_chunk_t;
+
+/**
+ * @brief Validates the delimiter and quote characters passed to a parser.
+ *
+ * @param caller The name of the calling function, for error messages.
+ * @param delimiter The field delimiter.
+ * @param quote The quote character, or 0.
+ * @return true if valid; false otherwise (which is logged).
+ */
+bool
+_csv_validate
+(   const char* caller
+,   const char  delimiter
+,   const char  quote
+);
+
+/**
+ * @brief Initializes the state shared by every parser.
+ *
+ * @param delimiter The field delimiter.
+ * @param quote The quote character, or 0.
+ * @param csv The parser to initialize. Must be non-zero.
+ */
+void
+_csv_init
+(   const char  delimiter
+,   const char  quote
+,   csv_t*      csv
+);
+
+/**
+ * @brief Classifies a block of CSV_BLOCK_SIZE bytes into bitmasks: bit i of
+ * each mask is set if byte i is a quote, delimiter or newline, respectively.
+ *
+ * @param block The block. Must be non-zero.
+ * @param delimiter The field delimiter.
+ * @param quote The quote character, or 0 (in which case no quotes are found).
+ * @param masks Output buffer for the masks. Must be non-zero.
+ */
+void
+_csv_classify
+(   const char*     block
+,   const char      delimiter
+,   const char      quote
+,   csv_block_t*    masks
+);
+
+/**
+ * @brief Loads the block at an offset into the input, copying it into a
+ * zero-padded buffer if fewer than CSV_BLOCK_SIZE bytes remain.
+ *
+ * @param data The input. Must be non-zero.
+ * @param remaining The number of bytes from the block to the end of input.
+ * @param padding A buffer of CSV_BLOCK_SIZE bytes. Must be non-zero.
+ * @return The address of the block.
+ */
+const char*
+_csv_load
+(   const char* data
+,   const u64   remaining
+,   char*       padding
+);
+
+/**
+ * @brief Computes the prefix XOR of a mask: bit i of the result is the XOR of
+ * bits 0 through i. Applied to a quote mask, yields the mask of quoted bytes
+ * (including opening quotes, excluding closing quotes).
+ *
+ * @param x The mask.
+ * @return The prefix XOR.
+ */
+u64
+_csv_prefix_xor
+(   u64 x
+);
+
+/**
+ * @brief Scans the record at the start of the input, and appends its fields
+ * to the parser's field array.
+ *
+ * @param csv The parser. Must be non-zero.
+ * @param data The input. Must be non-zero if size is non-zero.
+ * @param size The input size (in bytes).
+ * @param eof Does the input end at the end of the file? Y/N (if not, an
+ * incomplete record is reported as such rather than ended)
+ * @param record_size Output buffer for the size of the record, including its
+ * newline. Must be non-zero.
+ * @param field_count Output buffer for the number of fields. Must be non-zero.
+ * @return The outcome of the scan.
+ */
+CSV_SCAN
+_csv_scan
+(   csv_t*      csv
+,   const char* data
+,   const u64   size
+,   const bool  eof
+,   u64*        record_size
+,   u64*        field_count
+);
+
+/**
+ * @brief Appends a field to the parser's field array, growing it if needed,
+ * and stripping a trailing `\r` and surrounding quotes.
+ *
+ * @param csv The parser. Must be non-zero.
+ * @param string The raw field. Must be non-zero.
+ * @param length The raw field length (in bytes).
+ * @param last Does the field end the record? Y/N
+ * @param count The number of fields already in the array.
+ */
+void
+_csv_push
+(   csv_t*      csv
+,   const char* string
+,   u64         length
+,   const bool  last
+,   const u64   count
+);
+
+/**
+ * @brief Finds the first record which starts after an offset into a buffer.
+ *
+ * @param data The input. Must be non-zero.
+ * @param size The input size (in bytes).
+ * @param offset The offset to start searching from.
+ * @param quote The quote character, or 0.
+ * @param inside Is the offset within a quoted field? Y/N
+ * @return The offset of the byte after the first unquoted newline at or after
+ * offset, or size if there is none.
+ */
+u64
+_csv_record_start
+(   const char* data
+,   const u64   size
+,   const u64   offset
+,   const char  quote
+,   const bool  inside
+);
+
+/**
+ * @brief Runs a job on every chunk of a parallel parse, and waits for them.
+ *
+ * @param chunks The chunks. Must be non-zero.
+ * @param jobs Scratch space for chunk_count jobs. Must be non-zero.
+ * @param chunk_count The number of chunks.
+ * @param function The job to run.
+ * @param parallel Run on the job system? Y/N (if not, the chunks are run one
+ * after another on the calling thread)
+ */
+void
+_csv_run
+(   csv_chunk_t*    chunks
+,   job_t*          jobs
+,   const u64       chunk_count
+,   job_function_t  function
+,   const bool      parallel
+);
+
+/**
+ * @brief Job: counts the quotes in a chunk of a parallel parse.
+ *
+ * @param args The chunk (see csv_chunk_t). Must be non-zero.
+ */
+void
+_csv_count_job
+(   void* args
+);
+
+/**
+ * @brief Job: parses each record in a chunk of a parallel parse, and passes
+ * it to the chunk's function.
+ *
+ * @param args The chunk (see csv_chunk_t). Must be non-zero.
+ */
+void
+_csv_parse_job
+(   void* args
+);
+
+bool
+csv_create
+(   const char* data
+,   u64         size
+,   char        delimiter
+,   char        quote
+,   csv_t*      csv
+)
+{
+    if ( ( !data && size ) || !csv )
+    {
+        if ( !data && size )
+        {
+            LOGERROR ( "csv_create: Missing argument: data (input)." );
+        }
+        if ( !csv )
+        {
+            LOGERROR ( "csv_create: Missing argument: csv (output buffer)." );
+        }
+        return false;
+    }
+    if ( !_csv_validate ( "csv_create" , delimiter , quote ) )
+    {
+        return false;
+    }
+
+    _csv_init ( delimiter , quote , csv );
+    ( *csv ).data = data;
+    ( *csv ).size = size;
+    return true;
+}
+
+bool
+csv_create_reader
+(   file_reader_t*  reader
+,   char            delimiter
+,   char            quote
+,   csv_t*          csv
+)
+{
+    if ( !reader || !csv )
+    {
+        if ( !reader )
+        {
+            LOGERROR ( "csv_create_reader: Missing argument: reader (input)." );
+        }
+        if ( !csv )
+        {
+            LOGERROR ( "csv_create_reader: Missing argument: csv (output buffer)." );
+        }
+        return false;
+    }
+    if ( !_csv_validate ( "csv_create_reader" , delimiter , quote ) )
+    {
+        return false;
+    }
+
+    _csv_init ( delimiter , quote , csv );
+    ( *csv ).reader = reader;
+    return true;
+}
+
+void
+csv_destroy
+(   csv_t* csv
+)
+{
+    if ( !csv || !( *csv ).fields )
+    {
+        return;
+    }
+
+    if ( ( *csv ).reader )
+    {
+        file_reader_consume ( ( *csv ).reader , ( *csv ).consumed );
+    }
+
+    memory_free ( ( *csv ).fields
+                , ( *csv ).field_capacity * sizeof ( csv_field_t )
+                , MEMORY_TAG_ARRAY
+                );
+    memory_clear ( csv , sizeof ( csv_t ) );
+}
+
+bool
+csv_next_record
+(   csv_t*              csv
+,   const csv_field_t** fields
+,   u64*                field_count
+)
+{
+    if ( !csv || !fields || !field_count )
+    {
+        if ( !csv )
+        {
+            LOGERROR ( "csv_next_record: Missing argument: csv (parser to advance)." );
+        }
+        if ( !fields )
+        {
+            LOGERROR ( "csv_next_record: Missing argument: fields (output buffer)." );
+        }
+        else
+        {
+            *fields = 0;
+        }
+        if ( !field_count )
+        {
+            LOGERROR ( "csv_next_record: Missing argument: field_count (output buffer)." );
+        }
+        else
+        {
+            *field_count = 0;
+        }
+        return false;
+    }
+
+    *fields = 0;
+    *field_count = 0;
+
+    u64 record_size;
+    u64 count;
+    CSV_SCAN scan;
+
+    // Buffer? Y/N
+    if ( !( *csv ).reader )
+    {
+        scan = _csv_scan ( csv
+                         , ( *csv ).data + ( *csv ).position
+                         , ( *csv ).size - ( *csv ).position
+                         , true
+                         , &record_size
+                         , &count
+                         );
+        if ( scan == CSV_SCAN_RECORD )
+        {
+            ( *csv ).position += record_size;
+        }
+    }
+    else
+    {
+        file_reader_t* reader = ( *csv ).reader;
+
+        // The previous record remained valid until now.
+        file_reader_consume ( reader , ( *csv ).consumed );
+        ( *csv ).consumed = 0;
+
+        for (;;)
+        {
+            scan = _csv_scan ( csv
+                             , ( const char* )( ( *reader ).buffer + ( *reader ).start )
+                             , ( *reader ).end - ( *reader ).start
+                             , ( *csv ).eof
+                             , &record_size
+                             , &count
+                             );
+            if ( scan != CSV_SCAN_PARTIAL )
+            {
+                break;
+            }
+
+            // Scan the record again once more of it has been read. A record
+            // is rescanned at most once per fill, or per doubling of the
+            // buffer if it is larger than the buffer.
+            u64 read;
+            if ( !file_reader_fill ( reader , &read ) )
+            {
+                return false;
+            }
+            ( *csv ).eof = !read;
+        }
+        if ( scan == CSV_SCAN_RECORD )
+        {
+            ( *csv ).consumed = record_size;
+        }
+    }
+
+    if ( scan != CSV_SCAN_RECORD )
+    {
+        if ( scan == CSV_SCAN_MALFORMED )
+        {
+            LOGERROR ( "csv_next_record: Input ends within a quoted field (record %u)."
+                     , ( *csv ).record + 1
+                     );
+        }
+        return false;
+    }
+
+    ( *csv ).record += 1;
+    *fields = ( *csv ).fields;
+    *field_count = count;
+    return true;
+}
+
+u64
+csv_field_unescape
+(   const csv_field_t*  field
+,   char                quote
+,   char*               dst
+)
+{
+    const char* src = ( *field ).value.string;
+    const u64 length = ( *field ).value.length;
+    if ( !( *field ).escaped )
+    {
+        memory_copy ( dst , src , length );
+        return length;
+    }
+
+    u64 written = 0;
+    for ( u64 i = 0; i < length; ++i )
+    {
+        dst[ written++ ] = src[ i ];
+        if ( src[ i ] == quote && i + 1 < length && src[ i + 1 ] == quote )
+        {
+            i += 1;
+        }
+    }
+    return written;
+}
+
+bool
+csv_parse_parallel
+(   const char*             data
+,   u64                     size
+,   char                    delimiter
+,   char                    quote
+,   u64                     chunk_count
+,   csv_record_function_t   function
+,   void*                   args
+)
+{
+    if ( ( !data && size ) || !function )
+    {
+        if ( !data && size )
+        {
+            LOGERROR ( "csv_parse_parallel: Missing argument: data (input)." );
+        }
+        if ( !function )
+        {
+            LOGERROR ( "csv_parse_parallel: Missing argument: function." );
+        }
+        return false;
+    }
+    if ( !_csv_validate ( "csv_parse_parallel" , delimiter , quote ) )
+    {
+        return false;
+    }
+    if ( !size )
+    {
+        return true;
+    }
+
+    const u64 worker_count = job_system_worker_count ();
+    if ( !chunk_count )
+    {
+        chunk_count = worker_count + 1;
+    }
+    chunk_count = MAX ( MIN ( chunk_count , size / CSV_PARALLEL_MIN_CHUNK_SIZE )
+                      , ( u64 ) 1
+                      );
+
+    csv_chunk_t* chunks = memory_allocate ( chunk_count * sizeof ( csv_chunk_t ) , MEMORY_TAG_ARRAY );
+    job_t* jobs = memory_allocate ( chunk_count * sizeof ( job_t ) , MEMORY_TAG_ARRAY );
+    for ( u64 i = 0; i < chunk_count; ++i )
+    {
+        chunks[ i ].data = data;
+        chunks[ i ].begin = size * i / chunk_count;
+        chunks[ i ].end = size * ( i + 1 ) / chunk_count;
+        chunks[ i ].delimiter = delimiter;
+        chunks[ i ].quote = quote;
+        chunks[ i ].index = i;
+        chunks[ i ].function = function;
+        chunks[ i ].args = args;
+        chunks[ i ].odd = false;
+        chunks[ i ].success = true;
+    }
+
+    // Count the quotes in each chunk, to learn whether each one starts within
+    // a quoted field.
+    if ( quote && chunk_count > 1 )
+    {
+        _csv_run ( chunks , jobs , chunk_count , _csv_count_job , worker_count > 0 );
+    }
+
+    // Move each chunk boundary forward to the start of a record.
+    bool inside = false;
+    for ( u64 i = 1; i < chunk_count; ++i )
+    {
+        inside ^= chunks[ i - 1 ].odd;
+        const u64 begin = _csv_record_start ( data , size , chunks[ i ].begin , quote , inside );
+        chunks[ i ].begin = MAX ( begin , chunks[ i - 1 ].begin );
+        chunks[ i - 1 ].end = chunks[ i ].begin;
+    }
+    chunks[ chunk_count - 1 ].end = size;
+
+    _csv_run ( chunks , jobs , chunk_count , _csv_parse_job , worker_count > 0 );
+
+    bool success = true;
+    for ( u64 i = 0; i < chunk_count; ++i )
+    {
+        success = success && chunks[ i ].success;
+    }
+
+    memory_free ( jobs , chunk_count * sizeof ( job_t ) , MEMORY_TAG_ARRAY );
+    memory_free ( chunks , chunk_count * sizeof ( csv_chunk_t ) , MEMORY_TAG_ARRAY );
+    return success;
+}
+
+bool
+_csv_validate
+(   const char* caller
+,   const char  delimiter
+,   const char  quote
+)
+{
+    if ( !delimiter || delimiter == '\n' || delimiter == quote )
+    {
+        LOGERROR ( "%s: Value of delimiter argument must be non-zero, and neither a newline nor the quote character."
+                 , caller
+                 );
+        return false;
+    }
+    if ( quote == '\n' )
+    {
+        LOGERROR ( "%s: Value of quote argument must not be a newline."
+                 , caller
+                 );
+        return false;
+    }
+    return true;
+}
+
+void
+_csv_init
+(   const char  delimiter
+,   const char  quote
+,   csv_t*      csv
+)
+{
+    memory_clear ( csv , sizeof ( csv_t ) );
+    ( *csv ).delimiter = delimiter;
+    ( *csv ).quote = quote;
+    ( *csv ).field_capacity = CSV_FIELD_CAPACITY;
+    ( *csv ).fields = memory_allocate ( CSV_FIELD_CAPACITY * sizeof ( csv_field_t )
+                                      , MEMORY_TAG_ARRAY
+                                      );
+}
+
+void
+_csv_classify
+(   const char*     block
+,   const char      delimiter
+,   const char      quote
+,   csv_block_t*    masks
+)
+{
+#if PLATFORM_SIMD_AVX2
+    const __m256i quotes = _mm256_set1_epi8 ( quote );
+    const __m256i delimiters = _mm256_set1_epi8 ( delimiter );
+    const __m256i newlines = _mm256_set1_epi8 ( '\n' );
+    const __m256i lo = _mm256_loadu_si256 ( ( const __m256i* ) block );
+    const __m256i hi = _mm256_loadu_si256 ( ( const __m256i* )( block + 32 ) );
+    ( *masks ).quotes = ( u64 )( u32 ) _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( lo , quotes ) )
+                      | ( u64 )( u32 ) _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( hi , quotes ) ) << 32
+                      ;
+    ( *masks ).delimiters = ( u64 )( u32 ) _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( lo , delimiters ) )
+                          | ( u64 )( u32 ) _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( hi , delimiters ) ) << 32
+                          ;
+    ( *masks ).newlines = ( u64 )( u32 ) _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( lo , newlines ) )
+                        | ( u64 )( u32 ) _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( hi , newlines ) ) << 32
+                        ;
+#elif PLATFORM_SIMD_SSE2
+    const __m128i quotes = _mm_set1_epi8 ( quote );
+    const __m128i delimiters = _mm_set1_epi8 ( delimiter );
+    const __m128i newlines = _mm_set1_epi8 ( '\n' );
+    ( *masks ).quotes = 0;
+    ( *masks ).delimiters = 0;
+    ( *masks ).newlines = 0;
+    for ( u32 i = 0; i < CSV_BLOCK_SIZE / 16; ++i )
+    {
+        const __m128i v = _mm_loadu_si128 ( ( const __m128i* )( block + 16 * i ) );
+        ( *masks ).quotes |= ( u64 )( u32 ) _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( v , quotes ) ) << ( 16 * i );
+        ( *masks ).delimiters |= ( u64 )( u32 ) _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( v , delimiters ) ) << ( 16 * i );
+        ( *masks ).newlines |= ( u64 )( u32 ) _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( v , newlines ) ) << ( 16 * i );
+    }
+#elif PLATFORM_SIMD_NEON && defined ( __aarch64__ )
+    // NEON has no movemask: weight each lane by its bit, then add adjacent
+    // lanes together until each byte of the result holds eight lanes.
+    static const u8 weights[ 16 ] = { 1 , 2 , 4 , 8 , 16 , 32 , 64 , 128
+                                    , 1 , 2 , 4 , 8 , 16 , 32 , 64 , 128
+                                    };
+    const uint8x16_t weight = vld1q_u8 ( weights );
+    const uint8x16_t v[ 4 ] = { vld1q_u8 ( ( const u8* ) block )
+                              , vld1q_u8 ( ( const u8* ) block + 16 )
+                              , vld1q_u8 ( ( const u8* ) block + 32 )
+                              , vld1q_u8 ( ( const u8* ) block + 48 )
+                              };
+    const u8 characters[ 3 ] = { ( u8 ) quote , ( u8 ) delimiter , '\n' };
+    u64 result[ 3 ];
+    for ( u32 j = 0; j < 3; ++j )
+    {
+        const uint8x16_t c = vdupq_n_u8 ( characters[ j ] );
+        uint8x16_t sum0 = vpaddq_u8 ( vandq_u8 ( vceqq_u8 ( v[ 0 ] , c ) , weight )
+                                    , vandq_u8 ( vceqq_u8 ( v[ 1 ] , c ) , weight )
+                                    );
+        const uint8x16_t sum1 = vpaddq_u8 ( vandq_u8 ( vceqq_u8 ( v[ 2 ] , c ) , weight )
+                                          , vandq_u8 ( vceqq_u8 ( v[ 3 ] , c ) , weight )
+                                          );
+        sum0 = vpaddq_u8 ( sum0 , sum1 );
+        sum0 = vpaddq_u8 ( sum0 , sum0 );
+        result[ j ] = vgetq_lane_u64 ( vreinterpretq_u64_u8 ( sum0 ) , 0 );
+    }
+    ( *masks ).quotes = result[ 0 ];
+    ( *masks ).delimiters = result[ 1 ];
+    ( *masks ).newlines = result[ 2 ];
+#else
+    ( *masks ).quotes = 0;
+    ( *masks ).delimiters = 0;
+    ( *masks ).newlines = 0;
+    for ( u32 i = 0; i < CSV_BLOCK_SIZE; ++i )
+    {
+        ( *masks ).quotes |= ( u64 )( block[ i ] == quote ) << i;
+        ( *masks ).delimiters |= ( u64 )( block[ i ] == delimiter ) << i;
+        ( *masks ).newlines |= ( u64 )( block[ i ] == '\n' ) << i;
+    }
+#endif
+
+    if ( !quote )
+    {
+        ( *masks ).quotes = 0;
+    }
+}
+
+const char*
+_csv_load
+(   const char* data
+,   const u64   remaining
+,   char*       padding
+)
+{
+    if ( remaining >= CSV_BLOCK_SIZE )
+    {
+        return data;
+    }
+
+    // Zero never matches: neither the delimiter nor a newline may be zero,
+    // and a zero quote character disables quoting.
+    memory_clear ( padding , CSV_BLOCK_SIZE );
+    memory_copy ( padding , data , remaining );
+    return padding;
+}
+
+u64
+_csv_prefix_xor
+(   u64 x
+)
+{
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+CSV_SCAN
+_csv_scan
+(   csv_t*      csv
+,   const char* data
+,   const u64   size
+,   const bool  eof
+,   u64*        record_size
+,   u64*        field_count
+)
+{
+    char padding[ CSV_BLOCK_SIZE ];
+    u64 count = 0;
+    u64 field = 0;
+
+    // All ones while within a quoted field at the end of the previous block.
+    u64 inside = 0;
+
+    for ( u64 offset = 0; offset < size; offset += CSV_BLOCK_SIZE )
+    {
+        csv_block_t masks;
+        _csv_classify ( _csv_load ( data + offset , size - offset , padding )
+                      , ( *csv ).delimiter
+                      , ( *csv ).quote
+                      , &masks
+                      );
+        const u64 quoted = _csv_prefix_xor ( masks.quotes ) ^ inside;
+        inside = ( u64 )( ( i64 ) quoted >> 63 );
+
+        u64 structurals = ( masks.delimiters | masks.newlines ) & ~quoted;
+        while ( structurals )
+        {
+            const u64 bit = bitscan_forward ( structurals );
+            structurals &= structurals - 1;
+
+            const u64 end = offset + bit;
+            const bool newline = ( masks.newlines >> bit ) & 1;
+            _csv_push ( csv , data + field , end - field , newline , count );
+            count += 1;
+            field = end + 1;
+
+            if ( newline )
+            {
+                *record_size = field;
+                *field_count = count;
+                return CSV_SCAN_RECORD;
+            }
+        }
+    }
+
+    if ( !eof )
+    {
+        return CSV_SCAN_PARTIAL;
+    }
+    if ( inside )
+    {
+        return CSV_SCAN_MALFORMED;
+    }
+    if ( !size )
+    {
+        return CSV_SCAN_END;
+    }
+
+    // The last record need not end with a newline.
+    _csv_push ( csv , data + field , size - field , true , count );
+    *record_size = size;
+    *field_count = count + 1;
+    return CSV_SCAN_RECORD;
+}
+
+void
+_csv_push
+(   csv_t*      csv
+,   const char* string
+,   u64         length
+,   const bool  last
+,   const u64   count
+)
+{
+    if ( count == ( *csv ).field_capacity )
+    {
+        const u64 capacity = 2 * ( *csv ).field_capacity;
+        csv_field_t* fields = memory_allocate ( capacity * sizeof ( csv_field_t ) , MEMORY_TAG_ARRAY );
+        memory_copy ( fields , ( *csv ).fields , count * sizeof ( csv_field_t ) );
+        memory_free ( ( *csv ).fields
+                    , ( *csv ).field_capacity * sizeof ( csv_field_t )
+                    , MEMORY_TAG_ARRAY
+                    );
+        ( *csv ).fields = fields;
+        ( *csv ).field_capacity = capacity;
+    }
+
+    if ( last && length && string[ length - 1 ] == '\r' )
+    {
+        length -= 1;
+    }
+
+    bool escaped = false;
+    const char quote = ( *csv ).quote;
+    if ( quote && length >= 2 && string[ 0 ] == quote && string[ length - 1 ] == quote )
+    {
+        string += 1;
+        length -= 2;
+        u64 index;
+        escaped = string_contains ( string , length , &quote , 1 , false , &index );
+    }
+
+    ( *csv ).fields[ count ].value = string_view ( string , length );
+    ( *csv ).fields[ count ].escaped = escaped;
+}
+
+u64
+_csv_record_start
+(   const char* data
+,   const u64   size
+,   const u64   offset
+,   const char  quote
+,   const bool  inside_
+)
+{
+    char padding[ CSV_BLOCK_SIZE ];
+    u64 inside = ( inside_ ) ? ~( ( u64 ) 0 ) : 0;
+    for ( u64 i = offset; i < size; i += CSV_BLOCK_SIZE )
+    {
+        csv_block_t masks;
+
+        // The delimiter is irrelevant here, so classify with a newline.
+        _csv_classify ( _csv_load ( data + i , size - i , padding ) , '\n' , quote , &masks );
+        const u64 quoted = _csv_prefix_xor ( masks.quotes ) ^ inside;
+        inside = ( u64 )( ( i64 ) quoted >> 63 );
+
+        const u64 newlines = masks.newlines & ~quoted;
+        if ( newlines )
+        {
+            return MIN ( i + bitscan_forward ( newlines ) + 1 , size );
+        }
+    }
+    return size;
+}
+
+void
+_csv_run
+(   csv_chunk_t*    chunks
+,   job_t*          jobs
+,   const u64       chunk_count
+,   job_function_t  function
+,   const bool      parallel
+)
+{
+    if ( parallel )
+    {
+        for ( u64 i = 0; i < chunk_count; ++i )
+        {
+            jobs[ i ].function = function;
+            jobs[ i ].args = &chunks[ i ];
+        }
+        job_counter_t counter = { 0 };
+        if ( job_submit ( jobs , chunk_count , &counter ) )
+        {
+            job_wait ( &counter );
+            return;
+        }
+    }
+
+    for ( u64 i = 0; i < chunk_count; ++i )
+    {
+        function ( &chunks[ i ] );
+    }
+}
+
+void
+_csv_count_job
+(   void* args
+)
+{
+    csv_chunk_t* chunk = args;
+    char padding[ CSV_BLOCK_SIZE ];
+    u64 count = 0;
+    for ( u64 i = ( *chunk ).begin; i < ( *chunk ).end; i += CSV_BLOCK_SIZE )
+    {
+        csv_block_t masks;
+        _csv_classify ( _csv_load ( ( *chunk ).data + i , ( *chunk ).end - i , padding )
+                      , '\n'
+                      , ( *chunk ).quote
+                      , &masks
+                      );
+        count += popcount64 ( masks.quotes );
+    }
+    ( *chunk ).odd = count & 1;
+}
+
+void
+_csv_parse_job
+(   void* args
+)
+{
+    csv_chunk_t* chunk = args;
+    csv_t csv;
+    if ( !csv_create ( ( *chunk ).data + ( *chunk ).begin
+                     , ( *chunk ).end - ( *chunk ).begin
+                     , ( *chunk ).delimiter
+                     , ( *chunk ).quote
+                     , &csv
+                     ))
+    {
+        ( *chunk ).success = false;
+        return;
+    }
+
+    const csv_field_t* fields;
+    u64 field_count;
+    while ( csv_next_record ( &csv , &fields , &field_count ) )
+    {
+        if ( !( *chunk ).function ( fields , field_count , ( *chunk ).index , ( *chunk ).args ) )
+        {
+            ( *chunk ).success = false;
+            break;
+        }
+    }
+
+    // Stopped short of the end of the chunk? Y/N (i.e. malformed input)
+    if ( csv.position != csv.size )
+    {
+        ( *chunk ).success = false;
+    }
+
+    csv_destroy ( &csv );
+}
@@ -0,0 +1,240 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/csv.h
+ * @brief Provides an interface for parsing delimited records (CSV, TSV and
+ * the like) without copying.
+ *
+ * A record ends at a `\n` character (a preceding `\r` is dropped), and its
+ * fields are separated by the delimiter. A field which begins and ends with
+ * the quote character is quoted: the quotes are not part of its value, and
+ * it may contain delimiters, newlines and doubled quotes (which stand for a
+ * single quote; see csv_field_unescape).
+ *
+ * The input is scanned 64 bytes at a time: each block is classified into
+ * bitmasks of quotes, delimiters and newlines with vector comparisons, the
+ * quoted regions are found with a prefix XOR over the quote mask, and the
+ * remaining delimiters and newlines are visited with a bit scan. Quotes are
+ * thus recognized wherever they appear, so a stray quote within an unquoted
+ * field opens a quoted region.
+ *
+ * Fields are returned as views into the input (a buffer, e.g. a mapped file;
+ * or a buffered file reader), valid until the next record is requested:
+ *
+ *   csv_t csv;
+ *   csv_create ( data , size , ',' , '"' , &csv );
+ *   const csv_field_t* fields;
+ *   u64 field_count;
+ *   while ( csv_next_record ( &csv , &fields , &field_count ) )
+ *   { ... }
+ *   csv_destroy ( &csv );
+ *
+ * A buffer may also be split into chunks which are parsed in parallel on the
+ * job system (see csv_parse_parallel).
+ */
+#ifndef CSV_H
+#define CSV_H
+
+#include "common.h"
+
+#include "core/string.h"
+
+#include "platform/filesystem.h"
+
+/**
+ * @brief Minimum number of bytes per chunk for csv_parse_parallel; smaller
+ * inputs are split into fewer chunks.
+ */
+#define CSV_PARALLEL_MIN_CHUNK_SIZE KiB ( 64 )
+
+/** @brief Type definition for a field of a delimited record. */
+typedef struct
+{
+    // The value, without quotes.
+    string_view_t   value;
+
+    // Does the value contain doubled quotes? Y/N (see csv_field_unescape)
+    bool            escaped;
+}
+csv_field_t;
+
+/**
+ * @brief Type definition for a delimited record parser. Fields are internal.
+ */
+typedef struct
+{
+    // Input buffer, or 0 if reading from a file reader.
+    const char*     data;
+    u64             size;
+    u64             position;
+
+    // Input file reader, or 0 if reading from a buffer.
+    file_reader_t*  reader;
+    u64             consumed;
+    bool            eof;
+
+    char            delimiter;
+    char            quote;
+    u64             record;
+
+    csv_field_t*    fields;
+    u64             field_capacity;
+}
+csv_t;
+
+/**
+ * @brief Type definition for a function which handles a record parsed by
+ * csv_parse_parallel.
+ *
+ * @param fields The fields. Valid only until the function returns.
+ * @param field_count The number of fields.
+ * @param chunk The index of the chunk the record belongs to, so that results
+ * may be gathered per chunk without synchronization.
+ * @param args Arguments passed to csv_parse_parallel.
+ * @return true to continue; false to stop parsing the chunk, and fail.
+ */
+typedef bool ( *csv_record_function_t )( const csv_field_t* fields
+                                       , u64                field_count
+                                       , u64                chunk
+                                       , void*              args
+                                       );
+
+/**
+ * @brief Creates a parser for the delimited records in a buffer.
+ *
+ * Uses dynamic memory allocation. Call csv_destroy to free.
+ *
+ * @param data The input. Must be non-zero if size is non-zero, and remain
+ * valid until the parser is destroyed.
+ * @param size The input size (in bytes).
+ * @param delimiter The field delimiter (e.g. ',' or '\t'). Must be non-zero,
+ * and neither a newline nor the quote character.
+ * @param quote The quote character (e.g. '"'), or 0 to disable quoting. Must
+ * not be a newline.
+ * @param csv Output buffer for the parser.
+ * @return true on success; false otherwise.
+ */
+bool
+csv_create
+(   const char* data
+,   u64         size
+,   char        delimiter
+,   char        quote
+,   csv_t*      csv
+);
+
+/**
+ * @brief Variant of csv_create which parses the delimited records in a file
+ * as it is read through a buffered file reader (see file_reader_create in
+ * platform/filesystem.h). A record which does not fit in the reader's buffer
+ * grows it.
+ *
+ * Uses dynamic memory allocation. Call csv_destroy to free.
+ *
+ * @param reader The reader. Must be non-zero, and remain valid until the
+ * parser is destroyed; it must not be advanced by anything else meanwhile.
+ * @param delimiter The field delimiter. Must be non-zero, and neither a
+ * newline nor the quote character.
+ * @param quote The quote character, or 0 to disable quoting. Must not be a
+ * newline.
+ * @param csv Output buffer for the parser.
+ * @return true on success; false otherwise.
+ */
+bool
+csv_create_reader
+(   file_reader_t*  reader
+,   char            delimiter
+,   char            quote
+,   csv_t*          csv
+);
+
+/**
+ * @brief Frees the memory used by a delimited record parser. The last record
+ * returned by a parser created with csv_create_reader is consumed from the
+ * reader.
+ *
+ * @param csv The parser to free.
+ */
+void
+csv_destroy
+(   csv_t* csv
+);
+
+/**
+ * @brief Parses the next record. O(n).
+ *
+ * Performs no memory allocation or copying once the parser's field array
+ * (and, if reading from a file, the reader's buffer) holds the widest record.
+ *
+ * @param csv The parser to advance. Must be non-zero.
+ * @param fields Output buffer for the address of the record's fields, which
+ * are valid only until the next call on the parser. Must be non-zero.
+ * @param field_count Output buffer for the number of fields (at least one).
+ * Must be non-zero.
+ * @return true if a record was parsed; false at the end of the input, or if
+ * it ends within a quoted field or on a read error (which is logged).
+ */
+bool
+csv_next_record
+(   csv_t*              csv
+,   const csv_field_t** fields
+,   u64*                field_count
+);
+
+/**
+ * @brief Copies the value of a field, replacing every doubled quote with a
+ * single one.
+ *
+ * @param field The field. Must be non-zero.
+ * @param quote The quote character the field was parsed with.
+ * @param dst Output buffer for the value. Must be non-zero, and hold at least
+ * the length of the field's value.
+ * @return The length of the unescaped value.
+ */
+u64
+csv_field_unescape
+(   const csv_field_t*  field
+,   char                quote
+,   char*               dst
+);
+
+/**
+ * @brief Parses every delimited record in a buffer, in parallel.
+ *
+ * The buffer is divided into chunks of roughly equal size. The quotes in each
+ * chunk are counted in parallel; from the counts, the quoting state at the
+ * start of each chunk is known, so each chunk boundary is moved to the start
+ * of the next record. Then the chunks are parsed in parallel, and function is
+ * called for each record, from whichever thread parses its chunk. Records
+ * within a chunk are handled in order.
+ *
+ * Runs on the job system if it is running (see core/job.h); otherwise, the
+ * chunks are parsed one after another on the calling thread.
+ *
+ * Uses dynamic memory allocation.
+ *
+ * @param data The input. Must be non-zero if size is non-zero.
+ * @param size The input size (in bytes).
+ * @param delimiter The field delimiter. Must be non-zero, and neither a
+ * newline nor the quote character.
+ * @param quote The quote character, or 0 to disable quoting. Must not be a
+ * newline.
+ * @param chunk_count The number of chunks, or 0 for one per job system worker
+ * plus one for the calling thread. Fewer chunks are used if any would be
+ * smaller than CSV_PARALLEL_MIN_CHUNK_SIZE.
+ * @param function The function to call for each record. Must be non-zero, and
+ * safe to call from several threads at once.
+ * @param args Arguments to pass to function.
+ * @return true if every record was parsed and handled; false otherwise.
+ */
+bool
+csv_parse_parallel
+(   const char*             data
+,   u64                     size
+,   char                    delimiter
+,   char                    quote
+,   u64                     chunk_count
+,   csv_record_function_t   function
+,   void*                   args
+);
+
+#endif  // CSV_H
@@ -0,0 +1,198 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/hash.c
+ * @brief Implementation of the core/hash header.
+ * (see core/hash.h for additional details)
+ */
+#include "core/hash.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+/** @brief Default hash64 secret (odd, with balanced bits in every byte). */
+static const u64 hash64_secret[ 4 ] = { 0x2d358dccaa6c78a5ULL
+                                      , 0x8bb84b93962eacc9ULL
+                                      , 0x4b33a62ed433d4a3ULL
+                                      , 0x4d5a2da51de1aa47ULL
+                                      };
+
+/**
+ * @brief Computes the full 128-bit product of two 64-bit integers.
+ * 
+ * @param a Input: first factor. Output: low 64 bits of the product.
+ * @param b Input: second factor. Output: high 64 bits of the product.
+ */
+INLINE void
+hash64_multiply
+(   u64* a
+,   u64* b
+)
+{
+#ifdef _MSC_VER
+    *a = _umul128 ( *a , *b , b );
+#else
+    const __uint128_t product = ( ( __uint128_t ) *a ) * *b;
+    *a = ( u64 ) product;
+    *b = ( u64 )( product >> 64 );
+#endif
+}
+
+/**
+ * @brief Mixes two 64-bit integers.
+ * 
+ * @param a A 64-bit integer.
+ * @param b A 64-bit integer.
+ * @return The exclusive or of the low and high 64 bits of a * b.
+ */
+INLINE u64
+hash64_mix
+(   u64 a
+,   u64 b
+)
+{
+    hash64_multiply ( &a , &b );
+    return a ^ b;
+}
+
+/**
+ * @brief Reads eight bytes as a little-endian integer. Does not require
+ * alignment; compiles to a single load on little-endian targets.
+ * 
+ * @param p Address to read from. Must be non-zero.
+ * @return The integer.
+ */
+INLINE u64
+hash64_read8
+(   const u8* p
+)
+{
+    return ( ( u64 ) p[ 0 ] )
+         | ( ( u64 ) p[ 1 ] << 8 )
+         | ( ( u64 ) p[ 2 ] << 16 )
+         | ( ( u64 ) p[ 3 ] << 24 )
+         | ( ( u64 ) p[ 4 ] << 32 )
+         | ( ( u64 ) p[ 5 ] << 40 )
+         | ( ( u64 ) p[ 6 ] << 48 )
+         | ( ( u64 ) p[ 7 ] << 56 )
+         ;
+}
+
+/**
+ * @brief Reads four bytes as a little-endian integer. Does not require
+ * alignment.
+ * 
+ * @param p Address to read from. Must be non-zero.
+ * @return The integer.
+ */
+INLINE u64
+hash64_read4
+(   const u8* p
+)
+{
+    return ( ( u64 ) p[ 0 ] )
+         | ( ( u64 ) p[ 1 ] << 8 )
+         | ( ( u64 ) p[ 2 ] << 16 )
+         | ( ( u64 ) p[ 3 ] << 24 )
+         ;
+}
+
+u64
+hash64
+(   const void* data
+,   const u64   size
+,   u64         seed
+)
+{
+    const u8* p = data;
+    u64 a;
+    u64 b;
+
+    seed ^= hash64_mix ( seed ^ hash64_secret[ 0 ] , hash64_secret[ 1 ] );
+
+    if ( size <= 16 )
+    {
+        if ( size >= 4 )
+        {
+            // Two (possibly overlapping) pairs of four-byte reads cover every
+            // byte of the input.
+            const u64 offset = ( size >> 3 ) << 2;
+            a = ( hash64_read4 ( p ) << 32 ) | hash64_read4 ( p + offset );
+            b = ( hash64_read4 ( p + size - 4 ) << 32 )
+              | hash64_read4 ( p + size - 4 - offset )
+              ;
+        }
+        else if ( size )
+        {
+            a = ( ( ( u64 ) p[ 0 ] ) << 16 )
+              | ( ( ( u64 ) p[ size >> 1 ] ) << 8 )
+              | p[ size - 1 ]
+              ;
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        u64 remaining = size;
+        if ( remaining > 48 )
+        {
+            // Three independent lanes of 16 bytes each.
+            u64 seed1 = seed;
+            u64 seed2 = seed;
+            do
+            {
+                seed = hash64_mix ( hash64_read8 ( p ) ^ hash64_secret[ 1 ]
+                                  , hash64_read8 ( p + 8 ) ^ seed
+                                  );
+                seed1 = hash64_mix ( hash64_read8 ( p + 16 ) ^ hash64_secret[ 2 ]
+                                   , hash64_read8 ( p + 24 ) ^ seed1
+                                   );
+                seed2 = hash64_mix ( hash64_read8 ( p + 32 ) ^ hash64_secret[ 3 ]
+                                   , hash64_read8 ( p + 40 ) ^ seed2
+                                   );
+                p += 48;
+                remaining -= 48;
+            }
+            while ( remaining > 48 );
+            seed ^= seed1 ^ seed2;
+        }
+        while ( remaining > 16 )
+        {
+            seed = hash64_mix ( hash64_read8 ( p ) ^ hash64_secret[ 1 ]
+                              , hash64_read8 ( p + 8 ) ^ seed
+                              );
+            p += 16;
+            remaining -= 16;
+        }
+
+        // The final 16 bytes of the input (may overlap the previous block).
+        a = hash64_read8 ( p + remaining - 16 );
+        b = hash64_read8 ( p + remaining - 8 );
+    }
+
+    a ^= hash64_secret[ 1 ];
+    b ^= seed;
+    hash64_multiply ( &a , &b );
+    return hash64_mix ( a ^ hash64_secret[ 0 ] ^ size , b ^ hash64_secret[ 1 ] );
+}
+
+u64
+hash_polynomial
+(   const void* data
+,   const u64   size
+,   const u64   seed
+)
+{
+    static const u64 prime = 97;
+    u64 hash = seed;
+    for ( u64 i = 0; i < size; ++i )
+    {
+        hash = hash * prime + ( ( const u8* ) data )[ i ];
+    }
+    return hash;
+}
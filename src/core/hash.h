@@ -0,0 +1,63 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/hash.h
+ * @brief Provides an interface for non-cryptographic hash functions.
+ */
+#ifndef HASH_H
+#define HASH_H
+
+#include "common.h"
+
+/**
+ * @brief Type definition for a seeded hash function.
+ * 
+ * @param data The data to hash. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to hash.
+ * @param seed The seed.
+ * @return The hash of size bytes of data.
+ */
+typedef u64 ( *hash_function_t )( const void* data
+                                , const u64   size
+                                , const u64   seed
+                                );
+
+/**
+ * @brief Fast, seeded 64-bit hash. O(n).
+ * 
+ * Consumes eight bytes at a time and reduces with 64x64->128-bit
+ * multiplications (based on wyhash). Not suitable for cryptographic purposes;
+ * choose the seed at random when hashing untrusted input, to avoid collision
+ * flooding.
+ * 
+ * @param data The data to hash. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to hash.
+ * @param seed The seed.
+ * @return The hash of size bytes of data.
+ */
+u64
+hash64
+(   const void* data
+,   const u64   size
+,   const u64   seed
+);
+
+/**
+ * @brief Polynomial rolling hash. O(n).
+ * 
+ * Consumes one byte at a time. Slower and of lower quality than hash64;
+ * provided for compatibility with hashes computed by earlier versions of the
+ * hashtable.
+ * 
+ * @param data The data to hash. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to hash.
+ * @param seed The seed.
+ * @return The hash of size bytes of data.
+ */
+u64
+hash_polynomial
+(   const void* data
+,   const u64   size
+,   const u64   seed
+);
+
+#endif  // HASH_H
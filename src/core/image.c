@@ -0,0 +1,114 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/image.c
+ * @brief Implementation of the core/image header.
+ * (see core/image.h for additional details)
+ */
+#include "core/image.h"
+
+#include "core/checksum.h"
+#include "core/logger.h"
+
+/** @brief Image header magic number ("IMG1" in memory on a little-endian host). */
+#define IMAGE_MAGIC 0x31474D49
+
+/** @brief The image header magic number, as read on a host of the other byte order. */
+#define IMAGE_MAGIC_SWAPPED 0x494D4731
+
+STATIC_ASSERT ( sizeof ( image_header_t ) == 64 , "Expected image header to be 64 bytes." );
+
+void
+image_header_write
+(   const IMAGE_TYPE    type
+,   const u16           version
+,   const u64*          parameters
+,   const u64           size
+,   void*               image
+)
+{
+    image_header_t* header = image;
+    ( *header ).magic = IMAGE_MAGIC;
+    ( *header ).type = type;
+    ( *header ).version = version;
+    ( *header ).size = size;
+    for ( u32 i = 0; i < IMAGE_PARAMETER_COUNT; ++i )
+    {
+        ( *header ).parameters[ i ] = parameters[ i ];
+    }
+    ( *header ).checksum = checksum_crc32c ( ( ( const u8* ) image ) + IMAGE_HEADER_SIZE
+                                           , size - IMAGE_HEADER_SIZE
+                                           , 0
+                                           );
+    ( *header ).header_checksum = checksum_crc32c ( header
+                                                  , IMAGE_HEADER_SIZE - sizeof ( u32 )
+                                                  , 0
+                                                  );
+}
+
+const image_header_t*
+image_header_read
+(   const char*         caller
+,   const void*         image
+,   const u64           size
+,   const IMAGE_TYPE    type
+,   const u16           version
+,   const bool          verify
+)
+{
+    if ( !image || size < IMAGE_HEADER_SIZE )
+    {
+        LOGERROR ( "%s: Image is too small to hold an image header (%u bytes)."
+                 , caller , size
+                 );
+        return 0;
+    }
+
+    const image_header_t* header = image;
+    if ( ( *header ).magic != IMAGE_MAGIC )
+    {
+        if ( ( *header ).magic == IMAGE_MAGIC_SWAPPED )
+        {
+            LOGERROR ( "%s: Image was written on a host with a different byte order."
+                     , caller
+                     );
+        }
+        else
+        {
+            LOGERROR ( "%s: Not an image (magic number: %u)."
+                     , caller , ( *header ).magic
+                     );
+        }
+        return 0;
+    }
+    if ( ( *header ).header_checksum != checksum_crc32c ( header
+                                                        , IMAGE_HEADER_SIZE - sizeof ( u32 )
+                                                        , 0
+                                                        ))
+    {
+        LOGERROR ( "%s: Image header is damaged." , caller );
+        return 0;
+    }
+    if ( ( *header ).type != type || ( *header ).version != version )
+    {
+        LOGERROR ( "%s: Expected an image of type %u and version %u, but got type %u and version %u."
+                 , caller , type , version , ( *header ).type , ( *header ).version
+                 );
+        return 0;
+    }
+    if ( ( *header ).size < IMAGE_HEADER_SIZE || ( *header ).size > size )
+    {
+        LOGERROR ( "%s: Image is truncated (expected %u bytes, but only %u are available)."
+                 , caller , ( *header ).size , size
+                 );
+        return 0;
+    }
+    if ( verify && ( *header ).checksum != checksum_crc32c ( ( ( const u8* ) image ) + IMAGE_HEADER_SIZE
+                                                           , ( *header ).size - IMAGE_HEADER_SIZE
+                                                           , 0
+                                                           ))
+    {
+        LOGERROR ( "%s: Image payload is damaged (checksum mismatch)." , caller );
+        return 0;
+    }
+    return header;
+}
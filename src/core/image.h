@@ -0,0 +1,116 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/image.h
+ * @brief Provides an interface for the header of a position-independent image
+ * of a data structure, which may be written to a file, memory-mapped, and
+ * used in place (see hashtable_to_image, array_to_image).
+ *
+ * An image is a header followed by a payload. The payload refers to its own
+ * content by offset from the start of the image rather than by address, so it
+ * is valid wherever it is mapped. The header records the kind of data
+ * structure, the version of its layout, its parameters, the image size, and
+ * CRC32C checksums of both the header and the payload (see core/checksum.h).
+ *
+ * Loading an image checks its header, which is cheap, and optionally
+ * checksums the payload, which reads the whole image. Without the payload
+ * checksum, a mapped image costs nothing until it is accessed: pages are
+ * faulted in from the file on demand.
+ *
+ *   file_map ( &file , FILE_MODE_READ , FILE_MAP_HINT_RANDOM , &map );
+ *   hashtable_create_from_image ( map.data , map.size , stride , false
+ *                               , 0 , 0 , &hashtable
+ *                               );
+ *
+ * Images are native-endian and assume 64-bit addresses; an image written on a
+ * host with the other byte order is rejected.
+ */
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include "common.h"
+
+/** @brief Number of type-specific parameters recorded by an image header. */
+#define IMAGE_PARAMETER_COUNT 5
+
+/** @brief Type and instance definitions for the kinds of image. */
+typedef enum
+{
+    IMAGE_TYPE_HASHTABLE = 1
+,   IMAGE_TYPE_ARRAY     = 2
+}
+IMAGE_TYPE;
+
+/**
+ * @brief Type definition for an image header. The payload follows it
+ * directly, and is 64-byte aligned relative to the start of the image.
+ */
+typedef struct
+{
+    u32     magic;
+    u16     type;
+    u16     version;
+
+    // Image size (in bytes), including the header.
+    u64     size;
+
+    // Type-specific (e.g. element stride and count).
+    u64     parameters[ IMAGE_PARAMETER_COUNT ];
+
+    // CRC32C of the payload.
+    u32     checksum;
+
+    // CRC32C of every preceding field of the header.
+    u32     header_checksum;
+}
+image_header_t;
+
+/** @brief Image header size (in bytes). */
+#define IMAGE_HEADER_SIZE sizeof ( image_header_t )
+
+/**
+ * @brief Writes an image header, and checksums the payload which follows it.
+ * O(n).
+ *
+ * @param type The kind of image.
+ * @param version The version of the layout of the payload.
+ * @param parameters The type-specific parameters (IMAGE_PARAMETER_COUNT
+ * values). Must be non-zero.
+ * @param size The image size (in bytes), including the header.
+ * @param image The image, with the payload already written after the header.
+ * Must be non-zero, and hold at least size bytes.
+ */
+void
+image_header_write
+(   const IMAGE_TYPE    type
+,   const u16           version
+,   const u64*          parameters
+,   const u64           size
+,   void*               image
+);
+
+/**
+ * @brief Validates an image header. O(1), or O(n) if verifying the payload.
+ *
+ * Checks that the header is intact, of the expected kind and version, and
+ * that the image fits within size. Failures are logged.
+ *
+ * @param caller The name of the calling function, for error messages.
+ * @param image The image. Must be non-zero if size is non-zero.
+ * @param size The number of bytes available at image (e.g. the size of the
+ * mapped file).
+ * @param type The expected kind of image.
+ * @param version The expected version of the layout of the payload.
+ * @param verify Also checksum the payload? Y/N (reads the whole image)
+ * @return The header if valid; 0 otherwise.
+ */
+const image_header_t*
+image_header_read
+(   const char*         caller
+,   const void*         image
+,   const u64           size
+,   const IMAGE_TYPE    type
+,   const u16           version
+,   const bool          verify
+);
+
+#endif  // IMAGE_H
@@ -0,0 +1,905 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/job.c
+ * @brief Implementation of the core/job header.
+ * (see core/job.h for additional details)
+ */
+#include "core/job.h"
+
+#include "common/align.h"
+#include "common/thread_local.h"
+
+#include "container/mpmc_queue.h"
+
+#include "core/clock.h"
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/metrics.h"
+
+#include "platform/fiber.h"
+#include "platform/platform.h"
+#include "platform/thread.h"
+
+/**
+ * @brief Number of consecutive failed attempts to find work before an idle
+ * thread starts sleeping between attempts, rather than yielding.
+ */
+#define JOB_IDLE_SPIN_COUNT 256
+
+/** @brief Type definition for a job in flight. */
+typedef struct node_t
+{
+    job_function_t  function;
+    void*           args;
+    job_counter_t*  counter;
+    struct node_t*  next;
+
+    // Fiber jobs only (see job_resume). The fiber is created the first time
+    // the job runs; wait is set by job_wait before the fiber is suspended.
+    bool            on_fiber;
+    fiber_t*        fiber;
+    job_counter_t*  wait;
+}
+node_t;
+
+/**
+ * @brief Type definition for a work-stealing deque (Chase-Lev).
+ *
+ * The owning worker pushes and pops at the bottom; every other thread steals
+ * from the top. Holds indices into the job pool, so it can never overflow if
+ * its capacity is at least JOB_CAPACITY.
+ */
+typedef struct
+{
+    u64     top;
+    u8      padding0[ CACHE_LINE_SIZE - sizeof ( u64 ) ];
+    u64     bottom;
+    u8      padding1[ CACHE_LINE_SIZE - sizeof ( u64 ) ];
+    u64*    entries;
+    u8      padding2[ CACHE_LINE_SIZE - sizeof ( u64* ) ];
+}
+deque_t;
+
+/** @brief Type definition for a worker thread. */
+typedef struct
+{
+    deque_t     deque;
+    thread_t    thread;
+    u64         index;
+}
+worker_t;
+
+/** @brief Type definition for job system state. */
+typedef struct
+{
+    u64             worker_count;
+    worker_t*       workers;
+    node_t*         nodes;
+
+    // Free job pool indices.
+    mpmc_queue_t*   pool;
+
+    // Jobs submitted by threads which are not workers.
+    mpmc_queue_t*   injection;
+
+    u64             memory_requirement;
+    bool            owns_memory;
+    u32             running;
+}
+state_t;
+
+/** @brief Global subsystem state. */
+static state_t* state = 0;
+
+/**
+ * @brief Index of the worker owned by the calling thread, plus one; 0 if the
+ * calling thread is not a worker.
+ */
+static THREAD_LOCAL u64 job_worker_index = 0;
+
+/** @brief The fiber job the calling thread is running, or 0 if none. */
+static THREAD_LOCAL node_t* job_fiber_node = 0;
+
+/**
+ * @brief Computes the number of workers to start by default.
+ *
+ * @return One less than the number of available processor cores (minimum 1).
+ */
+u64
+job_system_default_worker_count
+( void );
+
+/**
+ * @brief Worker thread entry point.
+ *
+ * @param args The worker to run. Must be non-zero.
+ * @return 0.
+ */
+u32
+job_worker
+(   void* args
+);
+
+/**
+ * @brief Pushes a job index onto the bottom of a deque. Must only be called by
+ * the owning worker.
+ *
+ * @param deque The deque to push to. Must be non-zero.
+ * @param index The job index to push.
+ */
+void
+job_deque_push
+(   deque_t*    deque
+,   u64         index
+);
+
+/**
+ * @brief Pops a job index from the bottom of a deque. Must only be called by
+ * the owning worker.
+ *
+ * @param deque The deque to pop from. Must be non-zero.
+ * @param index Output buffer for the job index.
+ * @return true if a job was popped; false if the deque was empty.
+ */
+bool
+job_deque_pop
+(   deque_t*    deque
+,   u64*        index
+);
+
+/**
+ * @brief Steals a job index from the top of a deque. May be called by any
+ * thread.
+ *
+ * @param deque The deque to steal from. Must be non-zero.
+ * @param index Output buffer for the job index.
+ * @return true if a job was stolen; false if the deque was empty or the steal
+ * lost a race with another thread.
+ */
+bool
+job_deque_steal
+(   deque_t*    deque
+,   u64*        index
+);
+
+/**
+ * @brief Makes a job available for execution, either on the calling worker's
+ * deque or on the injection queue.
+ *
+ * @param node The job to schedule. Must be non-zero.
+ */
+void
+job_schedule
+(   node_t* node
+);
+
+/**
+ * @brief Parks a job on a counter until it reaches zero (see
+ * job_counter_decrement), unless it already has.
+ *
+ * @param node The job to park. Must be non-zero.
+ * @param counter The counter to park on. Must be non-zero.
+ * @return true if the job was parked; false if counter was zero, in which case
+ * the job is runnable.
+ */
+bool
+job_park
+(   node_t*         node
+,   job_counter_t*  counter
+);
+
+/**
+ * @brief Runs a fiber job until it finishes, waits or yields. A job which
+ * waits is parked on the counter it waits on; a job which yields is
+ * rescheduled behind every other pending job.
+ *
+ * The job is parked or rescheduled only once its fiber has been suspended, so
+ * that no other thread can resume the fiber while it is still running.
+ *
+ * @param node The job to run. Must be non-zero.
+ * @return true if the job finished; false otherwise.
+ */
+bool
+job_resume
+(   node_t* node
+);
+
+/**
+ * @brief Finds and executes one runnable job, if there is one.
+ *
+ * Searches the calling worker's own deque first, then the injection queue,
+ * then the deques of every other worker.
+ *
+ * @return true if a job was executed; false otherwise.
+ */
+bool
+job_execute_next
+( void );
+
+/**
+ * @brief Backs off after a failed attempt to find work.
+ *
+ * @param attempts The number of consecutive failed attempts so far.
+ */
+void
+job_idle
+(   u64 attempts
+);
+
+/**
+ * @brief Decrements a counter on behalf of a finished job, releasing any jobs
+ * which were waiting on it to reach zero.
+ *
+ * @param counter The counter to decrement. Must be non-zero.
+ */
+void
+job_counter_decrement
+(   job_counter_t* counter
+);
+
+/**
+ * @brief Acquires the lock which guards a counter's transition to zero and its
+ * list of waiting jobs.
+ *
+ * @param counter The counter to lock. Must be non-zero.
+ */
+void
+job_counter_lock
+(   job_counter_t* counter
+);
+
+/**
+ * @brief Releases the lock acquired by job_counter_lock.
+ *
+ * @param counter The counter to unlock. Must be non-zero.
+ */
+void
+job_counter_unlock
+(   job_counter_t* counter
+);
+
+bool
+job_system_startup
+(   u64     worker_count
+,   u64*    memory_requirement_
+,   void*   memory_
+)
+{
+    if ( state )
+    {
+        LOGERROR ( "job_system_startup: Called more than once." );
+        return false;
+    }
+
+    if ( !worker_count )
+    {
+        worker_count = job_system_default_worker_count ();
+    }
+
+    u64 pool_memory_requirement;
+    u64 injection_memory_requirement;
+    mpmc_queue_create ( sizeof ( u64 ) , JOB_CAPACITY , &pool_memory_requirement , 0 , 0 );
+    mpmc_queue_create ( sizeof ( u64 ) , JOB_CAPACITY , &injection_memory_requirement , 0 , 0 );
+
+    const u64 state_memory_requirement = aligned ( sizeof ( state_t ) , CACHE_LINE_SIZE );
+    const u64 workers_memory_requirement = aligned ( worker_count * sizeof ( worker_t ) , CACHE_LINE_SIZE );
+    const u64 entries_memory_requirement = worker_count * JOB_CAPACITY * sizeof ( u64 );
+    const u64 nodes_memory_requirement = aligned ( JOB_CAPACITY * sizeof ( node_t ) , CACHE_LINE_SIZE );
+    const u64 memory_requirement = state_memory_requirement
+                                 + workers_memory_requirement
+                                 + entries_memory_requirement
+                                 + nodes_memory_requirement
+                                 + aligned ( pool_memory_requirement , CACHE_LINE_SIZE )
+                                 + injection_memory_requirement
+                                 ;
+
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_aligned_uninit ( memory_requirement
+                                                , CACHE_LINE_SIZE
+                                                , MEMORY_TAG_JOB
+                                                );
+    }
+    memory_clear ( memory , memory_requirement );
+
+    state = memory;
+    ( *state ).worker_count = worker_count;
+    ( *state ).memory_requirement = memory_requirement;
+    ( *state ).owns_memory = !memory_;
+
+    u64 offset = ( ( u64 ) memory ) + state_memory_requirement;
+    ( *state ).workers = ( void* ) offset;
+    offset += workers_memory_requirement;
+    for ( u64 i = 0; i < worker_count; ++i )
+    {
+        ( *state ).workers[ i ].deque.entries = ( void* ) offset;
+        ( *state ).workers[ i ].index = i + 1;
+        offset += JOB_CAPACITY * sizeof ( u64 );
+    }
+    ( *state ).nodes = ( void* ) offset;
+    offset += nodes_memory_requirement;
+    mpmc_queue_create ( sizeof ( u64 ) , JOB_CAPACITY , 0 , ( void* ) offset , &( *state ).pool );
+    offset += aligned ( pool_memory_requirement , CACHE_LINE_SIZE );
+    mpmc_queue_create ( sizeof ( u64 ) , JOB_CAPACITY , 0 , ( void* ) offset , &( *state ).injection );
+
+    // Every job slot starts out free.
+    for ( u64 i = 0; i < JOB_CAPACITY; ++i )
+    {
+        mpmc_queue_push ( ( *state ).pool , &i );
+    }
+
+    atomic_store_u32 ( &( *state ).running , true , ATOMIC_RELEASE );
+
+    // Start worker threads.
+    thread_options_t options;
+    memory_clear ( &options , sizeof ( thread_options_t ) );
+    options.name = "job worker";
+    for ( u64 i = 0; i < worker_count; ++i )
+    {
+        if ( !thread_create_ex ( job_worker , &( *state ).workers[ i ] , &options , &( *state ).workers[ i ].thread ) )
+        {
+            LOGERROR ( "job_system_startup: Failed to start worker thread %u of %u."
+                     , i + 1 , worker_count
+                     );
+            ( *state ).worker_count = i;
+            job_system_shutdown ();
+            return false;
+        }
+    }
+
+    LOGDEBUG ( "job_system_startup: Started %u worker threads." , worker_count );
+
+    return true;
+}
+
+void
+job_system_shutdown
+( void )
+{
+    if ( !state )
+    {
+        return;
+    }
+
+    // Signal every worker to stop, then wait for them to exit.
+    atomic_store_u32 ( &( *state ).running , false , ATOMIC_RELEASE );
+    for ( u64 i = 0; i < ( *state ).worker_count; ++i )
+    {
+        thread_wait ( &( *state ).workers[ i ].thread );
+        thread_destroy ( &( *state ).workers[ i ].thread );
+    }
+
+    // Free the fibers of any jobs which were suspended and never resumed.
+    for ( u64 i = 0; i < JOB_CAPACITY; ++i )
+    {
+        fiber_destroy ( &( *state ).nodes[ i ].fiber );
+    }
+
+    mpmc_queue_destroy ( &( *state ).injection );
+    mpmc_queue_destroy ( &( *state ).pool );
+
+    const u64 memory_requirement = ( *state ).memory_requirement;
+    if ( ( *state ).owns_memory )
+    {
+        memory_free_aligned ( state
+                            , memory_requirement
+                            , CACHE_LINE_SIZE
+                            , MEMORY_TAG_JOB
+                            );
+    }
+    else
+    {
+        memory_clear ( state , memory_requirement );
+    }
+
+    state = 0;
+}
+
+u64
+job_system_worker_count
+( void )
+{
+    return state ? ( *state ).worker_count : 0;
+}
+
+u64
+job_system_pending_count
+( void )
+{
+    if ( !state )
+    {
+        return 0;
+    }
+    // Every job in flight holds a slot taken from the pool.
+    const u64 free = mpmc_queue_length ( ( *state ).pool );
+    return ( free < JOB_CAPACITY ) ? JOB_CAPACITY - free : 0;
+}
+
+bool
+_job_submit
+(   const job_t*    jobs
+,   u64             job_count
+,   job_counter_t*  counter
+,   job_counter_t*  dependency
+,   bool            fiber
+)
+{
+    if ( !state )
+    {
+        LOGERROR ( "_job_submit: The job system is not running." );
+        return false;
+    }
+    if ( !jobs )
+    {
+        LOGERROR ( "_job_submit: Missing argument: jobs." );
+        return false;
+    }
+    for ( u64 i = 0; i < job_count; ++i )
+    {
+        if ( !jobs[ i ].function )
+        {
+            LOGERROR ( "_job_submit: Job %u of %u has no function."
+                     , i + 1 , job_count
+                     );
+            return false;
+        }
+    }
+
+    // Count every job before any of them can finish, so the counter cannot
+    // reach zero while the batch is still being submitted.
+    if ( counter )
+    {
+        atomic_fetch_add_u64 ( &( *counter ).value , job_count , ATOMIC_SEQ_CST );
+    }
+
+    for ( u64 i = 0; i < job_count; ++i )
+    {
+        // Acquire a free job slot, running pending jobs until one frees up.
+        u64 index;
+        for ( u64 attempts = 0; !mpmc_queue_pop ( ( *state ).pool , &index ); ++attempts )
+        {
+            if ( job_execute_next () )
+            {
+                attempts = 0;
+            }
+            else
+            {
+                job_idle ( attempts );
+            }
+        }
+
+        node_t* node = &( *state ).nodes[ index ];
+        ( *node ).function = jobs[ i ].function;
+        ( *node ).args = jobs[ i ].args;
+        ( *node ).counter = counter;
+        ( *node ).next = 0;
+        ( *node ).on_fiber = fiber;
+        ( *node ).fiber = 0;
+        ( *node ).wait = 0;
+
+        // Park the job on the dependency if it has not completed yet; it is
+        // scheduled by whichever thread brings the dependency to zero.
+        if ( dependency && job_park ( node , dependency ) )
+        {
+            continue;
+        }
+
+        job_schedule ( node );
+    }
+
+    return true;
+}
+
+void
+job_wait
+(   job_counter_t* counter
+)
+{
+    if ( !counter )
+    {
+        LOGERROR ( "job_wait: Missing argument: counter." );
+        return;
+    }
+
+    // A fiber job is suspended rather than holding the thread; it is parked on
+    // the counter once the fiber has switched out (see job_resume).
+    node_t* node = job_fiber_node;
+    if ( node && fiber_current () == ( *node ).fiber )
+    {
+        while ( atomic_load_u64 ( &( *counter ).value , ATOMIC_ACQUIRE ) )
+        {
+            ( *node ).wait = counter;
+            fiber_yield ();
+        }
+    }
+
+    u64 attempts = 0;
+    while ( atomic_load_u64 ( &( *counter ).value , ATOMIC_ACQUIRE ) )
+    {
+        if ( state && job_execute_next () )
+        {
+            attempts = 0;
+        }
+        else
+        {
+            job_idle ( attempts );
+            attempts += 1;
+        }
+    }
+
+    // The final decrement happens while holding the counter lock; take it once
+    // so the finishing thread is guaranteed to be done with the counter before
+    // the caller is allowed to release it.
+    job_counter_lock ( counter );
+    job_counter_unlock ( counter );
+}
+
+void
+job_yield
+( void )
+{
+    node_t* node = job_fiber_node;
+    if ( node && fiber_current () == ( *node ).fiber )
+    {
+        ( *node ).wait = 0;
+        fiber_yield ();
+    }
+    else if ( state )
+    {
+        job_execute_next ();
+    }
+}
+
+u64
+job_counter_value
+(   const job_counter_t* counter
+)
+{
+    return atomic_load_u64 ( &( *counter ).value , ATOMIC_ACQUIRE );
+}
+
+void
+job_counter_add
+(   job_counter_t*  counter
+,   u64             amount
+)
+{
+    atomic_fetch_add_u64 ( &( *counter ).value , amount , ATOMIC_SEQ_CST );
+}
+
+void
+job_counter_release
+(   void* counter
+)
+{
+    job_counter_decrement ( counter );
+}
+
+u64
+job_system_default_worker_count
+( void )
+{
+    const i32 core_count = platform_processor_core_count ();
+    return ( core_count > 1 ) ? core_count - 1 : 1;
+}
+
+u32
+job_worker
+(   void* args
+)
+{
+    worker_t* worker = args;
+    job_worker_index = ( *worker ).index;
+
+    u64 attempts = 0;
+    while ( atomic_load_u32 ( &( *state ).running , ATOMIC_ACQUIRE ) )
+    {
+        if ( job_execute_next () )
+        {
+            attempts = 0;
+        }
+        else
+        {
+            job_idle ( attempts );
+            attempts += 1;
+        }
+    }
+
+    job_worker_index = 0;
+    return 0;
+}
+
+void
+job_deque_push
+(   deque_t*    deque
+,   u64         index
+)
+{
+    const u64 bottom = atomic_load_u64 ( &( *deque ).bottom , ATOMIC_RELAXED );
+    atomic_store_u64 ( &( *deque ).entries[ bottom & ( JOB_CAPACITY - 1 ) ]
+                     , index
+                     , ATOMIC_RELAXED
+                     );
+    atomic_store_u64 ( &( *deque ).bottom , bottom + 1 , ATOMIC_RELEASE );
+}
+
+bool
+job_deque_pop
+(   deque_t*    deque
+,   u64*        index
+)
+{
+    const u64 bottom = atomic_load_u64 ( &( *deque ).bottom , ATOMIC_RELAXED ) - 1;
+    atomic_store_u64 ( &( *deque ).bottom , bottom , ATOMIC_RELAXED );
+    atomic_fence ( ATOMIC_SEQ_CST );
+    u64 top = atomic_load_u64 ( &( *deque ).top , ATOMIC_RELAXED );
+
+    // Empty? (The indices may wrap, so compare their difference.)
+    if ( ( i64 )( bottom - top ) < 0 )
+    {
+        atomic_store_u64 ( &( *deque ).bottom , bottom + 1 , ATOMIC_RELAXED );
+        return false;
+    }
+
+    *index = atomic_load_u64 ( &( *deque ).entries[ bottom & ( JOB_CAPACITY - 1 ) ]
+                             , ATOMIC_RELAXED
+                             );
+    if ( ( i64 )( bottom - top ) > 0 )
+    {
+        return true;
+    }
+
+    // Last element: race any thief for it.
+    const bool won = atomic_compare_exchange_u64 ( &( *deque ).top
+                                                 , &top
+                                                 , top + 1
+                                                 , ATOMIC_SEQ_CST
+                                                 , ATOMIC_RELAXED
+                                                 );
+    atomic_store_u64 ( &( *deque ).bottom , bottom + 1 , ATOMIC_RELAXED );
+    return won;
+}
+
+bool
+job_deque_steal
+(   deque_t*    deque
+,   u64*        index
+)
+{
+    u64 top = atomic_load_u64 ( &( *deque ).top , ATOMIC_ACQUIRE );
+    atomic_fence ( ATOMIC_SEQ_CST );
+    const u64 bottom = atomic_load_u64 ( &( *deque ).bottom , ATOMIC_ACQUIRE );
+    if ( ( i64 )( bottom - top ) <= 0 )
+    {
+        return false;
+    }
+
+    *index = atomic_load_u64 ( &( *deque ).entries[ top & ( JOB_CAPACITY - 1 ) ] , ATOMIC_RELAXED );
+    return atomic_compare_exchange_u64 ( &( *deque ).top
+                                       , &top
+                                       , top + 1
+                                       , ATOMIC_SEQ_CST
+                                       , ATOMIC_RELAXED
+                                       );
+}
+
+void
+job_schedule
+(   node_t* node
+)
+{
+    const u64 index = node - ( *state ).nodes;
+    if ( job_worker_index )
+    {
+        job_deque_push ( &( *state ).workers[ job_worker_index - 1 ].deque , index );
+    }
+    else
+    {
+        // Never fails: the queue can hold every job slot at once.
+        mpmc_queue_push ( ( *state ).injection , &index );
+    }
+}
+
+bool
+job_execute_next
+( void )
+{
+    u64 index;
+    bool found = false;
+
+    if ( job_worker_index )
+    {
+        found = job_deque_pop ( &( *state ).workers[ job_worker_index - 1 ].deque , &index );
+    }
+    if ( !found )
+    {
+        found = mpmc_queue_pop ( ( *state ).injection , &index );
+    }
+
+    // Steal, starting from the next worker so that thieves spread out.
+    for ( u64 i = 0; !found && i < ( *state ).worker_count; ++i )
+    {
+        const u64 victim = ( job_worker_index + i ) % ( *state ).worker_count;
+        if ( victim + 1 == job_worker_index )
+        {
+            continue;
+        }
+        found = job_deque_steal ( &( *state ).workers[ victim ].deque , &index );
+    }
+
+    if ( !found )
+    {
+        return false;
+    }
+
+    node_t* node = &( *state ).nodes[ index ];
+    job_counter_t* counter = ( *node ).counter;
+    const u64 begin = metrics_running () ? clock_ticks () : 0;
+    bool finished = true;
+    if ( !( *node ).on_fiber )
+    {
+        ( *node ).function ( ( *node ).args );
+    }
+    else
+    {
+        finished = job_resume ( node );
+    }
+    if ( begin )
+    {
+        metrics_histogram_record ( METRICS_JOB_RUN_TIME , clock_ticks_to_ns ( clock_ticks () - begin ) );
+    }
+    if ( !finished )
+    {
+        return true;
+    }
+
+    // Free the job slot before signalling completion.
+    mpmc_queue_push ( ( *state ).pool , &index );
+    if ( counter )
+    {
+        job_counter_decrement ( counter );
+    }
+    return true;
+}
+
+bool
+job_park
+(   node_t*         node
+,   job_counter_t*  counter
+)
+{
+    bool parked = false;
+    job_counter_lock ( counter );
+    if ( atomic_load_u64 ( &( *counter ).value , ATOMIC_ACQUIRE ) )
+    {
+        ( *node ).next = ( *counter ).waiters;
+        ( *counter ).waiters = node;
+        parked = true;
+    }
+    job_counter_unlock ( counter );
+    return parked;
+}
+
+bool
+job_resume
+(   node_t* node
+)
+{
+    if ( !( *node ).fiber && !fiber_create ( ( *node ).function , ( *node ).args , &( *node ).fiber ) )
+    {
+        LOGWARN ( "job_resume: Failed to create a fiber; running the job on the calling thread instead." );
+        ( *node ).on_fiber = false;
+        ( *node ).function ( ( *node ).args );
+        return true;
+    }
+
+    node_t* previous = job_fiber_node;
+    job_fiber_node = node;
+    const FIBER_STATE status = fiber_resume ( ( *node ).fiber );
+    job_fiber_node = previous;
+
+    if ( status == FIBER_STATE_FINISHED )
+    {
+        fiber_destroy ( &( *node ).fiber );
+        return true;
+    }
+
+    job_counter_t* wait = ( *node ).wait;
+    ( *node ).wait = 0;
+    if ( wait && job_park ( node , wait ) )
+    {
+        return false;
+    }
+    if ( wait )
+    {
+        job_schedule ( node );
+    }
+    else
+    {
+        // Yielded: queue behind every other pending job. Never fails (see
+        // job_schedule).
+        const u64 index = node - ( *state ).nodes;
+        mpmc_queue_push ( ( *state ).injection , &index );
+    }
+    return false;
+}
+
+void
+job_idle
+(   u64 attempts
+)
+{
+    platform_sleep ( ( attempts < JOB_IDLE_SPIN_COUNT ) ? 0 : 1 );
+}
+
+void
+job_counter_decrement
+(   job_counter_t* counter
+)
+{
+    // Fast path: not the final job, so nothing can be waiting on the
+    // transition to zero.
+    u64 value = atomic_load_u64 ( &( *counter ).value , ATOMIC_RELAXED );
+    while ( value > 1 )
+    {
+        if ( atomic_compare_exchange_u64 ( &( *counter ).value
+                                         , &value
+                                         , value - 1
+                                         , ATOMIC_SEQ_CST
+                                         , ATOMIC_RELAXED
+                                         ) )
+        {
+            return;
+        }
+    }
+
+    job_counter_lock ( counter );
+    node_t* waiters = 0;
+    if ( atomic_fetch_sub_u64 ( &( *counter ).value , 1 , ATOMIC_SEQ_CST ) == 1 )
+    {
+        waiters = ( *counter ).waiters;
+        ( *counter ).waiters = 0;
+    }
+    job_counter_unlock ( counter );
+
+    // The counter must not be accessed past this point (see job_wait).
+    while ( waiters )
+    {
+        node_t* next = ( *waiters ).next;
+        job_schedule ( waiters );
+        waiters = next;
+    }
+}
+
+void
+job_counter_lock
+(   job_counter_t* counter
+)
+{
+    while ( atomic_exchange_u32 ( &( *counter ).lock , 1 , ATOMIC_ACQUIRE ) )
+    {
+        while ( atomic_load_u32 ( &( *counter ).lock , ATOMIC_RELAXED ) );
+    }
+}
+
+void
+job_counter_unlock
+(   job_counter_t* counter
+)
+{
+    atomic_store_u32 ( &( *counter ).lock , 0 , ATOMIC_RELEASE );
+}
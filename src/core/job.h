@@ -0,0 +1,234 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/job.h
+ * @brief Provides an interface for a work-stealing job system.
+ * 
+ * A fixed pool of worker threads is started once by job_system_startup. Each
+ * worker owns a deque of runnable jobs: jobs submitted from a worker are pushed
+ * to that worker's deque, and idle workers steal from the others. Jobs
+ * submitted from any other thread go through a shared injection queue.
+ * 
+ * Completion is tracked by counters: every job submitted against a counter
+ * increments it, and every job that finishes decrements it. A counter may also
+ * be passed as a dependency of a later submission, in which case those jobs
+ * are held back until the counter reaches zero.
+ * 
+ * Jobs submitted with job_submit_fiber each run on a fiber of their own (see
+ * platform/fiber.h). When such a job waits on a counter (see job_wait), its
+ * fiber is suspended and parked on the counter, and the thread goes on to run
+ * other jobs; the job resumes, possibly on another thread, once the counter
+ * reaches zero. A job which waits on another thread's results should be run on
+ * a fiber, since otherwise it holds the thread (and its stack) while it waits.
+ * 
+ * A fiber job may also wait for asynchronous I/O (see platform/io_queue.h):
+ * 
+ *   job_counter_t read = { 0 };
+ *   job_counter_add ( &read , 1 );
+ *   request.job = ( job_t ){ job_counter_release , &read };
+ *   io_queue_submit ( queue , &request , 1 );
+ *   job_wait ( &read );    // Suspends until the request is collected.
+ * 
+ * The request is collected by whichever thread polls the queue.
+ */
+#ifndef JOB_H
+#define JOB_H
+
+#include "common.h"
+
+/**
+ * @brief Maximum number of jobs which may be submitted but not yet finished at
+ * any one time. Must be a power of two.
+ * 
+ * When every job slot is in use, a submitting thread executes pending jobs
+ * itself until a slot becomes available.
+ */
+#define JOB_CAPACITY 4096
+
+/** @brief Type definition for a job entry point. */
+typedef void ( *job_function_t )( void* args );
+
+/** @brief Type definition for a job. */
+typedef struct
+{
+    job_function_t  function;
+    void*           args;
+}
+job_t;
+
+/**
+ * @brief Type definition for a job counter.
+ * 
+ * Must be zero-initialized before first use, and must remain valid until
+ * job_wait returns on it. Fields are internal; use job_counter_value to query.
+ */
+typedef struct
+{
+    u64     value;
+    u32     lock;
+    void*   waiters;
+}
+job_counter_t;
+
+/**
+ * @brief Initializes the job system and starts its worker threads.
+ * 
+ * Call job_system_shutdown to terminate.
+ * 
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size. The buffer should be aligned to
+ *   a cache line (64 bytes) to avoid false sharing.
+ * 
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @param worker_count The number of worker threads to start. Pass 0 to start
+ * one worker per available processor core, minus one for the calling thread
+ * (which executes jobs while it waits; see job_wait).
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required to operate the job system. Only applicable if pre-allocating a
+ * memory buffer of the required size. Pass 0 to use implicit memory
+ * allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @return true on success; false otherwise.
+ */
+bool
+job_system_startup
+(   u64     worker_count
+,   u64*    memory_requirement
+,   void*   memory
+);
+
+/**
+ * @brief Stops the worker threads and terminates the job system.
+ * 
+ * Jobs which have not started executing are discarded; call job_wait on every
+ * outstanding counter first.
+ */
+void
+job_system_shutdown
+( void );
+
+/**
+ * @brief Queries the number of worker threads owned by the job system.
+ * 
+ * @return The number of worker threads, or 0 if the job system is not running.
+ */
+u64
+job_system_worker_count
+( void );
+
+/**
+ * @brief Queries the number of jobs which have been submitted but have not yet
+ * finished (including jobs which are running, waiting on a counter, or held
+ * back by a dependency). Approximate while jobs are being submitted or
+ * finished concurrently.
+ * 
+ * @return The number of jobs in flight, or 0 if the job system is not running.
+ */
+u64
+job_system_pending_count
+( void );
+
+/**
+ * @brief Submits a batch of jobs for execution.
+ * 
+ * Use job_submit to submit jobs with no dependency, or job_submit_after to
+ * hold them back until a previous batch completes. Use job_submit_fiber or
+ * job_submit_fiber_after to run each job on a fiber of its own.
+ * 
+ * @param jobs An array of jobs. Must be non-zero.
+ * @param job_count The number of jobs in the array.
+ * @param counter Optional counter to increment by job_count; it is decremented
+ * as each job finishes. Pass 0 to submit without tracking completion.
+ * @param dependency Optional counter which must reach zero before any of the
+ * jobs may begin executing. Pass 0 to run the jobs immediately.
+ * @param fiber Run each job on a fiber of its own (see FIBER_DEFAULT_STACK_SIZE
+ * in platform/fiber.h), so that it may be suspended while it waits? Y/N
+ * @return true on success; false otherwise.
+ */
+bool
+_job_submit
+(   const job_t*    jobs
+,   u64             job_count
+,   job_counter_t*  counter
+,   job_counter_t*  dependency
+,   bool            fiber
+);
+
+#define job_submit(jobs,job_count,counter) \
+    _job_submit ( (jobs) , (job_count) , (counter) , 0 , false )
+
+#define job_submit_after(jobs,job_count,counter,dependency) \
+    _job_submit ( (jobs) , (job_count) , (counter) , (dependency) , false )
+
+#define job_submit_fiber(jobs,job_count,counter) \
+    _job_submit ( (jobs) , (job_count) , (counter) , 0 , true )
+
+#define job_submit_fiber_after(jobs,job_count,counter,dependency) \
+    _job_submit ( (jobs) , (job_count) , (counter) , (dependency) , true )
+
+/**
+ * @brief Blocks until a counter reaches zero.
+ * 
+ * The calling thread executes pending jobs while it waits, so it is safe to
+ * call from within a job. If called from a job running on a fiber (see
+ * job_submit_fiber), the fiber is suspended instead, and the job resumes once
+ * the counter reaches zero.
+ * 
+ * @param counter The counter to wait on. Must be non-zero.
+ */
+void
+job_wait
+(   job_counter_t* counter
+);
+
+/**
+ * @brief Lets other pending jobs run. If called from a job running on a fiber,
+ * suspends the job and reschedules it behind every other pending job;
+ * otherwise, executes one pending job, if there is one.
+ */
+void
+job_yield
+( void );
+
+/**
+ * @brief Increments a counter on behalf of work which is not a job (e.g. an
+ * asynchronous I/O request), so that job_wait blocks until the work calls
+ * job_counter_release.
+ * 
+ * @param counter The counter to increment. Must be non-zero.
+ * @param amount The amount to increment by.
+ */
+void
+job_counter_add
+(   job_counter_t*  counter
+,   u64             amount
+);
+
+/**
+ * @brief Decrements a counter incremented by job_counter_add, releasing any
+ * jobs which are waiting on it to reach zero. Has the signature of a job
+ * function, so that it may be submitted as a job.
+ * 
+ * @param counter The counter (job_counter_t*) to decrement. Must be non-zero.
+ */
+void
+job_counter_release
+(   void* counter
+);
+
+/**
+ * @brief Queries the number of unfinished jobs tracked by a counter.
+ * 
+ * @param counter The counter to query. Must be non-zero.
+ * @return The number of submitted jobs which have not finished.
+ */
+u64
+job_counter_value
+(   const job_counter_t* counter
+);
+
+#endif  // JOB_H
@@ -7,9 +7,21 @@
 #include "core/assert.h"
 #include "core/logger.h"
 
+#include "container/array.h"
+#include "container/hashtable.h"
 #include "container/string.h"
 
+#include "core/checksum.h"
+#include "core/clock.h"
+#include "core/compress.h"
 #include "core/memory.h"
+#include "core/metrics.h"
+#include "core/profile.h"
+
+#include "math/clamp.h"
+
+#include "platform/lock.h"
+#include "platform/thread.h"
 
 /** @brief Output message prefixes. */
 static const char* log_level_prefixes[] = { LOG_LEVEL_PREFIX_FATAL
@@ -30,18 +42,373 @@ static const char* log_level_colors[] = { LOG_LEVEL_COLOR_FATAL
                                         , LOG_LEVEL_COLOR_TRACE
                                         };
 
+/**
+ * @brief Capacity of the per-thread buffer which messages are formatted into
+ * (see logger_log). Longer messages are formatted into a resizable string.
+ */
+#define LOGGER_MESSAGE_SCRATCH_CAPACITY ( LOGGER_ASYNC_MESSAGE_MAX_LENGTH + 1 )
+
+/**
+ * @brief Upper bound on the number of characters which the prefix, color codes
+ * and line ending add to each output form of a message.
+ */
+#define LOGGER_OUTPUT_OVERHEAD 64
+
+/**
+ * @brief Capacity of the per-thread buffer which the output forms of a
+ * message are written into (see logger_write).
+ */
+#define LOGGER_OUTPUT_SCRATCH_CAPACITY \
+    ( 2 * ( LOGGER_MESSAGE_SCRATCH_CAPACITY + LOGGER_OUTPUT_OVERHEAD ) )
+
+/**
+ * @brief Capacity of the buffer which the output forms of a fatal message are
+ * written into (see logger_fatal).
+ */
+#define LOGGER_FATAL_OUTPUT_CAPACITY                                            \
+    ( COMPRESS_FRAME_HEADER_SIZE                                                \
+    + 2 * ( LOGGER_FATAL_MESSAGE_MAX_LENGTH + 1 + LOGGER_OUTPUT_OVERHEAD )      \
+    )
+
+/** @brief Minimum capacity of the asynchronous logger's ring buffer (in bytes). */
+#define LOGGER_ASYNC_MIN_CAPACITY 256
+
+/** @brief Ring buffer record tags (see record_t). */
+#define LOGGER_RECORD_EMPTY     0           // Reserved, but not yet written.
+#define LOGGER_RECORD_PADDING   0xFFFFFFFF  // Unused space at the end of the ring buffer.
+                                            // Otherwise, the log elevation plus one.
+
+/**
+ * @brief Type definition for a ring buffer record header. The message is
+ * stored directly after the header, and the record is padded to a multiple of
+ * the header size.
+ */
+typedef struct
+{
+    u32 tag;
+    u32 length;
+}
+record_t;
+
+/**
+ * @brief Type definition for asynchronous logger state.
+ * 
+ * Producers reserve space in the ring buffer by advancing tail, write their
+ * record, then publish it by setting its tag. The logger thread reads
+ * published records in order, writes them out in batches, clears the space,
+ * and only then advances head; so every record before head has been written
+ * out (see logger_flush).
+ */
+typedef struct
+{
+    // Read-only after initialization.
+    u64                 capacity;
+    LOG_OVERFLOW_POLICY policy;
+    u64                 memory_requirement;
+    bool                owns_memory;
+    u8*                 buffer;
+    char*               file_batch;
+    char*               console_batch;
+    thread_t            thread;
+    u8                  padding0[ CACHE_LINE_SIZE ];
+
+    // Shared by all producers.
+    u64                 tail;
+    u64                 dropped;
+    u8                  padding1[ CACHE_LINE_SIZE - 2 * sizeof ( u64 ) ];
+
+    // Written by the logger thread only.
+    u64                 head;
+    u32                 head_sequence;  // Incremented whenever head advances.
+    u8                  padding2[ CACHE_LINE_SIZE - sizeof ( u64 ) - sizeof ( u32 ) ];
+
+    // Threads sleeping until head advances (see logger_async_wait_head).
+    u32                 head_waiters;
+
+    // Wakes the logger thread (see logger_async_wake).
+    u32                 wake_sequence;
+    u32                 sleeping;
+    u32                 running;
+    u8                  padding3[ CACHE_LINE_SIZE - 4 * sizeof ( u32 ) ];
+
+    // Private to the logger thread.
+    u64                 reported;
+    u64                 file_batch_length;
+    u64                 console_batch_length;
+    bool                console_batch_err;
+}
+async_t;
+
+/** @brief Binary log file header: magic number ("BLOG") and format version. */
+#define LOGGER_BINARY_MAGIC             0x474F4C42
+#define LOGGER_BINARY_VERSION           1
+
+/** @brief Binary log record tags. Every record begins with a u8 tag. */
+#define LOGGER_BINARY_RECORD_FORMAT     1   // u32 ID, u32 length, null-terminated format string.
+#define LOGGER_BINARY_RECORD_MESSAGE    2   // u8 level, u32 format ID, f64 timestamp, u64 thread ID, u32 argument count, arguments.
+#define LOGGER_BINARY_RECORD_TEXT       3   // u8 level, f64 timestamp, u64 thread ID, u32 length, message.
+
+/** @brief Binary log record header sizes (in bytes, including the tag). */
+#define LOGGER_BINARY_FORMAT_HEADER_SIZE    ( 1 + 4 + 4 )
+#define LOGGER_BINARY_MESSAGE_HEADER_SIZE   ( 1 + 1 + 4 + 8 + 8 + 4 )
+#define LOGGER_BINARY_TEXT_HEADER_SIZE      ( 1 + 1 + 8 + 8 + 4 )
+
+/**
+ * @brief Binary log argument length which marks a null pointer. Arguments
+ * passed by value are recorded as a u64; any other argument is recorded as a
+ * u32 length followed by its contents: the f64, or the string's characters
+ * (followed by a terminator for %s).
+ */
+#define LOGGER_BINARY_NULL              0xFFFFFFFF
+
+/** @brief Initial capacity of the binary log sink's format string table. */
+#define LOGGER_BINARY_FORMAT_CAPACITY   64
+
+/** @brief Type definition for a format string known to the binary log sink. */
+typedef struct
+{
+    u32     id;
+    u32     argument_count;
+    bool    text;   // Formatted when logged (see LOGGER_BINARY_MAX_ARGUMENTS).
+    u8      arguments[ LOGGER_BINARY_MAX_ARGUMENTS ];   // See STRING_FORMAT_ARGUMENT.
+}
+binary_format_t;
+
+/** @brief Type definition for binary log sink state (see logger_binary_startup). */
+typedef struct
+{
+    LOG_LEVEL       level;
+    file_t          file;
+
+    // All fields below are protected by lock.
+    lock_t          lock;
+    hashtable_t*    formats;    // Format string address -> binary_format_t.
+    u32             format_count;
+    u64             length;
+    u8              buffer[ LOGGER_BINARY_BUFFER_CAPACITY ];
+}
+binary_t;
+
+/**
+ * @brief Type definition for a message read back from a binary log (see
+ * logger_binary_decode_record).
+ */
+typedef struct
+{
+    LOG_LEVEL   level;
+    f64         timestamp;
+    u64         thread;
+    const char* message;    // 0 if the record was not a message.
+    u64         length;
+
+    // Resizable string holding the message if it was formatted by the
+    // decoder; 0 otherwise.
+    char*       formatted;
+}
+binary_message_t;
+
+/**
+ * @brief Type definition for per-thread log sink state (see
+ * logger_segment_startup). Each segment is a binary log sink of its own.
+ */
+typedef struct
+{
+    LOG_LEVEL   level;
+    char*       prefix;
+    u64         generation; // See segments_generation.
+
+    // Protected by lock, which is only taken when a thread opens its segment,
+    // and when every segment is flushed.
+    lock_t      lock;
+    binary_t**  segments;   // Indexed by segment number.
+}
+segments_t;
+
+/** @brief Type definition for a log segment being merged (see logger_segment_merge). */
+typedef struct
+{
+    u64                 index;
+    u8*                 data;
+    const u8*           read;
+    const u8*           end;
+    char**              formats;
+
+    // The next message; message.message is 0 once the segment is exhausted.
+    binary_message_t    message;
+}
+segment_cursor_t;
+
+/**
+ * @brief Type definition for buffered console sink state (see
+ * logger_console_startup).
+ * 
+ * Output is appended to the front buffer under the output lock. To write it
+ * out, a thread holding the output lock waits for the back buffer to be
+ * empty, swaps the buffers and wakes the console thread, which writes the
+ * back buffer out without the output lock and then empties it. So buffers
+ * are written out in the order they were filled.
+ */
+typedef struct
+{
+    // Read-only after initialization.
+    u64         flush_interval_ms;
+    bool        terminal[ 2 ];  // Is stdout, stderr attached to a terminal? Y/N
+    thread_t    thread;
+
+    // Protected by the output lock.
+    char*       front;
+    u64         front_length;
+    bool        front_err;      // Stream of the buffered output.
+    f64         front_time;     // When the front buffer's oldest output was appended.
+
+    // Written out by the console thread while back_length is non-zero.
+    char*       back;
+    u64         back_length;
+    bool        back_err;
+
+    // Incremented whenever the back buffer is emptied (see
+    // logger_console_wait).
+    u32         back_sequence;
+
+    // Wakes the console thread.
+    u32         wake_sequence;
+    u32         running;
+
+    char        buffers[ 2 ][ LOGGER_CONSOLE_BUFFER_CAPACITY ];
+}
+console_t;
+
 /** @brief Type definition for logger subsystem state. */
 typedef struct
 {
     file_t      file;
     const char* filepath;
     bool        owns_memory;
+
+    // Buffers log file output, compressing it if requested (see
+    // logger_compress). Protected by the output lock.
+    file_writer_t   writer;
+
+    // Asynchronous mode state (see logger_async_startup).
+    async_t*    async;
+
+    // Binary log sink state (see logger_binary_startup).
+    binary_t*   binary;
+
+    // Per-thread log sink state (see logger_segment_startup).
+    segments_t* segments;
+
+    // Buffered console sink state (see logger_console_startup). Protected by
+    // the output lock.
+    console_t*  console;
 }
 state_t;
 
 /** @brief Global subsystem state. */
 static state_t* state = 0;
 
+/** @brief Runtime log elevation threshold (see logger_level_set). */
+u32 logger_level_threshold = LOG_TRACE;
+
+/**
+ * @brief Serializes log file and console output, so that messages logged
+ * concurrently by different threads are never interleaved. Zero-initialized,
+ * so console output is serialized even before logger_startup.
+ */
+static lock_t output_lock;
+
+/** @brief Does the calling thread hold the output lock? Y/N (see logger_lock). */
+static THREAD_LOCAL bool output_lock_held = false;
+
+/** @brief Is the calling thread the asynchronous logger thread? Y/N */
+static THREAD_LOCAL bool on_logger_thread = false;
+
+/** @brief Is the calling thread the buffered console sink's thread? Y/N */
+static THREAD_LOCAL bool on_console_thread = false;
+
+/**
+ * @brief Does the calling thread hold the binary log sink's lock? Y/N (i.e. an
+ * error occurred while recording a message, and is being logged).
+ */
+static THREAD_LOCAL bool binary_held = false;
+
+/**
+ * @brief Generation of the most recently opened per-thread log sink, so that
+ * a thread can tell whether its segment belongs to the open sink (see
+ * logger_segment_get).
+ */
+static u64 segments_generation = 0;
+
+/**
+ * @brief The calling thread's log segment (0 if it could not be opened), and
+ * the generation of the per-thread log sink it belongs to.
+ */
+static THREAD_LOCAL binary_t* thread_segment = 0;
+static THREAD_LOCAL u64 thread_segment_generation = 0;
+
+/**
+ * @brief Per-thread scratch buffers, so that logging a message never
+ * allocates memory in steady state (see logger_log).
+ */
+static THREAD_LOCAL char message_scratch[ LOGGER_MESSAGE_SCRATCH_CAPACITY ];
+static THREAD_LOCAL char output_scratch[ LOGGER_OUTPUT_SCRATCH_CAPACITY ];
+
+/**
+ * @brief Are the calling thread's scratch buffers in use? Y/N (i.e. a message
+ * is being logged while another one is formatted or written out).
+ */
+static THREAD_LOCAL bool scratch_held = false;
+
+/**
+ * @brief Preallocated buffers for fatal messages (see logger_fatal), so that
+ * reporting a failure never allocates memory. Shared by every thread, and
+ * claimed with fatal_held rather than a lock, so that a thread which fails
+ * while another is writing a fatal message never waits for it.
+ */
+static char fatal_message[ LOGGER_FATAL_MESSAGE_MAX_LENGTH + 1 ];
+static char fatal_output[ LOGGER_FATAL_OUTPUT_CAPACITY ];
+
+/** @brief Are the fatal message buffers in use? Y/N (see logger_fatal_claim). */
+static u32 fatal_held = false;
+
+/**
+ * @brief Acquires the output lock, unless the calling thread already holds it
+ * (i.e. an error occurred while writing a message out, and is being logged).
+ * 
+ * @return true if the lock was acquired (pass to logger_unlock); false
+ * otherwise.
+ */
+static bool
+logger_lock
+( void )
+{
+    if ( output_lock_held )
+    {
+        return false;
+    }
+    lock_acquire ( &output_lock );
+    output_lock_held = true;
+    return true;
+}
+
+/**
+ * @brief Releases the output lock (see logger_lock).
+ * 
+ * @param locked The value returned by the matching call to logger_lock.
+ */
+static void
+logger_unlock
+(   const bool locked
+)
+{
+    if ( !locked )
+    {
+        return;
+    }
+    output_lock_held = false;
+    lock_release ( &output_lock );
+}
+
 /**
  * @brief Primary implementation of print (see print).
  * 
@@ -57,7 +424,8 @@ _print
 );
 
 /**
- * @brief Appends a message to the log file.
+ * @brief Appends a message to the log file. The message is written as-is, so
+ * it must include its line ending.
  * 
  * Use logger_file_append to explicitly specify string length, or 
  * _logger_file_append to compute the length of a null-terminated string before
@@ -75,205 +443,3089 @@ logger_file_append
 #define _logger_file_append(message) \
     logger_file_append ( (message) , _string_length ( message ) )
 
+/**
+ * @brief Writes output to the log file via its buffered writer, which
+ * compresses it if log file compression is enabled (see logger_compress).
+ * Requires the output lock.
+ * 
+ * @param output The output to write. Must be non-zero.
+ * @param size The output size (in bytes).
+ * @return true on success; false otherwise.
+ */
 bool
-logger_startup
-(   const char* filepath
-,   u64*        memory_requirement_
-,   void*       state_
-)
-{
-    if ( state )
-    {
-        LOGERROR ( "logger_startup: Called more than once." );
-        return false;
-    }
+logger_file_write
+(   const char* output
+,   const u64   size
+);
 
-    const u64 memory_requirement = sizeof ( state_t );
+/**
+ * @brief Writes a message to the log file and console on the calling thread.
+ * 
+ * @param level The log elevation.
+ * @param message The formatted message. Must be non-zero.
+ * @param length The message length (in characters).
+ * @param scratch If true, the calling thread's output scratch buffer may be
+ * used to format the output.
+ */
+void
+logger_write
+(   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+,   const bool      scratch
+);
 
-    if ( memory_requirement_ )
-    {
-        *memory_requirement_ = memory_requirement;
-        if ( !state_ )
-        {
-            return true;
-        }
-    }
+/**
+ * @brief Writes console output, through the buffered console sink if it is
+ * open (see logger_console_startup). Requires the output lock.
+ * 
+ * @param err Write to stderr? Y/N (otherwise, stdout)
+ * @param output The output. Must be non-zero.
+ * @param length The output length (in characters).
+ */
+void
+logger_console_write
+(   const bool  err
+,   const char* output
+,   const u64   length
+);
 
-    if ( state_ )
-    {
-        state = state_;
-        ( *state ).owns_memory = false;
-    }
-    else
-    {
-        state = memory_allocate ( memory_requirement , MEMORY_TAG_LOGGER );
-        ( *state ).owns_memory = true;
-    }
-    
-    // Initialize log file.
-    if ( !file_open ( filepath , FILE_MODE_WRITE , &( *state ).file ) )
-    {
-        PRINTERROR ( LOG_LEVEL_COLOR_ERROR LOG_LEVEL_PREFIX_ERROR
-                     "logger_startup: Unable to open log file for writing:  %s."
-                     ANSI_CC_RESET "\n"
-                   , filepath
-                   );
-        return false;
-    }
-    ( *state ).filepath = filepath;
+/**
+ * @brief Hands the front buffer of the buffered console sink to the console
+ * thread to write out, once the back buffer is empty. Requires the output
+ * lock.
+ * 
+ * @param console The buffered console sink state. Must be non-zero.
+ */
+void
+logger_console_swap
+(   console_t* console
+);
 
-    return true;
-}
+/**
+ * @brief Sleeps until the back buffer of the buffered console sink is empty.
+ * 
+ * @param console The buffered console sink state. Must be non-zero.
+ */
+void
+logger_console_wait
+(   console_t* console
+);
 
+/**
+ * @brief Writes out all output buffered by the buffered console sink, and
+ * waits for it to be written.
+ * 
+ * @param console The buffered console sink state. Must be non-zero.
+ */
 void
-logger_shutdown
-( void )
-{
-    if ( !state )
-    {
-        return;
-    }
+logger_console_flush
+(   console_t* console
+);
 
-    // Close log file.
-    file_close ( &( *state ).file );
+/**
+ * @brief Writes out the front buffer of the buffered console sink ahead of a
+ * fatal message, if that can be done without waiting (see logger_fatal).
+ */
+void
+logger_console_flush_fatal
+( void );
 
-    const u64 memory_requirement = sizeof ( state_t );
-    if ( ( *state ).owns_memory )
-    {
-        memory_free ( state , memory_requirement , MEMORY_TAG_LOGGER );
-    }
-    else
-    {
-        memory_clear ( state , memory_requirement );
-    }
+/**
+ * @brief Writes out the output held by the log file's buffered writer ahead
+ * of a fatal message, if that can be done without waiting (see logger_fatal).
+ */
+void
+logger_file_flush_fatal
+( void );
 
-    state = 0;
-}
+/**
+ * @brief Entry point of the buffered console sink's thread.
+ * 
+ * @param args The buffered console sink state.
+ * @return 0.
+ */
+u32
+logger_console_thread
+(   void* args
+);
 
-void
-logger_log
-(   LOG_LEVEL   level
-,   const char* message
-,   args_t      args
+/**
+ * @brief Computes an upper bound on the length of the log file form of a
+ * message (see logger_format_file).
+ * 
+ * @param level The log elevation.
+ * @param length The message length (in characters).
+ * @return An upper bound on the output length (in characters).
+ */
+INLINE
+u64
+logger_file_length
+(   const LOG_LEVEL level
+,   const u64       length
 )
 {
-    const bool err = level < LOG_WARN;
-    const bool colored = level != LOG_INFO;
-
-    char* raw = _string_format ( message , args );
-    char* plaintext = 0;
-    char* formatted = 0;
+    return _string_length ( log_level_prefixes[ level ] ) + length + 1;
+}
 
-    // Write plaintext to log file.
-    if ( state )
+/**
+ * @brief Computes an upper bound on the length of the console form of a
+ * message (see logger_format_console).
+ * 
+ * @param level The log elevation.
+ * @param length The message length (in characters).
+ * @return An upper bound on the output length (in characters); 0 if the
+ * message is not written to the console.
+ */
+INLINE
+u64
+logger_console_length
+(   const LOG_LEVEL level
+,   const u64       length
+)
+{
+    if ( level == LOG_SILENT )
     {
-        plaintext = string_copy ( raw );
-        string_strip_ansi ( plaintext );
-        _string_insert ( plaintext , 0 , log_level_prefixes[ level ] );
-        logger_file_append ( plaintext , string_length ( plaintext ) );
+        return 0;
     }
+    return 3 * ( sizeof ( ANSI_CC_RESET ) - 1 )
+         + _string_length ( log_level_colors[ level ] )
+         + _string_length ( log_level_prefixes[ level ] )
+         + length
+         + 1
+         ;
+}
 
-    if ( level == LOG_SILENT )
+/**
+ * @brief Writes the log file form of a message: the prefix, the message with
+ * any ANSI escape sequences removed, and a line ending.
+ * 
+ * @param dst Output buffer. Must have room for at least logger_file_length
+ * characters.
+ * @param level The log elevation.
+ * @param message The formatted message. Must be non-zero.
+ * @param length The message length (in characters).
+ * @return The number of characters written to dst.
+ */
+u64
+logger_format_file
+(   char*           dst
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+);
+
+/**
+ * @brief Writes the console form of a message: the colored prefix, the
+ * message, and a line ending.
+ * 
+ * @param dst Output buffer. Must have room for at least logger_console_length
+ * characters.
+ * @param level The log elevation. Must not be LOG_SILENT.
+ * @param message The formatted message. Must be non-zero.
+ * @param length The message length (in characters).
+ * @return The number of characters written to dst.
+ */
+u64
+logger_format_console
+(   char*           dst
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+);
+
+/**
+ * @brief Attempts to claim the fatal message buffers. Never waits.
+ * 
+ * @return true if the buffers were claimed (call logger_fatal_release when
+ * done); false if they are already in use.
+ */
+INLINE
+bool
+logger_fatal_claim
+( void )
+{
+    return !atomic_exchange_u32 ( &fatal_held , true , ATOMIC_ACQUIRE );
+}
+
+/** @brief Releases the fatal message buffers (see logger_fatal_claim). */
+INLINE
+void
+logger_fatal_release
+( void )
+{
+    atomic_store_u32 ( &fatal_held , false , ATOMIC_RELEASE );
+}
+
+/**
+ * @brief Primary implementation of logger_fatal (see logger_fatal).
+ * 
+ * @param message The message. Must be non-zero.
+ * @param length The message length (in characters). Must not exceed
+ * LOGGER_FATAL_MESSAGE_MAX_LENGTH.
+ * @param claimed If true, the calling thread holds the fatal message buffers;
+ * otherwise, the message is written in pieces.
+ */
+void
+logger_fatal_write
+(   const char* message
+,   const u64   length
+,   const bool  claimed
+);
+
+/**
+ * @brief Computes the size of the ring buffer record which holds a message.
+ * 
+ * @param length The message length (in characters).
+ * @return The record size (in bytes).
+ */
+INLINE
+u64
+logger_record_size
+(   const u64 length
+)
+{
+    return aligned ( sizeof ( record_t ) + length , sizeof ( record_t ) );
+}
+
+/**
+ * @brief Copies a message into the ring buffer, blocking or discarding it if
+ * the ring buffer is full (see LOG_OVERFLOW_POLICY).
+ * 
+ * @param async The asynchronous logger state. Must be non-zero.
+ * @param level The log elevation.
+ * @param message The formatted message. Must be non-zero.
+ * @param length The message length (in characters). The record must fit into
+ * half of the ring buffer.
+ */
+void
+logger_async_push
+(   async_t*        async
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+);
+
+/**
+ * @brief Wakes the logger thread, if it is sleeping.
+ * 
+ * @param async The asynchronous logger state. Must be non-zero.
+ */
+void
+logger_async_wake
+(   async_t* async
+);
+
+/**
+ * @brief Sleeps until the logger thread has written out every record before a
+ * ring buffer position.
+ * 
+ * @param async The asynchronous logger state. Must be non-zero.
+ * @param position The ring buffer position.
+ */
+void
+logger_async_wait_head
+(   async_t*    async
+,   const u64   position
+);
+
+/**
+ * @brief Entry point of the logger thread.
+ * 
+ * @param args The asynchronous logger state.
+ * @return 0.
+ */
+u32
+logger_async_thread
+(   void* args
+);
+
+/**
+ * @brief Writes out every published record at the head of the ring buffer.
+ * Must only be called by the logger thread.
+ * 
+ * @param async The asynchronous logger state. Must be non-zero.
+ * @return true if any record was read; false otherwise.
+ */
+bool
+logger_async_drain
+(   async_t* async
+);
+
+/**
+ * @brief Writes out both output batches, then advances head. Must only be
+ * called by the logger thread.
+ * 
+ * @param async The asynchronous logger state. Must be non-zero.
+ * @param head The new head position.
+ */
+void
+logger_async_release
+(   async_t*    async
+,   const u64   head
+);
+
+/**
+ * @brief Appends a message to the output batches. Must only be called by the
+ * logger thread.
+ * 
+ * @param async The asynchronous logger state. Must be non-zero.
+ * @param level The log elevation.
+ * @param message The formatted message. Must be non-zero.
+ * @param length The message length (in characters).
+ * @return true on success; false if either batch is too full to hold the
+ * message.
+ */
+bool
+logger_async_batch
+(   async_t*        async
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+);
+
+/**
+ * @brief Writes out and empties both output batches. Must only be called by
+ * the logger thread.
+ * 
+ * @param async The asynchronous logger state. Must be non-zero.
+ */
+void
+logger_async_write
+(   async_t* async
+);
+
+/**
+ * @brief Records a message into the binary log sink, without formatting it
+ * (see logger_binary_startup).
+ * 
+ * @param binary The binary log sink state. Must be non-zero.
+ * @param level The log elevation.
+ * @param message The formatting string. Must be non-zero.
+ * @param args Variadic argument list (see common/args.h).
+ */
+void
+logger_binary_record
+(   binary_t*       binary
+,   const LOG_LEVEL level
+,   const char*     message
+,   args_t          args
+);
+
+/**
+ * @brief Looks up the binary log sink's entry for a format string, recording
+ * the format string the first time it is used. Requires the binary log
+ * sink's lock.
+ * 
+ * @param binary The binary log sink state. Must be non-zero.
+ * @param message The formatting string. Must be non-zero.
+ * @param format Output buffer for the entry.
+ */
+void
+logger_binary_format
+(   binary_t*           binary
+,   const char*         message
+,   binary_format_t*    format
+);
+
+/**
+ * @brief Reserves space for a record in the binary log sink's output buffer,
+ * writing the buffer out first if the record does not fit. Requires the
+ * binary log sink's lock.
+ * 
+ * @param binary The binary log sink state. Must be non-zero.
+ * @param size The record size (in bytes).
+ * @return The reserved space; 0 if the record is larger than the output
+ * buffer, in which case the caller writes it out (see logger_binary_write).
+ */
+u8*
+logger_binary_reserve
+(   binary_t*   binary
+,   const u64   size
+);
+
+/**
+ * @brief Writes out and empties the binary log sink's output buffer. Requires
+ * the binary log sink's lock.
+ * 
+ * @param binary The binary log sink state. Must be non-zero.
+ */
+void
+logger_binary_flush
+(   binary_t* binary
+);
+
+/**
+ * @brief Writes data to the binary log file. Requires the binary log sink's
+ * lock.
+ * 
+ * @param binary The binary log sink state. Must be non-zero.
+ * @param src The data to write. Must be non-zero.
+ * @param size The number of bytes to write.
+ */
+void
+logger_binary_write
+(   binary_t*   binary
+,   const void* src
+,   const u64   size
+);
+
+/**
+ * @brief Writes a field to a binary log record.
+ * 
+ * @param dst Output buffer. Must have room for at least size bytes.
+ * @param src The field. Must be non-zero.
+ * @param size The field size (in bytes).
+ * @return dst, advanced past the field.
+ */
+INLINE
+u8*
+logger_binary_put
+(   u8*         dst
+,   const void* src
+,   const u64   size
+)
+{
+    memory_copy ( dst , src , size );
+    return dst + size;
+}
+
+/**
+ * @brief Reads a binary log record field.
+ * 
+ * @param read Read head. Advanced past the field on success.
+ * @param end End of the binary log.
+ * @param dst Output buffer for the field.
+ * @param size The field size (in bytes).
+ * @return false if the binary log ends before the field; true otherwise.
+ */
+INLINE
+bool
+logger_binary_get
+(   const u8**  read
+,   const u8*   end
+,   void*       dst
+,   const u64   size
+)
+{
+    if ( size > ( u64 )( end - *read ) )
+    {
+        return false;
+    }
+    memory_copy ( dst , *read , size );
+    *read += size;
+    return true;
+}
+
+/**
+ * @brief Computes the number of bytes a binary log record uses to hold an
+ * argument.
+ * 
+ * @param kind The argument kind (see STRING_FORMAT_ARGUMENT).
+ * @param arg The argument.
+ * @return The encoded argument size (in bytes).
+ */
+u64
+logger_binary_argument_size
+(   const u8    kind
+,   const arg_t arg
+);
+
+/**
+ * @brief Writes an argument to a binary log record.
+ * 
+ * @param dst Output buffer. Must have room for logger_binary_argument_size
+ * bytes.
+ * @param kind The argument kind (see STRING_FORMAT_ARGUMENT).
+ * @param arg The argument.
+ * @return dst, advanced past the argument.
+ */
+u8*
+logger_binary_put_argument
+(   u8*         dst
+,   const u8    kind
+,   const arg_t arg
+);
+
+/**
+ * @brief Creates a binary log sink, and writes the binary log file header.
+ * 
+ * Uses dynamic memory allocation (see core/memory.h). Call
+ * logger_binary_destroy to free.
+ * 
+ * @param caller The name of the calling function, for error messages.
+ * @param filepath The filepath to create the binary log file at. Must be a
+ * null-terminated string.
+ * @param level The most severe log elevation to record in binary form.
+ * @return The binary log sink state on success; 0 otherwise.
+ */
+binary_t*
+logger_binary_create
+(   const char*     caller
+,   const char*     filepath
+,   const LOG_LEVEL level
+);
+
+/**
+ * @brief Writes out every buffered record of a binary log sink, closes its
+ * binary log file, and frees it. No thread may record into the sink anymore.
+ * 
+ * @param binary The binary log sink state. Must be non-zero.
+ */
+void
+logger_binary_destroy
+(   binary_t* binary
+);
+
+/**
+ * @brief Reads an entire binary log file, and checks its header.
+ * 
+ * @param caller The name of the calling function, for error messages.
+ * @param filepath The filepath of the binary log file. Must be a
+ * null-terminated string.
+ * @param data Output buffer for the file content. Free with string_free.
+ * @param read Output buffer for the read head, past the header.
+ * @param end Output buffer for the end of the binary log.
+ * @return true on success; false otherwise.
+ */
+bool
+logger_binary_load
+(   const char* caller
+,   const char* filepath
+,   u8**        data
+,   const u8**  read
+,   const u8**  end
+);
+
+/**
+ * @brief Reads a single binary log record (see logger_binary_decode). If it
+ * is a message, the message is rendered.
+ * 
+ * @param read Read head. Advanced past the record on success.
+ * @param end End of the binary log.
+ * @param formats The format strings recorded so far, indexed by ID.
+ * @param message Output buffer for the message; ( *message ).message is 0 if
+ * the record is not a message. The caller destroys ( *message ).formatted.
+ * @return false if the record is malformed; true otherwise.
+ */
+bool
+logger_binary_decode_record
+(   const u8**          read
+,   const u8*           end
+,   char***             formats
+,   binary_message_t*   message
+);
+
+/**
+ * @brief Reads the arguments of a binary log message record, then renders the
+ * message (see logger_binary_decode).
+ * 
+ * @param read Read head. Advanced past the arguments on success.
+ * @param end End of the binary log.
+ * @param format The message's formatting string. Must be non-zero.
+ * @param argument_count The number of arguments recorded.
+ * @param dst Output buffer for the rendered message (a resizable string).
+ * @return false if the arguments are malformed; true otherwise.
+ */
+bool
+logger_binary_decode_message
+(   const u8**  read
+,   const u8*   end
+,   const char* format
+,   const u32   argument_count
+,   char**      dst
+);
+
+/**
+ * @brief Writes a decoded message to a text file (see logger_binary_decode).
+ * 
+ * @param file The text file. Must be non-zero.
+ * @param level The log elevation.
+ * @param timestamp The time the message was logged.
+ * @param thread The ID of the logging thread.
+ * @param message The message. Must be non-zero.
+ * @param length The message length (in characters).
+ * @return true on success; false otherwise.
+ */
+bool
+logger_binary_decode_write
+(   file_t*         file
+,   const LOG_LEVEL level
+,   const f64       timestamp
+,   const u64       thread
+,   const char*     message
+,   const u64       length
+);
+
+/**
+ * @brief Retrieves the calling thread's log segment, opening it the first
+ * time the thread logs to the per-thread log sink (see
+ * logger_segment_startup).
+ * 
+ * @param segments The per-thread log sink state. Must be non-zero.
+ * @return The calling thread's log segment; 0 if it could not be opened.
+ */
+binary_t*
+logger_segment_get
+(   segments_t* segments
+);
+
+/**
+ * @brief Writes out the buffered records of every log segment.
+ * 
+ * @param segments The per-thread log sink state. Must be non-zero.
+ */
+void
+logger_segment_flush
+(   segments_t* segments
+);
+
+/**
+ * @brief Advances a log segment being merged to its next message (see
+ * logger_segment_merge).
+ * 
+ * @param cursor The log segment. Must be non-zero.
+ * @param prefix The filepath prefix of the log segments, for error messages.
+ * @return false if a record is malformed; true otherwise.
+ */
+bool
+logger_segment_advance
+(   segment_cursor_t*   cursor
+,   const char*         prefix
+);
+
+bool
+logger_startup
+(   const char* filepath
+,   u64*        memory_requirement_
+,   void*       state_
+)
+{
+    if ( state )
+    {
+        LOGERROR ( "logger_startup: Called more than once." );
+        return false;
+    }
+
+    const u64 memory_requirement = sizeof ( state_t );
+
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !state_ )
+        {
+            return true;
+        }
+    }
+
+    if ( state_ )
+    {
+        state = state_;
+        ( *state ).owns_memory = false;
+    }
+    else
+    {
+        state = memory_allocate ( memory_requirement , MEMORY_TAG_LOGGER );
+        ( *state ).owns_memory = true;
+    }
+    ( *state ).async = 0;
+    ( *state ).binary = 0;
+    ( *state ).segments = 0;
+    ( *state ).console = 0;
+
+    // Initialize log file.
+    if ( !file_open ( filepath , FILE_MODE_WRITE , &( *state ).file ) )
+    {
+        PRINTERROR ( LOG_LEVEL_COLOR_ERROR LOG_LEVEL_PREFIX_ERROR
+                     "logger_startup: Unable to open log file for writing:  %s."
+                     ANSI_CC_RESET "\n"
+                   , filepath
+                   );
+        return false;
+    }
+    if ( !file_writer_create ( &( *state ).file , &( *state ).writer ) )
+    {
+        file_close ( &( *state ).file );
+        return false;
+    }
+    ( *state ).filepath = filepath;
+
+    return true;
+}
+
+void
+logger_shutdown
+( void )
+{
+    if ( !state )
+    {
+        return;
+    }
+
+    logger_async_shutdown ();
+    logger_binary_shutdown ();
+    logger_segment_shutdown ();
+    logger_console_shutdown ();
+
+    // Close log file.
+    file_writer_destroy ( &( *state ).writer );
+    file_close ( &( *state ).file );
+
+    const u64 memory_requirement = sizeof ( state_t );
+    if ( ( *state ).owns_memory )
+    {
+        memory_free ( state , memory_requirement , MEMORY_TAG_LOGGER );
+    }
+    else
+    {
+        memory_clear ( state , memory_requirement );
+    }
+
+    state = 0;
+}
+
+bool
+logger_async_startup
+(   u64                 capacity
+,   LOG_OVERFLOW_POLICY policy
+,   u64*                memory_requirement_
+,   void*               memory_
+)
+{
+    if ( !state )
+    {
+        LOGERROR ( "logger_async_startup: The logger subsystem is not running." );
+        return false;
+    }
+    if ( ( *state ).async )
+    {
+        LOGERROR ( "logger_async_startup: Called more than once." );
+        return false;
+    }
+    if ( !capacity || policy >= LOG_OVERFLOW_POLICY_COUNT )
+    {
+        if ( !capacity )
+        {
+            LOGERROR ( "logger_async_startup: Value of capacity argument must be non-zero." );
+        }
+        if ( policy >= LOG_OVERFLOW_POLICY_COUNT )
+        {
+            LOGERROR ( "logger_async_startup: Value of policy argument is invalid: %u."
+                     , policy
+                     );
+        }
+        return false;
+    }
+
+    // Round capacity up to a power of two, so positions can be reduced with a
+    // mask.
+    capacity = MAX ( capacity , ( u64 ) LOGGER_ASYNC_MIN_CAPACITY );
+    if ( capacity & ( capacity - 1 ) )
+    {
+        capacity = ( ( u64 ) 1 ) << ( bitscan_reverse ( capacity ) + 1 );
+    }
+
+    const u64 state_memory_requirement = aligned ( sizeof ( async_t ) , CACHE_LINE_SIZE );
+    const u64 memory_requirement = state_memory_requirement
+                                 + capacity
+                                 + 2 * LOGGER_ASYNC_BATCH_CAPACITY
+                                 ;
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_aligned_uninit ( memory_requirement
+                                                , CACHE_LINE_SIZE
+                                                , MEMORY_TAG_LOGGER
+                                                );
+    }
+    memory_clear ( memory , memory_requirement );
+
+    async_t* async = memory;
+    ( *async ).capacity = capacity;
+    ( *async ).policy = policy;
+    ( *async ).memory_requirement = memory_requirement;
+    ( *async ).owns_memory = !memory_;
+    ( *async ).buffer = ( u8* )( ( ( u64 ) memory ) + state_memory_requirement );
+    ( *async ).file_batch = ( char* )( ( *async ).buffer + capacity );
+    ( *async ).console_batch = ( *async ).file_batch + LOGGER_ASYNC_BATCH_CAPACITY;
+    ( *async ).running = true;
+
+    thread_options_t options;
+    memory_clear ( &options , sizeof ( thread_options_t ) );
+    options.name = "logger";
+    if ( !thread_create_ex ( logger_async_thread , async , &options , &( *async ).thread ) )
+    {
+        LOGERROR ( "logger_async_startup: Failed to start the logger thread." );
+        if ( ( *async ).owns_memory )
+        {
+            memory_free_aligned ( memory
+                                , memory_requirement
+                                , CACHE_LINE_SIZE
+                                , MEMORY_TAG_LOGGER
+                                );
+        }
+        return false;
+    }
+
+    atomic_store_ptr ( ( void** ) &( *state ).async , async , ATOMIC_RELEASE );
+    return true;
+}
+
+void
+logger_async_shutdown
+( void )
+{
+    if ( !state || !( *state ).async )
+    {
+        return;
+    }
+    async_t* async = ( *state ).async;
+
+    // Write out the backlog, then stop the logger thread. It is woken
+    // unconditionally, in case it is about to sleep.
+    logger_flush ();
+    atomic_store_u32 ( &( *async ).running , false , ATOMIC_SEQ_CST );
+    atomic_fetch_add_u32 ( &( *async ).wake_sequence , 1 , ATOMIC_SEQ_CST );
+    platform_futex_wake ( &( *async ).wake_sequence , false );
+    thread_wait ( &( *async ).thread );
+    thread_destroy ( &( *async ).thread );
+
+    atomic_store_ptr ( ( void** ) &( *state ).async , 0 , ATOMIC_RELEASE );
+
+    const u64 memory_requirement = ( *async ).memory_requirement;
+    if ( ( *async ).owns_memory )
+    {
+        memory_free_aligned ( async
+                            , memory_requirement
+                            , CACHE_LINE_SIZE
+                            , MEMORY_TAG_LOGGER
+                            );
+    }
+    else
+    {
+        memory_clear ( async , memory_requirement );
+    }
+}
+
+void
+logger_flush
+( void )
+{
+    if ( !state )
+    {
+        return;
+    }
+    const u64 begin = clock_time ();
+
+    async_t* async = atomic_load_ptr ( ( void* const* ) &( *state ).async , ATOMIC_ACQUIRE );
+    if ( async && !on_logger_thread )
+    {
+        logger_async_wait_head ( async , atomic_load_u64 ( &( *async ).tail , ATOMIC_ACQUIRE ) );
+    }
+
+    const bool locked = logger_lock ();
+    if ( !file_writer_flush ( &( *state ).writer ) )
+    {
+        PRINTERROR ( LOG_LEVEL_COLOR_ERROR
+                     "logger_flush: Error writing to log file:  %s"
+                     ANSI_CC_RESET "\n"
+                   , ( *state ).filepath
+                   );
+    }
+    logger_unlock ( locked );
+
+    binary_t* binary = atomic_load_ptr ( ( void* const* ) &( *state ).binary , ATOMIC_ACQUIRE );
+    if ( binary && !binary_held )
+    {
+        lock_acquire ( &( *binary ).lock );
+        binary_held = true;
+        logger_binary_flush ( binary );
+        binary_held = false;
+        lock_release ( &( *binary ).lock );
+    }
+
+    segments_t* segments = atomic_load_ptr ( ( void* const* ) &( *state ).segments , ATOMIC_ACQUIRE );
+    if ( segments && !binary_held )
+    {
+        logger_segment_flush ( segments );
+    }
+
+    if ( ( *state ).console && !on_console_thread )
+    {
+        logger_console_flush ( ( *state ).console );
+    }
+
+    metrics_histogram_record ( METRICS_LOGGER_FLUSH_TIME , clock_time () - begin );
+}
+
+u64
+logger_dropped_count
+( void )
+{
+    if ( !state || !( *state ).async )
+    {
+        return 0;
+    }
+    return atomic_load_u64 ( &( *( *state ).async ).dropped , ATOMIC_RELAXED );
+}
+
+void
+logger_level_set
+(   const LOG_LEVEL level
+)
+{
+    if ( level >= LOG_SILENT )
+    {
+        LOGERROR ( "logger_level_set: Value of level argument must be less than LOG_SILENT (%u), but the value passed is %u."
+                 , LOG_SILENT , level
+                 );
+        return;
+    }
+    atomic_store_u32 ( &logger_level_threshold , level , ATOMIC_RELAXED );
+}
+
+LOG_LEVEL
+logger_level_get
+( void )
+{
+    return atomic_load_u32 ( &logger_level_threshold , ATOMIC_RELAXED );
+}
+
+bool
+logger_compress
+( void )
+{
+    if ( !state )
+    {
+        LOGERROR ( "logger_compress: The logger subsystem is not running." );
+        return false;
+    }
+
+    const bool locked = logger_lock ();
+    bool success = false;
+    if ( ( *state ).writer.frame )
+    {
+        LOGERROR ( "logger_compress: Called more than once." );
+    }
+    else if ( file_position_get ( &( *state ).file ) || ( *state ).writer.length )
+    {
+        LOGERROR ( "logger_compress: The log file has already been written to:  %s."
+                 , ( *state ).filepath
+                 );
+    }
+    else
+    {
+        file_writer_destroy ( &( *state ).writer );
+        success = file_writer_create_compressed ( &( *state ).file
+                                                , &( *state ).writer
+                                                );
+    }
+    logger_unlock ( locked );
+    return success;
+}
+
+bool
+logger_binary_startup
+(   const char*     filepath
+,   const LOG_LEVEL level
+)
+{
+    if ( !state )
+    {
+        LOGERROR ( "logger_binary_startup: The logger subsystem is not running." );
+        return false;
+    }
+    if ( ( *state ).binary )
+    {
+        LOGERROR ( "logger_binary_startup: Called more than once." );
+        return false;
+    }
+    if ( ( *state ).segments )
+    {
+        LOGERROR ( "logger_binary_startup: The per-thread log sink is open (see logger_segment_startup)." );
+        return false;
+    }
+    if ( !filepath || level >= LOG_SILENT )
+    {
+        if ( !filepath )
+        {
+            LOGERROR ( "logger_binary_startup: Missing argument: filepath." );
+        }
+        if ( level >= LOG_SILENT )
+        {
+            LOGERROR ( "logger_binary_startup: Value of level argument must be less than LOG_SILENT (%u), but the value passed is %u."
+                     , LOG_SILENT , level
+                     );
+        }
+        return false;
+    }
+
+    binary_t* binary = logger_binary_create ( "logger_binary_startup" , filepath , level );
+    if ( !binary )
+    {
+        return false;
+    }
+
+    atomic_store_ptr ( ( void** ) &( *state ).binary , binary , ATOMIC_RELEASE );
+    return true;
+}
+
+void
+logger_binary_shutdown
+( void )
+{
+    if ( !state || !( *state ).binary )
+    {
+        return;
+    }
+    binary_t* binary = ( *state ).binary;
+    atomic_store_ptr ( ( void** ) &( *state ).binary , 0 , ATOMIC_RELEASE );
+    logger_binary_destroy ( binary );
+}
+
+bool
+logger_binary_decode
+(   const char* src
+,   const char* dst
+)
+{
+    if ( !src || !dst )
+    {
+        if ( !src )
+        {
+            LOGERROR ( "logger_binary_decode: Missing argument: src (binary log filepath)." );
+        }
+        if ( !dst )
+        {
+            LOGERROR ( "logger_binary_decode: Missing argument: dst (text filepath)." );
+        }
+        return false;
+    }
+
+    u8* data;
+    const u8* read;
+    const u8* end;
+    if ( !logger_binary_load ( "logger_binary_decode" , src , &data , &read , &end ) )
+    {
+        return false;
+    }
+
+    file_t file;
+    if ( !file_open ( dst , FILE_MODE_WRITE , &file ) )
+    {
+        LOGERROR ( "logger_binary_decode: Unable to open text file for writing:  %s."
+                 , dst
+                 );
+        string_free ( data );
+        return false;
+    }
+
+    // Records refer to format strings by ID, and the format strings are
+    // rendered straight from the binary log.
+    char** formats = array_create_new ( char* );
+    bool success = true;
+    while ( success && read < end )
+    {
+        const u8* const record = read;
+        binary_message_t message;
+        success = logger_binary_decode_record ( &read , end , &formats , &message );
+        if ( !success )
+        {
+            LOGERROR ( "logger_binary_decode: Malformed record at offset %u of binary log file:  %s."
+                     , record - data
+                     , src
+                     );
+        }
+        else if ( message.message )
+        {
+            success = logger_binary_decode_write ( &file
+                                                 , message.level
+                                                 , message.timestamp
+                                                 , message.thread
+                                                 , message.message
+                                                 , message.length
+                                                 );
+        }
+        string_destroy ( message.formatted );
+    }
+
+    array_destroy ( formats );
+    file_close ( &file );
+    string_free ( data );
+    return success;
+}
+
+bool
+logger_segment_startup
+(   const char*     prefix
+,   const LOG_LEVEL level
+)
+{
+    if ( !state )
+    {
+        LOGERROR ( "logger_segment_startup: The logger subsystem is not running." );
+        return false;
+    }
+    if ( ( *state ).segments )
+    {
+        LOGERROR ( "logger_segment_startup: Called more than once." );
+        return false;
+    }
+    if ( ( *state ).binary )
+    {
+        LOGERROR ( "logger_segment_startup: The binary log sink is open (see logger_binary_startup)." );
+        return false;
+    }
+    if ( !prefix || level >= LOG_SILENT )
+    {
+        if ( !prefix )
+        {
+            LOGERROR ( "logger_segment_startup: Missing argument: prefix." );
+        }
+        if ( level >= LOG_SILENT )
+        {
+            LOGERROR ( "logger_segment_startup: Value of level argument must be less than LOG_SILENT (%u), but the value passed is %u."
+                     , LOG_SILENT , level
+                     );
+        }
+        return false;
+    }
+
+    // Truncate the segments of a previous run, so that they are not merged
+    // with those of this one (see logger_segment_merge).
+    for ( u64 i = 0; ; ++i )
+    {
+        char* filepath = string_format ( "%s.%u" , prefix , i );
+        file_t file;
+        const bool truncated = file_exists ( filepath , FILE_MODE_READ )
+                            && file_open ( filepath , FILE_MODE_WRITE , &file )
+                            ;
+        string_destroy ( filepath );
+        if ( !truncated )
+        {
+            break;
+        }
+        file_close ( &file );
+    }
+
+    segments_t* segments = memory_allocate ( sizeof ( segments_t ) , MEMORY_TAG_LOGGER );
+    ( *segments ).level = level;
+    ( *segments ).prefix = string_create_from ( prefix );
+    ( *segments ).segments = array_create_new ( binary_t* );
+    segments_generation += 1;
+    ( *segments ).generation = segments_generation;
+
+    atomic_store_ptr ( ( void** ) &( *state ).segments , segments , ATOMIC_RELEASE );
+    return true;
+}
+
+void
+logger_segment_shutdown
+( void )
+{
+    if ( !state || !( *state ).segments )
+    {
+        return;
+    }
+    segments_t* segments = ( *state ).segments;
+    atomic_store_ptr ( ( void** ) &( *state ).segments , 0 , ATOMIC_RELEASE );
+
+    for ( u64 i = 0; i < array_length ( ( *segments ).segments ); ++i )
+    {
+        logger_binary_destroy ( ( *segments ).segments[ i ] );
+    }
+    array_destroy ( ( *segments ).segments );
+    string_destroy ( ( *segments ).prefix );
+    memory_free ( segments , sizeof ( segments_t ) , MEMORY_TAG_LOGGER );
+}
+
+bool
+logger_segment_merge
+(   const char* prefix
+,   const char* dst
+)
+{
+    if ( !prefix || !dst )
+    {
+        if ( !prefix )
+        {
+            LOGERROR ( "logger_segment_merge: Missing argument: prefix." );
+        }
+        if ( !dst )
+        {
+            LOGERROR ( "logger_segment_merge: Missing argument: dst (text filepath)." );
+        }
+        return false;
+    }
+
+    // Read every segment, up to the first which does not exist or is empty
+    // (see logger_segment_startup).
+    segment_cursor_t* cursors = array_create_new ( segment_cursor_t );
+    bool success = true;
+    for ( u64 i = 0; success; ++i )
+    {
+        char* filepath = string_format ( "%s.%u" , prefix , i );
+        file_t file;
+        u64 size = 0;
+        if ( file_exists ( filepath , FILE_MODE_READ ) && file_open ( filepath , FILE_MODE_READ , &file ) )
+        {
+            size = file_size ( &file );
+            file_close ( &file );
+        }
+        if ( !size )
+        {
+            string_destroy ( filepath );
+            break;
+        }
+
+        segment_cursor_t cursor;
+        memory_clear ( &cursor , sizeof ( segment_cursor_t ) );
+        cursor.index = i;
+        success = logger_binary_load ( "logger_segment_merge"
+                                     , filepath
+                                     , &cursor.data
+                                     , &cursor.read
+                                     , &cursor.end
+                                     );
+        string_destroy ( filepath );
+        if ( success )
+        {
+            cursor.formats = array_create_new ( char* );
+            array_push ( cursors , cursor );
+            success = logger_segment_advance ( &cursors[ array_length ( cursors ) - 1 ] , prefix );
+        }
+    }
+    if ( success && !array_length ( cursors ) )
+    {
+        LOGERROR ( "logger_segment_merge: No log segments found at:  %s."
+                 , prefix
+                 );
+        success = false;
+    }
+
+    file_t file;
+    const bool opened = success && file_open ( dst , FILE_MODE_WRITE , &file );
+    if ( success && !opened )
+    {
+        LOGERROR ( "logger_segment_merge: Unable to open text file for writing:  %s."
+                 , dst
+                 );
+        success = false;
+    }
+
+    // Each segment is already in order, so repeatedly writing out the earliest
+    // pending message merges them. Ties go to the lower-numbered segment.
+    while ( success )
+    {
+        segment_cursor_t* next = 0;
+        for ( u64 i = 0; i < array_length ( cursors ); ++i )
+        {
+            segment_cursor_t* cursor = &cursors[ i ];
+            if ( ( *cursor ).message.message
+              && ( !next || ( *cursor ).message.timestamp < ( *next ).message.timestamp )
+               )
+            {
+                next = cursor;
+            }
+        }
+        if ( !next )
+        {
+            break;
+        }
+        success = logger_binary_decode_write ( &file
+                                             , ( *next ).message.level
+                                             , ( *next ).message.timestamp
+                                             , ( *next ).message.thread
+                                             , ( *next ).message.message
+                                             , ( *next ).message.length
+                                             )
+               && logger_segment_advance ( next , prefix )
+               ;
+    }
+
+    for ( u64 i = 0; i < array_length ( cursors ); ++i )
+    {
+        string_destroy ( cursors[ i ].message.formatted );
+        array_destroy ( cursors[ i ].formats );
+        string_free ( cursors[ i ].data );
+    }
+    array_destroy ( cursors );
+    if ( opened )
+    {
+        file_close ( &file );
+    }
+    return success;
+}
+
+bool
+logger_console_startup
+(   const u64 flush_interval_ms
+)
+{
+    if ( !state )
+    {
+        LOGERROR ( "logger_console_startup: The logger subsystem is not running." );
+        return false;
+    }
+    if ( ( *state ).console )
+    {
+        LOGERROR ( "logger_console_startup: Called more than once." );
+        return false;
+    }
+    if ( !flush_interval_ms )
+    {
+        LOGERROR ( "logger_console_startup: Value of flush_interval_ms argument must be non-zero." );
+        return false;
+    }
+
+    console_t* console = memory_allocate ( sizeof ( console_t ) , MEMORY_TAG_LOGGER );
+    ( *console ).flush_interval_ms = flush_interval_ms;
+    file_t file;
+    file_stdout ( &file );
+    ( *console ).terminal[ false ] = file_terminal ( &file );
+    file_stderr ( &file );
+    ( *console ).terminal[ true ] = file_terminal ( &file );
+    ( *console ).front = ( *console ).buffers[ 0 ];
+    ( *console ).back = ( *console ).buffers[ 1 ];
+    ( *console ).running = true;
+
+    thread_options_t options;
+    memory_clear ( &options , sizeof ( thread_options_t ) );
+    options.name = "console";
+    if ( !thread_create_ex ( logger_console_thread , console , &options , &( *console ).thread ) )
+    {
+        LOGERROR ( "logger_console_startup: Failed to start the console thread." );
+        memory_free ( console , sizeof ( console_t ) , MEMORY_TAG_LOGGER );
+        return false;
+    }
+
+    const bool locked = logger_lock ();
+    ( *state ).console = console;
+    logger_unlock ( locked );
+    return true;
+}
+
+void
+logger_console_shutdown
+( void )
+{
+    if ( !state || !( *state ).console )
+    {
+        return;
+    }
+    console_t* console = ( *state ).console;
+
+    // Write out the buffered output, and detach the sink before anything else
+    // is appended; output from here on is written directly.
+    const bool locked = logger_lock ();
+    if ( ( *console ).front_length )
+    {
+        logger_console_swap ( console );
+    }
+    logger_console_wait ( console );
+    ( *state ).console = 0;
+    logger_unlock ( locked );
+
+    // Stop the console thread. It is woken unconditionally, in case it is
+    // about to sleep.
+    atomic_store_u32 ( &( *console ).running , false , ATOMIC_SEQ_CST );
+    atomic_fetch_add_u32 ( &( *console ).wake_sequence , 1 , ATOMIC_SEQ_CST );
+    platform_futex_wake ( &( *console ).wake_sequence , false );
+    thread_wait ( &( *console ).thread );
+    thread_destroy ( &( *console ).thread );
+
+    memory_free ( console , sizeof ( console_t ) , MEMORY_TAG_LOGGER );
+}
+
+u64
+logger_console_pending
+( void )
+{
+    if ( !state )
+    {
+        return 0;
+    }
+    const bool locked = logger_lock ();
+    console_t* console = ( *state ).console;
+    const u64 pending = ( console ) ? ( *console ).front_length
+                                    + atomic_load_u64 ( &( *console ).back_length , ATOMIC_ACQUIRE )
+                                    : 0
+                                    ;
+    logger_unlock ( locked );
+    return pending;
+}
+
+void
+logger_log
+(   LOG_LEVEL   level
+,   const char* message
+,   args_t      args
+)
+{
+    if ( !logger_level_enabled ( level ) )
+    {
+        return;
+    }
+
+    // Fatal messages are formatted into the preallocated buffer, and written
+    // without taking any lock (see logger_fatal).
+    if ( level == LOG_FATAL )
+    {
+        if ( !logger_fatal_claim () )
+        {
+            logger_fatal_write ( message
+                               , MIN ( _string_length ( message )
+                                     , ( u64 ) LOGGER_FATAL_MESSAGE_MAX_LENGTH
+                                     )
+                               , false
+                               );
+            return;
+        }
+        const u64 length = _string_format_to ( fatal_message
+                                             , LOGGER_FATAL_MESSAGE_MAX_LENGTH + 1
+                                             , message
+                                             , args
+                                             );
+        logger_fatal_write ( fatal_message
+                           , MIN ( length , ( u64 ) LOGGER_FATAL_MESSAGE_MAX_LENGTH )
+                           , true
+                           );
+        logger_fatal_release ();
+        return;
+    }
+
+    PROFILE_FUNCTION ();
+
+    // Messages recorded by the binary log sink are never formatted.
+    binary_t* binary = ( state ) ? atomic_load_ptr ( ( void* const* ) &( *state ).binary
+                                                   , ATOMIC_ACQUIRE
+                                                   )
+                                 : 0
+                                 ;
+    if ( binary && !binary_held && ( level == LOG_SILENT || level >= ( *binary ).level ) )
+    {
+        logger_binary_record ( binary , level , message , args );
+        return;
+    }
+    segments_t* segments = ( state ) ? atomic_load_ptr ( ( void* const* ) &( *state ).segments
+                                                       , ATOMIC_ACQUIRE
+                                                       )
+                                     : 0
+                                     ;
+    if ( segments && !binary_held && ( level == LOG_SILENT || level >= ( *segments ).level ) )
+    {
+        binary_t* segment = logger_segment_get ( segments );
+        if ( segment )
+        {
+            logger_binary_record ( segment , level , message , args );
+            return;
+        }
+    }
+
+    // Format into the calling thread's scratch buffer, unless the message is
+    // too long, or the buffer is already in use.
+    const bool scratch = !scratch_held;
+    scratch_held = true;
+    char* raw = 0;
+    u64 length = ( scratch ) ? _string_format_to ( message_scratch
+                                                 , LOGGER_MESSAGE_SCRATCH_CAPACITY
+                                                 , message
+                                                 , args
+                                                 )
+                             : 0
+                             ;
+    if ( !scratch || length >= LOGGER_MESSAGE_SCRATCH_CAPACITY )
+    {
+        raw = _string_format ( message , args );
+        length = string_length ( raw );
+    }
+    const char* text = ( raw ) ? raw : message_scratch;
+
+    // Messages logged by the logger thread, or while writing output, are
+    // written synchronously; waiting on the logger thread could deadlock.
+    async_t* async = ( state ) ? atomic_load_ptr ( ( void* const* ) &( *state ).async
+                                                 , ATOMIC_ACQUIRE
+                                                 )
+                               : 0
+                               ;
+    bool queued = false;
+    if ( async && !on_logger_thread && !output_lock_held )
+    {
+        if ( length <= LOGGER_ASYNC_MESSAGE_MAX_LENGTH
+          && logger_record_size ( length ) <= ( *async ).capacity / 2
+           )
+        {
+            logger_async_push ( async , level , text , length );
+            queued = true;
+        }
+        else
+        {
+            // Otherwise, write synchronously, after every message queued so
+            // far.
+            logger_flush ();
+        }
+    }
+
+    if ( !queued )
+    {
+        logger_write ( level , text , length , scratch );
+    }
+
+    string_destroy ( raw );
+    if ( scratch )
+    {
+        scratch_held = false;
+    }
+}
+
+void
+logger_fatal
+(   const char* message
+,   u64         length
+)
+{
+    if ( !message )
+    {
+        return;
+    }
+    length = MIN ( length , ( u64 ) LOGGER_FATAL_MESSAGE_MAX_LENGTH );
+    const bool claimed = logger_fatal_claim ();
+    logger_fatal_write ( message , length , claimed );
+    if ( claimed )
+    {
+        logger_fatal_release ();
+    }
+}
+
+void
+logger_fatal_write
+(   const char* message
+,   const u64   length
+,   const bool  claimed
+)
+{
+    file_t console;
+    file_stderr ( &console );
+
+    // The log file handle is read without synchronization; at worst, a
+    // message written during logger_shutdown is lost.
+    file_t* file = ( state && ( *state ).file.handle && ( *state ).file.valid )
+                 ? &( *state ).file
+                 : 0
+                 ;
+
+    // A compressed log file receives the message in a stored frame, so that
+    // no buffer is needed to compress it (see logger_compress).
+    const bool compressed = file && ( *state ).writer.frame;
+
+    logger_file_flush_fatal ();
+    logger_console_flush_fatal ();
+
+    if ( claimed )
+    {
+        const u64 header_size = ( compressed ) ? COMPRESS_FRAME_HEADER_SIZE : 0;
+        const u64 file_written = ( file ) ? logger_format_file ( fatal_output + header_size
+                                                               , LOG_FATAL
+                                                               , message
+                                                               , length
+                                                               )
+                                          : 0
+                                          ;
+        char* console_output = fatal_output + header_size + file_written;
+        const u64 console_written = logger_format_console ( console_output
+                                                          , LOG_FATAL
+                                                          , message
+                                                          , length
+                                                          );
+        if ( compressed )
+        {
+            compress_frame_stored ( file_written
+                                  , checksum_crc32c ( fatal_output + header_size
+                                                    , file_written
+                                                    , 0
+                                                    )
+                                  , fatal_output
+                                  );
+        }
+        if ( file )
+        {
+            file_write_raw ( file , header_size + file_written , fatal_output );
+        }
+        file_write_raw ( &console , console_written , console_output );
+        return;
+    }
+
+    // The buffers are in use, so write each piece of both output forms
+    // separately.
+    if ( compressed )
+    {
+        u32 crc = checksum_crc32c ( LOG_LEVEL_PREFIX_FATAL , sizeof ( LOG_LEVEL_PREFIX_FATAL ) - 1 , 0 );
+        crc = checksum_crc32c ( message , length , crc );
+        crc = checksum_crc32c ( "\n" , 1 , crc );
+        u8 header[ COMPRESS_FRAME_HEADER_SIZE ];
+        compress_frame_stored ( sizeof ( LOG_LEVEL_PREFIX_FATAL ) - 1 + length + 1
+                              , crc
+                              , header
+                              );
+        file_write_raw ( file , sizeof ( header ) , header );
+    }
+    if ( file )
+    {
+        file_write_raw ( file , sizeof ( LOG_LEVEL_PREFIX_FATAL ) - 1 , LOG_LEVEL_PREFIX_FATAL );
+        file_write_raw ( file , length , message );
+        file_write_raw ( file , 1 , "\n" );
+    }
+    static const char console_prefix[] = ANSI_CC_RESET LOG_LEVEL_COLOR_FATAL LOG_LEVEL_PREFIX_FATAL;
+    static const char console_suffix[] = ANSI_CC_RESET "\n";
+    file_write_raw ( &console , sizeof ( console_prefix ) - 1 , console_prefix );
+    file_write_raw ( &console , length , message );
+    file_write_raw ( &console , sizeof ( console_suffix ) - 1 , console_suffix );
+}
+
+void
+print
+(   file_t*         file
+,   const char*     message
+,   args_t          args
+)
+{
+    if ( !file || !( *file ).handle || !( *file ).valid )
+    {
+        return;
+    }
+    char* raw = _string_format ( message , args );
+    char* formatted = string_format ( ANSI_CC_RESET"%S"ANSI_CC_RESET  , raw );
+    const bool locked = logger_lock ();
+    _print ( file , formatted , string_length ( formatted ) );
+    logger_unlock ( locked );
+    string_destroy ( raw );
+    string_destroy ( formatted );
+}
+
+void
+assertf
+(   const char* expression
+,   const char* message
+,   const char* file
+,   const i32   line
+)
+{
+    if ( *message == '\0' )
+    {
+        LOGFATAL ( "Assertion failure in file %s (line %i): %s"
+                 , file , line , expression
+                 );
+    }
+    else
+    {
+        LOGFATAL ( "Assertion failure in file %s (line %i): %s\n\tMessage: %s"
+                 , file , line , expression , message
+                 );
+    }
+}
+
+void
+_print
+(   file_t*         file
+,   const char*     string
+,   const u64       string_length
+)
+{
+    // Console output goes through the buffered console sink.
+    file_t console;
+    file_stderr ( &console );
+    const bool err = ( *file ).handle == console.handle;
+    file_stdout ( &console );
+    if ( err || ( *file ).handle == console.handle )
+    {
+        logger_console_write ( err , string , string_length );
+        return;
+    }
+
+    u64 written;
+    file_write ( file
+               , string_length * sizeof ( char )
+               , string
+               , &written
+               );
+}
+
+void
+logger_file_append
+(   const char* message
+,   const u64   message_length
+)
+{
+    if (   !state
+        || !( *state ).file.handle
+        || !( *state ).file.valid
+        || !message
+        || !message_length
+       )
+    {
+        return;
+    }
+    if ( !logger_file_write ( message , message_length ) )
+    {
+        PRINTERROR ( LOG_LEVEL_COLOR_ERROR
+                     "logger_file_append: Error writing to log file:  %s"
+                     ANSI_CC_RESET "\n"
+                   , ( *state ).filepath
+                   );
+    }
+}
+
+bool
+logger_file_write
+(   const char* output
+,   const u64   size
+)
+{
+    return file_writer_write ( &( *state ).writer , size , output );
+}
+
+void
+logger_write
+(   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+,   const bool      scratch
+)
+{
+    const bool err = level < LOG_WARN;
+
+    // Format both output forms up front, so the output lock is only held for
+    // I/O.
+    const u64 file_length = ( state ) ? logger_file_length ( level , length ) : 0;
+    const u64 console_length = logger_console_length ( level , length );
+    const u64 output_size = file_length + console_length;
+    if ( !output_size )
+    {
+        return;
+    }
+    const bool use_scratch = scratch && output_size <= LOGGER_OUTPUT_SCRATCH_CAPACITY;
+    char* output = ( use_scratch ) ? output_scratch
+                                   : memory_allocate_uninit ( output_size , MEMORY_TAG_STRING )
+                                   ;
+    const u64 file_written = ( file_length ) ? logger_format_file ( output
+                                                                  , level
+                                                                  , message
+                                                                  , length
+                                                                  )
+                                             : 0
+                                             ;
+    const u64 console_written = ( console_length ) ? logger_format_console ( output + file_written
+                                                                           , level
+                                                                           , message
+                                                                           , length
+                                                                           )
+                                                   : 0
+                                                   ;
+
+    const bool locked = logger_lock ();
+
+    // Write plaintext to log file.
+    logger_file_append ( output , file_written );
+
+    // Write ANSI-formatted text to console.
+    if ( console_written )
+    {
+        logger_console_write ( err , output + file_written , console_written );
+    }
+
+    logger_unlock ( locked );
+
+    if ( !use_scratch )
+    {
+        memory_free ( output , output_size , MEMORY_TAG_STRING );
+    }
+}
+
+u64
+logger_format_file
+(   char*           dst
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+)
+{
+    char* const start = dst;
+    const u64 prefix_length = _string_length ( log_level_prefixes[ level ] );
+    memory_copy ( dst , log_level_prefixes[ level ] , prefix_length );
+    dst += prefix_length;
+    dst += string_strip_ansi_to ( dst , message , length );
+    *dst = '\n';
+    return dst + 1 - start;
+}
+
+u64
+logger_format_console
+(   char*           dst
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+)
+{
+    const u64 reset_length = sizeof ( ANSI_CC_RESET ) - 1;
+    const u64 color_length = _string_length ( log_level_colors[ level ] );
+    const u64 prefix_length = _string_length ( log_level_prefixes[ level ] );
+    char* const start = dst;
+    memory_copy ( dst , ANSI_CC_RESET , reset_length );
+    dst += reset_length;
+    memory_copy ( dst , log_level_colors[ level ] , color_length );
+    dst += color_length;
+    memory_copy ( dst , log_level_prefixes[ level ] , prefix_length );
+    dst += prefix_length;
+    if ( level == LOG_INFO )
+    {
+        memory_copy ( dst , ANSI_CC_RESET , reset_length );
+        dst += reset_length;
+    }
+    memory_copy ( dst , message , length );
+    dst += length;
+    memory_copy ( dst , ANSI_CC_RESET , reset_length );
+    dst += reset_length;
+    *dst = '\n';
+    return dst + 1 - start;
+}
+
+void
+logger_async_push
+(   async_t*        async
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+)
+{
+    const u64 size = logger_record_size ( length );
+    const u64 mask = ( *async ).capacity - 1;
+
+    // Reserve space. A record never wraps around the end of the ring buffer;
+    // if it does not fit before the end, the remainder is reserved (and
+    // skipped) as padding.
+    u64 position = atomic_load_u64 ( &( *async ).tail , ATOMIC_RELAXED );
+    u64 padding;
+    for (;;)
+    {
+        const u64 contiguous = ( *async ).capacity - ( position & mask );
+        padding = ( contiguous < size ) ? contiguous : 0;
+        const u64 end = position + padding + size;
+
+        // Full?
+        if ( end - atomic_load_u64 ( &( *async ).head , ATOMIC_ACQUIRE ) > ( *async ).capacity )
+        {
+            if ( ( *async ).policy != LOG_OVERFLOW_BLOCK )
+            {
+                atomic_fetch_add_u64 ( &( *async ).dropped , 1 , ATOMIC_RELAXED );
+                metrics_counter_add ( METRICS_LOGGER_DROPPED , 1 );
+                return;
+            }
+            logger_async_wait_head ( async , end - ( *async ).capacity );
+            position = atomic_load_u64 ( &( *async ).tail , ATOMIC_RELAXED );
+            continue;
+        }
+
+        if ( atomic_compare_exchange_u64 ( &( *async ).tail
+                                         , &position
+                                         , end
+                                         , ATOMIC_RELAXED
+                                         , ATOMIC_RELAXED
+                                         ) )
+        {
+            break;
+        }
+    }
+
+    if ( padding )
+    {
+        record_t* record = ( record_t* )( ( *async ).buffer + ( position & mask ) );
+        ( *record ).length = padding - sizeof ( record_t );
+        atomic_store_u32 ( &( *record ).tag , LOGGER_RECORD_PADDING , ATOMIC_RELEASE );
+        position += padding;
+    }
+
+    // Write the record, then publish it to the logger thread.
+    record_t* record = ( record_t* )( ( *async ).buffer + ( position & mask ) );
+    ( *record ).length = length;
+    memory_copy ( record + 1 , message , length );
+    atomic_store_u32 ( &( *record ).tag , level + 1 , ATOMIC_RELEASE );
+
+    logger_async_wake ( async );
+}
+
+void
+logger_async_wake
+(   async_t* async
+)
+{
+    // Pairs with the fence in logger_async_thread: either the logger thread
+    // sees the new record before sleeping, or this thread sees it sleeping.
+    atomic_fence ( ATOMIC_SEQ_CST );
+    if ( atomic_load_u32 ( &( *async ).sleeping , ATOMIC_RELAXED ) )
+    {
+        atomic_fetch_add_u32 ( &( *async ).wake_sequence , 1 , ATOMIC_SEQ_CST );
+        platform_futex_wake ( &( *async ).wake_sequence , false );
+    }
+}
+
+void
+logger_async_wait_head
+(   async_t*    async
+,   const u64   position
+)
+{
+    atomic_fetch_add_u32 ( &( *async ).head_waiters , 1 , ATOMIC_SEQ_CST );
+    for (;;)
+    {
+        // Any advance of head after the sequence number is read changes it,
+        // so the futex refuses to sleep and the wakeup cannot be lost.
+        const u32 sequence = atomic_load_u32 ( &( *async ).head_sequence , ATOMIC_SEQ_CST );
+        if ( atomic_load_u64 ( &( *async ).head , ATOMIC_ACQUIRE ) >= position )
+        {
+            break;
+        }
+        logger_async_wake ( async );
+        platform_futex_wait ( &( *async ).head_sequence , sequence , PLATFORM_FUTEX_WAIT_FOREVER );
+    }
+    atomic_fetch_sub_u32 ( &( *async ).head_waiters , 1 , ATOMIC_SEQ_CST );
+}
+
+u32
+logger_async_thread
+(   void* args
+)
+{
+    async_t* async = args;
+    on_logger_thread = true;
+
+    for (;;)
+    {
+        const u32 sequence = atomic_load_u32 ( &( *async ).wake_sequence , ATOMIC_SEQ_CST );
+        if ( logger_async_drain ( async ) )
+        {
+            continue;
+        }
+        if ( !atomic_load_u32 ( &( *async ).running , ATOMIC_ACQUIRE ) )
+        {
+            break;
+        }
+
+        // Nothing published yet: sleep until a producer publishes a record
+        // (see logger_async_wake) or the logger shuts down.
+        atomic_store_u32 ( &( *async ).sleeping , true , ATOMIC_RELAXED );
+        atomic_fence ( ATOMIC_SEQ_CST );
+        const u64 head = ( *async ).head;
+        const record_t* record = ( record_t* )( ( *async ).buffer + ( head & ( ( *async ).capacity - 1 ) ) );
+        if ( ( head == atomic_load_u64 ( &( *async ).tail , ATOMIC_RELAXED )
+            || atomic_load_u32 ( &( *record ).tag , ATOMIC_RELAXED ) == LOGGER_RECORD_EMPTY
+             )
+          && atomic_load_u32 ( &( *async ).running , ATOMIC_RELAXED )
+           )
+        {
+            platform_futex_wait ( &( *async ).wake_sequence , sequence , PLATFORM_FUTEX_WAIT_FOREVER );
+        }
+        atomic_store_u32 ( &( *async ).sleeping , false , ATOMIC_RELAXED );
+    }
+
+    return 0;
+}
+
+bool
+logger_async_drain
+(   async_t* async
+)
+{
+    const u64 mask = ( *async ).capacity - 1;
+    const u64 tail = atomic_load_u64 ( &( *async ).tail , ATOMIC_ACQUIRE );
+    const u64 start = ( *async ).head;
+    u64 head = start;
+    while ( head != tail )
+    {
+        record_t* record = ( record_t* )( ( *async ).buffer + ( head & mask ) );
+        const u32 tag = atomic_load_u32 ( &( *record ).tag , ATOMIC_ACQUIRE );
+        if ( tag == LOGGER_RECORD_EMPTY )
+        {
+            break;
+        }
+
+        const u64 size = logger_record_size ( ( *record ).length );
+        if ( tag != LOGGER_RECORD_PADDING )
+        {
+            const LOG_LEVEL level = tag - 1;
+            const char* message = ( const char* )( record + 1 );
+            if ( !logger_async_batch ( async , level , message , ( *record ).length ) )
+            {
+                // Batches full: write them out, then retry.
+                logger_async_release ( async , head );
+                logger_async_batch ( async , level , message , ( *record ).length );
+            }
+        }
+
+        // Producers rely on free space being zeroed (see LOGGER_RECORD_EMPTY).
+        memory_clear ( record , size );
+        head += size;
+    }
+
+    if ( head == start )
+    {
+        return false;
+    }
+    logger_async_release ( async , head );
+    return true;
+}
+
+void
+logger_async_release
+(   async_t*    async
+,   const u64   head
+)
+{
+    // Report discarded messages.
+    if ( ( *async ).policy == LOG_OVERFLOW_COUNT )
+    {
+        const u64 dropped = atomic_load_u64 ( &( *async ).dropped , ATOMIC_RELAXED );
+        if ( dropped != ( *async ).reported )
+        {
+            static const char suffix[] = " log message(s) discarded; the log buffer was full.";
+            char report[ 65 + sizeof ( suffix ) ];
+            u64 length = string_u64 ( dropped - ( *async ).reported , 10 , report );
+            memory_copy ( report + length , suffix , sizeof ( suffix ) - 1 );
+            length += sizeof ( suffix ) - 1;
+            if ( logger_async_batch ( async , LOG_WARN , report , length ) )
+            {
+                ( *async ).reported = dropped;
+            }
+        }
+    }
+
+    logger_async_write ( async );
+
+    atomic_store_u64 ( &( *async ).head , head , ATOMIC_RELEASE );
+    atomic_fetch_add_u32 ( &( *async ).head_sequence , 1 , ATOMIC_SEQ_CST );
+    if ( atomic_load_u32 ( &( *async ).head_waiters , ATOMIC_SEQ_CST ) )
+    {
+        platform_futex_wake ( &( *async ).head_sequence , true );
+    }
+}
+
+bool
+logger_async_batch
+(   async_t*        async
+,   const LOG_LEVEL level
+,   const char*     message
+,   const u64       length
+)
+{
+    const bool err = level < LOG_WARN;
+
+    // Console output goes to one stream per batch.
+    if ( level != LOG_SILENT
+      && ( *async ).console_batch_length
+      && ( *async ).console_batch_err != err
+       )
+    {
+        logger_async_write ( async );
+    }
+
+    const u64 file_length = logger_file_length ( level , length );
+    const u64 console_length = logger_console_length ( level , length );
+    if ( file_length > LOGGER_ASYNC_BATCH_CAPACITY - ( *async ).file_batch_length
+      || console_length > LOGGER_ASYNC_BATCH_CAPACITY - ( *async ).console_batch_length
+       )
+    {
+        return false;
+    }
+
+    ( *async ).file_batch_length += logger_format_file ( ( *async ).file_batch + ( *async ).file_batch_length
+                                                       , level
+                                                       , message
+                                                       , length
+                                                       );
+    if ( console_length )
+    {
+        ( *async ).console_batch_length += logger_format_console ( ( *async ).console_batch + ( *async ).console_batch_length
+                                                                 , level
+                                                                 , message
+                                                                 , length
+                                                                 );
+        ( *async ).console_batch_err = err;
+    }
+
+    return true;
+}
+
+void
+logger_async_write
+(   async_t* async
+)
+{
+    const bool locked = logger_lock ();
+
+    if ( ( *async ).file_batch_length
+      && ( *state ).file.handle
+      && ( *state ).file.valid
+      && !( logger_file_write ( ( *async ).file_batch
+                              , ( *async ).file_batch_length
+                              )
+         && file_writer_flush ( &( *state ).writer )
+          )
+       )
+    {
+        PRINTERROR ( LOG_LEVEL_COLOR_ERROR
+                     "logger_async_write: Error writing to log file:  %s"
+                     ANSI_CC_RESET "\n"
+                   , ( *state ).filepath
+                   );
+    }
+
+    if ( ( *async ).console_batch_length )
+    {
+        logger_console_write ( ( *async ).console_batch_err
+                             , ( *async ).console_batch
+                             , ( *async ).console_batch_length
+                             );
+    }
+
+    logger_unlock ( locked );
+
+    ( *async ).file_batch_length = 0;
+    ( *async ).console_batch_length = 0;
+}
+
+void
+logger_binary_record
+(   binary_t*       binary
+,   const LOG_LEVEL level
+,   const char*     message
+,   args_t          args
+)
+{
+    const u8 level_ = level;
+    const f64 timestamp = platform_absolute_time ();
+    const u64 thread = platform_thread_id ();
+    const u32 argument_count = ( args.args ) ? args.arg_count : 0;
+
+    lock_acquire ( &( *binary ).lock );
+    binary_held = true;
+
+    binary_format_t format;
+    logger_binary_format ( binary , message , &format );
+
+    u8* record;
+    u8* dst;
+    u64 size;
+    if ( format.text )
+    {
+        // Fall back to formatting the message now; it may log, so release the
+        // lock while doing so.
+        binary_held = false;
+        lock_release ( &( *binary ).lock );
+        char* text = _string_format ( message , args );
+        const u32 length = string_length ( text );
+        lock_acquire ( &( *binary ).lock );
+        binary_held = true;
+
+        const u8 tag = LOGGER_BINARY_RECORD_TEXT;
+        size = LOGGER_BINARY_TEXT_HEADER_SIZE + length;
+        record = logger_binary_reserve ( binary , size );
+        dst = ( record ) ? record : memory_allocate_uninit ( size , MEMORY_TAG_LOGGER );
+        u8* write = dst;
+        write = logger_binary_put ( write , &tag , sizeof ( tag ) );
+        write = logger_binary_put ( write , &level_ , sizeof ( level_ ) );
+        write = logger_binary_put ( write , &timestamp , sizeof ( timestamp ) );
+        write = logger_binary_put ( write , &thread , sizeof ( thread ) );
+        write = logger_binary_put ( write , &length , sizeof ( length ) );
+        logger_binary_put ( write , text , length );
+        string_destroy ( text );
+    }
+    else
+    {
+        size = LOGGER_BINARY_MESSAGE_HEADER_SIZE;
+        for ( u32 i = 0; i < argument_count; ++i )
+        {
+            const u8 kind = ( i < format.argument_count ) ? format.arguments[ i ]
+                                                          : STRING_FORMAT_ARGUMENT_VALUE
+                                                          ;
+            size += logger_binary_argument_size ( kind , args.args[ i ] );
+        }
+
+        const u8 tag = LOGGER_BINARY_RECORD_MESSAGE;
+        record = logger_binary_reserve ( binary , size );
+        dst = ( record ) ? record : memory_allocate_uninit ( size , MEMORY_TAG_LOGGER );
+        u8* write = dst;
+        write = logger_binary_put ( write , &tag , sizeof ( tag ) );
+        write = logger_binary_put ( write , &level_ , sizeof ( level_ ) );
+        write = logger_binary_put ( write , &format.id , sizeof ( format.id ) );
+        write = logger_binary_put ( write , &timestamp , sizeof ( timestamp ) );
+        write = logger_binary_put ( write , &thread , sizeof ( thread ) );
+        write = logger_binary_put ( write , &argument_count , sizeof ( argument_count ) );
+        for ( u32 i = 0; i < argument_count; ++i )
+        {
+            const u8 kind = ( i < format.argument_count ) ? format.arguments[ i ]
+                                                          : STRING_FORMAT_ARGUMENT_VALUE
+                                                          ;
+            write = logger_binary_put_argument ( write , kind , args.args[ i ] );
+        }
+    }
+
+    // Records too large for the output buffer are written out directly.
+    if ( !record )
+    {
+        logger_binary_write ( binary , dst , size );
+        memory_free ( dst , size , MEMORY_TAG_LOGGER );
+    }
+
+    binary_held = false;
+    lock_release ( &( *binary ).lock );
+}
+
+void
+logger_binary_format
+(   binary_t*           binary
+,   const char*         message
+,   binary_format_t*    format
+)
+{
+    // Format strings are identified by address.
+    if ( _hashtable_get ( ( *binary ).formats , &message , sizeof ( message ) , format ) )
+    {
+        return;
+    }
+
+    const u64 length = _string_length ( message );
+    STRING_FORMAT_ARGUMENT arguments[ LOGGER_BINARY_MAX_ARGUMENTS ];
+    const u64 argument_count = string_format_arguments ( message
+                                                       , length
+                                                       , arguments
+                                                       , LOGGER_BINARY_MAX_ARGUMENTS
+                                                       );
+    ( *format ).text = argument_count > LOGGER_BINARY_MAX_ARGUMENTS;
+    ( *format ).argument_count = MIN ( argument_count , ( u64 ) LOGGER_BINARY_MAX_ARGUMENTS );
+    for ( u32 i = 0; i < ( *format ).argument_count; ++i )
+    {
+        ( *format ).arguments[ i ] = arguments[ i ];
+        if ( arguments[ i ] == STRING_FORMAT_ARGUMENT_CONTAINER )
+        {
+            ( *format ).text = true;
+        }
+    }
+
+    // Record the format string (unless it is only ever recorded as text).
+    ( *format ).id = ( *binary ).format_count;
+    if ( !( *format ).text )
+    {
+        const u8 tag = LOGGER_BINARY_RECORD_FORMAT;
+        const u32 size = length + 1;
+        const u64 record_size = LOGGER_BINARY_FORMAT_HEADER_SIZE + size;
+        u8* record = logger_binary_reserve ( binary , record_size );
+        u8* dst = ( record ) ? record : memory_allocate_uninit ( record_size , MEMORY_TAG_LOGGER );
+        u8* write = dst;
+        write = logger_binary_put ( write , &tag , sizeof ( tag ) );
+        write = logger_binary_put ( write , &( *format ).id , sizeof ( ( *format ).id ) );
+        write = logger_binary_put ( write , &size , sizeof ( size ) );
+        logger_binary_put ( write , message , size );
+        if ( !record )
+        {
+            logger_binary_write ( binary , dst , record_size );
+            memory_free ( dst , record_size , MEMORY_TAG_LOGGER );
+        }
+        ( *binary ).format_count += 1;
+    }
+
+    _hashtable_set ( ( *binary ).formats , &message , sizeof ( message ) , format );
+}
+
+u8*
+logger_binary_reserve
+(   binary_t*   binary
+,   const u64   size
+)
+{
+    if ( size > LOGGER_BINARY_BUFFER_CAPACITY - ( *binary ).length )
+    {
+        logger_binary_flush ( binary );
+    }
+    if ( size > LOGGER_BINARY_BUFFER_CAPACITY )
+    {
+        return 0;
+    }
+    u8* record = ( *binary ).buffer + ( *binary ).length;
+    ( *binary ).length += size;
+    return record;
+}
+
+void
+logger_binary_flush
+(   binary_t* binary
+)
+{
+    if ( !( *binary ).length )
+    {
+        return;
+    }
+    logger_binary_write ( binary , ( *binary ).buffer , ( *binary ).length );
+    ( *binary ).length = 0;
+}
+
+void
+logger_binary_write
+(   binary_t*   binary
+,   const void* src
+,   const u64   size
+)
+{
+    u64 written;
+    if ( !file_write ( &( *binary ).file , size , src , &written ) )
+    {
+        PRINTERROR ( LOG_LEVEL_COLOR_ERROR
+                     "logger_binary_write: Error writing to binary log file."
+                     ANSI_CC_RESET "\n"
+                   );
+    }
+}
+
+u64
+logger_binary_argument_size
+(   const u8    kind
+,   const arg_t arg
+)
+{
+    if ( kind == STRING_FORMAT_ARGUMENT_VALUE )
+    {
+        return sizeof ( arg_t );
+    }
+    if ( !arg )
+    {
+        return sizeof ( u32 );
+    }
+    switch ( kind )
+    {
+        case STRING_FORMAT_ARGUMENT_FLOATING_POINT:   return sizeof ( u32 ) + sizeof ( f64 );
+        case STRING_FORMAT_ARGUMENT_STRING:           return sizeof ( u32 ) + _string_length ( ( const char* ) arg ) + 1;
+        case STRING_FORMAT_ARGUMENT_RESIZABLE_STRING: return sizeof ( u32 ) + string_length ( ( const char* ) arg );
+        case STRING_FORMAT_ARGUMENT_STRING_VIEW:      return sizeof ( u32 ) + ( *( ( const string_view_t* ) arg ) ).length;
+        default:                                      return sizeof ( u32 );
+    }
+}
+
+u8*
+logger_binary_put_argument
+(   u8*         dst
+,   const u8    kind
+,   const arg_t arg
+)
+{
+    if ( kind == STRING_FORMAT_ARGUMENT_VALUE )
     {
-        string_destroy ( raw );
-        string_destroy ( plaintext );
-        return;
+        return logger_binary_put ( dst , &arg , sizeof ( arg ) );
     }
 
-    // Write ANSI-formatted text to console.
-    formatted = string_format ( ANSI_CC_RESET"%s%s%s%S"ANSI_CC_RESET"\n"
-                              , log_level_colors[ level ]
-                              , log_level_prefixes[ level ]
-                              , ( colored ) ? "" : ANSI_CC_RESET
-                              , raw
-                              );
-    file_t file;
-    ( err ) ? file_stderr ( &file )
-            : file_stdout ( &file )
-            ;
-    _print ( &file , formatted , string_length ( formatted ) );
+    u32 length;
+    if ( !arg )
+    {
+        length = LOGGER_BINARY_NULL;
+        return logger_binary_put ( dst , &length , sizeof ( length ) );
+    }
+    switch ( kind )
+    {
+        case STRING_FORMAT_ARGUMENT_FLOATING_POINT:
+        {
+            length = sizeof ( f64 );
+            dst = logger_binary_put ( dst , &length , sizeof ( length ) );
+            return logger_binary_put ( dst , ( const f64* ) arg , sizeof ( f64 ) );
+        }
+        case STRING_FORMAT_ARGUMENT_STRING:
+        {
+            length = _string_length ( ( const char* ) arg );
+            dst = logger_binary_put ( dst , &length , sizeof ( length ) );
+            return logger_binary_put ( dst , ( const char* ) arg , length + 1 );
+        }
+        case STRING_FORMAT_ARGUMENT_RESIZABLE_STRING:
+        {
+            length = string_length ( ( const char* ) arg );
+            dst = logger_binary_put ( dst , &length , sizeof ( length ) );
+            return logger_binary_put ( dst , ( const char* ) arg , length );
+        }
+        case STRING_FORMAT_ARGUMENT_STRING_VIEW:
+        {
+            const string_view_t* view = ( const string_view_t* ) arg;
+            length = ( *view ).length;
+            dst = logger_binary_put ( dst , &length , sizeof ( length ) );
+            return logger_binary_put ( dst , ( *view ).string , length );
+        }
+        default:
+        {
+            length = LOGGER_BINARY_NULL;
+            return logger_binary_put ( dst , &length , sizeof ( length ) );
+        }
+    }
+}
 
-    string_destroy ( raw );
-    string_destroy ( plaintext );
-    string_destroy ( formatted );
+bool
+logger_binary_decode_record
+(   const u8**          read
+,   const u8*           end
+,   char***             formats
+,   binary_message_t*   message
+)
+{
+    ( *message ).message = 0;
+    ( *message ).formatted = 0;
+
+    u8 tag;
+    if ( !logger_binary_get ( read , end , &tag , sizeof ( tag ) ) )
+    {
+        return false;
+    }
+
+    if ( tag == LOGGER_BINARY_RECORD_FORMAT )
+    {
+        u32 id;
+        u32 size;
+        if (   !logger_binary_get ( read , end , &id , sizeof ( id ) )
+            || !logger_binary_get ( read , end , &size , sizeof ( size ) )
+            || id != array_length ( *formats )
+            || !size
+            || size > ( u64 )( end - *read )
+            || ( *read )[ size - 1 ]
+           )
+        {
+            return false;
+        }
+        array_push ( *formats , ( char* ) *read );
+        *read += size;
+        return true;
+    }
+
+    u8 level;
+    f64 timestamp;
+    u64 thread;
+    if ( tag == LOGGER_BINARY_RECORD_MESSAGE )
+    {
+        u32 id;
+        u32 argument_count;
+        if (   !logger_binary_get ( read , end , &level , sizeof ( level ) )
+            || !logger_binary_get ( read , end , &id , sizeof ( id ) )
+            || !logger_binary_get ( read , end , &timestamp , sizeof ( timestamp ) )
+            || !logger_binary_get ( read , end , &thread , sizeof ( thread ) )
+            || !logger_binary_get ( read , end , &argument_count , sizeof ( argument_count ) )
+            || level >= LOG_LEVEL_COUNT
+            || id >= array_length ( *formats )
+           )
+        {
+            return false;
+        }
+        char* formatted;
+        if ( !logger_binary_decode_message ( read
+                                           , end
+                                           , ( *formats )[ id ]
+                                           , argument_count
+                                           , &formatted
+                                           ) )
+        {
+            return false;
+        }
+        ( *message ).level = level;
+        ( *message ).timestamp = timestamp;
+        ( *message ).thread = thread;
+        ( *message ).message = formatted;
+        ( *message ).length = string_length ( formatted );
+        ( *message ).formatted = formatted;
+        return true;
+    }
+
+    if ( tag == LOGGER_BINARY_RECORD_TEXT )
+    {
+        u32 length;
+        if (   !logger_binary_get ( read , end , &level , sizeof ( level ) )
+            || !logger_binary_get ( read , end , &timestamp , sizeof ( timestamp ) )
+            || !logger_binary_get ( read , end , &thread , sizeof ( thread ) )
+            || !logger_binary_get ( read , end , &length , sizeof ( length ) )
+            || level >= LOG_LEVEL_COUNT
+            || length > ( u64 )( end - *read )
+           )
+        {
+            return false;
+        }
+        ( *message ).level = level;
+        ( *message ).timestamp = timestamp;
+        ( *message ).thread = thread;
+        ( *message ).message = ( const char* ) *read;
+        ( *message ).length = length;
+        *read += length;
+        return true;
+    }
+
+    return false;
 }
 
-void
-print
+bool
+logger_binary_decode_message
+(   const u8**  read
+,   const u8*   end
+,   const char* format
+,   const u32   argument_count
+,   char**      dst
+)
+{
+    // Every argument takes at least four bytes.
+    if ( argument_count > ( u64 )( end - *read ) / sizeof ( u32 ) )
+    {
+        return false;
+    }
+
+    STRING_FORMAT_ARGUMENT kinds[ LOGGER_BINARY_MAX_ARGUMENTS ];
+    const u64 kind_count = MIN ( string_format_arguments ( format
+                                                         , _string_length ( format )
+                                                         , kinds
+                                                         , LOGGER_BINARY_MAX_ARGUMENTS
+                                                         )
+                               , ( u64 ) LOGGER_BINARY_MAX_ARGUMENTS
+                               );
+
+    // Floating point and string view arguments are passed by address, so each
+    // is copied into floats or views, and args refers to the copy.
+    const u64 size = argument_count * ( sizeof ( arg_t )
+                                      + sizeof ( f64 )
+                                      + sizeof ( string_view_t )
+                                      );
+    arg_t* values = ( argument_count ) ? memory_allocate ( size , MEMORY_TAG_LOGGER ) : 0;
+    f64* floats = ( f64* )( values + argument_count );
+    string_view_t* views = ( string_view_t* )( floats + argument_count );
+
+    bool valid = true;
+    u32 decoded = 0;
+    while ( valid && decoded < argument_count )
+    {
+        const STRING_FORMAT_ARGUMENT kind = ( decoded < kind_count ) ? kinds[ decoded ]
+                                                                     : STRING_FORMAT_ARGUMENT_VALUE
+                                                                     ;
+        if ( kind == STRING_FORMAT_ARGUMENT_VALUE )
+        {
+            valid = logger_binary_get ( read , end , &values[ decoded ] , sizeof ( arg_t ) );
+            decoded += valid;
+            continue;
+        }
+
+        u32 length;
+        valid = logger_binary_get ( read , end , &length , sizeof ( length ) );
+        if ( !valid || length == LOGGER_BINARY_NULL )
+        {
+            values[ decoded ] = 0;
+            decoded += valid;
+            continue;
+        }
+        switch ( kind )
+        {
+            case STRING_FORMAT_ARGUMENT_FLOATING_POINT:
+            {
+                valid = length == sizeof ( f64 )
+                     && logger_binary_get ( read , end , &floats[ decoded ] , sizeof ( f64 ) )
+                     ;
+                values[ decoded ] = ( arg_t ) &floats[ decoded ];
+                break;
+            }
+            case STRING_FORMAT_ARGUMENT_STRING:
+            {
+                valid = length < ( u64 )( end - *read ) && !( *read )[ length ];
+                values[ decoded ] = ( arg_t ) *read;
+                *read += ( valid ) ? length + 1 : 0;
+                break;
+            }
+            case STRING_FORMAT_ARGUMENT_RESIZABLE_STRING:
+            {
+                valid = length <= ( u64 )( end - *read );
+                values[ decoded ] = ( valid ) ? ( arg_t ) __string_copy ( ( const char* ) *read , length ) : 0;
+                *read += ( valid ) ? length : 0;
+                break;
+            }
+            case STRING_FORMAT_ARGUMENT_STRING_VIEW:
+            {
+                valid = length <= ( u64 )( end - *read );
+                views[ decoded ] = string_view ( ( const char* ) *read , length );
+                values[ decoded ] = ( arg_t ) &views[ decoded ];
+                *read += ( valid ) ? length : 0;
+                break;
+            }
+            default:
+            {
+                valid = false;
+                break;
+            }
+        }
+        decoded += valid;
+    }
+
+    if ( valid )
+    {
+        args_t args;
+        args.arg_count = argument_count;
+        args.args = values;
+        *dst = _string_format ( format , args );
+    }
+
+    // Free any resizable strings created for the arguments.
+    for ( u32 i = 0; i < decoded; ++i )
+    {
+        if ( i < kind_count && kinds[ i ] == STRING_FORMAT_ARGUMENT_RESIZABLE_STRING )
+        {
+            string_destroy ( ( char* ) values[ i ] );
+        }
+    }
+    if ( values )
+    {
+        memory_free ( values , size , MEMORY_TAG_LOGGER );
+    }
+    return valid;
+}
+
+bool
+logger_binary_decode_write
 (   file_t*         file
+,   const LOG_LEVEL level
+,   const f64       timestamp
+,   const u64       thread
 ,   const char*     message
-,   args_t          args
+,   const u64       length
 )
 {
-    if ( !file || !( *file ).handle || !( *file ).valid )
+    // Timestamp and thread ID, then the log file form of the message.
+    char* header = string_format ( "%.6F\t#%u\t" , &timestamp , thread );
+    const u64 header_length = string_length ( header );
+    const u64 size = header_length + logger_file_length ( level , length );
+    char* line = memory_allocate_uninit ( size , MEMORY_TAG_STRING );
+    memory_copy ( line , header , header_length );
+    const u64 line_length = header_length + logger_format_file ( line + header_length
+                                                               , level
+                                                               , message
+                                                               , length
+                                                               );
+    u64 written;
+    const bool success = file_write ( file , line_length , line , &written );
+    if ( !success )
     {
-        return;
+        LOGERROR ( "logger_binary_decode: Error writing to text file." );
     }
-    char* raw = _string_format ( message , args );
-    char* formatted = string_format ( ANSI_CC_RESET"%S"ANSI_CC_RESET  , raw );
-    _print ( file , formatted , string_length ( formatted ) );
-    string_destroy ( raw );
-    string_destroy ( formatted );
+    memory_free ( line , size , MEMORY_TAG_STRING );
+    string_destroy ( header );
+    return success;
+}
+
+binary_t*
+logger_binary_create
+(   const char*     caller
+,   const char*     filepath
+,   const LOG_LEVEL level
+)
+{
+    binary_t* binary = memory_allocate ( sizeof ( binary_t ) , MEMORY_TAG_LOGGER );
+    memory_clear ( binary , sizeof ( binary_t ) );
+    ( *binary ).level = level;
+
+    if ( !file_open ( filepath , FILE_MODE_WRITE , &( *binary ).file ) )
+    {
+        LOGERROR ( "%s: Unable to open binary log file for writing:  %s."
+                 , caller , filepath
+                 );
+        memory_free ( binary , sizeof ( binary_t ) , MEMORY_TAG_LOGGER );
+        return 0;
+    }
+    if ( !hashtable_create ( false
+                           , sizeof ( binary_format_t )
+                           , LOGGER_BINARY_FORMAT_CAPACITY
+                           , 0
+                           , 0
+                           , &( *binary ).formats
+                           ) )
+    {
+        LOGERROR ( "%s: Failed to create the format string table." , caller );
+        file_close ( &( *binary ).file );
+        memory_free ( binary , sizeof ( binary_t ) , MEMORY_TAG_LOGGER );
+        return 0;
+    }
+
+    // Header.
+    const u32 magic = LOGGER_BINARY_MAGIC;
+    const u32 version = LOGGER_BINARY_VERSION;
+    u8* dst = logger_binary_reserve ( binary , sizeof ( magic ) + sizeof ( version ) );
+    dst = logger_binary_put ( dst , &magic , sizeof ( magic ) );
+    logger_binary_put ( dst , &version , sizeof ( version ) );
+
+    return binary;
 }
 
 void
-assertf
-(   const char* expression
-,   const char* message
-,   const char* file
-,   const i32   line
+logger_binary_destroy
+(   binary_t* binary
 )
 {
-    if ( *message == '\0' )
+    lock_acquire ( &( *binary ).lock );
+    binary_held = true;
+    logger_binary_flush ( binary );
+    binary_held = false;
+    lock_release ( &( *binary ).lock );
+
+    file_close ( &( *binary ).file );
+    hashtable_destroy ( &( *binary ).formats );
+    memory_free ( binary , sizeof ( binary_t ) , MEMORY_TAG_LOGGER );
+}
+
+bool
+logger_binary_load
+(   const char* caller
+,   const char* filepath
+,   u8**        data
+,   const u8**  read
+,   const u8**  end
+)
+{
+    // Opening a file creates it if it does not exist, so check first.
+    file_t file;
+    if ( !file_exists ( filepath , FILE_MODE_READ ) || !file_open ( filepath , FILE_MODE_READ , &file ) )
     {
-        LOGFATAL ( "Assertion failure in file %s (line %i): %s"
-                 , file , line , expression
+        LOGERROR ( "%s: Unable to open binary log file for reading:  %s."
+                 , caller , filepath
                  );
+        return false;
     }
-    else
+    u64 size;
+    const bool read_all = file_read_all ( &file , data , &size );
+    file_close ( &file );
+    if ( !read_all )
     {
-        LOGFATAL ( "Assertion failure in file %s (line %i): %s\n\tMessage: %s"
-                 , file , line , expression , message
+        LOGERROR ( "%s: Failed to read binary log file:  %s."
+                 , caller , filepath
                  );
+        return false;
+    }
+
+    *read = *data;
+    *end = *data + size;
+    u32 magic;
+    u32 version;
+    if (   !logger_binary_get ( read , *end , &magic , sizeof ( magic ) )
+        || !logger_binary_get ( read , *end , &version , sizeof ( version ) )
+        || magic != LOGGER_BINARY_MAGIC
+        || version != LOGGER_BINARY_VERSION
+       )
+    {
+        LOGERROR ( "%s: Not a binary log file:  %s."
+                 , caller , filepath
+                 );
+        string_free ( *data );
+        return false;
+    }
+    return true;
+}
+
+binary_t*
+logger_segment_get
+(   segments_t* segments
+)
+{
+    if ( thread_segment_generation == ( *segments ).generation )
+    {
+        return thread_segment;
+    }
+
+    // Messages logged while opening the segment (i.e. errors) are logged as
+    // usual.
+    binary_held = true;
+    lock_acquire ( &( *segments ).lock );
+    char* filepath = string_format ( "%s.%u"
+                                   , ( *segments ).prefix
+                                   , array_length ( ( *segments ).segments )
+                                   );
+    thread_segment = logger_binary_create ( "logger_segment_get" , filepath , ( *segments ).level );
+    if ( thread_segment )
+    {
+        array_push ( ( *segments ).segments , thread_segment );
     }
+    lock_release ( &( *segments ).lock );
+    binary_held = false;
+    string_destroy ( filepath );
+
+    thread_segment_generation = ( *segments ).generation;
+    return thread_segment;
 }
 
 void
-_print
-(   file_t*         file
-,   const char*     string
-,   const u64       string_length
+logger_segment_flush
+(   segments_t* segments
+)
+{
+    lock_acquire ( &( *segments ).lock );
+    binary_held = true;
+    for ( u64 i = 0; i < array_length ( ( *segments ).segments ); ++i )
+    {
+        binary_t* binary = ( *segments ).segments[ i ];
+        lock_acquire ( &( *binary ).lock );
+        logger_binary_flush ( binary );
+        lock_release ( &( *binary ).lock );
+    }
+    binary_held = false;
+    lock_release ( &( *segments ).lock );
+}
+
+bool
+logger_segment_advance
+(   segment_cursor_t*   cursor
+,   const char*         prefix
+)
+{
+    string_destroy ( ( *cursor ).message.formatted );
+    ( *cursor ).message.message = 0;
+    ( *cursor ).message.formatted = 0;
+    while ( ( *cursor ).read < ( *cursor ).end )
+    {
+        const u8* const record = ( *cursor ).read;
+        if ( !logger_binary_decode_record ( &( *cursor ).read
+                                          , ( *cursor ).end
+                                          , &( *cursor ).formats
+                                          , &( *cursor ).message
+                                          ) )
+        {
+            LOGERROR ( "logger_segment_merge: Malformed record at offset %u of log segment:  %s.%u."
+                     , record - ( *cursor ).data
+                     , prefix , ( *cursor ).index
+                     );
+            return false;
+        }
+        if ( ( *cursor ).message.message )
+        {
+            return true;
+        }
+    }
+    return true;
+}
+
+void
+logger_console_write
+(   const bool  err
+,   const char* output
+,   const u64   length
 )
 {
+    console_t* console = ( state ) ? ( *state ).console : 0;
     u64 written;
-    file_write ( file
-               , ( string_length + 1 ) * sizeof ( char )
-               , string
-               , &written
-               );
+    if ( !console || on_console_thread )
+    {
+        file_t file;
+        ( err ) ? file_stderr ( &file )
+                : file_stdout ( &file )
+                ;
+        file_write ( &file , length , output , &written );
+        return;
+    }
+
+    // The front buffer holds output for one stream at a time, so that output
+    // to stdout and stderr stays in order.
+    if ( ( *console ).front_length
+      && ( ( *console ).front_err != err
+        || length > LOGGER_CONSOLE_BUFFER_CAPACITY - ( *console ).front_length
+         ))
+    {
+        logger_console_swap ( console );
+    }
+
+    // Too long to buffer: write it directly, once everything before it has
+    // been written.
+    if ( length > LOGGER_CONSOLE_BUFFER_CAPACITY )
+    {
+        logger_console_wait ( console );
+        file_t file;
+        ( err ) ? file_stderr ( &file )
+                : file_stdout ( &file )
+                ;
+        file_write ( &file , length , output , &written );
+        return;
+    }
+
+    if ( !( *console ).front_length )
+    {
+        ( *console ).front_err = err;
+        ( *console ).front_time = platform_absolute_time ();
+    }
+    memory_copy ( ( *console ).front + ( *console ).front_length , output , length );
+    ( *console ).front_length += length;
+
+    // A terminal shows each line as soon as it ends.
+    if ( ( *console ).terminal[ err ] )
+    {
+        for ( u64 i = 0; i < length; ++i )
+        {
+            if ( output[ i ] == '\n' )
+            {
+                logger_console_swap ( console );
+                break;
+            }
+        }
+    }
 }
 
 void
-logger_file_append
-(   const char* message
-,   const u64   message_length
+logger_console_swap
+(   console_t* console
 )
 {
-    if (   !state
-        || !( *state ).file.handle
-        || !( *state ).file.valid
-        || !message
-        || !message_length
-       )
+    logger_console_wait ( console );
+
+    char* back = ( *console ).back;
+    ( *console ).back = ( *console ).front;
+    ( *console ).back_err = ( *console ).front_err;
+    ( *console ).front = back;
+    atomic_store_u64 ( &( *console ).back_length , ( *console ).front_length , ATOMIC_RELEASE );
+    ( *console ).front_length = 0;
+
+    atomic_fetch_add_u32 ( &( *console ).wake_sequence , 1 , ATOMIC_SEQ_CST );
+    platform_futex_wake ( &( *console ).wake_sequence , false );
+}
+
+void
+logger_console_wait
+(   console_t* console
+)
+{
+    for (;;)
+    {
+        const u32 sequence = atomic_load_u32 ( &( *console ).back_sequence , ATOMIC_ACQUIRE );
+        if ( !atomic_load_u64 ( &( *console ).back_length , ATOMIC_ACQUIRE ) )
+        {
+            return;
+        }
+        platform_futex_wait ( &( *console ).back_sequence , sequence , PLATFORM_FUTEX_WAIT_FOREVER );
+    }
+}
+
+void
+logger_console_flush
+(   console_t* console
+)
+{
+    const bool locked = logger_lock ();
+    if ( ( *console ).front_length )
+    {
+        logger_console_swap ( console );
+    }
+    logger_console_wait ( console );
+    logger_unlock ( locked );
+}
+
+void
+logger_console_flush_fatal
+( void )
+{
+    console_t* console = ( state ) ? ( *state ).console : 0;
+    if ( !console || on_console_thread )
     {
         return;
     }
-    if ( !file_write_line ( &( *state ).file , message_length , message ) )
+
+    // Never wait: not for the output lock, nor for the console thread.
+    const bool locked = !output_lock_held && lock_try_acquire ( &output_lock );
+    if ( !locked && !output_lock_held )
     {
-        PRINTERROR ( LOG_LEVEL_COLOR_ERROR
-                     "logger_file_append: Error writing to log file:  %s"
-                     ANSI_CC_RESET "\n"
-                   , ( *state ).filepath
-                   );
+        return;
+    }
+    output_lock_held = true;
+    if ( ( *console ).front_length && !atomic_load_u64 ( &( *console ).back_length , ATOMIC_ACQUIRE ) )
+    {
+        file_t file;
+        ( ( *console ).front_err ) ? file_stderr ( &file )
+                                   : file_stdout ( &file )
+                                   ;
+        file_write_raw ( &file , ( *console ).front_length , ( *console ).front );
+        ( *console ).front_length = 0;
+    }
+    logger_unlock ( locked );
+}
+
+void
+logger_file_flush_fatal
+( void )
+{
+    if ( !state || !( *state ).writer.length )
+    {
+        return;
+    }
+
+    // Never wait for the output lock.
+    const bool locked = !output_lock_held && lock_try_acquire ( &output_lock );
+    if ( !locked && !output_lock_held )
+    {
+        return;
+    }
+    output_lock_held = true;
+    file_writer_flush ( &( *state ).writer );
+    logger_unlock ( locked );
+}
+
+u32
+logger_console_thread
+(   void* args
+)
+{
+    console_t* console = args;
+    on_console_thread = true;
+
+    const f64 interval = ( *console ).flush_interval_ms / 1000.0;
+    for (;;)
+    {
+        const u32 sequence = atomic_load_u32 ( &( *console ).wake_sequence , ATOMIC_ACQUIRE );
+
+        const u64 length = atomic_load_u64 ( &( *console ).back_length , ATOMIC_ACQUIRE );
+        if ( length )
+        {
+            file_t file;
+            ( ( *console ).back_err ) ? file_stderr ( &file )
+                                      : file_stdout ( &file )
+                                      ;
+            u64 written;
+            file_write ( &file , length , ( *console ).back , &written );
+
+            atomic_store_u64 ( &( *console ).back_length , 0 , ATOMIC_RELEASE );
+            atomic_fetch_add_u32 ( &( *console ).back_sequence , 1 , ATOMIC_SEQ_CST );
+            platform_futex_wake ( &( *console ).back_sequence , true );
+            continue;
+        }
+
+        if ( !atomic_load_u32 ( &( *console ).running , ATOMIC_ACQUIRE ) )
+        {
+            break;
+        }
+
+        // Hand off the front buffer once its oldest output is due. A thread
+        // which holds the output lock may be waiting for this one to empty
+        // the back buffer, so never wait for the lock here; if it is taken,
+        // try again once woken or the interval has passed.
+        if ( lock_try_acquire ( &output_lock ) )
+        {
+            output_lock_held = true;
+            if ( ( *console ).front_length
+              && platform_absolute_time () - ( *console ).front_time >= interval
+               )
+            {
+                logger_console_swap ( console );
+            }
+            output_lock_held = false;
+            lock_release ( &output_lock );
+        }
+
+        platform_futex_wait ( &( *console ).wake_sequence , sequence , ( *console ).flush_interval_ms );
     }
+
+    return 0;
 }
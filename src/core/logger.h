@@ -41,6 +41,38 @@ LOG_LEVEL;
 #define LOG_TRACE_ENABLED 0
 #endif
 
+/**
+ * @brief Least severe log elevation compiled into the current module.
+ * 
+ * Messages less severe than this are removed at compile time: their arguments
+ * are never evaluated, and no code is generated for them. The default keeps
+ * every elevation. To raise it for a single module, define it at the top of
+ * the source file, before any header is included, e.g.:
+ * 
+ *  |  #define LOG_MODULE_LEVEL LOG_INFO
+ *  |  #include "core/job.h"
+ * 
+ * or pass it on the command line for the whole build, e.g.:
+ * 
+ *  |  -DLOG_MODULE_LEVEL=LOG_WARN
+ * 
+ * LOG_FATAL and LOG_ERROR messages are never removed, and LOG_SILENT messages
+ * are only removed by LOG_SILENT_ENABLED.
+ */
+#ifndef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL LOG_TRACE
+#endif
+
+/**
+ * @brief Tests whether a log elevation is compiled into the current module
+ * (see LOG_MODULE_LEVEL). Constant when level is.
+ */
+#define LOG_COMPILED(level)                    \
+    (   ( level ) <= LOG_ERROR                 \
+     || ( level ) == LOG_SILENT                \
+     || ( level ) <= ( LOG_MODULE_LEVEL )      \
+    )
+
 // Defines logger output message prefixes.
 #define LOG_LEVEL_PREFIX_FATAL  "[FATAL]\t" /** @brief Logger output message prefix (LOG_FATAL). */
 #define LOG_LEVEL_PREFIX_ERROR  "[ERROR]\t" /** @brief Logger output message prefix (LOG_ERROR). */
@@ -58,9 +90,58 @@ LOG_LEVEL;
 #define LOG_LEVEL_COLOR_DEBUG      ANSI_CC ( ANSI_CC_FG_GRAY )        /** @brief Logger output message color (LOG_DEBUG). */
 #define LOG_LEVEL_COLOR_TRACE      ANSI_CC ( ANSI_CC_FG_DARK_YELLOW ) /** @brief Logger output message color (LOG_TRACE). */
 
+/**
+ * @brief Type and instance definitions for the action taken when a message is
+ * logged while the asynchronous logger's buffer is full
+ * (see logger_async_startup).
+ */
+typedef enum
+{
+    LOG_OVERFLOW_BLOCK  = 0 /** @brief Wait for the logger thread to free up space. */
+,   LOG_OVERFLOW_DROP   = 1 /** @brief Discard the message. */
+,   LOG_OVERFLOW_COUNT  = 2 /** @brief Discard the message, and log how many were discarded once space frees up. */
+
+,   LOG_OVERFLOW_POLICY_COUNT = 3
+}
+LOG_OVERFLOW_POLICY;
+
+/**
+ * @brief Maximum length of a message which the asynchronous logger queues.
+ * Longer messages are written synchronously, after every queued message.
+ */
+#define LOGGER_ASYNC_MESSAGE_MAX_LENGTH 4096
+
+/** @brief Capacity of each of the asynchronous logger's output batches (in bytes). */
+#define LOGGER_ASYNC_BATCH_CAPACITY     KiB ( 64 )
+
+/** @brief Capacity of the binary log sink's output buffer (in bytes). */
+#define LOGGER_BINARY_BUFFER_CAPACITY   KiB ( 64 )
+
+/** @brief Capacity of each of the buffered console sink's two output buffers (in bytes). */
+#define LOGGER_CONSOLE_BUFFER_CAPACITY  KiB ( 64 )
+
+/**
+ * @brief Maximum number of format specifiers a message may have to be
+ * recorded in binary form. Messages with more are formatted when logged, and
+ * recorded as text.
+ */
+#define LOGGER_BINARY_MAX_ARGUMENTS     32
+
+/**
+ * @brief Maximum length of a fatal message (see logger_fatal). Longer messages
+ * are truncated.
+ */
+#define LOGGER_FATAL_MESSAGE_MAX_LENGTH 4096
+
 /**
  * @brief Initializes the logger subsystem.
  * 
+ * Log file output is collected by a buffered file writer (see
+ * file_writer_create in platform/filesystem.h), and only written out once it
+ * fills, after each asynchronous batch, ahead of a fatal message, or on
+ * logger_flush / logger_shutdown. The writer's buffer always uses dynamic
+ * memory allocation.
+ * 
  * Call logger_shutdown to terminate.
  * 
  * If pre-allocating a memory buffer:
@@ -95,6 +176,353 @@ void
 logger_shutdown
 ( void );
 
+/**
+ * @brief Switches the logger subsystem to asynchronous mode.
+ * 
+ * In asynchronous mode, logger_log only formats the message and copies it
+ * into a lock-free ring buffer. A dedicated logger thread drains the buffer,
+ * and writes the messages to the log file and console in large batches.
+ * Fatal messages, messages which are too long to queue (see
+ * LOGGER_ASYNC_MESSAGE_MAX_LENGTH), and messages logged by the logger thread
+ * itself are written synchronously, after every message queued before them.
+ * 
+ * Requires the logger subsystem to be initialized (see logger_startup). Call
+ * logger_async_shutdown to return to synchronous mode; logger_shutdown does so
+ * automatically.
+ * 
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size. The buffer should be aligned to
+ *   a cache line (see common/atomic.h) to avoid false sharing.
+ * 
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @param capacity The capacity of the ring buffer (in bytes). Rounded up to
+ * the nearest power of two (minimum 256).
+ * @param policy The action to take when a message is logged while the ring
+ * buffer is full.
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required to operate the asynchronous logger. Only applicable if
+ * pre-allocating a memory buffer of the required size. Pass 0 to use implicit
+ * memory allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @return true on success; false otherwise.
+ */
+bool
+logger_async_startup
+(   u64                 capacity
+,   LOG_OVERFLOW_POLICY policy
+,   u64*                memory_requirement
+,   void*               memory
+);
+
+/**
+ * @brief Writes out every queued message, stops the logger thread, and
+ * switches the logger subsystem back to synchronous mode.
+ * 
+ * No other thread may log while this function runs.
+ */
+void
+logger_async_shutdown
+( void );
+
+/**
+ * @brief Blocks until every message queued before the call has been written
+ * out, then writes out any output buffered for the log file (see
+ * logger_startup), any records buffered by the binary log sink
+ * (see logger_binary_startup) or by any thread's log segment
+ * (see logger_segment_startup), and any output buffered by the buffered
+ * console sink (see logger_console_startup).
+ */
+void
+logger_flush
+( void );
+
+/**
+ * @brief Opens a buffered console sink.
+ * 
+ * While the buffered console sink is open, console output (of logger_log and
+ * of print, PRINT and PRINTERROR) is appended to an output buffer instead of
+ * being written right away, so that a burst of messages costs a single write.
+ * The buffer is written out:
+ *   - As soon as it ends a line, if its stream is attached to a terminal (see
+ *     file_terminal), so that an interactive console still shows each line
+ *     as it is logged.
+ *   - Once it is full, or the output switches between stdout and stderr (so
+ *     the two streams stay in order).
+ *   - Once its oldest output has waited for flush_interval_ms; a console
+ *     thread checks every flush_interval_ms, so output waits at most about
+ *     twice that long.
+ *   - By logger_flush, by logger_console_shutdown, and before a fatal message
+ *     is written (see logger_fatal), unless another thread is writing console
+ *     output out at that moment.
+ * 
+ * The sink is double-buffered: the console thread writes one buffer out while
+ * output is appended to the other, so logging only waits for a write once
+ * both are full. Output too long to buffer is written directly, after
+ * everything buffered before it.
+ * 
+ * Requires the logger subsystem to be initialized (see logger_startup). Call
+ * logger_console_shutdown to close the sink; logger_shutdown does so
+ * automatically. Must not be called while other threads are logging.
+ * 
+ * Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @param flush_interval_ms The longest that output may wait in the buffer
+ * when its stream is not attached to a terminal (in milliseconds). Must be
+ * non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+logger_console_startup
+(   const u64 flush_interval_ms
+);
+
+/**
+ * @brief Writes out all buffered console output, stops the console thread,
+ * and closes the buffered console sink. Must not be called while other
+ * threads are logging.
+ */
+void
+logger_console_shutdown
+( void );
+
+/**
+ * @brief Queries the amount of console output which the buffered console
+ * sink has yet to write out (see logger_console_startup).
+ * 
+ * @return The number of characters buffered; 0 if the sink is not open.
+ */
+u64
+logger_console_pending
+( void );
+
+/**
+ * @brief Queries the number of messages which the asynchronous logger has
+ * discarded because its ring buffer was full (see LOG_OVERFLOW_POLICY).
+ * 
+ * @return The number of discarded messages since logger_async_startup.
+ */
+u64
+logger_dropped_count
+( void );
+
+/**
+ * @brief Compresses the log file from here on (see core/compress.h).
+ * 
+ * Log file output is written as a sequence of compressed frames instead of
+ * text: one each time the log file's buffered writer is written out (see
+ * logger_startup). Each frame is self-contained and checksummed, so a log file
+ * cut short by a crash remains readable up to its last complete frame. Fatal messages are stored as-is in
+ * their own frame, so they are written without allocating memory. Read the
+ * file back with a compressed reader (see file_reader_create_compressed in
+ * platform/filesystem.h). Console output is unaffected.
+ * 
+ * Requires the logger subsystem to be initialized (see logger_startup), and
+ * nothing to have been written to the log file yet. Compression stays enabled
+ * until logger_shutdown.
+ * 
+ * Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @return true on success; false otherwise.
+ */
+bool
+logger_compress
+( void );
+
+/**
+ * @brief Opens a binary log sink.
+ * 
+ * While the binary sink is open, messages at the given log elevation or less
+ * severe (and LOG_SILENT messages) are not formatted at all. Instead, each is
+ * recorded into the binary log file as a format string ID, a timestamp (see
+ * platform_absolute_time), the ID of the logging thread and the raw argument
+ * list; the contents of string and floating point arguments are copied in.
+ * Each format string is recorded once, the first time it is used. These
+ * messages are written neither to the log file nor to the console; use
+ * logger_binary_decode to render them offline. More severe messages are
+ * logged as usual.
+ * 
+ * Messages which use the array or queue format modifiers, or which have more
+ * than LOGGER_BINARY_MAX_ARGUMENTS format specifiers, are formatted when
+ * logged, and recorded as text.
+ * 
+ * Requires the logger subsystem to be initialized (see logger_startup), and
+ * the per-thread log sink to be closed (see logger_segment_startup). Call
+ * logger_binary_shutdown to close the binary sink; logger_shutdown does so
+ * automatically. Must not be called while other threads are logging.
+ * 
+ * Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @param filepath The filepath to create the binary log file at. Must be a
+ * null-terminated string.
+ * @param level The most severe log elevation to record in binary form. Must
+ * be less than LOG_SILENT.
+ * @return true on success; false otherwise.
+ */
+bool
+logger_binary_startup
+(   const char*     filepath
+,   const LOG_LEVEL level
+);
+
+/**
+ * @brief Writes out every buffered record and closes the binary log sink.
+ * Must not be called while other threads are logging.
+ */
+void
+logger_binary_shutdown
+( void );
+
+/**
+ * @brief Renders a binary log file (see logger_binary_startup) as text, one
+ * line per message: the timestamp, the thread ID, and the message as it
+ * would have been written to the log file.
+ * 
+ * Formats each message with the same engine as logger_log
+ * (see container/string/format.h). Does not require the logger subsystem to
+ * be initialized.
+ * 
+ * Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @param src The filepath of the binary log file. Must be a null-terminated
+ * string.
+ * @param dst The filepath to create the text file at. Must be a
+ * null-terminated string.
+ * @return true on success; false if either file could not be opened, or the
+ * binary log file is malformed.
+ */
+bool
+logger_binary_decode
+(   const char* src
+,   const char* dst
+);
+
+/**
+ * @brief Opens a per-thread log sink.
+ * 
+ * Like the binary log sink (see logger_binary_startup), except that each
+ * thread records its messages into a binary log file of its own (a segment)
+ * through an output buffer of its own, so that threads logging concurrently
+ * never contend with one another. A thread opens its segment the first time
+ * it logs a message which the sink records; segments are numbered in that
+ * order, and created at prefix.0, prefix.1, and so on.
+ * 
+ * Each segment is an ordinary binary log file (see logger_binary_decode).
+ * Its messages are in the order they were logged, so a message's position in
+ * its segment is its sequence number within its thread, and each carries a
+ * timestamp from the monotonic clock (see platform_absolute_time). Use
+ * logger_segment_merge to render every segment as a single, time-ordered
+ * text file.
+ * 
+ * Segment files left at prefix by a previous run are truncated.
+ * 
+ * Requires the logger subsystem to be initialized (see logger_startup), and
+ * the binary log sink to be closed. Call logger_segment_shutdown to close the
+ * sink; logger_shutdown does so automatically. Must not be called while other
+ * threads are logging.
+ * 
+ * Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @param prefix The filepath prefix of the segment files. Must be a
+ * null-terminated string.
+ * @param level The most severe log elevation to record in binary form. Must
+ * be less than LOG_SILENT.
+ * @return true on success; false otherwise.
+ */
+bool
+logger_segment_startup
+(   const char*     prefix
+,   const LOG_LEVEL level
+);
+
+/**
+ * @brief Writes out the buffered records of every thread's log segment and
+ * closes the per-thread log sink. Must not be called while other threads are
+ * logging.
+ */
+void
+logger_segment_shutdown
+( void );
+
+/**
+ * @brief Renders the segments written by a per-thread log sink
+ * (see logger_segment_startup) as a single text file, in the format of
+ * logger_binary_decode, with the messages of every thread in order of their
+ * timestamps. The messages of each thread stay in the order they were
+ * logged; messages of different threads with equal timestamps are written in
+ * segment order.
+ * 
+ * Each segment is read into memory, then the segments are merged in a single
+ * pass. Does not require the logger subsystem to be initialized.
+ * 
+ * Uses dynamic memory allocation (see core/memory.h).
+ * 
+ * @param prefix The filepath prefix of the segment files. Must be a
+ * null-terminated string.
+ * @param dst The filepath to create the text file at. Must be a
+ * null-terminated string.
+ * @return true on success; false if there is no segment at prefix, a segment
+ * is malformed, or the text file could not be written.
+ */
+bool
+logger_segment_merge
+(   const char* prefix
+,   const char* dst
+);
+
+/**
+ * @brief Runtime log elevation threshold. Do not access directly; use
+ * logger_level_set and logger_level_get.
+ */
+extern u32 logger_level_threshold;
+
+/**
+ * @brief Sets the least severe log elevation which is logged at runtime.
+ * Messages less severe than this are discarded before their arguments are
+ * evaluated. LOG_FATAL and LOG_ERROR messages are always logged, as are
+ * LOG_SILENT messages. Defaults to LOG_TRACE (log everything).
+ * 
+ * Thread-safe.
+ * 
+ * @param level The new threshold. Must be less than LOG_SILENT.
+ */
+void
+logger_level_set
+(   const LOG_LEVEL level
+);
+
+/**
+ * @brief Queries the least severe log elevation which is logged at runtime
+ * (see logger_level_set).
+ * 
+ * @return The runtime log elevation threshold.
+ */
+LOG_LEVEL
+logger_level_get
+( void );
+
+/**
+ * @brief Tests whether a message at a given log elevation would be logged,
+ * both at compile time (see LOG_MODULE_LEVEL) and at runtime (see
+ * logger_level_set). For a constant level, this is a single comparison.
+ * 
+ * @param level The log elevation.
+ * @return true if a message at the given elevation is logged; false otherwise.
+ */
+#define logger_level_enabled(level)                                               \
+    (   LOG_COMPILED ( level )                                                    \
+     && (   ( level ) <= LOG_ERROR                                                \
+         || ( level ) == LOG_SILENT                                               \
+         || ( i32 )( level ) <= ( i32 ) atomic_load_u32 ( &logger_level_threshold \
+                                                        , ATOMIC_RELAXED          \
+                                                        )                         \
+        )                                                                         \
+    )
+
 /**
  * @brief Logs a message according to the logging elevation protocol.
  * 
@@ -109,14 +537,55 @@ logger_log
 ,   args_t      args
 );
 
-/** @brief Alias for calling logger_log with __VA_ARGS__. */
-#define LOG(level,message,...)                                     \
-    do                                                             \
-    {                                                              \
-        DISABLE_WARNING ( -Wint-conversion )                       \
-        logger_log ( (level) , (message) , ARGS ( __VA_ARGS__ ) ); \
-        REENABLE_WARNING ()                                        \
-    }                                                              \
+/**
+ * @brief Writes a fatal error message straight to the log file and the
+ * console (stderr), without formatting it, allocating memory or taking any
+ * lock.
+ * 
+ * This is the path every LOG_FATAL message takes (see logger_log), so that
+ * reporting a failure can never deadlock on, or wait for, a lock which the
+ * failing thread (or another one) already holds: the message is written into
+ * a preallocated buffer, and both output forms are passed to the host
+ * platform's write system call (see file_write_raw). It is async-signal-safe,
+ * so it may also be called directly from a signal handler.
+ * 
+ * Messages which the asynchronous logger has queued but not yet written are
+ * not flushed first, and the binary log sink (if any) does not record the
+ * message. If the buffer is already in use (i.e. another thread is writing a
+ * fatal message, or a signal interrupted one), the message is written in
+ * pieces, without ANSI escape sequences being removed from the log file form.
+ * 
+ * Use logger_fatal to explicitly specify message length, or _logger_fatal to
+ * compute the length of a null-terminated message.
+ * 
+ * @param message The message (not formatted). Must be non-zero.
+ * @param length The message length (in characters). Truncated to
+ * LOGGER_FATAL_MESSAGE_MAX_LENGTH.
+ */
+void
+logger_fatal
+(   const char* message
+,   u64         length
+);
+
+#define _logger_fatal(message) \
+    logger_fatal ( (message) , _string_length ( message ) )
+
+/**
+ * @brief Alias for calling logger_log with __VA_ARGS__. The arguments are
+ * only evaluated, and the message only formatted, if the message is logged
+ * (see logger_level_enabled).
+ */
+#define LOG(level,message,...)                                         \
+    do                                                                 \
+    {                                                                  \
+        if ( logger_level_enabled ( level ) )                          \
+        {                                                              \
+            DISABLE_WARNING ( -Wint-conversion )                       \
+            logger_log ( (level) , (message) , ARGS ( __VA_ARGS__ ) ); \
+            REENABLE_WARNING ()                                        \
+        }                                                              \
+    }                                                                  \
     while ( 0 )
 
 // LOG: Fatal.
@@ -190,7 +659,9 @@ logger_log
 /**
  * @brief Writes a formatted message to file.
  * 
- * Use PRINT to print to stdout, use PRINTERROR to print to stderr.
+ * Use PRINT to print to stdout, use PRINTERROR to print to stderr. Output to
+ * either goes through the buffered console sink, if it is open (see
+ * logger_console_startup).
  * 
  * @param file The file to print to.
  * @param message Formatted message to print to file 
@@ -9,13 +9,32 @@
 #include "container/string.h"
 
 #include "core/logger.h"
+#include "core/metrics.h"
+#include "core/profile.h"
 
 #include "math/clamp.h"
 
 #include "memory/dynamic_allocator.h"
 
 #include "platform/platform.h"
-#include "platform/mutex.h"
+#include "platform/lock.h"
+
+#if PLATFORM_SIMD_AVX2
+    #include <immintrin.h>
+#elif PLATFORM_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if MEMORY_PROFILE_ENABLED == 1
+// The call-site macros (see core/memory.h) would otherwise expand within the
+// definitions below.
+#undef memory_allocate
+#undef memory_allocate_aligned
+#undef memory_allocate_uninit
+#undef memory_allocate_aligned_uninit
+#undef memory_reallocate
+#undef memory_reallocate_aligned
+#endif
 
 /** @brief Memory tag strings. */
 static const char* memory_tags[ MEMORY_TAG_COUNT ] = { "UNKNOWN"
@@ -26,10 +45,14 @@ static const char* memory_tags[ MEMORY_TAG_COUNT ] = { "UNKNOWN"
                                                      , "FREELIST"
                                                      , "LINEAR_ALLOCATOR"
                                                      , "DYNAMIC_ALLOCATOR"
+                                                     , "ARENA"
+                                                     , "POOL_ALLOCATOR"
                                                      , "THREAD"
+                                                     , "JOB"
                                                      , "MUTEX"
                                                      , "FILE"
                                                      , "LOGGER"
+                                                     , "METRICS"
                                                      , "APPLICATION"
                                                      };
 
@@ -37,35 +60,972 @@ static const char* memory_tags[ MEMORY_TAG_COUNT ] = { "UNKNOWN"
 #define MEMORY_TAG_MAX_STRING_LENGTH_STRING "18"
 // _string_length ( memory_tags[ MEMORY_TAG_DYNAMIC_ALLOCATOR ] ) + 1
 
-/** @brief Type definition for a container to hold global statistics. */
+/**
+ * @brief Type definition for a container to hold global statistics. Shares a
+ * layout with statistics scopes (see memory_stat_scope_set).
+ */
+typedef memory_stat_scope_t stat_t;
+
+/** @brief Number of statistics shards (see memory_stat_shard). */
+#define MEMORY_STAT_SHARD_COUNT 16
+
+/** @brief Padding which rounds a statistics shard up to a whole number of cache lines. */
+#define MEMORY_STAT_SHARD_PADDING \
+    ( CACHE_LINE_SIZE - sizeof ( stat_t ) % CACHE_LINE_SIZE )
+
+/**
+ * @brief Type definition for a statistics shard. Each thread updates only its
+ * own shard, so concurrent allocations on different threads do not contend
+ * for the same counters (or cache lines).
+ */
+typedef struct
+{
+    stat_t  stat;
+    u8      padding[ MEMORY_STAT_SHARD_PADDING ];
+}
+stat_shard_t;
+
+#if MEMORY_PROFILE_ENABLED == 1
+
+/** @brief Number of allocation size histogram buckets: one per power of two. */
+#define MEMORY_PROFILE_BUCKET_COUNT 64
+
+/** @brief Capacity of the call-site table (must be a power of two). */
+#define MEMORY_PROFILE_SITE_CAPACITY 1024
+
+/** @brief Number of call sites listed by memory_stat. */
+#define MEMORY_PROFILE_SITE_REPORT_COUNT 16
+
+/** @brief Type definition for an allocation call site. */
+typedef struct
+{
+    u64         key;        // 0 if the slot is empty (see memory_profile_key).
+    const char* file;       // Published after line; 0 until then.
+    u64         line;
+    u64         count;
+    u64         bytes;
+}
+site_t;
+
+/** @brief Type definition for a container to hold allocation profiler statistics. */
 typedef struct
 {
-    u64     allocation_count;
-    u64     free_count;
-
-    u64     allocated;
-    u64     tagged_allocations[ MEMORY_TAG_COUNT ];
+    u64     live[ MEMORY_TAG_COUNT + 1 ];   // Indexed by tag; MEMORY_TAG_ALL for the total.
+    u64     peak[ MEMORY_TAG_COUNT + 1 ];
+    u64     buckets[ MEMORY_PROFILE_BUCKET_COUNT ];
+    site_t  sites[ MEMORY_PROFILE_SITE_CAPACITY ];
+    u64     sites_dropped;                  // Allocations from sites which did not fit.
+}
+profile_t;
+
+#endif  // MEMORY_PROFILE_ENABLED
+
+/** @brief Maximum number of NUMA nodes given a heap of their own. */
+#define MEMORY_NODE_MAX 8U
+
+/**
+ * @brief Type definition for a heap: the region of the sandbox given to a
+ * single NUMA node, managed by an allocator (and lock) of its own.
+ */
+typedef struct
+{
+    dynamic_allocator_t*    allocator;
+
+    void*                   memory;     // Start of the region.
+    u64                     reserved;   // Size of the region.
+    u64                     committed;  // Bytes committed from its start.
+    u32                     node;
+
+    lock_t                  allocation_lock;
+}
+heap_t;
+
+/** @brief Type definition for memory subsystem state. */
+typedef struct
+{
+    bool                    initialized;
+
+#if MEMORY_STAT_ENABLED == 1
+    stat_shard_t            stat[ MEMORY_STAT_SHARD_COUNT ];
+#endif
+
+#if MEMORY_PROFILE_ENABLED == 1
+    profile_t               profile;
+#endif
+
+    heap_t                  heaps[ MEMORY_NODE_MAX ];
+    u32                     heap_count;
+
+    u64                     capacity;
+    u64                     reserved;   // Size of the sandbox address space.
+    u64                     page_size;
+}
+state_t;
+
+/** @brief Memory subsystem state. */
+static state_t* state = 0;
+
+/**
+ * @brief Memory subsystem lifetime counter (incremented by each successful
+ * memory_startup). Any per-thread allocation cache tagged with a different
+ * value refers to a sandbox which no longer exists.
+ */
+static u64 generation = 0;
+
+/** @brief Heap index (see memory_heap_local) of the calling thread. */
+static THREAD_LOCAL u32 thread_heap = 0;
+
+/** @brief Memory subsystem lifetime in which thread_heap was assigned. */
+static THREAD_LOCAL u64 thread_heap_generation = 0;
+
+/**
+ * @brief Does the calling thread hold an allocation lock? Y/N
+ * 
+ * The allocation lock is not recursive. Anything logged while it is held
+ * (e.g. an allocator error) allocates again from the same thread; such nested
+ * requests are served directly by the host platform instead (see
+ * memory_allocate_aligned and memory_free_aligned).
+ */
+static THREAD_LOCAL bool allocation_lock_held = false;
+
+/**
+ * @brief Acquires the allocation lock of a heap, which guards its allocator.
+ * 
+ * @param heap The heap.
+ */
+static void
+memory_lock
+(   heap_t* heap
+)
+{
+    lock_acquire ( &( *heap ).allocation_lock );
+    allocation_lock_held = true;
+}
+
+/**
+ * @brief Releases the allocation lock of a heap (see memory_lock).
+ * 
+ * @param heap The heap.
+ */
+static void
+memory_unlock
+(   heap_t* heap
+)
+{
+    allocation_lock_held = false;
+    lock_release ( &( *heap ).allocation_lock );
+}
+
+/**
+ * @brief Fetches the calling thread's heap: by default, the heap of the NUMA
+ * node the thread first allocated on (see memory_thread_node_set).
+ * 
+ * @return The calling thread's heap.
+ */
+static heap_t*
+memory_heap_local
+( void )
+{
+    if ( thread_heap_generation != generation )
+    {
+        thread_heap = ( ( *state ).heap_count > 1 )
+                    ? platform_numa_node_current () % ( *state ).heap_count
+                    : 0
+                    ;
+        thread_heap_generation = generation;
+    }
+    return &( *state ).heaps[ thread_heap ];
+}
+
+/**
+ * @brief Finds the heap which a block belongs to.
+ * 
+ * @param memory The block.
+ * @return The heap containing memory, or 0 if there is none.
+ */
+static heap_t*
+memory_heap_of
+(   const void* memory
+)
+{
+    for ( u32 i = 0; i < ( *state ).heap_count; ++i )
+    {
+        if ( dynamic_allocator_contains ( ( *state ).heaps[ i ].allocator , memory ) )
+        {
+            return &( *state ).heaps[ i ];
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Call site of the calling thread's next allocation (see
+ * memory_profile_site); 0 if unknown.
+ */
+static THREAD_LOCAL const char* profile_file = 0;
+static THREAD_LOCAL u64 profile_line = 0;
+
+/** @brief Granularity (in bytes) at which the sandbox is committed. */
+#define MEMORY_COMMIT_GRANULARITY ( MiB ( 2 ) )
+
+/**
+ * @brief Distance (in bytes) past the end of every allocated block which is
+ * kept committed. The heap allocator writes the header of a new block before
+ * memory_heap_allocate can commit it; the header lies less than the maximum
+ * alignment past the start of the block, which in turn lies at or below the
+ * end of some allocated block.
+ */
+#define MEMORY_COMMIT_SLACK ( KiB ( 64 ) )
+
+/**
+ * @brief Number of nodes pre-allocated by each heap's allocator. Further node
+ * storage is allocated from the heap as it is needed (see
+ * memory_heap_reserve_nodes), so the bookkeeping committed and initialized at
+ * startup does not grow with the capacity.
+ */
+#define MEMORY_HEAP_NODE_COUNT 64
+
+/**
+ * @brief Commits a heap up to (at least) MEMORY_COMMIT_SLACK past a given
+ * address. The caller must hold the heap's allocation lock.
+ * 
+ * @param heap The heap.
+ * @param end The address. Must lie within the heap.
+ * @return true on success; false otherwise.
+ */
+static bool
+memory_commit
+(   heap_t*     heap
+,   const void* end
+)
+{
+    const u64 offset = ( ( u64 ) end ) - ( ( u64 )( *heap ).memory ) + MEMORY_COMMIT_SLACK;
+    if ( offset <= ( *heap ).committed )
+    {
+        return true;
+    }
+    const u64 committed = MIN ( aligned ( offset , MEMORY_COMMIT_GRANULARITY )
+                              , ( *heap ).reserved
+                              );
+    void* memory = ( void* )( ( ( u64 )( *heap ).memory ) + ( *heap ).committed );
+    const u64 size = committed - ( *heap ).committed;
+    if ( ( *state ).heap_count > 1 )
+    {
+        // Failure only costs locality.
+        platform_memory_bind ( memory , size , ( *heap ).node );
+    }
+    if ( !platform_memory_commit ( memory , size , false ) )
+    {
+        return false;
+    }
+    ( *heap ).committed = committed;
+    return true;
+}
+
+/**
+ * @brief Allocates a block from a heap, committing it as needed. The caller
+ * must hold the heap's allocation lock.
+ * 
+ * @param heap The heap.
+ * @param size The block size in bytes.
+ * @param alignment Memory alignment.
+ * @return The allocated block, or 0 if the heap is out of memory.
+ */
+static void*
+memory_heap_allocate
+(   heap_t*     heap
+,   const u64   size
+,   const u16   alignment
+)
+{
+    void* memory = dynamic_allocator_allocate_aligned ( ( *heap ).allocator
+                                                      , size
+                                                      , alignment
+                                                      );
+    if ( memory && !memory_commit ( heap , ( void* )( ( ( u64 ) memory ) + size ) ) )
+    {
+        dynamic_allocator_free_sized ( ( *heap ).allocator , memory , size , alignment );
+        return 0;
+    }
+    return memory;
+}
+
+/**
+ * @brief Supplies a heap's allocator with additional node storage, allocated
+ * (and committed) from the heap itself, once it runs out of unused nodes (see
+ * dynamic_allocator_add_nodes), so that the next free cannot fail for lack of
+ * one. The caller must hold the heap's allocation lock.
+ * 
+ * Only a free can use up a node, so this is called after each free.
+ * 
+ * @param heap The heap.
+ */
+static void
+memory_heap_reserve_nodes
+(   heap_t* heap
+)
+{
+    if ( dynamic_allocator_query_unused_nodes ( ( *heap ).allocator ) )
+    {
+        return;
+    }
+    void* memory = memory_heap_allocate ( heap
+                                        , DYNAMIC_ALLOCATOR_NODE_STORAGE_SIZE
+                                        , 8
+                                        );
+    if ( memory )
+    {
+        dynamic_allocator_add_nodes ( ( *heap ).allocator
+                                    , memory
+                                    , DYNAMIC_ALLOCATOR_NODE_STORAGE_SIZE
+                                    );
+    }
+}
+
+/**
+ * @brief Allocates a block from the calling thread's heap or, if it is out of
+ * memory, from the heap of any other node. Obtains the allocation lock of
+ * each heap it tries.
+ * 
+ * @param size The block size in bytes.
+ * @param alignment Memory alignment.
+ * @return The allocated block, or 0 if every heap is out of memory.
+ */
+static void*
+memory_heaps_allocate
+(   const u64 size
+,   const u16 alignment
+)
+{
+    const u32 first = memory_heap_local () - ( *state ).heaps;
+    for ( u32 i = 0; i < ( *state ).heap_count; ++i )
+    {
+        heap_t* heap = &( *state ).heaps[ ( first + i ) % ( *state ).heap_count ];
+        memory_lock ( heap );
+        void* memory = memory_heap_allocate ( heap , size , alignment );
+        memory_unlock ( heap );
+        if ( memory )
+        {
+            return memory;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Queries whether an allocation request is served by the host
+ * platform's virtual memory system (see MEMORY_LARGE_ALLOCATION_THRESHOLD).
+ * Allocation and release must agree on this, so it depends only on the size
+ * and alignment supplied by the caller.
+ * 
+ * @param size The block size in bytes.
+ * @param alignment Memory alignment.
+ * @return true if the request is served by virtual memory; false otherwise.
+ */
+INLINE
+bool
+memory_large_eligible
+(   const u64 size
+,   const u16 alignment
+)
+{
+    return size >= MEMORY_LARGE_ALLOCATION_THRESHOLD
+        && alignment <= ( *state ).page_size
+        ;
+}
+
+/**
+ * @brief Maps a block directly from the host platform's virtual memory system.
+ * Does not require the allocation lock. The block is page-aligned, and reads as
+ * zero.
+ * 
+ * @param size The block size in bytes.
+ * @return The allocated block, or 0 if the host platform is out of memory.
+ */
+static void*
+memory_large_allocate
+(   const u64 size
+)
+{
+    const u64 mapped_size = aligned ( size , ( *state ).page_size );
+    void* memory = platform_memory_reserve ( mapped_size );
+    if ( !memory )
+    {
+        return 0;
+    }
+    if ( !platform_memory_commit ( memory , mapped_size , mapped_size >= MEMORY_COMMIT_GRANULARITY ) )
+    {
+        platform_memory_release ( memory , mapped_size );
+        return 0;
+    }
+    return memory;
+}
+
+// Atomic counter operations (statistics are updated outside of the
+// allocation lock).
+#define MEMORY_STAT_ADD(counter,amount) \
+    atomic_fetch_add_u64 ( &( counter ) , ( amount ) , ATOMIC_RELAXED )
+#define MEMORY_STAT_SUB(counter,amount) \
+    atomic_fetch_sub_u64 ( &( counter ) , ( amount ) , ATOMIC_RELAXED )
+#define MEMORY_STAT_LOAD(counter) \
+    atomic_load_u64 ( &( counter ) , ATOMIC_RELAXED )
+
+#if MEMORY_STAT_ENABLED == 1
+
+/** @brief Allocates statistics shards to threads (round-robin). */
+static u64 stat_shard_next = 0;
+
+/** @brief Statistics shard index of the calling thread (plus one; zero if unassigned). */
+static THREAD_LOCAL u64 stat_shard = 0;
+
+/** @brief Statistics scope of the calling thread (see memory_stat_scope_set). */
+static THREAD_LOCAL stat_t* stat_scope = 0;
+
+/**
+ * @brief Fetches the calling thread's statistics shard.
+ * 
+ * @return The calling thread's statistics shard.
+ */
+INLINE
+stat_t*
+memory_stat_shard
+( void )
+{
+    if ( !stat_shard )
+    {
+        stat_shard = MEMORY_STAT_ADD ( stat_shard_next , 1 )
+                   % MEMORY_STAT_SHARD_COUNT
+                   + 1
+                   ;
+    }
+    return &( *state ).stat[ stat_shard - 1 ].stat;
+}
+
+/**
+ * @brief Sums a single statistics counter across all shards.
+ * 
+ * Shards may individually wrap (e.g. a block allocated on one thread and freed
+ * on another), but the sum across all of them is exact.
+ * 
+ * @param field The byte offset of the counter within stat_t.
+ * @return The sum of the counter across all shards.
+ */
+static u64
+memory_stat_sum
+(   const u64 field
+)
+{
+    u64 sum = 0;
+    for ( u64 i = 0; i < MEMORY_STAT_SHARD_COUNT; ++i )
+    {
+        sum += MEMORY_STAT_LOAD ( *( ( u64* )( ( ( u64 ) &( *state ).stat[ i ].stat ) + field ) ) );
+    }
+    return sum;
+}
+
+/** @brief Computes the byte offset of a counter within stat_t. */
+#define MEMORY_STAT_FIELD(field) \
+    ( ( u64 ) &( ( *( stat_t* ) 0 ).field ) )
+
+#endif  // MEMORY_STAT_ENABLED
+
+////////////////////////////////////////////////////////////////////////////////
+#if MEMORY_THREAD_CACHE_ENABLED == 1
+
+#define MEMORY_THREAD_CACHE_MIN_SIZE            16                                            /** @brief Smallest size class (in bytes). */
+#define MEMORY_THREAD_CACHE_CLASS_COUNT         7                                             /** @brief Number of size classes ( MEMORY_THREAD_CACHE_MIN_SIZE .. MEMORY_THREAD_CACHE_MAX_SIZE ). */
+#define MEMORY_THREAD_CACHE_ALIGNMENT           16                                            /** @brief Alignment of every cached block; requests with a larger alignment bypass the cache. */
+#define MEMORY_THREAD_CACHE_MAGAZINE_CAPACITY   64                                            /** @brief Maximum number of blocks cached per size class per thread. */
+#define MEMORY_THREAD_CACHE_BATCH_SIZE          ( MEMORY_THREAD_CACHE_MAGAZINE_CAPACITY / 2 ) /** @brief Number of blocks moved per refill or drain. */
+
+STATIC_ASSERT ( ( MEMORY_THREAD_CACHE_MIN_SIZE << ( MEMORY_THREAD_CACHE_CLASS_COUNT - 1 ) ) == MEMORY_THREAD_CACHE_MAX_SIZE
+              , "MEMORY_THREAD_CACHE_CLASS_COUNT does not span MEMORY_THREAD_CACHE_MAX_SIZE."
+              );
+
+/**
+ * @brief Returns blocks to the heaps they belong to, holding each heap's
+ * allocation lock across consecutive blocks from the same heap.
+ * 
+ * @param blocks The blocks. Each must belong to a heap.
+ * @param count The number of blocks.
+ */
+static void
+memory_heaps_free
+(   void**      blocks
+,   const u64   count
+)
+{
+    heap_t* locked = 0;
+    for ( u64 i = 0; i < count; ++i )
+    {
+        heap_t* heap = memory_heap_of ( blocks[ i ] );
+        if ( heap != locked )
+        {
+            if ( locked )
+            {
+                memory_unlock ( locked );
+            }
+            locked = heap;
+            memory_lock ( locked );
+        }
+        if ( !dynamic_allocator_free_aligned ( ( *heap ).allocator , blocks[ i ] ) )
+        {
+            LOGERROR ( "memory_free: Failed to return cached block [%@] to the global allocator."
+                     , blocks[ i ]
+                     );
+        }
+        memory_heap_reserve_nodes ( heap );
+    }
+    if ( locked )
+    {
+        memory_unlock ( locked );
+    }
+}
+
+/** @brief Type definition for a stack of free blocks of a single size class. */
+typedef struct
+{
+    u64     count;
+    void*   blocks[ MEMORY_THREAD_CACHE_MAGAZINE_CAPACITY ];
+}
+magazine_t;
+
+/** @brief Type definition for a per-thread allocation cache. */
+typedef struct
+{
+    u64         generation;
+    magazine_t  magazines[ MEMORY_THREAD_CACHE_CLASS_COUNT ];
+}
+thread_cache_t;
+
+/** @brief Per-thread allocation cache. */
+static THREAD_LOCAL thread_cache_t thread_cache;
+
+/**
+ * @brief Queries whether an allocation request is served by the per-thread
+ * allocation cache. Allocation and release must agree on this, so it depends
+ * only on the size and alignment supplied by the caller.
+ * 
+ * @param size The block size in bytes.
+ * @param alignment Memory alignment.
+ * @return true if the request is served by the cache; false otherwise.
+ */
+INLINE
+bool
+memory_thread_cache_eligible
+(   const u64 size
+,   const u16 alignment
+)
+{
+    return size <= MEMORY_THREAD_CACHE_MAX_SIZE
+        && alignment
+        && alignment <= MEMORY_THREAD_CACHE_ALIGNMENT
+        ;
+}
+
+/**
+ * @brief Computes the size class of an allocation request.
+ * 
+ * @param size The block size in bytes.
+ * @return The index of the smallest size class which fits size.
+ */
+INLINE
+u8
+memory_thread_cache_class
+(   const u64 size
+)
+{
+    u8 class = 0;
+    u64 class_size = MEMORY_THREAD_CACHE_MIN_SIZE;
+    while ( class_size < size )
+    {
+        class_size <<= 1;
+        class += 1;
+    }
+    return class;
+}
+
+/**
+ * @brief Fetches the calling thread's allocation cache, discarding its
+ * contents if they belong to a previous memory subsystem lifetime.
+ * 
+ * @return The calling thread's allocation cache.
+ */
+static thread_cache_t*
+memory_thread_cache
+( void )
+{
+    if ( thread_cache.generation != generation )
+    {
+        memory_clear ( &thread_cache , sizeof ( thread_cache_t ) );
+        thread_cache.generation = generation;
+    }
+    return &thread_cache;
+}
+
+/**
+ * @brief Allocates a block via the calling thread's allocation cache. If the
+ * magazine for the size class is empty, it is refilled from the calling
+ * thread's heap (this is the only case in which an allocation lock is
+ * obtained).
+ * 
+ * @param size The block size in bytes.
+ * @return The allocated block, or 0 if the global allocator is out of memory.
+ */
+static void*
+memory_thread_cache_allocate
+(   const u64 size
+)
+{
+    const u8 class = memory_thread_cache_class ( size );
+    magazine_t* magazine = &( *memory_thread_cache () ).magazines[ class ];
+    if ( !( *magazine ).count )
+    {
+        metrics_counter_add ( METRICS_MEMORY_CACHE_MISSES , 1 );
+        const u64 class_size = MEMORY_THREAD_CACHE_MIN_SIZE << class;
+        heap_t* heap = memory_heap_local ();
+        memory_lock ( heap );
+        while ( ( *magazine ).count < MEMORY_THREAD_CACHE_BATCH_SIZE )
+        {
+            void* block = memory_heap_allocate ( heap
+                                               , class_size
+                                               , MEMORY_THREAD_CACHE_ALIGNMENT
+                                               );
+            if ( !block )
+            {
+                break;
+            }
+            ( *magazine ).blocks[ ( *magazine ).count ] = block;
+            ( *magazine ).count += 1;
+        }
+        memory_unlock ( heap );
+        if ( !( *magazine ).count )
+        {
+            // The local heap is out of memory; borrow from another node.
+            return memory_heaps_allocate ( class_size , MEMORY_THREAD_CACHE_ALIGNMENT );
+        }
+    }
+    else
+    {
+        metrics_counter_add ( METRICS_MEMORY_CACHE_HITS , 1 );
+    }
+    ( *magazine ).count -= 1;
+    return ( *magazine ).blocks[ ( *magazine ).count ];
+}
+
+/**
+ * @brief Releases a block to the calling thread's allocation cache. If the
+ * magazine for the size class is full, the oldest half of it is first drained
+ * back to the heaps the blocks belong to (this is the only case in which an
+ * allocation lock is obtained).
+ * 
+ * @param memory The block to free. Must belong to a heap.
+ * @param size The block size in bytes.
+ */
+static void
+memory_thread_cache_free
+(   void*       memory
+,   const u64   size
+)
+{
+    const u8 class = memory_thread_cache_class ( size );
+    magazine_t* magazine = &( *memory_thread_cache () ).magazines[ class ];
+    if ( ( *magazine ).count == MEMORY_THREAD_CACHE_MAGAZINE_CAPACITY )
+    {
+        memory_heaps_free ( ( *magazine ).blocks , MEMORY_THREAD_CACHE_BATCH_SIZE );
+        ( *magazine ).count -= MEMORY_THREAD_CACHE_BATCH_SIZE;
+        memory_move ( ( *magazine ).blocks
+                    , ( *magazine ).blocks + MEMORY_THREAD_CACHE_BATCH_SIZE
+                    , ( *magazine ).count * sizeof ( void* )
+                    );
+    }
+    ( *magazine ).blocks[ ( *magazine ).count ] = memory;
+    ( *magazine ).count += 1;
+}
+
+#endif  // MEMORY_THREAD_CACHE_ENABLED
+////////////////////////////////////////////////////////////////////////////////
+#if MEMORY_PROFILE_ENABLED == 1
+
+/**
+ * @brief Computes the key of a call site. Exact (i.e. distinct sites never
+ * share a key) for addresses below 2^48 and lines below 2^16, and never 0.
+ * 
+ * @param file The source file. Must be non-zero.
+ * @param line The source line.
+ * @return The key.
+ */
+INLINE
+u64
+memory_profile_key
+(   const char* file
+,   const u64   line
+)
+{
+    return ( ( u64 ) file ) ^ ( line << 48 );
+}
+
+/**
+ * @brief Raises a high-water mark to a given value, if it is lower.
+ * 
+ * @param peak The high-water mark.
+ * @param value The value.
+ */
+INLINE
+void
+memory_profile_peak
+(   u64*        peak
+,   const u64   value
+)
+{
+    u64 current = MEMORY_STAT_LOAD ( *peak );
+    while ( value > current && !atomic_compare_exchange_u64 ( peak
+                                                            , &current
+                                                            , value
+                                                            , ATOMIC_RELAXED
+                                                            , ATOMIC_RELAXED
+                                                            ));
+}
+
+/**
+ * @brief Updates the allocation profiler following a successful allocation,
+ * attributing it to the calling thread's pending call site (see
+ * memory_profile_site).
+ * 
+ * Lock-free: call sites are claimed with a compare-and-swap on their key, and
+ * counted with atomic increments.
+ * 
+ * @param size The block size in bytes.
+ * @param tag The block tag.
+ */
+static void
+memory_profile_allocate
+(   const u64           size
+,   const MEMORY_TAG    tag
+)
+{
+    profile_t* profile = &( *state ).profile;
+
+    memory_profile_peak ( &( *profile ).peak[ tag ]
+                        , MEMORY_STAT_ADD ( ( *profile ).live[ tag ] , size ) + size
+                        );
+    memory_profile_peak ( &( *profile ).peak[ MEMORY_TAG_ALL ]
+                        , MEMORY_STAT_ADD ( ( *profile ).live[ MEMORY_TAG_ALL ] , size ) + size
+                        );
+    MEMORY_STAT_ADD ( ( *profile ).buckets[ size ? 63 - __builtin_clzll ( size ) : 0 ] , 1 );
+
+    const char* file = ( profile_file ) ? profile_file : "(unknown)";
+    const u64 line = profile_line;
+    profile_file = 0;
+    profile_line = 0;
+
+    const u64 key = memory_profile_key ( file , line );
+    const u64 hash = ( key * 0x9E3779B97F4A7C15ULL ) >> 32;
+    for ( u64 i = 0; i < MEMORY_PROFILE_SITE_CAPACITY; ++i )
+    {
+        site_t* site = &( *profile ).sites[ ( hash + i ) & ( MEMORY_PROFILE_SITE_CAPACITY - 1 ) ];
+        u64 site_key = atomic_load_u64 ( &( *site ).key , ATOMIC_ACQUIRE );
+        if ( !site_key )
+        {
+            if ( atomic_compare_exchange_u64 ( &( *site ).key
+                                             , &site_key
+                                             , key
+                                             , ATOMIC_ACQ_REL
+                                             , ATOMIC_ACQUIRE
+                                             ))
+            {
+                ( *site ).line = line;
+                atomic_store_ptr ( ( void** ) &( *site ).file , ( void* ) file , ATOMIC_RELEASE );
+                site_key = key;
+            }
+        }
+        if ( site_key == key )
+        {
+            MEMORY_STAT_ADD ( ( *site ).count , 1 );
+            MEMORY_STAT_ADD ( ( *site ).bytes , size );
+            return;
+        }
+    }
+    MEMORY_STAT_ADD ( ( *profile ).sites_dropped , 1 );
+}
+
+/**
+ * @brief Updates the allocation profiler following a successful release.
+ * 
+ * @param size The block size in bytes.
+ * @param tag The block tag.
+ */
+INLINE
+void
+memory_profile_free
+(   const u64           size
+,   const MEMORY_TAG    tag
+)
+{
+    MEMORY_STAT_SUB ( ( *state ).profile.live[ tag ] , size );
+    MEMORY_STAT_SUB ( ( *state ).profile.live[ MEMORY_TAG_ALL ] , size );
+}
+
+/**
+ * @brief Appends the allocation profiler statistics to a memory_stat string.
+ * 
+ * @param string A resizable string.
+ * @return string, possibly reallocated.
+ */
+static char*
+memory_profile_stat
+(   char* string
+);
+
+#endif  // MEMORY_PROFILE_ENABLED
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Updates the global statistics following a successful allocation.
+ * 
+ * @param size The block size in bytes.
+ * @param tag The block tag.
+ */
+INLINE
+void
+memory_stat_allocate
+(   const u64           size
+,   const MEMORY_TAG    tag
+)
+{
+#if MEMORY_STAT_ENABLED == 1
+    stat_t* stat = memory_stat_shard ();
+    MEMORY_STAT_ADD ( ( *stat ).allocated , size );
+    MEMORY_STAT_ADD ( ( *stat ).tagged_allocations[ tag ] , size );
+    MEMORY_STAT_ADD ( ( *stat ).allocation_count , 1 );
+    if ( stat_scope )
+    {
+        MEMORY_STAT_ADD ( ( *stat_scope ).allocated , size );
+        MEMORY_STAT_ADD ( ( *stat_scope ).tagged_allocations[ tag ] , size );
+        MEMORY_STAT_ADD ( ( *stat_scope ).allocation_count , 1 );
+    }
+#endif
+#if MEMORY_PROFILE_ENABLED == 1
+    memory_profile_allocate ( size , tag );
+#endif
+}
+
+/**
+ * @brief Updates the global statistics following a successful release.
+ * 
+ * @param size The block size in bytes.
+ * @param tag The block tag.
+ */
+INLINE
+void
+memory_stat_free
+(   u64                 size
+,   const MEMORY_TAG    tag
+)
+{
+#if MEMORY_STAT_ENABLED == 1
+#if VERSION_DEBUG == 1
+    // Aggregating the shards is comparatively expensive; only validate the
+    // release size in debug builds.
+    const u64 tagged_allocated = memory_stat_sum ( MEMORY_STAT_FIELD ( tagged_allocations[ tag ] ) );
+    if ( size > tagged_allocated )
+    {
+        f64 req_amount;
+        f64 rem_amount;
+        const char* req_unit = string_bytesize ( size , &req_amount );
+        const char* rem_unit = string_bytesize ( tagged_allocated , &rem_amount );
+        LOGERROR ( "memory_free: Freed a %.2f %s %s, but only %.2f %s is allocated."
+                 , &req_amount , req_unit
+                 , memory_tags[ tag ]
+                 , &rem_amount , rem_unit
+                 );
+        size = tagged_allocated;
+    }
+#endif
+    stat_t* stat = memory_stat_shard ();
+    MEMORY_STAT_SUB ( ( *stat ).allocated , size );
+    MEMORY_STAT_SUB ( ( *stat ).tagged_allocations[ tag ] , size );
+    MEMORY_STAT_ADD ( ( *stat ).free_count , 1 );
+    if ( stat_scope )
+    {
+        MEMORY_STAT_SUB ( ( *stat_scope ).allocated , size );
+        MEMORY_STAT_SUB ( ( *stat_scope ).tagged_allocations[ tag ] , size );
+        MEMORY_STAT_ADD ( ( *stat_scope ).free_count , 1 );
+    }
+#endif
+#if MEMORY_PROFILE_ENABLED == 1
+    memory_profile_free ( size , tag );
+#endif
 }
-stat_t;
 
-/** @brief Type definition for memory subsystem state. */
-typedef struct
+/**
+ * @brief Allocates a block of memory (see memory_allocate_aligned,
+ * memory_allocate_aligned_uninit).
+ * 
+ * @param size The number of bytes to allocate.
+ * @param alignment Memory alignment.
+ * @param tag The block tag.
+ * @param clear Clear the block? Y/N
+ * @return The allocated block.
+ */
+static void*
+memory_allocate_block
+(   const u64           size
+,   const u16           alignment
+,   const MEMORY_TAG    tag
+,   const bool          clear
+)
 {
-    bool                    initialized;
-
-    stat_t                  stat;
-    
-    dynamic_allocator_t*    allocator;
-
-    u64                     capacity;
-    void*                   memory;
+    if ( tag == MEMORY_TAG_UNKNOWN )
+    {
+        LOGWARN ( "memory_allocate: Called with MEMORY_TAG_UNKNOWN." );
+    }
 
-    mutex_t                 allocation_mutex;
+    void* memory;
+    if ( state && ( *state ).initialized && memory_large_eligible ( size , alignment ) )
+    {
+        // Fresh mappings read as zero, so the block is not cleared.
+        memory = memory_large_allocate ( size );
+        if ( memory )
+        {
+            memory_stat_allocate ( size , tag );
+            return memory;
+        }
+        LOGFATAL ( "memory_allocate: Failed to map memory." );
+        return 0;
+    }
+    else if ( state && ( *state ).initialized && !allocation_lock_held )
+    {
+#if MEMORY_THREAD_CACHE_ENABLED == 1
+        if ( memory_thread_cache_eligible ( size , alignment ) )
+        {
+            memory = memory_thread_cache_allocate ( size );
+        }
+        else
+#endif
+        {
+            memory = memory_heaps_allocate ( size , alignment );
+        }
+        if ( memory )
+        {
+            memory_stat_allocate ( size , tag );
+        }
+    }
+    else
+    {   // Failsafe for if memory subsystem is not initialized, or if called
+        // while this thread holds the allocation lock.
+        memory = platform_memory_allocate ( size );
+    }
+    if ( !memory )
+    {
+        LOGFATAL ( "memory_allocate: Failed to allocate memory." );
+    }
+    else if ( clear )
+    {
+        memory_clear ( memory , size );
+    }
+    return memory;
 }
-state_t;
-
-/** @brief Memory subsystem state. */
-static state_t* state = 0;
 
 bool
 memory_startup
@@ -78,51 +1038,92 @@ memory_startup
         return false;
     }
 
-    const u64 state_memory_requirement = sizeof ( state_t );
+    // The capacity is split evenly between one heap per NUMA node. Each heap
+    // occupies a region of the sandbox aligned to the commit granularity, so
+    // that no commit spans two nodes.
+    const u32 heap_count = MIN ( platform_numa_node_count () , MEMORY_NODE_MAX );
+    const u64 heap_capacity = capacity / heap_count;
     u64 allocator_memory_requirement = 0;
-    dynamic_allocator_create ( capacity , &allocator_memory_requirement , 0 , 0 );
+    _dynamic_allocator_create ( heap_capacity
+                              , FREELIST_MODE_FIRST_FIT
+                              , MEMORY_HEAP_NODE_COUNT
+                              , &allocator_memory_requirement
+                              , 0
+                              , 0
+                              );
+    const u64 state_memory_requirement = aligned ( sizeof ( state_t ) , MEMORY_COMMIT_GRANULARITY );
+    const u64 heap_memory_requirement = aligned ( allocator_memory_requirement , MEMORY_COMMIT_GRANULARITY );
     const u64 memory_requirement = state_memory_requirement
-                                 + allocator_memory_requirement
+                                 + heap_count * heap_memory_requirement
                                  ;
 
     f64 amount;
     const char* unit = string_bytesize ( memory_requirement , &amount );
-    LOGDEBUG ( "Requesting %.2f %s of memory from "PLATFORM_STRING" for the entire runtime environment. . ."
+    LOGDEBUG ( "Reserving %.2f %s of address space from "PLATFORM_STRING" for the entire runtime environment (%u NUMA node%s). . ."
              , &amount , unit
+             , heap_count , ( heap_count == 1 ) ? "" : "s"
              );
 
-    void* memory = platform_memory_allocate ( memory_requirement );
+    // Only the bookkeeping of the sandbox is committed up front; the remainder
+    // is committed as each heap's allocator reaches into it. Committed memory
+    // reads as zero, so the state is not cleared, and its pages are not
+    // touched until they are used.
+    const u64 page_size = platform_memory_page_size ();
+    void* memory = platform_memory_reserve ( memory_requirement );
     if ( !memory )
     {
         return false;
     }
+    if ( !platform_memory_commit ( memory , aligned ( sizeof ( state_t ) , page_size ) , false ) )
+    {
+        platform_memory_release ( memory , memory_requirement );
+        return false;
+    }
 
     state = memory;
     ( *state ).initialized = false;
+    ( *state ).reserved = memory_requirement;
+    ( *state ).page_size = page_size;
+    ( *state ).capacity = heap_count * heap_capacity;
+    ( *state ).heap_count = heap_count;
 
-    memory_clear ( &( *state ).stat , sizeof ( stat_t ) );
+    for ( u32 i = 0; i < heap_count; ++i )
+    {
+        heap_t* heap = &( *state ).heaps[ i ];
+        ( *heap ).memory = ( void* )( ( ( u64 ) memory )
+                                    + state_memory_requirement
+                                    + i * heap_memory_requirement
+                                    );
+        ( *heap ).reserved = heap_memory_requirement;
+        ( *heap ).node = i;
 
-    ( *state ).memory = ( void* )( ( ( u64 ) memory )
-                                 + state_memory_requirement
-                                 );
-    ( *state ).capacity = capacity;
+        if (   !memory_commit ( heap , ( void* )( ( ( u64 )( *heap ).memory )
+                                                + allocator_memory_requirement
+                                                - heap_capacity
+                                                ))
+            || !_dynamic_allocator_create ( heap_capacity
+                                          , FREELIST_MODE_FIRST_FIT
+                                          , MEMORY_HEAP_NODE_COUNT
+                                          , 0
+                                          , ( *heap ).memory
+                                          , &( *heap ).allocator
+                                          ))
+        {
+            LOGFATAL ( "memory_startup: Failed to initialize internal allocator." );
 
-    if ( !dynamic_allocator_create ( ( *state ).capacity
-                                   , 0
-                                   , ( *state ).memory
-                                   , &( *state ).allocator
-                                   ))
-    {
-        LOGFATAL ( "memory_startup: Failed to initialize internal allocator." );
-        return false;
-    }
-    
-    if ( !mutex_create ( &( *state ).allocation_mutex ) )
-    {
-        LOGFATAL ( "memory_startup: Failed to initialize the mutex data structure employed by thread-safe memory operations." );
-        return false;
+            // Tear down the heaps built so far and the sandbox, so that
+            // neither a retry nor memory_shutdown sees a partial state.
+            for ( u32 j = 0; j < i; ++j )
+            {
+                dynamic_allocator_destroy ( &( *state ).heaps[ j ].allocator );
+            }
+            state = 0;
+            platform_memory_release ( memory , memory_requirement );
+            return false;
+        }
     }
 
+    generation += 1;
     ( *state ).initialized = true;
     
     LOGDEBUG ( "  Success." );
@@ -141,22 +1142,25 @@ memory_shutdown
 
     ( *state ).initialized = false;
 
-    mutex_destroy ( &( *state ).allocation_mutex );
-
-    dynamic_allocator_destroy ( &( *state ).allocator );
+    for ( u32 i = 0; i < ( *state ).heap_count; ++i )
+    {
+        dynamic_allocator_destroy ( &( *state ).heaps[ i ].allocator );
+    }
 
-    if ( ( *state ).stat.allocation_count != ( *state ).stat.free_count )
+    const u64 allocation_count = memory_allocation_count ();
+    const u64 free_count = memory_free_count ();
+    if ( allocation_count != free_count )
     {
         char* stat = memory_stat ();
         LOGDEBUG ( "memory_shutdown: Noticed allocation count (%i) != free count (%i) when shutting down memory subsystem.\n\n\t%s\n"
-                 , ( *state ).stat.allocation_count
-                 , ( *state ).stat.free_count
+                 , allocation_count
+                 , free_count
                  , stat
                  );
         string_destroy ( stat );
     }
     
-    platform_memory_free ( state );
+    platform_memory_release ( state , ( *state ).reserved );
 
     state = 0;
 }
@@ -177,47 +1181,107 @@ memory_allocate_aligned
 ,   MEMORY_TAG  tag
 )
 {
-    if ( tag == MEMORY_TAG_UNKNOWN )
-    {
-        LOGWARN ( "memory_allocate: Called with MEMORY_TAG_UNKNOWN." );
-    }
+    PROFILE_FUNCTION ();
+    return memory_allocate_block ( size , alignment , tag , true );
+}
 
-    void* memory;
-    if ( state && ( *state ).initialized )
+void*
+memory_allocate_uninit
+(   u64         size
+,   MEMORY_TAG  tag
+)
+{
+    return memory_allocate_aligned_uninit ( size , 1 , tag );
+}
+
+void*
+memory_allocate_aligned_uninit
+(   u64         size
+,   u16         alignment
+,   MEMORY_TAG  tag
+)
+{
+    PROFILE_FUNCTION ();
+    return memory_allocate_block ( size , alignment , tag , false );
+}
+
+void*
+memory_reallocate
+(   void*       memory
+,   u64         old_size
+,   u64         new_size
+,   MEMORY_TAG  tag
+)
+{
+    return memory_reallocate_aligned ( memory , old_size , new_size , 1 , tag );
+}
+
+void*
+memory_reallocate_aligned
+(   void*       memory
+,   u64         old_size
+,   u64         new_size
+,   u16         alignment
+,   MEMORY_TAG  tag
+)
+{
+    void* new_memory = 0;
+
+    // Blocks served by the per-thread cache have their size class baked in, so
+    // only blocks which bypass the cache both before and after can be resized
+    // in place. Otherwise (or if the space following the block is taken), the
+    // block is moved to a newly allocated one, which commits the sandbox.
+    heap_t* heap = 0;
+    if ( state && ( *state ).initialized
+      && !allocation_lock_held
+#if MEMORY_THREAD_CACHE_ENABLED == 1
+      && !memory_thread_cache_eligible ( old_size , alignment )
+      && !memory_thread_cache_eligible ( new_size , alignment )
+#endif
+      && ( heap = memory_heap_of ( memory ) )
+       )
     {
-        if ( !mutex_lock ( &( *state ).allocation_mutex ) )
-        {
-            LOGFATAL ( "memory_allocate: Could not obtain mutex lock. Aborting operation." );
-            return 0;
-        }
-        memory = dynamic_allocator_allocate_aligned ( ( *state ).allocator
-                                                    , size
-                                                    , alignment
-                                                    );
-        if ( memory )
+        memory_lock ( heap );
+        if ( dynamic_allocator_resize ( ( *heap ).allocator , memory , new_size ) )
         {
-            ( *state ).stat.allocated += size;
-            ( *state ).stat.tagged_allocations[ tag ] += size;
-            ( *state ).stat.allocation_count += 1;
+            if ( memory_commit ( heap , ( void* )( ( ( u64 ) memory ) + new_size ) ) )
+            {
+                new_memory = memory;
+            }
+            else
+            {   // Restore the old size, and let the fallback report the error.
+                dynamic_allocator_resize ( ( *heap ).allocator , memory , old_size );
+            }
         }
-        if ( !mutex_unlock ( &( *state ).allocation_mutex ) )
+        memory_heap_reserve_nodes ( heap );
+        memory_unlock ( heap );
+        if ( new_memory )
         {
-            LOGERROR ( "memory_allocate: Failed to release the mutex lock." );
+            memory_stat_free ( old_size , tag );
+            memory_stat_allocate ( new_size , tag );
         }
     }
-    else
-    {   // Failsafe for if memory subsystem is not initialized.
-        memory = platform_memory_allocate ( size );
-    }
-    if ( memory )
+
+    // Only the bytes beyond the copied content need clearing. If the new block
+    // cannot be allocated, the old one is left as it was (as with realloc).
+    if ( !new_memory )
     {
-        memory_clear ( memory , size );
+        new_memory = memory_allocate_block ( new_size , alignment , tag , false );
+        if ( !new_memory )
+        {
+            return 0;
+        }
+        memory_copy ( new_memory , memory , MIN ( old_size , new_size ) );
+        memory_free_aligned ( memory , old_size , alignment , tag );
     }
-    else
+
+    if ( new_size > old_size )
     {
-        LOGFATAL ( "memory_allocate: Failed to allocate memory." );
+        memory_clear ( ( void* )( ( ( u64 ) new_memory ) + old_size )
+                     , new_size - old_size
+                     );
     }
-    return memory;
+    return new_memory;
 }
 
 void
@@ -243,42 +1307,36 @@ memory_free_aligned
         LOGWARN ( "memory_free: Called with MEMORY_TAG_UNKNOWN." );
     }
 
-    if ( state && ( *state ).initialized )
+    heap_t* heap = 0;
+    if ( state && ( *state ).initialized
+      && !allocation_lock_held
+      && ( heap = memory_heap_of ( memory ) )
+       )
     {
-        if ( !mutex_lock ( &( *state ).allocation_mutex ) )
+        bool success;
+#if MEMORY_THREAD_CACHE_ENABLED == 1
+        if ( memory_thread_cache_eligible ( size , alignment ) )
         {
-            LOGFATAL ( "memory_free: Could not obtain mutex lock. Heap corruption is likely." );
-            return;
+            memory_thread_cache_free ( memory , size );
+            success = true;
         }
-        bool success = dynamic_allocator_free_aligned ( ( *state ).allocator
-                                                      , memory
-                                                      );
-        if ( success )
+        else
+#endif
         {
-            if ( size > ( *state ).stat.tagged_allocations[ tag ] )
-            {
-                f64 req_amount;
-                f64 rem_amount;
-                const char* req_unit = string_bytesize ( size , &req_amount );
-                const char* rem_unit = string_bytesize ( ( *state ).stat.tagged_allocations[ tag ]
-                                                       , &req_amount
-                                                       );
-                LOGERROR ( "memory_free: Freed a %.2f %s %s, but only %.2f %s is allocated."
-                         , &req_amount , req_unit
-                         , memory_tags[ tag ]
-                         , &rem_amount , rem_unit
-                         );
-                size = ( *state ).stat.tagged_allocations[ tag ];
-            }
-            ( *state ).stat.allocated -= size;
-            ( *state ).stat.tagged_allocations[ tag ] -= size;
-            ( *state ).stat.free_count += 1;
+            memory_lock ( heap );
+            success = dynamic_allocator_free_sized ( ( *heap ).allocator
+                                                   , memory
+                                                   , size
+                                                   , alignment
+                                                   );
+            memory_heap_reserve_nodes ( heap );
+            memory_unlock ( heap );
         }
-        if ( !mutex_unlock ( &( *state ).allocation_mutex ) )
+        if ( success )
         {
-            LOGERROR ( "memory_free: Failed to release mutex lock." );
+            memory_stat_free ( size , tag );
         }
-        if ( !success )
+        else
         {
             /**
              * If the free operation failed, try freeing the memory on the
@@ -288,58 +1346,177 @@ memory_free_aligned
             // . . .gee, I sure hope that worked. . .
         }
     }
+    else if ( state && ( *state ).initialized && memory_large_eligible ( size , alignment ) )
+    {
+        platform_memory_release ( memory , aligned ( size , ( *state ).page_size ) );
+        memory_stat_free ( size , tag );
+    }
     else
-    {   // Failsafe for if memory subsystem is not initialized.
+    {   // Failsafe for if memory subsystem is not initialized, or if the block
+        // was served by the host platform (see memory_allocate_aligned).
         platform_memory_free ( memory );
     }
 }
 
-void*
-memory_clear
-(   void*   memory
-,   u64     size
+void
+memory_thread_cache_flush
+( void )
+{
+#if MEMORY_THREAD_CACHE_ENABLED == 1
+    if ( !state || !( *state ).initialized )
+    {
+        return;
+    }
+    thread_cache_t* cache = memory_thread_cache ();
+    for ( u8 class = 0; class < MEMORY_THREAD_CACHE_CLASS_COUNT; ++class )
+    {
+        magazine_t* magazine = &( *cache ).magazines[ class ];
+        memory_heaps_free ( ( *magazine ).blocks , ( *magazine ).count );
+        ( *magazine ).count = 0;
+    }
+#endif
+}
+
+u32
+memory_node_count
+( void )
+{
+    if ( !state || !( *state ).initialized )
+    {
+        return 1;
+    }
+    return ( *state ).heap_count;
+}
+
+void
+memory_thread_node_set
+(   u32 node
+)
+{
+    if ( !state || !( *state ).initialized )
+    {
+        return;
+    }
+    thread_heap = node % ( *state ).heap_count;
+    thread_heap_generation = generation;
+}
+
+#if PLATFORM_SIMD_SSE2
+/**
+ * @brief Copies a block of memory using non-temporal stores (see
+ * MEMORY_STREAM_THRESHOLD).
+ * 
+ * @param dst The destination block. Must be non-zero.
+ * @param src The source block. Must be non-zero.
+ * @param size The number of bytes to copy. Must be at least 128.
+ * @return dst.
+ */
+static void*
+memory_copy_stream
+(   void*       dst
+,   const void* src
+,   u64         size
 )
 {
-    return platform_memory_clear ( memory , size );
+#if PLATFORM_SIMD_AVX2
+    const u64 alignment = 32;
+#else
+    const u64 alignment = 16;
+#endif
+    u8* d = dst;
+    const u8* s = src;
+
+    // Non-temporal stores must be aligned, so copy the bytes before the first
+    // aligned address normally.
+    const u64 head = ( alignment - ( ( ( u64 ) d ) & ( alignment - 1 ) ) ) & ( alignment - 1 );
+    platform_memory_copy ( d , s , head );
+    d += head;
+    s += head;
+    size -= head;
+
+    for ( ; size >= 128; size -= 128 , d += 128 , s += 128 )
+    {
+#if PLATFORM_SIMD_AVX2
+        for ( u64 i = 0; i < 128; i += 32 )
+        {
+            _mm256_stream_si256 ( ( __m256i* )( d + i ) , _mm256_loadu_si256 ( ( const __m256i* )( s + i ) ) );
+        }
+#else
+        for ( u64 i = 0; i < 128; i += 16 )
+        {
+            _mm_stream_si128 ( ( __m128i* )( d + i ) , _mm_loadu_si128 ( ( const __m128i* )( s + i ) ) );
+        }
+#endif
+    }
+
+    // Non-temporal stores are weakly ordered: fence them, so the copy is
+    // complete (and visible to other threads) once this returns.
+    _mm_sfence ();
+
+    platform_memory_copy ( d , s , size );
+    return dst;
 }
+#endif
 
 void*
-memory_set
+_memory_set
 (   void*   memory
 ,   i32     value
 ,   u64     size
 )
 {
+    if ( size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_set_small ( memory , value , size );
+    }
     return platform_memory_set ( memory , value , size );
 }
 
 void*
-memory_copy
+_memory_copy
 (   void*       dst
 ,   const void* src
 ,   u64         size
 )
 {
-    return platform_memory_copy ( dst , src , size );    
+    if ( size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_move_small ( dst , src , size );
+    }
+#if PLATFORM_SIMD_SSE2
+    if ( size >= MEMORY_STREAM_THRESHOLD )
+    {
+        return memory_copy_stream ( dst , src , size );
+    }
+#endif
+    return platform_memory_copy ( dst , src , size );
 }
 
 void*
-memory_move
+_memory_move
 (   void*       dst
 ,   const void* src
 ,   u64         size
 )
 {
-    return platform_memory_move ( dst , src , size );    
+    if ( size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_move_small ( dst , src , size );
+    }
+    return platform_memory_move ( dst , src , size );
 }
 
 bool
-memory_equal
+_memory_equal
 (   const void* s1
 ,   const void* s2
 ,   u64         size
 )
 {
+    if ( size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_equal_small ( s1 , s2 , size );
+    }
     return platform_memory_equal ( s1 , s2 , size );
 }
 
@@ -353,6 +1530,16 @@ memory_stat
         return 0;
     }
 
+    stat_t stat;
+    memory_clear ( &stat , sizeof ( stat_t ) );
+#if MEMORY_STAT_ENABLED == 1
+    stat.allocated = memory_stat_sum ( MEMORY_STAT_FIELD ( allocated ) );
+    for ( u64 i = 0; i < MEMORY_TAG_COUNT; ++i )
+    {
+        stat.tagged_allocations[ i ] = memory_stat_sum ( MEMORY_STAT_FIELD ( tagged_allocations[ i ] ) );
+    }
+#endif
+
     char* lines[ MEMORY_TAG_COUNT + 2 ];
     char* string = string_create_from ( "System memory usage:\n" );
     const char* unit;
@@ -360,7 +1547,7 @@ memory_stat
     u64 i = 0;
     while ( i < MEMORY_TAG_COUNT )
     {
-        unit = string_bytesize ( ( *state ).stat.tagged_allocations[ i ]
+        unit = string_bytesize ( stat.tagged_allocations[ i ]
                                , &amount
                                );
         lines[ i ] = string_format ( "\t  %Pr "MEMORY_TAG_MAX_STRING_LENGTH_STRING"s: %.2f %s\n"
@@ -373,7 +1560,7 @@ memory_stat
         i += 1;
     }
 
-    unit = string_bytesize ( ( *state ).stat.allocated
+    unit = string_bytesize ( stat.allocated
                            , &amount
                            );
     lines[ i ] = string_format ( "\t  ------------------------------\n"
@@ -404,29 +1591,97 @@ memory_stat
         i -= 1;
     }
 
+#if MEMORY_PROFILE_ENABLED == 1
+    string = memory_profile_stat ( string );
+#endif
+
     return string;
 }
 
+void
+memory_profile_site
+(   const char* file
+,   u64         line
+)
+{
+    profile_file = file;
+    profile_line = line;
+}
+
+memory_stat_scope_t*
+memory_stat_scope_set
+(   memory_stat_scope_t* scope
+)
+{
+#if MEMORY_STAT_ENABLED == 1
+    memory_stat_scope_t* previous = stat_scope;
+    stat_scope = scope;
+    return previous;
+#else
+    return 0;
+#endif
+}
+
+f64
+memory_fragmentation
+( void )
+{
+    if ( !state || !( *state ).initialized )
+    {
+        return 0;
+    }
+
+    // Weight the fragmentation of each heap by its free space.
+    f64 fragmentation = 0;
+    u64 free = 0;
+    for ( u32 i = 0; i < ( *state ).heap_count; ++i )
+    {
+        heap_t* heap = &( *state ).heaps[ i ];
+        memory_lock ( heap );
+        const u64 heap_free = dynamic_allocator_query_free ( ( *heap ).allocator );
+        fragmentation += dynamic_allocator_query_fragmentation ( ( *heap ).allocator ) * heap_free;
+        free += heap_free;
+        memory_unlock ( heap );
+    }
+    return ( free ) ? fragmentation / free : 0;
+}
+
 u64
 memory_allocation_count
 ( void )
 {
+#if MEMORY_STAT_ENABLED == 1
     if ( !state )
     {
         return 0;
     }
-    return ( *state ).stat.allocation_count;
+    if ( stat_scope )
+    {
+        return MEMORY_STAT_LOAD ( ( *stat_scope ).allocation_count );
+    }
+    return memory_stat_sum ( MEMORY_STAT_FIELD ( allocation_count ) );
+#else
+    return 0;
+#endif
 }
 
 u64
 memory_free_count
 ( void )
 {
+#if MEMORY_STAT_ENABLED == 1
     if ( !state )
     {
         return 0;
     }
-    return ( *state ).stat.free_count;
+    if ( stat_scope )
+    {
+        return MEMORY_STAT_LOAD ( ( *stat_scope ).free_count );
+    }
+    return memory_stat_sum ( MEMORY_STAT_FIELD ( free_count ) );
+#else
+    return 0;
+#endif
 }
 
 u64
@@ -434,14 +1689,121 @@ memory_amount_allocated
 (   MEMORY_TAG tag
 )
 {
+#if MEMORY_STAT_ENABLED == 1
     if ( !state )
     {
         return 0;
     }
+    if ( tag != MEMORY_TAG_ALL )
+    {
+        tag = CLAMP ( tag , ( MEMORY_TAG ) 0 , ( MEMORY_TAG ) MEMORY_TAG_COUNT - 1 );
+    }
+    if ( stat_scope )
+    {
+        return ( tag == MEMORY_TAG_ALL ) ? MEMORY_STAT_LOAD ( ( *stat_scope ).allocated )
+                                         : MEMORY_STAT_LOAD ( ( *stat_scope ).tagged_allocations[ tag ] )
+                                         ;
+    }
     if ( tag == MEMORY_TAG_ALL )
     {
-        return ( *state ).stat.allocated;
+        return memory_stat_sum ( MEMORY_STAT_FIELD ( allocated ) );
+    }
+    return memory_stat_sum ( MEMORY_STAT_FIELD ( tagged_allocations[ tag ] ) );
+#else
+    return 0;
+#endif
+}
+
+#if MEMORY_PROFILE_ENABLED == 1
+
+static char*
+memory_profile_stat
+(   char* string
+)
+{
+    const profile_t* profile = &( *state ).profile;
+    const char* unit;
+    f64 amount;
+
+    _string_push ( string , "\n\n\tAllocation profile:\n\t  High-water marks:\n" );
+    for ( u64 i = 0; i <= MEMORY_TAG_COUNT; ++i )
+    {
+        const u64 peak = MEMORY_STAT_LOAD ( ( *profile ).peak[ i ] );
+        if ( !peak && i != MEMORY_TAG_ALL )
+        {
+            continue;
+        }
+        unit = string_bytesize ( peak , &amount );
+        string_format_append ( string
+                             , "\t    %Pr "MEMORY_TAG_MAX_STRING_LENGTH_STRING"s: %.2f %s\n"
+                             , ( i == MEMORY_TAG_ALL ) ? "TOTAL" : memory_tags[ i ]
+                             , &amount , unit
+                             );
+    }
+
+    _string_push ( string , "\t  Allocation sizes (bytes):\n" );
+    for ( u64 i = 0; i < MEMORY_PROFILE_BUCKET_COUNT; ++i )
+    {
+        const u64 count = MEMORY_STAT_LOAD ( ( *profile ).buckets[ i ] );
+        if ( count )
+        {
+            string_format_append ( string
+                                 , "\t    [ 2^%u , 2^%u ): %u\n"
+                                 , i , i + 1 , count
+                                 );
+        }
+    }
+
+    // Select the busiest call sites (by allocation count).
+    const site_t* top[ MEMORY_PROFILE_SITE_REPORT_COUNT ];
+    u64 top_count = 0;
+    for ( u64 i = 0; i < MEMORY_PROFILE_SITE_CAPACITY; ++i )
+    {
+        const site_t* site = &( *profile ).sites[ i ];
+        if ( !atomic_load_ptr ( ( void* const* ) &( *site ).file , ATOMIC_ACQUIRE ) )
+        {
+            continue;
+        }
+        const u64 count = MEMORY_STAT_LOAD ( ( *site ).count );
+        if (   top_count == MEMORY_PROFILE_SITE_REPORT_COUNT
+            && count <= ( *top[ top_count - 1 ] ).count
+           )
+        {
+            continue;
+        }
+        if ( top_count < MEMORY_PROFILE_SITE_REPORT_COUNT )
+        {
+            top_count += 1;
+        }
+        u64 j = top_count - 1;
+        while ( j && ( *top[ j - 1 ] ).count < count )
+        {
+            top[ j ] = top[ j - 1 ];
+            j -= 1;
+        }
+        top[ j ] = site;
+    }
+    _string_push ( string , "\t  Call sites (by allocation count):" );
+    for ( u64 i = 0; i < top_count; ++i )
+    {
+        unit = string_bytesize ( ( *top[ i ] ).bytes , &amount );
+        string_format_append ( string
+                             , "\n\t    %s:%u: %u allocations, %.2f %s"
+                             , ( *top[ i ] ).file
+                             , ( *top[ i ] ).line
+                             , ( *top[ i ] ).count
+                             , &amount , unit
+                             );
+    }
+    const u64 dropped = MEMORY_STAT_LOAD ( ( *profile ).sites_dropped );
+    if ( dropped )
+    {
+        string_format_append ( string
+                             , "\n\t    (%u allocations from sites which did not fit the table)"
+                             , dropped
+                             );
     }
-    tag = CLAMP ( tag , ( MEMORY_TAG ) 0 , ( MEMORY_TAG ) MEMORY_TAG_COUNT );
-    return ( *state ).stat.tagged_allocations[ tag ];
-}
\ No newline at end of file
+    return string;
+}
+
+#endif  // MEMORY_PROFILE_ENABLED
@@ -20,16 +20,101 @@ typedef enum
 ,   MEMORY_TAG_FREELIST
 ,   MEMORY_TAG_LINEAR_ALLOCATOR
 ,   MEMORY_TAG_DYNAMIC_ALLOCATOR
+,   MEMORY_TAG_ARENA
+,   MEMORY_TAG_POOL_ALLOCATOR
 ,   MEMORY_TAG_THREAD
+,   MEMORY_TAG_JOB
 ,   MEMORY_TAG_MUTEX
 ,   MEMORY_TAG_FILE
 ,   MEMORY_TAG_LOGGER
+,   MEMORY_TAG_METRICS
 ,   MEMORY_TAG_APPLICATION
 
 ,   MEMORY_TAG_COUNT
 }
 MEMORY_TAG;
 
+/**
+ * @brief Type definition for a memory statistics scope: a set of counters which
+ * a thread records its allocations and releases into, in addition to the
+ * global ones (see memory_stat_scope_set).
+ */
+typedef struct
+{
+    u64     allocation_count;
+    u64     free_count;
+
+    u64     allocated;
+    u64     tagged_allocations[ MEMORY_TAG_COUNT ];
+}
+memory_stat_scope_t;
+
+/**
+ * @brief Enable memory usage statistics? Y/N
+ * 
+ * If disabled, memory_allocation_count, memory_free_count and
+ * memory_amount_allocated always return 0, and allocation and release
+ * operations perform no bookkeeping whatsoever.
+ * 
+ * Defaults to Y; disable by defining MEMORY_STAT_ENABLED as 0 for every module
+ * (e.g. -DMEMORY_STAT_ENABLED=0).
+ */
+#ifndef MEMORY_STAT_ENABLED
+#define MEMORY_STAT_ENABLED 1
+#endif
+
+/**
+ * @brief Enable per-thread allocation caches? Y/N
+ * 
+ * If enabled, small allocations (see MEMORY_THREAD_CACHE_MAX_SIZE) are served
+ * from thread-local size-class magazines, which are refilled from and drained
+ * to the global allocator in batches. The global allocation lock is only
+ * obtained when a magazine runs empty or overflows.
+ */
+#define MEMORY_THREAD_CACHE_ENABLED 1
+
+/** @brief Largest allocation size (in bytes) served by the per-thread allocation caches. */
+#define MEMORY_THREAD_CACHE_MAX_SIZE 1024
+
+/**
+ * @brief Smallest allocation size (in bytes) served directly by the host
+ * platform's virtual memory system rather than the global allocator.
+ * 
+ * Such blocks are mapped on allocation and returned to the host platform as
+ * soon as they are freed, so they neither fragment the global allocator nor
+ * count against its capacity, and they are not subject to its maximum single
+ * allocation size.
+ */
+#define MEMORY_LARGE_ALLOCATION_THRESHOLD ( MiB ( 1 ) )
+
+/**
+ * @brief Smallest copy size (in bytes) for which memory_copy uses non-temporal
+ * (streaming) stores, which write around the cache instead of evicting the
+ * working set to make room for a destination which will not be read soon.
+ * 
+ * Only applicable if the host platform supports SSE2; otherwise, every copy is
+ * cached.
+ */
+#define MEMORY_STREAM_THRESHOLD ( MiB ( 4 ) )
+
+/**
+ * @brief Enable the allocation profiler? Y/N
+ * 
+ * If enabled, the memory_allocate, memory_allocate_aligned, memory_reallocate
+ * and memory_reallocate_aligned families (including the _uninit variants)
+ * record the file and line they are called from, and every allocation updates
+ * a size histogram, per-tag live-byte high-water marks, and per-call-site
+ * allocation counts, all of which are reported by
+ * memory_stat. Reallocations count as allocations at their call site, so
+ * repeated container growth shows up there.
+ * 
+ * Defaults to N; enable by defining MEMORY_PROFILE_ENABLED as 1 for every
+ * module (e.g. -DMEMORY_PROFILE_ENABLED=1).
+ */
+#ifndef MEMORY_PROFILE_ENABLED
+#define MEMORY_PROFILE_ENABLED 0
+#endif
+
 /** @brief (see memory_amount_allocated). */
 #define MEMORY_TAG_ALL MEMORY_TAG_COUNT
 
@@ -40,13 +125,20 @@ MEMORY_TAG;
 /**
  * @brief Initializes the memory subsystem.
  * 
- * Requests a large sandbox of memory from the host platform and runs all
- * dynamic memory allocation and release processes from within it.
+ * Reserves a large sandbox of virtual address space from the host platform and
+ * runs all dynamic memory allocation and release processes from within it
+ * (except for large allocations; see MEMORY_LARGE_ALLOCATION_THRESHOLD). The
+ * sandbox is committed to physical memory on demand, as the global allocator
+ * reaches into it, so capacity may safely exceed the memory actually used.
+ * 
+ * On a NUMA host, the capacity is split evenly between one heap per node, and
+ * each thread allocates from its own node's heap (see memory_thread_node_set).
  * 
  * When the application no longer needs a dynamic memory management subsystem,
  * the host platform should be signaled to free the sandbox via memory_shutdown.
  * 
- * @param capacity The amount of memory to request from the host platform.
+ * @param capacity The amount of address space to reserve for the global
+ * allocator.
  * @return true on success; false otherwise.
  */
 bool
@@ -62,7 +154,8 @@ memory_shutdown
 ( void );
 
 /**
- * @brief Allocates a block of memory.
+ * @brief Allocates a block of memory. The block is cleared (see
+ * memory_allocate_uninit).
  * 
  * @param size The number of bytes to allocate.
  * @param tag The block tag.
@@ -89,6 +182,84 @@ memory_allocate_aligned
 ,   MEMORY_TAG  tag
 );
 
+/**
+ * @brief Allocates a block of memory without clearing it: its content is
+ * unspecified until written.
+ * 
+ * Use for blocks which are written in full before being read (e.g. copy
+ * destinations, read buffers), to save the cost of clearing them.
+ * 
+ * @param size The number of bytes to allocate.
+ * @param tag The block tag.
+ * @return The allocated block.
+ */
+void*
+memory_allocate_uninit
+(   u64         size
+,   MEMORY_TAG  tag
+);
+
+/**
+ * @brief Allocates a block of memory without clearing it.
+ * (see memory_allocate_uninit)
+ * 
+ * @param size The number of bytes to allocate.
+ * @param alignment Memory alignment.
+ * @param tag The block tag.
+ * @return The allocated block.
+ */
+void*
+memory_allocate_aligned_uninit
+(   u64         size
+,   u16         alignment
+,   MEMORY_TAG  tag
+);
+
+/**
+ * @brief Resizes a block of memory, preserving its content.
+ * 
+ * Where possible, the block is grown or shrunk in place (see
+ * dynamic_allocator_reallocate); otherwise, a new block is allocated, the
+ * content copied, and the old block freed. As with memory_allocate, bytes
+ * beyond old_size are cleared.
+ * 
+ * If the new block cannot be allocated, memory is neither modified nor freed,
+ * and remains valid with its old size (as with realloc).
+ * 
+ * @param memory The block to resize. Must be non-zero.
+ * @param old_size The current block size in bytes.
+ * @param new_size The new block size in bytes.
+ * @param tag The block tag.
+ * @return The resized block (which may equal memory); 0 if out of memory.
+ */
+void*
+memory_reallocate
+(   void*       memory
+,   u64         old_size
+,   u64         new_size
+,   MEMORY_TAG  tag
+);
+
+/**
+ * @brief Resizes a block of memory, preserving its content.
+ * (see memory_reallocate)
+ * 
+ * @param memory The block to resize. Must be non-zero.
+ * @param old_size The current block size in bytes.
+ * @param new_size The new block size in bytes.
+ * @param alignment Memory alignment (as passed to memory_allocate_aligned).
+ * @param tag The block tag.
+ * @return The resized block (which may equal memory); 0 if out of memory.
+ */
+void*
+memory_reallocate_aligned
+(   void*       memory
+,   u64         old_size
+,   u64         new_size
+,   u16         alignment
+,   MEMORY_TAG  tag
+);
+
 /**
  * @brief Frees a block of memory.
  * 
@@ -120,31 +291,293 @@ memory_free_aligned
 );
 
 /**
- * @brief Clears a block of memory.
+ * @brief Returns all blocks held by the calling thread's allocation cache to
+ * the global allocator.
  * 
- * @param memory The block to clear. Must be non-zero.
+ * Called automatically when a thread created by thread_create or
+ * thread_create_ex exits (see platform/thread.h). A thread may also call it
+ * directly, e.g. before a long idle period.
+ * 
+ * Does nothing if MEMORY_THREAD_CACHE_ENABLED is not set.
+ */
+void
+memory_thread_cache_flush
+( void );
+
+/**
+ * @brief Queries the number of heaps the global allocator is split into: one
+ * per NUMA node of the host platform (up to a fixed maximum).
+ * 
+ * @return The number of heaps (1 if the host platform is not NUMA).
+ */
+u32
+memory_node_count
+( void );
+
+/**
+ * @brief Directs the calling thread's subsequent allocations to the heap of a
+ * given NUMA node.
+ * 
+ * By default, a thread allocates from the heap of the node it was running on
+ * when it first allocated; a thread which moves to another node should call
+ * this (thread_affinity_set_node does so automatically). Blocks may be freed
+ * from any thread, and are always returned to the heap they came from. If the
+ * heap is out of memory, allocations fall back on the heaps of other nodes.
+ * 
+ * @param node The NUMA node (see thread_numa_node).
+ */
+void
+memory_thread_node_set
+(   u32 node
+);
+
+/**
+ * @brief Primary implementation of memory_set (see memory_set).
+ * 
+ * @param memory The block to set. Must be non-zero.
+ * @param value The value to set.
  * @param size The block size in bytes.
  * @return memory.
  */
 void*
-memory_clear
+_memory_set
 (   void*   memory
+,   i32     value
 ,   u64     size
 );
 
+/**
+ * @brief Primary implementation of memory_copy (see memory_copy).
+ * 
+ * @param dst The destination block. Must be non-zero.
+ * @param src The source block. Must be non-zero.
+ * @param size The number of bytes to copy.
+ * @return dst.
+ */
+void*
+_memory_copy
+(   void*       dst
+,   const void* src
+,   u64         size
+);
+
+/**
+ * @brief Primary implementation of memory_move (see memory_move).
+ * 
+ * @param dst The destination block. Must be non-zero.
+ * @param src The source block. Must be non-zero.
+ * @param size The number of bytes to move.
+ * @return dst.
+ */
+void*
+_memory_move
+(   void*       dst
+,   const void* src
+,   u64         size
+);
+
+/**
+ * @brief Primary implementation of memory_equal (see memory_equal).
+ * 
+ * @param s1 A string. Must be non-zero.
+ * @param s2 A string. Must be non-zero.
+ * @param size The number of bytes to compare.
+ * @return true if strings are equal; false otherwise.
+ */
+bool
+_memory_equal
+(   const void* s1
+,   const void* s2
+,   u64         size
+);
+
+// Blocks of at most MEMORY_SMALL_SIZE bytes (such as the elements of most
+// containers) are handled without calling the host platform, as at most two
+// loads and two stores: one at each end, overlapping in the middle. If size is
+// constant at the call site, this is inlined and the compiler discards every
+// other case; otherwise, it is the first branch of the primary implementation.
+
+/** @brief Largest block size (in bytes) handled without the host platform. */
+#define MEMORY_SMALL_SIZE 16
+
+/**
+ * @brief Sets a block of at most MEMORY_SMALL_SIZE bytes.
+ * 
+ * @param memory The block to set. Must be non-zero.
+ * @param value The value to set.
+ * @param size The block size in bytes.
+ * @return memory.
+ */
+INLINE
+void*
+_memory_set_small
+(   void*   memory
+,   i32     value
+,   u64     size
+)
+{
+    u8* const dst = memory;
+    const u64 splat = 0x0101010101010101ULL * ( u8 ) value;
+    if ( size >= 8 )
+    {
+        __builtin_memcpy ( dst , &splat , 8 );
+        __builtin_memcpy ( dst + size - 8 , &splat , 8 );
+    }
+    else if ( size >= 4 )
+    {
+        const u32 splat32 = ( u32 ) splat;
+        __builtin_memcpy ( dst , &splat32 , 4 );
+        __builtin_memcpy ( dst + size - 4 , &splat32 , 4 );
+    }
+    else if ( size )
+    {
+        dst[ 0 ] = ( u8 ) value;
+        dst[ size >> 1 ] = ( u8 ) value;
+        dst[ size - 1 ] = ( u8 ) value;
+    }
+    return memory;
+}
+
+/**
+ * @brief Moves a block of at most MEMORY_SMALL_SIZE bytes. Both ends are
+ * loaded before either is stored, so the blocks may overlap.
+ * 
+ * @param dst The destination block. Must be non-zero.
+ * @param src The source block. Must be non-zero.
+ * @param size The number of bytes to move.
+ * @return dst.
+ */
+INLINE
+void*
+_memory_move_small
+(   void*       dst
+,   const void* src
+,   u64         size
+)
+{
+    u8* const d = dst;
+    const u8* const s = src;
+    if ( size >= 8 )
+    {
+        u64 head;
+        u64 tail;
+        __builtin_memcpy ( &head , s , 8 );
+        __builtin_memcpy ( &tail , s + size - 8 , 8 );
+        __builtin_memcpy ( d , &head , 8 );
+        __builtin_memcpy ( d + size - 8 , &tail , 8 );
+    }
+    else if ( size >= 4 )
+    {
+        u32 head;
+        u32 tail;
+        __builtin_memcpy ( &head , s , 4 );
+        __builtin_memcpy ( &tail , s + size - 4 , 4 );
+        __builtin_memcpy ( d , &head , 4 );
+        __builtin_memcpy ( d + size - 4 , &tail , 4 );
+    }
+    else if ( size )
+    {
+        const u8 first = s[ 0 ];
+        const u8 middle = s[ size >> 1 ];
+        const u8 last = s[ size - 1 ];
+        d[ 0 ] = first;
+        d[ size >> 1 ] = middle;
+        d[ size - 1 ] = last;
+    }
+    return dst;
+}
+
+/**
+ * @brief Compares two blocks of at most MEMORY_SMALL_SIZE bytes.
+ * 
+ * @param s1 A string. Must be non-zero.
+ * @param s2 A string. Must be non-zero.
+ * @param size The number of bytes to compare.
+ * @return true if strings are equal; false otherwise.
+ */
+INLINE
+bool
+_memory_equal_small
+(   const void* s1
+,   const void* s2
+,   u64         size
+)
+{
+    const u8* const a = s1;
+    const u8* const b = s2;
+    if ( size >= 8 )
+    {
+        u64 a_head;
+        u64 a_tail;
+        u64 b_head;
+        u64 b_tail;
+        __builtin_memcpy ( &a_head , a , 8 );
+        __builtin_memcpy ( &a_tail , a + size - 8 , 8 );
+        __builtin_memcpy ( &b_head , b , 8 );
+        __builtin_memcpy ( &b_tail , b + size - 8 , 8 );
+        return !( ( a_head ^ b_head ) | ( a_tail ^ b_tail ) );
+    }
+    if ( size >= 4 )
+    {
+        u32 a_head;
+        u32 a_tail;
+        u32 b_head;
+        u32 b_tail;
+        __builtin_memcpy ( &a_head , a , 4 );
+        __builtin_memcpy ( &a_tail , a + size - 4 , 4 );
+        __builtin_memcpy ( &b_head , b , 4 );
+        __builtin_memcpy ( &b_tail , b + size - 4 , 4 );
+        return !( ( a_head ^ b_head ) | ( a_tail ^ b_tail ) );
+    }
+    if ( size )
+    {
+        return !( ( a[ 0 ] ^ b[ 0 ] )
+                | ( a[ size >> 1 ] ^ b[ size >> 1 ] )
+                | ( a[ size - 1 ] ^ b[ size - 1 ] )
+                );
+    }
+    return true;
+}
+
 /**
  * @brief Sets a block of memory.
  * 
  * @param memory The block to set. Must be non-zero.
+ * @param value The value to set.
  * @param size The block size in bytes.
  * @return memory.
  */
+INLINE
 void*
 memory_set
-(   void*   dst
+(   void*   memory
 ,   i32     value
 ,   u64     size
-);
+)
+{
+    if ( __builtin_constant_p ( size ) && size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_set_small ( memory , value , size );
+    }
+    return _memory_set ( memory , value , size );
+}
+
+/**
+ * @brief Clears a block of memory.
+ * 
+ * @param memory The block to clear. Must be non-zero.
+ * @param size The block size in bytes.
+ * @return memory.
+ */
+INLINE
+void*
+memory_clear
+(   void*   memory
+,   u64     size
+)
+{
+    return memory_set ( memory , 0 , size );
+}
 
 /**
  * @brief Copies a specified number of bytes of memory from a source block to a
@@ -153,17 +586,28 @@ memory_set
  * The size of both blocks should be adequate for the specified size parameter.
  * The source and destination blocks may not overlap.
  * 
+ * Copies of at least MEMORY_STREAM_THRESHOLD bytes bypass the cache, where the
+ * host platform supports it.
+ * 
  * @param dst The destination block. Must be non-zero.
  * @param src The source block. Must be non-zero.
  * @param size The number of bytes to copy.
  * @return dst.
  */
+INLINE
 void*
 memory_copy
 (   void*       dst
 ,   const void* src
 ,   u64         size
-);
+)
+{
+    if ( __builtin_constant_p ( size ) && size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_move_small ( dst , src , size );
+    }
+    return _memory_copy ( dst , src , size );
+}
 
 /**
  * @brief Moves a specified number of bytes of memory from a source block to a
@@ -177,12 +621,20 @@ memory_copy
  * @param size The number of bytes to move.
  * @return dst.
  */
+INLINE
 void*
 memory_move
 (   void*       dst
 ,   const void* src
 ,   u64         size
-);
+)
+{
+    if ( __builtin_constant_p ( size ) && size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_move_small ( dst , src , size );
+    }
+    return _memory_move ( dst , src , size );
+}
 
 /**
  * @brief Fixed-length string equality test predicate.
@@ -192,12 +644,20 @@ memory_move
  * @param size The number of bytes to compare.
  * @return true if strings are equal; false otherwise.
  */
+INLINE
 bool
 memory_equal
 (   const void* s1
 ,   const void* s2
 ,   u64         size
-);
+)
+{
+    if ( __builtin_constant_p ( size ) && size <= MEMORY_SMALL_SIZE )
+    {
+        return _memory_equal_small ( s1 , s2 , size );
+    }
+    return _memory_equal ( s1 , s2 , size );
+}
 
 /**
  * @brief Stringify utility.
@@ -211,6 +671,42 @@ char*
 memory_stat
 ( void );
 
+/**
+ * @brief Sets the memory statistics scope of the calling thread.
+ * 
+ * While a scope is set, every allocation and release made by the calling
+ * thread is also recorded in it, and memory_allocation_count, memory_free_count
+ * and memory_amount_allocated report the scope's counters instead of the global
+ * ones. This isolates the statistics of work running concurrently on different
+ * threads (e.g. tests; see test/test.h). memory_stat always reports the global
+ * statistics.
+ * 
+ * Threads do not inherit the scope of the thread which created them.
+ * 
+ * @param scope The scope (cleared by the caller), or 0 to record only the
+ * global statistics. Must remain valid until the scope is unset.
+ * @return The scope which was previously set (0 if none), so that scopes may
+ * be nested.
+ */
+memory_stat_scope_t*
+memory_stat_scope_set
+(   memory_stat_scope_t* scope
+);
+
+/**
+ * @brief Queries the external fragmentation of the free space of the global
+ * allocator (see dynamic_allocator_query_fragmentation): one minus the ratio
+ * of the largest free block to the total free space, across every heap.
+ * 
+ * Obtains every allocation lock in turn.
+ * 
+ * @return The fragmentation in [ 0 , 1 ] (0 if there is no free space, or if
+ * the memory subsystem is not running).
+ */
+f64
+memory_fragmentation
+( void );
+
 /**
  * @brief Queries the global allocation count.
  * 
@@ -242,4 +738,52 @@ memory_amount_allocated
 (   MEMORY_TAG tag
 );
 
+/**
+ * @brief Records the call site of the calling thread's next allocation (see
+ * MEMORY_PROFILE_ENABLED). Called by the allocation macros below; not intended
+ * to be called directly.
+ * 
+ * @param file The source file. Must have static storage duration.
+ * @param line The source line.
+ */
+void
+memory_profile_site
+(   const char* file
+,   u64         line
+);
+
+#if MEMORY_PROFILE_ENABLED == 1
+
+#define memory_allocate(size,tag)                                                            \
+    ( memory_profile_site ( __FILE__ , __LINE__ )                                            \
+    , memory_allocate ( (size) , (tag) )                                                     \
+    )
+
+#define memory_allocate_aligned(size,alignment,tag)                                          \
+    ( memory_profile_site ( __FILE__ , __LINE__ )                                            \
+    , memory_allocate_aligned ( (size) , (alignment) , (tag) )                               \
+    )
+
+#define memory_allocate_uninit(size,tag)                                                     \
+    ( memory_profile_site ( __FILE__ , __LINE__ )                                            \
+    , memory_allocate_uninit ( (size) , (tag) )                                              \
+    )
+
+#define memory_allocate_aligned_uninit(size,alignment,tag)                                   \
+    ( memory_profile_site ( __FILE__ , __LINE__ )                                            \
+    , memory_allocate_aligned_uninit ( (size) , (alignment) , (tag) )                        \
+    )
+
+#define memory_reallocate(memory,old_size,new_size,tag)                                      \
+    ( memory_profile_site ( __FILE__ , __LINE__ )                                            \
+    , memory_reallocate ( (memory) , (old_size) , (new_size) , (tag) )                       \
+    )
+
+#define memory_reallocate_aligned(memory,old_size,new_size,alignment,tag)                    \
+    ( memory_profile_site ( __FILE__ , __LINE__ )                                            \
+    , memory_reallocate_aligned ( (memory) , (old_size) , (new_size) , (alignment) , (tag) ) \
+    )
+
+#endif  // MEMORY_PROFILE_ENABLED
+
 #endif  // MEMORY_H
\ No newline at end of file
@@ -0,0 +1,649 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/metrics.c
+ * @brief Implementation of the core/metrics header.
+ * (see core/metrics.h for additional details)
+ */
+#include "core/metrics.h"
+
+#include "common/align.h"
+#include "common/bitops.h"
+#include "common/thread_local.h"
+
+#include "container/string.h"
+#include "container/string/format.h"
+
+#include "core/job.h"
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/string.h"
+
+#include "math/clamp.h"
+
+#include "platform/lock.h"
+
+/** @brief Index of the sum of the recorded values within a histogram's cells. */
+#define METRICS_HISTOGRAM_SUM METRICS_HISTOGRAM_BUCKET_COUNT
+
+/** @brief Index of the maximum recorded value within a histogram's cells. */
+#define METRICS_HISTOGRAM_MAX ( METRICS_HISTOGRAM_BUCKET_COUNT + 1 )
+
+/** @brief Number of cells taken by a histogram within each shard. */
+#define METRICS_HISTOGRAM_CELL_COUNT ( METRICS_HISTOGRAM_BUCKET_COUNT + 2 )
+
+/** @brief Type definition for a registered metric. */
+typedef struct
+{
+    char            name[ METRICS_NAME_MAX_LENGTH + 1 ];
+    METRICS_TYPE    type;
+
+    // Index of its first cell within each shard (counters and histograms).
+    u32             cell;
+}
+entry_t;
+
+/** @brief Type definition for metrics subsystem state. */
+typedef struct
+{
+    entry_t     entries[ METRICS_CAPACITY ];
+
+    // Published with release semantics, once the entry below it is written.
+    u32         count;
+
+    // Cells in use within each shard.
+    u32         cell_count;
+
+    // Guards registration.
+    lock_t      lock;
+
+    // Bit patterns of the values of the gauges, indexed by handle.
+    u64         gauges[ METRICS_CAPACITY ];
+
+    // METRICS_SHARD_COUNT shards of METRICS_SHARD_CAPACITY cells each.
+    u64*        shards;
+
+    u64         memory_requirement;
+    bool        owns_memory;
+}
+state_t;
+
+/** @brief Type definition for the name and kind of a built-in metric. */
+typedef struct
+{
+    const char*     name;
+    METRICS_TYPE    type;
+}
+builtin_t;
+
+/** @brief Built-in metrics, indexed by handle (see METRICS_BUILTIN). */
+static const builtin_t metrics_builtins[ METRICS_BUILTIN_COUNT ] = { { "memory.allocated_bytes"       , METRICS_TYPE_GAUGE     }
+                                                                   , { "memory.live_allocations"      , METRICS_TYPE_GAUGE     }
+                                                                   , { "memory.fragmentation"         , METRICS_TYPE_GAUGE     }
+                                                                   , { "memory.cache_hits"            , METRICS_TYPE_COUNTER   }
+                                                                   , { "memory.cache_misses"          , METRICS_TYPE_COUNTER   }
+                                                                   , { "logger.dropped"               , METRICS_TYPE_COUNTER   }
+                                                                   , { "logger.console_pending_bytes" , METRICS_TYPE_GAUGE     }
+                                                                   , { "logger.flush_ns"              , METRICS_TYPE_HISTOGRAM }
+                                                                   , { "file.bytes_read"              , METRICS_TYPE_COUNTER   }
+                                                                   , { "file.bytes_written"           , METRICS_TYPE_COUNTER   }
+                                                                   , { "job.workers"                  , METRICS_TYPE_GAUGE     }
+                                                                   , { "job.pending"                  , METRICS_TYPE_GAUGE     }
+                                                                   , { "job.run_ns"                   , METRICS_TYPE_HISTOGRAM }
+                                                                   };
+
+/** @brief Metrics subsystem state. */
+static state_t* state = 0;
+
+/** @brief Allocates shards to threads (round-robin). */
+static u64 shard_next = 0;
+
+/** @brief Shard index of the calling thread (plus one; zero if unassigned). */
+static THREAD_LOCAL u64 thread_shard = 0;
+
+/**
+ * @brief Fetches the cells of a metric within the calling thread's shard.
+ *
+ * @param metric Handle to the metric.
+ * @param type The kind of metric expected.
+ * @return The cells; 0 if the metrics subsystem is not running, or if metric
+ * is not a registered metric of the expected kind.
+ */
+static u64*
+metrics_cells
+(   const metric_t      metric
+,   const METRICS_TYPE  type
+)
+{
+    state_t* metrics = atomic_load_ptr ( ( void* const* ) &state , ATOMIC_ACQUIRE );
+    if (   !metrics
+        || metric >= atomic_load_u32 ( &( *metrics ).count , ATOMIC_ACQUIRE )
+        || ( *metrics ).entries[ metric ].type != type
+       )
+    {
+        return 0;
+    }
+    if ( !thread_shard )
+    {
+        thread_shard = atomic_fetch_add_u64 ( &shard_next , 1 , ATOMIC_RELAXED )
+                     % METRICS_SHARD_COUNT
+                     + 1
+                     ;
+    }
+    return ( *metrics ).shards
+         + ( thread_shard - 1 ) * METRICS_SHARD_CAPACITY
+         + ( *metrics ).entries[ metric ].cell
+         ;
+}
+
+/**
+ * @brief Computes the histogram bucket which holds a value.
+ *
+ * Values below 2 * METRICS_HISTOGRAM_SUB_BUCKET_COUNT have a bucket each;
+ * above that, each power of two is split into METRICS_HISTOGRAM_SUB_BUCKET_COUNT
+ * buckets of equal width, indexed by the bits following the most significant.
+ *
+ * @param value The value.
+ * @return The index of the bucket.
+ */
+INLINE
+u64
+metrics_histogram_bucket
+(   const u64 value
+)
+{
+    if ( value < METRICS_HISTOGRAM_SUB_BUCKET_COUNT )
+    {
+        return value;
+    }
+    const u64 shift = bitscan_reverse ( value ) - METRICS_HISTOGRAM_SUB_BUCKET_BITS;
+    return ( shift + 1 ) * METRICS_HISTOGRAM_SUB_BUCKET_COUNT
+         + ( ( value >> shift ) & ( METRICS_HISTOGRAM_SUB_BUCKET_COUNT - 1 ) )
+         ;
+}
+
+/**
+ * @brief Computes the largest value held by a histogram bucket (see
+ * metrics_histogram_bucket).
+ *
+ * @param bucket The index of the bucket.
+ * @return The largest value which maps to bucket.
+ */
+INLINE
+u64
+metrics_histogram_bucket_max
+(   const u64 bucket
+)
+{
+    if ( bucket < METRICS_HISTOGRAM_SUB_BUCKET_COUNT )
+    {
+        return bucket;
+    }
+    const u64 shift = bucket / METRICS_HISTOGRAM_SUB_BUCKET_COUNT - 1;
+    return ( ( METRICS_HISTOGRAM_SUB_BUCKET_COUNT + bucket % METRICS_HISTOGRAM_SUB_BUCKET_COUNT ) << shift )
+         + ( ( ( u64 ) 1 ) << shift ) - 1
+         ;
+}
+
+/**
+ * @brief Computes a quantile of the values recorded into a histogram.
+ *
+ * @param buckets The bucket counts.
+ * @param count The number of values recorded (the sum of the bucket counts).
+ * @param max The largest value recorded.
+ * @param numerator The quantile, as a fraction (e.g. 99 / 100).
+ * @param denominator The quantile, as a fraction.
+ * @return The largest value held by the bucket which holds the quantile, or
+ * max if smaller; 0 if no values were recorded.
+ */
+static u64
+metrics_histogram_quantile
+(   const u64*  buckets
+,   const u64   count
+,   const u64   max
+,   const u64   numerator
+,   const u64   denominator
+)
+{
+    if ( !count )
+    {
+        return 0;
+    }
+
+    // Rank (1-based) of the quantile among the recorded values.
+    const u64 rank = ( count * numerator + denominator - 1 ) / denominator;
+
+    u64 seen = 0;
+    for ( u64 i = 0; i < METRICS_HISTOGRAM_BUCKET_COUNT; ++i )
+    {
+        seen += buckets[ i ];
+        if ( seen >= rank )
+        {
+            return MIN ( metrics_histogram_bucket_max ( i ) , max );
+        }
+    }
+    return max;
+}
+
+/**
+ * @brief Validates a metric name (see metrics_register).
+ *
+ * @param name The name. Must be non-zero.
+ * @return The length of name if valid; 0 otherwise.
+ */
+static u64
+metrics_name_length
+(   const char* name
+)
+{
+    u64 length = 0;
+    for ( ; name[ length ]; ++length )
+    {
+        const char c = name[ length ];
+        if (   length == METRICS_NAME_MAX_LENGTH
+            || !( ( c >= 'a' && c <= 'z' ) || ( c >= '0' && c <= '9' ) || c == '_' || c == '.' )
+           )
+        {
+            return 0;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Reads the current value of a metric. Assumes the metrics subsystem
+ * is running.
+ *
+ * @param metric Handle to a registered metric.
+ * @param value Output buffer for the value.
+ */
+static void
+metrics_read
+(   const metric_t      metric
+,   metrics_value_t*    value
+)
+{
+    const entry_t* entry = &( *state ).entries[ metric ];
+    memory_clear ( value , sizeof ( metrics_value_t ) );
+    memory_copy ( ( *value ).name , ( *entry ).name , sizeof ( ( *value ).name ) );
+    ( *value ).type = ( *entry ).type;
+
+    if ( ( *entry ).type == METRICS_TYPE_GAUGE )
+    {
+        const u64 bits = atomic_load_u64 ( &( *state ).gauges[ metric ] , ATOMIC_RELAXED );
+        memory_copy ( &( *value ).value , &bits , sizeof ( f64 ) );
+        return;
+    }
+
+    if ( ( *entry ).type == METRICS_TYPE_COUNTER )
+    {
+        for ( u64 i = 0; i < METRICS_SHARD_COUNT; ++i )
+        {
+            const u64* cells = ( *state ).shards + i * METRICS_SHARD_CAPACITY + ( *entry ).cell;
+            ( *value ).count += atomic_load_u64 ( cells , ATOMIC_RELAXED );
+        }
+        return;
+    }
+
+    u64 buckets[ METRICS_HISTOGRAM_BUCKET_COUNT ] = { 0 };
+    for ( u64 i = 0; i < METRICS_SHARD_COUNT; ++i )
+    {
+        const u64* cells = ( *state ).shards + i * METRICS_SHARD_CAPACITY + ( *entry ).cell;
+        for ( u64 j = 0; j < METRICS_HISTOGRAM_BUCKET_COUNT; ++j )
+        {
+            buckets[ j ] += atomic_load_u64 ( &cells[ j ] , ATOMIC_RELAXED );
+        }
+        ( *value ).sum += atomic_load_u64 ( &cells[ METRICS_HISTOGRAM_SUM ] , ATOMIC_RELAXED );
+        ( *value ).max = MAX ( ( *value ).max
+                             , atomic_load_u64 ( &cells[ METRICS_HISTOGRAM_MAX ] , ATOMIC_RELAXED )
+                             );
+    }
+    for ( u64 j = 0; j < METRICS_HISTOGRAM_BUCKET_COUNT; ++j )
+    {
+        ( *value ).count += buckets[ j ];
+    }
+    ( *value ).p50 = metrics_histogram_quantile ( buckets , ( *value ).count , ( *value ).max , 50 , 100 );
+    ( *value ).p90 = metrics_histogram_quantile ( buckets , ( *value ).count , ( *value ).max , 90 , 100 );
+    ( *value ).p99 = metrics_histogram_quantile ( buckets , ( *value ).count , ( *value ).max , 99 , 100 );
+    ( *value ).p999 = metrics_histogram_quantile ( buckets , ( *value ).count , ( *value ).max , 999 , 1000 );
+}
+
+/**
+ * @brief Reads the sampled built-in gauges from their subsystems (see
+ * METRICS_BUILTIN).
+ */
+static void
+metrics_sample
+( void )
+{
+    metrics_gauge_set ( METRICS_MEMORY_ALLOCATED , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    metrics_gauge_set ( METRICS_MEMORY_ALLOCATIONS , MEMORY_ALLOCATION_COUNT );
+    metrics_gauge_set ( METRICS_MEMORY_FRAGMENTATION , memory_fragmentation () );
+    metrics_gauge_set ( METRICS_LOGGER_CONSOLE_PENDING , logger_console_pending () );
+    metrics_gauge_set ( METRICS_JOB_WORKERS , job_system_worker_count () );
+    metrics_gauge_set ( METRICS_JOB_PENDING , job_system_pending_count () );
+}
+
+bool
+metrics_startup
+(   u64*    memory_requirement_
+,   void*   memory_
+)
+{
+    if ( state )
+    {
+        LOGERROR ( "metrics_startup: Called more than once." );
+        return false;
+    }
+
+    const u64 state_memory_requirement = aligned ( sizeof ( state_t ) , CACHE_LINE_SIZE );
+    const u64 memory_requirement = state_memory_requirement
+                                 + METRICS_SHARD_COUNT * METRICS_SHARD_CAPACITY * sizeof ( u64 )
+                                 ;
+
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_aligned_uninit ( memory_requirement
+                                                , CACHE_LINE_SIZE
+                                                , MEMORY_TAG_METRICS
+                                                );
+    }
+    memory_clear ( memory , memory_requirement );
+
+    state_t* metrics = memory;
+    ( *metrics ).shards = ( void* )( ( ( u64 ) memory ) + state_memory_requirement );
+    ( *metrics ).memory_requirement = memory_requirement;
+    ( *metrics ).owns_memory = !memory_;
+    atomic_store_ptr ( ( void** ) &state , metrics , ATOMIC_RELEASE );
+
+    // Built-in metrics are registered first, so that their handles are known
+    // in advance.
+    metric_t metric;
+    for ( u32 i = 0; i < METRICS_BUILTIN_COUNT; ++i )
+    {
+        metrics_register ( metrics_builtins[ i ].name , metrics_builtins[ i ].type , &metric );
+    }
+
+    return true;
+}
+
+void
+metrics_shutdown
+( void )
+{
+    if ( !state )
+    {
+        return;
+    }
+
+    state_t* metrics = state;
+    atomic_store_ptr ( ( void** ) &state , 0 , ATOMIC_RELEASE );
+
+    const u64 memory_requirement = ( *metrics ).memory_requirement;
+    if ( ( *metrics ).owns_memory )
+    {
+        memory_free_aligned ( metrics
+                            , memory_requirement
+                            , CACHE_LINE_SIZE
+                            , MEMORY_TAG_METRICS
+                            );
+    }
+    else
+    {
+        memory_clear ( metrics , memory_requirement );
+    }
+}
+
+bool
+metrics_running
+( void )
+{
+    return atomic_load_ptr ( ( void* const* ) &state , ATOMIC_RELAXED ) != 0;
+}
+
+bool
+metrics_register
+(   const char*         name
+,   const METRICS_TYPE  type
+,   metric_t*           metric
+)
+{
+    if ( !state )
+    {
+        LOGERROR ( "metrics_register: The metrics subsystem is not running." );
+        return false;
+    }
+    if ( !name || !metric )
+    {
+        if ( !name )
+        {
+            LOGERROR ( "metrics_register: Missing argument: name." );
+        }
+        if ( !metric )
+        {
+            LOGERROR ( "metrics_register: Missing argument: metric (output buffer)." );
+        }
+        return false;
+    }
+    const u64 length = metrics_name_length ( name );
+    if ( !length )
+    {
+        LOGERROR ( "metrics_register: Invalid metric name: `%s`. Must be 1 to %u lowercase letters, digits, '_' or '.' characters."
+                 , name , METRICS_NAME_MAX_LENGTH
+                 );
+        return false;
+    }
+    if ( type > METRICS_TYPE_HISTOGRAM )
+    {
+        LOGERROR ( "metrics_register: Invalid metric type: %u." , type );
+        return false;
+    }
+
+    lock_acquire ( &( *state ).lock );
+
+    const u32 count = ( *state ).count;
+    for ( u32 i = 0; i < count; ++i )
+    {
+        if ( _string_equal ( ( *state ).entries[ i ].name , name ) )
+        {
+            const bool match = ( *state ).entries[ i ].type == type;
+            lock_release ( &( *state ).lock );
+            if ( !match )
+            {
+                LOGERROR ( "metrics_register: Metric %s is already registered as a different type."
+                         , name
+                         );
+                return false;
+            }
+            *metric = i;
+            return true;
+        }
+    }
+
+    const u32 cell_count = ( type == METRICS_TYPE_COUNTER )   ? 1
+                         : ( type == METRICS_TYPE_HISTOGRAM ) ? METRICS_HISTOGRAM_CELL_COUNT
+                         :                                      0
+                         ;
+    if (   count == METRICS_CAPACITY
+        || ( *state ).cell_count + cell_count > METRICS_SHARD_CAPACITY
+       )
+    {
+        lock_release ( &( *state ).lock );
+        LOGERROR ( "metrics_register: Cannot register %s: the registry is full."
+                 , name
+                 );
+        return false;
+    }
+
+    entry_t* entry = &( *state ).entries[ count ];
+    memory_copy ( ( *entry ).name , name , length + 1 );
+    ( *entry ).type = type;
+    ( *entry ).cell = ( *state ).cell_count;
+    ( *state ).cell_count += cell_count;
+    atomic_store_u32 ( &( *state ).count , count + 1 , ATOMIC_RELEASE );
+
+    lock_release ( &( *state ).lock );
+
+    *metric = count;
+    return true;
+}
+
+void
+metrics_counter_add
+(   const metric_t  metric
+,   const u64       amount
+)
+{
+    u64* cells = metrics_cells ( metric , METRICS_TYPE_COUNTER );
+    if ( cells )
+    {
+        atomic_fetch_add_u64 ( cells , amount , ATOMIC_RELAXED );
+    }
+}
+
+void
+metrics_gauge_set
+(   const metric_t  metric
+,   const f64       value
+)
+{
+    state_t* metrics = atomic_load_ptr ( ( void* const* ) &state , ATOMIC_ACQUIRE );
+    if (   !metrics
+        || metric >= atomic_load_u32 ( &( *metrics ).count , ATOMIC_ACQUIRE )
+        || ( *metrics ).entries[ metric ].type != METRICS_TYPE_GAUGE
+       )
+    {
+        return;
+    }
+    u64 bits;
+    memory_copy ( &bits , &value , sizeof ( u64 ) );
+    atomic_store_u64 ( &( *metrics ).gauges[ metric ] , bits , ATOMIC_RELAXED );
+}
+
+void
+metrics_histogram_record
+(   const metric_t  metric
+,   const u64       value
+)
+{
+    u64* cells = metrics_cells ( metric , METRICS_TYPE_HISTOGRAM );
+    if ( !cells )
+    {
+        return;
+    }
+    atomic_fetch_add_u64 ( &cells[ metrics_histogram_bucket ( value ) ] , 1 , ATOMIC_RELAXED );
+    atomic_fetch_add_u64 ( &cells[ METRICS_HISTOGRAM_SUM ] , value , ATOMIC_RELAXED );
+
+    u64 max = atomic_load_u64 ( &cells[ METRICS_HISTOGRAM_MAX ] , ATOMIC_RELAXED );
+    while ( value > max && !atomic_compare_exchange_u64 ( &cells[ METRICS_HISTOGRAM_MAX ]
+                                                        , &max
+                                                        , value
+                                                        , ATOMIC_RELAXED
+                                                        , ATOMIC_RELAXED
+                                                        ));
+}
+
+u64
+metrics_snapshot
+(   metrics_value_t*    values
+,   const u64           capacity
+)
+{
+    if ( !state )
+    {
+        LOGERROR ( "metrics_snapshot: The metrics subsystem is not running." );
+        return 0;
+    }
+
+    const u64 count = atomic_load_u32 ( &( *state ).count , ATOMIC_ACQUIRE );
+    if ( !values )
+    {
+        return count;
+    }
+
+    metrics_sample ();
+    for ( u64 i = 0; i < count && i < capacity; ++i )
+    {
+        metrics_read ( i , &values[ i ] );
+    }
+    return count;
+}
+
+char*
+metrics_json
+( void )
+{
+    if ( !state )
+    {
+        LOGERROR ( "metrics_json: The metrics subsystem is not running." );
+        return 0;
+    }
+
+    metrics_sample ();
+
+    char* string = string_create ();
+    _string_push ( string , "{" );
+    const u64 count = atomic_load_u32 ( &( *state ).count , ATOMIC_ACQUIRE );
+    for ( u64 i = 0; i < count; ++i )
+    {
+        metrics_value_t value;
+        metrics_read ( i , &value );
+
+        // Metric names need no escaping (see metrics_register).
+        string_format_append ( string
+                             , "%s\"%s\":{\"type\":"
+                             , i ? "\n," : ""
+                             , value.name
+                             );
+        switch ( value.type )
+        {
+            case METRICS_TYPE_COUNTER:
+            {
+                string_format_append ( string
+                                     , "\"counter\",\"value\":%u}"
+                                     , value.count
+                                     );
+            }
+            break;
+
+            case METRICS_TYPE_GAUGE:
+            {
+                string_format_append ( string
+                                     , "\"gauge\",\"value\":%.6F}"
+                                     , &value.value
+                                     );
+            }
+            break;
+
+            case METRICS_TYPE_HISTOGRAM:
+            {
+                string_format_append ( string
+                                     , "\"histogram\",\"count\":%u,\"sum\":%u,\"max\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"p999\":%u}"
+                                     , value.count
+                                     , value.sum
+                                     , value.max
+                                     , value.p50
+                                     , value.p90
+                                     , value.p99
+                                     , value.p999
+                                     );
+            }
+            break;
+        }
+    }
+    _string_push ( string , "\n}\n" );
+    return string;
+}
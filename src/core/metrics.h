@@ -0,0 +1,275 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/metrics.h
+ * @brief Provides an interface for a registry of runtime metrics: counters,
+ * gauges and latency histograms, which may be read at any time as a snapshot
+ * (see metrics_snapshot) or as JSON (see metrics_json).
+ *
+ * A metric is registered once by name, and then updated through the handle
+ * returned by metrics_register:
+ *
+ *   metric_t requests;
+ *   metrics_register ( "server.requests" , METRICS_TYPE_COUNTER , &requests );
+ *   ...
+ *   metrics_counter_add ( requests , 1 );
+ *
+ * Counters and histograms are recorded into one of METRICS_SHARD_COUNT shards,
+ * assigned to threads round-robin, so that threads updating the same metric
+ * rarely contend for the same cache lines; a snapshot sums the shards. Every
+ * update is a relaxed atomic operation, and never takes a lock or allocates
+ * memory. Updates are no-ops while the metrics subsystem is not running, so
+ * instrumented code need not check for it.
+ *
+ * Histograms are log-linear (as in HdrHistogram): each power of two is split
+ * into METRICS_HISTOGRAM_SUB_BUCKET_COUNT buckets of equal width, so that any
+ * value is bucketed with a relative error of at most 1/8, over the whole u64
+ * range.
+ *
+ * The subsystems of the library feed the built-in metrics (see
+ * METRICS_BUILTIN), which metrics_startup registers ahead of any others.
+ */
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "common.h"
+
+/** @brief Maximum number of registered metrics (including the built-in ones). */
+#define METRICS_CAPACITY 256
+
+/** @brief Maximum length of a metric name. */
+#define METRICS_NAME_MAX_LENGTH 63
+
+/** @brief Number of shards which counters and histograms are recorded into. */
+#define METRICS_SHARD_COUNT 16
+
+/**
+ * @brief Size of each shard (in u64 cells). A counter takes a single cell,
+ * and a histogram takes METRICS_HISTOGRAM_BUCKET_COUNT + 2; gauges take none.
+ */
+#define METRICS_SHARD_CAPACITY 8192
+
+/** @brief Number of histogram buckets per power of two (log2). */
+#define METRICS_HISTOGRAM_SUB_BUCKET_BITS 3
+
+/** @brief Number of histogram buckets per power of two. */
+#define METRICS_HISTOGRAM_SUB_BUCKET_COUNT \
+    ( 1 << METRICS_HISTOGRAM_SUB_BUCKET_BITS )
+
+/** @brief Number of histogram buckets spanning every u64 value. */
+#define METRICS_HISTOGRAM_BUCKET_COUNT                              \
+    ( ( 64 - METRICS_HISTOGRAM_SUB_BUCKET_BITS + 1 )                \
+    * METRICS_HISTOGRAM_SUB_BUCKET_COUNT                            \
+    )
+
+/** @brief Type and instance definitions for the kinds of metric. */
+typedef enum
+{
+    // Monotonic total (e.g. bytes written).
+    METRICS_TYPE_COUNTER
+
+    // Most recent value (e.g. queue depth).
+,   METRICS_TYPE_GAUGE
+
+    // Distribution of recorded values (e.g. latencies in nanoseconds).
+,   METRICS_TYPE_HISTOGRAM
+}
+METRICS_TYPE;
+
+/** @brief Type definition for a handle to a registered metric. */
+typedef u32 metric_t;
+
+/**
+ * @brief Handles of the built-in metrics.
+ *
+ * Gauges marked as sampled are read from their subsystems by metrics_snapshot
+ * and metrics_json, rather than updated as they change. Job system utilization
+ * is the rate of increase of the sum of METRICS_JOB_RUN_TIME, divided by the
+ * number of worker threads.
+ */
+typedef enum
+{
+    METRICS_MEMORY_ALLOCATED            // memory.allocated_bytes        gauge (sampled)
+,   METRICS_MEMORY_ALLOCATIONS          // memory.live_allocations       gauge (sampled)
+,   METRICS_MEMORY_FRAGMENTATION        // memory.fragmentation          gauge (sampled; see memory_fragmentation)
+,   METRICS_MEMORY_CACHE_HITS           // memory.cache_hits             counter (per-thread allocation cache)
+,   METRICS_MEMORY_CACHE_MISSES         // memory.cache_misses           counter
+,   METRICS_LOGGER_DROPPED              // logger.dropped                counter (see logger_dropped_count)
+,   METRICS_LOGGER_CONSOLE_PENDING      // logger.console_pending_bytes  gauge (sampled; see logger_console_pending)
+,   METRICS_LOGGER_FLUSH_TIME           // logger.flush_ns               histogram (see logger_flush)
+,   METRICS_FILE_BYTES_READ             // file.bytes_read               counter
+,   METRICS_FILE_BYTES_WRITTEN          // file.bytes_written            counter
+,   METRICS_JOB_WORKERS                 // job.workers                   gauge (sampled)
+,   METRICS_JOB_PENDING                 // job.pending                   gauge (sampled; see job_system_pending_count)
+,   METRICS_JOB_RUN_TIME                // job.run_ns                    histogram (each run of a job)
+
+,   METRICS_BUILTIN_COUNT
+}
+METRICS_BUILTIN;
+
+/** @brief Type definition for the value of a metric in a snapshot. */
+typedef struct
+{
+    char            name[ METRICS_NAME_MAX_LENGTH + 1 ];
+    METRICS_TYPE    type;
+
+    // Counter: the total. Histogram: the number of recorded values.
+    u64             count;
+
+    // Gauge: the value.
+    f64             value;
+
+    // Histogram: the sum and maximum of the recorded values, and quantiles
+    // (the upper bound of the bucket which holds each; at most max).
+    u64             sum;
+    u64             max;
+    u64             p50;
+    u64             p90;
+    u64             p99;
+    u64             p999;
+}
+metrics_value_t;
+
+/**
+ * @brief Initializes the metrics subsystem, and registers the built-in
+ * metrics (see METRICS_BUILTIN).
+ *
+ * Call metrics_shutdown to terminate.
+ *
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size. The buffer should be aligned to
+ *   a cache line (64 bytes) to avoid false sharing.
+ *
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h).
+ *
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required to operate the metrics subsystem. Only applicable if pre-allocating
+ * a memory buffer of the required size. Pass 0 to use implicit memory
+ * allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @return true on success; false otherwise.
+ */
+bool
+metrics_startup
+(   u64*    memory_requirement
+,   void*   memory
+);
+
+/**
+ * @brief Terminates the metrics subsystem. Every handle is invalidated.
+ *
+ * Other threads must not be updating metrics meanwhile (in particular, stop
+ * the job system first).
+ */
+void
+metrics_shutdown
+( void );
+
+/**
+ * @brief Queries whether the metrics subsystem is running, so that an
+ * instrumented hot path may skip measuring (e.g. reading a clock) when it is
+ * not. O(1).
+ *
+ * @return true if the metrics subsystem is running; false otherwise.
+ */
+bool
+metrics_running
+( void );
+
+/**
+ * @brief Registers a metric, or looks up a metric which is already registered
+ * under the same name and type. Thread-safe. O(n).
+ *
+ * @param name The metric name: 1 to METRICS_NAME_MAX_LENGTH lowercase letters,
+ * digits, '_' or '.' characters (so that it needs no escaping in JSON). Must
+ * be non-zero.
+ * @param type The kind of metric.
+ * @param metric Output buffer for the handle. Must be non-zero.
+ * @return true on success; false if the name is invalid or registered as a
+ * different type, or if the registry is full.
+ */
+bool
+metrics_register
+(   const char*         name
+,   const METRICS_TYPE  type
+,   metric_t*           metric
+);
+
+/**
+ * @brief Adds to a counter. O(1).
+ *
+ * @param metric Handle to a counter.
+ * @param amount The amount to add.
+ */
+void
+metrics_counter_add
+(   const metric_t  metric
+,   const u64       amount
+);
+
+/**
+ * @brief Sets a gauge. O(1).
+ *
+ * @param metric Handle to a gauge.
+ * @param value The value. Must be finite (JSON has no representation for NaN
+ * or infinity).
+ */
+void
+metrics_gauge_set
+(   const metric_t  metric
+,   const f64       value
+);
+
+/**
+ * @brief Records a value into a histogram. O(1).
+ *
+ * @param metric Handle to a histogram.
+ * @param value The value (e.g. a latency in nanoseconds).
+ */
+void
+metrics_histogram_record
+(   const metric_t  metric
+,   const u64       value
+);
+
+/**
+ * @brief Reads the current value of every registered metric, in order of
+ * registration (the built-in metrics first). O(n).
+ *
+ * Concurrent updates may or may not be reflected; each value is read
+ * atomically, but the snapshot as a whole is not.
+ *
+ * @param values Output buffer for the values, or 0 to query the number of
+ * registered metrics.
+ * @param capacity The number of values which fit in values.
+ * @return The number of registered metrics (values holds the first capacity
+ * of them, if fewer); 0 if the metrics subsystem is not running.
+ */
+u64
+metrics_snapshot
+(   metrics_value_t*    values
+,   const u64           capacity
+);
+
+/**
+ * @brief Formats a snapshot of every registered metric (see metrics_snapshot)
+ * as a JSON object, with one member per metric:
+ *
+ *   {"file.bytes_read":{"type":"counter","value":4096}
+ *   ,"job.workers":{"type":"gauge","value":7.000000}
+ *   ,"job.run_ns":{"type":"histogram","count":2,"sum":1500,"max":1000,"p50":511,"p90":1000,"p99":1000,"p999":1000}
+ *   }
+ *
+ * Uses dynamic memory allocation. Call string_destroy to free.
+ *
+ * @return A resizable string (see container/string.h); 0 if the metrics
+ * subsystem is not running.
+ */
+char*
+metrics_json
+( void );
+
+#endif  // METRICS_H
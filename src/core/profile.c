@@ -0,0 +1,305 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/profile.c
+ * @brief Implementation of the core/profile header.
+ * (see core/profile.h for additional details)
+ */
+#include "core/profile.h"
+
+#include "container/string.h"
+#include "container/string/format.h"
+
+#include "core/clock.h"
+#include "core/logger.h"
+
+#include "platform/filesystem.h"
+#include "platform/platform.h"
+
+/** @brief Type definition for a recorded profiling zone. */
+typedef struct
+{
+    const char* name;
+    u64         begin;
+    u64         end;
+}
+profile_event_t;
+
+/**
+ * @brief Type definition for a thread's profiling buffer. Only the owning
+ * thread writes events; count is published with release semantics, so any
+ * thread may read the events below it.
+ */
+typedef struct profile_buffer_t
+{
+    struct profile_buffer_t*    next;
+    u64                         thread_id;
+    u32                         index;      // Position in the trace (1-based).
+    u64                         count;      // Total events recorded (including overwritten ones).
+    profile_event_t             events[ PROFILE_BUFFER_CAPACITY ];
+}
+profile_buffer_t;
+
+// Global state.
+static u32                  profile_recording_ = false;
+static u64                  profile_origin = 0;
+static profile_buffer_t*    profile_buffers = 0;
+static u32                  profile_buffer_count = 0;
+static u32                  profile_generation = 0;
+
+// Per-thread state.
+static THREAD_LOCAL profile_buffer_t*   profile_buffer = 0;
+static THREAD_LOCAL u32                 profile_buffer_generation = 0;
+static THREAD_LOCAL bool                profile_suspended = false;
+
+/**
+ * @brief Creates a profiling buffer for the calling thread, and links it into
+ * the global list of buffers.
+ *
+ * Allocated directly from the host platform, so that recording is not itself
+ * visible to the memory subsystem (see core/memory.h), which is profiled.
+ *
+ * @return The calling thread's buffer, on success. 0, on error.
+ */
+profile_buffer_t*
+_profile_buffer_create
+( void );
+
+/**
+ * @brief Appends a string to a JSON string, as a quoted JSON string literal.
+ *
+ * @param string A resizable string.
+ * @param value A null-terminated string.
+ * @return string, possibly reallocated.
+ */
+char*
+_profile_quote
+(   char*       string
+,   const char* value
+);
+
+void
+profile_start
+( void )
+{
+    atomic_store_u64 ( &profile_origin , clock_ticks () , ATOMIC_RELAXED );
+    atomic_store_u32 ( &profile_recording_ , true , ATOMIC_RELEASE );
+}
+
+void
+profile_stop
+( void )
+{
+    atomic_store_u32 ( &profile_recording_ , false , ATOMIC_RELEASE );
+}
+
+bool
+profile_recording
+( void )
+{
+    return atomic_load_u32 ( &profile_recording_ , ATOMIC_ACQUIRE );
+}
+
+void
+profile_clear
+( void )
+{
+    profile_buffer_t* buffer = atomic_load_ptr ( ( void* const* ) &profile_buffers
+                                               , ATOMIC_ACQUIRE
+                                               );
+    for ( ; buffer; buffer = ( *buffer ).next )
+    {
+        atomic_store_u64 ( &( *buffer ).count , 0 , ATOMIC_RELEASE );
+    }
+}
+
+void
+profile_shutdown
+( void )
+{
+    profile_buffer_t* buffer = atomic_exchange_ptr ( ( void** ) &profile_buffers
+                                                   , 0
+                                                   , ATOMIC_ACQ_REL
+                                                   );
+    while ( buffer )
+    {
+        profile_buffer_t* next = ( *buffer ).next;
+        platform_memory_free ( buffer );
+        buffer = next;
+    }
+    atomic_store_u32 ( &profile_buffer_count , 0 , ATOMIC_RELAXED );
+
+    // Threads compare against the generation before reusing their buffers.
+    atomic_fetch_add_u32 ( &profile_generation , 1 , ATOMIC_RELEASE );
+}
+
+profile_zone_t
+profile_zone_begin
+(   const char* name
+)
+{
+    profile_zone_t zone;
+    zone.name = name;
+    zone.begin = clock_ticks ();
+    return zone;
+}
+
+void
+profile_zone_end
+(   profile_zone_t* zone
+)
+{
+    if ( !atomic_load_u32 ( &profile_recording_ , ATOMIC_RELAXED ) || profile_suspended )
+    {
+        return;
+    }
+    const u64 end = clock_ticks ();
+
+    profile_buffer_t* buffer = profile_buffer;
+    if ( !buffer || profile_buffer_generation != atomic_load_u32 ( &profile_generation
+                                                                 , ATOMIC_ACQUIRE
+                                                                 ))
+    {
+        buffer = _profile_buffer_create ();
+        if ( !buffer )
+        {
+            return;
+        }
+    }
+
+    const u64 count = ( *buffer ).count;
+    profile_event_t* event = &( *buffer ).events[ count % PROFILE_BUFFER_CAPACITY ];
+    ( *event ).name = ( *zone ).name;
+    ( *event ).begin = ( *zone ).begin;
+    ( *event ).end = end;
+    atomic_store_u64 ( &( *buffer ).count , count + 1 , ATOMIC_RELEASE );
+}
+
+bool
+profile_write
+(   const char* path
+)
+{
+    if ( !path )
+    {
+        LOGERROR ( "profile_write: Missing argument: path (file to write to)." );
+        return false;
+    }
+
+    // Formatting the trace would otherwise record zones into the buffer being
+    // read.
+    const bool suspended = profile_suspended;
+    profile_suspended = true;
+
+    const u64 origin = atomic_load_u64 ( &profile_origin , ATOMIC_RELAXED );
+    bool first = true;
+
+    char* string = string_create ();
+    _string_push ( string , "{\"traceEvents\":[\n" );
+    profile_buffer_t* buffer = atomic_load_ptr ( ( void* const* ) &profile_buffers
+                                               , ATOMIC_ACQUIRE
+                                               );
+    for ( ; buffer; buffer = ( *buffer ).next )
+    {
+        const u64 count = atomic_load_u64 ( &( *buffer ).count , ATOMIC_ACQUIRE );
+        if ( !count )
+        {
+            continue;
+        }
+
+        // Name the thread after its platform identifier.
+        string_format_append ( string
+                             , "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}"
+                             , first ? "" : ",\n"
+                             , ( *buffer ).index
+                             , ( *buffer ).thread_id
+                             );
+        first = false;
+
+        const u64 oldest = ( count > PROFILE_BUFFER_CAPACITY ) ? count - PROFILE_BUFFER_CAPACITY
+                                                               : 0
+                                                               ;
+        for ( u64 i = oldest; i < count; ++i )
+        {
+            const profile_event_t* event = &( *buffer ).events[ i % PROFILE_BUFFER_CAPACITY ];
+
+            // Zones opened before profile_start are clipped to it.
+            const u64 begin = ( ( *event ).begin > origin ) ? ( *event ).begin - origin : 0;
+            const u64 end = ( ( *event ).end > origin ) ? ( *event ).end - origin : 0;
+            const f64 timestamp = clock_ticks_to_ns ( begin ) / 1000.0;
+            const f64 duration = clock_ticks_to_ns ( end - begin ) / 1000.0;
+
+            _string_push ( string , ",\n{\"name\":" );
+            string = _profile_quote ( string , ( *event ).name );
+            string_format_append ( string
+                                 , ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}"
+                                 , &timestamp
+                                 , &duration
+                                 , ( *buffer ).index
+                                 );
+        }
+    }
+    _string_push ( string , "\n]}\n" );
+
+    file_t file;
+    u64 written = 0;
+    bool success = file_open ( path , FILE_MODE_WRITE , &file );
+    if ( success )
+    {
+        success = file_write ( &file , string_length ( string ) , string , &written );
+        file_close ( &file );
+    }
+    if ( !success )
+    {
+        LOGERROR ( "profile_write: Failed to write trace to file: %s" , path );
+    }
+    string_destroy ( string );
+
+    profile_suspended = suspended;
+    return success;
+}
+
+profile_buffer_t*
+_profile_buffer_create
+( void )
+{
+    profile_buffer_t* buffer = platform_memory_allocate ( sizeof ( profile_buffer_t ) );
+    if ( !buffer )
+    {
+        return 0;
+    }
+    ( *buffer ).thread_id = platform_thread_id ();
+    ( *buffer ).index = atomic_fetch_add_u32 ( &profile_buffer_count , 1 , ATOMIC_RELAXED ) + 1;
+    ( *buffer ).count = 0;
+
+    // Lock-free push onto the front of the list.
+    ( *buffer ).next = atomic_load_ptr ( ( void* const* ) &profile_buffers , ATOMIC_RELAXED );
+    while ( !atomic_compare_exchange_ptr ( ( void** ) &profile_buffers
+                                         , ( void** ) &( *buffer ).next
+                                         , buffer
+                                         , ATOMIC_RELEASE
+                                         , ATOMIC_RELAXED
+                                         ));
+
+    profile_buffer = buffer;
+    profile_buffer_generation = atomic_load_u32 ( &profile_generation , ATOMIC_ACQUIRE );
+    return buffer;
+}
+
+char*
+_profile_quote
+(   char*       string
+,   const char* value
+)
+{
+    string_push ( string , "\"" , 1 );
+    for ( ; *value; ++value )
+    {
+        if ( *value == '"' || *value == '\\' )
+        {
+            string_push ( string , "\\" , 1 );
+        }
+        string_push ( string , value , 1 );
+    }
+    string_push ( string , "\"" , 1 );
+    return string;
+}
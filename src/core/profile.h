@@ -0,0 +1,158 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/profile.h
+ * @brief Provides an interface for lightweight scoped profiling zones, and for
+ * exporting them as a trace viewable in chrome://tracing or Perfetto.
+ *
+ * A zone times the rest of the scope it is declared in:
+ *
+ *   void
+ *   update
+ *   ( void )
+ *   {
+ *       PROFILE_ZONE ( "update" );
+ *       ...
+ *   }
+ *
+ * Zones are recorded only between profile_start and profile_stop. Each thread
+ * records into its own fixed-size ring buffer, so recording never takes a lock
+ * or allocates memory after the thread's first zone; once a buffer is full, its
+ * oldest zones are overwritten. Timestamps are cycle counter readings (see
+ * clock_ticks), converted to microseconds only when the trace is written (see
+ * profile_write).
+ *
+ * PROFILE_ZONE and PROFILE_FUNCTION compile to nothing unless PROFILE_ENABLED
+ * is 1, so zones may be left in hot paths at no cost.
+ */
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "common.h"
+
+/**
+ * @brief Compile profiling zones into the current module? Y\N
+ *
+ * Defaults to N; enable by defining PROFILE_ENABLED as 1 (e.g. -DPROFILE_ENABLED=1).
+ */
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0
+#endif
+
+/** @brief Defines the capacity (in zones) of each thread's profiling buffer. */
+#define PROFILE_BUFFER_CAPACITY 65536
+
+/** @brief Type definition for an open profiling zone (see profile_zone_begin). */
+typedef struct
+{
+    const char* name;
+    u64         begin;  // Cycle counter at the start of the zone.
+}
+profile_zone_t;
+
+/**
+ * @brief Starts recording profiling zones on every thread.
+ *
+ * Trace timestamps are relative to the most recent call.
+ */
+void
+profile_start
+( void );
+
+/**
+ * @brief Stops recording profiling zones. Zones already recorded are kept
+ * until profile_clear or profile_shutdown.
+ */
+void
+profile_stop
+( void );
+
+/**
+ * @brief Queries whether profiling zones are being recorded.
+ *
+ * @return true between profile_start and profile_stop; false otherwise.
+ */
+bool
+profile_recording
+( void );
+
+/**
+ * @brief Discards every recorded profiling zone. Call while recording is
+ * stopped.
+ */
+void
+profile_clear
+( void );
+
+/**
+ * @brief Frees every thread's profiling buffer. Call while recording is
+ * stopped, and no other thread is inside a profiling zone.
+ */
+void
+profile_shutdown
+( void );
+
+/**
+ * @brief Writes every recorded profiling zone to a file, in Chrome Trace Event
+ * (JSON) format.
+ *
+ * Zones recorded by the calling thread while writing are ignored. If other
+ * threads are still recording, the trace includes only the zones they closed
+ * before the call, and their oldest zones may be torn if their buffers wrap;
+ * call profile_stop first for an exact trace.
+ *
+ * @param path The filepath. Must be non-zero.
+ * @return true if the trace was written successfully; false otherwise.
+ */
+bool
+profile_write
+(   const char* path
+);
+
+/**
+ * @brief Opens a profiling zone. Prefer PROFILE_ZONE, which closes the zone
+ * at the end of the scope.
+ *
+ * Not inline, so that core/clock.h need not be included by every profiled
+ * module (the platform layers define their own clock_t).
+ *
+ * @param name The name of the zone. Must have static storage duration (e.g. a
+ * string literal): it is read when the trace is written, not copied.
+ * @return An open zone. Pass it to profile_zone_end.
+ */
+profile_zone_t
+profile_zone_begin
+(   const char* name
+);
+
+/**
+ * @brief Closes a profiling zone, and records it if recording is started.
+ *
+ * @param zone A zone opened by profile_zone_begin. Must be non-zero.
+ */
+void
+profile_zone_end
+(   profile_zone_t* zone
+);
+
+#define PROFILE_CONCAT_(a,b) a##b
+#define PROFILE_CONCAT(a,b)  PROFILE_CONCAT_ ( a , b )
+
+#if PROFILE_ENABLED == 1
+
+/** @brief Profiles the remainder of the current scope as a zone named name. */
+#define PROFILE_ZONE(name)                                                          \
+    profile_zone_t PROFILE_CONCAT ( profile_zone_ , __LINE__ )                      \
+        __attribute__ ( ( cleanup ( profile_zone_end ) ) )                          \
+        = profile_zone_begin ( (name) )
+
+#else
+
+#define PROFILE_ZONE(name)
+
+#endif
+
+/** @brief Profiles the remainder of the current function as a zone named after it. */
+#define PROFILE_FUNCTION() \
+    PROFILE_ZONE ( __func__ )
+
+#endif  // PROFILE_H
@@ -0,0 +1,806 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/sort.c
+ * @brief Implementation of the core/sort header.
+ * (see core/sort.h for additional details)
+ */
+#include "core/sort.h"
+
+#include "core/array.h"
+#include "core/job.h"
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/clamp.h"
+
+/** @brief Partitions of up to this many elements are finished with insertion sort. */
+#define SORT_INSERTION_THRESHOLD 24
+
+/** @brief Arrays shorter than this are sorted on the calling thread by sort_parallel. */
+#define SORT_PARALLEL_THRESHOLD ( ( u64 ) 16384 )
+
+/** @brief Size (in bytes) of each radix sort key type. */
+static const u8 sort_key_size[ SORT_KEY_COUNT ] = { 1 , 2 , 4 , 8   // SORT_KEY_U*
+                                                  , 1 , 2 , 4 , 8   // SORT_KEY_I*
+                                                  , 4 , 8           // SORT_KEY_F*
+                                                  };
+
+/** @brief Type definition for a partition awaiting sorting by introsort. */
+typedef struct
+{
+    u8*     array;
+    u64     length;
+    u32     depth;
+}
+sort_partition_t;
+
+/**
+ * @brief Type definition for a sort_parallel job: either sorting one run in
+ * place, or merging part of a pair of adjacent runs from src into dst.
+ */
+typedef struct
+{
+    const u8*               src;
+    u8*                     dst;
+    u64                     stride;
+    comparator_function_t   comparator;
+    u64                     left_length;    // Length of the run (or left run).
+    u64                     right_length;   // Merge only: length of right run.
+    u64                     begin;          // Merge only: first output element.
+    u64                     end;            // Merge only: last output element + 1.
+}
+sort_job_t;
+
+/**
+ * @brief Copies one array element. The switch folds away when stride is a
+ * compile-time constant.
+ *
+ * @param dst Output buffer.
+ * @param src The element to copy.
+ * @param stride The size of each element in bytes.
+ */
+INLINE
+void
+_sort_copy
+(   u8*         dst
+,   const u8*   src
+,   const u64   stride
+)
+{
+    switch ( stride )
+    {
+        case 4:  __builtin_memcpy ( dst , src , 4 )      ;break;
+        case 8:  __builtin_memcpy ( dst , src , 8 )      ;break;
+        case 16: __builtin_memcpy ( dst , src , 16 )     ;break;
+        default: __builtin_memcpy ( dst , src , stride ) ;break;
+    }
+}
+
+/**
+ * @brief Sorts a small array with insertion sort.
+ *
+ * @param array The array to sort.
+ * @param length The number of elements in the array.
+ * @param stride The size of each element in bytes.
+ * @param comparator A function which compares two array elements.
+ */
+INLINE
+void
+_sort_insertion
+(   u8*                     array
+,   const u64               length
+,   const u64               stride
+,   comparator_function_t   comparator
+)
+{
+    for ( u64 i = 1; i < length; ++i )
+    {
+        for ( u64 j = i; j && comparator ( array + j * stride
+                                         , array + ( j - 1 ) * stride
+                                         ) < 0; --j )
+        {
+            array_swap ( array + j * stride , array + ( j - 1 ) * stride , stride );
+        }
+    }
+}
+
+/**
+ * @brief Restores the max-heap property below an element of a heap.
+ *
+ * @param array The heap.
+ * @param root The index of the element.
+ * @param length The number of elements in the heap.
+ * @param stride The size of each element in bytes.
+ * @param comparator A function which compares two array elements.
+ */
+INLINE
+void
+_sort_heap_sift_down
+(   u8*                     array
+,   u64                     root
+,   const u64               length
+,   const u64               stride
+,   comparator_function_t   comparator
+)
+{
+    for (;;)
+    {
+        u64 child = 2 * root + 1;
+        if ( child >= length )
+        {
+            return;
+        }
+        if ( child + 1 < length && comparator ( array + child * stride
+                                              , array + ( child + 1 ) * stride
+                                              ) < 0 )
+        {
+            child += 1;
+        }
+        if ( comparator ( array + root * stride , array + child * stride ) >= 0 )
+        {
+            return;
+        }
+        array_swap ( array + root * stride , array + child * stride , stride );
+        root = child;
+    }
+}
+
+/**
+ * @brief Sorts an array with heapsort. Guarantees O(n log(n)) once introsort
+ * recurses too deeply.
+ *
+ * @param array The array to sort.
+ * @param length The number of elements in the array.
+ * @param stride The size of each element in bytes.
+ * @param comparator A function which compares two array elements.
+ */
+INLINE
+void
+_sort_heap
+(   u8*                     array
+,   const u64               length
+,   const u64               stride
+,   comparator_function_t   comparator
+)
+{
+    for ( u64 i = length / 2; i--; )
+    {
+        _sort_heap_sift_down ( array , i , length , stride , comparator );
+    }
+    for ( u64 end = length - 1; end; --end )
+    {
+        array_swap ( array , array + end * stride , stride );
+        _sort_heap_sift_down ( array , 0 , end , stride , comparator );
+    }
+}
+
+/**
+ * @brief Sorts an array with introsort. Non-recursive, so it can be inlined
+ * into the stride-specialized entry points.
+ *
+ * @param array The array to sort.
+ * @param length The number of elements in the array. Must be at least 2.
+ * @param stride The size of each element in bytes.
+ * @param comparator A function which compares two array elements.
+ */
+INLINE
+void
+_sort_introsort
+(   u8*                     array
+,   u64                     length
+,   const u64               stride
+,   comparator_function_t   comparator
+)
+{
+    // The larger partition is deferred and the smaller one sorted first, so
+    // at most log2(length) partitions are ever deferred.
+    sort_partition_t stack[ 64 ];
+    u64 stack_count = 0;
+    u32 depth = 2 * bitscan_reverse ( length );
+
+    for (;;)
+    {
+        while ( length > SORT_INSERTION_THRESHOLD )
+        {
+            // Partitions too unbalanced? Y/N
+            if ( !depth )
+            {
+                _sort_heap ( array , length , stride , comparator );
+                length = 0;
+                break;
+            }
+            depth -= 1;
+
+            // Move the median of the first, middle, and last elements to the
+            // front, to serve as the pivot.
+            u8* first = array;
+            u8* middle = array + ( length / 2 ) * stride;
+            u8* last = array + ( length - 1 ) * stride;
+            if ( comparator ( middle , first ) < 0 )
+            {
+                array_swap ( middle , first , stride );
+            }
+            if ( comparator ( last , middle ) < 0 )
+            {
+                array_swap ( last , middle , stride );
+                if ( comparator ( middle , first ) < 0 )
+                {
+                    array_swap ( middle , first , stride );
+                }
+            }
+            array_swap ( first , middle , stride );
+
+            // Partition around the pivot. Both scans stop on elements equal
+            // to the pivot, which keeps arrays with many duplicates balanced.
+            u64 i = 0;
+            u64 j = length;
+            for (;;)
+            {
+                do
+                {
+                    i += 1;
+                }
+                while ( i < length && comparator ( array + i * stride , array ) < 0 );
+                do
+                {
+                    j -= 1;
+                }
+                while ( comparator ( array + j * stride , array ) > 0 );
+                if ( i >= j )
+                {
+                    break;
+                }
+                array_swap ( array + i * stride , array + j * stride , stride );
+            }
+            array_swap ( array , array + j * stride , stride );
+
+            const u64 left = j;
+            const u64 right = length - j - 1;
+            if ( left < right )
+            {
+                stack[ stack_count ].array = array + ( j + 1 ) * stride;
+                stack[ stack_count ].length = right;
+                stack[ stack_count ].depth = depth;
+                length = left;
+            }
+            else
+            {
+                stack[ stack_count ].array = array;
+                stack[ stack_count ].length = left;
+                stack[ stack_count ].depth = depth;
+                array += ( j + 1 ) * stride;
+                length = right;
+            }
+            stack_count += 1;
+        }
+
+        _sort_insertion ( array , length , stride , comparator );
+
+        if ( !stack_count )
+        {
+            return;
+        }
+        stack_count -= 1;
+        array = stack[ stack_count ].array;
+        length = stack[ stack_count ].length;
+        depth = stack[ stack_count ].depth;
+    }
+}
+
+/**
+ * @brief Introsort specialized for 4-byte elements.
+ *
+ * @param array The array to sort.
+ * @param length The number of elements in the array. Must be at least 2.
+ * @param comparator A function which compares two array elements.
+ */
+__attribute__ ( ( flatten ) )
+void
+_sort_4
+(   u8*                     array
+,   u64                     length
+,   comparator_function_t   comparator
+);
+
+/**
+ * @brief Introsort specialized for 8-byte elements.
+ *
+ * @param array The array to sort.
+ * @param length The number of elements in the array. Must be at least 2.
+ * @param comparator A function which compares two array elements.
+ */
+__attribute__ ( ( flatten ) )
+void
+_sort_8
+(   u8*                     array
+,   u64                     length
+,   comparator_function_t   comparator
+);
+
+/**
+ * @brief Introsort specialized for 16-byte elements.
+ *
+ * @param array The array to sort.
+ * @param length The number of elements in the array. Must be at least 2.
+ * @param comparator A function which compares two array elements.
+ */
+__attribute__ ( ( flatten ) )
+void
+_sort_16
+(   u8*                     array
+,   u64                     length
+,   comparator_function_t   comparator
+);
+
+/**
+ * @brief Reads the key of an array element for radix sort, and maps it onto
+ * an unsigned integer with the same ordering.
+ *
+ * @param element The key within the array element.
+ * @param key The type of the key.
+ * @return The key as an unsigned integer.
+ */
+INLINE
+u64
+_sort_radix_key
+(   const u8*       element
+,   const SORT_KEY  key
+)
+{
+    switch ( key )
+    {
+        case SORT_KEY_U8:
+        case SORT_KEY_I8:
+        {
+            const u8 v = *element;
+            return ( key == SORT_KEY_I8 ) ? ( u8 )( v ^ 0x80 ) : v;
+        }
+        case SORT_KEY_U16:
+        case SORT_KEY_I16:
+        {
+            u16 v;
+            __builtin_memcpy ( &v , element , 2 );
+            return ( key == SORT_KEY_I16 ) ? ( u16 )( v ^ 0x8000 ) : v;
+        }
+        case SORT_KEY_U32:
+        case SORT_KEY_I32:
+        {
+            u32 v;
+            __builtin_memcpy ( &v , element , 4 );
+            return ( key == SORT_KEY_I32 ) ? ( v ^ 0x80000000 ) : v;
+        }
+        case SORT_KEY_F32:
+        {
+            // Negative: reverse the order by flipping every bit.
+            // Positive: move above every negative by setting the sign bit.
+            u32 v;
+            __builtin_memcpy ( &v , element , 4 );
+            return ( v & 0x80000000 ) ? ( u32 ) ~v : ( v | 0x80000000 );
+        }
+        case SORT_KEY_F64:
+        {
+            u64 v;
+            __builtin_memcpy ( &v , element , 8 );
+            return ( v & 0x8000000000000000ULL ) ? ~v : ( v | 0x8000000000000000ULL );
+        }
+        default:
+        {
+            u64 v;
+            __builtin_memcpy ( &v , element , 8 );
+            return ( key == SORT_KEY_I64 ) ? ( v ^ 0x8000000000000000ULL ) : v;
+        }
+    }
+}
+
+/**
+ * @brief sort_parallel job: sorts one run in place.
+ *
+ * @param args A sort_job_t.
+ */
+void
+_sort_parallel_run
+(   void* args
+);
+
+/**
+ * @brief sort_parallel job: merges part of a pair of adjacent sorted runs.
+ *
+ * @param args A sort_job_t.
+ */
+void
+_sort_parallel_merge
+(   void* args
+);
+
+/**
+ * @brief Finds how many elements of the left run are among the first
+ * diagonal elements of the merge of two sorted runs (the 'merge path').
+ *
+ * @param left The left run.
+ * @param left_length The number of elements in the left run.
+ * @param right The right run.
+ * @param right_length The number of elements in the right run.
+ * @param diagonal The number of merged elements.
+ * @param stride The size of each element in bytes.
+ * @param comparator A function which compares two array elements.
+ * @return The number of elements taken from the left run.
+ */
+u64
+_sort_merge_split
+(   const u8*               left
+,   u64                     left_length
+,   const u8*               right
+,   u64                     right_length
+,   u64                     diagonal
+,   u64                     stride
+,   comparator_function_t   comparator
+);
+
+void
+sort
+(   void*                   array
+,   u64                     array_length
+,   u64                     array_stride
+,   comparator_function_t   comparator
+)
+{
+    if ( array_length < 2 || !array_stride )
+    {
+        return;
+    }
+    if ( !array || !comparator )
+    {
+        if ( !array )
+        {
+            LOGERROR ( "sort: Missing argument: array." );
+        }
+        if ( !comparator )
+        {
+            LOGERROR ( "sort: Missing argument: comparator." );
+        }
+        return;
+    }
+
+    switch ( array_stride )
+    {
+        case 4:  _sort_4 ( array , array_length , comparator )                               ;break;
+        case 8:  _sort_8 ( array , array_length , comparator )                               ;break;
+        case 16: _sort_16 ( array , array_length , comparator )                              ;break;
+        default: _sort_introsort ( array , array_length , array_stride , comparator )        ;break;
+    }
+}
+
+bool
+sort_radix
+(   void*       array_
+,   u64         array_length
+,   u64         array_stride
+,   u64         key_offset
+,   SORT_KEY    key
+,   void*       scratch_
+)
+{
+    if ( !array_ || key >= SORT_KEY_COUNT || key_offset + sort_key_size[ key ] > array_stride )
+    {
+        if ( !array_ )
+        {
+            LOGERROR ( "sort_radix: Missing argument: array." );
+        }
+        if ( key >= SORT_KEY_COUNT )
+        {
+            LOGERROR ( "sort_radix: Value of key argument was invalid; it should be a valid key type." );
+        }
+        else if ( key_offset + sort_key_size[ key ] > array_stride )
+        {
+            LOGERROR ( "sort_radix: A key of %u bytes at offset %u does not fit in an element of %u bytes."
+                     , sort_key_size[ key ] , key_offset , array_stride
+                     );
+        }
+        return false;
+    }
+
+    if ( array_length < 2 )
+    {
+        return true;
+    }
+
+    u8* array = array_;
+    const u64 key_size = sort_key_size[ key ];
+
+    // Count the occurrences of each value of each key byte, in one pass.
+    u64 counts[ 8 ][ 256 ];
+    memory_clear ( counts , sizeof ( counts ) );
+    for ( u64 i = 0; i < array_length; ++i )
+    {
+        const u64 k = _sort_radix_key ( array + i * array_stride + key_offset , key );
+        for ( u64 byte = 0; byte < key_size; ++byte )
+        {
+            counts[ byte ][ ( k >> ( 8 * byte ) ) & 0xFF ] += 1;
+        }
+    }
+
+    u8* scratch = scratch_ ? scratch_
+                           : memory_allocate_uninit ( array_length * array_stride
+                                                    , MEMORY_TAG_ARRAY
+                                                    );
+    u8* src = array;
+    u8* dst = scratch;
+
+    const u64 first_key = _sort_radix_key ( array + key_offset , key );
+    for ( u64 byte = 0; byte < key_size; ++byte )
+    {
+        // Byte identical in every key? Y/N
+        if ( counts[ byte ][ ( first_key >> ( 8 * byte ) ) & 0xFF ] == array_length )
+        {
+            continue;
+        }
+
+        // Convert counts to output positions.
+        u64 offset = 0;
+        for ( u64 value = 0; value < 256; ++value )
+        {
+            const u64 count = counts[ byte ][ value ];
+            counts[ byte ][ value ] = offset;
+            offset += count;
+        }
+
+        for ( u64 i = 0; i < array_length; ++i )
+        {
+            const u64 k = _sort_radix_key ( src + i * array_stride + key_offset , key );
+            u64* position = &counts[ byte ][ ( k >> ( 8 * byte ) ) & 0xFF ];
+            _sort_copy ( dst + ( *position ) * array_stride
+                       , src + i * array_stride
+                       , array_stride
+                       );
+            *position += 1;
+        }
+
+        u8* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if ( src != array )
+    {
+        memory_copy ( array , src , array_length * array_stride );
+    }
+
+    if ( !scratch_ )
+    {
+        memory_free ( scratch , array_length * array_stride , MEMORY_TAG_ARRAY );
+    }
+
+    return true;
+}
+
+void
+sort_parallel
+(   void*                   array_
+,   u64                     array_length
+,   u64                     array_stride
+,   comparator_function_t   comparator
+,   void*                   scratch_
+)
+{
+    const u64 worker_count = job_system_worker_count ();
+    if ( !worker_count || array_length < SORT_PARALLEL_THRESHOLD || !array_ || !comparator )
+    {
+        sort ( array_ , array_length , array_stride , comparator );
+        return;
+    }
+    if ( !array_stride )
+    {
+        return;
+    }
+
+    u8* array = array_;
+
+    // One run per thread (including the caller, which helps in job_wait),
+    // rounded up to a power of two so the runs merge pairwise.
+    const u64 thread_count = worker_count + 1;
+    u64 run_count = 1;
+    while ( run_count < thread_count )
+    {
+        run_count *= 2;
+    }
+
+    const u64 job_capacity = MAX ( run_count , thread_count );
+    sort_job_t* args = memory_allocate ( sizeof ( sort_job_t ) * job_capacity
+                                       , MEMORY_TAG_ARRAY
+                                       );
+    job_t* jobs = memory_allocate ( sizeof ( job_t ) * job_capacity
+                                  , MEMORY_TAG_ARRAY
+                                  );
+    u8* scratch = scratch_ ? scratch_
+                           : memory_allocate_uninit ( array_length * array_stride
+                                                    , MEMORY_TAG_ARRAY
+                                                    );
+    job_counter_t counter;
+    memory_clear ( &counter , sizeof ( job_counter_t ) );
+
+    // Sort each run.
+    for ( u64 i = 0; i < run_count; ++i )
+    {
+        const u64 begin = i * array_length / run_count;
+        const u64 end = ( i + 1 ) * array_length / run_count;
+        args[ i ].src = 0;
+        args[ i ].dst = array + begin * array_stride;
+        args[ i ].stride = array_stride;
+        args[ i ].comparator = comparator;
+        args[ i ].left_length = end - begin;
+        args[ i ].right_length = 0;
+        args[ i ].begin = 0;
+        args[ i ].end = 0;
+        jobs[ i ].function = _sort_parallel_run;
+        jobs[ i ].args = &args[ i ];
+    }
+    job_submit ( jobs , run_count , &counter );
+    job_wait ( &counter );
+
+    // Merge pairs of runs until one remains. Each merge is split along its
+    // merge path so every thread has work, even in the final rounds.
+    const u8* src = array;
+    u8* dst = scratch;
+    for ( ; run_count > 1; run_count /= 2 )
+    {
+        const u64 pair_count = run_count / 2;
+        const u64 part_count = MAX ( ( u64 ) 1 , thread_count / pair_count );
+        u64 job_count = 0;
+        for ( u64 i = 0; i < pair_count; ++i )
+        {
+            const u64 begin = ( 2 * i ) * array_length / run_count;
+            const u64 middle = ( 2 * i + 1 ) * array_length / run_count;
+            const u64 end = ( 2 * i + 2 ) * array_length / run_count;
+            for ( u64 j = 0; j < part_count; ++j )
+            {
+                args[ job_count ].src = src + begin * array_stride;
+                args[ job_count ].dst = dst + begin * array_stride;
+                args[ job_count ].stride = array_stride;
+                args[ job_count ].comparator = comparator;
+                args[ job_count ].left_length = middle - begin;
+                args[ job_count ].right_length = end - middle;
+                args[ job_count ].begin = j * ( end - begin ) / part_count;
+                args[ job_count ].end = ( j + 1 ) * ( end - begin ) / part_count;
+                jobs[ job_count ].function = _sort_parallel_merge;
+                jobs[ job_count ].args = &args[ job_count ];
+                job_count += 1;
+            }
+        }
+        job_submit ( jobs , job_count , &counter );
+        job_wait ( &counter );
+
+        u8* swap = ( u8* ) src;
+        src = dst;
+        dst = swap;
+    }
+
+    if ( src != array )
+    {
+        memory_copy ( array , src , array_length * array_stride );
+    }
+
+    if ( !scratch_ )
+    {
+        memory_free ( scratch , array_length * array_stride , MEMORY_TAG_ARRAY );
+    }
+    memory_free ( jobs , sizeof ( job_t ) * job_capacity , MEMORY_TAG_ARRAY );
+    memory_free ( args , sizeof ( sort_job_t ) * job_capacity , MEMORY_TAG_ARRAY );
+}
+
+void
+_sort_4
+(   u8*                     array
+,   u64                     length
+,   comparator_function_t   comparator
+)
+{
+    _sort_introsort ( array , length , 4 , comparator );
+}
+
+void
+_sort_8
+(   u8*                     array
+,   u64                     length
+,   comparator_function_t   comparator
+)
+{
+    _sort_introsort ( array , length , 8 , comparator );
+}
+
+void
+_sort_16
+(   u8*                     array
+,   u64                     length
+,   comparator_function_t   comparator
+)
+{
+    _sort_introsort ( array , length , 16 , comparator );
+}
+
+void
+_sort_parallel_run
+(   void* args_
+)
+{
+    const sort_job_t* args = args_;
+    sort ( ( *args ).dst
+         , ( *args ).left_length
+         , ( *args ).stride
+         , ( *args ).comparator
+         );
+}
+
+void
+_sort_parallel_merge
+(   void* args_
+)
+{
+    const sort_job_t* args = args_;
+    const u64 stride = ( *args ).stride;
+    const comparator_function_t comparator = ( *args ).comparator;
+    const u8* left = ( *args ).src;
+    const u8* right = ( *args ).src + ( *args ).left_length * stride;
+
+    u64 i = _sort_merge_split ( left , ( *args ).left_length
+                              , right , ( *args ).right_length
+                              , ( *args ).begin
+                              , stride , comparator
+                              );
+    const u64 i_end = _sort_merge_split ( left , ( *args ).left_length
+                                        , right , ( *args ).right_length
+                                        , ( *args ).end
+                                        , stride , comparator
+                                        );
+    u64 j = ( *args ).begin - i;
+    const u64 j_end = ( *args ).end - i_end;
+
+    // Ties take from the left run, matching _sort_merge_split.
+    u8* out = ( *args ).dst + ( *args ).begin * stride;
+    while ( i < i_end && j < j_end )
+    {
+        if ( comparator ( right + j * stride , left + i * stride ) < 0 )
+        {
+            _sort_copy ( out , right + j * stride , stride );
+            j += 1;
+        }
+        else
+        {
+            _sort_copy ( out , left + i * stride , stride );
+            i += 1;
+        }
+        out += stride;
+    }
+    memory_copy ( out , left + i * stride , ( i_end - i ) * stride );
+    out += ( i_end - i ) * stride;
+    memory_copy ( out , right + j * stride , ( j_end - j ) * stride );
+}
+
+u64
+_sort_merge_split
+(   const u8*               left
+,   u64                     left_length
+,   const u8*               right
+,   u64                     right_length
+,   u64                     diagonal
+,   u64                     stride
+,   comparator_function_t   comparator
+)
+{
+    u64 low = ( diagonal > right_length ) ? diagonal - right_length : 0;
+    u64 high = MIN ( diagonal , left_length );
+    while ( low < high )
+    {
+        const u64 middle = low + ( high - low ) / 2;
+        if ( comparator ( left + middle * stride
+                        , right + ( diagonal - middle - 1 ) * stride
+                        ) <= 0 )
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
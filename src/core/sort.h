@@ -0,0 +1,121 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/sort.h
+ * @brief Provides in-place sorting algorithms for arrays of fixed-size
+ * elements.
+ *
+ * sort          : Introsort (quicksort which falls back on heapsort if the
+ *                 partitions become unbalanced, and finishes small partitions
+ *                 with insertion sort). Specialized for 4, 8 and 16-byte
+ *                 elements.
+ * sort_radix    : LSD radix sort on an integer or floating point key
+ *                 embedded in each element. No comparator calls, and stable.
+ * sort_parallel : Merge sort which sorts and merges runs on the job system
+ *                 (see core/job.h).
+ *
+ * For resizable arrays, see the _array_sort macro family in
+ * container/array.h.
+ */
+#ifndef SORT_H
+#define SORT_H
+
+#include "common.h"
+
+/** @brief Type and instance definitions for radix sort key types. */
+typedef enum
+{
+    SORT_KEY_U8
+,   SORT_KEY_U16
+,   SORT_KEY_U32
+,   SORT_KEY_U64
+,   SORT_KEY_I8
+,   SORT_KEY_I16
+,   SORT_KEY_I32
+,   SORT_KEY_I64
+,   SORT_KEY_F32
+,   SORT_KEY_F64
+
+,   SORT_KEY_COUNT
+}
+SORT_KEY;
+
+/**
+ * @brief Sorts an array in-place.
+ *
+ * Not stable.
+ * AVERAGE CASE TIME COMPLEXITY : O(n log(n))
+ * WORST CASE TIME COMPLEXITY   : O(n log(n))
+ *
+ * @param array The array to sort. Must be non-zero.
+ * @param array_length The number of elements in the array.
+ * @param array_stride The size of each array element in bytes.
+ * @param comparator A function which compares two array elements.
+ * Must be non-zero.
+ */
+void
+sort
+(   void*                   array
+,   u64                     array_length
+,   u64                     array_stride
+,   comparator_function_t   comparator
+);
+
+/**
+ * @brief Sorts an array in-place by an integer or floating point key stored
+ * within each element, in ascending order.
+ *
+ * Stable. Passes over bytes of the key which are identical in every element
+ * are skipped, so e.g. sorting small values in a u64 key costs little more than
+ * sorting a u8 key.
+ * Negative zero sorts before positive zero, and NaNs sort before (negative) or
+ * after (positive) every other value.
+ * TIME COMPLEXITY : O(n * key size)
+ *
+ * @param array The array to sort. Must be non-zero.
+ * @param array_length The number of elements in the array.
+ * @param array_stride The size of each array element in bytes.
+ * @param key_offset The position of the key within each element (in bytes).
+ * @param key The type of the key.
+ * @param scratch Optional pre-allocated buffer of array_length * array_stride
+ * bytes. Pass 0 to use implicit memory allocation.
+ * @return true on success; false if the key does not fit in an element.
+ */
+bool
+sort_radix
+(   void*       array
+,   u64         array_length
+,   u64         array_stride
+,   u64         key_offset
+,   SORT_KEY    key
+,   void*       scratch
+);
+
+/**
+ * @brief Sorts an array in-place, splitting the work across the job system.
+ *
+ * The array is divided into runs which are sorted (see sort) concurrently,
+ * then merged pairwise; each merge is itself divided among the workers. If
+ * the job system is not running, or the array is small, this is equivalent to
+ * sort.
+ *
+ * Not stable.
+ * TIME COMPLEXITY : O(n log(n))
+ *
+ * @param array The array to sort. Must be non-zero.
+ * @param array_length The number of elements in the array.
+ * @param array_stride The size of each array element in bytes.
+ * @param comparator A function which compares two array elements. Must be
+ * non-zero, and safe to call from several threads at once.
+ * @param scratch Optional pre-allocated buffer of array_length * array_stride
+ * bytes. Pass 0 to use implicit memory allocation.
+ */
+void
+sort_parallel
+(   void*                   array
+,   u64                     array_length
+,   u64                     array_stride
+,   comparator_function_t   comparator
+,   void*                   scratch
+);
+
+#endif  // SORT_H
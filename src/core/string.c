@@ -6,6 +6,14 @@
  */
 #include "core/string.h"
 
+#if PLATFORM_SIMD_AVX2
+    #include <immintrin.h>
+#elif PLATFORM_SIMD_SSE2
+    #include <emmintrin.h>
+#elif PLATFORM_SIMD_NEON
+    #include <arm_neon.h>
+#endif
+
 #include "core/logger.h"
 #include "core/memory.h"
 
@@ -58,231 +66,3420 @@ __string_contains_reverse
 );
 
 /**
- * @brief Primary implementation of string_i64 and string_u64
- * (see string_i64 and string_u64).
+ * @brief Two-Way implementation of __string_contains, which runs in O(n)
+ * time and O(1) space for any substring (algorithm by Crochemore and Perrin).
  * 
- * After return, the string at dst will be written in least-significant-bit
- * first order. Since the standard method for printing Arabic-numeral integers
- * is in most-significant-bit first order, the output of this function should be
- * reversed for the purpose of display.
+ * @param search The string to search.
+ * @param search_length The number of characters in search.
+ * @param find The string to find. Must be non-empty.
+ * @param find_length The number of characters in find.
+ * @param index Output buffer to hold the index in search at which find was
+ * found.
+ * @return true if search contains find; false otherwise.
+ */
+bool
+_string_contains_two_way
+(   const char* search
+,   const u64   search_length
+,   const char* find
+,   const u64   find_length
+,   u64*        index
+);
+
+/**
+ * @brief Computes a critical factorization of a string (see
+ * _string_contains_two_way): the split point is the later of the maximal
+ * suffixes under the ordinary and the reversed alphabet ordering.
  * 
- * @param value A 64-bit value.
- * @param radix Integer radix in the range [2..36] (inclusive).
- * @param dst Output buffer for string.
- * @return The number of characters written to dst.
+ * @param string The string. Must be non-empty.
+ * @param string_length The number of characters in string.
+ * @param period Output buffer for the period of the right half.
+ * @return The index at which string is split.
  */
 u64
-_string_u64
-(   u64     value
-,   u8      radix
-,   char*   dst
+_string_critical_factorization
+(   const u8*   string
+,   const u64   string_length
+,   u64*        period
 );
 
-u64
-_string_length
-(   const char* string
-)
+/** @brief Digit characters for every integer radix (see string_u64). */
+static const char string_integer_digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+
+/** @brief Hexadecimal digit characters, lowercase then uppercase (see string_hex_encode). */
+static const char string_hex_digits[ 2 ][ 17 ] = { "0123456789abcdef" , "0123456789ABCDEF" };
+
+/** @brief Base64 alphabet (see string_base64_encode). */
+static const char string_base64_digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/** @brief Value of each hexadecimal digit character, or 0xFF for any other character. */
+static const u8 string_hex_values[ 256 ] = { 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0x00 , 0x01 , 0x02 , 0x03 , 0x04 , 0x05 , 0x06 , 0x07 , 0x08 , 0x09 , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0x0A , 0x0B , 0x0C , 0x0D , 0x0E , 0x0F , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0x0A , 0x0B , 0x0C , 0x0D , 0x0E , 0x0F , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                           };
+
+/** @brief Value of each base64 digit character, or 0xFF for any other character. */
+static const u8 string_base64_values[ 256 ] = { 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0x3E , 0xFF , 0xFF , 0xFF , 0x3F
+                                              , 0x34 , 0x35 , 0x36 , 0x37 , 0x38 , 0x39 , 0x3A , 0x3B , 0x3C , 0x3D , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0x00 , 0x01 , 0x02 , 0x03 , 0x04 , 0x05 , 0x06 , 0x07 , 0x08 , 0x09 , 0x0A , 0x0B , 0x0C , 0x0D , 0x0E
+                                              , 0x0F , 0x10 , 0x11 , 0x12 , 0x13 , 0x14 , 0x15 , 0x16 , 0x17 , 0x18 , 0x19 , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0x1A , 0x1B , 0x1C , 0x1D , 0x1E , 0x1F , 0x20 , 0x21 , 0x22 , 0x23 , 0x24 , 0x25 , 0x26 , 0x27 , 0x28
+                                              , 0x29 , 0x2A , 0x2B , 0x2C , 0x2D , 0x2E , 0x2F , 0x30 , 0x31 , 0x32 , 0x33 , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF , 0xFF
+                                              };
+
+/**
+ * @brief Every two-digit decimal number in ascending order, so decimal
+ * integers can be converted two digits per division.
+ */
+static const char string_integer_digit_pairs[] = "00010203040506070809"
+                                                 "10111213141516171819"
+                                                 "20212223242526272829"
+                                                 "30313233343536373839"
+                                                 "40414243444546474849"
+                                                 "50515253545556575859"
+                                                 "60616263646566676869"
+                                                 "70717273747576777879"
+                                                 "80818283848586878889"
+                                                 "90919293949596979899"
+                                                 ;
+
+/** @brief Powers of ten which fit in 32 bits. */
+static const u32 string_pow10_u32[] = { 1
+                                      , 10
+                                      , 100
+                                      , 1000
+                                      , 10000
+                                      , 100000
+                                      , 1000000
+                                      , 10000000
+                                      , 100000000
+                                      , 1000000000
+                                      };
+
+/**
+ * @brief Capacity of a bigint_t (in 32-bit limbs). Every intermediate value of
+ * string_f64 and string_f64_shortest is less than 2^1160, and of
+ * string_to_f64 less than 2^2660 (see STRING_PARSE_MAX_DIGITS).
+ */
+#define STRING_FLOAT_BIGINT_CAPACITY 96
+
+/**
+ * @brief Maximum number of significant digits read exactly by string_to_f64.
+ * A decimal number halfway between two adjacent f64 values has at most 767
+ * significant digits, so any digits past this many can only break a tie, and
+ * are folded into a single sticky digit.
+ */
+#define STRING_PARSE_MAX_DIGITS 780
+
+/** @brief Maximum number of significant digits which always fit in a u64. */
+#define STRING_PARSE_MAX_U64_DIGITS 19
+
+/**
+ * @brief Maximum number of digits generated by string_f64 (309 integer digits
+ * of the largest f64, plus the fractional digits and a rounding carry).
+ */
+#define STRING_FLOAT_MAX_DIGITS \
+    ( 310 + STRING_FLOAT_MAX_PRECISION + 1 )
+
+/** @brief Type definition for an unsigned arbitrary-precision integer. */
+typedef struct
 {
-    return platform_string_length ( string );
+    u32 length;                                 // Number of limbs in use.
+    u32 limbs[ STRING_FLOAT_BIGINT_CAPACITY ];  // Least significant first.
 }
+bigint_t;
 
-u64
-_string_length_clamped
+/**
+ * @brief Type definition for a floating point number with a 64-bit
+ * significand and no implicit bit (value = f * 2^e).
+ */
+typedef struct
+{
+    u64 f;
+    i32 e;
+}
+fp_t;
+
+/** @brief Type definition for a cached power of ten (value ~= significand * 2^binary_exponent). */
+typedef struct
+{
+    u64 significand;
+    i16 binary_exponent;
+    i16 decimal_exponent;
+}
+pow10_t;
+
+/** @brief Decimal exponent of the first cached power of ten (see string_pow10_cache). */
+#define STRING_POW10_CACHE_FIRST_EXPONENT -348
+
+/** @brief Decimal exponent step between cached powers of ten (see string_pow10_cache). */
+#define STRING_POW10_CACHE_STEP 8
+
+/**
+ * @brief Every eighth power of ten from 10^-348 to 10^340, each rounded to
+ * nearest with a normalized 64-bit significand (see _string_f64_digits_grisu).
+ */
+static const pow10_t string_pow10_cache[] = { { 0xFA8FD5A0081C0288 , -1220 , -348 }
+                                            , { 0xBAAEE17FA23EBF76 , -1193 , -340 }
+                                            , { 0x8B16FB203055AC76 , -1166 , -332 }
+                                            , { 0xCF42894A5DCE35EA , -1140 , -324 }
+                                            , { 0x9A6BB0AA55653B2D , -1113 , -316 }
+                                            , { 0xE61ACF033D1A45DF , -1087 , -308 }
+                                            , { 0xAB70FE17C79AC6CA , -1060 , -300 }
+                                            , { 0xFF77B1FCBEBCDC4F , -1034 , -292 }
+                                            , { 0xBE5691EF416BD60C , -1007 , -284 }
+                                            , { 0x8DD01FAD907FFC3C ,  -980 , -276 }
+                                            , { 0xD3515C2831559A83 ,  -954 , -268 }
+                                            , { 0x9D71AC8FADA6C9B5 ,  -927 , -260 }
+                                            , { 0xEA9C227723EE8BCB ,  -901 , -252 }
+                                            , { 0xAECC49914078536D ,  -874 , -244 }
+                                            , { 0x823C12795DB6CE57 ,  -847 , -236 }
+                                            , { 0xC21094364DFB5637 ,  -821 , -228 }
+                                            , { 0x9096EA6F3848984F ,  -794 , -220 }
+                                            , { 0xD77485CB25823AC7 ,  -768 , -212 }
+                                            , { 0xA086CFCD97BF97F4 ,  -741 , -204 }
+                                            , { 0xEF340A98172AACE5 ,  -715 , -196 }
+                                            , { 0xB23867FB2A35B28E ,  -688 , -188 }
+                                            , { 0x84C8D4DFD2C63F3B ,  -661 , -180 }
+                                            , { 0xC5DD44271AD3CDBA ,  -635 , -172 }
+                                            , { 0x936B9FCEBB25C996 ,  -608 , -164 }
+                                            , { 0xDBAC6C247D62A584 ,  -582 , -156 }
+                                            , { 0xA3AB66580D5FDAF6 ,  -555 , -148 }
+                                            , { 0xF3E2F893DEC3F126 ,  -529 , -140 }
+                                            , { 0xB5B5ADA8AAFF80B8 ,  -502 , -132 }
+                                            , { 0x87625F056C7C4A8B ,  -475 , -124 }
+                                            , { 0xC9BCFF6034C13053 ,  -449 , -116 }
+                                            , { 0x964E858C91BA2655 ,  -422 , -108 }
+                                            , { 0xDFF9772470297EBD ,  -396 , -100 }
+                                            , { 0xA6DFBD9FB8E5B88F ,  -369 ,  -92 }
+                                            , { 0xF8A95FCF88747D94 ,  -343 ,  -84 }
+                                            , { 0xB94470938FA89BCF ,  -316 ,  -76 }
+                                            , { 0x8A08F0F8BF0F156B ,  -289 ,  -68 }
+                                            , { 0xCDB02555653131B6 ,  -263 ,  -60 }
+                                            , { 0x993FE2C6D07B7FAC ,  -236 ,  -52 }
+                                            , { 0xE45C10C42A2B3B06 ,  -210 ,  -44 }
+                                            , { 0xAA242499697392D3 ,  -183 ,  -36 }
+                                            , { 0xFD87B5F28300CA0E ,  -157 ,  -28 }
+                                            , { 0xBCE5086492111AEB ,  -130 ,  -20 }
+                                            , { 0x8CBCCC096F5088CC ,  -103 ,  -12 }
+                                            , { 0xD1B71758E219652C ,   -77 ,   -4 }
+                                            , { 0x9C40000000000000 ,   -50 ,    4 }
+                                            , { 0xE8D4A51000000000 ,   -24 ,   12 }
+                                            , { 0xAD78EBC5AC620000 ,     3 ,   20 }
+                                            , { 0x813F3978F8940984 ,    30 ,   28 }
+                                            , { 0xC097CE7BC90715B3 ,    56 ,   36 }
+                                            , { 0x8F7E32CE7BEA5C70 ,    83 ,   44 }
+                                            , { 0xD5D238A4ABE98068 ,   109 ,   52 }
+                                            , { 0x9F4F2726179A2245 ,   136 ,   60 }
+                                            , { 0xED63A231D4C4FB27 ,   162 ,   68 }
+                                            , { 0xB0DE65388CC8ADA8 ,   189 ,   76 }
+                                            , { 0x83C7088E1AAB65DB ,   216 ,   84 }
+                                            , { 0xC45D1DF942711D9A ,   242 ,   92 }
+                                            , { 0x924D692CA61BE758 ,   269 ,  100 }
+                                            , { 0xDA01EE641A708DEA ,   295 ,  108 }
+                                            , { 0xA26DA3999AEF774A ,   322 ,  116 }
+                                            , { 0xF209787BB47D6B85 ,   348 ,  124 }
+                                            , { 0xB454E4A179DD1877 ,   375 ,  132 }
+                                            , { 0x865B86925B9BC5C2 ,   402 ,  140 }
+                                            , { 0xC83553C5C8965D3D ,   428 ,  148 }
+                                            , { 0x952AB45CFA97A0B3 ,   455 ,  156 }
+                                            , { 0xDE469FBD99A05FE3 ,   481 ,  164 }
+                                            , { 0xA59BC234DB398C25 ,   508 ,  172 }
+                                            , { 0xF6C69A72A3989F5C ,   534 ,  180 }
+                                            , { 0xB7DCBF5354E9BECE ,   561 ,  188 }
+                                            , { 0x88FCF317F22241E2 ,   588 ,  196 }
+                                            , { 0xCC20CE9BD35C78A5 ,   614 ,  204 }
+                                            , { 0x98165AF37B2153DF ,   641 ,  212 }
+                                            , { 0xE2A0B5DC971F303A ,   667 ,  220 }
+                                            , { 0xA8D9D1535CE3B396 ,   694 ,  228 }
+                                            , { 0xFB9B7CD9A4A7443C ,   720 ,  236 }
+                                            , { 0xBB764C4CA7A44410 ,   747 ,  244 }
+                                            , { 0x8BAB8EEFB6409C1A ,   774 ,  252 }
+                                            , { 0xD01FEF10A657842C ,   800 ,  260 }
+                                            , { 0x9B10A4E5E9913129 ,   827 ,  268 }
+                                            , { 0xE7109BFBA19C0C9D ,   853 ,  276 }
+                                            , { 0xAC2820D9623BF429 ,   880 ,  284 }
+                                            , { 0x80444B5E7AA7CF85 ,   907 ,  292 }
+                                            , { 0xBF21E44003ACDD2D ,   933 ,  300 }
+                                            , { 0x8E679C2F5E44FF8F ,   960 ,  308 }
+                                            , { 0xD433179D9C8CB841 ,   986 ,  316 }
+                                            , { 0x9E19DB92B4E31BA9 ,  1013 ,  324 }
+                                            , { 0xEB96BF6EBADF77D9 ,  1039 ,  332 }
+                                            , { 0xAF87023B9BF0EE6B ,  1066 ,  340 }
+                                            };
+
+/**
+ * @brief Every power of five from 5^-342 to 5^308, each as the most
+ * significant 128 bits of its normalized binary significand (most significant
+ * word first). Negative powers are rounded up, positive powers truncated
+ * (see _string_f64_eisel_lemire).
+ */
+static const u64 string_pow5_128[][ 2 ] = { { 0xEEF453D6923BD65A , 0x113FAA2906A13B3F } // 5^-342
+                                           , { 0x9558B4661B6565F8 , 0x4AC7CA59A424C507 } // 5^-341
+                                           , { 0xBAAEE17FA23EBF76 , 0x5D79BCF00D2DF649 } // 5^-340
+                                           , { 0xE95A99DF8ACE6F53 , 0xF4D82C2C107973DC } // 5^-339
+                                           , { 0x91D8A02BB6C10594 , 0x79071B9B8A4BE869 } // 5^-338
+                                           , { 0xB64EC836A47146F9 , 0x9748E2826CDEE284 } // 5^-337
+                                           , { 0xE3E27A444D8D98B7 , 0xFD1B1B2308169B25 } // 5^-336
+                                           , { 0x8E6D8C6AB0787F72 , 0xFE30F0F5E50E20F7 } // 5^-335
+                                           , { 0xB208EF855C969F4F , 0xBDBD2D335E51A935 } // 5^-334
+                                           , { 0xDE8B2B66B3BC4723 , 0xAD2C788035E61382 } // 5^-333
+                                           , { 0x8B16FB203055AC76 , 0x4C3BCB5021AFCC31 } // 5^-332
+                                           , { 0xADDCB9E83C6B1793 , 0xDF4ABE242A1BBF3D } // 5^-331
+                                           , { 0xD953E8624B85DD78 , 0xD71D6DAD34A2AF0D } // 5^-330
+                                           , { 0x87D4713D6F33AA6B , 0x8672648C40E5AD68 } // 5^-329
+                                           , { 0xA9C98D8CCB009506 , 0x680EFDAF511F18C2 } // 5^-328
+                                           , { 0xD43BF0EFFDC0BA48 , 0x0212BD1B2566DEF2 } // 5^-327
+                                           , { 0x84A57695FE98746D , 0x014BB630F7604B57 } // 5^-326
+                                           , { 0xA5CED43B7E3E9188 , 0x419EA3BD35385E2D } // 5^-325
+                                           , { 0xCF42894A5DCE35EA , 0x52064CAC828675B9 } // 5^-324
+                                           , { 0x818995CE7AA0E1B2 , 0x7343EFEBD1940993 } // 5^-323
+                                           , { 0xA1EBFB4219491A1F , 0x1014EBE6C5F90BF8 } // 5^-322
+                                           , { 0xCA66FA129F9B60A6 , 0xD41A26E077774EF6 } // 5^-321
+                                           , { 0xFD00B897478238D0 , 0x8920B098955522B4 } // 5^-320
+                                           , { 0x9E20735E8CB16382 , 0x55B46E5F5D5535B0 } // 5^-319
+                                           , { 0xC5A890362FDDBC62 , 0xEB2189F734AA831D } // 5^-318
+                                           , { 0xF712B443BBD52B7B , 0xA5E9EC7501D523E4 } // 5^-317
+                                           , { 0x9A6BB0AA55653B2D , 0x47B233C92125366E } // 5^-316
+                                           , { 0xC1069CD4EABE89F8 , 0x999EC0BB696E840A } // 5^-315
+                                           , { 0xF148440A256E2C76 , 0xC00670EA43CA250D } // 5^-314
+                                           , { 0x96CD2A865764DBCA , 0x380406926A5E5728 } // 5^-313
+                                           , { 0xBC807527ED3E12BC , 0xC605083704F5ECF2 } // 5^-312
+                                           , { 0xEBA09271E88D976B , 0xF7864A44C633682E } // 5^-311
+                                           , { 0x93445B8731587EA3 , 0x7AB3EE6AFBE0211D } // 5^-310
+                                           , { 0xB8157268FDAE9E4C , 0x5960EA05BAD82964 } // 5^-309
+                                           , { 0xE61ACF033D1A45DF , 0x6FB92487298E33BD } // 5^-308
+                                           , { 0x8FD0C16206306BAB , 0xA5D3B6D479F8E056 } // 5^-307
+                                           , { 0xB3C4F1BA87BC8696 , 0x8F48A4899877186C } // 5^-306
+                                           , { 0xE0B62E2929ABA83C , 0x331ACDABFE94DE87 } // 5^-305
+                                           , { 0x8C71DCD9BA0B4925 , 0x9FF0C08B7F1D0B14 } // 5^-304
+                                           , { 0xAF8E5410288E1B6F , 0x07ECF0AE5EE44DD9 } // 5^-303
+                                           , { 0xDB71E91432B1A24A , 0xC9E82CD9F69D6150 } // 5^-302
+                                           , { 0x892731AC9FAF056E , 0xBE311C083A225CD2 } // 5^-301
+                                           , { 0xAB70FE17C79AC6CA , 0x6DBD630A48AAF406 } // 5^-300
+                                           , { 0xD64D3D9DB981787D , 0x092CBBCCDAD5B108 } // 5^-299
+                                           , { 0x85F0468293F0EB4E , 0x25BBF56008C58EA5 } // 5^-298
+                                           , { 0xA76C582338ED2621 , 0xAF2AF2B80AF6F24E } // 5^-297
+                                           , { 0xD1476E2C07286FAA , 0x1AF5AF660DB4AEE1 } // 5^-296
+                                           , { 0x82CCA4DB847945CA , 0x50D98D9FC890ED4D } // 5^-295
+                                           , { 0xA37FCE126597973C , 0xE50FF107BAB528A0 } // 5^-294
+                                           , { 0xCC5FC196FEFD7D0C , 0x1E53ED49A96272C8 } // 5^-293
+                                           , { 0xFF77B1FCBEBCDC4F , 0x25E8E89C13BB0F7A } // 5^-292
+                                           , { 0x9FAACF3DF73609B1 , 0x77B191618C54E9AC } // 5^-291
+                                           , { 0xC795830D75038C1D , 0xD59DF5B9EF6A2417 } // 5^-290
+                                           , { 0xF97AE3D0D2446F25 , 0x4B0573286B44AD1D } // 5^-289
+                                           , { 0x9BECCE62836AC577 , 0x4EE367F9430AEC32 } // 5^-288
+                                           , { 0xC2E801FB244576D5 , 0x229C41F793CDA73F } // 5^-287
+                                           , { 0xF3A20279ED56D48A , 0x6B43527578C1110F } // 5^-286
+                                           , { 0x9845418C345644D6 , 0x830A13896B78AAA9 } // 5^-285
+                                           , { 0xBE5691EF416BD60C , 0x23CC986BC656D553 } // 5^-284
+                                           , { 0xEDEC366B11C6CB8F , 0x2CBFBE86B7EC8AA8 } // 5^-283
+                                           , { 0x94B3A202EB1C3F39 , 0x7BF7D71432F3D6A9 } // 5^-282
+                                           , { 0xB9E08A83A5E34F07 , 0xDAF5CCD93FB0CC53 } // 5^-281
+                                           , { 0xE858AD248F5C22C9 , 0xD1B3400F8F9CFF68 } // 5^-280
+                                           , { 0x91376C36D99995BE , 0x23100809B9C21FA1 } // 5^-279
+                                           , { 0xB58547448FFFFB2D , 0xABD40A0C2832A78A } // 5^-278
+                                           , { 0xE2E69915B3FFF9F9 , 0x16C90C8F323F516C } // 5^-277
+                                           , { 0x8DD01FAD907FFC3B , 0xAE3DA7D97F6792E3 } // 5^-276
+                                           , { 0xB1442798F49FFB4A , 0x99CD11CFDF41779C } // 5^-275
+                                           , { 0xDD95317F31C7FA1D , 0x40405643D711D583 } // 5^-274
+                                           , { 0x8A7D3EEF7F1CFC52 , 0x482835EA666B2572 } // 5^-273
+                                           , { 0xAD1C8EAB5EE43B66 , 0xDA3243650005EECF } // 5^-272
+                                           , { 0xD863B256369D4A40 , 0x90BED43E40076A82 } // 5^-271
+                                           , { 0x873E4F75E2224E68 , 0x5A7744A6E804A291 } // 5^-270
+                                           , { 0xA90DE3535AAAE202 , 0x711515D0A205CB36 } // 5^-269
+                                           , { 0xD3515C2831559A83 , 0x0D5A5B44CA873E03 } // 5^-268
+                                           , { 0x8412D9991ED58091 , 0xE858790AFE9486C2 } // 5^-267
+                                           , { 0xA5178FFF668AE0B6 , 0x626E974DBE39A872 } // 5^-266
+                                           , { 0xCE5D73FF402D98E3 , 0xFB0A3D212DC8128F } // 5^-265
+                                           , { 0x80FA687F881C7F8E , 0x7CE66634BC9D0B99 } // 5^-264
+                                           , { 0xA139029F6A239F72 , 0x1C1FFFC1EBC44E80 } // 5^-263
+                                           , { 0xC987434744AC874E , 0xA327FFB266B56220 } // 5^-262
+                                           , { 0xFBE9141915D7A922 , 0x4BF1FF9F0062BAA8 } // 5^-261
+                                           , { 0x9D71AC8FADA6C9B5 , 0x6F773FC3603DB4A9 } // 5^-260
+                                           , { 0xC4CE17B399107C22 , 0xCB550FB4384D21D3 } // 5^-259
+                                           , { 0xF6019DA07F549B2B , 0x7E2A53A146606A48 } // 5^-258
+                                           , { 0x99C102844F94E0FB , 0x2EDA7444CBFC426D } // 5^-257
+                                           , { 0xC0314325637A1939 , 0xFA911155FEFB5308 } // 5^-256
+                                           , { 0xF03D93EEBC589F88 , 0x793555AB7EBA27CA } // 5^-255
+                                           , { 0x96267C7535B763B5 , 0x4BC1558B2F3458DE } // 5^-254
+                                           , { 0xBBB01B9283253CA2 , 0x9EB1AAEDFB016F16 } // 5^-253
+                                           , { 0xEA9C227723EE8BCB , 0x465E15A979C1CADC } // 5^-252
+                                           , { 0x92A1958A7675175F , 0x0BFACD89EC191EC9 } // 5^-251
+                                           , { 0xB749FAED14125D36 , 0xCEF980EC671F667B } // 5^-250
+                                           , { 0xE51C79A85916F484 , 0x82B7E12780E7401A } // 5^-249
+                                           , { 0x8F31CC0937AE58D2 , 0xD1B2ECB8B0908810 } // 5^-248
+                                           , { 0xB2FE3F0B8599EF07 , 0x861FA7E6DCB4AA15 } // 5^-247
+                                           , { 0xDFBDCECE67006AC9 , 0x67A791E093E1D49A } // 5^-246
+                                           , { 0x8BD6A141006042BD , 0xE0C8BB2C5C6D24E0 } // 5^-245
+                                           , { 0xAECC49914078536D , 0x58FAE9F773886E18 } // 5^-244
+                                           , { 0xDA7F5BF590966848 , 0xAF39A475506A899E } // 5^-243
+                                           , { 0x888F99797A5E012D , 0x6D8406C952429603 } // 5^-242
+                                           , { 0xAAB37FD7D8F58178 , 0xC8E5087BA6D33B83 } // 5^-241
+                                           , { 0xD5605FCDCF32E1D6 , 0xFB1E4A9A90880A64 } // 5^-240
+                                           , { 0x855C3BE0A17FCD26 , 0x5CF2EEA09A55067F } // 5^-239
+                                           , { 0xA6B34AD8C9DFC06F , 0xF42FAA48C0EA481E } // 5^-238
+                                           , { 0xD0601D8EFC57B08B , 0xF13B94DAF124DA26 } // 5^-237
+                                           , { 0x823C12795DB6CE57 , 0x76C53D08D6B70858 } // 5^-236
+                                           , { 0xA2CB1717B52481ED , 0x54768C4B0C64CA6E } // 5^-235
+                                           , { 0xCB7DDCDDA26DA268 , 0xA9942F5DCF7DFD09 } // 5^-234
+                                           , { 0xFE5D54150B090B02 , 0xD3F93B35435D7C4C } // 5^-233
+                                           , { 0x9EFA548D26E5A6E1 , 0xC47BC5014A1A6DAF } // 5^-232
+                                           , { 0xC6B8E9B0709F109A , 0x359AB6419CA1091B } // 5^-231
+                                           , { 0xF867241C8CC6D4C0 , 0xC30163D203C94B62 } // 5^-230
+                                           , { 0x9B407691D7FC44F8 , 0x79E0DE63425DCF1D } // 5^-229
+                                           , { 0xC21094364DFB5636 , 0x985915FC12F542E4 } // 5^-228
+                                           , { 0xF294B943E17A2BC4 , 0x3E6F5B7B17B2939D } // 5^-227
+                                           , { 0x979CF3CA6CEC5B5A , 0xA705992CEECF9C42 } // 5^-226
+                                           , { 0xBD8430BD08277231 , 0x50C6FF782A838353 } // 5^-225
+                                           , { 0xECE53CEC4A314EBD , 0xA4F8BF5635246428 } // 5^-224
+                                           , { 0x940F4613AE5ED136 , 0x871B7795E136BE99 } // 5^-223
+                                           , { 0xB913179899F68584 , 0x28E2557B59846E3F } // 5^-222
+                                           , { 0xE757DD7EC07426E5 , 0x331AEADA2FE589CF } // 5^-221
+                                           , { 0x9096EA6F3848984F , 0x3FF0D2C85DEF7621 } // 5^-220
+                                           , { 0xB4BCA50B065ABE63 , 0x0FED077A756B53A9 } // 5^-219
+                                           , { 0xE1EBCE4DC7F16DFB , 0xD3E8495912C62894 } // 5^-218
+                                           , { 0x8D3360F09CF6E4BD , 0x64712DD7ABBBD95C } // 5^-217
+                                           , { 0xB080392CC4349DEC , 0xBD8D794D96AACFB3 } // 5^-216
+                                           , { 0xDCA04777F541C567 , 0xECF0D7A0FC5583A0 } // 5^-215
+                                           , { 0x89E42CAAF9491B60 , 0xF41686C49DB57244 } // 5^-214
+                                           , { 0xAC5D37D5B79B6239 , 0x311C2875C522CED5 } // 5^-213
+                                           , { 0xD77485CB25823AC7 , 0x7D633293366B828B } // 5^-212
+                                           , { 0x86A8D39EF77164BC , 0xAE5DFF9C02033197 } // 5^-211
+                                           , { 0xA8530886B54DBDEB , 0xD9F57F830283FDFC } // 5^-210
+                                           , { 0xD267CAA862A12D66 , 0xD072DF63C324FD7B } // 5^-209
+                                           , { 0x8380DEA93DA4BC60 , 0x4247CB9E59F71E6D } // 5^-208
+                                           , { 0xA46116538D0DEB78 , 0x52D9BE85F074E608 } // 5^-207
+                                           , { 0xCD795BE870516656 , 0x67902E276C921F8B } // 5^-206
+                                           , { 0x806BD9714632DFF6 , 0x00BA1CD8A3DB53B6 } // 5^-205
+                                           , { 0xA086CFCD97BF97F3 , 0x80E8A40ECCD228A4 } // 5^-204
+                                           , { 0xC8A883C0FDAF7DF0 , 0x6122CD128006B2CD } // 5^-203
+                                           , { 0xFAD2A4B13D1B5D6C , 0x796B805720085F81 } // 5^-202
+                                           , { 0x9CC3A6EEC6311A63 , 0xCBE3303674053BB0 } // 5^-201
+                                           , { 0xC3F490AA77BD60FC , 0xBEDBFC4411068A9C } // 5^-200
+                                           , { 0xF4F1B4D515ACB93B , 0xEE92FB5515482D44 } // 5^-199
+                                           , { 0x991711052D8BF3C5 , 0x751BDD152D4D1C4A } // 5^-198
+                                           , { 0xBF5CD54678EEF0B6 , 0xD262D45A78A0635D } // 5^-197
+                                           , { 0xEF340A98172AACE4 , 0x86FB897116C87C34 } // 5^-196
+                                           , { 0x9580869F0E7AAC0E , 0xD45D35E6AE3D4DA0 } // 5^-195
+                                           , { 0xBAE0A846D2195712 , 0x8974836059CCA109 } // 5^-194
+                                           , { 0xE998D258869FACD7 , 0x2BD1A438703FC94B } // 5^-193
+                                           , { 0x91FF83775423CC06 , 0x7B6306A34627DDCF } // 5^-192
+                                           , { 0xB67F6455292CBF08 , 0x1A3BC84C17B1D542 } // 5^-191
+                                           , { 0xE41F3D6A7377EECA , 0x20CABA5F1D9E4A93 } // 5^-190
+                                           , { 0x8E938662882AF53E , 0x547EB47B7282EE9C } // 5^-189
+                                           , { 0xB23867FB2A35B28D , 0xE99E619A4F23AA43 } // 5^-188
+                                           , { 0xDEC681F9F4C31F31 , 0x6405FA00E2EC94D4 } // 5^-187
+                                           , { 0x8B3C113C38F9F37E , 0xDE83BC408DD3DD04 } // 5^-186
+                                           , { 0xAE0B158B4738705E , 0x9624AB50B148D445 } // 5^-185
+                                           , { 0xD98DDAEE19068C76 , 0x3BADD624DD9B0957 } // 5^-184
+                                           , { 0x87F8A8D4CFA417C9 , 0xE54CA5D70A80E5D6 } // 5^-183
+                                           , { 0xA9F6D30A038D1DBC , 0x5E9FCF4CCD211F4C } // 5^-182
+                                           , { 0xD47487CC8470652B , 0x7647C3200069671F } // 5^-181
+                                           , { 0x84C8D4DFD2C63F3B , 0x29ECD9F40041E073 } // 5^-180
+                                           , { 0xA5FB0A17C777CF09 , 0xF468107100525890 } // 5^-179
+                                           , { 0xCF79CC9DB955C2CC , 0x7182148D4066EEB4 } // 5^-178
+                                           , { 0x81AC1FE293D599BF , 0xC6F14CD848405530 } // 5^-177
+                                           , { 0xA21727DB38CB002F , 0xB8ADA00E5A506A7C } // 5^-176
+                                           , { 0xCA9CF1D206FDC03B , 0xA6D90811F0E4851C } // 5^-175
+                                           , { 0xFD442E4688BD304A , 0x908F4A166D1DA663 } // 5^-174
+                                           , { 0x9E4A9CEC15763E2E , 0x9A598E4E043287FE } // 5^-173
+                                           , { 0xC5DD44271AD3CDBA , 0x40EFF1E1853F29FD } // 5^-172
+                                           , { 0xF7549530E188C128 , 0xD12BEE59E68EF47C } // 5^-171
+                                           , { 0x9A94DD3E8CF578B9 , 0x82BB74F8301958CE } // 5^-170
+                                           , { 0xC13A148E3032D6E7 , 0xE36A52363C1FAF01 } // 5^-169
+                                           , { 0xF18899B1BC3F8CA1 , 0xDC44E6C3CB279AC1 } // 5^-168
+                                           , { 0x96F5600F15A7B7E5 , 0x29AB103A5EF8C0B9 } // 5^-167
+                                           , { 0xBCB2B812DB11A5DE , 0x7415D448F6B6F0E7 } // 5^-166
+                                           , { 0xEBDF661791D60F56 , 0x111B495B3464AD21 } // 5^-165
+                                           , { 0x936B9FCEBB25C995 , 0xCAB10DD900BEEC34 } // 5^-164
+                                           , { 0xB84687C269EF3BFB , 0x3D5D514F40EEA742 } // 5^-163
+                                           , { 0xE65829B3046B0AFA , 0x0CB4A5A3112A5112 } // 5^-162
+                                           , { 0x8FF71A0FE2C2E6DC , 0x47F0E785EABA72AB } // 5^-161
+                                           , { 0xB3F4E093DB73A093 , 0x59ED216765690F56 } // 5^-160
+                                           , { 0xE0F218B8D25088B8 , 0x306869C13EC3532C } // 5^-159
+                                           , { 0x8C974F7383725573 , 0x1E414218C73A13FB } // 5^-158
+                                           , { 0xAFBD2350644EEACF , 0xE5D1929EF90898FA } // 5^-157
+                                           , { 0xDBAC6C247D62A583 , 0xDF45F746B74ABF39 } // 5^-156
+                                           , { 0x894BC396CE5DA772 , 0x6B8BBA8C328EB783 } // 5^-155
+                                           , { 0xAB9EB47C81F5114F , 0x066EA92F3F326564 } // 5^-154
+                                           , { 0xD686619BA27255A2 , 0xC80A537B0EFEFEBD } // 5^-153
+                                           , { 0x8613FD0145877585 , 0xBD06742CE95F5F36 } // 5^-152
+                                           , { 0xA798FC4196E952E7 , 0x2C48113823B73704 } // 5^-151
+                                           , { 0xD17F3B51FCA3A7A0 , 0xF75A15862CA504C5 } // 5^-150
+                                           , { 0x82EF85133DE648C4 , 0x9A984D73DBE722FB } // 5^-149
+                                           , { 0xA3AB66580D5FDAF5 , 0xC13E60D0D2E0EBBA } // 5^-148
+                                           , { 0xCC963FEE10B7D1B3 , 0x318DF905079926A8 } // 5^-147
+                                           , { 0xFFBBCFE994E5C61F , 0xFDF17746497F7052 } // 5^-146
+                                           , { 0x9FD561F1FD0F9BD3 , 0xFEB6EA8BEDEFA633 } // 5^-145
+                                           , { 0xC7CABA6E7C5382C8 , 0xFE64A52EE96B8FC0 } // 5^-144
+                                           , { 0xF9BD690A1B68637B , 0x3DFDCE7AA3C673B0 } // 5^-143
+                                           , { 0x9C1661A651213E2D , 0x06BEA10CA65C084E } // 5^-142
+                                           , { 0xC31BFA0FE5698DB8 , 0x486E494FCFF30A62 } // 5^-141
+                                           , { 0xF3E2F893DEC3F126 , 0x5A89DBA3C3EFCCFA } // 5^-140
+                                           , { 0x986DDB5C6B3A76B7 , 0xF89629465A75E01C } // 5^-139
+                                           , { 0xBE89523386091465 , 0xF6BBB397F1135823 } // 5^-138
+                                           , { 0xEE2BA6C0678B597F , 0x746AA07DED582E2C } // 5^-137
+                                           , { 0x94DB483840B717EF , 0xA8C2A44EB4571CDC } // 5^-136
+                                           , { 0xBA121A4650E4DDEB , 0x92F34D62616CE413 } // 5^-135
+                                           , { 0xE896A0D7E51E1566 , 0x77B020BAF9C81D17 } // 5^-134
+                                           , { 0x915E2486EF32CD60 , 0x0ACE1474DC1D122E } // 5^-133
+                                           , { 0xB5B5ADA8AAFF80B8 , 0x0D819992132456BA } // 5^-132
+                                           , { 0xE3231912D5BF60E6 , 0x10E1FFF697ED6C69 } // 5^-131
+                                           , { 0x8DF5EFABC5979C8F , 0xCA8D3FFA1EF463C1 } // 5^-130
+                                           , { 0xB1736B96B6FD83B3 , 0xBD308FF8A6B17CB2 } // 5^-129
+                                           , { 0xDDD0467C64BCE4A0 , 0xAC7CB3F6D05DDBDE } // 5^-128
+                                           , { 0x8AA22C0DBEF60EE4 , 0x6BCDF07A423AA96B } // 5^-127
+                                           , { 0xAD4AB7112EB3929D , 0x86C16C98D2C953C6 } // 5^-126
+                                           , { 0xD89D64D57A607744 , 0xE871C7BF077BA8B7 } // 5^-125
+                                           , { 0x87625F056C7C4A8B , 0x11471CD764AD4972 } // 5^-124
+                                           , { 0xA93AF6C6C79B5D2D , 0xD598E40D3DD89BCF } // 5^-123
+                                           , { 0xD389B47879823479 , 0x4AFF1D108D4EC2C3 } // 5^-122
+                                           , { 0x843610CB4BF160CB , 0xCEDF722A585139BA } // 5^-121
+                                           , { 0xA54394FE1EEDB8FE , 0xC2974EB4EE658828 } // 5^-120
+                                           , { 0xCE947A3DA6A9273E , 0x733D226229FEEA32 } // 5^-119
+                                           , { 0x811CCC668829B887 , 0x0806357D5A3F525F } // 5^-118
+                                           , { 0xA163FF802A3426A8 , 0xCA07C2DCB0CF26F7 } // 5^-117
+                                           , { 0xC9BCFF6034C13052 , 0xFC89B393DD02F0B5 } // 5^-116
+                                           , { 0xFC2C3F3841F17C67 , 0xBBAC2078D443ACE2 } // 5^-115
+                                           , { 0x9D9BA7832936EDC0 , 0xD54B944B84AA4C0D } // 5^-114
+                                           , { 0xC5029163F384A931 , 0x0A9E795E65D4DF11 } // 5^-113
+                                           , { 0xF64335BCF065D37D , 0x4D4617B5FF4A16D5 } // 5^-112
+                                           , { 0x99EA0196163FA42E , 0x504BCED1BF8E4E45 } // 5^-111
+                                           , { 0xC06481FB9BCF8D39 , 0xE45EC2862F71E1D6 } // 5^-110
+                                           , { 0xF07DA27A82C37088 , 0x5D767327BB4E5A4C } // 5^-109
+                                           , { 0x964E858C91BA2655 , 0x3A6A07F8D510F86F } // 5^-108
+                                           , { 0xBBE226EFB628AFEA , 0x890489F70A55368B } // 5^-107
+                                           , { 0xEADAB0ABA3B2DBE5 , 0x2B45AC74CCEA842E } // 5^-106
+                                           , { 0x92C8AE6B464FC96F , 0x3B0B8BC90012929D } // 5^-105
+                                           , { 0xB77ADA0617E3BBCB , 0x09CE6EBB40173744 } // 5^-104
+                                           , { 0xE55990879DDCAABD , 0xCC420A6A101D0515 } // 5^-103
+                                           , { 0x8F57FA54C2A9EAB6 , 0x9FA946824A12232D } // 5^-102
+                                           , { 0xB32DF8E9F3546564 , 0x47939822DC96ABF9 } // 5^-101
+                                           , { 0xDFF9772470297EBD , 0x59787E2B93BC56F7 } // 5^-100
+                                           , { 0x8BFBEA76C619EF36 , 0x57EB4EDB3C55B65A } // 5^-99
+                                           , { 0xAEFAE51477A06B03 , 0xEDE622920B6B23F1 } // 5^-98
+                                           , { 0xDAB99E59958885C4 , 0xE95FAB368E45ECED } // 5^-97
+                                           , { 0x88B402F7FD75539B , 0x11DBCB0218EBB414 } // 5^-96
+                                           , { 0xAAE103B5FCD2A881 , 0xD652BDC29F26A119 } // 5^-95
+                                           , { 0xD59944A37C0752A2 , 0x4BE76D3346F0495F } // 5^-94
+                                           , { 0x857FCAE62D8493A5 , 0x6F70A4400C562DDB } // 5^-93
+                                           , { 0xA6DFBD9FB8E5B88E , 0xCB4CCD500F6BB952 } // 5^-92
+                                           , { 0xD097AD07A71F26B2 , 0x7E2000A41346A7A7 } // 5^-91
+                                           , { 0x825ECC24C873782F , 0x8ED400668C0C28C8 } // 5^-90
+                                           , { 0xA2F67F2DFA90563B , 0x728900802F0F32FA } // 5^-89
+                                           , { 0xCBB41EF979346BCA , 0x4F2B40A03AD2FFB9 } // 5^-88
+                                           , { 0xFEA126B7D78186BC , 0xE2F610C84987BFA8 } // 5^-87
+                                           , { 0x9F24B832E6B0F436 , 0x0DD9CA7D2DF4D7C9 } // 5^-86
+                                           , { 0xC6EDE63FA05D3143 , 0x91503D1C79720DBB } // 5^-85
+                                           , { 0xF8A95FCF88747D94 , 0x75A44C6397CE912A } // 5^-84
+                                           , { 0x9B69DBE1B548CE7C , 0xC986AFBE3EE11ABA } // 5^-83
+                                           , { 0xC24452DA229B021B , 0xFBE85BADCE996168 } // 5^-82
+                                           , { 0xF2D56790AB41C2A2 , 0xFAE27299423FB9C3 } // 5^-81
+                                           , { 0x97C560BA6B0919A5 , 0xDCCD879FC967D41A } // 5^-80
+                                           , { 0xBDB6B8E905CB600F , 0x5400E987BBC1C920 } // 5^-79
+                                           , { 0xED246723473E3813 , 0x290123E9AAB23B68 } // 5^-78
+                                           , { 0x9436C0760C86E30B , 0xF9A0B6720AAF6521 } // 5^-77
+                                           , { 0xB94470938FA89BCE , 0xF808E40E8D5B3E69 } // 5^-76
+                                           , { 0xE7958CB87392C2C2 , 0xB60B1D1230B20E04 } // 5^-75
+                                           , { 0x90BD77F3483BB9B9 , 0xB1C6F22B5E6F48C2 } // 5^-74
+                                           , { 0xB4ECD5F01A4AA828 , 0x1E38AEB6360B1AF3 } // 5^-73
+                                           , { 0xE2280B6C20DD5232 , 0x25C6DA63C38DE1B0 } // 5^-72
+                                           , { 0x8D590723948A535F , 0x579C487E5A38AD0E } // 5^-71
+                                           , { 0xB0AF48EC79ACE837 , 0x2D835A9DF0C6D851 } // 5^-70
+                                           , { 0xDCDB1B2798182244 , 0xF8E431456CF88E65 } // 5^-69
+                                           , { 0x8A08F0F8BF0F156B , 0x1B8E9ECB641B58FF } // 5^-68
+                                           , { 0xAC8B2D36EED2DAC5 , 0xE272467E3D222F3F } // 5^-67
+                                           , { 0xD7ADF884AA879177 , 0x5B0ED81DCC6ABB0F } // 5^-66
+                                           , { 0x86CCBB52EA94BAEA , 0x98E947129FC2B4E9 } // 5^-65
+                                           , { 0xA87FEA27A539E9A5 , 0x3F2398D747B36224 } // 5^-64
+                                           , { 0xD29FE4B18E88640E , 0x8EEC7F0D19A03AAD } // 5^-63
+                                           , { 0x83A3EEEEF9153E89 , 0x1953CF68300424AC } // 5^-62
+                                           , { 0xA48CEAAAB75A8E2B , 0x5FA8C3423C052DD7 } // 5^-61
+                                           , { 0xCDB02555653131B6 , 0x3792F412CB06794D } // 5^-60
+                                           , { 0x808E17555F3EBF11 , 0xE2BBD88BBEE40BD0 } // 5^-59
+                                           , { 0xA0B19D2AB70E6ED6 , 0x5B6ACEAEAE9D0EC4 } // 5^-58
+                                           , { 0xC8DE047564D20A8B , 0xF245825A5A445275 } // 5^-57
+                                           , { 0xFB158592BE068D2E , 0xEED6E2F0F0D56712 } // 5^-56
+                                           , { 0x9CED737BB6C4183D , 0x55464DD69685606B } // 5^-55
+                                           , { 0xC428D05AA4751E4C , 0xAA97E14C3C26B886 } // 5^-54
+                                           , { 0xF53304714D9265DF , 0xD53DD99F4B3066A8 } // 5^-53
+                                           , { 0x993FE2C6D07B7FAB , 0xE546A8038EFE4029 } // 5^-52
+                                           , { 0xBF8FDB78849A5F96 , 0xDE98520472BDD033 } // 5^-51
+                                           , { 0xEF73D256A5C0F77C , 0x963E66858F6D4440 } // 5^-50
+                                           , { 0x95A8637627989AAD , 0xDDE7001379A44AA8 } // 5^-49
+                                           , { 0xBB127C53B17EC159 , 0x5560C018580D5D52 } // 5^-48
+                                           , { 0xE9D71B689DDE71AF , 0xAAB8F01E6E10B4A6 } // 5^-47
+                                           , { 0x9226712162AB070D , 0xCAB3961304CA70E8 } // 5^-46
+                                           , { 0xB6B00D69BB55C8D1 , 0x3D607B97C5FD0D22 } // 5^-45
+                                           , { 0xE45C10C42A2B3B05 , 0x8CB89A7DB77C506A } // 5^-44
+                                           , { 0x8EB98A7A9A5B04E3 , 0x77F3608E92ADB242 } // 5^-43
+                                           , { 0xB267ED1940F1C61C , 0x55F038B237591ED3 } // 5^-42
+                                           , { 0xDF01E85F912E37A3 , 0x6B6C46DEC52F6688 } // 5^-41
+                                           , { 0x8B61313BBABCE2C6 , 0x2323AC4B3B3DA015 } // 5^-40
+                                           , { 0xAE397D8AA96C1B77 , 0xABEC975E0A0D081A } // 5^-39
+                                           , { 0xD9C7DCED53C72255 , 0x96E7BD358C904A21 } // 5^-38
+                                           , { 0x881CEA14545C7575 , 0x7E50D64177DA2E54 } // 5^-37
+                                           , { 0xAA242499697392D2 , 0xDDE50BD1D5D0B9E9 } // 5^-36
+                                           , { 0xD4AD2DBFC3D07787 , 0x955E4EC64B44E864 } // 5^-35
+                                           , { 0x84EC3C97DA624AB4 , 0xBD5AF13BEF0B113E } // 5^-34
+                                           , { 0xA6274BBDD0FADD61 , 0xECB1AD8AEACDD58E } // 5^-33
+                                           , { 0xCFB11EAD453994BA , 0x67DE18EDA5814AF2 } // 5^-32
+                                           , { 0x81CEB32C4B43FCF4 , 0x80EACF948770CED7 } // 5^-31
+                                           , { 0xA2425FF75E14FC31 , 0xA1258379A94D028D } // 5^-30
+                                           , { 0xCAD2F7F5359A3B3E , 0x096EE45813A04330 } // 5^-29
+                                           , { 0xFD87B5F28300CA0D , 0x8BCA9D6E188853FC } // 5^-28
+                                           , { 0x9E74D1B791E07E48 , 0x775EA264CF55347E } // 5^-27
+                                           , { 0xC612062576589DDA , 0x95364AFE032A819E } // 5^-26
+                                           , { 0xF79687AED3EEC551 , 0x3A83DDBD83F52205 } // 5^-25
+                                           , { 0x9ABE14CD44753B52 , 0xC4926A9672793543 } // 5^-24
+                                           , { 0xC16D9A0095928A27 , 0x75B7053C0F178294 } // 5^-23
+                                           , { 0xF1C90080BAF72CB1 , 0x5324C68B12DD6339 } // 5^-22
+                                           , { 0x971DA05074DA7BEE , 0xD3F6FC16EBCA5E04 } // 5^-21
+                                           , { 0xBCE5086492111AEA , 0x88F4BB1CA6BCF585 } // 5^-20
+                                           , { 0xEC1E4A7DB69561A5 , 0x2B31E9E3D06C32E6 } // 5^-19
+                                           , { 0x9392EE8E921D5D07 , 0x3AFF322E62439FD0 } // 5^-18
+                                           , { 0xB877AA3236A4B449 , 0x09BEFEB9FAD487C3 } // 5^-17
+                                           , { 0xE69594BEC44DE15B , 0x4C2EBE687989A9B4 } // 5^-16
+                                           , { 0x901D7CF73AB0ACD9 , 0x0F9D37014BF60A11 } // 5^-15
+                                           , { 0xB424DC35095CD80F , 0x538484C19EF38C95 } // 5^-14
+                                           , { 0xE12E13424BB40E13 , 0x2865A5F206B06FBA } // 5^-13
+                                           , { 0x8CBCCC096F5088CB , 0xF93F87B7442E45D4 } // 5^-12
+                                           , { 0xAFEBFF0BCB24AAFE , 0xF78F69A51539D749 } // 5^-11
+                                           , { 0xDBE6FECEBDEDD5BE , 0xB573440E5A884D1C } // 5^-10
+                                           , { 0x89705F4136B4A597 , 0x31680A88F8953031 } // 5^-9
+                                           , { 0xABCC77118461CEFC , 0xFDC20D2B36BA7C3E } // 5^-8
+                                           , { 0xD6BF94D5E57A42BC , 0x3D32907604691B4D } // 5^-7
+                                           , { 0x8637BD05AF6C69B5 , 0xA63F9A49C2C1B110 } // 5^-6
+                                           , { 0xA7C5AC471B478423 , 0x0FCF80DC33721D54 } // 5^-5
+                                           , { 0xD1B71758E219652B , 0xD3C36113404EA4A9 } // 5^-4
+                                           , { 0x83126E978D4FDF3B , 0x645A1CAC083126EA } // 5^-3
+                                           , { 0xA3D70A3D70A3D70A , 0x3D70A3D70A3D70A4 } // 5^-2
+                                           , { 0xCCCCCCCCCCCCCCCC , 0xCCCCCCCCCCCCCCCD } // 5^-1
+                                           , { 0x8000000000000000 , 0x0000000000000000 } // 5^0
+                                           , { 0xA000000000000000 , 0x0000000000000000 } // 5^1
+                                           , { 0xC800000000000000 , 0x0000000000000000 } // 5^2
+                                           , { 0xFA00000000000000 , 0x0000000000000000 } // 5^3
+                                           , { 0x9C40000000000000 , 0x0000000000000000 } // 5^4
+                                           , { 0xC350000000000000 , 0x0000000000000000 } // 5^5
+                                           , { 0xF424000000000000 , 0x0000000000000000 } // 5^6
+                                           , { 0x9896800000000000 , 0x0000000000000000 } // 5^7
+                                           , { 0xBEBC200000000000 , 0x0000000000000000 } // 5^8
+                                           , { 0xEE6B280000000000 , 0x0000000000000000 } // 5^9
+                                           , { 0x9502F90000000000 , 0x0000000000000000 } // 5^10
+                                           , { 0xBA43B74000000000 , 0x0000000000000000 } // 5^11
+                                           , { 0xE8D4A51000000000 , 0x0000000000000000 } // 5^12
+                                           , { 0x9184E72A00000000 , 0x0000000000000000 } // 5^13
+                                           , { 0xB5E620F480000000 , 0x0000000000000000 } // 5^14
+                                           , { 0xE35FA931A0000000 , 0x0000000000000000 } // 5^15
+                                           , { 0x8E1BC9BF04000000 , 0x0000000000000000 } // 5^16
+                                           , { 0xB1A2BC2EC5000000 , 0x0000000000000000 } // 5^17
+                                           , { 0xDE0B6B3A76400000 , 0x0000000000000000 } // 5^18
+                                           , { 0x8AC7230489E80000 , 0x0000000000000000 } // 5^19
+                                           , { 0xAD78EBC5AC620000 , 0x0000000000000000 } // 5^20
+                                           , { 0xD8D726B7177A8000 , 0x0000000000000000 } // 5^21
+                                           , { 0x878678326EAC9000 , 0x0000000000000000 } // 5^22
+                                           , { 0xA968163F0A57B400 , 0x0000000000000000 } // 5^23
+                                           , { 0xD3C21BCECCEDA100 , 0x0000000000000000 } // 5^24
+                                           , { 0x84595161401484A0 , 0x0000000000000000 } // 5^25
+                                           , { 0xA56FA5B99019A5C8 , 0x0000000000000000 } // 5^26
+                                           , { 0xCECB8F27F4200F3A , 0x0000000000000000 } // 5^27
+                                           , { 0x813F3978F8940984 , 0x4000000000000000 } // 5^28
+                                           , { 0xA18F07D736B90BE5 , 0x5000000000000000 } // 5^29
+                                           , { 0xC9F2C9CD04674EDE , 0xA400000000000000 } // 5^30
+                                           , { 0xFC6F7C4045812296 , 0x4D00000000000000 } // 5^31
+                                           , { 0x9DC5ADA82B70B59D , 0xF020000000000000 } // 5^32
+                                           , { 0xC5371912364CE305 , 0x6C28000000000000 } // 5^33
+                                           , { 0xF684DF56C3E01BC6 , 0xC732000000000000 } // 5^34
+                                           , { 0x9A130B963A6C115C , 0x3C7F400000000000 } // 5^35
+                                           , { 0xC097CE7BC90715B3 , 0x4B9F100000000000 } // 5^36
+                                           , { 0xF0BDC21ABB48DB20 , 0x1E86D40000000000 } // 5^37
+                                           , { 0x96769950B50D88F4 , 0x1314448000000000 } // 5^38
+                                           , { 0xBC143FA4E250EB31 , 0x17D955A000000000 } // 5^39
+                                           , { 0xEB194F8E1AE525FD , 0x5DCFAB0800000000 } // 5^40
+                                           , { 0x92EFD1B8D0CF37BE , 0x5AA1CAE500000000 } // 5^41
+                                           , { 0xB7ABC627050305AD , 0xF14A3D9E40000000 } // 5^42
+                                           , { 0xE596B7B0C643C719 , 0x6D9CCD05D0000000 } // 5^43
+                                           , { 0x8F7E32CE7BEA5C6F , 0xE4820023A2000000 } // 5^44
+                                           , { 0xB35DBF821AE4F38B , 0xDDA2802C8A800000 } // 5^45
+                                           , { 0xE0352F62A19E306E , 0xD50B2037AD200000 } // 5^46
+                                           , { 0x8C213D9DA502DE45 , 0x4526F422CC340000 } // 5^47
+                                           , { 0xAF298D050E4395D6 , 0x9670B12B7F410000 } // 5^48
+                                           , { 0xDAF3F04651D47B4C , 0x3C0CDD765F114000 } // 5^49
+                                           , { 0x88D8762BF324CD0F , 0xA5880A69FB6AC800 } // 5^50
+                                           , { 0xAB0E93B6EFEE0053 , 0x8EEA0D047A457A00 } // 5^51
+                                           , { 0xD5D238A4ABE98068 , 0x72A4904598D6D880 } // 5^52
+                                           , { 0x85A36366EB71F041 , 0x47A6DA2B7F864750 } // 5^53
+                                           , { 0xA70C3C40A64E6C51 , 0x999090B65F67D924 } // 5^54
+                                           , { 0xD0CF4B50CFE20765 , 0xFFF4B4E3F741CF6D } // 5^55
+                                           , { 0x82818F1281ED449F , 0xBFF8F10E7A8921A4 } // 5^56
+                                           , { 0xA321F2D7226895C7 , 0xAFF72D52192B6A0D } // 5^57
+                                           , { 0xCBEA6F8CEB02BB39 , 0x9BF4F8A69F764490 } // 5^58
+                                           , { 0xFEE50B7025C36A08 , 0x02F236D04753D5B4 } // 5^59
+                                           , { 0x9F4F2726179A2245 , 0x01D762422C946590 } // 5^60
+                                           , { 0xC722F0EF9D80AAD6 , 0x424D3AD2B7B97EF5 } // 5^61
+                                           , { 0xF8EBAD2B84E0D58B , 0xD2E0898765A7DEB2 } // 5^62
+                                           , { 0x9B934C3B330C8577 , 0x63CC55F49F88EB2F } // 5^63
+                                           , { 0xC2781F49FFCFA6D5 , 0x3CBF6B71C76B25FB } // 5^64
+                                           , { 0xF316271C7FC3908A , 0x8BEF464E3945EF7A } // 5^65
+                                           , { 0x97EDD871CFDA3A56 , 0x97758BF0E3CBB5AC } // 5^66
+                                           , { 0xBDE94E8E43D0C8EC , 0x3D52EEED1CBEA317 } // 5^67
+                                           , { 0xED63A231D4C4FB27 , 0x4CA7AAA863EE4BDD } // 5^68
+                                           , { 0x945E455F24FB1CF8 , 0x8FE8CAA93E74EF6A } // 5^69
+                                           , { 0xB975D6B6EE39E436 , 0xB3E2FD538E122B44 } // 5^70
+                                           , { 0xE7D34C64A9C85D44 , 0x60DBBCA87196B616 } // 5^71
+                                           , { 0x90E40FBEEA1D3A4A , 0xBC8955E946FE31CD } // 5^72
+                                           , { 0xB51D13AEA4A488DD , 0x6BABAB6398BDBE41 } // 5^73
+                                           , { 0xE264589A4DCDAB14 , 0xC696963C7EED2DD1 } // 5^74
+                                           , { 0x8D7EB76070A08AEC , 0xFC1E1DE5CF543CA2 } // 5^75
+                                           , { 0xB0DE65388CC8ADA8 , 0x3B25A55F43294BCB } // 5^76
+                                           , { 0xDD15FE86AFFAD912 , 0x49EF0EB713F39EBE } // 5^77
+                                           , { 0x8A2DBF142DFCC7AB , 0x6E3569326C784337 } // 5^78
+                                           , { 0xACB92ED9397BF996 , 0x49C2C37F07965404 } // 5^79
+                                           , { 0xD7E77A8F87DAF7FB , 0xDC33745EC97BE906 } // 5^80
+                                           , { 0x86F0AC99B4E8DAFD , 0x69A028BB3DED71A3 } // 5^81
+                                           , { 0xA8ACD7C0222311BC , 0xC40832EA0D68CE0C } // 5^82
+                                           , { 0xD2D80DB02AABD62B , 0xF50A3FA490C30190 } // 5^83
+                                           , { 0x83C7088E1AAB65DB , 0x792667C6DA79E0FA } // 5^84
+                                           , { 0xA4B8CAB1A1563F52 , 0x577001B891185938 } // 5^85
+                                           , { 0xCDE6FD5E09ABCF26 , 0xED4C0226B55E6F86 } // 5^86
+                                           , { 0x80B05E5AC60B6178 , 0x544F8158315B05B4 } // 5^87
+                                           , { 0xA0DC75F1778E39D6 , 0x696361AE3DB1C721 } // 5^88
+                                           , { 0xC913936DD571C84C , 0x03BC3A19CD1E38E9 } // 5^89
+                                           , { 0xFB5878494ACE3A5F , 0x04AB48A04065C723 } // 5^90
+                                           , { 0x9D174B2DCEC0E47B , 0x62EB0D64283F9C76 } // 5^91
+                                           , { 0xC45D1DF942711D9A , 0x3BA5D0BD324F8394 } // 5^92
+                                           , { 0xF5746577930D6500 , 0xCA8F44EC7EE36479 } // 5^93
+                                           , { 0x9968BF6ABBE85F20 , 0x7E998B13CF4E1ECB } // 5^94
+                                           , { 0xBFC2EF456AE276E8 , 0x9E3FEDD8C321A67E } // 5^95
+                                           , { 0xEFB3AB16C59B14A2 , 0xC5CFE94EF3EA101E } // 5^96
+                                           , { 0x95D04AEE3B80ECE5 , 0xBBA1F1D158724A12 } // 5^97
+                                           , { 0xBB445DA9CA61281F , 0x2A8A6E45AE8EDC97 } // 5^98
+                                           , { 0xEA1575143CF97226 , 0xF52D09D71A3293BD } // 5^99
+                                           , { 0x924D692CA61BE758 , 0x593C2626705F9C56 } // 5^100
+                                           , { 0xB6E0C377CFA2E12E , 0x6F8B2FB00C77836C } // 5^101
+                                           , { 0xE498F455C38B997A , 0x0B6DFB9C0F956447 } // 5^102
+                                           , { 0x8EDF98B59A373FEC , 0x4724BD4189BD5EAC } // 5^103
+                                           , { 0xB2977EE300C50FE7 , 0x58EDEC91EC2CB657 } // 5^104
+                                           , { 0xDF3D5E9BC0F653E1 , 0x2F2967B66737E3ED } // 5^105
+                                           , { 0x8B865B215899F46C , 0xBD79E0D20082EE74 } // 5^106
+                                           , { 0xAE67F1E9AEC07187 , 0xECD8590680A3AA11 } // 5^107
+                                           , { 0xDA01EE641A708DE9 , 0xE80E6F4820CC9495 } // 5^108
+                                           , { 0x884134FE908658B2 , 0x3109058D147FDCDD } // 5^109
+                                           , { 0xAA51823E34A7EEDE , 0xBD4B46F0599FD415 } // 5^110
+                                           , { 0xD4E5E2CDC1D1EA96 , 0x6C9E18AC7007C91A } // 5^111
+                                           , { 0x850FADC09923329E , 0x03E2CF6BC604DDB0 } // 5^112
+                                           , { 0xA6539930BF6BFF45 , 0x84DB8346B786151C } // 5^113
+                                           , { 0xCFE87F7CEF46FF16 , 0xE612641865679A63 } // 5^114
+                                           , { 0x81F14FAE158C5F6E , 0x4FCB7E8F3F60C07E } // 5^115
+                                           , { 0xA26DA3999AEF7749 , 0xE3BE5E330F38F09D } // 5^116
+                                           , { 0xCB090C8001AB551C , 0x5CADF5BFD3072CC5 } // 5^117
+                                           , { 0xFDCB4FA002162A63 , 0x73D9732FC7C8F7F6 } // 5^118
+                                           , { 0x9E9F11C4014DDA7E , 0x2867E7FDDCDD9AFA } // 5^119
+                                           , { 0xC646D63501A1511D , 0xB281E1FD541501B8 } // 5^120
+                                           , { 0xF7D88BC24209A565 , 0x1F225A7CA91A4226 } // 5^121
+                                           , { 0x9AE757596946075F , 0x3375788DE9B06958 } // 5^122
+                                           , { 0xC1A12D2FC3978937 , 0x0052D6B1641C83AE } // 5^123
+                                           , { 0xF209787BB47D6B84 , 0xC0678C5DBD23A49A } // 5^124
+                                           , { 0x9745EB4D50CE6332 , 0xF840B7BA963646E0 } // 5^125
+                                           , { 0xBD176620A501FBFF , 0xB650E5A93BC3D898 } // 5^126
+                                           , { 0xEC5D3FA8CE427AFF , 0xA3E51F138AB4CEBE } // 5^127
+                                           , { 0x93BA47C980E98CDF , 0xC66F336C36B10137 } // 5^128
+                                           , { 0xB8A8D9BBE123F017 , 0xB80B0047445D4184 } // 5^129
+                                           , { 0xE6D3102AD96CEC1D , 0xA60DC059157491E5 } // 5^130
+                                           , { 0x9043EA1AC7E41392 , 0x87C89837AD68DB2F } // 5^131
+                                           , { 0xB454E4A179DD1877 , 0x29BABE4598C311FB } // 5^132
+                                           , { 0xE16A1DC9D8545E94 , 0xF4296DD6FEF3D67A } // 5^133
+                                           , { 0x8CE2529E2734BB1D , 0x1899E4A65F58660C } // 5^134
+                                           , { 0xB01AE745B101E9E4 , 0x5EC05DCFF72E7F8F } // 5^135
+                                           , { 0xDC21A1171D42645D , 0x76707543F4FA1F73 } // 5^136
+                                           , { 0x899504AE72497EBA , 0x6A06494A791C53A8 } // 5^137
+                                           , { 0xABFA45DA0EDBDE69 , 0x0487DB9D17636892 } // 5^138
+                                           , { 0xD6F8D7509292D603 , 0x45A9D2845D3C42B6 } // 5^139
+                                           , { 0x865B86925B9BC5C2 , 0x0B8A2392BA45A9B2 } // 5^140
+                                           , { 0xA7F26836F282B732 , 0x8E6CAC7768D7141E } // 5^141
+                                           , { 0xD1EF0244AF2364FF , 0x3207D795430CD926 } // 5^142
+                                           , { 0x8335616AED761F1F , 0x7F44E6BD49E807B8 } // 5^143
+                                           , { 0xA402B9C5A8D3A6E7 , 0x5F16206C9C6209A6 } // 5^144
+                                           , { 0xCD036837130890A1 , 0x36DBA887C37A8C0F } // 5^145
+                                           , { 0x802221226BE55A64 , 0xC2494954DA2C9789 } // 5^146
+                                           , { 0xA02AA96B06DEB0FD , 0xF2DB9BAA10B7BD6C } // 5^147
+                                           , { 0xC83553C5C8965D3D , 0x6F92829494E5ACC7 } // 5^148
+                                           , { 0xFA42A8B73ABBF48C , 0xCB772339BA1F17F9 } // 5^149
+                                           , { 0x9C69A97284B578D7 , 0xFF2A760414536EFB } // 5^150
+                                           , { 0xC38413CF25E2D70D , 0xFEF5138519684ABA } // 5^151
+                                           , { 0xF46518C2EF5B8CD1 , 0x7EB258665FC25D69 } // 5^152
+                                           , { 0x98BF2F79D5993802 , 0xEF2F773FFBD97A61 } // 5^153
+                                           , { 0xBEEEFB584AFF8603 , 0xAAFB550FFACFD8FA } // 5^154
+                                           , { 0xEEAABA2E5DBF6784 , 0x95BA2A53F983CF38 } // 5^155
+                                           , { 0x952AB45CFA97A0B2 , 0xDD945A747BF26183 } // 5^156
+                                           , { 0xBA756174393D88DF , 0x94F971119AEEF9E4 } // 5^157
+                                           , { 0xE912B9D1478CEB17 , 0x7A37CD5601AAB85D } // 5^158
+                                           , { 0x91ABB422CCB812EE , 0xAC62E055C10AB33A } // 5^159
+                                           , { 0xB616A12B7FE617AA , 0x577B986B314D6009 } // 5^160
+                                           , { 0xE39C49765FDF9D94 , 0xED5A7E85FDA0B80B } // 5^161
+                                           , { 0x8E41ADE9FBEBC27D , 0x14588F13BE847307 } // 5^162
+                                           , { 0xB1D219647AE6B31C , 0x596EB2D8AE258FC8 } // 5^163
+                                           , { 0xDE469FBD99A05FE3 , 0x6FCA5F8ED9AEF3BB } // 5^164
+                                           , { 0x8AEC23D680043BEE , 0x25DE7BB9480D5854 } // 5^165
+                                           , { 0xADA72CCC20054AE9 , 0xAF561AA79A10AE6A } // 5^166
+                                           , { 0xD910F7FF28069DA4 , 0x1B2BA1518094DA04 } // 5^167
+                                           , { 0x87AA9AFF79042286 , 0x90FB44D2F05D0842 } // 5^168
+                                           , { 0xA99541BF57452B28 , 0x353A1607AC744A53 } // 5^169
+                                           , { 0xD3FA922F2D1675F2 , 0x42889B8997915CE8 } // 5^170
+                                           , { 0x847C9B5D7C2E09B7 , 0x69956135FEBADA11 } // 5^171
+                                           , { 0xA59BC234DB398C25 , 0x43FAB9837E699095 } // 5^172
+                                           , { 0xCF02B2C21207EF2E , 0x94F967E45E03F4BB } // 5^173
+                                           , { 0x8161AFB94B44F57D , 0x1D1BE0EEBAC278F5 } // 5^174
+                                           , { 0xA1BA1BA79E1632DC , 0x6462D92A69731732 } // 5^175
+                                           , { 0xCA28A291859BBF93 , 0x7D7B8F7503CFDCFE } // 5^176
+                                           , { 0xFCB2CB35E702AF78 , 0x5CDA735244C3D43E } // 5^177
+                                           , { 0x9DEFBF01B061ADAB , 0x3A0888136AFA64A7 } // 5^178
+                                           , { 0xC56BAEC21C7A1916 , 0x088AAA1845B8FDD0 } // 5^179
+                                           , { 0xF6C69A72A3989F5B , 0x8AAD549E57273D45 } // 5^180
+                                           , { 0x9A3C2087A63F6399 , 0x36AC54E2F678864B } // 5^181
+                                           , { 0xC0CB28A98FCF3C7F , 0x84576A1BB416A7DD } // 5^182
+                                           , { 0xF0FDF2D3F3C30B9F , 0x656D44A2A11C51D5 } // 5^183
+                                           , { 0x969EB7C47859E743 , 0x9F644AE5A4B1B325 } // 5^184
+                                           , { 0xBC4665B596706114 , 0x873D5D9F0DDE1FEE } // 5^185
+                                           , { 0xEB57FF22FC0C7959 , 0xA90CB506D155A7EA } // 5^186
+                                           , { 0x9316FF75DD87CBD8 , 0x09A7F12442D588F2 } // 5^187
+                                           , { 0xB7DCBF5354E9BECE , 0x0C11ED6D538AEB2F } // 5^188
+                                           , { 0xE5D3EF282A242E81 , 0x8F1668C8A86DA5FA } // 5^189
+                                           , { 0x8FA475791A569D10 , 0xF96E017D694487BC } // 5^190
+                                           , { 0xB38D92D760EC4455 , 0x37C981DCC395A9AC } // 5^191
+                                           , { 0xE070F78D3927556A , 0x85BBE253F47B1417 } // 5^192
+                                           , { 0x8C469AB843B89562 , 0x93956D7478CCEC8E } // 5^193
+                                           , { 0xAF58416654A6BABB , 0x387AC8D1970027B2 } // 5^194
+                                           , { 0xDB2E51BFE9D0696A , 0x06997B05FCC0319E } // 5^195
+                                           , { 0x88FCF317F22241E2 , 0x441FECE3BDF81F03 } // 5^196
+                                           , { 0xAB3C2FDDEEAAD25A , 0xD527E81CAD7626C3 } // 5^197
+                                           , { 0xD60B3BD56A5586F1 , 0x8A71E223D8D3B074 } // 5^198
+                                           , { 0x85C7056562757456 , 0xF6872D5667844E49 } // 5^199
+                                           , { 0xA738C6BEBB12D16C , 0xB428F8AC016561DB } // 5^200
+                                           , { 0xD106F86E69D785C7 , 0xE13336D701BEBA52 } // 5^201
+                                           , { 0x82A45B450226B39C , 0xECC0024661173473 } // 5^202
+                                           , { 0xA34D721642B06084 , 0x27F002D7F95D0190 } // 5^203
+                                           , { 0xCC20CE9BD35C78A5 , 0x31EC038DF7B441F4 } // 5^204
+                                           , { 0xFF290242C83396CE , 0x7E67047175A15271 } // 5^205
+                                           , { 0x9F79A169BD203E41 , 0x0F0062C6E984D386 } // 5^206
+                                           , { 0xC75809C42C684DD1 , 0x52C07B78A3E60868 } // 5^207
+                                           , { 0xF92E0C3537826145 , 0xA7709A56CCDF8A82 } // 5^208
+                                           , { 0x9BBCC7A142B17CCB , 0x88A66076400BB691 } // 5^209
+                                           , { 0xC2ABF989935DDBFE , 0x6ACFF893D00EA435 } // 5^210
+                                           , { 0xF356F7EBF83552FE , 0x0583F6B8C4124D43 } // 5^211
+                                           , { 0x98165AF37B2153DE , 0xC3727A337A8B704A } // 5^212
+                                           , { 0xBE1BF1B059E9A8D6 , 0x744F18C0592E4C5C } // 5^213
+                                           , { 0xEDA2EE1C7064130C , 0x1162DEF06F79DF73 } // 5^214
+                                           , { 0x9485D4D1C63E8BE7 , 0x8ADDCB5645AC2BA8 } // 5^215
+                                           , { 0xB9A74A0637CE2EE1 , 0x6D953E2BD7173692 } // 5^216
+                                           , { 0xE8111C87C5C1BA99 , 0xC8FA8DB6CCDD0437 } // 5^217
+                                           , { 0x910AB1D4DB9914A0 , 0x1D9C9892400A22A2 } // 5^218
+                                           , { 0xB54D5E4A127F59C8 , 0x2503BEB6D00CAB4B } // 5^219
+                                           , { 0xE2A0B5DC971F303A , 0x2E44AE64840FD61D } // 5^220
+                                           , { 0x8DA471A9DE737E24 , 0x5CEAECFED289E5D2 } // 5^221
+                                           , { 0xB10D8E1456105DAD , 0x7425A83E872C5F47 } // 5^222
+                                           , { 0xDD50F1996B947518 , 0xD12F124E28F77719 } // 5^223
+                                           , { 0x8A5296FFE33CC92F , 0x82BD6B70D99AAA6F } // 5^224
+                                           , { 0xACE73CBFDC0BFB7B , 0x636CC64D1001550B } // 5^225
+                                           , { 0xD8210BEFD30EFA5A , 0x3C47F7E05401AA4E } // 5^226
+                                           , { 0x8714A775E3E95C78 , 0x65ACFAEC34810A71 } // 5^227
+                                           , { 0xA8D9D1535CE3B396 , 0x7F1839A741A14D0D } // 5^228
+                                           , { 0xD31045A8341CA07C , 0x1EDE48111209A050 } // 5^229
+                                           , { 0x83EA2B892091E44D , 0x934AED0AAB460432 } // 5^230
+                                           , { 0xA4E4B66B68B65D60 , 0xF81DA84D5617853F } // 5^231
+                                           , { 0xCE1DE40642E3F4B9 , 0x36251260AB9D668E } // 5^232
+                                           , { 0x80D2AE83E9CE78F3 , 0xC1D72B7C6B426019 } // 5^233
+                                           , { 0xA1075A24E4421730 , 0xB24CF65B8612F81F } // 5^234
+                                           , { 0xC94930AE1D529CFC , 0xDEE033F26797B627 } // 5^235
+                                           , { 0xFB9B7CD9A4A7443C , 0x169840EF017DA3B1 } // 5^236
+                                           , { 0x9D412E0806E88AA5 , 0x8E1F289560EE864E } // 5^237
+                                           , { 0xC491798A08A2AD4E , 0xF1A6F2BAB92A27E2 } // 5^238
+                                           , { 0xF5B5D7EC8ACB58A2 , 0xAE10AF696774B1DB } // 5^239
+                                           , { 0x9991A6F3D6BF1765 , 0xACCA6DA1E0A8EF29 } // 5^240
+                                           , { 0xBFF610B0CC6EDD3F , 0x17FD090A58D32AF3 } // 5^241
+                                           , { 0xEFF394DCFF8A948E , 0xDDFC4B4CEF07F5B0 } // 5^242
+                                           , { 0x95F83D0A1FB69CD9 , 0x4ABDAF101564F98E } // 5^243
+                                           , { 0xBB764C4CA7A4440F , 0x9D6D1AD41ABE37F1 } // 5^244
+                                           , { 0xEA53DF5FD18D5513 , 0x84C86189216DC5ED } // 5^245
+                                           , { 0x92746B9BE2F8552C , 0x32FD3CF5B4E49BB4 } // 5^246
+                                           , { 0xB7118682DBB66A77 , 0x3FBC8C33221DC2A1 } // 5^247
+                                           , { 0xE4D5E82392A40515 , 0x0FABAF3FEAA5334A } // 5^248
+                                           , { 0x8F05B1163BA6832D , 0x29CB4D87F2A7400E } // 5^249
+                                           , { 0xB2C71D5BCA9023F8 , 0x743E20E9EF511012 } // 5^250
+                                           , { 0xDF78E4B2BD342CF6 , 0x914DA9246B255416 } // 5^251
+                                           , { 0x8BAB8EEFB6409C1A , 0x1AD089B6C2F7548E } // 5^252
+                                           , { 0xAE9672ABA3D0C320 , 0xA184AC2473B529B1 } // 5^253
+                                           , { 0xDA3C0F568CC4F3E8 , 0xC9E5D72D90A2741E } // 5^254
+                                           , { 0x8865899617FB1871 , 0x7E2FA67C7A658892 } // 5^255
+                                           , { 0xAA7EEBFB9DF9DE8D , 0xDDBB901B98FEEAB7 } // 5^256
+                                           , { 0xD51EA6FA85785631 , 0x552A74227F3EA565 } // 5^257
+                                           , { 0x8533285C936B35DE , 0xD53A88958F87275F } // 5^258
+                                           , { 0xA67FF273B8460356 , 0x8A892ABAF368F137 } // 5^259
+                                           , { 0xD01FEF10A657842C , 0x2D2B7569B0432D85 } // 5^260
+                                           , { 0x8213F56A67F6B29B , 0x9C3B29620E29FC73 } // 5^261
+                                           , { 0xA298F2C501F45F42 , 0x8349F3BA91B47B8F } // 5^262
+                                           , { 0xCB3F2F7642717713 , 0x241C70A936219A73 } // 5^263
+                                           , { 0xFE0EFB53D30DD4D7 , 0xED238CD383AA0110 } // 5^264
+                                           , { 0x9EC95D1463E8A506 , 0xF4363804324A40AA } // 5^265
+                                           , { 0xC67BB4597CE2CE48 , 0xB143C6053EDCD0D5 } // 5^266
+                                           , { 0xF81AA16FDC1B81DA , 0xDD94B7868E94050A } // 5^267
+                                           , { 0x9B10A4E5E9913128 , 0xCA7CF2B4191C8326 } // 5^268
+                                           , { 0xC1D4CE1F63F57D72 , 0xFD1C2F611F63A3F0 } // 5^269
+                                           , { 0xF24A01A73CF2DCCF , 0xBC633B39673C8CEC } // 5^270
+                                           , { 0x976E41088617CA01 , 0xD5BE0503E085D813 } // 5^271
+                                           , { 0xBD49D14AA79DBC82 , 0x4B2D8644D8A74E18 } // 5^272
+                                           , { 0xEC9C459D51852BA2 , 0xDDF8E7D60ED1219E } // 5^273
+                                           , { 0x93E1AB8252F33B45 , 0xCABB90E5C942B503 } // 5^274
+                                           , { 0xB8DA1662E7B00A17 , 0x3D6A751F3B936243 } // 5^275
+                                           , { 0xE7109BFBA19C0C9D , 0x0CC512670A783AD4 } // 5^276
+                                           , { 0x906A617D450187E2 , 0x27FB2B80668B24C5 } // 5^277
+                                           , { 0xB484F9DC9641E9DA , 0xB1F9F660802DEDF6 } // 5^278
+                                           , { 0xE1A63853BBD26451 , 0x5E7873F8A0396973 } // 5^279
+                                           , { 0x8D07E33455637EB2 , 0xDB0B487B6423E1E8 } // 5^280
+                                           , { 0xB049DC016ABC5E5F , 0x91CE1A9A3D2CDA62 } // 5^281
+                                           , { 0xDC5C5301C56B75F7 , 0x7641A140CC7810FB } // 5^282
+                                           , { 0x89B9B3E11B6329BA , 0xA9E904C87FCB0A9D } // 5^283
+                                           , { 0xAC2820D9623BF429 , 0x546345FA9FBDCD44 } // 5^284
+                                           , { 0xD732290FBACAF133 , 0xA97C177947AD4095 } // 5^285
+                                           , { 0x867F59A9D4BED6C0 , 0x49ED8EABCCCC485D } // 5^286
+                                           , { 0xA81F301449EE8C70 , 0x5C68F256BFFF5A74 } // 5^287
+                                           , { 0xD226FC195C6A2F8C , 0x73832EEC6FFF3111 } // 5^288
+                                           , { 0x83585D8FD9C25DB7 , 0xC831FD53C5FF7EAB } // 5^289
+                                           , { 0xA42E74F3D032F525 , 0xBA3E7CA8B77F5E55 } // 5^290
+                                           , { 0xCD3A1230C43FB26F , 0x28CE1BD2E55F35EB } // 5^291
+                                           , { 0x80444B5E7AA7CF85 , 0x7980D163CF5B81B3 } // 5^292
+                                           , { 0xA0555E361951C366 , 0xD7E105BCC332621F } // 5^293
+                                           , { 0xC86AB5C39FA63440 , 0x8DD9472BF3FEFAA7 } // 5^294
+                                           , { 0xFA856334878FC150 , 0xB14F98F6F0FEB951 } // 5^295
+                                           , { 0x9C935E00D4B9D8D2 , 0x6ED1BF9A569F33D3 } // 5^296
+                                           , { 0xC3B8358109E84F07 , 0x0A862F80EC4700C8 } // 5^297
+                                           , { 0xF4A642E14C6262C8 , 0xCD27BB612758C0FA } // 5^298
+                                           , { 0x98E7E9CCCFBD7DBD , 0x8038D51CB897789C } // 5^299
+                                           , { 0xBF21E44003ACDD2C , 0xE0470A63E6BD56C3 } // 5^300
+                                           , { 0xEEEA5D5004981478 , 0x1858CCFCE06CAC74 } // 5^301
+                                           , { 0x95527A5202DF0CCB , 0x0F37801E0C43EBC8 } // 5^302
+                                           , { 0xBAA718E68396CFFD , 0xD30560258F54E6BA } // 5^303
+                                           , { 0xE950DF20247C83FD , 0x47C6B82EF32A2069 } // 5^304
+                                           , { 0x91D28B7416CDD27E , 0x4CDC331D57FA5441 } // 5^305
+                                           , { 0xB6472E511C81471D , 0xE0133FE4ADF8E952 } // 5^306
+                                           , { 0xE3D8F9E563A198E5 , 0x58180FDDD97723A6 } // 5^307
+                                           , { 0x8E679C2F5E44FF8F , 0x570F09EAA7EA7648 } // 5^308
+                                           };
+
+/** @brief Powers of ten which are exactly representable as f64. */
+static const f64 string_pow10_f64[] = { 1e0 , 1e1 , 1e2 , 1e3 , 1e4 , 1e5 , 1e6 , 1e7
+                                      , 1e8 , 1e9 , 1e10 , 1e11 , 1e12 , 1e13 , 1e14 , 1e15
+                                      , 1e16 , 1e17 , 1e18 , 1e19 , 1e20 , 1e21 , 1e22
+                                      };
+
+/**
+ * @brief Reads eight characters as a little-endian integer. Does not require
+ * alignment; compiles to a single load on little-endian targets.
+ * 
+ * @param string Address to read from. Must be non-zero.
+ * @return The integer.
+ */
+INLINE u64
+string_read8
 (   const char* string
-,   const u64   limit
 )
 {
-    return platform_string_length_clamped ( string , limit );
+    const u8* p = ( const u8* ) string;
+    return ( ( u64 ) p[ 0 ] )
+         | ( ( u64 ) p[ 1 ] << 8 )
+         | ( ( u64 ) p[ 2 ] << 16 )
+         | ( ( u64 ) p[ 3 ] << 24 )
+         | ( ( u64 ) p[ 4 ] << 32 )
+         | ( ( u64 ) p[ 5 ] << 40 )
+         | ( ( u64 ) p[ 6 ] << 48 )
+         | ( ( u64 ) p[ 7 ] << 56 )
+         ;
 }
 
-bool
-string_equal
-(   const char* s1
-,   const u64   s1_length
-,   const char* s2
-,   const u64   s2_length
+/**
+ * @brief SWAR (SIMD within a register) test for eight consecutive decimal
+ * digits.
+ * 
+ * @param chunk Eight characters (see string_read8).
+ * @return true if every character of chunk is in the range ['0'..'9'];
+ * false otherwise.
+ */
+INLINE bool
+string_eight_digits
+(   const u64 chunk
 )
 {
-    return ( s1_length == s2_length )
-        && ( s1 == s2 || memory_equal ( s1 , s2 , s1_length ) )
-        ;
+    // A byte is a digit iff its high nibble is 3 and adding 6 to it does not
+    // carry into the high nibble.
+    return ( ( chunk & 0xF0F0F0F0F0F0F0F0 )
+           | ( ( ( chunk + 0x0606060606060606 ) & 0xF0F0F0F0F0F0F0F0 ) >> 4 )
+           ) == 0x3333333333333333;
 }
 
-bool
-string_contains
-(   const char* search
-,   const u64   search_length
-,   const char* find
-,   const u64   find_length
-,   bool        reverse
-,   u64*        index
+/**
+ * @brief SWAR conversion of eight decimal digits to an integer, with three
+ * multiplications instead of eight.
+ * 
+ * @param chunk Eight digit characters (see string_eight_digits).
+ * @return The value of the digits, read most significant first.
+ */
+INLINE u32
+string_parse_eight_digits
+(   u64 chunk
 )
 {
-    if ( find_length > search_length )
-    {
-        return false;
-    }
-    if ( reverse )
-    {
-        return __string_contains_reverse ( search , search_length
-                                         , find , find_length
-                                         , index
-                                         );
-    }
-    return __string_contains ( search , search_length
-                             , find , find_length
-                             , index
-                             );
+    chunk -= 0x3030303030303030;
+    chunk = ( chunk * 10 ) + ( chunk >> 8 ); // Pairs.
+    chunk = ( ( ( chunk & 0x000000FF000000FF ) * ( 100 + ( 1000000ULL << 32 ) ) )
+            + ( ( ( chunk >> 16 ) & 0x000000FF000000FF ) * ( 1 + ( 10000ULL << 32 ) ) )
+            ) >> 32;
+    return ( u32 ) chunk;
 }
 
-char*
-string_reverse
-(   char*       string
-,   const u64   string_length
+/**
+ * @brief Minimum substring length for which a forward search may fall back to
+ * the Two-Way algorithm (see __string_contains). Shorter substrings cost at
+ * most this many comparisons per candidate anyway.
+ */
+#define STRING_TWO_WAY_MIN_LENGTH 16
+
+// Candidate filter for __string_contains and __string_contains_reverse: each
+// lane of a vector is one candidate position. STRING_SIMD_WIDTH is the number
+// of lanes, and STRING_SIMD_LANE_BITS the width of each lane in the mask
+// returned by string_simd_match.
+#if PLATFORM_SIMD_AVX2
+    #define STRING_SIMD_WIDTH       32
+    #define STRING_SIMD_LANE_BITS   1
+    typedef __m256i string_simd_t;
+#elif PLATFORM_SIMD_SSE2
+    #define STRING_SIMD_WIDTH       16
+    #define STRING_SIMD_LANE_BITS   1
+    typedef __m128i string_simd_t;
+#elif PLATFORM_SIMD_NEON
+    #define STRING_SIMD_WIDTH       16
+    #define STRING_SIMD_LANE_BITS   4
+    typedef uint8x16_t string_simd_t;
+#else
+    #define STRING_SIMD_WIDTH       8
+    #define STRING_SIMD_LANE_BITS   8
+    typedef u64 string_simd_t;
+#endif
+
+/**
+ * @brief Broadcasts a character to every lane of a vector.
+ * 
+ * @param c A character.
+ * @return The vector.
+ */
+INLINE string_simd_t
+string_simd_splat
+(   const char c
 )
 {
-    if ( string_length < 2 )
-    {
-        return string;
-    }
-    
-    u64 i;
-    u64 j;
-    char swap;
-    for ( i = 0 , j = string_length - 1; i < j; ++i , --j )
-    {
-        swap = string[ i ];
-        string[ i ] = string[ j ];
-        string[ j ] = swap;
-    }
-    return string;
+#if PLATFORM_SIMD_AVX2
+    return _mm256_set1_epi8 ( c );
+#elif PLATFORM_SIMD_SSE2
+    return _mm_set1_epi8 ( c );
+#elif PLATFORM_SIMD_NEON
+    return vdupq_n_u8 ( ( u8 ) c );
+#else
+    return 0x0101010101010101ULL * ( u8 ) c;
+#endif
 }
 
-u64
-string_i64
-(   i64     value
-,   u8      radix
-,   char*   dst
+/**
+ * @brief Tests STRING_SIMD_WIDTH consecutive candidate positions at once.
+ * 
+ * @param first Address of the first character of the first candidate.
+ * @param last Address of the last character of the first candidate.
+ * @param first_splat The first character of the substring, broadcast.
+ * @param last_splat The last character of the substring, broadcast.
+ * @return A mask with exactly one bit set in lane i (see
+ * STRING_SIMD_LANE_BITS) if candidate i begins and ends with the same
+ * characters as the substring, and no bits set otherwise.
+ */
+INLINE u64
+string_simd_match
+(   const char*         first
+,   const char*         last
+,   const string_simd_t first_splat
+,   const string_simd_t last_splat
 )
 {
-    if ( radix < STRING_INTEGER_MIN_RADIX || radix > STRING_INTEGER_MAX_RADIX )
-    {
-        LOGWARN ( "string_i64: Illegal value for radix argument: %u. Clamping to range [%u..%u]."
-                , radix
-                , STRING_INTEGER_MIN_RADIX
-                , STRING_INTEGER_MAX_RADIX
-                );
-        radix = CLAMP ( radix
-                      , STRING_INTEGER_MIN_RADIX
-                      , STRING_INTEGER_MAX_RADIX
-                      );
-    }
+#if PLATFORM_SIMD_AVX2
+    const __m256i a = _mm256_cmpeq_epi8 ( _mm256_loadu_si256 ( ( const __m256i* ) first ) , first_splat );
+    const __m256i b = _mm256_cmpeq_epi8 ( _mm256_loadu_si256 ( ( const __m256i* ) last ) , last_splat );
+    return ( u32 ) _mm256_movemask_epi8 ( _mm256_and_si256 ( a , b ) );
+#elif PLATFORM_SIMD_SSE2
+    const __m128i a = _mm_cmpeq_epi8 ( _mm_loadu_si128 ( ( const __m128i* ) first ) , first_splat );
+    const __m128i b = _mm_cmpeq_epi8 ( _mm_loadu_si128 ( ( const __m128i* ) last ) , last_splat );
+    return ( u32 ) _mm_movemask_epi8 ( _mm_and_si128 ( a , b ) );
+#elif PLATFORM_SIMD_NEON
+    // NEON has no movemask: narrow each lane to four bits instead.
+    const uint8x16_t a = vceqq_u8 ( vld1q_u8 ( ( const u8* ) first ) , first_splat );
+    const uint8x16_t b = vceqq_u8 ( vld1q_u8 ( ( const u8* ) last ) , last_splat );
+    const uint8x8_t narrow = vshrn_n_u16 ( vreinterpretq_u16_u8 ( vandq_u8 ( a , b ) ) , 4 );
+    return vget_lane_u64 ( vreinterpret_u64_u8 ( narrow ) , 0 ) & 0x8888888888888888;
+#else
+    // Sets the high bit of each byte which is zero in both differences.
+    const u64 difference = ( string_read8 ( first ) ^ first_splat )
+                         | ( string_read8 ( last ) ^ last_splat )
+                         ;
+    return ~( ( ( difference & 0x7F7F7F7F7F7F7F7F ) + 0x7F7F7F7F7F7F7F7F )
+            | difference
+            | 0x7F7F7F7F7F7F7F7F
+            );
+#endif
+}
 
-    const bool negative = radix == 10 && value < 0;
-    if ( negative )
-    {
-        *dst = '-';
-        value = -value;
-    }
+// Character classification for string_to_lowercase, string_utf8 and the like:
+// a lane set is a vector with every bit of a lane set (or, without vector
+// instructions, the high bit of each byte set) if its character belongs to
+// the set, and no bits set otherwise.
 
-    const u64 length = _string_u64 ( value , radix , dst + negative );
-    string_reverse ( dst + negative , length );
-    return length + negative;
+/**
+ * @brief Loads STRING_SIMD_WIDTH consecutive characters into a vector.
+ * 
+ * @param p Address of the first character.
+ * @return The vector.
+ */
+INLINE string_simd_t
+string_simd_load
+(   const char* p
+)
+{
+#if PLATFORM_SIMD_AVX2
+    return _mm256_loadu_si256 ( ( const __m256i* ) p );
+#elif PLATFORM_SIMD_SSE2
+    return _mm_loadu_si128 ( ( const __m128i* ) p );
+#elif PLATFORM_SIMD_NEON
+    return vld1q_u8 ( ( const u8* ) p );
+#else
+    return string_read8 ( p );
+#endif
 }
 
-u64
-string_u64
-(   u64     value
-,   u8      radix
-,   char*   dst
+/**
+ * @brief Stores a vector as STRING_SIMD_WIDTH consecutive characters.
+ * 
+ * @param p Address of the first character.
+ * @param v The vector.
+ */
+INLINE void
+string_simd_store
+(   char*               p
+,   const string_simd_t v
 )
 {
-    if ( radix < STRING_INTEGER_MIN_RADIX || radix > STRING_INTEGER_MAX_RADIX )
+#if PLATFORM_SIMD_AVX2
+    _mm256_storeu_si256 ( ( __m256i* ) p , v );
+#elif PLATFORM_SIMD_SSE2
+    _mm_storeu_si128 ( ( __m128i* ) p , v );
+#elif PLATFORM_SIMD_NEON
+    vst1q_u8 ( ( u8* ) p , v );
+#else
+    for ( u64 i = 0; i < 8; ++i )
     {
-        LOGWARN ( "string_u64: Illegal value for radix argument: %u. Clamping to range [%u..%u]."
-                , radix
-                , STRING_INTEGER_MIN_RADIX
-                , STRING_INTEGER_MAX_RADIX
-                );
-        radix = CLAMP ( radix
-                      , STRING_INTEGER_MIN_RADIX
-                      , STRING_INTEGER_MAX_RADIX
-                      );
+        p[ i ] = ( char )( v >> ( 8 * i ) );
     }
-
-    const u64 length = _string_u64 ( value , radix , dst );
-    string_reverse ( dst , length );
-    return length;
+#endif
 }
 
-u64
-string_f64
-(   f64     value
-,   u8      precision
-,   bool    abbreviated
-,   char*   dst
+/**
+ * @brief Classifies the lanes of a vector which equal a character.
+ * 
+ * @param v A vector of characters.
+ * @param splat The character, broadcast (see string_simd_splat).
+ * @return The lane set.
+ */
+INLINE string_simd_t
+string_simd_equal
+(   const string_simd_t v
+,   const string_simd_t splat
 )
-{   // TODO: Implement this.
-    return 0;
+{
+#if PLATFORM_SIMD_AVX2
+    return _mm256_cmpeq_epi8 ( v , splat );
+#elif PLATFORM_SIMD_SSE2
+    return _mm_cmpeq_epi8 ( v , splat );
+#elif PLATFORM_SIMD_NEON
+    return vceqq_u8 ( v , splat );
+#else
+    const u64 difference = v ^ splat;
+    return ~( ( ( difference & 0x7F7F7F7F7F7F7F7F ) + 0x7F7F7F7F7F7F7F7F )
+            | difference
+            | 0x7F7F7F7F7F7F7F7F
+            );
+#endif
 }
 
-const char*
-string_bytesize
-(   u64     size
-,   f64*    amount
+/**
+ * @brief Classifies the lanes of a vector which hold one of count consecutive
+ * characters, starting from first.
+ * 
+ * @param v A vector of characters.
+ * @param first The first character in the range.
+ * @param count The number of characters in the range. Must be in the range
+ * [1..128].
+ * @return The lane set.
+ */
+INLINE string_simd_t
+string_simd_range
+(   const string_simd_t v
+,   const char          first
+,   const u8            count
 )
 {
-    if ( size >= GiB ( 1 ) )
-    {
-        *amount = ( f64 ) size / GiB ( 1 );
-        return "GiB";
-    }
-    if ( size >= MiB ( 1 ) )
-    {
-        *amount = ( f64 ) size / MiB ( 1 );
-        return "MiB";
-    }
-    if ( size >= KiB ( 1 ) )
-    {
-        *amount = ( f64 ) size / KiB ( 1 );
-        return "KiB";
-    }
-    *amount = ( f64 ) size;
-    return "B";
+    // A character is in range iff ( c - first ), as an unsigned byte, is less
+    // than count.
+#if PLATFORM_SIMD_AVX2
+    const __m256i offset = _mm256_sub_epi8 ( v , _mm256_set1_epi8 ( first ) );
+    return _mm256_cmpeq_epi8 ( _mm256_min_epu8 ( offset , _mm256_set1_epi8 ( count - 1 ) ) , offset );
+#elif PLATFORM_SIMD_SSE2
+    const __m128i offset = _mm_sub_epi8 ( v , _mm_set1_epi8 ( first ) );
+    return _mm_cmpeq_epi8 ( _mm_min_epu8 ( offset , _mm_set1_epi8 ( count - 1 ) ) , offset );
+#elif PLATFORM_SIMD_NEON
+    return vcltq_u8 ( vsubq_u8 ( v , vdupq_n_u8 ( ( u8 ) first ) ) , vdupq_n_u8 ( count ) );
+#else
+    // Bytewise subtraction (no borrow between bytes), then a bytewise test
+    // for values below count.
+    const u64 splat = string_simd_splat ( first );
+    const u64 offset = ( ( v | 0x8080808080808080 ) - ( splat & 0x7F7F7F7F7F7F7F7F ) )
+                     ^ ( ( v ^ ~splat ) & 0x8080808080808080 )
+                     ;
+    return ~( ( ( offset & 0x7F7F7F7F7F7F7F7F ) + 0x0101010101010101ULL * ( u8 )( 128 - count ) )
+            | offset
+            )
+         & 0x8080808080808080
+         ;
+#endif
 }
 
-char*
-string_allocate
-(   u64 content_size
+/**
+ * @brief Computes the union of two lane sets.
+ * 
+ * @param a A lane set.
+ * @param b A lane set.
+ * @return The union of a and b.
+ */
+INLINE string_simd_t
+string_simd_or
+(   const string_simd_t a
+,   const string_simd_t b
 )
 {
-    const u64 header_size = sizeof ( u64 );
-    const u64 size = header_size + content_size;
-    char* string = memory_allocate ( size , MEMORY_TAG_STRING );
-    *( ( u64* ) string ) = size;
-    return ( char* )( ( ( u64 ) string ) + header_size );
+#if PLATFORM_SIMD_AVX2
+    return _mm256_or_si256 ( a , b );
+#elif PLATFORM_SIMD_SSE2
+    return _mm_or_si128 ( a , b );
+#elif PLATFORM_SIMD_NEON
+    return vorrq_u8 ( a , b );
+#else
+    return a | b;
+#endif
 }
 
-char*
-string_allocate_from
-(   const char* string
+/**
+ * @brief Computes the complement of a lane set.
+ * 
+ * @param lanes A lane set.
+ * @return The lanes not in lanes.
+ */
+INLINE string_simd_t
+string_simd_not
+(   const string_simd_t lanes
 )
 {
-    const u64 length = _string_length ( string );
-    char* copy = string_allocate ( length + 1 );
-    memory_copy ( copy , string , length );
-    return copy;
+#if PLATFORM_SIMD_AVX2
+    return _mm256_xor_si256 ( lanes , _mm256_set1_epi8 ( -1 ) );
+#elif PLATFORM_SIMD_SSE2
+    return _mm_xor_si128 ( lanes , _mm_set1_epi8 ( -1 ) );
+#elif PLATFORM_SIMD_NEON
+    return vmvnq_u8 ( lanes );
+#else
+    return lanes ^ 0x8080808080808080;
+#endif
 }
 
-void
-string_free
-(   void* string
+/**
+ * @brief Converts a lane set to a mask.
+ * 
+ * @param lanes A lane set.
+ * @return A mask with exactly one bit set in lane i (see
+ * STRING_SIMD_LANE_BITS) if lane i is in lanes, and no bits set otherwise.
+ */
+INLINE u64
+string_simd_mask
+(   const string_simd_t lanes
 )
 {
-    if ( !string )
-    {
-        return;
-    }
+#if PLATFORM_SIMD_AVX2
+    return ( u32 ) _mm256_movemask_epi8 ( lanes );
+#elif PLATFORM_SIMD_SSE2
+    return ( u32 ) _mm_movemask_epi8 ( lanes );
+#elif PLATFORM_SIMD_NEON
+    const uint8x8_t narrow = vshrn_n_u16 ( vreinterpretq_u16_u8 ( lanes ) , 4 );
+    return vget_lane_u64 ( vreinterpret_u64_u8 ( narrow ) , 0 ) & 0x8888888888888888;
+#else
+    return lanes;
+#endif
+}
+
+/**
+ * @brief Tests a vector of characters for non-ASCII bytes.
+ * 
+ * @param v A vector of characters.
+ * @return Non-zero if any character of v is outside the range [0..127]; zero
+ * otherwise.
+ */
+INLINE u64
+string_simd_non_ascii
+(   const string_simd_t v
+)
+{
+#if PLATFORM_SIMD_AVX2
+    return ( u32 ) _mm256_movemask_epi8 ( v );
+#elif PLATFORM_SIMD_SSE2
+    return ( u32 ) _mm_movemask_epi8 ( v );
+#elif PLATFORM_SIMD_NEON
+    return string_simd_mask ( vcgeq_u8 ( v , vdupq_n_u8 ( 0x80 ) ) );
+#else
+    return v & 0x8080808080808080;
+#endif
+}
+
+/**
+ * @brief Toggles the case of the Latin letters in a lane set.
+ * 
+ * @param v A vector of characters.
+ * @param lanes The lanes of v which hold Latin letters.
+ * @return v, with the case of each letter in lanes toggled.
+ */
+INLINE string_simd_t
+string_simd_toggle_case
+(   const string_simd_t v
+,   const string_simd_t lanes
+)
+{
+#if PLATFORM_SIMD_AVX2
+    return _mm256_xor_si256 ( v , _mm256_and_si256 ( lanes , _mm256_set1_epi8 ( 0x20 ) ) );
+#elif PLATFORM_SIMD_SSE2
+    return _mm_xor_si128 ( v , _mm_and_si128 ( lanes , _mm_set1_epi8 ( 0x20 ) ) );
+#elif PLATFORM_SIMD_NEON
+    return veorq_u8 ( v , vandq_u8 ( lanes , vdupq_n_u8 ( 0x20 ) ) );
+#else
+    return v ^ ( lanes >> 2 );
+#endif
+}
+
+/**
+ * @brief Classifies the lanes of a vector which hold whitespace (see
+ * whitespace in common/ascii.h).
+ * 
+ * @param v A vector of characters.
+ * @return The lane set.
+ */
+INLINE string_simd_t
+string_simd_whitespace
+(   const string_simd_t v
+)
+{
+    // '\t' , '\n' , '\v' , '\f' and '\r' are consecutive.
+    return string_simd_or ( string_simd_equal ( v , string_simd_splat ( ' ' ) )
+                          , string_simd_range ( v , '\t' , 5 )
+                          );
+}
+
+/**
+ * @brief Toggles the case of every letter of a string within one case (see
+ * string_to_lowercase and string_to_uppercase).
+ * 
+ * @param string The string to convert.
+ * @param string_length The number of characters in string.
+ * @param first 'A' to convert uppercase letters, or 'a' to convert lowercase
+ * letters.
+ * @return The string after conversion.
+ */
+INLINE char*
+string_toggle_case
+(   char*       string
+,   const u64   string_length
+,   const char  first
+)
+{
+    u64 i = 0;
+    for ( ; i + STRING_SIMD_WIDTH <= string_length; i += STRING_SIMD_WIDTH )
+    {
+        const string_simd_t v = string_simd_load ( string + i );
+        string_simd_store ( string + i
+                          , string_simd_toggle_case ( v , string_simd_range ( v , first , 26 ) )
+                          );
+    }
+    for ( ; i < string_length; ++i )
+    {
+        if ( ( u8 )( string[ i ] - first ) < 26 )
+        {
+            string[ i ] ^= 0x20;
+        }
+    }
+    return string;
+}
+
+/**
+ * @brief Validates one UTF-8 encoded code point.
+ * 
+ * @param string The bytes to read, starting with the first byte of the code
+ * point.
+ * @param length The number of bytes which may be read from string. Must be
+ * non-zero.
+ * @return The number of bytes in the code point, or 0 if it is malformed.
+ */
+INLINE u64
+string_utf8_sequence
+(   const u8*   string
+,   const u64   length
+)
+{
+    const u8 lead = string[ 0 ];
+    if ( lead < 0x80 )
+    {
+        return 1;
+    }
+
+    // The lead byte fixes the sequence length, and the range of the second
+    // byte (which excludes overlong encodings, surrogates and code points
+    // beyond U+10FFFF).
+    u64 count;
+    u8 low = 0x80;
+    u8 high = 0xBF;
+    if ( lead >= 0xC2 && lead <= 0xDF )
+    {
+        count = 2;
+    }
+    else if ( lead >= 0xE0 && lead <= 0xEF )
+    {
+        count = 3;
+        if ( lead == 0xE0 )
+        {
+            low = 0xA0;
+        }
+        else if ( lead == 0xED )
+        {
+            high = 0x9F;
+        }
+    }
+    else if ( lead >= 0xF0 && lead <= 0xF4 )
+    {
+        count = 4;
+        if ( lead == 0xF0 )
+        {
+            low = 0x90;
+        }
+        else if ( lead == 0xF4 )
+        {
+            high = 0x8F;
+        }
+    }
+    else
+    {
+        return 0;
+    }
+
+    if ( count > length || string[ 1 ] < low || string[ 1 ] > high )
+    {
+        return 0;
+    }
+    for ( u64 i = 2; i < count; ++i )
+    {
+        if ( ( string[ i ] & 0xC0 ) != 0x80 )
+        {
+            return 0;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Maps a character to its digit value in radices up to 36.
+ * 
+ * @param c A character.
+ * @return The digit value of c (case-insensitive), or 36 or more if c is not
+ * an alphanumeric character.
+ */
+INLINE u8
+string_digit_value
+(   const char c
+)
+{
+    if ( c >= '0' && c <= '9' )
+    {
+        return c - '0';
+    }
+    const char lower = c | 0x20;
+    if ( lower >= 'a' && lower <= 'z' )
+    {
+        return lower - 'a' + 10;
+    }
+    return 0xFF;
+}
+
+/**
+ * @brief Primary implementation of string_i64 and string_u64
+ * (see string_i64 and string_u64).
+ * 
+ * Decimal values are converted two digits per division, and power-of-two
+ * radices by shifting; every other radix falls back to one division per digit.
+ * In every case, digits are written directly into their final position.
+ * 
+ * @param value A 64-bit value.
+ * @param radix Integer radix in the range [2..36] (inclusive).
+ * @param dst Output buffer for string.
+ * @return The number of characters written to dst.
+ */
+u64
+_string_u64
+(   u64     value
+,   u8      radix
+,   char*   dst
+);
+
+/**
+ * @brief Splits a floating point number into its components.
+ * 
+ * Finite values are decomposed such that | value | = mantissa * 2^exponent.
+ * 
+ * @param value A 64-bit floating point number.
+ * @param mantissa Output buffer for the mantissa. Zero if value is zero.
+ * @param exponent Output buffer for the binary exponent.
+ * @return true if value is finite; false if it is infinite or NaN.
+ */
+bool
+_string_f64_decompose
+(   const f64   value
+,   u64*        mantissa
+,   i32*        exponent
+);
+
+/**
+ * @brief Writes the sign and, if applicable, the spelling of a non-finite or
+ * zero floating point number (see string_f64).
+ * 
+ * @param value A 64-bit floating point number.
+ * @param abbreviated Use abbreviated (scientific) notation? Y/N
+ * @param mantissa The mantissa of value (see _string_f64_decompose).
+ * @param finite Is value finite? Y/N
+ * @param dst Output buffer for string.
+ * @return The number of characters written to dst.
+ */
+u64
+_string_f64_prefix
+(   const f64   value
+,   const bool  abbreviated
+,   const u64   mantissa
+,   const bool  finite
+,   char*       dst
+);
+
+/**
+ * @brief Writes the exponent of a number in abbreviated (scientific) notation:
+ * 'E', the sign, and at least two digits.
+ * 
+ * @param exponent The decimal exponent.
+ * @param dst Output buffer for string.
+ * @return The number of characters written to dst.
+ */
+u64
+_string_f64_exponent
+(   const i32   exponent
+,   char*       dst
+);
+
+/**
+ * @brief Computes a lower bound on the decimal exponent k of a finite,
+ * non-zero floating point number, such that 10^( k - 1 ) <= value < 10^k.
+ * Never more than one less than the actual value.
+ * 
+ * @param mantissa The mantissa (see _string_f64_decompose). Must be non-zero.
+ * @param exponent The binary exponent (see _string_f64_decompose).
+ * @return The estimated decimal exponent.
+ */
+i32
+_string_f64_estimate_exponent
+(   const u64   mantissa
+,   const i32   exponent
+);
+
+/**
+ * @brief Generates the leading decimal digits of a finite, non-zero floating
+ * point number, exactly rounded (round-half-to-even on the exact binary
+ * value, as printf does).
+ * 
+ * @param mantissa The mantissa (see _string_f64_decompose). Must be non-zero.
+ * @param exponent The binary exponent (see _string_f64_decompose).
+ * @param precision Floating point precision.
+ * @param abbreviated If true, generates precision + 1 significant digits;
+ * otherwise, generates every digit down to the 10^-precision place.
+ * @param digits Output buffer for the digits (in ASCII).
+ * @param k Output buffer for the decimal exponent: the first digit has place
+ * value 10^( k - 1 ).
+ * @return The number of digits written to digits.
+ */
+u64
+_string_f64_digits
+(   const u64   mantissa
+,   const i32   exponent
+,   const u8    precision
+,   const bool  abbreviated
+,   char*       digits
+,   i32*        k
+);
+
+/**
+ * @brief Fast path of _string_f64_digits, for numbers whose integer part and
+ * fractional part each fit in 64 bits with room to spare (i.e.
+ * 2^-60 <= the least significant bit of the mantissa <= 2^11). Never uses
+ * arbitrary-precision arithmetic.
+ * 
+ * @param mantissa The mantissa (see _string_f64_decompose). Must be non-zero.
+ * @param exponent The binary exponent (see _string_f64_decompose).
+ * @param precision Floating point precision.
+ * @param abbreviated Generate significant digits? Y/N (see _string_f64_digits)
+ * @param digits Output buffer for the digits (in ASCII).
+ * @param k Output buffer for the decimal exponent (see _string_f64_digits).
+ * @param count Output buffer for the number of digits written to digits.
+ * @return true if the fast path applies; false otherwise (nothing is written).
+ */
+bool
+_string_f64_digits_fast
+(   const u64   mantissa
+,   const i32   exponent
+,   const u8    precision
+,   const bool  abbreviated
+,   char*       digits
+,   i32*        k
+,   u64*        count
+);
+
+/**
+ * @brief Rounds the digits generated by _string_f64_digits to nearest, with
+ * ties to even.
+ * 
+ * @param digits The digits (in ASCII). Must have room for one more.
+ * @param count The number of digits.
+ * @param remainder The sign of ( the value of the truncated digits - half a
+ * unit in the last place ).
+ * @param abbreviated Are the digits significant digits? Y/N
+ * (see _string_f64_digits)
+ * @param k The decimal exponent (see _string_f64_digits). Incremented if
+ * rounding carries out of the leading digit.
+ * @return The number of digits, after rounding.
+ */
+u64
+_string_f64_round
+(   char*       digits
+,   u64         count
+,   const i32   remainder
+,   const bool  abbreviated
+,   i32*        k
+);
+
+/**
+ * @brief Generates the shortest sequence of decimal digits which uniquely
+ * identifies a finite, non-zero floating point number (Steele & White /
+ * Burger & Dybvig free-format algorithm, with exact arithmetic). Tries
+ * _string_f64_digits_grisu first.
+ * 
+ * @param mantissa The mantissa (see _string_f64_decompose). Must be non-zero.
+ * @param exponent The binary exponent (see _string_f64_decompose).
+ * @param digits Output buffer for the digits (in ASCII). At most 17 are
+ * written.
+ * @param k Output buffer for the decimal exponent: the first digit has place
+ * value 10^( k - 1 ).
+ * @return The number of digits written to digits.
+ */
+u64
+_string_f64_digits_shortest
+(   const u64   mantissa
+,   const i32   exponent
+,   char*       digits
+,   i32*        k
+);
+
+/**
+ * @brief Fast path of _string_f64_digits_shortest (Grisu3 algorithm, by
+ * Florian Loitsch). Uses only 64-bit arithmetic, but gives up on roughly 0.5%
+ * of inputs, for which it cannot prove that its result is both the shortest
+ * and the closest.
+ * 
+ * @param mantissa The mantissa (see _string_f64_decompose). Must be non-zero.
+ * @param exponent The binary exponent (see _string_f64_decompose).
+ * @param digits Output buffer for the digits (in ASCII). At most 17 are
+ * written.
+ * @param k Output buffer for the decimal exponent (see
+ * _string_f64_digits_shortest).
+ * @param count Output buffer for the number of digits written to digits.
+ * @return true on success; false if the result is uncertain.
+ */
+bool
+_string_f64_digits_grisu
+(   const u64   mantissa
+,   const i32   exponent
+,   char*       digits
+,   i32*        k
+,   u64*        count
+);
+
+/**
+ * @brief Final step of _string_f64_digits_grisu: nudges the last digit toward
+ * the exact value, then checks whether the result is provably correct.
+ * 
+ * All parameters are in units of the scaled binary exponent.
+ * 
+ * @param digits The digits (in ASCII).
+ * @param count The number of digits.
+ * @param distance_too_high_w Distance from the value to the (inflated) upper
+ * boundary.
+ * @param unsafe_interval Width of the (inflated) interval of numbers which
+ * round to the value.
+ * @param rest Distance from the digits to the (inflated) upper boundary.
+ * @param ten_kappa Place value of the last digit.
+ * @param unit Upper bound on the accumulated rounding error.
+ * @return true if the digits are provably the shortest and closest; false
+ * otherwise.
+ */
+bool
+_string_f64_grisu_round
+(   char*       digits
+,   const u64   count
+,   const u64   distance_too_high_w
+,   const u64   unsafe_interval
+,   u64         rest
+,   const u64   ten_kappa
+,   const u64   unit
+);
+
+/**
+ * @brief Multiplies two floating point numbers with 64-bit significands,
+ * rounding the product to 64 bits.
+ * 
+ * @param a A floating point number.
+ * @param b A floating point number.
+ * @return a * b.
+ */
+fp_t
+fp_multiply
+(   const fp_t  a
+,   const fp_t  b
+);
+
+/**
+ * @brief Shifts the significand of a floating point number left until its
+ * most significant bit is set.
+ * 
+ * @param x A floating point number. Its significand must be non-zero.
+ * @return The normalized number (same value).
+ */
+fp_t
+fp_normalize
+(   const fp_t x
+);
+
+// Arbitrary-precision integer arithmetic, for _string_f64_digits and
+// _string_f64_digits_shortest. Operands are non-negative and never exceed
+// STRING_FLOAT_BIGINT_CAPACITY limbs.
+void bigint_set ( bigint_t* bigint , u64 value );
+void bigint_shift_left ( bigint_t* bigint , const u32 shift );
+void bigint_multiply ( bigint_t* bigint , const u32 factor );
+void bigint_multiply_pow10 ( bigint_t* bigint , u32 power );
+void bigint_add ( bigint_t* dst , const bigint_t* a , const bigint_t* b );
+void bigint_subtract ( bigint_t* bigint , const bigint_t* subtrahend );
+i32 bigint_compare ( const bigint_t* a , const bigint_t* b );
+u8 bigint_divide_digit ( bigint_t* bigint , const bigint_t* divisor );
+void bigint_add_u32 ( bigint_t* bigint , const u32 value );
+void bigint_multiply_pow5 ( bigint_t* bigint , u32 power );
+
+/**
+ * @brief Primary implementation of string_to_i64 and string_to_u64
+ * (see string_to_i64).
+ * 
+ * @param string The string to parse.
+ * @param string_length The number of characters in string.
+ * @param radix Integer radix in the range [2..36] (inclusive).
+ * @param allow_negative Accept a leading '-'? Y/N
+ * @param magnitude Output buffer for the absolute value. Saturates at the
+ * maximum u64 on overflow.
+ * @param negative Output buffer for the sign.
+ * @param overflow Output buffer for whether the absolute value exceeded the
+ * maximum u64.
+ * @param read Output buffer for the number of characters parsed (see
+ * string_to_i64).
+ * @return STRING_PARSE_SUCCESS on success (magnitude, negative and overflow
+ * are written); STRING_PARSE_ERROR_EMPTY or STRING_PARSE_ERROR_INVALID
+ * otherwise.
+ */
+STRING_PARSE_RESULT
+_string_to_integer
+(   const char* string
+,   const u64   string_length
+,   const u8    radix
+,   const bool  allow_negative
+,   u64*        magnitude
+,   bool*       negative
+,   bool*       overflow
+,   u64*        read
+);
+
+/**
+ * @brief Parses the spelling of a non-finite floating point number: "inf",
+ * "infinity" or "nan" (case-insensitive).
+ * 
+ * @param string The string to parse (after the sign).
+ * @param string_length The number of characters in string.
+ * @param bits Output buffer for the bits of the (positive) value.
+ * @return The number of characters parsed, or 0 if string does not begin with
+ * a non-finite spelling.
+ */
+u64
+_string_to_f64_special
+(   const char* string
+,   const u64   string_length
+,   u64*        bits
+);
+
+/**
+ * @brief Computes the full 128-bit product of two 64-bit integers.
+ * 
+ * @param a A 64-bit integer.
+ * @param b A 64-bit integer.
+ * @param low Output buffer for the least significant 64 bits of the product.
+ * @return The most significant 64 bits of the product.
+ */
+u64
+_string_multiply_u64
+(   const u64   a
+,   const u64   b
+,   u64*        low
+);
+
+/**
+ * @brief Converts w * 10^q to the nearest f64 (Eisel-Lemire algorithm, as in
+ * Daniel Lemire's "Number Parsing at a Gigabyte per Second"). Exact for every
+ * w < 2^64 and q, using one or two 64x64-bit multiplications by a truncated
+ * power of five.
+ * 
+ * @param w A decimal significand.
+ * @param q A decimal exponent.
+ * @return The bits of the nearest (positive) f64; 0x7FF0000000000000 if it
+ * overflows to infinity.
+ */
+u64
+_string_f64_eisel_lemire
+(   u64         w
+,   const i64   q
+);
+
+/**
+ * @brief Exact slow path of string_to_f64, for numbers with more than 19
+ * significant digits which lie too close to a halfway point for the leading
+ * 19 to decide. Compares the full decimal number against the point halfway
+ * between a candidate and its successor, using arbitrary-precision
+ * arithmetic.
+ * 
+ * @param digits The first significant digit of the number.
+ * @param digits_length The number of characters from digits to the end of
+ * the significand (may include a point).
+ * @param exponent The decimal exponent of the last digit in the significand.
+ * @param bits The bits of the candidate: the correct result, or the f64
+ * immediately below it.
+ * @return The bits of the nearest (positive) f64.
+ */
+u64
+_string_f64_exact
+(   const char* digits
+,   const u64   digits_length
+,   i64         exponent
+,   const u64   bits
+);
+
+u64
+_string_length
+(   const char* string
+)
+{
+    return platform_string_length ( string );
+}
+
+bool
+_string_f64_digits_fast
+(   const u64   mantissa
+,   const i32   exponent
+,   const u8    precision
+,   const bool  abbreviated
+,   char*       digits
+,   i32*        k
+,   u64*        count
+)
+{
+    if ( exponent < -60 || exponent > 11 )
+    {
+        return false;
+    }
+
+    // value = integer + fraction / 2^shift exactly. Since fraction < 2^60,
+    // multiplying it by 10 cannot overflow.
+    const u32 shift = ( exponent < 0 ) ? -exponent : 0;
+    const u64 mask = ( ( u64 ) 1 << shift ) - 1;
+    const u64 integer = ( exponent < 0 ) ? mantissa >> shift : mantissa << exponent;
+    u64 fraction = mantissa & mask;
+    const u64 half = ( shift ) ? ( u64 ) 1 << ( shift - 1 ) : 1;
+
+    u64 n = ( integer ) ? _string_u64 ( integer , 10 , digits ) : 0;
+    *k = n;
+    u64 target;
+    i32 remainder;
+    if ( abbreviated )
+    {
+        if ( !integer )
+        {
+            // Skip the leading zeros.
+            for (;;)
+            {
+                fraction *= 10;
+                const u8 digit = fraction >> shift;
+                fraction &= mask;
+                if ( digit )
+                {
+                    digits[ 0 ] = '0' + digit;
+                    n = 1;
+                    break;
+                }
+                *k -= 1;
+            }
+        }
+        target = precision + 1;
+
+        // Already have more integer digits than needed: round on the rest.
+        if ( n > target )
+        {
+            remainder = digits[ target ] - '5';
+            for ( u64 i = target + 1; !remainder && i < n; ++i )
+            {
+                remainder = digits[ i ] != '0';
+            }
+            if ( !remainder )
+            {
+                remainder = fraction != 0;
+            }
+            *count = _string_f64_round ( digits , target , remainder , true , k );
+            return true;
+        }
+    }
+    else
+    {
+        target = n + precision;
+    }
+
+    while ( n < target )
+    {
+        fraction *= 10;
+        digits[ n ] = '0' + ( fraction >> shift );
+        fraction &= mask;
+        n += 1;
+    }
+    remainder = ( fraction > half ) - ( fraction < half );
+    if ( !shift )
+    {
+        remainder = -1; // Integral value: nothing was truncated.
+    }
+    *count = _string_f64_round ( digits , n , remainder , abbreviated , k );
+    return true;
+}
+
+u64
+_string_f64_round
+(   char*       digits
+,   u64         count
+,   const i32   remainder
+,   const bool  abbreviated
+,   i32*        k
+)
+{
+    if ( remainder < 0 || ( !remainder && ( !count || !( digits[ count - 1 ] & 1 ) ) ) )
+    {
+        return count;
+    }
+
+    u64 i = count;
+    while ( i && digits[ i - 1 ] == '9' )
+    {
+        digits[ i - 1 ] = '0';
+        i -= 1;
+    }
+    if ( i )
+    {
+        digits[ i - 1 ] += 1;
+        return count;
+    }
+
+    // Carried out of the leading digit. In abbreviated notation, the number of
+    // significant digits stays fixed, so the last (zero) digit falls off;
+    // otherwise, there is one more integer digit.
+    memory_move ( digits + 1 , digits , count );
+    digits[ 0 ] = '1';
+    *k += 1;
+    return ( abbreviated ) ? count : count + 1;
+}
+
+u64
+_string_length_clamped
+(   const char* string
+,   const u64   limit
+)
+{
+    return platform_string_length_clamped ( string , limit );
+}
+
+bool
+string_equal
+(   const char* s1
+,   const u64   s1_length
+,   const char* s2
+,   const u64   s2_length
+)
+{
+    return ( s1_length == s2_length )
+        && ( s1 == s2 || memory_equal ( s1 , s2 , s1_length ) )
+        ;
+}
+
+bool
+string_contains
+(   const char* search
+,   const u64   search_length
+,   const char* find
+,   const u64   find_length
+,   bool        reverse
+,   u64*        index
+)
+{
+    if ( find_length > search_length )
+    {
+        return false;
+    }
+    if ( reverse )
+    {
+        return __string_contains_reverse ( search , search_length
+                                         , find , find_length
+                                         , index
+                                         );
+    }
+    return __string_contains ( search , search_length
+                             , find , find_length
+                             , index
+                             );
+}
+
+u64
+string_find_all
+(   const char* search
+,   const u64   search_length
+,   const char* find
+,   const u64   find_length
+,   u64*        indices
+,   const u64   capacity
+)
+{
+    if ( !find_length )
+    {
+        return 0;
+    }
+
+    u64 count = 0;
+    u64 offset = 0;
+    u64 index;
+    while ( search_length - offset >= find_length
+         && __string_contains ( search + offset
+                              , search_length - offset
+                              , find
+                              , find_length
+                              , &index
+                              ))
+    {
+        if ( indices && count < capacity )
+        {
+            indices[ count ] = offset + index;
+        }
+        count += 1;
+        offset += index + find_length;
+    }
+    return count;
+}
+
+char*
+string_reverse
+(   char*       string
+,   const u64   string_length
+)
+{
+    if ( string_length < 2 )
+    {
+        return string;
+    }
+    
+    u64 i;
+    u64 j;
+    char swap;
+    for ( i = 0 , j = string_length - 1; i < j; ++i , --j )
+    {
+        swap = string[ i ];
+        string[ i ] = string[ j ];
+        string[ j ] = swap;
+    }
+    return string;
+}
+
+char*
+string_to_lowercase
+(   char*       string
+,   const u64   string_length
+)
+{
+    return string_toggle_case ( string , string_length , 'A' );
+}
+
+char*
+string_to_uppercase
+(   char*       string
+,   const u64   string_length
+)
+{
+    return string_toggle_case ( string , string_length , 'a' );
+}
+
+u64
+string_leading_whitespace
+(   const char* string
+,   const u64   string_length
+)
+{
+    u64 i = 0;
+    for ( ; i + STRING_SIMD_WIDTH <= string_length; i += STRING_SIMD_WIDTH )
+    {
+        const u64 mask = string_simd_mask ( string_simd_not ( string_simd_whitespace ( string_simd_load ( string + i ) ) ) );
+        if ( mask )
+        {
+            return i + bitscan_forward ( mask ) / STRING_SIMD_LANE_BITS;
+        }
+    }
+    for ( ; i < string_length && whitespace ( string[ i ] ); ++i );
+    return i;
+}
+
+u64
+string_trailing_whitespace
+(   const char* string
+,   const u64   string_length
+)
+{
+    u64 i = string_length;
+    for ( ; i >= STRING_SIMD_WIDTH; i -= STRING_SIMD_WIDTH )
+    {
+        const char* const block = string + i - STRING_SIMD_WIDTH;
+        const u64 mask = string_simd_mask ( string_simd_not ( string_simd_whitespace ( string_simd_load ( block ) ) ) );
+        if ( mask )
+        {
+            return string_length - ( i - STRING_SIMD_WIDTH ) - bitscan_reverse ( mask ) / STRING_SIMD_LANE_BITS - 1;
+        }
+    }
+    for ( ; i && whitespace ( string[ i - 1 ] ); --i );
+    return string_length - i;
+}
+
+bool
+string_ascii
+(   const char* string
+,   const u64   string_length
+)
+{
+    u64 i = 0;
+    for ( ; i + STRING_SIMD_WIDTH <= string_length; i += STRING_SIMD_WIDTH )
+    {
+        if ( string_simd_non_ascii ( string_simd_load ( string + i ) ) )
+        {
+            return false;
+        }
+    }
+    for ( ; i < string_length; ++i )
+    {
+        if ( ( u8 ) string[ i ] >= 0x80 )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+string_utf8
+(   const char* string
+,   const u64   string_length
+)
+{
+    const u8* const bytes = ( const u8* ) string;
+    u64 i = 0;
+    while ( i < string_length )
+    {
+        // Skip ASCII a vector at a time.
+        if ( i + STRING_SIMD_WIDTH <= string_length
+          && !string_simd_non_ascii ( string_simd_load ( string + i ) )
+           )
+        {
+            i += STRING_SIMD_WIDTH;
+            continue;
+        }
+        const u64 count = string_utf8_sequence ( bytes + i , string_length - i );
+        if ( !count )
+        {
+            return false;
+        }
+        i += count;
+    }
+    return true;
+}
+
+u64
+string_strip_ansi_to
+(   char*       dst
+,   const char* src
+,   const u64   length
+)
+{
+    const string_simd_t escape = string_simd_splat ( '\033' );
+    u64 written = 0;
+    u64 copied = 0; // Characters of src before this index have been copied.
+    u64 i = 0;
+    while ( i < length )
+    {
+        // Skip to the next ESC character.
+        for ( ; i + STRING_SIMD_WIDTH <= length; i += STRING_SIMD_WIDTH )
+        {
+            const u64 mask = string_simd_mask ( string_simd_equal ( string_simd_load ( src + i ) , escape ) );
+            if ( mask )
+            {
+                i += bitscan_forward ( mask ) / STRING_SIMD_LANE_BITS;
+                break;
+            }
+        }
+        for ( ; i < length && src[ i ] != '\033'; ++i );
+        if ( i >= length )
+        {
+            break;
+        }
+
+        // Not a complete sequence? Keep the ESC character as text.
+        u64 j = i + 2;
+        if ( j < length && src[ i + 1 ] == '[' )
+        {
+            while ( j < length && ( digit ( src[ j ] ) || src[ j ] == ';' ) )
+            {
+                j += 1;
+            }
+        }
+        if ( j >= length || src[ i + 1 ] != '[' || src[ j ] != 'm' )
+        {
+            i += 1;
+            continue;
+        }
+
+        // Copy the text before the sequence, then omit the sequence.
+        if ( dst + written != src + copied )
+        {
+            memory_move ( dst + written , src + copied , i - copied );
+        }
+        written += i - copied;
+        i = j + 1;
+        copied = i;
+    }
+    if ( dst + written != src + copied )
+    {
+        memory_move ( dst + written , src + copied , length - copied );
+    }
+    return written + length - copied;
+}
+
+u64
+string_i64
+(   i64     value
+,   u8      radix
+,   char*   dst
+)
+{
+    if ( radix < STRING_INTEGER_MIN_RADIX || radix > STRING_INTEGER_MAX_RADIX )
+    {
+        LOGWARN ( "string_i64: Illegal value for radix argument: %u. Clamping to range [%u..%u]."
+                , radix
+                , STRING_INTEGER_MIN_RADIX
+                , STRING_INTEGER_MAX_RADIX
+                );
+        radix = CLAMP ( radix
+                      , STRING_INTEGER_MIN_RADIX
+                      , STRING_INTEGER_MAX_RADIX
+                      );
+    }
+
+    const bool negative = radix == 10 && value < 0;
+    if ( negative )
+    {
+        *dst = '-';
+        value = -value;
+    }
+
+    return _string_u64 ( value , radix , dst + negative ) + negative;
+}
+
+u64
+string_u64
+(   u64     value
+,   u8      radix
+,   char*   dst
+)
+{
+    if ( radix < STRING_INTEGER_MIN_RADIX || radix > STRING_INTEGER_MAX_RADIX )
+    {
+        LOGWARN ( "string_u64: Illegal value for radix argument: %u. Clamping to range [%u..%u]."
+                , radix
+                , STRING_INTEGER_MIN_RADIX
+                , STRING_INTEGER_MAX_RADIX
+                );
+        radix = CLAMP ( radix
+                      , STRING_INTEGER_MIN_RADIX
+                      , STRING_INTEGER_MAX_RADIX
+                      );
+    }
+
+    return _string_u64 ( value , radix , dst );
+}
+
+u64
+string_f64
+(   f64     value
+,   u8      precision
+,   bool    abbreviated
+,   char*   dst
+)
+{
+    if ( precision > STRING_FLOAT_MAX_PRECISION )
+    {
+        LOGWARN ( "string_f64: Illegal value for precision argument: %u. Clamping to %u."
+                , precision
+                , STRING_FLOAT_MAX_PRECISION
+                );
+        precision = STRING_FLOAT_MAX_PRECISION;
+    }
+
+    u64 mantissa;
+    i32 exponent;
+    const bool finite = _string_f64_decompose ( value , &mantissa , &exponent );
+    char* write = dst + _string_f64_prefix ( value
+                                           , abbreviated
+                                           , mantissa
+                                           , finite
+                                           , dst
+                                           );
+    if ( !finite )
+    {
+        return write - dst;
+    }
+
+    char digits[ STRING_FLOAT_MAX_DIGITS ];
+    i32 k;
+    u64 count;
+    if ( mantissa )
+    {
+        count = _string_f64_digits ( mantissa
+                                   , exponent
+                                   , precision
+                                   , abbreviated
+                                   , digits
+                                   , &k
+                                   );
+    }
+    else
+    {
+        digits[ 0 ] = '0';
+        count = 1;
+        k = 1;
+    }
+
+    if ( abbreviated )
+    {
+        *write = digits[ 0 ];
+        write += 1;
+        if ( precision )
+        {
+            *write = '.';
+            write += 1;
+            for ( u64 i = 1; i <= precision; ++i )
+            {
+                *write = ( i < count ) ? digits[ i ] : '0';
+                write += 1;
+            }
+        }
+        write += _string_f64_exponent ( mantissa ? k - 1 : 0 , write );
+        return write - dst;
+    }
+
+    // Digit i has place value 10^( k - 1 - i ).
+    if ( k > 0 )
+    {
+        memory_copy ( write , digits , k );
+        write += k;
+    }
+    else
+    {
+        *write = '0';
+        write += 1;
+    }
+    if ( precision )
+    {
+        *write = '.';
+        write += 1;
+        for ( i32 i = k; i < k + precision; ++i )
+        {
+            *write = ( i >= 0 && ( u64 ) i < count ) ? digits[ i ] : '0';
+            write += 1;
+        }
+    }
+    return write - dst;
+}
+
+u64
+string_f64_shortest
+(   f64     value
+,   bool    abbreviated
+,   char*   dst
+)
+{
+    u64 mantissa;
+    i32 exponent;
+    const bool finite = _string_f64_decompose ( value , &mantissa , &exponent );
+    char* write = dst + _string_f64_prefix ( value
+                                           , abbreviated
+                                           , mantissa
+                                           , finite
+                                           , dst
+                                           );
+    if ( !finite )
+    {
+        return write - dst;
+    }
+    if ( !mantissa )
+    {
+        *write = '0';
+        write += 1;
+        if ( abbreviated )
+        {
+            write += _string_f64_exponent ( 0 , write );
+        }
+        return write - dst;
+    }
+
+    char digits[ 17 ];
+    i32 k;
+    const u64 count = _string_f64_digits_shortest ( mantissa
+                                                  , exponent
+                                                  , digits
+                                                  , &k
+                                                  );
+
+    if ( abbreviated )
+    {
+        *write = digits[ 0 ];
+        write += 1;
+        if ( count > 1 )
+        {
+            *write = '.';
+            memory_copy ( write + 1 , digits + 1 , count - 1 );
+            write += count;
+        }
+        write += _string_f64_exponent ( k - 1 , write );
+        return write - dst;
+    }
+
+    // Digit i has place value 10^( k - 1 - i ).
+    if ( k <= 0 )
+    {
+        write[ 0 ] = '0';
+        write[ 1 ] = '.';
+        memory_set ( write + 2 , '0' , -k );
+        write += 2 - k;
+        memory_copy ( write , digits , count );
+        write += count;
+    }
+    else if ( ( u64 ) k < count )
+    {
+        memory_copy ( write , digits , k );
+        write[ k ] = '.';
+        memory_copy ( write + k + 1 , digits + k , count - k );
+        write += count + 1;
+    }
+    else
+    {
+        memory_copy ( write , digits , count );
+        memory_set ( write + count , '0' , k - count );
+        write += k;
+    }
+    return write - dst;
+}
+
+STRING_PARSE_RESULT
+string_to_i64
+(   const char* string
+,   const u64   string_length
+,   const u8    radix
+,   i64*        value
+,   u64*        read
+)
+{
+    u64 magnitude;
+    bool negative;
+    bool overflow;
+    const STRING_PARSE_RESULT result = _string_to_integer ( string
+                                                          , string_length
+                                                          , radix
+                                                          , true
+                                                          , &magnitude
+                                                          , &negative
+                                                          , &overflow
+                                                          , read
+                                                          );
+    if ( result != STRING_PARSE_SUCCESS )
+    {
+        return result;
+    }
+
+    // Like string_i64, other radices may hold a two's complement bit pattern.
+    const u64 limit = ( radix != 10 && !negative ) ? ( u64 ) -1
+                                                   : ( u64 ) 0x7FFFFFFFFFFFFFFF + negative
+                                                   ;
+    if ( overflow || magnitude > limit )
+    {
+        *value = ( negative ) ? ( i64 )( ( u64 ) 1 << 63 ) : ( i64 ) 0x7FFFFFFFFFFFFFFF;
+        return STRING_PARSE_ERROR_OUT_OF_RANGE;
+    }
+    *value = ( negative ) ? ( i64 )( 0 - magnitude ) : ( i64 ) magnitude;
+    return STRING_PARSE_SUCCESS;
+}
+
+STRING_PARSE_RESULT
+string_to_u64
+(   const char* string
+,   const u64   string_length
+,   const u8    radix
+,   u64*        value
+,   u64*        read
+)
+{
+    u64 magnitude;
+    bool negative;
+    bool overflow;
+    const STRING_PARSE_RESULT result = _string_to_integer ( string
+                                                          , string_length
+                                                          , radix
+                                                          , false
+                                                          , &magnitude
+                                                          , &negative
+                                                          , &overflow
+                                                          , read
+                                                          );
+    if ( result != STRING_PARSE_SUCCESS )
+    {
+        return result;
+    }
+    *value = magnitude;
+    return ( overflow ) ? STRING_PARSE_ERROR_OUT_OF_RANGE
+                        : STRING_PARSE_SUCCESS
+                        ;
+}
+
+STRING_PARSE_RESULT
+string_to_f64
+(   const char* string
+,   const u64   string_length
+,   f64*        value
+,   u64*        read
+)
+{
+    u64 i = 0;
+    const bool negative = string_length && string[ 0 ] == '-';
+    if ( string_length && ( string[ 0 ] == '-' || string[ 0 ] == '+' ) )
+    {
+        i += 1;
+    }
+    const u64 sign = ( u64 ) negative << 63;
+    u64 bits;
+
+    // Infinity and NaN.
+    const u64 special = _string_to_f64_special ( string + i
+                                               , string_length - i
+                                               , &bits
+                                               );
+    if ( special )
+    {
+        i += special;
+        if ( !read && i != string_length )
+        {
+            return STRING_PARSE_ERROR_INVALID;
+        }
+        bits |= sign;
+        memory_copy ( value , &bits , sizeof ( f64 ) );
+        if ( read )
+        {
+            *read = i;
+        }
+        return STRING_PARSE_SUCCESS;
+    }
+
+    // Significand. The first 19 significant digits are accumulated into w;
+    // the rest only move the decimal exponent and set the truncated flag.
+    u64 w = 0;
+    u64 significant = 0;        // Significant digits read (up to 19).
+    i64 exponent = 0;           // Decimal exponent of the last digit in w.
+    bool truncated = false;     // Non-zero digits past the first 19?
+    bool any_digits = false;
+    u64 first_digit = string_length; // Index of the first significant digit.
+
+    // Integer part. Leading zeros are skipped.
+    while ( i < string_length && string[ i ] == '0' )
+    {
+        i += 1;
+        any_digits = true;
+    }
+    while ( string_length - i >= 8
+         && significant + 8 <= STRING_PARSE_MAX_U64_DIGITS
+         && string_eight_digits ( string_read8 ( string + i ) )
+          )
+    {
+        if ( first_digit == string_length )
+        {
+            first_digit = i;
+        }
+        w = w * 100000000 + string_parse_eight_digits ( string_read8 ( string + i ) );
+        significant += 8;
+        i += 8;
+    }
+    while ( i < string_length && string[ i ] >= '0' && string[ i ] <= '9' )
+    {
+        if ( first_digit == string_length )
+        {
+            first_digit = i;
+        }
+        if ( significant < STRING_PARSE_MAX_U64_DIGITS )
+        {
+            w = w * 10 + ( string[ i ] - '0' );
+            significant += 1;
+        }
+        else
+        {
+            exponent += 1;
+            truncated |= string[ i ] != '0';
+        }
+        i += 1;
+    }
+    any_digits |= first_digit != string_length;
+
+    // Fractional part. Leading zeros are skipped if no significant digit has
+    // been read yet.
+    i64 fraction_digits = 0;
+    if ( i < string_length && string[ i ] == '.' )
+    {
+        i += 1;
+        if ( !w )
+        {
+            while ( i < string_length && string[ i ] == '0' )
+            {
+                i += 1;
+                exponent -= 1;
+                fraction_digits += 1;
+                any_digits = true;
+            }
+        }
+        while ( string_length - i >= 8
+             && significant + 8 <= STRING_PARSE_MAX_U64_DIGITS
+             && string_eight_digits ( string_read8 ( string + i ) )
+              )
+        {
+            if ( first_digit == string_length )
+            {
+                first_digit = i;
+            }
+            w = w * 100000000 + string_parse_eight_digits ( string_read8 ( string + i ) );
+            significant += 8;
+            exponent -= 8;
+            fraction_digits += 8;
+            i += 8;
+        }
+        while ( i < string_length && string[ i ] >= '0' && string[ i ] <= '9' )
+        {
+            if ( first_digit == string_length )
+            {
+                first_digit = i;
+            }
+            if ( significant < STRING_PARSE_MAX_U64_DIGITS )
+            {
+                w = w * 10 + ( string[ i ] - '0' );
+                significant += 1;
+                exponent -= 1;
+            }
+            else
+            {
+                truncated |= string[ i ] != '0';
+            }
+            fraction_digits += 1;
+            i += 1;
+            any_digits = true;
+        }
+    }
+    if ( !any_digits )
+    {
+        if ( read )
+        {
+            *read = 0;
+        }
+        return STRING_PARSE_ERROR_EMPTY;
+    }
+    const u64 significand_end = i;
+
+    // Exponent. Only consumed if at least one digit follows.
+    i64 explicit_exponent = 0;
+    if ( i < string_length && ( string[ i ] | 0x20 ) == 'e' )
+    {
+        u64 j = i + 1;
+        const bool exponent_negative = j < string_length && string[ j ] == '-';
+        if ( j < string_length && ( string[ j ] == '-' || string[ j ] == '+' ) )
+        {
+            j += 1;
+        }
+        if ( j < string_length && string[ j ] >= '0' && string[ j ] <= '9' )
+        {
+            i64 e = 0;
+            while ( j < string_length && string[ j ] >= '0' && string[ j ] <= '9' )
+            {
+                if ( e < 0x10000000 ) // Saturate; far beyond any f64.
+                {
+                    e = e * 10 + ( string[ j ] - '0' );
+                }
+                j += 1;
+            }
+            explicit_exponent = ( exponent_negative ) ? -e : e;
+            exponent += explicit_exponent;
+            i = j;
+        }
+    }
+    if ( !read && i != string_length )
+    {
+        return STRING_PARSE_ERROR_INVALID;
+    }
+    if ( read )
+    {
+        *read = i;
+    }
+
+    if ( !w )
+    {
+        bits = 0;
+    }
+
+    // Clinger's fast path: w and 10^|exponent| are both exact, so a single
+    // correctly rounded multiplication or division gives the exact result.
+    else if ( !truncated
+           && exponent >= -22 && exponent <= 22
+           && w <= ( ( u64 ) 1 << 53 )
+            )
+    {
+        f64 result = ( f64 ) w;
+        result = ( exponent < 0 ) ? result / string_pow10_f64[ -exponent ]
+                                  : result * string_pow10_f64[ exponent ]
+                                  ;
+        memory_copy ( &bits , &result , sizeof ( f64 ) );
+    }
+
+    else
+    {
+        bits = _string_f64_eisel_lemire ( w , exponent );
+
+        // The true significand lies between w and w + 1. If both round the
+        // same way, so does everything in between.
+        if ( truncated && bits != _string_f64_eisel_lemire ( w + 1 , exponent ) )
+        {
+            bits = _string_f64_exact ( string + first_digit
+                                     , significand_end - first_digit
+                                     , explicit_exponent - fraction_digits
+                                     , bits
+                                     );
+        }
+    }
+
+    bits |= sign;
+    memory_copy ( value , &bits , sizeof ( f64 ) );
+    return ( ( bits << 1 ) == ( ( u64 ) 0x7FF << 53 ) ) ? STRING_PARSE_ERROR_OUT_OF_RANGE
+                                                     : STRING_PARSE_SUCCESS
+                                                     ;
+}
+
+// Vector kernels for string_hex_encode, string_hex_decode,
+// string_base64_encode and string_base64_decode. Each processes as many whole
+// blocks as it can, and returns the number of input bytes (or characters) it
+// consumed; the caller finishes the remainder one byte (or group) at a time.
+// The x86 kernels need only SSE2 (no byte shuffles), so they are used on every
+// x86-64 target. Little-endian only, as is every target supported.
+
+#if PLATFORM_SIMD_SSE2
+
+/**
+ * @brief Converts a vector of values in the range [0..15] to hexadecimal digit
+ * characters.
+ * 
+ * @param v A vector of values in the range [0..15].
+ * @param letter The distance from '0' + 10 to the digit character for 10
+ * ('a' or 'A').
+ * @return The vector of digit characters.
+ */
+INLINE __m128i
+string_hex_digits_sse2
+(   const __m128i v
+,   const __m128i letter
+)
+{
+    const __m128i letters = _mm_and_si128 ( _mm_cmpgt_epi8 ( v , _mm_set1_epi8 ( 9 ) ) , letter );
+    return _mm_add_epi8 ( _mm_add_epi8 ( v , _mm_set1_epi8 ( '0' ) ) , letters );
+}
+
+/**
+ * @brief Classifies the bytes of a vector which are in the range
+ * [first..first + count - 1] (unsigned).
+ * 
+ * @param v A vector of bytes.
+ * @param first The first byte in the range.
+ * @param count The number of bytes in the range. Must be in the range
+ * [1..128].
+ * @return A vector with every bit of a byte set if it is in range, and no bits
+ * set otherwise.
+ */
+INLINE __m128i
+string_range_sse2
+(   const __m128i   v
+,   const char      first
+,   const u8        count
+)
+{
+    const __m128i offset = _mm_sub_epi8 ( v , _mm_set1_epi8 ( first ) );
+    return _mm_cmpeq_epi8 ( _mm_min_epu8 ( offset , _mm_set1_epi8 ( count - 1 ) ) , offset );
+}
+
+/**
+ * @brief Converts a vector of hexadecimal digit characters to their values.
+ * 
+ * @param v A vector of characters.
+ * @param values Output buffer for the values.
+ * @return true if every character of v is a hexadecimal digit; false
+ * otherwise.
+ */
+INLINE bool
+string_hex_values_sse2
+(   const __m128i   v
+,   __m128i*        values
+)
+{
+    const __m128i digit = _mm_sub_epi8 ( v , _mm_set1_epi8 ( '0' ) );
+    const __m128i letter = _mm_sub_epi8 ( _mm_or_si128 ( v , _mm_set1_epi8 ( 0x20 ) ) , _mm_set1_epi8 ( 'a' - 10 ) );
+    const __m128i is_digit = string_range_sse2 ( v , '0' , 10 );
+    const __m128i is_letter = string_range_sse2 ( _mm_or_si128 ( v , _mm_set1_epi8 ( 0x20 ) ) , 'a' , 6 );
+    *values = _mm_or_si128 ( _mm_and_si128 ( is_digit , digit )
+                           , _mm_and_si128 ( is_letter , letter )
+                           );
+    return _mm_movemask_epi8 ( _mm_or_si128 ( is_digit , is_letter ) ) == 0xFFFF;
+}
+
+/**
+ * @brief Converts a vector of values in the range [0..63] to base64 digit
+ * characters.
+ * 
+ * @param v A vector of values in the range [0..63].
+ * @return The vector of digit characters.
+ */
+INLINE __m128i
+string_base64_digits_sse2
+(   const __m128i v
+)
+{
+    // 'A' + v, then correct the offset for each later range of the alphabet:
+    // 'a' - 26 , '0' - 52 , '+' - 62 and '/' - 63.
+    __m128i offset = _mm_set1_epi8 ( 'A' );
+    offset = _mm_add_epi8 ( offset , _mm_and_si128 ( _mm_cmpgt_epi8 ( v , _mm_set1_epi8 ( 25 ) ) , _mm_set1_epi8 ( 6 ) ) );
+    offset = _mm_add_epi8 ( offset , _mm_and_si128 ( _mm_cmpgt_epi8 ( v , _mm_set1_epi8 ( 51 ) ) , _mm_set1_epi8 ( -75 ) ) );
+    offset = _mm_add_epi8 ( offset , _mm_and_si128 ( _mm_cmpeq_epi8 ( v , _mm_set1_epi8 ( 62 ) ) , _mm_set1_epi8 ( -15 ) ) );
+    offset = _mm_add_epi8 ( offset , _mm_and_si128 ( _mm_cmpeq_epi8 ( v , _mm_set1_epi8 ( 63 ) ) , _mm_set1_epi8 ( -12 ) ) );
+    return _mm_add_epi8 ( v , offset );
+}
+
+/**
+ * @brief Converts a vector of base64 digit characters to their values.
+ * 
+ * @param v A vector of characters.
+ * @param values Output buffer for the values.
+ * @return true if every character of v is a base64 digit; false otherwise.
+ */
+INLINE bool
+string_base64_values_sse2
+(   const __m128i   v
+,   __m128i*        values
+)
+{
+    const __m128i upper = string_range_sse2 ( v , 'A' , 26 );
+    const __m128i lower = string_range_sse2 ( v , 'a' , 26 );
+    const __m128i digit = string_range_sse2 ( v , '0' , 10 );
+    const __m128i plus = _mm_cmpeq_epi8 ( v , _mm_set1_epi8 ( '+' ) );
+    const __m128i slash = _mm_cmpeq_epi8 ( v , _mm_set1_epi8 ( '/' ) );
+    __m128i offset = _mm_and_si128 ( upper , _mm_set1_epi8 ( -'A' ) );
+    offset = _mm_or_si128 ( offset , _mm_and_si128 ( lower , _mm_set1_epi8 ( 26 - 'a' ) ) );
+    offset = _mm_or_si128 ( offset , _mm_and_si128 ( digit , _mm_set1_epi8 ( 52 - '0' ) ) );
+    offset = _mm_or_si128 ( offset , _mm_and_si128 ( plus , _mm_set1_epi8 ( 62 - '+' ) ) );
+    offset = _mm_or_si128 ( offset , _mm_and_si128 ( slash , _mm_set1_epi8 ( 63 - '/' ) ) );
+    *values = _mm_add_epi8 ( v , offset );
+    const __m128i valid = _mm_or_si128 ( _mm_or_si128 ( upper , lower )
+                                       , _mm_or_si128 ( digit , _mm_or_si128 ( plus , slash ) )
+                                       );
+    return _mm_movemask_epi8 ( valid ) == 0xFFFF;
+}
+
+#elif PLATFORM_SIMD_NEON
+
+/** @brief NEON variant of string_hex_digits_sse2. */
+INLINE uint8x16_t
+string_hex_digits_neon
+(   const uint8x16_t v
+,   const uint8x16_t letter
+)
+{
+    const uint8x16_t letters = vandq_u8 ( vcgtq_u8 ( v , vdupq_n_u8 ( 9 ) ) , letter );
+    return vaddq_u8 ( vaddq_u8 ( v , vdupq_n_u8 ( '0' ) ) , letters );
+}
+
+/**
+ * @brief Tests whether every byte of a vector has every bit set.
+ * 
+ * @param v A vector with every bit of each byte either set or clear.
+ * @return true if every byte of v is 0xFF; false otherwise.
+ */
+INLINE bool
+string_all_neon
+(   const uint8x16_t v
+)
+{
+    // NEON has no movemask: narrow each byte to four bits instead.
+    const uint8x8_t narrow = vshrn_n_u16 ( vreinterpretq_u16_u8 ( v ) , 4 );
+    return vget_lane_u64 ( vreinterpret_u64_u8 ( narrow ) , 0 ) == ~( ( u64 ) 0 );
+}
+
+/** @brief NEON variant of string_hex_values_sse2. */
+INLINE bool
+string_hex_values_neon
+(   const uint8x16_t    v
+,   uint8x16_t*         values
+)
+{
+    const uint8x16_t digit = vsubq_u8 ( v , vdupq_n_u8 ( '0' ) );
+    const uint8x16_t letter = vsubq_u8 ( vorrq_u8 ( v , vdupq_n_u8 ( 0x20 ) ) , vdupq_n_u8 ( 'a' ) );
+    const uint8x16_t is_digit = vcltq_u8 ( digit , vdupq_n_u8 ( 10 ) );
+    const uint8x16_t is_letter = vcltq_u8 ( letter , vdupq_n_u8 ( 6 ) );
+    *values = vorrq_u8 ( vandq_u8 ( is_digit , digit )
+                       , vandq_u8 ( is_letter , vaddq_u8 ( letter , vdupq_n_u8 ( 10 ) ) )
+                       );
+    return string_all_neon ( vorrq_u8 ( is_digit , is_letter ) );
+}
+
+/** @brief NEON variant of string_base64_digits_sse2. */
+INLINE uint8x16_t
+string_base64_digits_neon
+(   const uint8x16_t v
+)
+{
+    uint8x16_t offset = vdupq_n_u8 ( 'A' );
+    offset = vaddq_u8 ( offset , vandq_u8 ( vcgtq_u8 ( v , vdupq_n_u8 ( 25 ) ) , vdupq_n_u8 ( 6 ) ) );
+    offset = vaddq_u8 ( offset , vandq_u8 ( vcgtq_u8 ( v , vdupq_n_u8 ( 51 ) ) , vdupq_n_u8 ( ( u8 ) -75 ) ) );
+    offset = vaddq_u8 ( offset , vandq_u8 ( vceqq_u8 ( v , vdupq_n_u8 ( 62 ) ) , vdupq_n_u8 ( ( u8 ) -15 ) ) );
+    offset = vaddq_u8 ( offset , vandq_u8 ( vceqq_u8 ( v , vdupq_n_u8 ( 63 ) ) , vdupq_n_u8 ( ( u8 ) -12 ) ) );
+    return vaddq_u8 ( v , offset );
+}
+
+/** @brief NEON variant of string_base64_values_sse2. */
+INLINE bool
+string_base64_values_neon
+(   const uint8x16_t    v
+,   uint8x16_t*         values
+)
+{
+    const uint8x16_t upper = vcltq_u8 ( vsubq_u8 ( v , vdupq_n_u8 ( 'A' ) ) , vdupq_n_u8 ( 26 ) );
+    const uint8x16_t lower = vcltq_u8 ( vsubq_u8 ( v , vdupq_n_u8 ( 'a' ) ) , vdupq_n_u8 ( 26 ) );
+    const uint8x16_t digit = vcltq_u8 ( vsubq_u8 ( v , vdupq_n_u8 ( '0' ) ) , vdupq_n_u8 ( 10 ) );
+    const uint8x16_t plus = vceqq_u8 ( v , vdupq_n_u8 ( '+' ) );
+    const uint8x16_t slash = vceqq_u8 ( v , vdupq_n_u8 ( '/' ) );
+    uint8x16_t offset = vandq_u8 ( upper , vdupq_n_u8 ( ( u8 ) -'A' ) );
+    offset = vorrq_u8 ( offset , vandq_u8 ( lower , vdupq_n_u8 ( ( u8 )( 26 - 'a' ) ) ) );
+    offset = vorrq_u8 ( offset , vandq_u8 ( digit , vdupq_n_u8 ( ( u8 )( 52 - '0' ) ) ) );
+    offset = vorrq_u8 ( offset , vandq_u8 ( plus , vdupq_n_u8 ( 62 - '+' ) ) );
+    offset = vorrq_u8 ( offset , vandq_u8 ( slash , vdupq_n_u8 ( 63 - '/' ) ) );
+    *values = vaddq_u8 ( v , offset );
+    return string_all_neon ( vorrq_u8 ( vorrq_u8 ( upper , lower )
+                                      , vorrq_u8 ( digit , vorrq_u8 ( plus , slash ) )
+                                      ));
+}
+
+#endif
+
+/**
+ * @brief Vector kernel for string_hex_encode.
+ * 
+ * @param src The bytes to encode.
+ * @param size The number of bytes in src.
+ * @param uppercase Use uppercase letters? Y/N
+ * @param dst Output buffer for string.
+ * @return The number of bytes of src encoded.
+ */
+INLINE u64
+string_hex_encode_simd
+(   const u8*   src
+,   const u64   size
+,   const bool  uppercase
+,   char*       dst
+)
+{
+    u64 i = 0;
+#if PLATFORM_SIMD_SSE2
+    const __m128i letter = _mm_set1_epi8 ( ( uppercase ) ? 'A' - '0' - 10 : 'a' - '0' - 10 );
+    const __m128i low = _mm_set1_epi8 ( 0x0F );
+    for ( ; i + 16 <= size; i += 16 )
+    {
+        const __m128i v = _mm_loadu_si128 ( ( const __m128i* )( src + i ) );
+        const __m128i hi = _mm_and_si128 ( _mm_srli_epi16 ( v , 4 ) , low );
+        const __m128i lo = _mm_and_si128 ( v , low );
+        _mm_storeu_si128 ( ( __m128i* )( dst + 2 * i ) , string_hex_digits_sse2 ( _mm_unpacklo_epi8 ( hi , lo ) , letter ) );
+        _mm_storeu_si128 ( ( __m128i* )( dst + 2 * i + 16 ) , string_hex_digits_sse2 ( _mm_unpackhi_epi8 ( hi , lo ) , letter ) );
+    }
+#elif PLATFORM_SIMD_NEON
+    const uint8x16_t letter = vdupq_n_u8 ( ( uppercase ) ? 'A' - '0' - 10 : 'a' - '0' - 10 );
+    for ( ; i + 16 <= size; i += 16 )
+    {
+        const uint8x16_t v = vld1q_u8 ( src + i );
+        uint8x16x2_t digits;
+        digits.val[ 0 ] = string_hex_digits_neon ( vshrq_n_u8 ( v , 4 ) , letter );
+        digits.val[ 1 ] = string_hex_digits_neon ( vandq_u8 ( v , vdupq_n_u8 ( 0x0F ) ) , letter );
+        vst2q_u8 ( ( u8* )( dst + 2 * i ) , digits );
+    }
+#endif
+    return i;
+}
+
+/**
+ * @brief Vector kernel for string_hex_decode.
+ * 
+ * @param string The string to decode.
+ * @param string_length The number of characters in string. Must be even.
+ * @param dst Output buffer for the bytes.
+ * @return The number of characters of string decoded. Stops early at a block
+ * which contains an illegal character.
+ */
+INLINE u64
+string_hex_decode_simd
+(   const char* string
+,   const u64   string_length
+,   u8*         dst
+)
+{
+    u64 i = 0;
+#if PLATFORM_SIMD_SSE2
+    for ( ; i + 32 <= string_length; i += 32 )
+    {
+        __m128i a;
+        __m128i b;
+        if ( !string_hex_values_sse2 ( _mm_loadu_si128 ( ( const __m128i* )( string + i ) ) , &a )
+          || !string_hex_values_sse2 ( _mm_loadu_si128 ( ( const __m128i* )( string + i + 16 ) ) , &b )
+           )
+        {
+            break;
+        }
+
+        // Each 16-bit lane holds a pair of digits, most significant first.
+        const __m128i even = _mm_set1_epi16 ( 0x00FF );
+        a = _mm_or_si128 ( _mm_slli_epi16 ( _mm_and_si128 ( a , even ) , 4 ) , _mm_srli_epi16 ( a , 8 ) );
+        b = _mm_or_si128 ( _mm_slli_epi16 ( _mm_and_si128 ( b , even ) , 4 ) , _mm_srli_epi16 ( b , 8 ) );
+        _mm_storeu_si128 ( ( __m128i* )( dst + i / 2 ) , _mm_packus_epi16 ( a , b ) );
+    }
+#elif PLATFORM_SIMD_NEON
+    for ( ; i + 32 <= string_length; i += 32 )
+    {
+        const uint8x16x2_t v = vld2q_u8 ( ( const u8* )( string + i ) );
+        uint8x16_t hi;
+        uint8x16_t lo;
+        if ( !string_hex_values_neon ( v.val[ 0 ] , &hi )
+          || !string_hex_values_neon ( v.val[ 1 ] , &lo )
+           )
+        {
+            break;
+        }
+        vst1q_u8 ( dst + i / 2 , vorrq_u8 ( vshlq_n_u8 ( hi , 4 ) , lo ) );
+    }
+#endif
+    return i;
+}
+
+/**
+ * @brief Vector kernel for string_base64_encode.
+ * 
+ * @param src The bytes to encode.
+ * @param size The number of bytes in src.
+ * @param dst Output buffer for string.
+ * @return The number of bytes of src encoded (a multiple of 3).
+ */
+INLINE u64
+string_base64_encode_simd
+(   const u8*   src
+,   const u64   size
+,   char*       dst
+)
+{
+    u64 i = 0;
+    u64 j = 0;
+#if PLATFORM_SIMD_SSE2
+    // 12 bytes per iteration, but a whole vector is loaded.
+    for ( ; i + 16 <= size; i += 12 , j += 16 )
+    {
+        // Spread each group of three bytes across a 32-bit lane:
+        // b0 | b1 << 8 | b2 << 16.
+        const __m128i v = _mm_loadu_si128 ( ( const __m128i* )( src + i ) );
+        const __m128i halves = _mm_unpacklo_epi64 ( v , _mm_srli_si128 ( v , 6 ) );
+        const __m128i groups = _mm_or_si128 ( _mm_and_si128 ( halves , _mm_set_epi32 ( 0 , 0x00FFFFFF , 0 , 0x00FFFFFF ) )
+                                            , _mm_and_si128 ( _mm_slli_epi64 ( halves , 8 ) , _mm_set_epi32 ( 0x00FFFFFF , 0 , 0x00FFFFFF , 0 ) )
+                                            );
+
+        // Split each group into four 6-bit values, one per byte.
+        __m128i values = _mm_and_si128 ( _mm_srli_epi32 ( groups , 2 ) , _mm_set1_epi32 ( 0x0000003F ) );
+        values = _mm_or_si128 ( values , _mm_and_si128 ( _mm_slli_epi32 ( groups , 12 ) , _mm_set1_epi32 ( 0x00003000 ) ) );
+        values = _mm_or_si128 ( values , _mm_and_si128 ( _mm_srli_epi32 ( groups , 4 ) , _mm_set1_epi32 ( 0x00000F00 ) ) );
+        values = _mm_or_si128 ( values , _mm_and_si128 ( _mm_slli_epi32 ( groups , 10 ) , _mm_set1_epi32 ( 0x003C0000 ) ) );
+        values = _mm_or_si128 ( values , _mm_and_si128 ( _mm_srli_epi32 ( groups , 6 ) , _mm_set1_epi32 ( 0x00030000 ) ) );
+        values = _mm_or_si128 ( values , _mm_and_si128 ( _mm_slli_epi32 ( groups , 8 ) , _mm_set1_epi32 ( 0x3F000000 ) ) );
+        _mm_storeu_si128 ( ( __m128i* )( dst + j ) , string_base64_digits_sse2 ( values ) );
+    }
+#elif PLATFORM_SIMD_NEON
+    for ( ; i + 48 <= size; i += 48 , j += 64 )
+    {
+        const uint8x16x3_t v = vld3q_u8 ( src + i );
+        uint8x16x4_t values;
+        values.val[ 0 ] = vshrq_n_u8 ( v.val[ 0 ] , 2 );
+        values.val[ 1 ] = vorrq_u8 ( vandq_u8 ( vshlq_n_u8 ( v.val[ 0 ] , 4 ) , vdupq_n_u8 ( 0x30 ) ) , vshrq_n_u8 ( v.val[ 1 ] , 4 ) );
+        values.val[ 2 ] = vorrq_u8 ( vandq_u8 ( vshlq_n_u8 ( v.val[ 1 ] , 2 ) , vdupq_n_u8 ( 0x3C ) ) , vshrq_n_u8 ( v.val[ 2 ] , 6 ) );
+        values.val[ 3 ] = vandq_u8 ( v.val[ 2 ] , vdupq_n_u8 ( 0x3F ) );
+        for ( u64 k = 0; k < 4; ++k )
+        {
+            values.val[ k ] = string_base64_digits_neon ( values.val[ k ] );
+        }
+        vst4q_u8 ( ( u8* )( dst + j ) , values );
+    }
+#endif
+    return i;
+}
+
+/**
+ * @brief Vector kernel for string_base64_decode.
+ * 
+ * @param string The string to decode, without padding.
+ * @param string_length The number of characters in string.
+ * @param dst Output buffer for the bytes.
+ * @return The number of characters of string decoded (a multiple of 4). Stops
+ * early at a block which contains an illegal character.
+ */
+INLINE u64
+string_base64_decode_simd
+(   const char* string
+,   const u64   string_length
+,   u8*         dst
+)
+{
+    u64 i = 0;
+    u64 j = 0;
+#if PLATFORM_SIMD_SSE2
+    // 16 characters per iteration, but 14 bytes are stored: at least four
+    // more characters must follow, so that the excess is overwritten.
+    for ( ; i + 20 <= string_length; i += 16 , j += 12 )
+    {
+        __m128i values;
+        if ( !string_base64_values_sse2 ( _mm_loadu_si128 ( ( const __m128i* )( string + i ) ) , &values ) )
+        {
+            break;
+        }
+
+        // Join each pair of 6-bit values, then each pair of 12-bit values,
+        // most significant first.
+        const __m128i pairs = _mm_or_si128 ( _mm_slli_epi16 ( _mm_and_si128 ( values , _mm_set1_epi16 ( 0x00FF ) ) , 6 )
+                                           , _mm_srli_epi16 ( values , 8 )
+                                           );
+        const __m128i groups = _mm_or_si128 ( _mm_slli_epi32 ( _mm_and_si128 ( pairs , _mm_set1_epi32 ( 0x0000FFFF ) ) , 12 )
+                                            , _mm_srli_epi32 ( pairs , 16 )
+                                            );
+
+        // Reverse the three bytes of each group, then pack the groups.
+        const __m128i bytes = _mm_or_si128 ( _mm_or_si128 ( _mm_and_si128 ( _mm_srli_epi32 ( groups , 16 ) , _mm_set1_epi32 ( 0x000000FF ) )
+                                                          , _mm_and_si128 ( groups , _mm_set1_epi32 ( 0x0000FF00 ) )
+                                                          )
+                                           , _mm_and_si128 ( _mm_slli_epi32 ( groups , 16 ) , _mm_set1_epi32 ( 0x00FF0000 ) )
+                                           );
+        const __m128i packed = _mm_or_si128 ( _mm_and_si128 ( bytes , _mm_set_epi32 ( 0 , 0x00FFFFFF , 0 , 0x00FFFFFF ) )
+                                            , _mm_srli_epi64 ( _mm_andnot_si128 ( _mm_set_epi32 ( 0 , 0x00FFFFFF , 0 , 0x00FFFFFF ) , bytes ) , 8 )
+                                            );
+        _mm_storel_epi64 ( ( __m128i* )( dst + j ) , packed );
+        _mm_storel_epi64 ( ( __m128i* )( dst + j + 6 ) , _mm_srli_si128 ( packed , 8 ) );
+    }
+#elif PLATFORM_SIMD_NEON
+    for ( ; i + 64 <= string_length; i += 64 , j += 48 )
+    {
+        const uint8x16x4_t v = vld4q_u8 ( ( const u8* )( string + i ) );
+        uint8x16_t values[ 4 ];
+        if ( !string_base64_values_neon ( v.val[ 0 ] , &values[ 0 ] )
+          || !string_base64_values_neon ( v.val[ 1 ] , &values[ 1 ] )
+          || !string_base64_values_neon ( v.val[ 2 ] , &values[ 2 ] )
+          || !string_base64_values_neon ( v.val[ 3 ] , &values[ 3 ] )
+           )
+        {
+            break;
+        }
+        uint8x16x3_t bytes;
+        bytes.val[ 0 ] = vorrq_u8 ( vshlq_n_u8 ( values[ 0 ] , 2 ) , vshrq_n_u8 ( values[ 1 ] , 4 ) );
+        bytes.val[ 1 ] = vorrq_u8 ( vshlq_n_u8 ( values[ 1 ] , 4 ) , vshrq_n_u8 ( values[ 2 ] , 2 ) );
+        bytes.val[ 2 ] = vorrq_u8 ( vshlq_n_u8 ( values[ 2 ] , 6 ) , values[ 3 ] );
+        vst3q_u8 ( dst + j , bytes );
+    }
+#endif
+    return i;
+}
+
+u64
+string_hex_encode
+(   const void* src_
+,   const u64   size
+,   const bool  uppercase
+,   char*       dst
+)
+{
+    const u8* src = src_;
+    const char* digits = string_hex_digits[ uppercase ];
+    for ( u64 i = string_hex_encode_simd ( src , size , uppercase , dst ); i < size; ++i )
+    {
+        dst[ 2 * i ] = digits[ src[ i ] >> 4 ];
+        dst[ 2 * i + 1 ] = digits[ src[ i ] & 0x0F ];
+    }
+    return STRING_HEX_LENGTH ( size );
+}
+
+STRING_PARSE_RESULT
+string_hex_decode
+(   const char* string
+,   const u64   string_length
+,   void*       dst_
+,   u64*        size
+)
+{
+    if ( string_length % 2 )
+    {
+        return STRING_PARSE_ERROR_INVALID;
+    }
+
+    u8* dst = dst_;
+    for ( u64 i = string_hex_decode_simd ( string , string_length , dst ); i < string_length; i += 2 )
+    {
+        const u8 hi = string_hex_values[ ( u8 ) string[ i ] ];
+        const u8 lo = string_hex_values[ ( u8 ) string[ i + 1 ] ];
+        if ( ( hi | lo ) == 0xFF )
+        {
+            return STRING_PARSE_ERROR_INVALID;
+        }
+        dst[ i / 2 ] = ( u8 )( hi << 4 | lo );
+    }
+    *size = string_length / 2;
+    return STRING_PARSE_SUCCESS;
+}
+
+u64
+string_base64_encode
+(   const void* src_
+,   const u64   size
+,   char*       dst
+)
+{
+    const u8* src = src_;
+    u64 i = string_base64_encode_simd ( src , size , dst );
+    u64 j = i / 3 * 4;
+    for ( ; i + 3 <= size; i += 3 , j += 4 )
+    {
+        const u32 group = ( u32 ) src[ i ] << 16 | ( u32 ) src[ i + 1 ] << 8 | src[ i + 2 ];
+        dst[ j ] = string_base64_digits[ group >> 18 ];
+        dst[ j + 1 ] = string_base64_digits[ ( group >> 12 ) & 0x3F ];
+        dst[ j + 2 ] = string_base64_digits[ ( group >> 6 ) & 0x3F ];
+        dst[ j + 3 ] = string_base64_digits[ group & 0x3F ];
+    }
+    if ( i < size )
+    {
+        const u32 group = ( u32 ) src[ i ] << 16 | ( ( i + 1 < size ) ? ( u32 ) src[ i + 1 ] << 8 : 0 );
+        dst[ j ] = string_base64_digits[ group >> 18 ];
+        dst[ j + 1 ] = string_base64_digits[ ( group >> 12 ) & 0x3F ];
+        dst[ j + 2 ] = ( i + 1 < size ) ? string_base64_digits[ ( group >> 6 ) & 0x3F ] : '=';
+        dst[ j + 3 ] = '=';
+    }
+    return STRING_BASE64_LENGTH ( size );
+}
+
+STRING_PARSE_RESULT
+string_base64_decode
+(   const char* string
+,   const u64   string_length
+,   void*       dst_
+,   u64*        size
+)
+{
+    // Padding is only legal to complete the last group of four characters.
+    u64 length = string_length;
+    if ( length && !( length % 4 ) && string[ length - 1 ] == '=' )
+    {
+        length -= ( string[ length - 2 ] == '=' ) ? 2 : 1;
+    }
+    if ( length % 4 == 1 )
+    {
+        return STRING_PARSE_ERROR_INVALID;
+    }
+
+    u8* dst = dst_;
+    u64 i = string_base64_decode_simd ( string , length , dst );
+    u64 j = i / 4 * 3;
+    for ( ; i < length; i += 4 )
+    {
+        // A trailing group of two or three characters holds one or two bytes.
+        const u64 count = MIN ( length - i , ( u64 ) 4 );
+        u32 group = 0;
+        u8 invalid = 0;
+        for ( u64 k = 0; k < 4; ++k )
+        {
+            const u8 value = ( k < count ) ? string_base64_values[ ( u8 ) string[ i + k ] ] : 0;
+            invalid |= value;
+            group = group << 6 | value;
+        }
+        if ( invalid == 0xFF )
+        {
+            return STRING_PARSE_ERROR_INVALID;
+        }
+        for ( u64 k = 0; k < count - 1; ++k )
+        {
+            dst[ j++ ] = ( u8 )( group >> ( 16 - 8 * k ) );
+        }
+    }
+    *size = j;
+    return STRING_PARSE_SUCCESS;
+}
+
+const char*
+string_bytesize
+(   u64     size
+,   f64*    amount
+)
+{
+    if ( size >= GiB ( 1 ) )
+    {
+        *amount = ( f64 ) size / GiB ( 1 );
+        return "GiB";
+    }
+    if ( size >= MiB ( 1 ) )
+    {
+        *amount = ( f64 ) size / MiB ( 1 );
+        return "MiB";
+    }
+    if ( size >= KiB ( 1 ) )
+    {
+        *amount = ( f64 ) size / KiB ( 1 );
+        return "KiB";
+    }
+    *amount = ( f64 ) size;
+    return "B";
+}
+
+char*
+string_allocate
+(   u64 content_size
+)
+{
+    const u64 header_size = sizeof ( u64 );
+    const u64 size = header_size + content_size;
+    char* string = memory_allocate ( size , MEMORY_TAG_STRING );
+    *( ( u64* ) string ) = size;
+    return ( char* )( ( ( u64 ) string ) + header_size );
+}
+
+char*
+string_allocate_uninit
+(   u64 content_size
+)
+{
+    const u64 header_size = sizeof ( u64 );
+    const u64 size = header_size + content_size;
+    char* string = memory_allocate_uninit ( size , MEMORY_TAG_STRING );
+    *( ( u64* ) string ) = size;
+    return ( char* )( ( ( u64 ) string ) + header_size );
+}
+
+char*
+string_allocate_from
+(   const char* string
+)
+{
+    const u64 length = _string_length ( string );
+    char* copy = string_allocate_uninit ( length + 1 );
+    memory_copy ( copy , string , length + 1 );
+    return copy;
+}
+
+void
+string_free
+(   void* string
+)
+{
+    if ( !string )
+    {
+        return;
+    }
     const u64 header_size = sizeof ( u64 );
     string = ( void* )( ( ( u64 ) string ) - header_size );
     memory_free ( string
@@ -292,87 +3489,1349 @@ string_free
 }
 
 bool
-__string_contains
-(   const char* search
-,   const u64   search_length
-,   const char* find
-,   const u64   find_length
-,   u64*        index
+__string_contains
+(   const char* search
+,   const u64   search_length
+,   const char* find
+,   const u64   find_length
+,   u64*        index
+)
+{
+    if ( !find_length )
+    {
+        *index = 0;
+        return true;
+    }
+
+    const string_simd_t first = string_simd_splat ( find[ 0 ] );
+    const string_simd_t last = string_simd_splat ( find[ find_length - 1 ] );
+    const u64 candidates = search_length - find_length + 1;
+    u64 false_candidates = 0;
+    u64 i = 0;
+    for ( ; i + STRING_SIMD_WIDTH <= candidates; i += STRING_SIMD_WIDTH )
+    {
+        u64 mask = string_simd_match ( search + i
+                                     , search + i + find_length - 1
+                                     , first
+                                     , last
+                                     );
+        while ( mask )
+        {
+            const u64 j = i + bitscan_forward ( mask ) / STRING_SIMD_LANE_BITS;
+            if ( find_length <= 2 || memory_equal ( search + j + 1 , find + 1 , find_length - 2 ) )
+            {
+                *index = j;
+                return true;
+            }
+            mask &= mask - 1;
+            false_candidates += 1;
+        }
+
+        // Once verifying false candidates costs more than a few comparisons
+        // per character scanned, switch to a search with a linear bound.
+        if ( find_length >= STRING_TWO_WAY_MIN_LENGTH
+          && false_candidates * find_length > 4 * ( i + STRING_SIMD_WIDTH ) + 1024
+           )
+        {
+            i += STRING_SIMD_WIDTH;
+            if ( !_string_contains_two_way ( search + i
+                                           , search_length - i
+                                           , find
+                                           , find_length
+                                           , index
+                                           ))
+            {
+                return false;
+            }
+            *index += i;
+            return true;
+        }
+    }
+
+    // Remaining candidates (fewer than one vector).
+    for ( ; i < candidates; ++i )
+    {
+        if ( search[ i ] == find[ 0 ]
+          && search[ i + find_length - 1 ] == find[ find_length - 1 ]
+          && ( find_length <= 2 || memory_equal ( search + i + 1 , find + 1 , find_length - 2 ) )
+           )
+        {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+__string_contains_reverse
+(   const char* search
+,   const u64   search_length
+,   const char* find
+,   const u64   find_length
+,   u64*        index
+)
+{
+    if ( !find_length )
+    {
+        *index = search_length - 1;
+        return true;
+    }
+
+    const string_simd_t first = string_simd_splat ( find[ 0 ] );
+    const string_simd_t last = string_simd_splat ( find[ find_length - 1 ] );
+    u64 i = search_length - find_length + 1; // Candidates [0..i) remain.
+    for ( ; i >= STRING_SIMD_WIDTH; i -= STRING_SIMD_WIDTH )
+    {
+        const u64 base = i - STRING_SIMD_WIDTH;
+        u64 mask = string_simd_match ( search + base
+                                     , search + base + find_length - 1
+                                     , first
+                                     , last
+                                     );
+        while ( mask )
+        {
+            const u8 bit = bitscan_reverse ( mask );
+            const u64 j = base + bit / STRING_SIMD_LANE_BITS;
+            if ( find_length <= 2 || memory_equal ( search + j + 1 , find + 1 , find_length - 2 ) )
+            {
+                *index = j;
+                return true;
+            }
+            mask ^= ( u64 ) 1 << bit;
+        }
+    }
+
+    // Remaining candidates (fewer than one vector).
+    for ( ; i; --i )
+    {
+        if ( search[ i - 1 ] == find[ 0 ]
+          && search[ i + find_length - 2 ] == find[ find_length - 1 ]
+          && ( find_length <= 2 || memory_equal ( search + i , find + 1 , find_length - 2 ) )
+           )
+        {
+            *index = i - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+_string_contains_two_way
+(   const char* search
+,   const u64   search_length
+,   const char* find
+,   const u64   find_length
+,   u64*        index
+)
+{
+    if ( find_length > search_length )
+    {
+        return false;
+    }
+
+    const u8* haystack = ( const u8* ) search;
+    const u8* needle = ( const u8* ) find;
+    u64 period;
+    const u64 split = _string_critical_factorization ( needle , find_length , &period );
+    u64 i;
+    u64 j = 0;
+
+    // Periodic substring: after a mismatch in the right half, the prefix
+    // already matched ( memory ) need not be compared again.
+    if ( memory_equal ( needle , needle + period , split ) )
+    {
+        u64 memory = 0;
+        while ( j <= search_length - find_length )
+        {
+            i = MAX ( split , memory );
+            while ( i < find_length && needle[ i ] == haystack[ i + j ] )
+            {
+                i += 1;
+            }
+            if ( i < find_length )
+            {
+                j += i - split + 1;
+                memory = 0;
+                continue;
+            }
+            i = split;
+            while ( i > memory && needle[ i - 1 ] == haystack[ i - 1 + j ] )
+            {
+                i -= 1;
+            }
+            if ( i <= memory )
+            {
+                *index = j;
+                return true;
+            }
+            j += period;
+            memory = find_length - period;
+        }
+        return false;
+    }
+
+    // Non-periodic substring: shift past the longer half on a mismatch in the
+    // left half.
+    period = MAX ( split , find_length - split ) + 1;
+    while ( j <= search_length - find_length )
+    {
+        i = split;
+        while ( i < find_length && needle[ i ] == haystack[ i + j ] )
+        {
+            i += 1;
+        }
+        if ( i < find_length )
+        {
+            j += i - split + 1;
+            continue;
+        }
+        i = split;
+        while ( i && needle[ i - 1 ] == haystack[ i - 1 + j ] )
+        {
+            i -= 1;
+        }
+        if ( !i )
+        {
+            *index = j;
+            return true;
+        }
+        j += period;
+    }
+    return false;
+}
+
+u64
+_string_critical_factorization
+(   const u8*   string
+,   const u64   string_length
+,   u64*        period
+)
+{
+    // suffix is one less than the start of the maximal suffix, and wraps
+    // around from zero (so suffix + k indexes correctly).
+    u64 periods[ 2 ];
+    u64 suffixes[ 2 ];
+    for ( u8 reverse = 0; reverse < 2; ++reverse )
+    {
+        u64 suffix = ( u64 ) -1;
+        u64 j = 0;
+        u64 k = 1;
+        u64 p = 1;
+        while ( j + k < string_length )
+        {
+            const u8 a = string[ j + k ];
+            const u8 b = string[ suffix + k ];
+            if ( ( reverse ) ? b < a : a < b )
+            {
+                j += k;
+                k = 1;
+                p = j - suffix;
+            }
+            else if ( a == b )
+            {
+                if ( k != p )
+                {
+                    k += 1;
+                }
+                else
+                {
+                    j += p;
+                    k = 1;
+                }
+            }
+            else
+            {
+                suffix = j;
+                j += 1;
+                k = 1;
+                p = 1;
+            }
+        }
+        periods[ reverse ] = p;
+        suffixes[ reverse ] = suffix + 1;
+    }
+
+    const u8 later = suffixes[ 1 ] > suffixes[ 0 ];
+    *period = periods[ later ];
+    return suffixes[ later ];
+}
+
+u64
+_string_u64
+(   u64     value
+,   u8      radix
+,   char*   dst
+)
+{
+    // Decimal: count the digits, then fill them in two at a time from the end.
+    if ( radix == 10 )
+    {
+        u64 length = 1;
+        for ( u64 bound = 10; value >= bound; bound *= 10 )
+        {
+            length += 1;
+            if ( length == 20 )
+            {
+                break; // 10^20 does not fit in 64 bits.
+            }
+        }
+
+        char* write = dst + length;
+        while ( value >= 100 )
+        {
+            const u64 pair = 2 * ( value % 100 );
+            value /= 100;
+            write -= 2;
+            write[ 0 ] = string_integer_digit_pairs[ pair ];
+            write[ 1 ] = string_integer_digit_pairs[ pair + 1 ];
+        }
+        if ( value >= 10 )
+        {
+            write[ -2 ] = string_integer_digit_pairs[ 2 * value ];
+            write[ -1 ] = string_integer_digit_pairs[ 2 * value + 1 ];
+        }
+        else
+        {
+            write[ -1 ] = '0' + value;
+        }
+        return length;
+    }
+
+    // Power-of-two radix: each digit is a fixed-width bit field.
+    if ( !( radix & ( radix - 1 ) ) )
+    {
+        const u8 shift = bitscan_reverse ( radix );
+        const u64 mask = radix - 1;
+        const u64 length = ( value ) ? bitscan_reverse ( value ) / shift + 1
+                                     : 1
+                                     ;
+        for ( u64 i = length; i; --i )
+        {
+            dst[ i - 1 ] = string_integer_digits[ value & mask ];
+            value >>= shift;
+        }
+        return length;
+    }
+
+    // Any other radix: one division per digit, then reverse.
+    char* i = dst;
+    do
+    {
+        *i = string_integer_digits[ value % radix ];
+        value /= radix;
+        i += 1;
+    }
+    while ( value );
+    string_reverse ( dst , i - dst );
+    return i - dst;
+}
+
+bool
+_string_f64_decompose
+(   const f64   value
+,   u64*        mantissa
+,   i32*        exponent
+)
+{
+    u64 bits;
+    memory_copy ( &bits , &value , sizeof ( bits ) );
+    const u64 fraction = bits & ( ( ( u64 ) 1 << 52 ) - 1 );
+    const u32 biased_exponent = ( bits >> 52 ) & 0x7FF;
+
+    if ( biased_exponent == 0x7FF )
+    {
+        *mantissa = fraction; // Non-zero for NaN.
+        *exponent = 0;
+        return false;
+    }
+
+    // Subnormal numbers have no implicit leading bit.
+    if ( biased_exponent )
+    {
+        *mantissa = fraction | ( ( u64 ) 1 << 52 );
+        *exponent = ( i32 ) biased_exponent - 1075;
+    }
+    else
+    {
+        *mantissa = fraction;
+        *exponent = -1074;
+    }
+    return true;
+}
+
+u64
+_string_f64_prefix
+(   const f64   value
+,   const bool  abbreviated
+,   const u64   mantissa
+,   const bool  finite
+,   char*       dst
+)
+{
+    u64 bits;
+    memory_copy ( &bits , &value , sizeof ( bits ) );
+    const bool negative = bits >> 63;
+    if ( negative )
+    {
+        *dst = '-';
+    }
+    if ( finite )
+    {
+        return negative;
+    }
+
+    // Same spelling as printf: lowercase, except in abbreviated notation.
+    const char* spelling;
+    if ( mantissa )
+    {
+        spelling = ( abbreviated ) ? "NAN" : "nan";
+    }
+    else
+    {
+        spelling = ( abbreviated ) ? "INF" : "inf";
+    }
+    memory_copy ( dst + negative , spelling , 3 );
+    return negative + 3;
+}
+
+u64
+_string_f64_exponent
+(   const i32   exponent
+,   char*       dst
+)
+{
+    dst[ 0 ] = 'E';
+    dst[ 1 ] = ( exponent < 0 ) ? '-' : '+';
+    const u64 magnitude = ( exponent < 0 ) ? -exponent : exponent;
+    if ( magnitude < 10 )
+    {
+        dst[ 2 ] = '0';
+        dst[ 3 ] = '0' + magnitude;
+        return 4;
+    }
+    return 2 + _string_u64 ( magnitude , 10 , dst + 2 );
+}
+
+i32
+_string_f64_estimate_exponent
+(   const u64   mantissa
+,   const i32   exponent
+)
+{
+    // floor ( e * log10 ( 2 ) ) == floor ( e * 78913 / 2^18 ) for | e | < 1650.
+    const i32 e = exponent + bitscan_reverse ( mantissa );
+    const i32 floor_log10 = ( e >= 0 ) ? ( i32 )( ( ( u64 ) e * 78913 ) >> 18 )
+                                 : -( i32 )( ( ( u64 )( -e ) * 78913 ) >> 18 ) - 1
+                                 ;
+    return floor_log10 + 1;
+}
+
+u64
+_string_f64_digits
+(   const u64   mantissa
+,   const i32   exponent
+,   const u8    precision
+,   const bool  abbreviated
+,   char*       digits
+,   i32*        k_
+)
+{
+    u64 count_;
+    if ( _string_f64_digits_fast ( mantissa
+                                 , exponent
+                                 , precision
+                                 , abbreviated
+                                 , digits
+                                 , k_
+                                 , &count_
+                                 ))
+    {
+        return count_;
+    }
+
+    // value = r / s exactly.
+    bigint_t r;
+    bigint_t s;
+    bigint_set ( &r , mantissa );
+    bigint_set ( &s , 1 );
+    if ( exponent > 0 )
+    {
+        bigint_shift_left ( &r , exponent );
+    }
+    else
+    {
+        bigint_shift_left ( &s , -exponent );
+    }
+
+    // Scale so that value = ( r / s ) * 10^k, with r / s in [0.1, 1).
+    i32 k = _string_f64_estimate_exponent ( mantissa , exponent );
+    if ( k >= 0 )
+    {
+        bigint_multiply_pow10 ( &s , k );
+    }
+    else
+    {
+        bigint_multiply_pow10 ( &r , -k );
+    }
+    if ( bigint_compare ( &r , &s ) >= 0 )
+    {
+        bigint_multiply ( &s , 10 );
+        k += 1;
+    }
+
+    i32 count = ( abbreviated ) ? precision + 1 : k + precision;
+    i32 remainder; // Sign of ( remainder - half a unit in the last place ).
+    if ( count < 0 )
+    {
+        // Less than a tenth of a unit in the last place.
+        k = -precision;
+        count = 0;
+        remainder = -1;
+    }
+    else
+    {
+        for ( i32 i = 0; i < count; ++i )
+        {
+            bigint_multiply ( &r , 10 );
+            digits[ i ] = '0' + bigint_divide_digit ( &r , &s );
+        }
+        bigint_shift_left ( &r , 1 );
+        remainder = bigint_compare ( &r , &s );
+    }
+
+    *k_ = k;
+    return _string_f64_round ( digits , count , remainder , abbreviated , k_ );
+}
+
+u64
+_string_f64_digits_shortest
+(   const u64   mantissa
+,   const i32   exponent
+,   char*       digits
+,   i32*        k_
+)
+{
+    u64 count;
+    if ( _string_f64_digits_grisu ( mantissa , exponent , digits , k_ , &count ) )
+    {
+        return count;
+    }
+
+    // value = r / s exactly, and the halfway points to the neighboring
+    // floating point numbers are ( r - m_minus ) / s and ( r + m_plus ) / s.
+    // The gap below is half as wide at the bottom of each binade.
+    const bool unequal_gaps = mantissa == ( ( u64 ) 1 << 52 ) && exponent > -1074;
+    const u32 scale = 1 + unequal_gaps;
+    bigint_t r;
+    bigint_t s;
+    bigint_t m_plus;
+    bigint_t m_minus;
+    bigint_set ( &r , mantissa );
+    bigint_set ( &s , 1 );
+    bigint_set ( &m_plus , 1 );
+    bigint_set ( &m_minus , 1 );
+    if ( exponent >= 0 )
+    {
+        bigint_shift_left ( &r , exponent + scale );
+        bigint_shift_left ( &s , scale );
+        bigint_shift_left ( &m_plus , exponent + unequal_gaps );
+        bigint_shift_left ( &m_minus , exponent );
+    }
+    else
+    {
+        bigint_shift_left ( &r , scale );
+        bigint_shift_left ( &s , scale - exponent );
+        bigint_shift_left ( &m_plus , unequal_gaps );
+    }
+
+    // A number with an even mantissa wins ties when parsed, so the interval
+    // of numbers which round to value is closed.
+    const bool inclusive = !( mantissa & 1 );
+
+    // Scale so that ( r + m_plus ) / s is in [0.1, 1) (or (0.1, 1] if the
+    // interval is open).
+    bigint_t high;
+    i32 k = _string_f64_estimate_exponent ( mantissa , exponent );
+    if ( k >= 0 )
+    {
+        bigint_multiply_pow10 ( &s , k );
+    }
+    else
+    {
+        bigint_multiply_pow10 ( &r , -k );
+        bigint_multiply_pow10 ( &m_plus , -k );
+        bigint_multiply_pow10 ( &m_minus , -k );
+    }
+    for (;;)
+    {
+        bigint_add ( &high , &r , &m_plus );
+        const i32 comparison = bigint_compare ( &high , &s );
+        if ( comparison < 0 || ( !comparison && !inclusive ) )
+        {
+            break;
+        }
+        bigint_multiply ( &s , 10 );
+        k += 1;
+    }
+
+    // Generate digits until the remaining ones can be dropped (low) or the
+    // last one rounded up (high) without leaving the interval.
+    count = 0;
+    for (;;)
+    {
+        bigint_multiply ( &r , 10 );
+        bigint_multiply ( &m_plus , 10 );
+        bigint_multiply ( &m_minus , 10 );
+        u8 digit = bigint_divide_digit ( &r , &s );
+
+        i32 comparison = bigint_compare ( &r , &m_minus );
+        const bool low = comparison < 0 || ( !comparison && inclusive );
+        bigint_add ( &high , &r , &m_plus );
+        comparison = bigint_compare ( &high , &s );
+        const bool high_ = comparison > 0 || ( !comparison && inclusive );
+
+        if ( !low && !high_ )
+        {
+            digits[ count ] = '0' + digit;
+            count += 1;
+            continue;
+        }
+
+        // If both are possible, pick whichever is closer (or even, on a tie).
+        if ( low && high_ )
+        {
+            bigint_shift_left ( &r , 1 );
+            comparison = bigint_compare ( &r , &s );
+            if ( comparison > 0 || ( !comparison && ( digit & 1 ) ) )
+            {
+                digit += 1;
+            }
+        }
+        else if ( high_ )
+        {
+            digit += 1;
+        }
+        digits[ count ] = '0' + digit;
+        count += 1;
+        break;
+    }
+
+    *k_ = k;
+    return count;
+}
+
+bool
+_string_f64_digits_grisu
+(   const u64   mantissa
+,   const i32   exponent
+,   char*       digits
+,   i32*        k
+,   u64*        count
+)
+{
+    // The value, and the halfway points to its neighbors, with a common
+    // exponent. The gap below is half as wide at the bottom of each binade.
+    const bool unequal_gaps = mantissa == ( ( u64 ) 1 << 52 ) && exponent > -1074;
+    const fp_t w = fp_normalize ( ( fp_t ){ mantissa , exponent } );
+    const fp_t plus = fp_normalize ( ( fp_t ){ ( mantissa << 1 ) + 1 , exponent - 1 } );
+    fp_t minus = ( unequal_gaps ) ? ( fp_t ){ ( mantissa << 2 ) - 1 , exponent - 2 }
+                                  : ( fp_t ){ ( mantissa << 1 ) - 1 , exponent - 1 }
+                                  ;
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Pick a cached power of ten c = 10^-mk, such that the binary exponent of
+    // w * c lies in [-60, -32]; then the integer part of each scaled number
+    // fits in 32 bits, and its fractional part can be multiplied by 10 without
+    // overflow.
+    const i32 x = -60 - ( w.e + 64 ) + 63;
+    const i32 ceil_log10 = ( x > 0 ) ? ( i32 )( ( ( u64 ) x * 78913 ) >> 18 ) + 1
+                         : ( x < 0 ) ? -( i32 )( ( ( u64 )( -x ) * 78913 ) >> 18 )
+                         : 0
+                         ;
+    const pow10_t* pow10 = &string_pow10_cache[ ( ceil_log10 - STRING_POW10_CACHE_FIRST_EXPONENT - 1 ) / STRING_POW10_CACHE_STEP + 1 ];
+    const fp_t c = { ( *pow10 ).significand , ( *pow10 ).binary_exponent };
+    const fp_t scaled_w = fp_multiply ( w , c );
+    const fp_t scaled_minus = fp_multiply ( minus , c );
+    const fp_t scaled_plus = fp_multiply ( plus , c );
+
+    // Each product may be off by up to one unit, so widen the interval by a
+    // unit on both sides: any digits within it are certainly acceptable only
+    // if they are also within the narrowed interval (see
+    // _string_f64_grisu_round).
+    u64 unit = 1;
+    const u64 too_low = scaled_minus.f - unit;
+    const u64 too_high = scaled_plus.f + unit;
+    u64 unsafe_interval = too_high - too_low;
+    const u32 shift = -scaled_w.e;
+    const u64 one = ( u64 ) 1 << shift;
+    u32 integrals = too_high >> shift;
+    u64 fractionals = too_high & ( one - 1 );
+
+    // Integral digits.
+    i32 kappa = 0;
+    if ( integrals )
+    {
+        kappa = 1;
+        while ( kappa < 10 && integrals >= string_pow10_u32[ kappa ] )
+        {
+            kappa += 1;
+        }
+    }
+    u64 n = 0;
+    while ( kappa > 0 )
+    {
+        const u32 divisor = string_pow10_u32[ kappa - 1 ];
+        digits[ n ] = '0' + integrals / divisor;
+        n += 1;
+        integrals %= divisor;
+        kappa -= 1;
+        const u64 rest = ( ( u64 ) integrals << shift ) + fractionals;
+        if ( rest < unsafe_interval )
+        {
+            *count = n;
+            *k = -( *pow10 ).decimal_exponent + kappa + n;
+            return _string_f64_grisu_round ( digits
+                                           , n
+                                           , too_high - scaled_w.f
+                                           , unsafe_interval
+                                           , rest
+                                           , ( u64 ) divisor << shift
+                                           , unit
+                                           );
+        }
+    }
+
+    // Fractional digits.
+    for (;;)
+    {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digits[ n ] = '0' + ( fractionals >> shift );
+        n += 1;
+        fractionals &= one - 1;
+        kappa -= 1;
+        if ( fractionals < unsafe_interval )
+        {
+            *count = n;
+            *k = -( *pow10 ).decimal_exponent + kappa + n;
+            return _string_f64_grisu_round ( digits
+                                           , n
+                                           , ( too_high - scaled_w.f ) * unit
+                                           , unsafe_interval
+                                           , fractionals
+                                           , one
+                                           , unit
+                                           );
+        }
+    }
+}
+
+bool
+_string_f64_grisu_round
+(   char*       digits
+,   const u64   count
+,   const u64   distance_too_high_w
+,   const u64   unsafe_interval
+,   u64         rest
+,   const u64   ten_kappa
+,   const u64   unit
 )
 {
-    if ( !find_length )
+    // The exact value lies somewhere in ( w - unit , w + unit ). Decrement the
+    // last digit while that moves the digits closer to the value for every
+    // value in that range.
+    const u64 small_distance = distance_too_high_w - unit;
+    const u64 big_distance = distance_too_high_w + unit;
+    while ( rest < small_distance
+         && unsafe_interval - rest >= ten_kappa
+         && ( rest + ten_kappa < small_distance
+           || small_distance - rest >= rest + ten_kappa - small_distance
+            ))
     {
-        *index = 0;
-        return true;
+        digits[ count - 1 ] -= 1;
+        rest += ten_kappa;
+    }
+
+    // If decrementing once more could be closer for some value in the range,
+    // the result is uncertain.
+    if ( rest < big_distance
+      && unsafe_interval - rest >= ten_kappa
+      && ( rest + ten_kappa < big_distance
+        || big_distance - rest > rest + ten_kappa - big_distance
+         ))
+    {
+        return false;
+    }
+
+    // The digits must also lie safely within the interval.
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+STRING_PARSE_RESULT
+_string_to_integer
+(   const char* string
+,   const u64   string_length
+,   const u8    radix
+,   const bool  allow_negative
+,   u64*        magnitude
+,   bool*       negative
+,   bool*       overflow
+,   u64*        read
+)
+{
+    if ( radix < STRING_INTEGER_MIN_RADIX || radix > STRING_INTEGER_MAX_RADIX )
+    {
+        LOGERROR ( "string_to_%s: Illegal value for radix argument: %u. Must be in the range [%u..%u]."
+                 , ( allow_negative ) ? "i64" : "u64"
+                 , radix
+                 , STRING_INTEGER_MIN_RADIX
+                 , STRING_INTEGER_MAX_RADIX
+                 );
+        return STRING_PARSE_ERROR_INVALID;
     }
-    for ( u64 i = 0; i <= search_length - find_length; ++i )
+
+    u64 i = 0;
+    *negative = false;
+    if ( string_length && ( string[ 0 ] == '-' || string[ 0 ] == '+' ) )
     {
-        if ( search[ i ] != *find )
+        if ( string[ 0 ] == '-' && !allow_negative )
         {
-            continue;
+            return STRING_PARSE_ERROR_INVALID;
         }
+        *negative = string[ 0 ] == '-';
+        i += 1;
+    }
+    const u64 digits = i;
 
-        if ( memory_equal ( search + i + 1 , find + 1 , find_length - 1 ) )
+    u64 value = 0;
+    bool saturated = false;
+
+    // Eight decimal digits at a time while the result cannot overflow
+    // (value < 10^11 guarantees value * 10^8 + 99999999 < 10^19 < 2^64).
+    if ( radix == 10 )
+    {
+        while ( string_length - i >= 8
+             && value < 100000000000
+             && string_eight_digits ( string_read8 ( string + i ) )
+              )
         {
-            *index = i;
-            return true;
+            value = value * 100000000 + string_parse_eight_digits ( string_read8 ( string + i ) );
+            i += 8;
         }
     }
-    return false;
+
+    const u64 cutoff = ( ( u64 ) -1 ) / radix;
+    const u8 cutoff_digit = ( ( u64 ) -1 ) % radix;
+    while ( i < string_length )
+    {
+        const u8 digit = string_digit_value ( string[ i ] );
+        if ( digit >= radix )
+        {
+            break;
+        }
+        if ( value > cutoff || ( value == cutoff && digit > cutoff_digit ) )
+        {
+            saturated = true;
+            value = ( u64 ) -1;
+        }
+        else if ( !saturated )
+        {
+            value = value * radix + digit;
+        }
+        i += 1;
+    }
+
+    if ( i == digits )
+    {
+        if ( read )
+        {
+            *read = 0;
+        }
+        return STRING_PARSE_ERROR_EMPTY;
+    }
+    if ( !read && i != string_length )
+    {
+        return STRING_PARSE_ERROR_INVALID;
+    }
+    if ( read )
+    {
+        *read = i;
+    }
+    *magnitude = value;
+    *overflow = saturated;
+    return STRING_PARSE_SUCCESS;
 }
 
-bool
-__string_contains_reverse
-(   const char* search
-,   const u64   search_length
-,   const char* find
-,   const u64   find_length
-,   u64*        index
+u64
+_string_to_f64_special
+(   const char* string
+,   const u64   string_length
+,   u64*        bits
 )
 {
-    if ( !find_length )
+    if ( string_length < 3 )
     {
-        *index = search_length - 1;
-        return true;
+        return 0;
+    }
+    const char c0 = string[ 0 ] | 0x20;
+    const char c1 = string[ 1 ] | 0x20;
+    const char c2 = string[ 2 ] | 0x20;
+    if ( c0 == 'n' && c1 == 'a' && c2 == 'n' )
+    {
+        *bits = 0x7FF8000000000000;
+        return 3;
+    }
+    if ( c0 != 'i' || c1 != 'n' || c2 != 'f' )
+    {
+        return 0;
     }
-    for ( u64 i = search_length - find_length + 1; i; --i )
+    *bits = 0x7FF0000000000000;
+    static const char inity[] = "inity";
+    for ( u64 i = 0; i < 5; ++i )
     {
-        if ( search[ i - 1 ] != *find )
+        if ( 3 + i >= string_length || ( string[ 3 + i ] | 0x20 ) != inity[ i ] )
         {
-            continue;
+            return 3;
+        }
+    }
+    return 8;
+}
+
+u64
+_string_multiply_u64
+(   const u64   a
+,   const u64   b
+,   u64*        low
+)
+{
+    const u64 a_high = a >> 32;
+    const u64 a_low = a & 0xFFFFFFFF;
+    const u64 b_high = b >> 32;
+    const u64 b_low = b & 0xFFFFFFFF;
+    const u64 high_high = a_high * b_high;
+    const u64 low_high = a_low * b_high;
+    const u64 high_low = a_high * b_low;
+    const u64 low_low = a_low * b_low;
+    const u64 middle = ( low_low >> 32 ) + ( high_low & 0xFFFFFFFF ) + ( low_high & 0xFFFFFFFF );
+    *low = ( middle << 32 ) | ( low_low & 0xFFFFFFFF );
+    return high_high + ( high_low >> 32 ) + ( low_high >> 32 ) + ( middle >> 32 );
+}
+
+u64
+_string_f64_eisel_lemire
+(   u64         w
+,   const i64   q
+)
+{
+    if ( !w || q < -342 )
+    {
+        return 0;
+    }
+    if ( q > 308 )
+    {
+        return 0x7FF0000000000000;
+    }
+
+    const u8 leading_zeros = 63 - bitscan_reverse ( w );
+    w <<= leading_zeros;
+
+    // The 55 most significant bits of the product decide the result. The
+    // second multiplication is only needed if they could still change.
+    const u64* power = string_pow5_128[ q + 342 ];
+    u64 low;
+    u64 high = _string_multiply_u64 ( w , power[ 0 ] , &low );
+    if ( ( high & 0x1FF ) == 0x1FF )
+    {
+        u64 low_low;
+        const u64 low_high = _string_multiply_u64 ( w , power[ 1 ] , &low_low );
+        low += low_high;
+        if ( low_high > low )
+        {
+            high += 1;
         }
+    }
+
+    // Keep 54 bits (one more than the significand, to round on).
+    const u32 upper_bit = high >> 63;
+    const u32 shift = upper_bit + 9;
+    u64 mantissa = high >> shift;
+    i32 biased_exponent = ( ( ( 152170 + 65536 ) * ( i32 ) q ) >> 16 ) // floor ( q * log2 ( 10 ) )
+                        + 63 + upper_bit - leading_zeros + 1023
+                        ;
 
-        if ( memory_equal ( search + i , find + 1 , find_length - 1 ) )
+    // Subnormal.
+    if ( biased_exponent <= 0 )
+    {
+        if ( -biased_exponent + 1 >= 64 )
         {
-            *index = i - 1;
-            return true;
+            return 0;
         }
+        mantissa >>= -biased_exponent + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+
+        // Rounding up to 2^52 yields the smallest normal number.
+        return mantissa;
     }
-    return false;
+
+    // Exactly halfway: round to even. Only possible for small q, where the
+    // power of five is exact.
+    if ( low <= 1 && q >= -4 && q <= 23 && ( mantissa & 3 ) == 1
+      && ( mantissa << shift ) == high
+       )
+    {
+        mantissa &= ~( u64 ) 1;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if ( mantissa >= ( ( u64 ) 2 << 52 ) )
+    {
+        mantissa = ( u64 ) 1 << 52;
+        biased_exponent += 1;
+    }
+    mantissa &= ~( ( u64 ) 1 << 52 );
+    if ( biased_exponent >= 0x7FF )
+    {
+        return 0x7FF0000000000000;
+    }
+    return ( ( u64 ) biased_exponent << 52 ) | mantissa;
 }
 
 u64
-_string_u64
-(   u64     value
-,   u8      radix
-,   char*   dst
+_string_f64_exact
+(   const char* digits
+,   const u64   digits_length
+,   i64         exponent
+,   const u64   bits
 )
 {
-    char* i = dst;
-    do
+    // Read at most STRING_PARSE_MAX_DIGITS significant digits, nine at a time.
+    bigint_t decimal;
+    bigint_set ( &decimal , 0 );
+    u64 count = 0;
+    u32 chunk = 0;
+    u32 chunk_length = 0;
+    bool sticky = false;
+    for ( u64 i = 0; i < digits_length; ++i )
     {
-        const u8 digit = value % radix;
-        value /= radix;
-        if ( digit < 10 )
+        if ( digits[ i ] == '.' )
+        {
+            continue;
+        }
+        if ( count == STRING_PARSE_MAX_DIGITS )
         {
-            *i = '0' + digit;
+            sticky |= digits[ i ] != '0';
+            exponent += 1;
+            continue;
         }
-        else
+        chunk = chunk * 10 + ( digits[ i ] - '0' );
+        chunk_length += 1;
+        count += 1;
+        if ( chunk_length == 9 )
         {
-            *i = 'A' + digit - 10;
+            bigint_multiply ( &decimal , string_pow10_u32[ 9 ] );
+            bigint_add_u32 ( &decimal , chunk );
+            chunk = 0;
+            chunk_length = 0;
         }
-        i += 1;
     }
-    while ( value );
-    return i - dst;
+    if ( chunk_length )
+    {
+        bigint_multiply ( &decimal , string_pow10_u32[ chunk_length ] );
+        bigint_add_u32 ( &decimal , chunk );
+    }
+    if ( sticky )
+    {
+        bigint_multiply ( &decimal , 10 );
+        bigint_add_u32 ( &decimal , 1 );
+        exponent -= 1;
+    }
+
+    // Halfway point: ( 2m + 1 ) * 2^( e - 1 ).
+    u64 mantissa;
+    i32 binary_exponent;
+    f64 candidate;
+    memory_copy ( &candidate , &bits , sizeof ( f64 ) );
+    _string_f64_decompose ( candidate , &mantissa , &binary_exponent );
+    bigint_t halfway;
+    bigint_set ( &halfway , 2 * mantissa + 1 );
+
+    // decimal * 10^exponent vs. halfway * 2^( e - 1 ): move the power of five
+    // to whichever side keeps it an integer, then the power of two.
+    if ( exponent >= 0 )
+    {
+        bigint_multiply_pow5 ( &decimal , exponent );
+    }
+    else
+    {
+        bigint_multiply_pow5 ( &halfway , -exponent );
+    }
+    const i64 shift = ( i64 ) binary_exponent - 1 - exponent;
+    if ( shift > 0 )
+    {
+        bigint_shift_left ( &halfway , shift );
+    }
+    else
+    {
+        bigint_shift_left ( &decimal , -shift );
+    }
+
+    const i32 comparison = bigint_compare ( &decimal , &halfway );
+    if ( comparison > 0 || ( !comparison && ( bits & 1 ) ) )
+    {
+        return bits + 1;
+    }
+    return bits;
+}
+
+fp_t
+fp_multiply
+(   const fp_t  a
+,   const fp_t  b
+)
+{
+    const u64 a_high = a.f >> 32;
+    const u64 a_low = a.f & 0xFFFFFFFF;
+    const u64 b_high = b.f >> 32;
+    const u64 b_low = b.f & 0xFFFFFFFF;
+    const u64 high_high = a_high * b_high;
+    const u64 low_high = a_low * b_high;
+    const u64 high_low = a_high * b_low;
+    const u64 low_low = a_low * b_low;
+    u64 middle = ( low_low >> 32 ) + ( high_low & 0xFFFFFFFF ) + ( low_high & 0xFFFFFFFF );
+    middle += ( u64 ) 1 << 31; // Round to nearest.
+    return ( fp_t ){ high_high + ( high_low >> 32 ) + ( low_high >> 32 ) + ( middle >> 32 )
+                   , a.e + b.e + 64
+                   };
+}
+
+fp_t
+fp_normalize
+(   const fp_t x
+)
+{
+    const u8 shift = 63 - bitscan_reverse ( x.f );
+    return ( fp_t ){ x.f << shift , x.e - shift };
+}
+
+void
+bigint_set
+(   bigint_t*   bigint
+,   u64         value
+)
+{
+    ( *bigint ).length = 0;
+    while ( value )
+    {
+        ( *bigint ).limbs[ ( *bigint ).length ] = ( u32 ) value;
+        ( *bigint ).length += 1;
+        value >>= 32;
+    }
+}
+
+void
+bigint_shift_left
+(   bigint_t*   bigint
+,   const u32   shift
+)
+{
+    if ( !( *bigint ).length )
+    {
+        return;
+    }
+
+    const u32 words = shift / 32;
+    const u32 bits = shift % 32;
+    u32* limbs = ( *bigint ).limbs;
+    if ( !bits )
+    {
+        memory_move ( limbs + words , limbs , ( *bigint ).length * sizeof ( u32 ) );
+        memory_clear ( limbs , words * sizeof ( u32 ) );
+        ( *bigint ).length += words;
+        return;
+    }
+
+    // Descending, so every source limb is read before it is overwritten.
+    const u32 length = ( *bigint ).length;
+    limbs[ length + words ] = limbs[ length - 1 ] >> ( 32 - bits );
+    for ( u32 i = length - 1; i; --i )
+    {
+        limbs[ i + words ] = ( limbs[ i ] << bits ) | ( limbs[ i - 1 ] >> ( 32 - bits ) );
+    }
+    limbs[ words ] = limbs[ 0 ] << bits;
+    memory_clear ( limbs , words * sizeof ( u32 ) );
+    ( *bigint ).length = length + words + ( limbs[ length + words ] != 0 );
+}
+
+void
+bigint_multiply
+(   bigint_t*   bigint
+,   const u32   factor
+)
+{
+    u64 carry = 0;
+    for ( u32 i = 0; i < ( *bigint ).length; ++i )
+    {
+        const u64 product = ( u64 )( *bigint ).limbs[ i ] * factor + carry;
+        ( *bigint ).limbs[ i ] = ( u32 ) product;
+        carry = product >> 32;
+    }
+    if ( carry )
+    {
+        ( *bigint ).limbs[ ( *bigint ).length ] = ( u32 ) carry;
+        ( *bigint ).length += 1;
+    }
+}
+
+void
+bigint_multiply_pow10
+(   bigint_t*   bigint
+,   u32         power
+)
+{
+    while ( power >= 9 )
+    {
+        bigint_multiply ( bigint , string_pow10_u32[ 9 ] );
+        power -= 9;
+    }
+    if ( power )
+    {
+        bigint_multiply ( bigint , string_pow10_u32[ power ] );
+    }
+}
+
+void
+bigint_add
+(   bigint_t*       dst
+,   const bigint_t* a
+,   const bigint_t* b
+)
+{
+    if ( ( *a ).length < ( *b ).length )
+    {
+        const bigint_t* swap = a;
+        a = b;
+        b = swap;
+    }
+
+    u64 carry = 0;
+    for ( u32 i = 0; i < ( *a ).length; ++i )
+    {
+        const u64 sum = ( u64 )( *a ).limbs[ i ]
+                      + ( ( i < ( *b ).length ) ? ( *b ).limbs[ i ] : 0 )
+                      + carry
+                      ;
+        ( *dst ).limbs[ i ] = ( u32 ) sum;
+        carry = sum >> 32;
+    }
+    ( *dst ).length = ( *a ).length;
+    if ( carry )
+    {
+        ( *dst ).limbs[ ( *dst ).length ] = ( u32 ) carry;
+        ( *dst ).length += 1;
+    }
+}
+
+void
+bigint_subtract
+(   bigint_t*       bigint
+,   const bigint_t* subtrahend
+)
+{
+    u64 borrow = 0;
+    for ( u32 i = 0; i < ( *bigint ).length; ++i )
+    {
+        const u64 difference = ( u64 )( *bigint ).limbs[ i ]
+                             - ( ( i < ( *subtrahend ).length ) ? ( *subtrahend ).limbs[ i ] : 0 )
+                             - borrow
+                             ;
+        ( *bigint ).limbs[ i ] = ( u32 ) difference;
+        borrow = difference >> 63;
+    }
+    while ( ( *bigint ).length && !( *bigint ).limbs[ ( *bigint ).length - 1 ] )
+    {
+        ( *bigint ).length -= 1;
+    }
+}
+
+i32
+bigint_compare
+(   const bigint_t* a
+,   const bigint_t* b
+)
+{
+    if ( ( *a ).length != ( *b ).length )
+    {
+        return ( ( *a ).length < ( *b ).length ) ? -1 : 1;
+    }
+    for ( u32 i = ( *a ).length; i; --i )
+    {
+        if ( ( *a ).limbs[ i - 1 ] != ( *b ).limbs[ i - 1 ] )
+        {
+            return ( ( *a ).limbs[ i - 1 ] < ( *b ).limbs[ i - 1 ] ) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+u8
+bigint_divide_digit
+(   bigint_t*       bigint
+,   const bigint_t* divisor
+)
+{
+    // The quotient is a single decimal digit, so repeated subtraction is
+    // cheaper than long division.
+    u8 quotient = 0;
+    while ( bigint_compare ( bigint , divisor ) >= 0 )
+    {
+        bigint_subtract ( bigint , divisor );
+        quotient += 1;
+    }
+    return quotient;
+}
+
+void
+bigint_add_u32
+(   bigint_t*   bigint
+,   const u32   value
+)
+{
+    u64 carry = value;
+    for ( u32 i = 0; carry && i < ( *bigint ).length; ++i )
+    {
+        const u64 sum = ( u64 )( *bigint ).limbs[ i ] + carry;
+        ( *bigint ).limbs[ i ] = ( u32 ) sum;
+        carry = sum >> 32;
+    }
+    if ( carry )
+    {
+        ( *bigint ).limbs[ ( *bigint ).length ] = ( u32 ) carry;
+        ( *bigint ).length += 1;
+    }
+}
+
+void
+bigint_multiply_pow5
+(   bigint_t*   bigint
+,   u32         power
+)
+{
+    // 5^13 is the largest power of five which fits in 32 bits.
+    while ( power >= 13 )
+    {
+        bigint_multiply ( bigint , 1220703125 );
+        power -= 13;
+    }
+    u32 factor = 1;
+    while ( power )
+    {
+        factor *= 5;
+        power -= 1;
+    }
+    bigint_multiply ( bigint , factor );
 }
\ No newline at end of file
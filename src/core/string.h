@@ -19,9 +19,68 @@
 #define STRING_INTEGER_MAX_RADIX  36 /** @brief Maximum radix for string_i64 and string_u64 (see string_i64 and string_u64). */
 
 // (see string_f64).
-#define STRING_FLOAT_MAX_LENGTH    1080 /** @brief Maximum stringified floating point number length. */
+#define STRING_FLOAT_MAX_LENGTH    327  /** @brief Maximum stringified floating point number length. */
 #define STRING_FLOAT_MAX_PRECISION 10   /** @brief Maximum precision for string_f64 (see string_f64). */
 
+/**
+ * @brief Type definition for a string view.
+ * 
+ * A view refers to a range of characters owned by something else (a literal,
+ * a resizable string, a file buffer, etc.); it is neither null-terminated nor
+ * freed. Views are passed by value, and taking a substring of one does not
+ * copy any characters (see string_view_slice).
+ */
+typedef struct
+{
+    const char* string;
+    u64         length;
+}
+string_view_t;
+
+/**
+ * @brief Creates a string view.
+ * 
+ * Use string_view to explicitly specify string length, or _string_view to
+ * compute the length of a null-terminated string. For a resizable string,
+ * use string_view_of instead (see container/string.h).
+ * 
+ * @param string The first character in the view. Must be non-zero.
+ * @param length The number of characters in the view.
+ * @return A view of length characters starting at string.
+ */
+#define string_view(string,length) \
+    ( ( string_view_t ){ (string) , (length) } )
+
+#define _string_view(string)                                  \
+    ({                                                        \
+        const char* string__ = (string);                      \
+        string_view ( string__ , _string_length ( string__ ) ); \
+    })
+
+/**
+ * @brief Takes a substring of a string view. O(1).
+ * 
+ * Does not copy any characters. The range is clamped to the bounds of view.
+ * 
+ * @param view A string view.
+ * @param index The index in view of the first character of the substring.
+ * @param count The maximum number of characters in the substring.
+ * @return A view of the substring.
+ */
+#define string_view_slice(view,index,count)                               \
+    ({                                                                    \
+        const string_view_t view__ = (view);                              \
+        const u64 index__ = (index);                                      \
+        const u64 count__ = (count);                                      \
+        const u64 start__ = ( index__ < view__.length ) ? index__         \
+                                                        : view__.length   \
+                                                        ;                 \
+        const u64 left__ = view__.length - start__;                       \
+        string_view ( view__.string + start__                             \
+                    , ( count__ < left__ ) ? count__ : left__             \
+                    );                                                    \
+    })
+
 
 /**
  * @brief Computes the number of characters in a null-terminated string. O(n).
@@ -74,7 +133,7 @@ string_equal
 ,   const u64   s2_length
 );
 
-#define _string_equal (s1,s2)                         \
+#define _string_equal(s1,s2)                          \
     ({                                                \
         const char* s1__ = (s1);                      \
         const char* s2__ = (s2);                      \
@@ -82,7 +141,17 @@ string_equal
                      , s2__ , _string_length ( s2__ ) \
                      );                               \
     })
-    
+
+/** @brief Alias for calling string_equal on two string views. */
+#define string_view_equal(v1,v2)                                \
+    ({                                                          \
+        const string_view_t v1__ = (v1);                        \
+        const string_view_t v2__ = (v2);                        \
+        string_equal ( v1__.string , v1__.length                \
+                     , v2__.string , v2__.length                \
+                     );                                         \
+    })
+
 
 /**
  * @brief Empty string test predicate.
@@ -98,6 +167,13 @@ string_empty
 /**
  * @brief Searches a string for a substring.
  * 
+ * Candidate positions are found a vector at a time, by comparing the first
+ * and last characters of find against the string (SSE2, AVX2 or NEON, as
+ * enabled at compile time; otherwise, eight characters per 64-bit word). A
+ * forward search for a long substring falls back to the Two-Way algorithm if
+ * too many candidates turn out to be false, so the search is O(n) in the
+ * worst case.
+ * 
  * Use string_contains to explicitly specify string length, or _string_contains
  * to compute the lengths of null-terminated strings before passing them to
  * string_contains.
@@ -134,6 +210,57 @@ string_contains
                         );                                       \
     })
 
+/** @brief Alias for calling string_contains on two string views. */
+#define string_view_contains(search,find,reverse,index)          \
+    ({                                                           \
+        const string_view_t search__ = (search);                 \
+        const string_view_t find__ = (find);                     \
+        string_contains ( search__.string , search__.length      \
+                        , find__.string , find__.length          \
+                        , (reverse)                              \
+                        , (index)                                \
+                        );                                       \
+    })
+
+/**
+ * @brief Finds every non-overlapping occurrence of a substring, from left to
+ * right. O(n).
+ * 
+ * Use string_find_all to explicitly specify string length, or
+ * _string_find_all to compute the lengths of null-terminated strings before
+ * passing them to string_find_all.
+ * 
+ * @param search The string to search. Must be non-zero.
+ * @param search_length The number of characters in search.
+ * @param find The string to find. Must be non-zero.
+ * @param find_length The number of characters in find.
+ * @param indices Output buffer for the index in search of each occurrence.
+ * Pass 0 to only count them.
+ * @param capacity The maximum number of indices to write.
+ * @return The number of occurrences of find in search (which may exceed
+ * capacity), or 0 if find_length is zero.
+ */
+u64
+string_find_all
+(   const char* search
+,   const u64   search_length
+,   const char* find
+,   const u64   find_length
+,   u64*        indices
+,   const u64   capacity
+);
+
+#define _string_find_all(search,find,indices,capacity)           \
+    ({                                                           \
+        const char* search__ = (search);                         \
+        const char* find__ = (find);                             \
+        string_find_all ( search__ , _string_length ( search__ ) \
+                        , find__ , _string_length ( find__ )     \
+                        , (indices)                              \
+                        , (capacity)                             \
+                        );                                       \
+    })
+
 /**
  * @brief Reverses a string. O(n). In-place.
  * 
@@ -157,6 +284,129 @@ string_reverse
         string_reverse ( string__ , _string_length ( string__ ) ); \
     })
 
+/**
+ * @brief Converts every uppercase Latin letter of a string to lowercase (see
+ * to_lowercase in common/ascii.h). Other characters, including non-ASCII
+ * bytes, are unchanged. O(n). In-place.
+ * 
+ * Processes one vector of characters at a time.
+ * 
+ * @param string The string to convert. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of characters in string.
+ * @return The string after conversion.
+ */
+char*
+string_to_lowercase
+(   char*       string
+,   const u64   string_length
+);
+
+/**
+ * @brief Converts every lowercase Latin letter of a string to uppercase (see
+ * to_uppercase in common/ascii.h). Other characters, including non-ASCII
+ * bytes, are unchanged. O(n). In-place.
+ * 
+ * Processes one vector of characters at a time.
+ * 
+ * @param string The string to convert. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of characters in string.
+ * @return The string after conversion.
+ */
+char*
+string_to_uppercase
+(   char*       string
+,   const u64   string_length
+);
+
+/**
+ * @brief Counts the whitespace characters (see whitespace in common/ascii.h)
+ * at the start of a string. O(n).
+ * 
+ * @param string The string to read. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of characters in string.
+ * @return The index of the first non-whitespace character of string, or
+ * string_length if there is none.
+ */
+u64
+string_leading_whitespace
+(   const char* string
+,   const u64   string_length
+);
+
+/**
+ * @brief Counts the whitespace characters (see whitespace in common/ascii.h)
+ * at the end of a string. O(n).
+ * 
+ * @param string The string to read. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of characters in string.
+ * @return The number of characters after the last non-whitespace character of
+ * string, or string_length if there is none.
+ */
+u64
+string_trailing_whitespace
+(   const char* string
+,   const u64   string_length
+);
+
+/**
+ * @brief ASCII validation predicate. O(n).
+ * 
+ * @param string The string to validate. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of characters in string.
+ * @return true if every character of string is in the range [0..127]; false
+ * otherwise.
+ */
+bool
+string_ascii
+(   const char* string
+,   const u64   string_length
+);
+
+/**
+ * @brief UTF-8 validation predicate. O(n).
+ * 
+ * Runs of ASCII are validated one vector at a time; only multi-byte sequences
+ * are decoded individually. Rejects overlong encodings, surrogates (U+D800 to
+ * U+DFFF), code points beyond U+10FFFF, and truncated sequences.
+ * 
+ * @param string The string to validate. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of bytes in string.
+ * @return true if string is well-formed UTF-8; false otherwise.
+ */
+bool
+string_utf8
+(   const char* string
+,   const u64   string_length
+);
+
+/**
+ * @brief Copies a string, omitting every ANSI SGR escape sequence (ESC '['
+ * followed by any digits and semicolons, then 'm'). O(n).
+ * 
+ * Skips from one ESC character to the next a vector at a time, so text without
+ * escape sequences costs little more than a copy.
+ * 
+ * @param dst Output buffer for the stripped string (not null-terminated).
+ * Must be non-zero if length is non-zero, and must have access to at least
+ * length characters. May equal src, for an in-place strip; must not otherwise
+ * overlap it.
+ * @param src The string to strip. Must be non-zero if length is non-zero.
+ * @param length The number of characters in src.
+ * @return The number of characters written to dst.
+ */
+u64
+string_strip_ansi_to
+(   char*       dst
+,   const char* src
+,   const u64   length
+);
+
 /**
  * @brief Signed integer stringify utility.
  * 
@@ -196,19 +446,22 @@ string_u64
 );
 
 /**
- * @brief ** NOT YET IMPLEMENTED** Floating point stringify utility.
+ * @brief Floating point stringify utility.
  * 
- * TODO: Implement this.
+ * Prints a fixed number of fractional digits (or, in abbreviated notation, of
+ * significant digits after the first), exactly rounded to nearest with ties
+ * to even on the exact binary value. The output matches printf's %.<n>f and
+ * %.<n>E conversions, including the spelling of infinity and NaN.
  * 
  * @param value A 64-bit floating point number.
- * @param precision Floating point precision.
+ * @param precision Floating point precision in the range [0..10] (inclusive).
  * @param abbreviated Use abbreviated (scientific) notation? Y/N
  * @param dst Output buffer for string. Must be non-zero. Should have access to
  * an adequate number of characters given the supplied value, abbreviation, and
- * precision. The maximum amount written to dst is 1080† bytes, so dst should
- * have access to a minimum of 1080† bytes to guarantee it will never overflow
- * for any valid value and radix combination. †Confirmation needed on this
- * number (see https://stackoverflow.com/a/1701272/5294916).
+ * precision. The maximum amount written to dst is 321 bytes (a sign, the 309
+ * integer digits of the largest f64, the point and 10 fractional digits), so
+ * dst should have access to a minimum of 321 bytes to guarantee it will never
+ * overflow for any valid value and precision combination.
  * @return The number of characters written to dst.
  */
 u64
@@ -219,6 +472,261 @@ string_f64
 ,   char*   dst
 );
 
+/**
+ * @brief Variant of string_f64 which prints the fewest significant digits
+ * needed to identify the value uniquely (at most 17), so that parsing the
+ * output yields exactly the same floating point number.
+ * 
+ * The output has no trailing fractional zeros, and no point if the value is
+ * an integer.
+ * 
+ * @param value A 64-bit floating point number.
+ * @param abbreviated Use abbreviated (scientific) notation? Y/N
+ * @param dst Output buffer for string. Must be non-zero. The maximum amount
+ * written to dst is 327 bytes (for subnormal numbers: a sign, "0." and up to
+ * 324 fractional digits), so dst should have access to a minimum of 327
+ * bytes to guarantee it will never overflow.
+ * @return The number of characters written to dst.
+ */
+u64
+string_f64_shortest
+(   f64     value
+,   bool    abbreviated
+,   char*   dst
+);
+
+/** @brief Type definition for the result of a string-to-number conversion. */
+typedef enum
+{
+    STRING_PARSE_SUCCESS            // The number was parsed.
+,   STRING_PARSE_ERROR_EMPTY        // No digits were found.
+,   STRING_PARSE_ERROR_INVALID      // Illegal character or radix.
+,   STRING_PARSE_ERROR_OUT_OF_RANGE // The number does not fit the type.
+}
+STRING_PARSE_RESULT;
+
+/**
+ * @brief Signed integer parse utility (inverse of string_i64).
+ * 
+ * Accepts an optional sign ('+' or '-') followed by digits in the given radix.
+ * Letters are case-insensitive. Whitespace is not skipped. Decimal digits are
+ * consumed eight at a time where possible.
+ * 
+ * As string_i64 writes negative values in radices other than 10 as their
+ * two's complement bit pattern, unsigned digits up to the maximum u64 are
+ * accepted (and reinterpreted) in those radices.
+ * 
+ * Use string_to_i64 to explicitly specify string length, or _string_to_i64
+ * to compute the length of a null-terminated string before passing it to
+ * string_to_i64.
+ * 
+ * @param string The string to parse. Must be non-zero.
+ * @param string_length The number of characters in string.
+ * @param radix Integer radix in the range [2..36] (inclusive).
+ * @param value Output buffer for the parsed value. Must be non-zero. On
+ * STRING_PARSE_ERROR_OUT_OF_RANGE, holds the nearest representable value.
+ * Untouched on any other error.
+ * @param read Output buffer for the number of characters parsed. If non-zero,
+ * parsing stops at the first character which cannot continue the number;
+ * if zero, the number must span the whole string.
+ * @return STRING_PARSE_SUCCESS on success; an error code otherwise.
+ */
+STRING_PARSE_RESULT
+string_to_i64
+(   const char* string
+,   const u64   string_length
+,   const u8    radix
+,   i64*        value
+,   u64*        read
+);
+
+#define _string_to_i64(string,radix,value,read)                         \
+    ({                                                                  \
+        const char* string__ = (string);                                \
+        string_to_i64 ( string__ , _string_length ( string__ )          \
+                      , (radix) , (value) , (read)                      \
+                      );                                                \
+    })
+
+/**
+ * @brief Unsigned integer parse utility (inverse of string_u64).
+ * 
+ * Identical to string_to_i64, except that a leading '-' is illegal.
+ * 
+ * @param string The string to parse. Must be non-zero.
+ * @param string_length The number of characters in string.
+ * @param radix Integer radix in the range [2..36] (inclusive).
+ * @param value Output buffer for the parsed value (see string_to_i64).
+ * @param read Output buffer for the number of characters parsed (see
+ * string_to_i64).
+ * @return STRING_PARSE_SUCCESS on success; an error code otherwise.
+ */
+STRING_PARSE_RESULT
+string_to_u64
+(   const char* string
+,   const u64   string_length
+,   const u8    radix
+,   u64*        value
+,   u64*        read
+);
+
+#define _string_to_u64(string,radix,value,read)                         \
+    ({                                                                  \
+        const char* string__ = (string);                                \
+        string_to_u64 ( string__ , _string_length ( string__ )          \
+                      , (radix) , (value) , (read)                      \
+                      );                                                \
+    })
+
+/**
+ * @brief Floating point parse utility (inverse of string_f64 and
+ * string_f64_shortest).
+ * 
+ * Accepts an optional sign, decimal digits with an optional point, and an
+ * optional exponent ('e' or 'E', an optional sign, and decimal digits); or
+ * "inf", "infinity" or "nan" in any case. The result is exactly rounded to
+ * nearest with ties to even, as strtod does.
+ * 
+ * Most inputs are converted by the Eisel-Lemire algorithm with 128-bit
+ * powers of five. Inputs with more than 19 significant digits which it cannot
+ * settle fall back to exact arbitrary-precision comparison.
+ * 
+ * Use string_to_f64 to explicitly specify string length, or _string_to_f64
+ * to compute the length of a null-terminated string before passing it to
+ * string_to_f64.
+ * 
+ * @param string The string to parse. Must be non-zero.
+ * @param string_length The number of characters in string.
+ * @param value Output buffer for the parsed value. Must be non-zero. On
+ * STRING_PARSE_ERROR_OUT_OF_RANGE, holds a signed infinity. Values too small
+ * to represent round to (signed) zero without error.
+ * @param read Output buffer for the number of characters parsed (see
+ * string_to_i64).
+ * @return STRING_PARSE_SUCCESS on success; an error code otherwise.
+ */
+STRING_PARSE_RESULT
+string_to_f64
+(   const char* string
+,   const u64   string_length
+,   f64*        value
+,   u64*        read
+);
+
+#define _string_to_f64(string,value,read)                               \
+    ({                                                                  \
+        const char* string__ = (string);                                \
+        string_to_f64 ( string__ , _string_length ( string__ )          \
+                      , (value) , (read)                                \
+                      );                                                \
+    })
+
+/** @brief Computes the number of characters string_hex_encode writes for size bytes. */
+#define STRING_HEX_LENGTH(size) \
+    ( 2 * (size) )
+
+/** @brief Computes the number of characters string_base64_encode writes for size bytes. */
+#define STRING_BASE64_LENGTH(size) \
+    ( 4 * ( ( (size) + 2 ) / 3 ) )
+
+/**
+ * @brief Computes the maximum number of bytes string_base64_decode writes for
+ * a string of length characters.
+ */
+#define STRING_BASE64_MAX_SIZE(length) \
+    ( 3 * ( ( (length) + 3 ) / 4 ) )
+
+/**
+ * @brief Hexadecimal encode utility.
+ * 
+ * Writes two digits per byte, most significant first. Encodes a vector of
+ * bytes at a time where possible.
+ * 
+ * @param src The bytes to encode. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to encode.
+ * @param uppercase Use uppercase letters? Y/N
+ * @param dst Output buffer for string (not null-terminated). Must have access
+ * to at least STRING_HEX_LENGTH ( size ) characters.
+ * @return The number of characters written to dst.
+ */
+u64
+string_hex_encode
+(   const void* src
+,   const u64   size
+,   const bool  uppercase
+,   char*       dst
+);
+
+/**
+ * @brief Hexadecimal decode utility (inverse of string_hex_encode).
+ * 
+ * Letters are case-insensitive. Whitespace and prefixes (e.g. "0x") are not
+ * accepted.
+ * 
+ * @param string The string to decode. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of characters in string. Must be even.
+ * @param dst Output buffer for the bytes. Must have access to at least
+ * string_length / 2 bytes. May equal string, for an in-place decode; must not
+ * otherwise overlap it.
+ * @param size Output buffer for the number of bytes written to dst. Must be
+ * non-zero. Untouched on error.
+ * @return STRING_PARSE_SUCCESS on success; STRING_PARSE_ERROR_INVALID if
+ * string_length is odd or string contains an illegal character, in which case
+ * the contents of dst are unspecified.
+ */
+STRING_PARSE_RESULT
+string_hex_decode
+(   const char* string
+,   const u64   string_length
+,   void*       dst
+,   u64*        size
+);
+
+/**
+ * @brief Base64 encode utility (standard alphabet, RFC 4648).
+ * 
+ * Pads the output to a multiple of four characters with '='. Encodes a vector
+ * of bytes at a time where possible.
+ * 
+ * @param src The bytes to encode. Must be non-zero if size is non-zero.
+ * @param size The number of bytes to encode.
+ * @param dst Output buffer for string (not null-terminated). Must have access
+ * to at least STRING_BASE64_LENGTH ( size ) characters.
+ * @return The number of characters written to dst.
+ */
+u64
+string_base64_encode
+(   const void* src
+,   const u64   size
+,   char*       dst
+);
+
+/**
+ * @brief Base64 decode utility (inverse of string_base64_encode).
+ * 
+ * Accepts padded or unpadded input. Whitespace and the URL-safe alphabet are
+ * not accepted.
+ * 
+ * @param string The string to decode. Must be non-zero if string_length is
+ * non-zero.
+ * @param string_length The number of characters in string.
+ * @param dst Output buffer for the bytes. Must have access to at least
+ * STRING_BASE64_MAX_SIZE ( string_length ) bytes. May equal string, for an
+ * in-place decode; must not otherwise overlap it.
+ * @param size Output buffer for the number of bytes written to dst. Must be
+ * non-zero. Untouched on error.
+ * @return STRING_PARSE_SUCCESS on success; STRING_PARSE_ERROR_INVALID if
+ * string is not well-formed base64, in which case the contents of dst are
+ * unspecified.
+ */
+STRING_PARSE_RESULT
+string_base64_decode
+(   const char* string
+,   const u64   string_length
+,   void*       dst
+,   u64*        size
+);
+
 /**
  * @brief Character stringify utility.
  * 
@@ -258,6 +766,21 @@ string_allocate
 (   u64 size
 );
 
+/**
+ * @brief Allocates memory for a string of the provided size, without clearing
+ * it (see memory_allocate_uninit): the caller must write its content,
+ * including the terminator.
+ * 
+ * Uses dynamic memory allocation. Call string_free to free.
+ * 
+ * @param size The number of bytes of memory to allocate.
+ * @return A string of the provided size, with unspecified content.
+ */
+char*
+string_allocate_uninit
+(   u64 size
+);
+
 /**
  * @brief Generates a copy of a null-terminated string.
  * 
@@ -0,0 +1,540 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/timer.c
+ * @brief Implementation of the core/timer header.
+ * (see core/timer.h for additional details)
+ */
+#include "core/timer.h"
+
+#include "container/array.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+/** @brief Sentinel node index: the end of a list, or no node at all. */
+#define TIMER_WHEEL_NONE 0xFFFFFFFF
+
+/** @brief Total number of slots of a timer wheel. */
+#define TIMER_WHEEL_TOTAL_SLOT_COUNT \
+    ( TIMER_WHEEL_LEVEL_COUNT * TIMER_WHEEL_SLOT_COUNT )
+
+/** @brief Value of the slot field of a node which is not in any slot. */
+#define TIMER_WHEEL_SLOT_FREE 0xFFFF
+
+// Each level keeps one bit per slot in a u64 (see state_t).
+STATIC_ASSERT ( TIMER_WHEEL_SLOT_COUNT == 64
+              , "timer_wheel: Each level must have exactly 64 slots."
+              );
+
+/** @brief Type definition for a timer. */
+typedef struct
+{
+    // Deadline, in ticks.
+    u64     deadline;
+
+    job_t   job;
+
+    // Neighbours in the slot list if pending; next free node otherwise.
+    u32     next;
+    u32     prev;
+
+    // Incremented each time the node is freed, to invalidate old handles.
+    u32     generation;
+
+    // Index of the slot holding the node, or TIMER_WHEEL_SLOT_FREE.
+    u16     slot;
+}
+node_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64         resolution;
+
+    // The next tick to process.
+    u64         current;
+
+    u64         length;
+
+    // Node storage, and the head of the free list.
+    array_t*    nodes;
+    u32         free;
+
+    // Scratch buffer for the jobs of expired timers.
+    array_t*    expired;
+
+    // Head of each slot list, indexed by level * TIMER_WHEEL_SLOT_COUNT + slot.
+    u32         slots[ TIMER_WHEEL_TOTAL_SLOT_COUNT ];
+
+    // For each level, a bitmask of the slots which are not empty.
+    u64         occupied[ TIMER_WHEEL_LEVEL_COUNT ];
+}
+state_t;
+
+/**
+ * @brief Retrieves a node.
+ *
+ * @param state Internal state arguments.
+ * @param index The node index.
+ * @return The node at index.
+ */
+node_t*
+timer_wheel_node
+(   const state_t*  state
+,   const u32       index
+);
+
+/**
+ * @brief Validates a timer handle.
+ *
+ * @param state Internal state arguments.
+ * @param timer The timer handle.
+ * @return The index of the pending node with handle timer, or
+ * TIMER_WHEEL_NONE.
+ */
+u32
+timer_wheel_find
+(   const state_t*  state
+,   const u64       timer
+);
+
+/**
+ * @brief Inserts a node into the slot for its deadline, relative to the
+ * current tick.
+ *
+ * @param state Internal state arguments.
+ * @param index The node index.
+ */
+void
+timer_wheel_insert
+(   state_t*    state
+,   const u32   index
+);
+
+/**
+ * @brief Removes a node from its slot.
+ *
+ * @param state Internal state arguments.
+ * @param index The node index.
+ */
+void
+timer_wheel_unlink
+(   state_t*    state
+,   const u32   index
+);
+
+/**
+ * @brief Returns a node to the free list, invalidating its handle.
+ *
+ * @param state Internal state arguments.
+ * @param index The node index.
+ */
+void
+timer_wheel_release
+(   state_t*    state
+,   const u32   index
+);
+
+/**
+ * @brief Finds the next tick with work to do: one on which a non-empty slot is
+ * cascaded or expires. O(TIMER_WHEEL_LEVEL_COUNT).
+ *
+ * Every tick before it may be skipped, so that advancing over a long interval
+ * costs time in the number of timers rather than the number of ticks.
+ *
+ * @param state Internal state arguments.
+ * @return The next tick with work to do (not before the current tick), or
+ * U64 max if no timers are pending.
+ */
+u64
+timer_wheel_next_tick
+(   const state_t* state
+);
+
+/**
+ * @brief Processes the current tick: cascades the levels which complete a
+ * rotation, and collects the jobs of the timers which expire.
+ *
+ * @param state Internal state arguments.
+ */
+void
+timer_wheel_tick
+(   state_t* state
+);
+
+bool
+timer_wheel_create
+(   u64             resolution
+,   u64             time
+,   timer_wheel_t** wheel
+)
+{
+    if ( !resolution )
+    {
+        LOGERROR ( "timer_wheel_create: Value of resolution argument must be non-zero." );
+        return false;
+    }
+    if ( !wheel )
+    {
+        LOGERROR ( "timer_wheel_create: Missing argument: wheel (output buffer)." );
+        return false;
+    }
+
+    state_t* state = memory_allocate ( sizeof ( state_t ) , MEMORY_TAG_JOB );
+    ( *state ).resolution = resolution;
+    ( *state ).current = time / resolution;
+    ( *state ).length = 0;
+    ( *state ).nodes = array_create_new ( node_t );
+    ( *state ).free = TIMER_WHEEL_NONE;
+    ( *state ).expired = array_create_new ( job_t );
+    for ( u32 i = 0; i < TIMER_WHEEL_TOTAL_SLOT_COUNT; ++i )
+    {
+        ( *state ).slots[ i ] = TIMER_WHEEL_NONE;
+    }
+    for ( u32 i = 0; i < TIMER_WHEEL_LEVEL_COUNT; ++i )
+    {
+        ( *state ).occupied[ i ] = 0;
+    }
+
+    *wheel = state;
+    return true;
+}
+
+void
+timer_wheel_destroy
+(   timer_wheel_t** wheel
+)
+{
+    if ( !wheel || !*wheel )
+    {
+        return;
+    }
+
+    state_t* state = *wheel;
+    array_destroy ( ( *state ).nodes );
+    array_destroy ( ( *state ).expired );
+    memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_JOB );
+
+    *wheel = 0;
+}
+
+u64
+timer_wheel_length
+(   const timer_wheel_t* wheel
+)
+{
+    return ( *( ( state_t* ) wheel ) ).length;
+}
+
+u64
+timer_wheel_resolution
+(   const timer_wheel_t* wheel
+)
+{
+    return ( *( ( state_t* ) wheel ) ).resolution;
+}
+
+u64
+timer_wheel_schedule
+(   timer_wheel_t*  wheel
+,   u64             deadline
+,   job_t           job
+)
+{
+    state_t* state = wheel;
+    if ( !job.function )
+    {
+        LOGERROR ( "timer_wheel_schedule: Missing argument: job.function." );
+        return TIMER_INVALID;
+    }
+
+    // Reuse a node if any are free.
+    u32 index = ( *state ).free;
+    if ( index != TIMER_WHEEL_NONE )
+    {
+        ( *state ).free = ( *timer_wheel_node ( state , index ) ).next;
+    }
+    else
+    {
+        index = array_length ( ( *state ).nodes );
+        if ( index == TIMER_WHEEL_NONE )
+        {
+            LOGERROR ( "timer_wheel_schedule: Too many pending timers." );
+            return TIMER_INVALID;
+        }
+        node_t node = { 0 };
+        node.generation = 1;
+        array_push ( ( *state ).nodes , node );
+    }
+
+    node_t* node = timer_wheel_node ( state , index );
+    ( *node ).deadline = deadline / ( *state ).resolution
+                       + ( ( deadline % ( *state ).resolution ) ? 1 : 0 )
+                       ;
+    ( *node ).job = job;
+    timer_wheel_insert ( state , index );
+    ( *state ).length += 1;
+
+    return ( ( ( u64 )( *node ).generation ) << 32 ) | index;
+}
+
+bool
+timer_wheel_cancel
+(   timer_wheel_t*  wheel
+,   u64             timer
+)
+{
+    state_t* state = wheel;
+    const u32 index = timer_wheel_find ( state , timer );
+    if ( index == TIMER_WHEEL_NONE )
+    {
+        return false;
+    }
+    timer_wheel_unlink ( state , index );
+    timer_wheel_release ( state , index );
+    ( *state ).length -= 1;
+    return true;
+}
+
+bool
+timer_wheel_pending
+(   const timer_wheel_t*    wheel
+,   u64                     timer
+)
+{
+    return timer_wheel_find ( wheel , timer ) != TIMER_WHEEL_NONE;
+}
+
+u64
+timer_wheel_advance
+(   timer_wheel_t*  wheel
+,   u64             time
+,   job_counter_t*  counter
+)
+{
+    state_t* state = wheel;
+    const u64 target = time / ( *state ).resolution;
+    while ( ( *state ).current <= target )
+    {
+        // Skip the ticks with nothing to do.
+        const u64 next = timer_wheel_next_tick ( state );
+        if ( next > target )
+        {
+            ( *state ).current = target + 1;
+            break;
+        }
+        ( *state ).current = next;
+        timer_wheel_tick ( state );
+        ( *state ).current += 1;
+    }
+
+    const u64 count = array_length ( ( *state ).expired );
+    if ( !count )
+    {
+        return 0;
+    }
+
+    if ( counter )
+    {
+        job_submit ( ( *state ).expired , count , counter );
+    }
+    else
+    {
+        const job_t* jobs = ( *state ).expired;
+        for ( u64 i = 0; i < count; ++i )
+        {
+            jobs[ i ].function ( jobs[ i ].args );
+        }
+    }
+    _array_field_set ( ( *state ).expired , ARRAY_FIELD_LENGTH , 0 );
+    return count;
+}
+
+node_t*
+timer_wheel_node
+(   const state_t*  state
+,   const u32       index
+)
+{
+    return &( ( node_t* )( ( *state ).nodes ) )[ index ];
+}
+
+u32
+timer_wheel_find
+(   const state_t*  state
+,   const u64       timer
+)
+{
+    const u32 index = ( u32 ) timer;
+    if ( index >= array_length ( ( *state ).nodes ) )
+    {
+        return TIMER_WHEEL_NONE;
+    }
+    const node_t* node = timer_wheel_node ( state , index );
+    if ( ( *node ).slot == TIMER_WHEEL_SLOT_FREE
+         || ( *node ).generation != ( u32 )( timer >> 32 )
+       )
+    {
+        return TIMER_WHEEL_NONE;
+    }
+    return index;
+}
+
+void
+timer_wheel_insert
+(   state_t*    state
+,   const u32   index
+)
+{
+    node_t* node = timer_wheel_node ( state , index );
+    const u64 current = ( *state ).current;
+
+    // A deadline which has passed expires on the current tick.
+    u64 deadline = ( ( *node ).deadline > current ) ? ( *node ).deadline
+                                                    : current
+                                                    ;
+
+    // Find the lowest level which spans the deadline. A deadline beyond the
+    // top level is held at its furthest slot, and cascaded until in range.
+    u64 level = 0;
+    while ( ( deadline - current ) >> ( ( level + 1 ) * TIMER_WHEEL_SLOT_BITS ) )
+    {
+        if ( level == TIMER_WHEEL_LEVEL_COUNT - 1 )
+        {
+            deadline = current + ( ( ( u64 ) 1 ) << ( TIMER_WHEEL_LEVEL_COUNT * TIMER_WHEEL_SLOT_BITS ) ) - 1;
+            break;
+        }
+        level += 1;
+    }
+
+    const u16 slot = level * TIMER_WHEEL_SLOT_COUNT
+                   + ( ( deadline >> ( level * TIMER_WHEEL_SLOT_BITS ) ) & ( TIMER_WHEEL_SLOT_COUNT - 1 ) )
+                   ;
+    const u32 head = ( *state ).slots[ slot ];
+    ( *state ).occupied[ level ] |= ( ( u64 ) 1 ) << ( slot % TIMER_WHEEL_SLOT_COUNT );
+    ( *node ).slot = slot;
+    ( *node ).prev = TIMER_WHEEL_NONE;
+    ( *node ).next = head;
+    if ( head != TIMER_WHEEL_NONE )
+    {
+        ( *timer_wheel_node ( state , head ) ).prev = index;
+    }
+    ( *state ).slots[ slot ] = index;
+}
+
+void
+timer_wheel_unlink
+(   state_t*    state
+,   const u32   index
+)
+{
+    node_t* node = timer_wheel_node ( state , index );
+    if ( ( *node ).prev != TIMER_WHEEL_NONE )
+    {
+        ( *timer_wheel_node ( state , ( *node ).prev ) ).next = ( *node ).next;
+    }
+    else
+    {
+        ( *state ).slots[ ( *node ).slot ] = ( *node ).next;
+        if ( ( *node ).next == TIMER_WHEEL_NONE )
+        {
+            ( *state ).occupied[ ( *node ).slot / TIMER_WHEEL_SLOT_COUNT ] &= ~( ( ( u64 ) 1 ) << ( ( *node ).slot % TIMER_WHEEL_SLOT_COUNT ) );
+        }
+    }
+    if ( ( *node ).next != TIMER_WHEEL_NONE )
+    {
+        ( *timer_wheel_node ( state , ( *node ).next ) ).prev = ( *node ).prev;
+    }
+}
+
+void
+timer_wheel_release
+(   state_t*    state
+,   const u32   index
+)
+{
+    node_t* node = timer_wheel_node ( state , index );
+    ( *node ).slot = TIMER_WHEEL_SLOT_FREE;
+    ( *node ).generation = ( ( *node ).generation + 1 ) ? ( *node ).generation + 1 : 1;
+    ( *node ).next = ( *state ).free;
+    ( *state ).free = index;
+}
+
+void
+timer_wheel_tick
+(   state_t* state
+)
+{
+    const u64 current = ( *state ).current;
+
+    // Cascade each level whose lower level completes a rotation on this tick,
+    // top-down, so that timers cascaded from a higher level are cascaded again
+    // if they land in a lower level's slot for this tick.
+    u64 level = 1;
+    while ( level < TIMER_WHEEL_LEVEL_COUNT
+            && !( current & ( ( ( u64 ) 1 << ( level * TIMER_WHEEL_SLOT_BITS ) ) - 1 ) )
+          )
+    {
+        level += 1;
+    }
+    while ( --level )
+    {
+        const u16 slot = level * TIMER_WHEEL_SLOT_COUNT
+                       + ( ( current >> ( level * TIMER_WHEEL_SLOT_BITS ) ) & ( TIMER_WHEEL_SLOT_COUNT - 1 ) )
+                       ;
+        u32 index = ( *state ).slots[ slot ];
+        ( *state ).slots[ slot ] = TIMER_WHEEL_NONE;
+        ( *state ).occupied[ level ] &= ~( ( ( u64 ) 1 ) << ( slot % TIMER_WHEEL_SLOT_COUNT ) );
+        while ( index != TIMER_WHEEL_NONE )
+        {
+            const u32 next = ( *timer_wheel_node ( state , index ) ).next;
+            timer_wheel_insert ( state , index );
+            index = next;
+        }
+    }
+
+    // Expire the timers of the level 0 slot for this tick.
+    u32 index = ( *state ).slots[ current & ( TIMER_WHEEL_SLOT_COUNT - 1 ) ];
+    ( *state ).slots[ current & ( TIMER_WHEEL_SLOT_COUNT - 1 ) ] = TIMER_WHEEL_NONE;
+    ( *state ).occupied[ 0 ] &= ~( ( ( u64 ) 1 ) << ( current & ( TIMER_WHEEL_SLOT_COUNT - 1 ) ) );
+    while ( index != TIMER_WHEEL_NONE )
+    {
+        node_t* node = timer_wheel_node ( state , index );
+        const u32 next = ( *node ).next;
+        array_push ( ( *state ).expired , ( *node ).job );
+        timer_wheel_release ( state , index );
+        ( *state ).length -= 1;
+        index = next;
+    }
+}
+
+u64
+timer_wheel_next_tick
+(   const state_t* state
+)
+{
+    const u64 current = ( *state ).current;
+    u64 next = ( u64 ) -1;
+    for ( u64 level = 0; level < TIMER_WHEEL_LEVEL_COUNT; ++level )
+    {
+        const u64 occupied = ( *state ).occupied[ level ];
+        if ( !occupied )
+        {
+            continue;
+        }
+
+        // Slot s of this level is processed on the ticks t for which
+        // t >> shift == s (mod TIMER_WHEEL_SLOT_COUNT) and t is a multiple of
+        // 1 << shift. Find the first occupied slot from the first such tick at
+        // or after the current one.
+        const u64 shift = level * TIMER_WHEEL_SLOT_BITS;
+        const u64 start = ( current + ( ( ( u64 ) 1 ) << shift ) - 1 ) >> shift;
+        const u64 distance = bitscan_forward ( rotr64 ( occupied , start & ( TIMER_WHEEL_SLOT_COUNT - 1 ) ) );
+        const u64 tick = ( start + distance ) << shift;
+        if ( tick < next )
+        {
+            next = tick;
+        }
+    }
+    return next;
+}
@@ -0,0 +1,181 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/timer.h
+ * @brief Provides an interface for a hierarchical timer wheel.
+ *
+ * A timer wheel schedules large numbers of deadlines (e.g. connection or job
+ * timeouts, most of which are cancelled before they expire) at O(1) cost per
+ * schedule and per cancel, compared to O(log n) for a heap.
+ *
+ *   timer_wheel_t* timers;
+ *   timer_wheel_create ( 1000000 , clock_time () , &timers );
+ *   const job_t timeout = { connection_timeout , connection };
+ *   const u64 timer = timer_wheel_schedule ( timers , clock_time () + 5000000000 , timeout );
+ *   ...
+ *   timer_wheel_cancel ( timers , timer );
+ *   ...
+ *   timer_wheel_advance ( timers , clock_time () , &counter );
+ *
+ * Time is divided into ticks of a fixed resolution. The wheel has
+ * TIMER_WHEEL_LEVEL_COUNT levels of TIMER_WHEEL_SLOT_COUNT slots each: level 0
+ * holds the timers due within the next TIMER_WHEEL_SLOT_COUNT ticks, one slot
+ * per tick, and each slot of level n spans a whole rotation of level n - 1.
+ * When a lower level completes a rotation, the timers of the next slot of the
+ * level above are redistributed (cascaded) into it. Timers further out than
+ * the top level spans are held in its slots and cascaded repeatedly until they
+ * come within range.
+ *
+ * Deadlines are integer nanoseconds on the monotonic clock (see clock_time in
+ * core/clock.h), rounded up to a whole tick; a timer never expires early, and
+ * expires at most one tick late, plus the interval between advances.
+ *
+ * Expired timers are jobs (see core/job.h): they are either executed by the
+ * thread which advances the wheel, or submitted to the job system.
+ *
+ * Not thread-safe; a wheel is typically owned by one thread, which advances it
+ * from its event loop.
+ */
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "common.h"
+
+#include "core/job.h"
+
+/** @brief Type declaration for a timer wheel. */
+typedef void timer_wheel_t;
+
+/** @brief Number of levels of a timer wheel. */
+#define TIMER_WHEEL_LEVEL_COUNT 6
+
+/** @brief Number of slots per level of a timer wheel (as a power of two). */
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOT_COUNT ( 1 << TIMER_WHEEL_SLOT_BITS )
+
+/** @brief Value of an invalid timer handle. */
+#define TIMER_INVALID 0
+
+/**
+ * @brief Initializes a timer wheel.
+ *
+ * Uses dynamic memory allocation. Call timer_wheel_destroy to free.
+ *
+ * @param resolution The length of a tick (in nanoseconds). Must be non-zero.
+ * @param time The current time (in nanoseconds; see clock_time).
+ * @param wheel Output buffer for the wheel. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+timer_wheel_create
+(   u64             resolution
+,   u64             time
+,   timer_wheel_t** wheel
+);
+
+/**
+ * @brief Frees the memory used by a timer wheel. Timers which have not expired
+ * are discarded.
+ *
+ * @param wheel Handle to the wheel to free.
+ */
+void
+timer_wheel_destroy
+(   timer_wheel_t** wheel
+);
+
+/**
+ * @brief Queries the number of pending timers in a timer wheel.
+ *
+ * @param wheel The wheel to query. Must be non-zero.
+ * @return The number of timers which have been scheduled, and have neither
+ * expired nor been cancelled.
+ */
+u64
+timer_wheel_length
+(   const timer_wheel_t* wheel
+);
+
+/**
+ * @brief Queries the tick length of a timer wheel.
+ *
+ * @param wheel The wheel to query. Must be non-zero.
+ * @return The resolution (in nanoseconds).
+ */
+u64
+timer_wheel_resolution
+(   const timer_wheel_t* wheel
+);
+
+/**
+ * @brief Schedules a timer. O(1), on average.
+ *
+ * @param wheel The wheel to schedule the timer on. Must be non-zero.
+ * @param deadline The time at which the timer expires (in nanoseconds; see
+ * clock_time). A deadline which has already passed expires on the next call
+ * to timer_wheel_advance which reaches a new tick.
+ * @param job The job to run when the timer expires. function must be
+ * non-zero.
+ * @return A handle to the timer (valid until it expires or is cancelled), or
+ * TIMER_INVALID on error.
+ */
+u64
+timer_wheel_schedule
+(   timer_wheel_t*  wheel
+,   u64             deadline
+,   job_t           job
+);
+
+/**
+ * @brief Cancels a pending timer. O(1).
+ *
+ * @param wheel The wheel the timer was scheduled on. Must be non-zero.
+ * @param timer The timer handle.
+ * @return true if the timer was pending; false if it already expired, was
+ * already cancelled, or the handle is invalid.
+ */
+bool
+timer_wheel_cancel
+(   timer_wheel_t*  wheel
+,   u64             timer
+);
+
+/**
+ * @brief Queries whether a timer is pending. O(1).
+ *
+ * @param wheel The wheel the timer was scheduled on. Must be non-zero.
+ * @param timer The timer handle.
+ * @return true if the timer has neither expired nor been cancelled; false
+ * otherwise.
+ */
+bool
+timer_wheel_pending
+(   const timer_wheel_t*    wheel
+,   u64                     timer
+);
+
+/**
+ * @brief Advances a timer wheel to the current time, and runs the job of
+ * every timer which expires.
+ *
+ * Every timer which expires is collected before any job runs, so a job run
+ * by this thread may schedule or cancel timers on the same wheel (but must
+ * not advance it).
+ * O(ticks elapsed + timers expired); skips straight to the current time if no
+ * timers are pending.
+ *
+ * @param wheel The wheel to advance. Must be non-zero.
+ * @param time The current time (in nanoseconds; see clock_time). Times earlier
+ * than the last advance are ignored.
+ * @param counter Job counter to submit the expired jobs to the job system
+ * against (see job_submit). Pass 0 to run them on the calling thread before
+ * returning instead.
+ * @return The number of timers which expired.
+ */
+u64
+timer_wheel_advance
+(   timer_wheel_t*  wheel
+,   u64             time
+,   job_counter_t*  counter
+);
+
+#endif  // TIMER_H
@@ -0,0 +1,243 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/approx.h
+ * @brief Defines fast approximations of floating point functions, with bounded
+ * error.
+ *
+ * Each approximation is a short polynomial, with no branches or tables, which
+ * the compiler can inline and schedule freely; the corresponding batch
+ * operations (see math_approx_exp_array etc. in math/batch.h) evaluate it over
+ * a whole vector at a time. Prefer them to math_exp, math_ln, math_sin and
+ * math_cos (see math/float.h, math/trig.h) where speed matters more than the
+ * last bit of accuracy, and inputs stay within the ranges below.
+ *
+ * Maximum errors, measured over every f32 in each range against the correctly
+ * rounded result, in units in the last place (ULP) unless otherwise noted:
+ *
+ *   math_approx_exp        x in [ -87.3 , 88.3 ]       1.1 ULP
+ *   math_approx_ln         x positive, not subnormal   0.9 ULP
+ *   math_approx_sin (cos)  x in [ -π , π ]             1.5 ULP
+ *                          x in [ -100 , 100 ]         14 ULP
+ *                          x in [ -8192 , 8192 ]       8e-8 (absolute)
+ *   math_approx_rsqrt      x positive, not subnormal   1.8e-3 (relative)
+ *
+ * The bounds hold whether or not the compiler fuses multiplies and adds, but
+ * the result may differ in the last bit between builds (or instruction sets)
+ * which do and do not.
+ */
+#ifndef MATH_APPROX_H
+#define MATH_APPROX_H
+
+#include "common.h"
+
+// Range reduction and polynomial coefficients (shared with the batch kernels).
+#define MATH_APPROX_ROUND       12582912.0f             /** @brief 1.5 * 2^23: x + MATH_APPROX_ROUND - MATH_APPROX_ROUND rounds x to the nearest integer, for abs(x) < 2^22. */
+#define MATH_APPROX_LN2_HI      0.693359375f            /** @brief ln(2), high bits (exact in a product with any exponent). */
+#define MATH_APPROX_LN2_LO      -2.12194440e-4f         /** @brief ln(2) - MATH_APPROX_LN2_HI. */
+#define MATH_APPROX_LOG2E       1.44269504088896341f    /** @brief 1 / ln(2). */
+#define MATH_APPROX_EXP_MIN     -87.3365478515625f      /** @brief Least argument with a normal exponential. */
+#define MATH_APPROX_EXP_MAX     88.3762626647949f       /** @brief Greatest argument with a finite exponential. */
+#define MATH_APPROX_EXP_0       1.9875691500e-4f
+#define MATH_APPROX_EXP_1       1.3981999507e-3f
+#define MATH_APPROX_EXP_2       8.3334519073e-3f
+#define MATH_APPROX_EXP_3       4.1665795894e-2f
+#define MATH_APPROX_EXP_4       1.6666665459e-1f
+#define MATH_APPROX_EXP_5       5.0000001201e-1f
+#define MATH_APPROX_LN_0        7.0376836292e-2f
+#define MATH_APPROX_LN_1        -1.1514610310e-1f
+#define MATH_APPROX_LN_2        1.1676998740e-1f
+#define MATH_APPROX_LN_3        -1.2420140846e-1f
+#define MATH_APPROX_LN_4        1.4249322787e-1f
+#define MATH_APPROX_LN_5        -1.6668057665e-1f
+#define MATH_APPROX_LN_6        2.0000714765e-1f
+#define MATH_APPROX_LN_7        -2.4999993993e-1f
+#define MATH_APPROX_LN_8        3.3333331174e-1f
+#define MATH_APPROX_DIV_SQRT2   0.707106781186547524f   /** @brief 1 / sqrt(2): the mantissa of a logarithm argument is reduced to [ 1 / sqrt(2) , sqrt(2) ). */
+#define MATH_APPROX_DIV_HALF_PI 0.636619772367581343f   /** @brief 2 / π. */
+#define MATH_APPROX_HALF_PI_0   1.5703125f              /** @brief π / 2, high bits (exact in a product with an integer below 8192). */
+#define MATH_APPROX_HALF_PI_1   4.837512969970703125e-4f/** @brief π / 2, middle bits. */
+#define MATH_APPROX_HALF_PI_2   7.54978995489188216e-8f /** @brief π / 2, low bits. */
+#define MATH_APPROX_SIN_0       -1.9515295891e-4f
+#define MATH_APPROX_SIN_1       8.3321608736e-3f
+#define MATH_APPROX_SIN_2       -1.6666654611e-1f
+#define MATH_APPROX_COS_0       2.443315711809948e-5f
+#define MATH_APPROX_COS_1       -1.388731625493765e-3f
+#define MATH_APPROX_COS_2       4.166664568298827e-2f
+#define MATH_APPROX_RSQRT       0x5F375A86              /** @brief Initial estimate of 1 / sqrt(x), from the bits of x. */
+
+/** @brief Type definition for the bits of a 32-bit floating point number. */
+typedef union
+{
+    f32 f;
+    u32 u;
+}
+math_approx_bits_t;
+
+/**
+ * @brief Approximate sine or cosine function (see math_approx_sin).
+ *
+ * @param x A floating point number.
+ * @param quadrant 0 for sin(x); 1 for cos(x).
+ * @return An approximation of sin(x + quadrant * π / 2).
+ */
+INLINE
+f32
+_math_approx_sin_quadrant
+(   f32 x
+,   i32 quadrant
+)
+{
+    // Reduce x to r in [ -π / 4 , π / 4 ], and the quadrant it lies in.
+    const f32 n = ( x * MATH_APPROX_DIV_HALF_PI + MATH_APPROX_ROUND ) - MATH_APPROX_ROUND;
+    f32 r = x - n * MATH_APPROX_HALF_PI_0;
+    r = r - n * MATH_APPROX_HALF_PI_1;
+    r = r - n * MATH_APPROX_HALF_PI_2;
+    quadrant += ( i32 ) n;
+
+    const f32 z = r * r;
+    const f32 s = ( ( MATH_APPROX_SIN_0 * z + MATH_APPROX_SIN_1 ) * z + MATH_APPROX_SIN_2 ) * z * r + r;
+    const f32 c = ( ( MATH_APPROX_COS_0 * z + MATH_APPROX_COS_1 ) * z + MATH_APPROX_COS_2 ) * z * z - 0.5f * z + 1.0f;
+
+    // Odd quadrants use the cosine; the upper two negate.
+    math_approx_bits_t result;
+    result.f = ( quadrant & 1 ) ? c : s;
+    result.u ^= ( ( u32 ) quadrant & 2 ) << 30;
+    return result.f;
+}
+
+/**
+ * @brief Approximate exponential function. Arguments outside the range
+ * [ MATH_APPROX_EXP_MIN , MATH_APPROX_EXP_MAX ] are clamped to it.
+ *
+ * @param x A floating point number.
+ * @return An approximation of e^x, within 1.1 ULP.
+ */
+INLINE
+f32
+math_approx_exp
+(   f32 x
+)
+{
+    x = ( x > MATH_APPROX_EXP_MAX ) ? MATH_APPROX_EXP_MAX : x;
+    x = ( x < MATH_APPROX_EXP_MIN ) ? MATH_APPROX_EXP_MIN : x;
+
+    // e^x = 2^n * e^r, for r in [ -ln(2) / 2 , ln(2) / 2 ].
+    const f32 n = ( x * MATH_APPROX_LOG2E + MATH_APPROX_ROUND ) - MATH_APPROX_ROUND;
+    f32 r = x - n * MATH_APPROX_LN2_HI;
+    r = r - n * MATH_APPROX_LN2_LO;
+
+    f32 p = MATH_APPROX_EXP_0;
+    p = p * r + MATH_APPROX_EXP_1;
+    p = p * r + MATH_APPROX_EXP_2;
+    p = p * r + MATH_APPROX_EXP_3;
+    p = p * r + MATH_APPROX_EXP_4;
+    p = p * r + MATH_APPROX_EXP_5;
+
+    // Multiply by 2^n by adding n to the exponent.
+    math_approx_bits_t result;
+    result.f = p * r * r + r + 1.0f;
+    result.u += ( u32 )( i32 ) n << 23;
+    return result.f;
+}
+
+/**
+ * @brief Approximate natural logarithmic function. Zero, negative, subnormal,
+ * infinite and NaN arguments produce an unspecified result.
+ *
+ * @param x A positive floating point number.
+ * @return An approximation of ln(x), within 0.9 ULP.
+ */
+INLINE
+f32
+math_approx_ln
+(   f32 x
+)
+{
+    // x = 2^e * ( 1 + m ), for 1 + m in [ 1 / sqrt(2) , sqrt(2) ).
+    math_approx_bits_t bits;
+    bits.f = x;
+    i32 e = ( i32 )( ( bits.u >> 23 ) & 0xFF ) - 126;
+    bits.u = ( bits.u & 0x007FFFFF ) | 0x3F000000;
+    f32 m = bits.f;
+    if ( m < MATH_APPROX_DIV_SQRT2 )
+    {
+        e -= 1;
+        m = m + m - 1.0f;
+    }
+    else
+    {
+        m = m - 1.0f;
+    }
+
+    const f32 z = m * m;
+    f32 p = MATH_APPROX_LN_0;
+    p = p * m + MATH_APPROX_LN_1;
+    p = p * m + MATH_APPROX_LN_2;
+    p = p * m + MATH_APPROX_LN_3;
+    p = p * m + MATH_APPROX_LN_4;
+    p = p * m + MATH_APPROX_LN_5;
+    p = p * m + MATH_APPROX_LN_6;
+    p = p * m + MATH_APPROX_LN_7;
+    p = p * m + MATH_APPROX_LN_8;
+
+    // ln(x) = e * ln(2) + ln(1 + m).
+    const f32 n = ( f32 ) e;
+    f32 y = p * m * z;
+    y = y + n * MATH_APPROX_LN2_LO;
+    y = y - 0.5f * z;
+    return m + y + n * MATH_APPROX_LN2_HI;
+}
+
+/**
+ * @brief Approximate sine function. Accuracy degrades with the magnitude of x
+ * (see math/approx.h); beyond 8192, the result is unspecified.
+ *
+ * @param x A floating point number.
+ * @return An approximation of sin(x), within 1.5 ULP for x in [ -π , π ].
+ */
+INLINE
+f32
+math_approx_sin
+(   f32 x
+)
+{
+    return _math_approx_sin_quadrant ( x , 0 );
+}
+
+/**
+ * @brief Approximate cosine function. Accuracy degrades with the magnitude of
+ * x (see math/approx.h); beyond 8192, the result is unspecified.
+ *
+ * @param x A floating point number.
+ * @return An approximation of cos(x), within 1.5 ULP for x in [ -π , π ].
+ */
+INLINE
+f32
+math_approx_cos
+(   f32 x
+)
+{
+    return _math_approx_sin_quadrant ( x , 1 );
+}
+
+/**
+ * @brief Approximate reciprocal square root function: an estimate from the
+ * bits of x, refined by a single Newton-Raphson step. Zero, negative,
+ * subnormal, infinite and NaN arguments produce an unspecified result.
+ *
+ * @param x A positive floating point number.
+ * @return An approximation of 1 / sqrt(x), within a relative error of 1.8e-3.
+ */
+INLINE
+f32
+math_approx_rsqrt
+(   f32 x
+)
+{
+    math_approx_bits_t y;
+    y.f = x;
+    y.u = MATH_APPROX_RSQRT - ( y.u >> 1 );
+    return y.f * ( 1.5f - 0.5f * x * y.f * y.f );
+}
+
+#endif  // MATH_APPROX_H
@@ -0,0 +1,789 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/batch.c
+ * @brief Implementation of the math/batch header.
+ * (see math/batch.h for additional details)
+ */
+#include "math/batch.h"
+
+#include "platform/cpu.h"
+
+// Kernels for every instruction set the compiler can target are built into
+// each binary, each function with its own target attribute; which ones run is
+// decided at runtime (see math_batch_dispatch).
+#if PLATFORM_ARCH_X86 == 1 && PLATFORM_COMPILER_GCC == 1
+    #include <immintrin.h>
+    #define MATH_BATCH_X86 1
+#elif defined(__aarch64__) && PLATFORM_COMPILER_GCC == 1
+    #include <arm_neon.h>
+    #define MATH_BATCH_NEON 1   // 32-bit NEON lacks f64 lanes and vector sqrt.
+#endif
+
+// Included after the intrinsics headers, whose libc dependencies would
+// otherwise conflict with the aliases (see math/float.h).
+#include "math/approx.h"
+#include "math/float.h"
+#include "math/float64.h"
+
+// Vector operations, per instruction set: math_<isa>_width_32 (_64) is the
+// number of f32 (f64) lanes per vector, math_<isa>_fma_32 (_64) computes
+// a * b + c, and math_<isa>_target is the attribute which enables the
+// instruction set for a single function. Every vector type is also a generic
+// vector of the compiler, which supports the C arithmetic, bitwise and
+// comparison operators on it lane by lane (see MATH_APPROX_DEFINE);
+// math_<isa>_i32_t is the integer vector of the same width.
+
+// Scalar (any host); also processes the elements which do not fill a vector.
+#define math_scalar_target
+#define math_scalar_width_32            1
+#define math_scalar_width_64            1
+typedef f32         math_scalar_32_t;
+typedef f64         math_scalar_64_t;
+#define math_scalar_load_32(p)          ( *(p) )
+#define math_scalar_load_64(p)          ( *(p) )
+#define math_scalar_store_32(p,x)       ( *(p) = (x) )
+#define math_scalar_store_64(p,x)       ( *(p) = (x) )
+#define math_scalar_splat_32(x)         ( x )
+#define math_scalar_splat_64(x)         ( x )
+#define math_scalar_add_32(a,b)         ( (a) + (b) )
+#define math_scalar_add_64(a,b)         ( (a) + (b) )
+#define math_scalar_mul_32(a,b)         ( (a) * (b) )
+#define math_scalar_mul_64(a,b)         ( (a) * (b) )
+#define math_scalar_fma_32(a,b,c)       ( (a) * (b) + (c) )
+#define math_scalar_fma_64(a,b,c)       ( (a) * (b) + (c) )
+#define math_scalar_min_32(a,b)         ( ( (a) < (b) ) ? (a) : (b) )
+#define math_scalar_min_64(a,b)         ( ( (a) < (b) ) ? (a) : (b) )
+#define math_scalar_max_32(a,b)         ( ( (a) > (b) ) ? (a) : (b) )
+#define math_scalar_max_64(a,b)         ( ( (a) > (b) ) ? (a) : (b) )
+#define math_scalar_sqrt_32(x)          __builtin_sqrtf ( (x) )
+#define math_scalar_sqrt_64(x)          __builtin_sqrt ( (x) )
+#define math_scalar_abs_32(x)           __builtin_fabsf ( (x) )
+#define math_scalar_abs_64(x)           __builtin_fabs ( (x) )
+#define math_scalar_approx_exp_32(x)    math_approx_exp ( (x) )
+#define math_scalar_approx_ln_32(x)     math_approx_ln ( (x) )
+#define math_scalar_approx_sin_32(x)    math_approx_sin ( (x) )
+#define math_scalar_approx_cos_32(x)    math_approx_cos ( (x) )
+#define math_scalar_approx_rsqrt_32(x)  math_approx_rsqrt ( (x) )
+
+#if MATH_BATCH_X86 == 1
+
+    // AVX-512 (AVX-512F).
+    #define math_avx512_target              __attribute__ ( ( target ( "avx512f" ) ) )
+    #define math_avx512_width_32            16
+    #define math_avx512_width_64            8
+    typedef __m512      math_avx512_32_t;
+    typedef __m512d     math_avx512_64_t;
+    typedef i32         math_avx512_i32_t __attribute__ ( ( vector_size ( 64 ) ) );
+    #define math_avx512_load_32(p)          _mm512_loadu_ps ( (p) )
+    #define math_avx512_load_64(p)          _mm512_loadu_pd ( (p) )
+    #define math_avx512_store_32(p,x)       _mm512_storeu_ps ( (p) , (x) )
+    #define math_avx512_store_64(p,x)       _mm512_storeu_pd ( (p) , (x) )
+    #define math_avx512_splat_32(x)         _mm512_set1_ps ( (x) )
+    #define math_avx512_splat_64(x)         _mm512_set1_pd ( (x) )
+    #define math_avx512_add_32(a,b)         _mm512_add_ps ( (a) , (b) )
+    #define math_avx512_add_64(a,b)         _mm512_add_pd ( (a) , (b) )
+    #define math_avx512_mul_32(a,b)         _mm512_mul_ps ( (a) , (b) )
+    #define math_avx512_mul_64(a,b)         _mm512_mul_pd ( (a) , (b) )
+    #define math_avx512_fma_32(a,b,c)       _mm512_fmadd_ps ( (a) , (b) , (c) )
+    #define math_avx512_fma_64(a,b,c)       _mm512_fmadd_pd ( (a) , (b) , (c) )
+    #define math_avx512_min_32(a,b)         _mm512_min_ps ( (a) , (b) )
+    #define math_avx512_min_64(a,b)         _mm512_min_pd ( (a) , (b) )
+    #define math_avx512_max_32(a,b)         _mm512_max_ps ( (a) , (b) )
+    #define math_avx512_max_64(a,b)         _mm512_max_pd ( (a) , (b) )
+    #define math_avx512_sqrt_32(x)          _mm512_sqrt_ps ( (x) )
+    #define math_avx512_sqrt_64(x)          _mm512_sqrt_pd ( (x) )
+    #define math_avx512_abs_32(x)           _mm512_abs_ps ( (x) )
+    #define math_avx512_abs_64(x)           _mm512_abs_pd ( (x) )
+
+    // AVX2 (AVX2 and FMA).
+    #define math_avx2_target                __attribute__ ( ( target ( "avx2,fma" ) ) )
+    #define math_avx2_width_32              8
+    #define math_avx2_width_64              4
+    typedef __m256      math_avx2_32_t;
+    typedef __m256d     math_avx2_64_t;
+    typedef i32         math_avx2_i32_t __attribute__ ( ( vector_size ( 32 ) ) );
+    #define math_avx2_load_32(p)            _mm256_loadu_ps ( (p) )
+    #define math_avx2_load_64(p)            _mm256_loadu_pd ( (p) )
+    #define math_avx2_store_32(p,x)         _mm256_storeu_ps ( (p) , (x) )
+    #define math_avx2_store_64(p,x)         _mm256_storeu_pd ( (p) , (x) )
+    #define math_avx2_splat_32(x)           _mm256_set1_ps ( (x) )
+    #define math_avx2_splat_64(x)           _mm256_set1_pd ( (x) )
+    #define math_avx2_add_32(a,b)           _mm256_add_ps ( (a) , (b) )
+    #define math_avx2_add_64(a,b)           _mm256_add_pd ( (a) , (b) )
+    #define math_avx2_mul_32(a,b)           _mm256_mul_ps ( (a) , (b) )
+    #define math_avx2_mul_64(a,b)           _mm256_mul_pd ( (a) , (b) )
+    #define math_avx2_fma_32(a,b,c)         _mm256_fmadd_ps ( (a) , (b) , (c) )
+    #define math_avx2_fma_64(a,b,c)         _mm256_fmadd_pd ( (a) , (b) , (c) )
+    #define math_avx2_min_32(a,b)           _mm256_min_ps ( (a) , (b) )
+    #define math_avx2_min_64(a,b)           _mm256_min_pd ( (a) , (b) )
+    #define math_avx2_max_32(a,b)           _mm256_max_ps ( (a) , (b) )
+    #define math_avx2_max_64(a,b)           _mm256_max_pd ( (a) , (b) )
+    #define math_avx2_sqrt_32(x)            _mm256_sqrt_ps ( (x) )
+    #define math_avx2_sqrt_64(x)            _mm256_sqrt_pd ( (x) )
+    #define math_avx2_abs_32(x)             _mm256_andnot_ps ( _mm256_set1_ps ( -0.0f ) , (x) )
+    #define math_avx2_abs_64(x)             _mm256_andnot_pd ( _mm256_set1_pd ( -0.0 ) , (x) )
+
+    // SSE2.
+    #define math_sse2_target                __attribute__ ( ( target ( "sse2" ) ) )
+    #define math_sse2_width_32              4
+    #define math_sse2_width_64              2
+    typedef __m128      math_sse2_32_t;
+    typedef __m128d     math_sse2_64_t;
+    typedef i32         math_sse2_i32_t __attribute__ ( ( vector_size ( 16 ) ) );
+    #define math_sse2_load_32(p)            _mm_loadu_ps ( (p) )
+    #define math_sse2_load_64(p)            _mm_loadu_pd ( (p) )
+    #define math_sse2_store_32(p,x)         _mm_storeu_ps ( (p) , (x) )
+    #define math_sse2_store_64(p,x)         _mm_storeu_pd ( (p) , (x) )
+    #define math_sse2_splat_32(x)           _mm_set1_ps ( (x) )
+    #define math_sse2_splat_64(x)           _mm_set1_pd ( (x) )
+    #define math_sse2_add_32(a,b)           _mm_add_ps ( (a) , (b) )
+    #define math_sse2_add_64(a,b)           _mm_add_pd ( (a) , (b) )
+    #define math_sse2_mul_32(a,b)           _mm_mul_ps ( (a) , (b) )
+    #define math_sse2_mul_64(a,b)           _mm_mul_pd ( (a) , (b) )
+    #define math_sse2_fma_32(a,b,c)         _mm_add_ps ( _mm_mul_ps ( (a) , (b) ) , (c) )
+    #define math_sse2_fma_64(a,b,c)         _mm_add_pd ( _mm_mul_pd ( (a) , (b) ) , (c) )
+    #define math_sse2_min_32(a,b)           _mm_min_ps ( (a) , (b) )
+    #define math_sse2_min_64(a,b)           _mm_min_pd ( (a) , (b) )
+    #define math_sse2_max_32(a,b)           _mm_max_ps ( (a) , (b) )
+    #define math_sse2_max_64(a,b)           _mm_max_pd ( (a) , (b) )
+    #define math_sse2_sqrt_32(x)            _mm_sqrt_ps ( (x) )
+    #define math_sse2_sqrt_64(x)            _mm_sqrt_pd ( (x) )
+    #define math_sse2_abs_32(x)             _mm_andnot_ps ( _mm_set1_ps ( -0.0f ) , (x) )
+    #define math_sse2_abs_64(x)             _mm_andnot_pd ( _mm_set1_pd ( -0.0 ) , (x) )
+
+#elif MATH_BATCH_NEON == 1
+
+    // NEON (AArch64).
+    #define math_neon_target
+    #define math_neon_width_32              4
+    #define math_neon_width_64              2
+    typedef float32x4_t math_neon_32_t;
+    typedef float64x2_t math_neon_64_t;
+    typedef int32x4_t   math_neon_i32_t;
+    #define math_neon_load_32(p)            vld1q_f32 ( (p) )
+    #define math_neon_load_64(p)            vld1q_f64 ( (p) )
+    #define math_neon_store_32(p,x)         vst1q_f32 ( (p) , (x) )
+    #define math_neon_store_64(p,x)         vst1q_f64 ( (p) , (x) )
+    #define math_neon_splat_32(x)           vdupq_n_f32 ( (x) )
+    #define math_neon_splat_64(x)           vdupq_n_f64 ( (x) )
+    #define math_neon_add_32(a,b)           vaddq_f32 ( (a) , (b) )
+    #define math_neon_add_64(a,b)           vaddq_f64 ( (a) , (b) )
+    #define math_neon_mul_32(a,b)           vmulq_f32 ( (a) , (b) )
+    #define math_neon_mul_64(a,b)           vmulq_f64 ( (a) , (b) )
+    #define math_neon_fma_32(a,b,c)         vfmaq_f32 ( (c) , (a) , (b) )
+    #define math_neon_fma_64(a,b,c)         vfmaq_f64 ( (c) , (a) , (b) )
+    #define math_neon_min_32(a,b)           vminq_f32 ( (a) , (b) )
+    #define math_neon_min_64(a,b)           vminq_f64 ( (a) , (b) )
+    #define math_neon_max_32(a,b)           vmaxq_f32 ( (a) , (b) )
+    #define math_neon_max_64(a,b)           vmaxq_f64 ( (a) , (b) )
+    #define math_neon_sqrt_32(x)            vsqrtq_f32 ( (x) )
+    #define math_neon_sqrt_64(x)            vsqrtq_f64 ( (x) )
+    #define math_neon_abs_32(x)             vabsq_f32 ( (x) )
+    #define math_neon_abs_64(x)             vabsq_f64 ( (x) )
+
+#endif
+
+/**
+ * @brief Applies an elementwise operation to every element of an array src,
+ * writing the results to dst: a vector at a time, then an element at a time.
+ */
+#define MATH_BATCH_APPLY(isa,bits,operation)                                    \
+    {                                                                           \
+        u64 i = 0;                                                              \
+        for ( ; i + math_##isa##_width_##bits <= count                          \
+              ; i += math_##isa##_width_##bits                                  \
+              )                                                                 \
+        {                                                                       \
+            math_##isa##_store_##bits                                           \
+                ( dst + i                                                       \
+                , math_##isa##_##operation##_##bits                             \
+                      ( math_##isa##_load_##bits ( src + i ) )                  \
+                );                                                              \
+        }                                                                       \
+        for ( ; i < count; ++i )                                                \
+        {                                                                       \
+            dst[ i ] = math_scalar_##operation##_##bits ( src[ i ] );           \
+        }                                                                       \
+    }
+
+/**
+ * @brief Reduces an array to a single value, and returns it.
+ *
+ * step ( isa , bits , accumulator , i ) folds the vector (or, for the scalar
+ * instruction set, the element) at index i into an accumulator; merge (add,
+ * min or max) combines accumulators. Four independent vector accumulators let
+ * consecutive steps overlap.
+ */
+#define MATH_BATCH_REDUCE(isa,bits,identity,step,merge)                         \
+    {                                                                           \
+        const u64 width = math_##isa##_width_##bits;                            \
+        math_##isa##_##bits##_t a0 = math_##isa##_splat_##bits ( (identity) );  \
+        math_##isa##_##bits##_t a1 = a0;                                        \
+        math_##isa##_##bits##_t a2 = a0;                                        \
+        math_##isa##_##bits##_t a3 = a0;                                        \
+        u64 i = 0;                                                              \
+        for ( ; i + 4 * width <= count; i += 4 * width )                        \
+        {                                                                       \
+            a0 = step ( isa , bits , a0 , i );                                  \
+            a1 = step ( isa , bits , a1 , i + width );                          \
+            a2 = step ( isa , bits , a2 , i + 2 * width );                      \
+            a3 = step ( isa , bits , a3 , i + 3 * width );                      \
+        }                                                                       \
+        for ( ; i + width <= count; i += width )                                \
+        {                                                                       \
+            a0 = step ( isa , bits , a0 , i );                                  \
+        }                                                                       \
+        a0 = math_##isa##_##merge##_##bits                                      \
+                 ( math_##isa##_##merge##_##bits ( a0 , a1 )                    \
+                 , math_##isa##_##merge##_##bits ( a2 , a3 )                    \
+                 );                                                             \
+        f##bits lanes[ math_##isa##_width_##bits ];                             \
+        math_##isa##_store_##bits ( lanes , a0 );                               \
+        f##bits result = lanes[ 0 ];                                            \
+        for ( u64 j = 1; j < width; ++j )                                       \
+        {                                                                       \
+            result = math_scalar_##merge##_##bits ( result , lanes[ j ] );      \
+        }                                                                       \
+        for ( ; i < count; ++i )                                                \
+        {                                                                       \
+            result = step ( scalar , bits , result , i );                       \
+        }                                                                       \
+        return result;                                                          \
+    }
+
+// Reduction steps (see MATH_BATCH_REDUCE).
+#define MATH_SUM_STEP(isa,bits,a,i)                                             \
+    math_##isa##_add_##bits ( (a) , math_##isa##_load_##bits ( src + (i) ) )
+#define MATH_DOT_STEP(isa,bits,a,i)                                             \
+    math_##isa##_fma_##bits ( math_##isa##_load_##bits ( x + (i) )              \
+                            , math_##isa##_load_##bits ( y + (i) )              \
+                            , (a)                                               \
+                            )
+#define MATH_MIN_STEP(isa,bits,a,i)                                             \
+    math_##isa##_min_##bits ( (a) , math_##isa##_load_##bits ( src + (i) ) )
+#define MATH_MAX_STEP(isa,bits,a,i)                                             \
+    math_##isa##_max_##bits ( (a) , math_##isa##_load_##bits ( src + (i) ) )
+
+/**
+ * @brief Interpolates two arrays x and y elementwise by weight, writing the
+ * results to dst. Computes ( 1 - weight ) * x + weight * y, as math_mix does,
+ * but with a fused multiply-add where the instruction set has one.
+ */
+#define MATH_BATCH_MIX(isa,bits)                                                \
+    {                                                                           \
+        const math_##isa##_##bits##_t t = math_##isa##_splat_##bits ( weight ); \
+        const math_##isa##_##bits##_t s = math_##isa##_splat_##bits             \
+                                              ( 1 - weight );                   \
+        u64 i = 0;                                                              \
+        for ( ; i + math_##isa##_width_##bits <= count                          \
+              ; i += math_##isa##_width_##bits                                  \
+              )                                                                 \
+        {                                                                       \
+            const math_##isa##_##bits##_t a = math_##isa##_load_##bits ( x + i );\
+            const math_##isa##_##bits##_t b = math_##isa##_load_##bits ( y + i );\
+            math_##isa##_store_##bits                                           \
+                ( dst + i                                                       \
+                , math_##isa##_fma_##bits ( b , t , math_##isa##_mul_##bits ( a , s ) ) \
+                );                                                              \
+        }                                                                       \
+        for ( ; i < count; ++i )                                                \
+        {                                                                       \
+            dst[ i ] = ( 1 - weight ) * x[ i ] + weight * y[ i ];               \
+        }                                                                       \
+    }
+
+/**
+ * @brief Defines the approximations of math/approx.h over whole vectors, for
+ * one (vector) instruction set: math_<isa>_approx_<function>_32. Each follows
+ * the scalar approximation step for step, with masks in place of branches.
+ */
+#define MATH_APPROX_DEFINE(isa)                                                 \
+    INLINE math_##isa##_target math_##isa##_32_t                                \
+    math_##isa##_approx_exp_32 ( math_##isa##_32_t x )                          \
+    {                                                                           \
+        x = math_##isa##_min_32 ( x , math_##isa##_splat_32                     \
+                                          ( MATH_APPROX_EXP_MAX ) );            \
+        x = math_##isa##_max_32 ( x , math_##isa##_splat_32                     \
+                                          ( MATH_APPROX_EXP_MIN ) );            \
+        const math_##isa##_32_t n = ( x * MATH_APPROX_LOG2E                     \
+                                    + MATH_APPROX_ROUND                         \
+                                    ) - MATH_APPROX_ROUND;                      \
+        math_##isa##_32_t r = x - n * MATH_APPROX_LN2_HI;                       \
+        r = r - n * MATH_APPROX_LN2_LO;                                         \
+        math_##isa##_32_t p = r * MATH_APPROX_EXP_0 + MATH_APPROX_EXP_1;        \
+        p = p * r + MATH_APPROX_EXP_2;                                          \
+        p = p * r + MATH_APPROX_EXP_3;                                          \
+        p = p * r + MATH_APPROX_EXP_4;                                          \
+        p = p * r + MATH_APPROX_EXP_5;                                          \
+        const math_##isa##_32_t e = p * r * r + r + 1.0f;                       \
+        return ( math_##isa##_32_t )                                            \
+               ( ( math_##isa##_i32_t ) e                                       \
+               + ( __builtin_convertvector ( n , math_##isa##_i32_t ) << 23 )   \
+               );                                                               \
+    }                                                                           \
+    INLINE math_##isa##_target math_##isa##_32_t                                \
+    math_##isa##_approx_ln_32 ( math_##isa##_32_t x )                           \
+    {                                                                           \
+        const math_##isa##_i32_t bits = ( math_##isa##_i32_t ) x;               \
+        math_##isa##_i32_t e = ( ( bits >> 23 ) & 0xFF ) - 126;                 \
+        math_##isa##_32_t m = ( math_##isa##_32_t )                             \
+                              ( ( bits & 0x007FFFFF ) | 0x3F000000 );           \
+        const math_##isa##_i32_t low = m < MATH_APPROX_DIV_SQRT2;               \
+        e = e + low;                                                            \
+        m = ( m - 1.0f )                                                        \
+          + ( math_##isa##_32_t )( low & ( math_##isa##_i32_t ) m );            \
+        const math_##isa##_32_t z = m * m;                                      \
+        math_##isa##_32_t p = m * MATH_APPROX_LN_0 + MATH_APPROX_LN_1;          \
+        p = p * m + MATH_APPROX_LN_2;                                           \
+        p = p * m + MATH_APPROX_LN_3;                                           \
+        p = p * m + MATH_APPROX_LN_4;                                           \
+        p = p * m + MATH_APPROX_LN_5;                                           \
+        p = p * m + MATH_APPROX_LN_6;                                           \
+        p = p * m + MATH_APPROX_LN_7;                                           \
+        p = p * m + MATH_APPROX_LN_8;                                           \
+        const math_##isa##_32_t n = __builtin_convertvector                     \
+                                        ( e , math_##isa##_32_t );              \
+        math_##isa##_32_t y = p * m * z;                                        \
+        y = y + n * MATH_APPROX_LN2_LO;                                         \
+        y = y - 0.5f * z;                                                       \
+        return m + y + n * MATH_APPROX_LN2_HI;                                  \
+    }                                                                           \
+    INLINE math_##isa##_target math_##isa##_32_t                                \
+    math_##isa##_approx_sin_quadrant_32 ( math_##isa##_32_t x , i32 quadrant )  \
+    {                                                                           \
+        const math_##isa##_32_t n = ( x * MATH_APPROX_DIV_HALF_PI               \
+                                    + MATH_APPROX_ROUND                         \
+                                    ) - MATH_APPROX_ROUND;                      \
+        math_##isa##_32_t r = x - n * MATH_APPROX_HALF_PI_0;                    \
+        r = r - n * MATH_APPROX_HALF_PI_1;                                      \
+        r = r - n * MATH_APPROX_HALF_PI_2;                                      \
+        const math_##isa##_i32_t q = __builtin_convertvector                    \
+                                         ( n , math_##isa##_i32_t ) + quadrant; \
+        const math_##isa##_32_t z = r * r;                                      \
+        const math_##isa##_32_t s = ( ( z * MATH_APPROX_SIN_0                   \
+                                      + MATH_APPROX_SIN_1                       \
+                                      ) * z + MATH_APPROX_SIN_2                 \
+                                    ) * z * r + r;                              \
+        const math_##isa##_32_t c = ( ( z * MATH_APPROX_COS_0                   \
+                                      + MATH_APPROX_COS_1                       \
+                                      ) * z + MATH_APPROX_COS_2                 \
+                                    ) * z * z - 0.5f * z + 1.0f;                \
+        const math_##isa##_i32_t odd = ( q & 1 ) == 1;                          \
+        const math_##isa##_i32_t negative = ( ( q & 2 ) == 2 )                  \
+                                          & ( math_##isa##_i32_t )              \
+                                            math_##isa##_splat_32 ( -0.0f );    \
+        return ( math_##isa##_32_t )                                            \
+               ( ( ( odd & ( math_##isa##_i32_t ) c )                           \
+                 | ( ~odd & ( math_##isa##_i32_t ) s )                          \
+                 ) ^ negative                                                   \
+               );                                                               \
+    }                                                                           \
+    INLINE math_##isa##_target math_##isa##_32_t                                \
+    math_##isa##_approx_sin_32 ( math_##isa##_32_t x )                          \
+    {                                                                           \
+        return math_##isa##_approx_sin_quadrant_32 ( x , 0 );                   \
+    }                                                                           \
+    INLINE math_##isa##_target math_##isa##_32_t                                \
+    math_##isa##_approx_cos_32 ( math_##isa##_32_t x )                          \
+    {                                                                           \
+        return math_##isa##_approx_sin_quadrant_32 ( x , 1 );                   \
+    }                                                                           \
+    INLINE math_##isa##_target math_##isa##_32_t                                \
+    math_##isa##_approx_rsqrt_32 ( math_##isa##_32_t x )                        \
+    {                                                                           \
+        const math_##isa##_32_t y = ( math_##isa##_32_t )                       \
+                                    ( MATH_APPROX_RSQRT                         \
+                                    - ( ( math_##isa##_i32_t ) x >> 1 )         \
+                                    );                                          \
+        return y * ( 1.5f - 0.5f * x * y * y );                                 \
+    }
+
+#if MATH_BATCH_X86 == 1
+MATH_APPROX_DEFINE ( avx512 )
+MATH_APPROX_DEFINE ( avx2 )
+MATH_APPROX_DEFINE ( sse2 )
+#elif MATH_BATCH_NEON == 1
+MATH_APPROX_DEFINE ( neon )
+#endif
+
+/** @brief Type definition for a set of batch kernels for one instruction set. */
+typedef struct
+{
+    const char* name;
+
+    void    ( *sqrt_32 )( f32* , const f32* , u64 );
+    void    ( *abs_32 )( f32* , const f32* , u64 );
+    void    ( *mix_32 )( f32* , const f32* , const f32* , f32 , u64 );
+    f32     ( *sum_32 )( const f32* , u64 );
+    f32     ( *dot_32 )( const f32* , const f32* , u64 );
+    f32     ( *min_32 )( const f32* , u64 );
+    f32     ( *max_32 )( const f32* , u64 );
+
+    void    ( *sqrt_64 )( f64* , const f64* , u64 );
+    void    ( *abs_64 )( f64* , const f64* , u64 );
+    void    ( *mix_64 )( f64* , const f64* , const f64* , f64 , u64 );
+    f64     ( *sum_64 )( const f64* , u64 );
+    f64     ( *dot_64 )( const f64* , const f64* , u64 );
+    f64     ( *min_64 )( const f64* , u64 );
+    f64     ( *max_64 )( const f64* , u64 );
+
+    void    ( *approx_exp_32 )( f32* , const f32* , u64 );
+    void    ( *approx_ln_32 )( f32* , const f32* , u64 );
+    void    ( *approx_sin_32 )( f32* , const f32* , u64 );
+    void    ( *approx_cos_32 )( f32* , const f32* , u64 );
+    void    ( *approx_rsqrt_32 )( f32* , const f32* , u64 );
+}
+math_batch_kernels_t;
+
+/**
+ * @brief Defines the kernel functions for one instruction set, and the
+ * math_batch_<isa> kernel set which holds them.
+ */
+#define MATH_BATCH_DEFINE(isa)                                                  \
+    static math_##isa##_target void                                             \
+    math_sqrt_array_##isa ( f32* dst , const f32* src , const u64 count )       \
+    MATH_BATCH_APPLY ( isa , 32 , sqrt )                                        \
+    static math_##isa##_target void                                             \
+    math_abs_array_##isa ( f32* dst , const f32* src , const u64 count )        \
+    MATH_BATCH_APPLY ( isa , 32 , abs )                                         \
+    static math_##isa##_target void                                             \
+    math_mix_array_##isa ( f32* dst , const f32* x , const f32* y               \
+                         , const f32 weight , const u64 count )                 \
+    MATH_BATCH_MIX ( isa , 32 )                                                 \
+    static math_##isa##_target f32                                              \
+    math_sum_array_##isa ( const f32* src , const u64 count )                   \
+    MATH_BATCH_REDUCE ( isa , 32 , 0.0f , MATH_SUM_STEP , add )                 \
+    static math_##isa##_target f32                                              \
+    math_dot_array_##isa ( const f32* x , const f32* y , const u64 count )      \
+    MATH_BATCH_REDUCE ( isa , 32 , 0.0f , MATH_DOT_STEP , add )                 \
+    static math_##isa##_target f32                                              \
+    math_min_array_##isa ( const f32* src , const u64 count )                   \
+    MATH_BATCH_REDUCE ( isa , 32 , INFINITY , MATH_MIN_STEP , min )             \
+    static math_##isa##_target f32                                              \
+    math_max_array_##isa ( const f32* src , const u64 count )                   \
+    MATH_BATCH_REDUCE ( isa , 32 , -INFINITY , MATH_MAX_STEP , max )            \
+    static math_##isa##_target void                                             \
+    math_sqrt_array_64_##isa ( f64* dst , const f64* src , const u64 count )    \
+    MATH_BATCH_APPLY ( isa , 64 , sqrt )                                        \
+    static math_##isa##_target void                                             \
+    math_abs_array_64_##isa ( f64* dst , const f64* src , const u64 count )     \
+    MATH_BATCH_APPLY ( isa , 64 , abs )                                         \
+    static math_##isa##_target void                                             \
+    math_mix_array_64_##isa ( f64* dst , const f64* x , const f64* y            \
+                            , const f64 weight , const u64 count )              \
+    MATH_BATCH_MIX ( isa , 64 )                                                 \
+    static math_##isa##_target f64                                              \
+    math_sum_array_64_##isa ( const f64* src , const u64 count )                \
+    MATH_BATCH_REDUCE ( isa , 64 , 0.0 , MATH_SUM_STEP , add )                  \
+    static math_##isa##_target f64                                              \
+    math_dot_array_64_##isa ( const f64* x , const f64* y , const u64 count )   \
+    MATH_BATCH_REDUCE ( isa , 64 , 0.0 , MATH_DOT_STEP , add )                  \
+    static math_##isa##_target f64                                              \
+    math_min_array_64_##isa ( const f64* src , const u64 count )                \
+    MATH_BATCH_REDUCE ( isa , 64 , INFINITY_64 , MATH_MIN_STEP , min )          \
+    static math_##isa##_target f64                                              \
+    math_max_array_64_##isa ( const f64* src , const u64 count )                \
+    MATH_BATCH_REDUCE ( isa , 64 , -INFINITY_64 , MATH_MAX_STEP , max )         \
+    static math_##isa##_target void                                             \
+    math_approx_exp_array_##isa ( f32* dst , const f32* src , const u64 count ) \
+    MATH_BATCH_APPLY ( isa , 32 , approx_exp )                                  \
+    static math_##isa##_target void                                             \
+    math_approx_ln_array_##isa ( f32* dst , const f32* src , const u64 count )  \
+    MATH_BATCH_APPLY ( isa , 32 , approx_ln )                                   \
+    static math_##isa##_target void                                             \
+    math_approx_sin_array_##isa ( f32* dst , const f32* src , const u64 count ) \
+    MATH_BATCH_APPLY ( isa , 32 , approx_sin )                                  \
+    static math_##isa##_target void                                             \
+    math_approx_cos_array_##isa ( f32* dst , const f32* src , const u64 count ) \
+    MATH_BATCH_APPLY ( isa , 32 , approx_cos )                                  \
+    static math_##isa##_target void                                             \
+    math_approx_rsqrt_array_##isa ( f32* dst , const f32* src                   \
+                                  , const u64 count )                           \
+    MATH_BATCH_APPLY ( isa , 32 , approx_rsqrt )                                \
+    static const math_batch_kernels_t math_batch_##isa =                        \
+    {   #isa                                                                    \
+    ,   math_sqrt_array_##isa                                                   \
+    ,   math_abs_array_##isa                                                    \
+    ,   math_mix_array_##isa                                                    \
+    ,   math_sum_array_##isa                                                    \
+    ,   math_dot_array_##isa                                                    \
+    ,   math_min_array_##isa                                                    \
+    ,   math_max_array_##isa                                                    \
+    ,   math_sqrt_array_64_##isa                                                \
+    ,   math_abs_array_64_##isa                                                 \
+    ,   math_mix_array_64_##isa                                                 \
+    ,   math_sum_array_64_##isa                                                 \
+    ,   math_dot_array_64_##isa                                                 \
+    ,   math_min_array_64_##isa                                                 \
+    ,   math_max_array_64_##isa                                                 \
+    ,   math_approx_exp_array_##isa                                             \
+    ,   math_approx_ln_array_##isa                                              \
+    ,   math_approx_sin_array_##isa                                             \
+    ,   math_approx_cos_array_##isa                                             \
+    ,   math_approx_rsqrt_array_##isa                                           \
+    };
+
+MATH_BATCH_DEFINE ( scalar )
+#if MATH_BATCH_X86 == 1
+MATH_BATCH_DEFINE ( avx512 )
+MATH_BATCH_DEFINE ( avx2 )
+MATH_BATCH_DEFINE ( sse2 )
+#elif MATH_BATCH_NEON == 1
+MATH_BATCH_DEFINE ( neon )
+#endif
+
+// Global state.
+static const math_batch_kernels_t* math_batch_kernels_state = 0;
+
+/**
+ * @brief Queries the selected kernel set, selecting one for the host on the
+ * first call (see math_batch_dispatch).
+ *
+ * @return The selected kernel set.
+ */
+INLINE
+const math_batch_kernels_t*
+_math_batch_kernels
+( void )
+{
+    const math_batch_kernels_t* kernels = atomic_load_ptr ( ( void* const* ) &math_batch_kernels_state
+                                                          , ATOMIC_ACQUIRE
+                                                          );
+    if ( !kernels )
+    {
+        math_batch_dispatch ( cpu_features () );
+        kernels = atomic_load_ptr ( ( void* const* ) &math_batch_kernels_state , ATOMIC_ACQUIRE );
+    }
+    return kernels;
+}
+
+const char*
+math_batch_dispatch
+(   const u32 features
+)
+{
+    const math_batch_kernels_t* kernels = &math_batch_scalar;
+#if MATH_BATCH_X86 == 1
+    if ( ( features & CPU_FEATURE_AVX512F ) )
+    {
+        kernels = &math_batch_avx512;
+    }
+    else if ( ( features & ( CPU_FEATURE_AVX2 | CPU_FEATURE_FMA ) ) == ( CPU_FEATURE_AVX2 | CPU_FEATURE_FMA ) )
+    {
+        kernels = &math_batch_avx2;
+    }
+    else if ( ( features & CPU_FEATURE_SSE2 ) )
+    {
+        kernels = &math_batch_sse2;
+    }
+#elif MATH_BATCH_NEON == 1
+    if ( ( features & CPU_FEATURE_NEON ) )
+    {
+        kernels = &math_batch_neon;
+    }
+#endif
+    atomic_store_ptr ( ( void** ) &math_batch_kernels_state , ( void* ) kernels , ATOMIC_RELEASE );
+    return ( *kernels ).name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Begin 32-bit batch math.
+
+void
+math_sqrt_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).sqrt_32 ( dst , src , count );
+}
+
+void
+math_abs_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).abs_32 ( dst , src , count );
+}
+
+void
+math_mix_array
+(   f32*        dst
+,   const f32*  x
+,   const f32*  y
+,   const f32   weight
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).mix_32 ( dst , x , y , weight , count );
+}
+
+f32
+math_sum_array
+(   const f32*  src
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).sum_32 ( src , count );
+}
+
+f32
+math_dot_array
+(   const f32*  x
+,   const f32*  y
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).dot_32 ( x , y , count );
+}
+
+f32
+math_min_array
+(   const f32*  src
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).min_32 ( src , count );
+}
+
+f32
+math_max_array
+(   const f32*  src
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).max_32 ( src , count );
+}
+
+// End 32-bit batch math.
+////////////////////////////////////////////////////////////////////////////////
+// Begin 64-bit batch math.
+
+void
+math_sqrt_array_64
+(   f64*        dst
+,   const f64*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).sqrt_64 ( dst , src , count );
+}
+
+void
+math_abs_array_64
+(   f64*        dst
+,   const f64*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).abs_64 ( dst , src , count );
+}
+
+void
+math_mix_array_64
+(   f64*        dst
+,   const f64*  x
+,   const f64*  y
+,   const f64   weight
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).mix_64 ( dst , x , y , weight , count );
+}
+
+f64
+math_sum_array_64
+(   const f64*  src
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).sum_64 ( src , count );
+}
+
+f64
+math_dot_array_64
+(   const f64*  x
+,   const f64*  y
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).dot_64 ( x , y , count );
+}
+
+f64
+math_min_array_64
+(   const f64*  src
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).min_64 ( src , count );
+}
+
+f64
+math_max_array_64
+(   const f64*  src
+,   const u64   count
+)
+{
+    return ( *_math_batch_kernels () ).max_64 ( src , count );
+}
+
+// End 64-bit batch math.
+////////////////////////////////////////////////////////////////////////////////
+// Begin approximate batch math.
+
+void
+math_approx_exp_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).approx_exp_32 ( dst , src , count );
+}
+
+void
+math_approx_ln_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).approx_ln_32 ( dst , src , count );
+}
+
+void
+math_approx_sin_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).approx_sin_32 ( dst , src , count );
+}
+
+void
+math_approx_cos_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).approx_cos_32 ( dst , src , count );
+}
+
+void
+math_approx_rsqrt_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+)
+{
+    ( *_math_batch_kernels () ).approx_rsqrt_32 ( dst , src , count );
+}
+
+// End approximate batch math.
+////////////////////////////////////////////////////////////////////////////////
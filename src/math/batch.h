@@ -0,0 +1,339 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/batch.h
+ * @brief Defines floating point operations over whole arrays.
+ *
+ * Each operation applies the corresponding scalar operation (see math/float.h,
+ * math/float64.h) to every element of one or more arrays, several elements at
+ * a time. Kernels for AVX-512, AVX2 (with FMA), SSE2 and NEON (AArch64) are
+ * built into every binary for the matching architecture, alongside plain
+ * scalar ones; on first use, the widest the host processor supports is
+ * selected (see math_batch_dispatch).
+ *
+ * Elementwise results match the scalar operations exactly, except that mix
+ * uses a fused multiply-add where the instruction set has one (so may differ
+ * from math_mix in the last bit). Reductions (sum, dot product) add the
+ * elements in a different order than a sequential loop, so their results may
+ * differ from one in the last few bits, and between builds for different
+ * instruction sets.
+ *
+ * The approximate operations (see math/approx.h) produce results within the
+ * same error bounds as the scalar approximations, but not necessarily the same
+ * results, since they fuse multiplies and adds where the instruction set can.
+ *
+ * Arrays need not be aligned. An output array may be one of the input arrays
+ * (in-place), but must not partially overlap one.
+ */
+#ifndef MATH_BATCH_H
+#define MATH_BATCH_H
+
+#include "common.h"
+
+/**
+ * @brief Selects the kernels used by every batch operation: those for the
+ * widest instruction set among features.
+ *
+ * Called automatically, with cpu_features, on the first batch operation.
+ * Call explicitly only to restrict the kernels (e.g. to test or benchmark a
+ * narrower instruction set); features must not include any extension the host
+ * lacks (see platform/cpu.h).
+ *
+ * @param features A combination of CPU_FEATURE flags.
+ * @return The name of the selected instruction set (e.g. "avx2", "scalar").
+ */
+const char*
+math_batch_dispatch
+(   const u32 features
+);
+
+////////////////////////////////////////////////////////////////////////////////
+// Begin 32-bit batch math.
+
+/**
+ * @brief Square root function over an array.
+ *
+ * @param dst Output buffer for sqrt(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_sqrt_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Absolute value function over an array.
+ *
+ * @param dst Output buffer for abs(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_abs_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Interpolates two arrays of floating point values elementwise, using
+ * the same weight for every element (see math_mix).
+ *
+ * @param dst Output buffer for mix(x[ i ],y[ i ],weight) for each i.
+ * @param x An array of floating point numbers.
+ * @param y An array of floating point numbers.
+ * @param weight Weight. Its value must be in the range [ 0.0 , 1.0 ].
+ * @param count The number of elements in dst, x and y.
+ */
+void
+math_mix_array
+(   f32*        dst
+,   const f32*  x
+,   const f32*  y
+,   const f32   weight
+,   const u64   count
+);
+
+/**
+ * @brief Sums an array of floating point numbers.
+ *
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in src.
+ * @return The sum of the elements of src (0 if count is 0).
+ */
+f32
+math_sum_array
+(   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Dot product of two arrays of floating point numbers.
+ *
+ * @param x An array of floating point numbers.
+ * @param y An array of floating point numbers.
+ * @param count The number of elements in x and y.
+ * @return The sum of x[ i ] * y[ i ] over each i (0 if count is 0).
+ */
+f32
+math_dot_array
+(   const f32*  x
+,   const f32*  y
+,   const u64   count
+);
+
+/**
+ * @brief Minimum of an array of floating point numbers. NaN elements produce
+ * an unspecified result.
+ *
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in src.
+ * @return The minimum element of src (INFINITY if count is 0).
+ */
+f32
+math_min_array
+(   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Maximum of an array of floating point numbers. NaN elements produce
+ * an unspecified result.
+ *
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in src.
+ * @return The maximum element of src (-INFINITY if count is 0).
+ */
+f32
+math_max_array
+(   const f32*  src
+,   const u64   count
+);
+
+// End 32-bit batch math.
+////////////////////////////////////////////////////////////////////////////////
+// Begin 64-bit batch math.
+
+/**
+ * @brief Square root function over an array.
+ *
+ * @param dst Output buffer for sqrt64(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_sqrt_array_64
+(   f64*        dst
+,   const f64*  src
+,   const u64   count
+);
+
+/**
+ * @brief Absolute value function over an array.
+ *
+ * @param dst Output buffer for abs64(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_abs_array_64
+(   f64*        dst
+,   const f64*  src
+,   const u64   count
+);
+
+/**
+ * @brief Interpolates two arrays of floating point values elementwise, using
+ * the same weight for every element (see math_mix_64).
+ *
+ * @param dst Output buffer for mix64(x[ i ],y[ i ],weight) for each i.
+ * @param x An array of floating point numbers.
+ * @param y An array of floating point numbers.
+ * @param weight Weight. Its value must be in the range [ 0.0 , 1.0 ].
+ * @param count The number of elements in dst, x and y.
+ */
+void
+math_mix_array_64
+(   f64*        dst
+,   const f64*  x
+,   const f64*  y
+,   const f64   weight
+,   const u64   count
+);
+
+/**
+ * @brief Sums an array of floating point numbers.
+ *
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in src.
+ * @return The sum of the elements of src (0 if count is 0).
+ */
+f64
+math_sum_array_64
+(   const f64*  src
+,   const u64   count
+);
+
+/**
+ * @brief Dot product of two arrays of floating point numbers.
+ *
+ * @param x An array of floating point numbers.
+ * @param y An array of floating point numbers.
+ * @param count The number of elements in x and y.
+ * @return The sum of x[ i ] * y[ i ] over each i (0 if count is 0).
+ */
+f64
+math_dot_array_64
+(   const f64*  x
+,   const f64*  y
+,   const u64   count
+);
+
+/**
+ * @brief Minimum of an array of floating point numbers. NaN elements produce
+ * an unspecified result.
+ *
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in src.
+ * @return The minimum element of src (INFINITY_64 if count is 0).
+ */
+f64
+math_min_array_64
+(   const f64*  src
+,   const u64   count
+);
+
+/**
+ * @brief Maximum of an array of floating point numbers. NaN elements produce
+ * an unspecified result.
+ *
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in src.
+ * @return The maximum element of src (-INFINITY_64 if count is 0).
+ */
+f64
+math_max_array_64
+(   const f64*  src
+,   const u64   count
+);
+
+// End 64-bit batch math.
+////////////////////////////////////////////////////////////////////////////////
+// Begin approximate batch math.
+
+/**
+ * @brief Approximate exponential function over an array (see math_approx_exp).
+ *
+ * @param dst Output buffer for an approximation of e^src[ i ] for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_approx_exp_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Approximate natural logarithmic function over an array (see math_approx_ln).
+ *
+ * @param dst Output buffer for an approximation of ln(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_approx_ln_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Approximate sine function over an array (see math_approx_sin).
+ *
+ * @param dst Output buffer for an approximation of sin(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_approx_sin_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Approximate cosine function over an array (see math_approx_cos).
+ *
+ * @param dst Output buffer for an approximation of cos(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_approx_cos_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+);
+
+/**
+ * @brief Approximate reciprocal square root function over an array (see math_approx_rsqrt).
+ *
+ * @param dst Output buffer for an approximation of 1 / sqrt(src[ i ]) for each i.
+ * @param src An array of floating point numbers.
+ * @param count The number of elements in dst and src.
+ */
+void
+math_approx_rsqrt_array
+(   f32*        dst
+,   const f32*  src
+,   const u64   count
+);
+
+// End approximate batch math.
+////////////////////////////////////////////////////////////////////////////////
+
+#endif  // MATH_BATCH_H
@@ -65,9 +65,6 @@
 #include <math.h>
 #include <stdlib.h>
 
-// ( see random ).
-static bool random_seeded = false;
-
 ////////////////////////////////////////////////////////////////////////////////
 // Begin 32-bit math.
 
@@ -228,12 +225,7 @@ i32
 math_random
 ( void )
 {
-    if ( !random_seeded )
-    {
-        srand ( ( u32 ) platform_absolute_time () );
-        random_seeded = true;
-    }
-    return rand ();
+    return ( i32 )( prng_next ( prng_local () ) >> 33 );
 }
 
 i32
@@ -242,7 +234,7 @@ math_random2
 ,   i32 max
 )
 {
-    return ( math_random () % ( max - min + 1 ) ) + min;
+    return ( i32 ) prng_range ( prng_local () , min , max );
 }
 
 f32
@@ -258,7 +250,8 @@ math_randomf2
 ,   f32 max
 )
 {
-    return min + ( f32 ) math_random () / ( ( f32 ) RAND_MAX / ( max - min ) );
+    // 24 random bits, scaled so that both bounds are reachable.
+    return min + ( f32 )( prng_next ( prng_local () ) >> 40 ) * ( ( max - min ) / 16777215.0f );
 }
 
 // End 32-bit math.
@@ -422,9 +415,7 @@ i64
 math_random_64
 ( void )
 {
-    const u64 lo = math_random () & 0xFFFFFFFF;
-    const u64 hi = math_random () & 0xFFFFFFFF;
-    return lo | ( hi << 32 );
+    return ( i64 ) prng_next ( prng_local () );
 }
 
 i64
@@ -433,14 +424,14 @@ math_random2_64
 ,   i64 max
 )
 {
-    return ( math_random_64 () % ( max - min + 1 ) ) + min;
+    return prng_range ( prng_local () , min , max );
 }
 
 f64
 math_randomf_64
 ( void )
 {
-    return math_randomf2_64 ( 0.0f , 1.0f );
+    return math_randomf2_64 ( 0.0 , 1.0 );
 }
 
 f64
@@ -449,7 +440,8 @@ math_randomf2_64
 ,   f64 max
 )
 {
-    return min + ( f64 ) math_random_64 () / ( ( f64 ) RAND_MAX / ( max - min ) );
+    // 53 random bits, scaled so that both bounds are reachable.
+    return min + ( f64 )( prng_next ( prng_local () ) >> 11 ) * ( ( max - min ) / 9007199254740991.0 );
 }
 
 // End 64-bit math.
@@ -8,11 +8,14 @@
 
 #include "common.h"
 
+#include "math/approx.h"
+#include "math/batch.h"
 #include "math/conversion.h"
 #include "math/clamp.h"
 #include "math/div.h"
 #include "math/float.h"
 #include "math/float64.h"
+#include "math/prng.h"
 #include "math/random.h"
 #include "math/random64.h"
 #include "math/trig.h"
@@ -0,0 +1,448 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/prng.c
+ * @brief Implementation of the math/prng header.
+ * (see math/prng.h for additional details)
+ */
+#include "math/prng.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "platform/platform.h"
+
+/** @brief PCG64 multiplier (128-bit). */
+#define PRNG_PCG64_MULTIPLIER_LO 0x4385DF649FCCF645ULL
+#define PRNG_PCG64_MULTIPLIER_HI 0x2360ED051FC65DA4ULL
+
+/** @brief 2^-24 and 2^-53: scale the top bits of an output onto [ 0 , 1 ). */
+#define PRNG_F32_SCALE ( 1.0f / 16777216.0f )
+#define PRNG_F64_SCALE ( 1.0 / 9007199254740992.0 )
+
+// Per-thread generator (see prng_local).
+static THREAD_LOCAL prng_t  prng_local_state;
+static THREAD_LOCAL bool    prng_local_seeded = false;
+
+// Distinguishes threads which seed prng_local at the same clock time.
+static u64 prng_local_count = 0;
+
+/**
+ * @brief Advances a splitmix64 state. Used to expand seeds.
+ *
+ * @param state The state to advance.
+ * @return 64 random bits.
+ */
+INLINE
+u64
+_prng_splitmix64
+(   u64* state
+)
+{
+    *state += 0x9E3779B97F4A7C15ULL;
+    u64 z = *state;
+    z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+    return z ^ ( z >> 31 );
+}
+
+/**
+ * @brief Advances a xoshiro256** state.
+ *
+ * @param s The state to advance.
+ * @return 64 random bits.
+ */
+INLINE
+u64
+_prng_xoshiro256ss
+(   u64* s
+)
+{
+    const u64 result = rotl64 ( s[ 1 ] * 5 , 7 ) * 9;
+    const u64 t = s[ 1 ] << 17;
+    s[ 2 ] ^= s[ 0 ];
+    s[ 3 ] ^= s[ 1 ];
+    s[ 1 ] ^= s[ 2 ];
+    s[ 0 ] ^= s[ 3 ];
+    s[ 2 ] ^= t;
+    s[ 3 ] = rotl64 ( s[ 3 ] , 45 );
+    return result;
+}
+
+/**
+ * @brief Computes the low 128 bits of the product of two 128-bit values.
+ *
+ * @param lo Input: low 64 bits of the multiplicand. Output: low 64 bits of the product.
+ * @param hi Input: high 64 bits of the multiplicand. Output: high 64 bits of the product.
+ * @param y_lo Low 64 bits of the multiplier.
+ * @param y_hi High 64 bits of the multiplier.
+ */
+INLINE
+void
+_prng_mul128
+(   u64*        lo
+,   u64*        hi
+,   const u64   y_lo
+,   const u64   y_hi
+)
+{
+    const u64 x_lo = *lo;
+    const u64 x_hi = *hi;
+    *lo = x_lo * y_lo;
+    *hi = mulhi64 ( x_lo , y_lo ) + x_lo * y_hi + x_hi * y_lo;
+}
+
+/**
+ * @brief Computes the sum of two 128-bit values.
+ *
+ * @param lo Input: low 64 bits of an addend. Output: low 64 bits of the sum.
+ * @param hi Input: high 64 bits of an addend. Output: high 64 bits of the sum.
+ * @param y_lo Low 64 bits of the other addend.
+ * @param y_hi High 64 bits of the other addend.
+ */
+INLINE
+void
+_prng_add128
+(   u64*        lo
+,   u64*        hi
+,   const u64   y_lo
+,   const u64   y_hi
+)
+{
+    const u64 x_lo = *lo;
+    *lo = x_lo + y_lo;
+    *hi = *hi + y_hi + ( *lo < x_lo );
+}
+
+/**
+ * @brief Advances a PCG64 state by one step of its LCG.
+ *
+ * @param s The state to advance.
+ */
+INLINE
+void
+_prng_pcg64_step
+(   u64* s
+)
+{
+    _prng_mul128 ( &s[ 0 ] , &s[ 1 ] , PRNG_PCG64_MULTIPLIER_LO , PRNG_PCG64_MULTIPLIER_HI );
+    _prng_add128 ( &s[ 0 ] , &s[ 1 ] , s[ 2 ] , s[ 3 ] );
+}
+
+/**
+ * @brief Advances a PCG64 state.
+ *
+ * @param s The state to advance.
+ * @return 64 random bits.
+ */
+INLINE
+u64
+_prng_pcg64
+(   u64* s
+)
+{
+    _prng_pcg64_step ( s );
+    return rotr64 ( s[ 1 ] ^ s[ 0 ] , s[ 1 ] >> 58 );
+}
+
+/**
+ * @brief Advances a PCG64 state by an arbitrary number of steps in
+ * O(log(steps)) (Brown, "Random Number Generation with Arbitrary Strides").
+ *
+ * @param s The state to advance.
+ * @param delta_lo Low 64 bits of the number of steps.
+ * @param delta_hi High 64 bits of the number of steps.
+ */
+void
+_prng_pcg64_advance
+(   u64*    s
+,   u64     delta_lo
+,   u64     delta_hi
+);
+
+/**
+ * @brief Generates 64 random bits.
+ *
+ * @param prng The generator to advance.
+ * @return 64 random bits.
+ */
+INLINE
+u64
+_prng_next
+(   prng_t* prng
+)
+{
+    return ( ( *prng ).algorithm == PRNG_PCG64 ) ? _prng_pcg64 ( ( *prng ).state )
+                                                 : _prng_xoshiro256ss ( ( *prng ).state )
+                                                 ;
+}
+
+void
+_prng_seed
+(   prng_t*         prng
+,   u64             seed
+,   PRNG_ALGORITHM  algorithm
+)
+{
+    if ( !prng )
+    {
+        LOGERROR ( "prng_seed: Missing argument: prng (output buffer)." );
+        return;
+    }
+    if ( algorithm >= PRNG_ALGORITHM_COUNT )
+    {
+        LOGERROR ( "prng_seed: Value of algorithm argument was invalid; falling back on xoshiro256**." );
+        algorithm = PRNG_XOSHIRO256SS;
+    }
+
+    ( *prng ).algorithm = algorithm;
+
+    if ( algorithm == PRNG_PCG64 )
+    {
+        // PCG64 reference seeding: increment is odd, state is stepped once
+        // either side of adding the initial state.
+        const u64 state_lo = _prng_splitmix64 ( &seed );
+        const u64 state_hi = _prng_splitmix64 ( &seed );
+        const u64 sequence_lo = _prng_splitmix64 ( &seed );
+        const u64 sequence_hi = _prng_splitmix64 ( &seed );
+        ( *prng ).state[ 0 ] = 0;
+        ( *prng ).state[ 1 ] = 0;
+        ( *prng ).state[ 2 ] = ( sequence_lo << 1 ) | 1;
+        ( *prng ).state[ 3 ] = ( sequence_hi << 1 ) | ( sequence_lo >> 63 );
+        _prng_pcg64_step ( ( *prng ).state );
+        _prng_add128 ( &( *prng ).state[ 0 ] , &( *prng ).state[ 1 ] , state_lo , state_hi );
+        _prng_pcg64_step ( ( *prng ).state );
+    }
+    else
+    {
+        // splitmix64 never outputs four zeros in a row, so the state is valid.
+        for ( u32 i = 0; i < 4; ++i )
+        {
+            ( *prng ).state[ i ] = _prng_splitmix64 ( &seed );
+        }
+    }
+}
+
+u64
+prng_next
+(   prng_t* prng
+)
+{
+    return _prng_next ( prng );
+}
+
+u64
+prng_bounded
+(   prng_t* prng
+,   u64     bound
+)
+{
+    u64 x = _prng_next ( prng );
+    if ( !bound )
+    {
+        return x;
+    }
+
+    u64 lo = x * bound;
+    if ( lo < bound )
+    {
+        const u64 threshold = ( -bound ) % bound;
+        while ( lo < threshold )
+        {
+            x = _prng_next ( prng );
+            lo = x * bound;
+        }
+    }
+    return mulhi64 ( x , bound );
+}
+
+i64
+prng_range
+(   prng_t* prng
+,   i64     min
+,   i64     max
+)
+{
+    // The span wraps to 0 for the full 64-bit range, which prng_bounded
+    // treats as unbounded.
+    return ( i64 )( ( u64 ) min + prng_bounded ( prng , ( u64 ) max - ( u64 ) min + 1 ) );
+}
+
+f32
+prng_f32
+(   prng_t* prng
+)
+{
+    return ( f32 )( _prng_next ( prng ) >> 40 ) * PRNG_F32_SCALE;
+}
+
+f64
+prng_f64
+(   prng_t* prng
+)
+{
+    return ( f64 )( _prng_next ( prng ) >> 11 ) * PRNG_F64_SCALE;
+}
+
+void
+prng_fill_u64
+(   prng_t* prng
+,   u64*    dst
+,   u64     count
+)
+{
+    // Work on a local copy so the state stays in registers.
+    prng_t local = *prng;
+    if ( local.algorithm == PRNG_PCG64 )
+    {
+        for ( u64 i = 0; i < count; ++i )
+        {
+            dst[ i ] = _prng_pcg64 ( local.state );
+        }
+    }
+    else
+    {
+        for ( u64 i = 0; i < count; ++i )
+        {
+            dst[ i ] = _prng_xoshiro256ss ( local.state );
+        }
+    }
+    *prng = local;
+}
+
+void
+prng_fill_f32
+(   prng_t* prng
+,   f32*    dst
+,   u64     count
+)
+{
+    prng_t local = *prng;
+    u64 i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const u64 x = _prng_next ( &local );
+        dst[ i ] = ( f32 )( x >> 40 ) * PRNG_F32_SCALE;
+        dst[ i + 1 ] = ( f32 )( ( x >> 8 ) & 0xFFFFFF ) * PRNG_F32_SCALE;
+    }
+    if ( i < count )
+    {
+        dst[ i ] = ( f32 )( _prng_next ( &local ) >> 40 ) * PRNG_F32_SCALE;
+    }
+    *prng = local;
+}
+
+void
+prng_fill_f64
+(   prng_t* prng
+,   f64*    dst
+,   u64     count
+)
+{
+    prng_t local = *prng;
+    for ( u64 i = 0; i < count; ++i )
+    {
+        dst[ i ] = ( f64 )( _prng_next ( &local ) >> 11 ) * PRNG_F64_SCALE;
+    }
+    *prng = local;
+}
+
+void
+prng_jump
+(   prng_t* prng
+)
+{
+    if ( ( *prng ).algorithm == PRNG_PCG64 )
+    {
+        _prng_pcg64_advance ( ( *prng ).state , 0 , 1 );
+        return;
+    }
+
+    // xoshiro256** jump polynomial (Blackman & Vigna).
+    static const u64 jump[] = { 0x180EC6D33CFD0ABAULL , 0xD5A61266F0C9392CULL
+                              , 0xA9582618E03FC9AAULL , 0x39ABDC4529B1661CULL
+                              };
+    u64* s = ( *prng ).state;
+    u64 t[ 4 ] = { 0 , 0 , 0 , 0 };
+    for ( u32 i = 0; i < 4; ++i )
+    {
+        for ( u32 b = 0; b < 64; ++b )
+        {
+            if ( jump[ i ] & ( ( u64 ) 1 << b ) )
+            {
+                t[ 0 ] ^= s[ 0 ];
+                t[ 1 ] ^= s[ 1 ];
+                t[ 2 ] ^= s[ 2 ];
+                t[ 3 ] ^= s[ 3 ];
+            }
+            _prng_xoshiro256ss ( s );
+        }
+    }
+    memory_copy ( s , t , sizeof ( t ) );
+}
+
+prng_t*
+prng_local
+( void )
+{
+    if ( !prng_local_seeded )
+    {
+        const f64 time = platform_absolute_time ();
+        u64 seed;
+        memory_copy ( &seed , &time , sizeof ( seed ) );
+        u64 count = atomic_fetch_add_u64 ( &prng_local_count , 1 , ATOMIC_RELAXED );
+        seed ^= _prng_splitmix64 ( &count );
+        prng_seed ( &prng_local_state , seed );
+        prng_local_seeded = true;
+    }
+    return &prng_local_state;
+}
+
+void
+_prng_pcg64_advance
+(   u64*    s
+,   u64     delta_lo
+,   u64     delta_hi
+)
+{
+    u64 multiplier_lo = PRNG_PCG64_MULTIPLIER_LO;
+    u64 multiplier_hi = PRNG_PCG64_MULTIPLIER_HI;
+    u64 increment_lo = s[ 2 ];
+    u64 increment_hi = s[ 3 ];
+    u64 accumulated_multiplier_lo = 1;
+    u64 accumulated_multiplier_hi = 0;
+    u64 accumulated_increment_lo = 0;
+    u64 accumulated_increment_hi = 0;
+
+    while ( delta_lo || delta_hi )
+    {
+        if ( delta_lo & 1 )
+        {
+            _prng_mul128 ( &accumulated_multiplier_lo , &accumulated_multiplier_hi
+                         , multiplier_lo , multiplier_hi
+                         );
+            _prng_mul128 ( &accumulated_increment_lo , &accumulated_increment_hi
+                         , multiplier_lo , multiplier_hi
+                         );
+            _prng_add128 ( &accumulated_increment_lo , &accumulated_increment_hi
+                         , increment_lo , increment_hi
+                         );
+        }
+
+        // increment = ( multiplier + 1 ) * increment
+        u64 factor_lo = multiplier_lo;
+        u64 factor_hi = multiplier_hi;
+        _prng_add128 ( &factor_lo , &factor_hi , 1 , 0 );
+        _prng_mul128 ( &increment_lo , &increment_hi , factor_lo , factor_hi );
+
+        // multiplier = multiplier * multiplier
+        const u64 square_lo = multiplier_lo;
+        const u64 square_hi = multiplier_hi;
+        _prng_mul128 ( &multiplier_lo , &multiplier_hi , square_lo , square_hi );
+
+        delta_lo = ( delta_lo >> 1 ) | ( delta_hi << 63 );
+        delta_hi >>= 1;
+    }
+
+    _prng_mul128 ( &s[ 0 ] , &s[ 1 ] , accumulated_multiplier_lo , accumulated_multiplier_hi );
+    _prng_add128 ( &s[ 0 ] , &s[ 1 ] , accumulated_increment_lo , accumulated_increment_hi );
+}
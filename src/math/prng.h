@@ -0,0 +1,204 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/prng.h
+ * @brief Seedable pseudorandom number generators with explicit state.
+ *
+ * Each generator is a small value owned by the caller, so threads which each
+ * own a generator never contend. Algorithms:
+ *   xoshiro256** : Default. Fastest; period 2^256 - 1.
+ *   PCG64        : Permuted 128-bit LCG (XSL-RR output); period 2^128.
+ * Seeds of any value are expanded with splitmix64, so nearby seeds produce
+ * unrelated streams.
+ *
+ * Neither algorithm is suitable for cryptography.
+ *
+ * The math_random family (see math/random.h) draws from a generator local to
+ * the calling thread (see prng_local).
+ */
+#ifndef MATH_PRNG_H
+#define MATH_PRNG_H
+
+#include "common.h"
+
+/** @brief Type and instance definitions for generator algorithms. */
+typedef enum
+{
+    PRNG_XOSHIRO256SS
+,   PRNG_PCG64
+
+,   PRNG_ALGORITHM_COUNT
+}
+PRNG_ALGORITHM;
+
+/**
+ * @brief Type definition for a generator. Opaque; initialize with prng_seed.
+ */
+typedef struct
+{
+    PRNG_ALGORITHM  algorithm;
+    u64             state[ 4 ]; // PCG64: state (lo, hi), increment (lo, hi).
+}
+prng_t;
+
+/**
+ * @brief Initializes a generator from a seed.
+ *
+ * Equal seeds (and algorithms) always produce the same sequence.
+ *
+ * @param prng Output buffer. Must be non-zero.
+ * @param seed The seed. Any value.
+ * @param algorithm The algorithm to use.
+ */
+void
+_prng_seed
+(   prng_t*         prng
+,   u64             seed
+,   PRNG_ALGORITHM  algorithm
+);
+
+#define prng_seed(prng,seed) \
+    _prng_seed ( (prng) , (seed) , PRNG_XOSHIRO256SS )
+
+/**
+ * @brief Generates 64 random bits.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @return 64 random bits.
+ */
+u64
+prng_next
+(   prng_t* prng
+);
+
+/**
+ * @brief Generates a uniformly distributed random integer in [ 0 , bound ).
+ *
+ * Unbiased (Lemire's multiply-shift method with rejection). The rejection
+ * threshold costs a division, but is only computed on the rare draws which
+ * could be biased.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @param bound The (exclusive) upper bound. Pass 0 for the full 64-bit range.
+ * @return A random integer in [ 0 , bound ).
+ */
+u64
+prng_bounded
+(   prng_t* prng
+,   u64     bound
+);
+
+/**
+ * @brief Generates a uniformly distributed random integer in [ min , max ].
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @param min lower bound (inclusive)
+ * @param max upper bound (inclusive). Must be at least min.
+ * @return A random integer in [ min , max ].
+ */
+i64
+prng_range
+(   prng_t* prng
+,   i64     min
+,   i64     max
+);
+
+/**
+ * @brief Generates a uniformly distributed random floating point number in
+ * [ 0.0 , 1.0 ), with 24 bits of precision.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @return A random floating point number in [ 0.0 , 1.0 ).
+ */
+f32
+prng_f32
+(   prng_t* prng
+);
+
+/**
+ * @brief Generates a uniformly distributed random floating point number in
+ * [ 0.0 , 1.0 ), with 53 bits of precision.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @return A random floating point number in [ 0.0 , 1.0 ).
+ */
+f64
+prng_f64
+(   prng_t* prng
+);
+
+/**
+ * @brief Fills an array with random 64-bit values.
+ *
+ * Produces the same values as count calls to prng_next, without the call
+ * overhead of each.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @param dst Output buffer for count values. Must be non-zero.
+ * @param count The number of values to generate.
+ */
+void
+prng_fill_u64
+(   prng_t* prng
+,   u64*    dst
+,   u64     count
+);
+
+/**
+ * @brief Fills an array with random floating point numbers in [ 0.0 , 1.0 ).
+ *
+ * Each 64-bit output yields two values.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @param dst Output buffer for count values. Must be non-zero.
+ * @param count The number of values to generate.
+ */
+void
+prng_fill_f32
+(   prng_t* prng
+,   f32*    dst
+,   u64     count
+);
+
+/**
+ * @brief Fills an array with random floating point numbers in [ 0.0 , 1.0 ).
+ *
+ * Produces the same values as count calls to prng_f64.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ * @param dst Output buffer for count values. Must be non-zero.
+ * @param count The number of values to generate.
+ */
+void
+prng_fill_f64
+(   prng_t* prng
+,   f64*    dst
+,   u64     count
+);
+
+/**
+ * @brief Advances a generator as if by a very large number of calls to
+ * prng_next: 2^128 (xoshiro256**) or 2^64 (PCG64).
+ *
+ * To give parallel workers non-overlapping streams, seed one generator, copy
+ * it to the first worker, then jump and copy for each subsequent worker.
+ *
+ * @param prng The generator to advance. Must be non-zero.
+ */
+void
+prng_jump
+(   prng_t* prng
+);
+
+/**
+ * @brief Queries the calling thread's generator.
+ *
+ * Seeded on first use from the clock and a process-wide counter, so each
+ * thread has its own stream and no locking is required.
+ *
+ * @return The calling thread's generator. Valid only on the calling thread.
+ */
+prng_t*
+prng_local
+( void );
+
+#endif  // MATH_PRNG_H
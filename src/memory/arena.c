@@ -0,0 +1,309 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/arena.c
+ * @brief Implementation of the memory/arena header.
+ * (see memory/arena.h for additional details)
+ */
+#include "memory/arena.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/clamp.h"
+
+/** @brief Type definition for a block header. The block content follows it. */
+typedef struct arena_block_t
+{
+    struct arena_block_t*   next;
+    u64                     capacity;
+    u64                     allocated;
+    u64                     padding;    // Keeps the content 16-byte aligned.
+}
+arena_block_t;
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64             block_size;
+    u64             capacity;
+
+    arena_block_t*  first;
+    arena_block_t*  current;
+}
+state_t;
+
+// Per-thread scratch arena (see arena_scratch).
+static THREAD_LOCAL arena_t* arena_scratch_state = 0;
+
+/**
+ * @brief Attempts to serve an allocation from a block.
+ *
+ * @param block The block.
+ * @param size The number of bytes to allocate.
+ * @param alignment The alignment of the allocation.
+ * @return The address of the allocated memory, or 0 if the block is full.
+ */
+INLINE
+void*
+_arena_block_allocate
+(   arena_block_t*  block
+,   const u64       size
+,   const u64       alignment
+)
+{
+    const u64 content = ( u64 )( block + 1 );
+    const u64 offset = aligned ( content + ( *block ).allocated , alignment ) - content;
+    if ( offset + size > ( *block ).capacity )
+    {
+        return 0;
+    }
+    ( *block ).allocated = offset + size;
+    return ( void* )( content + offset );
+}
+
+/**
+ * @brief Chains a new block onto the end of an arena.
+ *
+ * @param state Internal state arguments.
+ * @param capacity The capacity of the new block in bytes.
+ * @return The new block, on success. 0, on error.
+ */
+arena_block_t*
+_arena_block_create
+(   state_t*    state
+,   u64         capacity
+);
+
+bool
+arena_create
+(   u64         block_size
+,   arena_t**   arena
+)
+{
+    if ( !block_size || !arena )
+    {
+        if ( !block_size )
+        {
+            LOGERROR ( "arena_create: Value of block_size argument must be non-zero." );
+        }
+        if ( !arena )
+        {
+            LOGERROR ( "arena_create: Missing argument: arena (output buffer)." );
+        }
+        return false;
+    }
+
+    state_t* state = memory_allocate ( sizeof ( state_t ) , MEMORY_TAG_ARENA );
+    ( *state ).block_size = aligned ( block_size , ARENA_DEFAULT_ALIGNMENT );
+    ( *state ).capacity = 0;
+    ( *state ).first = 0;
+    ( *state ).current = 0;
+
+    // The first block is created up front, so that the allocation fast path
+    // never sees an empty arena.
+    if ( !_arena_block_create ( state , ( *state ).block_size ) )
+    {
+        memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_ARENA );
+        return false;
+    }
+    ( *state ).current = ( *state ).first;
+
+    *arena = state;
+    return true;
+}
+
+void
+arena_destroy
+(   arena_t** arena
+)
+{
+    if ( !arena || !*arena )
+    {
+        return;
+    }
+
+    state_t* state = *arena;
+    arena_block_t* block = ( *state ).first;
+    while ( block )
+    {
+        arena_block_t* next = ( *block ).next;
+        memory_free_aligned ( block
+                            , sizeof ( arena_block_t ) + ( *block ).capacity
+                            , ARENA_DEFAULT_ALIGNMENT
+                            , MEMORY_TAG_ARENA
+                            );
+        block = next;
+    }
+    memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_ARENA );
+    *arena = 0;
+}
+
+u64
+arena_allocated
+(   const arena_t* arena
+)
+{
+    const state_t* state = arena;
+    u64 allocated = 0;
+    for ( const arena_block_t* block = ( *state ).first; block; block = ( *block ).next )
+    {
+        allocated += ( *block ).allocated;
+        if ( block == ( *state ).current )
+        {
+            break;
+        }
+    }
+    return allocated;
+}
+
+u64
+arena_capacity
+(   const arena_t* arena
+)
+{
+    return ( *( ( const state_t* ) arena ) ).capacity;
+}
+
+void*
+_arena_allocate
+(   arena_t*    arena
+,   u64         size
+,   u64         alignment
+)
+{
+    if ( !size || !alignment || ( alignment & ( alignment - 1 ) ) )
+    {
+        if ( !size )
+        {
+            LOGERROR ( "arena_allocate: Value of size argument must be non-zero." );
+        }
+        else
+        {
+            LOGERROR ( "arena_allocate: Value of alignment argument must be a power of two." );
+        }
+        return 0;
+    }
+
+    state_t* state = arena;
+
+    void* memory = _arena_block_allocate ( ( *state ).current , size , alignment );
+    if ( memory )
+    {
+        return memory;
+    }
+
+    // Reuse blocks retained from before the last rewind, skipping any too
+    // small for this allocation.
+    arena_block_t* block = ( *state ).current;
+    while ( ( *block ).next )
+    {
+        block = ( *block ).next;
+        ( *block ).allocated = 0;
+        memory = _arena_block_allocate ( block , size , alignment );
+        if ( memory )
+        {
+            ( *state ).current = block;
+            return memory;
+        }
+    }
+
+    block = _arena_block_create ( state , MAX ( ( *state ).block_size
+                                              , size + alignment
+                                              ));
+    if ( !block )
+    {
+        return 0;
+    }
+    ( *state ).current = block;
+    return _arena_block_allocate ( block , size , alignment );
+}
+
+arena_mark_t
+arena_mark
+(   const arena_t* arena
+)
+{
+    const state_t* state = arena;
+    arena_mark_t mark;
+    mark.block = ( *state ).current;
+    mark.allocated = ( *( ( *state ).current ) ).allocated;
+    return mark;
+}
+
+void
+arena_rewind
+(   arena_t*        arena
+,   arena_mark_t    mark
+)
+{
+    state_t* state = arena;
+
+    // Blocks after the checkpoint are reset lazily, as allocation reaches them.
+    ( *state ).current = mark.block;
+    ( *( ( *state ).current ) ).allocated = mark.allocated;
+}
+
+void
+arena_clear
+(   arena_t* arena
+)
+{
+    state_t* state = arena;
+    ( *state ).current = ( *state ).first;
+    ( *( ( *state ).current ) ).allocated = 0;
+}
+
+arena_t*
+arena_scratch
+( void )
+{
+    if ( !arena_scratch_state )
+    {
+        arena_create ( ARENA_DEFAULT_BLOCK_SIZE , &arena_scratch_state );
+    }
+    return arena_scratch_state;
+}
+
+void
+arena_scratch_destroy
+( void )
+{
+    arena_destroy ( &arena_scratch_state );
+}
+
+arena_block_t*
+_arena_block_create
+(   state_t*    state
+,   u64         capacity
+)
+{
+    arena_block_t* block = memory_allocate_aligned ( sizeof ( arena_block_t ) + capacity
+                                                   , ARENA_DEFAULT_ALIGNMENT
+                                                   , MEMORY_TAG_ARENA
+                                                   );
+    if ( !block )
+    {
+        LOGERROR ( "arena_allocate: Failed to chain a new block of %u bytes." , capacity );
+        return 0;
+    }
+    ( *block ).next = 0;
+    ( *block ).capacity = capacity;
+    ( *block ).allocated = 0;
+
+    if ( !( *state ).first )
+    {
+        ( *state ).first = block;
+    }
+    else
+    {
+        arena_block_t* last = ( *state ).current;
+        while ( ( *last ).next )
+        {
+            last = ( *last ).next;
+        }
+        ( *last ).next = block;
+    }
+    ( *state ).capacity += capacity;
+
+    return block;
+}
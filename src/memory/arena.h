@@ -0,0 +1,183 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/arena.h
+ * @brief Provides an interface for a growable arena (region) allocator.
+ *
+ * Like a linear allocator (see memory/linear_allocator.h), an arena serves
+ * allocations by advancing an offset within a block of memory, and cannot free
+ * them individually. Unlike a linear allocator, when its current block fills,
+ * an arena chains another block from the global allocator rather than failing.
+ *
+ * Allocations are released in bulk, in O(1), either entirely (arena_clear) or
+ * back to a checkpoint (arena_mark / arena_rewind). Blocks are retained for
+ * reuse until the arena is destroyed, so an arena which is cleared after each
+ * request stops touching the global allocator once it has grown to fit the
+ * largest request.
+ *
+ *   arena_mark_t mark = arena_mark ( arena );
+ *   char* temporary = arena_allocate ( arena , size );
+ *   ...
+ *   arena_rewind ( arena , mark );
+ *
+ * Memory served by an arena is not cleared, and is not thread-safe; for
+ * temporaries on any thread, see arena_scratch.
+ */
+#ifndef MEMORY_ARENA_H
+#define MEMORY_ARENA_H
+
+#include "common.h"
+
+/** @brief Type declaration for an arena. */
+typedef void arena_t;
+
+/** @brief Type definition for an arena checkpoint (see arena_mark). */
+typedef struct
+{
+    void*   block;
+    u64     allocated;
+}
+arena_mark_t;
+
+/** @brief Defines arena default block size (see arena_create). */
+#define ARENA_DEFAULT_BLOCK_SIZE ( KiB ( 64 ) )
+
+/** @brief Defines arena default allocation alignment (see arena_allocate). */
+#define ARENA_DEFAULT_ALIGNMENT 16
+
+/**
+ * @brief Initializes an arena.
+ *
+ * Uses dynamic memory allocation (see core/memory.h). Call arena_destroy to
+ * free.
+ *
+ * @param block_size The capacity of each block in bytes. Allocations larger
+ * than this are served by a block of their own. Must be non-zero.
+ * @param arena Output buffer for arena.
+ * @return true on success; false otherwise.
+ */
+bool
+arena_create
+(   u64         block_size
+,   arena_t**   arena
+);
+
+/**
+ * @brief Frees the memory used by an arena, including every block it has
+ * chained.
+ *
+ * @param arena Handle to the arena to free.
+ */
+void
+arena_destroy
+(   arena_t** arena
+);
+
+/**
+ * @brief Queries the number of bytes currently allocated from an arena
+ * (including alignment padding).
+ *
+ * @param arena The arena to query. Must be non-zero.
+ * @return The number of bytes currently allocated.
+ */
+u64
+arena_allocated
+(   const arena_t* arena
+);
+
+/**
+ * @brief Queries the total capacity of the blocks held by an arena.
+ *
+ * @param arena The arena to query. Must be non-zero.
+ * @return The arena capacity in bytes.
+ */
+u64
+arena_capacity
+(   const arena_t* arena
+);
+
+/**
+ * @brief Allocates memory from an arena.
+ *
+ * Chains a new block if the current one is full. The memory is not cleared.
+ *
+ * @param arena The arena to mutate. Must be non-zero.
+ * @param size The number of bytes to allocate. Must be non-zero.
+ * @param alignment The alignment of the allocation. Must be a power of two.
+ * @return The address of the allocated memory, on success. 0, on error.
+ */
+void*
+_arena_allocate
+(   arena_t*    arena
+,   u64         size
+,   u64         alignment
+);
+
+#define arena_allocate(arena,size) \
+    _arena_allocate ( (arena) , (size) , ARENA_DEFAULT_ALIGNMENT )
+
+#define arena_allocate_aligned(arena,size,alignment) \
+    _arena_allocate ( (arena) , (size) , (alignment) )
+
+/**
+ * @brief Records the current position of an arena.
+ *
+ * @param arena The arena to query. Must be non-zero.
+ * @return A checkpoint which arena_rewind can return the arena to.
+ */
+arena_mark_t
+arena_mark
+(   const arena_t* arena
+);
+
+/**
+ * @brief Releases every allocation made from an arena since a checkpoint.
+ * O(1).
+ *
+ * Checkpoints nest: rewinding to a checkpoint invalidates any checkpoint taken
+ * after it.
+ *
+ * @param arena The arena to mutate. Must be non-zero.
+ * @param mark A checkpoint taken from arena by arena_mark.
+ */
+void
+arena_rewind
+(   arena_t*        arena
+,   arena_mark_t    mark
+);
+
+/**
+ * @brief Releases every allocation made from an arena. O(1).
+ *
+ * The arena keeps its blocks for reuse (see arena_destroy).
+ *
+ * @param arena The arena to mutate. Must be non-zero.
+ */
+void
+arena_clear
+(   arena_t* arena
+);
+
+/**
+ * @brief Queries the calling thread's scratch arena, creating it on first use.
+ *
+ * For temporaries which do not outlive a function: take a checkpoint on entry,
+ * and rewind to it on exit. The scratch arena uses ARENA_DEFAULT_BLOCK_SIZE.
+ *
+ * Each thread which uses its scratch arena must call arena_scratch_destroy
+ * before it exits.
+ *
+ * @return The calling thread's scratch arena, on success. 0, on error.
+ */
+arena_t*
+arena_scratch
+( void );
+
+/**
+ * @brief Frees the calling thread's scratch arena (see arena_scratch), if it
+ * has one.
+ */
+void
+arena_scratch_destroy
+( void );
+
+#endif  // MEMORY_ARENA_H
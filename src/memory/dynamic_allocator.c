@@ -12,6 +12,8 @@
 
 #include "container/freelist.h"
 
+#include "math/math.h"
+
 /** @brief Type definition for internal state. */
 typedef struct
 {
@@ -25,25 +27,64 @@ typedef struct
 }
 state_t;
 
-/** @brief Type definition for a container to hold memory allocation header info. */
-typedef struct
-{
-    void*   start;
-    u16     alignment;
-}
-header_t;
+/**
+ * @brief Type definition for a memory allocation header. Stored in the eight
+ * bytes immediately preceding each user memory block, packed as:
+ *   bits  0..31 : The size of the user memory block.
+ *   bits 32..47 : The offset of the user memory block from the start of its
+ *                 freelist node (at most alignment + 7).
+ *   bits 48..63 : The alignment of the user memory block.
+ * The freelist node size is recomputed from these on free, so no other
+ * bookkeeping is stored with the block.
+ */
+typedef u64 header_t;
 
-/** @brief Storage size (in bytes) of a node's user memory block. */
-#define SIZE_STORAGE \
-    sizeof ( u32 )
+/** @brief Computes the freelist node size of a memory allocation. */
+#define NODE_SIZE(size,alignment) \
+    ( ( alignment ) + sizeof ( header_t ) + ( size ) )
 
 /** @brief Maximum single allocation size. */
 #define MAX_SINGLE_ALLOCATION_SIZE \
     GiB ( 4 )
 
+/**
+ * @brief Keeps at least one unused node in the backend freelist of an
+ * allocator which owns its memory, by carving additional node storage from the
+ * region it manages, so that the next free cannot fail for lack of one. The
+ * storage is held until the allocator is destroyed.
+ * 
+ * @param state Internal state arguments.
+ */
+void
+dynamic_allocator_reserve_nodes
+(   state_t* state
+);
+
+/**
+ * @brief Reads the header of a user memory block.
+ * 
+ * @param memory The user memory block. Must be non-zero.
+ * @return The header.
+ */
+INLINE
+header_t
+_dynamic_allocator_header
+(   const void* memory
+)
+{
+    header_t header;
+    __builtin_memcpy ( &header
+                     , ( const void* )( ( ( u64 ) memory ) - sizeof ( header_t ) )
+                     , sizeof ( header_t )
+                     );
+    return header;
+}
+
 bool
-dynamic_allocator_create
+_dynamic_allocator_create
 (   u64                     capacity
+,   FREELIST_MODE           mode
+,   u64                     node_count
 ,   u64*                    memory_requirement_
 ,   void*                   memory_
 ,   dynamic_allocator_t**   allocator
@@ -56,7 +97,11 @@ dynamic_allocator_create
     }
 
     u64 freelist_memory_requirement = 0;
-    freelist_create ( capacity , &freelist_memory_requirement , 0 , 0 );
+    if ( !_freelist_create ( capacity , mode , node_count , &freelist_memory_requirement , 0 , 0 ) )
+    {
+        LOGERROR ( "dynamic_allocator_create: Failed to query the memory requirement of the backend freelist." );
+        return false;
+    }
     const u64 memory_requirement = freelist_memory_requirement
                                  + capacity
                                  + sizeof ( state_t )
@@ -101,11 +146,13 @@ dynamic_allocator_create
     ( *state ).owns_memory = !memory_;
 
     ( *state ).freelist_memory_requirement = freelist_memory_requirement;
-    if ( !freelist_create ( capacity
-                          , 0
-                          , ( void* )( ( ( u64 ) memory ) + sizeof ( state_t ) )
-                          , &( *state ).freelist
-                          ))
+    if ( !_freelist_create ( capacity
+                           , mode
+                           , node_count
+                           , 0
+                           , ( void* )( ( ( u64 ) memory ) + sizeof ( state_t ) )
+                           , &( *state ).freelist
+                           ))
     {
         LOGERROR ( "dynamic_allocator_create: Failed to initialize backend freelist." );
         if ( ( *state ).owns_memory )
@@ -122,7 +169,6 @@ dynamic_allocator_create
                                  + sizeof ( state_t )
                                  + ( *state ).freelist_memory_requirement
                                  );
-    memory_clear ( ( *state ).memory , capacity );
 
     *allocator = state;
     return true;
@@ -158,8 +204,9 @@ dynamic_allocator_destroy
                     );
     }
     else
-    {
-        memory_clear ( state , memory_requirement );
+    {   // The content is not cleared, so that a caller-supplied buffer which is
+        // committed on demand (see core/memory.h) is not touched in full.
+        memory_clear ( state , memory_requirement - ( *state ).capacity );
     }
 
     *allocator = 0;
@@ -199,9 +246,7 @@ dynamic_allocator_allocate_aligned
 {
     state_t* state = allocator;
 
-    const u64 header_size = sizeof ( header_t );
-    const u64 storage_size = SIZE_STORAGE;
-    const u64 required_size = alignment + header_size + storage_size + size;
+    const u64 required_size = NODE_SIZE ( size , alignment );
 
     if ( required_size >= MAX_SINGLE_ALLOCATION_SIZE )
     {
@@ -236,14 +281,94 @@ dynamic_allocator_allocate_aligned
         return 0;
     }
 
-    void* memory = ( void* )( ( ( u64 )( ( *state ).memory ) ) + base_offset );
-    u64 memory_offset = aligned ( ( ( u64 ) memory ) + SIZE_STORAGE , alignment );
-    u32* memory_size = ( u32* )( memory_offset - SIZE_STORAGE );
-    *memory_size = ( u32 ) size;
-    header_t* header = ( header_t* )( memory_offset + size );
-    ( *header ).start = memory;
-    ( *header ).alignment = alignment;
-    return ( void* ) memory_offset;
+    const u64 start = ( ( u64 )( ( *state ).memory ) ) + base_offset;
+    const u64 memory = aligned ( start + sizeof ( header_t ) , alignment );
+    const header_t header = size
+                          | ( ( memory - start ) << 32 )
+                          | ( ( ( u64 ) alignment ) << 48 )
+                          ;
+    __builtin_memcpy ( ( void* )( memory - sizeof ( header_t ) )
+                     , &header
+                     , sizeof ( header_t )
+                     );
+    dynamic_allocator_reserve_nodes ( state );
+    return ( void* ) memory;
+}
+
+bool
+dynamic_allocator_resize
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+)
+{
+    state_t* state = allocator;
+
+    const header_t header = _dynamic_allocator_header ( memory );
+    const u64 old_size = header & 0xFFFFFFFF;
+    const u16 alignment = header >> 48;
+    if ( size == old_size )
+    {
+        return true;
+    }
+
+    const u64 old_node_size = NODE_SIZE ( old_size , alignment );
+    const u64 new_node_size = NODE_SIZE ( size , alignment );
+    const u64 offset = ( ( u64 ) memory )
+                     - ( header >> 32 & 0xFFFF )
+                     - ( ( u64 )( ( *state ).memory ) )
+                     ;
+
+    if ( new_node_size < MAX_SINGLE_ALLOCATION_SIZE )
+    {
+        const bool in_place = ( new_node_size > old_node_size )
+                            ? freelist_extend ( ( *state ).freelist
+                                              , old_node_size
+                                              , offset
+                                              , new_node_size - old_node_size
+                                              )
+                            : freelist_free ( ( *state ).freelist
+                                            , old_node_size - new_node_size
+                                            , offset + new_node_size
+                                            )
+                            ;
+        if ( in_place )
+        {
+            const header_t new_header = ( header & ~( ( u64 ) 0xFFFFFFFF ) ) | size;
+            __builtin_memcpy ( ( void* )( ( ( u64 ) memory ) - sizeof ( header_t ) )
+                             , &new_header
+                             , sizeof ( header_t )
+                             );
+            dynamic_allocator_reserve_nodes ( state );
+            return true;
+        }
+    }
+    return false;
+}
+
+void*
+dynamic_allocator_reallocate
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+)
+{
+    if ( dynamic_allocator_resize ( allocator , memory , size ) )
+    {
+        return memory;
+    }
+
+    const header_t header = _dynamic_allocator_header ( memory );
+    const u64 old_size = header & 0xFFFFFFFF;
+    const u16 alignment = header >> 48;
+    void* new_memory = dynamic_allocator_allocate_aligned ( allocator , size , alignment );
+    if ( !new_memory )
+    {
+        return 0;
+    }
+    memory_copy ( new_memory , memory , MIN ( size , old_size ) );
+    dynamic_allocator_free_sized ( allocator , memory , old_size , alignment );
+    return new_memory;
 }
 
 bool
@@ -276,15 +401,12 @@ dynamic_allocator_free_aligned
         return false;
     }
 
-    u32* size = ( u32* )( ( ( u64 ) memory ) - SIZE_STORAGE );
-    header_t* header = ( header_t* )( ( ( u64 ) memory ) + *size );
-    u64 offset = ( ( u64 )( ( *header ).start ) )
-               - ( ( u64 )( ( *state ).memory ) );
-    u64 required_size = ( *header ).alignment
-                      + sizeof ( header_t )
-                      + SIZE_STORAGE
-                      + *size
-                      ;
+    const header_t header = _dynamic_allocator_header ( memory );
+    const u64 offset = ( ( u64 ) memory )
+                     - ( header >> 32 & 0xFFFF )
+                     - ( ( u64 )( ( *state ).memory ) )
+                     ;
+    const u64 required_size = NODE_SIZE ( header & 0xFFFFFFFF , header >> 48 );
 
     if ( !freelist_free ( ( *state ).freelist
                         , required_size
@@ -295,6 +417,55 @@ dynamic_allocator_free_aligned
         return false;
     }
 
+    dynamic_allocator_reserve_nodes ( state );
+    return true;
+}
+
+bool
+dynamic_allocator_free_sized
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+,   u16                     alignment
+)
+{
+    state_t* state = allocator;
+
+    if ( !dynamic_allocator_contains ( allocator , memory ) )
+    {
+        LOGWARN ( "dynamic_allocator_free: Trying to release block [%@] outside of allocator range [%@ .. %@]."
+                , memory
+                , ( *state ).memory
+                , ( *state ).memory + ( *state ).capacity
+                );
+        return false;
+    }
+
+    const header_t header = _dynamic_allocator_header ( memory );
+    if ( ( header & 0xFFFFFFFF ) != size || ( header >> 48 ) != alignment )
+    {
+        LOGERROR ( "dynamic_allocator_free: Block [%@] was allocated with size %u and alignment %u, but freed with size %u and alignment %u."
+                 , memory
+                 , header & 0xFFFFFFFF , header >> 48
+                 , size , alignment
+                 );
+        return false;
+    }
+
+    const u64 offset = ( ( u64 ) memory )
+                     - ( header >> 32 & 0xFFFF )
+                     - ( ( u64 )( ( *state ).memory ) )
+                     ;
+    if ( !freelist_free ( ( *state ).freelist
+                        , NODE_SIZE ( size , alignment )
+                        , offset
+                        ))
+    {
+        LOGERROR ( "dynamic_allocator_free: Failed to free memory." );
+        return false;
+    }
+
+    dynamic_allocator_reserve_nodes ( state );
     return true;
 }
 
@@ -305,12 +476,24 @@ dynamic_allocator_size_alignment
 ,   u16*    alignment
 )
 {
-    *size = *( ( u32* )( ( ( u64 ) memory ) - SIZE_STORAGE ) );
-    header_t* header = ( header_t* )( ( ( u64 ) memory ) + *size );
-    *alignment = ( *header ).alignment;
+    const header_t header = _dynamic_allocator_header ( memory );
+    *size = header & 0xFFFFFFFF;
+    *alignment = header >> 48;
     return true;
 }
 
+bool
+dynamic_allocator_contains
+(   const dynamic_allocator_t*  allocator
+,   const void*                 memory
+)
+{
+    const state_t* state = allocator;
+    return memory >= ( *state ).memory
+        && memory < ( *state ).memory + ( *state ).capacity
+        ;
+}
+
 // Expensive!
 u64
 dynamic_allocator_query_free
@@ -320,9 +503,60 @@ dynamic_allocator_query_free
     return freelist_query_free ( ( *( ( state_t* ) allocator ) ).freelist );
 }
 
+f64
+dynamic_allocator_query_fragmentation
+(   const dynamic_allocator_t* allocator
+)
+{
+    return freelist_query_fragmentation ( ( *( ( state_t* ) allocator ) ).freelist );
+}
+
+u64
+dynamic_allocator_query_unused_nodes
+(   const dynamic_allocator_t* allocator
+)
+{
+    return freelist_query_unused_nodes ( ( *( ( state_t* ) allocator ) ).freelist );
+}
+
+bool
+dynamic_allocator_add_nodes
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+)
+{
+    return freelist_add_nodes ( ( *( ( state_t* ) allocator ) ).freelist
+                              , memory
+                              , size
+                              );
+}
+
 u64
 dynamic_allocator_header_size
 ( void ) 
 {
-    return sizeof ( header_t ) + SIZE_STORAGE;
+    return sizeof ( header_t );
+}
+
+void
+dynamic_allocator_reserve_nodes
+(   state_t* state
+)
+{
+    // Room to align the storage to eight bytes.
+    const u64 size = DYNAMIC_ALLOCATOR_NODE_STORAGE_SIZE + 7;
+    u64 offset;
+    if (   !( *state ).owns_memory
+        || freelist_query_unused_nodes ( ( *state ).freelist )
+        || freelist_query_largest_free ( ( *state ).freelist ) < size
+        || !freelist_allocate ( ( *state ).freelist , size , &offset )
+       )
+    {
+        return;
+    }
+    freelist_add_nodes ( ( *state ).freelist
+                       , ( void* ) aligned ( ( ( u64 )( *state ).memory ) + offset , 8 )
+                       , DYNAMIC_ALLOCATOR_NODE_STORAGE_SIZE
+                       );
 }
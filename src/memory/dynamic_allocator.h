@@ -8,12 +8,23 @@
 
 #include "common.h"
 
+#include "container/freelist.h"
+
 /** @brief Type declaration for a linear allocator. */
 typedef void dynamic_allocator_t;
 
+/**
+ * @brief Size (in bytes) of each block of additional node storage carved from
+ * the managed region for the backend freelist (see dynamic_allocator_add_nodes).
+ */
+#define DYNAMIC_ALLOCATOR_NODE_STORAGE_SIZE ( KiB ( 4 ) )
+
 /**
  * @brief Initializes a dynamic allocator.
  * 
+ * Use dynamic_allocator_create to initialize a dynamic allocator backed by a
+ * first-fit freelist.
+ * 
  * If pre-allocating a memory buffer:
  *   Call once to get the memory requirement; call a second time passing in a
  *   valid memory buffer of the required size.
@@ -22,7 +33,19 @@ typedef void dynamic_allocator_t;
  *   Uses dynamic memory allocation (see core/memory.h). Call
  *   dynamic_allocator_destroy to free.
  * 
+ * Free blocks are tracked by the nodes of the backend freelist. Whenever its
+ * last unused node is taken, an allocator using implicit memory allocation
+ * carves DYNAMIC_ALLOCATOR_NODE_STORAGE_SIZE bytes of additional node storage
+ * from the region it manages, so that freeing into many small holes never
+ * fails for lack of a node, and the freelist is never resized; a pre-allocated
+ * allocator leaves this to the caller, who may commit the region on demand
+ * (see dynamic_allocator_add_nodes).
+ * 
  * @param capacity The requested capacity in bytes.
+ * @param mode The allocation strategy of the backend freelist
+ * (see container/freelist.h).
+ * @param node_count The number of backend freelist nodes to pre-allocate, or 0
+ * for the default (see _freelist_create).
  * @param memory_requirement Output buffer to hold the actual number of bytes
  * required to operate the dynamic allocator. Only applicable if pre-allocating
  * a memory buffer of the required size. Pass 0 to use implicit memory
@@ -34,13 +57,25 @@ typedef void dynamic_allocator_t;
  * @return true on success; false otherwise.
  */
 bool
-dynamic_allocator_create
+_dynamic_allocator_create
 (   u64                     capacity
+,   FREELIST_MODE           mode
+,   u64                     node_count
 ,   u64*                    memory_requirement
 ,   void*                   memory
 ,   dynamic_allocator_t**   allocator
 );
 
+/** @brief Alias for calling _dynamic_allocator_create with FREELIST_MODE_FIRST_FIT. */
+#define dynamic_allocator_create(capacity,memory_requirement,memory,allocator) \
+    _dynamic_allocator_create ( (capacity)                                     \
+                              , FREELIST_MODE_FIRST_FIT                        \
+                              , 0                                              \
+                              , (memory_requirement)                           \
+                              , (memory)                                       \
+                              , (allocator)                                    \
+                              )
+
 /**
  * @brief Frees the memory used by a dynamic allocator.
  * 
@@ -110,6 +145,48 @@ dynamic_allocator_allocate_aligned
 ,   u16                     alignment
 );
 
+/**
+ * @brief Resizes a block of memory previously allocated by a dynamic allocator
+ * in place, without moving it.
+ * 
+ * Grows the block if the space immediately following it is free, and shrinks
+ * it by releasing its tail. Bytes beyond the old size are not initialized.
+ * 
+ * @param allocator The allocator to mutate. Must be non-zero.
+ * @param memory The memory block to resize. Must be non-zero.
+ * @param size The new size in bytes. Must be non-zero.
+ * @return true if the block was resized; false otherwise (in which case memory
+ * is left intact).
+ */
+bool
+dynamic_allocator_resize
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+);
+
+/**
+ * @brief Resizes a block of memory previously allocated by a dynamic allocator,
+ * preserving its content and alignment.
+ * 
+ * Grows the block in place if the space immediately following it is free, and
+ * shrinks it in place by releasing its tail; otherwise, allocates a new block,
+ * copies the content and frees the old block. Bytes beyond the old size are
+ * not initialized.
+ * 
+ * @param allocator The allocator to mutate. Must be non-zero.
+ * @param memory The memory block to resize. Must be non-zero.
+ * @param size The new size in bytes. Must be non-zero.
+ * @return The address of the resized block (which may equal memory), on
+ * success. 0, on error (in which case memory is left intact).
+ */
+void*
+dynamic_allocator_reallocate
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+);
+
 /**
  * @brief Frees a single block of memory previously allocated by a dynamic
  * allocator.
@@ -138,6 +215,28 @@ dynamic_allocator_free_aligned
 ,   void*                   memory
 );
 
+/**
+ * @brief Variant of dynamic_allocator_free_aligned for callers which already
+ * know the size and alignment of the block (see memory_free).
+ * 
+ * Computes the size of the underlying freelist node from its arguments rather
+ * than from the block header, and cross-checks them against it: a mismatch is
+ * logged and the block is not freed.
+ * 
+ * @param allocator The allocator to mutate. Must be non-zero.
+ * @param memory The memory block to free. Must be non-zero.
+ * @param size The size the block was allocated with.
+ * @param alignment The alignment the block was allocated with.
+ * @return true on success; false otherwise.
+ */
+bool
+dynamic_allocator_free_sized
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+,   u16                     alignment
+);
+
 /**
  * @brief Computes the size and alignment of the given block of memory.
  * 
@@ -156,10 +255,21 @@ dynamic_allocator_size_alignment
 );
 
 /**
- * @brief Query free space remaining for an allocator.
+ * @brief Queries whether a block of memory lies within the range managed by an
+ * allocator.
  * 
- * This function is expensive and should be used sparingly, but it is useful for
- * unit testing.
+ * @param allocator The allocator to query. Must be non-zero.
+ * @param memory The block of memory.
+ * @return true if memory lies within the allocator range; false otherwise.
+ */
+bool
+dynamic_allocator_contains
+(   const dynamic_allocator_t*  allocator
+,   const void*                 memory
+);
+
+/**
+ * @brief Query free space remaining for an allocator. O(1).
  * 
  * @param allocator The allocator to query. Must be non-zero.
  * @return The number of free bytes of space remaining.
@@ -169,10 +279,58 @@ dynamic_allocator_query_free
 (   const dynamic_allocator_t* allocator
 );
 
+/**
+ * @brief Queries the external fragmentation of a dynamic allocator (see
+ * freelist_query_fragmentation).
+ * 
+ * @param allocator The allocator to query. Must be non-zero.
+ * @return The fragmentation in [ 0 , 1 ] (0 if there is no free space).
+ */
+f64
+dynamic_allocator_query_fragmentation
+(   const dynamic_allocator_t* allocator
+);
+
+/**
+ * @brief Queries the number of unused nodes of the backend freelist of a
+ * dynamic allocator (see freelist_query_unused_nodes).
+ * 
+ * @param allocator The allocator to query. Must be non-zero.
+ * @return The number of unused nodes.
+ */
+u64
+dynamic_allocator_query_unused_nodes
+(   const dynamic_allocator_t* allocator
+);
+
+/**
+ * @brief Supplies the backend freelist of a dynamic allocator with additional
+ * node storage (see freelist_add_nodes).
+ * 
+ * Intended for a pre-allocated allocator, which does not grow its node storage
+ * on its own (see _dynamic_allocator_create): its owner allocates the storage
+ * from the allocator itself once the allocator runs out of unused nodes. The
+ * storage must remain allocated until the allocator is destroyed.
+ * 
+ * @param allocator The allocator to mutate. Must be non-zero.
+ * @param memory The buffer. Must be aligned to at least eight bytes.
+ * @param size The size of memory in bytes.
+ * @return true on success; false otherwise.
+ */
+bool
+dynamic_allocator_add_nodes
+(   dynamic_allocator_t*    allocator
+,   void*                   memory
+,   u64                     size
+);
+
 /**
  * @brief Computes the header size of a dynamic allocator's internal data
  * structure.
  * 
+ * Each allocation of size bytes at a given alignment occupies at most
+ * size + alignment + header size bytes of the allocator's capacity.
+ * 
  * This function is useful for unit testing.
  * 
  * @return The header size of an allocator data structure (in bytes).
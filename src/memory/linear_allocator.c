@@ -52,9 +52,9 @@ linear_allocator_create
     }
     else
     {
-        memory = memory_allocate ( memory_requirement
-                                 , MEMORY_TAG_LINEAR_ALLOCATOR
-                                 );
+        memory = memory_allocate_uninit ( memory_requirement
+                                        , MEMORY_TAG_LINEAR_ALLOCATOR
+                                        );
     }
 
     if ( !allocator )
@@ -0,0 +1,358 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/pool_allocator.c
+ * @brief Implementation of the memory/pool_allocator header.
+ * (see memory/pool_allocator.h for additional details)
+ */
+#include "memory/pool_allocator.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "platform/lock.h"
+
+/**
+ * @brief Alignment of the first block of every slab. A cache line, so that
+ * blocks whose stride is a multiple of CACHE_LINE_SIZE never straddle one.
+ */
+#define POOL_ALLOCATOR_SLAB_ALIGNMENT CACHE_LINE_SIZE
+
+/** @brief Type definition for a slab header. The slab content follows it. */
+typedef struct slab_t
+{
+    struct slab_t*  next;
+}
+slab_t;
+
+/** @brief Size of a slab header, padded to keep the slab content aligned. */
+#define POOL_ALLOCATOR_SLAB_HEADER_SIZE \
+    aligned ( sizeof ( slab_t ) , POOL_ALLOCATOR_SLAB_ALIGNMENT )
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64     stride;
+    u64     slab_capacity;
+    u64     capacity;
+    u64     allocated;
+
+    void*   free;           // Intrusive free list (each block stores the next).
+    u8*     bump;           // Next never-allocated block in the newest slab.
+    u8*     bump_end;       // End of the newest slab.
+
+    slab_t* slabs;          // Chained slabs (excludes the first).
+
+    lock_t  lock;           // Only held by cache refill and drain.
+    bool    owns_memory;
+}
+state_t;
+
+/**
+ * @brief Chains a new slab onto a pool allocator.
+ * 
+ * @param state Internal state arguments.
+ * @return true on success; false otherwise.
+ */
+bool
+_pool_allocator_grow
+(   state_t* state
+);
+
+bool
+pool_allocator_create
+(   u64                 stride
+,   u64                 capacity
+,   u64*                memory_requirement_
+,   void*               memory_
+,   pool_allocator_t**  allocator
+)
+{
+    if ( !stride || !capacity )
+    {
+        if ( !stride )
+        {
+            LOGERROR ( "pool_allocator_create: Value of stride argument must be non-zero." );
+        }
+        if ( !capacity )
+        {
+            LOGERROR ( "pool_allocator_create: Value of capacity argument must be non-zero." );
+        }
+        return false;
+    }
+
+    stride = aligned ( stride , sizeof ( void* ) );
+    const u64 header_size = aligned ( sizeof ( state_t ) , POOL_ALLOCATOR_SLAB_ALIGNMENT );
+    const u64 memory_requirement = header_size + stride * capacity;
+    if ( memory_requirement_ )
+    {
+        *memory_requirement_ = memory_requirement;
+        if ( !memory_ )
+        {
+            return true;
+        }
+    }
+
+    if ( !allocator )
+    {
+        LOGERROR ( "pool_allocator_create: Missing argument: allocator (output buffer)." );
+        return false;
+    }
+
+    void* memory;
+    if ( memory_ )
+    {
+        memory = memory_;
+    }
+    else
+    {
+        memory = memory_allocate_aligned ( memory_requirement
+                                         , POOL_ALLOCATOR_SLAB_ALIGNMENT
+                                         , MEMORY_TAG_POOL_ALLOCATOR
+                                         );
+    }
+
+    // Only the state is cleared; blocks are initialized lazily, as the bump
+    // pointer first reaches them.
+    state_t* state = memory;
+    memory_clear ( state , sizeof ( state_t ) );
+    ( *state ).stride = stride;
+    ( *state ).slab_capacity = capacity;
+    ( *state ).capacity = capacity;
+    ( *state ).owns_memory = !memory_;
+    ( *state ).bump = ( ( u8* ) state ) + header_size;
+    ( *state ).bump_end = ( *state ).bump + stride * capacity;
+
+    *allocator = state;
+    return true;
+}
+
+void
+pool_allocator_destroy
+(   pool_allocator_t** allocator
+)
+{
+    if ( !allocator )
+    {
+        return;
+    }
+
+    state_t* state = *allocator;
+    if ( !state )
+    {
+        return;
+    }
+
+    const u64 slab_size = ( *state ).stride * ( *state ).slab_capacity;
+    slab_t* slab = ( *state ).slabs;
+    while ( slab )
+    {
+        slab_t* next = ( *slab ).next;
+        memory_free_aligned ( slab
+                            , POOL_ALLOCATOR_SLAB_HEADER_SIZE + slab_size
+                            , POOL_ALLOCATOR_SLAB_ALIGNMENT
+                            , MEMORY_TAG_POOL_ALLOCATOR
+                            );
+        slab = next;
+    }
+
+    if ( ( *state ).owns_memory )
+    {
+        memory_free_aligned ( state
+                            , aligned ( sizeof ( state_t ) , POOL_ALLOCATOR_SLAB_ALIGNMENT ) + slab_size
+                            , POOL_ALLOCATOR_SLAB_ALIGNMENT
+                            , MEMORY_TAG_POOL_ALLOCATOR
+                            );
+    }
+    else
+    {
+        memory_clear ( state , sizeof ( state_t ) );
+    }
+
+    *allocator = 0;
+}
+
+u64
+pool_allocator_stride
+(   const pool_allocator_t* allocator
+)
+{
+    return ( *( ( state_t* ) allocator ) ).stride;
+}
+
+u64
+pool_allocator_allocated
+(   const pool_allocator_t* allocator
+)
+{
+    return ( *( ( state_t* ) allocator ) ).allocated;
+}
+
+u64
+pool_allocator_capacity
+(   const pool_allocator_t* allocator
+)
+{
+    return ( *( ( state_t* ) allocator ) ).capacity;
+}
+
+bool
+pool_allocator_owns_memory
+(   const pool_allocator_t* allocator
+)
+{
+    return ( *( ( state_t* ) allocator ) ).owns_memory;
+}
+
+void*
+pool_allocator_allocate
+(   pool_allocator_t* allocator
+)
+{
+    state_t* state = allocator;
+
+    void* block = ( *state ).free;
+    if ( block )
+    {
+        ( *state ).free = *( ( void** ) block );
+    }
+    else
+    {
+        if ( ( *state ).bump == ( *state ).bump_end && !_pool_allocator_grow ( state ) )
+        {
+            return 0;
+        }
+        block = ( *state ).bump;
+        ( *state ).bump += ( *state ).stride;
+    }
+
+    ( *state ).allocated += 1;
+    return block;
+}
+
+void
+pool_allocator_free
+(   pool_allocator_t*   allocator
+,   void*               memory
+)
+{
+    state_t* state = allocator;
+    *( ( void** ) memory ) = ( *state ).free;
+    ( *state ).free = memory;
+    ( *state ).allocated -= 1;
+}
+
+void
+pool_allocator_cache_init
+(   pool_allocator_cache_t* cache
+,   pool_allocator_t*       allocator
+)
+{
+    ( *cache ).allocator = allocator;
+    ( *cache ).count = 0;
+}
+
+void*
+pool_allocator_cache_allocate
+(   pool_allocator_cache_t* cache
+)
+{
+    if ( !( *cache ).count )
+    {
+        state_t* state = ( *cache ).allocator;
+        lock_acquire ( &( *state ).lock );
+        while ( ( *cache ).count < POOL_ALLOCATOR_CACHE_BATCH_SIZE )
+        {
+            void* block = pool_allocator_allocate ( state );
+            if ( !block )
+            {
+                break;
+            }
+            ( *cache ).blocks[ ( *cache ).count ] = block;
+            ( *cache ).count += 1;
+        }
+        lock_release ( &( *state ).lock );
+        if ( !( *cache ).count )
+        {
+            return 0;
+        }
+    }
+    ( *cache ).count -= 1;
+    return ( *cache ).blocks[ ( *cache ).count ];
+}
+
+void
+pool_allocator_cache_free
+(   pool_allocator_cache_t* cache
+,   void*                   memory
+)
+{
+    if ( ( *cache ).count == POOL_ALLOCATOR_CACHE_CAPACITY )
+    {
+        state_t* state = ( *cache ).allocator;
+        lock_acquire ( &( *state ).lock );
+        for ( u64 i = 0; i < POOL_ALLOCATOR_CACHE_BATCH_SIZE; ++i )
+        {
+            pool_allocator_free ( state , ( *cache ).blocks[ i ] );
+        }
+        lock_release ( &( *state ).lock );
+        ( *cache ).count -= POOL_ALLOCATOR_CACHE_BATCH_SIZE;
+        memory_move ( ( *cache ).blocks
+                    , ( *cache ).blocks + POOL_ALLOCATOR_CACHE_BATCH_SIZE
+                    , ( *cache ).count * sizeof ( void* )
+                    );
+    }
+    ( *cache ).blocks[ ( *cache ).count ] = memory;
+    ( *cache ).count += 1;
+}
+
+void
+pool_allocator_cache_flush
+(   pool_allocator_cache_t* cache
+)
+{
+    if ( !( *cache ).count )
+    {
+        return;
+    }
+    state_t* state = ( *cache ).allocator;
+    lock_acquire ( &( *state ).lock );
+    for ( u64 i = 0; i < ( *cache ).count; ++i )
+    {
+        pool_allocator_free ( state , ( *cache ).blocks[ i ] );
+    }
+    lock_release ( &( *state ).lock );
+    ( *cache ).count = 0;
+}
+
+bool
+_pool_allocator_grow
+(   state_t* state
+)
+{
+    if ( !( *state ).owns_memory )
+    {
+        LOGERROR ( "pool_allocator_allocate: Pool is full (%u blocks), and cannot grow because its memory was pre-allocated."
+                 , ( *state ).capacity
+                 );
+        return false;
+    }
+
+    const u64 slab_size = ( *state ).stride * ( *state ).slab_capacity;
+    slab_t* slab = memory_allocate_aligned ( POOL_ALLOCATOR_SLAB_HEADER_SIZE + slab_size
+                                           , POOL_ALLOCATOR_SLAB_ALIGNMENT
+                                           , MEMORY_TAG_POOL_ALLOCATOR
+                                           );
+    if ( !slab )
+    {
+        LOGERROR ( "pool_allocator_allocate: Failed to chain a new slab of %u blocks."
+                 , ( *state ).slab_capacity
+                 );
+        return false;
+    }
+    ( *slab ).next = ( *state ).slabs;
+    ( *state ).slabs = slab;
+    ( *state ).capacity += ( *state ).slab_capacity;
+    ( *state ).bump = ( ( u8* ) slab ) + POOL_ALLOCATOR_SLAB_HEADER_SIZE;
+    ( *state ).bump_end = ( *state ).bump + slab_size;
+    return true;
+}
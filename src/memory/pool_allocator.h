@@ -0,0 +1,215 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/pool_allocator.h
+ * @brief Provides an interface for a fixed-size object pool allocator.
+ *
+ * A pool serves blocks of a single size (its stride). Free blocks are threaded
+ * onto an intrusive free list through their own first bytes, so allocation and
+ * release are each a single pointer swap, with no search and no per-block
+ * header. Memory is carved from slabs of a fixed number of blocks; a pool
+ * which owns its memory chains another slab when full.
+ *
+ * A pool is not thread-safe. To share one between threads, access it only
+ * through per-thread caches (see pool_allocator_cache_t), which take the pool
+ * lock once per batch of blocks rather than once per block.
+ */
+#ifndef MEMORY_POOL_ALLOCATOR_H
+#define MEMORY_POOL_ALLOCATOR_H
+
+#include "common.h"
+
+/** @brief Type declaration for a pool allocator. */
+typedef void pool_allocator_t;
+
+/** @brief Defines the maximum number of blocks held by a per-thread cache. */
+#define POOL_ALLOCATOR_CACHE_CAPACITY 64
+
+/** @brief Defines the number of blocks moved per cache refill or drain. */
+#define POOL_ALLOCATOR_CACHE_BATCH_SIZE ( POOL_ALLOCATOR_CACHE_CAPACITY / 2 )
+
+/**
+ * @brief Type definition for a per-thread pool cache. Owned by a single thread;
+ * initialize with pool_allocator_cache_init.
+ */
+typedef struct
+{
+    pool_allocator_t*   allocator;
+    u64                 count;
+    void*               blocks[ POOL_ALLOCATOR_CACHE_CAPACITY ];
+}
+pool_allocator_cache_t;
+
+/**
+ * @brief Initializes a pool allocator.
+ * 
+ * If pre-allocating a memory buffer:
+ *   Call once to get the memory requirement; call a second time passing in a
+ *   valid memory buffer of the required size. The pool cannot grow beyond
+ *   capacity blocks.
+ * 
+ * If using implicit memory allocation:
+ *   Uses dynamic memory allocation (see core/memory.h). Call
+ *   pool_allocator_destroy to free. The pool chains another slab of capacity
+ *   blocks whenever it is full.
+ * 
+ * @param stride The size of each block in bytes. Rounded up to a multiple of
+ * the pointer size. Must be non-zero. If a multiple of CACHE_LINE_SIZE, and
+ * memory is allocated implicitly, every block is aligned to a cache line.
+ * @param capacity The number of blocks per slab. Must be non-zero.
+ * @param memory_requirement Output buffer to hold the actual number of bytes
+ * required to operate the allocator. Only applicable if pre-allocating a memory
+ * buffer of the required size. Pass 0 to use implicit memory allocation.
+ * @param memory Optional pre-allocated memory buffer. Only applicable if
+ * memory is being pre-allocated. Pass 0 to read memory requirement; otherwise,
+ * pass a pre-allocated buffer of the required size.
+ * @param allocator Output buffer for allocator.
+ * @return true on success; false otherwise.
+ */
+bool
+pool_allocator_create
+(   u64                 stride
+,   u64                 capacity
+,   u64*                memory_requirement
+,   void*               memory
+,   pool_allocator_t**  allocator
+);
+
+/**
+ * @brief Frees the memory used by a pool allocator, including every slab it
+ * has chained.
+ * 
+ * If the allocator was not pre-allocated, this function will free the memory
+ * implicitly (see core/memory.h).
+ * 
+ * @param allocator Handle to the allocator to free.
+ */
+void
+pool_allocator_destroy
+(   pool_allocator_t** allocator
+);
+
+/**
+ * @brief Queries the block size of a pool allocator.
+ * 
+ * @param allocator The allocator to query. Must be non-zero.
+ * @return The size of each block in bytes.
+ */
+u64
+pool_allocator_stride
+(   const pool_allocator_t* allocator
+);
+
+/**
+ * @brief Queries the number of blocks currently allocated from a pool
+ * allocator (including blocks held by caches).
+ * 
+ * @param allocator The allocator to query. Must be non-zero.
+ * @return The number of blocks currently allocated.
+ */
+u64
+pool_allocator_allocated
+(   const pool_allocator_t* allocator
+);
+
+/**
+ * @brief Queries the total number of blocks in every slab of a pool allocator.
+ * 
+ * @param allocator The allocator to query. Must be non-zero.
+ * @return The allocator capacity in blocks.
+ */
+u64
+pool_allocator_capacity
+(   const pool_allocator_t* allocator
+);
+
+/**
+ * @brief Queries whether a pool allocator was created with implicit memory
+ * allocation.
+ * 
+ * @param allocator The allocator to query. Must be non-zero.
+ * @return true if allocator was created with implicit memory allocation; false
+ * otherwise.
+ */
+bool
+pool_allocator_owns_memory
+(   const pool_allocator_t* allocator
+);
+
+/**
+ * @brief Allocates a block from a pool allocator. O(1).
+ * 
+ * The memory is not cleared.
+ * 
+ * @param allocator The allocator to mutate. Must be non-zero.
+ * @return The address of a block of pool_allocator_stride bytes, on success.
+ * 0, on error.
+ */
+void*
+pool_allocator_allocate
+(   pool_allocator_t* allocator
+);
+
+/**
+ * @brief Returns a block to a pool allocator. O(1).
+ * 
+ * @param allocator The allocator to mutate. Must be non-zero.
+ * @param memory A block allocated from allocator. Must be non-zero.
+ */
+void
+pool_allocator_free
+(   pool_allocator_t*   allocator
+,   void*               memory
+);
+
+/**
+ * @brief Initializes a per-thread cache for a pool allocator.
+ * 
+ * @param cache Output buffer. Must be non-zero.
+ * @param allocator The allocator to draw blocks from. Must be non-zero.
+ */
+void
+pool_allocator_cache_init
+(   pool_allocator_cache_t* cache
+,   pool_allocator_t*       allocator
+);
+
+/**
+ * @brief Allocates a block via a per-thread cache. If the cache is empty, it is
+ * refilled from the pool (this is the only case in which the pool lock is
+ * obtained).
+ * 
+ * @param cache The cache to mutate. Must be non-zero.
+ * @return The address of a block of pool_allocator_stride bytes, on success.
+ * 0, on error.
+ */
+void*
+pool_allocator_cache_allocate
+(   pool_allocator_cache_t* cache
+);
+
+/**
+ * @brief Returns a block via a per-thread cache. If the cache is full, the
+ * oldest half of it is first drained back to the pool (this is the only case in
+ * which the pool lock is obtained).
+ * 
+ * @param cache The cache to mutate. Must be non-zero.
+ * @param memory A block allocated from the cache's allocator. Must be non-zero.
+ */
+void
+pool_allocator_cache_free
+(   pool_allocator_cache_t* cache
+,   void*                   memory
+);
+
+/**
+ * @brief Returns every block held by a per-thread cache to the pool. Call
+ * before the owning thread exits, or before the pool is destroyed.
+ * 
+ * @param cache The cache to mutate. Must be non-zero.
+ */
+void
+pool_allocator_cache_flush
+(   pool_allocator_cache_t* cache
+);
+
+#endif  // MEMORY_POOL_ALLOCATOR_H
@@ -0,0 +1,361 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/cpu.c
+ * @brief Implementation of the platform/cpu header.
+ * (see platform/cpu.h for additional details)
+ */
+#include "platform/cpu.h"
+#include "platform/platform.h"
+
+#include "core/memory.h"
+
+#include "math/math.h"
+
+#if PLATFORM_ARCH_X86 == 1
+    #include <cpuid.h>
+#endif
+
+/** @brief Marks cpu_features_state as detected, so that a host with no features is not detected again. */
+#define CPU_FEATURES_DETECTED 0x80000000
+
+/** @brief Values of cpu_topology_status. */
+#define CPU_TOPOLOGY_UNDETECTED 0
+#define CPU_TOPOLOGY_DETECTING  1
+#define CPU_TOPOLOGY_DETECTED   2
+
+// Global state.
+static u32 cpu_features_state = 0;
+static u32 cpu_topology_status = CPU_TOPOLOGY_UNDETECTED;
+static cpu_topology_t cpu_topology_state;
+
+/**
+ * @brief Detects the instruction set extensions of the host processor.
+ *
+ * x86 extensions are reported by the processor itself (cpuid), regardless of
+ * the host platform; ARM extensions are reported by the host platform (see
+ * platform_cpu_features).
+ *
+ * @return A combination of CPU_FEATURE flags.
+ */
+u32
+_cpu_features_detect
+( void );
+
+/**
+ * @brief Detects the topology of the host processor (see cpu_topology).
+ *
+ * @param topology Output buffer for the topology. Must be zeroed.
+ */
+void
+_cpu_topology_detect
+(   cpu_topology_t* topology
+);
+
+/**
+ * @brief Reads the cache sizes of the host processor from the processor itself
+ * (cpuid leaf 4, or 0x8000001D on AMD). Does nothing on other architectures.
+ *
+ * @param topology The topology to write the caches to.
+ */
+void
+_cpu_topology_detect_caches
+(   cpu_topology_t* topology
+);
+
+u32
+cpu_features
+( void )
+{
+    u32 features = atomic_load_u32 ( &cpu_features_state , ATOMIC_RELAXED );
+    if ( !features )
+    {
+        // Detection is idempotent, so concurrent first calls may all store.
+        features = _cpu_features_detect () | CPU_FEATURES_DETECTED;
+        atomic_store_u32 ( &cpu_features_state , features , ATOMIC_RELAXED );
+    }
+    return features & ~CPU_FEATURES_DETECTED;
+}
+
+bool
+cpu_supports
+(   u32 features
+)
+{
+    return ( cpu_features () & features ) == features;
+}
+
+const char*
+cpu_feature_name
+(   CPU_FEATURE feature
+)
+{
+    switch ( feature )
+    {
+        case CPU_FEATURE_SSE2:     return "SSE2";
+        case CPU_FEATURE_SSE41:    return "SSE4.1";
+        case CPU_FEATURE_SSE42:    return "SSE4.2";
+        case CPU_FEATURE_POPCNT:   return "POPCNT";
+        case CPU_FEATURE_AVX:      return "AVX";
+        case CPU_FEATURE_AVX2:     return "AVX2";
+        case CPU_FEATURE_FMA:      return "FMA";
+        case CPU_FEATURE_BMI2:     return "BMI2";
+        case CPU_FEATURE_AVX512F:  return "AVX-512F";
+        case CPU_FEATURE_AVX512BW: return "AVX-512BW";
+        case CPU_FEATURE_AVX512VL: return "AVX-512VL";
+        case CPU_FEATURE_PCLMUL:   return "PCLMUL";
+        case CPU_FEATURE_NEON:     return "NEON";
+        case CPU_FEATURE_SVE:      return "SVE";
+        case CPU_FEATURE_CRC32:    return "CRC32";
+        default:                   return "unknown";
+    }
+}
+
+const cpu_topology_t*
+cpu_topology
+( void )
+{
+    if ( atomic_load_u32 ( &cpu_topology_status , ATOMIC_ACQUIRE ) != CPU_TOPOLOGY_DETECTED )
+    {
+        // Unlike the features, the topology is too large to store atomically,
+        // so exactly one thread detects it, and any other waits.
+        u32 expected = CPU_TOPOLOGY_UNDETECTED;
+        if ( atomic_compare_exchange_u32 ( &cpu_topology_status
+                                         , &expected
+                                         , CPU_TOPOLOGY_DETECTING
+                                         , ATOMIC_ACQUIRE
+                                         , ATOMIC_RELAXED
+                                         ))
+        {
+            _cpu_topology_detect ( &cpu_topology_state );
+            atomic_store_u32 ( &cpu_topology_status , CPU_TOPOLOGY_DETECTED , ATOMIC_RELEASE );
+        }
+        while ( atomic_load_u32 ( &cpu_topology_status , ATOMIC_ACQUIRE ) != CPU_TOPOLOGY_DETECTED );
+    }
+    return &cpu_topology_state;
+}
+
+u32
+_cpu_features_detect
+( void )
+{
+    u32 features = platform_cpu_features ();
+
+#if PLATFORM_ARCH_X86 == 1
+    u32 a;
+    u32 b;
+    u32 c;
+    u32 d;
+    if ( !__get_cpuid ( 1 , &a , &b , &c , &d ) )
+    {
+        return features;
+    }
+    if ( d & bit_SSE2 )   features |= CPU_FEATURE_SSE2;
+    if ( c & bit_SSE4_1 ) features |= CPU_FEATURE_SSE41;
+    if ( c & bit_SSE4_2 ) features |= CPU_FEATURE_SSE42;
+    if ( c & bit_POPCNT ) features |= CPU_FEATURE_POPCNT;
+    if ( c & bit_PCLMUL ) features |= CPU_FEATURE_PCLMUL;
+
+    // The AVX registers are usable only if the host platform saves them on a
+    // context switch: XCR0 bits 1-2 (XMM, YMM), and 5-7 (AVX-512 state).
+    u64 xcr0 = 0;
+    if ( c & bit_OSXSAVE )
+    {
+        u32 low;
+        u32 high;
+        __asm__ volatile ( "xgetbv" : "=a" ( low ) , "=d" ( high ) : "c" ( 0 ) );
+        xcr0 = ( ( u64 ) high << 32 ) | low;
+    }
+    const bool ymm = ( xcr0 & 0x06 ) == 0x06;
+    const bool zmm = ( xcr0 & 0xE6 ) == 0xE6;
+    if ( ymm && ( c & bit_AVX ) ) features |= CPU_FEATURE_AVX;
+    if ( ymm && ( c & bit_FMA ) ) features |= CPU_FEATURE_FMA;
+
+    if ( __get_cpuid_max ( 0 , 0 ) < 7 )
+    {
+        return features;
+    }
+    __cpuid_count ( 7 , 0 , a , b , c , d );
+    if ( ymm && ( b & bit_AVX2 ) )     features |= CPU_FEATURE_AVX2;
+    if ( b & bit_BMI2 )                features |= CPU_FEATURE_BMI2;
+    if ( zmm && ( b & bit_AVX512F ) )  features |= CPU_FEATURE_AVX512F;
+    if ( zmm && ( b & bit_AVX512BW ) ) features |= CPU_FEATURE_AVX512BW;
+    if ( zmm && ( b & bit_AVX512VL ) ) features |= CPU_FEATURE_AVX512VL;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    // Advanced SIMD is mandatory on AArch64.
+    features |= CPU_FEATURE_NEON;
+#endif
+
+    return features;
+}
+
+void
+_cpu_topology_detect
+(   cpu_topology_t* topology
+)
+{
+    platform_cpu_topology ( topology );
+
+    // Default: one physical core per logical core, in one package.
+    if ( !( *topology ).logical_core_count )
+    {
+        const i32 count = platform_processor_core_count ();
+        ( *topology ).logical_core_count = MAX ( count , 1 );
+        for ( u32 i = 0; i < MIN ( ( *topology ).logical_core_count , CPU_MAX_LOGICAL_CORES ); ++i )
+        {
+            ( *topology ).logical_cores[ i ].id = i;
+            ( *topology ).logical_cores[ i ].physical_core = i;
+            ( *topology ).logical_cores[ i ].package = 0;
+            ( *topology ).logical_cores[ i ].numa_node = 0;
+        }
+    }
+
+    // The host platform identifies a physical core by any number unique within
+    // its package, and a package by any number; renumber both densely, in order
+    // of first appearance.
+    const u32 described = MIN ( ( *topology ).logical_core_count , CPU_MAX_LOGICAL_CORES );
+    cpu_logical_core_t* cores = ( *topology ).logical_cores;
+    cpu_logical_core_t raw[ CPU_MAX_LOGICAL_CORES ];
+    memory_copy ( raw , cores , described * sizeof ( cpu_logical_core_t ) );
+    u32 physical_core_count = 0;
+    u32 package_count = 0;
+    u32 smt_width = 1;
+    for ( u32 i = 0; i < described; ++i )
+    {
+        u32 j = 0;
+        while ( j < i && raw[ j ].package != raw[ i ].package )
+        {
+            j += 1;
+        }
+        cores[ i ].package = ( j < i ) ? cores[ j ].package : package_count++;
+
+        u32 siblings = 1;
+        cores[ i ].physical_core = physical_core_count;
+        for ( j = 0; j < i; ++j )
+        {
+            if (   raw[ j ].package == raw[ i ].package
+                && raw[ j ].physical_core == raw[ i ].physical_core
+               )
+            {
+                cores[ i ].physical_core = cores[ j ].physical_core;
+                siblings += 1;
+            }
+        }
+        if ( siblings == 1 )
+        {
+            physical_core_count += 1;
+        }
+        smt_width = MAX ( smt_width , siblings );
+    }
+
+    // Estimate the physical cores among any logical cores not described.
+    physical_core_count += ( ( *topology ).logical_core_count - described ) / smt_width;
+
+    ( *topology ).physical_core_count = MAX ( physical_core_count , 1U );
+    ( *topology ).package_count = MAX ( package_count , 1U );
+    ( *topology ).smt_width = smt_width;
+    ( *topology ).numa_node_count = platform_numa_node_count ();
+
+    if ( !( *topology ).l1_data.size && !( *topology ).l2.size )
+    {
+        _cpu_topology_detect_caches ( topology );
+    }
+    ( *topology ).cache_line_size = ( ( *topology ).l1_data.line_size )
+                                  ? ( *topology ).l1_data.line_size
+                                  : CACHE_LINE_SIZE
+                                  ;
+    cpu_cache_t* caches[] = { &( *topology ).l1_data
+                            , &( *topology ).l1_instruction
+                            , &( *topology ).l2
+                            , &( *topology ).l3
+                            };
+    for ( u32 i = 0; i < sizeof ( caches ) / sizeof ( caches[ 0 ] ); ++i )
+    {
+        if ( !( *caches[ i ] ).size )
+        {
+            continue;
+        }
+        if ( !( *caches[ i ] ).line_size )
+        {
+            ( *caches[ i ] ).line_size = ( *topology ).cache_line_size;
+        }
+        if ( !( *caches[ i ] ).shared_by )
+        {
+            ( *caches[ i ] ).shared_by = 1;
+        }
+    }
+}
+
+void
+_cpu_topology_detect_caches
+(   cpu_topology_t* topology
+)
+{
+#if PLATFORM_ARCH_X86 == 1
+    u32 a;
+    u32 b;
+    u32 c;
+    u32 d;
+
+    // Intel reports the caches by leaf 4, and AMD by leaf 0x8000001D, in the
+    // same format; an unsupported leaf reports no caches (type 0).
+    u32 leaf = 0;
+    if ( __get_cpuid_max ( 0 , 0 ) >= 4 )
+    {
+        __cpuid_count ( 4 , 0 , a , b , c , d );
+        if ( a & 0x1F )
+        {
+            leaf = 4;
+        }
+    }
+    if ( !leaf && __get_cpuid_max ( 0x80000000 , 0 ) >= 0x8000001D )
+    {
+        __cpuid_count ( 0x8000001D , 0 , a , b , c , d );
+        if ( a & 0x1F )
+        {
+            leaf = 0x8000001D;
+        }
+    }
+    if ( !leaf )
+    {
+        return;
+    }
+
+    for ( u32 i = 0; i < 16; ++i )
+    {
+        __cpuid_count ( leaf , i , a , b , c , d );
+        const u32 type = a & 0x1F;  // 1: data, 2: instruction, 3: unified.
+        const u32 level = ( a >> 5 ) & 0x7;
+        if ( !type )
+        {
+            break;
+        }
+        cpu_cache_t cache;
+        cache.line_size = ( b & 0xFFF ) + 1;
+        cache.size = ( ( u64 ) cache.line_size )
+                   * ( ( ( b >> 12 ) & 0x3FF ) + 1 )   // Partitions.
+                   * ( ( ( b >> 22 ) & 0x3FF ) + 1 )   // Ways.
+                   * ( ( ( u64 ) c ) + 1 )             // Sets.
+                   ;
+        cache.shared_by = ( ( a >> 14 ) & 0xFFF ) + 1;
+        if ( level == 1 )
+        {
+            if ( type == 2 )
+            {
+                ( *topology ).l1_instruction = cache;
+            }
+            else
+            {
+                ( *topology ).l1_data = cache;
+            }
+        }
+        else if ( level == 2 )
+        {
+            ( *topology ).l2 = cache;
+        }
+        else if ( level == 3 )
+        {
+            ( *topology ).l3 = cache;
+        }
+    }
+#endif
+}
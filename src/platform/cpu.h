@@ -0,0 +1,156 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/cpu.h
+ * @brief Defines an interface for detecting the instruction set extensions and
+ * the topology of the host processor at runtime.
+ *
+ * platform/detect.h reports the instruction sets a module was compiled for;
+ * this header reports those the processor running it actually supports. A
+ * module with kernels for several instruction sets (see math/batch.h) selects
+ * the fastest one the host supports the first time it is used, so that one
+ * binary runs well on every host:
+ *
+ *   if ( cpu_supports ( CPU_FEATURE_AVX2 | CPU_FEATURE_FMA ) )
+ *   {
+ *       kernel = kernel_avx2;
+ *   }
+ *
+ * A feature is reported only if the host operating system also supports it
+ * (e.g. saves the AVX registers on a context switch).
+ *
+ * cpu_topology reports how the logical cores are grouped into physical cores
+ * (SMT siblings), packages and NUMA nodes, and the sizes of the caches, so that
+ * thread pools, shard counts and block sizes may be fitted to the host:
+ *
+ *   const cpu_topology_t* topology = cpu_topology ();
+ *   const u64 block_size = ( *topology ).l2.size / 2;
+ */
+#ifndef CPU_H
+#define CPU_H
+
+#include "common.h"
+
+/** @brief Type and instance definitions for instruction set extensions. */
+typedef enum
+{
+    // x86.
+    CPU_FEATURE_SSE2        = 0x0001
+,   CPU_FEATURE_SSE41       = 0x0002
+,   CPU_FEATURE_SSE42       = 0x0004    // Includes the CRC32C instruction.
+,   CPU_FEATURE_POPCNT      = 0x0008
+,   CPU_FEATURE_AVX         = 0x0010
+,   CPU_FEATURE_AVX2        = 0x0020
+,   CPU_FEATURE_FMA         = 0x0040
+,   CPU_FEATURE_BMI2        = 0x0080
+,   CPU_FEATURE_AVX512F     = 0x0100
+,   CPU_FEATURE_AVX512BW    = 0x0200
+,   CPU_FEATURE_AVX512VL    = 0x0400
+,   CPU_FEATURE_PCLMUL      = 0x0800    // Carry-less multiplication (PCLMULQDQ).
+
+    // ARM.
+,   CPU_FEATURE_NEON        = 0x1000
+,   CPU_FEATURE_SVE         = 0x2000
+,   CPU_FEATURE_CRC32       = 0x4000    // ARMv8 CRC32 / CRC32C instructions.
+
+,   CPU_FEATURE_COUNT       = 15
+}
+CPU_FEATURE;
+
+/**
+ * @brief Queries the instruction set extensions which the host processor and
+ * operating system support.
+ *
+ * Detected on the first call, and cached; safe to call from any thread.
+ *
+ * @return A combination of CPU_FEATURE flags.
+ */
+u32
+cpu_features
+( void );
+
+/**
+ * @brief Queries whether the host supports every one of a set of instruction
+ * set extensions.
+ *
+ * @param features A combination of CPU_FEATURE flags.
+ * @return true if every feature in features is supported; false otherwise.
+ */
+bool
+cpu_supports
+(   u32 features
+);
+
+/**
+ * @brief Queries the name of an instruction set extension.
+ *
+ * @param feature A single CPU_FEATURE flag.
+ * @return The name of feature (e.g. "AVX2"), or "unknown" if it is not a
+ * single flag.
+ */
+const char*
+cpu_feature_name
+(   CPU_FEATURE feature
+);
+
+/**
+ * @brief Maximum number of logical cores which cpu_topology describes
+ * individually. Any further cores are counted, but not described.
+ */
+#define CPU_MAX_LOGICAL_CORES ( ( u32 ) 1024 )
+
+/** @brief Type definition for a logical core (hardware thread). */
+typedef struct
+{
+    u32 id;             // Host platform processor number (see thread affinity).
+    u32 physical_core;  // Index of its physical core, dense from 0.
+    u32 package;        // Index of its physical package (socket), dense from 0.
+    u32 numa_node;      // NUMA node.
+}
+cpu_logical_core_t;
+
+/** @brief Type definition for a level of processor cache. */
+typedef struct
+{
+    u64 size;           // Size of one instance, in bytes (0 if not present).
+    u32 line_size;      // Line size in bytes.
+    u32 shared_by;      // Number of logical cores sharing one instance.
+}
+cpu_cache_t;
+
+/** @brief Type definition for the topology of the host processor. */
+typedef struct
+{
+    u32                 logical_core_count;
+    u32                 physical_core_count;
+    u32                 package_count;
+    u32                 numa_node_count;
+    u32                 smt_width;          // Most logical cores on one physical core.
+    u32                 cache_line_size;    // Never 0.
+
+    cpu_cache_t         l1_data;
+    cpu_cache_t         l1_instruction;
+    cpu_cache_t         l2;
+    cpu_cache_t         l3;
+
+    // The first CPU_MAX_LOGICAL_CORES logical cores, in order of id.
+    cpu_logical_core_t  logical_cores[ CPU_MAX_LOGICAL_CORES ];
+}
+cpu_topology_t;
+
+/**
+ * @brief Queries the topology of the host processor.
+ *
+ * The host platform reports it where it can (see platform_cpu_topology);
+ * cache sizes it does not report are read from the processor (cpuid) on x86,
+ * and anything else unreported defaults to one physical core per logical core,
+ * in one package.
+ *
+ * Detected on the first call, and cached; safe to call from any thread.
+ *
+ * @return The topology (never 0).
+ */
+const cpu_topology_t*
+cpu_topology
+( void );
+
+#endif  // CPU_H
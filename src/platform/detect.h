@@ -65,4 +65,49 @@
     #error "Unknown platform."
 #endif
 
+// Compiler: Microsoft Visual C++.
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define PLATFORM_COMPILER_MSVC 1
+    #define PLATFORM_COMPILER_STRING "MSVC"
+
+// Compiler: GCC, or a compiler which implements the GNU C extensions (clang).
+#elif defined(__GNUC__) || defined(__clang__)
+    #define PLATFORM_COMPILER_GCC 1
+    #if defined(__clang__)
+        #define PLATFORM_COMPILER_STRING "clang"
+    #else
+        #define PLATFORM_COMPILER_STRING "GCC"
+    #endif
+
+// Compiler: Other.
+#else
+    #error "Unknown compiler."
+#endif
+
+// Architecture: x86 (32- or 64-bit).
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define PLATFORM_ARCH_X86 1
+
+// Architecture: ARM (32- or 64-bit).
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__arm__) || defined(_M_ARM)
+    #define PLATFORM_ARCH_ARM 1
+#endif
+
+// Vector instruction sets enabled at compile time.
+#if defined(__AVX512F__)
+    #define PLATFORM_SIMD_AVX512 1
+#endif
+#if defined(__FMA__)
+    #define PLATFORM_SIMD_FMA 1
+#endif
+#if defined(__AVX2__)
+    #define PLATFORM_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+    #define PLATFORM_SIMD_SSE2 1
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+    #define PLATFORM_SIMD_NEON 1
+#endif
+
 #endif  // PLATFORM_DETECT_H
\ No newline at end of file
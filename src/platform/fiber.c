@@ -0,0 +1,273 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/fiber.c
+ * @brief Implementation of the platform/fiber header.
+ * (see platform/fiber.h for additional details)
+ */
+#include "platform/fiber.h"
+#include "platform/platform.h"
+
+#include "common/align.h"
+#include "common/thread_local.h"
+
+#include "container/list.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/clamp.h"
+
+/** @brief Type definition for a fiber. */
+typedef struct
+{
+    // First, so that a pooled fiber may be cast from its node.
+    atomic_stack_node_t node;
+
+    fiber_context_t     context;
+
+    // Context to switch back to on yield (see fiber_resume).
+    fiber_context_t*    caller;
+
+    fiber_function_t    function;
+    void*               args;
+    u64                 stack_size;
+    FIBER_STATE         state;
+}
+fiber_data_t;
+
+/** @brief Fibers of the default stack size which are not in use. */
+static atomic_stack_t fiber_pool = { 0 };
+
+/** @brief The fiber the calling thread is running, or 0 if none. */
+static THREAD_LOCAL fiber_data_t* fiber_running = 0;
+
+/** @brief Context of the calling thread's own stack (see fiber_resume). */
+static THREAD_LOCAL fiber_context_t fiber_thread_context;
+static THREAD_LOCAL bool fiber_thread_initialized = false;
+
+/**
+ * @brief Fiber entry point. Runs the fiber's function, then switches back to
+ * the caller; loops so that a pooled fiber may run another function without
+ * building a new stack.
+ *
+ * @param args The fiber to run. Must be non-zero.
+ */
+void
+_fiber_main
+(   void* args
+);
+
+/**
+ * @brief Computes the stack size of a pooled fiber.
+ *
+ * @return FIBER_DEFAULT_STACK_SIZE, rounded up to the page size.
+ */
+u64
+_fiber_pool_stack_size
+( void );
+
+bool
+_fiber_create
+(   u64                 stack_size
+,   fiber_function_t    function
+,   void*               args
+,   fiber_t**           fiber_
+)
+{
+    if ( !function || !fiber_ )
+    {
+        if ( !function )
+        {
+            LOGERROR ( "fiber_create: Missing argument: function." );
+        }
+        if ( !fiber_ )
+        {
+            LOGERROR ( "fiber_create: Missing argument: fiber (output buffer)." );
+        }
+        return false;
+    }
+
+    stack_size = aligned ( MAX ( stack_size , ( u64 ) 1 ) , platform_memory_page_size () );
+
+    fiber_data_t* fiber = 0;
+    if ( stack_size == _fiber_pool_stack_size () )
+    {
+        fiber = ( fiber_data_t* ) atomic_stack_pop ( &fiber_pool );
+    }
+    if ( !fiber )
+    {
+        fiber = memory_allocate ( sizeof ( fiber_data_t ) , MEMORY_TAG_THREAD );
+        if ( !platform_fiber_create ( stack_size , _fiber_main , fiber , &( *fiber ).context ) )
+        {
+            LOGERROR ( "fiber_create: Failed to create a fiber with a stack of %u bytes."
+                     , stack_size
+                     );
+            memory_free ( fiber , sizeof ( fiber_data_t ) , MEMORY_TAG_THREAD );
+            return false;
+        }
+        ( *fiber ).stack_size = stack_size;
+    }
+
+    ( *fiber ).caller = 0;
+    ( *fiber ).function = function;
+    ( *fiber ).args = args;
+    ( *fiber ).state = FIBER_STATE_READY;
+
+    *fiber_ = fiber;
+    return true;
+}
+
+void
+fiber_destroy
+(   fiber_t** fiber_
+)
+{
+    if ( !fiber_ || !*fiber_ )
+    {
+        return;
+    }
+
+    fiber_data_t* fiber = *fiber_;
+    if ( ( *fiber ).state == FIBER_STATE_RUNNING )
+    {
+        LOGERROR ( "fiber_destroy: Cannot destroy a running fiber." );
+        return;
+    }
+
+    // Only a fiber which is not inside its function may be reused (see
+    // _fiber_main).
+    if ( ( *fiber ).state != FIBER_STATE_SUSPENDED
+      && ( *fiber ).stack_size == _fiber_pool_stack_size ()
+       )
+    {
+        atomic_stack_push ( &fiber_pool , &( *fiber ).node );
+    }
+    else
+    {
+        platform_fiber_destroy ( &( *fiber ).context );
+        memory_free ( fiber , sizeof ( fiber_data_t ) , MEMORY_TAG_THREAD );
+    }
+
+    *fiber_ = 0;
+}
+
+FIBER_STATE
+fiber_resume
+(   fiber_t* fiber_
+)
+{
+    if ( !fiber_ )
+    {
+        LOGERROR ( "fiber_resume: Missing argument: fiber." );
+        return FIBER_STATE_FINISHED;
+    }
+
+    fiber_data_t* fiber = fiber_;
+    if ( ( *fiber ).state != FIBER_STATE_READY
+      && ( *fiber ).state != FIBER_STATE_SUSPENDED
+       )
+    {
+        LOGERROR ( "fiber_resume: Fiber is not ready or suspended." );
+        return ( *fiber ).state;
+    }
+
+    fiber_data_t* previous = fiber_running;
+    fiber_context_t* caller;
+    if ( previous )
+    {
+        caller = &( *previous ).context;
+    }
+    else
+    {
+        if ( !fiber_thread_initialized )
+        {
+            if ( !platform_fiber_thread ( &fiber_thread_context ) )
+            {
+                LOGERROR ( "fiber_resume: Failed to prepare the calling thread to run fibers." );
+                return ( *fiber ).state;
+            }
+            fiber_thread_initialized = true;
+        }
+        caller = &fiber_thread_context;
+    }
+
+    ( *fiber ).caller = caller;
+    ( *fiber ).state = FIBER_STATE_RUNNING;
+    fiber_running = fiber;
+    platform_fiber_switch ( caller , &( *fiber ).context );
+
+    // The fiber always switches back on the thread which resumed it, so this
+    // is still the same thread.
+    fiber_running = previous;
+    return ( *fiber ).state;
+}
+
+void
+fiber_yield
+( void )
+{
+    fiber_data_t* fiber = fiber_running;
+    if ( !fiber )
+    {
+        return;
+    }
+
+    ( *fiber ).state = FIBER_STATE_SUSPENDED;
+    platform_fiber_switch ( &( *fiber ).context , ( *fiber ).caller );
+
+    // May now be running on another thread: thread-local storage must not be
+    // accessed past this point.
+}
+
+fiber_t*
+fiber_current
+( void )
+{
+    return fiber_running;
+}
+
+FIBER_STATE
+fiber_state
+(   const fiber_t* fiber
+)
+{
+    return ( *( ( const fiber_data_t* ) fiber ) ).state;
+}
+
+u64
+fiber_pool_trim
+( void )
+{
+    u64 count = 0;
+    atomic_stack_node_t* node = atomic_stack_pop_all ( &fiber_pool );
+    while ( node )
+    {
+        fiber_data_t* fiber = ( fiber_data_t* ) node;
+        node = ( *node ).next;
+        platform_fiber_destroy ( &( *fiber ).context );
+        memory_free ( fiber , sizeof ( fiber_data_t ) , MEMORY_TAG_THREAD );
+        count += 1;
+    }
+    return count;
+}
+
+void
+_fiber_main
+(   void* args
+)
+{
+    fiber_data_t* fiber = args;
+    for (;;)
+    {
+        ( *fiber ).function ( ( *fiber ).args );
+        ( *fiber ).state = FIBER_STATE_FINISHED;
+        platform_fiber_switch ( &( *fiber ).context , ( *fiber ).caller );
+    }
+}
+
+u64
+_fiber_pool_stack_size
+( void )
+{
+    return aligned ( FIBER_DEFAULT_STACK_SIZE , platform_memory_page_size () );
+}
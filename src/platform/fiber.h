@@ -0,0 +1,173 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/fiber.h
+ * @brief Defines an interface for cooperative execution on fibers (stackful
+ * coroutines).
+ *
+ * A fiber runs a function on a stack of its own. Unlike a thread, a fiber is
+ * never preempted: it runs on the thread which resumes it until it calls
+ * fiber_yield or its function returns, at which point execution continues
+ * after the call to fiber_resume. A fiber which has yielded may be resumed
+ * again later, by any thread.
+ *
+ *   fiber_t* fiber;
+ *   fiber_create ( function , args , &fiber );
+ *   while ( fiber_resume ( fiber ) != FIBER_STATE_FINISHED )
+ *   { ... }
+ *   fiber_destroy ( &fiber );
+ *
+ * Switching fibers saves and restores only the callee-saved registers, so it
+ * costs a few nanoseconds, compared to microseconds for a thread context
+ * switch through the host platform scheduler. Each stack is reserved from
+ * virtual memory with an inaccessible guard page below it, so a stack overflow
+ * faults immediately rather than corrupting other memory. Stacks of the
+ * default size are pooled, so creating and destroying fibers does not reserve
+ * and release virtual memory every time.
+ *
+ * A fiber must not hold a lock (e.g. a mutex) across fiber_yield, and must not
+ * rely on thread-local storage remaining the same across it, since it may be
+ * resumed on another thread.
+ */
+#ifndef FIBER_H
+#define FIBER_H
+
+#include "common.h"
+
+/** @brief Type declaration for a fiber. */
+typedef void fiber_t;
+
+/** @brief Type definition for a fiber entry point. */
+typedef void ( *fiber_function_t )( void* args );
+
+/**
+ * @brief Type definition for a host platform execution context (see
+ * platform/platform.h). Fields are internal.
+ */
+typedef struct
+{
+    // Saved stack pointer, or native fiber handle (LPVOID) on Windows.
+    void*               handle;
+
+    // Stack memory reservation, including the guard page; 0 if the context
+    // represents a thread's own stack.
+    void*               stack;
+    u64                 stack_size;
+
+    fiber_function_t    function;
+    void*               args;
+}
+fiber_context_t;
+
+/** @brief Type and instance definitions for fiber states. */
+typedef enum
+{
+    FIBER_STATE_READY       = 0 /** @brief Created; not yet resumed. */
+,   FIBER_STATE_RUNNING     = 1 /** @brief Executing on some thread. */
+,   FIBER_STATE_SUSPENDED   = 2 /** @brief Yielded; may be resumed. */
+,   FIBER_STATE_FINISHED    = 3 /** @brief Function returned. */
+}
+FIBER_STATE;
+
+/**
+ * @brief Fiber default stack size (in bytes). Stacks of this size are pooled
+ * (see fiber_pool_trim).
+ */
+#define FIBER_DEFAULT_STACK_SIZE KiB ( 64 )
+
+/**
+ * @brief Creates a new fiber, in the ready state. The fiber does not execute
+ * until it is resumed (see fiber_resume).
+ *
+ * Use _fiber_create to explicitly specify the stack size, or fiber_create to
+ * use the default.
+ *
+ * Uses dynamic memory allocation. Call fiber_destroy to free.
+ *
+ * @param stack_size The stack size in bytes, excluding the guard page. Rounded
+ * up to the page size.
+ * @param function The function to run on the fiber. Must be non-zero.
+ * @param args Arguments to pass to function.
+ * @param fiber Output buffer for the fiber. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+_fiber_create
+(   u64                 stack_size
+,   fiber_function_t    function
+,   void*               args
+,   fiber_t**           fiber
+);
+
+#define fiber_create(function,args,fiber) \
+    _fiber_create ( FIBER_DEFAULT_STACK_SIZE , (function) , (args) , (fiber) )
+
+/**
+ * @brief Frees a fiber. Must not be called on a running fiber.
+ *
+ * A ready or finished fiber of the default stack size is returned to the pool.
+ * A suspended fiber is abandoned: its function never returns, and its stack is
+ * released without being unwound.
+ *
+ * @param fiber Handle to the fiber to free.
+ */
+void
+fiber_destroy
+(   fiber_t** fiber
+);
+
+/**
+ * @brief Runs a fiber on the calling thread until it yields or finishes.
+ *
+ * May be called from another fiber, in which case the resumed fiber yields
+ * back to that one.
+ *
+ * @param fiber The fiber to resume. Must be non-zero, and ready or suspended.
+ * @return FIBER_STATE_SUSPENDED if the fiber yielded; FIBER_STATE_FINISHED if
+ * its function returned.
+ */
+FIBER_STATE
+fiber_resume
+(   fiber_t* fiber
+);
+
+/**
+ * @brief Suspends the calling fiber, and continues execution after the call to
+ * fiber_resume which last resumed it.
+ *
+ * Has no effect if the calling thread is not running a fiber.
+ */
+void
+fiber_yield
+( void );
+
+/**
+ * @brief Queries the fiber the calling thread is running.
+ *
+ * @return The running fiber, or 0 if the calling thread is not running one.
+ */
+fiber_t*
+fiber_current
+( void );
+
+/**
+ * @brief Queries the state of a fiber.
+ *
+ * @param fiber The fiber to query. Must be non-zero.
+ * @return The state of fiber.
+ */
+FIBER_STATE
+fiber_state
+(   const fiber_t* fiber
+);
+
+/**
+ * @brief Frees every pooled fiber (see fiber_destroy). Must not be called while
+ * any other thread may create or destroy a fiber.
+ *
+ * @return The number of fibers freed.
+ */
+u64
+fiber_pool_trim
+( void );
+
+#endif  // FIBER_H
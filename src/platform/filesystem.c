@@ -5,8 +5,105 @@
  * (see platform/filesystem.h for additional details)
  */
 #include "platform/filesystem.h"
+#include "platform/io_queue.h"
 #include "platform/platform.h"
 
+#include "container/string.h"
+#include "core/checksum.h"
+#include "core/compress.h"
+#include "core/job.h"
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/metrics.h"
+
+#include "math/clamp.h"
+
+/**
+ * @brief Type definition for the state shared by every job of a directory
+ * walk (see directory_walk).
+ */
+typedef struct
+{
+    directory_walk_function_t   function;
+    void*                       args;
+    bool                        query_size;
+    bool                        parallel;
+    job_counter_t               counter;
+    u32                         failed;
+}
+directory_walk_t;
+
+/**
+ * @brief Type definition for the arguments to a directory walk job. The path
+ * is stored immediately after this header.
+ */
+typedef struct
+{
+    directory_walk_t*   walk;
+    u64                 path_length;
+}
+directory_walk_job_t;
+
+/**
+ * @brief Enumerates a single directory of a directory walk, descending into
+ * each subdirectory which the callback accepts (see directory_walk).
+ * 
+ * @param walk The walk state.
+ * @param path The directory path.
+ * @param path_length The length of path.
+ */
+void
+_directory_walk_visit
+(   directory_walk_t*   walk
+,   const char*         path
+,   u64                 path_length
+);
+
+/**
+ * @brief Job: enumerates a single directory of a parallel directory walk.
+ * 
+ * @param args The job arguments (see directory_walk_job_t). Freed by the job.
+ */
+void
+_directory_walk_job
+(   void* args
+);
+
+/**
+ * @brief Moves the unread content of a buffered file reader to the front of
+ * its buffer, and fills the rest of the buffer from the file.
+ * 
+ * @param reader The reader to fill. Must be non-zero.
+ * @return false on read error; true otherwise.
+ */
+bool
+_file_reader_fill
+(   file_reader_t* reader
+);
+
+/**
+ * @brief Variant of _file_reader_fill for a compressed reader: moves the
+ * unread content to the front of the buffer, and appends the content of the
+ * next frame in the file to it, growing the buffer if the frame does not fit.
+ * 
+ * @param reader The reader to fill. Must be non-zero.
+ * @return false on read error or damaged frame; true otherwise.
+ */
+bool
+_file_reader_fill_compressed
+(   file_reader_t* reader
+);
+
+/**
+ * @brief Doubles the buffer capacity of a buffered file reader.
+ * 
+ * @param reader The reader to grow. Must be non-zero.
+ */
+void
+_file_reader_grow
+(   file_reader_t* reader
+);
+
 bool
 file_exists
 (   const char* path
@@ -34,6 +131,15 @@ file_close
     platform_file_close ( file );
 }
 
+bool
+file_preallocate
+(   file_t* file
+,   u64     size
+)
+{
+    return platform_file_preallocate ( file , size );
+}
+
 u64
 file_size
 (   file_t* file
@@ -67,7 +173,46 @@ file_read
 ,   u64*    read
 )
 {
-    return platform_file_read ( file , size , dst , read );
+    const bool success = platform_file_read ( file , size , dst , read );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_READ , *read );
+    }
+    return success;
+}
+
+bool
+file_read_at
+(   file_t* file
+,   u64     offset
+,   u64     size
+,   void*   dst
+,   u64*    read
+)
+{
+    const bool success = platform_file_read_at ( file , offset , size , dst , read );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_READ , *read );
+    }
+    return success;
+}
+
+bool
+file_readv_at
+(   file_t*                 file
+,   u64                     offset
+,   const file_buffer_t*    buffers
+,   u64                     count
+,   u64*                    read
+)
+{
+    const bool success = platform_file_readv_at ( file , offset , buffers , count , read );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_READ , *read );
+    }
+    return success;
 }
 
 bool
@@ -76,7 +221,265 @@ file_read_line
 ,   char**  dst
 )
 {
-    return platform_file_read_line ( file , dst );
+    const bool success = platform_file_read_line ( file , dst );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_READ , string_length ( *dst ) );
+    }
+    return success;
+}
+
+bool
+_file_reader_create
+(   file_t*         file
+,   u64             capacity
+,   file_reader_t*  reader
+)
+{
+    if ( !file || !capacity || !reader )
+    {
+        if ( !file )
+        {
+            LOGERROR ( "_file_reader_create: Missing argument: file (file to read)." );
+        }
+        if ( !capacity )
+        {
+            LOGERROR ( "_file_reader_create: Value of capacity argument must be non-zero." );
+        }
+        if ( !reader )
+        {
+            LOGERROR ( "_file_reader_create: Missing argument: reader (output buffer)." );
+        }
+        return false;
+    }
+
+    ( *reader ).file = file;
+    ( *reader ).buffer = memory_allocate_uninit ( capacity , MEMORY_TAG_FILE );
+    ( *reader ).capacity = capacity;
+    ( *reader ).start = 0;
+    ( *reader ).end = 0;
+    ( *reader ).checksum = 0;
+    ( *reader ).compressed = false;
+    ( *reader ).frame = 0;
+    ( *reader ).frame_capacity = 0;
+    return true;
+}
+
+bool
+_file_reader_create_compressed
+(   file_t*         file
+,   u64             capacity
+,   file_reader_t*  reader
+)
+{
+    if ( !_file_reader_create ( file , capacity , reader ) )
+    {
+        return false;
+    }
+
+    // The frame scratch buffer is allocated on the first fill, once the
+    // payload size of the first frame is known.
+    ( *reader ).compressed = true;
+    return true;
+}
+
+void
+file_reader_destroy
+(   file_reader_t* reader
+)
+{
+    if ( !reader || !( *reader ).buffer )
+    {
+        return;
+    }
+
+    // Give back any content which was buffered but not read. Not possible
+    // for a compressed reader, as decompressed content does not map back to
+    // a file position.
+    const u64 unread = ( *reader ).end - ( *reader ).start;
+    if ( unread && !( *reader ).compressed )
+    {
+        file_position_set ( ( *reader ).file
+                          , file_position_get ( ( *reader ).file ) - unread
+                          );
+    }
+
+    if ( ( *reader ).frame )
+    {
+        memory_free ( ( *reader ).frame , ( *reader ).frame_capacity , MEMORY_TAG_FILE );
+    }
+    memory_free ( ( *reader ).buffer , ( *reader ).capacity , MEMORY_TAG_FILE );
+    memory_clear ( reader , sizeof ( file_reader_t ) );
+}
+
+bool
+_file_reader_next_line
+(   file_reader_t*  reader
+,   bool            strip_cr
+,   const char**    line
+,   u64*            length
+)
+{
+    if ( !reader || !line || !length )
+    {
+        if ( !reader )
+        {
+            LOGERROR ( "_file_reader_next_line: Missing argument: reader (reader to advance)." );
+        }
+        if ( !line )
+        {
+            LOGERROR ( "_file_reader_next_line: Missing argument: line (output buffer)." );
+        }
+        else
+        {
+            *line = 0;
+        }
+        if ( !length )
+        {
+            LOGERROR ( "_file_reader_next_line: Missing argument: length (output buffer)." );
+        }
+        else
+        {
+            *length = 0;
+        }
+        return false;
+    }
+
+    *line = 0;
+    *length = 0;
+
+    // Number of unread bytes already known not to contain a newline.
+    u64 scanned = 0;
+    for (;;)
+    {
+        const char* read = ( const char* )( ( *reader ).buffer + ( *reader ).start );
+        const u64 available = ( *reader ).end - ( *reader ).start;
+
+        // End of line? Y/N
+        u64 index;
+        if ( string_contains ( read + scanned , available - scanned
+                             , "\n" , 1
+                             , false
+                             , &index
+                             ))
+        {
+            index += scanned;
+            ( *reader ).checksum = checksum_crc32c ( read , index + 1
+                                                   , ( *reader ).checksum
+                                                   );
+            ( *reader ).start += index + 1;
+            *line = read;
+            *length = ( strip_cr && index && read[ index - 1 ] == '\r' ) ? index - 1
+                                                                         : index
+                                                                         ;
+            return true;
+        }
+        scanned = available;
+
+        // Partial line fills the entire buffer? Y/N
+        if ( available == ( *reader ).capacity )
+        {
+            _file_reader_grow ( reader );
+        }
+
+        if ( !( ( *reader ).compressed ? _file_reader_fill_compressed ( reader )
+                                       : _file_reader_fill ( reader )
+                                       ))
+        {
+            return false;
+        }
+
+        // End of file? Y/N
+        if ( ( *reader ).end == scanned )
+        {
+            if ( !scanned )
+            {
+                return false;
+            }
+            read = ( const char* ) ( *reader ).buffer;
+            ( *reader ).checksum = checksum_crc32c ( read , scanned
+                                                   , ( *reader ).checksum
+                                                   );
+            ( *reader ).start = ( *reader ).end;
+            *line = read;
+            *length = ( strip_cr && read[ scanned - 1 ] == '\r' ) ? scanned - 1
+                                                                  : scanned
+                                                                  ;
+            return true;
+        }
+    }
+}
+
+bool
+file_reader_fill
+(   file_reader_t*  reader
+,   u64*            read
+)
+{
+    if ( !reader || !read )
+    {
+        if ( !reader )
+        {
+            LOGERROR ( "file_reader_fill: Missing argument: reader (reader to fill)." );
+        }
+        if ( !read )
+        {
+            LOGERROR ( "file_reader_fill: Missing argument: read (output buffer)." );
+        }
+        else
+        {
+            *read = 0;
+        }
+        return false;
+    }
+
+    const u64 unread = ( *reader ).end - ( *reader ).start;
+    if ( unread == ( *reader ).capacity )
+    {
+        _file_reader_grow ( reader );
+    }
+
+    const bool success = ( ( *reader ).compressed ) ? _file_reader_fill_compressed ( reader )
+                                                    : _file_reader_fill ( reader )
+                                                    ;
+    *read = ( *reader ).end - unread;
+    return success;
+}
+
+void
+file_reader_consume
+(   file_reader_t*  reader
+,   u64             size
+)
+{
+    ( *reader ).checksum = checksum_crc32c ( ( *reader ).buffer + ( *reader ).start
+                                           , size
+                                           , ( *reader ).checksum
+                                           );
+    ( *reader ).start += size;
+}
+
+bool
+file_reader_read_line
+(   file_reader_t*  reader
+,   char**          dst
+)
+{
+    if ( !dst )
+    {
+        LOGERROR ( "file_reader_read_line: Missing argument: dst (output buffer)." );
+        return false;
+    }
+
+    const char* line;
+    u64 length;
+    if ( !file_reader_next_line ( reader , &line , &length ) )
+    {
+        *dst = 0;
+        return false;
+    }
+    *dst = __string_copy ( line , length );
+    return true;
 }
 
 bool
@@ -86,7 +489,152 @@ file_read_all
 ,   u64*    read
 )
 {
-    return platform_file_read_all ( file , dst , read );
+    const bool success = platform_file_read_all ( file , dst , read );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_READ , *read );
+    }
+    return success;
+}
+
+bool
+_file_stream
+(   file_t*                 file
+,   u64                     chunk_size
+,   bool                    prefetch
+,   file_stream_function_t  function
+,   void*                   args
+)
+{
+    if ( !file || !chunk_size || !function )
+    {
+        if ( !file )
+        {
+            LOGERROR ( "_file_stream: Missing argument: file (file to read)." );
+        }
+        if ( !chunk_size )
+        {
+            LOGERROR ( "_file_stream: Value of chunk_size argument must be non-zero." );
+        }
+        if ( !function )
+        {
+            LOGERROR ( "_file_stream: Missing argument: function (callback function)." );
+        }
+        return false;
+    }
+
+    if ( !( *file ).valid )
+    {
+        return false;
+    }
+
+    const u64 size = file_size ( file );
+
+    // Nothing to stream? Y/N
+    if ( !size )
+    {
+        return true;
+    }
+
+    chunk_size = aligned ( chunk_size , FILE_DIRECT_ALIGNMENT );
+
+    // No reads to overlap if the file fits in a single chunk.
+    io_queue_t* queue = 0;
+    prefetch = prefetch && size > chunk_size && io_queue_create ( 2 , &queue );
+
+    const u64 buffer_count = prefetch ? 2 : 1;
+    u8* buffers = memory_allocate_aligned_uninit ( chunk_size * buffer_count
+                                                 , FILE_DIRECT_ALIGNMENT
+                                                 , MEMORY_TAG_FILE
+                                                 );
+
+    bool success = true;
+    if ( !prefetch )
+    {
+        u64 offset = 0;
+        while ( offset < size )
+        {
+            u64 read;
+            if ( !file_read_at ( file , offset , chunk_size , buffers , &read ) )
+            {
+                success = false;
+                break;
+            }
+            if ( !function ( buffers , read , offset , args ) )
+            {
+                break;
+            }
+            offset += read;
+        }
+    }
+    else
+    {
+        // Only one read is ever in flight: the chunk after the one being
+        // processed. Each buffer alternates between the two roles.
+        io_request_t requests[ 2 ];
+        memory_clear ( requests , sizeof ( io_request_t ) * 2 );
+        for ( u64 i = 0; i < 2; ++i )
+        {
+            requests[ i ].operation = IO_OPERATION_READ;
+            requests[ i ].file = file;
+            requests[ i ].data = buffers + i * chunk_size;
+        }
+        requests[ 0 ].offset = 0;
+        requests[ 0 ].size = chunk_size;
+
+        u64 next = chunk_size; // Offset of the next chunk to prefetch.
+        u64 current = 0;
+        success = io_queue_submit ( queue , &requests[ 0 ] , 1 );
+        while ( success )
+        {
+            io_request_t* completed;
+            if ( !io_queue_wait ( queue , &completed , 1 ) || !( *completed ).success )
+            {
+                success = false;
+                break;
+            }
+
+            // Prefetch the next chunk into the other buffer.
+            if ( next < size )
+            {
+                requests[ 1 - current ].offset = next;
+                requests[ 1 - current ].size = MIN ( chunk_size , size - next );
+                next += requests[ 1 - current ].size;
+                if ( !io_queue_submit ( queue , &requests[ 1 - current ] , 1 ) )
+                {
+                    success = false;
+                    break;
+                }
+            }
+
+            if ( !function ( ( *completed ).data
+                           , ( *completed ).transferred
+                           , ( *completed ).offset
+                           , args
+                           ))
+            {
+                break;
+            }
+
+            // End of file reached? Y/N
+            if ( !io_queue_pending ( queue ) )
+            {
+                break;
+            }
+
+            current = 1 - current;
+        }
+
+        // Waits for a prefetch still in flight.
+        io_queue_destroy ( &queue );
+    }
+
+    memory_free_aligned ( buffers
+                        , chunk_size * buffer_count
+                        , FILE_DIRECT_ALIGNMENT
+                        , MEMORY_TAG_FILE
+                        );
+    return success;
 }
 
 bool
@@ -97,7 +645,29 @@ file_write
 ,   u64*        written
 )
 {
-    return platform_file_write ( file , size , src , written );
+    const bool success = platform_file_write ( file , size , src , written );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_WRITTEN , *written );
+    }
+    return success;
+}
+
+bool
+file_write_at
+(   file_t*     file
+,   u64         offset
+,   u64         size
+,   const void* src
+,   u64*        written
+)
+{
+    const bool success = platform_file_write_at ( file , offset , size , src , written );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_WRITTEN , *written );
+    }
+    return success;
 }
 
 bool
@@ -107,7 +677,323 @@ file_write_line
 ,   const char* src
 )
 {
-    return platform_file_write_line ( file , size , src );
+    const bool success = platform_file_write_line ( file , size , src );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_WRITTEN , size + 1 );
+    }
+    return success;
+}
+
+bool
+file_writev
+(   file_t*             file
+,   const file_span_t*  spans
+,   u64                 count
+,   u64*                written
+)
+{
+    const bool success = platform_file_writev ( file , spans , count , written );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_WRITTEN , *written );
+    }
+    return success;
+}
+
+bool
+file_write_raw
+(   file_t*     file
+,   u64         size
+,   const void* src
+)
+{
+    const bool success = platform_file_write_raw ( file , size , src );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_WRITTEN , size );
+    }
+    return success;
+}
+
+bool
+file_copy
+(   const char* src_path
+,   const char* dst_path
+)
+{
+    return platform_file_copy ( src_path , dst_path );
+}
+
+bool
+file_transfer
+(   file_t* dst
+,   file_t* src
+,   u64     offset
+,   u64     size
+,   u64*    transferred
+)
+{
+    const bool success = platform_file_transfer ( dst , src , offset , size , transferred );
+    if ( success )
+    {
+        metrics_counter_add ( METRICS_FILE_BYTES_WRITTEN , *transferred );
+    }
+    return success;
+}
+
+bool
+_file_writer_create
+(   file_t*         file
+,   u64             capacity
+,   u64             threshold
+,   file_writer_t*  writer
+)
+{
+    if ( !file || !capacity || !threshold || threshold > capacity || !writer )
+    {
+        if ( !file )
+        {
+            LOGERROR ( "_file_writer_create: Missing argument: file (file to write to)." );
+        }
+        if ( !capacity )
+        {
+            LOGERROR ( "_file_writer_create: Value of capacity argument must be non-zero." );
+        }
+        if ( !threshold || threshold > capacity )
+        {
+            LOGERROR ( "_file_writer_create: Value of threshold argument must be non-zero and no larger than capacity (%u)."
+                     , capacity
+                     );
+        }
+        if ( !writer )
+        {
+            LOGERROR ( "_file_writer_create: Missing argument: writer (output buffer)." );
+        }
+        return false;
+    }
+
+    ( *writer ).file = file;
+    ( *writer ).buffer = memory_allocate_uninit ( capacity , MEMORY_TAG_FILE );
+    ( *writer ).capacity = capacity;
+    ( *writer ).threshold = threshold;
+    ( *writer ).length = 0;
+    ( *writer ).checksum = 0;
+    ( *writer ).frame = 0;
+    ( *writer ).frame_capacity = 0;
+    return true;
+}
+
+bool
+_file_writer_create_compressed
+(   file_t*         file
+,   u64             capacity
+,   u64             threshold
+,   file_writer_t*  writer
+)
+{
+    if ( !_file_writer_create ( file , capacity , threshold , writer ) )
+    {
+        return false;
+    }
+
+    // A flush compresses the buffer one COMPRESS_MAX_SIZE piece at a time.
+    ( *writer ).frame_capacity = COMPRESS_FRAME_BOUND ( MIN ( capacity
+                                                            , ( u64 ) COMPRESS_MAX_SIZE
+                                                            ));
+    ( *writer ).frame = memory_allocate_uninit ( ( *writer ).frame_capacity
+                                               , MEMORY_TAG_FILE
+                                               );
+    return true;
+}
+
+bool
+file_writer_destroy
+(   file_writer_t* writer
+)
+{
+    if ( !writer || !( *writer ).buffer )
+    {
+        return true;
+    }
+
+    const bool flushed = file_writer_flush ( writer );
+
+    if ( ( *writer ).frame )
+    {
+        memory_free ( ( *writer ).frame , ( *writer ).frame_capacity , MEMORY_TAG_FILE );
+    }
+    memory_free ( ( *writer ).buffer , ( *writer ).capacity , MEMORY_TAG_FILE );
+    memory_clear ( writer , sizeof ( file_writer_t ) );
+    return flushed;
+}
+
+bool
+file_writer_write
+(   file_writer_t*  writer
+,   u64             size
+,   const void*     src
+)
+{
+    if ( !writer || !src )
+    {
+        if ( !writer )
+        {
+            LOGERROR ( "file_writer_write: Missing argument: writer (writer to write with)." );
+        }
+        if ( !src )
+        {
+            LOGERROR ( "file_writer_write: Missing argument: src (content to write)." );
+        }
+        return false;
+    }
+
+    // Checksum the content on the way through, while it is still in cache.
+    ( *writer ).checksum = checksum_crc32c ( src , size , ( *writer ).checksum );
+
+    // Compressed? Y/N
+    if ( ( *writer ).frame )
+    {
+        // All content must pass through the buffer to be compressed, so copy
+        // it in pieces, flushing whenever the threshold is reached.
+        const u8* read = src;
+        while ( size )
+        {
+            const u64 piece = MIN ( size , ( *writer ).capacity - ( *writer ).length );
+            memory_copy ( ( *writer ).buffer + ( *writer ).length , read , piece );
+            ( *writer ).length += piece;
+            read += piece;
+            size -= piece;
+            if ( ( *writer ).length >= ( *writer ).threshold
+              && !file_writer_flush ( writer )
+               )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Too large to buffer? Y/N
+    if ( ( *writer ).length + size > ( *writer ).capacity )
+    {
+        // Write the buffered content and src together, without copying src.
+        const file_span_t spans[] = { { ( *writer ).buffer , ( *writer ).length }
+                                    , { src , size }
+                                    };
+        u64 written;
+        const bool success = file_writev ( ( *writer ).file , spans , 2 , &written );
+        ( *writer ).length = 0;
+        return success;
+    }
+
+    memory_copy ( ( *writer ).buffer + ( *writer ).length , src , size );
+    ( *writer ).length += size;
+
+    if ( ( *writer ).length >= ( *writer ).threshold )
+    {
+        return file_writer_flush ( writer );
+    }
+    return true;
+}
+
+bool
+file_writer_write_line
+(   file_writer_t*  writer
+,   u64             size
+,   const char*     src
+)
+{
+    return file_writer_write ( writer , size , src )
+        && file_writer_write ( writer , 1 , "\n" )
+        ;
+}
+
+bool
+file_writer_flush
+(   file_writer_t* writer
+)
+{
+    if ( !writer )
+    {
+        LOGERROR ( "file_writer_flush: Missing argument: writer (writer to flush)." );
+        return false;
+    }
+
+    if ( !( *writer ).length )
+    {
+        return true;
+    }
+
+    u64 written;
+
+    // Compressed? Y/N
+    if ( ( *writer ).frame )
+    {
+        bool success = true;
+        for ( u64 offset = 0; success && offset < ( *writer ).length; )
+        {
+            const u64 piece = MIN ( ( *writer ).length - offset
+                                  , ( u64 ) COMPRESS_MAX_SIZE
+                                  );
+            const u64 size = compress_frame ( ( *writer ).buffer + offset
+                                            , piece
+                                            , ( *writer ).frame
+                                            );
+            success = file_write ( ( *writer ).file
+                                 , size
+                                 , ( *writer ).frame
+                                 , &written
+                                 );
+            offset += piece;
+        }
+        ( *writer ).length = 0;
+        return success;
+    }
+
+    const bool success = file_write ( ( *writer ).file
+                                    , ( *writer ).length
+                                    , ( *writer ).buffer
+                                    , &written
+                                    );
+    ( *writer ).length = 0;
+    return success;
+}
+
+bool
+file_map
+(   file_t*         file
+,   FILE_MODE       mode
+,   FILE_MAP_HINT   hints
+,   file_map_t*     map
+)
+{
+    return platform_file_map ( file , mode , hints , map );
+}
+
+void
+file_unmap
+(   file_map_t* map
+)
+{
+    platform_file_unmap ( map );
+}
+
+bool
+file_map_advise
+(   file_map_t*     map
+,   FILE_MAP_HINT   hints
+)
+{
+    return platform_file_map_advise ( map , hints );
+}
+
+bool
+file_map_flush
+(   file_map_t* map
+)
+{
+    return platform_file_map_flush ( map );
 }
 
 void
@@ -132,4 +1018,273 @@ file_stderr
 )
 {
     platform_file_stderr ( file );
+}
+
+bool
+file_terminal
+(   file_t* file
+)
+{
+    return platform_file_terminal ( file );
+}
+
+bool
+_directory_open
+(   const char*     path
+,   bool            query_size
+,   directory_t*    directory
+)
+{
+    return platform_directory_open ( path , query_size , directory );
+}
+
+void
+directory_close
+(   directory_t* directory
+)
+{
+    platform_directory_close ( directory );
+}
+
+bool
+directory_next
+(   directory_t*        directory
+,   directory_entry_t*  entry
+)
+{
+    return platform_directory_next ( directory , entry );
+}
+
+bool
+directory_walk
+(   const char*                 path
+,   bool                        query_size
+,   directory_walk_function_t   function
+,   void*                       args
+)
+{
+    if ( !path || !function )
+    {
+        if ( !path )
+        {
+            LOGERROR ( "directory_walk: Missing argument: path (directory path)." );
+        }
+        if ( !function )
+        {
+            LOGERROR ( "directory_walk: Missing argument: function (callback function)." );
+        }
+        return false;
+    }
+
+    directory_walk_t walk;
+    memory_clear ( &walk , sizeof ( directory_walk_t ) );
+    walk.function = function;
+    walk.args = args;
+    walk.query_size = query_size;
+    walk.parallel = job_system_worker_count () > 0;
+
+    _directory_walk_visit ( &walk , path , _string_length ( path ) );
+
+    if ( walk.parallel )
+    {
+        job_wait ( &walk.counter );
+    }
+
+    return !atomic_load_u32 ( &walk.failed , ATOMIC_ACQUIRE );
+}
+
+bool
+_file_reader_fill
+(   file_reader_t* reader
+)
+{
+    const u64 unread = ( *reader ).end - ( *reader ).start;
+    memory_move ( ( *reader ).buffer
+                , ( *reader ).buffer + ( *reader ).start
+                , unread
+                );
+    ( *reader ).start = 0;
+    ( *reader ).end = unread;
+
+    u64 read;
+    const bool success = file_read ( ( *reader ).file
+                                   , ( *reader ).capacity - unread
+                                   , ( *reader ).buffer + unread
+                                   , &read
+                                   );
+    ( *reader ).end += read;
+    return success;
+}
+
+bool
+_file_reader_fill_compressed
+(   file_reader_t* reader
+)
+{
+    const u64 unread = ( *reader ).end - ( *reader ).start;
+    memory_move ( ( *reader ).buffer
+                , ( *reader ).buffer + ( *reader ).start
+                , unread
+                );
+    ( *reader ).start = 0;
+    ( *reader ).end = unread;
+
+    // Skip over any frames with no content.
+    u64 size = 0;
+    while ( !size )
+    {
+        u8 header[ COMPRESS_FRAME_HEADER_SIZE ];
+        u64 read;
+        if ( !file_read ( ( *reader ).file , sizeof ( header ) , header , &read ) )
+        {
+            return false;
+        }
+
+        // End of file? Y/N
+        if ( !read )
+        {
+            return true;
+        }
+        if ( read < sizeof ( header ) )
+        {
+            LOGWARN ( "file_reader_next_line: Ignoring truncated frame at the end of the file." );
+            return true;
+        }
+
+        u64 payload_size;
+        if ( !compress_frame_parse ( header , &payload_size , &size ) )
+        {
+            LOGERROR ( "file_reader_next_line: Malformed frame header." );
+            return false;
+        }
+
+        while ( ( *reader ).capacity - unread < size )
+        {
+            _file_reader_grow ( reader );
+        }
+        if ( ( *reader ).frame_capacity < payload_size )
+        {
+            if ( ( *reader ).frame )
+            {
+                memory_free ( ( *reader ).frame , ( *reader ).frame_capacity , MEMORY_TAG_FILE );
+            }
+            ( *reader ).frame_capacity = payload_size;
+            ( *reader ).frame = memory_allocate_uninit ( payload_size , MEMORY_TAG_FILE );
+        }
+
+        if ( !file_read ( ( *reader ).file
+                        , payload_size
+                        , ( *reader ).frame
+                        , &read
+                        ))
+        {
+            return false;
+        }
+        if ( read < payload_size )
+        {
+            LOGWARN ( "file_reader_next_line: Ignoring truncated frame at the end of the file." );
+            return true;
+        }
+
+        if ( !decompress_frame ( header , ( *reader ).frame , ( *reader ).buffer + unread ) )
+        {
+            LOGERROR ( "file_reader_next_line: Damaged frame." );
+            return false;
+        }
+    }
+
+    ( *reader ).end += size;
+    return true;
+}
+
+void
+_file_reader_grow
+(   file_reader_t* reader
+)
+{
+    const u64 capacity = 2 * ( *reader ).capacity;
+    u8* buffer = memory_allocate_uninit ( capacity , MEMORY_TAG_FILE );
+    const u64 unread = ( *reader ).end - ( *reader ).start;
+    memory_copy ( buffer , ( *reader ).buffer + ( *reader ).start , unread );
+    memory_free ( ( *reader ).buffer , ( *reader ).capacity , MEMORY_TAG_FILE );
+    ( *reader ).buffer = buffer;
+    ( *reader ).capacity = capacity;
+    ( *reader ).start = 0;
+    ( *reader ).end = unread;
+}
+
+void
+_directory_walk_visit
+(   directory_walk_t*   walk
+,   const char*         path
+,   u64                 path_length
+)
+{
+    directory_t directory;
+    if ( !_directory_open ( path , ( *walk ).query_size , &directory ) )
+    {
+        atomic_store_u32 ( &( *walk ).failed , true , ATOMIC_RELEASE );
+        return;
+    }
+
+    // Omit the separator if the path already ends with one.
+    const u64 prefix_length = ( path_length && ( path[ path_length - 1 ] == '/'
+                                              || path[ path_length - 1 ] == '\\'
+                                               ))
+                            ? path_length
+                            : path_length + 1
+                            ;
+
+    directory_entry_t entry;
+    while ( directory_next ( &directory , &entry ) )
+    {
+        if ( !( *walk ).function ( path , path_length , &entry , ( *walk ).args )
+          || entry.type != FILE_TYPE_DIRECTORY
+           )
+        {
+            continue;
+        }
+
+        // Build the subdirectory path (the entry name is only valid until the
+        // next call to directory_next).
+        const u64 subdirectory_length = prefix_length + entry.name_length;
+        const u64 size = sizeof ( directory_walk_job_t ) + subdirectory_length + 1;
+        directory_walk_job_t* job_args = memory_allocate ( size , MEMORY_TAG_FILE );
+        char* subdirectory = ( char* )( job_args + 1 );
+        memory_copy ( subdirectory , path , path_length );
+        subdirectory[ prefix_length - 1 ] = '/';
+        memory_copy ( subdirectory + prefix_length , entry.name , entry.name_length );
+        subdirectory[ subdirectory_length ] = 0;
+        ( *job_args ).walk = walk;
+        ( *job_args ).path_length = subdirectory_length;
+
+        if ( ( *walk ).parallel )
+        {
+            const job_t job = { _directory_walk_job , job_args };
+            if ( !job_submit ( &job , 1 , &( *walk ).counter ) )
+            {
+                _directory_walk_job ( job_args );
+            }
+        }
+        else
+        {
+            _directory_walk_job ( job_args );
+        }
+    }
+
+    directory_close ( &directory );
+}
+
+void
+_directory_walk_job
+(   void* args
+)
+{
+    directory_walk_job_t* job_args = args;
+    const u64 size = sizeof ( directory_walk_job_t ) + ( *job_args ).path_length + 1;
+    _directory_walk_visit ( ( *job_args ).walk
+                          , ( const char* )( job_args + 1 )
+                          , ( *job_args ).path_length
+                          );
+    memory_free ( job_args , size , MEMORY_TAG_FILE );
 }
\ No newline at end of file
@@ -16,15 +16,200 @@ typedef struct
 }
 file_t;
 
-/** @brief Type and instance definitions for file modes. */
+/**
+ * @brief Type definition for a buffered file reader (see file_reader_create).
+ */
+typedef struct
+{
+    file_t* file;
+    u8*     buffer;
+    u64     capacity;
+    u64     start;
+    u64     end;
+
+    // CRC32C of every byte consumed so far (see core/checksum.h).
+    u32     checksum;
+
+    // Compressed frame scratch buffer (see file_reader_create_compressed).
+    bool    compressed;
+    u8*     frame;
+    u64     frame_capacity;
+}
+file_reader_t;
+
+/** @brief Defines buffered file reader default capacity (in bytes). */
+#define FILE_READER_DEFAULT_CAPACITY \
+    KiB ( 64 )
+
+/**
+ * @brief Type definition for a buffered file writer (see file_writer_create).
+ */
+typedef struct
+{
+    file_t* file;
+    u8*     buffer;
+    u64     capacity;
+    u64     threshold;
+    u64     length;
+
+    // CRC32C of every byte written so far (see core/checksum.h).
+    u32     checksum;
+
+    // Compressed frame scratch buffer, or 0 if the writer does not compress
+    // (see file_writer_create_compressed).
+    u8*     frame;
+    u64     frame_capacity;
+}
+file_writer_t;
+
+/** @brief Defines buffered file writer default capacity (in bytes). */
+#define FILE_WRITER_DEFAULT_CAPACITY \
+    KiB ( 64 )
+
+/** @brief Type definition for a span of data to write (see file_writev). */
+typedef struct
+{
+    const void* data;
+    u64         size;
+}
+file_span_t;
+
+/** @brief Type definition for a buffer to read into (see file_readv_at). */
+typedef struct
+{
+    void*   data;
+    u64     size;
+}
+file_buffer_t;
+
+/**
+ * @brief Type and instance definitions for file modes.
+ *
+ * FILE_MODE_READ and FILE_MODE_WRITE select the access mode. The remaining
+ * flags are optional hints for file_open, and may be combined with either:
+ *
+ * FILE_MODE_SEQUENTIAL : The file will be read from start to end; the host
+ *                        platform reads ahead aggressively.
+ * FILE_MODE_RANDOM     : The file will be accessed at random offsets; the host
+ *                        platform does not read ahead.
+ * FILE_MODE_DIRECT     : Transfers bypass the host platform's page cache, so
+ *                        streaming a very large file does not evict everything
+ *                        else from it (see FILE_DIRECT_ALIGNMENT).
+ */
 typedef enum
 {
-    FILE_MODE_ACCESS = 0x0
-,   FILE_MODE_READ   = 0x1
-,   FILE_MODE_WRITE  = 0x2
+    FILE_MODE_ACCESS     = 0x00
+,   FILE_MODE_READ       = 0x01
+,   FILE_MODE_WRITE      = 0x02
+,   FILE_MODE_SEQUENTIAL = 0x04
+,   FILE_MODE_RANDOM     = 0x08
+,   FILE_MODE_DIRECT     = 0x10
 }
 FILE_MODE;
 
+/**
+ * @brief Defines the alignment (in bytes) of transfers on a file opened with
+ * FILE_MODE_DIRECT.
+ *
+ * A transfer bypasses the page cache only if its buffer address, its position
+ * in the file, and its size are all multiples of this value; allocate buffers
+ * with memory_allocate_aligned. A read may request past the end of the file.
+ *
+ * Unaligned transfers are performed through the page cache instead on GNU/Linux
+ * and macOS, but fail on Windows.
+ */
+#define FILE_DIRECT_ALIGNMENT 4096
+
+/** @brief Type and instance definitions for directory entry types. */
+typedef enum
+{
+    FILE_TYPE_UNKNOWN
+,   FILE_TYPE_FILE
+,   FILE_TYPE_DIRECTORY
+,   FILE_TYPE_SYMLINK
+,   FILE_TYPE_OTHER
+}
+FILE_TYPE;
+
+/** @brief Type definition for a directory (see directory_open). */
+typedef struct
+{
+    void*   handle;
+    bool    valid;
+}
+directory_t;
+
+/** @brief Type definition for a directory entry (see directory_next). */
+typedef struct
+{
+    const char* name;
+    u64         name_length;
+    FILE_TYPE   type;
+    u64         size;
+}
+directory_entry_t;
+
+/**
+ * @brief Type definition for a 'file stream' callback function (see
+ * file_stream).
+ * 
+ * @param data The chunk of the file content.
+ * @param size The number of bytes in data.
+ * @param offset The position of the chunk in the file.
+ * @param args Internal state arguments.
+ * @return true to continue streaming; false to stop.
+ */
+typedef bool ( *file_stream_function_t )( const void*   data
+                                        , u64           size
+                                        , u64           offset
+                                        , void*         args
+                                        );
+
+/** @brief Defines file stream default chunk size (in bytes). */
+#define FILE_STREAM_DEFAULT_CHUNK_SIZE \
+    MiB ( 1 )
+
+/**
+ * @brief Type definition for a 'directory walk' callback function (see
+ * directory_walk).
+ * 
+ * @param path The path of the directory containing the entry.
+ * @param path_length The length of path.
+ * @param entry The entry.
+ * @param args Internal state arguments.
+ * @return For a directory entry: true to descend into the directory; false to
+ * skip it. Ignored for any other entry.
+ */
+typedef bool ( *directory_walk_function_t )( const char*                path
+                                           , u64                        path_length
+                                           , const directory_entry_t*   entry
+                                           , void*                      args
+                                           );
+
+/**
+ * @brief Type and instance definitions for memory-mapped file access hints
+ * (see file_map_advise).
+ */
+typedef enum
+{
+    FILE_MAP_HINT_NONE       = 0x0
+,   FILE_MAP_HINT_SEQUENTIAL = 0x1
+,   FILE_MAP_HINT_RANDOM     = 0x2
+,   FILE_MAP_HINT_WILLNEED   = 0x4
+,   FILE_MAP_HINT_HUGE_PAGES = 0x8
+}
+FILE_MAP_HINT;
+
+/** @brief Type definition for a memory-mapped view of a file (see file_map). */
+typedef struct
+{
+    void*   data;
+    u64     size;
+    void*   handle;
+    bool    writable;
+}
+file_map_t;
+
 /**
  * @brief Tests if a file with the provided mode exists at the provided path on
  * the host platform.
@@ -70,6 +255,26 @@ file_close
 (   file_t* file
 );
 
+/**
+ * @brief Reserves storage for a file on the host platform ahead of writing to
+ * it, so a large file written piece by piece is laid out contiguously rather
+ * than fragmented.
+ *
+ * Neither the file size nor the file position changes; the reserved space is
+ * filled by subsequent writes. If the host file system cannot reserve space in
+ * advance, this function does nothing and succeeds.
+ *
+ * @param file Handle to a file opened for writing.
+ * @param size The number of bytes to reserve, counted from the start of the
+ * file.
+ * @return true on success; false otherwise.
+ */
+bool
+file_preallocate
+(   file_t* file
+,   u64     size
+);
+
 /**
  * @brief Queries the size (in bytes) of a file on the host platform.
  * 
@@ -125,10 +330,67 @@ file_read
 ,   u64*    read
 );
 
+/**
+ * @brief Reads a specified amount of content from a file on the host platform,
+ * starting at a specified offset, into an output buffer.
+ * 
+ * Unlike file_read, this function neither uses nor modifies the file position.
+ * Several threads may therefore read different regions of one file at once
+ * (e.g. to divide a large file among a pool of workers), provided no other
+ * operation on the same file runs concurrently.
+ * 
+ * Reading stops at the end of the file; an offset at or past the end of the
+ * file reads nothing.
+ * 
+ * @param file Handle to the file to read.
+ * @param offset The position in the file to start reading from.
+ * @param size Number of bytes to read.
+ * @param dst Output buffer for the content.
+ * @param read Output buffer to hold number of bytes read.
+ * @return true if file read into dst successfully; false otherwise.
+ */
+bool
+file_read_at
+(   file_t* file
+,   u64     offset
+,   u64     size
+,   void*   dst
+,   u64*    read
+);
+
+/**
+ * @brief Reads consecutive content from a file on the host platform, starting
+ * at a specified offset, into several output buffers in order.
+ * 
+ * Equivalent to calling file_read_at on each buffer in turn (with the offset
+ * advanced past the previous buffer), but lets the host platform scatter the
+ * content with a single read where it can. Like file_read_at, this function
+ * neither uses nor modifies the file position.
+ * 
+ * @param file Handle to the file to read.
+ * @param offset The position in the file to start reading from.
+ * @param buffers The output buffers.
+ * @param count Number of output buffers.
+ * @param read Output buffer to hold total number of bytes read.
+ * @return true if file read into buffers successfully; false otherwise.
+ */
+bool
+file_readv_at
+(   file_t*                 file
+,   u64                     offset
+,   const file_buffer_t*    buffers
+,   u64                     count
+,   u64*                    read
+);
+
 /**
  * @brief Reads content from a file from the host platform into a resizable
  * string buffer until EOF or line break encountered (see container/string.h).
  * 
+ * The file position is left just past the line, so each call reads ahead and
+ * then seeks back. To read many lines in sequence, use a buffered reader
+ * instead (see file_reader_create).
+ * 
  * Uses dynamic memory allocation. Call string_destroy to free.
  * 
  * @param file Handle to the file to read.
@@ -141,6 +403,179 @@ file_read_line
 ,   char**  dst
 );
 
+/**
+ * @brief Initializes a buffered reader for a file on the host platform.
+ * 
+ * The reader fetches the file a buffer at a time, starting from the current
+ * file position, and serves consecutive lines out of the buffer; reading a
+ * file line by line this way costs one host platform read per buffer, rather
+ * than a read and a seek per line (see file_read_line). The reader behaves
+ * identically on every host platform.
+ * 
+ * While the reader is in use, the file should not be read from, written to,
+ * or repositioned directly.
+ * 
+ * Uses dynamic memory allocation. Call file_reader_destroy to free.
+ * 
+ * Use _file_reader_create to explicitly specify the buffer capacity, or
+ * file_reader_create to use the default.
+ * 
+ * @param file Handle to the file to read. Must remain open until the reader is
+ * destroyed.
+ * @param capacity The buffer capacity (in bytes). Must be non-zero.
+ * @param reader Output buffer for the reader.
+ * @return true on success; false otherwise.
+ */
+bool
+_file_reader_create
+(   file_t*         file
+,   u64             capacity
+,   file_reader_t*  reader
+);
+
+#define file_reader_create(file,reader) \
+    _file_reader_create ( (file) , FILE_READER_DEFAULT_CAPACITY , (reader) )
+
+/**
+ * @brief Variant of _file_reader_create for a file written by a compressing
+ * writer (see file_writer_create_compressed), or by the logger subsystem with
+ * compression enabled (see logger_compress in core/logger.h). The reader
+ * decompresses the file a frame at a time as it is read, and serves the
+ * decompressed lines; every frame's checksum is verified.
+ * 
+ * A file which ends partway through a frame (e.g. because the writer was cut
+ * short by a crash) reads as if it ended just before that frame.
+ * 
+ * Uses dynamic memory allocation. Call file_reader_destroy to free.
+ * 
+ * Use _file_reader_create_compressed to explicitly specify the buffer capacity,
+ * or file_reader_create_compressed to use the default. The buffer grows to hold
+ * a whole frame if needed.
+ * 
+ * @param file Handle to the file to read. Must remain open until the reader is
+ * destroyed.
+ * @param capacity The buffer capacity (in bytes). Must be non-zero.
+ * @param reader Output buffer for the reader.
+ * @return true on success; false otherwise.
+ */
+bool
+_file_reader_create_compressed
+(   file_t*         file
+,   u64             capacity
+,   file_reader_t*  reader
+);
+
+#define file_reader_create_compressed(file,reader) \
+    _file_reader_create_compressed ( (file) , FILE_READER_DEFAULT_CAPACITY , (reader) )
+
+/**
+ * @brief Frees the memory used by a buffered file reader.
+ * 
+ * Any content which was buffered but not yet read is given back: the file
+ * position is reset to just past the last line read from the reader. A
+ * compressed reader cannot give back decompressed content, so the file position
+ * is left past the last frame read instead.
+ * 
+ * @param reader The reader to free.
+ */
+void
+file_reader_destroy
+(   file_reader_t* reader
+);
+
+/**
+ * @brief Advances a buffered file reader to its next line, without copying.
+ * O(n).
+ * 
+ * The line is returned as the address and length of its content within the
+ * reader's buffer; it is valid only until the next call on the reader, and is
+ * not null-terminated. A line ends at a `\n` character, which is consumed but
+ * not included, or at the end of the file. If a line is longer than the
+ * buffer, the buffer grows to hold it. A caller which parses and discards
+ * each line thus performs no memory allocation or copying.
+ * 
+ * Use _file_reader_next_line to optionally strip a `\r` character preceding
+ * the `\n` (i.e. a CRLF line ending), or file_reader_next_line to keep it.
+ * 
+ * Usage:
+ *   const char* line;
+ *   u64 length;
+ *   while ( file_reader_next_line ( &reader , &line , &length ) )
+ *   { ... }
+ * 
+ * @param reader The reader to advance. Must be non-zero.
+ * @param strip_cr Strip a trailing `\r` character from the line? Y/N
+ * @param line Output buffer for the address of the line. Must be non-zero.
+ * @param length Output buffer for the length of the line. Must be non-zero.
+ * @return true if a line was read; false at the end of the file, or on error
+ * (in either case, line is set to 0 and length to 0).
+ */
+bool
+_file_reader_next_line
+(   file_reader_t*  reader
+,   bool            strip_cr
+,   const char**    line
+,   u64*            length
+);
+
+#define file_reader_next_line(reader,line,length) \
+    _file_reader_next_line ( (reader) , false , (line) , (length) )
+
+/**
+ * @brief Reads the next line from a buffered file reader into a resizable
+ * string (see container/string.h).
+ * 
+ * Equivalent to file_reader_next_line followed by a copy of the line.
+ * 
+ * Uses dynamic memory allocation. Call string_destroy to free.
+ * 
+ * @param reader The reader to read from. Must be non-zero.
+ * @param dst Output buffer to hold the handle to the resizable output string.
+ * @return true if a line was read; false at the end of the file, or on error
+ * (in either case, dst is set to 0).
+ */
+bool
+file_reader_read_line
+(   file_reader_t*  reader
+,   char**          dst
+);
+
+/**
+ * @brief Reads more of a file into a buffered file reader, for a caller which
+ * parses the reader's unread content directly (i.e. the reader.end -
+ * reader.start bytes at reader.buffer + reader.start) rather than line by
+ * line; e.g. a delimited record parser (see core/csv.h).
+ * 
+ * The unread content is moved to the front of the buffer, and the rest of the
+ * buffer is filled from the file. If the unread content already fills the
+ * buffer, the buffer grows first, so every successful call with read non-zero
+ * makes more content available. Any address into the buffer is invalidated.
+ * 
+ * @param reader The reader to fill. Must be non-zero.
+ * @param read Output buffer for the number of bytes added (0 at the end of
+ * the file). Must be non-zero.
+ * @return true on success; false on read error.
+ */
+bool
+file_reader_fill
+(   file_reader_t*  reader
+,   u64*            read
+);
+
+/**
+ * @brief Consumes unread content from a buffered file reader, as if it had
+ * been read (see file_reader_fill).
+ * 
+ * @param reader The reader to advance. Must be non-zero.
+ * @param size The number of bytes to consume. Must not exceed the amount of
+ * unread content.
+ */
+void
+file_reader_consume
+(   file_reader_t*  reader
+,   u64             size
+);
+
 /**
  * @brief Generates a copy of the entire contents of a file on the host
  * platform.
@@ -161,6 +596,51 @@ file_read_all
 ,   u64*    read
 );
 
+/**
+ * @brief Streams the entire contents of a file on the host platform through a
+ * callback function, one fixed-size chunk at a time.
+ * 
+ * Unlike file_read_all, memory usage does not depend on the file size, so this
+ * is suitable for files larger than the memory available to the application.
+ * Reads are positional (see file_read_at); the file position is unchanged.
+ * 
+ * With prefetch enabled, the chunk following the one being processed is read
+ * in the background (see platform/io_queue.h) into a second buffer, so reading
+ * and processing overlap.
+ * 
+ * Uses dynamic memory allocation: one chunk, or two with prefetch. Chunk
+ * buffers are aligned for direct I/O (see FILE_DIRECT_ALIGNMENT).
+ * 
+ * Use file_stream to stream in chunks of FILE_STREAM_DEFAULT_CHUNK_SIZE with
+ * prefetch enabled, or _file_stream to specify these explicitly.
+ * 
+ * @param file Handle to the file to read.
+ * @param chunk_size The number of bytes to pass to function at a time (the
+ * final chunk may be smaller). Must be non-zero. Rounded up to a multiple of
+ * FILE_DIRECT_ALIGNMENT.
+ * @param prefetch Read the next chunk in the background? Y/N
+ * @param function The callback function to invoke on each chunk.
+ * @param args Internal state arguments for the callback.
+ * @return true if every chunk was read successfully (including if function
+ * stopped the stream early); false otherwise.
+ */
+bool
+_file_stream
+(   file_t*                 file
+,   u64                     chunk_size
+,   bool                    prefetch
+,   file_stream_function_t  function
+,   void*                   args
+);
+
+#define file_stream(file,function,args)                 \
+    _file_stream ( (file)                               \
+                 , FILE_STREAM_DEFAULT_CHUNK_SIZE       \
+                 , true                                 \
+                 , (function)                           \
+                 , (args)                               \
+                 )
+
 /**
  * @brief Writes a specified amount of data to a file on the host platform.
  * 
@@ -189,6 +669,29 @@ file_write
     })
    
 
+/**
+ * @brief Writes a specified amount of data to a file on the host platform,
+ * starting at a specified offset.
+ * 
+ * Unlike file_write, this function neither uses nor modifies the file
+ * position (see file_read_at). Writing past the end of the file extends it.
+ * 
+ * @param file Handle to the file to write to.
+ * @param offset The position in the file to start writing at.
+ * @param size Number of bytes to write.
+ * @param src The data to write.
+ * @param written Output buffer to hold number of bytes written.
+ * @return true if src written to file successfully; false otherwise.
+ */
+bool
+file_write_at
+(   file_t*     file
+,   u64         offset
+,   u64         size
+,   const void* src
+,   u64*        written
+);
+
 /**
  * @brief Writes a string to file on the host platform and appends the `\n`
  * character.
@@ -216,6 +719,343 @@ file_write_line
         file_write_line ( (file) , _string_length ( src__ ) , src__ ); \
     })
 
+/**
+ * @brief Writes several spans of data to a file on the host platform, in
+ * order, using as few system calls as possible.
+ * 
+ * Equivalent to calling file_write on each span in turn, but lets the host
+ * platform gather the spans into a single write where it can. Empty spans are
+ * skipped.
+ * 
+ * @param file Handle to the file to write to.
+ * @param spans The spans to write.
+ * @param count Number of spans.
+ * @param written Output buffer to hold total number of bytes written.
+ * @return true if every span written to file successfully; false otherwise.
+ */
+bool
+file_writev
+(   file_t*             file
+,   const file_span_t*  spans
+,   u64                 count
+,   u64*                written
+);
+
+/**
+ * @brief Writes a specified amount of data to a file on the host platform,
+ * using nothing but the host platform's write system call.
+ * 
+ * Unlike file_write, this function never logs, allocates memory or takes a
+ * lock, and retries writes which are interrupted by a signal, so it is
+ * async-signal-safe: it may be called from a signal handler, or while the
+ * calling thread holds any lock (see logger_fatal in core/logger.h). Invalid
+ * arguments are not reported; the function just returns false.
+ * 
+ * @param file Handle to the file to write to.
+ * @param size Number of bytes to write.
+ * @param src The data to write.
+ * @return true if src written to file successfully; false otherwise.
+ */
+bool
+file_write_raw
+(   file_t*     file
+,   u64         size
+,   const void* src
+);
+
+/**
+ * @brief Creates a buffered file writer.
+ * 
+ * The writer collects small writes in a buffer in memory, and only writes to
+ * the file once the buffer holds at least threshold bytes (or on
+ * file_writer_flush / file_writer_destroy). Writes which do not fit in the
+ * buffer are passed to the file together with the buffered content in a
+ * single call to file_writev, without being copied.
+ * 
+ * While the writer is in use, the file should only be written to via the
+ * writer; content written to the file directly may be reordered with content
+ * still held in the buffer.
+ * 
+ * Uses dynamic memory allocation. Call file_writer_destroy to free.
+ * 
+ * Use _file_writer_create to explicitly specify the buffer capacity and
+ * auto-flush threshold, or file_writer_create to use the default for both.
+ * 
+ * @param file Handle to the file to write to.
+ * @param capacity Buffer capacity (in bytes).
+ * @param threshold Buffer fill level (in bytes) at which the writer flushes
+ * automatically. Must be non-zero and no larger than capacity.
+ * @param writer Output buffer for the writer.
+ * @return true if writer created successfully; false otherwise.
+ */
+bool
+_file_writer_create
+(   file_t*         file
+,   u64             capacity
+,   u64             threshold
+,   file_writer_t*  writer
+);
+
+#define file_writer_create(file,writer)                    \
+    _file_writer_create ( (file)                           \
+                        , FILE_WRITER_DEFAULT_CAPACITY     \
+                        , FILE_WRITER_DEFAULT_CAPACITY     \
+                        , (writer)                         \
+                        )
+
+/**
+ * @brief Variant of _file_writer_create which compresses the content it
+ * writes (see core/compress.h).
+ * 
+ * Every write is collected in the buffer; each time the buffer is flushed, its
+ * content is compressed into a self-contained frame, which is written to the
+ * file in a single call. A larger threshold thus compresses better, at the
+ * cost of holding more unwritten content in memory. Use a compressed reader to
+ * read the file back (see file_reader_create_compressed).
+ * 
+ * Uses dynamic memory allocation. Call file_writer_destroy to free.
+ * 
+ * Use _file_writer_create_compressed to explicitly specify the buffer capacity
+ * and auto-flush threshold, or file_writer_create_compressed to use the
+ * default for both.
+ * 
+ * @param file Handle to the file to write to.
+ * @param capacity Buffer capacity (in bytes).
+ * @param threshold Buffer fill level (in bytes) at which the writer flushes
+ * automatically. Must be non-zero and no larger than capacity.
+ * @param writer Output buffer for the writer.
+ * @return true if writer created successfully; false otherwise.
+ */
+bool
+_file_writer_create_compressed
+(   file_t*         file
+,   u64             capacity
+,   u64             threshold
+,   file_writer_t*  writer
+);
+
+#define file_writer_create_compressed(file,writer)                    \
+    _file_writer_create_compressed ( (file)                           \
+                                   , FILE_WRITER_DEFAULT_CAPACITY     \
+                                   , FILE_WRITER_DEFAULT_CAPACITY     \
+                                   , (writer)                         \
+                                   )
+
+/**
+ * @brief Flushes and frees the memory used by a buffered file writer.
+ * 
+ * Does not close the file.
+ * 
+ * @param writer The writer to free.
+ * @return true if the buffered content written to file successfully; false
+ * otherwise.
+ */
+bool
+file_writer_destroy
+(   file_writer_t* writer
+);
+
+/**
+ * @brief Writes a specified amount of data via a buffered file writer.
+ * 
+ * Use file_writer_write to explicitly specify string length, or
+ * _file_writer_write to compute the length of a null-terminated string before
+ * passing it to file_writer_write.
+ * 
+ * @param writer The writer to write with.
+ * @param size Number of bytes to write.
+ * @param src The data to write.
+ * @return true if src buffered or written to file successfully; false
+ * otherwise.
+ */
+bool
+file_writer_write
+(   file_writer_t*  writer
+,   u64             size
+,   const void*     src
+);
+
+#define _file_writer_write(writer,src)                                      \
+    ({                                                                      \
+        const char* src__ = (src);                                          \
+        file_writer_write ( (writer) , _string_length ( src__ ) , src__ );  \
+    })
+
+/**
+ * @brief Writes a string via a buffered file writer and appends the `\n`
+ * character.
+ * 
+ * Use file_writer_write_line to explicitly specify string length, or
+ * _file_writer_write_line to compute the length of a null-terminated string
+ * before passing it to file_writer_write_line.
+ * 
+ * @param writer The writer to write with.
+ * @param size Number of bytes to write.
+ * @param src The string to write.
+ * @return true if src buffered or written to file successfully; false
+ * otherwise.
+ */
+bool
+file_writer_write_line
+(   file_writer_t*  writer
+,   u64             size
+,   const char*     src
+);
+
+#define _file_writer_write_line(writer,src)                                     \
+    ({                                                                          \
+        const char* src__ = (src);                                              \
+        file_writer_write_line ( (writer) , _string_length ( src__ ) , src__ ); \
+    })
+
+/**
+ * @brief Writes any content held in the buffer of a buffered file writer to
+ * file.
+ * 
+ * @param writer The writer to flush.
+ * @return true if the buffered content written to file successfully; false
+ * otherwise.
+ */
+bool
+file_writer_flush
+(   file_writer_t* writer
+);
+
+/**
+ * @brief Copies a file on the host platform, creating the destination file or
+ * replacing its content.
+ * 
+ * The copy is performed by the host platform without passing the content
+ * through the application, sharing storage with the source file where the file
+ * system supports it (reflink / clone):
+ *   GNU/Linux : FICLONE, else copy_file_range, else sendfile.
+ *   macOS     : clonefile, else copyfile.
+ *   Windows   : CopyFileEx.
+ * If none of these apply, the content is copied through a large buffer.
+ * 
+ * @param src_path The filepath of the file to copy.
+ * @param dst_path The filepath to copy to.
+ * @return true if the file was copied successfully; false otherwise.
+ */
+bool
+file_copy
+(   const char* src_path
+,   const char* dst_path
+);
+
+/**
+ * @brief Copies a range of content from one file on the host platform to
+ * another, e.g. to concatenate files.
+ * 
+ * Like file_read_at, the source range is read without using or modifying the
+ * source file position, and stops at the end of the source file. Like
+ * file_write, the content is written at the current position in the
+ * destination file, which advances past it.
+ * 
+ * Uses the same host platform fast paths as file_copy where available (only
+ * GNU/Linux can copy a range between open files in the kernel), and copies
+ * through a large buffer otherwise.
+ * 
+ * @param dst Handle to the file to write to.
+ * @param src Handle to the file to read from.
+ * @param offset The position in the source file to start reading at.
+ * @param size Maximum number of bytes to copy.
+ * @param transferred Output buffer to hold the number of bytes copied.
+ * @return true if the range was copied successfully; false otherwise.
+ */
+bool
+file_transfer
+(   file_t* dst
+,   file_t* src
+,   u64     offset
+,   u64     size
+,   u64*    transferred
+);
+
+/**
+ * @brief Maps the entire contents of a file on the host platform into memory.
+ * 
+ * The file contents may then be read (or, for a read-write mapping, written)
+ * directly at map.data, without copying them into a buffer first; pages are
+ * loaded by the host platform on demand, and may be shared with its file cache.
+ * Changes made through a read-write mapping are written back to the file (see
+ * file_map_flush).
+ * 
+ * The mapping covers the size of the file at the time of the call; it neither
+ * grows nor shrinks with the file, and does not affect the file position. An
+ * empty file produces an empty mapping (map.data is 0). The mapping remains
+ * valid after the file is closed.
+ * 
+ * Call file_unmap to free.
+ * 
+ * @param file Handle to the file to map.
+ * @param mode FILE_MODE_READ for a read-only mapping, or FILE_MODE_READ |
+ * FILE_MODE_WRITE for a read-write mapping. The file must have been opened
+ * with (at least) the same mode.
+ * @param hints Access hints to apply to the mapping (see file_map_advise).
+ * @param map Output buffer for the mapping.
+ * @return true if the file was mapped successfully; false otherwise.
+ */
+bool
+file_map
+(   file_t*         file
+,   FILE_MODE       mode
+,   FILE_MAP_HINT   hints
+,   file_map_t*     map
+);
+
+/**
+ * @brief Unmaps a memory-mapped file.
+ * 
+ * Changes made through a read-write mapping are kept, but are not necessarily
+ * written back to the file before this function returns (see file_map_flush).
+ * 
+ * @param map The mapping to unmap.
+ */
+void
+file_unmap
+(   file_map_t* map
+);
+
+/**
+ * @brief Advises the host platform how a memory-mapped file will be accessed.
+ * 
+ * Hints only affect performance, never the contents of the mapping. Hints
+ * which the host platform does not support are ignored.
+ * 
+ * FILE_MAP_HINT_SEQUENTIAL : Pages will be accessed in order; read ahead
+ *                            aggressively and release pages once read.
+ * FILE_MAP_HINT_RANDOM     : Pages will be accessed in no particular order;
+ *                            do not read ahead. Mutually exclusive with
+ *                            FILE_MAP_HINT_SEQUENTIAL.
+ * FILE_MAP_HINT_WILLNEED   : The whole mapping will be accessed soon; start
+ *                            loading it now.
+ * FILE_MAP_HINT_HUGE_PAGES : Back the mapping with huge pages where the host
+ *                            platform and filesystem allow it.
+ * 
+ * @param map The mapping to advise. Must be non-zero.
+ * @param hints Bitwise OR of any number of FILE_MAP_HINT flags.
+ * @return false if the host platform rejected a supported hint; true
+ * otherwise.
+ */
+bool
+file_map_advise
+(   file_map_t*     map
+,   FILE_MAP_HINT   hints
+);
+
+/**
+ * @brief Writes any changes made through a read-write memory-mapped file back
+ * to the file.
+ * 
+ * @param map The mapping to flush. Must be non-zero.
+ * @return true on success; false otherwise.
+ */
+bool
+file_map_flush
+(   file_map_t* map
+);
+
 /**
  * @brief Obtains a handle to the host platform's standard input stream.
  * 
@@ -246,4 +1086,102 @@ file_stderr
 (   file_t* file
 );
 
+/**
+ * @brief Queries whether a file is attached to a terminal (e.g. a console
+ * window, as opposed to a pipe or a regular file).
+ * 
+ * @param file Handle to a file.
+ * @return true if file is attached to a terminal; false otherwise.
+ */
+bool
+file_terminal
+(   file_t* file
+);
+
+/**
+ * @brief Opens a directory on the host platform for enumeration.
+ * 
+ * Entries are read from the host platform in large batches (getdents64 on
+ * GNU/Linux, FindFirstFileEx on Windows, getattrlistbulk on macOS), and the
+ * type of each entry is reported without querying it separately.
+ * 
+ * The size of each regular file may optionally be reported as well. Windows
+ * and macOS report it in the same batch; on GNU/Linux it costs one additional
+ * system call per regular file, so only request it when needed.
+ * 
+ * Uses dynamic memory allocation. Call directory_close to free.
+ * 
+ * Use _directory_open to explicitly request file sizes, or directory_open to
+ * skip them.
+ * 
+ * @param path The directory path.
+ * @param query_size Report the size of each regular file? Y/N
+ * @param directory Output buffer for directory.
+ * @return true if directory opened successfully; false otherwise.
+ */
+bool
+_directory_open
+(   const char*     path
+,   bool            query_size
+,   directory_t*    directory
+);
+
+#define directory_open(path,directory) \
+    _directory_open ( (path) , false , (directory) )
+
+/**
+ * @brief Closes a directory on the host platform.
+ * 
+ * @param directory Handle to the directory to close.
+ */
+void
+directory_close
+(   directory_t* directory
+);
+
+/**
+ * @brief Reads the next entry from a directory on the host platform.
+ * 
+ * Entries are returned in no particular order. The `.` and `..` entries are
+ * skipped. The entry name is not a copy; it remains valid only until the next
+ * call to directory_next or directory_close.
+ * 
+ * @param directory Handle to the directory to read.
+ * @param entry Output buffer for the entry.
+ * @return true if an entry was read; false at the end of the directory, or on
+ * error.
+ */
+bool
+directory_next
+(   directory_t*        directory
+,   directory_entry_t*  entry
+);
+
+/**
+ * @brief Visits every entry beneath a directory on the host platform,
+ * recursively.
+ * 
+ * Symbolic links are reported, but never followed.
+ * 
+ * If the job system is running (see core/job.h), each directory is enumerated
+ * by a separate job, so the callback may be invoked concurrently from several
+ * threads and must be thread-safe. Otherwise, the walk is performed on the
+ * calling thread.
+ * 
+ * @param path The directory path.
+ * @param query_size Report the size of each regular file? Y/N (see
+ * _directory_open).
+ * @param function The callback function to invoke on each entry.
+ * @param args Internal state arguments for the callback.
+ * @return true if every directory was enumerated successfully; false
+ * otherwise.
+ */
+bool
+directory_walk
+(   const char*                 path
+,   bool                        query_size
+,   directory_walk_function_t   function
+,   void*                       args
+);
+
 #endif  // FILESYSTEM_H
@@ -0,0 +1,320 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/io_queue.c
+ * @brief Implementation of the platform/io_queue header.
+ * (see platform/io_queue.h for additional details)
+ */
+#include "platform/io_queue.h"
+#include "platform/platform.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/clamp.h"
+
+/** @brief Number of requests collected at a time when the caller discards them. */
+#define IO_QUEUE_COLLECT_BATCH ( ( u64 ) 64 )
+
+/** @brief Type definition for internal state. */
+typedef struct
+{
+    u64             depth;
+    u64             pending;
+
+    // Host platform backend, or 0 if requests are performed synchronously.
+    void*           internal;
+
+    // Synchronous only: requests performed but not yet collected.
+    io_request_t**  completed;
+    u64             completed_count;
+}
+state_t;
+
+/**
+ * @brief Performs a request synchronously.
+ *
+ * @param request The request to perform.
+ */
+void
+_io_queue_perform
+(   io_request_t* request
+);
+
+bool
+io_queue_create
+(   u64             depth
+,   io_queue_t**    queue
+)
+{
+    if ( !depth || !queue )
+    {
+        if ( !depth )
+        {
+            LOGERROR ( "io_queue_create: Value of depth argument must be non-zero." );
+        }
+        if ( !queue )
+        {
+            LOGERROR ( "io_queue_create: Missing argument: queue (output buffer)." );
+        }
+        return false;
+    }
+
+    depth = MIN ( depth , ( u64 ) IO_QUEUE_MAX_DEPTH );
+
+    state_t* state = memory_allocate ( sizeof ( state_t ) , MEMORY_TAG_FILE );
+    ( *state ).depth = depth;
+    ( *state ).pending = 0;
+    ( *state ).internal = 0;
+    ( *state ).completed = 0;
+    ( *state ).completed_count = 0;
+
+    if ( !platform_io_queue_create ( depth , &( *state ).internal ) )
+    {
+        LOGDEBUG ( "io_queue_create: No asynchronous I/O backend available; requests will be performed synchronously." );
+        ( *state ).internal = 0;
+        ( *state ).completed = memory_allocate ( sizeof ( io_request_t* ) * depth
+                                               , MEMORY_TAG_FILE
+                                               );
+    }
+
+    *queue = state;
+    return true;
+}
+
+void
+io_queue_destroy
+(   io_queue_t** queue
+)
+{
+    if ( !queue || !*queue )
+    {
+        return;
+    }
+
+    state_t* state = *queue;
+
+    io_queue_flush ( state );
+
+    if ( ( *state ).internal )
+    {
+        platform_io_queue_destroy ( ( *state ).internal );
+    }
+    else
+    {
+        memory_free ( ( *state ).completed
+                    , sizeof ( io_request_t* ) * ( *state ).depth
+                    , MEMORY_TAG_FILE
+                    );
+    }
+
+    memory_free ( state , sizeof ( state_t ) , MEMORY_TAG_FILE );
+    *queue = 0;
+}
+
+u64
+io_queue_depth
+(   const io_queue_t* queue
+)
+{
+    return ( *( ( const state_t* ) queue ) ).depth;
+}
+
+u64
+io_queue_pending
+(   const io_queue_t* queue
+)
+{
+    return ( *( ( const state_t* ) queue ) ).pending;
+}
+
+bool
+io_queue_submit
+(   io_queue_t*     queue
+,   io_request_t*   requests
+,   u64             count
+)
+{
+    if ( !requests )
+    {
+        LOGERROR ( "io_queue_submit: Missing argument: requests." );
+        return false;
+    }
+    for ( u64 i = 0; i < count; ++i )
+    {
+        if ( !requests[ i ].file || ( !requests[ i ].data && requests[ i ].size ) )
+        {
+            LOGERROR ( "io_queue_submit: Request %u of %u is missing its %s."
+                     , i + 1 , count
+                     , ( !requests[ i ].file ) ? "file" : "data"
+                     );
+            return false;
+        }
+        if ( requests[ i ].operation != IO_OPERATION_READ
+          && requests[ i ].operation != IO_OPERATION_WRITE
+           )
+        {
+            LOGERROR ( "io_queue_submit: Request %u of %u has an invalid operation."
+                     , i + 1 , count
+                     );
+            return false;
+        }
+    }
+
+    state_t* state = queue;
+
+    u64 submitted = 0;
+    while ( submitted < count )
+    {
+        // Queue full? Y/N
+        if ( ( *state ).pending == ( *state ).depth )
+        {
+            _io_queue_collect ( state , 1 , 0 , ( *state ).depth );
+        }
+
+        const u64 batch = MIN ( count - submitted
+                              , ( *state ).depth - ( *state ).pending
+                              );
+        for ( u64 i = 0; i < batch; ++i )
+        {
+            requests[ submitted + i ].transferred = 0;
+            requests[ submitted + i ].success = false;
+        }
+
+        if ( ( *state ).internal )
+        {
+            if ( !platform_io_queue_submit ( ( *state ).internal
+                                           , requests + submitted
+                                           , batch
+                                           ))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            for ( u64 i = 0; i < batch; ++i )
+            {
+                _io_queue_perform ( &requests[ submitted + i ] );
+                ( *state ).completed[ ( *state ).completed_count ] = &requests[ submitted + i ];
+                ( *state ).completed_count += 1;
+            }
+        }
+
+        ( *state ).pending += batch;
+        submitted += batch;
+    }
+
+    return true;
+}
+
+u64
+_io_queue_collect
+(   io_queue_t*     queue
+,   u64             min_count
+,   io_request_t**  completed
+,   u64             capacity
+)
+{
+    state_t* state = queue;
+
+    min_count = MIN ( min_count , MIN ( capacity , ( *state ).pending ) );
+
+    io_request_t* batch[ IO_QUEUE_COLLECT_BATCH ];
+    u64 collected = 0;
+    while ( collected < capacity && ( *state ).pending )
+    {
+        io_request_t** dst = completed ? completed + collected : batch;
+        const u64 limit = completed ? capacity - collected
+                                    : MIN ( capacity - collected , IO_QUEUE_COLLECT_BATCH )
+                                    ;
+        const u64 required = ( collected < min_count ) ? MIN ( min_count - collected , limit )
+                                                       : 0
+                                                       ;
+
+        u64 count;
+        if ( ( *state ).internal )
+        {
+            count = platform_io_queue_collect ( ( *state ).internal
+                                              , required
+                                              , dst
+                                              , limit
+                                              );
+        }
+        else
+        {
+            count = MIN ( ( *state ).completed_count , limit );
+            memory_copy ( dst , ( *state ).completed , sizeof ( io_request_t* ) * count );
+            memory_move ( ( *state ).completed
+                        , ( *state ).completed + count
+                        , sizeof ( io_request_t* ) * ( ( *state ).completed_count - count )
+                        );
+            ( *state ).completed_count -= count;
+        }
+
+        if ( !count )
+        {
+            break;
+        }
+
+        ( *state ).pending -= count;
+        collected += count;
+
+        // Hand each collected request over to its job.
+        for ( u64 i = 0; i < count; ++i )
+        {
+            if ( ( *( dst[ i ] ) ).job.function )
+            {
+                job_submit ( &( *( dst[ i ] ) ).job , 1 , ( *( dst[ i ] ) ).counter );
+            }
+        }
+
+        // Everything collected that was already complete? Y/N
+        if ( collected >= min_count && count < limit )
+        {
+            break;
+        }
+    }
+
+    return collected;
+}
+
+void
+io_queue_flush
+(   io_queue_t* queue
+)
+{
+    state_t* state = queue;
+    while ( ( *state ).pending )
+    {
+        _io_queue_collect ( state , ( *state ).pending , 0 , ( *state ).pending );
+    }
+}
+
+void
+_io_queue_perform
+(   io_request_t* request
+)
+{
+    if ( !( *request ).size )
+    {
+        ( *request ).success = true;
+    }
+    else if ( ( *request ).operation == IO_OPERATION_READ )
+    {
+        ( *request ).success = platform_file_read_at ( ( *request ).file
+                                                     , ( *request ).offset
+                                                     , ( *request ).size
+                                                     , ( *request ).data
+                                                     , &( *request ).transferred
+                                                     );
+    }
+    else
+    {
+        ( *request ).success = platform_file_write_at ( ( *request ).file
+                                                      , ( *request ).offset
+                                                      , ( *request ).size
+                                                      , ( *request ).data
+                                                      , &( *request ).transferred
+                                                      );
+    }
+}
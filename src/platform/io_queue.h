@@ -0,0 +1,194 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/io_queue.h
+ * @brief Provides an interface for submitting file reads and writes to the
+ * host platform asynchronously.
+ *
+ * Requests are submitted in batches, and proceed in the background while the
+ * calling thread does other work; completed requests are collected later with
+ * io_queue_poll or io_queue_wait. A request may carry a job, which is
+ * submitted to the job system (see core/job.h) as soon as the request is
+ * collected, so processing of one read can overlap with the next. A job
+ * running on a fiber may instead suspend until its request is collected (see
+ * job_counter_release).
+ *
+ * Backends:
+ *   GNU/Linux : io_uring.
+ *   Other     : Requests are performed synchronously during submission, and
+ *               are complete by the time io_queue_submit returns. The
+ *               interface is otherwise identical.
+ *
+ * A queue is not thread-safe; submit and collect requests from one thread at a
+ * time.
+ *
+ * Requests on a file opened with FILE_MODE_DIRECT must be aligned (see
+ * FILE_DIRECT_ALIGNMENT); unlike file_read and file_write, the queue does not
+ * fall back on the page cache for unaligned requests.
+ */
+#ifndef IO_QUEUE_H
+#define IO_QUEUE_H
+
+#include "common.h"
+
+#include "core/job.h"
+
+#include "platform/filesystem.h"
+
+/** @brief Type declaration for an asynchronous I/O queue. */
+typedef void io_queue_t;
+
+/** @brief Defines asynchronous I/O queue default depth. */
+#define IO_QUEUE_DEFAULT_DEPTH 64
+
+/** @brief Defines asynchronous I/O queue maximum depth. */
+#define IO_QUEUE_MAX_DEPTH 4096
+
+/** @brief Type and instance definitions for asynchronous I/O operations. */
+typedef enum
+{
+    IO_OPERATION_READ
+,   IO_OPERATION_WRITE
+}
+IO_OPERATION;
+
+/**
+ * @brief Type definition for an asynchronous I/O request.
+ *
+ * Fill in the fields above the line before submission (see io_queue_submit).
+ * The fields below the line are set once the request is collected.
+ */
+typedef struct
+{
+    IO_OPERATION    operation;
+    file_t*         file;
+    u64             offset;     // Position in the file.
+    void*           data;       // Output buffer (read) or content (write).
+    u64             size;       // Number of bytes to transfer.
+    job_t           job;        // Optional; submitted once collected.
+    job_counter_t*  counter;    // Optional; counter for job.
+
+    ////////////////////////////////////////////////////////////////////////////
+
+    u64             transferred;
+    bool            success;
+}
+io_request_t;
+
+/**
+ * @brief Initializes an asynchronous I/O queue.
+ *
+ * Uses dynamic memory allocation. Call io_queue_destroy to free.
+ *
+ * @param depth The maximum number of requests which may be in flight at any
+ * one time. Deeper queues let fast storage (e.g. NVMe) service more requests
+ * in parallel. Must be non-zero. Clamped to IO_QUEUE_MAX_DEPTH.
+ * @param queue Output buffer for queue.
+ * @return true on success; false otherwise.
+ */
+bool
+io_queue_create
+(   u64             depth
+,   io_queue_t**    queue
+);
+
+/**
+ * @brief Frees the memory used by an asynchronous I/O queue.
+ *
+ * Waits for any requests still in flight first (see io_queue_flush).
+ *
+ * @param queue Handle to the queue to free.
+ */
+void
+io_queue_destroy
+(   io_queue_t** queue
+);
+
+/**
+ * @brief Queries the depth of an asynchronous I/O queue.
+ *
+ * @param queue The queue to query. Must be non-zero.
+ * @return The maximum number of requests which may be in flight at once.
+ */
+u64
+io_queue_depth
+(   const io_queue_t* queue
+);
+
+/**
+ * @brief Queries the number of requests submitted to an asynchronous I/O queue
+ * which have not been collected.
+ *
+ * @param queue The queue to query. Must be non-zero.
+ * @return The number of requests in flight.
+ */
+u64
+io_queue_pending
+(   const io_queue_t* queue
+);
+
+/**
+ * @brief Submits a batch of requests to an asynchronous I/O queue.
+ *
+ * Like file_read_at, requests neither use nor modify the file position, and a
+ * read stops at the end of the file. Each request, its file, and its data must
+ * remain valid until the request is collected. Requests in flight at the same
+ * time may complete in any order.
+ *
+ * When the queue is full, this function collects completed requests (and
+ * submits their jobs) until there is room.
+ *
+ * @param queue The queue to submit to. Must be non-zero.
+ * @param requests An array of requests.
+ * @param count The number of requests in the array.
+ * @return true if every request submitted successfully; false otherwise.
+ */
+bool
+io_queue_submit
+(   io_queue_t*     queue
+,   io_request_t*   requests
+,   u64             count
+);
+
+/**
+ * @brief Collects completed requests from an asynchronous I/O queue.
+ *
+ * The job of each collected request (if any) is submitted to the job system,
+ * which must be running.
+ *
+ * Use io_queue_poll to collect only requests which have already completed, or
+ * io_queue_wait to block until at least one request completes.
+ *
+ * @param queue The queue to collect from. Must be non-zero.
+ * @param min_count Block until at least this many requests (or every request
+ * in flight, if fewer) have been collected.
+ * @param completed Optional output buffer to hold handles to the collected
+ * requests. Pass 0 to discard them.
+ * @param capacity The maximum number of requests to collect.
+ * @return The number of requests collected.
+ */
+u64
+_io_queue_collect
+(   io_queue_t*     queue
+,   u64             min_count
+,   io_request_t**  completed
+,   u64             capacity
+);
+
+#define io_queue_poll(queue,completed,capacity) \
+    _io_queue_collect ( (queue) , 0 , (completed) , (capacity) )
+
+#define io_queue_wait(queue,completed,capacity) \
+    _io_queue_collect ( (queue) , 1 , (completed) , (capacity) )
+
+/**
+ * @brief Blocks until every request submitted to an asynchronous I/O queue has
+ * been collected.
+ *
+ * @param queue The queue to flush. Must be non-zero.
+ */
+void
+io_queue_flush
+(   io_queue_t* queue
+);
+
+#endif  // IO_QUEUE_H
@@ -14,16 +14,30 @@
 #include "container/string.h"
 #include "core/logger.h"
 #include "core/memory.h"
+#include "core/profile.h"
 #include "math/clamp.h"
+#include "platform/cpu.h"
 
 // Platform layer dependencies.
+#define _GNU_SOURCE // O_DIRECT, fallocate
 #define _FILE_OFFSET_BITS 64
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <linux/fs.h>         // FICLONE
+#include <linux/io_uring.h>
+#include <linux/futex.h>
+#include <linux/perf_event.h>
 #include <pthread.h>
+#include <sys/auxv.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/sysinfo.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #if _POSIX_C_SOURCE >= 199309L
     #include <time.h> // nanosleep
@@ -33,6 +47,24 @@
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * @brief Maximum number of buffers platform_file_writev (or
+ * platform_file_readv_at) passes to the host platform at a time.
+ */
+#define PLATFORM_FILE_VECTOR_BATCH 64
+
+/**
+ * @brief Maximum number of bytes platform_file_transfer asks the kernel to copy
+ * at a time.
+ */
+#define PLATFORM_FILE_TRANSFER_MAX ( ( u64 ) 0x7FFFF000 )
+
+/**
+ * @brief Size of the buffer platform_file_transfer copies through if the
+ * kernel cannot copy between the files itself.
+ */
+#define PLATFORM_FILE_TRANSFER_BUFFER_SIZE MiB ( 1 )
+
 /** @brief Type definition for a platform-dependent file data structure. */
 typedef struct
 {
@@ -42,9 +74,218 @@ typedef struct
     u64         size;
     u64         position;
     bool        initialized;
+    bool        direct;     // O_DIRECT currently set on descriptor? Y/N
 }
 platform_file_t;
 
+/**
+ * @brief Tests whether a transfer satisfies the alignment requirements of
+ * direct I/O (see FILE_DIRECT_ALIGNMENT).
+ */
+#define PLATFORM_FILE_ALIGNED(address,offset,size)                            \
+    ( !( ( ( ( u64 )(address) ) | ( ( u64 )(offset) ) | ( ( u64 )(size) ) )  \
+         % FILE_DIRECT_ALIGNMENT                                              \
+       ))
+
+/** @brief Path prefix of the sysfs directory of a logical core. */
+#define PLATFORM_SYSFS_CPU "/sys/devices/system/cpu/cpu"
+
+/** @brief Size of the buffer platform_directory_next reads entries into. */
+#define PLATFORM_DIRECTORY_BUFFER_SIZE KiB ( 32 )
+
+/**
+ * @brief Type definition for a directory entry as returned by getdents64
+ * (glibc does not declare one).
+ */
+typedef struct
+{
+    u64     d_ino;
+    i64     d_off;
+    u16     d_reclen;
+    u8      d_type;
+    char    d_name[];
+}
+platform_dirent64_t;
+
+/** @brief Type definition for a platform-dependent directory data structure. */
+typedef struct
+{
+    i32         descriptor;
+    bool        query_size;
+    u64         offset;
+    u64         length;
+    u8          buffer[ PLATFORM_DIRECTORY_BUFFER_SIZE ];
+}
+platform_directory_t;
+
+/**
+ * @brief Maximum number of bytes a single io_uring read or write may request.
+ * Larger requests are split.
+ */
+#define PLATFORM_IO_QUEUE_MAX_TRANSFER ( ( u64 ) 0x7FFFF000 )
+
+/** @brief Type definition for a platform-dependent io_uring instance. */
+typedef struct
+{
+    i32                     descriptor;
+
+    // Submission ring.
+    void*                   sq_ring;
+    u64                     sq_ring_size;
+    u32*                    sq_tail;
+    u32*                    sq_array;
+    u32                     sq_mask;
+    struct io_uring_sqe*    sqes;
+    u64                     sqes_size;
+    u32                     unsubmitted;
+
+    // Completion ring.
+    void*                   cq_ring;
+    u64                     cq_ring_size;
+    u32*                    cq_head;
+    u32*                    cq_tail;
+    u32                     cq_mask;
+    struct io_uring_cqe*    cqes;
+}
+platform_io_queue_t;
+
+/**
+ * @brief For a file opened with FILE_MODE_DIRECT, sets O_DIRECT on the file
+ * descriptor if the next transfer is aligned, or clears it otherwise, so that
+ * an unaligned transfer goes through the page cache rather than failing.
+ * 
+ * @param file The file.
+ * @param aligned Is the next transfer aligned? Y/N
+ */
+void
+_platform_file_direct
+(   platform_file_t*    file
+,   bool                aligned
+);
+
+/**
+ * @brief Queues the remaining part of a request on an io_uring instance. The
+ * request is not passed to the kernel until _platform_io_queue_enter.
+ * 
+ * @param queue The io_uring instance.
+ * @param request The request.
+ */
+void
+_platform_io_queue_prepare
+(   platform_io_queue_t*    queue
+,   io_request_t*           request
+);
+
+/**
+ * @brief Passes any queued requests to the kernel, and optionally waits for
+ * a completion.
+ * 
+ * @param queue The io_uring instance.
+ * @param min_complete Number of completions to wait for (0 or 1).
+ * @return true on success; false otherwise.
+ */
+bool
+_platform_io_queue_enter
+(   platform_io_queue_t*    queue
+,   u32                     min_complete
+);
+
+/**
+ * @brief Writes a path of the form <prefix><number><suffix> (e.g. a sysfs
+ * attribute of a numbered device).
+ * 
+ * @param path Output buffer for the path. Must be large enough, and distinct
+ * from prefix.
+ * @param prefix The part before the number.
+ * @param number The number.
+ * @param suffix The part after the number.
+ * @return path.
+ */
+char*
+_platform_sysfs_path
+(   char*       path
+,   const char* prefix
+,   u64         number
+,   const char* suffix
+);
+
+/**
+ * @brief Reads a (small) sysfs attribute.
+ * 
+ * @param path The path of the attribute.
+ * @param content Output buffer for the content, which is null-terminated.
+ * @param capacity The size of the buffer in bytes.
+ * @return The number of characters read (0 on failure).
+ */
+u64
+_platform_sysfs_read
+(   const char* path
+,   char*       content
+,   u64         capacity
+);
+
+/**
+ * @brief Reads a sysfs attribute as an unsigned integer, with an optional K, M
+ * or G suffix (e.g. a cache size, "48K").
+ * 
+ * @param path The path of the attribute.
+ * @param value Output buffer for the value.
+ * @return true on success; false otherwise.
+ */
+bool
+_platform_sysfs_read_u64
+(   const char* path
+,   u64*        value
+);
+
+/**
+ * @brief Parses a sysfs cpulist (e.g. "0-3,8-11") into a set of logical cores.
+ * 
+ * @param content The cpulist.
+ * @param length The number of characters in content.
+ * @param set Output buffer for the set.
+ * @return true if the set is non-empty; false otherwise.
+ */
+bool
+_platform_cpulist_parse
+(   const char* content
+,   u64         length
+,   cpu_set_t*  set
+);
+
+/**
+ * @brief Size of the frame which platform_fiber_switch saves on the stack of
+ * the context it switches from (callee-saved registers and return address).
+ */
+#if defined(__x86_64__)
+#define PLATFORM_FIBER_FRAME_SIZE 64
+#elif defined(__aarch64__)
+#define PLATFORM_FIBER_FRAME_SIZE 160
+#endif
+
+/**
+ * @brief Saves the callee-saved registers of the running context on its stack,
+ * stores its stack pointer, then loads another stack pointer and restores the
+ * registers saved there. Implemented in assembly (see platform_fiber_switch).
+ * 
+ * @param from Output buffer for the stack pointer of the running context.
+ * @param to The stack pointer of the context to switch to.
+ */
+void
+_platform_fiber_switch
+(   void**  from
+,   void*   to
+);
+
+/**
+ * @brief First return address of a new context (see platform_fiber_create).
+ * Calls the context's function with its arguments, which were placed in
+ * callee-saved registers. Implemented in assembly; never called directly.
+ */
+void
+_platform_fiber_start
+( void );
+
 // Global definitions for standard input, output, and error file streams.
 static platform_file_t platform_stdin;  /** @brief Standard input stream handle. */
 static platform_file_t platform_stdout; /** @brief Standard output stream handle. */
@@ -66,6 +307,88 @@ platform_memory_free
     free ( blk );
 }
 
+u64
+platform_memory_page_size
+( void )
+{
+    return sysconf ( _SC_PAGESIZE );
+}
+
+void*
+platform_memory_reserve
+(   u64 size
+)
+{
+    #ifdef MAP_NORESERVE
+    const i32 flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    #else
+    const i32 flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #endif
+    void* blk = mmap ( 0 , size , PROT_NONE , flags , -1 , 0 );
+    if ( blk == MAP_FAILED )
+    {
+        platform_log_error ( "platform_memory_reserve ("PLATFORM_STRING"): mmap failed on %u bytes." , size );
+        return 0;
+    }
+    return blk;
+}
+
+bool
+platform_memory_commit
+(   void*   blk
+,   u64     size
+,   bool    huge_pages
+)
+{
+    if ( mprotect ( blk , size , PROT_READ | PROT_WRITE ) )
+    {
+        platform_log_error ( "platform_memory_commit ("PLATFORM_STRING"): mprotect failed on %u bytes." , size );
+        return false;
+    }
+    #ifdef MADV_HUGEPAGE
+    if ( huge_pages )
+    {
+        // Transparent huge pages may be disabled system-wide, so this may be
+        // rejected even if the host platform supports them.
+        madvise ( blk , size , MADV_HUGEPAGE );
+    }
+    #else
+    ( void ) huge_pages;
+    #endif
+    return true;
+}
+
+void
+platform_memory_release
+(   void*   blk
+,   u64     size
+)
+{
+    munmap ( blk , size );
+}
+
+bool
+platform_memory_bind
+(   void*   blk
+,   u64     size
+,   u32     node
+)
+{
+    if ( node >= 64 )
+    {
+        return false;
+    }
+    // Called via syscall, so as not to depend on libnuma. MPOL_PREFERRED falls
+    // back on other nodes (rather than failing) if the node is out of memory.
+    const u64 mask = ( ( u64 ) 1 ) << node;
+    if ( syscall ( SYS_mbind , blk , size , 1 /* MPOL_PREFERRED */ , &mask , 64 , 0 ) )
+    {
+        platform_log_error ( "platform_memory_bind ("PLATFORM_STRING"): mbind failed on node %u." , node );
+        return false;
+    }
+    return true;
+}
+
 void*
 platform_memory_clear
 (   void*   blk
@@ -147,53 +470,107 @@ bool
 platform_thread_create
 (   thread_start_function_t function
 ,   void*                   args
-,   bool                    auto_detach
+,   const thread_options_t* options
 ,   thread_t*               thread
 )
 {
-    if ( !function || !thread )
+    if ( !function || !options || !thread )
     {
         if ( !function )
         {
             LOGERROR ( "platform_thread_create ("PLATFORM_STRING"): Missing argument: function (threaded process to run)." );
-            return false;
+        }
+        if ( !options )
+        {
+            LOGERROR ( "platform_thread_create ("PLATFORM_STRING"): Missing argument: options." );
         }
         if ( !thread )
         {
             LOGERROR ( "platform_thread_create ("PLATFORM_STRING"): Missing argument: thread (output buffer)." );
-            return false;
         }
+        return false;
+    }
+
+    pthread_attr_t attributes;
+    if ( pthread_attr_init ( &attributes ) )
+    {
+        platform_log_error ( "platform_thread_create ("PLATFORM_STRING"): pthread_attr_init failed." );
+        return false;
+    }
+    if ( ( *options ).auto_detach )
+    {
+        pthread_attr_setdetachstate ( &attributes , PTHREAD_CREATE_DETACHED );
+    }
+    if ( ( *options ).stack_size )
+    {
+        const u64 page_size = platform_memory_page_size ();
+        pthread_attr_setstacksize ( &attributes
+                                  , MAX ( aligned ( ( *options ).stack_size , page_size )
+                                        , ( u64 ) PTHREAD_STACK_MIN
+                                        ));
+    }
+    // Pin the thread before it starts, so it never runs on another core.
+    if ( ( *options ).affinity )
+    {
+        cpu_set_t set;
+        CPU_ZERO ( &set );
+        for ( u64 cpu = 0; cpu < 64; ++cpu )
+        {
+            if ( ( *options ).affinity & ( ( ( u64 ) 1 ) << cpu ) )
+            {
+                CPU_SET ( cpu , &set );
+            }
+        }
+        pthread_attr_setaffinity_np ( &attributes , sizeof ( cpu_set_t ) , &set );
+    }
+
+    // SCHED_BATCH threads yield to interactive (SCHED_OTHER) threads;
+    // SCHED_RR threads preempt both, but require CAP_SYS_NICE.
+    if ( ( *options ).priority != THREAD_PRIORITY_NORMAL )
+    {
+        const i32 policy = ( ( *options ).priority == THREAD_PRIORITY_LOW ) ? SCHED_BATCH
+                                                                           : SCHED_RR
+                                                                           ;
+        struct sched_param parameters;
+        memory_clear ( &parameters , sizeof ( struct sched_param ) );
+        parameters.sched_priority = sched_get_priority_min ( policy );
+        pthread_attr_setinheritsched ( &attributes , PTHREAD_EXPLICIT_SCHED );
+        pthread_attr_setschedpolicy ( &attributes , policy );
+        pthread_attr_setschedparam ( &attributes , &parameters );
     }
 
     DISABLE_WARNING ( -Wcast-function-type );
-    const i32 pthread_create_result = pthread_create ( ( pthread_t* ) &( *thread ).id
-                                                     , 0
+    pthread_t handle;
+    const i32 pthread_create_result = pthread_create ( &handle
+                                                     , &attributes
                                                      , ( void* (*)( void* ) ) function
                                                      , args
                                                      );
     REENABLE_WARNING ();
+    pthread_attr_destroy ( &attributes );
     if ( pthread_create_result )
     {
+        errno = pthread_create_result;
         platform_log_error ( "platform_thread_create ("PLATFORM_STRING"): pthread_create failed." );
         return false;
     }
 
-    if ( auto_detach )
+    ( *thread ).handle = ( u64 ) handle;
+    ( *thread ).id = ( u64 ) handle;
+
+    if ( ( *options ).name )
     {
-        if ( pthread_detach ( ( *thread ).id ) )
-        {
-            platform_log_error ( "platform_thread_create ("PLATFORM_STRING"): pthread_detach failed on auto-detach thread #%u."
-                               , ( *thread ).id
-                               );
-            return false;
-        }
+        // Linux rejects names longer than 15 characters.
+        char name[ THREAD_NAME_MAX_LENGTH + 1 ];
+        const u64 length = _string_length_clamped ( ( *options ).name , THREAD_NAME_MAX_LENGTH );
+        memory_copy ( name , ( *options ).name , length );
+        name[ length ] = 0;
+        pthread_setname_np ( ( *thread ).handle , name );
     }
 
-    ( *thread ).internal = memory_allocate ( sizeof ( u64 )
-                                           , MEMORY_TAG_THREAD
-                                           );
-    *( ( u64* )( ( *thread ).internal ) ) = ( *thread ).id;
-
+    // An auto-detach thread releases its own resources, so the handle must
+    // not be used.
+    ( *thread ).valid = !( *options ).auto_detach;
     return true;
 }
 
@@ -202,12 +579,12 @@ platform_thread_destroy
 (   thread_t* thread
 )
 {
-    if ( !thread || !( *thread ).internal )
+    if ( !thread || !( *thread ).valid )
     {
         return;
     }
 
-    if ( pthread_cancel ( *( ( pthread_t* )( ( *thread ).internal ) ) ) )
+    if ( pthread_cancel ( ( pthread_t )( *thread ).handle ) )
     {
         platform_log_error ( "platform_thread_destroy ("PLATFORM_STRING"): pthread_cancel failed on thread #%u."
                            , ( *thread ).id
@@ -215,8 +592,7 @@ platform_thread_destroy
         return;
     }
 
-    memory_free ( ( *thread ).internal , sizeof ( u64 ) , MEMORY_TAG_THREAD );
-    ( *thread ).internal = 0;
+    ( *thread ).valid = false;
     ( *thread ).id = 0;
 }
 
@@ -225,12 +601,12 @@ platform_thread_detach
 (   thread_t* thread
 )
 {
-    if ( !thread || !( *thread ).internal )
+    if ( !thread || !( *thread ).valid )
     {
         return;
     }
 
-    if ( pthread_detach ( *( ( pthread_t* )( ( *thread ).internal ) ) ) )
+    if ( pthread_detach ( ( pthread_t )( *thread ).handle ) )
     {
         platform_log_error ( "platform_thread_detach ("PLATFORM_STRING"): pthread_detach failed on thread #%u."
                            , ( *thread ).id
@@ -238,8 +614,7 @@ platform_thread_detach
         return;
     }
 
-    memory_free ( ( *thread ).internal , sizeof ( u64 ) , MEMORY_TAG_THREAD );
-    ( *thread ).internal = 0;
+    ( *thread ).valid = false;
 }
 
 void
@@ -247,12 +622,12 @@ platform_thread_cancel
 (   thread_t* thread
 )
 {
-    if ( !thread || !( *thread ).internal )
+    if ( !thread || !( *thread ).valid )
     {
         return;
     }
 
-    if ( pthread_cancel ( *( ( pthread_t* )( ( *thread ).internal ) ) ) )
+    if ( pthread_cancel ( ( pthread_t )( *thread ).handle ) )
     {
         platform_log_error ( "platform_thread_cancel ("PLATFORM_STRING"): pthread_cancel failed on thread #%u."
                            , ( *thread ).id
@@ -260,8 +635,7 @@ platform_thread_cancel
         return;
     }
 
-    memory_free ( ( *thread ).internal , sizeof ( u64 ) , MEMORY_TAG_THREAD );
-    ( *thread ).internal = 0;
+    ( *thread ).valid = false;
     ( *thread ).id = 0;
 }
 
@@ -270,11 +644,23 @@ platform_thread_wait
 (   thread_t* thread
 )
 {
-    // TODO: Implement this.
-    if ( !thread || !( *thread ).internal )
+    if ( !thread || !( *thread ).valid )
+    {
+        return false;
+    }
+
+    if ( pthread_join ( ( pthread_t )( *thread ).handle , 0 ) )
     {
+        platform_log_error ( "platform_thread_wait ("PLATFORM_STRING"): pthread_join failed on thread #%u."
+                           , ( *thread ).id
+                           );
         return false;
     }
+
+    // A joined thread has already released its resources; it must not be
+    // cancelled or detached again.
+    ( *thread ).valid = false;
+    ( *thread ).id = 0;
     return true;
 }
 
@@ -285,7 +671,7 @@ platform_thread_wait_timeout
 )
 {
     // TODO: Implement this.
-    if ( !thread || !( *thread ).internal )
+    if ( !thread || !( *thread ).valid )
     {
         return false;
     }
@@ -298,11 +684,7 @@ platform_thread_active
 )
 {
     // TODO: Implement this.
-    if ( !thread || !( *thread ).internal )
-    {
-        return false;
-    }
-    return thread && ( *thread ).internal;
+    return thread && ( *thread ).valid;
 }
 
 void
@@ -314,6 +696,35 @@ platform_thread_sleep
     platform_sleep ( ms );
 }
 
+bool
+platform_thread_affinity_set_node
+(   u32 node
+)
+{
+    // Parse the node's cpulist from sysfs.
+    char path[ 96 ];
+    char content[ 1024 ];
+    _platform_sysfs_path ( path , "/sys/devices/system/node/node" , node , "/cpulist" );
+    const u64 length = _platform_sysfs_read ( path , content , sizeof ( content ) );
+    if ( !length )
+    {
+        platform_log_error ( "platform_thread_affinity_set_node ("PLATFORM_STRING"): Failed to read %s." , path );
+        return false;
+    }
+
+    cpu_set_t set;
+    if ( !_platform_cpulist_parse ( content , length , &set ) )
+    {
+        return false;
+    }
+    if ( sched_setaffinity ( 0 , sizeof ( cpu_set_t ) , &set ) )
+    {
+        platform_log_error ( "platform_thread_affinity_set_node ("PLATFORM_STRING"): sched_setaffinity failed on node %u." , node );
+        return false;
+    }
+    return true;
+}
+
 u64
 platform_thread_id
 ( void )
@@ -321,6 +732,181 @@ platform_thread_id
     return pthread_self ();
 }
 
+#if defined(__x86_64__)
+__asm__
+(   ".text\n"
+    ".globl _platform_fiber_switch\n"
+    ".type _platform_fiber_switch, @function\n"
+    ".p2align 4\n"
+    "_platform_fiber_switch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size _platform_fiber_switch, .-_platform_fiber_switch\n"
+    ".globl _platform_fiber_start\n"
+    ".type _platform_fiber_start, @function\n"
+    ".p2align 4\n"
+    "_platform_fiber_start:\n"
+    "    movq %r12, %rdi\n"
+    "    callq *%r13\n"
+    "    ud2\n"
+    ".size _platform_fiber_start, .-_platform_fiber_start\n"
+);
+#elif defined(__aarch64__)
+__asm__
+(   ".text\n"
+    ".globl _platform_fiber_switch\n"
+    ".type _platform_fiber_switch, %function\n"
+    ".p2align 4\n"
+    "_platform_fiber_switch:\n"
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8, d9, [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x2, sp\n"
+    "    str x2, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8, d9, [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+    ".size _platform_fiber_switch, .-_platform_fiber_switch\n"
+    ".globl _platform_fiber_start\n"
+    ".type _platform_fiber_start, %function\n"
+    ".p2align 4\n"
+    "_platform_fiber_start:\n"
+    "    mov x0, x19\n"
+    "    blr x20\n"
+    "    brk #0\n"
+    ".size _platform_fiber_start, .-_platform_fiber_start\n"
+);
+#endif
+
+bool
+platform_fiber_create
+(   u64                 stack_size
+,   fiber_function_t    function
+,   void*               args
+,   fiber_context_t*    context
+)
+{
+#ifdef PLATFORM_FIBER_FRAME_SIZE
+    // The lowest page is never committed, so that a stack overflow faults
+    // (the stack grows down).
+    const u64 page_size = platform_memory_page_size ();
+    const u64 size = stack_size + page_size;
+    u8* stack = platform_memory_reserve ( size );
+    if ( !stack )
+    {
+        return false;
+    }
+    if ( !platform_memory_commit ( stack + page_size , stack_size , false ) )
+    {
+        platform_memory_release ( stack , size );
+        return false;
+    }
+
+    // Build the frame which _platform_fiber_switch restores the first time the
+    // context is switched to: it returns into _platform_fiber_start, with the
+    // function and its arguments in callee-saved registers.
+    u64* frame = ( u64* )( stack + size - PLATFORM_FIBER_FRAME_SIZE );
+    memory_clear ( frame , PLATFORM_FIBER_FRAME_SIZE );
+    #if defined(__x86_64__)
+    frame[ 0 ] = 0x1F80 | ( ( ( u64 ) 0x037F ) << 32 );  // Default MXCSR and x87 control word.
+    frame[ 3 ] = ( u64 ) function;                      // r13
+    frame[ 4 ] = ( u64 ) args;                          // r12
+    frame[ 7 ] = ( u64 ) _platform_fiber_start;         // Return address.
+    #elif defined(__aarch64__)
+    frame[ 0 ] = ( u64 ) args;                          // x19
+    frame[ 1 ] = ( u64 ) function;                      // x20
+    frame[ 11 ] = ( u64 ) _platform_fiber_start;        // x30 (link register).
+    #endif
+
+    ( *context ).handle = frame;
+    ( *context ).stack = stack;
+    ( *context ).stack_size = size;
+    ( *context ).function = function;
+    ( *context ).args = args;
+    return true;
+#else
+    ( void ) stack_size;
+    ( void ) function;
+    ( void ) args;
+    ( void ) context;
+    LOGERROR ( "platform_fiber_create ("PLATFORM_STRING"): Not supported on this processor architecture." );
+    return false;
+#endif
+}
+
+void
+platform_fiber_destroy
+(   fiber_context_t* context
+)
+{
+    if ( ( *context ).stack )
+    {
+        platform_memory_release ( ( *context ).stack , ( *context ).stack_size );
+    }
+    memory_clear ( context , sizeof ( fiber_context_t ) );
+}
+
+bool
+platform_fiber_thread
+(   fiber_context_t* context
+)
+{
+    // The thread's stack pointer is saved by the first switch away from it.
+    memory_clear ( context , sizeof ( fiber_context_t ) );
+    return true;
+}
+
+void
+platform_fiber_switch
+(   fiber_context_t*    from
+,   fiber_context_t*    to
+)
+{
+#ifdef PLATFORM_FIBER_FRAME_SIZE
+    _platform_fiber_switch ( &( *from ).handle , ( *to ).handle );
+#else
+    ( void ) from;
+    ( void ) to;
+#endif
+}
+
 bool
 platform_mutex_create
 (   mutex_t* mutex
@@ -440,6 +1026,37 @@ platform_mutex_unlock
     return true;
 }
 
+bool
+platform_futex_wait
+(   u32*    address
+,   u32     expected
+,   u64     timeout_ms
+)
+{
+    struct timespec timeout;
+    struct timespec* timeout_ = 0;
+    if ( timeout_ms != PLATFORM_FUTEX_WAIT_FOREVER )
+    {
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = ( timeout_ms % 1000 ) * 1000 * 1000;
+        timeout_ = &timeout;
+    }
+    if ( syscall ( SYS_futex , address , FUTEX_WAIT_PRIVATE , expected , timeout_ , 0 , 0 ) == -1 )
+    {
+        return errno != ETIMEDOUT;
+    }
+    return true;
+}
+
+void
+platform_futex_wake
+(   u32*    address
+,   bool    all
+)
+{
+    syscall ( SYS_futex , address , FUTEX_WAKE_PRIVATE , all ? 0x7FFFFFFF : 1 , 0 , 0 , 0 );
+}
+
 bool
 platform_file_exists
 (   const char* path
@@ -518,7 +1135,20 @@ platform_file_open
         return false;
     }
 
-    i32 descriptor = open ( path , mode | O_CREAT , S_IRWXU );
+    i32 descriptor = open ( path
+                          , mode | O_CREAT | ( ( mode_ & FILE_MODE_DIRECT ) ? O_DIRECT : 0 )
+                          , S_IRWXU
+                          );
+
+    // Direct I/O unsupported by the file system? Y/N
+    if ( descriptor == -1 && errno == EINVAL && ( mode_ & FILE_MODE_DIRECT ) )
+    {
+        LOGDEBUG ( "platform_file_open ("PLATFORM_STRING"): Direct I/O is not supported for file %s; the page cache will be used instead."
+                 , path
+                 );
+        mode_ &= ~FILE_MODE_DIRECT;
+        descriptor = open ( path , mode | O_CREAT , S_IRWXU );
+    }
 
     if ( descriptor == -1 )
     {
@@ -546,6 +1176,17 @@ platform_file_open
         return false;
     }
 
+    // Pass access pattern hint to the kernel.
+    if ( mode_ & ( FILE_MODE_SEQUENTIAL | FILE_MODE_RANDOM ) )
+    {
+        posix_fadvise ( descriptor
+                      , 0
+                      , 0
+                      , ( mode_ & FILE_MODE_SEQUENTIAL ) ? POSIX_FADV_SEQUENTIAL
+                                                         : POSIX_FADV_RANDOM
+                      );
+    }
+
     // Precompute the file size.
     struct stat file_info;
     fstat ( descriptor , &file_info );
@@ -559,6 +1200,7 @@ platform_file_open
     ( *file ).size = file_info.st_size;
     ( *file ).position = 0;
     ( *file ).initialized = true;
+    ( *file ).direct = mode_ & FILE_MODE_DIRECT;
     
     ( *file_ ).handle = file;
     ( *file_ ).valid = true;
@@ -592,32 +1234,81 @@ platform_file_close
     ( *file_ ).handle = 0;
 }
 
-u64
-platform_file_size
+bool
+platform_file_preallocate
 (   file_t* file_
+,   u64     size
 )
 {
     if ( !file_ )
     {
-        LOGERROR ( "platform_file_size ("PLATFORM_STRING"): Missing argument: file." );
-        return 0;
+        LOGERROR ( "platform_file_preallocate ("PLATFORM_STRING"): Missing argument: file." );
+        return false;
     }
 
     if ( !( *file_ ).handle || !( *file_ ).valid )
     {
-        return 0;
+        return false;
     }
 
     platform_file_t* file = ( *file_ ).handle;
-    return ( *file ).size;
-}
 
-u64
-platform_file_position_get
-(   file_t* file_
-)
-{
-    if ( !file_ )
+    // Illegal mode? Y/N
+    if ( !( ( *file ).mode & FILE_MODE_WRITE ) )
+    {
+        LOGERROR ( "platform_file_preallocate ("PLATFORM_STRING"): The provided file is not opened for writing: %s"
+                 , ( *file ).path
+                 );
+        return false;
+    }
+
+    if ( !size )
+    {
+        return true;
+    }
+
+    if ( fallocate ( ( *file ).descriptor , FALLOC_FL_KEEP_SIZE , 0 , size ) == -1 )
+    {
+        // Unsupported by the file system? Y/N
+        if ( errno == EOPNOTSUPP )
+        {
+            return true;
+        }
+        platform_log_error ( "platform_file_preallocate ("PLATFORM_STRING"): fallocate failed on file: %s"
+                           , ( *file ).path
+                           );
+        return false;
+    }
+
+    return true;
+}
+
+u64
+platform_file_size
+(   file_t* file_
+)
+{
+    if ( !file_ )
+    {
+        LOGERROR ( "platform_file_size ("PLATFORM_STRING"): Missing argument: file." );
+        return 0;
+    }
+
+    if ( !( *file_ ).handle || !( *file_ ).valid )
+    {
+        return 0;
+    }
+
+    platform_file_t* file = ( *file_ ).handle;
+    return ( *file ).size;
+}
+
+u64
+platform_file_position_get
+(   file_t* file_
+)
+{
+    if ( !file_ )
     {
         LOGERROR ( "platform_file_position_get ("PLATFORM_STRING"): Missing argument: file." );
         return 0;
@@ -681,6 +1372,8 @@ platform_file_read
 ,   u64*    read_
 )
 {
+    PROFILE_FUNCTION ();
+
     if ( !file_ || !dst || !read_ )
     {
         if ( !file_ )
@@ -724,6 +1417,11 @@ platform_file_read
     u64 total_bytes_read = 0;
     while ( total_bytes_read < size )
     {
+        _platform_file_direct ( file
+                              , PLATFORM_FILE_ALIGNED ( ( ( u8* ) dst ) + total_bytes_read
+                                                      , ( *file ).position
+                                                      , size - total_bytes_read
+                                                      ));
         const ssize_t bytes_read = read ( ( *file ).descriptor
                                         , ( ( u8* ) dst ) + total_bytes_read
                                         , size - total_bytes_read
@@ -747,6 +1445,154 @@ platform_file_read
     return total_bytes_read == size;
 }
 
+bool
+platform_file_read_at
+(   file_t* file_
+,   u64     offset
+,   u64     size
+,   void*   dst
+,   u64*    read
+)
+{
+    const file_buffer_t buffer = { dst , size };
+    return platform_file_readv_at ( file_ , offset , &buffer , 1 , read );
+}
+
+bool
+platform_file_readv_at
+(   file_t*                 file_
+,   u64                     offset
+,   const file_buffer_t*    buffers
+,   u64                     count
+,   u64*                    read
+)
+{
+    if ( !file_ || ( !buffers && count ) || !read )
+    {
+        if ( !file_ )
+        {
+            LOGERROR ( "platform_file_readv_at ("PLATFORM_STRING"): Missing argument: file (file to read)." );
+        }
+        if ( !buffers && count )
+        {
+            LOGERROR ( "platform_file_readv_at ("PLATFORM_STRING"): Missing argument: buffers (output buffers)." );
+        }
+        if ( !read )
+        {
+            LOGERROR ( "platform_file_readv_at ("PLATFORM_STRING"): Missing argument: read (output buffer)." );
+        }
+        else
+        {
+            *read = 0;
+        }
+        return false;
+    }
+
+    if ( !( *file_ ).handle || !( *file_ ).valid )
+    {
+        *read = 0;
+        return false;
+    }
+
+    platform_file_t* file = ( *file_ ).handle;
+
+    // Illegal mode? Y/N
+    if ( !( ( *file ).mode & FILE_MODE_READ ) )
+    {
+        LOGERROR ( "platform_file_readv_at ("PLATFORM_STRING"): The provided file is not opened for reading: %s."
+                 , ( *file ).path
+                 );
+        *read = 0;
+        return false;
+    }
+
+    // Read no further than the end of the file.
+    u64 size = 0;
+    for ( u64 i = 0; i < count; ++i )
+    {
+        if ( !buffers[ i ].data && buffers[ i ].size )
+        {
+            LOGERROR ( "platform_file_readv_at ("PLATFORM_STRING"): Missing argument: buffers[%u].data (output buffer)."
+                     , i
+                     );
+            *read = 0;
+            return false;
+        }
+        size += buffers[ i ].size;
+    }
+    size = ( offset < ( *file ).size ) ? MIN ( size , ( *file ).size - offset )
+                                       : 0
+                                       ;
+
+    u64 total_bytes_read = 0;
+    u64 buffer = 0; // First buffer not yet filled.
+    u64 filled = 0; // Number of bytes of that buffer already filled.
+    while ( total_bytes_read < size )
+    {
+        // Scatter into the remaining buffers (up to the batch size).
+        struct iovec vectors[ PLATFORM_FILE_VECTOR_BATCH ];
+        i32 vector_count = 0;
+        u64 remaining = size - total_bytes_read;
+        for ( u64 i = buffer; i < count && remaining && vector_count < PLATFORM_FILE_VECTOR_BATCH; ++i )
+        {
+            const u64 skip = ( i == buffer ) ? filled : 0;
+            if ( buffers[ i ].size == skip )
+            {
+                continue;
+            }
+            vectors[ vector_count ].iov_base = ( ( u8* )( buffers[ i ].data ) ) + skip;
+            vectors[ vector_count ].iov_len = MIN ( buffers[ i ].size - skip , remaining );
+            remaining -= vectors[ vector_count ].iov_len;
+            vector_count += 1;
+        }
+
+        bool aligned = PLATFORM_FILE_ALIGNED ( 0 , offset + total_bytes_read , 0 );
+        for ( i32 i = 0; i < vector_count; ++i )
+        {
+            aligned = aligned && PLATFORM_FILE_ALIGNED ( vectors[ i ].iov_base
+                                                       , 0
+                                                       , vectors[ i ].iov_len
+                                                       );
+        }
+        _platform_file_direct ( file , aligned );
+
+        const ssize_t bytes_read = preadv ( ( *file ).descriptor
+                                          , vectors
+                                          , vector_count
+                                          , offset + total_bytes_read
+                                          );
+        if ( bytes_read == -1 )
+        {
+            platform_log_error ( "platform_file_readv_at ("PLATFORM_STRING"): preadv failed on file: %s."
+                               , ( *file ).path
+                               );
+            *read = total_bytes_read;
+            return false;
+        }
+
+        // End of file reached early? Y/N
+        if ( !bytes_read )
+        {
+            break;
+        }
+
+        total_bytes_read += bytes_read;
+
+        // Skip past every buffer which was filled.
+        remaining = bytes_read;
+        while ( buffer < count && remaining >= buffers[ buffer ].size - filled )
+        {
+            remaining -= buffers[ buffer ].size - filled;
+            buffer += 1;
+            filled = 0;
+        }
+        filled += remaining;
+    }
+
+    *read = total_bytes_read;
+    return total_bytes_read == size;
+}
+
 bool
 platform_file_read_line
 (   file_t* file_
@@ -799,6 +1645,8 @@ platform_file_read_line
         return true;
     }
 
+    _platform_file_direct ( file , false );
+
     bool end_of_line = false;
     do
     {
@@ -914,7 +1762,9 @@ platform_file_read_all
         return false;
     }
 
-    u8* string = ( u8* ) string_allocate ( sizeof ( u8 ) * ( ( *file ).size + 1 ) );
+    // Every byte but the terminator is read into.
+    u8* string = ( u8* ) string_allocate_uninit ( sizeof ( u8 ) * ( ( *file ).size + 1 ) );
+    string[ ( *file ).size ] = 0;
 
     // Nothing to copy? Y/N
     if ( !( *file ).size )
@@ -942,6 +1792,11 @@ platform_file_read_all
     u64 total_bytes_read = 0;
     do
     {
+        _platform_file_direct ( file
+                              , PLATFORM_FILE_ALIGNED ( string + total_bytes_read
+                                                      , total_bytes_read
+                                                      , ( *file ).size - total_bytes_read
+                                                      ));
         const ssize_t bytes_read = read ( ( *file ).descriptor
                                         , string + total_bytes_read
                                         , ( *file ).size - total_bytes_read
@@ -1034,6 +1889,11 @@ platform_file_write
     u64 total_bytes_written = 0;
     while ( total_bytes_written < size )
     {
+        _platform_file_direct ( file
+                              , PLATFORM_FILE_ALIGNED ( ( ( u8* ) src ) + total_bytes_written
+                                                      , ( *file ).position
+                                                      , size - total_bytes_written
+                                                      ));
         const ssize_t bytes_written = write ( ( *file ).descriptor
                                             , ( ( u8* ) src ) + total_bytes_written
                                             , size - total_bytes_written
@@ -1059,27 +1919,90 @@ platform_file_write
 }
 
 bool
-platform_file_write_line
+platform_file_write_raw
 (   file_t*     file_
 ,   u64         size
-,   const char* src
+,   const void* src
 )
 {
-    if ( !file_ || !src )
+    if ( !file_ || !( *file_ ).handle || !( *file_ ).valid || ( size && !src ) )
+    {
+        return false;
+    }
+    platform_file_t* file = ( *file_ ).handle;
+
+    // An unaligned write to a descriptor with O_DIRECT set fails, so clear
+    // it first (see _platform_file_direct, which would log on failure).
+    if ( ( *file ).direct )
+    {
+        const i32 flags = fcntl ( ( *file ).descriptor , F_GETFL );
+        if ( flags != -1 && fcntl ( ( *file ).descriptor , F_SETFL , flags & ~O_DIRECT ) != -1 )
+        {
+            ( *file ).direct = false;
+        }
+    }
+
+    u64 total_bytes_written = 0;
+    while ( total_bytes_written < size )
+    {
+        const ssize_t bytes_written = write ( ( *file ).descriptor
+                                            , ( ( u8* ) src ) + total_bytes_written
+                                            , size - total_bytes_written
+                                            );
+        if ( bytes_written == -1 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            return false;
+        }
+        if ( !bytes_written )
+        {
+            return false;
+        }
+
+        // Update internal file position and size.
+        ( *file ).position += bytes_written;
+        ( *file ).size += bytes_written;
+
+        total_bytes_written += bytes_written;
+    }
+    return true;
+}
+
+bool
+platform_file_writev
+(   file_t*             file_
+,   const file_span_t*  spans
+,   u64                 count
+,   u64*                written
+)
+{
+    if ( !file_ || ( !spans && count ) || !written )
     {
         if ( !file_ )
         {
-            LOGERROR ( "platform_file_write_line ("PLATFORM_STRING"): Missing argument: file (file to write to)." );
+            LOGERROR ( "platform_file_writev ("PLATFORM_STRING"): Missing argument: file (file to write to)." );
         }
-        if ( !src )
+        if ( !spans && count )
         {
-            LOGERROR ( "platform_file_write_line ("PLATFORM_STRING"): Missing argument: src (content to write)." );
+            LOGERROR ( "platform_file_writev ("PLATFORM_STRING"): Missing argument: spans (content to write)." );
+        }
+        if ( !written )
+        {
+            LOGERROR ( "platform_file_writev ("PLATFORM_STRING"): Missing argument: written (output buffer)." );
+        }
+        else
+        {
+            *written = 0;
         }
         return false;
     }
 
     if ( !( *file_ ).handle || !( *file_ ).valid )
     {
+        *written = 0;
         return false;
     }
 
@@ -1088,24 +2011,57 @@ platform_file_write_line
     // Illegal mode? Y/N
     if ( !( ( *file ).mode & FILE_MODE_WRITE ) )
     {
-        LOGERROR ( "platform_file_write_line ("PLATFORM_STRING"): The provided file is not opened for writing: %s"
+        LOGERROR ( "platform_file_writev ("PLATFORM_STRING"): The provided file is not opened for writing: %s"
                  , ( *file ).path
                  );
+        *written = 0;
         return false;
     }
 
     u64 total_bytes_written = 0;
-    while ( total_bytes_written < size )
-    {
-        const ssize_t bytes_written = write ( ( *file ).descriptor
-                                            , ( ( u8* ) src ) + total_bytes_written
-                                            , size - total_bytes_written
-                                            );
+    u64 span = 0;   // First span not yet written in full.
+    u64 offset = 0; // Number of bytes of that span already written.
+    for (;;)
+    {
+        // Gather the remaining spans (up to the batch size).
+        struct iovec vectors[ PLATFORM_FILE_VECTOR_BATCH ];
+        i32 vector_count = 0;
+        for ( u64 i = span; i < count && vector_count < PLATFORM_FILE_VECTOR_BATCH; ++i )
+        {
+            const u64 skip = ( i == span ) ? offset : 0;
+            if ( spans[ i ].size == skip )
+            {
+                continue;
+            }
+            vectors[ vector_count ].iov_base = ( ( u8* ) spans[ i ].data ) + skip;
+            vectors[ vector_count ].iov_len = spans[ i ].size - skip;
+            vector_count += 1;
+        }
+        if ( !vector_count )
+        {
+            break;
+        }
+
+        bool aligned = PLATFORM_FILE_ALIGNED ( 0 , ( *file ).position , 0 );
+        for ( i32 i = 0; i < vector_count; ++i )
+        {
+            aligned = aligned && PLATFORM_FILE_ALIGNED ( vectors[ i ].iov_base
+                                                       , 0
+                                                       , vectors[ i ].iov_len
+                                                       );
+        }
+        _platform_file_direct ( file , aligned );
+
+        const ssize_t bytes_written = writev ( ( *file ).descriptor
+                                             , vectors
+                                             , vector_count
+                                             );
         if ( bytes_written == -1 )
         {
-            platform_log_error ( "platform_file_write ("PLATFORM_STRING"): write failed on file: %s"
+            platform_log_error ( "platform_file_writev ("PLATFORM_STRING"): writev failed on file: %s"
                                , ( *file ).path
                                );
+            *written = total_bytes_written;
             return false;
         }
 
@@ -1114,83 +2070,1085 @@ platform_file_write_line
         ( *file ).size += bytes_written;
 
         total_bytes_written += bytes_written;
-    }
 
-    // Append a newline to the file.
-    const char newline = '\n';
-    const ssize_t bytes_written = write ( ( *file ).descriptor
-                                        , &newline
-                                        , sizeof ( newline )
-                                        );
-    if ( bytes_written == -1 )
-    {
-        platform_log_error ( "platform_file_write ("PLATFORM_STRING"): write failed on file: %s"
-                            , ( *file ).path
-                            );
-        return false;
+        // Skip past every span which was written in full.
+        u64 remaining = bytes_written;
+        while ( span < count && remaining >= spans[ span ].size - offset )
+        {
+            remaining -= spans[ span ].size - offset;
+            span += 1;
+            offset = 0;
+        }
+        offset += remaining;
     }
 
-    // Update internal file position and size.
-    ( *file ).position += bytes_written;
-    ( *file ).size += bytes_written;
-
-    total_bytes_written += bytes_written;
-
-    return total_bytes_written == size + sizeof ( newline );
+    *written = total_bytes_written;
+    return true;
 }
 
-void
-platform_file_stdin
-(   file_t* file
+bool
+platform_file_write_at
+(   file_t*     file_
+,   u64         offset
+,   u64         size
+,   const void* src
+,   u64*        written
 )
 {
-    if ( !platform_stdin.initialized )
+    if ( !file_ || !src || !written )
     {
-        platform_stdin.descriptor = 0;
-        platform_stdin.mode = FILE_MODE_READ;
-        platform_stdin.path = "stdin";
-        platform_stdin.size = 0;
-        platform_stdin.position = 0;
-        platform_stdin.initialized = true;
+        if ( !file_ )
+        {
+            LOGERROR ( "platform_file_write_at ("PLATFORM_STRING"): Missing argument: file (file to write to)." );
+        }
+        if ( !src )
+        {
+            LOGERROR ( "platform_file_write_at ("PLATFORM_STRING"): Missing argument: src (content to write)." );
+        }
+        if ( !written )
+        {
+            LOGERROR ( "platform_file_write_at ("PLATFORM_STRING"): Missing argument: written (output buffer)." );
+        }
+        else
+        {
+            *written = 0;
+        }
+        return false;
+    }
+
+    if ( !( *file_ ).handle || !( *file_ ).valid )
+    {
+        *written = 0;
+        return false;
+    }
+
+    platform_file_t* file = ( *file_ ).handle;
+
+    // Illegal mode? Y/N
+    if ( !( ( *file ).mode & FILE_MODE_WRITE ) )
+    {
+        LOGERROR ( "platform_file_write_at ("PLATFORM_STRING"): The provided file is not opened for writing: %s"
+                 , ( *file ).path
+                 );
+        *written = 0;
+        return false;
+    }
+
+    u64 total_bytes_written = 0;
+    while ( total_bytes_written < size )
+    {
+        _platform_file_direct ( file
+                              , PLATFORM_FILE_ALIGNED ( ( ( u8* ) src ) + total_bytes_written
+                                                      , offset + total_bytes_written
+                                                      , size - total_bytes_written
+                                                      ));
+        const ssize_t bytes_written = pwrite ( ( *file ).descriptor
+                                             , ( ( u8* ) src ) + total_bytes_written
+                                             , size - total_bytes_written
+                                             , offset + total_bytes_written
+                                             );
+        if ( bytes_written == -1 )
+        {
+            platform_log_error ( "platform_file_write_at ("PLATFORM_STRING"): pwrite failed on file: %s"
+                               , ( *file ).path
+                               );
+            break;
+        }
+
+        total_bytes_written += bytes_written;
+    }
+
+    // Update internal file size.
+    ( *file ).size = MAX ( ( *file ).size , offset + total_bytes_written );
+
+    *written = total_bytes_written;
+    return total_bytes_written == size;
+}
+
+bool
+platform_file_write_line
+(   file_t*     file_
+,   u64         size
+,   const char* src
+)
+{
+    if ( !file_ || !src )
+    {
+        if ( !file_ )
+        {
+            LOGERROR ( "platform_file_write_line ("PLATFORM_STRING"): Missing argument: file (file to write to)." );
+        }
+        if ( !src )
+        {
+            LOGERROR ( "platform_file_write_line ("PLATFORM_STRING"): Missing argument: src (content to write)." );
+        }
+        return false;
+    }
+
+    if ( !( *file_ ).handle || !( *file_ ).valid )
+    {
+        return false;
+    }
+
+    platform_file_t* file = ( *file_ ).handle;
+
+    // Illegal mode? Y/N
+    if ( !( ( *file ).mode & FILE_MODE_WRITE ) )
+    {
+        LOGERROR ( "platform_file_write_line ("PLATFORM_STRING"): The provided file is not opened for writing: %s"
+                 , ( *file ).path
+                 );
+        return false;
+    }
+
+    _platform_file_direct ( file , false );
+
+    u64 total_bytes_written = 0;
+    while ( total_bytes_written < size )
+    {
+        const ssize_t bytes_written = write ( ( *file ).descriptor
+                                            , ( ( u8* ) src ) + total_bytes_written
+                                            , size - total_bytes_written
+                                            );
+        if ( bytes_written == -1 )
+        {
+            platform_log_error ( "platform_file_write ("PLATFORM_STRING"): write failed on file: %s"
+                               , ( *file ).path
+                               );
+            return false;
+        }
+
+        // Update internal file position and size.
+        ( *file ).position += bytes_written;
+        ( *file ).size += bytes_written;
+
+        total_bytes_written += bytes_written;
+    }
+
+    // Append a newline to the file.
+    const char newline = '\n';
+    const ssize_t bytes_written = write ( ( *file ).descriptor
+                                        , &newline
+                                        , sizeof ( newline )
+                                        );
+    if ( bytes_written == -1 )
+    {
+        platform_log_error ( "platform_file_write ("PLATFORM_STRING"): write failed on file: %s"
+                            , ( *file ).path
+                            );
+        return false;
+    }
+
+    // Update internal file position and size.
+    ( *file ).position += bytes_written;
+    ( *file ).size += bytes_written;
+
+    total_bytes_written += bytes_written;
+
+    return total_bytes_written == size + sizeof ( newline );
+}
+
+bool
+platform_file_copy
+(   const char* src_path
+,   const char* dst_path
+)
+{
+    if ( !src_path || !dst_path )
+    {
+        if ( !src_path )
+        {
+            LOGERROR ( "platform_file_copy ("PLATFORM_STRING"): Missing argument: src_path (filepath of the file to copy)." );
+        }
+        if ( !dst_path )
+        {
+            LOGERROR ( "platform_file_copy ("PLATFORM_STRING"): Missing argument: dst_path (filepath to copy to)." );
+        }
+        return false;
+    }
+
+    // Source file missing? Y/N
+    struct stat src_info;
+    if ( stat ( src_path , &src_info ) == -1 )
+    {
+        platform_log_error ( "platform_file_copy ("PLATFORM_STRING"): stat failed on file: %s"
+                           , src_path
+                           );
+        return false;
+    }
+
+    // Copying a file onto itself would truncate it first.
+    struct stat dst_info;
+    if ( stat ( dst_path , &dst_info ) != -1
+      && dst_info.st_dev == src_info.st_dev
+      && dst_info.st_ino == src_info.st_ino
+       )
+    {
+        LOGERROR ( "platform_file_copy ("PLATFORM_STRING"): Source and destination are the same file: %s"
+                 , src_path
+                 );
+        return false;
+    }
+
+    file_t src;
+    file_t dst;
+    if ( !platform_file_open ( src_path , FILE_MODE_READ , &src ) )
+    {
+        return false;
+    }
+    if ( !platform_file_open ( dst_path , FILE_MODE_WRITE , &dst ) )
+    {
+        platform_file_close ( &src );
+        return false;
+    }
+
+    u64 transferred;
+    const bool success = platform_file_transfer ( &dst
+                                                , &src
+                                                , 0
+                                                , platform_file_size ( &src )
+                                                , &transferred
+                                                );
+
+    platform_file_close ( &dst );
+    platform_file_close ( &src );
+    return success;
+}
+
+bool
+platform_file_transfer
+(   file_t* dst_
+,   file_t* src_
+,   u64     offset
+,   u64     size
+,   u64*    transferred
+)
+{
+    if ( !dst_ || !src_ || !transferred )
+    {
+        if ( !dst_ )
+        {
+            LOGERROR ( "platform_file_transfer ("PLATFORM_STRING"): Missing argument: dst (file to write to)." );
+        }
+        if ( !src_ )
+        {
+            LOGERROR ( "platform_file_transfer ("PLATFORM_STRING"): Missing argument: src (file to read from)." );
+        }
+        if ( !transferred )
+        {
+            LOGERROR ( "platform_file_transfer ("PLATFORM_STRING"): Missing argument: transferred (output buffer)." );
+        }
+        else
+        {
+            *transferred = 0;
+        }
+        return false;
+    }
+
+    *transferred = 0;
+
+    if ( !( *dst_ ).handle || !( *dst_ ).valid || !( *src_ ).handle || !( *src_ ).valid )
+    {
+        return false;
+    }
+
+    platform_file_t* dst = ( *dst_ ).handle;
+    platform_file_t* src = ( *src_ ).handle;
+
+    // Illegal mode? Y/N
+    if ( !( ( *src ).mode & FILE_MODE_READ ) )
+    {
+        LOGERROR ( "platform_file_transfer ("PLATFORM_STRING"): The provided source file is not opened for reading: %s"
+                 , ( *src ).path
+                 );
+        return false;
+    }
+    if ( !( ( *dst ).mode & FILE_MODE_WRITE ) )
+    {
+        LOGERROR ( "platform_file_transfer ("PLATFORM_STRING"): The provided destination file is not opened for writing: %s"
+                 , ( *dst ).path
+                 );
+        return false;
+    }
+
+    // Copy no further than the end of the source file.
+    size = ( offset < ( *src ).size ) ? MIN ( size , ( *src ).size - offset )
+                                      : 0
+                                      ;
+
+    // None of the methods below observe the alignment rules of direct I/O.
+    _platform_file_direct ( src , false );
+    _platform_file_direct ( dst , false );
+
+    bool success = true;
+    u64 total_bytes_transferred = 0;
+
+    // Entire file copied into an empty file? Y/N
+    // If so, share storage with the source file where the file system
+    // supports reflinks.
+    if ( size && !offset && size == ( *src ).size && !( *dst ).size
+      && ioctl ( ( *dst ).descriptor , FICLONE , ( *src ).descriptor ) != -1
+       )
+    {
+        if ( lseek ( ( *dst ).descriptor , size , SEEK_SET ) == -1 )
+        {
+            platform_log_error ( "platform_file_transfer ("PLATFORM_STRING"): lseek failed on file: %s"
+                               , ( *dst ).path
+                               );
+            success = false;
+        }
+        else
+        {
+            total_bytes_transferred = size;
+        }
+    }
+
+    // Copy within the kernel: copy_file_range, or sendfile if the file systems
+    // do not support it.
+    bool kernel = true;
+    bool use_sendfile = false;
+    while ( success && kernel && total_bytes_transferred < size )
+    {
+        const u64 request = MIN ( size - total_bytes_transferred
+                                , PLATFORM_FILE_TRANSFER_MAX
+                                );
+        ssize_t bytes_transferred;
+        if ( use_sendfile )
+        {
+            off_t src_offset = offset + total_bytes_transferred;
+            bytes_transferred = sendfile ( ( *dst ).descriptor
+                                         , ( *src ).descriptor
+                                         , &src_offset
+                                         , request
+                                         );
+        }
+        else
+        {
+            loff_t src_offset = offset + total_bytes_transferred;
+            bytes_transferred = copy_file_range ( ( *src ).descriptor
+                                                , &src_offset
+                                                , ( *dst ).descriptor
+                                                , 0
+                                                , request
+                                                , 0
+                                                );
+        }
+
+        if ( bytes_transferred == -1 )
+        {
+            // Unsupported for these files? Y/N
+            if ( errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP )
+            {
+                kernel = !use_sendfile;
+                use_sendfile = true;
+                continue;
+            }
+            platform_log_error ( "platform_file_transfer ("PLATFORM_STRING"): %s failed on file: %s"
+                               , use_sendfile ? "sendfile" : "copy_file_range"
+                               , ( *src ).path
+                               );
+            success = false;
+            break;
+        }
+
+        // End of file reached early? Y/N
+        if ( !bytes_transferred )
+        {
+            break;
+        }
+
+        total_bytes_transferred += bytes_transferred;
+    }
+
+    // Neither is supported? Y/N
+    // If so, copy through a buffer.
+    if ( success && !kernel && total_bytes_transferred < size )
+    {
+        u8* buffer = memory_allocate_uninit ( PLATFORM_FILE_TRANSFER_BUFFER_SIZE
+                                            , MEMORY_TAG_FILE
+                                            );
+        while ( total_bytes_transferred < size )
+        {
+            const ssize_t bytes_read = pread ( ( *src ).descriptor
+                                             , buffer
+                                             , MIN ( size - total_bytes_transferred
+                                                   , PLATFORM_FILE_TRANSFER_BUFFER_SIZE
+                                                   )
+                                             , offset + total_bytes_transferred
+                                             );
+            if ( bytes_read == -1 )
+            {
+                platform_log_error ( "platform_file_transfer ("PLATFORM_STRING"): pread failed on file: %s"
+                                   , ( *src ).path
+                                   );
+                success = false;
+                break;
+            }
+
+            // End of file reached early? Y/N
+            if ( !bytes_read )
+            {
+                break;
+            }
+
+            u64 total_bytes_written = 0;
+            while ( total_bytes_written < ( u64 ) bytes_read )
+            {
+                const ssize_t bytes_written = write ( ( *dst ).descriptor
+                                                    , buffer + total_bytes_written
+                                                    , bytes_read - total_bytes_written
+                                                    );
+                if ( bytes_written == -1 )
+                {
+                    platform_log_error ( "platform_file_transfer ("PLATFORM_STRING"): write failed on file: %s"
+                                       , ( *dst ).path
+                                       );
+                    success = false;
+                    break;
+                }
+                total_bytes_written += bytes_written;
+            }
+            total_bytes_transferred += total_bytes_written;
+
+            if ( !success )
+            {
+                break;
+            }
+        }
+        memory_free ( buffer
+                    , PLATFORM_FILE_TRANSFER_BUFFER_SIZE
+                    , MEMORY_TAG_FILE
+                    );
+    }
+
+    // Update internal file position and size.
+    ( *dst ).position += total_bytes_transferred;
+    ( *dst ).size = MAX ( ( *dst ).size , ( *dst ).position );
+
+    *transferred = total_bytes_transferred;
+    return success && total_bytes_transferred == size;
+}
+
+bool
+platform_file_map
+(   file_t*         file_
+,   FILE_MODE       mode
+,   FILE_MAP_HINT   hints
+,   file_map_t*     map
+)
+{
+    if ( !file_ || !map )
+    {
+        if ( !file_ )
+        {
+            LOGERROR ( "platform_file_map ("PLATFORM_STRING"): Missing argument: file (file to map)." );
+        }
+        if ( !map )
+        {
+            LOGERROR ( "platform_file_map ("PLATFORM_STRING"): Missing argument: map (output buffer)." );
+        }
+        else
+        {
+            memory_clear ( map , sizeof ( file_map_t ) );
+        }
+        return false;
+    }
+
+    memory_clear ( map , sizeof ( file_map_t ) );
+
+    if ( !( *file_ ).handle || !( *file_ ).valid )
+    {
+        return false;
+    }
+
+    platform_file_t* file = ( *file_ ).handle;
+
+    // Illegal mode? Y/N
+    if ( !( mode & FILE_MODE_READ ) || ( mode & ~( *file ).mode ) )
+    {
+        LOGERROR ( "platform_file_map ("PLATFORM_STRING"): Value of mode argument was invalid; it should be FILE_MODE_READ, optionally with FILE_MODE_WRITE, and the file must be opened with the same mode: %s."
+                 , ( *file ).path
+                 );
+        return false;
+    }
+
+    // Nothing to map? Y/N
+    if ( !( *file ).size )
+    {
+        return true;
+    }
+
+    const bool writable = mode & FILE_MODE_WRITE;
+    void* data = mmap ( 0
+                      , ( *file ).size
+                      , ( writable ) ? PROT_READ | PROT_WRITE : PROT_READ
+                      , MAP_SHARED
+                      , ( *file ).descriptor
+                      , 0
+                      );
+    if ( data == MAP_FAILED )
+    {
+        platform_log_error ( "platform_file_map ("PLATFORM_STRING"): mmap failed on file: %s."
+                           , ( *file ).path
+                           );
+        return false;
+    }
+
+    ( *map ).data = data;
+    ( *map ).size = ( *file ).size;
+    ( *map ).writable = writable;
+
+    // Hints only affect performance, so a rejected hint is not an error.
+    platform_file_map_advise ( map , hints );
+    return true;
+}
+
+void
+platform_file_unmap
+(   file_map_t* map
+)
+{
+    if ( !map || !( *map ).data )
+    {
+        return;
+    }
+
+    if ( munmap ( ( *map ).data , ( *map ).size ) == -1 )
+    {
+        platform_log_error ( "platform_file_unmap ("PLATFORM_STRING"): munmap failed." );
+    }
+    memory_clear ( map , sizeof ( file_map_t ) );
+}
+
+bool
+platform_file_map_advise
+(   file_map_t*     map
+,   FILE_MAP_HINT   hints
+)
+{
+    if ( !map )
+    {
+        LOGERROR ( "platform_file_map_advise ("PLATFORM_STRING"): Missing argument: map (mapping to advise)." );
+        return false;
+    }
+
+    if ( !( *map ).data )
+    {
+        return true;
+    }
+
+    bool success = true;
+    if ( hints & FILE_MAP_HINT_SEQUENTIAL )
+    {
+        success &= !madvise ( ( *map ).data , ( *map ).size , MADV_SEQUENTIAL );
+    }
+    if ( hints & FILE_MAP_HINT_RANDOM )
+    {
+        success &= !madvise ( ( *map ).data , ( *map ).size , MADV_RANDOM );
+    }
+    if ( hints & FILE_MAP_HINT_WILLNEED )
+    {
+        success &= !madvise ( ( *map ).data , ( *map ).size , MADV_WILLNEED );
+    }
+    #ifdef MADV_HUGEPAGE
+    if ( hints & FILE_MAP_HINT_HUGE_PAGES )
+    {
+        // Not every filesystem supports huge pages for file-backed memory, so
+        // this may be rejected even if the host platform supports them.
+        madvise ( ( *map ).data , ( *map ).size , MADV_HUGEPAGE );
+    }
+    #endif
+    return success;
+}
+
+bool
+platform_file_map_flush
+(   file_map_t* map
+)
+{
+    if ( !map )
+    {
+        LOGERROR ( "platform_file_map_flush ("PLATFORM_STRING"): Missing argument: map (mapping to flush)." );
+        return false;
+    }
+
+    if ( !( *map ).data || !( *map ).writable )
+    {
+        return true;
+    }
+
+    if ( msync ( ( *map ).data , ( *map ).size , MS_SYNC ) == -1 )
+    {
+        platform_log_error ( "platform_file_map_flush ("PLATFORM_STRING"): msync failed." );
+        return false;
+    }
+    return true;
+}
+
+bool
+platform_directory_open
+(   const char*     path
+,   bool            query_size
+,   directory_t*    directory_
+)
+{
+    if ( !directory_ )
+    {
+        LOGERROR ( "platform_directory_open ("PLATFORM_STRING"): Missing argument: directory (output buffer)." );
+        return false;
+    }
+
+    ( *directory_ ).valid = false;
+    ( *directory_ ).handle = 0;
+
+    if ( !path )
+    {
+        LOGERROR ( "platform_directory_open ("PLATFORM_STRING"): Missing argument: path (directory path)." );
+        return false;
+    }
+
+    const i32 descriptor = open ( path , O_RDONLY | O_DIRECTORY | O_CLOEXEC );
+    if ( descriptor == -1 )
+    {
+        platform_log_error ( "platform_directory_open ("PLATFORM_STRING"): open failed on directory: %s"
+                           , path
+                           );
+        return false;
+    }
+
+    platform_directory_t* directory = memory_allocate ( sizeof ( platform_directory_t )
+                                                      , MEMORY_TAG_FILE
+                                                      );
+    ( *directory ).descriptor = descriptor;
+    ( *directory ).query_size = query_size;
+    ( *directory ).offset = 0;
+    ( *directory ).length = 0;
+
+    ( *directory_ ).handle = directory;
+    ( *directory_ ).valid = true;
+    return true;
+}
+
+void
+platform_directory_close
+(   directory_t* directory_
+)
+{
+    if ( !directory_ || !( *directory_ ).handle )
+    {
+        return;
+    }
+
+    platform_directory_t* directory = ( *directory_ ).handle;
+    close ( ( *directory ).descriptor );
+    memory_free ( directory , sizeof ( platform_directory_t ) , MEMORY_TAG_FILE );
+
+    ( *directory_ ).handle = 0;
+    ( *directory_ ).valid = false;
+}
+
+bool
+platform_directory_next
+(   directory_t*        directory_
+,   directory_entry_t*  entry
+)
+{
+    if ( !directory_ || !entry )
+    {
+        if ( !directory_ )
+        {
+            LOGERROR ( "platform_directory_next ("PLATFORM_STRING"): Missing argument: directory (directory to read)." );
+        }
+        if ( !entry )
+        {
+            LOGERROR ( "platform_directory_next ("PLATFORM_STRING"): Missing argument: entry (output buffer)." );
+        }
+        return false;
+    }
+
+    if ( !( *directory_ ).handle || !( *directory_ ).valid )
+    {
+        return false;
+    }
+
+    platform_directory_t* directory = ( *directory_ ).handle;
+
+    for (;;)
+    {
+        // Buffer exhausted? Y/N
+        if ( ( *directory ).offset >= ( *directory ).length )
+        {
+            const i64 length = syscall ( SYS_getdents64
+                                       , ( *directory ).descriptor
+                                       , ( *directory ).buffer
+                                       , sizeof ( ( *directory ).buffer )
+                                       );
+            if ( length == -1 )
+            {
+                platform_log_error ( "platform_directory_next ("PLATFORM_STRING"): getdents64 failed." );
+                return false;
+            }
+
+            // End of directory? Y/N
+            if ( !length )
+            {
+                return false;
+            }
+
+            ( *directory ).offset = 0;
+            ( *directory ).length = length;
+        }
+
+        const platform_dirent64_t* dirent = ( platform_dirent64_t* )( ( *directory ).buffer + ( *directory ).offset );
+        ( *directory ).offset += dirent->d_reclen;
+
+        // Skip the `.` and `..` entries.
+        if ( dirent->d_name[ 0 ] == '.'
+          && ( !dirent->d_name[ 1 ] || ( dirent->d_name[ 1 ] == '.' && !dirent->d_name[ 2 ] ) )
+           )
+        {
+            continue;
+        }
+
+        ( *entry ).name = dirent->d_name;
+        ( *entry ).name_length = _string_length ( dirent->d_name );
+        ( *entry ).size = 0;
+        switch ( dirent->d_type )
+        {
+            case DT_REG:     ( *entry ).type = FILE_TYPE_FILE      ;break;
+            case DT_DIR:     ( *entry ).type = FILE_TYPE_DIRECTORY ;break;
+            case DT_LNK:     ( *entry ).type = FILE_TYPE_SYMLINK   ;break;
+            case DT_UNKNOWN: ( *entry ).type = FILE_TYPE_UNKNOWN   ;break;
+            default:         ( *entry ).type = FILE_TYPE_OTHER     ;break;
+        }
+
+        // Some filesystems do not report the entry type; only stat the entry
+        // if the type or the size is still unknown.
+        if ( ( *entry ).type == FILE_TYPE_UNKNOWN
+          || ( ( *entry ).type == FILE_TYPE_FILE && ( *directory ).query_size )
+           )
+        {
+            struct stat status;
+            if ( !fstatat ( ( *directory ).descriptor
+                          , dirent->d_name
+                          , &status
+                          , AT_SYMLINK_NOFOLLOW
+                          ))
+            {
+                if ( S_ISREG ( status.st_mode ) )
+                {
+                    ( *entry ).type = FILE_TYPE_FILE;
+                    ( *entry ).size = ( *directory ).query_size ? status.st_size : 0;
+                }
+                else if ( S_ISDIR ( status.st_mode ) )
+                {
+                    ( *entry ).type = FILE_TYPE_DIRECTORY;
+                }
+                else if ( S_ISLNK ( status.st_mode ) )
+                {
+                    ( *entry ).type = FILE_TYPE_SYMLINK;
+                }
+                else
+                {
+                    ( *entry ).type = FILE_TYPE_OTHER;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+void
+platform_file_stdin
+(   file_t* file
+)
+{
+    if ( !platform_stdin.initialized )
+    {
+        platform_stdin.descriptor = 0;
+        platform_stdin.mode = FILE_MODE_READ;
+        platform_stdin.path = "stdin";
+        platform_stdin.size = 0;
+        platform_stdin.position = 0;
+        platform_stdin.initialized = true;
     }
     ( *file ).handle = &platform_stdin;
     ( *file ).valid = true;
 }
 
 void
-platform_file_stdout
-(   file_t* file
+platform_file_stdout
+(   file_t* file
+)
+{
+    if ( !platform_stdout.initialized )
+    {
+        platform_stdout.descriptor = 1;
+        platform_stdout.mode = FILE_MODE_WRITE;
+        platform_stdout.path = "stdout";
+        platform_stdout.size = 0;
+        platform_stdout.position = 0;
+        platform_stdout.initialized = true;
+    }
+    ( *file ).handle = &platform_stdout;
+    ( *file ).valid = true;
+}
+
+void
+platform_file_stderr
+(   file_t* file
+)
+{
+    if ( !platform_stderr.initialized )
+    {
+        platform_stderr.descriptor = 2;
+        platform_stderr.mode = FILE_MODE_WRITE;
+        platform_stderr.path = "stderr";
+        platform_stderr.size = 0;
+        platform_stderr.position = 0;
+        platform_stderr.initialized = true;
+    }
+    ( *file ).handle = &platform_stderr;
+    ( *file ).valid = true;
+}
+
+bool
+platform_file_terminal
+(   file_t* file_
+)
+{
+    if ( !file_ )
+    {
+        LOGERROR ( "platform_file_terminal ("PLATFORM_STRING"): Missing argument: file." );
+        return false;
+    }
+
+    if ( !( *file_ ).handle || !( *file_ ).valid )
+    {
+        return false;
+    }
+
+    platform_file_t* file = ( *file_ ).handle;
+    return isatty ( ( *file ).descriptor ) == 1;
+}
+
+bool
+platform_io_queue_create
+(   u64     depth
+,   void**  internal
+)
+{
+    struct io_uring_params params;
+    memory_clear ( &params , sizeof ( struct io_uring_params ) );
+    const i32 descriptor = syscall ( __NR_io_uring_setup
+                                   , ( u32 ) depth
+                                   , &params
+                                   );
+    if ( descriptor == -1 )
+    {
+        // Not supported by the host kernel (or disallowed by its policy).
+        return false;
+    }
+
+    // IORING_OP_READ and IORING_OP_WRITE were introduced alongside this
+    // feature (Linux 5.6).
+    if ( !( params.features & IORING_FEAT_RW_CUR_POS ) )
+    {
+        close ( descriptor );
+        return false;
+    }
+
+    platform_io_queue_t* queue = memory_allocate ( sizeof ( platform_io_queue_t )
+                                                 , MEMORY_TAG_FILE
+                                                 );
+    ( *queue ).descriptor = descriptor;
+    ( *queue ).unsubmitted = 0;
+
+    // Map the submission and completion rings (a single mapping if the kernel
+    // supports it), and the submission queue entries.
+    ( *queue ).sq_ring_size = params.sq_off.array + params.sq_entries * sizeof ( u32 );
+    ( *queue ).cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof ( struct io_uring_cqe );
+    const bool single_mapping = params.features & IORING_FEAT_SINGLE_MMAP;
+    if ( single_mapping )
+    {
+        ( *queue ).sq_ring_size = MAX ( ( *queue ).sq_ring_size , ( *queue ).cq_ring_size );
+        ( *queue ).cq_ring_size = 0;
+    }
+    ( *queue ).sqes_size = params.sq_entries * sizeof ( struct io_uring_sqe );
+
+    ( *queue ).sq_ring = mmap ( 0
+                              , ( *queue ).sq_ring_size
+                              , PROT_READ | PROT_WRITE
+                              , MAP_SHARED | MAP_POPULATE
+                              , descriptor
+                              , IORING_OFF_SQ_RING
+                              );
+    ( *queue ).cq_ring = single_mapping ? ( *queue ).sq_ring
+                                        : mmap ( 0
+                                               , ( *queue ).cq_ring_size
+                                               , PROT_READ | PROT_WRITE
+                                               , MAP_SHARED | MAP_POPULATE
+                                               , descriptor
+                                               , IORING_OFF_CQ_RING
+                                               );
+    ( *queue ).sqes = mmap ( 0
+                           , ( *queue ).sqes_size
+                           , PROT_READ | PROT_WRITE
+                           , MAP_SHARED | MAP_POPULATE
+                           , descriptor
+                           , IORING_OFF_SQES
+                           );
+    if ( ( *queue ).sq_ring == MAP_FAILED
+      || ( *queue ).cq_ring == MAP_FAILED
+      || ( *queue ).sqes == MAP_FAILED
+       )
+    {
+        platform_log_error ( "platform_io_queue_create ("PLATFORM_STRING"): mmap failed on io_uring instance." );
+        if ( ( *queue ).sq_ring != MAP_FAILED )
+        {
+            munmap ( ( *queue ).sq_ring , ( *queue ).sq_ring_size );
+        }
+        if ( !single_mapping && ( *queue ).cq_ring != MAP_FAILED )
+        {
+            munmap ( ( *queue ).cq_ring , ( *queue ).cq_ring_size );
+        }
+        if ( ( *queue ).sqes != MAP_FAILED )
+        {
+            munmap ( ( *queue ).sqes , ( *queue ).sqes_size );
+        }
+        close ( descriptor );
+        memory_free ( queue , sizeof ( platform_io_queue_t ) , MEMORY_TAG_FILE );
+        return false;
+    }
+
+    ( *queue ).sq_tail = ( u32* )( ( ( u8* )( *queue ).sq_ring ) + params.sq_off.tail );
+    ( *queue ).sq_mask = *( ( u32* )( ( ( u8* )( *queue ).sq_ring ) + params.sq_off.ring_mask ) );
+    ( *queue ).sq_array = ( u32* )( ( ( u8* )( *queue ).sq_ring ) + params.sq_off.array );
+    ( *queue ).cq_head = ( u32* )( ( ( u8* )( *queue ).cq_ring ) + params.cq_off.head );
+    ( *queue ).cq_tail = ( u32* )( ( ( u8* )( *queue ).cq_ring ) + params.cq_off.tail );
+    ( *queue ).cq_mask = *( ( u32* )( ( ( u8* )( *queue ).cq_ring ) + params.cq_off.ring_mask ) );
+    ( *queue ).cqes = ( struct io_uring_cqe* )( ( ( u8* )( *queue ).cq_ring ) + params.cq_off.cqes );
+
+    *internal = queue;
+    return true;
+}
+
+void
+platform_io_queue_destroy
+(   void* internal
 )
 {
-    if ( !platform_stdout.initialized )
+    platform_io_queue_t* queue = internal;
+    munmap ( ( *queue ).sqes , ( *queue ).sqes_size );
+    if ( ( *queue ).cq_ring_size )
     {
-        platform_stdout.descriptor = 1;
-        platform_stdout.mode = FILE_MODE_WRITE;
-        platform_stdout.path = "stdout";
-        platform_stdout.size = 0;
-        platform_stdout.position = 0;
-        platform_stdout.initialized = true;
+        munmap ( ( *queue ).cq_ring , ( *queue ).cq_ring_size );
     }
-    ( *file ).handle = &platform_stdout;
-    ( *file ).valid = true;
+    munmap ( ( *queue ).sq_ring , ( *queue ).sq_ring_size );
+    close ( ( *queue ).descriptor );
+    memory_free ( queue , sizeof ( platform_io_queue_t ) , MEMORY_TAG_FILE );
 }
 
-void
-platform_file_stderr
-(   file_t* file
+bool
+platform_io_queue_submit
+(   void*           internal
+,   io_request_t*   requests
+,   u64             count
 )
 {
-    if ( !platform_stderr.initialized )
+    platform_io_queue_t* queue = internal;
+    for ( u64 i = 0; i < count; ++i )
     {
-        platform_stderr.descriptor = 2;
-        platform_stderr.mode = FILE_MODE_WRITE;
-        platform_stderr.path = "stderr";
-        platform_stderr.size = 0;
-        platform_stderr.position = 0;
-        platform_stderr.initialized = true;
+        if ( !( *( requests[ i ].file ) ).handle || !( *( requests[ i ].file ) ).valid )
+        {
+            LOGERROR ( "platform_io_queue_submit ("PLATFORM_STRING"): Request %u of %u has an invalid file."
+                     , i + 1 , count
+                     );
+            return false;
+        }
+        _platform_io_queue_prepare ( queue , &requests[ i ] );
     }
-    ( *file ).handle = &platform_stderr;
-    ( *file ).valid = true;
+    return _platform_io_queue_enter ( queue , 0 );
+}
+
+u64
+platform_io_queue_collect
+(   void*           internal
+,   u64             min_count
+,   io_request_t**  completed
+,   u64             capacity
+)
+{
+    platform_io_queue_t* queue = internal;
+
+    u64 count = 0;
+    for (;;)
+    {
+        u32 head = *( *queue ).cq_head;
+        const u32 tail = atomic_load_u32 ( ( *queue ).cq_tail , ATOMIC_ACQUIRE );
+        while ( head != tail && count < capacity )
+        {
+            const struct io_uring_cqe* cqe = &( *queue ).cqes[ head & ( *queue ).cq_mask ];
+            io_request_t* request = ( io_request_t* )( cqe->user_data );
+            const i32 result = cqe->res;
+            head += 1;
+
+            if ( result < 0 )
+            {
+                errno = -result;
+                platform_log_error ( "platform_io_queue_collect ("PLATFORM_STRING"): %s failed on file: %s"
+                                   , ( ( *request ).operation == IO_OPERATION_READ ) ? "Read" : "Write"
+                                   , ( *( ( platform_file_t* )( *( ( *request ).file ) ).handle ) ).path
+                                   );
+                ( *request ).success = false;
+                completed[ count ] = request;
+                count += 1;
+                continue;
+            }
+
+            ( *request ).transferred += result;
+            if ( ( *request ).operation == IO_OPERATION_WRITE )
+            {
+                // Update internal file size.
+                platform_file_t* file = ( *( ( *request ).file ) ).handle;
+                ( *file ).size = MAX ( ( *file ).size
+                                     , ( *request ).offset + ( *request ).transferred
+                                     );
+            }
+
+            // Partial transfer? Y/N
+            if ( result && ( *request ).transferred < ( *request ).size )
+            {
+                _platform_io_queue_prepare ( queue , request );
+                continue;
+            }
+
+            // A read may stop early at the end of the file; a write may not.
+            ( *request ).success = ( *request ).operation == IO_OPERATION_READ
+                                || ( *request ).transferred == ( *request ).size
+                                 ;
+            completed[ count ] = request;
+            count += 1;
+        }
+        atomic_store_u32 ( ( *queue ).cq_head , head , ATOMIC_RELEASE );
+
+        if ( count >= min_count )
+        {
+            break;
+        }
+
+        // Wait for the next completion (resubmitting any partial transfers).
+        _platform_io_queue_enter ( queue , 1 );
+    }
+
+    // Resubmit any remaining partial transfers.
+    if ( ( *queue ).unsubmitted )
+    {
+        _platform_io_queue_enter ( queue , 0 );
+    }
+
+    return count;
 }
 
 i64
@@ -1236,6 +3194,15 @@ platform_absolute_time
     return time.tv_sec + time.tv_nsec * 0.000000001;
 }
 
+u64
+platform_absolute_time_ns
+( void )
+{
+    struct timespec time;
+    clock_gettime ( CLOCK_MONOTONIC_RAW , &time );
+    return ( ( u64 ) time.tv_sec ) * 1000000000 + ( ( u64 ) time.tv_nsec );
+}
+
 void
 platform_sleep
 (   u64 ms
@@ -1268,5 +3235,480 @@ platform_processor_core_count
     return available_processor_count;
 }
 
+u32
+platform_numa_node_count
+( void )
+{
+    // The node directories are numbered densely from zero.
+    static u32 count = 0;
+    if ( count )
+    {
+        return count;
+    }
+    u32 nodes = 0;
+    DIR* directory = opendir ( "/sys/devices/system/node" );
+    if ( directory )
+    {
+        struct dirent* entry;
+        while ( ( entry = readdir ( directory ) ) )
+        {
+            u64 node;
+            u64 read_;
+            if (   !memcmp ( ( *entry ).d_name , "node" , 4 )
+                && _string_to_u64 ( ( *entry ).d_name + 4 , 10 , &node , &read_ ) == STRING_PARSE_SUCCESS
+               )
+            {
+                nodes = MAX ( nodes , ( u32 )( node + 1 ) );
+            }
+        }
+        closedir ( directory );
+    }
+    count = MAX ( nodes , 1U );
+    return count;
+}
+
+u32
+platform_numa_node_current
+( void )
+{
+    u32 cpu;
+    u32 node;
+    if ( syscall ( SYS_getcpu , &cpu , &node , 0 ) )
+    {
+        return 0;
+    }
+    return node;
+}
+
+u32
+platform_cpu_features
+( void )
+{
+    u32 features = 0;
+#if defined(__aarch64__)
+    const u64 hwcap = getauxval ( AT_HWCAP );
+    if ( hwcap & ( 1 << 1 ) )  features |= CPU_FEATURE_NEON;    // HWCAP_ASIMD
+    if ( hwcap & ( 1 << 7 ) )  features |= CPU_FEATURE_CRC32;   // HWCAP_CRC32
+    if ( hwcap & ( 1 << 22 ) ) features |= CPU_FEATURE_SVE;     // HWCAP_SVE
+#elif defined(__arm__)
+    const u64 hwcap = getauxval ( AT_HWCAP );
+    const u64 hwcap2 = getauxval ( AT_HWCAP2 );
+    if ( hwcap & ( 1 << 12 ) ) features |= CPU_FEATURE_NEON;    // HWCAP_NEON
+    if ( hwcap2 & ( 1 << 4 ) ) features |= CPU_FEATURE_CRC32;   // HWCAP2_CRC32
+#endif
+    return features;
+}
+
+void
+platform_cpu_topology
+(   cpu_topology_t* topology
+)
+{
+    char path[ 128 ];
+    char directory[ 96 ];
+    char content[ 1024 ];
+
+    // Logical cores (online only).
+    cpu_set_t online;
+    const u64 length = _platform_sysfs_read ( "/sys/devices/system/cpu/online" , content , sizeof ( content ) );
+    if ( !length || !_platform_cpulist_parse ( content , length , &online ) )
+    {
+        return;
+    }
+    u32 count = 0;
+    for ( u32 cpu = 0; cpu < CPU_SETSIZE; ++cpu )
+    {
+        if ( !CPU_ISSET ( cpu , &online ) )
+        {
+            continue;
+        }
+        if ( count < CPU_MAX_LOGICAL_CORES )
+        {
+            cpu_logical_core_t* core = &( *topology ).logical_cores[ count ];
+            u64 value;
+            ( *core ).id = cpu;
+            ( *core ).physical_core = _platform_sysfs_read_u64 ( _platform_sysfs_path ( path , PLATFORM_SYSFS_CPU , cpu , "/topology/core_id" ) , &value )
+                                    ? value
+                                    : cpu
+                                    ;
+            ( *core ).package = _platform_sysfs_read_u64 ( _platform_sysfs_path ( path , PLATFORM_SYSFS_CPU , cpu , "/topology/physical_package_id" ) , &value )
+                              ? value
+                              : 0
+                              ;
+
+            // The core's directory links to its NUMA node, as node<N>.
+            ( *core ).numa_node = 0;
+            DIR* entries = opendir ( _platform_sysfs_path ( path , PLATFORM_SYSFS_CPU , cpu , "" ) );
+            if ( entries )
+            {
+                struct dirent* entry;
+                while ( ( entry = readdir ( entries ) ) )
+                {
+                    u64 read_;
+                    if (   !memcmp ( ( *entry ).d_name , "node" , 4 )
+                        && _string_to_u64 ( ( *entry ).d_name + 4 , 10 , &value , &read_ ) == STRING_PARSE_SUCCESS
+                       )
+                    {
+                        ( *core ).numa_node = value;
+                        break;
+                    }
+                }
+                closedir ( entries );
+            }
+        }
+        count += 1;
+    }
+    ( *topology ).logical_core_count = count;
+
+    // Caches, as seen by the first logical core.
+    _platform_sysfs_path ( directory , PLATFORM_SYSFS_CPU , ( *topology ).logical_cores[ 0 ].id , "/cache/index" );
+    for ( u32 index = 0; index < 16; ++index )
+    {
+        u64 level;
+        if ( !_platform_sysfs_read_u64 ( _platform_sysfs_path ( path , directory , index , "/level" ) , &level ) )
+        {
+            break;
+        }
+        cpu_cache_t cache = { 0 , 0 , 1 };
+        u64 value;
+        if ( _platform_sysfs_read_u64 ( _platform_sysfs_path ( path , directory , index , "/size" ) , &value ) )
+        {
+            cache.size = value;
+        }
+        if ( _platform_sysfs_read_u64 ( _platform_sysfs_path ( path , directory , index , "/coherency_line_size" ) , &value ) )
+        {
+            cache.line_size = value;
+        }
+        const u64 shared_length = _platform_sysfs_read ( _platform_sysfs_path ( path , directory , index , "/shared_cpu_list" )
+                                                       , content
+                                                       , sizeof ( content )
+                                                       );
+        cpu_set_t shared;
+        if ( shared_length && _platform_cpulist_parse ( content , shared_length , &shared ) )
+        {
+            cache.shared_by = CPU_COUNT ( &shared );
+        }
+
+        // Type: "Data", "Instruction" or "Unified".
+        _platform_sysfs_read ( _platform_sysfs_path ( path , directory , index , "/type" ) , content , sizeof ( content ) );
+        if ( level == 1 )
+        {
+            if ( *content == 'I' )
+            {
+                ( *topology ).l1_instruction = cache;
+            }
+            else
+            {
+                ( *topology ).l1_data = cache;
+            }
+        }
+        else if ( level == 2 )
+        {
+            ( *topology ).l2 = cache;
+        }
+        else if ( level == 3 )
+        {
+            ( *topology ).l3 = cache;
+        }
+    }
+}
+
+bool
+platform_perf_open
+(   platform_perf_t* perf
+)
+{
+    static const u64 configs[ PLATFORM_PERF_COUNTER_COUNT ] = { PERF_COUNT_HW_CPU_CYCLES
+                                                              , PERF_COUNT_HW_INSTRUCTIONS
+                                                              , PERF_COUNT_HW_CACHE_MISSES
+                                                              , PERF_COUNT_HW_BRANCH_MISSES
+                                                              };
+    ( *perf ).available = 0;
+    for ( u32 i = 0; i < PLATFORM_PERF_COUNTER_COUNT; ++i )
+    {
+        struct perf_event_attr attributes;
+        memset ( &attributes , 0 , sizeof ( attributes ) );
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof ( attributes );
+        attributes.config = configs[ i ];
+        attributes.disabled = 1;
+        attributes.inherit = 1;         // Count threads created afterwards.
+        attributes.exclude_kernel = 1;  // Permitted at perf_event_paranoid <= 2.
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+                               | PERF_FORMAT_TOTAL_TIME_RUNNING
+                               ;
+
+        // Counters are opened individually rather than as a group, because
+        // inherited counters cannot be read as a group.
+        ( *perf ).handle[ i ] = syscall ( SYS_perf_event_open , &attributes , 0 , -1 , -1 , PERF_FLAG_FD_CLOEXEC );
+        if ( ( *perf ).handle[ i ] != -1 )
+        {
+            ( *perf ).available |= 1 << i;
+        }
+    }
+    return ( *perf ).available;
+}
+
+void
+platform_perf_close
+(   platform_perf_t* perf
+)
+{
+    for ( u32 i = 0; i < PLATFORM_PERF_COUNTER_COUNT; ++i )
+    {
+        if ( ( *perf ).available & ( 1 << i ) )
+        {
+            close ( ( *perf ).handle[ i ] );
+        }
+        ( *perf ).handle[ i ] = -1;
+    }
+    ( *perf ).available = 0;
+}
+
+void
+platform_perf_start
+(   platform_perf_t* perf
+)
+{
+    for ( u32 i = 0; i < PLATFORM_PERF_COUNTER_COUNT; ++i )
+    {
+        if ( ( *perf ).available & ( 1 << i ) )
+        {
+            ioctl ( ( *perf ).handle[ i ] , PERF_EVENT_IOC_RESET , 0 );
+            ioctl ( ( *perf ).handle[ i ] , PERF_EVENT_IOC_ENABLE , 0 );
+        }
+    }
+}
+
+void
+platform_perf_stop
+(   platform_perf_t*    perf
+,   u64*                values
+)
+{
+    for ( u32 i = 0; i < PLATFORM_PERF_COUNTER_COUNT; ++i )
+    {
+        if ( ( *perf ).available & ( 1 << i ) )
+        {
+            ioctl ( ( *perf ).handle[ i ] , PERF_EVENT_IOC_DISABLE , 0 );
+        }
+    }
+    for ( u32 i = 0; i < PLATFORM_PERF_COUNTER_COUNT; ++i )
+    {
+        values[ i ] = 0;
+
+        // Value, time enabled, time running (see read_format).
+        u64 data[ 3 ];
+        if ( !( ( *perf ).available & ( 1 << i ) )
+          || read ( ( *perf ).handle[ i ] , data , sizeof ( data ) ) != sizeof ( data )
+          || !data[ 2 ]
+           )
+        {
+            continue;
+        }
+        values[ i ] = ( data[ 2 ] < data[ 1 ] ) ? ( u64 )( ( f64 ) data[ 0 ] * data[ 1 ] / data[ 2 ] )
+                                                : data[ 0 ]
+                                                ;
+    }
+}
+
+void
+_platform_file_direct
+(   platform_file_t*    file
+,   bool                aligned
+)
+{
+    // Direct mode not requested, or no change required? Y/N
+    if ( !( ( *file ).mode & FILE_MODE_DIRECT ) || ( *file ).direct == aligned )
+    {
+        return;
+    }
+
+    const i32 flags = fcntl ( ( *file ).descriptor , F_GETFL );
+    if ( flags == -1 || fcntl ( ( *file ).descriptor
+                              , F_SETFL
+                              , aligned ? ( flags | O_DIRECT ) : ( flags & ~O_DIRECT )
+                              ) == -1 )
+    {
+        platform_log_error ( "_platform_file_direct ("PLATFORM_STRING"): fcntl failed on file: %s"
+                           , ( *file ).path
+                           );
+        return;
+    }
+
+    ( *file ).direct = aligned;
+}
+
+void
+_platform_io_queue_prepare
+(   platform_io_queue_t*    queue
+,   io_request_t*           request
+)
+{
+    const u32 tail = *( *queue ).sq_tail;
+    const u32 index = tail & ( *queue ).sq_mask;
+    struct io_uring_sqe* sqe = &( *queue ).sqes[ index ];
+    memory_clear ( sqe , sizeof ( struct io_uring_sqe ) );
+    sqe->opcode = ( ( *request ).operation == IO_OPERATION_READ ) ? IORING_OP_READ
+                                                                  : IORING_OP_WRITE
+                                                                  ;
+    sqe->fd = ( *( ( platform_file_t* )( *( ( *request ).file ) ).handle ) ).descriptor;
+    sqe->off = ( *request ).offset + ( *request ).transferred;
+    sqe->addr = ( u64 )( ( ( u8* )( *request ).data ) + ( *request ).transferred );
+    sqe->len = MIN ( ( *request ).size - ( *request ).transferred
+                   , PLATFORM_IO_QUEUE_MAX_TRANSFER
+                   );
+    sqe->user_data = ( u64 ) request;
+    ( *queue ).sq_array[ index ] = index;
+    atomic_store_u32 ( ( *queue ).sq_tail , tail + 1 , ATOMIC_RELEASE );
+    ( *queue ).unsubmitted += 1;
+}
+
+bool
+_platform_io_queue_enter
+(   platform_io_queue_t*    queue
+,   u32                     min_complete
+)
+{
+    for (;;)
+    {
+        const i32 result = syscall ( __NR_io_uring_enter
+                                   , ( *queue ).descriptor
+                                   , ( *queue ).unsubmitted
+                                   , min_complete
+                                   , min_complete ? IORING_ENTER_GETEVENTS : 0
+                                   , 0
+                                   , 0
+                                   );
+        if ( result >= 0 )
+        {
+            ( *queue ).unsubmitted -= result;
+            if ( !( *queue ).unsubmitted || min_complete )
+            {
+                return true;
+            }
+            continue;
+        }
+        if ( errno == EINTR )
+        {
+            continue;
+        }
+
+        // Completion queue full; submit the remaining entries once some of
+        // the completions have been collected.
+        if ( errno == EAGAIN || errno == EBUSY )
+        {
+            return true;
+        }
+
+        platform_log_error ( "_platform_io_queue_enter ("PLATFORM_STRING"): io_uring_enter failed." );
+        return false;
+    }
+}
+
+char*
+_platform_sysfs_path
+(   char*       path
+,   const char* prefix
+,   u64         number
+,   const char* suffix
+)
+{
+    u64 length = _string_length ( prefix );
+    __builtin_memcpy ( path , prefix , length );
+    length += string_u64 ( number , 10 , path + length );
+    __builtin_memcpy ( path + length , suffix , _string_length ( suffix ) + 1 );
+    return path;
+}
+
+u64
+_platform_sysfs_read
+(   const char* path
+,   char*       content
+,   u64         capacity
+)
+{
+    *content = 0;
+    const i32 descriptor = open ( path , O_RDONLY );
+    if ( descriptor == -1 )
+    {
+        return 0;
+    }
+    const i64 read_ = read ( descriptor , content , capacity - 1 );
+    close ( descriptor );
+    if ( read_ <= 0 )
+    {
+        return 0;
+    }
+    content[ read_ ] = 0;
+    return read_;
+}
+
+bool
+_platform_sysfs_read_u64
+(   const char* path
+,   u64*        value
+)
+{
+    char content[ 32 ];
+    const u64 length = _platform_sysfs_read ( path , content , sizeof ( content ) );
+    u64 read_;
+    if ( !length || string_to_u64 ( content , length , 10 , value , &read_ ) != STRING_PARSE_SUCCESS )
+    {
+        return false;
+    }
+    switch ( content[ read_ ] )
+    {
+        case 'K': *value <<= 10; break;
+        case 'M': *value <<= 20; break;
+        case 'G': *value <<= 30; break;
+        default:                 break;
+    }
+    return true;
+}
+
+bool
+_platform_cpulist_parse
+(   const char* content
+,   u64         length
+,   cpu_set_t*  set
+)
+{
+    CPU_ZERO ( set );
+    u64 i = 0;
+    while ( i < length )
+    {
+        u64 first;
+        u64 last;
+        u64 n;
+        if ( string_to_u64 ( content + i , length - i , 10 , &first , &n ) != STRING_PARSE_SUCCESS )
+        {
+            break;
+        }
+        i += n;
+        last = first;
+        if ( i < length && content[ i ] == '-' )
+        {
+            i += 1;
+            if ( string_to_u64 ( content + i , length - i , 10 , &last , &n ) != STRING_PARSE_SUCCESS )
+            {
+                break;
+            }
+            i += n;
+        }
+        for ( u64 cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu )
+        {
+            CPU_SET ( cpu , set );
+        }
+        if ( i >= length || content[ i ] != ',' )
+        {
+            break;
+        }
+        i += 1;
+    }
+    return CPU_COUNT ( set ) > 0;
+}
+
 #endif  // End platform layer.
 ////////////////////////////////////////////////////////////////////////////////
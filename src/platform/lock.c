@@ -0,0 +1,605 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/lock.c
+ * @brief Implementation of the platform/lock header.
+ * (see platform/lock.h for additional details)
+ */
+#include "platform/lock.h"
+#include "platform/platform.h"
+
+#include "math/clamp.h"
+
+/** @brief Mutex and spinlock states. */
+#define LOCK_STATE_UNLOCKED     0
+#define LOCK_STATE_LOCKED       1
+#define LOCK_STATE_CONTENDED    2   // Locked, and other threads may be sleeping.
+
+/** @brief Reader-writer lock state fields. */
+#define RWLOCK_STATE_COUNT_MASK     0x7FFFFFFF  // Number of readers, or RWLOCK_STATE_WRITER.
+#define RWLOCK_STATE_WRITER         0x7FFFFFFF
+#define RWLOCK_STATE_WRITER_WAITING 0x80000000
+
+/** @brief Deadline which never passes (see lock_sleep). */
+#define LOCK_DEADLINE_NEVER ( ( u64 ) -1 )
+
+/**
+ * @brief Slow path of lock_acquire and spinlock_acquire: marks the lock as
+ * contended and sleeps until it is released.
+ *
+ * @param state The lock state. Must be non-zero.
+ * @param observed The most recently observed lock state.
+ */
+static void
+lock_acquire_contended
+(   u32*    state
+,   u32     observed
+)
+{
+    if ( observed != LOCK_STATE_CONTENDED )
+    {
+        observed = atomic_exchange_u32 ( state , LOCK_STATE_CONTENDED , ATOMIC_SEQ_CST );
+    }
+    while ( observed != LOCK_STATE_UNLOCKED )
+    {
+        platform_futex_wait ( state , LOCK_STATE_CONTENDED , PLATFORM_FUTEX_WAIT_FOREVER );
+        observed = atomic_exchange_u32 ( state , LOCK_STATE_CONTENDED , ATOMIC_SEQ_CST );
+    }
+}
+
+/**
+ * @brief Releases a mutex or spinlock, waking one sleeping thread if there may
+ * be any.
+ *
+ * @param state The lock state. Must be non-zero.
+ */
+static void
+lock_release_state
+(   u32* state
+)
+{
+    if ( atomic_exchange_u32 ( state , LOCK_STATE_UNLOCKED , ATOMIC_SEQ_CST ) == LOCK_STATE_CONTENDED )
+    {
+        platform_futex_wake ( state , false );
+    }
+}
+
+/**
+ * @brief Sleeps on a reader-writer lock until its state changes.
+ *
+ * @param lock The reader-writer lock. Must be non-zero.
+ * @param observed The most recently observed lock state.
+ */
+static void
+rwlock_wait
+(   rwlock_t*   lock
+,   u32         observed
+)
+{
+    // The waiter count is published before the futex re-checks the state, so
+    // any release which changes the state afterward sees the waiter.
+    atomic_fetch_add_u32 ( &( *lock ).waiters , 1 , ATOMIC_SEQ_CST );
+    platform_futex_wait ( &( *lock ).state , observed , PLATFORM_FUTEX_WAIT_FOREVER );
+    atomic_fetch_sub_u32 ( &( *lock ).waiters , 1 , ATOMIC_SEQ_CST );
+}
+
+/**
+ * @brief Wakes every thread sleeping on a reader-writer lock, if there are
+ * any.
+ *
+ * @param lock The reader-writer lock. Must be non-zero.
+ */
+static void
+rwlock_wake
+(   rwlock_t* lock
+)
+{
+    if ( atomic_load_u32 ( &( *lock ).waiters , ATOMIC_RELAXED ) )
+    {
+        platform_futex_wake ( &( *lock ).state , true );
+    }
+}
+
+/**
+ * @brief Computes the deadline of a timed wait.
+ *
+ * @param timeout_ms The timeout (in milliseconds), or
+ * PLATFORM_FUTEX_WAIT_FOREVER.
+ * @return The deadline (see platform_absolute_time_ns), or
+ * LOCK_DEADLINE_NEVER.
+ */
+static u64
+lock_deadline
+(   u64 timeout_ms
+)
+{
+    if ( timeout_ms == PLATFORM_FUTEX_WAIT_FOREVER )
+    {
+        return LOCK_DEADLINE_NEVER;
+    }
+    return platform_absolute_time_ns () + timeout_ms * 1000000;
+}
+
+/**
+ * @brief Sleeps while a word holds an expected value, for no longer than the
+ * time remaining until a deadline. May return spuriously.
+ *
+ * @param address The address of the word to wait on. Must be non-zero.
+ * @param expected The value the word must hold for the thread to sleep.
+ * @param deadline The deadline (see lock_deadline).
+ * @return false if the deadline had already passed; true otherwise.
+ */
+static bool
+lock_sleep
+(   u32*    address
+,   u32     expected
+,   u64     deadline
+)
+{
+    if ( deadline == LOCK_DEADLINE_NEVER )
+    {
+        platform_futex_wait ( address , expected , PLATFORM_FUTEX_WAIT_FOREVER );
+        return true;
+    }
+    const u64 now = platform_absolute_time_ns ();
+    if ( now >= deadline )
+    {
+        return false;
+    }
+    platform_futex_wait ( address , expected , ( deadline - now + 999999 ) / 1000000 );
+    return true;
+}
+
+/**
+ * @brief Attempts to consume the signal of an event. Never sleeps.
+ *
+ * @param event The event. Must be non-zero.
+ * @return true if the event was signalled; false otherwise.
+ */
+static bool
+event_try_wait
+(   event_t* event
+)
+{
+    if ( ( *event ).manual_reset )
+    {
+        return atomic_load_u32 ( &( *event ).state , ATOMIC_ACQUIRE );
+    }
+    u32 observed = true;
+    return atomic_compare_exchange_u32 ( &( *event ).state
+                                       , &observed
+                                       , false
+                                       , ATOMIC_ACQUIRE
+                                       , ATOMIC_RELAXED
+                                       );
+}
+
+void
+lock_acquire
+(   lock_t* lock
+)
+{
+    u32 observed = LOCK_STATE_UNLOCKED;
+    if ( !atomic_compare_exchange_u32 ( &( *lock ).state
+                                      , &observed
+                                      , LOCK_STATE_LOCKED
+                                      , ATOMIC_SEQ_CST
+                                      , ATOMIC_RELAXED
+                                      ) )
+    {
+        lock_acquire_contended ( &( *lock ).state , observed );
+    }
+}
+
+bool
+lock_try_acquire
+(   lock_t* lock
+)
+{
+    u32 observed = LOCK_STATE_UNLOCKED;
+    return atomic_compare_exchange_u32 ( &( *lock ).state
+                                       , &observed
+                                       , LOCK_STATE_LOCKED
+                                       , ATOMIC_SEQ_CST
+                                       , ATOMIC_RELAXED
+                                       );
+}
+
+void
+lock_release
+(   lock_t* lock
+)
+{
+    lock_release_state ( &( *lock ).state );
+}
+
+void
+spinlock_acquire
+(   spinlock_t* lock
+)
+{
+    u32 observed = LOCK_STATE_UNLOCKED;
+    if ( atomic_compare_exchange_u32 ( &( *lock ).state
+                                     , &observed
+                                     , LOCK_STATE_LOCKED
+                                     , ATOMIC_SEQ_CST
+                                     , ATOMIC_RELAXED
+                                     ) )
+    {
+        return;
+    }
+
+    // Poll for up to twice as long as recent acquisitions have needed, then
+    // give up and sleep. The estimate moves 1/8 of the way toward each new
+    // measurement.
+    const u32 spin_count = atomic_load_u32 ( &( *lock ).spin_count , ATOMIC_RELAXED );
+    const u32 spin_limit = MIN ( ( u32 ) SPINLOCK_SPIN_LIMIT , 2 * spin_count + 16 );
+    for ( u32 i = 0; i < spin_limit; ++i )
+    {
+        atomic_pause ();
+        observed = atomic_load_u32 ( &( *lock ).state , ATOMIC_RELAXED );
+        if ( observed == LOCK_STATE_UNLOCKED
+          && atomic_compare_exchange_u32 ( &( *lock ).state
+                                         , &observed
+                                         , LOCK_STATE_LOCKED
+                                         , ATOMIC_SEQ_CST
+                                         , ATOMIC_RELAXED
+                                         )
+           )
+        {
+            atomic_store_u32 ( &( *lock ).spin_count
+                             , ( u32 )( ( i64 ) spin_count + ( ( i64 ) i - ( i64 ) spin_count ) / 8 )
+                             , ATOMIC_RELAXED
+                             );
+            return;
+        }
+    }
+    atomic_store_u32 ( &( *lock ).spin_count
+                     , ( u32 )( ( i64 ) spin_count + ( ( i64 ) spin_limit - ( i64 ) spin_count ) / 8 )
+                     , ATOMIC_RELAXED
+                     );
+
+    lock_acquire_contended ( &( *lock ).state , observed );
+}
+
+bool
+spinlock_try_acquire
+(   spinlock_t* lock
+)
+{
+    u32 observed = LOCK_STATE_UNLOCKED;
+    return atomic_compare_exchange_u32 ( &( *lock ).state
+                                       , &observed
+                                       , LOCK_STATE_LOCKED
+                                       , ATOMIC_SEQ_CST
+                                       , ATOMIC_RELAXED
+                                       );
+}
+
+void
+spinlock_release
+(   spinlock_t* lock
+)
+{
+    lock_release_state ( &( *lock ).state );
+}
+
+void
+rwlock_acquire_read
+(   rwlock_t* lock
+)
+{
+    u32 observed = atomic_load_u32 ( &( *lock ).state , ATOMIC_RELAXED );
+    for (;;)
+    {
+        // Free for reading: not write-locked, and no writer is waiting.
+        if ( !( observed & RWLOCK_STATE_WRITER_WAITING )
+          && ( observed & RWLOCK_STATE_COUNT_MASK ) < RWLOCK_STATE_WRITER - 1
+           )
+        {
+            if ( atomic_compare_exchange_u32 ( &( *lock ).state
+                                             , &observed
+                                             , observed + 1
+                                             , ATOMIC_SEQ_CST
+                                             , ATOMIC_RELAXED
+                                             ) )
+            {
+                return;
+            }
+            continue;
+        }
+        rwlock_wait ( lock , observed );
+        observed = atomic_load_u32 ( &( *lock ).state , ATOMIC_RELAXED );
+    }
+}
+
+void
+rwlock_release_read
+(   rwlock_t* lock
+)
+{
+    const u32 state = atomic_fetch_sub_u32 ( &( *lock ).state , 1 , ATOMIC_SEQ_CST ) - 1;
+    if ( !( state & RWLOCK_STATE_COUNT_MASK ) )
+    {
+        rwlock_wake ( lock );
+    }
+}
+
+void
+rwlock_acquire_write
+(   rwlock_t* lock
+)
+{
+    u32 observed = atomic_load_u32 ( &( *lock ).state , ATOMIC_RELAXED );
+    for (;;)
+    {
+        // Free for writing: no readers and no writer. Acquiring clears the
+        // waiting flag; any other waiting writer sets it again when woken.
+        if ( !( observed & RWLOCK_STATE_COUNT_MASK ) )
+        {
+            if ( atomic_compare_exchange_u32 ( &( *lock ).state
+                                             , &observed
+                                             , RWLOCK_STATE_WRITER
+                                             , ATOMIC_SEQ_CST
+                                             , ATOMIC_RELAXED
+                                             ) )
+            {
+                return;
+            }
+            continue;
+        }
+
+        // Otherwise, hold back new readers before sleeping.
+        if ( !( observed & RWLOCK_STATE_WRITER_WAITING ) )
+        {
+            if ( !atomic_compare_exchange_u32 ( &( *lock ).state
+                                              , &observed
+                                              , observed | RWLOCK_STATE_WRITER_WAITING
+                                              , ATOMIC_SEQ_CST
+                                              , ATOMIC_RELAXED
+                                              ) )
+            {
+                continue;
+            }
+            observed |= RWLOCK_STATE_WRITER_WAITING;
+        }
+        rwlock_wait ( lock , observed );
+        observed = atomic_load_u32 ( &( *lock ).state , ATOMIC_RELAXED );
+    }
+}
+
+void
+rwlock_release_write
+(   rwlock_t* lock
+)
+{
+    atomic_exchange_u32 ( &( *lock ).state , 0 , ATOMIC_SEQ_CST );
+    rwlock_wake ( lock );
+}
+
+void
+condvar_wait
+(   condvar_t*  condvar
+,   lock_t*     lock
+)
+{
+    condvar_wait_timeout ( condvar , lock , PLATFORM_FUTEX_WAIT_FOREVER );
+}
+
+bool
+condvar_wait_timeout
+(   condvar_t*  condvar
+,   lock_t*     lock
+,   u64         timeout_ms
+)
+{
+    // Any signal issued after the sequence number is read changes it, so the
+    // futex refuses to sleep and the signal cannot be lost.
+    const u32 sequence = atomic_load_u32 ( &( *condvar ).sequence , ATOMIC_RELAXED );
+    atomic_fetch_add_u32 ( &( *condvar ).waiters , 1 , ATOMIC_SEQ_CST );
+    lock_release ( lock );
+    const bool signalled = platform_futex_wait ( &( *condvar ).sequence , sequence , timeout_ms );
+    atomic_fetch_sub_u32 ( &( *condvar ).waiters , 1 , ATOMIC_SEQ_CST );
+    lock_acquire ( lock );
+    return signalled;
+}
+
+void
+condvar_signal
+(   condvar_t* condvar
+)
+{
+    atomic_fetch_add_u32 ( &( *condvar ).sequence , 1 , ATOMIC_SEQ_CST );
+    if ( atomic_load_u32 ( &( *condvar ).waiters , ATOMIC_RELAXED ) )
+    {
+        platform_futex_wake ( &( *condvar ).sequence , false );
+    }
+}
+
+void
+condvar_broadcast
+(   condvar_t* condvar
+)
+{
+    atomic_fetch_add_u32 ( &( *condvar ).sequence , 1 , ATOMIC_SEQ_CST );
+    if ( atomic_load_u32 ( &( *condvar ).waiters , ATOMIC_RELAXED ) )
+    {
+        platform_futex_wake ( &( *condvar ).sequence , true );
+    }
+}
+
+void
+event_set
+(   event_t* event
+)
+{
+    // A waiter publishes itself before the futex re-checks the state, so
+    // either it sees the state change, or this sees the waiter.
+    atomic_exchange_u32 ( &( *event ).state , true , ATOMIC_SEQ_CST );
+    if ( atomic_load_u32 ( &( *event ).waiters , ATOMIC_SEQ_CST ) )
+    {
+        platform_futex_wake ( &( *event ).state , ( *event ).manual_reset );
+    }
+}
+
+void
+event_reset
+(   event_t* event
+)
+{
+    atomic_store_u32 ( &( *event ).state , false , ATOMIC_RELEASE );
+}
+
+bool
+event_signalled
+(   event_t* event
+)
+{
+    return atomic_load_u32 ( &( *event ).state , ATOMIC_ACQUIRE );
+}
+
+void
+event_wait
+(   event_t* event
+)
+{
+    event_wait_timeout ( event , PLATFORM_FUTEX_WAIT_FOREVER );
+}
+
+bool
+event_wait_timeout
+(   event_t*    event
+,   u64         timeout_ms
+)
+{
+    if ( event_try_wait ( event ) )
+    {
+        return true;
+    }
+    const u64 deadline = lock_deadline ( timeout_ms );
+    atomic_fetch_add_u32 ( &( *event ).waiters , 1 , ATOMIC_SEQ_CST );
+    bool signalled = event_try_wait ( event );
+    while ( !signalled && lock_sleep ( &( *event ).state , false , deadline ) )
+    {
+        signalled = event_try_wait ( event );
+    }
+    atomic_fetch_sub_u32 ( &( *event ).waiters , 1 , ATOMIC_SEQ_CST );
+    return signalled;
+}
+
+void
+semaphore_release
+(   semaphore_t*    semaphore
+,   u32             count
+)
+{
+    if ( !count )
+    {
+        return;
+    }
+    atomic_fetch_add_u32 ( &( *semaphore ).count , count , ATOMIC_SEQ_CST );
+    if ( atomic_load_u32 ( &( *semaphore ).waiters , ATOMIC_SEQ_CST ) )
+    {
+        platform_futex_wake ( &( *semaphore ).count , count > 1 );
+    }
+}
+
+void
+semaphore_acquire
+(   semaphore_t* semaphore
+)
+{
+    semaphore_acquire_timeout ( semaphore , PLATFORM_FUTEX_WAIT_FOREVER );
+}
+
+bool
+semaphore_try_acquire
+(   semaphore_t* semaphore
+)
+{
+    u32 observed = atomic_load_u32 ( &( *semaphore ).count , ATOMIC_RELAXED );
+    while ( observed )
+    {
+        if ( atomic_compare_exchange_u32 ( &( *semaphore ).count
+                                         , &observed
+                                         , observed - 1
+                                         , ATOMIC_ACQUIRE
+                                         , ATOMIC_RELAXED
+                                         ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+semaphore_acquire_timeout
+(   semaphore_t*    semaphore
+,   u64             timeout_ms
+)
+{
+    if ( semaphore_try_acquire ( semaphore ) )
+    {
+        return true;
+    }
+    const u64 deadline = lock_deadline ( timeout_ms );
+    atomic_fetch_add_u32 ( &( *semaphore ).waiters , 1 , ATOMIC_SEQ_CST );
+    bool acquired = semaphore_try_acquire ( semaphore );
+    while ( !acquired && lock_sleep ( &( *semaphore ).count , 0 , deadline ) )
+    {
+        acquired = semaphore_try_acquire ( semaphore );
+    }
+    atomic_fetch_sub_u32 ( &( *semaphore ).waiters , 1 , ATOMIC_SEQ_CST );
+    return acquired;
+}
+
+void
+waitgroup_add
+(   waitgroup_t*    waitgroup
+,   u32             count
+)
+{
+    atomic_fetch_add_u32 ( &( *waitgroup ).count , count , ATOMIC_RELAXED );
+}
+
+void
+waitgroup_done
+(   waitgroup_t* waitgroup
+)
+{
+    if ( atomic_fetch_sub_u32 ( &( *waitgroup ).count , 1 , ATOMIC_SEQ_CST ) == 1
+      && atomic_load_u32 ( &( *waitgroup ).waiters , ATOMIC_SEQ_CST )
+       )
+    {
+        platform_futex_wake ( &( *waitgroup ).count , true );
+    }
+}
+
+void
+waitgroup_wait
+(   waitgroup_t* waitgroup
+)
+{
+    waitgroup_wait_timeout ( waitgroup , PLATFORM_FUTEX_WAIT_FOREVER );
+}
+
+bool
+waitgroup_wait_timeout
+(   waitgroup_t*    waitgroup
+,   u64             timeout_ms
+)
+{
+    u32 observed = atomic_load_u32 ( &( *waitgroup ).count , ATOMIC_ACQUIRE );
+    if ( !observed )
+    {
+        return true;
+    }
+    const u64 deadline = lock_deadline ( timeout_ms );
+    atomic_fetch_add_u32 ( &( *waitgroup ).waiters , 1 , ATOMIC_SEQ_CST );
+    while ( observed && lock_sleep ( &( *waitgroup ).count , observed , deadline ) )
+    {
+        observed = atomic_load_u32 ( &( *waitgroup ).count , ATOMIC_ACQUIRE );
+    }
+    atomic_fetch_sub_u32 ( &( *waitgroup ).waiters , 1 , ATOMIC_SEQ_CST );
+    return !observed;
+}
@@ -0,0 +1,415 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/lock.h
+ * @brief Provides an interface for non-recursive synchronization primitives
+ * with inline storage: a mutex, an adaptive spinlock, a reader-writer lock, a
+ * condition variable, an event, a counting semaphore and a wait group.
+ *
+ * Every primitive is a plain struct which is ready to use once
+ * zero-initialized; none of them allocate memory or need to be destroyed.
+ * Uncontended operations are a single atomic instruction, and waking a
+ * primitive which no thread is waiting on makes no system call. Contended
+ * threads sleep on the primitive's address via the host platform's futex
+ * interface (futex on GNU/Linux, WaitOnAddress on Windows, __ulock_wait on
+ * macOS).
+ *
+ * None of the primitives are recursive: acquiring a lock which the calling
+ * thread already holds deadlocks. For a recursive mutex, see platform/mutex.h.
+ */
+#ifndef LOCK_H
+#define LOCK_H
+
+#include "common.h"
+
+/**
+ * @brief Upper bound on the number of times spinlock_acquire polls a held
+ * spinlock before sleeping.
+ */
+#define SPINLOCK_SPIN_LIMIT 1024
+
+/** @brief Type definition for a mutex. */
+typedef struct
+{
+    u32 state;
+}
+lock_t;
+
+/**
+ * @brief Type definition for an adaptive spinlock.
+ *
+ * Behaves like lock_t, except that contended threads first poll the lock for
+ * a while before sleeping. The polling budget adapts to how long the lock has
+ * recently taken to become available (up to SPINLOCK_SPIN_LIMIT).
+ */
+typedef struct
+{
+    u32 state;
+    u32 spin_count;
+}
+spinlock_t;
+
+/**
+ * @brief Type definition for a reader-writer lock.
+ *
+ * Any number of readers may hold the lock at once, or a single writer. Once a
+ * writer is waiting, new readers wait as well, so writers cannot be starved.
+ */
+typedef struct
+{
+    u32 state;
+    u32 waiters;
+}
+rwlock_t;
+
+/** @brief Type definition for a condition variable. */
+typedef struct
+{
+    u32 sequence;
+    u32 waiters;
+}
+condvar_t;
+
+/**
+ * @brief Type definition for an event.
+ * 
+ * An auto-reset event (the default) releases a single waiting thread each
+ * time it is set, and becomes unsignalled again as that thread returns. A
+ * manual-reset event releases every waiting thread, and stays signalled until
+ * event_reset; to create one, set manual_reset to true before first use.
+ * Setting an event which is already signalled has no effect.
+ */
+typedef struct
+{
+    u32     state;
+    u32     waiters;
+    bool    manual_reset;
+}
+event_t;
+
+/** @brief Type definition for a counting semaphore. */
+typedef struct
+{
+    u32 count;
+    u32 waiters;
+}
+semaphore_t;
+
+/**
+ * @brief Type definition for a wait group (a countdown latch).
+ * 
+ * Counts outstanding work: waitgroup_add raises the count, waitgroup_done
+ * lowers it, and waitgroup_wait sleeps until it reaches zero. May be reused
+ * once the count has reached zero.
+ */
+typedef struct
+{
+    u32 count;
+    u32 waiters;
+}
+waitgroup_t;
+
+/**
+ * @brief Acquires a mutex, sleeping until it is available.
+ *
+ * @param lock The mutex to acquire. Must be non-zero.
+ */
+void
+lock_acquire
+(   lock_t* lock
+);
+
+/**
+ * @brief Acquires a mutex if it is immediately available.
+ *
+ * @param lock The mutex to acquire. Must be non-zero.
+ * @return true if the mutex was acquired; false otherwise.
+ */
+bool
+lock_try_acquire
+(   lock_t* lock
+);
+
+/**
+ * @brief Releases a mutex held by the calling thread.
+ *
+ * @param lock The mutex to release. Must be non-zero.
+ */
+void
+lock_release
+(   lock_t* lock
+);
+
+/**
+ * @brief Acquires a spinlock, polling and then sleeping until it is available.
+ *
+ * @param lock The spinlock to acquire. Must be non-zero.
+ */
+void
+spinlock_acquire
+(   spinlock_t* lock
+);
+
+/**
+ * @brief Acquires a spinlock if it is immediately available.
+ *
+ * @param lock The spinlock to acquire. Must be non-zero.
+ * @return true if the spinlock was acquired; false otherwise.
+ */
+bool
+spinlock_try_acquire
+(   spinlock_t* lock
+);
+
+/**
+ * @brief Releases a spinlock held by the calling thread.
+ *
+ * @param lock The spinlock to release. Must be non-zero.
+ */
+void
+spinlock_release
+(   spinlock_t* lock
+);
+
+/**
+ * @brief Acquires shared (read) access to a reader-writer lock.
+ *
+ * @param lock The reader-writer lock to acquire. Must be non-zero.
+ */
+void
+rwlock_acquire_read
+(   rwlock_t* lock
+);
+
+/**
+ * @brief Releases shared (read) access to a reader-writer lock.
+ *
+ * @param lock The reader-writer lock to release. Must be non-zero.
+ */
+void
+rwlock_release_read
+(   rwlock_t* lock
+);
+
+/**
+ * @brief Acquires exclusive (write) access to a reader-writer lock.
+ *
+ * @param lock The reader-writer lock to acquire. Must be non-zero.
+ */
+void
+rwlock_acquire_write
+(   rwlock_t* lock
+);
+
+/**
+ * @brief Releases exclusive (write) access to a reader-writer lock.
+ *
+ * @param lock The reader-writer lock to release. Must be non-zero.
+ */
+void
+rwlock_release_write
+(   rwlock_t* lock
+);
+
+/**
+ * @brief Atomically releases a mutex and sleeps until the condition variable
+ * is signalled, then reacquires the mutex.
+ *
+ * May return spuriously; always re-check the condition being waited on.
+ *
+ * @param condvar The condition variable to wait on. Must be non-zero.
+ * @param lock A mutex held by the calling thread. Must be non-zero.
+ */
+void
+condvar_wait
+(   condvar_t*  condvar
+,   lock_t*     lock
+);
+
+/**
+ * @brief Variant of condvar_wait which accepts a timeout parameter.
+ *
+ * @param condvar The condition variable to wait on. Must be non-zero.
+ * @param lock A mutex held by the calling thread. Must be non-zero.
+ * @param timeout_ms The maximum number of milliseconds to sleep for.
+ * @return false on timeout; true otherwise. The mutex is reacquired either
+ * way.
+ */
+bool
+condvar_wait_timeout
+(   condvar_t*  condvar
+,   lock_t*     lock
+,   u64         timeout_ms
+);
+
+/**
+ * @brief Wakes one thread waiting on a condition variable, if there is one.
+ *
+ * @param condvar The condition variable to signal. Must be non-zero.
+ */
+void
+condvar_signal
+(   condvar_t* condvar
+);
+
+/**
+ * @brief Wakes every thread waiting on a condition variable.
+ *
+ * @param condvar The condition variable to signal. Must be non-zero.
+ */
+void
+condvar_broadcast
+(   condvar_t* condvar
+);
+
+/**
+ * @brief Signals an event, waking one waiting thread (auto-reset) or every
+ * waiting thread (manual-reset).
+ * 
+ * @param event The event to signal. Must be non-zero.
+ */
+void
+event_set
+(   event_t* event
+);
+
+/**
+ * @brief Makes an event unsignalled.
+ * 
+ * @param event The event to reset. Must be non-zero.
+ */
+void
+event_reset
+(   event_t* event
+);
+
+/**
+ * @brief Queries whether an event is signalled, without waiting for it or
+ * resetting it.
+ * 
+ * @param event The event to query. Must be non-zero.
+ * @return true if the event is signalled; false otherwise.
+ */
+bool
+event_signalled
+(   event_t* event
+);
+
+/**
+ * @brief Sleeps until an event is signalled. An auto-reset event is reset
+ * before returning.
+ * 
+ * @param event The event to wait on. Must be non-zero.
+ */
+void
+event_wait
+(   event_t* event
+);
+
+/**
+ * @brief Variant of event_wait which accepts a timeout parameter.
+ * 
+ * @param event The event to wait on. Must be non-zero.
+ * @param timeout_ms The maximum number of milliseconds to sleep for. Pass 0
+ * to poll without sleeping.
+ * @return true if the event was signalled; false on timeout.
+ */
+bool
+event_wait_timeout
+(   event_t*    event
+,   u64         timeout_ms
+);
+
+/**
+ * @brief Adds to the count of a semaphore, waking as many waiting threads.
+ * 
+ * @param semaphore The semaphore to release. Must be non-zero.
+ * @param count The amount to add.
+ */
+void
+semaphore_release
+(   semaphore_t*    semaphore
+,   u32             count
+);
+
+/**
+ * @brief Decrements the count of a semaphore, sleeping until it is non-zero.
+ * 
+ * @param semaphore The semaphore to acquire. Must be non-zero.
+ */
+void
+semaphore_acquire
+(   semaphore_t* semaphore
+);
+
+/**
+ * @brief Decrements the count of a semaphore if it is non-zero.
+ * 
+ * @param semaphore The semaphore to acquire. Must be non-zero.
+ * @return true if the count was decremented; false otherwise.
+ */
+bool
+semaphore_try_acquire
+(   semaphore_t* semaphore
+);
+
+/**
+ * @brief Variant of semaphore_acquire which accepts a timeout parameter.
+ * 
+ * @param semaphore The semaphore to acquire. Must be non-zero.
+ * @param timeout_ms The maximum number of milliseconds to sleep for.
+ * @return true if the count was decremented; false on timeout.
+ */
+bool
+semaphore_acquire_timeout
+(   semaphore_t*    semaphore
+,   u64             timeout_ms
+);
+
+/**
+ * @brief Adds to the count of outstanding work of a wait group.
+ * 
+ * @param waitgroup The wait group. Must be non-zero.
+ * @param count The amount to add.
+ */
+void
+waitgroup_add
+(   waitgroup_t*    waitgroup
+,   u32             count
+);
+
+/**
+ * @brief Marks one unit of work of a wait group as done, waking every waiting
+ * thread if it was the last.
+ * 
+ * @param waitgroup The wait group. Must be non-zero, and its count must be
+ * non-zero.
+ */
+void
+waitgroup_done
+(   waitgroup_t* waitgroup
+);
+
+/**
+ * @brief Sleeps until the count of outstanding work of a wait group is zero.
+ * 
+ * @param waitgroup The wait group to wait on. Must be non-zero.
+ */
+void
+waitgroup_wait
+(   waitgroup_t* waitgroup
+);
+
+/**
+ * @brief Variant of waitgroup_wait which accepts a timeout parameter.
+ * 
+ * @param waitgroup The wait group to wait on. Must be non-zero.
+ * @param timeout_ms The maximum number of milliseconds to sleep for.
+ * @return true if the count reached zero; false on timeout.
+ */
+bool
+waitgroup_wait_timeout
+(   waitgroup_t*    waitgroup
+,   u64             timeout_ms
+);
+
+#endif  // LOCK_H
@@ -9,7 +9,12 @@
 
 #include "common.h"
 
-/** @brief Type defintion for a mutex. */
+/**
+ * @brief Type defintion for a mutex.
+ * 
+ * The mutex is recursive and its storage is allocated dynamically. For a
+ * lighter, non-recursive mutex with inline storage, see platform/lock.h.
+ */
 typedef struct
 {
     void* internal;
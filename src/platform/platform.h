@@ -31,6 +31,86 @@ platform_memory_free
 (   void* blk
 );
 
+/**
+ * @brief Platform-independent function to query the granularity of virtual
+ * memory operations (see platform_memory_reserve).
+ * 
+ * @return The virtual memory page size in bytes.
+ */
+u64
+platform_memory_page_size
+( void );
+
+/**
+ * @brief Platform-independent function to reserve a range of virtual address
+ * space. Reserved memory is not backed by physical memory, and cannot be
+ * accessed until it is committed (see platform_memory_commit).
+ * 
+ * @param size The number of bytes to reserve. Must be a multiple of the page
+ * size (see platform_memory_page_size).
+ * @return The page-aligned start of the range, on success. 0, on error.
+ */
+void*
+platform_memory_reserve
+(   u64 size
+);
+
+/**
+ * @brief Platform-independent function to commit part of a reserved range of
+ * virtual address space (see platform_memory_reserve). Committed memory reads
+ * as zero until written.
+ * 
+ * @param blk The start of the range to commit. Must be page-aligned.
+ * @param size The number of bytes to commit. Must be a multiple of the page
+ * size.
+ * @param huge_pages Back the range with huge pages where the host platform
+ * allows it? Y/N
+ * @return true on success; false otherwise.
+ */
+bool
+platform_memory_commit
+(   void*   blk
+,   u64     size
+,   bool    huge_pages
+);
+
+/**
+ * @brief Platform-independent function to return a reserved range of virtual
+ * address space (see platform_memory_reserve), and any physical memory
+ * committed to it, to the host platform.
+ * 
+ * @param blk The start of the range, as returned by platform_memory_reserve.
+ * @param size The size of the range, as passed to platform_memory_reserve.
+ */
+void
+platform_memory_release
+(   void*   blk
+,   u64     size
+);
+
+/**
+ * @brief Platform-independent function to request that the physical memory
+ * backing part of a reserved range of virtual address space
+ * (see platform_memory_reserve) come from a given NUMA node. Call before the
+ * range is committed (see platform_memory_commit).
+ * 
+ * On Windows, a node can only be requested as the memory is committed, so this
+ * also commits the range.
+ * 
+ * @param blk The start of the range. Must be page-aligned.
+ * @param size The number of bytes in the range. Must be a multiple of the page
+ * size.
+ * @param node The NUMA node (see platform_numa_node_count).
+ * @return true on success; false otherwise (in which case the host platform
+ * places the memory as it sees fit).
+ */
+bool
+platform_memory_bind
+(   void*   blk
+,   u64     size
+,   u32     node
+);
+
 // End memory operations.
 ////////////////////////////////////////////////////////////////////////////////
 // Begin string operations.
@@ -169,14 +249,14 @@ platform_array_sort
 #include "platform/thread.h"
 
 /**
- * @brief Platform-independent 'thread create' function (see platform/thread.h).
+ * @brief Platform-independent 'thread create' function (see
+ * thread_create_ex in platform/thread.h).
  * 
- * Uses dynamic memory allocation; call platform_thread_destroy to free.
+ * Call platform_thread_destroy to release the thread's resources.
  * 
  * @param function The callback function to run threaded.
  * @param args Internal state arguments.
- * @param auto_detach Thread should immediately release resources when work is
- * complete? Y/N
+ * @param options The thread creation options.
  * @param thread Output buffer.
  * @return true if successfully created; otherwise false.
  */
@@ -184,7 +264,7 @@ bool
 platform_thread_create
 (   thread_start_function_t function
 ,   void*                   args
-,   bool                    auto_detach
+,   const thread_options_t* options
 ,   thread_t*               thread
 );
 
@@ -276,8 +356,87 @@ u64
 platform_thread_id
 ( void );
 
+/**
+ * @brief Platform-independent function to restrict the calling thread to the
+ * logical cores of a NUMA node (see platform/thread.h).
+ * 
+ * @param node The NUMA node (see platform_numa_node_count).
+ * @return true on success; false otherwise.
+ */
+bool
+platform_thread_affinity_set_node
+(   u32 node
+);
+
 // End thread operations.
 ////////////////////////////////////////////////////////////////////////////////
+// Begin fiber operations.
+
+#include "platform/fiber.h"
+
+/**
+ * @brief Platform-independent function to create an execution context with a
+ * stack of its own (see platform/fiber.h). The context starts executing
+ * function the first time it is switched to; function must never return.
+ * 
+ * Call platform_fiber_destroy to release the context's resources.
+ * 
+ * @param stack_size The stack size in bytes, excluding the guard page. Must be
+ * a multiple of the page size (see platform_memory_page_size).
+ * @param function The function to run on the context.
+ * @param args Arguments to pass to function.
+ * @param context Output buffer. Must remain at the same address for as long as
+ * the context exists.
+ * @return true on success; false otherwise.
+ */
+bool
+platform_fiber_create
+(   u64                 stack_size
+,   fiber_function_t    function
+,   void*               args
+,   fiber_context_t*    context
+);
+
+/**
+ * @brief Platform-independent function to release an execution context
+ * created by platform_fiber_create. Must not be called on the running context.
+ * 
+ * @param context The context to free.
+ */
+void
+platform_fiber_destroy
+(   fiber_context_t* context
+);
+
+/**
+ * @brief Platform-independent function to initialize an execution context for
+ * the calling thread's own stack, so that it may be switched from (and back
+ * to). Must be called by each thread before it first switches context.
+ * 
+ * @param context Output buffer.
+ * @return true on success; false otherwise.
+ */
+bool
+platform_fiber_thread
+(   fiber_context_t* context
+);
+
+/**
+ * @brief Platform-independent function to save the state of the running
+ * execution context and continue execution on another. Returns when some
+ * thread switches back to from.
+ * 
+ * @param from The running context.
+ * @param to The context to switch to. Must not be running.
+ */
+void
+platform_fiber_switch
+(   fiber_context_t*    from
+,   fiber_context_t*    to
+);
+
+// End fiber operations.
+////////////////////////////////////////////////////////////////////////////////
 // Begin mutex operations.
 
 #include "platform/mutex.h"
@@ -329,6 +488,49 @@ platform_mutex_unlock
 
 // End mutex operations.
 ////////////////////////////////////////////////////////////////////////////////
+// Begin futex operations.
+
+/** @brief Timeout which never expires (see platform_futex_wait). */
+#define PLATFORM_FUTEX_WAIT_FOREVER ( ( u64 ) -1 )
+
+/**
+ * @brief Blocks the calling thread while a 32-bit word holds an expected value
+ * (see platform/lock.h).
+ * 
+ * Returns immediately if the word does not hold the expected value. Otherwise,
+ * sleeps until another thread calls platform_futex_wake on the same address,
+ * the timeout expires, or the thread is woken spuriously. The comparison and
+ * the transition to sleep happen atomically with respect to
+ * platform_futex_wake.
+ * 
+ * @param address The address of the word to wait on. Must be non-zero.
+ * @param expected The value the word must hold for the thread to sleep.
+ * @param timeout_ms The maximum number of milliseconds to sleep for. Pass
+ * PLATFORM_FUTEX_WAIT_FOREVER to never time out.
+ * @return false on timeout; true otherwise.
+ */
+bool
+platform_futex_wait
+(   u32*    address
+,   u32     expected
+,   u64     timeout_ms
+);
+
+/**
+ * @brief Wakes threads blocked in platform_futex_wait on an address.
+ * 
+ * @param address The address of the word being waited on. Must be non-zero.
+ * @param all Wake every waiting thread? Y/N. If false, at most one thread is
+ * woken.
+ */
+void
+platform_futex_wake
+(   u32*    address
+,   bool    all
+);
+
+// End futex operations.
+////////////////////////////////////////////////////////////////////////////////
 // Begin filesystem operations.
 
 #include "platform/filesystem.h"
@@ -373,6 +575,20 @@ platform_file_close
 (   file_t* file
 );
 
+/**
+ * @brief Platform-independent 'file preallocate' function
+ * (see platform/filesystem.h).
+ * 
+ * @param file Handle to a file opened for writing.
+ * @param size The number of bytes to reserve.
+ * @return true on success; false otherwise.
+ */
+bool
+platform_file_preallocate
+(   file_t* file
+,   u64     size
+);
+
 /**
  * @brief Platform-independent 'file size' function (see platform/filesystem.h).
  * 
@@ -443,6 +659,66 @@ platform_file_read_line
 ,   char**  dst
 );
 
+/**
+ * @brief Platform-independent 'file read at' function
+ * (see platform/filesystem.h).
+ * 
+ * @param file Handle to the file to read.
+ * @param offset The position in the file to start reading from.
+ * @param size Number of bytes to read.
+ * @param dst Output buffer for the content.
+ * @param read Output buffer to hold number of bytes read.
+ * @return true if file read into dst successfully; false otherwise.
+ */
+bool
+platform_file_read_at
+(   file_t* file
+,   u64     offset
+,   u64     size
+,   void*   dst
+,   u64*    read
+);
+
+/**
+ * @brief Platform-independent 'file read vectored at' function
+ * (see platform/filesystem.h).
+ * 
+ * @param file Handle to the file to read.
+ * @param offset The position in the file to start reading from.
+ * @param buffers The output buffers.
+ * @param count Number of output buffers.
+ * @param read Output buffer to hold total number of bytes read.
+ * @return true if file read into buffers successfully; false otherwise.
+ */
+bool
+platform_file_readv_at
+(   file_t*                 file
+,   u64                     offset
+,   const file_buffer_t*    buffers
+,   u64                     count
+,   u64*                    read
+);
+
+/**
+ * @brief Platform-independent 'file write at' function
+ * (see platform/filesystem.h).
+ * 
+ * @param file Handle to the file to write to.
+ * @param offset The position in the file to start writing at.
+ * @param size Number of bytes to write.
+ * @param src The data to write.
+ * @param written Output buffer to hold number of bytes written.
+ * @return true if src written to file successfully; false otherwise.
+ */
+bool
+platform_file_write_at
+(   file_t*     file
+,   u64         offset
+,   u64         size
+,   const void* src
+,   u64*        written
+);
+
 /**
  * @brief Platform-independent 'file read all' function
  * (see platform/filesystem.h).
@@ -482,6 +758,42 @@ platform_file_write
 ,   u64*        written
 );
 
+/**
+ * @brief Platform-independent 'file write vectored' function
+ * (see platform/filesystem.h).
+ * 
+ * @param file Handle to the file to write to.
+ * @param spans The spans to write.
+ * @param count Number of spans.
+ * @param written Output buffer to hold total number of bytes written.
+ *
+ * @return true if every span written to file successfully; false otherwise.
+ */
+bool
+platform_file_writev
+(   file_t*             file
+,   const file_span_t*  spans
+,   u64                 count
+,   u64*                written
+);
+
+/**
+ * @brief Platform-dependent 'file write raw' function
+ * (see platform/filesystem.h).
+ * 
+ * @param file Handle to the file to write to.
+ * @param size Number of bytes to write.
+ * @param src The data to write.
+ *
+ * @return true if src written to file successfully; false otherwise.
+ */
+bool
+platform_file_write_raw
+(   file_t*     file
+,   u64         size
+,   const void* src
+);
+
 /**
  * Platform-independent 'file write line' function
  * (see platform/filesystem.h).
@@ -499,6 +811,94 @@ platform_file_write_line
 ,   const char* src
 );
 
+/**
+ * @brief Platform-independent 'file copy' function (see platform/filesystem.h).
+ * 
+ * @param src_path The filepath of the file to copy.
+ * @param dst_path The filepath to copy to.
+ * @return true if the file was copied successfully; false otherwise.
+ */
+bool
+platform_file_copy
+(   const char* src_path
+,   const char* dst_path
+);
+
+/**
+ * @brief Platform-independent 'file transfer' function
+ * (see platform/filesystem.h).
+ * 
+ * @param dst Handle to the file to write to.
+ * @param src Handle to the file to read from.
+ * @param offset The position in the source file to start reading at.
+ * @param size Maximum number of bytes to copy.
+ * @param transferred Output buffer to hold the number of bytes copied.
+ * @return true if the range was copied successfully; false otherwise.
+ */
+bool
+platform_file_transfer
+(   file_t* dst
+,   file_t* src
+,   u64     offset
+,   u64     size
+,   u64*    transferred
+);
+
+/**
+ * @brief Platform-independent 'file map' function (see platform/filesystem.h).
+ * 
+ * @param file Handle to the file to map.
+ * @param mode Mode flag.
+ * @param hints Access hint flags.
+ * @param map Output buffer for the mapping.
+ * @return true if the file was mapped successfully; false otherwise.
+ */
+bool
+platform_file_map
+(   file_t*         file
+,   FILE_MODE       mode
+,   FILE_MAP_HINT   hints
+,   file_map_t*     map
+);
+
+/**
+ * @brief Platform-independent 'file unmap' function
+ * (see platform/filesystem.h).
+ * 
+ * @param map The mapping to unmap.
+ */
+void
+platform_file_unmap
+(   file_map_t* map
+);
+
+/**
+ * @brief Platform-independent 'file map advise' function
+ * (see platform/filesystem.h).
+ * 
+ * @param map The mapping to advise.
+ * @param hints Access hint flags.
+ * @return false if the host platform rejected a supported hint; true
+ * otherwise.
+ */
+bool
+platform_file_map_advise
+(   file_map_t*     map
+,   FILE_MAP_HINT   hints
+);
+
+/**
+ * @brief Platform-independent 'file map flush' function
+ * (see platform/filesystem.h).
+ * 
+ * @param map The mapping to flush.
+ * @return true on success; false otherwise.
+ */
+bool
+platform_file_map_flush
+(   file_map_t* map
+);
+
 /**
  * @brief Obtains a handle to the host platform's standard input stream.
  * 
@@ -529,8 +929,135 @@ platform_file_stderr
 (   file_t* file
 );
 
+/**
+ * @brief Platform-dependent 'file terminal' function
+ * (see platform/filesystem.h).
+ * 
+ * @param file Handle to a file.
+ * @return true if file is attached to a terminal; false otherwise.
+ */
+bool
+platform_file_terminal
+(   file_t* file
+);
+
+/**
+ * @brief Platform-dependent 'directory open' function
+ * (see platform/filesystem.h).
+ * 
+ * @param path The directory path.
+ * @param query_size Report the size of each regular file? Y/N
+ * @param directory Output buffer for directory.
+ * @return true if directory opened successfully; false otherwise.
+ */
+bool
+platform_directory_open
+(   const char*     path
+,   bool            query_size
+,   directory_t*    directory
+);
+
+/**
+ * @brief Platform-dependent 'directory close' function
+ * (see platform/filesystem.h).
+ * 
+ * @param directory Handle to the directory to close.
+ */
+void
+platform_directory_close
+(   directory_t* directory
+);
+
+/**
+ * @brief Platform-dependent 'directory next' function
+ * (see platform/filesystem.h).
+ * 
+ * @param directory Handle to the directory to read.
+ * @param entry Output buffer for the entry.
+ * @return true if an entry was read; false at the end of the directory, or on
+ * error.
+ */
+bool
+platform_directory_next
+(   directory_t*        directory
+,   directory_entry_t*  entry
+);
+
 // End filesystem operations.
 ////////////////////////////////////////////////////////////////////////////////
+// Begin asynchronous I/O operations.
+
+#include "platform/io_queue.h"
+
+/**
+ * @brief Platform-dependent asynchronous I/O backend initialization function
+ * (see platform/io_queue.h).
+ * 
+ * Uses dynamic memory allocation. Call platform_io_queue_destroy to free.
+ * 
+ * @param depth The maximum number of requests which may be in flight at once.
+ * @param internal Output buffer for the backend.
+ * @return true on success; false if the host platform does not provide an
+ * asynchronous I/O backend (in which case requests are performed
+ * synchronously), or on error.
+ */
+bool
+platform_io_queue_create
+(   u64     depth
+,   void**  internal
+);
+
+/**
+ * @brief Platform-dependent asynchronous I/O backend free function
+ * (see platform/io_queue.h).
+ * 
+ * @param internal The backend to free. Must have no requests in flight.
+ */
+void
+platform_io_queue_destroy
+(   void* internal
+);
+
+/**
+ * @brief Platform-dependent asynchronous I/O submit function
+ * (see platform/io_queue.h).
+ * 
+ * @param internal The backend to submit to.
+ * @param requests An array of requests. The caller guarantees the number of
+ * requests in flight never exceeds the depth of the backend.
+ * @param count The number of requests in the array.
+ * @return true if every request submitted successfully; false otherwise.
+ */
+bool
+platform_io_queue_submit
+(   void*           internal
+,   io_request_t*   requests
+,   u64             count
+);
+
+/**
+ * @brief Platform-dependent asynchronous I/O collect function
+ * (see platform/io_queue.h).
+ * 
+ * Sets the transferred and success fields of each collected request.
+ * 
+ * @param internal The backend to collect from.
+ * @param min_count Block until at least this many requests are collected. The
+ * caller guarantees at least this many are in flight.
+ * @param completed Output buffer to hold handles to the collected requests.
+ * @param capacity The maximum number of requests to collect.
+ * @return The number of requests collected.
+ */
+u64
+platform_io_queue_collect
+(   void*           internal
+,   u64             min_count
+,   io_request_t**  completed
+,   u64             capacity
+);
+
+// End asynchronous I/O operations.
+////////////////////////////////////////////////////////////////////////////////
 // Begin error handling.
 
 /**
@@ -565,12 +1092,26 @@ platform_error_message
  * @brief Platform-independent function to query the system time
  * (see core/clock.h).
  * 
- * @return The system time.
+ * @return The system time (in seconds).
  */
 f64
 platform_absolute_time
 ( void );
 
+/**
+ * @brief Platform-independent function to query the system's monotonic clock
+ * at full resolution (see core/clock.h).
+ * 
+ * Linux: clock_gettime ( CLOCK_MONOTONIC_RAW ) (not slewed by NTP).
+ * Windows: QueryPerformanceCounter.
+ * macOS: mach_absolute_time.
+ * 
+ * @return The time in nanoseconds since an arbitrary fixed point.
+ */
+u64
+platform_absolute_time_ns
+( void );
+
 /**
  * @brief Sleeps on the current thread for the provided amount of time.
  * 
@@ -592,4 +1133,152 @@ i32
 platform_processor_core_count
 ( void );
 
+/**
+ * @brief Queries the number of NUMA nodes on the host platform.
+ * 
+ * @return The number of NUMA nodes (1 if the host platform is not NUMA, or
+ * does not expose its topology).
+ */
+u32
+platform_numa_node_count
+( void );
+
+/**
+ * @brief Queries the NUMA node of the logical core the calling thread is
+ * currently running on. Unless the thread is restricted to a single node
+ * (see platform_thread_affinity_set_node), it may migrate at any time.
+ * 
+ * @return The NUMA node of the calling thread's current logical core.
+ */
+u32
+platform_numa_node_current
+( void );
+
+/**
+ * @brief Platform-independent function to query the processor instruction set
+ * extensions which only the host platform can report (see platform/cpu.h).
+ * 
+ * x86 extensions are reported by the processor itself, so are not included.
+ * 
+ * Linux: getauxval ( AT_HWCAP ) (ARM).
+ * Windows: IsProcessorFeaturePresent (ARM).
+ * macOS: sysctlbyname ( "hw.optional.*" ) (ARM).
+ * 
+ * @return A combination of CPU_FEATURE flags.
+ */
+u32
+platform_cpu_features
+( void );
+
+////////////////////////////////////////////////////////////////////////////////
+// Begin processor topology operations.
+
+#include "platform/cpu.h"
+
+/**
+ * @brief Platform-independent function to query the topology of the host
+ * processor (see platform/cpu.h).
+ * 
+ * Reports the logical cores (each with the number of its physical core, which
+ * need only be unique within its package, and of its package), and whichever
+ * caches the host platform describes. Leaves the remaining fields for
+ * cpu_topology to derive or detect.
+ * 
+ * Linux: /sys/devices/system/cpu.
+ * Windows: GetLogicalProcessorInformationEx.
+ * macOS: sysctlbyname ( "hw.*" ).
+ * 
+ * @param topology Output buffer for the topology. Must be zeroed. Left with no
+ * logical cores if the host platform does not report them.
+ */
+void
+platform_cpu_topology
+(   cpu_topology_t* topology
+);
+
+////////////////////////////////////////////////////////////////////////////////
+// Begin performance counter operations.
+
+/** @brief Type and instance definitions for hardware performance counters. */
+typedef enum
+{
+    PLATFORM_PERF_CYCLES            // Core clock cycles (not cycle counter ticks; see clock_ticks).
+,   PLATFORM_PERF_INSTRUCTIONS      // Instructions retired.
+,   PLATFORM_PERF_CACHE_MISSES      // Last-level cache misses.
+,   PLATFORM_PERF_BRANCH_MISSES     // Mispredicted branches.
+
+,   PLATFORM_PERF_COUNTER_COUNT
+}
+PLATFORM_PERF_COUNTER;
+
+/** @brief Type definition for a set of hardware performance counters. */
+typedef struct
+{
+    i64 handle[ PLATFORM_PERF_COUNTER_COUNT ];
+    u32 available;  // Bit i is set if counter i was opened.
+}
+platform_perf_t;
+
+/**
+ * @brief Platform-independent function to open the hardware performance
+ * counters of the calling thread. Counts user-mode events on the calling
+ * thread, and on any thread it creates afterwards once that thread has exited.
+ * The counters start stopped (see platform_perf_start).
+ * 
+ * Linux: perf_event_open (subject to /proc/sys/kernel/perf_event_paranoid).
+ * Windows, macOS: Unsupported.
+ * 
+ * Counters the host does not support are left unavailable (see
+ * platform_perf_t). Call platform_perf_close to free.
+ * 
+ * @param perf Output buffer for the counters.
+ * @return true if at least one counter is available; false otherwise.
+ */
+bool
+platform_perf_open
+(   platform_perf_t* perf
+);
+
+/**
+ * @brief Platform-independent function to close hardware performance counters.
+ * 
+ * @param perf The counters to close. Must be non-zero.
+ */
+void
+platform_perf_close
+(   platform_perf_t* perf
+);
+
+/**
+ * @brief Platform-independent function to reset hardware performance counters
+ * to zero, and start counting.
+ * 
+ * @param perf The counters. Must be non-zero.
+ */
+void
+platform_perf_start
+(   platform_perf_t* perf
+);
+
+/**
+ * @brief Platform-independent function to stop hardware performance counters,
+ * and read them.
+ * 
+ * If the host had to multiplex the counters, each count is scaled up by the
+ * fraction of the time it was actually counting.
+ * 
+ * @param perf The counters. Must be non-zero.
+ * @param values Output buffer for the count of each counter since
+ * platform_perf_start (0 for unavailable counters). Must have room for
+ * PLATFORM_PERF_COUNTER_COUNT values.
+ */
+void
+platform_perf_stop
+(   platform_perf_t*    perf
+,   u64*                values
+);
+
+// End performance counter operations.
+////////////////////////////////////////////////////////////////////////////////
+
 #endif  // PLATFORM_H
\ No newline at end of file
@@ -8,6 +8,35 @@
 #include "platform/platform.h"
 
 #include "core/logger.h"
+#include "core/memory.h"
+
+/** @brief Type definition for the arguments of thread_start. */
+typedef struct
+{
+    thread_start_function_t function;
+    void*                   args;
+}
+thread_start_t;
+
+/**
+ * @brief Start routine of every thread created by thread_create_ex. Runs the
+ * caller's function, then returns any blocks still held by the thread's
+ * allocation cache to the global allocator (see memory_thread_cache_flush).
+ * 
+ * @param args The thread_start_t of the thread. Freed by this function.
+ * @return The return value of the caller's function.
+ */
+static u32
+thread_start
+(   void* args
+)
+{
+    const thread_start_t start = *( ( thread_start_t* ) args );
+    platform_memory_free ( args );
+    const u32 result = start.function ( start.args );
+    memory_thread_cache_flush ();
+    return result;
+}
 
 bool
 thread_create
@@ -17,14 +46,50 @@ thread_create
 ,   thread_t*               thread
 )
 {
-    if ( !platform_thread_create ( function , args , auto_detach , thread ) )
+    thread_options_t options;
+    memory_clear ( &options , sizeof ( thread_options_t ) );
+    options.auto_detach = auto_detach;
+    return thread_create_ex ( function , args , &options , thread );
+}
+
+bool
+thread_create_ex
+(   thread_start_function_t function
+,   void*                   args
+,   const thread_options_t* options
+,   thread_t*               thread
+)
+{
+    if ( options && ( *options ).priority >= THREAD_PRIORITY_COUNT )
     {
+        LOGERROR ( "thread_create_ex: Value of priority option (%u) is not a valid thread priority."
+                 , ( *options ).priority
+                 );
+        return false;
+    }
+
+    // Held outside the memory subsystem, because the thread frees it.
+    thread_start_t* start = 0;
+    if ( function )
+    {
+        start = platform_memory_allocate ( sizeof ( thread_start_t ) );
+        ( *start ).function = function;
+        ( *start ).args = args;
+    }
+    if ( !platform_thread_create ( ( start ) ? thread_start : 0 , start , options , thread ) )
+    {
+        if ( start )
+        {
+            platform_memory_free ( start );
+        }
         return false;
     }
     
-    LOGDEBUG ( "thread_create: Starting process on new%sthread #%u."
-             , auto_detach ? " auto-detach " : " "
+    LOGDEBUG ( "thread_create: Starting process on new%sthread #%u%s%s."
+             , ( *options ).auto_detach ? " auto-detach " : " "
              , ( *thread ).id
+             , ( ( *options ).name ) ? ": " : ""
+             , ( ( *options ).name ) ? ( *options ).name : ""
              );
     
     return true;
@@ -93,4 +158,38 @@ thread_id
 ( void )
 {
     return platform_thread_id ();
+}
+
+u32
+thread_numa_node_count
+( void )
+{
+    return platform_numa_node_count ();
+}
+
+u32
+thread_numa_node
+( void )
+{
+    return platform_numa_node_current ();
+}
+
+bool
+thread_affinity_set_node
+(   u32 node
+)
+{
+    if ( node >= platform_numa_node_count () )
+    {
+        LOGERROR ( "thread_affinity_set_node: Value of node argument (%u) exceeds the number of NUMA nodes (%u)."
+                 , node , platform_numa_node_count ()
+                 );
+        return false;
+    }
+    if ( !platform_thread_affinity_set_node ( node ) )
+    {
+        return false;
+    }
+    memory_thread_node_set ( node );
+    return true;
 }
\ No newline at end of file
@@ -13,19 +13,70 @@
 /** @brief Type definition for a thread. */
 typedef struct
 {
-    void*       internal;
+    // Native thread handle (pthread_t, or HANDLE on Windows). Held inline,
+    // so creating a thread never allocates memory.
+    u64         handle;
     u64         id;
+
+    // Does handle refer to a thread which has not been waited for, detached,
+    // cancelled or destroyed? Y/N
+    bool        valid;
+
     queue_t*    work;
 }
 thread_t;
 
+/** @brief Type and instance definitions for thread scheduling priority. */
+typedef enum
+{
+    THREAD_PRIORITY_NORMAL  = 0 /** @brief Host platform default. */
+,   THREAD_PRIORITY_LOW     = 1 /** @brief Yields to normal-priority threads (e.g. background work). */
+,   THREAD_PRIORITY_HIGH    = 2 /** @brief Preempts normal-priority threads. Requires CAP_SYS_NICE on Linux. */
+
+,   THREAD_PRIORITY_COUNT   = 3
+}
+THREAD_PRIORITY;
+
+/** @brief Maximum length of a thread name (in characters). Longer names are truncated. */
+#define THREAD_NAME_MAX_LENGTH 15
+
+/**
+ * @brief Type definition for thread creation options (see thread_create_ex).
+ * A zero-initialized instance selects the host platform default for each.
+ */
+typedef struct
+{
+    // Stack size (in bytes), or 0 for the host platform default. Rounded up
+    // to the page size, and to the host platform minimum.
+    u64             stack_size;
+
+    // Name shown by debuggers and profilers, or 0 for none (see
+    // THREAD_NAME_MAX_LENGTH). Not supported on macOS.
+    const char*     name;
+
+    // Logical cores the thread may run on, one bit per core (bit i is core i),
+    // or 0 for any. Applied before the thread starts running, so it never runs
+    // on any other core. Only cores 0 through 63 can be selected. Not
+    // supported on macOS.
+    u64             affinity;
+
+    THREAD_PRIORITY priority;
+
+    // Release resources as soon as the thread completes (see
+    // thread_create)? Y/N
+    bool            auto_detach;
+}
+thread_options_t;
+
 /** @brief Type definition for a 'thread start' callback function. */
 typedef u32 ( *thread_start_function_t )( void* );
 
 /**
- * @brief Creates a new thread.
+ * @brief Creates a new thread, with the host platform default stack size,
+ * affinity and priority (see thread_create_ex).
  * 
- * Uses dynamic memory allocation. Call thread_destroy to free.
+ * Does not allocate memory (see core/memory.h). Call thread_destroy to release the thread's
+ * resources.
  * 
  * @param function The callback function to run threaded.
  * @param args Internal state arguments.
@@ -43,7 +94,33 @@ thread_create
 );
 
 /**
- * @brief Frees the memory used by a thread.
+ * @brief Creates a new thread with a specified stack size, name, CPU affinity
+ * and priority.
+ * 
+ * Does not allocate memory (see core/memory.h). Call thread_destroy to
+ * release the thread's resources.
+ * 
+ * Once function returns, any blocks still held by the thread's allocation
+ * cache are returned to the global allocator (see memory_thread_cache_flush).
+ * 
+ * @param function The callback function to run threaded.
+ * @param args Internal state arguments.
+ * @param options The thread creation options. Must be non-zero.
+ * @param thread Output buffer (only valid if auto_detach is false).
+ * @return true if successfully created; otherwise false (e.g. if the affinity
+ * mask selects no logical core of the host platform, or the priority requires
+ * privileges the process lacks).
+ */
+bool
+thread_create_ex
+(   thread_start_function_t function
+,   void*                   args
+,   const thread_options_t* options
+,   thread_t*               thread
+);
+
+/**
+ * @brief Releases the resources of a thread.
  * 
  * @param thread The thread to free.
  */
@@ -77,6 +154,9 @@ thread_cancel
 /**
  * @brief Waits on the thread to complete all work.
  * 
+ * On success, the thread has exited and may no longer be detached or
+ * cancelled; call thread_destroy to release any remaining resources.
+ * 
  * @param thread The thread to wait for.
  * @return true on success; false otherwise.
  */
@@ -130,4 +210,40 @@ u64
 thread_id
 ( void );
 
+/**
+ * @brief Queries the number of NUMA nodes on the host platform.
+ * 
+ * @return The number of NUMA nodes (1 if the host platform is not NUMA).
+ */
+u32
+thread_numa_node_count
+( void );
+
+/**
+ * @brief Queries the NUMA node the current thread is running on.
+ * 
+ * Unless the thread is restricted to a node (see thread_affinity_set_node),
+ * the result may be stale as soon as it is returned.
+ * 
+ * @return The NUMA node of the current thread.
+ */
+u32
+thread_numa_node
+( void );
+
+/**
+ * @brief Restricts the current thread to the logical cores of a NUMA node, and
+ * directs its subsequent allocations to that node's heap (see
+ * memory_thread_node_set).
+ * 
+ * Not supported on macOS.
+ * 
+ * @param node The NUMA node. Must be less than thread_numa_node_count.
+ * @return true on success; false otherwise.
+ */
+bool
+thread_affinity_set_node
+(   u32 node
+);
+
 #endif  // THREAD_H
\ No newline at end of file
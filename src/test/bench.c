@@ -0,0 +1,548 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file test/bench.c
+ * @brief Implementation of test/bench header.
+ * (see test/bench.h for additional details)
+ */
+#include "test/bench.h"
+
+#include "container/array.h"
+#include "container/string.h"
+
+#include "core/clock.h"
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/sort.h"
+
+#include "math/math.h"
+
+#include "platform/filesystem.h"
+#include "platform/platform.h"
+#include "platform/thread.h"
+
+/** @brief Number of rounds a thread spins at the bench_run_threads barrier before yielding. */
+#define BENCH_SPIN_MAX 4096
+
+/** @brief Type definition for state shared by the threads of bench_run_threads. */
+typedef struct
+{
+    bench_function_t    function;
+    void*               args;
+    u64                 iterations;
+    u32                 thread_count;
+    u32                 ready;
+    u32                 failed;
+}
+bench_threads_t;
+
+/** @brief Names of the hardware performance counters, as reported (see PLATFORM_PERF_COUNTER). */
+static const char* bench_counter_names[ PLATFORM_PERF_COUNTER_COUNT ] = { "hw_cycles"
+                                                                        , "instructions"
+                                                                        , "cache_misses"
+                                                                        , "branch_misses"
+                                                                        };
+
+static bench_entry_t* benches = 0;
+static bench_result_t* results = 0;
+static bool counters_enabled = false;
+
+/**
+ * @brief Times a single sample of a benchmark.
+ * 
+ * @param entry The benchmark.
+ * @param iterations The number of iterations in the sample.
+ * @param seconds Output buffer for the duration of the sample in seconds.
+ * @param cycles Output buffer for the duration of the sample in cycle counter
+ * ticks.
+ * @return false if the benchmark failed; true otherwise.
+ */
+static bool
+bench_sample
+(   const bench_entry_t*    entry
+,   const u64               iterations
+,   f64*                    seconds
+,   u64*                    cycles
+);
+
+/**
+ * @brief Appends the hardware performance counters of a benchmark result to
+ * a string, in human-readable form.
+ * 
+ * @param string The resizable string to append to.
+ * @param result The benchmark result.
+ * @return The (possibly reallocated) string.
+ */
+static char*
+bench_counters_format
+(   char*                   string
+,   const bench_result_t*   result
+);
+
+/**
+ * @brief Thread start function for bench_run_threads. Waits for every thread
+ * to start, then runs the benchmark function.
+ * 
+ * @param args Shared state (bench_threads_t).
+ * @return 0.
+ */
+static u32
+bench_thread
+(   void* args
+);
+
+/**
+ * @brief Writes a string to a file as a JSON or CSV string literal.
+ * 
+ * @param string The resizable string to append to.
+ * @param value The null-terminated string to quote.
+ * @param escape The character which escapes a quote: '\\' (JSON) or '"'
+ * (CSV).
+ * @return The (possibly reallocated) string.
+ */
+static char*
+bench_quote
+(   char*       string
+,   const char* value
+,   const char  escape
+);
+
+void
+bench_startup
+( void )
+{
+    benches = array_create_new ( bench_entry_t );
+    results = array_create_new ( bench_result_t );
+}
+
+void
+bench_shutdown
+( void )
+{
+    array_destroy ( benches );
+    array_destroy ( results );
+    benches = 0;
+    results = 0;
+}
+
+bool
+_bench_register
+(   bench_function_t            function
+,   bench_setup_function_t      setup
+,   bench_teardown_function_t   teardown
+,   void*                       args
+,   char*                       description
+)
+{
+    if ( !function )
+    {
+        LOGERROR ( "bench_register: Missing argument: function (benchmark process to run)." );
+        return false;
+    }
+
+    bench_entry_t entry;
+    entry.function = function;
+    entry.setup = setup;
+    entry.teardown = teardown;
+    entry.args = args;
+    entry.description = description ? description : "";
+    array_push ( benches , entry );
+    return true;
+}
+
+void
+bench_counters_enable
+(   bool enabled
+)
+{
+    counters_enabled = enabled;
+}
+
+bool
+bench_run_all
+( void )
+{
+    const u32 bench_count = array_length ( benches );
+    _array_field_set ( results , ARRAY_FIELD_LENGTH , 0 );
+
+    // Opened before any benchmark creates a thread, so that the counters are
+    // inherited by threads created within a sample (see bench_run_threads).
+    platform_perf_t perf;
+    perf.available = 0;
+    if ( counters_enabled && !platform_perf_open ( &perf ) )
+    {
+        LOGWARN ( "bench_run_all: Hardware performance counters are unavailable on this host; reporting time only." );
+    }
+    u64 counts[ PLATFORM_PERF_COUNTER_COUNT ];
+
+    f64* seconds = memory_allocate ( BENCH_SAMPLE_COUNT * sizeof ( f64 ) , MEMORY_TAG_ARRAY );
+    f64* cycles = memory_allocate ( BENCH_SAMPLE_COUNT * sizeof ( f64 ) , MEMORY_TAG_ARRAY );
+
+    u32 fail = 0;
+    for ( u32 i = 0; i < bench_count; ++i )
+    {
+        const bench_entry_t* entry = &benches[ i ];
+        f64 elapsed;
+        u64 ticks;
+
+        if ( ( *entry ).setup && !( *entry ).setup ( ( *entry ).args ) )
+        {
+            LOGERROR ( "FAILED: %s" , ( *entry ).description );
+            fail += 1;
+            continue;
+        }
+
+        // Calibrate: grow the sample until it lasts at least BENCH_SAMPLE_TIME.
+        // Growth is bounded so that a noisy first sample cannot overshoot.
+        u64 iterations = 1;
+        f64 warmup = 0.0;
+        bool ok = true;
+        while ( ( ok = bench_sample ( entry , iterations , &elapsed , &ticks ) ) )
+        {
+            warmup += elapsed;
+            if ( elapsed >= BENCH_SAMPLE_TIME )
+            {
+                break;
+            }
+            const f64 scale = ( elapsed > 0.0 ) ? ( 1.2 * BENCH_SAMPLE_TIME / elapsed ) : 10.0;
+            iterations = MAX ( iterations + 1 , ( u64 )( iterations * MIN ( scale , 10.0 ) ) );
+        }
+
+        // Warm up.
+        while ( ok && warmup < BENCH_WARMUP_TIME )
+        {
+            ok = bench_sample ( entry , iterations , &elapsed , &ticks );
+            warmup += elapsed;
+        }
+
+        // Measure.
+        f64 sum = 0.0;
+        platform_perf_start ( &perf );
+        for ( u32 j = 0; ok && j < BENCH_SAMPLE_COUNT; ++j )
+        {
+            ok = bench_sample ( entry , iterations , &elapsed , &ticks );
+            seconds[ j ] = elapsed * 1.0E9 / iterations;
+            cycles[ j ] = ( f64 ) ticks / iterations;
+            sum += seconds[ j ];
+        }
+        platform_perf_stop ( &perf , counts );
+        if ( ( *entry ).teardown )
+        {
+            ( *entry ).teardown ( ( *entry ).args );
+        }
+        if ( !ok )
+        {
+            LOGERROR ( "FAILED: %s" , ( *entry ).description );
+            fail += 1;
+            continue;
+        }
+
+        sort_radix ( seconds , BENCH_SAMPLE_COUNT , sizeof ( f64 ) , 0 , SORT_KEY_F64 , 0 );
+        sort_radix ( cycles , BENCH_SAMPLE_COUNT , sizeof ( f64 ) , 0 , SORT_KEY_F64 , 0 );
+
+        bench_result_t result;
+        result.description = ( *entry ).description;
+        result.iterations = iterations;
+        result.samples = BENCH_SAMPLE_COUNT;
+        result.min = seconds[ 0 ];
+        result.median = seconds[ BENCH_SAMPLE_COUNT / 2 ];
+        result.p99 = seconds[ ( BENCH_SAMPLE_COUNT * 99 ) / 100 ];
+        result.mean = sum / BENCH_SAMPLE_COUNT;
+        result.cycles = cycles[ BENCH_SAMPLE_COUNT / 2 ];
+        result.counters = perf.available;
+        for ( u32 j = 0; j < PLATFORM_PERF_COUNTER_COUNT; ++j )
+        {
+            result.counter[ j ] = ( f64 ) counts[ j ] / ( iterations * BENCH_SAMPLE_COUNT );
+        }
+        array_push ( results , result );
+
+        char* counters = bench_counters_format ( string_create () , &result );
+        LOGINFO ( "Executed %u of %u.\n\t%s\n\tMin:      %.2f ns\n\tMedian:   %.2f ns  (%.1f cycles)\n\tp99:      %.2f ns\n\tSamples:  %u x %u iterations%s"
+                , i + 1
+                , bench_count
+                , result.description
+                , &result.min
+                , &result.median
+                , &result.cycles
+                , &result.p99
+                , result.samples
+                , result.iterations
+                , counters
+                );
+        string_destroy ( counters );
+    }
+
+    if ( perf.available )
+    {
+        platform_perf_close ( &perf );
+    }
+    memory_free ( seconds , BENCH_SAMPLE_COUNT * sizeof ( f64 ) , MEMORY_TAG_ARRAY );
+    memory_free ( cycles , BENCH_SAMPLE_COUNT * sizeof ( f64 ) , MEMORY_TAG_ARRAY );
+
+    LOGINFO ( "Results:  %u ran, %u failed." , bench_count - fail , fail );
+    return !fail;
+}
+
+bool
+bench_run_threads
+(   bench_function_t    function
+,   void*               args
+,   u64                 iterations
+,   u32                 thread_count
+)
+{
+    if ( !function || !thread_count || thread_count > BENCH_THREAD_MAX )
+    {
+        if ( !function )
+        {
+            LOGERROR ( "bench_run_threads: Missing argument: function (benchmark process to run)." );
+        }
+        else
+        {
+            LOGERROR ( "bench_run_threads: Value of thread_count argument must be in [ 1 , %u ]." , BENCH_THREAD_MAX );
+        }
+        return false;
+    }
+
+    bench_threads_t shared;
+    shared.function = function;
+    shared.args = args;
+    shared.iterations = iterations;
+    shared.thread_count = thread_count;
+    shared.ready = 0;
+    shared.failed = 0;
+
+    thread_t threads[ BENCH_THREAD_MAX ];
+    u32 created = 0;
+    for ( ; created < thread_count; ++created )
+    {
+        if ( !thread_create ( bench_thread , &shared , false , &threads[ created ] ) )
+        {
+            // Release any threads already waiting on the missing one.
+            atomic_fetch_add_u32 ( &shared.ready , thread_count - created , ATOMIC_RELEASE );
+            atomic_fetch_add_u32 ( &shared.failed , 1 , ATOMIC_RELAXED );
+            break;
+        }
+    }
+    for ( u32 i = 0; i < created; ++i )
+    {
+        thread_wait ( &threads[ i ] );
+        thread_destroy ( &threads[ i ] );
+    }
+    return !shared.failed;
+}
+
+bool
+bench_write
+(   const char*     path
+,   BENCH_FORMAT    format
+)
+{
+    if ( !path || format >= BENCH_FORMAT_COUNT )
+    {
+        if ( !path )
+        {
+            LOGERROR ( "bench_write: Missing argument: path (file to write to)." );
+        }
+        else
+        {
+            LOGERROR ( "bench_write: Value of format argument is invalid: %u." , format );
+        }
+        return false;
+    }
+
+    const u64 result_count = array_length ( results );
+    char* string = string_create ();
+    if ( format == BENCH_FORMAT_JSON )
+    {
+        string_push ( string , "[\n" , 2 );
+    }
+    else
+    {
+        _string_push ( string , "description,iterations,samples,min_ns,median_ns,p99_ns,mean_ns,median_cycles" );
+        for ( u32 i = 0; i < PLATFORM_PERF_COUNTER_COUNT; ++i )
+        {
+            string_format_append ( string , ",%s" , bench_counter_names[ i ] );
+        }
+        string_push ( string , "\n" , 1 );
+    }
+    for ( u64 i = 0; i < result_count; ++i )
+    {
+        const bench_result_t* result = &results[ i ];
+        if ( format == BENCH_FORMAT_JSON )
+        {
+            _string_push ( string , "  { \"description\": " );
+            string = bench_quote ( string , ( *result ).description , '\\' );
+            string_format_append ( string
+                                 , ", \"iterations\": %u, \"samples\": %u, \"min_ns\": %.3f, \"median_ns\": %.3f, \"p99_ns\": %.3f, \"mean_ns\": %.3f, \"median_cycles\": %.3f"
+                                 , ( *result ).iterations
+                                 , ( *result ).samples
+                                 , &( *result ).min
+                                 , &( *result ).median
+                                 , &( *result ).p99
+                                 , &( *result ).mean
+                                 , &( *result ).cycles
+                                 );
+
+            // Unavailable counters are omitted.
+            for ( u32 j = 0; j < PLATFORM_PERF_COUNTER_COUNT; ++j )
+            {
+                if ( ( *result ).counters & ( 1 << j ) )
+                {
+                    string_format_append ( string
+                                         , ", \"%s\": %.3f"
+                                         , bench_counter_names[ j ]
+                                         , &( *result ).counter[ j ]
+                                         );
+                }
+            }
+            string_format_append ( string , " }%s\n" , ( i + 1 < result_count ) ? "," : "" );
+        }
+        else
+        {
+            string = bench_quote ( string , ( *result ).description , '"' );
+            string_format_append ( string
+                                 , ",%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f"
+                                 , ( *result ).iterations
+                                 , ( *result ).samples
+                                 , &( *result ).min
+                                 , &( *result ).median
+                                 , &( *result ).p99
+                                 , &( *result ).mean
+                                 , &( *result ).cycles
+                                 );
+
+            // Unavailable counters are left empty.
+            for ( u32 j = 0; j < PLATFORM_PERF_COUNTER_COUNT; ++j )
+            {
+                if ( ( *result ).counters & ( 1 << j ) )
+                {
+                    string_format_append ( string , ",%.3f" , &( *result ).counter[ j ] );
+                }
+                else
+                {
+                    string_push ( string , "," , 1 );
+                }
+            }
+            string_push ( string , "\n" , 1 );
+        }
+    }
+    if ( format == BENCH_FORMAT_JSON )
+    {
+        string_push ( string , "]\n" , 2 );
+    }
+
+    file_t file;
+    u64 written = 0;
+    bool success = file_open ( path , FILE_MODE_WRITE , &file );
+    if ( success )
+    {
+        success = file_write ( &file , string_length ( string ) , string , &written );
+        file_close ( &file );
+    }
+    if ( !success )
+    {
+        LOGERROR ( "bench_write: Failed to write results to file: %s" , path );
+    }
+    string_destroy ( string );
+    return success;
+}
+
+static bool
+bench_sample
+(   const bench_entry_t*    entry
+,   const u64               iterations
+,   f64*                    seconds
+,   u64*                    cycles
+)
+{
+    const u64 start = clock_time ();
+    const u64 start_cycles = clock_ticks ();
+    const bool ok = ( *entry ).function ( ( *entry ).args , iterations );
+    *cycles = clock_ticks () - start_cycles;
+    *seconds = clock_seconds ( clock_time () - start );
+    return ok;
+}
+
+static char*
+bench_counters_format
+(   char*                   string
+,   const bench_result_t*   result
+)
+{
+    if ( !( *result ).counters )
+    {
+        return string;
+    }
+    _string_push ( string , "\n\tCounters: " );
+    bool first = true;
+    for ( u32 i = 0; i < PLATFORM_PERF_COUNTER_COUNT; ++i )
+    {
+        if ( ( *result ).counters & ( 1 << i ) )
+        {
+            string_format_append ( string
+                                 , "%s%.2f %s"
+                                 , first ? "" : ", "
+                                 , &( *result ).counter[ i ]
+                                 , bench_counter_names[ i ]
+                                 );
+            first = false;
+        }
+    }
+
+    // Instructions per cycle.
+    const u32 ipc = ( 1 << PLATFORM_PERF_CYCLES ) | ( 1 << PLATFORM_PERF_INSTRUCTIONS );
+    if ( ( ( *result ).counters & ipc ) == ipc && ( *result ).counter[ PLATFORM_PERF_CYCLES ] > 0.0 )
+    {
+        const f64 value = ( *result ).counter[ PLATFORM_PERF_INSTRUCTIONS ]
+                        / ( *result ).counter[ PLATFORM_PERF_CYCLES ]
+                        ;
+        string_format_append ( string , " (%.2f IPC)" , &value );
+    }
+    return string;
+}
+
+static u32
+bench_thread
+(   void* args
+)
+{
+    bench_threads_t* shared = args;
+    atomic_fetch_add_u32 ( &( *shared ).ready , 1 , ATOMIC_RELEASE );
+    for ( u32 spin = 0; atomic_load_u32 ( &( *shared ).ready , ATOMIC_ACQUIRE ) < ( *shared ).thread_count; ++spin )
+    {
+        // Yield if the threads seem to outnumber the processors.
+        if ( spin < BENCH_SPIN_MAX )
+        {
+            atomic_pause ();
+        }
+        else
+        {
+            platform_sleep ( 0 );
+        }
+    }
+    if ( !( *shared ).function ( ( *shared ).args , ( *shared ).iterations ) )
+    {
+        atomic_fetch_add_u32 ( &( *shared ).failed , 1 , ATOMIC_RELAXED );
+    }
+    return 0;
+}
+
+static char*
+bench_quote
+(   char*       string
+,   const char* value
+,   const char  escape
+)
+{
+    string_push ( string , "\"" , 1 );
+    for ( ; *value; ++value )
+    {
+        if ( *value == '"' || ( escape == '\\' && *value == '\\' ) )
+        {
+            string_push ( string , &escape , 1 );
+        }
+        string_push ( string , value , 1 );
+    }
+    string_push ( string , "\"" , 1 );
+    return string;
+}
@@ -0,0 +1,220 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file test/bench.h
+ * @brief Microbenchmark management subsystem.
+ *
+ * A benchmark is a function which runs the operation under test a requested
+ * number of times. For each registered benchmark, bench_run_all:
+ *   1. Calibrates the number of iterations per sample, so that each sample
+ *      lasts at least BENCH_SAMPLE_TIME (timer resolution is then negligible).
+ *   2. Warms up (caches, branch predictors, allocator state) until
+ *      BENCH_WARMUP_TIME has elapsed.
+ *   3. Times BENCH_SAMPLE_COUNT samples, and reports the minimum, median and
+ *      99th percentile time per iteration, as well as the median cycle count.
+ *      If enabled (see bench_counters_enable), hardware performance counters
+ *      (core cycles, instructions, cache misses, branch misses) are also read
+ *      across all the samples, and reported per iteration.
+ *
+ * The results of the last run can be written out as JSON or CSV (see
+ * bench_write), so that runs can be compared across revisions.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "common.h"
+
+#include "platform/platform.h"
+
+/** @brief Minimum duration of a single sample (in seconds). */
+#define BENCH_SAMPLE_TIME 0.002
+
+/** @brief Minimum duration of the warmup phase (in seconds). */
+#define BENCH_WARMUP_TIME 0.1
+
+/** @brief Number of samples timed per benchmark. */
+#define BENCH_SAMPLE_COUNT 100
+
+/** @brief Maximum number of threads which can run a benchmark at once (see bench_run_threads). */
+#define BENCH_THREAD_MAX 16
+
+/**
+ * @brief Type definition for a benchmark callback function.
+ * 
+ * Runs the operation under test iterations times. Any per-sample setup may
+ * be done inside the function; its cost is amortized over the iterations.
+ * Setup too costly to amortize belongs in a setup function instead (see
+ * _bench_register). Returns false on error.
+ */
+typedef bool ( *bench_function_t )( void* args , u64 iterations );
+
+/**
+ * @brief Type definition for a benchmark setup function. Called once with the
+ * benchmark arguments before the benchmark runs, and not timed. Returns false
+ * on error.
+ */
+typedef bool ( *bench_setup_function_t )( void* args );
+
+/**
+ * @brief Type definition for a benchmark teardown function. Called once with
+ * the benchmark arguments after the benchmark runs, if setup succeeded.
+ */
+typedef void ( *bench_teardown_function_t )( void* args );
+
+/** @brief Type definition for a container to hold benchmark info. */
+typedef struct
+{
+    bench_function_t            function;
+    bench_setup_function_t      setup;
+    bench_teardown_function_t   teardown;
+    void*                       args;
+    char*                       description;
+}
+bench_entry_t;
+
+/**
+ * @brief Type definition for the result of a benchmark. Times are in
+ * nanoseconds per iteration.
+ */
+typedef struct
+{
+    char*   description;
+    u64     iterations; // Per sample.
+    u64     samples;
+    f64     min;
+    f64     median;
+    f64     p99;
+    f64     mean;
+    f64     cycles;     // Median cycle counter ticks per iteration (see clock_ticks).
+
+    // Hardware performance counter events per iteration, averaged over every
+    // sample. Bit i of counters is set if counter[ i ] was read.
+    u32     counters;
+    f64     counter[ PLATFORM_PERF_COUNTER_COUNT ];
+}
+bench_result_t;
+
+/** @brief Type and instance definitions for benchmark result formats. */
+typedef enum
+{
+    BENCH_FORMAT_JSON
+,   BENCH_FORMAT_CSV
+
+,   BENCH_FORMAT_COUNT
+}
+BENCH_FORMAT;
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of a
+ * value, without otherwise affecting the generated code.
+ */
+#define BENCH_DO_NOT_OPTIMIZE(value) \
+    __asm__ volatile ( "" : : "r,m" ( value ) : "memory" )
+
+/**
+ * @brief Forces the compiler to assume all memory may have been read or
+ * written, so that stores which are never read are not optimized away.
+ */
+#define BENCH_CLOBBER() \
+    __asm__ volatile ( "" : : : "memory" )
+
+/**
+ * @brief Initializes the benchmark manager.
+ */
+void
+bench_startup
+( void );
+
+/**
+ * @brief Frees the memory used by the benchmark manager, including the results
+ * of the last run.
+ */
+void
+bench_shutdown
+( void );
+
+/**
+ * @brief Registers a benchmark with the benchmark manager.
+ * 
+ * Use bench_register to register a benchmark without setup or teardown.
+ * 
+ * @param function A callback function.
+ * @param setup Called with args before the benchmark runs. Optional (pass 0).
+ * @param teardown Called with args after the benchmark runs. Optional (pass
+ * 0).
+ * @param args Argument passed to function on each call.
+ * @param description Benchmark description string.
+ * @return true on success; false otherwise.
+ */
+bool
+_bench_register
+(   bench_function_t            function
+,   bench_setup_function_t      setup
+,   bench_teardown_function_t   teardown
+,   void*                       args
+,   char*                       description
+);
+
+#define bench_register(function,args,description) \
+    _bench_register ( (function) , 0 , 0 , (args) , (description) )
+
+/**
+ * @brief Enables or disables hardware performance counter sampling for
+ * subsequent runs (see bench_run_all). Disabled by default.
+ *
+ * Counters which the host does not support or permit (see platform_perf_open)
+ * are omitted from the results; the run is otherwise unaffected.
+ *
+ * @param enabled Sample counters? Y\N
+ */
+void
+bench_counters_enable
+(   bool enabled
+);
+
+/**
+ * @brief Runs all registered benchmarks.
+ * 
+ * @return true if all benchmarks ran; false otherwise.
+ */
+bool
+bench_run_all
+( void );
+
+/**
+ * @brief Runs a benchmark function on several threads at once, and waits for
+ * every thread to finish.
+ *
+ * For use within a benchmark function which measures contention. Each thread
+ * runs the full number of iterations, so the time per iteration reported for
+ * the enclosing benchmark is the time for every thread to complete one. The
+ * threads are released together once all have started, but the time taken to
+ * create and join them is included in the sample.
+ * 
+ * @param function A callback function. Must be thread-safe.
+ * @param args Argument passed to function on each thread.
+ * @param iterations The number of iterations for each thread to run.
+ * @param thread_count The number of threads. Must be in [ 1 , BENCH_THREAD_MAX ].
+ * @return true if function succeeded on every thread; false otherwise.
+ */
+bool
+bench_run_threads
+(   bench_function_t    function
+,   void*               args
+,   u64                 iterations
+,   u32                 thread_count
+);
+
+/**
+ * @brief Writes the results of the last run (see bench_run_all) to a file.
+ * 
+ * @param path The filepath to write to. Any existing file is overwritten.
+ * @param format The file format.
+ * @return true on success; false otherwise.
+ */
+bool
+bench_write
+(   const char*     path
+,   BENCH_FORMAT    format
+);
+
+#endif  // BENCH_H
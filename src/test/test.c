@@ -15,8 +15,62 @@
 
 #include "math/math.h"
 
+#include "platform/platform.h"
+#include "platform/thread.h"
+
+/** @brief Type definition for the outcome of a test. */
+typedef struct
+{
+    u8                  result;
+    u64                 elapsed;    // In nanoseconds.
+    u32                 done;       // Published once result and elapsed are set.
+    memory_stat_scope_t scope;      // (see memory_stat_scope_set)
+}
+test_outcome_t;
+
+/**
+ * @brief Type definition for a run of consecutively registered tests which
+ * are distributed across a pool of worker threads.
+ */
+typedef struct
+{
+    test_outcome_t* outcomes;
+    u32             next;       // Index of the next test to claim.
+    u32             end;        // Index past the last test of the run.
+}
+test_batch_t;
+
+/** @brief Interval (in milliseconds) at which the calling thread polls for a concurrent test to finish. */
+#define TEST_POLL_INTERVAL 1
+
 static test_entry_t* tests;
 
+/**
+ * @brief Runs a test on the calling thread, and records its outcome.
+ * 
+ * @param index The index of the test.
+ * @param scoped Record its memory usage in a statistics scope of its own?
+ * Y/N
+ * @param outcome Output buffer for the outcome.
+ */
+void
+_test_run
+(   const u32       index
+,   const bool      scoped
+,   test_outcome_t* outcome
+);
+
+/**
+ * @brief Thread: runs tests from a batch until every test in it is claimed.
+ * 
+ * @param batch The batch.
+ * @return 0.
+ */
+u32
+_test_worker
+(   void* batch
+);
+
 void
 test_startup
 ( void )
@@ -25,9 +79,10 @@ test_startup
 }
 
 bool
-test_register
+_test_register
 (   test_function_t function
 ,   char*           description
+,   bool            serial
 )
 {
     if ( !function )
@@ -39,15 +94,18 @@ test_register
     test_entry_t entry;
     entry.function = function;
     entry.description = description ? description : "";
+    entry.serial = serial;
     array_push ( tests , entry );
     return true;
 }
 
 bool
-test_run_all
-( void )
+_test_run_all
+(   u32 thread_count
+)
 {
     const u32 test_count = array_length ( tests );
+    thread_count = MAX ( thread_count , 1U );
     
     u32 pass = 0;
     u32 fail = 0;
@@ -61,18 +119,70 @@ test_run_all
     clock_t clock_master;
     clock_start ( &clock_master );
 
+    // Allocated before any test runs, so that no test sees it.
+    test_outcome_t* outcomes = memory_allocate ( MAX ( test_count , 1U ) * sizeof ( test_outcome_t )
+                                               , MEMORY_TAG_ARRAY
+                                               );
+    thread_t* threads = memory_allocate ( thread_count * sizeof ( thread_t )
+                                        , MEMORY_TAG_ARRAY
+                                        );
+    test_batch_t batch;
+    batch.outcomes = outcomes;
+    batch.next = 0;
+    batch.end = 0;
+    u32 thread_started = 0;
+
     for ( u32 i = 0; i < test_count; ++i )
     {
+        if ( i >= batch.end )
+        {
+            // Wait for the worker threads of the previous batch to exit.
+            while ( thread_started )
+            {
+                thread_started -= 1;
+                thread_wait ( &threads[ thread_started ] );
+                thread_destroy ( &threads[ thread_started ] );
+            }
+
+            // Start a batch with each run of consecutive tests which are not
+            // serial.
+            u32 end = i;
+            while ( thread_count > 1 && end < test_count && !tests[ end ].serial )
+            {
+                end += 1;
+            }
+            if ( end - i > 1 )
+            {
+                batch.next = i;
+                batch.end = end;
+                while ( thread_started < MIN ( thread_count , end - i ) )
+                {
+                    if ( !thread_create ( _test_worker , &batch , false , &threads[ thread_started ] ) )
+                    {
+                        break;
+                    }
+                    thread_started += 1;
+                }
+            }
+            if ( !thread_started )
+            {
+                // Serial test (or no worker thread could be started).
+                batch.end = i + 1;
+                _test_run ( i , false , &outcomes[ i ] );
+            }
+        }
+
+        while ( !atomic_load_u32 ( &outcomes[ i ].done , ATOMIC_ACQUIRE ) )
+        {
+            platform_sleep ( TEST_POLL_INTERVAL );
+        }
+        const u8 result = outcomes[ i ].result;
+
         u64 clock_test_elapsed_seconds;
         u64 clock_test_elapsed_minutes;
         u64 clock_test_elapsed_hours;
         f64 clock_test_elapsed_fractional;
 
-        clock_t clock_test;
-        clock_start ( &clock_test );
-        u8 result = tests[ i ].function ();
-        clock_update ( &clock_test );
-
         if ( result == true )
         {
             pass += 1;
@@ -95,13 +205,13 @@ test_run_all
 
         clock_update ( &clock_master );
 
-        display_time ( clock_master.elapsed
+        display_time ( clock_seconds ( clock_master.elapsed )
                      , &clock_master_elapsed_hours
                      , &clock_master_elapsed_minutes
                      , &clock_master_elapsed_seconds
                      , &clock_master_elapsed_fractional
                      );
-        display_time ( clock_test.elapsed
+        display_time ( clock_seconds ( outcomes[ i ].elapsed )
                      , &clock_test_elapsed_hours
                      , &clock_test_elapsed_minutes
                      , &clock_test_elapsed_seconds
@@ -127,9 +237,21 @@ test_run_all
         string_destroy ( status );
     }
 
+    while ( thread_started )
+    {
+        thread_started -= 1;
+        thread_wait ( &threads[ thread_started ] );
+        thread_destroy ( &threads[ thread_started ] );
+    }
+    memory_free ( threads , thread_count * sizeof ( thread_t ) , MEMORY_TAG_ARRAY );
+    memory_free ( outcomes
+                , MAX ( test_count , 1U ) * sizeof ( test_outcome_t )
+                , MEMORY_TAG_ARRAY
+                );
+
     clock_stop ( &clock_master );
 
-    display_time ( clock_master.elapsed
+    display_time ( clock_seconds ( clock_master.elapsed )
                  , &clock_master_elapsed_hours
                  , &clock_master_elapsed_minutes
                  , &clock_master_elapsed_seconds
@@ -151,3 +273,48 @@ test_run_all
 
     return fail;
 }
+
+void
+_test_run
+(   const u32       index
+,   const bool      scoped
+,   test_outcome_t* outcome
+)
+{
+    memory_stat_scope_t* previous = 0;
+    if ( scoped )
+    {
+        memory_clear ( &( *outcome ).scope , sizeof ( memory_stat_scope_t ) );
+        previous = memory_stat_scope_set ( &( *outcome ).scope );
+    }
+
+    clock_t clock_test;
+    clock_start ( &clock_test );
+    ( *outcome ).result = tests[ index ].function ();
+    clock_update ( &clock_test );
+    ( *outcome ).elapsed = clock_test.elapsed;
+
+    if ( scoped )
+    {
+        memory_stat_scope_set ( previous );
+    }
+    atomic_store_u32 ( &( *outcome ).done , true , ATOMIC_RELEASE );
+}
+
+u32
+_test_worker
+(   void* batch_
+)
+{
+    test_batch_t* batch = batch_;
+    for (;;)
+    {
+        const u32 index = atomic_fetch_add_u32 ( &( *batch ).next , 1 , ATOMIC_RELAXED );
+        if ( index >= ( *batch ).end )
+        {
+            break;
+        }
+        _test_run ( index , true , &( *batch ).outcomes[ index ] );
+    }
+    return 0;
+}
@@ -2,6 +2,14 @@
  * @author Matthew Weissel (mweissel3@gatech.edu)
  * @file test/test.h
  * @brief Test management subsystem.
+ *
+ * Tests may run concurrently on a pool of worker threads (see _test_run_all).
+ * Each concurrent test records its memory usage into a statistics scope of its
+ * own (see memory_stat_scope_set), so that it may compare the memory
+ * subsystem's statistics before and after as if it ran alone. Tests which
+ * spawn threads, touch files, or modify process-wide state (e.g. the logger or
+ * the job system) must be registered with test_register_serial; these run one
+ * at a time, while no other test is running.
  */
 #ifndef TEST_H
 #define TEST_H
@@ -19,6 +27,7 @@ typedef struct
 {
     test_function_t function;
     char*           description;
+    bool            serial;
 }
 test_entry_t;
 
@@ -32,22 +41,47 @@ test_startup
 /**
  * @brief Registers a test with the test manager.
  * 
+ * Use test_register for a test which may run concurrently with others, or
+ * test_register_serial for one which may not.
+ * 
  * @param function A callback function.
  * @param description Test description string.
+ * @param serial Must the test run alone? Y/N
  * @return true on success; false otherwise.
  */
 bool
-test_register
+_test_register
 (   test_function_t function
 ,   char*           description
+,   bool            serial
 );
 
+#define test_register(function,description) \
+    _test_register ( (function) , (description) , false )
+
+#define test_register_serial(function,description) \
+    _test_register ( (function) , (description) , true )
+
 /**
  * @brief Runs all registered tests.
- * @return true if all tests passed; false otherwise.
+ * 
+ * With more than one thread, each run of consecutively registered tests which
+ * are not serial is distributed across a pool of worker threads; each serial
+ * test runs on the calling thread once all tests before it have finished.
+ * Results are reported in registration order either way.
+ * 
+ * Use test_run_all to run every test on the calling thread, or _test_run_all
+ * to specify the number of threads.
+ * 
+ * @param thread_count The number of tests to run at a time. 0 is treated as 1.
+ * @return true if any test failed; false otherwise.
  */
 bool
-test_run_all
-( void );
+_test_run_all
+(   u32 thread_count
+);
+
+#define test_run_all() \
+    _test_run_all ( 1 )
 
 #endif  // TEST_H
\ No newline at end of file
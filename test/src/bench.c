@@ -0,0 +1,104 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file bench.c
+ * @brief Entry point for the benchmark suite program.
+ *
+ * Usage: bench [--counters] [--json <path>] [--csv <path>]
+ *
+ * --counters also samples hardware performance counters, where the host permits
+ * (see bench_counters_enable).
+ */
+#include "common.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/string.h"
+
+#include "test/bench.h"
+
+#include "container/bench_array.h"
+#include "container/bench_freelist.h"
+#include "container/bench_hashtable.h"
+#include "container/bench_queue.h"
+#include "container/bench_string.h"
+#include "core/bench_checksum.h"
+#include "core/bench_compress.h"
+#include "core/bench_csv.h"
+#include "core/bench_memory.h"
+#include "memory/bench_dynamic_allocator.h"
+#include "memory/bench_linear_allocator.h"
+#include "platform/bench_filesystem.h"
+
+/** @brief Rough bound on maximum system memory usage: 1 GiB. */
+#define BENCH_MEMORY_REQUIREMENT \
+    GiB ( 1 )
+
+/** @brief Log filepath. */
+#define LOG_FILEPATH "bench.log"
+
+int
+main
+(   int     argc
+,   char**  argv
+)
+{
+    memory_startup ( BENCH_MEMORY_REQUIREMENT );
+    logger_startup ( LOG_FILEPATH , 0 , 0 );
+
+    // Debug messages (e.g. from thread_create) would otherwise be timed.
+    logger_level_set ( LOG_INFO );
+
+    // Initialize benchmarks.
+    bench_startup ();
+    bench_register_memory ();
+    bench_register_checksum ();
+    bench_register_compress ();
+    bench_register_csv ();
+    bench_register_array ();
+    bench_register_queue ();
+    bench_register_hashtable ();
+    bench_register_string ();
+    bench_register_freelist ();
+    bench_register_dynamic_allocator ();
+    bench_register_linear_allocator ();
+    bench_register_filesystem ();
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( _string_equal ( argv[ i ] , "--counters" ) )
+        {
+            bench_counters_enable ( true );
+        }
+    }
+
+    // Run benchmarks.
+    LOGINFO ( "Running benchmark suite. . ." );
+    bool success = bench_run_all ();
+
+    // Write results.
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( _string_equal ( argv[ i ] , "--counters" ) )
+        {
+            continue;
+        }
+        if ( i + 1 < argc && _string_equal ( argv[ i ] , "--json" ) )
+        {
+            success &= bench_write ( argv[ ++i ] , BENCH_FORMAT_JSON );
+        }
+        else if ( i + 1 < argc && _string_equal ( argv[ i ] , "--csv" ) )
+        {
+            success &= bench_write ( argv[ ++i ] , BENCH_FORMAT_CSV );
+        }
+        else
+        {
+            LOGERROR ( "Unrecognized option: %s" , argv[ i ] );
+            success = false;
+        }
+    }
+
+    bench_shutdown ();
+    logger_shutdown ();
+    memory_shutdown ();
+    return !success;
+}
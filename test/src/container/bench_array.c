@@ -0,0 +1,146 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_array.c
+ * @brief Implementation of the container/bench_array header.
+ * (see container/bench_array.h for additional details)
+ */
+#include "container/bench_array.h"
+
+ARRAY_DEFINE ( u64 )
+
+/** @brief Type definition for the arguments of an array benchmark. */
+typedef struct
+{
+    u64 length;         // Number of elements per iteration.
+    u32 thread_count;   // Number of threads (see bench_run_threads).
+}
+bench_array_args_t;
+
+/** @brief Arguments for bench_array_push. */
+static bench_array_args_t bench_array_push_args[] = { { 16 , 1 } , { 1024 , 1 } , { 65536 , 1 } };
+
+/** @brief Arguments for bench_array_push_threads. */
+static bench_array_args_t bench_array_push_threads_args[] = { { 1024 , 2 } , { 1024 , 4 } , { 1024 , 8 } };
+
+/**
+ * @brief Arguments for bench_array_insert and bench_array_remove. Each is
+ * quadratic in the length, so the largest is smaller than for array_push.
+ */
+static bench_array_args_t bench_array_shift_args[] = { { 16 , 1 } , { 256 , 1 } , { 4096 , 1 } };
+
+bool
+bench_array_push
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 length = ( *( ( bench_array_args_t* ) args ) ).length;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        u64* array = array_create_new ( u64 );
+        for ( u64 j = 0; j < length; ++j )
+        {
+            array_push ( array , j );
+        }
+        BENCH_DO_NOT_OPTIMIZE ( array );
+        array_destroy ( array );
+    }
+    return true;
+}
+
+bool
+bench_array_push_typed
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 length = ( *( ( bench_array_args_t* ) args ) ).length;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        u64* array = array_u64_create ( ARRAY_DEFAULT_CAPACITY );
+        for ( u64 j = 0; j < length; ++j )
+        {
+            array = array_u64_push ( array , j );
+        }
+        BENCH_DO_NOT_OPTIMIZE ( array );
+        array_destroy ( array );
+    }
+    return true;
+}
+
+bool
+bench_array_push_threads
+(   void*   args
+,   u64     iterations
+)
+{
+    return bench_run_threads ( bench_array_push
+                             , args
+                             , iterations
+                             , ( *( ( bench_array_args_t* ) args ) ).thread_count
+                             );
+}
+
+bool
+bench_array_insert
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 length = ( *( ( bench_array_args_t* ) args ) ).length;
+    u64* array = array_create ( u64 , length );
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        _array_field_set ( array , ARRAY_FIELD_LENGTH , 0 );
+        for ( u64 j = 0; j < length; ++j )
+        {
+            array_insert ( array , j / 2 , j );
+        }
+        BENCH_CLOBBER ();
+    }
+    array_destroy ( array );
+    return true;
+}
+
+bool
+bench_array_remove
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 length = ( *( ( bench_array_args_t* ) args ) ).length;
+    u64* array = array_create ( u64 , length );
+    u64 value;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        _array_field_set ( array , ARRAY_FIELD_LENGTH , length );
+        for ( u64 j = length; j; --j )
+        {
+            array_remove ( array , j / 2 , &value );
+        }
+        BENCH_DO_NOT_OPTIMIZE ( value );
+    }
+    array_destroy ( array );
+    return true;
+}
+
+void
+bench_register_array
+( void )
+{
+    bench_register ( bench_array_push , &bench_array_push_args[ 0 ] , "array_push: 16 elements into a new array." );
+    bench_register ( bench_array_push , &bench_array_push_args[ 1 ] , "array_push: 1024 elements into a new array." );
+    bench_register ( bench_array_push , &bench_array_push_args[ 2 ] , "array_push: 65536 elements into a new array." );
+    bench_register ( bench_array_push_typed , &bench_array_push_args[ 0 ] , "array_u64_push (ARRAY_DEFINE): 16 elements into a new array." );
+    bench_register ( bench_array_push_typed , &bench_array_push_args[ 1 ] , "array_u64_push (ARRAY_DEFINE): 1024 elements into a new array." );
+    bench_register ( bench_array_push_typed , &bench_array_push_args[ 2 ] , "array_u64_push (ARRAY_DEFINE): 65536 elements into a new array." );
+    bench_register ( bench_array_push_threads , &bench_array_push_threads_args[ 0 ] , "array_push: 1024 elements into a new array, on each of 2 threads." );
+    bench_register ( bench_array_push_threads , &bench_array_push_threads_args[ 1 ] , "array_push: 1024 elements into a new array, on each of 4 threads." );
+    bench_register ( bench_array_push_threads , &bench_array_push_threads_args[ 2 ] , "array_push: 1024 elements into a new array, on each of 8 threads." );
+    bench_register ( bench_array_insert , &bench_array_shift_args[ 0 ] , "array_insert: 16 elements at the middle." );
+    bench_register ( bench_array_insert , &bench_array_shift_args[ 1 ] , "array_insert: 256 elements at the middle." );
+    bench_register ( bench_array_insert , &bench_array_shift_args[ 2 ] , "array_insert: 4096 elements at the middle." );
+    bench_register ( bench_array_remove , &bench_array_shift_args[ 0 ] , "array_remove: 16 elements from the middle." );
+    bench_register ( bench_array_remove , &bench_array_shift_args[ 1 ] , "array_remove: 256 elements from the middle." );
+    bench_register ( bench_array_remove , &bench_array_shift_args[ 2 ] , "array_remove: 4096 elements from the middle." );
+}
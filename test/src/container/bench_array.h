@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_array.h
+ * @brief Benchmarks container/array.h
+ * (see test/bench.h, container/array.h for additional details)
+ */
+#ifndef BENCH_ARRAY_H
+#define BENCH_ARRAY_H
+
+#include "test/bench.h"
+
+#include "container/array.h"
+
+void
+bench_register_array
+( void );
+
+#endif  // BENCH_ARRAY_H
@@ -0,0 +1,128 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_freelist.c
+ * @brief Implementation of the container/bench_freelist header.
+ * (see container/bench_freelist.h for additional details)
+ */
+#include "container/bench_freelist.h"
+
+#include "core/memory.h"
+
+#include "math/prng.h"
+
+/** @brief Maximum size of a block allocated by a freelist benchmark. */
+#define BENCH_FREELIST_BLOCK_MAX 512
+
+/** @brief Number of pregenerated block sizes cycled through by bench_freelist_allocate. */
+#define BENCH_FREELIST_SIZE_COUNT 64
+
+/**
+ * @brief Type definition for the fixture of a freelist benchmark. Setup
+ * allocates twice the given number of fragments, then frees every other one,
+ * so that the free space is split into that many holes.
+ */
+typedef struct
+{
+    FREELIST_MODE   mode;
+    u64             fragments;
+    freelist_t*     freelist;
+    u64             sizes[ BENCH_FREELIST_SIZE_COUNT ];
+}
+bench_freelist_t;
+
+/** @brief Fixtures for bench_freelist_allocate. */
+static bench_freelist_t bench_freelist_args[] = { { FREELIST_MODE_FIRST_FIT , 16 , 0 , { 0 } }
+                                                , { FREELIST_MODE_FIRST_FIT , 1024 , 0 , { 0 } }
+                                                , { FREELIST_MODE_FIRST_FIT , 16384 , 0 , { 0 } }
+                                                , { FREELIST_MODE_SEGREGATED_FIT , 16 , 0 , { 0 } }
+                                                , { FREELIST_MODE_SEGREGATED_FIT , 1024 , 0 , { 0 } }
+                                                , { FREELIST_MODE_SEGREGATED_FIT , 16384 , 0 , { 0 } }
+                                                };
+
+bool
+bench_freelist_setup
+(   void* args
+)
+{
+    bench_freelist_t* fixture = args;
+    const u64 capacity = 4 * ( *fixture ).fragments * BENCH_FREELIST_BLOCK_MAX;
+    if ( !_freelist_create ( capacity , ( *fixture ).mode , 0 , 0 , 0 , &( *fixture ).freelist ) )
+    {
+        return false;
+    }
+
+    prng_t prng;
+    prng_seed ( &prng , ( *fixture ).fragments );
+    for ( u64 i = 0; i < BENCH_FREELIST_SIZE_COUNT; ++i )
+    {
+        ( *fixture ).sizes[ i ] = 16 + prng_bounded ( &prng , BENCH_FREELIST_BLOCK_MAX - 16 );
+    }
+
+    // Fragment the free space.
+    const u64 count = 2 * ( *fixture ).fragments;
+    u64* offsets = memory_allocate ( count * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+    bool success = true;
+    for ( u64 i = 0; success && i < count; ++i )
+    {
+        success = freelist_allocate ( ( *fixture ).freelist
+                                    , ( *fixture ).sizes[ i % BENCH_FREELIST_SIZE_COUNT ]
+                                    , &offsets[ i ]
+                                    );
+    }
+    for ( u64 i = 0; success && i < count; i += 2 )
+    {
+        success = freelist_free ( ( *fixture ).freelist
+                                , ( *fixture ).sizes[ i % BENCH_FREELIST_SIZE_COUNT ]
+                                , offsets[ i ]
+                                );
+    }
+    memory_free ( offsets , count * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+    if ( !success )
+    {
+        freelist_destroy ( &( *fixture ).freelist );
+    }
+    return success;
+}
+
+void
+bench_freelist_teardown
+(   void* args
+)
+{
+    freelist_destroy ( &( *( ( bench_freelist_t* ) args ) ).freelist );
+}
+
+bool
+bench_freelist_allocate
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_freelist_t* fixture = args;
+    u64 offset = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        // Sizes above those freed during setup force a search past the holes.
+        const u64 size = ( *fixture ).sizes[ i % BENCH_FREELIST_SIZE_COUNT ] + ( ( i & 1 ) ? BENCH_FREELIST_BLOCK_MAX : 0 );
+        if ( !freelist_allocate ( ( *fixture ).freelist , size , &offset )
+          || !freelist_free ( ( *fixture ).freelist , size , offset )
+           )
+        {
+            return false;
+        }
+    }
+    BENCH_DO_NOT_OPTIMIZE ( offset );
+    return true;
+}
+
+void
+bench_register_freelist
+( void )
+{
+    _bench_register ( bench_freelist_allocate , bench_freelist_setup , bench_freelist_teardown , &bench_freelist_args[ 0 ] , "freelist_allocate + freelist_free: first-fit, 16 holes." );
+    _bench_register ( bench_freelist_allocate , bench_freelist_setup , bench_freelist_teardown , &bench_freelist_args[ 1 ] , "freelist_allocate + freelist_free: first-fit, 1024 holes." );
+    _bench_register ( bench_freelist_allocate , bench_freelist_setup , bench_freelist_teardown , &bench_freelist_args[ 2 ] , "freelist_allocate + freelist_free: first-fit, 16384 holes." );
+    _bench_register ( bench_freelist_allocate , bench_freelist_setup , bench_freelist_teardown , &bench_freelist_args[ 3 ] , "freelist_allocate + freelist_free: segregated-fit, 16 holes." );
+    _bench_register ( bench_freelist_allocate , bench_freelist_setup , bench_freelist_teardown , &bench_freelist_args[ 4 ] , "freelist_allocate + freelist_free: segregated-fit, 1024 holes." );
+    _bench_register ( bench_freelist_allocate , bench_freelist_setup , bench_freelist_teardown , &bench_freelist_args[ 5 ] , "freelist_allocate + freelist_free: segregated-fit, 16384 holes." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_freelist.h
+ * @brief Benchmarks container/freelist.h
+ * (see test/bench.h, container/freelist.h for additional details)
+ */
+#ifndef BENCH_FREELIST_H
+#define BENCH_FREELIST_H
+
+#include "test/bench.h"
+
+#include "container/freelist.h"
+
+void
+bench_register_freelist
+( void );
+
+#endif  // BENCH_FREELIST_H
@@ -0,0 +1,175 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_hashtable.c
+ * @brief Implementation of the container/bench_hashtable header.
+ * (see container/bench_hashtable.h for additional details)
+ */
+#include "container/bench_hashtable.h"
+
+#include "core/memory.h"
+
+/**
+ * @brief Type definition for the fixture of a hashtable benchmark. Keys are
+ * the 8-byte indices [ 0 , length ).
+ */
+typedef struct
+{
+    u64             length;
+    bool            fill;       // Set every key during setup?
+    hashtable_t*    hashtable;
+    u64*            keys;       // The keys as an array (batch benchmarks only).
+    u64*            values;     // Output buffer (batch benchmarks only).
+}
+bench_hashtable_t;
+
+/** @brief Fixtures for bench_hashtable_set. */
+static bench_hashtable_t bench_hashtable_set_args[] = { { 16 , false , 0 , 0 , 0 } , { 1024 , false , 0 , 0 , 0 } , { 65536 , false , 0 , 0 , 0 } };
+
+/** @brief Fixtures for bench_hashtable_get. */
+static bench_hashtable_t bench_hashtable_get_args[] = { { 16 , true , 0 , 0 , 0 } , { 1024 , true , 0 , 0 , 0 } , { 65536 , true , 0 , 0 , 0 } , { 1048576 , true , 0 , 0 , 0 } };
+
+/** @brief Fixtures for bench_hashtable_get_batch. */
+static bench_hashtable_t bench_hashtable_get_batch_args[] = { { 1024 , true , 0 , 0 , 0 } , { 65536 , true , 0 , 0 , 0 } , { 1048576 , true , 0 , 0 , 0 } };
+
+bool
+bench_hashtable_setup
+(   void* args
+)
+{
+    bench_hashtable_t* fixture = args;
+    if ( !hashtable_create ( false
+                           , sizeof ( u64 )
+                           , ( *fixture ).length
+                           , 0
+                           , 0
+                           , &( *fixture ).hashtable
+                           ))
+    {
+        return false;
+    }
+    for ( u64 i = 0; ( *fixture ).fill && i < ( *fixture ).length; ++i )
+    {
+        _hashtable_set ( ( *fixture ).hashtable , &i , sizeof ( u64 ) , &i );
+    }
+    return true;
+}
+
+void
+bench_hashtable_teardown
+(   void* args
+)
+{
+    hashtable_destroy ( &( *( ( bench_hashtable_t* ) args ) ).hashtable );
+}
+
+bool
+bench_hashtable_batch_setup
+(   void* args
+)
+{
+    bench_hashtable_t* fixture = args;
+    if ( !bench_hashtable_setup ( fixture ) )
+    {
+        return false;
+    }
+    ( *fixture ).keys = memory_allocate ( sizeof ( u64 ) * ( *fixture ).length , MEMORY_TAG_ARRAY );
+    ( *fixture ).values = memory_allocate ( sizeof ( u64 ) * ( *fixture ).length , MEMORY_TAG_ARRAY );
+    for ( u64 i = 0; i < ( *fixture ).length; ++i )
+    {
+        ( *fixture ).keys[ i ] = i;
+    }
+    return true;
+}
+
+void
+bench_hashtable_batch_teardown
+(   void* args
+)
+{
+    bench_hashtable_t* fixture = args;
+    memory_free ( ( *fixture ).keys , sizeof ( u64 ) * ( *fixture ).length , MEMORY_TAG_ARRAY );
+    memory_free ( ( *fixture ).values , sizeof ( u64 ) * ( *fixture ).length , MEMORY_TAG_ARRAY );
+    bench_hashtable_teardown ( fixture );
+}
+
+bool
+bench_hashtable_set
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_hashtable_t* fixture = args;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        for ( u64 j = 0; j < ( *fixture ).length; ++j )
+        {
+            if ( !_hashtable_set ( ( *fixture ).hashtable , &j , sizeof ( u64 ) , &i ) )
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool
+bench_hashtable_get
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_hashtable_t* fixture = args;
+    u64 value = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        for ( u64 j = 0; j < ( *fixture ).length; ++j )
+        {
+            if ( !_hashtable_get ( ( *fixture ).hashtable , &j , sizeof ( u64 ) , &value ) )
+            {
+                return false;
+            }
+        }
+        BENCH_DO_NOT_OPTIMIZE ( value );
+    }
+    return true;
+}
+
+bool
+bench_hashtable_get_batch
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_hashtable_t* fixture = args;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        if ( hashtable_get_batch ( ( *fixture ).hashtable
+                                 , ( *fixture ).keys
+                                 , sizeof ( u64 )
+                                 , ( *fixture ).length
+                                 , ( *fixture ).values
+                                 , 0
+                                 ) != ( *fixture ).length )
+        {
+            return false;
+        }
+        BENCH_DO_NOT_OPTIMIZE ( ( *fixture ).values[ 0 ] );
+    }
+    return true;
+}
+
+void
+bench_register_hashtable
+( void )
+{
+    _bench_register ( bench_hashtable_set , bench_hashtable_setup , bench_hashtable_teardown , &bench_hashtable_set_args[ 0 ] , "hashtable_set: 16 keys." );
+    _bench_register ( bench_hashtable_set , bench_hashtable_setup , bench_hashtable_teardown , &bench_hashtable_set_args[ 1 ] , "hashtable_set: 1024 keys." );
+    _bench_register ( bench_hashtable_set , bench_hashtable_setup , bench_hashtable_teardown , &bench_hashtable_set_args[ 2 ] , "hashtable_set: 65536 keys." );
+    _bench_register ( bench_hashtable_get , bench_hashtable_setup , bench_hashtable_teardown , &bench_hashtable_get_args[ 0 ] , "hashtable_get: 16 keys." );
+    _bench_register ( bench_hashtable_get , bench_hashtable_setup , bench_hashtable_teardown , &bench_hashtable_get_args[ 1 ] , "hashtable_get: 1024 keys." );
+    _bench_register ( bench_hashtable_get , bench_hashtable_setup , bench_hashtable_teardown , &bench_hashtable_get_args[ 2 ] , "hashtable_get: 65536 keys." );
+    _bench_register ( bench_hashtable_get , bench_hashtable_setup , bench_hashtable_teardown , &bench_hashtable_get_args[ 3 ] , "hashtable_get: 1048576 keys." );
+    _bench_register ( bench_hashtable_get_batch , bench_hashtable_batch_setup , bench_hashtable_batch_teardown , &bench_hashtable_get_batch_args[ 0 ] , "hashtable_get_batch: 1024 keys." );
+    _bench_register ( bench_hashtable_get_batch , bench_hashtable_batch_setup , bench_hashtable_batch_teardown , &bench_hashtable_get_batch_args[ 1 ] , "hashtable_get_batch: 65536 keys." );
+    _bench_register ( bench_hashtable_get_batch , bench_hashtable_batch_setup , bench_hashtable_batch_teardown , &bench_hashtable_get_batch_args[ 2 ] , "hashtable_get_batch: 1048576 keys." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_hashtable.h
+ * @brief Benchmarks container/hashtable.h
+ * (see test/bench.h, container/hashtable.h for additional details)
+ */
+#ifndef BENCH_HASHTABLE_H
+#define BENCH_HASHTABLE_H
+
+#include "test/bench.h"
+
+#include "container/hashtable.h"
+
+void
+bench_register_hashtable
+( void );
+
+#endif  // BENCH_HASHTABLE_H
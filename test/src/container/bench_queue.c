@@ -0,0 +1,126 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_queue.c
+ * @brief Implementation of the container/bench_queue header.
+ * (see container/bench_queue.h for additional details)
+ */
+#include "container/bench_queue.h"
+
+QUEUE_DEFINE ( u64 )
+
+/** @brief Capacity of the queue shared by the threads of bench_mpmc_queue. */
+#define BENCH_MPMC_QUEUE_CAPACITY 1024
+
+/** @brief Numbers of elements pushed and popped per iteration by bench_queue_push_and_pop. */
+static u64 bench_queue_lengths[] = { 16 , 1024 , 65536 };
+
+/** @brief Thread counts benchmarked by bench_mpmc_queue. */
+static u32 bench_mpmc_queue_thread_counts[] = { 1 , 2 , 4 , 8 };
+
+bool
+bench_queue_push_and_pop
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 length = *( ( u64* ) args );
+    queue_t* queue = queue_create ( u64 );
+    u64 value = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        for ( u64 j = 0; j < length; ++j )
+        {
+            queue_push ( queue , &j );
+        }
+        for ( u64 j = 0; j < length; ++j )
+        {
+            queue_pop ( queue , &value );
+        }
+        BENCH_DO_NOT_OPTIMIZE ( value );
+    }
+    queue_destroy ( queue );
+    return true;
+}
+
+bool
+bench_queue_push_and_pop_typed
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 length = *( ( u64* ) args );
+    u64* queue = queue_u64_create ();
+    u64 value = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        for ( u64 j = 0; j < length; ++j )
+        {
+            queue = queue_u64_push ( queue , j );
+        }
+        for ( u64 j = 0; j < length; ++j )
+        {
+            queue_u64_pop ( queue , &value );
+        }
+        BENCH_DO_NOT_OPTIMIZE ( value );
+    }
+    queue_destroy ( queue );
+    return true;
+}
+
+/**
+ * @brief Thread function for bench_mpmc_queue: pushes an element, then pops
+ * one, each iteration. At least one element is queued whenever a thread pops,
+ * so neither operation waits for long.
+ */
+bool
+bench_mpmc_queue_push_and_pop
+(   void*   args
+,   u64     iterations
+)
+{
+    mpmc_queue_t* queue = args;
+    u64 value = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        while ( !mpmc_queue_push ( queue , &i ) );
+        while ( !mpmc_queue_pop ( queue , &value ) );
+    }
+    BENCH_DO_NOT_OPTIMIZE ( value );
+    return true;
+}
+
+bool
+bench_mpmc_queue
+(   void*   args
+,   u64     iterations
+)
+{
+    mpmc_queue_t* queue;
+    if ( !mpmc_queue_create ( sizeof ( u64 ) , BENCH_MPMC_QUEUE_CAPACITY , 0 , 0 , &queue ) )
+    {
+        return false;
+    }
+    const bool success = bench_run_threads ( bench_mpmc_queue_push_and_pop
+                                           , queue
+                                           , iterations
+                                           , *( ( u32* ) args )
+                                           );
+    mpmc_queue_destroy ( &queue );
+    return success;
+}
+
+void
+bench_register_queue
+( void )
+{
+    bench_register ( bench_queue_push_and_pop , &bench_queue_lengths[ 0 ] , "queue_push + queue_pop: 16 elements." );
+    bench_register ( bench_queue_push_and_pop , &bench_queue_lengths[ 1 ] , "queue_push + queue_pop: 1024 elements." );
+    bench_register ( bench_queue_push_and_pop , &bench_queue_lengths[ 2 ] , "queue_push + queue_pop: 65536 elements." );
+    bench_register ( bench_queue_push_and_pop_typed , &bench_queue_lengths[ 0 ] , "queue_u64_push + queue_u64_pop (QUEUE_DEFINE): 16 elements." );
+    bench_register ( bench_queue_push_and_pop_typed , &bench_queue_lengths[ 1 ] , "queue_u64_push + queue_u64_pop (QUEUE_DEFINE): 1024 elements." );
+    bench_register ( bench_queue_push_and_pop_typed , &bench_queue_lengths[ 2 ] , "queue_u64_push + queue_u64_pop (QUEUE_DEFINE): 65536 elements." );
+    bench_register ( bench_mpmc_queue , &bench_mpmc_queue_thread_counts[ 0 ] , "mpmc_queue_push + mpmc_queue_pop: 1 thread." );
+    bench_register ( bench_mpmc_queue , &bench_mpmc_queue_thread_counts[ 1 ] , "mpmc_queue_push + mpmc_queue_pop: 2 threads." );
+    bench_register ( bench_mpmc_queue , &bench_mpmc_queue_thread_counts[ 2 ] , "mpmc_queue_push + mpmc_queue_pop: 4 threads." );
+    bench_register ( bench_mpmc_queue , &bench_mpmc_queue_thread_counts[ 3 ] , "mpmc_queue_push + mpmc_queue_pop: 8 threads." );
+}
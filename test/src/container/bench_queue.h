@@ -0,0 +1,20 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_queue.h
+ * @brief Benchmarks container/queue.h and container/mpmc_queue.h
+ * (see test/bench.h, container/queue.h, container/mpmc_queue.h for additional
+ * details)
+ */
+#ifndef BENCH_QUEUE_H
+#define BENCH_QUEUE_H
+
+#include "test/bench.h"
+
+#include "container/mpmc_queue.h"
+#include "container/queue.h"
+
+void
+bench_register_queue
+( void );
+
+#endif  // BENCH_QUEUE_H
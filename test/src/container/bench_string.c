@@ -0,0 +1,186 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_string.c
+ * @brief Implementation of the container/bench_string header.
+ * (see container/bench_string.h for additional details)
+ */
+#include "container/bench_string.h"
+
+#include "math/prng.h"
+
+/** @brief Substring inserted every BENCH_STRING_NEEDLE_SPACING characters by bench_string_setup. */
+#define BENCH_STRING_NEEDLE "needle"
+
+/** @brief Distance between the substrings inserted by bench_string_setup. */
+#define BENCH_STRING_NEEDLE_SPACING 64
+
+/**
+ * @brief Type definition for the fixture of a string benchmark. The string is
+ * random lowercase text of the given length, containing BENCH_STRING_NEEDLE
+ * every BENCH_STRING_NEEDLE_SPACING characters.
+ */
+typedef struct
+{
+    u64     length;
+    char*   string;
+    char*   work;   // Scratch string for mutating benchmarks.
+}
+bench_string_t;
+
+/** @brief Fixtures for bench_string_format. */
+static bench_string_t bench_string_format_args[] = { { 16 , 0 , 0 } , { 1024 , 0 , 0 } , { 65536 , 0 , 0 } };
+
+/** @brief Fixtures for bench_string_contains and bench_string_replace. */
+static bench_string_t bench_string_search_args[] = { { 1024 , 0 , 0 } , { 65536 , 0 , 0 } , { MiB ( 1 ) , 0 , 0 } };
+
+bool
+bench_string_setup
+(   void* args
+)
+{
+    bench_string_t* fixture = args;
+    const u64 needle_length = sizeof ( BENCH_STRING_NEEDLE ) - 1;
+    prng_t prng;
+    prng_seed ( &prng , ( *fixture ).length );
+    ( *fixture ).string = _string_create ( ( *fixture ).length + 1 );
+    ( *fixture ).work = _string_create ( ( *fixture ).length + 1 );
+    for ( u64 i = 0; i < ( *fixture ).length; ++i )
+    {
+        const u64 offset = i % BENCH_STRING_NEEDLE_SPACING;
+        char character;
+        if ( offset < needle_length && i + needle_length - offset <= ( *fixture ).length )
+        {
+            character = BENCH_STRING_NEEDLE[ offset ];
+        }
+        else
+        {
+            // Exclude 'n', so that the only matches are those placed above.
+            character = 'o' + prng_bounded ( &prng , 12 );
+        }
+        string_push ( ( *fixture ).string , &character , 1 );
+    }
+    return true;
+}
+
+void
+bench_string_teardown
+(   void* args
+)
+{
+    bench_string_t* fixture = args;
+    string_destroy ( ( *fixture ).string );
+    string_destroy ( ( *fixture ).work );
+}
+
+bool
+bench_string_format
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_string_t* fixture = args;
+    const f64 value = 3.14159;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        char* string = string_format ( "%u: %.3f [%s]" , i , &value , ( *fixture ).string );
+        BENCH_DO_NOT_OPTIMIZE ( string );
+        string_destroy ( string );
+    }
+    return true;
+}
+
+bool
+bench_string_contains
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_string_t* fixture = args;
+    u64 index = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        // Absent: scans the whole string, through every partial match.
+        if ( _string_contains ( ( *fixture ).string , "needle!" , false , &index ) )
+        {
+            return false;
+        }
+        BENCH_DO_NOT_OPTIMIZE ( index );
+    }
+    return true;
+}
+
+bool
+bench_string_replace
+(   void*   args
+,   u64     iterations
+)
+{
+    bench_string_t* fixture = args;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        string_clear ( ( *fixture ).work );
+        string_push ( ( *fixture ).work , ( *fixture ).string , ( *fixture ).length );
+        _string_replace ( ( *fixture ).work , BENCH_STRING_NEEDLE , "pin" );
+        BENCH_DO_NOT_OPTIMIZE ( ( *fixture ).work );
+    }
+    return true;
+}
+
+bool
+bench_string_hex
+(   void*   args
+,   u64     iterations
+)
+{
+    bench_string_t* fixture = args;
+    u64 size = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        string_clear ( ( *fixture ).work );
+        string_push_hex ( ( *fixture ).work , ( *fixture ).string , ( *fixture ).length , false );
+        if ( string_hex_decode ( ( *fixture ).work , string_length ( ( *fixture ).work ) , ( *fixture ).work , &size ) )
+        {
+            return false;
+        }
+        BENCH_DO_NOT_OPTIMIZE ( size );
+    }
+    return true;
+}
+
+bool
+bench_string_base64
+(   void*   args
+,   u64     iterations
+)
+{
+    bench_string_t* fixture = args;
+    u64 size = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        string_clear ( ( *fixture ).work );
+        string_push_base64 ( ( *fixture ).work , ( *fixture ).string , ( *fixture ).length );
+        if ( string_base64_decode ( ( *fixture ).work , string_length ( ( *fixture ).work ) , ( *fixture ).work , &size ) )
+        {
+            return false;
+        }
+        BENCH_DO_NOT_OPTIMIZE ( size );
+    }
+    return true;
+}
+
+void
+bench_register_string
+( void )
+{
+    _bench_register ( bench_string_format , bench_string_setup , bench_string_teardown , &bench_string_format_args[ 0 ] , "string_format: integer, float, and 16-character string arguments." );
+    _bench_register ( bench_string_format , bench_string_setup , bench_string_teardown , &bench_string_format_args[ 1 ] , "string_format: integer, float, and 1024-character string arguments." );
+    _bench_register ( bench_string_format , bench_string_setup , bench_string_teardown , &bench_string_format_args[ 2 ] , "string_format: integer, float, and 65536-character string arguments." );
+    _bench_register ( bench_string_contains , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 0 ] , "string_contains: 1 KiB string, absent substring." );
+    _bench_register ( bench_string_contains , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 1 ] , "string_contains: 64 KiB string, absent substring." );
+    _bench_register ( bench_string_contains , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 2 ] , "string_contains: 1 MiB string, absent substring." );
+    _bench_register ( bench_string_replace , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 0 ] , "string_replace: 1 KiB string, a match every 64 characters (including copy)." );
+    _bench_register ( bench_string_replace , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 1 ] , "string_replace: 64 KiB string, a match every 64 characters (including copy)." );
+    _bench_register ( bench_string_replace , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 2 ] , "string_replace: 1 MiB string, a match every 64 characters (including copy)." );
+    _bench_register ( bench_string_hex , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 2 ] , "string_push_hex, then string_hex_decode (in-place): 1 MiB." );
+    _bench_register ( bench_string_base64 , bench_string_setup , bench_string_teardown , &bench_string_search_args[ 2 ] , "string_push_base64, then string_base64_decode (in-place): 1 MiB." );
+}
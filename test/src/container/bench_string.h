@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/bench_string.h
+ * @brief Benchmarks container/string.h
+ * (see test/bench.h, container/string.h for additional details)
+ */
+#ifndef BENCH_STRING_H
+#define BENCH_STRING_H
+
+#include "test/bench.h"
+
+#include "container/string.h"
+
+void
+bench_register_string
+( void );
+
+#endif  // BENCH_STRING_H
@@ -8,8 +8,12 @@
 
 #include "test/expect.h"
 
+#include "core/image.h"
+#include "core/logger.h"
 #include "core/memory.h"
 
+ARRAY_DEFINE ( u64 )
+
 /**
  * @brief Comparator function used by test_array_sort.
  * 
@@ -277,11 +281,10 @@ test_array_resize
     array_amount_allocated_ = memory_amount_allocated ( MEMORY_TAG_ARRAY );
     global_allocation_count_ = MEMORY_ALLOCATION_COUNT;
 
-    array_ = array;
     array = _array_resize ( array , array_capacity ( array_copy ) * 2 );
 
-    // TEST 2.1: array_resize returns a new array.
-    EXPECT_NEQ ( array_ , array );
+    // TEST 2.1: array_resize returns a valid array (which may be resized in place; see memory_reallocate).
+    EXPECT_NEQ ( 0 , array );
 
     // TEST 2.2: array_resize resized the array to the correct capacity.
     EXPECT_EQ ( array_capacity ( array_copy ) * 2 , array_capacity ( array ) );
@@ -313,11 +316,10 @@ test_array_resize
     array_amount_allocated_ = memory_amount_allocated ( MEMORY_TAG_ARRAY );
     global_allocation_count_ = MEMORY_ALLOCATION_COUNT;
 
-    array_ = array;
     array = _array_resize ( array , array_out_length );
 
-    // TEST 3.1: array_resize returns a new array.
-    EXPECT_NEQ ( array_ , array );
+    // TEST 3.1: array_resize returns a valid array (which may be resized in place; see memory_reallocate).
+    EXPECT_NEQ ( 0 , array );
 
     // TEST 3.2: array_resize resized the array to the correct capacity.
     EXPECT_EQ ( array_out_length , array_capacity ( array ) );
@@ -799,6 +801,277 @@ test_array_insert_and_remove_random
     return true;
 }
 
+/**
+ * @brief Predicate function used by test_array_remove_swap_and_remove_if.
+ *
+ * @param element The address of a 32-bit integer.
+ * @param args The address of a 32-bit integer divisor.
+ * @return true if the element is a multiple of the divisor; false otherwise.
+ */
+bool
+test_array_remove_if_predicate
+(   const void* element
+,   void*       args
+)
+{
+    return !( *( ( i32* ) element ) % *( ( i32* ) args ) );
+}
+
+u8
+test_array_remove_swap_and_remove_if
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 max_op = 1000;
+    i32* array = array_create_new ( i32 );
+    i32* array_;
+    i32 removed;
+    i32 divisor;
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , array );
+
+    for ( u64 i = 0; i < max_op; ++i )
+    {
+        array_push ( array , ( i32 ) i );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: array_remove_swap.
+
+    // TEST 1.1: array_remove_swap copies the removed element into the output buffer.
+    array_ = array;
+    removed = -1;
+    array_remove_swap ( array , 10 , &removed );
+    EXPECT_EQ ( array_ , array );
+    EXPECT_EQ ( 10 , removed );
+
+    // TEST 1.2: array_remove_swap moves the last element into the hole, and leaves the rest in place.
+    EXPECT_EQ ( max_op - 1 , array_length ( array ) );
+    EXPECT_EQ ( ( i32 )( max_op - 1 ) , array[ 10 ] );
+    EXPECT_EQ ( 9 , array[ 9 ] );
+    EXPECT_EQ ( 11 , array[ 11 ] );
+    EXPECT_EQ ( ( i32 )( max_op - 2 ) , array[ max_op - 2 ] );
+
+    // TEST 1.3: array_remove_swap on the last element, without an output buffer.
+    array_remove_swap ( array , max_op - 2 , 0 );
+    EXPECT_EQ ( max_op - 2 , array_length ( array ) );
+    EXPECT_EQ ( ( i32 )( max_op - 3 ) , array[ max_op - 3 ] );
+
+    // TEST 1.4: array_remove_swap fails on an out of bounds index.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    array_remove_swap ( array , max_op - 2 , 0 );
+    EXPECT_EQ ( max_op - 2 , array_length ( array ) );
+
+    // TEST 2: array_remove_if.
+
+    // Restore the array to 0 .. max_op - 1.
+    array_remove_range ( array , 0 , array_length ( array ) , 0 );
+    for ( u64 i = 0; i < max_op; ++i )
+    {
+        array_push ( array , ( i32 ) i );
+    }
+
+    // TEST 2.1: array_remove_if removes every matching element, preserving the order of the rest.
+    divisor = 3;
+    EXPECT_EQ ( ( max_op + 2 ) / 3 , array_remove_if ( array , test_array_remove_if_predicate , &divisor ) );
+    EXPECT_EQ ( max_op - ( max_op + 2 ) / 3 , array_length ( array ) );
+    for ( u64 i = 0; i < array_length ( array ); ++i )
+    {
+        EXPECT_EQ ( ( i32 )( i + i / 2 + 1 ) , array[ i ] );
+    }
+
+    // TEST 2.2: array_remove_if removes nothing if no element matches.
+    const u64 length = array_length ( array );
+    EXPECT_EQ ( 0 , array_remove_if ( array , test_array_remove_if_predicate , &divisor ) );
+    EXPECT_EQ ( length , array_length ( array ) );
+
+    // TEST 2.3: array_remove_if can remove every element.
+    divisor = 1;
+    EXPECT_EQ ( length , array_remove_if ( array , test_array_remove_if_predicate , &divisor ) );
+    EXPECT_EQ ( 0 , array_length ( array ) );
+
+    // TEST 2.4: array_remove_if does nothing on an empty array.
+    EXPECT_EQ ( 0 , array_remove_if ( array , test_array_remove_if_predicate , &divisor ) );
+
+    // TEST 2.5: array_remove_if fails if no predicate is provided.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , array_remove_if ( array , 0 , 0 ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    array_destroy ( array );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_array_batch
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 max_op = 1000;
+    i32* array = array_create_new ( i32 );
+    i32* src = memory_allocate ( sizeof ( i32 ) * max_op , MEMORY_TAG_ARRAY );
+    i32 removed[ 10 ];
+    i32* array_;
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , array );
+    EXPECT_NEQ ( 0 , src );
+
+    for ( u64 i = 0; i < max_op; ++i )
+    {
+        src[ i ] = ( i32 ) i;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: array_reserve.
+
+    // TEST 1.1: array_reserve grows the array to exactly the requested capacity.
+    array = array_reserve ( array , max_op );
+    EXPECT_EQ ( max_op , array_capacity ( array ) );
+    EXPECT_EQ ( 0 , array_length ( array ) );
+
+    // TEST 1.2: array_reserve does not shrink the array.
+    array_ = array;
+    array = array_reserve ( array , 1 );
+    EXPECT_EQ ( array_ , array );
+    EXPECT_EQ ( max_op , array_capacity ( array ) );
+
+    // TEST 2: array_push_n.
+
+    // TEST 2.1: array_push_n into reserved capacity does not move the array.
+    array_ = array;
+    array_push_n ( array , src , max_op );
+    EXPECT_EQ ( array_ , array );
+    EXPECT_EQ ( max_op , array_length ( array ) );
+    EXPECT_EQ ( max_op , array_capacity ( array ) );
+
+    // TEST 2.2: array_push_n appends the elements in order.
+    EXPECT ( memory_equal ( array , src , sizeof ( i32 ) * max_op ) );
+
+    // TEST 2.3: array_push_n with no elements does nothing.
+    array_push_n ( array , 0 , 0 );
+    EXPECT_EQ ( max_op , array_length ( array ) );
+
+    // TEST 2.4: array_push_n grows the array once, beyond capacity.
+    array_push_n ( array , src , 1 );
+    EXPECT_EQ ( max_op + 1 , array_length ( array ) );
+    EXPECT_EQ ( ARRAY_SCALE_FACTOR ( max_op + 1 ) , array_capacity ( array ) );
+    EXPECT_EQ ( 0 , array[ max_op ] );
+
+    // TEST 3: array_remove_range.
+
+    // TEST 3.1: array_remove_range copies the removed elements into the output buffer.
+    array_ = array;
+    array_remove_range ( array , 10 , 10 , removed );
+    EXPECT_EQ ( array_ , array );
+    EXPECT ( memory_equal ( removed , &src[ 10 ] , sizeof ( removed ) ) );
+
+    // TEST 3.2: array_remove_range shifts the remaining elements down.
+    EXPECT_EQ ( max_op - 9 , array_length ( array ) );
+    EXPECT ( memory_equal ( array , src , sizeof ( i32 ) * 10 ) );
+    EXPECT ( memory_equal ( &array[ 10 ] , &src[ 20 ] , sizeof ( i32 ) * ( max_op - 20 ) ) );
+    EXPECT_EQ ( 0 , array[ max_op - 10 ] );
+
+    // TEST 3.3: array_remove_range can remove the tail of the array without an output buffer.
+    array_remove_range ( array , max_op - 10 , 1 , 0 );
+    EXPECT_EQ ( max_op - 10 , array_length ( array ) );
+
+    // TEST 3.4: array_remove_range fails on a range beyond the end of the array.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    array_remove_range ( array , max_op - 20 , 11 , 0 );
+    EXPECT_EQ ( max_op - 10 , array_length ( array ) );
+
+    // TEST 4: array_insert_n.
+
+    // TEST 4.1: array_insert_n restores the removed range.
+    array_insert_n ( array , 10 , removed , 10 );
+    EXPECT_EQ ( max_op , array_length ( array ) );
+    EXPECT ( memory_equal ( array , src , sizeof ( i32 ) * max_op ) );
+
+    // TEST 4.2: array_insert_n at the start of the array.
+    array_insert_n ( array , 0 , src , 5 );
+    EXPECT_EQ ( max_op + 5 , array_length ( array ) );
+    EXPECT ( memory_equal ( array , src , sizeof ( i32 ) * 5 ) );
+    EXPECT ( memory_equal ( &array[ 5 ] , src , sizeof ( i32 ) * max_op ) );
+
+    // TEST 4.3: array_insert_n at the end of the array.
+    array_insert_n ( array , max_op + 5 , src , 5 );
+    EXPECT_EQ ( max_op + 10 , array_length ( array ) );
+    EXPECT ( memory_equal ( &array[ max_op + 5 ] , src , sizeof ( i32 ) * 5 ) );
+
+    // TEST 4.4: array_insert_n fails on an out of bounds index.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    array_insert_n ( array , max_op + 11 , src , 5 );
+    EXPECT_EQ ( max_op + 10 , array_length ( array ) );
+
+    // TEST 5: array_extend_from.
+
+    array_remove_range ( array , 0 , max_op + 10 , 0 );
+    EXPECT_EQ ( 0 , array_length ( array ) );
+    i32* other = array_create_from ( i32 , src , max_op );
+
+    // TEST 5.1: array_extend_from appends the contents of another array.
+    array_extend_from ( array , other );
+    EXPECT_EQ ( max_op , array_length ( array ) );
+    EXPECT ( memory_equal ( array , src , sizeof ( i32 ) * max_op ) );
+
+    // TEST 5.2: array_extend_from can append an array to itself.
+    array_extend_from ( other , other );
+    EXPECT_EQ ( 2 * max_op , array_length ( other ) );
+    EXPECT ( memory_equal ( other , src , sizeof ( i32 ) * max_op ) );
+    EXPECT ( memory_equal ( &other[ max_op ] , src , sizeof ( i32 ) * max_op ) );
+
+    // TEST 5.3: array_extend_from fails on arrays of different stride.
+    u8* bytes = array_create_new ( u8 );
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    array_extend_from ( array , bytes );
+    EXPECT_EQ ( max_op , array_length ( array ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    memory_free ( src , sizeof ( i32 ) * max_op , MEMORY_TAG_ARRAY );
+    array_destroy ( array );
+    array_destroy ( other );
+    array_destroy ( bytes );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 u8
 test_array_reverse
 ( void )
@@ -832,6 +1105,107 @@ test_array_reverse
     array_reverse ( array , array_length , array_stride , 0 );
     EXPECT ( memory_equal ( array , array_in , sizeof ( array_in ) ) );
 
+    // TEST 4: array_reverse correctly reverses arrays of every specialized element size, and of a generic element size, for lengths either side of a block boundary.
+    u8 bytes_in[ 24 * 67 ];
+    u8 bytes_out[ 24 * 67 ];
+    for ( u64 i = 0; i < sizeof ( bytes_in ); ++i )
+    {
+        bytes_in[ i ] = i;
+    }
+    const u64 strides[] = { 1 , 2 , 4 , 8 , 12 , 16 , 24 };
+    for ( u64 i = 0; i < sizeof ( strides ) / sizeof ( strides[ 0 ] ); ++i )
+    {
+        for ( u64 length = 2; length <= 67; ++length )
+        {
+            memory_copy ( bytes_out , bytes_in , length * strides[ i ] );
+            array_reverse ( bytes_out , length , strides[ i ] , 0 );
+            for ( u64 j = 0; j < length; ++j )
+            {
+                EXPECT ( memory_equal ( bytes_out + j * strides[ i ]
+                                      , bytes_in + ( length - 1 - j ) * strides[ i ]
+                                      , strides[ i ]
+                                      ));
+            }
+        }
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_array_shuffle
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u8 bytes[ 24 * 100 ];
+    u64 counts[ 100 ];
+    const u64 strides[] = { 1 , 2 , 4 , 8 , 12 , 16 , 24 };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: array_shuffle does not fail on an empty or single-element array.
+    array_shuffle ( bytes , 0 , 1 , 0 );
+    array_shuffle ( bytes , 1 , 1 , 0 );
+
+    // TEST 2: array_shuffle produces a permutation of the input for every specialized element size, and for a generic element size.
+    for ( u64 i = 0; i < sizeof ( strides ) / sizeof ( strides[ 0 ] ); ++i )
+    {
+        const u64 stride = strides[ i ];
+        for ( u64 j = 0; j < 100; ++j )
+        {
+            memory_set ( bytes + j * stride , j , stride );
+        }
+        array_shuffle ( bytes , 100 , stride , 0 );
+        memory_clear ( counts , sizeof ( counts ) );
+        for ( u64 j = 0; j < 100; ++j )
+        {
+            const u8 value = bytes[ j * stride ];
+            EXPECT ( value < 100 );
+            for ( u64 k = 1; k < stride; ++k )
+            {
+                EXPECT_EQ ( value , bytes[ j * stride + k ] );
+            }
+            counts[ value ] += 1;
+        }
+        for ( u64 j = 0; j < 100; ++j )
+        {
+            EXPECT_EQ ( 1 , counts[ j ] );
+        }
+    }
+
+    // TEST 3: Each element of a shuffled array is equally likely to land in each position.
+    memory_clear ( counts , sizeof ( counts ) );
+    for ( u64 i = 0; i < 100000; ++i )
+    {
+        for ( u64 j = 0; j < 10; ++j )
+        {
+            bytes[ j ] = j;
+        }
+        array_shuffle ( bytes , 10 , 1 , 0 );
+        counts[ bytes[ 0 ] ] += 1;
+    }
+    for ( u64 j = 0; j < 10; ++j )
+    {
+        // Expected 10000 each; allow a generous margin (about 10 standard deviations).
+        EXPECT ( counts[ j ] > 9000 && counts[ j ] < 11000 );
+    }
+
+    // TEST 4: array_reverse and array_shuffle perform no memory allocation.
+    array_reverse ( bytes , 100 , 24 , 0 );
+    array_shuffle ( bytes , 100 , 24 , 0 );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
     // End test.
     ////////////////////////////////////////////////////////////////////////////
 
@@ -856,6 +1230,8 @@ test_array_sort
     const i32 array_empty[] = {};
     const i32 array_single_element[] = { 1 };
     const i32 array_all_elements_equal[] = { 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 , 99 };
+    const i32 array_short[] = { 3 , 1 , 2 };
+    const i32 array_short_sorted[] = { 1 , 2 , 3 };
     i32* array_sorted = memory_allocate ( length * stride , MEMORY_TAG_ARRAY );
     i32* array_unsorted = memory_allocate ( length * stride , MEMORY_TAG_ARRAY );
     i32* array_reverse_order = memory_allocate ( length * stride , MEMORY_TAG_ARRAY );
@@ -895,29 +1271,34 @@ test_array_sort
 
     // TEST 3: array_sort does not modify a single-element array.
     memory_copy ( array , array_single_element , sizeof ( array_single_element ) );
-    array_sort ( array , stride , 1 , test_array_sort_compare );
+    array_sort ( array , 1 , stride , test_array_sort_compare );
     EXPECT ( memory_equal ( array , array_single_element , sizeof ( array_single_element ) ) );
 
     // TEST 4: array_sort does not modify an array where every element is equal.
     memory_copy ( array , array_all_elements_equal , sizeof ( array_all_elements_equal ) );
-    array_sort ( array , stride , sizeof ( array_all_elements_equal ) / stride , test_array_sort_compare );
+    array_sort ( array , sizeof ( array_all_elements_equal ) / stride , stride , test_array_sort_compare );
     EXPECT ( memory_equal ( array , array_all_elements_equal , sizeof ( array_all_elements_equal ) ) );
 
     // TEST 5: array_sort does not modify an array that is already sorted.
     memory_copy ( array , array_sorted , stride * length );
-    array_sort ( array , stride , length , test_array_sort_compare );
+    array_sort ( array , length , stride , test_array_sort_compare );
     EXPECT ( memory_equal ( array , array_sorted , stride * length ) );
 
     // TEST 6: array_sort successfully sorts a random array.
     memory_copy ( array , array_unsorted , stride * length );
-    array_sort ( array , stride , length , test_array_sort_compare );
+    array_sort ( array , length , stride , test_array_sort_compare );
     EXPECT ( memory_equal ( array , array_sorted , stride * length ) );
 
     // TEST 7: array_sort successfully sorts an array which is in reverse order.
     memory_copy ( array , array_reverse_order , stride * length );
-    array_sort ( array , stride , length , test_array_sort_compare );
+    array_sort ( array , length , stride , test_array_sort_compare );
     EXPECT ( memory_equal ( array , array_sorted , stride * length ) );
 
+    // TEST 8: array_sort sorts an array with fewer elements than bytes per element.
+    memory_copy ( array , array_short , sizeof ( array_short ) );
+    array_sort ( array , sizeof ( array_short ) / stride , stride , test_array_sort_compare );
+    EXPECT ( memory_equal ( array , array_short_sorted , sizeof ( array_short_sorted ) ) );
+
     // End test.
     ////////////////////////////////////////////////////////////////////////////
 
@@ -934,6 +1315,173 @@ test_array_sort
     return true;
 }
 
+u8
+test_array_typed
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 length = 1000;
+    u64* array = array_u64_create ( 1 );
+    u64 value;
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , array );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A typed array has the same header as a generic array.
+    EXPECT_EQ ( sizeof ( u64 ) , array_stride ( array ) );
+    EXPECT_EQ ( 1 , array_u64_capacity ( array ) );
+    EXPECT_EQ ( 0 , array_u64_length ( array ) );
+
+    // TEST 2: array_u64_push appends elements, growing the array as needed (including from a capacity of 1).
+    for ( u64 i = 0; i < length; ++i )
+    {
+        array = array_u64_push ( array , i );
+        EXPECT_EQ ( i + 1 , array_u64_length ( array ) );
+        EXPECT_EQ ( array_length ( array ) , array_u64_length ( array ) );
+        EXPECT ( array_u64_capacity ( array ) >= array_u64_length ( array ) );
+    }
+    for ( u64 i = 0; i < length; ++i )
+    {
+        EXPECT_EQ ( i , array[ i ] );
+    }
+
+    // TEST 3: Typed and generic pushes may be mixed.
+    array_push ( array , length );
+    array = array_u64_push ( array , length + 1 );
+    EXPECT_EQ ( length + 2 , array_u64_length ( array ) );
+    EXPECT_EQ ( length , array[ length ] );
+    EXPECT_EQ ( length + 1 , array[ length + 1 ] );
+
+    // TEST 4: array_u64_pop removes the last element.
+    EXPECT ( array_u64_pop ( array , &value ) );
+    EXPECT_EQ ( length + 1 , value );
+    EXPECT ( array_u64_pop ( array , 0 ) );
+    EXPECT_EQ ( length , array_u64_length ( array ) );
+
+    // TEST 5: array_u64_remove_swap moves the last element into the removed element's place.
+    EXPECT ( array_u64_remove_swap ( array , 10 , &value ) );
+    EXPECT_EQ ( 10 , value );
+    EXPECT_EQ ( length - 1 , array[ 10 ] );
+    EXPECT_EQ ( length - 1 , array_u64_length ( array ) );
+    EXPECT ( array_u64_remove_swap ( array , array_u64_length ( array ) - 1 , 0 ) );
+    EXPECT_EQ ( length - 2 , array_u64_length ( array ) );
+
+    // TEST 6: array_u64_reserve grows to at least the requested capacity, and never shrinks the array.
+    array = array_u64_reserve ( array , 4 * length );
+    EXPECT_EQ ( 4 * length , array_u64_capacity ( array ) );
+    array = array_u64_reserve ( array , 1 );
+    EXPECT_EQ ( 4 * length , array_u64_capacity ( array ) );
+    EXPECT_EQ ( length - 2 , array_u64_length ( array ) );
+
+    // TEST 7: array_u64_clear empties the array without freeing it.
+    array_u64_clear ( array );
+    EXPECT_EQ ( 0 , array_u64_length ( array ) );
+    EXPECT_EQ ( 4 * length , array_u64_capacity ( array ) );
+
+    // TEST 8: array_u64_pop and array_u64_remove_swap log and fail on invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( array_u64_pop ( array , &value ) );
+    EXPECT_NOT ( array_u64_remove_swap ( array , 0 , &value ) );
+    array = array_u64_push ( array , 1 );
+    EXPECT_NOT ( array_u64_remove_swap ( array , 1 , &value ) );
+    EXPECT_EQ ( 1 , array_u64_length ( array ) );
+
+    array_destroy ( array );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_array_image
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u64* array = array_u64_create ( 1 );
+    u64 image_size;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        array = array_u64_push ( array , i * i );
+    }
+
+    // TEST 1: array_to_image reports the image size, then writes the image.
+    EXPECT ( array_to_image ( array , &image_size , 0 ) );
+    EXPECT_EQ ( IMAGE_HEADER_SIZE + ARRAY_FIELD_COUNT * sizeof ( u64 ) + 1000 * sizeof ( u64 ) , image_size );
+    u8* image = memory_allocate_aligned ( image_size , 8 , MEMORY_TAG_APPLICATION );
+    EXPECT ( array_to_image ( array , &image_size , image ) );
+
+    // TEST 2: An array created from an image is a view into the image, and holds every element.
+    const u64 amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    const u64* loaded = array_create_from_image ( u64 , image , image_size , true );
+    EXPECT_NEQ ( 0 , loaded );
+    EXPECT ( ( const u8* ) loaded > image && ( const u8* ) loaded < image + image_size );
+    EXPECT_EQ ( amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( 1000 , array_length ( loaded ) );
+    EXPECT_EQ ( sizeof ( u64 ) , array_stride ( loaded ) );
+    EXPECT ( memory_equal ( loaded , array , 1000 * sizeof ( u64 ) ) );
+
+    // TEST 3: An image is rejected if its stride differs, or it is damaged, truncated or misaligned.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , array_create_from_image ( u32 , image , image_size , false ) );
+    EXPECT_EQ ( 0 , array_create_from_image ( u64 , image , image_size - 1 , false ) );
+    EXPECT_EQ ( 0 , array_create_from_image ( u64 , image + 4 , image_size - 4 , false ) );
+    image[ image_size - 1 ] ^= 1;
+    EXPECT_EQ ( 0 , array_create_from_image ( u64 , image , image_size , true ) );
+    memory_free_aligned ( image , image_size , 8 , MEMORY_TAG_APPLICATION );
+
+    // TEST 4: Images of empty arrays.
+    array_u64_clear ( array );
+    EXPECT ( array_to_image ( array , &image_size , 0 ) );
+    image = memory_allocate_aligned ( image_size , 8 , MEMORY_TAG_APPLICATION );
+    EXPECT ( array_to_image ( array , &image_size , image ) );
+    loaded = array_create_from_image ( u64 , image , image_size , true );
+    EXPECT_NEQ ( 0 , loaded );
+    EXPECT_EQ ( 0 , array_length ( loaded ) );
+    memory_free_aligned ( image , image_size , 8 , MEMORY_TAG_APPLICATION );
+
+    array_destroy ( array );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 void
 test_register_array
 ( void )
@@ -943,6 +1491,11 @@ test_register_array
     test_register ( test_array_push_and_pop , "Testing array 'push' and 'pop' operations." );
     test_register ( test_array_insert_and_remove , "Testing array 'insert' and 'remove' operations." );
     test_register ( test_array_insert_and_remove_random , "Testing array 'insert' and 'remove' operations with random indices and elements." );
+    test_register ( test_array_remove_swap_and_remove_if , "Testing array 'remove_swap' and 'remove_if' operations." );
+    test_register ( test_array_batch , "Testing array batch 'push', 'insert', 'remove', 'reserve' and 'extend' operations." );
+    test_register ( test_array_typed , "Testing typed array (ARRAY_DEFINE) operations." );
     test_register ( test_array_reverse , "Testing array 'reverse' operation." );
+    test_register ( test_array_shuffle , "Testing array 'shuffle' operation." );
     test_register ( test_array_sort , "Testing array in-place 'sort' operation." );
+    test_register ( test_array_image , "Writing an array image, and using it in place." );
 }
\ No newline at end of file
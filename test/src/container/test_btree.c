@@ -0,0 +1,426 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_btree.c
+ * @brief Implementation of the container/test_btree header.
+ * (see container/test_btree.h for additional details)
+ */
+#include "container/test_btree.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "math/math.h"
+
+#define TEST_BTREE_ENTRY_COUNT ( ( u64 ) 20000 )
+
+/** @brief Type definition for a test key ordered by a comparator. */
+typedef struct
+{
+    char name[ 12 ];
+}
+name_t;
+
+/** @brief Comparator: orders name_t keys lexicographically. */
+i32
+test_btree_comparator_name
+(   const void* a
+,   const void* b
+)
+{
+    const char* a_ = ( *( ( name_t* ) a ) ).name;
+    const char* b_ = ( *( ( name_t* ) b ) ).name;
+    for ( u64 i = 0; i < sizeof ( ( *( ( name_t* ) a ) ).name ); ++i )
+    {
+        if ( a_[ i ] != b_[ i ] )
+        {
+            return ( ( u8 )( a_[ i ] ) < ( u8 )( b_[ i ] ) ) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/** @brief Fills an array with a random permutation of 0 .. count - 1. */
+void
+test_btree_shuffle
+(   u64*        keys
+,   const u64   count
+)
+{
+    for ( u64 i = 0; i < count; ++i )
+    {
+        keys[ i ] = i;
+    }
+    for ( u64 i = count - 1; i; --i )
+    {
+        const u64 j = ( ( u64 ) random64 () ) % ( i + 1 );
+        const u64 swap = keys[ i ];
+        keys[ i ] = keys[ j ];
+        keys[ j ] = swap;
+    }
+}
+
+u8
+test_btree_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 pool_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    pool_amount_allocated = memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    btree_t* tree;
+    btree_iterator_t iterator;
+    u64 key = 1;
+    u64 value;
+    const u64 unsorted[] = { 1 , 3 , 2 };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: btree_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( _btree_create ( 0 , sizeof ( u64 ) , BTREE_DEFAULT_NODE_SIZE , 0 , &tree ) );
+    EXPECT_NOT ( _btree_create ( sizeof ( u32 ) , sizeof ( u64 ) , BTREE_DEFAULT_NODE_SIZE , 0 , &tree ) );
+    EXPECT_NOT ( _btree_create ( sizeof ( u64 ) , sizeof ( u64 ) , BTREE_DEFAULT_NODE_SIZE , 0 , 0 ) );
+    EXPECT_NOT ( btree_create_from ( u64 , u64 , 0 , 0 , unsorted , 1 , &tree ) );
+    EXPECT_NOT ( btree_create_from ( u64 , u64 , 0 , unsorted , 0 , 1 , &tree ) );
+    EXPECT_NOT ( btree_create_from ( u64 , u64 , 0 , unsorted , unsorted , 3 , &tree ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: btree_create creates an empty tree, with nodes a whole number of
+    //         cache lines long.
+    tree = 0;
+    EXPECT ( btree_create ( u64 , u64 , 0 , &tree ) );
+    EXPECT_NEQ ( 0 , tree );
+    EXPECT_EQ ( 0 , btree_length ( tree ) );
+    EXPECT_EQ ( 0 , btree_height ( tree ) );
+    EXPECT_EQ ( BTREE_DEFAULT_NODE_SIZE , btree_node_size ( tree ) );
+    EXPECT_NOT ( btree_get ( tree , &key , &value ) );
+    EXPECT_NOT ( btree_remove ( tree , &key , &value ) );
+    EXPECT_NOT ( btree_first ( tree , &iterator ) );
+    EXPECT_NOT ( btree_last ( tree , &iterator ) );
+    EXPECT_NOT ( btree_lower_bound ( tree , &key , &iterator ) );
+    EXPECT_NOT ( btree_iterator_valid ( &iterator ) );
+    EXPECT_EQ ( 0 , btree_iterator_key ( &iterator ) );
+    EXPECT_NOT ( btree_iterator_next ( &iterator ) );
+    EXPECT_NEQ ( pool_amount_allocated , memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR ) );
+
+    // TEST 3: btree_destroy frees the tree and nullifies the handle.
+    btree_destroy ( &tree );
+    EXPECT_EQ ( 0 , tree );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+
+    // TEST 4: The node size is rounded up to fit at least four large entries.
+    EXPECT ( _btree_create ( sizeof ( u64 ) , 200 , 1 , 0 , &tree ) );
+    EXPECT_EQ ( 0 , btree_node_size ( tree ) % CACHE_LINE_SIZE );
+    EXPECT ( btree_node_size ( tree ) >= 4 * ( sizeof ( u64 ) + 200 ) );
+    btree_destroy ( &tree );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( pool_amount_allocated , memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_btree_set_get_and_remove
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    btree_t* tree;
+    btree_iterator_t iterator;
+    u64* keys = memory_allocate ( TEST_BTREE_ENTRY_COUNT * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+    u64 value;
+    u64 count;
+    u64 previous;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Entries inserted in random order are retrieved by key, for
+    //         several node sizes (small nodes make the tree deep).
+    for ( u64 node_size = CACHE_LINE_SIZE; node_size <= 16 * CACHE_LINE_SIZE; node_size *= 4 )
+    {
+        EXPECT ( _btree_create ( sizeof ( u64 ) , sizeof ( u64 ) , node_size , 0 , &tree ) );
+        test_btree_shuffle ( keys , TEST_BTREE_ENTRY_COUNT );
+        for ( u64 i = 0; i < TEST_BTREE_ENTRY_COUNT; ++i )
+        {
+            value = keys[ i ] * 3;
+            EXPECT ( btree_set ( tree , &keys[ i ] , &value ) );
+        }
+        EXPECT_EQ ( TEST_BTREE_ENTRY_COUNT , btree_length ( tree ) );
+        EXPECT ( btree_height ( tree ) > 1 );
+        for ( u64 i = 0; i < TEST_BTREE_ENTRY_COUNT; ++i )
+        {
+            EXPECT ( btree_get ( tree , &i , &value ) );
+            EXPECT_EQ ( i * 3 , value );
+        }
+        value = TEST_BTREE_ENTRY_COUNT;
+        EXPECT_NOT ( btree_contains ( tree , &value ) );
+
+        // TEST 2: Iteration visits every entry in key order, in both
+        //         directions.
+        count = 0;
+        for ( bool found = btree_first ( tree , &iterator ); found; found = btree_iterator_next ( &iterator ) )
+        {
+            EXPECT_EQ ( count , *( ( u64* ) btree_iterator_key ( &iterator ) ) );
+            EXPECT_EQ ( count * 3 , *( ( u64* ) btree_iterator_value ( &iterator ) ) );
+            count += 1;
+        }
+        EXPECT_EQ ( TEST_BTREE_ENTRY_COUNT , count );
+        for ( bool found = btree_last ( tree , &iterator ); found; found = btree_iterator_prev ( &iterator ) )
+        {
+            count -= 1;
+            EXPECT_EQ ( count , *( ( u64* ) btree_iterator_key ( &iterator ) ) );
+        }
+        EXPECT_EQ ( 0 , count );
+
+        // TEST 3: btree_set overwrites the value of an existing key.
+        value = 7;
+        EXPECT ( btree_set ( tree , &keys[ 0 ] , &value ) );
+        EXPECT_EQ ( TEST_BTREE_ENTRY_COUNT , btree_length ( tree ) );
+        value = 0;
+        EXPECT ( btree_get ( tree , &keys[ 0 ] , &value ) );
+        EXPECT_EQ ( 7 , value );
+        value = keys[ 0 ] * 3;
+        EXPECT ( btree_set ( tree , &keys[ 0 ] , &value ) );
+
+        // TEST 4: Entries removed in random order are no longer retrieved,
+        //         and the remainder are intact.
+        test_btree_shuffle ( keys , TEST_BTREE_ENTRY_COUNT );
+        for ( u64 i = 0; i < TEST_BTREE_ENTRY_COUNT / 2; ++i )
+        {
+            EXPECT ( btree_remove ( tree , &keys[ i ] , &value ) );
+            EXPECT_EQ ( keys[ i ] * 3 , value );
+            EXPECT_NOT ( btree_remove ( tree , &keys[ i ] , 0 ) );
+        }
+        EXPECT_EQ ( TEST_BTREE_ENTRY_COUNT / 2 , btree_length ( tree ) );
+        for ( u64 i = 0; i < TEST_BTREE_ENTRY_COUNT; ++i )
+        {
+            EXPECT_EQ ( i >= TEST_BTREE_ENTRY_COUNT / 2 , btree_get ( tree , &keys[ i ] , &value ) );
+        }
+        count = 0;
+        previous = 0;
+        for ( bool found = btree_first ( tree , &iterator ); found; found = btree_iterator_next ( &iterator ) )
+        {
+            const u64 key = *( ( u64* ) btree_iterator_key ( &iterator ) );
+            EXPECT ( !count || key > previous );
+            EXPECT_EQ ( key * 3 , *( ( u64* ) btree_iterator_value ( &iterator ) ) );
+            previous = key;
+            count += 1;
+        }
+        EXPECT_EQ ( TEST_BTREE_ENTRY_COUNT / 2 , count );
+
+        // TEST 5: Removing every entry empties the tree, which is then reusable.
+        for ( u64 i = TEST_BTREE_ENTRY_COUNT / 2; i < TEST_BTREE_ENTRY_COUNT; ++i )
+        {
+            EXPECT ( btree_remove ( tree , &keys[ i ] , 0 ) );
+        }
+        EXPECT_EQ ( 0 , btree_length ( tree ) );
+        EXPECT_EQ ( 0 , btree_height ( tree ) );
+        EXPECT_NOT ( btree_first ( tree , &iterator ) );
+        value = 1;
+        EXPECT ( btree_set ( tree , &value , &value ) );
+        EXPECT_EQ ( 1 , btree_length ( tree ) );
+        EXPECT_EQ ( 1 , btree_height ( tree ) );
+
+        btree_destroy ( &tree );
+    }
+
+    // TEST 6: btree_clear removes every entry.
+    EXPECT ( btree_create ( u64 , u64 , 0 , &tree ) );
+    for ( u64 i = 0; i < TEST_BTREE_ENTRY_COUNT; ++i )
+    {
+        EXPECT ( btree_set ( tree , &i , &i ) );
+    }
+    btree_clear ( tree );
+    EXPECT_EQ ( 0 , btree_length ( tree ) );
+    EXPECT_EQ ( 0 , btree_height ( tree ) );
+    value = 0;
+    EXPECT_NOT ( btree_contains ( tree , &value ) );
+    EXPECT ( btree_set ( tree , &value , &value ) );
+    EXPECT ( btree_contains ( tree , &value ) );
+    btree_destroy ( &tree );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    memory_free ( keys , TEST_BTREE_ENTRY_COUNT * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_btree_create_from_and_bounds
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    btree_t* tree;
+    btree_iterator_t iterator;
+    u64* keys = memory_allocate ( TEST_BTREE_ENTRY_COUNT * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+    u64* values = memory_allocate ( TEST_BTREE_ENTRY_COUNT * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+    u64 key;
+    u64 value;
+    u64 count;
+    name_t names[ 26 ];
+    name_t name;
+
+    // Even keys only, so that odd keys fall between entries.
+    for ( u64 i = 0; i < TEST_BTREE_ENTRY_COUNT; ++i )
+    {
+        keys[ i ] = 2 * i;
+        values[ i ] = i;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: btree_create_from builds a valid tree from sorted arrays, of any
+    //         length.
+    for ( u64 length = 0; length < 200; ++length )
+    {
+        EXPECT ( _btree_create_from ( sizeof ( u64 ) , sizeof ( u64 ) , CACHE_LINE_SIZE , 0
+                                    , keys , values , length , &tree
+                                    ));
+        EXPECT_EQ ( length , btree_length ( tree ) );
+        count = 0;
+        for ( bool found = btree_first ( tree , &iterator ); found; found = btree_iterator_next ( &iterator ) )
+        {
+            EXPECT_EQ ( keys[ count ] , *( ( u64* ) btree_iterator_key ( &iterator ) ) );
+            count += 1;
+        }
+        EXPECT_EQ ( length , count );
+
+        // TEST 2: A bulk-loaded tree remains valid under insertion and
+        //         removal.
+        for ( u64 i = 0; i < length; ++i )
+        {
+            key = 2 * i + 1;
+            EXPECT ( btree_set ( tree , &key , &i ) );
+        }
+        for ( u64 i = 0; i < length; ++i )
+        {
+            EXPECT ( btree_remove ( tree , &keys[ i ] , &value ) );
+            EXPECT_EQ ( i , value );
+        }
+        EXPECT_EQ ( length , btree_length ( tree ) );
+        for ( u64 i = 0; i < length; ++i )
+        {
+            key = 2 * i + 1;
+            EXPECT ( btree_get ( tree , &key , &value ) );
+            EXPECT_EQ ( i , value );
+        }
+        btree_destroy ( &tree );
+    }
+
+    // TEST 3: btree_lower_bound finds the first key not before a key, and
+    //         btree_upper_bound the first key after it.
+    EXPECT ( btree_create_from ( u64 , u64 , 0 , keys , values , TEST_BTREE_ENTRY_COUNT , &tree ) );
+    EXPECT_EQ ( TEST_BTREE_ENTRY_COUNT , btree_length ( tree ) );
+    for ( u64 i = 0; i < 2 * TEST_BTREE_ENTRY_COUNT - 2; ++i )
+    {
+        EXPECT ( btree_lower_bound ( tree , &i , &iterator ) );
+        EXPECT_EQ ( i + ( i & 1 ) , *( ( u64* ) btree_iterator_key ( &iterator ) ) );
+        EXPECT ( btree_upper_bound ( tree , &i , &iterator ) );
+        EXPECT_EQ ( i + 2 - ( i & 1 ) , *( ( u64* ) btree_iterator_key ( &iterator ) ) );
+    }
+    key = 2 * TEST_BTREE_ENTRY_COUNT - 2;
+    EXPECT ( btree_lower_bound ( tree , &key , &iterator ) );
+    EXPECT_NOT ( btree_upper_bound ( tree , &key , &iterator ) );
+    EXPECT_NOT ( btree_iterator_valid ( &iterator ) );
+    key += 1;
+    EXPECT_NOT ( btree_lower_bound ( tree , &key , &iterator ) );
+
+    // TEST 4: A range scan visits the keys in [ low , high ), in order.
+    const u64 low = 1001;
+    const u64 high = 3001;
+    count = 0;
+    for ( bool found = btree_lower_bound ( tree , &low , &iterator )
+        ; found && *( ( u64* ) btree_iterator_key ( &iterator ) ) < high
+        ; found = btree_iterator_next ( &iterator )
+        )
+    {
+        EXPECT_EQ ( 1002 + 2 * count , *( ( u64* ) btree_iterator_key ( &iterator ) ) );
+        count += 1;
+    }
+    EXPECT_EQ ( 1000 , count );
+
+    // TEST 5: Values may be modified in place through an iterator.
+    key = 10;
+    EXPECT ( btree_lower_bound ( tree , &key , &iterator ) );
+    *( ( u64* ) btree_iterator_value ( &iterator ) ) = 99;
+    EXPECT ( btree_get ( tree , &key , &value ) );
+    EXPECT_EQ ( 99 , value );
+    btree_destroy ( &tree );
+
+    // TEST 6: A tree with a comparator and no values (a sorted set).
+    for ( u64 i = 0; i < 26; ++i )
+    {
+        memory_clear ( &names[ i ] , sizeof ( name_t ) );
+        names[ i ].name[ 0 ] = 'a' + i;
+        names[ i ].name[ 1 ] = 'a' + i;
+    }
+    EXPECT ( _btree_create_from ( sizeof ( name_t ) , 0 , 0 , test_btree_comparator_name
+                                , names , 0 , 26 , &tree
+                                ));
+    memory_clear ( &name , sizeof ( name_t ) );
+    name.name[ 0 ] = 'm';
+    EXPECT ( btree_lower_bound ( tree , &name , &iterator ) );
+    EXPECT_EQ ( 0 , test_btree_comparator_name ( &names[ 12 ] , btree_iterator_key ( &iterator ) ) );
+    EXPECT ( btree_iterator_prev ( &iterator ) );
+    EXPECT_EQ ( 0 , test_btree_comparator_name ( &names[ 11 ] , btree_iterator_key ( &iterator ) ) );
+    EXPECT ( btree_contains ( tree , &names[ 25 ] ) );
+    EXPECT_NOT ( btree_contains ( tree , &name ) );
+    EXPECT ( btree_set ( tree , &name , 0 ) );
+    EXPECT ( btree_contains ( tree , &name ) );
+    EXPECT_EQ ( 27 , btree_length ( tree ) );
+    btree_destroy ( &tree );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    memory_free ( keys , TEST_BTREE_ENTRY_COUNT * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+    memory_free ( values , TEST_BTREE_ENTRY_COUNT * sizeof ( u64 ) , MEMORY_TAG_ARRAY );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_btree
+( void )
+{
+    test_register ( test_btree_create_and_destroy , "Creating or destroying a B+tree." );
+    test_register ( test_btree_set_get_and_remove , "Testing B+tree 'set', 'get' and 'remove' operations." );
+    test_register ( test_btree_create_from_and_bounds , "Testing B+tree bulk loading and lower/upper bound iterators." );
+}
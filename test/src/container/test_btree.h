@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_btree.h
+ * @brief Tests container/btree.h
+ * (see test/test.h, container/btree.h for additional details)
+ */
+#ifndef TEST_BTREE_H
+#define TEST_BTREE_H
+
+#include "test/test.h"
+
+#include "container/btree.h"
+
+void
+test_register_btree
+( void );
+
+#endif  // TEST_BTREE_H
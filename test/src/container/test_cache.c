@@ -0,0 +1,404 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_cache.c
+ * @brief Implementation of the container/test_cache header.
+ * (see container/test_cache.h for additional details)
+ */
+#include "container/test_cache.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+#include "core/string.h"
+
+#include "memory/linear_allocator.h"
+
+/** @brief Type definition for a record of the values evicted from a cache. */
+typedef struct
+{
+    u64     count;
+    u64     size;
+    u64     value;
+    char    key[ 16 ];
+}
+evicted_t;
+
+/**
+ * @brief Eviction callback: records the key, value and size of the most
+ * recently evicted entry.
+ */
+void
+test_cache_evict
+(   void*       args
+,   const void* key
+,   u64         key_length
+,   void*       value
+,   u64         size
+)
+{
+    evicted_t* evicted = args;
+    ( *evicted ).count += 1;
+    ( *evicted ).size += size;
+    ( *evicted ).value = *( ( u64* ) value );
+    memory_clear ( ( *evicted ).key , sizeof ( ( *evicted ).key ) );
+    memory_copy ( ( *evicted ).key , key , key_length );
+}
+
+u8
+test_cache_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    cache_t* cache;
+    u64 memory_requirement;
+    linear_allocator_t* allocator;
+    u64 value = 1;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: cache_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( cache_create ( 0 , 1 , 8 , 0 , 0 , 0 , 0 , 0 , &cache ) );
+    EXPECT_NOT ( cache_create ( sizeof ( u64 ) , 0 , 8 , 0 , 0 , 0 , 0 , 0 , &cache ) );
+    EXPECT_NOT ( cache_create ( sizeof ( u64 ) , 1 , 8 , 0 , 0 , 0 , 0 , 0 , 0 ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: cache_create reports its memory requirement without allocating.
+    memory_requirement = 0;
+    EXPECT ( cache_create ( sizeof ( u64 ) , 100 , 8 , 0 , 0 , 0 , &memory_requirement , 0 , &cache ) );
+    EXPECT_NEQ ( 0 , memory_requirement );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 3: A cache can be carved out of a linear allocator.
+    allocator = 0;
+    EXPECT ( linear_allocator_create ( memory_requirement , 0 , 0 , &allocator ) );
+    cache = 0;
+    EXPECT ( cache_create ( sizeof ( u64 ) , 100 , 8 , 0 , 0 , 0 , &memory_requirement
+                          , linear_allocator_allocate ( allocator , memory_requirement )
+                          , &cache
+                          ));
+    EXPECT_NEQ ( 0 , cache );
+    EXPECT_EQ ( 100 , cache_capacity ( cache ) );
+    EXPECT_EQ ( 0 , cache_budget ( cache ) );
+    EXPECT_EQ ( 0 , cache_length ( cache ) );
+    EXPECT_EQ ( 0 , cache_size ( cache ) );
+    for ( u64 i = 0; i < 200; ++i )
+    {
+        EXPECT ( _cache_set ( cache , &i , sizeof ( i ) , &i , 0 ) );
+    }
+    EXPECT_EQ ( 100 , cache_length ( cache ) );
+    cache_destroy ( &cache );
+    EXPECT_EQ ( 0 , cache );
+    linear_allocator_destroy ( &allocator );
+
+    // TEST 4: cache_create uses implicit memory allocation; cache_destroy
+    //         frees it and nullifies the handle.
+    cache = 0;
+    EXPECT ( cache_create ( sizeof ( u64 ) , 16 , 8 , KiB ( 1 ) , 0 , 0 , 0 , 0 , &cache ) );
+    EXPECT_NEQ ( 0 , cache );
+    EXPECT_EQ ( KiB ( 1 ) , cache_budget ( cache ) );
+    EXPECT_NEQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT ( cache_set ( cache , "key" , &value , 8 ) );
+    cache_destroy ( &cache );
+    EXPECT_EQ ( 0 , cache );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: cache_destroy handles invalid arguments.
+    cache_destroy ( 0 );
+    cache_destroy ( &cache );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_cache_set_get_and_remove
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    cache_t* cache;
+    cache_stats_t stats;
+    evicted_t evicted;
+    u64 value;
+
+    memory_clear ( &evicted , sizeof ( evicted ) );
+    EXPECT ( cache_create ( sizeof ( u64 ) , 8 , 8 , 0 , test_cache_evict , &evicted , 0 , 0 , &cache ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: cache_get misses on an empty cache, and leaves the output buffer
+    //         untouched.
+    value = 7;
+    EXPECT_NOT ( cache_get ( cache , "a" , &value ) );
+    EXPECT_EQ ( 7 , value );
+    EXPECT_NOT ( cache_contains ( cache , "a" ) );
+
+    // TEST 2: cache_set inserts; cache_get retrieves.
+    value = 1;
+    EXPECT ( cache_set ( cache , "a" , &value , 10 ) );
+    value = 2;
+    EXPECT ( cache_set_view ( cache , string_view ( "bb" , 2 ) , &value , 20 ) );
+    value = 0;
+    EXPECT ( cache_get ( cache , "a" , &value ) );
+    EXPECT_EQ ( 1 , value );
+    EXPECT ( cache_get_view ( cache , string_view ( "bb" , 2 ) , &value ) );
+    EXPECT_EQ ( 2 , value );
+    EXPECT ( cache_get ( cache , "a" , 0 ) );
+    EXPECT ( cache_contains ( cache , "bb" ) );
+    EXPECT_EQ ( 2 , cache_length ( cache ) );
+    EXPECT_EQ ( 30 , cache_size ( cache ) );
+    EXPECT_EQ ( 0 , evicted.count );
+
+    // TEST 3: The empty key is a valid key.
+    value = 3;
+    EXPECT ( _cache_set ( cache , 0 , 0 , &value , 0 ) );
+    value = 0;
+    EXPECT ( _cache_get ( cache , 0 , 0 , &value ) );
+    EXPECT_EQ ( 3 , value );
+    EXPECT ( _cache_remove ( cache , 0 , 0 , &value ) );
+    EXPECT_EQ ( 3 , value );
+    EXPECT_EQ ( 0 , evicted.count );
+
+    // TEST 4: cache_set overwrites an existing value, invoking the eviction
+    //         callback on the old one.
+    value = 4;
+    EXPECT ( cache_set ( cache , "a" , &value , 15 ) );
+    EXPECT_EQ ( 1 , evicted.count );
+    EXPECT_EQ ( 1 , evicted.value );
+    EXPECT_EQ ( 10 , evicted.size );
+    EXPECT ( memory_equal ( evicted.key , "a" , 2 ) );
+    EXPECT ( cache_get ( cache , "a" , &value ) );
+    EXPECT_EQ ( 4 , value );
+    EXPECT_EQ ( 2 , cache_length ( cache ) );
+    EXPECT_EQ ( 35 , cache_size ( cache ) );
+
+    // TEST 5: cache_remove with an output buffer hands the value over without
+    //         invoking the eviction callback.
+    value = 0;
+    EXPECT ( cache_remove ( cache , "bb" , &value ) );
+    EXPECT_EQ ( 2 , value );
+    EXPECT_EQ ( 1 , evicted.count );
+    EXPECT_NOT ( cache_contains ( cache , "bb" ) );
+    EXPECT_NOT ( cache_remove ( cache , "bb" , &value ) );
+    EXPECT_EQ ( 1 , cache_length ( cache ) );
+    EXPECT_EQ ( 15 , cache_size ( cache ) );
+
+    // TEST 6: cache_remove without an output buffer invokes the eviction
+    //         callback.
+    EXPECT ( cache_remove_view ( cache , string_view ( "a" , 1 ) , 0 ) );
+    EXPECT_EQ ( 2 , evicted.count );
+    EXPECT_EQ ( 4 , evicted.value );
+    EXPECT_EQ ( 0 , cache_length ( cache ) );
+    EXPECT_EQ ( 0 , cache_size ( cache ) );
+
+    // TEST 7: cache_set rejects a key longer than the key capacity.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( cache_set ( cache , "too long a key" , &value , 0 ) );
+    EXPECT_NOT ( cache_set ( cache , "a" , 0 , 0 ) );
+    EXPECT_EQ ( 0 , cache_length ( cache ) );
+
+    // TEST 8: cache_stats reports hits, misses and insertions, excluding
+    //         cache_contains; cache_stats_reset zeroes the counters only.
+    cache_stats ( cache , &stats );
+    EXPECT_EQ ( 5 , stats.hits );
+    EXPECT_EQ ( 1 , stats.misses );
+    EXPECT_EQ ( 3 , stats.insertions );
+    EXPECT_EQ ( 0 , stats.evictions );
+    EXPECT_EQ ( 0 , stats.length );
+    value = 5;
+    EXPECT ( cache_set ( cache , "c" , &value , 1 ) );
+    cache_stats_reset ( cache );
+    cache_stats ( cache , &stats );
+    EXPECT_EQ ( 0 , stats.hits );
+    EXPECT_EQ ( 0 , stats.misses );
+    EXPECT_EQ ( 0 , stats.insertions );
+    EXPECT_EQ ( 1 , stats.length );
+    EXPECT_EQ ( 1 , stats.size );
+
+    // TEST 9: cache_clear invokes the eviction callback on every value.
+    for ( u64 i = 0; i < 7; ++i )
+    {
+        EXPECT ( _cache_set ( cache , &i , sizeof ( i ) , &i , 1 ) );
+    }
+    EXPECT_EQ ( 8 , cache_length ( cache ) );
+    evicted.count = 0;
+    cache_clear ( cache );
+    EXPECT_EQ ( 8 , evicted.count );
+    EXPECT_EQ ( 0 , cache_length ( cache ) );
+    EXPECT_EQ ( 0 , cache_size ( cache ) );
+    for ( u64 i = 0; i < 7; ++i )
+    {
+        EXPECT_NOT ( _cache_contains ( cache , &i , sizeof ( i ) ) );
+    }
+
+    // TEST 10: cache_destroy invokes the eviction callback on every value.
+    value = 6;
+    EXPECT ( cache_set ( cache , "d" , &value , 1 ) );
+    evicted.count = 0;
+    cache_destroy ( &cache );
+    EXPECT_EQ ( 1 , evicted.count );
+    EXPECT_EQ ( 6 , evicted.value );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_cache_eviction
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    cache_t* cache;
+    cache_stats_t stats;
+    evicted_t evicted;
+    u64 value;
+
+    memory_clear ( &evicted , sizeof ( evicted ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A full cache evicts the first entry the CLOCK hand reaches which
+    //         has not been used since the hand last passed it.
+    EXPECT ( cache_create ( sizeof ( u64 ) , 4 , 8 , 0 , test_cache_evict , &evicted , 0 , 0 , &cache ) );
+    value = 'a'; EXPECT ( cache_set ( cache , "a" , &value , 0 ) );
+    value = 'b'; EXPECT ( cache_set ( cache , "b" , &value , 0 ) );
+    value = 'c'; EXPECT ( cache_set ( cache , "c" , &value , 0 ) );
+    value = 'd'; EXPECT ( cache_set ( cache , "d" , &value , 0 ) );
+    EXPECT_EQ ( 0 , evicted.count );
+
+    // Every entry is new, so the hand clears them all and comes back to "a".
+    value = 'e'; EXPECT ( cache_set ( cache , "e" , &value , 0 ) );
+    EXPECT_EQ ( 1 , evicted.count );
+    EXPECT_EQ ( 'a' , evicted.value );
+    EXPECT_NOT ( cache_contains ( cache , "a" ) );
+    EXPECT_EQ ( 4 , cache_length ( cache ) );
+
+    // "b" was used since, so it gets a second chance; "c" goes instead.
+    EXPECT ( cache_get ( cache , "b" , 0 ) );
+    value = 'f'; EXPECT ( cache_set ( cache , "f" , &value , 0 ) );
+    EXPECT_EQ ( 2 , evicted.count );
+    EXPECT_EQ ( 'c' , evicted.value );
+    EXPECT ( cache_contains ( cache , "b" ) );
+    EXPECT ( cache_contains ( cache , "d" ) );
+    EXPECT ( cache_contains ( cache , "e" ) );
+    EXPECT ( cache_contains ( cache , "f" ) );
+
+    cache_stats ( cache , &stats );
+    EXPECT_EQ ( 6 , stats.insertions );
+    EXPECT_EQ ( 2 , stats.evictions );
+    cache_destroy ( &cache );
+
+    // TEST 2: A cache with a budget evicts entries until the new one fits.
+    memory_clear ( &evicted , sizeof ( evicted ) );
+    EXPECT ( cache_create ( sizeof ( u64 ) , 16 , 8 , 100 , test_cache_evict , &evicted , 0 , 0 , &cache ) );
+    value = 'a'; EXPECT ( cache_set ( cache , "a" , &value , 40 ) );
+    value = 'b'; EXPECT ( cache_set ( cache , "b" , &value , 40 ) );
+    value = 'c'; EXPECT ( cache_set ( cache , "c" , &value , 10 ) );
+    EXPECT_EQ ( 90 , cache_size ( cache ) );
+    EXPECT_EQ ( 0 , evicted.count );
+    value = 'd'; EXPECT ( cache_set ( cache , "d" , &value , 60 ) );
+    EXPECT_EQ ( 2 , evicted.count );
+    EXPECT_EQ ( 80 , evicted.size );
+    EXPECT_NOT ( cache_contains ( cache , "a" ) );
+    EXPECT_NOT ( cache_contains ( cache , "b" ) );
+    EXPECT_EQ ( 70 , cache_size ( cache ) );
+    EXPECT_EQ ( 2 , cache_length ( cache ) );
+
+    // TEST 3: Growing the charge of an entry evicts other entries, never the
+    //         entry itself.
+    value = 'D'; EXPECT ( cache_set ( cache , "d" , &value , 95 ) );
+    EXPECT ( cache_get ( cache , "d" , &value ) );
+    EXPECT_EQ ( 'D' , value );
+    EXPECT_NOT ( cache_contains ( cache , "c" ) );
+    EXPECT_EQ ( 95 , cache_size ( cache ) );
+    EXPECT_EQ ( 1 , cache_length ( cache ) );
+
+    // TEST 4: cache_set rejects a value larger than the whole budget.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( cache_set ( cache , "e" , &value , 101 ) );
+    EXPECT ( cache_contains ( cache , "d" ) );
+    cache_destroy ( &cache );
+
+    // TEST 5: Many insertions into a small cache stay within its capacity, and
+    //         every value leaves through the eviction callback exactly once.
+    memory_clear ( &evicted , sizeof ( evicted ) );
+    EXPECT ( cache_create ( sizeof ( u64 ) , 13 , 8 , 0 , test_cache_evict , &evicted , 0 , 0 , &cache ) );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        EXPECT ( _cache_set ( cache , &i , sizeof ( i ) , &i , i ) );
+        if ( i % 3 )
+        {
+            const u64 key = i - 1;
+            _cache_get ( cache , &key , sizeof ( key ) , 0 );
+        }
+        EXPECT ( cache_length ( cache ) <= 13 );
+    }
+    EXPECT_EQ ( 13 , cache_length ( cache ) );
+    EXPECT_EQ ( 987 , evicted.count );
+    cache_destroy ( &cache );
+    EXPECT_EQ ( 1000 , evicted.count );
+    EXPECT_EQ ( 999 * 1000 / 2 , evicted.size );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_cache
+( void )
+{
+    test_register ( test_cache_create_and_destroy , "Creating or destroying a cache." );
+    test_register ( test_cache_set_get_and_remove , "Testing cache 'set', 'get' and 'remove' operations." );
+    test_register ( test_cache_eviction , "Testing cache eviction by capacity and by budget." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_cache.h
+ * @brief Tests container/cache.h
+ * (see test/test.h, container/cache.h for additional details)
+ */
+#ifndef TEST_CACHE_H
+#define TEST_CACHE_H
+
+#include "test/test.h"
+
+#include "container/cache.h"
+
+void
+test_register_cache
+( void );
+
+#endif  // TEST_CACHE_H
@@ -0,0 +1,419 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_concurrent_hashtable.c
+ * @brief Implementation of the container/test_concurrent_hashtable header.
+ * (see container/test_concurrent_hashtable.h for additional details)
+ */
+#include "container/test_concurrent_hashtable.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/thread.h"
+
+#define TEST_CONCURRENT_HASHTABLE_WRITER_COUNT  ( ( u64 ) 4 )
+#define TEST_CONCURRENT_HASHTABLE_READER_COUNT  ( ( u64 ) 4 )
+#define TEST_CONCURRENT_HASHTABLE_KEY_COUNT     ( ( u64 ) 4096 )
+#define TEST_CONCURRENT_HASHTABLE_ROUND_COUNT   ( ( u64 ) 4 )
+
+/**
+ * @brief Type definition for a test value. Every value written by the test
+ * satisfies check == key ^ ( version * TEST_CONCURRENT_HASHTABLE_MIX ), so a
+ * query which observes a partially written value can tell.
+ */
+typedef struct
+{
+    u64 key;
+    u64 version;
+    u64 check;
+}
+value_t;
+
+#define TEST_CONCURRENT_HASHTABLE_MIX ( ( u64 ) 0x9E3779B97F4A7C15 )
+
+/** @brief Type definition for state shared by all reader and writer threads. */
+typedef struct
+{
+    concurrent_hashtable_t* hashtable;
+    u64                     next_writer;
+    u64                     writers_done;
+    u64                     found;
+    u64                     errors;
+}
+shared_t;
+
+/**
+ * @brief Constructs a test value.
+ *
+ * @param key The key.
+ * @param version The version.
+ * @return A value for key.
+ */
+value_t
+test_concurrent_hashtable_value
+(   const u64 key
+,   const u64 version
+)
+{
+    value_t value;
+    value.key = key;
+    value.version = version;
+    value.check = key ^ ( version * TEST_CONCURRENT_HASHTABLE_MIX );
+    return value;
+}
+
+/**
+ * @brief Writer thread: over several rounds, inserts, overwrites and removes
+ * its share of the keys, leaving every even key of its share set to its last
+ * version.
+ */
+u32
+test_concurrent_hashtable_writer
+(   void* args
+)
+{
+    shared_t* shared = args;
+    const u64 writer = atomic_fetch_add_u64 ( &( *shared ).next_writer , 1 , ATOMIC_RELAXED );
+    u64 errors = 0;
+    for ( u64 round = 0; round < TEST_CONCURRENT_HASHTABLE_ROUND_COUNT; ++round )
+    {
+        for ( u64 key = writer; key < TEST_CONCURRENT_HASHTABLE_KEY_COUNT; key += TEST_CONCURRENT_HASHTABLE_WRITER_COUNT )
+        {
+            const value_t value = test_concurrent_hashtable_value ( key , round );
+            if ( !_concurrent_hashtable_set ( ( *shared ).hashtable , &key , sizeof ( key ) , &value ) )
+            {
+                errors += 1;
+            }
+        }
+        for ( u64 key = writer; key < TEST_CONCURRENT_HASHTABLE_KEY_COUNT; key += TEST_CONCURRENT_HASHTABLE_WRITER_COUNT )
+        {
+            value_t removed;
+            if ( ( key & 1 ) && !_concurrent_hashtable_remove ( ( *shared ).hashtable , &key , sizeof ( key ) , &removed ) )
+            {
+                errors += 1;
+            }
+        }
+    }
+    atomic_fetch_add_u64 ( &( *shared ).errors , errors , ATOMIC_RELAXED );
+    atomic_fetch_add_u64 ( &( *shared ).writers_done , 1 , ATOMIC_RELEASE );
+    return 0;
+}
+
+/**
+ * @brief Reader thread: queries every key until the writers are done,
+ * verifying that each value it finds is one which was written for that key.
+ */
+u32
+test_concurrent_hashtable_reader
+(   void* args
+)
+{
+    shared_t* shared = args;
+    u64 found = 0;
+    u64 errors = 0;
+    while ( atomic_load_u64 ( &( *shared ).writers_done , ATOMIC_ACQUIRE ) < TEST_CONCURRENT_HASHTABLE_WRITER_COUNT )
+    {
+        for ( u64 key = 0; key < TEST_CONCURRENT_HASHTABLE_KEY_COUNT; ++key )
+        {
+            value_t value;
+            if ( !_concurrent_hashtable_get ( ( *shared ).hashtable , &key , sizeof ( key ) , &value ) )
+            {
+                continue;
+            }
+            found += 1;
+            if ( value.key != key
+              || value.version >= TEST_CONCURRENT_HASHTABLE_ROUND_COUNT
+              || value.check != ( key ^ ( value.version * TEST_CONCURRENT_HASHTABLE_MIX ) )
+               )
+            {
+                errors += 1;
+            }
+        }
+    }
+    atomic_fetch_add_u64 ( &( *shared ).found , found , ATOMIC_RELAXED );
+    atomic_fetch_add_u64 ( &( *shared ).errors , errors , ATOMIC_RELAXED );
+    return 0;
+}
+
+u8
+test_concurrent_hashtable_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    concurrent_hashtable_t* hashtable;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: concurrent_hashtable_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( concurrent_hashtable_create ( 0 , 1 , &hashtable ) );
+    EXPECT_NOT ( concurrent_hashtable_create ( 1 , 1 , 0 ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: concurrent_hashtable_create rounds the capacity up to a power of two.
+    hashtable = 0;
+    EXPECT ( concurrent_hashtable_create ( sizeof ( u32 ) , 100 , &hashtable ) );
+    EXPECT_NEQ ( 0 , hashtable );
+    EXPECT_EQ ( 128 , concurrent_hashtable_capacity ( hashtable ) );
+    EXPECT_EQ ( sizeof ( u32 ) , concurrent_hashtable_stride ( hashtable ) );
+    EXPECT_EQ ( 0 , concurrent_hashtable_length ( hashtable ) );
+    EXPECT_NEQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+
+    // TEST 3: concurrent_hashtable_destroy frees the hashtable and nullifies the handle.
+    concurrent_hashtable_destroy ( &hashtable );
+    EXPECT_EQ ( 0 , hashtable );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 4: The capacity is at least the number of lock stripes.
+    EXPECT ( _concurrent_hashtable_create ( sizeof ( u32 ) , 0 , 0 , 0 , &hashtable ) );
+    EXPECT_EQ ( CONCURRENT_HASHTABLE_STRIPE_COUNT , concurrent_hashtable_capacity ( hashtable ) );
+    concurrent_hashtable_destroy ( &hashtable );
+
+    // TEST 5: concurrent_hashtable_destroy handles invalid arguments.
+    concurrent_hashtable_destroy ( 0 );
+    concurrent_hashtable_destroy ( &hashtable );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_concurrent_hashtable_set_get_and_remove
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char binary_key[] = { 'k' , 0 , 'e' , 0 , 'y' };
+    concurrent_hashtable_t* hashtable = 0;
+    u64 value;
+    u64 out;
+
+    EXPECT ( concurrent_hashtable_create ( sizeof ( u64 ) , 0 , &hashtable ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , hashtable );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Hashtable functions handle invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    value = 1;
+    EXPECT_NOT ( _concurrent_hashtable_set ( 0 , "key" , 3 , &value ) );
+    EXPECT_NOT ( _concurrent_hashtable_set ( hashtable , 0 , 3 , &value ) );
+    EXPECT_NOT ( _concurrent_hashtable_set ( hashtable , "key" , 3 , 0 ) );
+    EXPECT_NOT ( _concurrent_hashtable_insert ( hashtable , "key" , 3 , 0 ) );
+    EXPECT_NOT ( _concurrent_hashtable_get ( hashtable , 0 , 3 , &out ) );
+    EXPECT_NOT ( _concurrent_hashtable_remove ( hashtable , 0 , 3 , &out ) );
+    EXPECT_EQ ( 0 , concurrent_hashtable_length ( hashtable ) );
+
+    // TEST 2: concurrent_hashtable_get fails on a missing key.
+    EXPECT_NOT ( concurrent_hashtable_get ( hashtable , "key" , &out ) );
+    EXPECT_NOT ( concurrent_hashtable_contains ( hashtable , "key" ) );
+
+    // TEST 3: concurrent_hashtable_set inserts a missing key.
+    value = 12345;
+    EXPECT ( concurrent_hashtable_set ( hashtable , "key" , &value ) );
+    EXPECT_EQ ( 1 , concurrent_hashtable_length ( hashtable ) );
+    out = 0;
+    EXPECT ( concurrent_hashtable_get ( hashtable , "key" , &out ) );
+    EXPECT_EQ ( 12345 , out );
+    EXPECT ( concurrent_hashtable_get_view ( hashtable , string_view ( "key" , 3 ) , 0 ) );
+
+    // TEST 4: concurrent_hashtable_set overwrites the value of a present key.
+    value = 54321;
+    EXPECT ( concurrent_hashtable_set_view ( hashtable , string_view ( "key" , 3 ) , &value ) );
+    EXPECT_EQ ( 1 , concurrent_hashtable_length ( hashtable ) );
+    EXPECT ( concurrent_hashtable_get ( hashtable , "key" , &out ) );
+    EXPECT_EQ ( 54321 , out );
+
+    // TEST 5: concurrent_hashtable_insert does not overwrite a present key, and retrieves its value instead.
+    value = 1;
+    EXPECT_NOT ( concurrent_hashtable_insert ( hashtable , "key" , &value ) );
+    EXPECT_EQ ( 54321 , value );
+    value = 2;
+    EXPECT ( concurrent_hashtable_insert_view ( hashtable , string_view ( "other" , 5 ) , &value ) );
+    EXPECT_EQ ( 2 , value );
+    EXPECT_EQ ( 2 , concurrent_hashtable_length ( hashtable ) );
+
+    // TEST 6: Keys are binary strings of explicit length, and may be empty.
+    value = 3;
+    EXPECT ( _concurrent_hashtable_set ( hashtable , binary_key , sizeof ( binary_key ) , &value ) );
+    value = 4;
+    EXPECT ( _concurrent_hashtable_set ( hashtable , "" , 0 , &value ) );
+    EXPECT ( _concurrent_hashtable_get ( hashtable , binary_key , sizeof ( binary_key ) , &out ) );
+    EXPECT_EQ ( 3 , out );
+    EXPECT_NOT ( _concurrent_hashtable_contains ( hashtable , binary_key , 1 ) );
+    EXPECT ( _concurrent_hashtable_get ( hashtable , 0 , 0 , &out ) );
+    EXPECT_EQ ( 4 , out );
+    EXPECT_EQ ( 4 , concurrent_hashtable_length ( hashtable ) );
+
+    // TEST 7: concurrent_hashtable_remove removes a present key, and retrieves its value.
+    out = 0;
+    EXPECT ( concurrent_hashtable_remove ( hashtable , "key" , &out ) );
+    EXPECT_EQ ( 54321 , out );
+    EXPECT_NOT ( concurrent_hashtable_contains ( hashtable , "key" ) );
+    EXPECT_NOT ( concurrent_hashtable_remove ( hashtable , "key" , &out ) );
+    EXPECT ( concurrent_hashtable_remove_view ( hashtable , string_view ( "other" , 5 ) , 0 ) );
+    EXPECT ( _concurrent_hashtable_remove ( hashtable , binary_key , sizeof ( binary_key ) , 0 ) );
+    EXPECT ( _concurrent_hashtable_remove ( hashtable , "" , 0 , 0 ) );
+    EXPECT_EQ ( 0 , concurrent_hashtable_length ( hashtable ) );
+
+    // TEST 8: The hashtable grows as keys are inserted, and retains every key.
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        value = i * i;
+        EXPECT ( _concurrent_hashtable_set ( hashtable , &i , sizeof ( i ) , &value ) );
+    }
+    EXPECT_EQ ( 1000 , concurrent_hashtable_length ( hashtable ) );
+    EXPECT ( concurrent_hashtable_capacity ( hashtable ) >= 1000 );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        out = 0;
+        EXPECT ( _concurrent_hashtable_get ( hashtable , &i , sizeof ( i ) , &out ) );
+        EXPECT_EQ ( i * i , out );
+    }
+
+    // TEST 9: concurrent_hashtable_reclaim completes the resize, and frees every retired entry.
+    EXPECT_EQ ( 0 , concurrent_hashtable_reclaim ( hashtable ) );
+    EXPECT_EQ ( 1000 , concurrent_hashtable_length ( hashtable ) );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        EXPECT ( _concurrent_hashtable_remove ( hashtable , &i , sizeof ( i ) , &out ) );
+        EXPECT_EQ ( i * i , out );
+    }
+    EXPECT_EQ ( 0 , concurrent_hashtable_length ( hashtable ) );
+    EXPECT_EQ ( 0 , concurrent_hashtable_reclaim ( hashtable ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    concurrent_hashtable_destroy ( &hashtable );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_concurrent_hashtable_concurrent
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    thread_t writers[ TEST_CONCURRENT_HASHTABLE_WRITER_COUNT ];
+    thread_t readers[ TEST_CONCURRENT_HASHTABLE_READER_COUNT ];
+    shared_t shared = { 0 };
+    value_t value;
+
+    // Start small, so the writers resize the hashtable several times.
+    EXPECT ( concurrent_hashtable_create ( sizeof ( value_t ) , 0 , &shared.hashtable ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , shared.hashtable );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 i = 0; i < TEST_CONCURRENT_HASHTABLE_READER_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_concurrent_hashtable_reader , &shared , false , &readers[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_CONCURRENT_HASHTABLE_WRITER_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_concurrent_hashtable_writer , &shared , false , &writers[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_CONCURRENT_HASHTABLE_WRITER_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &writers[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_CONCURRENT_HASHTABLE_READER_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &readers[ i ] ) );
+    }
+
+    // TEST 1: No operation failed, and no query observed a value which was not written for its key.
+    EXPECT_EQ ( 0 , shared.errors );
+
+    // TEST 2: Exactly the even keys remain, each set to its last version.
+    EXPECT_EQ ( TEST_CONCURRENT_HASHTABLE_KEY_COUNT / 2 , concurrent_hashtable_length ( shared.hashtable ) );
+    for ( u64 key = 0; key < TEST_CONCURRENT_HASHTABLE_KEY_COUNT; ++key )
+    {
+        if ( key & 1 )
+        {
+            EXPECT_NOT ( _concurrent_hashtable_contains ( shared.hashtable , &key , sizeof ( key ) ) );
+            continue;
+        }
+        EXPECT ( _concurrent_hashtable_get ( shared.hashtable , &key , sizeof ( key ) , &value ) );
+        EXPECT_EQ ( key , value.key );
+        EXPECT_EQ ( TEST_CONCURRENT_HASHTABLE_ROUND_COUNT - 1 , value.version );
+    }
+
+    // TEST 3: Once no thread is accessing the hashtable, every retired entry can be freed.
+    EXPECT_EQ ( 0 , concurrent_hashtable_reclaim ( shared.hashtable ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    for ( u64 i = 0; i < TEST_CONCURRENT_HASHTABLE_WRITER_COUNT; ++i )
+    {
+        thread_destroy ( &writers[ i ] );
+    }
+    for ( u64 i = 0; i < TEST_CONCURRENT_HASHTABLE_READER_COUNT; ++i )
+    {
+        thread_destroy ( &readers[ i ] );
+    }
+    concurrent_hashtable_destroy ( &shared.hashtable );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_concurrent_hashtable
+( void )
+{
+    test_register ( test_concurrent_hashtable_create_and_destroy , "Creating or destroying a concurrent hashtable." );
+    test_register ( test_concurrent_hashtable_set_get_and_remove , "Testing concurrent hashtable 'set', 'insert', 'get' and 'remove' operations." );
+    test_register_serial ( test_concurrent_hashtable_concurrent , "Testing concurrent hashtable with several reader and writer threads." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_concurrent_hashtable.h
+ * @brief Tests container/concurrent_hashtable.h
+ * (see test/test.h, container/concurrent_hashtable.h for additional details)
+ */
+#ifndef TEST_CONCURRENT_HASHTABLE_H
+#define TEST_CONCURRENT_HASHTABLE_H
+
+#include "test/test.h"
+
+#include "container/concurrent_hashtable.h"
+
+void
+test_register_concurrent_hashtable
+( void );
+
+#endif  // TEST_CONCURRENT_HASHTABLE_H
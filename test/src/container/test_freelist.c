@@ -8,6 +8,7 @@
 
 #include "test/expect.h"
 
+#include "core/logger.h"
 #include "core/memory.h"
 
 /** @brief Type definition for a container to hold allocation info. */
@@ -160,20 +161,61 @@ test_freelist_create_and_clear
 
     memory_free ( memory , memory_requirement , MEMORY_TAG_FREELIST );
 
-    // TEST 5: freelist_destroy handles invalid argument.
+    // TEST 5: Freelist with an explicit number of pre-allocated nodes.
 
     // Copy the current global allocator state prior to the test.
     global_amount_allocated_ = memory_amount_allocated ( MEMORY_TAG_ALL );
     freelist_amount_allocated_ = memory_amount_allocated ( MEMORY_TAG_FREELIST );
     global_allocation_count_ = MEMORY_ALLOCATION_COUNT;
 
-    // TEST 5.1: freelist_destroy does not modify the global allocator state if null handle is provided.
+    // TEST 5.1: The memory requirement does not grow with the capacity.
+    u64 large_memory_requirement = 0;
+    EXPECT ( _freelist_create ( GiB ( 64 ) , FREELIST_MODE_FIRST_FIT , 32 , &large_memory_requirement , 0 , 0 ) );
+    EXPECT ( _freelist_create ( KiB ( 64 ) , FREELIST_MODE_FIRST_FIT , 32 , &memory_requirement , 0 , 0 ) );
+    EXPECT_EQ ( memory_requirement , large_memory_requirement );
+
+    // TEST 5.2: _freelist_create pre-allocates the requested number of nodes (one of which holds the initial free block).
+    freelist = 0;
+    EXPECT ( _freelist_create ( GiB ( 64 ) , FREELIST_MODE_FIRST_FIT , 32 , 0 , 0 , &freelist ) );
+    EXPECT_NEQ ( 0 , freelist );
+    EXPECT_EQ ( 31 , freelist_query_unused_nodes ( freelist ) );
+
+    // TEST 5.3: The node storage grows once the pre-allocated nodes are used up.
+    u64 offsets[ 128 ];
+    for ( u64 i = 0; i < 128; ++i )
+    {
+        EXPECT ( freelist_allocate ( freelist , 64 , &offsets[ i ] ) );
+    }
+    for ( u64 i = 0; i < 128; i += 2 )
+    {
+        EXPECT ( freelist_free ( freelist , 64 , offsets[ i ] ) );
+    }
+    for ( u64 i = 1; i < 128; i += 2 )
+    {
+        EXPECT ( freelist_free ( freelist , 64 , offsets[ i ] ) );
+    }
+    EXPECT_EQ ( GiB ( 64 ) , freelist_query_free ( freelist ) );
+
+    // TEST 5.4: freelist_destroy restores the global allocator state.
+    freelist_destroy ( &freelist );
+    EXPECT_EQ ( global_amount_allocated_ , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( freelist_amount_allocated_ , memory_amount_allocated ( MEMORY_TAG_FREELIST ) );
+    EXPECT_EQ ( global_allocation_count_ , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 6: freelist_destroy handles invalid argument.
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated_ = memory_amount_allocated ( MEMORY_TAG_ALL );
+    freelist_amount_allocated_ = memory_amount_allocated ( MEMORY_TAG_FREELIST );
+    global_allocation_count_ = MEMORY_ALLOCATION_COUNT;
+
+    // TEST 6.1: freelist_destroy does not modify the global allocator state if null handle is provided.
     freelist_destroy ( 0 );
     EXPECT_EQ ( global_amount_allocated_ , memory_amount_allocated ( MEMORY_TAG_ALL ) );
     EXPECT_EQ ( freelist_amount_allocated_ , memory_amount_allocated ( MEMORY_TAG_FREELIST ) );
     EXPECT_EQ ( global_allocation_count_ , MEMORY_ALLOCATION_COUNT );
 
-    // TEST 5.2: freelist_destroy does not modify the global allocator state if provided freelist is null.
+    // TEST 6.2: freelist_destroy does not modify the global allocator state if provided freelist is null.
     freelist = 0;
     freelist_destroy ( &freelist );
     EXPECT_EQ ( global_amount_allocated_ , memory_amount_allocated ( MEMORY_TAG_ALL ) );
@@ -647,6 +689,421 @@ test_freelist_multiple_allocate_and_free_random
     return true;
 }
 
+u8
+test_freelist_segregated_fit_multiple_allocate_and_free_random
+( void )
+{
+    u64 global_amount_allocated;
+    u64 freelist_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    freelist_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FREELIST );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u32 alloc_count = 65556;
+    const u32 max_op = 100000;
+
+    freelist_t* freelist;
+    u32 alloc = 0;
+    u64 allocated = 0;
+    u32 op = 0;
+
+    // Randomize the allocation sizes. Initialize them all with bad offsets so it can be determined later whether or not they have been freed.
+    alloc_t allocs[ 65556 ];
+    memory_clear ( allocs , sizeof ( alloc_t ) * alloc_count );
+    for ( u64 i = 0; i < alloc_count; ++i )
+    {
+        allocs[ i ].size = random2 ( 1 , 65536 );
+        allocs[ i ].offset = INVALID_ID;
+    }
+    u64 size = 0;
+    for (u64 i = 0; i < alloc_count; ++i )
+    {
+        size += allocs[ i ].size;
+    }
+
+    EXPECT ( _freelist_create ( size
+                               , FREELIST_MODE_SEGREGATED_FIT
+                               , 0
+                               , 0
+                               , 0
+                               , &freelist
+                               ));
+
+    // Verify the freelist was initialized with the requested mode.
+    EXPECT_EQ ( FREELIST_MODE_SEGREGATED_FIT , freelist_mode ( freelist ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , freelist );
+
+    // Verify entire freelist is free space prior to the test.
+    EXPECT_EQ ( size , freelist_query_free ( freelist ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // Allocate and free at random, until the maximum number of allowed operations has been reached.
+    while ( op < max_op )
+    {
+        if ( !alloc || random2 ( 0 , 99 ) > 50 )
+        {
+            for (;;)
+            {
+                u32 i = random2 ( 0 , alloc_count - 1 );
+                if ( allocs[ i ].offset == INVALID_ID )
+                {
+                    // TEST 1: freelist_allocate succeeds with random size.
+                    if ( !test_freelist_util_allocate ( freelist , &allocs[ i ] , &allocated , size ) )
+                    {
+                        LOGERROR ( "test_freelist_segregated_fit_multiple_alloc_and_free_random:  test_freelist_util_allocate failed on index: %i." , i );
+                        return false;
+                    }
+                    alloc += 1;
+                    break;
+                }
+            }
+            op += 1;
+        }
+        else
+        {
+            for (;;)
+            {
+                u32 i = random2 ( 0 , alloc_count - 1 );
+                if ( allocs[ i ].offset != INVALID_ID )
+                {
+                    // TEST 2: freelist_free succeeds with random block.
+                    if ( !test_freelist_util_free ( freelist , &allocs[ i ] , &allocated , size ) )
+                    {
+                        LOGERROR ( "test_freelist_segregated_fit_multiple_alloc_and_free_random:  test_freelist_util_free failed on index: %i." , i );
+                        return false;
+                    }
+                    alloc -= 1;
+                    break;
+                }
+            }
+            op += 1;
+        }
+    }
+
+    // Free any remaining blocks.
+    for ( u64 i = 0; i < alloc_count; ++i )
+    {
+        if ( allocs[ i ].offset != INVALID_ID )
+        {
+            if ( !test_freelist_util_free ( freelist , &allocs[ i ] , &allocated , size ) )
+            {
+                LOGERROR ( "test_freelist_segregated_fit_multiple_alloc_and_free_random:  test_freelist_util_free failed on index: %i." , i );
+                return false;
+            }
+        }
+    }
+
+    // TEST 3: Entire freelist is free space once every block has been freed.
+    EXPECT_EQ ( size , freelist_query_free ( freelist ) );
+
+    // TEST 4: Once every block has been freed, adjacent free blocks are merged and the full capacity can be allocated as a single block.
+    u64 offset = INVALID_ID;
+    EXPECT ( freelist_allocate ( freelist , size , &offset ) );
+    EXPECT_EQ ( 0 , offset );
+    EXPECT_EQ ( 0 , freelist_query_free ( freelist ) );
+    EXPECT ( freelist_free ( freelist , size , offset ) );
+    EXPECT_EQ ( size , freelist_query_free ( freelist ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    freelist_destroy ( &freelist );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( freelist_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FREELIST ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    
+    return true;
+}
+
+u8
+test_freelist_extend
+( void )
+{
+    u64 global_amount_allocated;
+    u64 freelist_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    freelist_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FREELIST );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 capacity = 1024;
+
+    freelist_t* freelist;
+    u64 a;
+    u64 b;
+    u64 c;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( FREELIST_MODE mode = 0; mode < FREELIST_MODE_COUNT; ++mode )
+    {
+        freelist = 0;
+        EXPECT ( _freelist_create ( capacity , mode , 0 , 0 , 0 , &freelist ) );
+        EXPECT ( freelist_allocate ( freelist , 64 , &a ) );
+        EXPECT ( freelist_allocate ( freelist , 64 , &b ) );
+        EXPECT ( freelist_allocate ( freelist , 64 , &c ) );
+
+        // TEST 1: freelist_extend fails if the block is not followed by free space.
+        EXPECT_NOT ( freelist_extend ( freelist , 64 , a , 1 ) );
+        EXPECT_EQ ( capacity - 192 , freelist_query_free ( freelist ) );
+
+        // TEST 2: freelist_extend grows a block into the free space which follows it.
+        EXPECT_NOT ( freelist_extend ( freelist , 64 , c , capacity ) );
+        EXPECT ( freelist_extend ( freelist , 64 , c , 64 ) );
+        EXPECT_EQ ( capacity - 256 , freelist_query_free ( freelist ) );
+
+        // TEST 3: freelist_extend can consume the following free block entirely.
+        EXPECT ( freelist_free ( freelist , 64 , b ) );
+        EXPECT ( freelist_extend ( freelist , 64 , a , 64 ) );
+        EXPECT_EQ ( capacity - 256 , freelist_query_free ( freelist ) );
+        EXPECT_NOT ( freelist_extend ( freelist , 128 , a , 1 ) );
+
+        // TEST 4: Extended blocks can be freed with their new size.
+        EXPECT ( freelist_free ( freelist , 128 , a ) );
+        EXPECT ( freelist_free ( freelist , 128 , c ) );
+        EXPECT_EQ ( capacity , freelist_query_free ( freelist ) );
+        EXPECT ( freelist_allocate ( freelist , capacity , &a ) );
+
+        freelist_destroy ( &freelist );
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( freelist_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FREELIST ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    
+    return true;
+}
+
+u8
+test_freelist_fragmentation
+( void )
+{
+    u64 global_amount_allocated;
+    u64 freelist_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    freelist_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FREELIST );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 capacity = 1024;
+    const u64 block_count = 16;
+    const u64 block_size = capacity / block_count;
+
+    freelist_t* freelist;
+    u64 offsets[ 16 ];
+    u64 offset;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( FREELIST_MODE mode = 0; mode < FREELIST_MODE_COUNT; ++mode )
+    {
+        freelist = 0;
+        EXPECT ( _freelist_create ( capacity , mode , 0 , 0 , 0 , &freelist ) );
+
+        // TEST 1: A new freelist is a single free block.
+        EXPECT_EQ ( capacity , freelist_query_largest_free ( freelist ) );
+        EXPECT ( freelist_query_fragmentation ( freelist ) == 0 );
+
+        // TEST 2: A full freelist has no free space and no fragmentation.
+        for ( u64 i = 0; i < block_count; ++i )
+        {
+            EXPECT ( freelist_allocate ( freelist , block_size , &offsets[ i ] ) );
+        }
+        EXPECT_EQ ( 0 , freelist_query_free ( freelist ) );
+        EXPECT_EQ ( 0 , freelist_query_largest_free ( freelist ) );
+        EXPECT ( freelist_query_fragmentation ( freelist ) == 0 );
+
+        // TEST 3: Freeing every other block leaves the free space scattered.
+        for ( u64 i = 0; i < block_count; i += 2 )
+        {
+            EXPECT ( freelist_free ( freelist , block_size , offsets[ i ] ) );
+        }
+        EXPECT_EQ ( capacity / 2 , freelist_query_free ( freelist ) );
+        EXPECT_EQ ( block_size , freelist_query_largest_free ( freelist ) );
+        EXPECT ( freelist_query_fragmentation ( freelist ) == 1.0 - ( ( f64 ) block_size ) / ( ( f64 ) ( capacity / 2 ) ) );
+
+        // TEST 4: Freeing the remaining blocks coalesces them into one.
+        for ( u64 i = 1; i < block_count; i += 2 )
+        {
+            EXPECT ( freelist_free ( freelist , block_size , offsets[ i ] ) );
+        }
+        EXPECT_EQ ( capacity , freelist_query_free ( freelist ) );
+        EXPECT ( freelist_allocate ( freelist , capacity , &offset ) );
+        EXPECT ( freelist_free ( freelist , capacity , offset ) );
+        EXPECT_EQ ( capacity , freelist_query_largest_free ( freelist ) );
+        EXPECT ( freelist_query_fragmentation ( freelist ) == 0 );
+
+        freelist_destroy ( &freelist );
+    }
+
+    EXPECT ( freelist_create ( capacity , 0 , 0 , &freelist ) );
+    for ( u64 i = 0; i < block_count; ++i )
+    {
+        EXPECT ( freelist_allocate ( freelist , block_size , &offsets[ i ] ) );
+    }
+    EXPECT ( freelist_free ( freelist , block_size , offsets[ 2 ] ) );
+    EXPECT ( freelist_free ( freelist , block_size , offsets[ 6 ] ) );
+    EXPECT ( freelist_free ( freelist , block_size , offsets[ 5 ] ) );
+    EXPECT ( freelist_free ( freelist , block_size , offsets[ 9 ] ) );
+    EXPECT ( freelist_free ( freelist , block_size , offsets[ 10 ] ) );
+    EXPECT ( freelist_free ( freelist , block_size , offsets[ 11 ] ) );
+
+    // TEST 5: First-fit mode coalesces on release and allocates from the
+    //         lowest-addressed block which fits.
+    EXPECT_EQ ( 3 * block_size , freelist_query_largest_free ( freelist ) );
+    EXPECT ( freelist_allocate ( freelist , 2 * block_size , &offset ) );
+    EXPECT_EQ ( offsets[ 5 ] , offset );
+    EXPECT ( freelist_allocate ( freelist , block_size , &offset ) );
+    EXPECT_EQ ( offsets[ 2 ] , offset );
+    EXPECT ( freelist_allocate ( freelist , block_size , &offset ) );
+    EXPECT_EQ ( offsets[ 9 ] , offset );
+
+    // TEST 6: First-fit mode detects a double free, or a free which overlaps
+    //         a free block, on release.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( freelist_free ( freelist , block_size , offsets[ 10 ] ) );
+    EXPECT_NOT ( freelist_free ( freelist , 2 * block_size , offsets[ 9 ] ) );
+    EXPECT_NOT ( freelist_free ( freelist , block_size , capacity ) );
+    EXPECT_EQ ( 2 * block_size , freelist_query_free ( freelist ) );
+
+    freelist_destroy ( &freelist );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( freelist_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FREELIST ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    
+    return true;
+}
+
+u8
+test_freelist_node_storage_growth
+( void )
+{
+    u64 global_amount_allocated;
+    u64 freelist_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    freelist_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FREELIST );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    // The node storage of a freelist of this capacity holds 20 nodes.
+    const u64 capacity = 1024;
+    const u64 block_count = 256;
+    const u64 block_size = capacity / block_count;
+
+    freelist_t* freelist;
+    u64 offset;
+    u64 memory_requirement;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( FREELIST_MODE mode = 0; mode < FREELIST_MODE_COUNT; ++mode )
+    {
+        freelist = 0;
+        EXPECT ( _freelist_create ( capacity , mode , 0 , 0 , 0 , &freelist ) );
+        for ( u64 i = 0; i < block_count; ++i )
+        {
+            EXPECT ( freelist_allocate ( freelist , block_size , &offset ) );
+        }
+
+        // TEST 1: A freelist which owns its memory grows its node storage to
+        //         track any number of free blocks.
+        for ( u64 i = 0; i < block_count; i += 2 )
+        {
+            EXPECT ( freelist_free ( freelist , block_size , i * block_size ) );
+        }
+        EXPECT_EQ ( capacity / 2 , freelist_query_free ( freelist ) );
+        EXPECT_EQ ( block_size , freelist_query_largest_free ( freelist ) );
+
+        // TEST 2: freelist_resize keeps the free blocks tracked by the
+        //         additional node storage.
+        EXPECT ( freelist_resize ( &freelist , 2 * capacity , 0 , 0 , 0 ) );
+        EXPECT_EQ ( capacity + capacity / 2 , freelist_query_free ( freelist ) );
+        for ( u64 i = 1; i < block_count; i += 2 )
+        {
+            EXPECT ( freelist_free ( freelist , block_size , i * block_size ) );
+        }
+        EXPECT_EQ ( 2 * capacity , freelist_query_free ( freelist ) );
+        EXPECT ( freelist_allocate ( freelist , 2 * capacity , &offset ) );
+        EXPECT_EQ ( 0 , offset );
+
+        freelist_destroy ( &freelist );
+    }
+
+    // TEST 3: A pre-allocated freelist runs out of nodes, and may be supplied
+    //         with more.
+    EXPECT ( freelist_create ( capacity , &memory_requirement , 0 , 0 ) );
+    void* memory = memory_allocate ( memory_requirement , MEMORY_TAG_FREELIST );
+    const u64 nodes_size = freelist_node_size ( block_count );
+    void* nodes = memory_allocate ( nodes_size , MEMORY_TAG_FREELIST );
+    EXPECT ( freelist_create ( capacity , &memory_requirement , memory , &freelist ) );
+    for ( u64 i = 0; i < block_count; ++i )
+    {
+        EXPECT ( freelist_allocate ( freelist , block_size , &offset ) );
+    }
+    u64 i = 0;
+    while ( freelist_query_unused_nodes ( freelist ) )
+    {
+        EXPECT ( freelist_free ( freelist , block_size , i * block_size ) );
+        i += 2;
+    }
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( freelist_free ( freelist , block_size , i * block_size ) );
+    EXPECT ( freelist_add_nodes ( freelist , nodes , nodes_size ) );
+    EXPECT_EQ ( block_count , freelist_query_unused_nodes ( freelist ) );
+    for ( ; i < block_count; i += 2 )
+    {
+        EXPECT ( freelist_free ( freelist , block_size , i * block_size ) );
+    }
+    EXPECT_EQ ( capacity / 2 , freelist_query_free ( freelist ) );
+
+    // TEST 4: freelist_reset releases every node of the additional node
+    //         storage.
+    freelist_reset ( freelist );
+    EXPECT_EQ ( capacity , freelist_query_free ( freelist ) );
+    EXPECT ( freelist_query_unused_nodes ( freelist ) >= block_count );
+
+    freelist_destroy ( &freelist );
+    memory_free ( nodes , nodes_size , MEMORY_TAG_FREELIST );
+    memory_free ( memory , memory_requirement , MEMORY_TAG_FREELIST );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( freelist_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FREELIST ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    
+    return true;
+}
+
 void
 test_register_freelist
 ( void )
@@ -657,4 +1114,8 @@ test_register_freelist
     test_register ( test_freelist_allocate_one_and_free_multiple_varying_sizes , "Testing freelist with multiple allocations and frees of varying sizes." );
     test_register ( test_freelist_allocate_until_full_and_fail_to_allocate_more , "Testing freelist overflow handling." );
     test_register ( test_freelist_multiple_allocate_and_free_random , "Testing freelist with multiple random-sized allocations, each freed in random order." );
+    test_register ( test_freelist_segregated_fit_multiple_allocate_and_free_random , "Testing segregated-fit freelist with multiple random-sized allocations, each freed in random order." );
+    test_register ( test_freelist_extend , "Growing a freelist block in place." );
+    test_register ( test_freelist_fragmentation , "Querying freelist fragmentation and coalescing free blocks." );
+    test_register ( test_freelist_node_storage_growth , "Growing freelist node storage." );
 }
\ No newline at end of file
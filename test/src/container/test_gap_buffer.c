@@ -0,0 +1,212 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_gap_buffer.c
+ * @brief Implementation of the container/test_gap_buffer header.
+ * (see container/test_gap_buffer.h for additional details)
+ */
+#include "container/test_gap_buffer.h"
+
+#include "test/expect.h"
+
+#include "container/string.h"
+
+#include "core/memory.h"
+
+#include "math/math.h"
+
+u8
+test_gap_buffer_edit
+( void )
+{
+    u64 global_amount_allocated;
+    u64 string_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    string_amount_allocated = memory_amount_allocated ( MEMORY_TAG_STRING );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    gap_buffer_t* buffer = gap_buffer_create_from ( "Hello world" );
+    string_view_t before;
+    string_view_t after;
+    char read[ 32 ];
+    char* string;
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , buffer );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: gap_buffer_create_from copies the text, with the cursor at its end.
+    EXPECT_EQ ( 11 , gap_buffer_length ( buffer ) );
+    EXPECT_EQ ( 11 , gap_buffer_cursor ( buffer ) );
+
+    // TEST 2: gap_buffer_insert inserts text, and leaves the cursor after it.
+    EXPECT ( gap_buffer_insert ( buffer , 5 , "," , 1 ) );
+    EXPECT_EQ ( 12 , gap_buffer_length ( buffer ) );
+    EXPECT_EQ ( 6 , gap_buffer_cursor ( buffer ) );
+    EXPECT_EQ ( ',' , gap_buffer_get ( buffer , 5 ) );
+    EXPECT_EQ ( ' ' , gap_buffer_get ( buffer , 6 ) );
+
+    // TEST 3: gap_buffer_segments splits the text at the cursor.
+    gap_buffer_segments ( buffer , &before , &after );
+    EXPECT_EQ ( 6 , before.length );
+    EXPECT ( memory_equal ( before.string , "Hello," , 6 ) );
+    EXPECT_EQ ( 6 , after.length );
+    EXPECT ( memory_equal ( after.string , " world" , 6 ) );
+
+    // TEST 4: gap_buffer_replace replaces a range of text.
+    EXPECT ( gap_buffer_replace ( buffer , 7 , 5 , "there!" , 6 ) );
+    EXPECT_EQ ( 13 , gap_buffer_length ( buffer ) );
+    EXPECT_EQ ( 13 , gap_buffer_cursor ( buffer ) );
+
+    // TEST 5: gap_buffer_remove removes a range of text, and leaves the cursor in its place.
+    EXPECT ( gap_buffer_remove ( buffer , 0 , 7 ) );
+    EXPECT_EQ ( 6 , gap_buffer_length ( buffer ) );
+    EXPECT_EQ ( 0 , gap_buffer_cursor ( buffer ) );
+
+    // TEST 6: gap_buffer_read copies a range which spans the gap.
+    gap_buffer_move ( buffer , 3 );
+    EXPECT_EQ ( 3 , gap_buffer_cursor ( buffer ) );
+    EXPECT ( gap_buffer_read ( buffer , 1 , 4 , read ) );
+    EXPECT ( memory_equal ( read , "here" , 4 ) );
+
+    // TEST 7: gap_buffer_move clamps the cursor to the length.
+    gap_buffer_move ( buffer , 100 );
+    EXPECT_EQ ( 6 , gap_buffer_cursor ( buffer ) );
+
+    // TEST 8: gap_buffer_flatten copies the text into a resizable string.
+    gap_buffer_move ( buffer , 2 );
+    string = gap_buffer_flatten ( buffer );
+    EXPECT_EQ ( 6 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "there!" , 7 ) );
+    string_destroy ( string );
+
+    // TEST 9: Edits with out of bounds ranges fail, and leave the text unmodified.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( gap_buffer_insert ( buffer , 7 , "x" , 1 ) );
+    EXPECT_NOT ( gap_buffer_remove ( buffer , 2 , 5 ) );
+    EXPECT_NOT ( gap_buffer_replace ( buffer , 7 , 0 , "x" , 1 ) );
+    EXPECT_NOT ( gap_buffer_read ( buffer , 6 , 1 , read ) );
+    EXPECT_EQ ( 6 , gap_buffer_length ( buffer ) );
+    EXPECT ( gap_buffer_read ( buffer , 0 , 6 , read ) );
+    EXPECT ( memory_equal ( read , "there!" , 6 ) );
+
+    // TEST 10: An empty gap buffer.
+    gap_buffer_destroy ( buffer );
+    buffer = gap_buffer_create ();
+    EXPECT_EQ ( 0 , gap_buffer_length ( buffer ) );
+    string = gap_buffer_flatten ( buffer );
+    EXPECT_EQ ( 0 , string_length ( string ) );
+    EXPECT_EQ ( 0 , string[ 0 ] );
+    string_destroy ( string );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    gap_buffer_destroy ( buffer );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( string_amount_allocated , memory_amount_allocated ( MEMORY_TAG_STRING ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_gap_buffer_edit_random
+( void )
+{
+    u64 global_amount_allocated;
+    u64 string_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    string_amount_allocated = memory_amount_allocated ( MEMORY_TAG_STRING );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 op_count = 10000;
+    gap_buffer_t* buffer = _gap_buffer_create ( 0 , 0 , 1 );
+    char* expected = string_create ();
+    char src[ 16 ];
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , buffer );
+    EXPECT_NEQ ( 0 , expected );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A random sequence of edits produces the same text as the same edits to a resizable string.
+    for ( u64 i = 0; i < op_count; ++i )
+    {
+        const u64 length = string_length ( expected );
+        const u64 index = random2 ( 0 , length );
+        const u64 count = MIN ( ( u64 ) random2 ( 0 , 8 ) , length - index );
+        const u64 src_length = random2 ( 0 , sizeof ( src ) );
+        for ( u64 j = 0; j < src_length; ++j )
+        {
+            src[ j ] = random2 ( 'a' , 'z' );
+        }
+
+        switch ( random2 ( 0 , 2 ) )
+        {
+            case 0:
+            {
+                EXPECT ( gap_buffer_insert ( buffer , index , src , src_length ) );
+                string_insert ( expected , index , src , src_length );
+            }
+            break;
+
+            case 1:
+            {
+                EXPECT ( gap_buffer_remove ( buffer , index , count ) );
+                string_remove ( expected , index , count );
+            }
+            break;
+
+            default:
+            {
+                EXPECT ( gap_buffer_replace ( buffer , index , count , src , src_length ) );
+                string_remove ( expected , index , count );
+                string_insert ( expected , index , src , src_length );
+            }
+            break;
+        }
+        EXPECT_EQ ( string_length ( expected ) , gap_buffer_length ( buffer ) );
+    }
+
+    char* string = gap_buffer_flatten ( buffer );
+    EXPECT_EQ ( string_length ( expected ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , expected , string_length ( expected ) + 1 ) );
+    for ( u64 i = 0; i < string_length ( expected ); ++i )
+    {
+        EXPECT_EQ ( expected[ i ] , gap_buffer_get ( buffer , i ) );
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    string_destroy ( string );
+    string_destroy ( expected );
+    gap_buffer_destroy ( buffer );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( string_amount_allocated , memory_amount_allocated ( MEMORY_TAG_STRING ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_gap_buffer
+( void )
+{
+    test_register ( test_gap_buffer_edit , "Testing gap buffer 'insert', 'remove', 'replace' and 'flatten' operations." );
+    test_register ( test_gap_buffer_edit_random , "Testing gap buffer edits with random indices and text." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_gap_buffer.h
+ * @brief Tests container/gap_buffer.h
+ * (see test/test.h, container/gap_buffer.h for additional details)
+ */
+#ifndef TEST_GAP_BUFFER_H
+#define TEST_GAP_BUFFER_H
+
+#include "test/test.h"
+
+#include "container/gap_buffer.h"
+
+void
+test_register_gap_buffer
+( void );
+
+#endif  // TEST_GAP_BUFFER_H
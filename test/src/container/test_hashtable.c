@@ -8,10 +8,17 @@
 
 #include "test/expect.h"
 
+#include "core/image.h"
+#include "core/logger.h"
 #include "core/memory.h"
 
 #include "math/math.h"
 
+#include "platform/filesystem.h"
+
+/** @brief Path of the hashtable image written and mapped by the tests. */
+#define FILE_NAME_TEST_OUT_IMAGE "test/assets/out-image"
+
 u8
 test_hashtable_create_and_destroy
 ( void )
@@ -496,16 +503,16 @@ test_hashtable_get_nonexistent
     // Set a key-value pair within a hashtable.
     EXPECT ( hashtable_set ( hashtable , "key0" , &values[ 0 ] ) );
 
-    // TEST 1: hashtable_get succeeds even when the provided key cannot be found within the hashtable.
+    // TEST 1: hashtable_get fails when the provided key cannot be found within the hashtable.
     get = 0;
-    EXPECT ( hashtable_get ( hashtable , "key1" , &get ) );
+    EXPECT_NOT ( hashtable_get ( hashtable , "key1" , &get ) );
 
     // TEST 2: hashtable_get does not modify the output buffer if the provided key could not be found.
     EXPECT_EQ ( 0 , get );
 
-    // TEST 3: hashtable_get succeeds even when the provided key cannot be found within the hashtable.
+    // TEST 3: hashtable_get fails when the provided key cannot be found within the hashtable.
     get = 0;
-    EXPECT ( hashtable_get ( hashtable , "key2" , &get ) );
+    EXPECT_NOT ( hashtable_get ( hashtable , "key2" , &get ) );
 
     // TEST 4: hashtable_get does not modify the output buffer if the provided key could not be found.
     EXPECT_EQ ( 0 , get );
@@ -602,6 +609,514 @@ test_hashtable_remove_pointer
     return true;
 }
 
+u8
+test_hashtable_binary_keys_and_growth
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u32 initial_capacity = 4;
+    const u64 key_count = 10000;
+
+    hashtable_t* hashtable = 0;
+    u64 key[ 4 ];
+    u64 get;
+    u64 memory_requirement;
+    void* memory;
+
+    EXPECT ( hashtable_create ( false , sizeof ( u64 ) , initial_capacity , 0 , 0 , &hashtable ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , hashtable );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: _hashtable_set succeeds for binary keys of varying length, including keys which are stored inline, keys which require an additional memory allocation, and keys containing null bytes. The hashtable grows to accommodate them.
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        key[ 0 ] = i;
+        key[ 1 ] = 0;
+        key[ 2 ] = 0;
+        key[ 3 ] = 0;
+        const u64 key_length = 8 + i % ( sizeof ( key ) - 7 );
+        const u64 value = i * i;
+        EXPECT ( _hashtable_set ( hashtable , key , key_length , &value ) );
+    }
+    EXPECT_EQ ( key_count , hashtable_length ( hashtable ) );
+    EXPECT ( hashtable_capacity ( hashtable ) >= key_count );
+
+    // TEST 2: _hashtable_get retrieves the correct value for every key.
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        key[ 0 ] = i;
+        const u64 key_length = 8 + i % ( sizeof ( key ) - 7 );
+        get = 0;
+        EXPECT ( _hashtable_get ( hashtable , key , key_length , &get ) );
+        EXPECT_EQ ( i * i , get );
+    }
+
+    // TEST 3: _hashtable_set overwrites the value of a key which is already present, without inserting another key.
+    key[ 0 ] = 0;
+    get = 7;
+    EXPECT ( _hashtable_set ( hashtable , key , sizeof ( u64 ) , &get ) );
+    EXPECT_EQ ( key_count , hashtable_length ( hashtable ) );
+    get = 0;
+    EXPECT ( _hashtable_get ( hashtable , key , sizeof ( u64 ) , &get ) );
+    EXPECT_EQ ( 7 , get );
+
+    // TEST 4: hashtable_iterate visits every key exactly once.
+    u64 iterator = 0;
+    u64 visited = 0;
+    const void* iterator_key;
+    u64 iterator_key_length;
+    while ( hashtable_iterate ( hashtable , &iterator , &iterator_key , &iterator_key_length , &get ) )
+    {
+        const u64 i = *( ( const u64* ) iterator_key );
+        EXPECT_EQ ( 8 + i % ( sizeof ( key ) - 7 ) , iterator_key_length );
+        EXPECT_EQ ( ( i ) ? i * i : 7 , get );
+        visited += 1;
+    }
+    EXPECT_EQ ( key_count , visited );
+
+    // TEST 5: _hashtable_remove removes every even key, and writes its value to the output buffer.
+    for ( u64 i = 0; i < key_count; i += 2 )
+    {
+        key[ 0 ] = i;
+        get = 0;
+        EXPECT ( _hashtable_remove ( hashtable , key , 8 + i % ( sizeof ( key ) - 7 ) , &get ) );
+        EXPECT_EQ ( ( i ) ? i * i : 7 , get );
+    }
+    EXPECT_EQ ( key_count / 2 , hashtable_length ( hashtable ) );
+
+    // TEST 6: Removed keys are no longer present; all other keys are unaffected.
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        key[ 0 ] = i;
+        const u64 key_length = 8 + i % ( sizeof ( key ) - 7 );
+        if ( i % 2 )
+        {
+            EXPECT ( _hashtable_contains ( hashtable , key , key_length ) );
+        }
+        else
+        {
+            EXPECT_NOT ( _hashtable_contains ( hashtable , key , key_length ) );
+            EXPECT_NOT ( _hashtable_remove ( hashtable , key , key_length , 0 ) );
+        }
+    }
+
+    hashtable_destroy ( &hashtable );
+
+    // TEST 7: A pre-allocated hashtable fails to insert once full, but may still overwrite or remove existing keys.
+    EXPECT ( hashtable_create ( false , sizeof ( u64 ) , initial_capacity , &memory_requirement , 0 , 0 ) );
+    memory = memory_allocate ( memory_requirement , MEMORY_TAG_HASHTABLE );
+    EXPECT ( hashtable_create ( false , sizeof ( u64 ) , initial_capacity , 0 , memory , &hashtable ) );
+    for ( u64 i = 0; i < initial_capacity; ++i )
+    {
+        EXPECT ( _hashtable_set ( hashtable , &i , sizeof ( i ) , &i ) );
+    }
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( hashtable_set ( hashtable , "key" , &get ) );
+    key[ 0 ] = 0;
+    EXPECT ( _hashtable_set ( hashtable , key , sizeof ( u64 ) , &get ) );
+    EXPECT ( _hashtable_remove ( hashtable , key , sizeof ( u64 ) , 0 ) );
+    EXPECT ( hashtable_set ( hashtable , "key" , &get ) );
+    EXPECT ( hashtable_contains ( hashtable , "key" ) );
+    EXPECT_EQ ( initial_capacity , hashtable_length ( hashtable ) );
+    hashtable_destroy ( &hashtable );
+    memory_free ( memory , memory_requirement , MEMORY_TAG_HASHTABLE );
+
+    // TEST 8: A string view may be used as a key, without terminating or copying the substring it refers to.
+    const string_view_t words = _string_view ( "alpha beta gamma" );
+    EXPECT ( hashtable_create ( false , sizeof ( u64 ) , initial_capacity , 0 , 0 , &hashtable ) );
+    get = 6;
+    EXPECT ( hashtable_set_view ( hashtable , string_view_slice ( words , 6 , 4 ) , &get ) );
+    EXPECT ( hashtable_contains ( hashtable , "beta" ) );
+    get = 0;
+    EXPECT ( hashtable_get_view ( hashtable , _string_view ( "beta" ) , &get ) );
+    EXPECT_EQ ( 6 , get );
+    EXPECT_NOT ( hashtable_contains_view ( hashtable , string_view_slice ( words , 6 , 5 ) ) );
+    EXPECT ( hashtable_remove_view ( hashtable , string_view_slice ( words , 6 , 4 ) , 0 ) );
+    EXPECT_EQ ( 0 , hashtable_length ( hashtable ) );
+    hashtable_destroy ( &hashtable );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_hashtable_batch
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 key_count = 1000;
+    const u64 probe_count = 2 * key_count;
+
+    hashtable_t* hashtable = 0;
+    u64* keys = memory_allocate ( sizeof ( u64 ) * probe_count , MEMORY_TAG_ARRAY );
+    u64* values = memory_allocate ( sizeof ( u64 ) * probe_count , MEMORY_TAG_ARRAY );
+    bool* found = memory_allocate ( sizeof ( bool ) * probe_count , MEMORY_TAG_ARRAY );
+    void* pointers[ 3 ];
+    void* get;
+
+    for ( u64 i = 0; i < probe_count; ++i )
+    {
+        keys[ i ] = i * 7919;
+        values[ i ] = i * i;
+    }
+
+    EXPECT ( hashtable_create ( false , sizeof ( u64 ) , 4 , 0 , 0 , &hashtable ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , hashtable );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: hashtable_set_batch sets every key, growing the hashtable as needed.
+    EXPECT ( hashtable_set_batch ( hashtable , keys , sizeof ( u64 ) , key_count , values ) );
+    EXPECT_EQ ( key_count , hashtable_length ( hashtable ) );
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        u64 value = 0;
+        EXPECT ( _hashtable_get ( hashtable , &keys[ i ] , sizeof ( u64 ) , &value ) );
+        EXPECT_EQ ( i * i , value );
+    }
+
+    // TEST 2: hashtable_get_batch retrieves the value of every key which is present, and reports which are.
+    memory_clear ( values , sizeof ( u64 ) * probe_count );
+    EXPECT_EQ ( key_count , hashtable_get_batch ( hashtable , keys , sizeof ( u64 ) , probe_count , values , found ) );
+    for ( u64 i = 0; i < probe_count; ++i )
+    {
+        EXPECT_EQ ( i < key_count , found[ i ] );
+        EXPECT_EQ ( ( i < key_count ) ? i * i : 0 , values[ i ] );
+    }
+
+    // TEST 3: hashtable_get_batch may be used to count the keys which are present.
+    EXPECT_EQ ( key_count / 2 , hashtable_get_batch ( hashtable , &keys[ key_count / 2 ] , sizeof ( u64 ) , key_count , 0 , 0 ) );
+    EXPECT_EQ ( 0 , hashtable_get_batch ( hashtable , keys , sizeof ( u64 ) , 0 , 0 , 0 ) );
+
+    // TEST 4: hashtable_set_batch overwrites the values of keys which are already present.
+    EXPECT ( hashtable_set_batch ( hashtable , keys , sizeof ( u64 ) , key_count , &keys[ key_count ] ) );
+    EXPECT_EQ ( key_count , hashtable_length ( hashtable ) );
+    EXPECT_EQ ( key_count , hashtable_get_batch ( hashtable , keys , sizeof ( u64 ) , key_count , values , 0 ) );
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        EXPECT_EQ ( keys[ key_count + i ] , values[ i ] );
+    }
+
+    hashtable_destroy ( &hashtable );
+
+    // TEST 5: The values of a batch set into a pointer-valued hashtable are an array of pointers.
+    pointers[ 0 ] = &keys[ 0 ];
+    pointers[ 1 ] = 0;
+    pointers[ 2 ] = &keys[ 2 ];
+    EXPECT ( hashtable_create ( true , 0 , 4 , 0 , 0 , &hashtable ) );
+    EXPECT ( hashtable_set_batch ( hashtable , "abc" , 1 , 3 , pointers ) );
+    EXPECT ( hashtable_get ( hashtable , "b" , &get ) );
+    EXPECT_EQ ( 0 , get );
+    EXPECT ( hashtable_get ( hashtable , "c" , &get ) );
+    EXPECT_EQ ( &keys[ 2 ] , get );
+    hashtable_destroy ( &hashtable );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    memory_free ( keys , sizeof ( u64 ) * probe_count , MEMORY_TAG_ARRAY );
+    memory_free ( values , sizeof ( u64 ) * probe_count , MEMORY_TAG_ARRAY );
+    memory_free ( found , sizeof ( bool ) * probe_count , MEMORY_TAG_ARRAY );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+/**
+ * @brief Hash function which maps every key to the same hashcode.
+ * Used to force collisions.
+ */
+u64
+test_hashtable_constant_hash
+(   const void* data
+,   const u64   size
+,   const u64   seed
+)
+{
+    return seed;
+}
+
+u8
+test_hashtable_hash_function
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 key_count = 257;
+    u8 data[ 257 ];
+    u64 hashes[ 257 ];
+    hashtable_t* hashtable = 0;
+    u64 get;
+
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        data[ i ] = random2 ( 0 , 255 );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: hash64 is deterministic, and sensitive to the seed.
+    EXPECT_EQ ( hash64 ( data , key_count , 1 ) , hash64 ( data , key_count , 1 ) );
+    EXPECT_NEQ ( hash64 ( data , key_count , 1 ) , hash64 ( data , key_count , 2 ) );
+
+    // TEST 2: hash64 produces distinct hashes for every prefix of the data (covers each of its code paths for short and long inputs).
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        hashes[ i ] = hash64 ( data , i , 0 );
+        for ( u64 j = 0; j < i; ++j )
+        {
+            EXPECT_NEQ ( hashes[ j ] , hashes[ i ] );
+        }
+    }
+
+    // TEST 3: hash64 reads every byte of the input.
+    for ( u64 i = 0; i < key_count - 1; ++i )
+    {
+        data[ i ] ^= 1;
+        EXPECT_NEQ ( hashes[ key_count - 1 ] , hash64 ( data , key_count - 1 , 0 ) );
+        data[ i ] ^= 1;
+    }
+
+    // TEST 4: _hashtable_create uses the provided hash function and seed.
+    EXPECT ( _hashtable_create ( false , sizeof ( u64 ) , 4 , test_hashtable_constant_hash , 3 , 0 , 0 , &hashtable ) );
+    EXPECT_NEQ ( 0 , hashtable );
+    EXPECT_EQ ( 3 , hashtable_seed ( hashtable ) );
+
+    // TEST 5: A hashtable remains correct even if every key collides.
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        EXPECT ( _hashtable_set ( hashtable , &i , sizeof ( i ) , &i ) );
+    }
+    for ( u64 i = 0; i < key_count; i += 3 )
+    {
+        EXPECT ( _hashtable_remove ( hashtable , &i , sizeof ( i ) , 0 ) );
+    }
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        get = INVALID_ID;
+        if ( i % 3 )
+        {
+            EXPECT ( _hashtable_get ( hashtable , &i , sizeof ( i ) , &get ) );
+            EXPECT_EQ ( i , get );
+        }
+        else
+        {
+            EXPECT_NOT ( _hashtable_get ( hashtable , &i , sizeof ( i ) , &get ) );
+            EXPECT_EQ ( INVALID_ID , get );
+        }
+    }
+    hashtable_destroy ( &hashtable );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_hashtable_image
+( void )
+{
+    u64 global_amount_allocated;
+    u64 hashtable_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    hashtable_amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    // Values with padding, and keys both shorter and longer than
+    // HASHTABLE_KEY_INLINE_CAPACITY.
+    typedef struct
+    {
+        u32 a;
+        u64 b;
+    }
+    value_t;
+    const u64 key_count = 2000;
+    u8 key[ 40 ];
+    value_t value;
+    hashtable_t* hashtable;
+    hashtable_t* loaded;
+    u64 image_size;
+    u64 memory_requirement;
+    u64 written;
+    file_t file;
+    file_map_t map;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    EXPECT ( hashtable_create ( false , sizeof ( value_t ) , 1 , 0 , 0 , &hashtable ) );
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        memory_set ( key , ( u8 ) i , sizeof ( key ) );
+        memory_copy ( key , &i , sizeof ( i ) );
+        value.a = i;
+        value.b = ~i;
+        EXPECT ( _hashtable_set ( hashtable , key , 8 + i % 33 , &value ) );
+    }
+    for ( u64 i = 0; i < key_count; i += 7 )
+    {
+        memory_set ( key , ( u8 ) i , sizeof ( key ) );
+        memory_copy ( key , &i , sizeof ( i ) );
+        EXPECT ( _hashtable_remove ( hashtable , key , 8 + i % 33 , 0 ) );
+    }
+
+    // TEST 1: hashtable_to_image reports the image size, then writes the image.
+    EXPECT ( hashtable_to_image ( hashtable , &image_size , 0 ) );
+    EXPECT ( image_size > IMAGE_HEADER_SIZE );
+    u8* image = memory_allocate_aligned ( image_size , 8 , MEMORY_TAG_ARRAY );
+    EXPECT ( hashtable_to_image ( hashtable , &image_size , image ) );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_IMAGE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( file_write ( &file , image_size , image , &written ) );
+    EXPECT_EQ ( image_size , written );
+    file_close ( &file );
+
+    // TEST 2: A hashtable created from a mapped image holds every key and value, and allocates only its internal state.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_IMAGE , FILE_MODE_READ , &file ) );
+    EXPECT ( file_map ( &file , FILE_MODE_READ , FILE_MAP_HINT_RANDOM , &map ) );
+    EXPECT_EQ ( image_size , map.size );
+    const u64 amount_allocated = memory_amount_allocated ( MEMORY_TAG_HASHTABLE );
+    EXPECT ( hashtable_create_from_image ( map.data , map.size , sizeof ( value_t ) , true , 0 , 0 , &loaded ) );
+    EXPECT ( memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) - amount_allocated < 256 );
+    EXPECT ( hashtable_read_only ( loaded ) );
+    EXPECT_NOT ( hashtable_read_only ( hashtable ) );
+    EXPECT_EQ ( hashtable_length ( hashtable ) , hashtable_length ( loaded ) );
+    EXPECT_EQ ( hashtable_capacity ( hashtable ) , hashtable_capacity ( loaded ) );
+    EXPECT_EQ ( hashtable_seed ( hashtable ) , hashtable_seed ( loaded ) );
+    for ( u64 i = 0; i < key_count; ++i )
+    {
+        memory_set ( key , ( u8 ) i , sizeof ( key ) );
+        memory_copy ( key , &i , sizeof ( i ) );
+        if ( !( i % 7 ) )
+        {
+            EXPECT_NOT ( _hashtable_contains ( loaded , key , 8 + i % 33 ) );
+            continue;
+        }
+        EXPECT ( _hashtable_get ( loaded , key , 8 + i % 33 , &value ) );
+        EXPECT_EQ ( i , value.a );
+        EXPECT_EQ ( ~i , value.b );
+    }
+    u64 iterator = 0;
+    u64 count = 0;
+    const void* key_;
+    u64 key_length;
+    while ( hashtable_iterate ( loaded , &iterator , &key_ , &key_length , &value ) )
+    {
+        EXPECT ( _hashtable_get ( hashtable , key_ , key_length , 0 ) );
+        count += 1;
+    }
+    EXPECT_EQ ( hashtable_length ( hashtable ) , count );
+
+    // TEST 3: A hashtable created from an image is read-only.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( _hashtable_set ( loaded , key , 8 , &value ) );
+    EXPECT_NOT ( hashtable_set_batch ( loaded , key , 8 , 1 , &value ) );
+    EXPECT_NOT ( _hashtable_remove ( loaded , key , 8 , 0 ) );
+    EXPECT_NOT ( hashtable_fill ( loaded , &value ) );
+
+    // TEST 4: An image of a hashtable created from an image is identical to the original image.
+    u64 image_size_;
+    EXPECT ( hashtable_to_image ( loaded , &image_size_ , 0 ) );
+    EXPECT_EQ ( image_size , image_size_ );
+    u8* image_ = memory_allocate_aligned ( image_size , 8 , MEMORY_TAG_ARRAY );
+    EXPECT ( hashtable_to_image ( loaded , &image_size , image_ ) );
+    EXPECT ( memory_equal ( image , image_ , image_size ) );
+    memory_free_aligned ( image_ , image_size , 8 , MEMORY_TAG_ARRAY );
+
+    // TEST 5: hashtable_destroy frees only the internal state.
+    hashtable_destroy ( &loaded );
+    EXPECT_EQ ( amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+
+    // TEST 6: _hashtable_create_from_image with a pre-allocated buffer.
+    EXPECT ( hashtable_create_from_image ( map.data , map.size , sizeof ( value_t ) , false , &memory_requirement , 0 , 0 ) );
+    void* memory = memory_allocate ( memory_requirement , MEMORY_TAG_HASHTABLE );
+    EXPECT ( hashtable_create_from_image ( map.data , map.size , sizeof ( value_t ) , false , &memory_requirement , memory , &loaded ) );
+    EXPECT_NOT ( hashtable_owns_memory ( loaded ) );
+    EXPECT ( _hashtable_get ( loaded , key , 8 + ( key_count - 1 ) % 33 , 0 ) );
+    hashtable_destroy ( &loaded );
+    memory_free ( memory , memory_requirement , MEMORY_TAG_HASHTABLE );
+
+    // TEST 7: An image is rejected if its stride or hash function differs, or it is damaged or truncated.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( hashtable_create_from_image ( map.data , map.size , sizeof ( u64 ) , false , 0 , 0 , &loaded ) );
+    EXPECT_NOT ( _hashtable_create_from_image ( map.data , map.size , sizeof ( value_t ) , hash_polynomial , false , 0 , 0 , &loaded ) );
+    EXPECT_NOT ( hashtable_create_from_image ( map.data , map.size - 1 , sizeof ( value_t ) , false , 0 , 0 , &loaded ) );
+    image[ image_size - 1 ] ^= 1;
+    EXPECT_NOT ( hashtable_create_from_image ( image , image_size , sizeof ( value_t ) , true , 0 , 0 , &loaded ) );
+    EXPECT_NOT ( hashtable_create_from_image ( image + 1 , image_size - 1 , sizeof ( value_t ) , false , 0 , 0 , &loaded ) );
+    EXPECT_EQ ( amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+
+    file_unmap ( &map );
+    file_close ( &file );
+    memory_free_aligned ( image , image_size , 8 , MEMORY_TAG_ARRAY );
+    hashtable_destroy ( &hashtable );
+
+    // TEST 8: Images of pointer-valued hashtables are not supported.
+    EXPECT ( hashtable_create ( true , 0 , 1 , 0 , 0 , &hashtable ) );
+    EXPECT_NOT ( hashtable_to_image ( hashtable , &image_size , 0 ) );
+    hashtable_destroy ( &hashtable );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( hashtable_amount_allocated , memory_amount_allocated ( MEMORY_TAG_HASHTABLE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 void
 test_register_hashtable
 ( void )
@@ -611,4 +1126,8 @@ test_register_hashtable
     test_register ( test_hashtable_set_and_get_pointer , "Testing 'set' and 'get' operations on a pointer-valued hashtable." );
     test_register ( test_hashtable_get_nonexistent , "Testing hashtable 'get' operation with an argument that cannot be found within the hashtable." );
     test_register ( test_hashtable_remove_pointer , "Testing the ability to remove a pointer value within a pointer-valued hashtable." );
+    test_register ( test_hashtable_binary_keys_and_growth , "Testing hashtable 'set', 'get', 'remove' and 'iterate' operations with many binary keys of varying length." );
+    test_register ( test_hashtable_batch , "Testing hashtable batch 'set' and 'get' operations." );
+    test_register ( test_hashtable_hash_function , "Testing hash64, and hashtables with a user-provided hash function." );
+    test_register_serial ( test_hashtable_image , "Writing a hashtable image, and using it in place from a mapped file." );
 }
\ No newline at end of file
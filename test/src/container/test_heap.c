@@ -0,0 +1,320 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_heap.c
+ * @brief Implementation of the container/test_heap header.
+ * (see container/test_heap.h for additional details)
+ */
+#include "container/test_heap.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "math/math.h"
+
+#define TEST_HEAP_ELEMENT_COUNT ( ( u64 ) 1000 )
+
+/** @brief Type definition for a test element ordered by priority. */
+typedef struct
+{
+    u64 priority;
+    u64 id;
+}
+element_t;
+
+/** @brief Comparator: orders i32 values in descending order. */
+i32
+test_heap_comparator_descending
+(   const void* a
+,   const void* b
+)
+{
+    const i32 a_ = *( ( i32* ) a );
+    const i32 b_ = *( ( i32* ) b );
+    return ( a_ > b_ ) ? -1 : ( a_ < b_ ) ? 1 : 0;
+}
+
+u8
+test_heap_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    heap_t* heap;
+    i32 value;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: heap_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( _heap_create ( 1 , sizeof ( i32 ) , test_heap_comparator_descending , &heap ) );
+    EXPECT_NOT ( _heap_create ( 2 , 0 , test_heap_comparator_descending , &heap ) );
+    EXPECT_NOT ( _heap_create ( 2 , sizeof ( i32 ) , 0 , &heap ) );
+    EXPECT_NOT ( _heap_create ( 2 , sizeof ( i32 ) , test_heap_comparator_descending , 0 ) );
+    EXPECT_NOT ( _heap_create_from ( 2 , sizeof ( i32 ) , test_heap_comparator_descending , 0 , 1 , &heap ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: heap_create creates an empty heap.
+    heap = 0;
+    EXPECT ( heap_create ( i32 , test_heap_comparator_descending , &heap ) );
+    EXPECT_NEQ ( 0 , heap );
+    EXPECT_EQ ( 0 , heap_length ( heap ) );
+    EXPECT_EQ ( sizeof ( i32 ) , heap_stride ( heap ) );
+    EXPECT_EQ ( HEAP_DEFAULT_ARITY , heap_arity ( heap ) );
+    EXPECT_NOT ( heap_peek ( heap , &value ) );
+    EXPECT_NOT ( heap_pop ( heap , &value ) );
+    EXPECT_NOT ( heap_contains ( heap , 0 ) );
+    EXPECT_NEQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+
+    // TEST 3: heap_destroy frees the heap and nullifies the handle.
+    heap_destroy ( &heap );
+    EXPECT_EQ ( 0 , heap );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 4: heap_destroy handles invalid arguments.
+    heap_destroy ( 0 );
+    heap_destroy ( &heap );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_heap_push_and_pop
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    heap_t* heap;
+    i32 values[ TEST_HEAP_ELEMENT_COUNT ];
+    i32 value;
+    i32 previous;
+    element_t element;
+
+    for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+    {
+        values[ i ] = random2 ( -1000 , 1000 );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Elements pop in comparator order, for several arities.
+    for ( u64 arity = 2; arity <= 8; ++arity )
+    {
+        EXPECT ( _heap_create ( arity , sizeof ( i32 ) , test_heap_comparator_descending , &heap ) );
+        for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+        {
+            heap_push ( heap , &values[ i ] );
+        }
+        EXPECT_EQ ( TEST_HEAP_ELEMENT_COUNT , heap_length ( heap ) );
+        previous = 1000;
+        for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+        {
+            i32 peeked;
+            EXPECT ( heap_peek ( heap , &peeked ) );
+            EXPECT ( heap_pop ( heap , &value ) );
+            EXPECT_EQ ( peeked , value );
+            EXPECT ( value <= previous );
+            previous = value;
+        }
+        EXPECT_EQ ( 0 , heap_length ( heap ) );
+        EXPECT_NOT ( heap_pop ( heap , 0 ) );
+        heap_destroy ( &heap );
+    }
+
+    // TEST 2: heap_create_from builds a valid heap from an array.
+    for ( u64 length = 0; length < 20; ++length )
+    {
+        EXPECT ( heap_create_from ( i32 , test_heap_comparator_descending , values , length , &heap ) );
+        EXPECT_EQ ( length , heap_length ( heap ) );
+        for ( u64 i = 0; i < length; ++i )
+        {
+            EXPECT ( heap_get ( heap , i , &value ) );
+            EXPECT_EQ ( values[ i ] , value );
+        }
+        previous = 1000;
+        while ( heap_pop ( heap , &value ) )
+        {
+            EXPECT ( value <= previous );
+            previous = value;
+        }
+        heap_destroy ( &heap );
+    }
+    EXPECT ( heap_create_from ( i32 , test_heap_comparator_descending , values , TEST_HEAP_ELEMENT_COUNT , &heap ) );
+    previous = 1000;
+    for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+    {
+        EXPECT ( heap_pop ( heap , &value ) );
+        EXPECT ( value <= previous );
+        previous = value;
+    }
+    heap_destroy ( &heap );
+
+    // TEST 3: A heap without a comparator orders by the u64 priority at the
+    //         start of each element, least first.
+    EXPECT ( heap_create_priority ( element_t , &heap ) );
+    for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+    {
+        element.priority = ( u64 ) random64 ();
+        element.id = i;
+        heap_push ( heap , &element );
+    }
+    u64 previous_priority = 0;
+    for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+    {
+        EXPECT ( heap_pop ( heap , &element ) );
+        EXPECT ( element.priority >= previous_priority );
+        previous_priority = element.priority;
+    }
+    heap_destroy ( &heap );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_heap_handles
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    heap_t* heap;
+    u64 handles[ TEST_HEAP_ELEMENT_COUNT ];
+    element_t element;
+
+    EXPECT ( heap_create_priority ( element_t , &heap ) );
+    for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+    {
+        element.priority = 1000000 + i;
+        element.id = i;
+        handles[ i ] = heap_push ( heap , &element );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Handles retrieve their elements.
+    for ( u64 i = 0; i < TEST_HEAP_ELEMENT_COUNT; ++i )
+    {
+        EXPECT ( heap_contains ( heap , handles[ i ] ) );
+        EXPECT ( heap_get ( heap , handles[ i ] , &element ) );
+        EXPECT_EQ ( i , element.id );
+    }
+    EXPECT_NOT ( heap_contains ( heap , TEST_HEAP_ELEMENT_COUNT ) );
+    EXPECT_NOT ( heap_get ( heap , HEAP_HANDLE_INVALID , &element ) );
+
+    // TEST 2: heap_update can decrease a key, moving the element to the top.
+    element.priority = 5;
+    element.id = 500;
+    EXPECT ( heap_update ( heap , handles[ 500 ] , &element ) );
+    EXPECT ( heap_peek ( heap , &element ) );
+    EXPECT_EQ ( 500 , element.id );
+
+    // TEST 3: heap_update can increase a key, moving the element down.
+    element.priority = 2000000;
+    element.id = 0;
+    EXPECT ( heap_update ( heap , handles[ 0 ] , &element ) );
+    EXPECT ( heap_pop ( heap , &element ) );
+    EXPECT_EQ ( 500 , element.id );
+    EXPECT ( heap_pop ( heap , &element ) );
+    EXPECT_EQ ( 1 , element.id );
+    EXPECT_NOT ( heap_contains ( heap , handles[ 500 ] ) );
+    EXPECT_NOT ( heap_contains ( heap , handles[ 1 ] ) );
+    EXPECT_NOT ( heap_update ( heap , handles[ 1 ] , &element ) );
+
+    // TEST 4: heap_remove removes an element by handle.
+    for ( u64 i = 2; i < TEST_HEAP_ELEMENT_COUNT; i += 2 )
+    {
+        if ( i == 500 )
+        {
+            continue;
+        }
+        EXPECT ( heap_remove ( heap , handles[ i ] , &element ) );
+        EXPECT_EQ ( i , element.id );
+        EXPECT_NOT ( heap_remove ( heap , handles[ i ] , 0 ) );
+    }
+    EXPECT_EQ ( TEST_HEAP_ELEMENT_COUNT / 2 , heap_length ( heap ) );
+    for ( u64 i = 3; i < TEST_HEAP_ELEMENT_COUNT; i += 2 )
+    {
+        EXPECT ( heap_pop ( heap , &element ) );
+        EXPECT_EQ ( i , element.id );
+    }
+    EXPECT ( heap_pop ( heap , &element ) );
+    EXPECT_EQ ( 0 , element.id );
+    EXPECT_EQ ( 0 , heap_length ( heap ) );
+
+    // TEST 5: Handles are reused once their elements leave the heap.
+    element.priority = 1;
+    element.id = 1;
+    const u64 handle = heap_push ( heap , &element );
+    EXPECT ( handle < TEST_HEAP_ELEMENT_COUNT );
+    EXPECT ( heap_get ( heap , handle , &element ) );
+    EXPECT_EQ ( 1 , element.id );
+
+    // TEST 6: heap_clear removes every element and invalidates every handle.
+    heap_clear ( heap );
+    EXPECT_EQ ( 0 , heap_length ( heap ) );
+    EXPECT_NOT ( heap_contains ( heap , handle ) );
+    EXPECT_NOT ( heap_peek ( heap , &element ) );
+    EXPECT_EQ ( 0 , heap_push ( heap , &element ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    heap_destroy ( &heap );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_heap
+( void )
+{
+    test_register ( test_heap_create_and_destroy , "Creating or destroying a heap." );
+    test_register ( test_heap_push_and_pop , "Testing heap 'push' and 'pop' operations." );
+    test_register ( test_heap_handles , "Testing heap 'update' and 'remove' operations by handle." );
+}
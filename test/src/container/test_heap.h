@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_heap.h
+ * @brief Tests container/heap.h
+ * (see test/test.h, container/heap.h for additional details)
+ */
+#ifndef TEST_HEAP_H
+#define TEST_HEAP_H
+
+#include "test/test.h"
+
+#include "container/heap.h"
+
+void
+test_register_heap
+( void );
+
+#endif  // TEST_HEAP_H
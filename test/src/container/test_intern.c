@@ -0,0 +1,227 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_intern.c
+ * @brief Implementation of the container/test_intern header.
+ * (see container/test_intern.h for additional details)
+ */
+#include "container/test_intern.h"
+
+#include "test/expect.h"
+
+#include "container/string.h"
+
+#include "core/memory.h"
+
+#include "platform/thread.h"
+
+#define TEST_INTERN_THREAD_COUNT    ( ( u64 ) 4 )
+#define TEST_INTERN_KEY_COUNT       ( ( u64 ) 512 )
+
+/** @brief Type definition for state shared by all interning threads. */
+typedef struct
+{
+    intern_pool_t*  pool;
+    char*           keys[ TEST_INTERN_KEY_COUNT ];
+    const char*     results[ TEST_INTERN_THREAD_COUNT ][ TEST_INTERN_KEY_COUNT ];
+    u64             next_thread;
+}
+shared_t;
+
+/**
+ * @brief Interning thread: interns every key, starting from a different key
+ * than the other threads, and records the interned copies.
+ */
+u32
+test_intern_thread
+(   void* args
+)
+{
+    shared_t* shared = args;
+    const u64 thread = atomic_fetch_add_u64 ( &( *shared ).next_thread , 1 , ATOMIC_RELAXED );
+    for ( u64 i = 0; i < TEST_INTERN_KEY_COUNT; ++i )
+    {
+        const u64 key = ( i + thread * ( TEST_INTERN_KEY_COUNT / TEST_INTERN_THREAD_COUNT ) )
+                      % TEST_INTERN_KEY_COUNT
+                      ;
+        ( *shared ).results[ thread ][ key ] = intern_string ( ( *shared ).pool
+                                                             , ( *shared ).keys[ key ]
+                                                             );
+    }
+    return 0;
+}
+
+u8
+test_intern_string
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* long_key = "a field name longer than the inline key capacity";
+    intern_pool_t* pool = 0;
+    char buffer[ 64 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: intern_pool_create handles invalid arguments.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( intern_pool_create ( 0 ) );
+    EXPECT ( intern_pool_create ( &pool ) );
+    EXPECT_NEQ ( 0 , pool );
+    EXPECT_EQ ( 0 , intern_pool_count ( pool ) );
+
+    // TEST 2: intern_string copies a string into the pool.
+    const char* position = intern_string ( pool , "position" );
+    EXPECT_NEQ ( 0 , position );
+    EXPECT ( memory_equal ( position , "position" , 9 ) );
+    EXPECT_EQ ( 8 , intern_length ( position ) );
+    EXPECT_EQ ( 0 , intern_id ( position ) );
+    EXPECT_EQ ( 1 , intern_pool_count ( pool ) );
+
+    // TEST 3: Interning an equal string returns the same copy, without storing it again.
+    memory_copy ( buffer , "position" , 9 );
+    EXPECT_EQ ( position , intern_string ( pool , buffer ) );
+    EXPECT_EQ ( position , _intern_string ( pool , "position velocity" , 8 ) );
+    EXPECT_EQ ( position , intern_view ( pool , string_view ( buffer , 8 ) ) );
+    EXPECT_EQ ( 1 , intern_pool_count ( pool ) );
+
+    // TEST 4: Distinct strings receive distinct copies and consecutive IDs.
+    const char* velocity = intern_string ( pool , "velocity" );
+    const char* pos = intern_string ( pool , "pos" );
+    EXPECT_NEQ ( position , velocity );
+    EXPECT_NEQ ( position , pos );
+    EXPECT_EQ ( 1 , intern_id ( velocity ) );
+    EXPECT_EQ ( 2 , intern_id ( pos ) );
+    EXPECT_EQ ( 3 , intern_pool_count ( pool ) );
+
+    // TEST 5: Strings longer than the inline key capacity of the lookup table.
+    const char* long_interned = intern_string ( pool , long_key );
+    memory_copy ( buffer , long_key , _string_length ( long_key ) + 1 );
+    EXPECT_NEQ ( long_key , long_interned );
+    EXPECT_EQ ( long_interned , intern_string ( pool , buffer ) );
+    EXPECT_EQ ( _string_length ( long_key ) , intern_length ( long_interned ) );
+    EXPECT_EQ ( 4 , intern_pool_count ( pool ) );
+
+    // TEST 6: The empty string, and strings containing null characters.
+    const char* empty = _intern_string ( pool , 0 , 0 );
+    EXPECT_NEQ ( 0 , empty );
+    EXPECT_EQ ( 0 , *empty );
+    EXPECT_EQ ( 0 , intern_length ( empty ) );
+    EXPECT_EQ ( empty , intern_string ( pool , "" ) );
+    const char* binary = _intern_string ( pool , "a\0b" , 3 );
+    EXPECT_NEQ ( 0 , binary );
+    EXPECT_EQ ( 3 , intern_length ( binary ) );
+    EXPECT_NEQ ( binary , intern_string ( pool , "a" ) );
+    EXPECT_EQ ( 7 , intern_pool_count ( pool ) );
+
+    // TEST 7: intern_find looks up a string without interning it.
+    EXPECT_EQ ( velocity , intern_find ( pool , "velocity" ) );
+    EXPECT_EQ ( 0 , intern_find ( pool , "acceleration" ) );
+    EXPECT_EQ ( 7 , intern_pool_count ( pool ) );
+
+    // TEST 8: intern_pool_get obtains an interned string by its ID.
+    EXPECT_EQ ( position , intern_pool_get ( pool , intern_id ( position ) ) );
+    EXPECT_EQ ( long_interned , intern_pool_get ( pool , intern_id ( long_interned ) ) );
+    EXPECT_EQ ( 0 , intern_pool_get ( pool , 7 ) );
+
+    // TEST 9: intern_view_of obtains a view of an interned string.
+    string_view_t view = intern_view_of ( velocity );
+    EXPECT_EQ ( velocity , view.string );
+    EXPECT_EQ ( 8 , view.length );
+
+    // TEST 10: intern_pool_destroy frees every interned string and nullifies the handle.
+    intern_pool_destroy ( &pool );
+    EXPECT_EQ ( 0 , pool );
+    intern_pool_destroy ( &pool );
+    intern_pool_destroy ( 0 );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_intern_concurrent
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    thread_t threads[ TEST_INTERN_THREAD_COUNT ];
+    shared_t* shared = memory_allocate ( sizeof ( shared_t ) , MEMORY_TAG_STRING );
+    EXPECT ( intern_pool_create ( &( *shared ).pool ) );
+    for ( u64 i = 0; i < TEST_INTERN_KEY_COUNT; ++i )
+    {
+        ( *shared ).keys[ i ] = string_format ( "component.field_%u" , i );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 i = 0; i < TEST_INTERN_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_intern_thread , shared , false , &threads[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_INTERN_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+    }
+
+    // TEST 1: Every key was interned exactly once.
+    EXPECT_EQ ( TEST_INTERN_KEY_COUNT , intern_pool_count ( ( *shared ).pool ) );
+
+    // TEST 2: Every thread received the same copy of each key.
+    for ( u64 i = 0; i < TEST_INTERN_KEY_COUNT; ++i )
+    {
+        const char* interned = ( *shared ).results[ 0 ][ i ];
+        EXPECT_NEQ ( 0 , interned );
+        EXPECT ( _string_equal ( ( *shared ).keys[ i ] , interned ) );
+        EXPECT_EQ ( interned , intern_pool_get ( ( *shared ).pool , intern_id ( interned ) ) );
+        for ( u64 j = 1; j < TEST_INTERN_THREAD_COUNT; ++j )
+        {
+            EXPECT_EQ ( interned , ( *shared ).results[ j ][ i ] );
+        }
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    for ( u64 i = 0; i < TEST_INTERN_THREAD_COUNT; ++i )
+    {
+        thread_destroy ( &threads[ i ] );
+    }
+    for ( u64 i = 0; i < TEST_INTERN_KEY_COUNT; ++i )
+    {
+        string_destroy ( ( *shared ).keys[ i ] );
+    }
+    intern_pool_destroy ( &( *shared ).pool );
+    memory_free ( shared , sizeof ( shared_t ) , MEMORY_TAG_STRING );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_intern
+( void )
+{
+    test_register ( test_intern_string , "Testing string interning pool 'intern' and 'find' operations." );
+    test_register_serial ( test_intern_concurrent , "Testing string interning pool with several threads interning the same strings." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_intern.h
+ * @brief Tests container/intern.h
+ * (see test/test.h, container/intern.h for additional details)
+ */
+#ifndef TEST_INTERN_H
+#define TEST_INTERN_H
+
+#include "test/test.h"
+
+#include "container/intern.h"
+
+void
+test_register_intern
+( void );
+
+#endif  // TEST_INTERN_H
@@ -0,0 +1,267 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_list.c
+ * @brief Implementation of the container/test_list header.
+ * (see container/test_list.h for additional details)
+ */
+#include "container/test_list.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/thread.h"
+
+#define TEST_LIST_ELEMENT_COUNT             ( ( u64 ) 16 )
+#define TEST_LIST_THREAD_COUNT              ( ( u64 ) 4 )
+#define TEST_LIST_OPERATIONS_PER_THREAD     ( ( u64 ) 100000 )
+
+/** @brief Type definition for a test element, on a list and a stack. */
+typedef struct
+{
+    u64                 id;
+    list_node_t         node;
+    atomic_stack_node_t stack_node;
+    u64                 popped;
+}
+element_t;
+
+/** @brief Type definition for state shared by all stack threads. */
+typedef struct
+{
+    atomic_stack_t  stack;
+    u64             errors;
+}
+shared_t;
+
+/**
+ * @brief Stack thread: repeatedly pops a node and pushes it back, verifying
+ * that no other thread holds the same node at the same time.
+ */
+u32
+test_list_stack_thread
+(   void* args
+)
+{
+    shared_t* shared = args;
+    u64 errors = 0;
+    for ( u64 i = 0; i < TEST_LIST_OPERATIONS_PER_THREAD; ++i )
+    {
+        atomic_stack_node_t* node = atomic_stack_pop ( &( *shared ).stack );
+        if ( !node )
+        {
+            continue;
+        }
+        element_t* element = ( element_t* )( ( ( u64 ) node )
+                                           - ( ( u64 ) &( *( ( element_t* ) 0 ) ).stack_node )
+                                           );
+        if ( atomic_exchange_u64 ( &( *element ).popped , 1 , ATOMIC_ACQ_REL ) )
+        {
+            errors += 1;
+        }
+        atomic_store_u64 ( &( *element ).popped , 0 , ATOMIC_RELEASE );
+        atomic_stack_push ( &( *shared ).stack , node );
+    }
+    atomic_fetch_add_u64 ( &( *shared ).errors , errors , ATOMIC_RELAXED );
+    return 0;
+}
+
+u8
+test_list_operations
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    list_t list;
+    list_t other;
+    element_t elements[ TEST_LIST_ELEMENT_COUNT ];
+    u64 i;
+
+    for ( i = 0; i < TEST_LIST_ELEMENT_COUNT; ++i )
+    {
+        elements[ i ].id = i;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: list_init initializes an empty list.
+    list_init ( &list );
+    EXPECT ( list_empty ( &list ) );
+    EXPECT_EQ ( 0 , list_length ( &list ) );
+    EXPECT_EQ ( 0 , list_front ( &list ) );
+    EXPECT_EQ ( 0 , list_back ( &list ) );
+    EXPECT_EQ ( 0 , list_pop_front ( &list ) );
+    EXPECT_EQ ( 0 , list_pop_back ( &list ) );
+    EXPECT_EQ ( 0 , list_entry ( list_front ( &list ) , element_t , node ) );
+
+    // TEST 2: Nodes pushed to the back are iterated in order, and
+    //         list_entry recovers their elements.
+    for ( i = 0; i < TEST_LIST_ELEMENT_COUNT; ++i )
+    {
+        list_push_back ( &list , &elements[ i ].node );
+    }
+    EXPECT_NOT ( list_empty ( &list ) );
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT , list_length ( &list ) );
+    i = 0;
+    for ( list_node_t* node = list_front ( &list ); node; node = list_next ( &list , node ) )
+    {
+        EXPECT_EQ ( i , ( *list_entry ( node , element_t , node ) ).id );
+        i += 1;
+    }
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT , i );
+    for ( list_node_t* node = list_back ( &list ); node; node = list_prev ( &list , node ) )
+    {
+        i -= 1;
+        EXPECT_EQ ( i , ( *list_entry ( node , element_t , node ) ).id );
+    }
+    EXPECT_EQ ( 0 , i );
+
+    // TEST 3: list_remove unlinks a node from the middle of a list.
+    list_remove ( &elements[ 5 ].node );
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT - 1 , list_length ( &list ) );
+    EXPECT_EQ ( &elements[ 6 ].node , list_next ( &list , &elements[ 4 ].node ) );
+    EXPECT_EQ ( &elements[ 4 ].node , list_prev ( &list , &elements[ 6 ].node ) );
+    EXPECT_EQ ( 0 , elements[ 5 ].node.next );
+
+    // TEST 4: list_insert_before and list_insert_after link a node next to
+    //         another.
+    list_insert_before ( &elements[ 6 ].node , &elements[ 5 ].node );
+    EXPECT_EQ ( &elements[ 5 ].node , list_next ( &list , &elements[ 4 ].node ) );
+    list_remove ( &elements[ 5 ].node );
+    list_insert_after ( &elements[ 4 ].node , &elements[ 5 ].node );
+    EXPECT_EQ ( &elements[ 6 ].node , list_next ( &list , &elements[ 5 ].node ) );
+
+    // TEST 5: list_move_front and list_move_back reorder a list (LRU).
+    list_move_front ( &list , &elements[ 9 ].node );
+    list_move_back ( &list , &elements[ 0 ].node );
+    EXPECT_EQ ( &elements[ 9 ].node , list_front ( &list ) );
+    EXPECT_EQ ( &elements[ 0 ].node , list_back ( &list ) );
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT , list_length ( &list ) );
+    EXPECT_EQ ( &elements[ 0 ].node , list_pop_back ( &list ) );
+    EXPECT_EQ ( &elements[ 9 ].node , list_pop_front ( &list ) );
+    EXPECT_EQ ( &elements[ 1 ].node , list_front ( &list ) );
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT - 2 , list_length ( &list ) );
+
+    // TEST 6: list_splice_back and list_splice_front move a whole list, in
+    //         order, and leave it empty.
+    list_init ( &other );
+    list_push_back ( &other , &elements[ 0 ].node );
+    list_push_back ( &other , &elements[ 9 ].node );
+    list_splice_front ( &list , &other );
+    EXPECT ( list_empty ( &other ) );
+    EXPECT_EQ ( &elements[ 0 ].node , list_front ( &list ) );
+    EXPECT_EQ ( &elements[ 9 ].node , list_next ( &list , &elements[ 0 ].node ) );
+    EXPECT_EQ ( &elements[ 1 ].node , list_next ( &list , &elements[ 9 ].node ) );
+    list_splice_back ( &other , &list );
+    EXPECT ( list_empty ( &list ) );
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT , list_length ( &other ) );
+    EXPECT_EQ ( &elements[ 0 ].node , list_front ( &other ) );
+    EXPECT_EQ ( &elements[ 15 ].node , list_back ( &other ) );
+    list_splice_back ( &other , &list );
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT , list_length ( &other ) );
+
+    // TEST 7: A lock-free stack pops nodes in reverse push order.
+    atomic_stack_t stack;
+    atomic_stack_init ( &stack );
+    EXPECT ( atomic_stack_empty ( &stack ) );
+    EXPECT_EQ ( 0 , atomic_stack_pop ( &stack ) );
+    EXPECT_EQ ( 0 , atomic_stack_pop_all ( &stack ) );
+    for ( i = 0; i < TEST_LIST_ELEMENT_COUNT; ++i )
+    {
+        atomic_stack_push ( &stack , &elements[ i ].stack_node );
+    }
+    EXPECT_NOT ( atomic_stack_empty ( &stack ) );
+    for ( i = TEST_LIST_ELEMENT_COUNT; i > TEST_LIST_ELEMENT_COUNT / 2; --i )
+    {
+        EXPECT_EQ ( &elements[ i - 1 ].stack_node , atomic_stack_pop ( &stack ) );
+    }
+
+    // TEST 8: atomic_stack_pop_all takes the remaining nodes as a chain.
+    atomic_stack_node_t* node = atomic_stack_pop_all ( &stack );
+    EXPECT ( atomic_stack_empty ( &stack ) );
+    for ( ; i; --i )
+    {
+        EXPECT_EQ ( &elements[ i - 1 ].stack_node , node );
+        node = ( *node ).next;
+    }
+    EXPECT_EQ ( 0 , node );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_list_atomic_stack_concurrent
+( void )
+{
+    thread_t threads[ TEST_LIST_THREAD_COUNT ];
+    element_t elements[ TEST_LIST_ELEMENT_COUNT ];
+    shared_t shared = { 0 };
+
+    atomic_stack_init ( &shared.stack );
+    for ( u64 i = 0; i < TEST_LIST_ELEMENT_COUNT; ++i )
+    {
+        elements[ i ].id = i;
+        elements[ i ].popped = 0;
+        atomic_stack_push ( &shared.stack , &elements[ i ].stack_node );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 i = 0; i < TEST_LIST_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_list_stack_thread , &shared , false , &threads[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_LIST_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+    }
+
+    // TEST 1: No node was ever held by two threads at once.
+    EXPECT_EQ ( 0 , shared.errors );
+
+    // TEST 2: Every node is on the stack exactly once.
+    u64 seen = 0;
+    u64 count = 0;
+    for ( atomic_stack_node_t* node = atomic_stack_pop_all ( &shared.stack ); node; node = ( *node ).next )
+    {
+        const element_t* element = ( element_t* )( ( ( u64 ) node )
+                                                 - ( ( u64 ) &( *( ( element_t* ) 0 ) ).stack_node )
+                                                 );
+        EXPECT_EQ ( 0 , seen & ( ( ( u64 ) 1 ) << ( *element ).id ) );
+        seen |= ( ( u64 ) 1 ) << ( *element ).id;
+        count += 1;
+    }
+    EXPECT_EQ ( TEST_LIST_ELEMENT_COUNT , count );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    for ( u64 i = 0; i < TEST_LIST_THREAD_COUNT; ++i )
+    {
+        thread_destroy ( &threads[ i ] );
+    }
+
+    return true;
+}
+
+void
+test_register_list
+( void )
+{
+    test_register ( test_list_operations , "Testing intrusive list and lock-free stack operations." );
+    test_register_serial ( test_list_atomic_stack_concurrent , "Testing a lock-free stack with several threads." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_list.h
+ * @brief Tests container/list.h
+ * (see test/test.h, container/list.h for additional details)
+ */
+#ifndef TEST_LIST_H
+#define TEST_LIST_H
+
+#include "test/test.h"
+
+#include "container/list.h"
+
+void
+test_register_list
+( void );
+
+#endif  // TEST_LIST_H
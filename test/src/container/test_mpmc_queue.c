@@ -0,0 +1,314 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_mpmc_queue.c
+ * @brief Implementation of the container/test_mpmc_queue header.
+ * (see container/test_mpmc_queue.h for additional details)
+ */
+#include "container/test_mpmc_queue.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/thread.h"
+
+#define TEST_MPMC_QUEUE_PRODUCER_COUNT        ( ( u64 ) 4 )
+#define TEST_MPMC_QUEUE_CONSUMER_COUNT        ( ( u64 ) 4 )
+#define TEST_MPMC_QUEUE_ELEMENTS_PER_PRODUCER ( ( u64 ) 100000 )
+
+/** @brief Type definition for state shared by all producer and consumer threads. */
+typedef struct
+{
+    mpmc_queue_t*   queue;
+    u64             next_producer;
+    u64             consumed;
+    u64             sum;
+    u64             errors;
+}
+shared_t;
+
+/**
+ * @brief Producer thread: pushes ( producer << 32 ) | sequence for every
+ * sequence number in [ 0 , TEST_MPMC_QUEUE_ELEMENTS_PER_PRODUCER ).
+ */
+u32
+test_mpmc_queue_producer
+(   void* args
+)
+{
+    shared_t* shared = args;
+    const u64 producer = atomic_fetch_add_u64 ( &( *shared ).next_producer , 1 , ATOMIC_RELAXED );
+    for ( u64 i = 0; i < TEST_MPMC_QUEUE_ELEMENTS_PER_PRODUCER; )
+    {
+        const u64 value = ( producer << 32 ) | i;
+        if ( mpmc_queue_push ( ( *shared ).queue , &value ) )
+        {
+            i += 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Consumer thread: pops until every produced element has been consumed,
+ * verifying that the elements of each producer arrive in increasing order.
+ */
+u32
+test_mpmc_queue_consumer
+(   void* args
+)
+{
+    shared_t* shared = args;
+    const u64 total = TEST_MPMC_QUEUE_PRODUCER_COUNT
+                    * TEST_MPMC_QUEUE_ELEMENTS_PER_PRODUCER
+                    ;
+    u64 next[ TEST_MPMC_QUEUE_PRODUCER_COUNT ] = { 0 };
+    u64 sum = 0;
+    u64 errors = 0;
+    u64 value;
+    while ( atomic_load_u64 ( &( *shared ).consumed , ATOMIC_ACQUIRE ) < total )
+    {
+        if ( !mpmc_queue_pop ( ( *shared ).queue , &value ) )
+        {
+            continue;
+        }
+        const u64 producer = value >> 32;
+        const u64 sequence = value & 0xFFFFFFFF;
+        if ( producer >= TEST_MPMC_QUEUE_PRODUCER_COUNT || sequence < next[ producer ] )
+        {
+            errors += 1;
+        }
+        else
+        {
+            next[ producer ] = sequence + 1;
+        }
+        sum += sequence;
+        atomic_fetch_add_u64 ( &( *shared ).consumed , 1 , ATOMIC_RELEASE );
+    }
+    atomic_fetch_add_u64 ( &( *shared ).sum , sum , ATOMIC_RELAXED );
+    atomic_fetch_add_u64 ( &( *shared ).errors , errors , ATOMIC_RELAXED );
+    return 0;
+}
+
+u8
+test_mpmc_queue_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    mpmc_queue_t* queue;
+    u64 memory_requirement;
+    void* memory;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: mpmc_queue_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( mpmc_queue_create ( 0 , 1 , 0 , 0 , &queue ) );
+    EXPECT_NOT ( mpmc_queue_create ( 1 , 0 , 0 , 0 , &queue ) );
+    EXPECT_NOT ( mpmc_queue_create ( 1 , 1 , 0 , 0 , 0 ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: mpmc_queue_create with implicit memory allocation.
+    queue = 0;
+    EXPECT ( mpmc_queue_create ( sizeof ( u32 ) , 100 , &memory_requirement , 0 , 0 ) );
+    EXPECT ( mpmc_queue_create ( sizeof ( u32 ) , 100 , 0 , 0 , &queue ) );
+    EXPECT_NEQ ( 0 , queue );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    EXPECT_EQ ( queue_amount_allocated + memory_requirement , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+
+    // TEST 3: Queue capacity is rounded up to a power of two.
+    EXPECT_EQ ( 128 , mpmc_queue_capacity ( queue ) );
+    EXPECT_EQ ( sizeof ( u32 ) , mpmc_queue_stride ( queue ) );
+    EXPECT_EQ ( 0 , mpmc_queue_length ( queue ) );
+
+    // TEST 4: mpmc_queue_destroy frees the queue and nullifies the handle.
+    mpmc_queue_destroy ( &queue );
+    EXPECT_EQ ( 0 , queue );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: mpmc_queue_create with a pre-allocated buffer does not modify the global allocator state.
+    memory = memory_allocate_aligned ( memory_requirement , 64 , MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+    EXPECT ( mpmc_queue_create ( sizeof ( u32 ) , 100 , 0 , memory , &queue ) );
+    EXPECT_EQ ( memory , queue );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    mpmc_queue_destroy ( &queue );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    memory_free_aligned ( memory , memory_requirement , 64 , MEMORY_TAG_QUEUE );
+
+    // TEST 6: mpmc_queue_destroy handles invalid arguments.
+    mpmc_queue_destroy ( 0 );
+    mpmc_queue_destroy ( &queue );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+
+    return true;
+}
+
+u8
+test_mpmc_queue_push_and_pop
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 capacity = 16;
+    mpmc_queue_t* queue = 0;
+    u64 popped;
+
+    EXPECT ( mpmc_queue_create ( sizeof ( u64 ) , capacity , 0 , 0 , &queue ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , queue );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: mpmc_queue_pop fails on an empty queue.
+    EXPECT_NOT ( mpmc_queue_pop ( queue , &popped ) );
+
+    // Fill and drain the queue several times, so that the indices wrap around.
+    for ( u64 lap = 0; lap < 5; ++lap )
+    {
+        // TEST 2: mpmc_queue_push succeeds until the queue is full.
+        for ( u64 i = 0; i < capacity; ++i )
+        {
+            const u64 value = lap * capacity + i;
+            EXPECT ( mpmc_queue_push ( queue , &value ) );
+            EXPECT_EQ ( i + 1 , mpmc_queue_length ( queue ) );
+        }
+
+        // TEST 3: mpmc_queue_push fails on a full queue.
+        EXPECT_NOT ( mpmc_queue_push ( queue , &popped ) );
+
+        // TEST 4: mpmc_queue_pop removes the elements in order.
+        for ( u64 i = 0; i < capacity; ++i )
+        {
+            EXPECT ( mpmc_queue_pop ( queue , &popped ) );
+            EXPECT_EQ ( lap * capacity + i , popped );
+        }
+        EXPECT_NOT ( mpmc_queue_pop ( queue , 0 ) );
+        EXPECT_EQ ( 0 , mpmc_queue_length ( queue ) );
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    mpmc_queue_destroy ( &queue );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_mpmc_queue_concurrent
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 total = TEST_MPMC_QUEUE_PRODUCER_COUNT
+                    * TEST_MPMC_QUEUE_ELEMENTS_PER_PRODUCER
+                    ;
+    thread_t producers[ TEST_MPMC_QUEUE_PRODUCER_COUNT ];
+    thread_t consumers[ TEST_MPMC_QUEUE_CONSUMER_COUNT ];
+    shared_t shared = { 0 };
+    u64 popped;
+
+    EXPECT ( mpmc_queue_create ( sizeof ( u64 ) , 1024 , 0 , 0 , &shared.queue ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , shared.queue );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 i = 0; i < TEST_MPMC_QUEUE_CONSUMER_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_mpmc_queue_consumer , &shared , false , &consumers[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_MPMC_QUEUE_PRODUCER_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_mpmc_queue_producer , &shared , false , &producers[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_MPMC_QUEUE_PRODUCER_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &producers[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_MPMC_QUEUE_CONSUMER_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &consumers[ i ] ) );
+    }
+
+    // TEST 1: Every element was consumed exactly once.
+    EXPECT_EQ ( total , shared.consumed );
+    EXPECT_EQ ( TEST_MPMC_QUEUE_PRODUCER_COUNT * ( ( TEST_MPMC_QUEUE_ELEMENTS_PER_PRODUCER * ( TEST_MPMC_QUEUE_ELEMENTS_PER_PRODUCER - 1 ) ) / 2 ) , shared.sum );
+
+    // TEST 2: Each consumer received the elements of each producer in order.
+    EXPECT_EQ ( 0 , shared.errors );
+
+    // TEST 3: The queue is empty once every element has been consumed.
+    EXPECT_NOT ( mpmc_queue_pop ( shared.queue , &popped ) );
+    EXPECT_EQ ( 0 , mpmc_queue_length ( shared.queue ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    for ( u64 i = 0; i < TEST_MPMC_QUEUE_PRODUCER_COUNT; ++i )
+    {
+        thread_destroy ( &producers[ i ] );
+    }
+    for ( u64 i = 0; i < TEST_MPMC_QUEUE_CONSUMER_COUNT; ++i )
+    {
+        thread_destroy ( &consumers[ i ] );
+    }
+    mpmc_queue_destroy ( &shared.queue );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_mpmc_queue
+( void )
+{
+    test_register_serial ( test_mpmc_queue_create_and_destroy , "Creating or destroying a multi-producer multi-consumer queue." );
+    test_register_serial ( test_mpmc_queue_push_and_pop , "Testing multi-producer multi-consumer queue 'push' and 'pop' operations." );
+    test_register_serial ( test_mpmc_queue_concurrent , "Testing multi-producer multi-consumer queue with several producer and consumer threads." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_mpmc_queue.h
+ * @brief Tests container/mpmc_queue.h
+ * (see test/test.h, container/mpmc_queue.h for additional details)
+ */
+#ifndef TEST_MPMC_QUEUE_H
+#define TEST_MPMC_QUEUE_H
+
+#include "test/test.h"
+
+#include "container/mpmc_queue.h"
+
+void
+test_register_mpmc_queue
+( void );
+
+#endif  // TEST_MPMC_QUEUE_H
@@ -12,6 +12,17 @@
 
 #include "math/math.h"
 
+/** @brief Type definition for an element of a typed queue (see test_queue_typed). */
+typedef struct
+{
+    u64 id;
+    u64 payload;
+}
+test_queue_job_t;
+
+QUEUE_DEFINE_NAMED ( job , test_queue_job_t )
+QUEUE_DEFINE ( u64 )
+
 u8
 test_queue_create_and_destroy
 ( void )
@@ -262,7 +273,7 @@ test_queue_peek
         EXPECT ( queue_peek ( queue , &popped ) );
 
         // TEST 2: queue_peek writes the correct value into the output buffer.
-        EXPECT ( memory_equal ( queue , &popped , queue_stride ( queue ) ) );
+        EXPECT ( memory_equal ( queue_element ( queue , 0 ) , &popped , queue_stride ( queue ) ) );
 
         // Pop the element from the queue.
         EXPECT ( queue_pop ( queue , &popped ) );
@@ -292,6 +303,206 @@ test_queue_peek
     return true;
 }
 
+u8
+test_queue_push_n_and_pop_n
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 op_count = 10000;
+    queue_t* queue = _queue_create ( 8 , sizeof ( u64 ) );
+    u64 in[ 16 ];
+    u64 out[ 16 ];
+    u64 pushed = 0;
+    u64 popped = 0;
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , queue );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // Push and pop batches of random size, so that the head wraps around the end of the buffer many times. The queue holds the consecutive integers [ popped , pushed ).
+    for ( u64 i = 0; i < op_count; ++i )
+    {
+        const u64 push_count = random2 ( 0 , 16 );
+        for ( u64 j = 0; j < push_count; ++j )
+        {
+            in[ j ] = pushed + j;
+        }
+
+        // TEST 1: queue_push_n appends the elements to the end of the queue.
+        EXPECT_NEQ ( 0 , queue_push_n ( queue , in , push_count ) );
+        pushed += push_count;
+        EXPECT_EQ ( pushed - popped , queue_length ( queue ) );
+        EXPECT ( queue_allocated ( queue ) >= queue_length ( queue ) * queue_stride ( queue ) );
+
+        // TEST 2: queue_element addresses every element in order.
+        for ( u64 j = 0; j < queue_length ( queue ); ++j )
+        {
+            EXPECT_EQ ( popped + j , *( ( u64* ) queue_element ( queue , j ) ) );
+        }
+
+        // TEST 3: queue_pop_n removes the elements from the head of the queue, in order.
+        const u64 pop_count = random2 ( 0 , MIN ( queue_length ( queue ) , ( u64 ) 16 ) );
+        EXPECT ( queue_pop_n ( queue , out , pop_count ) );
+        for ( u64 j = 0; j < pop_count; ++j )
+        {
+            EXPECT_EQ ( popped + j , out[ j ] );
+        }
+        popped += pop_count;
+        EXPECT_EQ ( pushed - popped , queue_length ( queue ) );
+    }
+
+    // TEST 4: queue_pop_n warns and fails without modifying the queue if the queue holds fewer than the requested number of elements.
+    const u64 length = queue_length ( queue );
+    LOGWARN ( "The following warning is intentionally triggered by a test:" );
+    EXPECT_NOT ( queue_pop_n ( queue , 0 , length + 1 ) );
+    EXPECT_EQ ( length , queue_length ( queue ) );
+
+    // TEST 5: queue_pop_n succeeds when no output buffer is provided.
+    EXPECT ( queue_pop_n ( queue , 0 , length ) );
+    EXPECT_EQ ( 0 , queue_length ( queue ) );
+
+    queue_destroy ( queue );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_queue_typed
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 op_count = 10000;
+    test_queue_job_t* queue = queue_job_create ();
+    test_queue_job_t job;
+    u64 pushed = 0;
+    u64 popped = 0;
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , queue );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A typed queue has the same header as a generic queue.
+    EXPECT_EQ ( sizeof ( test_queue_job_t ) , queue_stride ( queue ) );
+    EXPECT_EQ ( 0 , queue_job_length ( queue ) );
+
+    // TEST 2: queue_job_pop and queue_job_peek warn and fail if the queue is empty.
+    LOGWARN ( "The following warnings are intentionally triggered by a test:" );
+    EXPECT_NOT ( queue_job_pop ( queue , &job ) );
+    EXPECT_NOT ( queue_job_peek ( queue , &job ) );
+
+    // Push and pop runs of random length, alternating between the typed and generic functions, so that the head wraps around the end of the buffer many times. The queue holds the jobs [ popped , pushed ).
+    for ( u64 i = 0; i < op_count; ++i )
+    {
+        // TEST 3: queue_job_push appends an element to the end of the queue, growing it if needed.
+        const u64 push_count = random2 ( 0 , 16 );
+        for ( u64 j = 0; j < push_count; ++j )
+        {
+            job.id = pushed;
+            job.payload = ~pushed;
+            if ( j & 1 )
+            {
+                queue = queue_job_push ( queue , job );
+            }
+            else
+            {
+                queue_push ( queue , &job );
+            }
+            pushed += 1;
+        }
+        EXPECT_EQ ( pushed - popped , queue_job_length ( queue ) );
+        EXPECT_EQ ( pushed - popped , queue_length ( queue ) );
+
+        // TEST 4: queue_job_element addresses the same elements as queue_element.
+        for ( u64 j = 0; j < queue_job_length ( queue ); ++j )
+        {
+            EXPECT_EQ ( queue_element ( queue , j ) , queue_job_element ( queue , j ) );
+            EXPECT_EQ ( popped + j , ( *queue_job_element ( queue , j ) ).id );
+        }
+
+        // TEST 5: queue_job_peek and queue_job_pop retrieve the head of the queue.
+        const u64 pop_count = random2 ( 0 , queue_job_length ( queue ) );
+        for ( u64 j = 0; j < pop_count; ++j )
+        {
+            EXPECT ( queue_job_peek ( queue , &job ) );
+            EXPECT_EQ ( popped , job.id );
+            if ( j & 1 )
+            {
+                EXPECT ( queue_job_pop ( queue , &job ) );
+            }
+            else
+            {
+                EXPECT ( queue_pop ( queue , &job ) );
+            }
+            EXPECT_EQ ( popped , job.id );
+            EXPECT_EQ ( ~popped , job.payload );
+            popped += 1;
+        }
+        EXPECT_EQ ( pushed - popped , queue_length ( queue ) );
+    }
+
+    // TEST 6: queue_job_pop succeeds when no output buffer is provided, and resets the head once the queue is empty.
+    while ( queue_job_length ( queue ) )
+    {
+        EXPECT ( queue_job_pop ( queue , 0 ) );
+    }
+    EXPECT_EQ ( 0 , queue_head ( queue ) );
+
+    // TEST 7: A queue of a primitive type stores its elements by value.
+    u64* integers = queue_u64_create ();
+    EXPECT_NEQ ( 0 , integers );
+    for ( u64 i = 0; i < 100; ++i )
+    {
+        integers = queue_u64_push ( integers , i * i );
+    }
+    for ( u64 i = 0; i < 100; ++i )
+    {
+        u64 integer;
+        EXPECT ( queue_u64_pop ( integers , &integer ) );
+        EXPECT_EQ ( i * i , integer );
+    }
+
+    queue_destroy ( integers );
+    queue_destroy ( queue );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 void
 test_register_queue
 ( void )
@@ -299,4 +510,6 @@ test_register_queue
     test_register ( test_queue_create_and_destroy , "Creating or destroying a queue." );
     test_register ( test_queue_push_and_pop , "Testing queue 'push' and 'pop' operations." );
     test_register ( test_queue_peek , "Testing queue 'peek' operation." );
+    test_register ( test_queue_push_n_and_pop_n , "Testing queue 'push_n' and 'pop_n' operations." );
+    test_register ( test_queue_typed , "Testing typed queue (QUEUE_DEFINE) operations." );
 }
\ No newline at end of file
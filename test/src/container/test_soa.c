@@ -0,0 +1,351 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_soa.c
+ * @brief Implementation of the container/test_soa header.
+ * (see container/test_soa.h for additional details)
+ */
+#include "container/test_soa.h"
+
+#include "test/expect.h"
+
+#include "container/array.h"
+#include "container/string.h"
+
+#include "core/memory.h"
+
+/**
+ * @brief Comparator function used by test_soa_sort.
+ *
+ * @param x The address of a 32-bit integer.
+ * @param y The address of a 32-bit integer.
+ * @return < 0 if x < y.
+ *         > 0 if x > y.
+ *         = 0 otherwise.
+ */
+i32
+test_soa_sort_compare
+(   const void* x
+,   const void* y
+)
+{
+    return *( ( i32* ) x ) - *( ( i32* ) y );
+}
+
+u8
+test_soa_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 strides[] = { sizeof ( u8 ) , sizeof ( f64 ) , 3 };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: soa_create handles invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    // TEST 1.1: soa_create fails if no strides are provided.
+    EXPECT_EQ ( 0 , _soa_create ( 0 , 3 , SOA_DEFAULT_CAPACITY ) );
+
+    // TEST 1.2: soa_create fails if there are no columns.
+    EXPECT_EQ ( 0 , _soa_create ( strides , 0 , SOA_DEFAULT_CAPACITY ) );
+
+    // TEST 1.3: soa_create fails if the initial capacity is zero.
+    EXPECT_EQ ( 0 , _soa_create ( strides , 3 , 0 ) );
+
+    // TEST 1.4: soa_create fails if any stride is zero.
+    EXPECT_EQ ( 0 , soa_create ( SOA_DEFAULT_CAPACITY , sizeof ( u32 ) , 0 ) );
+
+    // TEST 2: soa_create with valid arguments.
+
+    soa_t* soa = soa_create ( SOA_DEFAULT_CAPACITY , sizeof ( u8 ) , sizeof ( f64 ) , 3 );
+    EXPECT_NEQ ( 0 , soa );
+
+    // TEST 2.1: soa_create initializes the length, capacity and column count.
+    EXPECT_EQ ( 0 , soa_length ( soa ) );
+    EXPECT_EQ ( SOA_DEFAULT_CAPACITY , soa_capacity ( soa ) );
+    EXPECT_EQ ( 3 , soa_column_count ( soa ) );
+
+    for ( u64 i = 0; i < soa_column_count ( soa ); ++i )
+    {
+        const void* column = soa_column ( soa , i );
+
+        // TEST 2.2: Each column is aligned to SOA_ALIGNMENT.
+        EXPECT_NEQ ( 0 , column );
+        EXPECT_EQ ( 0 , ( ( u64 ) column ) % SOA_ALIGNMENT );
+
+        // TEST 2.3: Each column is a valid resizable array view.
+        EXPECT_EQ ( 0 , array_length ( column ) );
+        EXPECT_EQ ( SOA_DEFAULT_CAPACITY , array_capacity ( column ) );
+        EXPECT_EQ ( strides[ i ] , array_stride ( column ) );
+    }
+
+    // TEST 2.4: soa_column fails on an out of bounds column.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , soa_column ( soa , 3 ) );
+
+    // TEST 3: soa_reserve grows to exactly the requested capacity, and never shrinks.
+    soa_reserve ( soa , 1000 );
+    EXPECT_EQ ( 1000 , soa_capacity ( soa ) );
+    EXPECT_EQ ( 1000 , array_capacity ( soa_column ( soa , 1 ) ) );
+    EXPECT_EQ ( 0 , ( ( u64 ) soa_column ( soa , 2 ) ) % SOA_ALIGNMENT );
+    soa_reserve ( soa , 1 );
+    EXPECT_EQ ( 1000 , soa_capacity ( soa ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    soa_destroy ( soa );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_soa_push_pop_and_remove
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 max_op = 10000;
+    soa_t* soa = soa_create ( 1 , sizeof ( f32 ) , sizeof ( u64 ) , sizeof ( u8 ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , soa );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: soa_push.
+
+    for ( u64 i = 0; i < max_op; ++i )
+    {
+        const f32 x = ( f32 ) i;
+        const u64 id = i * 3;
+        const u8 flag = ( u8 ) i;
+
+        // TEST 1.1: soa_push succeeds.
+        EXPECT ( soa_push ( soa , &x , &id , &flag ) );
+
+        // TEST 1.2: soa_push increases the length by 1.
+        EXPECT_EQ ( i + 1 , soa_length ( soa ) );
+    }
+
+    // TEST 1.3: soa_push keeps the columns in step, and their array views up to date.
+    const f32* xs = soa_column ( soa , 0 );
+    const u64* ids = soa_column ( soa , 1 );
+    const u8* flags = soa_column ( soa , 2 );
+    for ( u64 i = 0; i < max_op; ++i )
+    {
+        EXPECT_EQ ( ( f32 ) i , xs[ i ] );
+        EXPECT_EQ ( i * 3 , ids[ i ] );
+        EXPECT_EQ ( ( u8 ) i , flags[ i ] );
+    }
+    for ( u64 i = 0; i < soa_column_count ( soa ); ++i )
+    {
+        EXPECT_EQ ( max_op , array_length ( soa_column ( soa , i ) ) );
+        EXPECT_EQ ( soa_capacity ( soa ) , array_capacity ( soa_column ( soa , i ) ) );
+    }
+
+    // TEST 1.4: soa_push fails if the number of fields does not match the number of columns.
+    const f32 x = 0.0f;
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( soa_push ( soa , &x ) );
+    EXPECT_EQ ( max_op , soa_length ( soa ) );
+
+    // TEST 2: soa_pop.
+
+    f32 popped_x = 0;
+    u64 popped_id = 0;
+
+    // TEST 2.1: soa_pop retrieves every field of the last record.
+    u8 popped_flag = 0;
+    EXPECT ( soa_pop ( soa , &popped_x , &popped_id , &popped_flag ) );
+    EXPECT_EQ ( ( f32 )( max_op - 1 ) , popped_x );
+    EXPECT_EQ ( ( max_op - 1 ) * 3 , popped_id );
+    EXPECT_EQ ( ( u8 )( max_op - 1 ) , popped_flag );
+    EXPECT_EQ ( max_op - 1 , soa_length ( soa ) );
+    EXPECT_EQ ( max_op - 1 , array_length ( soa_column ( soa , 2 ) ) );
+
+    // TEST 2.2: soa_pop retrieves only the requested fields.
+    popped_x = 0;
+    EXPECT ( soa_pop ( soa , 0 , &popped_id ) );
+    EXPECT_EQ ( 0 , popped_x );
+    EXPECT_EQ ( ( max_op - 2 ) * 3 , popped_id );
+
+    // TEST 2.3: soa_pop succeeds when no output buffer is provided.
+    EXPECT ( _soa_pop ( soa , 0 , 0 ) );
+    EXPECT_EQ ( max_op - 3 , soa_length ( soa ) );
+
+    // TEST 3: soa_remove_swap.
+
+    const u64 length = soa_length ( soa );
+
+    // TEST 3.1: soa_remove_swap retrieves the removed record.
+    EXPECT ( soa_remove_swap ( soa , 10 , &popped_x , &popped_id ) );
+    EXPECT_EQ ( 10.0f , popped_x );
+    EXPECT_EQ ( 30 , popped_id );
+    EXPECT_EQ ( length - 1 , soa_length ( soa ) );
+
+    // TEST 3.2: soa_remove_swap moves the last record into the hole, in every column.
+    xs = soa_column ( soa , 0 );
+    ids = soa_column ( soa , 1 );
+    flags = soa_column ( soa , 2 );
+    EXPECT_EQ ( ( f32 )( length - 1 ) , xs[ 10 ] );
+    EXPECT_EQ ( ( length - 1 ) * 3 , ids[ 10 ] );
+    EXPECT_EQ ( ( u8 )( length - 1 ) , flags[ 10 ] );
+    EXPECT_EQ ( 9.0f , xs[ 9 ] );
+    EXPECT_EQ ( 11.0f , xs[ 11 ] );
+
+    // TEST 3.3: soa_remove_swap on the last record.
+    EXPECT ( soa_remove_swap ( soa , soa_length ( soa ) - 1 , 0 ) );
+    EXPECT_EQ ( length - 2 , soa_length ( soa ) );
+
+    // TEST 3.4: soa_remove_swap fails on an out of bounds index.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( soa_remove_swap ( soa , soa_length ( soa ) , 0 ) );
+    EXPECT_EQ ( length - 2 , soa_length ( soa ) );
+
+    // TEST 4: soa_pop fails on an empty structure-of-arrays.
+    while ( soa_length ( soa ) )
+    {
+        EXPECT ( soa_pop ( soa , 0 ) );
+    }
+    LOGWARN ( "The following warning is intentionally triggered by a test:" );
+    EXPECT_NOT ( soa_pop ( soa , 0 ) );
+    EXPECT_EQ ( 0 , array_length ( soa_column ( soa , 0 ) ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    soa_destroy ( soa );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_soa_sort
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const i32 keys[] = { 5 , -3 , 9 , 0 , 7 , -8 , 2 , 1 };
+    const i32 sorted[] = { -8 , -3 , 0 , 1 , 2 , 5 , 7 , 9 };
+    const u64 count = sizeof ( keys ) / sizeof ( i32 );
+    soa_t* soa = soa_create ( SOA_DEFAULT_CAPACITY , sizeof ( u16 ) , sizeof ( i32 ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , soa );
+
+    for ( u64 i = 0; i < count; ++i )
+    {
+        // The first column holds the negation of the key, so the columns can be checked against each other.
+        const u16 value = ( u16 )( -keys[ i ] );
+        EXPECT ( soa_push ( soa , &value , &keys[ i ] ) );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: soa_sort sorts by the key column, keeping the other columns in step.
+    EXPECT ( soa_sort ( soa , 1 , test_soa_sort_compare ) );
+    const u16* values = soa_column ( soa , 0 );
+    const i32* sorted_keys = soa_column ( soa , 1 );
+    EXPECT ( memory_equal ( sorted_keys , sorted , sizeof ( sorted ) ) );
+    for ( u64 i = 0; i < count; ++i )
+    {
+        EXPECT_EQ ( ( u16 )( -sorted[ i ] ) , values[ i ] );
+    }
+
+    // TEST 2: soa_sort_radix sorts by the key column, keeping the other columns in step.
+    EXPECT ( soa_sort_radix ( soa , 0 , SORT_KEY_U16 ) );
+    for ( u64 i = 1; i < count; ++i )
+    {
+        EXPECT ( values[ i - 1 ] <= values[ i ] );
+    }
+    for ( u64 i = 0; i < count; ++i )
+    {
+        EXPECT_EQ ( ( u16 )( -sorted_keys[ i ] ) , values[ i ] );
+    }
+
+    // TEST 3: soa_sort and soa_sort_radix handle invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( soa_sort ( soa , 2 , test_soa_sort_compare ) );
+    EXPECT_NOT ( soa_sort_radix ( soa , 2 , SORT_KEY_I32 ) );
+    EXPECT_NOT ( soa_sort_radix ( soa , 1 , SORT_KEY_I64 ) );
+
+    // TEST 4: soa_permute.
+    EXPECT ( soa_sort ( soa , 1 , test_soa_sort_compare ) );
+    u64 reverse[ sizeof ( keys ) / sizeof ( i32 ) ];
+    for ( u64 i = 0; i < count; ++i )
+    {
+        reverse[ i ] = count - 1 - i;
+    }
+    soa_permute ( soa , reverse );
+    for ( u64 i = 0; i < count; ++i )
+    {
+        EXPECT_EQ ( sorted[ count - 1 - i ] , sorted_keys[ i ] );
+        EXPECT_EQ ( ( u16 )( -sorted[ count - 1 - i ] ) , values[ i ] );
+    }
+
+    // TEST 5: A column can be formatted with the %a modifier.
+    soa_sort ( soa , 1 , test_soa_sort_compare );
+    char* string = string_format ( "%ai" , soa_column ( soa , 1 ) );
+    const char* expected = "{ `-8`, `-3`, `0`, `1`, `2`, `5`, `7`, `9` }";
+    EXPECT_EQ ( _string_length ( expected ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , expected , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    soa_destroy ( soa );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_soa
+( void )
+{
+    test_register ( test_soa_create_and_destroy , "Allocating memory for a structure-of-arrays data structure." );
+    test_register ( test_soa_push_pop_and_remove , "Testing structure-of-arrays 'push', 'pop' and 'remove_swap' operations." );
+    test_register ( test_soa_sort , "Testing structure-of-arrays 'sort' and 'permute' operations." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_soa.h
+ * @brief Tests container/soa.h
+ * (see test/test.h, container/soa.h for additional details)
+ */
+#ifndef TEST_SOA_H
+#define TEST_SOA_H
+
+#include "test/test.h"
+
+#include "container/soa.h"
+
+void
+test_register_soa
+( void );
+
+#endif  // TEST_SOA_H
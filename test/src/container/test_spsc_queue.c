@@ -0,0 +1,242 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_spsc_queue.c
+ * @brief Implementation of the container/test_spsc_queue header.
+ * (see container/test_spsc_queue.h for additional details)
+ */
+#include "container/test_spsc_queue.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/thread.h"
+
+/** @brief Type definition for producer thread arguments. */
+typedef struct
+{
+    spsc_queue_t*   queue;
+    u64             count;
+}
+producer_t;
+
+/**
+ * @brief Producer thread: pushes the integers [ 0 , count ) in order.
+ */
+u32
+test_spsc_queue_producer
+(   void* args
+)
+{
+    producer_t* producer = args;
+    for ( u64 i = 0; i < ( *producer ).count; )
+    {
+        if ( spsc_queue_push ( ( *producer ).queue , &i ) )
+        {
+            i += 1;
+        }
+    }
+    return 0;
+}
+
+u8
+test_spsc_queue_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    spsc_queue_t* queue;
+    u64 memory_requirement;
+    void* memory;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: spsc_queue_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( spsc_queue_create ( 0 , 1 , 0 , 0 , &queue ) );
+    EXPECT_NOT ( spsc_queue_create ( 1 , 0 , 0 , 0 , &queue ) );
+    EXPECT_NOT ( spsc_queue_create ( 1 , 1 , 0 , 0 , 0 ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: spsc_queue_create with implicit memory allocation.
+    queue = 0;
+    EXPECT ( spsc_queue_create ( sizeof ( u32 ) , 100 , &memory_requirement , 0 , 0 ) );
+    EXPECT ( spsc_queue_create ( sizeof ( u32 ) , 100 , 0 , 0 , &queue ) );
+    EXPECT_NEQ ( 0 , queue );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    EXPECT_EQ ( queue_amount_allocated + memory_requirement , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+
+    // TEST 3: Queue capacity is rounded up to a power of two.
+    EXPECT_EQ ( 128 , spsc_queue_capacity ( queue ) );
+    EXPECT_EQ ( sizeof ( u32 ) , spsc_queue_stride ( queue ) );
+    EXPECT_EQ ( 0 , spsc_queue_length ( queue ) );
+
+    // TEST 4: spsc_queue_destroy frees the queue and nullifies the handle.
+    spsc_queue_destroy ( &queue );
+    EXPECT_EQ ( 0 , queue );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: spsc_queue_create with a pre-allocated buffer does not modify the global allocator state.
+    memory = memory_allocate_aligned ( memory_requirement , 64 , MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+    EXPECT ( spsc_queue_create ( sizeof ( u32 ) , 100 , 0 , memory , &queue ) );
+    EXPECT_EQ ( memory , queue );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    spsc_queue_destroy ( &queue );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+    memory_free_aligned ( memory , memory_requirement , 64 , MEMORY_TAG_QUEUE );
+
+    // TEST 6: spsc_queue_destroy handles invalid arguments.
+    spsc_queue_destroy ( 0 );
+    spsc_queue_destroy ( &queue );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+
+    return true;
+}
+
+u8
+test_spsc_queue_push_and_pop
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 capacity = 16;
+    spsc_queue_t* queue = 0;
+    u64 popped;
+
+    EXPECT ( spsc_queue_create ( sizeof ( u64 ) , capacity , 0 , 0 , &queue ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , queue );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: spsc_queue_pop fails on an empty queue.
+    EXPECT_NOT ( spsc_queue_pop ( queue , &popped ) );
+
+    // Fill and drain the queue several times, so that the indices wrap around.
+    for ( u64 lap = 0; lap < 5; ++lap )
+    {
+        // TEST 2: spsc_queue_push succeeds until the queue is full.
+        for ( u64 i = 0; i < capacity; ++i )
+        {
+            const u64 value = lap * capacity + i;
+            EXPECT ( spsc_queue_push ( queue , &value ) );
+            EXPECT_EQ ( i + 1 , spsc_queue_length ( queue ) );
+        }
+
+        // TEST 3: spsc_queue_push fails on a full queue.
+        EXPECT_NOT ( spsc_queue_push ( queue , &popped ) );
+
+        // TEST 4: spsc_queue_pop removes the elements in order.
+        for ( u64 i = 0; i < capacity; ++i )
+        {
+            EXPECT ( spsc_queue_pop ( queue , &popped ) );
+            EXPECT_EQ ( lap * capacity + i , popped );
+        }
+        EXPECT_NOT ( spsc_queue_pop ( queue , 0 ) );
+        EXPECT_EQ ( 0 , spsc_queue_length ( queue ) );
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    spsc_queue_destroy ( &queue );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_spsc_queue_concurrent
+( void )
+{
+    u64 global_amount_allocated;
+    u64 queue_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    queue_amount_allocated = memory_amount_allocated ( MEMORY_TAG_QUEUE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    producer_t producer;
+    thread_t thread;
+    u64 popped;
+
+    producer.queue = 0;
+    producer.count = 1000000;
+    EXPECT ( spsc_queue_create ( sizeof ( u64 ) , 256 , 0 , 0 , &producer.queue ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , producer.queue );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    EXPECT ( thread_create ( test_spsc_queue_producer , &producer , false , &thread ) );
+
+    // TEST 1: Every element pushed by the producer thread is received by the consumer thread, in order.
+    for ( u64 i = 0; i < producer.count; )
+    {
+        if ( spsc_queue_pop ( producer.queue , &popped ) )
+        {
+            EXPECT_EQ ( i , popped );
+            i += 1;
+        }
+    }
+    EXPECT ( thread_wait ( &thread ) );
+
+    // TEST 2: The queue is empty once every element has been received.
+    EXPECT_NOT ( spsc_queue_pop ( producer.queue , &popped ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    thread_destroy ( &thread );
+    spsc_queue_destroy ( &producer.queue );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( queue_amount_allocated , memory_amount_allocated ( MEMORY_TAG_QUEUE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_spsc_queue
+( void )
+{
+    test_register_serial ( test_spsc_queue_create_and_destroy , "Creating or destroying a single-producer single-consumer queue." );
+    test_register_serial ( test_spsc_queue_push_and_pop , "Testing single-producer single-consumer queue 'push' and 'pop' operations." );
+    test_register_serial ( test_spsc_queue_concurrent , "Testing single-producer single-consumer queue with a producer thread and a consumer thread." );
+}
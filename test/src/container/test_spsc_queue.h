@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file container/test_spsc_queue.h
+ * @brief Tests container/spsc_queue.h
+ * (see test/test.h, container/spsc_queue.h for additional details)
+ */
+#ifndef TEST_SPSC_QUEUE_H
+#define TEST_SPSC_QUEUE_H
+
+#include "test/test.h"
+
+#include "container/spsc_queue.h"
+
+void
+test_register_spsc_queue
+( void );
+
+#endif  // TEST_SPSC_QUEUE_H
@@ -669,6 +669,25 @@ test_string_trim
     EXPECT ( memory_equal ( string , trimmed , _string_length ( trimmed ) ) );
     string_clear ( string );
 
+    // TEST 6: string_trim keeps a single non-whitespace character at either end.
+    _string_push ( string , "      x" );
+    string_trim ( string );
+    EXPECT_EQ ( 1 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "x" , 2 ) );
+    string_clear ( string );
+    _string_push ( string , "x      " );
+    string_trim ( string );
+    EXPECT_EQ ( 1 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "x" , 2 ) );
+    string_clear ( string );
+
+    // TEST 7: string_trim trims whitespace runs longer than a vector.
+    _string_push ( string , "                                        \t\t<-- Trim this off -->\n                                        " );
+    string_trim ( string );
+    EXPECT_EQ ( _string_length ( trimmed ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , trimmed , _string_length ( trimmed ) + 1 ) );
+    string_clear ( string );
+
     // End test.
     ////////////////////////////////////////////////////////////////////////////
 
@@ -824,12 +843,320 @@ test_string_contains
     EXPECT ( string_contains ( search2 , search2_length , find26 , sizeof ( find26 ) , true , &index ) );
     EXPECT_EQ ( 4 , index );
 
+    // TEST 29: string_contains locates substrings at every offset of a string longer than one vector, including the last.
+    char long_search[ 200 ];
+    for ( u64 i = 0; i < sizeof ( long_search ); ++i )
+    {
+        long_search[ i ] = 'a' + i % 7;
+    }
+    long_search[ sizeof ( long_search ) - 1 ] = 'z';
+    for ( u64 i = 0; i + 5 <= sizeof ( long_search ); ++i )
+    {
+        EXPECT ( string_contains ( long_search , sizeof ( long_search ) , long_search + i , 5 , false , &index ) );
+        EXPECT_EQ ( ( i < 7 ) ? i : ( i == sizeof ( long_search ) - 5 ) ? i : i % 7 , index );
+        EXPECT ( string_contains ( long_search , sizeof ( long_search ) , long_search + i , 5 , true , &index ) );
+        EXPECT_EQ ( ( i == sizeof ( long_search ) - 5 ) ? i : ( sizeof ( long_search ) - 6 ) - ( ( sizeof ( long_search ) - 6 - i ) % 7 ) , index );
+    }
+
+    // TEST 30: string_contains on a long substring which matches the first and last character everywhere (Two-Way fallback).
+    const u64 pathological_length = KiB ( 64 );
+    char* pathological = string_allocate ( pathological_length + 1 );
+    char* pathological_find = string_allocate ( 101 );
+    memory_set ( pathological , 'a' , pathological_length );
+    memory_set ( pathological_find , 'a' , 100 );
+    pathological_find[ 50 ] = 'b';
+    EXPECT_NOT ( string_contains ( pathological , pathological_length , pathological_find , 100 , false , &index ) );
+    pathological[ pathological_length - 50 ] = 'b';
+    EXPECT ( string_contains ( pathological , pathological_length , pathological_find , 100 , false , &index ) );
+    EXPECT_EQ ( pathological_length - 100 , index );
+    EXPECT ( string_contains ( pathological , pathological_length , pathological_find , 100 , true , &index ) );
+    EXPECT_EQ ( pathological_length - 100 , index );
+    string_free ( pathological );
+    string_free ( pathological_find );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_string_find_all
+( void )
+{
+    const char* search = "abababa, abab; ba";
+    u64 indices[ 8 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: string_find_all finds non-overlapping occurrences from left to right.
+    EXPECT_EQ ( 5 , _string_find_all ( search , "ab" , indices , 8 ) );
+    EXPECT_EQ ( 0 , indices[ 0 ] );
+    EXPECT_EQ ( 2 , indices[ 1 ] );
+    EXPECT_EQ ( 4 , indices[ 2 ] );
+    EXPECT_EQ ( 9 , indices[ 3 ] );
+    EXPECT_EQ ( 11 , indices[ 4 ] );
+    EXPECT_EQ ( 3 , _string_find_all ( search , "aba" , indices , 8 ) );
+    EXPECT_EQ ( 0 , indices[ 0 ] );
+    EXPECT_EQ ( 4 , indices[ 1 ] );
+    EXPECT_EQ ( 9 , indices[ 2 ] );
+
+    // TEST 2: string_find_all counts every occurrence, but writes at most capacity indices.
+    indices[ 2 ] = 0xDEADBEEF;
+    EXPECT_EQ ( 5 , _string_find_all ( search , "ba" , indices , 2 ) );
+    EXPECT_EQ ( 1 , indices[ 0 ] );
+    EXPECT_EQ ( 3 , indices[ 1 ] );
+    EXPECT_EQ ( 0xDEADBEEF , indices[ 2 ] );
+    EXPECT_EQ ( 5 , _string_find_all ( search , "ba" , 0 , 0 ) );
+
+    // TEST 3: string_find_all finds nothing if the substring is empty, absent, or too long.
+    EXPECT_EQ ( 0 , _string_find_all ( search , "" , indices , 8 ) );
+    EXPECT_EQ ( 0 , _string_find_all ( search , "abc" , indices , 8 ) );
+    EXPECT_EQ ( 0 , _string_find_all ( "ab" , "aba" , indices , 8 ) );
+
     // End test.
     ////////////////////////////////////////////////////////////////////////////
 
     return true;
 }
 
+u8
+test_string_view
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* hello = "Hello world!";
+    char* resizable_string = string_create_from ( hello );
+    string_view_t views[ 2 ];
+    string_view_t* array = array_create ( string_view_t , 2 );
+    char* string;
+    u64 index;
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , resizable_string );
+    EXPECT_NEQ ( 0 , array );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A view refers to the characters of a null-terminated string or a resizable string without copying them.
+    views[ 0 ] = _string_view ( hello );
+    views[ 1 ] = string_view_of ( resizable_string );
+    EXPECT_EQ ( hello , views[ 0 ].string );
+    EXPECT_EQ ( _string_length ( hello ) , views[ 0 ].length );
+    EXPECT_EQ ( resizable_string , views[ 1 ].string );
+    EXPECT_EQ ( string_length ( resizable_string ) , views[ 1 ].length );
+    EXPECT ( string_view_equal ( views[ 0 ] , views[ 1 ] ) );
+
+    // TEST 2: string_view_slice takes a substring without copying, and clamps it to the bounds of the view.
+    views[ 1 ] = string_view_slice ( views[ 0 ] , 6 , 5 );
+    EXPECT_EQ ( hello + 6 , views[ 1 ].string );
+    EXPECT_EQ ( 5 , views[ 1 ].length );
+    EXPECT ( string_view_equal ( views[ 1 ] , _string_view ( "world" ) ) );
+    EXPECT_EQ ( 6 , string_view_slice ( views[ 0 ] , 6 , 100 ).length );
+    EXPECT_EQ ( 0 , string_view_slice ( views[ 0 ] , 100 , 1 ).length );
+    EXPECT_EQ ( hello + views[ 0 ].length , string_view_slice ( views[ 0 ] , 100 , 1 ).string );
+
+    // TEST 3: string_view_contains searches only within the view.
+    EXPECT ( string_view_contains ( views[ 0 ] , views[ 1 ] , false , &index ) );
+    EXPECT_EQ ( 6 , index );
+    EXPECT_NOT ( string_view_contains ( string_view_slice ( views[ 0 ] , 0 , 10 ) , views[ 1 ] , false , 0 ) );
+    EXPECT_NOT ( string_view_equal ( views[ 1 ] , _string_view ( "world!" ) ) );
+
+    // TEST 4: string_view_hash hashes only the characters within the view.
+    EXPECT_EQ ( hash64 ( "world" , 5 , 7 ) , string_view_hash ( views[ 1 ] , 7 ) );
+
+    // TEST 5: String view format specifier, with and without modifiers.
+    string = string_format ( "`%v` `%Pr.8v` `%v`" , &views[ 1 ] , &views[ 1 ] , 0 );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( _string_length ( "`world` `world...` ``" ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "`world` `world...` ``" , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // TEST 6: String view format specifier, with array format modifier.
+    array_push ( array , views[ 1 ] );
+    array_push ( array , string_view_slice ( views[ 0 ] , 0 , 5 ) );
+    string = string_format ( "%av" , array );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( _string_length ( "{ `world`, `Hello` }" ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "{ `world`, `Hello` }" , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    array_destroy ( array );
+    string_destroy ( resizable_string );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_string_small
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* hello = "Hello world!";
+    const char* long_string = "This string is too long to fit within small string storage.";
+    string_small_t small;
+    char* string;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A string which fits within small string storage does not allocate memory.
+    string = string_create_small_from ( &small , hello );
+    EXPECT_EQ ( small.data , string );
+    EXPECT_NOT ( string_owns_memory ( string ) );
+    EXPECT_EQ ( _string_length ( hello ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , hello , string_length ( string ) + 1 ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: A small string may be mutated in place.
+    _string_push ( string , " Hello!" );
+    string_remove ( string , 0 , 6 );
+    _string_replace ( string , "Hello" , "world" );
+    EXPECT_EQ ( small.data , string );
+    EXPECT_EQ ( _string_length ( "world! world!" ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "world! world!" , string_length ( string ) + 1 ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 3: string_destroy does nothing for a small string.
+    string_destroy ( string );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 4: A small string which outgrows small string storage is moved to dynamic memory.
+    string = string_create_small ( &small );
+    EXPECT_EQ ( 0 , string_length ( string ) );
+    EXPECT_EQ ( 0 , *string );
+    _string_push ( string , long_string );
+    EXPECT_NEQ ( small.data , string );
+    EXPECT ( string_owns_memory ( string ) );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    EXPECT_EQ ( _string_length ( long_string ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , long_string , string_length ( string ) + 1 ) );
+    string_destroy ( string );
+
+    // TEST 5: A string which does not fit within small string storage is allocated.
+    string = _string_create_small ( &small , long_string , _string_length ( long_string ) );
+    EXPECT ( string_owns_memory ( string ) );
+    EXPECT_EQ ( _string_length ( long_string ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , long_string , string_length ( string ) + 1 ) );
+    string_destroy ( string );
+
+    // TEST 6: A string of STRING_SMALL_CAPACITY - 1 characters just fits within small string storage.
+    string = _string_create_small ( &small , long_string , STRING_SMALL_CAPACITY - 1 );
+    EXPECT_NOT ( string_owns_memory ( string ) );
+    EXPECT_EQ ( STRING_SMALL_CAPACITY - 1 , string_length ( string ) );
+    _string_insert ( string , 0 , "!" );
+    EXPECT ( string_owns_memory ( string ) );
+    EXPECT_EQ ( STRING_SMALL_CAPACITY , string_length ( string ) );
+    EXPECT_EQ ( '!' , string[ 0 ] );
+    EXPECT ( memory_equal ( string + 1 , long_string , STRING_SMALL_CAPACITY - 1 ) );
+    string_destroy ( string );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+/**
+ * @brief Predicate function used by test_string_remove_if.
+ *
+ * @param element The address of a character.
+ * @param args The address of the character to remove.
+ * @return true if the characters are equal; false otherwise.
+ */
+bool
+test_string_remove_if_predicate
+(   const void* element
+,   void*       args
+)
+{
+    return *( ( const char* ) element ) == *( ( char* ) args );
+}
+
+u8
+test_string_remove_if
+( void )
+{
+    u64 global_amount_allocated;
+    u64 string_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    string_amount_allocated = memory_amount_allocated ( MEMORY_TAG_STRING );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* in = "a-b--c---d";
+    const char* out = "abcd";
+    char remove = '-';
+    string_small_t small;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: string_remove_if removes every matching character from a resizable string.
+    char* string = string_create_from ( in );
+    string_remove_if ( string , test_string_remove_if_predicate , &remove );
+    EXPECT_EQ ( _string_length ( out ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , out , string_length ( string ) + 1 ) );
+
+    // TEST 2: string_remove_if can remove every character.
+    remove = 'a';
+    string_remove_if ( string , test_string_remove_if_predicate , &remove );
+    remove = 'b';
+    string_remove_if ( string , test_string_remove_if_predicate , &remove );
+    remove = 'c';
+    string_remove_if ( string , test_string_remove_if_predicate , &remove );
+    remove = 'd';
+    string_remove_if ( string , test_string_remove_if_predicate , &remove );
+    EXPECT_EQ ( 0 , string_length ( string ) );
+    EXPECT_EQ ( 0 , string[ 0 ] );
+    string_destroy ( string );
+
+    // TEST 3: string_remove_if works within small string storage.
+    remove = '-';
+    string = _string_create_small ( &small , in , _string_length ( in ) );
+    string_remove_if ( string , test_string_remove_if_predicate , &remove );
+    EXPECT_EQ ( _string_length ( out ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , out , string_length ( string ) + 1 ) );
+    string_destroy ( string );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( string_amount_allocated , memory_amount_allocated ( MEMORY_TAG_STRING ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 u8
 test_string_reverse
 ( void )
@@ -950,6 +1277,34 @@ test_string_replace
     EXPECT_EQ ( _string_length ( removed_replaced ) , string_length ( string ) );
     EXPECT ( memory_equal ( string , removed_replaced , string_length ( string ) + 1 ) );
 
+    // TEST 8: string_replace does not rescan a replacement which contains the substring to remove.
+    string_clear ( string );
+    _string_push ( string , "a-a-a" );
+    _string_replace ( string , "a" , "aa" );
+    EXPECT_EQ ( 8 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "aa-aa-aa" , string_length ( string ) + 1 ) );
+    _string_replace ( string , "-" , "" );
+    EXPECT_EQ ( 6 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "aaaaaa" , string_length ( string ) + 1 ) );
+
+    // TEST 9: string_replace with a same-length replacement replaces every occurrence in place.
+    _string_replace ( string , "aa" , "ab" );
+    EXPECT_EQ ( 6 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "ababab" , string_length ( string ) + 1 ) );
+
+    // TEST 10: string_replace handles more occurrences than fit on the stack.
+    string_clear ( string );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        _string_push ( string , "x." );
+    }
+    _string_replace ( string , "." , ", " );
+    EXPECT_EQ ( 3000 , string_length ( string ) );
+    EXPECT ( memory_equal ( string + 2997 , "x, " , 4 ) );
+    _string_replace ( string , ", " , "" );
+    EXPECT_EQ ( 1000 , string_length ( string ) );
+    EXPECT_EQ ( 'x' , string[ 999 ] );
+
     // End test.
     ////////////////////////////////////////////////////////////////////////////
 
@@ -1064,6 +1419,108 @@ test_string_strip_ansi
     return true;
 }
 
+u8
+test_string_ascii
+( void )
+{
+    const char* mixed = "The Quick Brown Fox Jumps Over The Lazy Dog @ [0-9] `{|}~ 0123456789 and THEN some MORE text!";
+    const char* lower = "the quick brown fox jumps over the lazy dog @ [0-9] `{|}~ 0123456789 and then some more text!";
+    const char* upper = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG @ [0-9] `{|}~ 0123456789 AND THEN SOME MORE TEXT!";
+    const char* ansi = "\033[1;31mERROR\033[0m: A long enough message to span more than one vector, \033[32mcolored\033[0m.\033[m";
+    const char* ansi_stripped = "ERROR: A long enough message to span more than one vector, colored.";
+    const char* ansi_illegal = "\033[1;3x\033[ \033 [0m \033[1;31 text \033";
+    char string[ 128 ];
+    char stripped[ 128 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: string_to_lowercase and string_to_uppercase convert only Latin letters.
+    const u64 length = _string_length ( mixed );
+    for ( u64 i = 0; i <= length; ++i )
+    {
+        memory_copy ( string , mixed , length + 1 );
+        string_to_lowercase ( string , i );
+        EXPECT ( memory_equal ( string , lower , i ) );
+        EXPECT ( memory_equal ( string + i , mixed + i , length - i + 1 ) );
+        memory_copy ( string , mixed , length + 1 );
+        string_to_uppercase ( string , i );
+        EXPECT ( memory_equal ( string , upper , i ) );
+        EXPECT ( memory_equal ( string + i , mixed + i , length - i + 1 ) );
+    }
+    memory_copy ( string , "\xC0\xE0\xFF@[`{" , 8 );
+    string_to_uppercase ( string_to_lowercase ( string , 7 ) , 7 );
+    EXPECT ( memory_equal ( string , "\xC0\xE0\xFF@[`{" , 8 ) );
+
+    // TEST 2: string_leading_whitespace and string_trailing_whitespace count every whitespace character.
+    memory_set ( string , ' ' , 100 );
+    for ( u64 i = 0; i < 100; ++i )
+    {
+        string[ i ] = 'x';
+        EXPECT_EQ ( i , string_leading_whitespace ( string , 100 ) );
+        EXPECT_EQ ( 99 - i , string_trailing_whitespace ( string , 100 ) );
+        string[ i ] = "\t\n\v\f\r "[ i % 6 ];
+    }
+    EXPECT_EQ ( 100 , string_leading_whitespace ( string , 100 ) );
+    EXPECT_EQ ( 100 , string_trailing_whitespace ( string , 100 ) );
+    EXPECT_EQ ( 0 , string_leading_whitespace ( string , 0 ) );
+    EXPECT_EQ ( 0 , string_trailing_whitespace ( string , 0 ) );
+    string[ 50 ] = '\x08'; // Not whitespace.
+    EXPECT_EQ ( 50 , string_leading_whitespace ( string , 100 ) );
+    EXPECT_EQ ( 49 , string_trailing_whitespace ( string , 100 ) );
+    string[ 50 ] = '\x0E'; // Not whitespace.
+    EXPECT_EQ ( 50 , string_leading_whitespace ( string , 100 ) );
+
+    // TEST 3: string_ascii rejects any byte outside [0..127], wherever it is.
+    EXPECT ( string_ascii ( mixed , length ) );
+    EXPECT ( string_ascii ( mixed , 0 ) );
+    for ( u64 i = 0; i < length; ++i )
+    {
+        memory_copy ( string , mixed , length + 1 );
+        string[ i ] = ( char ) 0x80;
+        EXPECT_NOT ( string_ascii ( string , length ) );
+        EXPECT ( string_ascii ( string , i ) );
+    }
+
+    // TEST 4: string_utf8 accepts well-formed UTF-8.
+    const char* utf8 = "ASCII, then \xC3\xA9 (U+00E9), \xE2\x82\xAC (U+20AC), \xED\x9F\xBF (U+D7FF), \xF0\x9F\x98\x80 (U+1F600) and \xF4\x8F\xBF\xBF (U+10FFFF).";
+    EXPECT ( string_utf8 ( utf8 , _string_length ( utf8 ) ) );
+    EXPECT ( string_utf8 ( mixed , length ) );
+    EXPECT ( string_utf8 ( mixed , 0 ) );
+
+    // TEST 5: string_utf8 rejects malformed UTF-8.
+    EXPECT_NOT ( string_utf8 ( "\x80" , 1 ) );                  // Lone continuation byte.
+    EXPECT_NOT ( string_utf8 ( "\xC3" , 1 ) );                  // Truncated sequence.
+    EXPECT_NOT ( string_utf8 ( "\xE2\x82" , 2 ) );              // Truncated sequence.
+    EXPECT_NOT ( string_utf8 ( "\xC3\x28" , 2 ) );              // Invalid continuation byte.
+    EXPECT_NOT ( string_utf8 ( "\xC0\xAF" , 2 ) );              // Overlong encoding.
+    EXPECT_NOT ( string_utf8 ( "\xE0\x80\xAF" , 3 ) );          // Overlong encoding.
+    EXPECT_NOT ( string_utf8 ( "\xF0\x80\x80\xAF" , 4 ) );      // Overlong encoding.
+    EXPECT_NOT ( string_utf8 ( "\xED\xA0\x80" , 3 ) );          // Surrogate.
+    EXPECT_NOT ( string_utf8 ( "\xF4\x90\x80\x80" , 4 ) );      // Beyond U+10FFFF.
+    EXPECT_NOT ( string_utf8 ( "\xF5\x80\x80\x80" , 4 ) );      // Invalid lead byte.
+    memory_copy ( string , mixed , length + 1 );
+    string[ length - 1 ] = ( char ) 0xE2;
+    EXPECT_NOT ( string_utf8 ( string , length ) );
+
+    // TEST 6: string_strip_ansi_to omits every ANSI formatting code.
+    EXPECT_EQ ( _string_length ( ansi_stripped ) , string_strip_ansi_to ( stripped , ansi , _string_length ( ansi ) ) );
+    EXPECT ( memory_equal ( stripped , ansi_stripped , _string_length ( ansi_stripped ) ) );
+    EXPECT_EQ ( _string_length ( ansi_illegal ) , string_strip_ansi_to ( stripped , ansi_illegal , _string_length ( ansi_illegal ) ) );
+    EXPECT ( memory_equal ( stripped , ansi_illegal , _string_length ( ansi_illegal ) ) );
+    EXPECT_EQ ( 0 , string_strip_ansi_to ( stripped , ansi , 0 ) );
+
+    // TEST 7: string_strip_ansi_to may strip a string in-place.
+    memory_copy ( string , ansi , _string_length ( ansi ) + 1 );
+    EXPECT_EQ ( _string_length ( ansi_stripped ) , string_strip_ansi_to ( string , string , _string_length ( ansi ) ) );
+    EXPECT ( memory_equal ( string , ansi_stripped , _string_length ( ansi_stripped ) ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
 u8
 test_string_u64_and_i64
 ( void )
@@ -1198,8 +1655,504 @@ u8
 test_string_f64
 ( void )
 {
-    // TODO: Implement this.
-    return BYPASS;
+    // Infinity and quiet NaN (with the sign bit clear).
+    const u64 infinity_bits = 0x7FF0000000000000;
+    const u64 nan_bits = 0x7FF8000000000000;
+    f64 infinity;
+    f64 not_a_number;
+    memory_copy ( &infinity , &infinity_bits , sizeof ( f64 ) );
+    memory_copy ( &not_a_number , &nan_bits , sizeof ( f64 ) );
+
+    // Fixed precision, checked against printf's %.<n>f and %.<n>E.
+    const struct
+    {
+        f64         value;
+        u8          precision;
+        bool        abbreviated;
+        const char* out;
+    }
+    fixed[] = { { 0.0 , 0 , false , "0" }
+              , { -0.0 , 2 , false , "-0.00" }
+              , { 1.5 , 0 , false , "2" }
+              , { 2.5 , 0 , false , "2" } // Ties round to even.
+              , { 0.125 , 2 , false , "0.12" }
+              , { 0.375 , 2 , false , "0.38" }
+              , { 123.456 , 3 , false , "123.456" }
+              , { -9.99999 , 4 , false , "-10.0000" }
+              , { 1e22 , 0 , false , "10000000000000000000000" }
+              , { 0.1 , 10 , false , "0.1000000000" }
+              , { 1.7976931348623157e308 , 10 , true , "1.7976931349E+308" }
+              , { 4.9406564584124654e-324 , 10 , true , "4.9406564584E-324" }
+              , { -0.000123456 , 3 , true , "-1.235E-04" }
+              , { 9.5 , 0 , true , "1E+01" }
+              , { 0.0 , 4 , true , "0.0000E+00" }
+              , { infinity , 3 , false , "inf" }
+              , { -infinity , 3 , true , "-INF" }
+              , { not_a_number , 2 , false , "nan" }
+              , { not_a_number , 2 , true , "NAN" }
+              };
+
+    // Shortest round-trip representation.
+    const struct
+    {
+        f64         value;
+        const char* out;
+        const char* out_abbreviated;
+    }
+    shortest[] = { { 0.1 , "0.1" , "1E-01" }
+                 , { 0.3 , "0.3" , "3E-01" }
+                 , { -0.0 , "-0" , "-0E+00" }
+                 , { 100.0 , "100" , "1E+02" }
+                 , { 1.0 / 3.0 , "0.3333333333333333" , "3.333333333333333E-01" }
+                 , { 123456789012345680.0 , "123456789012345680" , "1.2345678901234568E+17" }
+                 , { 9007199254740993.0 , "9007199254740992" , "9.007199254740992E+15" }
+                 , { 1e23 , "100000000000000000000000" , "1E+23" }
+                 , { 1.7976931348623157e308 , 0 , "1.7976931348623157E+308" }
+                 , { 2.2250738585072014e-308 , 0 , "2.2250738585072014E-308" }
+                 , { 4.9406564584124654e-324 , 0 , "5E-324" }
+                 };
+
+    char string[ STRING_FLOAT_MAX_LENGTH ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: string_f64, fixed and abbreviated notation.
+    for ( u64 i = 0; i < sizeof ( fixed ) / sizeof ( fixed[ 0 ] ); ++i )
+    {
+        EXPECT_EQ ( _string_length ( fixed[ i ].out ) , string_f64 ( fixed[ i ].value , fixed[ i ].precision , fixed[ i ].abbreviated , string ) );
+        EXPECT ( memory_equal ( string , fixed[ i ].out , _string_length ( fixed[ i ].out ) ) );
+    }
+
+    // TEST 2: string_f64_shortest, fixed and abbreviated notation.
+    for ( u64 i = 0; i < sizeof ( shortest ) / sizeof ( shortest[ 0 ] ); ++i )
+    {
+        if ( shortest[ i ].out )
+        {
+            EXPECT_EQ ( _string_length ( shortest[ i ].out ) , string_f64_shortest ( shortest[ i ].value , false , string ) );
+            EXPECT ( memory_equal ( string , shortest[ i ].out , _string_length ( shortest[ i ].out ) ) );
+        }
+        EXPECT_EQ ( _string_length ( shortest[ i ].out_abbreviated ) , string_f64_shortest ( shortest[ i ].value , true , string ) );
+        EXPECT ( memory_equal ( string , shortest[ i ].out_abbreviated , _string_length ( shortest[ i ].out_abbreviated ) ) );
+    }
+
+    // TEST 3: string_f64_shortest, longest output (smallest subnormal number).
+    EXPECT_EQ ( 327 , string_f64_shortest ( -4.9406564584124654e-324 , false , string ) );
+    EXPECT ( memory_equal ( string , "-0.000" , 6 ) );
+    EXPECT_EQ ( '5' , string[ 326 ] );
+
+    // TEST 4: string_f64 clamps precision to STRING_FLOAT_MAX_PRECISION.
+    LOGWARN ( "The following warnings are intentionally triggered by a test:" );
+    EXPECT_EQ ( 12 , string_f64 ( 0.5 , STRING_FLOAT_MAX_PRECISION + 5 , false , string ) );
+    EXPECT ( memory_equal ( string , "0.5000000000" , 12 ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_string_to_i64_and_u64
+( void )
+{
+    const struct
+    {
+        const char*         in;
+        u8                  radix;
+        STRING_PARSE_RESULT result;
+        i64                 out;
+    }
+    signed_[] = { { "0" , 10 , STRING_PARSE_SUCCESS , 0 }
+                , { "-0" , 10 , STRING_PARSE_SUCCESS , 0 }
+                , { "+42" , 10 , STRING_PARSE_SUCCESS , 42 }
+                , { "-1234567890123456789" , 10 , STRING_PARSE_SUCCESS , -1234567890123456789 }
+                , { "9223372036854775807" , 10 , STRING_PARSE_SUCCESS , 9223372036854775807 }
+                , { "-9223372036854775808" , 10 , STRING_PARSE_SUCCESS , ( i64 )( ( u64 ) 1 << 63 ) }
+                , { "9223372036854775808" , 10 , STRING_PARSE_ERROR_OUT_OF_RANGE , 9223372036854775807 }
+                , { "-99999999999999999999" , 10 , STRING_PARSE_ERROR_OUT_OF_RANGE , ( i64 )( ( u64 ) 1 << 63 ) }
+                , { "-7fffFFFFffffFFFF" , 16 , STRING_PARSE_SUCCESS , -9223372036854775807 }
+                , { "zz" , 36 , STRING_PARSE_SUCCESS , 1295 }
+                , { "101" , 2 , STRING_PARSE_SUCCESS , 5 }
+                , { "" , 10 , STRING_PARSE_ERROR_EMPTY , 0 }
+                , { "-" , 10 , STRING_PARSE_ERROR_EMPTY , 0 }
+                , { "12a" , 10 , STRING_PARSE_ERROR_INVALID , 0 }
+                , { "102" , 2 , STRING_PARSE_ERROR_INVALID , 0 }
+                , { " 1" , 10 , STRING_PARSE_ERROR_EMPTY , 0 }
+                };
+
+    const struct
+    {
+        const char*         in;
+        u8                  radix;
+        STRING_PARSE_RESULT result;
+        u64                 out;
+    }
+    unsigned_[] = { { "18446744073709551615" , 10 , STRING_PARSE_SUCCESS , 18446744073709551615ULL }
+                  , { "18446744073709551616" , 10 , STRING_PARSE_ERROR_OUT_OF_RANGE , 18446744073709551615ULL }
+                  , { "+00000000000000000000000000000001" , 10 , STRING_PARSE_SUCCESS , 1 }
+                  , { "FFFFFFFFFFFFFFFF" , 16 , STRING_PARSE_SUCCESS , 18446744073709551615ULL }
+                  , { "-1" , 10 , STRING_PARSE_ERROR_INVALID , 0 }
+                  };
+
+    char string[ STRING_INTEGER_MAX_LENGTH ];
+    i64 i;
+    u64 u;
+    u64 read;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: string_to_i64, whole string.
+    for ( u64 j = 0; j < sizeof ( signed_ ) / sizeof ( signed_[ 0 ] ); ++j )
+    {
+        i = 0;
+        EXPECT_EQ ( signed_[ j ].result , _string_to_i64 ( signed_[ j ].in , signed_[ j ].radix , &i , 0 ) );
+        EXPECT_EQ ( signed_[ j ].out , i );
+    }
+
+    // TEST 2: string_to_u64, whole string.
+    for ( u64 j = 0; j < sizeof ( unsigned_ ) / sizeof ( unsigned_[ 0 ] ); ++j )
+    {
+        u = 0;
+        EXPECT_EQ ( unsigned_[ j ].result , _string_to_u64 ( unsigned_[ j ].in , unsigned_[ j ].radix , &u , 0 ) );
+        EXPECT_EQ ( unsigned_[ j ].out , u );
+    }
+
+    // TEST 3: Parsing a prefix reports the number of characters read.
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , _string_to_i64 ( "-123456789012,5" , 10 , &i , &read ) );
+    EXPECT_EQ ( -123456789012 , i );
+    EXPECT_EQ ( 13 , read );
+    EXPECT_EQ ( STRING_PARSE_ERROR_EMPTY , _string_to_u64 ( "x1" , 10 , &u , &read ) );
+    EXPECT_EQ ( 0 , read );
+
+    // TEST 4: Explicit length.
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_to_u64 ( "12345678901" , 4 , 10 , &u , 0 ) );
+    EXPECT_EQ ( 1234 , u );
+
+    // TEST 5: string_to_i64 and string_to_u64 invert string_i64 and string_u64
+    //         for every radix.
+    for ( u8 radix = STRING_INTEGER_MIN_RADIX; radix <= STRING_INTEGER_MAX_RADIX; ++radix )
+    {
+        const i64 values[] = { 0 , 1 , -1 , 1000000007 , -4611686018427387904 , 9223372036854775807 };
+        for ( u64 j = 0; j < sizeof ( values ) / sizeof ( values[ 0 ] ); ++j )
+        {
+            const u64 length = string_i64 ( values[ j ] , radix , string );
+            EXPECT_EQ ( STRING_PARSE_SUCCESS , string_to_i64 ( string , length , radix , &i , &read ) );
+            EXPECT_EQ ( values[ j ] , i );
+            EXPECT_EQ ( length , read );
+        }
+        const u64 length = string_u64 ( 18446744073709551615ULL , radix , string );
+        EXPECT_EQ ( STRING_PARSE_SUCCESS , string_to_u64 ( string , length , radix , &u , 0 ) );
+        EXPECT_EQ ( 18446744073709551615ULL , u );
+    }
+
+    // TEST 6: Illegal radix.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , _string_to_i64 ( "1" , 1 , &i , 0 ) );
+    EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , _string_to_u64 ( "1" , 37 , &u , 0 ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_string_to_f64
+( void )
+{
+    const struct
+    {
+        const char*         in;
+        STRING_PARSE_RESULT result;
+        u64                 out;    // Bits.
+        u64                 read;
+    }
+    cases[] = { { "0" , STRING_PARSE_SUCCESS , 0 , 1 }
+              , { "-0.0" , STRING_PARSE_SUCCESS , 0x8000000000000000 , 4 }
+              , { "1.5" , STRING_PARSE_SUCCESS , 0x3FF8000000000000 , 3 }
+              , { ".5" , STRING_PARSE_SUCCESS , 0x3FE0000000000000 , 2 }
+              , { "5." , STRING_PARSE_SUCCESS , 0x4014000000000000 , 2 }
+              , { "0.1" , STRING_PARSE_SUCCESS , 0x3FB999999999999A , 3 }
+              , { "1e23" , STRING_PARSE_SUCCESS , 0x44B52D02C7E14AF6 , 4 }
+              , { "+1E-2" , STRING_PARSE_SUCCESS , 0x3F847AE147AE147B , 5 }
+              , { "9007199254740993" , STRING_PARSE_SUCCESS , 0x4340000000000000 , 16 } // Tie: to even.
+              , { "9007199254740993.000000000000000000001" , STRING_PARSE_SUCCESS , 0x4340000000000001 , 38 } // Just past the tie.
+              , { "1.7976931348623157e308" , STRING_PARSE_SUCCESS , 0x7FEFFFFFFFFFFFFF , 22 }
+              , { "1.7976931348623159e308" , STRING_PARSE_ERROR_OUT_OF_RANGE , 0x7FF0000000000000 , 22 }
+              , { "-1e400" , STRING_PARSE_ERROR_OUT_OF_RANGE , 0xFFF0000000000000 , 6 }
+              , { "2.2250738585072011e-308" , STRING_PARSE_SUCCESS , 0x000FFFFFFFFFFFFF , 23 }
+              , { "4.9406564584124654e-324" , STRING_PARSE_SUCCESS , 1 , 23 }
+              , { "2.4703282292062327e-324" , STRING_PARSE_SUCCESS , 0 , 23 }
+              , { "2.4703282292062328e-324" , STRING_PARSE_SUCCESS , 1 , 23 }
+              , { "1e-400" , STRING_PARSE_SUCCESS , 0 , 6 }
+              , { "0.000000000000000000000000000000123456789012345678901234567890" , STRING_PARSE_SUCCESS , 0x39840831C305489C , 62 }
+              , { "Infinity" , STRING_PARSE_SUCCESS , 0x7FF0000000000000 , 8 }
+              , { "-INF" , STRING_PARSE_SUCCESS , 0xFFF0000000000000 , 4 }
+              , { "nan" , STRING_PARSE_SUCCESS , 0x7FF8000000000000 , 3 }
+              , { "1e" , STRING_PARSE_ERROR_INVALID , 0 , 1 }   // Exponent without digits is not read.
+              , { "1.2.3" , STRING_PARSE_ERROR_INVALID , 0 , 3 }
+              , { "" , STRING_PARSE_ERROR_EMPTY , 0 , 0 }
+              , { "-." , STRING_PARSE_ERROR_EMPTY , 0 , 0 }
+              , { "e5" , STRING_PARSE_ERROR_EMPTY , 0 , 0 }
+              };
+
+    // Shortest representations of extreme values, which must round-trip.
+    const f64 round_trip[] = { 0.1 , 1.0 / 3.0 , 123456789012345680.0
+                             , 1.7976931348623157e308
+                             , 2.2250738585072014e-308
+                             , 4.9406564584124654e-324
+                             , 5e-324 * 3
+                             , 6.02214076e23
+                             };
+
+    char string[ STRING_FLOAT_MAX_LENGTH ];
+    f64 value;
+    u64 bits;
+    u64 read;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: string_to_f64, whole string and prefix.
+    for ( u64 i = 0; i < sizeof ( cases ) / sizeof ( cases[ 0 ] ); ++i )
+    {
+        EXPECT_EQ ( cases[ i ].result , _string_to_f64 ( cases[ i ].in , &value , 0 ) );
+        if ( cases[ i ].result == STRING_PARSE_SUCCESS || cases[ i ].result == STRING_PARSE_ERROR_OUT_OF_RANGE )
+        {
+            memory_copy ( &bits , &value , sizeof ( f64 ) );
+            EXPECT_EQ ( cases[ i ].out , bits );
+        }
+        read = 0xFF;
+        _string_to_f64 ( cases[ i ].in , &value , &read );
+        EXPECT_EQ ( cases[ i ].read , read );
+    }
+
+    // TEST 2: string_to_f64 inverts string_f64_shortest.
+    for ( u64 i = 0; i < sizeof ( round_trip ) / sizeof ( round_trip[ 0 ] ); ++i )
+    {
+        for ( u8 abbreviated = 0; abbreviated < 2; ++abbreviated )
+        {
+            const u64 length = string_f64_shortest ( -round_trip[ i ] , abbreviated , string );
+            EXPECT_EQ ( STRING_PARSE_SUCCESS , string_to_f64 ( string , length , &value , 0 ) );
+            EXPECT ( memory_equal ( &value , &( ( f64 ){ -round_trip[ i ] } ) , sizeof ( f64 ) ) );
+        }
+    }
+
+    // TEST 3: Explicit length.
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_to_f64 ( "3.14159" , 4 , &value , 0 ) );
+    EXPECT ( value == 3.14 );
+
+    // TEST 4: More than 767 significant digits: the digits past the limit can
+    //         only break a tie.
+    char* digits = string_allocate ( 1024 );
+    memory_copy ( digits , "9007199254740993." , 17 );
+    memory_set ( digits + 17 , '0' , 1000 );
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_to_f64 ( digits , 1017 , &value , 0 ) );
+    memory_copy ( &bits , &value , sizeof ( f64 ) );
+    EXPECT_EQ ( 0x4340000000000000 , bits );
+    digits[ 1016 ] = '1';
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_to_f64 ( digits , 1017 , &value , 0 ) );
+    memory_copy ( &bits , &value , sizeof ( f64 ) );
+    EXPECT_EQ ( 0x4340000000000001 , bits );
+    string_free ( digits );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_string_hex_and_base64
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    // Test vectors from RFC 4648.
+    const char* rfc_in[] = { "" , "f" , "fo" , "foo" , "foob" , "fooba" , "foobar" };
+    const char* rfc_base64[] = { "" , "Zg==" , "Zm8=" , "Zm9v" , "Zm9vYg==" , "Zm9vYmE=" , "Zm9vYmFy" };
+    const char* rfc_hex[] = { "" , "66" , "666F" , "666F6F" , "666F6F62" , "666F6F6261" , "666F6F626172" };
+    u8 bytes[ 256 ];
+    u8 decoded[ 256 ];
+    char encoded[ 512 ];
+    u8 large[ 2000 ];
+    u64 size;
+    char* string;
+    char* expected;
+    string_view_t view;
+    string_view_t* array = array_create ( string_view_t , 2 );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , array );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: string_hex_encode and string_base64_encode match the RFC 4648 test vectors.
+    for ( u64 i = 0; i < sizeof ( rfc_in ) / sizeof ( rfc_in[ 0 ] ); ++i )
+    {
+        const u64 length = _string_length ( rfc_in[ i ] );
+        EXPECT_EQ ( _string_length ( rfc_hex[ i ] ) , string_hex_encode ( rfc_in[ i ] , length , true , encoded ) );
+        EXPECT ( memory_equal ( encoded , rfc_hex[ i ] , _string_length ( rfc_hex[ i ] ) ) );
+        EXPECT_EQ ( _string_length ( rfc_base64[ i ] ) , string_base64_encode ( rfc_in[ i ] , length , encoded ) );
+        EXPECT ( memory_equal ( encoded , rfc_base64[ i ] , _string_length ( rfc_base64[ i ] ) ) );
+    }
+
+    // TEST 2: string_hex_decode and string_base64_decode match the RFC 4648 test vectors.
+    for ( u64 i = 0; i < sizeof ( rfc_in ) / sizeof ( rfc_in[ 0 ] ); ++i )
+    {
+        const u64 length = _string_length ( rfc_in[ i ] );
+        EXPECT_EQ ( STRING_PARSE_SUCCESS , string_hex_decode ( rfc_hex[ i ] , _string_length ( rfc_hex[ i ] ) , decoded , &size ) );
+        EXPECT_EQ ( length , size );
+        EXPECT ( memory_equal ( decoded , rfc_in[ i ] , length ) );
+        EXPECT_EQ ( STRING_PARSE_SUCCESS , string_base64_decode ( rfc_base64[ i ] , _string_length ( rfc_base64[ i ] ) , decoded , &size ) );
+        EXPECT_EQ ( length , size );
+        EXPECT ( memory_equal ( decoded , rfc_in[ i ] , length ) );
+        EXPECT ( size <= STRING_BASE64_MAX_SIZE ( _string_length ( rfc_base64[ i ] ) ) );
+    }
+
+    // TEST 3: Encoding then decoding every byte, at every length, is lossless
+    //         (covers both the vectorized and scalar paths).
+    for ( u64 i = 0; i < sizeof ( bytes ); ++i )
+    {
+        bytes[ i ] = ( u8 )( 255 - i );
+    }
+    for ( u64 i = 0; i <= sizeof ( bytes ); ++i )
+    {
+        EXPECT_EQ ( STRING_HEX_LENGTH ( i ) , string_hex_encode ( bytes , i , i % 2 , encoded ) );
+        EXPECT_EQ ( STRING_PARSE_SUCCESS , string_hex_decode ( encoded , STRING_HEX_LENGTH ( i ) , decoded , &size ) );
+        EXPECT_EQ ( i , size );
+        EXPECT ( memory_equal ( decoded , bytes , i ) );
+        EXPECT_EQ ( STRING_BASE64_LENGTH ( i ) , string_base64_encode ( bytes , i , encoded ) );
+        EXPECT_EQ ( STRING_PARSE_SUCCESS , string_base64_decode ( encoded , STRING_BASE64_LENGTH ( i ) , decoded , &size ) );
+        EXPECT_EQ ( i , size );
+        EXPECT ( memory_equal ( decoded , bytes , i ) );
+    }
+    string_hex_encode ( bytes , 16 , false , encoded );
+    EXPECT ( memory_equal ( encoded , "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0" , 32 ) );
+    string_hex_encode ( bytes , 16 , true , encoded );
+    EXPECT ( memory_equal ( encoded , "FFFEFDFCFBFAF9F8F7F6F5F4F3F2F1F0" , 32 ) );
+
+    // TEST 4: string_hex_decode accepts either case.
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_hex_decode ( "0123456789abcdefABCDEF0123456789aBcDeF" , 38 , decoded , &size ) );
+    EXPECT_EQ ( 19 , size );
+    EXPECT ( memory_equal ( decoded , "\x01\x23\x45\x67\x89\xAB\xCD\xEF\xAB\xCD\xEF\x01\x23\x45\x67\x89\xAB\xCD\xEF" , 19 ) );
+
+    // TEST 5: string_base64_decode accepts input without padding.
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_base64_decode ( "Zm9vYg" , 6 , decoded , &size ) );
+    EXPECT_EQ ( 4 , size );
+    EXPECT ( memory_equal ( decoded , "foob" , 4 ) );
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_base64_decode ( "Zm9vYmE" , 7 , decoded , &size ) );
+    EXPECT_EQ ( 5 , size );
+    EXPECT ( memory_equal ( decoded , "fooba" , 5 ) );
+
+    // TEST 6: Decoding rejects illegal characters anywhere in the input, and
+    //         does not write the output size.
+    for ( u64 i = 0; i < 128; ++i )
+    {
+        string_hex_encode ( bytes , 64 , false , encoded );
+        encoded[ i ] = 'g';
+        size = 12345;
+        EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , string_hex_decode ( encoded , 128 , decoded , &size ) );
+        EXPECT_EQ ( 12345 , size );
+    }
+    for ( u64 i = 0; i < 84; ++i )
+    {
+        string_base64_encode ( bytes , 63 , encoded );
+        encoded[ i ] = "=-_ .\n"[ i % 6 ];
+        size = 12345;
+        EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , string_base64_decode ( encoded , 84 , decoded , &size ) );
+        EXPECT_EQ ( 12345 , size );
+    }
+
+    // TEST 7: Decoding rejects input of an illegal length.
+    EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , string_hex_decode ( "666" , 3 , decoded , &size ) );
+    EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , string_base64_decode ( "Zm9vY" , 5 , decoded , &size ) );
+    EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , string_base64_decode ( "Zg=" , 3 , decoded , &size ) );
+    EXPECT_EQ ( STRING_PARSE_ERROR_INVALID , string_base64_decode ( "Z===" , 4 , decoded , &size ) );
+
+    // TEST 8: Decoding may be done in-place.
+    string_base64_encode ( bytes , 200 , encoded );
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_base64_decode ( encoded , STRING_BASE64_LENGTH ( 200 ) , encoded , &size ) );
+    EXPECT_EQ ( 200 , size );
+    EXPECT ( memory_equal ( encoded , bytes , 200 ) );
+    string_hex_encode ( bytes , 200 , false , encoded );
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_hex_decode ( encoded , STRING_HEX_LENGTH ( 200 ) , encoded , &size ) );
+    EXPECT_EQ ( 200 , size );
+    EXPECT ( memory_equal ( encoded , bytes , 200 ) );
+
+    // TEST 9: string_push_hex and string_push_base64 append to a resizable string.
+    string = _string_create ( 1 );
+    string_push_hex ( string , "foobar" , 6 , false );
+    string_push_base64 ( string , "foobar" , 6 );
+    string_push_base64 ( string , "f" , 1 );
+    string_push_hex ( string , "" , 0 , false );
+    EXPECT_EQ ( 24 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "666f6f626172Zm9vYmFyZg==" , 25 ) );
+    string_clear ( string );
+    string_push_base64 ( string , bytes , sizeof ( bytes ) );
+    EXPECT_EQ ( STRING_BASE64_LENGTH ( sizeof ( bytes ) ) , string_length ( string ) );
+    EXPECT_EQ ( STRING_PARSE_SUCCESS , string_base64_decode ( string , string_length ( string ) , decoded , &size ) );
+    EXPECT ( memory_equal ( decoded , bytes , sizeof ( bytes ) ) );
+    string_destroy ( string );
+
+    // TEST 10: Hexadecimal and base64 format specifiers, with and without modifiers.
+    view = string_view ( "foobar" , 6 );
+    string = string_format ( "%x %X %b `%Pl.12b` `%Pr 14x` `%Pr.4X` `%x`" , &view , &view , &view , &view , &view , &view , 0 );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( _string_length ( "666f6f626172 666F6F626172 Zm9vYmFy `....Zm9vYmFy` `666f6f626172  ` `666F` ``" ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "666f6f626172 666F6F626172 Zm9vYmFy `....Zm9vYmFy` `666f6f626172  ` `666F` ``" , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // TEST 11: Hexadecimal and base64 format specifiers, with array format modifier.
+    array_push ( array , string_view ( "foo" , 3 ) );
+    array_push ( array , string_view ( "bar" , 3 ) );
+    string = string_format ( "%ax %ab" , array , array );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( _string_length ( "{ `666f6f`, `626172` } { `Zm9v`, `YmFy` }" ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "{ `666f6f`, `626172` } { `Zm9v`, `YmFy` }" , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // TEST 12: Hexadecimal and base64 format specifiers encode input of any size.
+    for ( u64 i = 0; i < sizeof ( large ); ++i )
+    {
+        large[ i ] = random2 ( 0 , 255 );
+    }
+    view = string_view ( ( const char* ) large , sizeof ( large ) );
+    expected = string_create ();
+    string_push_hex ( expected , large , sizeof ( large ) , true );
+    string_push_base64 ( expected , large , sizeof ( large ) );
+    string = string_format ( "%X%b" , &view , &view );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( string_length ( expected ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , expected , string_length ( string ) ) );
+    string_destroy ( string );
+    string_destroy ( expected );
+
+    // TEST 13: Hexadecimal and base64 format specifiers, into a fixed-capacity buffer.
+    view = string_view ( "foobar" , 6 );
+    EXPECT_EQ ( 12 , string_format_to ( encoded , 8 , "%x" , &view ) );
+    EXPECT ( memory_equal ( encoded , "666f6f6" , 8 ) );
+    EXPECT_EQ ( 8 , string_format_to ( encoded , sizeof ( encoded ) , "%b" , &view ) );
+    EXPECT ( memory_equal ( encoded , "Zm9vYmFy" , 9 ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    array_destroy ( array );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
 }
 
 u8
@@ -1271,6 +2224,12 @@ test_string_format
     const char* out23 = "{ `-8`, `-7`, `-6`, `-5`, `-4`, `-3`, `-2`, `-1`, ` 0`, ` 1`, ` 2`, ` 3`, ` 4`, ` 5`, ` 6`, ` 7` }";
     const char* out24 = "{ `string_queue_in1`, `string_queue_in2`, `string_queue_in3` }";
     const char* out25 = "{ `H`, `e`, `l`, `l`, `o`, ` `, `w`, `o`, `r`, `l`, `d`, `!`, `` }";
+    const char* out26 = "{ `-8`, `-7`, `-6`, ... (13 more) }";
+    const char* out27 = "{ `string_queue_in1`, ... (2 more) }";
+    u8 u8_array_in[ 2000 ];
+    memory_set ( u8_array_in , 7 , sizeof ( u8_array_in ) );
+    u8* array_in3 = array_create_from ( u8 , u8_array_in , 2000 );
+    char out28[ 32 ];
     const char* illegal_container_string1 = "%.2aaF";
     const char* illegal_container_string2 = "%.2qaF";
     const char* illegal_container_string3 = "%.2aqF";
@@ -1658,6 +2617,38 @@ test_string_format
     EXPECT ( memory_equal ( string , out25 , string_length ( string ) ) );
     string_destroy ( string );
 
+    // TEST 44: Integer format specifier, with array format modifier and element limit.
+    string = string_format ( "%a3i" , array_in2 );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( _string_length ( out26 ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , out26 , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // TEST 45: String format specifier, with queue format modifier and element limit.
+    string = string_format ( "%q1s" , queue_in );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( _string_length ( out27 ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , out27 , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // TEST 46: An element limit which is not exceeded elides nothing.
+    string = string_format ( "%a16pl 2i" , array_in2 );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( _string_length ( out23 ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , out23 , string_length ( string ) ) );
+    string_destroy ( string );
+
+    // TEST 47: A container whose output exceeds the staging buffer is written in full, with or without truncation.
+    string = string_format ( "%au" , array_in3 );
+    EXPECT_NEQ ( 0 , string ); // Verify there was no memory error prior to the test.
+    EXPECT_EQ ( 4 + 2000 * 3 + 1999 * 2 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "{ `7`, `7`, " , 12 ) );
+    EXPECT ( memory_equal ( string + string_length ( string ) - 12 , ", `7`, `7` }" , 12 ) );
+    EXPECT_EQ ( string_length ( string ) , string_format_to ( out28 , sizeof ( out28 ) , "%au" , array_in3 ) );
+    EXPECT ( memory_equal ( out28 , string , sizeof ( out28 ) - 1 ) );
+    EXPECT_EQ ( 0 , out28[ sizeof ( out28 ) - 1 ] );
+    string_destroy ( string );
+
     // End test.
     ////////////////////////////////////////////////////////////////////////////
 
@@ -1665,6 +2656,7 @@ test_string_format
     string_destroy ( really_long_string_in );
     array_destroy ( array_in1 );
     array_destroy ( array_in2 );
+    array_destroy ( array_in3 );
     queue_destroy ( queue_in );
 
     // Verify the test allocated and freed all of its memory properly.
@@ -1675,6 +2667,258 @@ test_string_format
     return true;
 }
 
+u8
+test_string_format_to
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    char buffer[ 32 ];
+    u64 length;
+    const char* in = "Hello world!";
+    const char* out = "Hello world! 42 -7 f";
+
+    // TEST 1: Output fits into the buffer.
+    memory_set ( buffer , '#' , sizeof ( buffer ) );
+    length = string_format_to ( buffer , sizeof ( buffer ) , "%s %u %i %c" , in , 42 , -7 , 'f' );
+    EXPECT_EQ ( _string_length ( out ) , length );
+    EXPECT_EQ ( _string_length ( out ) , _string_length ( buffer ) );
+    EXPECT ( memory_equal ( buffer , out , _string_length ( out ) + 1 ) );
+
+    // TEST 2: Output is truncated, but still terminated, and the full length is returned.
+    memory_set ( buffer , '#' , sizeof ( buffer ) );
+    length = string_format_to ( buffer , 6 , "%s %u %i %c" , in , 42 , -7 , 'f' );
+    EXPECT_EQ ( _string_length ( out ) , length );
+    EXPECT_EQ ( 5 , _string_length ( buffer ) );
+    EXPECT ( memory_equal ( buffer , out , 5 ) );
+    EXPECT_EQ ( '#' , buffer[ 6 ] );
+
+    // TEST 3: A buffer with room for the terminator only.
+    length = string_format_to ( buffer , 1 , "%s %u %i %c" , in , 42 , -7 , 'f' );
+    EXPECT_EQ ( _string_length ( out ) , length );
+    EXPECT_EQ ( 0 , *buffer );
+
+    // TEST 4: Empty output.
+    length = string_format_to ( buffer , sizeof ( buffer ) , "" );
+    EXPECT_EQ ( 0 , length );
+    EXPECT_EQ ( 0 , *buffer );
+
+    // TEST 5: Invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    length = string_format_to ( 0 , sizeof ( buffer ) , "%u" , 1 );
+    EXPECT_EQ ( 0 , length );
+    length = string_format_to ( buffer , 0 , "%u" , 1 );
+    EXPECT_EQ ( 0 , length );
+    length = _string_format_to ( buffer , sizeof ( buffer ) , 0 , ARGS ( 1 ) );
+    EXPECT_EQ ( 0 , length );
+    EXPECT_EQ ( 0 , *buffer );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_string_format_append
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* in = "Hello world!";
+    const char* out = "Hello world! 42 -7 f";
+    char* string = string_create ();
+    char* string_ = string;
+    string_format_template_t* template = 0;
+    u64 allocation_count;
+
+    // TEST 1: Appending to an empty string.
+    string_format_append ( string , "%s %u" , in , 42 );
+    string_format_append ( string , " %i %c" , -7 , 'f' );
+    EXPECT_EQ ( _string_length ( out ) , string_length ( string ) );
+    EXPECT ( memory_equal ( string , out , _string_length ( out ) + 1 ) );
+
+    // TEST 2: Padding is relative to the existing string contents.
+    string_clear ( string );
+    _string_push ( string , "abc" );
+    string_format_append ( string , "[%Pl 5u]" , 42 );
+    EXPECT_EQ ( 10 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "abc[   42]" , 11 ) );
+
+    // TEST 3: A cleared string which is large enough is reused without allocating.
+    EXPECT ( string_format_compile ( "%u:%i;" , 0 , 0 , &template ) );
+    string = _string_create ( 256 );
+    string_destroy ( string_ );
+    string_ = string;
+    allocation_count = MEMORY_ALLOCATION_COUNT;
+    for ( u64 i = 0; i < 100; ++i )
+    {
+        string_clear ( string );
+        string_format_append ( string , "%s %u" , in , i );
+        string_format_append_with ( string , template , i , -( ( i64 ) i ) );
+    }
+    EXPECT_EQ ( allocation_count , MEMORY_ALLOCATION_COUNT );
+    EXPECT_EQ ( string_ , string );
+    EXPECT_EQ ( 22 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "Hello world! 9999:-99;" , 23 ) );
+
+    // TEST 4: Strings grow to fit the output.
+    string_clear ( string );
+    for ( u64 i = 0; i < 100; ++i )
+    {
+        string_format_append_with ( string , template , i , i );
+    }
+    EXPECT_EQ ( 580 , string_length ( string ) );
+    EXPECT ( memory_equal ( string + string_length ( string ) - 6 , "99:99;" , 7 ) );
+
+    // TEST 5: Invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , _string_format_append ( 0 , "%u" , ARGS ( 1 ) ) );
+    string_ = string;
+    EXPECT_EQ ( string_ , _string_format_append ( string , 0 , ARGS ( 1 ) ) );
+    EXPECT_EQ ( string_ , _string_format_append_with ( string , 0 , ARGS ( 1 ) ) );
+    EXPECT_EQ ( 580 , string_length ( string ) );
+
+    string_destroy ( string );
+    string_format_template_destroy ( &template );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+/**
+ * @brief Tests whether executing a precompiled formatting string produces the
+ * same output as _string_format and _string_format_to.
+ */
+bool
+test_string_format_with_matches
+(   const char* format
+,   args_t      args
+)
+{
+    string_format_template_t* template = 0;
+    EXPECT ( string_format_compile ( format , 0 , 0 , &template ) );
+    EXPECT_NEQ ( 0 , template );
+
+    char* expected = _string_format ( format , args );
+    char* string = _string_format_with ( template , args );
+    EXPECT_EQ ( string_length ( expected ) , string_length ( string ) );
+    EXPECT ( memory_equal ( expected , string , string_length ( expected ) + 1 ) );
+
+    char buffer[ 256 ];
+    const u64 length = _string_format_to_with ( buffer , sizeof ( buffer ) , template , args );
+    EXPECT_EQ ( string_length ( expected ) , length );
+    EXPECT ( memory_equal ( expected , buffer , MIN ( length + 1 , sizeof ( buffer ) ) ) );
+
+    // Executing a template does not modify it.
+    string_destroy ( string );
+    string = _string_format_with ( template , args );
+    EXPECT ( memory_equal ( expected , string , string_length ( expected ) + 1 ) );
+
+    string_destroy ( expected );
+    string_destroy ( string );
+    string_format_template_destroy ( &template );
+    EXPECT_EQ ( 0 , template );
+    return true;
+}
+
+u8
+test_string_format_with
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* string_in = "Hello world!";
+    const f64 float_in = 3.14159265358979;
+    char* resizable_string_in = string_create_from ( string_in );
+    u64 memory_requirement;
+    char memory[ 1024 ];
+    string_format_template_t* template;
+    char* string;
+
+    DISABLE_WARNING ( -Wint-conversion )
+
+    // TEST 1: Templates produce the same output as string_format.
+    EXPECT ( test_string_format_with_matches ( "%u %i %.3f %s %c" , ARGS ( 42 , -7 , &float_in , string_in , 'f' ) ) );
+    EXPECT ( test_string_format_with_matches ( "`%Pl010u` `%pr.12i` `%+.2e` `%Pr 20S` %@" , ARGS ( 42 , -7 , &float_in , resizable_string_in , string_in ) ) );
+    EXPECT ( test_string_format_with_matches ( "Text without format specifiers." , ARGS ( 42 ) ) );
+    EXPECT ( test_string_format_with_matches ( "" , ARGS ( 42 ) ) );
+
+    // TEST 2: Templates preserve the formatting of literal '%' characters.
+    EXPECT ( test_string_format_with_matches ( "a%%b %u%%%u %%" , ARGS ( 1 , 2 ) ) );
+    EXPECT ( test_string_format_with_matches ( "100%% %u %" , ARGS ( 1 ) ) );
+
+    // TEST 3: Templates copy the remainder of the formatting string verbatim once the arguments run out.
+    EXPECT ( test_string_format_with_matches ( "%u %i %s tail%%" , ARGS ( 1 ) ) );
+    args_t no_args;
+    no_args.arg_count = 0;
+    no_args.args = 0;
+    EXPECT ( test_string_format_with_matches ( "%u %i %s tail%%" , no_args ) );
+
+    // TEST 4: Templates skip an argument for each illegal format specifier.
+    LOGWARN ( "The following warnings are intentionally triggered by a test:" );
+    EXPECT ( test_string_format_with_matches ( "%zq %u %y . %u" , ARGS ( 1 , 2 , 3 , 4 ) ) );
+
+    REENABLE_WARNING ()
+
+    // TEST 5: Pre-allocated memory buffer.
+    memory_requirement = 0;
+    EXPECT ( string_format_compile ( "%u-%u" , &memory_requirement , 0 , 0 ) );
+    EXPECT_NEQ ( 0 , memory_requirement );
+    EXPECT ( memory_requirement <= sizeof ( memory ) );
+    template = 0;
+    EXPECT ( string_format_compile ( "%u-%u" , &memory_requirement , memory , &template ) );
+    EXPECT_EQ ( ( void* ) memory , template );
+    string = string_format_with ( template , 12 , 34 );
+    EXPECT_EQ ( 5 , string_length ( string ) );
+    EXPECT ( memory_equal ( string , "12-34" , 6 ) );
+    string_destroy ( string );
+    string_format_template_destroy ( &template );
+    EXPECT_EQ ( 0 , template );
+
+    // TEST 6: Invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    template = 0;
+    EXPECT_NOT ( string_format_compile ( 0 , 0 , 0 , &template ) );
+    EXPECT_NOT ( string_format_compile ( "%u" , 0 , 0 , 0 ) );
+    EXPECT_EQ ( 0 , template );
+    string = _string_format_with ( 0 , ARGS ( 1 ) );
+    EXPECT_EQ ( 0 , string_length ( string ) );
+    string_destroy ( string );
+    memory[ 0 ] = '#';
+    EXPECT_EQ ( 0 , _string_format_to_with ( memory , sizeof ( memory ) , 0 , ARGS ( 1 ) ) );
+    EXPECT_EQ ( 0 , *memory );
+    string_format_template_destroy ( 0 );
+    string_format_template_destroy ( &template );
+
+    string_destroy ( resizable_string_in );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 void
 test_register_string
 ( void )
@@ -1686,10 +2930,21 @@ test_register_string
     test_register ( test_string_insert_and_remove_random , "Testing string 'insert' and 'remove' operations with random indices and elements." );
     test_register ( test_string_trim , "Testing string 'trim' operation." );
     test_register ( test_string_contains , "Testing string 'contains' operation." );
+    test_register ( test_string_find_all , "Testing string 'find all' operation." );
+    test_register ( test_string_view , "Testing string views." );
+    test_register ( test_string_small , "Testing resizable strings within small string storage." );
+    test_register ( test_string_remove_if , "Testing string 'remove_if' operation." );
     test_register ( test_string_reverse , "Testing string in-place 'reverse' operation." );
     test_register ( test_string_replace , "Testing string 'replace' operation." );
     test_register ( test_string_strip_ansi , "Stripping a string of ANSI formatting codes." );
+    test_register ( test_string_ascii , "Testing vectorized ASCII case conversion, whitespace, validation and ANSI stripping." );
     test_register ( test_string_u64_and_i64 , "Testing 'stringify' operation on 64-bit integers." );
     test_register ( test_string_f64 , "Testing 'stringify' operation on 64-bit floating point numbers." );
+    test_register ( test_string_to_i64_and_u64 , "Testing 'parse' operation on 64-bit integers." );
+    test_register ( test_string_to_f64 , "Testing 'parse' operation on 64-bit floating point numbers." );
+    test_register ( test_string_hex_and_base64 , "Testing vectorized hexadecimal and base64 encoding and decoding." );
     test_register ( test_string_format , "Constructing a string using format specifiers." );
+    test_register ( test_string_format_to , "Formatting a string into a fixed-capacity buffer." );
+    test_register ( test_string_format_append , "Formatting a string onto the end of an existing string." );
+    test_register ( test_string_format_with , "Formatting a string using a precompiled formatting string." );
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_checksum.c
+ * @brief Implementation of the core/bench_checksum header.
+ * (see core/bench_checksum.h for additional details)
+ */
+#include "core/bench_checksum.h"
+
+#include "core/memory.h"
+
+#include "platform/cpu.h"
+
+/** @brief Buffer size (in bytes) benchmarked. */
+#define BENCH_CHECKSUM_SIZE MiB ( 1 )
+
+/** @brief Instruction sets benchmarked: none (scalar kernels), or any. */
+static u32 bench_checksum_features[] = { 0 , ~0U };
+
+/**
+ * @brief Benchmarks a checksum of a 1 MiB buffer, with the kernels selected
+ * for a set of instruction set extensions.
+ */
+#define BENCH_CHECKSUM(name,expression)                                         \
+    bool                                                                        \
+    name                                                                        \
+    (   void*   args                                                            \
+    ,   u64     iterations                                                      \
+    )                                                                           \
+    {                                                                           \
+        checksum_dispatch ( *( ( u32* ) args ) & cpu_features () );             \
+        u8* data = memory_allocate ( BENCH_CHECKSUM_SIZE , MEMORY_TAG_ARRAY );  \
+        for ( u64 i = 0; i < iterations; ++i )                                  \
+        {                                                                       \
+            u64 checksum = ( expression );                                      \
+            BENCH_DO_NOT_OPTIMIZE ( checksum );                                 \
+        }                                                                       \
+        memory_free ( data , BENCH_CHECKSUM_SIZE , MEMORY_TAG_ARRAY );          \
+        checksum_dispatch ( cpu_features () );                                  \
+        return true;                                                            \
+    }
+
+BENCH_CHECKSUM ( bench_checksum_crc32c , checksum_crc32c ( data , BENCH_CHECKSUM_SIZE , 0 ) )
+BENCH_CHECKSUM ( bench_checksum_crc32 , checksum_crc32 ( data , BENCH_CHECKSUM_SIZE , 0 ) )
+BENCH_CHECKSUM ( bench_checksum_xxh64 , checksum_xxh64 ( data , BENCH_CHECKSUM_SIZE , 0 ) )
+
+void
+bench_register_checksum
+( void )
+{
+    bench_register ( bench_checksum_crc32c , &bench_checksum_features[ 0 ] , "checksum_crc32c: 1 MiB (scalar)." );
+    bench_register ( bench_checksum_crc32c , &bench_checksum_features[ 1 ] , "checksum_crc32c: 1 MiB (hardware)." );
+    bench_register ( bench_checksum_crc32 , &bench_checksum_features[ 0 ] , "checksum_crc32: 1 MiB (scalar)." );
+    bench_register ( bench_checksum_crc32 , &bench_checksum_features[ 1 ] , "checksum_crc32: 1 MiB (hardware)." );
+    bench_register ( bench_checksum_xxh64 , &bench_checksum_features[ 1 ] , "checksum_xxh64: 1 MiB." );
+}
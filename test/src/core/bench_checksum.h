@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_checksum.h
+ * @brief Benchmarks core/checksum.h
+ * (see test/bench.h, core/checksum.h for additional details)
+ */
+#ifndef BENCH_CHECKSUM_H
+#define BENCH_CHECKSUM_H
+
+#include "test/bench.h"
+
+#include "core/checksum.h"
+
+void
+bench_register_checksum
+( void );
+
+#endif  // BENCH_CHECKSUM_H
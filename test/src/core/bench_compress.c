@@ -0,0 +1,110 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_compress.c
+ * @brief Implementation of the core/bench_compress header.
+ * (see core/bench_compress.h for additional details)
+ */
+#include "core/bench_compress.h"
+
+#include "core/memory.h"
+
+#include "math/prng.h"
+
+/** @brief Buffer size (in bytes) benchmarked. */
+#define BENCH_COMPRESS_SIZE MiB ( 1 )
+
+/** @brief Type definition for benchmark state. */
+typedef struct
+{
+    u8* data;
+    u8* frame;
+    u8* decompressed;
+}
+bench_compress_t;
+
+static bench_compress_t bench_compress_args;
+
+/**
+ * @brief Fills a 1 MiB buffer with log-like text, and compresses it once.
+ */
+bool
+bench_compress_setup
+(   void* args_
+)
+{
+    static const char* words[] = { "[INFO]\t" , "[WARN]\t" , "job " , "queued " , "finished " , "in " , "ms.\n" , "file " , "0x7f" , "thread " };
+
+    bench_compress_t* args = args_;
+    ( *args ).data = memory_allocate ( BENCH_COMPRESS_SIZE , MEMORY_TAG_ARRAY );
+    ( *args ).frame = memory_allocate ( COMPRESS_FRAME_BOUND ( BENCH_COMPRESS_SIZE ) , MEMORY_TAG_ARRAY );
+    ( *args ).decompressed = memory_allocate ( BENCH_COMPRESS_SIZE , MEMORY_TAG_ARRAY );
+
+    prng_t prng;
+    prng_seed ( &prng , 0xC0FFEE );
+    u64 i = 0;
+    while ( i < BENCH_COMPRESS_SIZE )
+    {
+        const char* word = words[ prng_next ( &prng ) % ( sizeof ( words ) / sizeof ( words[ 0 ] ) ) ];
+        for ( u64 j = 0; word[ j ] && i < BENCH_COMPRESS_SIZE; ++j )
+        {
+            ( *args ).data[ i++ ] = word[ j ];
+        }
+    }
+    compress_frame ( ( *args ).data , BENCH_COMPRESS_SIZE , ( *args ).frame );
+    return true;
+}
+
+/**
+ * @brief Frees the buffers allocated by bench_compress_setup.
+ */
+void
+bench_compress_teardown
+(   void* args_
+)
+{
+    bench_compress_t* args = args_;
+    memory_free ( ( *args ).data , BENCH_COMPRESS_SIZE , MEMORY_TAG_ARRAY );
+    memory_free ( ( *args ).frame , COMPRESS_FRAME_BOUND ( BENCH_COMPRESS_SIZE ) , MEMORY_TAG_ARRAY );
+    memory_free ( ( *args ).decompressed , BENCH_COMPRESS_SIZE , MEMORY_TAG_ARRAY );
+}
+
+bool
+bench_compress_frame
+(   void*   args_
+,   u64     iterations
+)
+{
+    bench_compress_t* args = args_;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        u64 size = compress_frame ( ( *args ).data , BENCH_COMPRESS_SIZE , ( *args ).frame );
+        BENCH_DO_NOT_OPTIMIZE ( size );
+    }
+    return true;
+}
+
+bool
+bench_decompress_frame
+(   void*   args_
+,   u64     iterations
+)
+{
+    bench_compress_t* args = args_;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        bool success = decompress_frame ( ( *args ).frame
+                                        , ( *args ).frame + COMPRESS_FRAME_HEADER_SIZE
+                                        , ( *args ).decompressed
+                                        );
+        BENCH_DO_NOT_OPTIMIZE ( success );
+    }
+    return true;
+}
+
+void
+bench_register_compress
+( void )
+{
+    _bench_register ( bench_compress_frame , bench_compress_setup , bench_compress_teardown , &bench_compress_args , "compress_frame: 1 MiB of log text." );
+    _bench_register ( bench_decompress_frame , bench_compress_setup , bench_compress_teardown , &bench_compress_args , "decompress_frame: 1 MiB of log text." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_compress.h
+ * @brief Benchmarks core/compress.h
+ * (see test/bench.h, core/compress.h for additional details)
+ */
+#ifndef BENCH_COMPRESS_H
+#define BENCH_COMPRESS_H
+
+#include "test/bench.h"
+
+#include "core/compress.h"
+
+void
+bench_register_compress
+( void );
+
+#endif  // BENCH_COMPRESS_H
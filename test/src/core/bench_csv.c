@@ -0,0 +1,166 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_csv.c
+ * @brief Implementation of the core/bench_csv header.
+ * (see core/bench_csv.h for additional details)
+ */
+#include "core/bench_csv.h"
+
+#include "core/job.h"
+#include "core/memory.h"
+
+#include "math/prng.h"
+
+/** @brief Buffer size (in bytes) benchmarked. */
+#define BENCH_CSV_SIZE MiB ( 4 )
+
+/** @brief Type definition for benchmark state. */
+typedef struct
+{
+    char*   data;
+    u64     size;
+}
+bench_csv_t;
+
+static bench_csv_t bench_csv_args;
+
+/**
+ * @brief Fills a 4 MiB buffer with delimited records, a tenth of which have
+ * quoted fields.
+ */
+bool
+bench_csv_setup
+(   void* args_
+)
+{
+    static const char* records[] = { "1042,2024-03-01,alpha,0.125,shipped\n"
+                                   , "77,2024-03-02,beta,13.5,pending\n"
+                                   , "9,2024-03-02,\"gamma, delta\",7,\"said \"\"later\"\"\"\n"
+                                   , "31337,2024-03-04,epsilon,2.75,\"multi\nline\"\n"
+                                   , "5,2024-03-05,zeta,100,returned\n"
+                                   };
+
+    bench_csv_t* args = args_;
+    ( *args ).data = memory_allocate ( BENCH_CSV_SIZE , MEMORY_TAG_ARRAY );
+    ( *args ).size = 0;
+
+    prng_t prng;
+    prng_seed ( &prng , 0xC0FFEE );
+    for (;;)
+    {
+        const u64 r = prng_next ( &prng ) % 20;
+        const char* record = records[ ( r < 2 ) ? 2 + r : ( r & 1 ) ? 0 : ( r % 4 ) ? 1 : 4 ];
+        u64 length = 0;
+        while ( record[ length ] )
+        {
+            length += 1;
+        }
+        if ( ( *args ).size + length > BENCH_CSV_SIZE )
+        {
+            break;
+        }
+        memory_copy ( ( *args ).data + ( *args ).size , record , length );
+        ( *args ).size += length;
+    }
+    return true;
+}
+
+/**
+ * @brief Variant of bench_csv_setup which also starts the job system.
+ */
+bool
+bench_csv_setup_parallel
+(   void* args_
+)
+{
+    return bench_csv_setup ( args_ ) && job_system_startup ( 0 , 0 , 0 );
+}
+
+/**
+ * @brief Frees the buffer allocated by bench_csv_setup.
+ */
+void
+bench_csv_teardown
+(   void* args_
+)
+{
+    bench_csv_t* args = args_;
+    memory_free ( ( *args ).data , BENCH_CSV_SIZE , MEMORY_TAG_ARRAY );
+}
+
+/**
+ * @brief Variant of bench_csv_teardown which also stops the job system.
+ */
+void
+bench_csv_teardown_parallel
+(   void* args_
+)
+{
+    job_system_shutdown ();
+    bench_csv_teardown ( args_ );
+}
+
+/**
+ * @brief Record function for csv_parse_parallel: does nothing.
+ */
+bool
+bench_csv_record
+(   const csv_field_t*  fields
+,   u64                 field_count
+,   u64                 chunk
+,   void*               args
+)
+{
+    BENCH_DO_NOT_OPTIMIZE ( fields );
+    return true;
+}
+
+bool
+bench_csv_next_record
+(   void*   args_
+,   u64     iterations
+)
+{
+    bench_csv_t* args = args_;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        csv_t csv;
+        if ( !csv_create ( ( *args ).data , ( *args ).size , ',' , '"' , &csv ) )
+        {
+            return false;
+        }
+        const csv_field_t* fields;
+        u64 field_count;
+        while ( csv_next_record ( &csv , &fields , &field_count ) )
+        {
+            BENCH_DO_NOT_OPTIMIZE ( fields );
+        }
+        csv_destroy ( &csv );
+    }
+    return true;
+}
+
+bool
+bench_csv_parse_parallel
+(   void*   args_
+,   u64     iterations
+)
+{
+    bench_csv_t* args = args_;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        if ( !csv_parse_parallel ( ( *args ).data , ( *args ).size , ',' , '"' , 0 , bench_csv_record , 0 ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+bench_register_csv
+( void )
+{
+    _bench_register ( bench_csv_next_record , bench_csv_setup , bench_csv_teardown , &bench_csv_args , "csv_next_record: 4 MiB of records." );
+    _bench_register ( bench_csv_parse_parallel , bench_csv_setup_parallel , bench_csv_teardown_parallel , &bench_csv_args , "csv_parse_parallel: 4 MiB of records, one chunk per core." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_csv.h
+ * @brief Benchmarks core/csv.h
+ * (see test/bench.h, core/csv.h for additional details)
+ */
+#ifndef BENCH_CSV_H
+#define BENCH_CSV_H
+
+#include "test/bench.h"
+
+#include "core/csv.h"
+
+void
+bench_register_csv
+( void );
+
+#endif  // BENCH_CSV_H
@@ -0,0 +1,94 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_memory.c
+ * @brief Implementation of the core/bench_memory header.
+ * (see core/bench_memory.h for additional details)
+ */
+#include "core/bench_memory.h"
+
+/** @brief Block sizes (in bytes) benchmarked by bench_memory_allocate_and_free. */
+static u64 bench_memory_sizes[] = { 64 , KiB ( 4 ) , MiB ( 2 ) };
+
+/** @brief Type definition for the arguments of bench_memory_allocate_and_free_threads. */
+typedef struct
+{
+    u64 size;           // Must be first (see bench_memory_allocate_and_free).
+    u32 thread_count;
+}
+bench_memory_threads_t;
+
+/** @brief Arguments for bench_memory_allocate_and_free_threads. */
+static bench_memory_threads_t bench_memory_threads_args[] = { { 64 , 2 } , { 64 , 4 } , { 64 , 8 }
+                                                            , { KiB ( 4 ) , 2 } , { KiB ( 4 ) , 4 } , { KiB ( 4 ) , 8 }
+                                                            };
+
+/** @brief Buffer sizes (in bytes) benchmarked by bench_memory_copy. */
+static u64 bench_memory_copy_sizes[] = { 8 , 64 , KiB ( 4 ) , MiB ( 1 ) , MiB ( 16 ) };
+
+bool
+bench_memory_allocate_and_free
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 size = *( ( u64* ) args );
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        void* memory = memory_allocate ( size , MEMORY_TAG_ARRAY );
+        BENCH_DO_NOT_OPTIMIZE ( memory );
+        memory_free ( memory , size , MEMORY_TAG_ARRAY );
+    }
+    return true;
+}
+
+bool
+bench_memory_allocate_and_free_threads
+(   void*   args
+,   u64     iterations
+)
+{
+    return bench_run_threads ( bench_memory_allocate_and_free
+                             , args
+                             , iterations
+                             , ( *( ( bench_memory_threads_t* ) args ) ).thread_count
+                             );
+}
+
+bool
+bench_memory_copy
+(   void*   args
+,   u64     iterations
+)
+{
+    const u64 size = *( ( u64* ) args );
+    u8* src = memory_allocate ( size , MEMORY_TAG_ARRAY );
+    u8* dst = memory_allocate ( size , MEMORY_TAG_ARRAY );
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        memory_copy ( dst , src , size );
+        BENCH_CLOBBER ();
+    }
+    memory_free ( src , size , MEMORY_TAG_ARRAY );
+    memory_free ( dst , size , MEMORY_TAG_ARRAY );
+    return true;
+}
+
+void
+bench_register_memory
+( void )
+{
+    bench_register ( bench_memory_allocate_and_free , &bench_memory_sizes[ 0 ] , "memory_allocate + memory_free: 64 B (per-thread cache)." );
+    bench_register ( bench_memory_allocate_and_free , &bench_memory_sizes[ 1 ] , "memory_allocate + memory_free: 4 KiB (global allocator)." );
+    bench_register ( bench_memory_allocate_and_free , &bench_memory_sizes[ 2 ] , "memory_allocate + memory_free: 2 MiB (virtual memory)." );
+    bench_register ( bench_memory_allocate_and_free_threads , &bench_memory_threads_args[ 0 ] , "memory_allocate + memory_free: 64 B, on each of 2 threads." );
+    bench_register ( bench_memory_allocate_and_free_threads , &bench_memory_threads_args[ 1 ] , "memory_allocate + memory_free: 64 B, on each of 4 threads." );
+    bench_register ( bench_memory_allocate_and_free_threads , &bench_memory_threads_args[ 2 ] , "memory_allocate + memory_free: 64 B, on each of 8 threads." );
+    bench_register ( bench_memory_allocate_and_free_threads , &bench_memory_threads_args[ 3 ] , "memory_allocate + memory_free: 4 KiB, on each of 2 threads." );
+    bench_register ( bench_memory_allocate_and_free_threads , &bench_memory_threads_args[ 4 ] , "memory_allocate + memory_free: 4 KiB, on each of 4 threads." );
+    bench_register ( bench_memory_allocate_and_free_threads , &bench_memory_threads_args[ 5 ] , "memory_allocate + memory_free: 4 KiB, on each of 8 threads." );
+    bench_register ( bench_memory_copy , &bench_memory_copy_sizes[ 0 ] , "memory_copy: 8 B." );
+    bench_register ( bench_memory_copy , &bench_memory_copy_sizes[ 1 ] , "memory_copy: 64 B." );
+    bench_register ( bench_memory_copy , &bench_memory_copy_sizes[ 2 ] , "memory_copy: 4 KiB." );
+    bench_register ( bench_memory_copy , &bench_memory_copy_sizes[ 3 ] , "memory_copy: 1 MiB." );
+    bench_register ( bench_memory_copy , &bench_memory_copy_sizes[ 4 ] , "memory_copy: 16 MiB (non-temporal)." );
+}
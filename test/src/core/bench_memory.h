@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/bench_memory.h
+ * @brief Benchmarks core/memory.h
+ * (see test/bench.h, core/memory.h for additional details)
+ */
+#ifndef BENCH_MEMORY_H
+#define BENCH_MEMORY_H
+
+#include "test/bench.h"
+
+#include "core/memory.h"
+
+void
+bench_register_memory
+( void );
+
+#endif  // BENCH_MEMORY_H
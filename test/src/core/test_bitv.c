@@ -0,0 +1,147 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_bitv.c
+ * @brief Implementation of the core/test_bitv header.
+ * (see core/test_bitv.h for additional details)
+ */
+#include "core/test_bitv.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "math/math.h"
+
+/** @brief Size (in bytes) of the bit vectors used by the tests. */
+#define TEST_BITV_SIZE 160
+
+u8
+test_bitv_bulk
+( void )
+{
+    u8 a[ TEST_BITV_SIZE ];
+    u8 b[ TEST_BITV_SIZE ];
+    u8 dst[ TEST_BITV_SIZE ];
+    u8 original[ TEST_BITV_SIZE ];
+    prng_t prng;
+    prng_seed ( &prng , 34 );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // Every length from 0 up to the size of the vectors, so that every
+    // combination of SIMD blocks, words, bytes, and trailing bits is covered.
+    for ( u64 length = 0; length <= TEST_BITV_SIZE * 8; ++length )
+    {
+        for ( u64 i = 0; i < TEST_BITV_SIZE; ++i )
+        {
+            // Sparse vectors give the searches long runs to skip.
+            a[ i ] = ( length % 3 ) ? ( u8 ) prng_next ( &prng ) : ( prng_bounded ( &prng , 16 ) ? 0 : 0x10 );
+            b[ i ] = ( u8 ) prng_next ( &prng );
+            original[ i ] = ( u8 ) prng_next ( &prng );
+        }
+
+        // TEST 1: bitv_and, bitv_or, bitv_xor, bitv_andnot, and bitv_not match single-bit operations, and leave bits at or beyond length untouched.
+        for ( u32 operation = 0; operation < 5; ++operation )
+        {
+            memory_copy ( dst , original , TEST_BITV_SIZE );
+            switch ( operation )
+            {
+                case 0:  bitv_and ( dst , a , b , length )      ;break;
+                case 1:  bitv_or ( dst , a , b , length )       ;break;
+                case 2:  bitv_xor ( dst , a , b , length )      ;break;
+                case 3:  bitv_andnot ( dst , a , b , length )   ;break;
+                default: bitv_not ( dst , a , length )          ;break;
+            }
+            for ( u64 i = 0; i < TEST_BITV_SIZE * 8; ++i )
+            {
+                bool expected;
+                const bool x = bitv_bit ( a , i );
+                const bool y = bitv_bit ( b , i );
+                if ( i >= length )
+                {
+                    expected = bitv_bit ( original , i );
+                }
+                else
+                {
+                    switch ( operation )
+                    {
+                        case 0:  expected = x && y   ;break;
+                        case 1:  expected = x || y   ;break;
+                        case 2:  expected = x != y   ;break;
+                        case 3:  expected = x && !y  ;break;
+                        default: expected = !x       ;break;
+                    }
+                }
+                EXPECT_EQ ( expected , bitv_bit ( dst , i ) );
+            }
+        }
+
+        // TEST 2: bitv_count, bitv_rank, bitv_next_set, bitv_next_clr, and bitv_select match single-bit scans.
+        u64 count = 0;
+        u64 next_set = length;
+        u64 next_clr = length;
+        for ( u64 i = length; i--; )
+        {
+            if ( bitv_bit ( a , i ) )
+            {
+                next_set = i;
+            }
+            else
+            {
+                next_clr = i;
+            }
+            EXPECT_EQ ( next_set , bitv_next_set ( a , length , i ) );
+            EXPECT_EQ ( next_clr , bitv_next_clr ( a , length , i ) );
+        }
+        EXPECT_EQ ( length , bitv_next_set ( a , length , length ) );
+        EXPECT_EQ ( length , bitv_next_clr ( a , length , length ) );
+        for ( u64 i = 0; i < length; ++i )
+        {
+            EXPECT_EQ ( count , bitv_rank ( a , i ) );
+            if ( bitv_bit ( a , i ) )
+            {
+                EXPECT_EQ ( i , bitv_select ( a , length , count ) );
+                count += 1;
+            }
+        }
+        EXPECT_EQ ( count , bitv_count ( a , length ) );
+        EXPECT_EQ ( length , bitv_select ( a , length , count ) );
+
+        // TEST 3: Iterating with bitv_first_set and bitv_next_set visits every set bit once.
+        u64 visited = 0;
+        for ( u64 i = bitv_first_set ( a , length ); i < length; i = bitv_next_set ( a , length , i + 1 ) )
+        {
+            EXPECT ( bitv_bit ( a , i ) );
+            visited += 1;
+        }
+        EXPECT_EQ ( count , visited );
+
+        // TEST 4: bitv_set_all, bitv_clr_all, and bitv_swp_all leave bits at or beyond length untouched.
+        memory_copy ( dst , original , TEST_BITV_SIZE );
+        bitv_set_all ( dst , length );
+        EXPECT_EQ ( length , bitv_count ( dst , length ) );
+        EXPECT_EQ ( length , bitv_first_clr ( dst , length ) );
+        bitv_swp_all ( dst , length );
+        EXPECT_EQ ( 0 , bitv_count ( dst , length ) );
+        bitv_set_all ( dst , length );
+        bitv_clr_all ( dst , length );
+        EXPECT_EQ ( length , bitv_first_set ( dst , length ) );
+        for ( u64 i = length; i < TEST_BITV_SIZE * 8; ++i )
+        {
+            EXPECT_EQ ( bitv_bit ( original , i ) , bitv_bit ( dst , i ) );
+        }
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_bitv
+( void )
+{
+    test_register ( test_bitv_bulk , "Testing bit vector bulk operations, searches, rank, and select." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_bitv.h
+ * @brief Tests core/bitv.h
+ * (see test/test.h, core/bitv.h for additional details)
+ */
+#ifndef TEST_BITV_H
+#define TEST_BITV_H
+
+#include "test/test.h"
+
+#include "core/bitv.h"
+
+void
+test_register_bitv
+( void );
+
+#endif  // TEST_BITV_H
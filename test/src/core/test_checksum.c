@@ -0,0 +1,215 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_checksum.c
+ * @brief Implementation of the core/test_checksum header.
+ * (see core/test_checksum.h for additional details)
+ */
+#include "core/test_checksum.h"
+
+#include "test/expect.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/prng.h"
+
+#include "platform/cpu.h"
+
+/** @brief Maximum buffer length tested. */
+#define TEST_CHECKSUM_CAPACITY 4096
+
+u8
+test_checksum_reference_values
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: CRC32C matches the standard check value (RFC 3720).
+    EXPECT_EQ ( 0xE3069283 , checksum_crc32c ( "123456789" , 9 , 0 ) );
+
+    // TEST 2: CRC32 matches the standard check value (zlib's crc32).
+    EXPECT_EQ ( 0xCBF43926 , checksum_crc32 ( "123456789" , 9 , 0 ) );
+
+    // TEST 3: The checksum of no data is the checksum passed in.
+    EXPECT_EQ ( 0 , checksum_crc32c ( 0 , 0 , 0 ) );
+    EXPECT_EQ ( 0 , checksum_crc32 ( 0 , 0 , 0 ) );
+    EXPECT_EQ ( 0xE3069283 , checksum_crc32c ( 0 , 0 , 0xE3069283 ) );
+
+    // TEST 4: A checksum may be continued from the checksum of the preceding
+    //         data.
+    EXPECT_EQ ( 0xE3069283 , checksum_crc32c ( "6789" , 4 , checksum_crc32c ( "12345" , 5 , 0 ) ) );
+    EXPECT_EQ ( 0xCBF43926 , checksum_crc32 ( "6789" , 4 , checksum_crc32 ( "12345" , 5 , 0 ) ) );
+
+    // TEST 5: XXH64 matches the reference implementation.
+    EXPECT_EQ ( 0xEF46DB3751D8E999ULL , checksum_xxh64 ( 0 , 0 , 0 ) );
+    EXPECT_EQ ( 0x44BC2CF5AD770999ULL , checksum_xxh64 ( "abc" , 3 , 0 ) );
+
+    // TEST 6: Checksums perform no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_checksum_kernels
+( void )
+{
+    // Lengths which exercise the folding loops, the tails, or both, for every
+    // kernel.
+    static const u64 sizes[] = { 1 , 7 , 8 , 15 , 63 , 64 , 65 , 127 , 200 , 1000 , TEST_CHECKSUM_CAPACITY };
+
+    // Instruction sets to test, fastest first, as far as the host supports.
+    static const u32 isas[] = { ~0U
+                              , CPU_FEATURE_SSE42
+                              , 0
+                              };
+
+    // Padding, so that the data can be misaligned.
+    static u8 data[ TEST_CHECKSUM_CAPACITY + 8 ];
+    static u32 expected_crc32c[ sizeof ( sizes ) / sizeof ( sizes[ 0 ] ) ][ 8 ];
+    static u32 expected_crc32[ sizeof ( sizes ) / sizeof ( sizes[ 0 ] ) ][ 8 ];
+
+    prng_t prng;
+    prng_seed ( &prng , 0xC0FFEE );
+    for ( u64 i = 0; i < sizeof ( data ); ++i )
+    {
+        data[ i ] = ( u8 ) prng_next ( &prng );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // Checksums computed byte by byte by the scalar kernels are the reference.
+    checksum_dispatch ( 0 );
+    for ( u64 k = 0; k < sizeof ( sizes ) / sizeof ( sizes[ 0 ] ); ++k )
+    {
+        for ( u64 offset = 0; offset < 8; ++offset )
+        {
+            u32 crc32c = 0;
+            u32 crc32 = 0;
+            for ( u64 i = 0; i < sizes[ k ]; ++i )
+            {
+                crc32c = checksum_crc32c ( data + offset + i , 1 , crc32c );
+                crc32 = checksum_crc32 ( data + offset + i , 1 , crc32 );
+            }
+            expected_crc32c[ k ][ offset ] = crc32c;
+            expected_crc32[ k ][ offset ] = crc32;
+        }
+    }
+
+    for ( u64 m = 0; m < sizeof ( isas ) / sizeof ( isas[ 0 ] ); ++m )
+    {
+        const char* isa = checksum_dispatch ( isas[ m ] & cpu_features () );
+        EXPECT ( isa != 0 );
+        LOGDEBUG ( "test_checksum_kernels: Testing %s kernels." , isa );
+
+        for ( u64 k = 0; k < sizeof ( sizes ) / sizeof ( sizes[ 0 ] ); ++k )
+        {
+            for ( u64 offset = 0; offset < 8; ++offset )
+            {
+                const u8* src = data + offset;
+                const u64 size = sizes[ k ];
+
+                // TEST 1: Each kernel matches the scalar kernel, at every
+                //         alignment.
+                EXPECT_EQ ( expected_crc32c[ k ][ offset ] , checksum_crc32c ( src , size , 0 ) );
+                EXPECT_EQ ( expected_crc32[ k ][ offset ] , checksum_crc32 ( src , size , 0 ) );
+
+                // TEST 2: Each kernel continues a checksum split at an odd
+                //         point.
+                const u64 split = size / 3;
+                EXPECT_EQ ( expected_crc32c[ k ][ offset ]
+                          , checksum_crc32c ( src + split , size - split , checksum_crc32c ( src , split , 0 ) )
+                          );
+                EXPECT_EQ ( expected_crc32[ k ][ offset ]
+                          , checksum_crc32 ( src + split , size - split , checksum_crc32 ( src , split , 0 ) )
+                          );
+            }
+        }
+    }
+
+    // Restore the host's fastest kernels.
+    checksum_dispatch ( cpu_features () );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_checksum_xxh64_incremental
+( void )
+{
+    static u8 data[ TEST_CHECKSUM_CAPACITY ];
+    for ( u64 i = 0; i < sizeof ( data ); ++i )
+    {
+        data[ i ] = ( u8 )( i * 31 + 7 );
+    }
+
+    checksum_xxh64_t state;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 size = 0; size < 200; size += 13 )
+    {
+        const u64 expected = checksum_xxh64 ( data , size , 42 );
+
+        // TEST 1: An incremental digest matches the one-pass digest, for every
+        //         chunk size (including ones smaller and larger than a
+        //         stripe).
+        for ( u64 chunk = 1; chunk < 3 * CHECKSUM_XXH64_STRIPE_SIZE; chunk += 5 )
+        {
+            checksum_xxh64_begin ( 42 , &state );
+            for ( u64 i = 0; i < size; i += chunk )
+            {
+                checksum_xxh64_update ( &state , data + i , MIN ( chunk , size - i ) );
+            }
+            EXPECT_EQ ( expected , checksum_xxh64_end ( &state ) );
+        }
+
+        // TEST 2: The seed changes the digest.
+        EXPECT_NEQ ( expected , checksum_xxh64 ( data , size , 43 ) );
+    }
+
+    // TEST 3: An incremental digest may be queried, then continued.
+    checksum_xxh64_begin ( 0 , &state );
+    checksum_xxh64_update ( &state , "a" , 1 );
+    checksum_xxh64_update ( &state , 0 , 0 );
+    EXPECT_EQ ( checksum_xxh64 ( "a" , 1 , 0 ) , checksum_xxh64_end ( &state ) );
+    checksum_xxh64_update ( &state , "bc" , 2 );
+    EXPECT_EQ ( 0x44BC2CF5AD770999ULL , checksum_xxh64_end ( &state ) );
+
+    // TEST 4: Large inputs are digested identically in one pass and in chunks.
+    checksum_xxh64_begin ( 0 , &state );
+    checksum_xxh64_update ( &state , data , 1001 );
+    checksum_xxh64_update ( &state , data + 1001 , sizeof ( data ) - 1001 );
+    EXPECT_EQ ( checksum_xxh64 ( data , sizeof ( data ) , 0 ) , checksum_xxh64_end ( &state ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_checksum
+( void )
+{
+    test_register ( test_checksum_reference_values , "Testing checksums against reference values." );
+    test_register_serial ( test_checksum_kernels , "Testing checksum kernels for each instruction set." );
+    test_register ( test_checksum_xxh64_incremental , "Computing an XXH64 digest incrementally." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_checksum.h
+ * @brief Tests core/checksum.h
+ * (see test/test.h, core/checksum.h for additional details)
+ */
+#ifndef TEST_CHECKSUM_H
+#define TEST_CHECKSUM_H
+
+#include "test/test.h"
+
+#include "core/checksum.h"
+
+void
+test_register_checksum
+( void );
+
+#endif  // TEST_CHECKSUM_H
@@ -0,0 +1,109 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_clock.c
+ * @brief Implementation of the core/test_clock header.
+ * (see core/test_clock.h for additional details)
+ */
+#include "core/test_clock.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/platform.h"
+
+/** @brief Duration (in milliseconds) of each sleep timed by the test. */
+#define TEST_CLOCK_SLEEP 10
+
+/** @brief TEST_CLOCK_SLEEP in nanoseconds. */
+#define TEST_CLOCK_SLEEP_NS ( ( u64 ) TEST_CLOCK_SLEEP * 1000000 )
+
+u8
+test_clock
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    clock_t clock;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: clock_time is monotonic, and advances by at least the time slept.
+    u64 time = clock_time ();
+    EXPECT_NEQ ( 0 , time );
+    for ( u32 i = 0; i < 1000; ++i )
+    {
+        const u64 next = clock_time ();
+        EXPECT ( next >= time );
+        time = next;
+    }
+    platform_sleep ( TEST_CLOCK_SLEEP );
+    EXPECT ( clock_time () - time >= TEST_CLOCK_SLEEP_NS );
+
+    // TEST 2: clock_start resets the elapsed time, and clock_update measures it.
+    clock_start ( &clock );
+    EXPECT_EQ ( 0 , clock.elapsed );
+    platform_sleep ( TEST_CLOCK_SLEEP );
+    clock_update ( &clock );
+    EXPECT ( clock.elapsed >= TEST_CLOCK_SLEEP_NS );
+
+    // TEST 3: A stopped clock keeps its elapsed time, and clock_update has no effect on it.
+    clock_stop ( &clock );
+    const u64 elapsed = clock.elapsed;
+    EXPECT ( elapsed >= TEST_CLOCK_SLEEP_NS );
+    platform_sleep ( TEST_CLOCK_SLEEP );
+    clock_update ( &clock );
+    EXPECT_EQ ( elapsed , clock.elapsed );
+    clock_stop ( &clock );
+    EXPECT_EQ ( elapsed , clock.elapsed );
+
+    // TEST 4: clock_resume accumulates, excluding the time spent stopped.
+    clock_resume ( &clock );
+    platform_sleep ( TEST_CLOCK_SLEEP );
+    clock_stop ( &clock );
+    EXPECT ( clock.elapsed >= elapsed + TEST_CLOCK_SLEEP_NS );
+    EXPECT ( clock_seconds ( clock.elapsed ) >= 2 * TEST_CLOCK_SLEEP / 1000.0 );
+
+    // TEST 5: clock_lap measures the time since the last lap, and updates the elapsed time.
+    clock_start ( &clock );
+    platform_sleep ( TEST_CLOCK_SLEEP );
+    const u64 lap = clock_lap ( &clock );
+    EXPECT ( lap >= TEST_CLOCK_SLEEP_NS );
+    EXPECT_EQ ( lap , clock.elapsed );
+    platform_sleep ( TEST_CLOCK_SLEEP );
+    EXPECT ( clock_lap ( &clock ) >= TEST_CLOCK_SLEEP_NS );
+    EXPECT ( clock.elapsed >= lap + TEST_CLOCK_SLEEP_NS );
+
+    // TEST 6: The cycle counter advances, and converts to a time consistent with the monotonic clock.
+    EXPECT_NEQ ( 0 , clock_tick_frequency () );
+    EXPECT_EQ ( clock_tick_frequency () , clock_tick_frequency () );
+    time = clock_time ();
+    const u64 ticks = clock_ticks ();
+    platform_sleep ( TEST_CLOCK_SLEEP );
+    const u64 ticks_ns = clock_ticks_to_ns ( clock_ticks () - ticks );
+    const u64 time_ns = clock_time () - time;
+    EXPECT ( ticks_ns >= TEST_CLOCK_SLEEP_NS );
+    EXPECT ( ticks_ns > time_ns / 2 && ticks_ns < time_ns * 2 );
+
+    // TEST 7: clock performs no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_clock
+( void )
+{
+    test_register ( test_clock , "Testing monotonic clock and cycle counter." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_clock.h
+ * @brief Tests core/clock.h
+ * (see test/test.h, core/clock.h for additional details)
+ */
+#ifndef TEST_CLOCK_H
+#define TEST_CLOCK_H
+
+#include "test/test.h"
+
+#include "core/clock.h"
+
+void
+test_register_clock
+( void );
+
+#endif  // TEST_CLOCK_H
@@ -0,0 +1,240 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_compress.c
+ * @brief Implementation of the core/test_compress header.
+ * (see core/test_compress.h for additional details)
+ */
+#include "core/test_compress.h"
+
+#include "test/expect.h"
+
+#include "core/checksum.h"
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/prng.h"
+
+/** @brief Maximum buffer length tested. */
+#define TEST_COMPRESS_CAPACITY KiB ( 256 )
+
+/** @brief Types of data tested. */
+typedef enum
+{
+    TEST_COMPRESS_ZEROS
+,   TEST_COMPRESS_TEXT
+,   TEST_COMPRESS_RANDOM
+
+,   TEST_COMPRESS_KIND_COUNT
+}
+TEST_COMPRESS_KIND;
+
+/**
+ * @brief Fills a buffer with test data.
+ * 
+ * @param kind The kind of data.
+ * @param size The number of bytes to fill.
+ * @param dst Output buffer. Must be non-zero.
+ */
+void
+test_compress_fill
+(   const TEST_COMPRESS_KIND    kind
+,   const u64                   size
+,   u8*                         dst
+)
+{
+    static const char* words[] = { "[INFO]\t" , "[WARN]\t" , "job " , "queued " , "finished " , "in " , "ms.\n" , "file " , "0x7f" };
+
+    prng_t prng;
+    prng_seed ( &prng , 0xC0FFEE );
+    switch ( kind )
+    {
+        case TEST_COMPRESS_ZEROS:
+        {
+            memory_clear ( dst , size );
+        }
+        break;
+
+        case TEST_COMPRESS_TEXT:
+        {
+            u64 i = 0;
+            while ( i < size )
+            {
+                const char* word = words[ prng_next ( &prng ) % ( sizeof ( words ) / sizeof ( words[ 0 ] ) ) ];
+                for ( u64 j = 0; word[ j ] && i < size; ++j )
+                {
+                    dst[ i++ ] = word[ j ];
+                }
+            }
+        }
+        break;
+
+        default:
+        {
+            for ( u64 i = 0; i < size; ++i )
+            {
+                dst[ i ] = ( u8 ) prng_next ( &prng );
+            }
+        }
+        break;
+    }
+}
+
+u8
+test_compress_block
+( void )
+{
+    // Lengths around the minimum match, the literal-only tail and the 64 KiB
+    // window, and much longer.
+    static const u64 sizes[] = { 0 , 1 , 4 , 12 , 13 , 17 , 100 , 1000 , KiB ( 64 ) - 1 , KiB ( 64 ) + 1 , TEST_COMPRESS_CAPACITY };
+
+    static u8 data[ TEST_COMPRESS_CAPACITY ];
+    static u8 compressed[ COMPRESS_BOUND ( TEST_COMPRESS_CAPACITY ) ];
+    static u8 decompressed[ TEST_COMPRESS_CAPACITY ];
+
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 kind = 0; kind < TEST_COMPRESS_KIND_COUNT; ++kind )
+    {
+        test_compress_fill ( kind , TEST_COMPRESS_CAPACITY , data );
+        for ( u64 k = 0; k < sizeof ( sizes ) / sizeof ( sizes[ 0 ] ); ++k )
+        {
+            const u64 size = sizes[ k ];
+
+            // TEST 1: The compressed block fits within the bound.
+            const u64 compressed_size = compress_block ( data , size , compressed );
+            EXPECT ( compressed_size <= COMPRESS_BOUND ( size ) );
+
+            // TEST 2: The block decompresses to the original data.
+            memory_clear ( decompressed , size );
+            EXPECT ( decompress_block ( compressed , compressed_size , decompressed , size ) );
+            EXPECT ( memory_equal ( data , decompressed , size ) );
+
+            // TEST 3: Decompressing to the wrong size fails.
+            EXPECT_NOT ( decompress_block ( compressed , compressed_size , decompressed , size + 1 ) );
+            if ( size )
+            {
+                EXPECT_NOT ( decompress_block ( compressed , compressed_size , decompressed , size - 1 ) );
+            }
+
+            // TEST 4: A truncated block fails.
+            EXPECT_NOT ( decompress_block ( compressed , compressed_size - 1 , decompressed , size ) );
+        }
+    }
+
+    // TEST 5: Redundant data compresses well.
+    test_compress_fill ( TEST_COMPRESS_ZEROS , TEST_COMPRESS_CAPACITY , data );
+    EXPECT ( compress_block ( data , TEST_COMPRESS_CAPACITY , compressed ) < TEST_COMPRESS_CAPACITY / 100 );
+    test_compress_fill ( TEST_COMPRESS_TEXT , TEST_COMPRESS_CAPACITY , data );
+    EXPECT ( compress_block ( data , TEST_COMPRESS_CAPACITY , compressed ) < TEST_COMPRESS_CAPACITY / 2 );
+
+    // TEST 6: Blocks in the LZ4 block format decompress (overlapping match).
+    static const u8 block[] = { 0x11 , 'a' , 0x01 , 0x00 , 0x50 , 'b' , 'c' , 'd' , 'e' , 'f' };
+    EXPECT ( decompress_block ( block , sizeof ( block ) , decompressed , 11 ) );
+    EXPECT ( memory_equal ( decompressed , "aaaaaabcdef" , 11 ) );
+
+    // TEST 7: Back-references outside the output are rejected.
+    static const u8 zero_offset[] = { 0x10 , 'a' , 0x00 , 0x00 , 0x00 };
+    static const u8 far_offset[] = { 0x10 , 'a' , 0x02 , 0x00 , 0x00 };
+    EXPECT_NOT ( decompress_block ( zero_offset , sizeof ( zero_offset ) , decompressed , 5 ) );
+    EXPECT_NOT ( decompress_block ( far_offset , sizeof ( far_offset ) , decompressed , 5 ) );
+
+    // TEST 8: Garbage never decompresses past either buffer.
+    test_compress_fill ( TEST_COMPRESS_RANDOM , 4096 , data );
+    for ( u64 i = 0; i < 4096; i += 64 )
+    {
+        decompress_block ( data + i , 64 , decompressed , 256 );
+    }
+
+    // TEST 9: Compression performs no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_compress_frame
+( void )
+{
+    static u8 data[ TEST_COMPRESS_CAPACITY ];
+    static u8 frame[ COMPRESS_FRAME_BOUND ( TEST_COMPRESS_CAPACITY ) ];
+    static u8 decompressed[ TEST_COMPRESS_CAPACITY ];
+
+    u64 payload_size;
+    u64 size;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A frame round-trips, and its header reports its sizes.
+    test_compress_fill ( TEST_COMPRESS_TEXT , TEST_COMPRESS_CAPACITY , data );
+    u64 frame_size = compress_frame ( data , TEST_COMPRESS_CAPACITY , frame );
+    EXPECT ( frame_size < TEST_COMPRESS_CAPACITY / 2 );
+    EXPECT ( compress_frame_parse ( frame , &payload_size , &size ) );
+    EXPECT_EQ ( frame_size - COMPRESS_FRAME_HEADER_SIZE , payload_size );
+    EXPECT_EQ ( TEST_COMPRESS_CAPACITY , size );
+    EXPECT ( decompress_frame ( frame , frame + COMPRESS_FRAME_HEADER_SIZE , decompressed ) );
+    EXPECT ( memory_equal ( data , decompressed , TEST_COMPRESS_CAPACITY ) );
+
+    // TEST 2: Data which does not compress is stored as-is.
+    test_compress_fill ( TEST_COMPRESS_RANDOM , TEST_COMPRESS_CAPACITY , data );
+    frame_size = compress_frame ( data , TEST_COMPRESS_CAPACITY , frame );
+    EXPECT_EQ ( COMPRESS_FRAME_HEADER_SIZE + TEST_COMPRESS_CAPACITY , frame_size );
+    EXPECT ( memory_equal ( data , frame + COMPRESS_FRAME_HEADER_SIZE , TEST_COMPRESS_CAPACITY ) );
+    EXPECT ( compress_frame_parse ( frame , &payload_size , &size ) );
+    EXPECT_EQ ( TEST_COMPRESS_CAPACITY , payload_size );
+    EXPECT ( decompress_frame ( frame , frame + COMPRESS_FRAME_HEADER_SIZE , decompressed ) );
+    EXPECT ( memory_equal ( data , decompressed , TEST_COMPRESS_CAPACITY ) );
+
+    // TEST 3: An empty frame round-trips.
+    frame_size = compress_frame ( 0 , 0 , frame );
+    EXPECT ( compress_frame_parse ( frame , &payload_size , &size ) );
+    EXPECT_EQ ( 0 , size );
+    EXPECT ( decompress_frame ( frame , frame + COMPRESS_FRAME_HEADER_SIZE , decompressed ) );
+
+    // TEST 4: A stored frame header may be written in front of content.
+    static const char message[] = "[FATAL]\tOut of memory.\n";
+    compress_frame_stored ( sizeof ( message ) - 1 , checksum_crc32c ( message , sizeof ( message ) - 1 , 0 ) , frame );
+    EXPECT ( compress_frame_parse ( frame , &payload_size , &size ) );
+    EXPECT_EQ ( sizeof ( message ) - 1 , payload_size );
+    EXPECT_EQ ( sizeof ( message ) - 1 , size );
+    EXPECT ( decompress_frame ( frame , message , decompressed ) );
+    EXPECT ( memory_equal ( message , decompressed , sizeof ( message ) - 1 ) );
+
+    // TEST 5: A damaged frame is detected.
+    test_compress_fill ( TEST_COMPRESS_TEXT , TEST_COMPRESS_CAPACITY , data );
+    frame_size = compress_frame ( data , 1000 , frame );
+    frame[ frame_size - 1 ] ^= 0x20;
+    EXPECT_NOT ( decompress_frame ( frame , frame + COMPRESS_FRAME_HEADER_SIZE , decompressed ) );
+
+    // TEST 6: A malformed header is rejected.
+    frame[ 0 ] ^= 1;
+    EXPECT_NOT ( compress_frame_parse ( frame , &payload_size , &size ) );
+    frame[ 0 ] ^= 1;
+    frame[ 11 ] = 0xFF;
+    EXPECT_NOT ( compress_frame_parse ( frame , &payload_size , &size ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_compress
+( void )
+{
+    test_register ( test_compress_block , "Compressing and decompressing blocks." );
+    test_register ( test_compress_frame , "Compressing and decompressing frames." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_compress.h
+ * @brief Tests core/compress.h
+ * (see test/test.h, core/compress.h for additional details)
+ */
+#ifndef TEST_COMPRESS_H
+#define TEST_COMPRESS_H
+
+#include "test/test.h"
+
+#include "core/compress.h"
+
+void
+test_register_compress
+( void );
+
+#endif  // TEST_COMPRESS_H
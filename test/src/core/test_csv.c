@@ -0,0 +1,437 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_csv.c
+ * @brief Implementation of the core/test_csv header.
+ * (see core/test_csv.h for additional details)
+ */
+#include "core/test_csv.h"
+
+#include "test/expect.h"
+
+#include "core/checksum.h"
+#include "core/job.h"
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/string.h"
+
+/** @brief Path of the file written and read back by the tests. */
+#define FILE_NAME_TEST_OUT_CSV "test/assets/out-csv"
+
+/** @brief Capacity of the generated input. */
+#define TEST_CSV_CAPACITY KiB ( 512 )
+
+/** @brief Number of records in the generated input. */
+#define TEST_CSV_RECORD_COUNT 9000
+
+/** @brief Maximum number of chunks tested by csv_parse_parallel. */
+#define TEST_CSV_MAX_CHUNK_COUNT 16
+
+/** @brief Type definition for the results of a parallel parse, per chunk. */
+typedef struct
+{
+    u64     records[ TEST_CSV_MAX_CHUNK_COUNT ];
+    u64     length[ TEST_CSV_MAX_CHUNK_COUNT ];
+    bool    valid[ TEST_CSV_MAX_CHUNK_COUNT ];
+
+    // Number of records after which to fail, or 0 to never fail.
+    u64     limit;
+}
+test_csv_results_t;
+
+/**
+ * @brief Generates delimited records: plain ones, ones with quoted newlines,
+ * delimiters and doubled quotes, and ones longer than a 64-byte block.
+ *
+ * @param record_count The number of records.
+ * @param dst Output buffer. Must be non-zero, and hold at least
+ * TEST_CSV_CAPACITY bytes.
+ * @return The number of bytes written.
+ */
+u64
+test_csv_generate
+(   const u64   record_count
+,   char*       dst
+)
+{
+    static const char* records[] = { "alpha,beta,gamma\n"
+                                   , "\"multi\nline, \"\"quoted\"\" field\",x\r\n"
+                                   , "\"zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz\",end\n"
+                                   };
+    u64 size = 0;
+    for ( u64 i = 0; i < record_count; ++i )
+    {
+        const char* record = records[ i % ( sizeof ( records ) / sizeof ( records[ 0 ] ) ) ];
+        const u64 length = _string_length ( record );
+        if ( size + length > TEST_CSV_CAPACITY )
+        {
+            break;
+        }
+        memory_copy ( dst + size , record , length );
+        size += length;
+    }
+    return size;
+}
+
+/**
+ * @brief Compares the value of a field to a string.
+ *
+ * @param field The field. Must be non-zero.
+ * @param string The expected value. Must be non-zero.
+ * @return true if the field's unescaped value equals string; false otherwise.
+ */
+bool
+test_csv_field_equal
+(   const csv_field_t*  field
+,   const char*         string
+)
+{
+    char value[ 256 ];
+    if ( ( *field ).value.length > sizeof ( value ) )
+    {
+        return false;
+    }
+    const u64 length = csv_field_unescape ( field , '"' , value );
+    return length == _string_length ( string ) && memory_equal ( value , string , length );
+}
+
+/**
+ * @brief Record function for csv_parse_parallel: counts the records and the
+ * total length of their fields in each chunk.
+ *
+ * @param fields The fields.
+ * @param field_count The number of fields.
+ * @param chunk The index of the chunk.
+ * @param args The results (see test_csv_results_t).
+ * @return false if the results' record limit is reached; true otherwise.
+ */
+bool
+test_csv_count
+(   const csv_field_t*  fields
+,   u64                 field_count
+,   u64                 chunk
+,   void*               args
+)
+{
+    test_csv_results_t* results = args;
+    if ( chunk >= TEST_CSV_MAX_CHUNK_COUNT )
+    {
+        return false;
+    }
+
+    // Every generated record has three fields if its first is unquoted.
+    const bool quoted = !( field_count == 3 && test_csv_field_equal ( &fields[ 0 ] , "alpha" ) );
+    if ( quoted && field_count != 2 )
+    {
+        ( *results ).valid[ chunk ] = false;
+    }
+
+    ( *results ).records[ chunk ] += 1;
+    for ( u64 i = 0; i < field_count; ++i )
+    {
+        ( *results ).length[ chunk ] += fields[ i ].value.length;
+    }
+    return !( *results ).limit || ( *results ).records[ chunk ] < ( *results ).limit;
+}
+
+u8
+test_csv_parse
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    csv_t csv;
+    const csv_field_t* fields;
+    u64 field_count;
+    char value[ 64 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: csv_create handles invalid arguments, and does not allocate memory on failure.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( csv_create ( 0 , 1 , ',' , '"' , &csv ) );
+    EXPECT_NOT ( csv_create ( "a" , 1 , ',' , '"' , 0 ) );
+    EXPECT_NOT ( csv_create ( "a" , 1 , 0 , '"' , &csv ) );
+    EXPECT_NOT ( csv_create ( "a" , 1 , '\n' , '"' , &csv ) );
+    EXPECT_NOT ( csv_create ( "a" , 1 , '"' , '"' , &csv ) );
+    EXPECT_NOT ( csv_create ( "a" , 1 , ',' , '\n' , &csv ) );
+    EXPECT_NOT ( csv_create_reader ( 0 , ',' , '"' , &csv ) );
+    EXPECT_NOT ( csv_next_record ( 0 , &fields , &field_count ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+
+    // TEST 2: Empty input has no records.
+    EXPECT ( csv_create ( 0 , 0 , ',' , '"' , &csv ) );
+    EXPECT_NOT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 0 , field_count );
+    csv_destroy ( &csv );
+
+    // TEST 3: Plain fields, empty fields, CRLF line endings and a final record without a newline.
+    const char plain[] = "a,bc,\r\n,,\nlast,record";
+    EXPECT ( csv_create ( plain , sizeof ( plain ) - 1 , ',' , '"' , &csv ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 3 , field_count );
+    EXPECT ( test_csv_field_equal ( &fields[ 0 ] , "a" ) );
+    EXPECT ( test_csv_field_equal ( &fields[ 1 ] , "bc" ) );
+    EXPECT ( test_csv_field_equal ( &fields[ 2 ] , "" ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 3 , field_count );
+    EXPECT_EQ ( 0 , fields[ 0 ].value.length );
+    EXPECT_EQ ( 0 , fields[ 2 ].value.length );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 2 , field_count );
+    EXPECT ( test_csv_field_equal ( &fields[ 1 ] , "record" ) );
+    EXPECT_NOT ( csv_next_record ( &csv , &fields , &field_count ) );
+    csv_destroy ( &csv );
+
+    // TEST 4: Quoted fields may contain delimiters, newlines and doubled quotes.
+    const char quoted[] = "\"a,b\",\"line\nbreak\",\"say \"\"hi\"\"\"\r\n\"\",x\n";
+    EXPECT ( csv_create ( quoted , sizeof ( quoted ) - 1 , ',' , '"' , &csv ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 3 , field_count );
+    EXPECT ( test_csv_field_equal ( &fields[ 0 ] , "a,b" ) );
+    EXPECT_NOT ( fields[ 0 ].escaped );
+    EXPECT ( test_csv_field_equal ( &fields[ 1 ] , "line\nbreak" ) );
+    EXPECT ( fields[ 2 ].escaped );
+    EXPECT_EQ ( 10 , fields[ 2 ].value.length );
+    EXPECT_EQ ( 8 , csv_field_unescape ( &fields[ 2 ] , '"' , value ) );
+    EXPECT ( memory_equal ( value , "say \"hi\"" , 8 ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 2 , field_count );
+    EXPECT ( test_csv_field_equal ( &fields[ 0 ] , "" ) );
+    EXPECT ( test_csv_field_equal ( &fields[ 1 ] , "x" ) );
+    EXPECT_NOT ( csv_next_record ( &csv , &fields , &field_count ) );
+    csv_destroy ( &csv );
+
+    // TEST 5: Records and quoted regions which span several 64-byte blocks, and records with more fields than the initial field capacity.
+    char wide[ 1024 ];
+    u64 size = 0;
+    for ( u64 i = 0; i < 40; ++i )
+    {
+        wide[ size++ ] = 'a' + i % 26;
+        wide[ size++ ] = '\t';
+    }
+    wide[ size++ ] = '"';
+    for ( u64 i = 0; i < 150; ++i )
+    {
+        wide[ size++ ] = ( i % 50 == 49 ) ? '\n' : ( i % 10 == 9 ) ? '\t' : 'q';
+    }
+    wide[ size++ ] = '"';
+    wide[ size++ ] = '\n';
+    wide[ size++ ] = 'z';
+    EXPECT ( csv_create ( wide , size , '\t' , '"' , &csv ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 41 , field_count );
+    EXPECT ( test_csv_field_equal ( &fields[ 39 ] , "n" ) );
+    EXPECT_EQ ( 150 , fields[ 40 ].value.length );
+    EXPECT ( memory_equal ( fields[ 40 ].value.string , wide + 81 , 150 ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 1 , field_count );
+    EXPECT ( test_csv_field_equal ( &fields[ 0 ] , "z" ) );
+    EXPECT_NOT ( csv_next_record ( &csv , &fields , &field_count ) );
+    csv_destroy ( &csv );
+
+    // TEST 6: With quoting disabled, quotes are ordinary characters.
+    const char unquoted[] = "\"a,b\"\n";
+    EXPECT ( csv_create ( unquoted , sizeof ( unquoted ) - 1 , ',' , 0 , &csv ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT_EQ ( 2 , field_count );
+    EXPECT ( test_csv_field_equal ( &fields[ 0 ] , "\"a" ) );
+    EXPECT ( test_csv_field_equal ( &fields[ 1 ] , "b\"" ) );
+    csv_destroy ( &csv );
+
+    // TEST 7: Input which ends within a quoted field is malformed.
+    const char malformed[] = "a,b\n\"c,d\ne\n";
+    EXPECT ( csv_create ( malformed , sizeof ( malformed ) - 1 , ',' , '"' , &csv ) );
+    EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( csv_next_record ( &csv , &fields , &field_count ) );
+    csv_destroy ( &csv );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_csv_reader
+( void )
+{
+    static char data[ TEST_CSV_CAPACITY ];
+
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 size = test_csv_generate ( 300 , data );
+    file_t file;
+    file_reader_t reader;
+    csv_t csv;
+    csv_t expected;
+    const csv_field_t* fields;
+    const csv_field_t* expected_fields;
+    u64 field_count;
+    u64 expected_field_count;
+    u64 written;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_CSV , FILE_MODE_WRITE , &file ) );
+    EXPECT ( file_write ( &file , size , data , &written ) );
+    EXPECT_EQ ( size , written );
+    file_close ( &file );
+
+    // TEST 1: A parser reading through a small file reader buffer returns the same records as one parsing the whole buffer, growing the reader's buffer to hold the widest record.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_CSV , FILE_MODE_READ , &file ) );
+    EXPECT ( _file_reader_create ( &file , 16 , &reader ) );
+    EXPECT ( csv_create_reader ( &reader , ',' , '"' , &csv ) );
+    EXPECT ( csv_create ( data , size , ',' , '"' , &expected ) );
+    u64 record_count = 0;
+    while ( csv_next_record ( &expected , &expected_fields , &expected_field_count ) )
+    {
+        EXPECT ( csv_next_record ( &csv , &fields , &field_count ) );
+        EXPECT_EQ ( expected_field_count , field_count );
+        for ( u64 i = 0; i < field_count; ++i )
+        {
+            EXPECT_EQ ( expected_fields[ i ].value.length , fields[ i ].value.length );
+            EXPECT ( memory_equal ( expected_fields[ i ].value.string
+                                  , fields[ i ].value.string
+                                  , fields[ i ].value.length
+                                  ));
+            EXPECT_EQ ( expected_fields[ i ].escaped , fields[ i ].escaped );
+        }
+        record_count += 1;
+    }
+    EXPECT_EQ ( 300 , record_count );
+    EXPECT_NOT ( csv_next_record ( &csv , &fields , &field_count ) );
+    EXPECT ( reader.capacity > 16 );
+
+    // TEST 2: Every record is consumed from the reader.
+    csv_destroy ( &csv );
+    csv_destroy ( &expected );
+    EXPECT_EQ ( checksum_crc32c ( data , size , 0 ) , reader.checksum );
+    file_reader_destroy ( &reader );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_csv_parse_parallel
+( void )
+{
+    static char data[ TEST_CSV_CAPACITY ];
+
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 size = test_csv_generate ( TEST_CSV_RECORD_COUNT , data );
+    test_csv_results_t results;
+    test_csv_results_t expected;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: csv_parse_parallel handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( csv_parse_parallel ( 0 , 1 , ',' , '"' , 0 , test_csv_count , 0 ) );
+    EXPECT_NOT ( csv_parse_parallel ( data , size , ',' , '"' , 0 , 0 , 0 ) );
+    EXPECT_NOT ( csv_parse_parallel ( data , size , ',' , ',' , 0 , test_csv_count , 0 ) );
+
+    // TEST 2: Parsing the whole input as a single chunk.
+    memory_clear ( &expected , sizeof ( expected ) );
+    memory_set ( expected.valid , true , sizeof ( expected.valid ) );
+    EXPECT ( csv_parse_parallel ( data , size , ',' , '"' , 1 , test_csv_count , &expected ) );
+    EXPECT_EQ ( TEST_CSV_RECORD_COUNT , expected.records[ 0 ] );
+    EXPECT ( expected.valid[ 0 ] );
+
+    // TEST 3: csv_parse_parallel splits the input at record boundaries, both on the calling thread and on the job system.
+    for ( u64 j = 0; j < 2; ++j )
+    {
+        if ( j )
+        {
+            EXPECT ( job_system_startup ( 2 , 0 , 0 ) );
+        }
+        static const u64 chunk_counts[] = { 0 , 2 , 3 , 5 , 8 , TEST_CSV_MAX_CHUNK_COUNT };
+        for ( u64 k = 0; k < sizeof ( chunk_counts ) / sizeof ( chunk_counts[ 0 ] ); ++k )
+        {
+            memory_clear ( &results , sizeof ( results ) );
+            memory_set ( results.valid , true , sizeof ( results.valid ) );
+            EXPECT ( csv_parse_parallel ( data , size , ',' , '"' , chunk_counts[ k ] , test_csv_count , &results ) );
+            u64 records = 0;
+            u64 length = 0;
+            for ( u64 i = 0; i < TEST_CSV_MAX_CHUNK_COUNT; ++i )
+            {
+                EXPECT ( results.valid[ i ] );
+                records += results.records[ i ];
+                length += results.length[ i ];
+            }
+            EXPECT_EQ ( expected.records[ 0 ] , records );
+            EXPECT_EQ ( expected.length[ 0 ] , length );
+            if ( chunk_counts[ k ] > 1 )
+            {
+                EXPECT_NEQ ( 0 , results.records[ 1 ] );
+            }
+        }
+        if ( j )
+        {
+            job_system_shutdown ();
+        }
+    }
+
+    // TEST 4: csv_parse_parallel fails if the record function does.
+    memory_clear ( &results , sizeof ( results ) );
+    results.limit = 10;
+    EXPECT_NOT ( csv_parse_parallel ( data , size , ',' , '"' , 4 , test_csv_count , &results ) );
+    EXPECT_EQ ( 10 , results.records[ 0 ] );
+
+    // TEST 5: csv_parse_parallel fails if the input ends within a quoted field.
+    data[ size - 1 ] = '"';
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( csv_parse_parallel ( data , size , ',' , '"' , 4 , test_csv_count , &results ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_csv
+( void )
+{
+    test_register ( test_csv_parse , "Parsing delimited records from a buffer." );
+    test_register_serial ( test_csv_reader , "Parsing delimited records from a file through a buffered file reader." );
+    test_register_serial ( test_csv_parse_parallel , "Parsing delimited records from a buffer in parallel." );
+}
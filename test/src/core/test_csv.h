@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_csv.h
+ * @brief Tests core/csv.h
+ * (see test/test.h, core/csv.h for additional details)
+ */
+#ifndef TEST_CSV_H
+#define TEST_CSV_H
+
+#include "test/test.h"
+
+#include "core/csv.h"
+
+void
+test_register_csv
+( void );
+
+#endif  // TEST_CSV_H
@@ -0,0 +1,93 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_image.c
+ * @brief Implementation of the core/test_image header.
+ * (see core/test_image.h for additional details)
+ */
+#include "core/test_image.h"
+
+#include "test/expect.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+/** @brief Image size tested (in bytes). */
+#define TEST_IMAGE_SIZE ( IMAGE_HEADER_SIZE + 256 )
+
+u8
+test_image_header
+( void )
+{
+    static u64 buffer[ TEST_IMAGE_SIZE / sizeof ( u64 ) ];
+
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u8* image = ( u8* ) buffer;
+    image_header_t* header = ( image_header_t* ) buffer;
+    const u64 parameters[ IMAGE_PARAMETER_COUNT ] = { 1 , 2 , 3 , 4 , 5 };
+    for ( u64 i = IMAGE_HEADER_SIZE; i < TEST_IMAGE_SIZE; ++i )
+    {
+        image[ i ] = ( u8 ) i;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A header which was just written is valid, and records its parameters.
+    image_header_write ( IMAGE_TYPE_ARRAY , 3 , parameters , TEST_IMAGE_SIZE , image );
+    EXPECT_EQ ( header , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 3 , true ) );
+    EXPECT_EQ ( TEST_IMAGE_SIZE , ( *header ).size );
+    EXPECT ( memory_equal ( ( *header ).parameters , parameters , sizeof ( parameters ) ) );
+
+    // TEST 2: The image may be followed by other data.
+    EXPECT_EQ ( header , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE + 1 , IMAGE_TYPE_ARRAY , 3 , true ) );
+
+    // TEST 3: A missing, truncated or unexpected image is rejected.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , 0 , 0 , IMAGE_TYPE_ARRAY , 3 , false ) );
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , IMAGE_HEADER_SIZE - 1 , IMAGE_TYPE_ARRAY , 3 , false ) );
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE - 1 , IMAGE_TYPE_ARRAY , 3 , false ) );
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_HASHTABLE , 3 , false ) );
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 4 , false ) );
+
+    // TEST 4: A damaged payload is detected only when verifying it.
+    image[ TEST_IMAGE_SIZE - 1 ] ^= 1;
+    EXPECT_EQ ( header , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 3 , false ) );
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 3 , true ) );
+    image[ TEST_IMAGE_SIZE - 1 ] ^= 1;
+
+    // TEST 5: A damaged header is always detected.
+    ( *header ).parameters[ 2 ] += 1;
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 3 , false ) );
+    ( *header ).parameters[ 2 ] -= 1;
+
+    // TEST 6: An image with the other byte order, or with no magic number, is rejected.
+    const u32 magic = ( *header ).magic;
+    ( *header ).magic = ( magic >> 24 ) | ( ( magic >> 8 ) & 0xFF00 ) | ( ( magic << 8 ) & 0xFF0000 ) | ( magic << 24 );
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 3 , false ) );
+    ( *header ).magic = 0;
+    EXPECT_EQ ( 0 , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 3 , false ) );
+    ( *header ).magic = magic;
+    EXPECT_EQ ( header , image_header_read ( "test_image_header" , image , TEST_IMAGE_SIZE , IMAGE_TYPE_ARRAY , 3 , true ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_image
+( void )
+{
+    test_register ( test_image_header , "Writing and validating the header of a data structure image." );
+}
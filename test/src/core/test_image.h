@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_image.h
+ * @brief Tests core/image.h
+ * (see test/test.h, core/image.h for additional details)
+ */
+#ifndef TEST_IMAGE_H
+#define TEST_IMAGE_H
+
+#include "test/test.h"
+
+#include "core/image.h"
+
+void
+test_register_image
+( void );
+
+#endif  // TEST_IMAGE_H
@@ -0,0 +1,459 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_job.c
+ * @brief Implementation of the core/test_job header.
+ * (see core/test_job.h for additional details)
+ */
+#include "core/test_job.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/fiber.h"
+#include "platform/platform.h"
+
+/** @brief Number of elements processed per stage by the dependency test. */
+#define TEST_JOB_STAGE_LENGTH 1000
+
+/** @brief Type definition for state shared by the jobs of the dependency test. */
+typedef struct
+{
+    u64 values[ TEST_JOB_STAGE_LENGTH ];
+    u64 errors;
+}
+stage_t;
+
+/** @brief Type definition for the arguments of a single dependency test job. */
+typedef struct
+{
+    stage_t*    stage;
+    u64         index;
+}
+stage_job_t;
+
+/**
+ * @brief Job: atomically increments a counter.
+ */
+void
+test_job_increment
+(   void* args
+)
+{
+    atomic_fetch_add_u64 ( ( u64* ) args , 1 , ATOMIC_RELAXED );
+}
+
+/**
+ * @brief Job: writes one element of the first stage.
+ */
+void
+test_job_stage_first
+(   void* args
+)
+{
+    stage_job_t* job = args;
+    ( *( *job ).stage ).values[ ( *job ).index ] = ( *job ).index;
+}
+
+/**
+ * @brief Job: verifies one element of the first stage, then doubles it.
+ */
+void
+test_job_stage_second
+(   void* args
+)
+{
+    stage_job_t* job = args;
+    stage_t* stage = ( *job ).stage;
+    if ( ( *stage ).values[ ( *job ).index ] != ( *job ).index )
+    {
+        atomic_fetch_add_u64 ( &( *stage ).errors , 1 , ATOMIC_RELAXED );
+    }
+    ( *stage ).values[ ( *job ).index ] *= 2;
+}
+
+/** @brief Type definition for the arguments of a fiber test job. */
+typedef struct
+{
+    job_counter_t*  gate;
+    u64*            value;
+}
+gate_job_t;
+
+/**
+ * @brief Job: waits on a counter, then atomically increments a value.
+ */
+void
+test_job_gate
+(   void* args
+)
+{
+    gate_job_t* job = args;
+    job_wait ( ( *job ).gate );
+    atomic_fetch_add_u64 ( ( *job ).value , 1 , ATOMIC_RELAXED );
+}
+
+/**
+ * @brief Job: yields several times, then atomically increments a counter.
+ */
+void
+test_job_yield
+(   void* args
+)
+{
+    for ( u64 i = 0; i < 8; ++i )
+    {
+        job_yield ();
+    }
+    atomic_fetch_add_u64 ( ( u64* ) args , 1 , ATOMIC_RELAXED );
+}
+
+/**
+ * @brief Job: submits a batch of nested jobs and waits on them.
+ */
+void
+test_job_nested
+(   void* args
+)
+{
+    job_t jobs[ 16 ];
+    for ( u64 i = 0; i < 16; ++i )
+    {
+        jobs[ i ].function = test_job_increment;
+        jobs[ i ].args = args;
+    }
+    job_counter_t counter = { 0 };
+    job_submit ( jobs , 16 , &counter );
+    job_wait ( &counter );
+}
+
+u8
+test_job_system_startup_and_shutdown
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u64 memory_requirement;
+    void* memory;
+    job_t job;
+    u64 value = 0;
+
+    job.function = test_job_increment;
+    job.args = &value;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Jobs cannot be submitted while the job system is not running.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( job_submit ( &job , 1 , 0 ) );
+    EXPECT_EQ ( 0 , job_system_worker_count () );
+
+    // TEST 2: job_system_startup with implicit memory allocation.
+    EXPECT ( job_system_startup ( 2 , &memory_requirement , 0 ) );
+    EXPECT ( job_system_startup ( 2 , 0 , 0 ) );
+    EXPECT_EQ ( 2 , job_system_worker_count () );
+    EXPECT_EQ ( job_amount_allocated + memory_requirement , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+
+    // TEST 3: job_system_startup fails if the job system is already running.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( job_system_startup ( 2 , 0 , 0 ) );
+
+    // TEST 4: job_system_shutdown stops every worker and frees all memory.
+    job_system_shutdown ();
+    EXPECT_EQ ( 0 , job_system_worker_count () );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: job_system_shutdown handles a job system which is not running.
+    job_system_shutdown ();
+
+    // TEST 6: job_system_startup with a pre-allocated buffer.
+    memory = memory_allocate_aligned ( memory_requirement , 64 , MEMORY_TAG_JOB );
+    EXPECT ( job_system_startup ( 2 , 0 , memory ) );
+    EXPECT_EQ ( 2 , job_system_worker_count () );
+    job_counter_t counter = { 0 };
+    EXPECT ( job_submit ( &job , 1 , &counter ) );
+    job_wait ( &counter );
+    EXPECT_EQ ( 0 , job_counter_value ( &counter ) );
+    EXPECT_EQ ( 1 , value );
+    job_system_shutdown ();
+    memory_free_aligned ( memory , memory_requirement , 64 , MEMORY_TAG_JOB );
+
+    // TEST 7: job_system_startup sizes the worker pool from the processor core count by default.
+    EXPECT ( job_system_startup ( 0 , 0 , 0 ) );
+    EXPECT_NEQ ( 0 , job_system_worker_count () );
+    job_system_shutdown ();
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_job_submit_and_wait
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    // More jobs than there are job slots, so that submission must help out.
+    const u64 job_count = 4 * JOB_CAPACITY;
+    job_t jobs[ 256 ];
+    job_counter_t counter = { 0 };
+    u64 value = 0;
+
+    EXPECT ( job_system_startup ( 4 , 0 , 0 ) );
+
+    for ( u64 i = 0; i < 256; ++i )
+    {
+        jobs[ i ].function = test_job_increment;
+        jobs[ i ].args = &value;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Every submitted job is executed exactly once.
+    for ( u64 i = 0; i < job_count; i += 256 )
+    {
+        EXPECT ( job_submit ( jobs , 256 , &counter ) );
+    }
+    job_wait ( &counter );
+    EXPECT_EQ ( 0 , job_counter_value ( &counter ) );
+    EXPECT_EQ ( job_count , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+
+    // TEST 2: A counter can be reused once it reaches zero.
+    value = 0;
+    EXPECT ( job_submit ( jobs , 256 , &counter ) );
+    job_wait ( &counter );
+    EXPECT_EQ ( 256 , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+
+    // TEST 3: Jobs may submit and wait on nested jobs from a worker thread.
+    value = 0;
+    for ( u64 i = 0; i < 256; ++i )
+    {
+        jobs[ i ].function = test_job_nested;
+    }
+    EXPECT ( job_submit ( jobs , 256 , &counter ) );
+    job_wait ( &counter );
+    EXPECT_EQ ( 256 * 16 , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+
+    // TEST 4: job_submit handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( job_submit ( 0 , 1 , &counter ) );
+    jobs[ 0 ].function = 0;
+    EXPECT_NOT ( job_submit ( jobs , 1 , &counter ) );
+    EXPECT_EQ ( 0 , job_counter_value ( &counter ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    job_system_shutdown ();
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_job_dependencies
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    stage_t* stage = memory_allocate ( sizeof ( stage_t ) , MEMORY_TAG_ARRAY );
+    stage_job_t* args = memory_allocate ( TEST_JOB_STAGE_LENGTH * sizeof ( stage_job_t ) , MEMORY_TAG_ARRAY );
+    job_t* first = memory_allocate ( TEST_JOB_STAGE_LENGTH * sizeof ( job_t ) , MEMORY_TAG_ARRAY );
+    job_t* second = memory_allocate ( TEST_JOB_STAGE_LENGTH * sizeof ( job_t ) , MEMORY_TAG_ARRAY );
+    job_counter_t first_counter = { 0 };
+    job_counter_t second_counter = { 0 };
+    u64 value = 0;
+    job_t last;
+
+    for ( u64 i = 0; i < TEST_JOB_STAGE_LENGTH; ++i )
+    {
+        args[ i ].stage = stage;
+        args[ i ].index = i;
+        first[ i ].function = test_job_stage_first;
+        first[ i ].args = &args[ i ];
+        second[ i ].function = test_job_stage_second;
+        second[ i ].args = &args[ i ];
+    }
+    last.function = test_job_increment;
+    last.args = &value;
+
+    EXPECT ( job_system_startup ( 4 , 0 , 0 ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 trial = 0; trial < 20; ++trial )
+    {
+        ( *stage ).errors = 0;
+        for ( u64 i = 0; i < TEST_JOB_STAGE_LENGTH; ++i )
+        {
+            ( *stage ).values[ i ] = ( u64 ) -1;
+        }
+
+        // TEST 1: A job chain executes each stage only after the previous one completes.
+        EXPECT ( job_submit ( first , TEST_JOB_STAGE_LENGTH , &first_counter ) );
+        EXPECT ( job_submit_after ( second , TEST_JOB_STAGE_LENGTH , &second_counter , &first_counter ) );
+        EXPECT ( job_submit_after ( &last , 1 , 0 , &second_counter ) );
+        job_wait ( &second_counter );
+        EXPECT_EQ ( 0 , job_counter_value ( &first_counter ) );
+        EXPECT_EQ ( 0 , ( *stage ).errors );
+        for ( u64 i = 0; i < TEST_JOB_STAGE_LENGTH; ++i )
+        {
+            EXPECT_EQ ( 2 * i , ( *stage ).values[ i ] );
+        }
+    }
+
+    // TEST 2: Jobs which depend on a completed counter run immediately.
+    job_counter_t counter = { 0 };
+    EXPECT ( job_submit_after ( &last , 1 , &counter , &first_counter ) );
+    job_wait ( &counter );
+
+    // TEST 3: Jobs without a counter still run once their dependency completes.
+    while ( atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) < 21 );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    job_system_shutdown ();
+
+    memory_free ( stage , sizeof ( stage_t ) , MEMORY_TAG_ARRAY );
+    memory_free ( args , TEST_JOB_STAGE_LENGTH * sizeof ( stage_job_t ) , MEMORY_TAG_ARRAY );
+    memory_free ( first , TEST_JOB_STAGE_LENGTH * sizeof ( job_t ) , MEMORY_TAG_ARRAY );
+    memory_free ( second , TEST_JOB_STAGE_LENGTH * sizeof ( job_t ) , MEMORY_TAG_ARRAY );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_job_fibers
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    job_t jobs[ 256 ];
+    job_counter_t gate = { 0 };
+    job_counter_t counter = { 0 };
+    u64 value = 0;
+    gate_job_t args = { &gate , &value };
+
+    EXPECT ( job_system_startup ( 4 , 0 , 0 ) );
+
+    for ( u64 i = 0; i < 256; ++i )
+    {
+        jobs[ i ].function = test_job_gate;
+        jobs[ i ].args = &args;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Fiber jobs which wait on a counter are suspended, so that many
+    //         more jobs than there are workers may wait at once.
+    job_counter_add ( &gate , 1 );
+    EXPECT ( job_submit_fiber ( jobs , 256 , &counter ) );
+    platform_sleep ( 10 );
+    EXPECT_EQ ( 0 , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+    EXPECT_EQ ( 256 , job_counter_value ( &counter ) );
+
+    // TEST 2: Suspended fiber jobs resume once the counter reaches zero.
+    job_counter_release ( &gate );
+    job_wait ( &counter );
+    EXPECT_EQ ( 256 , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+
+    // TEST 3: Fiber jobs which yield run to completion.
+    value = 0;
+    for ( u64 i = 0; i < 256; ++i )
+    {
+        jobs[ i ].function = test_job_yield;
+        jobs[ i ].args = &value;
+    }
+    EXPECT ( job_submit_fiber ( jobs , 256 , &counter ) );
+    job_wait ( &counter );
+    EXPECT_EQ ( 256 , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+
+    // TEST 4: Fiber jobs may submit and wait on nested jobs, and may depend on
+    //         a counter.
+    value = 0;
+    for ( u64 i = 0; i < 256; ++i )
+    {
+        jobs[ i ].function = test_job_nested;
+    }
+    job_counter_add ( &gate , 1 );
+    EXPECT ( job_submit_fiber_after ( jobs , 256 , &counter , &gate ) );
+    job_counter_release ( &gate );
+    job_wait ( &counter );
+    EXPECT_EQ ( 256 * 16 , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+
+    // TEST 5: job_yield returns when called outside of a fiber.
+    job_yield ();
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    job_system_shutdown ();
+    fiber_pool_trim ();
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_job
+( void )
+{
+    test_register_serial ( test_job_system_startup_and_shutdown , "Starting up or shutting down the job system." );
+    test_register_serial ( test_job_submit_and_wait , "Submitting jobs to the job system and waiting on their completion." );
+    test_register_serial ( test_job_dependencies , "Submitting chains of dependent jobs to the job system." );
+    test_register_serial ( test_job_fibers , "Submitting jobs which run on fibers to the job system." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_job.h
+ * @brief Tests core/job.h
+ * (see test/test.h, core/job.h for additional details)
+ */
+#ifndef TEST_JOB_H
+#define TEST_JOB_H
+
+#include "test/test.h"
+
+#include "core/job.h"
+
+void
+test_register_job
+( void );
+
+#endif  // TEST_JOB_H
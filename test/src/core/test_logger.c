@@ -0,0 +1,798 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_logger.c
+ * @brief Implementation of the core/test_logger header.
+ * (see core/test_logger.h for additional details)
+ */
+#include "core/test_logger.h"
+
+#include "test/expect.h"
+
+#include "container/array.h"
+#include "container/string.h"
+
+#include "core/assert.h"
+#include "core/memory.h"
+#include "core/string.h"
+
+#include "platform/thread.h"
+
+/** @brief Number of threads logging concurrently. */
+#define TEST_LOGGER_THREAD_COUNT 4
+
+/** @brief Number of messages logged by each thread. */
+#define TEST_LOGGER_MESSAGE_COUNT ( ( u64 ) 2000 )
+
+/**
+ * @brief Upper bound on the number of messages which may be discarded per run
+ * of test_logger_run_producers (thread_create logs one message per thread).
+ */
+#define TEST_LOGGER_DROP_LIMIT ( TEST_LOGGER_THREAD_COUNT * ( TEST_LOGGER_MESSAGE_COUNT + 1 ) )
+
+/** @brief Filepaths used by the binary log sink test. */
+#define TEST_LOGGER_BINARY_FILEPATH      "test/assets/out-logger-binary"
+#define TEST_LOGGER_BINARY_TEXT_FILEPATH "test/assets/out-logger-binary.txt"
+
+/** @brief Filepaths used by the per-thread log sink test. */
+#define TEST_LOGGER_SEGMENT_PREFIX        "test/assets/out-logger-segment"
+#define TEST_LOGGER_SEGMENT_TEXT_FILEPATH "test/assets/out-logger-segment.txt"
+
+/**
+ * @brief Log file written by the log file compression test. The test suite's
+ * log file is restarted (i.e. truncated) after it.
+ */
+#define TEST_LOGGER_COMPRESSED_FILEPATH "test/assets/out-logger-compressed"
+
+/** @brief Log file written by the test suite (see test/src/main.c). */
+#define TEST_LOGGER_FILEPATH "console.log"
+
+/**
+ * @brief Flush interval of the buffered console sink test (in milliseconds);
+ * long enough that output is never written out by the console thread while
+ * the test inspects it.
+ */
+#define TEST_LOGGER_CONSOLE_INTERVAL 60000
+
+/** @brief Ring buffer capacity used by the concurrent logging test (small, so it overflows). */
+#define TEST_LOGGER_ASYNC_CAPACITY 256
+
+/**
+ * @brief Thread: logs a batch of messages (to the log file only).
+ */
+u32
+test_logger_producer
+(   void* args
+)
+{
+    const u64 index = ( u64 ) args;
+    for ( u64 i = 0; i < TEST_LOGGER_MESSAGE_COUNT; ++i )
+    {
+        LOGSILENT ( "test_logger_producer: Thread %u, message %u of %u."
+                  , index , i + 1 , TEST_LOGGER_MESSAGE_COUNT
+                  );
+    }
+    return 0;
+}
+
+/**
+ * @brief Logs a batch of messages from several threads at once.
+ */
+u8
+test_logger_run_producers
+( void )
+{
+    thread_t threads[ TEST_LOGGER_THREAD_COUNT ];
+    for ( u64 i = 0; i < TEST_LOGGER_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_logger_producer , ( void* ) i , false , &threads[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_LOGGER_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+        thread_destroy ( &threads[ i ] );
+    }
+    return true;
+}
+
+/**
+ * @brief Counts how many times it has been called (to detect whether a log
+ * message's arguments were evaluated).
+ */
+u64
+test_logger_count_evaluation
+(   u64* count
+)
+{
+    *count += 1;
+    return *count;
+}
+
+u8
+test_logger_async_startup_and_shutdown
+( void )
+{
+    u64 global_amount_allocated;
+    u64 logger_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    logger_amount_allocated = memory_amount_allocated ( MEMORY_TAG_LOGGER );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u64 memory_requirement;
+    void* memory;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: logger_async_startup handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_async_startup ( 0 , LOG_OVERFLOW_BLOCK , 0 , 0 ) );
+    EXPECT_NOT ( logger_async_startup ( KiB ( 4 ) , LOG_OVERFLOW_POLICY_COUNT , 0 , 0 ) );
+
+    // TEST 2: logger_async_startup with implicit memory allocation.
+    EXPECT ( logger_async_startup ( KiB ( 4 ) , LOG_OVERFLOW_BLOCK , &memory_requirement , 0 ) );
+    EXPECT ( logger_async_startup ( KiB ( 4 ) , LOG_OVERFLOW_BLOCK , 0 , 0 ) );
+    EXPECT_EQ ( logger_amount_allocated + memory_requirement , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+    LOGINFO ( "test_logger_async_startup_and_shutdown: Logged asynchronously." );
+    logger_flush ();
+
+    // TEST 3: logger_async_startup fails if the asynchronous logger is already running.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_async_startup ( KiB ( 4 ) , LOG_OVERFLOW_BLOCK , 0 , 0 ) );
+
+    // TEST 4: logger_async_shutdown frees all memory.
+    logger_async_shutdown ();
+    EXPECT_EQ ( 0 , logger_dropped_count () );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: logger_async_shutdown and logger_flush handle an asynchronous logger which is not running.
+    logger_async_shutdown ();
+    logger_flush ();
+
+    // TEST 6: logger_async_startup with a pre-allocated buffer.
+    EXPECT ( logger_async_startup ( KiB ( 4 ) , LOG_OVERFLOW_DROP , &memory_requirement , 0 ) );
+    memory = memory_allocate_aligned ( memory_requirement , CACHE_LINE_SIZE , MEMORY_TAG_LOGGER );
+    EXPECT ( logger_async_startup ( KiB ( 4 ) , LOG_OVERFLOW_DROP , 0 , memory ) );
+    LOGINFO ( "test_logger_async_startup_and_shutdown: Logged asynchronously." );
+    logger_async_shutdown ();
+    memory_free_aligned ( memory , memory_requirement , CACHE_LINE_SIZE , MEMORY_TAG_LOGGER );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_logger_async_overflow
+( void )
+{
+    u64 global_amount_allocated;
+    u64 logger_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    logger_amount_allocated = memory_amount_allocated ( MEMORY_TAG_LOGGER );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    char message[ LOGGER_ASYNC_MESSAGE_MAX_LENGTH + 2 ];
+    memory_set ( message , '-' , sizeof ( message ) - 1 );
+    message[ sizeof ( message ) - 1 ] = 0;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: With LOG_OVERFLOW_BLOCK, no message is ever discarded.
+    EXPECT ( logger_async_startup ( TEST_LOGGER_ASYNC_CAPACITY , LOG_OVERFLOW_BLOCK , 0 , 0 ) );
+    EXPECT ( test_logger_run_producers () );
+    logger_flush ();
+    EXPECT_EQ ( 0 , logger_dropped_count () );
+
+    // TEST 2: Messages which are too long to queue are written synchronously.
+    LOGSILENT ( "%s" , message );
+    EXPECT_EQ ( 0 , logger_dropped_count () );
+    logger_async_shutdown ();
+
+    // TEST 3: With LOG_OVERFLOW_DROP or LOG_OVERFLOW_COUNT, messages may be discarded, but are always counted.
+    EXPECT ( logger_async_startup ( TEST_LOGGER_ASYNC_CAPACITY , LOG_OVERFLOW_DROP , 0 , 0 ) );
+    EXPECT ( test_logger_run_producers () );
+    logger_flush ();
+    EXPECT ( logger_dropped_count () <= TEST_LOGGER_DROP_LIMIT );
+    logger_async_shutdown ();
+    EXPECT ( logger_async_startup ( TEST_LOGGER_ASYNC_CAPACITY , LOG_OVERFLOW_COUNT , 0 , 0 ) );
+    EXPECT ( test_logger_run_producers () );
+    logger_flush ();
+    EXPECT ( logger_dropped_count () <= TEST_LOGGER_DROP_LIMIT );
+    logger_async_shutdown ();
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_logger_level
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const LOG_LEVEL level = logger_level_get ();
+    u64 count = 0;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Every elevation is compiled into this module, and logged by default.
+    EXPECT_EQ ( LOG_TRACE , level );
+    EXPECT ( LOG_COMPILED ( LOG_TRACE ) );
+    EXPECT ( logger_level_enabled ( LOG_TRACE ) );
+    LOGSILENT ( "test_logger_level: Logged with argument %u." , test_logger_count_evaluation ( &count ) );
+    EXPECT_EQ ( 1 , count );
+
+    // TEST 2: Messages less severe than the runtime threshold are discarded without evaluating their arguments.
+    logger_level_set ( LOG_WARN );
+    EXPECT_EQ ( LOG_WARN , logger_level_get () );
+    EXPECT ( logger_level_enabled ( LOG_WARN ) );
+    EXPECT_NOT ( logger_level_enabled ( LOG_INFO ) );
+    EXPECT_NOT ( logger_level_enabled ( LOG_TRACE ) );
+    LOGINFO ( "test_logger_level: Not logged (argument %u)." , test_logger_count_evaluation ( &count ) );
+    LOGDEBUG ( "test_logger_level: Not logged (argument %u)." , test_logger_count_evaluation ( &count ) );
+    LOGTRACE ( "test_logger_level: Not logged (argument %u)." , test_logger_count_evaluation ( &count ) );
+    EXPECT_EQ ( 1 , count );
+
+    // TEST 3: LOG_FATAL, LOG_ERROR and LOG_SILENT messages are never discarded at runtime.
+    logger_level_set ( LOG_FATAL );
+    EXPECT ( logger_level_enabled ( LOG_FATAL ) );
+    EXPECT ( logger_level_enabled ( LOG_ERROR ) );
+    EXPECT ( logger_level_enabled ( LOG_SILENT ) );
+    EXPECT_NOT ( logger_level_enabled ( LOG_WARN ) );
+    LOGSILENT ( "test_logger_level: Logged with argument %u." , test_logger_count_evaluation ( &count ) );
+    EXPECT_EQ ( 2 , count );
+
+    // TEST 4: logger_level_set rejects LOG_SILENT.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    logger_level_set ( LOG_SILENT );
+    EXPECT_EQ ( LOG_FATAL , logger_level_get () );
+
+    // TEST 5: Restoring the threshold logs everything again.
+    logger_level_set ( level );
+    LOGDEBUG ( "test_logger_level: Logged with argument %u." , test_logger_count_evaluation ( &count ) );
+    EXPECT_EQ ( 3 , count );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+/**
+ * @brief Tests whether a text file contains a string.
+ */
+bool
+test_logger_file_contains
+(   const char* filepath
+,   const char* find
+)
+{
+    file_t file;
+    if ( !file_open ( filepath , FILE_MODE_READ , &file ) )
+    {
+        return false;
+    }
+    u8* content;
+    u64 size;
+    const bool read = file_read_all ( &file , &content , &size );
+    file_close ( &file );
+    if ( !read )
+    {
+        return false;
+    }
+    u64 index;
+    const bool found = string_contains ( ( const char* ) content , size
+                                       , find , _string_length ( find )
+                                       , false
+                                       , &index
+                                       );
+    string_free ( content );
+    return found;
+}
+
+u8
+test_logger_binary
+( void )
+{
+    u64 global_amount_allocated;
+    u64 logger_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    logger_amount_allocated = memory_amount_allocated ( MEMORY_TAG_LOGGER );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const f64 value = 2.5;
+    const char* string = "string";
+    char* resizable = string_create_from ( "resizable" );
+    i8 array_in[ 3 ] = { -1 , 0 , 1 };
+    i8* array = array_create_from ( i8 , array_in , 3 );
+    u64 count = 0;
+    char* expected;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: logger_binary_startup and logger_binary_decode handle invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_binary_startup ( 0 , LOG_DEBUG ) );
+    EXPECT_NOT ( logger_binary_startup ( TEST_LOGGER_BINARY_FILEPATH , LOG_SILENT ) );
+    EXPECT_NOT ( logger_binary_decode ( 0 , TEST_LOGGER_BINARY_TEXT_FILEPATH ) );
+    EXPECT_NOT ( logger_binary_decode ( TEST_LOGGER_BINARY_FILEPATH , 0 ) );
+    EXPECT_NOT ( logger_binary_decode ( "test/assets/file-dne" , TEST_LOGGER_BINARY_TEXT_FILEPATH ) );
+    EXPECT_NOT ( logger_binary_decode ( "test/assets/in-file.txt" , TEST_LOGGER_BINARY_TEXT_FILEPATH ) );
+
+    // TEST 2: Messages at or below the sink's elevation are recorded without evaluating the format string.
+    EXPECT ( logger_binary_startup ( TEST_LOGGER_BINARY_FILEPATH , LOG_DEBUG ) );
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_binary_startup ( TEST_LOGGER_BINARY_FILEPATH , LOG_DEBUG ) );
+    for ( u64 i = 0; i < 3; ++i )
+    {
+        LOGDEBUG ( "test_logger_binary: Message %u: %s, %S, %.2F, %i, %c, [%s]."
+                 , i , string , resizable , &value , -7 , 'x' , 0
+                 );
+    }
+    LOGTRACE ( "test_logger_binary: Array: %ai." , array );
+    LOGSILENT ( "test_logger_binary: Argument %u." , test_logger_count_evaluation ( &count ) );
+    LOGINFO ( "test_logger_binary: Logged as usual." );
+    EXPECT_EQ ( 1 , count );
+    logger_flush ();
+    logger_binary_shutdown ();
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+
+    // TEST 3: logger_binary_decode renders every recorded message, and only those.
+    EXPECT ( logger_binary_decode ( TEST_LOGGER_BINARY_FILEPATH , TEST_LOGGER_BINARY_TEXT_FILEPATH ) );
+    for ( u64 i = 0; i < 3; ++i )
+    {
+        expected = string_format ( "#%u\t[DEBUG]\ttest_logger_binary: Message %u: string, resizable, 2.50, -7, x, [].\n"
+                                 , platform_thread_id () , i
+                                 );
+        EXPECT ( test_logger_file_contains ( TEST_LOGGER_BINARY_TEXT_FILEPATH , expected ) );
+        string_destroy ( expected );
+    }
+    expected = string_format ( "[TRACE]\ttest_logger_binary: Array: %ai.\n" , array );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_BINARY_TEXT_FILEPATH , expected ) );
+    string_destroy ( expected );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_BINARY_TEXT_FILEPATH , "test_logger_binary: Argument 1.\n" ) );
+    EXPECT_NOT ( test_logger_file_contains ( TEST_LOGGER_BINARY_TEXT_FILEPATH , "test_logger_binary: Logged as usual." ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    string_destroy ( resizable );
+    array_destroy ( array );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+/**
+ * @brief Tests whether each line of a text file rendered from a binary log
+ * begins with a timestamp no earlier than that of the line before it, and
+ * counts the lines.
+ */
+bool
+test_logger_file_ordered
+(   const char* filepath
+,   u64*        line_count
+)
+{
+    file_t file;
+    if ( !file_open ( filepath , FILE_MODE_READ , &file ) )
+    {
+        return false;
+    }
+    u8* content;
+    u64 size;
+    const bool read = file_read_all ( &file , &content , &size );
+    file_close ( &file );
+    if ( !read )
+    {
+        return false;
+    }
+    bool ordered = true;
+    f64 previous = 0;
+    *line_count = 0;
+    for ( u64 i = 0; ordered && i < size; )
+    {
+        f64 timestamp;
+        u64 timestamp_length;
+        ordered = string_to_f64 ( ( const char* ) content + i
+                                , size - i
+                                , &timestamp
+                                , &timestamp_length
+                                ) == STRING_PARSE_SUCCESS
+               && timestamp >= previous
+               ;
+        previous = timestamp;
+        *line_count += 1;
+        while ( i < size && content[ i ] != '\n' )
+        {
+            i += 1;
+        }
+        i += 1;
+    }
+    string_free ( content );
+    return ordered;
+}
+
+u8
+test_logger_segment
+( void )
+{
+    u64 global_amount_allocated;
+    u64 logger_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    logger_amount_allocated = memory_amount_allocated ( MEMORY_TAG_LOGGER );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u64 line_count;
+    char* expected;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: logger_segment_startup and logger_segment_merge handle invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_segment_startup ( 0 , LOG_DEBUG ) );
+    EXPECT_NOT ( logger_segment_startup ( TEST_LOGGER_SEGMENT_PREFIX , LOG_SILENT ) );
+    EXPECT_NOT ( logger_segment_merge ( 0 , TEST_LOGGER_SEGMENT_TEXT_FILEPATH ) );
+    EXPECT_NOT ( logger_segment_merge ( TEST_LOGGER_SEGMENT_PREFIX , 0 ) );
+    EXPECT_NOT ( logger_segment_merge ( "test/assets/file-dne" , TEST_LOGGER_SEGMENT_TEXT_FILEPATH ) );
+
+    // TEST 2: Each thread records its messages into a segment of its own.
+    EXPECT ( logger_segment_startup ( TEST_LOGGER_SEGMENT_PREFIX , LOG_DEBUG ) );
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_segment_startup ( TEST_LOGGER_SEGMENT_PREFIX , LOG_DEBUG ) );
+    EXPECT_NOT ( logger_binary_startup ( TEST_LOGGER_BINARY_FILEPATH , LOG_DEBUG ) );
+    LOGDEBUG ( "test_logger_segment: Before." );
+    EXPECT ( test_logger_run_producers () );
+    LOGDEBUG ( "test_logger_segment: After." );
+    LOGINFO ( "test_logger_segment: Logged as usual." );
+    logger_flush ();
+    logger_segment_shutdown ();
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+
+    // TEST 3: Each segment is an ordinary binary log file; the first belongs to the first thread to log.
+    EXPECT ( logger_binary_decode ( TEST_LOGGER_SEGMENT_PREFIX ".0" , TEST_LOGGER_SEGMENT_TEXT_FILEPATH ) );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , "test_logger_segment: Before.\n" ) );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , "test_logger_segment: After.\n" ) );
+    EXPECT_NOT ( test_logger_file_contains ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , "test_logger_producer:" ) );
+
+    // TEST 4: logger_segment_merge renders every recorded message of every thread, in order of their timestamps.
+    EXPECT ( logger_segment_merge ( TEST_LOGGER_SEGMENT_PREFIX , TEST_LOGGER_SEGMENT_TEXT_FILEPATH ) );
+    EXPECT ( test_logger_file_ordered ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , &line_count ) );
+    EXPECT ( line_count >= TEST_LOGGER_THREAD_COUNT * TEST_LOGGER_MESSAGE_COUNT + 2 );
+    for ( u64 i = 0; i < TEST_LOGGER_THREAD_COUNT; ++i )
+    {
+        expected = string_format ( "test_logger_producer: Thread %u, message %u of %u.\n"
+                                 , i , TEST_LOGGER_MESSAGE_COUNT , TEST_LOGGER_MESSAGE_COUNT
+                                 );
+        EXPECT ( test_logger_file_contains ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , expected ) );
+        string_destroy ( expected );
+    }
+    EXPECT_NOT ( test_logger_file_contains ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , "test_logger_segment: Logged as usual." ) );
+
+    // TEST 5: Segments of a previous run are not merged with those of the next.
+    EXPECT ( logger_segment_startup ( TEST_LOGGER_SEGMENT_PREFIX , LOG_DEBUG ) );
+    LOGDEBUG ( "test_logger_segment: Second run." );
+    logger_segment_shutdown ();
+    EXPECT ( logger_segment_merge ( TEST_LOGGER_SEGMENT_PREFIX , TEST_LOGGER_SEGMENT_TEXT_FILEPATH ) );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , "test_logger_segment: Second run.\n" ) );
+    EXPECT_NOT ( test_logger_file_contains ( TEST_LOGGER_SEGMENT_TEXT_FILEPATH , "test_logger_producer:" ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_logger_console
+( void )
+{
+    u64 global_amount_allocated;
+    u64 logger_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    logger_amount_allocated = memory_amount_allocated ( MEMORY_TAG_LOGGER );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    static const char buffered[] = "test_logger_console: Buffered until the line ends, ";
+    file_t file;
+    file_stdout ( &file );
+    const bool terminal = file_terminal ( &file );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: logger_console_startup handles invalid arguments.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_console_startup ( 0 ) );
+    EXPECT_EQ ( 0 , logger_console_pending () );
+
+    // TEST 2: logger_console_startup fails if the buffered console sink is already open.
+    EXPECT ( logger_console_startup ( TEST_LOGGER_CONSOLE_INTERVAL ) );
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_console_startup ( TEST_LOGGER_CONSOLE_INTERVAL ) );
+    logger_flush ();
+    EXPECT_EQ ( 0 , logger_console_pending () );
+
+    // TEST 3: Console output is buffered; a terminal receives it once the line ends.
+    PRINT ( buffered );
+    EXPECT_EQ ( 2 * ( sizeof ( ANSI_CC_RESET ) - 1 ) + sizeof ( buffered ) - 1 , logger_console_pending () );
+    PRINT ( "and no sooner.\n" );
+    if ( !terminal )
+    {
+        EXPECT_EQ ( 4 * ( sizeof ( ANSI_CC_RESET ) - 1 ) + sizeof ( buffered ) - 1 + _string_length ( "and no sooner.\n" )
+                  , logger_console_pending ()
+                  );
+    }
+
+    // TEST 4: logger_flush writes out the buffered output, including output of the asynchronous logger.
+    EXPECT ( logger_async_startup ( KiB ( 4 ) , LOG_OVERFLOW_BLOCK , 0 , 0 ) );
+    LOGINFO ( "test_logger_console: Logged asynchronously." );
+    logger_flush ();
+    EXPECT_EQ ( 0 , logger_console_pending () );
+    logger_async_shutdown ();
+    EXPECT_EQ ( 0 , logger_console_pending () );
+
+    // TEST 5: Buffered output is written out ahead of a fatal message.
+    LOGWARN ( "The following fatal error is intentionally triggered by a test:" );
+    logger_flush ();
+    PRINT ( "test_logger_console: Written ahead of a fatal message. " );
+    EXPECT_NEQ ( 0 , logger_console_pending () );
+    LOGFATAL ( "test_logger_console: Fatal." );
+    EXPECT_EQ ( 0 , logger_console_pending () );
+
+    // TEST 6: Buffered output is written out once the flush interval has passed.
+    logger_console_shutdown ();
+    EXPECT ( logger_console_startup ( 10 ) );
+    LOGINFO ( "test_logger_console: Written once the flush interval has passed." );
+    for ( u64 i = 0; i < 500 && logger_console_pending (); ++i )
+    {
+        platform_sleep ( 10 );
+    }
+    EXPECT_EQ ( 0 , logger_console_pending () );
+
+    // TEST 7: logger_console_shutdown writes out the buffered output and frees all memory.
+    PRINT ( "test_logger_console: Written at shutdown.\n" );
+    logger_console_shutdown ();
+    EXPECT_EQ ( 0 , logger_console_pending () );
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+
+    // TEST 8: logger_console_shutdown and logger_flush handle a buffered console sink which is not open.
+    logger_console_shutdown ();
+    logger_flush ();
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_logger_fatal
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    char* long_message = string_create_from ( "test_logger_fatal: " );
+    char* expected;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: file_write_raw handles invalid arguments.
+    file_t file;
+    memory_clear ( &file , sizeof ( file_t ) );
+    EXPECT_NOT ( file_write_raw ( 0 , 1 , "x" ) );
+    EXPECT_NOT ( file_write_raw ( &file , 1 , "x" ) );
+    file_stderr ( &file );
+    EXPECT_NOT ( file_write_raw ( &file , 1 , 0 ) );
+    EXPECT ( file_write_raw ( &file , 0 , 0 ) );
+
+    LOGWARN ( "The following fatal errors are intentionally triggered by a test:" );
+
+    // TEST 2: LOGFATAL formats and writes the message to the log file without allocating memory.
+    u64 allocation_count = MEMORY_ALLOCATION_COUNT;
+    LOGFATAL ( "test_logger_fatal: Formatted %i, %s." , -7 , "string" );
+    EXPECT_EQ ( allocation_count , MEMORY_ALLOCATION_COUNT );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_FILEPATH , "[FATAL]\ttest_logger_fatal: Formatted -7, string.\n" ) );
+
+    // TEST 3: logger_fatal writes the message as-is, removing ANSI escape sequences from the log file form.
+    allocation_count = MEMORY_ALLOCATION_COUNT;
+    _logger_fatal ( "test_logger_fatal: "ANSI_CC ( ANSI_CC_FG_RED )"Not formatted %i."ANSI_CC_RESET );
+    EXPECT_EQ ( allocation_count , MEMORY_ALLOCATION_COUNT );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_FILEPATH , "[FATAL]\ttest_logger_fatal: Not formatted %i.\n" ) );
+
+    // TEST 4: assertf reports the failed assertion without allocating memory.
+    allocation_count = MEMORY_ALLOCATION_COUNT;
+    assertf ( "test_logger_fatal" , "Message." , "test_logger.c" , 7 );
+    EXPECT_EQ ( allocation_count , MEMORY_ALLOCATION_COUNT );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_FILEPATH , "[FATAL]\tAssertion failure in file test_logger.c (line 7): test_logger_fatal\n\tMessage: Message.\n" ) );
+
+    // TEST 5: Messages longer than LOGGER_FATAL_MESSAGE_MAX_LENGTH are truncated.
+    while ( string_length ( long_message ) < LOGGER_FATAL_MESSAGE_MAX_LENGTH + 100 )
+    {
+        _string_push ( long_message , "x" );
+    }
+    logger_fatal ( long_message , string_length ( long_message ) );
+    expected = string_copy ( long_message );
+    string_remove ( expected , LOGGER_FATAL_MESSAGE_MAX_LENGTH , 100 );
+    _string_push ( expected , "\n" );
+    EXPECT ( test_logger_file_contains ( TEST_LOGGER_FILEPATH , expected ) );
+    string_destroy ( expected );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    string_destroy ( long_message );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_logger_compress
+( void )
+{
+    u64 global_amount_allocated;
+    u64 logger_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    logger_amount_allocated = memory_amount_allocated ( MEMORY_TAG_LOGGER );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 message_count = 1000;
+    file_t file;
+    file_reader_t reader;
+    const char* line;
+    u64 length;
+    char* expected;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: logger_compress fails once the log file has been written to.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_compress () );
+
+    // Restart the logger on a new log file.
+    logger_shutdown ();
+    EXPECT ( logger_startup ( TEST_LOGGER_COMPRESSED_FILEPATH , 0 , 0 ) );
+    EXPECT ( logger_compress () );
+
+    // TEST 2: logger_compress fails if compression is already enabled.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( logger_compress () );
+
+    // TEST 3: Messages logged synchronously, asynchronously and fatally are all written to the compressed log file.
+    LOGINFO ( "test_logger_compress: Logged synchronously." );
+    EXPECT ( logger_async_startup ( KiB ( 64 ) , LOG_OVERFLOW_BLOCK , 0 , 0 ) );
+    for ( u64 i = 0; i < message_count; ++i )
+    {
+        LOGINFO ( "test_logger_compress: Message %u." , i );
+    }
+    LOGWARN ( "The following fatal error is intentionally triggered by a test:" );
+    LOGFATAL ( "test_logger_compress: Fatal." );
+    logger_async_shutdown ();
+    logger_shutdown ();
+    EXPECT ( logger_startup ( TEST_LOGGER_FILEPATH , 0 , 0 ) );
+
+    // TEST 4: The compressed log file reads back in order, and is smaller than its content.
+    EXPECT ( file_open ( TEST_LOGGER_COMPRESSED_FILEPATH , FILE_MODE_READ , &file ) );
+    EXPECT ( file_reader_create_compressed ( &file , &reader ) );
+    u64 next = 0;
+    u64 content_size = 0;
+    bool fatal = false;
+    while ( file_reader_next_line ( &reader , &line , &length ) )
+    {
+        content_size += length + 1;
+        if ( length == _string_length ( "[FATAL]\ttest_logger_compress: Fatal." )
+          && memory_equal ( line , "[FATAL]\ttest_logger_compress: Fatal." , length )
+           )
+        {
+            fatal = true;
+        }
+        else if ( next < message_count )
+        {
+            expected = string_format ( "[INFO]\ttest_logger_compress: Message %u." , next );
+            if ( length == string_length ( expected ) && memory_equal ( line , expected , length ) )
+            {
+                next += 1;
+            }
+            string_destroy ( expected );
+        }
+    }
+    EXPECT_EQ ( message_count , next );
+    EXPECT ( fatal );
+    EXPECT ( file_size ( &file ) < content_size / 2 );
+    file_reader_destroy ( &reader );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( logger_amount_allocated , memory_amount_allocated ( MEMORY_TAG_LOGGER ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_logger
+( void )
+{
+    test_register_serial ( test_logger_async_startup_and_shutdown , "Starting up or shutting down the asynchronous logger." );
+    test_register_serial ( test_logger_async_overflow , "Logging concurrently through the asynchronous logger with each overflow policy." );
+    test_register_serial ( test_logger_level , "Filtering log messages by elevation." );
+    test_register_serial ( test_logger_binary , "Recording log messages into a binary log file, then decoding it." );
+    test_register_serial ( test_logger_segment , "Recording log messages into per-thread log segments, then merging them." );
+    test_register_serial ( test_logger_console , "Buffering console output, then writing it out." );
+    test_register_serial ( test_logger_fatal , "Writing fatal messages without allocating memory or taking a lock." );
+    test_register_serial ( test_logger_compress , "Compressing the log file, then reading it back." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_logger.h
+ * @brief Tests core/logger.h
+ * (see test/test.h, core/logger.h for additional details)
+ */
+#ifndef TEST_LOGGER_H
+#define TEST_LOGGER_H
+
+#include "test/test.h"
+
+#include "core/logger.h"
+
+void
+test_register_logger
+( void );
+
+#endif  // TEST_LOGGER_H
@@ -0,0 +1,480 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_memory.c
+ * @brief Implementation of the core/test_memory header.
+ * (see core/test_memory.h for additional details)
+ */
+#include "core/test_memory.h"
+
+#include "test/expect.h"
+
+#include "container/string.h"
+
+#include "platform/thread.h"
+
+u8
+test_memory_large_allocation
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 size = MEMORY_LARGE_ALLOCATION_THRESHOLD + 123;
+    u8* memory;
+    u8* memory_;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: memory_allocate serves a large allocation, and records it.
+    memory = memory_allocate ( size , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    EXPECT_EQ ( global_amount_allocated + size , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated + size , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: A large allocation is page-aligned, reads as zero, and is writable throughout.
+    EXPECT_EQ ( 0 , ( ( u64 ) memory ) % KiB ( 4 ) );
+    for ( u64 i = 0; i < size; i += KiB ( 4 ) )
+    {
+        EXPECT_EQ ( 0 , memory[ i ] );
+        memory[ i ] = ( u8 )( i >> 12 );
+    }
+    EXPECT_EQ ( 0 , memory[ size - 1 ] );
+    memory[ size - 1 ] = 0xFF;
+
+    // TEST 3: memory_free releases a large allocation, and records it.
+    memory_free ( memory , size , MEMORY_TAG_ARRAY );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 4: memory_allocate_aligned serves a large allocation with an alignment up to the page size.
+    memory = memory_allocate_aligned ( size , 256 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    EXPECT_EQ ( 0 , ( ( u64 ) memory ) % 256 );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    memory_free_aligned ( memory , size , 256 , MEMORY_TAG_ARRAY );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: memory_reallocate moves a block across the threshold in both directions, preserving its content.
+    memory = memory_allocate ( 1000 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        memory[ i ] = ( u8 ) i;
+    }
+    memory_ = memory_reallocate ( memory , 1000 , size , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory_ );
+    EXPECT_EQ ( array_amount_allocated + size , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        EXPECT_EQ ( ( u8 ) i , memory_[ i ] );
+    }
+    for ( u64 i = 1000; i < size; ++i )
+    {
+        EXPECT_EQ ( 0 , memory_[ i ] );
+    }
+    memory = memory_reallocate ( memory_ , size , 500 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    EXPECT_EQ ( array_amount_allocated + 500 , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    for ( u64 i = 0; i < 500; ++i )
+    {
+        EXPECT_EQ ( ( u8 ) i , memory[ i ] );
+    }
+    memory_free ( memory , 500 , MEMORY_TAG_ARRAY );
+
+    // TEST 6: Allocations which span many commit granules of the global allocator are usable throughout.
+    memory = memory_allocate_aligned ( MEMORY_LARGE_ALLOCATION_THRESHOLD - 1 , 8 * KiB ( 1 ) , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    for ( u64 i = 0; i < MEMORY_LARGE_ALLOCATION_THRESHOLD - 1; i += KiB ( 4 ) )
+    {
+        EXPECT_EQ ( 0 , memory[ i ] );
+    }
+    memory_free_aligned ( memory , MEMORY_LARGE_ALLOCATION_THRESHOLD - 1 , 8 * KiB ( 1 ) , MEMORY_TAG_ARRAY );
+
+    // TEST 7: memory_reallocate fails without modifying or freeing the block if the new block cannot be allocated.
+    memory = memory_allocate ( 1000 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        memory[ i ] = ( u8 ) i;
+    }
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , memory_reallocate ( memory , 1000 , ( ( u64 ) 1 ) << 62 , MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( array_amount_allocated + 1000 , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    for ( u64 i = 0; i < 1000; ++i )
+    {
+        EXPECT_EQ ( ( u8 ) i , memory[ i ] );
+    }
+    memory_free ( memory , 1000 , MEMORY_TAG_ARRAY );
+
+    // TEST 8: Global allocator state is restored.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_memory_uninit
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u8* memory;
+    u8* memory_;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: memory_allocate_uninit allocates a writable block, and records it.
+    memory = memory_allocate_uninit ( 300 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    EXPECT_EQ ( global_amount_allocated + 300 , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated + 300 , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    memory_set ( memory , 0xAB , 300 );
+    memory_free ( memory , 300 , MEMORY_TAG_ARRAY );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: memory_allocate still clears a block which was previously written (and likely reused).
+    memory = memory_allocate ( 300 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    for ( u64 i = 0; i < 300; ++i )
+    {
+        EXPECT_EQ ( 0 , memory[ i ] );
+    }
+    memory_set ( memory , 0xCD , 300 );
+    memory_free ( memory , 300 , MEMORY_TAG_ARRAY );
+
+    // TEST 3: memory_allocate_aligned_uninit respects the alignment.
+    memory = memory_allocate_aligned_uninit ( 300 , 64 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    EXPECT_EQ ( 0 , ( ( u64 ) memory ) % 64 );
+    memory_free_aligned ( memory , 300 , 64 , MEMORY_TAG_ARRAY );
+
+    // TEST 4: memory_reallocate clears every byte beyond the old size when it moves a block, even into written memory.
+    memory = memory_allocate ( 100 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory );
+    memory_set ( memory , 0x11 , 100 );
+    memory_ = memory_reallocate ( memory , 100 , 300 , MEMORY_TAG_ARRAY );
+    EXPECT_NEQ ( 0 , memory_ );
+    for ( u64 i = 0; i < 100; ++i )
+    {
+        EXPECT_EQ ( 0x11 , memory_[ i ] );
+    }
+    for ( u64 i = 100; i < 300; ++i )
+    {
+        EXPECT_EQ ( 0 , memory_[ i ] );
+    }
+    memory_free ( memory_ , 300 , MEMORY_TAG_ARRAY );
+
+    // TEST 5: Global allocator state is restored.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_memory_copy_set_and_equal
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u8 src[ 64 ];
+    u8 dst[ 64 ];
+    u8 buffer[ 64 ];
+    for ( u64 i = 0; i < 64; ++i )
+    {
+        src[ i ] = ( u8 )( i * 7 + 1 );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: memory_copy and memory_set write exactly size bytes, for every small and medium size.
+    for ( u64 size = 0; size <= 40; ++size )
+    {
+        memory_set ( dst , 0xEE , 64 );
+        memory_copy ( dst + 1 , src , size );
+        EXPECT_EQ ( 0xEE , dst[ 0 ] );
+        EXPECT ( memory_equal ( dst + 1 , src , size ) );
+        for ( u64 i = size + 1; i < 64; ++i )
+        {
+            EXPECT_EQ ( 0xEE , dst[ i ] );
+        }
+        memory_set ( dst + 1 , 0x5A , size );
+        EXPECT_EQ ( 0xEE , dst[ 0 ] );
+        for ( u64 i = 1; i < 64; ++i )
+        {
+            EXPECT_EQ ( ( i <= size ) ? 0x5A : 0xEE , dst[ i ] );
+        }
+    }
+
+    // TEST 2: memory_copy, memory_set and memory_clear with sizes known at compile time.
+    memory_clear ( dst , 64 );
+    memory_copy ( dst , src , 3 );
+    memory_copy ( dst + 3 , src + 3 , 8 );
+    memory_copy ( dst + 11 , src + 11 , 13 );
+    memory_copy ( dst + 24 , src + 24 , 16 );
+    EXPECT ( memory_equal ( dst , src , 40 ) );
+    EXPECT_EQ ( 0 , dst[ 40 ] );
+    memory_set ( dst , 0x77 , 5 );
+    memory_clear ( dst + 5 , 2 );
+    EXPECT_EQ ( 0x77 , dst[ 4 ] );
+    EXPECT_EQ ( 0 , dst[ 6 ] );
+    EXPECT_EQ ( src[ 7 ] , dst[ 7 ] );
+
+    // TEST 3: memory_equal detects a difference at any position, for every small and medium size.
+    for ( u64 size = 1; size <= 40; ++size )
+    {
+        memory_copy ( dst , src , size );
+        EXPECT ( memory_equal ( dst , src , size ) );
+        for ( u64 i = 0; i < size; ++i )
+        {
+            dst[ i ] ^= 0x10;
+            EXPECT_NOT ( memory_equal ( dst , src , size ) );
+            EXPECT_NOT ( memory_equal ( src , dst , size ) );
+            dst[ i ] ^= 0x10;
+        }
+    }
+    EXPECT ( memory_equal ( dst , buffer , 0 ) );
+    EXPECT ( memory_equal ( "abcd" , "abcd" , 4 ) );
+    EXPECT_NOT ( memory_equal ( "abcd" , "abce" , 4 ) );
+
+    // TEST 4: memory_move handles overlapping blocks in either direction.
+    for ( u64 size = 1; size <= 40; ++size )
+    {
+        memory_copy ( buffer , src , 64 );
+        memory_move ( buffer + 3 , buffer , size );
+        EXPECT ( memory_equal ( buffer + 3 , src , size ) );
+        memory_copy ( buffer , src , 64 );
+        memory_move ( buffer , buffer + 3 , size );
+        EXPECT ( memory_equal ( buffer , src + 3 , size ) );
+    }
+
+    // TEST 5: memory_copy is exact for blocks beyond MEMORY_STREAM_THRESHOLD, including a misaligned head and a partial tail.
+    const u64 size = MEMORY_STREAM_THRESHOLD + 77;
+    u8* large_src = memory_allocate_uninit ( size + 3 , MEMORY_TAG_ARRAY );
+    u8* large_dst = memory_allocate ( size + 6 , MEMORY_TAG_ARRAY );
+    for ( u64 i = 0; i < size + 3; ++i )
+    {
+        large_src[ i ] = ( u8 )( i ^ ( i >> 8 ) );
+    }
+    memory_copy ( large_dst + 3 , large_src + 3 , size );
+    EXPECT ( memory_equal ( large_dst + 3 , large_src + 3 , size ) );
+    EXPECT_EQ ( 0 , large_dst[ 2 ] );
+    EXPECT_EQ ( 0 , large_dst[ size + 3 ] );
+    memory_free ( large_src , size + 3 , MEMORY_TAG_ARRAY );
+    memory_free ( large_dst , size + 6 , MEMORY_TAG_ARRAY );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_memory_node
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    void* blocks[ 16 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: There is at least one heap, and no more than one per NUMA node.
+    EXPECT ( memory_node_count () >= 1 );
+    EXPECT ( memory_node_count () <= thread_numa_node_count () );
+    EXPECT ( thread_numa_node () < thread_numa_node_count () );
+
+    // TEST 2: Blocks allocated from any node's heap can be freed from another.
+    for ( u32 i = 0; i < 16; ++i )
+    {
+        memory_thread_node_set ( i );
+        blocks[ i ] = memory_allocate ( ( i % 2 ) ? 64 : 4096 , MEMORY_TAG_ARRAY );
+        EXPECT_NEQ ( 0 , blocks[ i ] );
+    }
+    memory_thread_node_set ( thread_numa_node () );
+    for ( u32 i = 0; i < 16; ++i )
+    {
+        memory_free ( blocks[ i ] , ( i % 2 ) ? 64 : 4096 , MEMORY_TAG_ARRAY );
+    }
+    memory_thread_cache_flush ();
+
+    // TEST 3: thread_affinity_set_node rejects a node which does not exist.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( thread_affinity_set_node ( thread_numa_node_count () ) );
+
+    // TEST 4: Global allocator state is restored.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_memory_profile
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    void* blocks[ 100 ];
+    char* stat;
+    u64 index;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: memory_stat includes the allocation profile if (and only if) it is enabled.
+    for ( u32 i = 0; i < 100; ++i )
+    {
+        blocks[ i ] = memory_allocate ( 48 , MEMORY_TAG_ARRAY );
+    }
+    blocks[ 0 ] = memory_reallocate ( blocks[ 0 ] , 48 , 4000 , MEMORY_TAG_ARRAY );
+    stat = memory_stat ();
+    EXPECT_NEQ ( 0 , stat );
+    EXPECT ( _string_contains ( stat , "System memory usage:" , false , &index ) );
+    EXPECT_EQ ( MEMORY_PROFILE_ENABLED == 1 , _string_contains ( stat , "Allocation profile:" , false , &index ) );
+
+#if MEMORY_PROFILE_ENABLED == 1
+    // TEST 2: The allocation profile attributes allocations to their call sites.
+    EXPECT ( _string_contains ( stat , "test_memory.c:" , false , &index ) );
+    EXPECT ( _string_contains ( stat , ": 100 allocations" , false , &index ) );
+
+    // TEST 3: The allocation profile includes a size histogram.
+    EXPECT ( _string_contains ( stat , "[ 2^5 , 2^6 ): " , false , &index ) );
+    EXPECT ( _string_contains ( stat , "[ 2^11 , 2^12 ): " , false , &index ) );
+#endif
+
+    string_destroy ( stat );
+    memory_free ( blocks[ 0 ] , 4000 , MEMORY_TAG_ARRAY );
+    for ( u32 i = 1; i < 100; ++i )
+    {
+        memory_free ( blocks[ i ] , 48 , MEMORY_TAG_ARRAY );
+    }
+
+    // TEST 4: Global allocator state is restored.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_memory_stat_scope
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    memory_stat_scope_t scope;
+    memory_stat_scope_t* previous;
+    void* block;
+    void* block_;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A scope starts empty, and records only allocations made while it is set.
+    block_ = memory_allocate ( 64 , MEMORY_TAG_ARRAY );
+    memory_clear ( &scope , sizeof ( memory_stat_scope_t ) );
+    previous = memory_stat_scope_set ( &scope );
+    EXPECT_EQ ( 0 , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( 0 , MEMORY_ALLOCATION_COUNT );
+    block = memory_allocate ( 100 , MEMORY_TAG_STRING );
+    EXPECT_EQ ( 100 , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( 100 , memory_amount_allocated ( MEMORY_TAG_STRING ) );
+    EXPECT_EQ ( 0 , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( 1 , MEMORY_ALLOCATION_COUNT );
+    memory_free ( block , 100 , MEMORY_TAG_STRING );
+    EXPECT_EQ ( 0 , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( 0 , MEMORY_ALLOCATION_COUNT );
+    EXPECT_EQ ( 1 , memory_free_count () );
+
+    // TEST 2: Unsetting a scope restores the previous statistics, which include the scoped ones.
+    EXPECT_EQ ( &scope , memory_stat_scope_set ( previous ) );
+    EXPECT_EQ ( global_amount_allocated + 64 , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    memory_free ( block_ , 64 , MEMORY_TAG_ARRAY );
+
+    // TEST 3: Global allocator state is restored.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_memory
+( void )
+{
+    test_register ( test_memory_large_allocation , "Testing large allocations served by virtual memory." );
+    test_register ( test_memory_uninit , "Testing allocations which are not cleared." );
+    test_register ( test_memory_copy_set_and_equal , "Testing memory 'copy', 'move', 'set' and 'equal' operations at every small size." );
+    test_register_serial ( test_memory_node , "Testing per-NUMA-node heaps." );
+    test_register ( test_memory_profile , "Testing the allocation profiler." );
+    test_register ( test_memory_stat_scope , "Testing memory statistics scopes." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_memory.h
+ * @brief Tests core/memory.h
+ * (see test/test.h, core/memory.h for additional details)
+ */
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "test/test.h"
+
+#include "core/memory.h"
+
+void
+test_register_memory
+( void );
+
+#endif  // TEST_MEMORY_H
@@ -0,0 +1,357 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_metrics.c
+ * @brief Implementation of the core/test_metrics header.
+ * (see core/test_metrics.h for additional details)
+ */
+#include "core/test_metrics.h"
+
+#include "test/expect.h"
+
+#include "container/string.h"
+
+#include "core/job.h"
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/string.h"
+
+#include "platform/filesystem.h"
+
+/** @brief File read by the built-in metrics test. */
+#define TEST_METRICS_IN_FILE "test/assets/in-file.txt"
+
+/** @brief File written by the built-in metrics test. */
+#define TEST_METRICS_OUT_FILE "test/assets/out-metrics"
+
+/** @brief Number of jobs submitted by the built-in metrics test. */
+#define TEST_METRICS_JOB_COUNT 1000
+
+/**
+ * @brief Job: adds one to a counter.
+ */
+void
+test_metrics_increment
+(   void* args
+)
+{
+    metrics_counter_add ( *( ( metric_t* ) args ) , 1 );
+}
+
+u8
+test_metrics_startup_and_shutdown
+( void )
+{
+    u64 global_amount_allocated;
+    u64 metrics_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    metrics_amount_allocated = memory_amount_allocated ( MEMORY_TAG_METRICS );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    u64 memory_requirement;
+    void* memory;
+    metric_t metric;
+    metrics_value_t values[ METRICS_BUILTIN_COUNT ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Metrics cannot be registered or read while the metrics subsystem is not running, and updates do nothing.
+    EXPECT_NOT ( metrics_running () );
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( metrics_register ( "test.counter" , METRICS_TYPE_COUNTER , &metric ) );
+    EXPECT_EQ ( 0 , metrics_snapshot ( values , METRICS_BUILTIN_COUNT ) );
+    EXPECT_EQ ( 0 , metrics_json () );
+    metrics_counter_add ( METRICS_FILE_BYTES_READ , 1 );
+    metrics_gauge_set ( METRICS_JOB_WORKERS , 1 );
+    metrics_histogram_record ( METRICS_JOB_RUN_TIME , 1 );
+
+    // TEST 2: metrics_startup with implicit memory allocation registers the built-in metrics.
+    EXPECT ( metrics_startup ( &memory_requirement , 0 ) );
+    EXPECT ( metrics_startup ( 0 , 0 ) );
+    EXPECT ( metrics_running () );
+    EXPECT_EQ ( metrics_amount_allocated + memory_requirement , memory_amount_allocated ( MEMORY_TAG_METRICS ) );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT , metrics_snapshot ( 0 , 0 ) );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT , metrics_snapshot ( values , METRICS_BUILTIN_COUNT ) );
+    EXPECT ( _string_equal ( values[ METRICS_FILE_BYTES_READ ].name , "file.bytes_read" ) );
+    EXPECT_EQ ( METRICS_TYPE_COUNTER , values[ METRICS_FILE_BYTES_READ ].type );
+    EXPECT ( _string_equal ( values[ METRICS_JOB_RUN_TIME ].name , "job.run_ns" ) );
+    EXPECT_EQ ( METRICS_TYPE_HISTOGRAM , values[ METRICS_JOB_RUN_TIME ].type );
+    EXPECT ( metrics_register ( "job.pending" , METRICS_TYPE_GAUGE , &metric ) );
+    EXPECT_EQ ( METRICS_JOB_PENDING , metric );
+
+    // TEST 3: metrics_startup fails if the metrics subsystem is already running.
+    LOGWARN ( "The following error is intentionally triggered by a test:" );
+    EXPECT_NOT ( metrics_startup ( 0 , 0 ) );
+
+    // TEST 4: metrics_shutdown frees all memory.
+    metrics_shutdown ();
+    EXPECT_NOT ( metrics_running () );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: metrics_shutdown handles a metrics subsystem which is not running.
+    metrics_shutdown ();
+
+    // TEST 6: metrics_startup with a pre-allocated buffer starts from zero.
+    memory = memory_allocate_aligned ( memory_requirement , 64 , MEMORY_TAG_METRICS );
+    EXPECT ( metrics_startup ( 0 , memory ) );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT , metrics_snapshot ( values , METRICS_BUILTIN_COUNT ) );
+    EXPECT_EQ ( 0 , values[ METRICS_JOB_RUN_TIME ].count );
+    metrics_shutdown ();
+    memory_free_aligned ( memory , memory_requirement , 64 , MEMORY_TAG_METRICS );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( metrics_amount_allocated , memory_amount_allocated ( MEMORY_TAG_METRICS ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_metrics_register_and_record
+( void )
+{
+    u64 global_amount_allocated;
+    u64 metrics_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    metrics_amount_allocated = memory_amount_allocated ( MEMORY_TAG_METRICS );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    metric_t counter;
+    metric_t gauge;
+    metric_t histogram;
+    metric_t extremes;
+    metric_t metric;
+    metrics_value_t values[ METRICS_BUILTIN_COUNT + 4 ];
+    char name[ METRICS_NAME_MAX_LENGTH + 2 ];
+    u64 index;
+
+    EXPECT ( metrics_startup ( 0 , 0 ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: metrics_register assigns handles in order of registration, after the built-in metrics.
+    EXPECT ( metrics_register ( "test.counter" , METRICS_TYPE_COUNTER , &counter ) );
+    EXPECT ( metrics_register ( "test.gauge" , METRICS_TYPE_GAUGE , &gauge ) );
+    EXPECT ( metrics_register ( "test.histogram_ns" , METRICS_TYPE_HISTOGRAM , &histogram ) );
+    EXPECT ( metrics_register ( "test.extremes" , METRICS_TYPE_HISTOGRAM , &extremes ) );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT , counter );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT + 1 , gauge );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT + 2 , histogram );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT + 3 , extremes );
+
+    // TEST 2: metrics_register returns the existing handle for a name registered as the same type.
+    EXPECT ( metrics_register ( "test.gauge" , METRICS_TYPE_GAUGE , &metric ) );
+    EXPECT_EQ ( gauge , metric );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT + 4 , metrics_snapshot ( 0 , 0 ) );
+
+    // TEST 3: metrics_register rejects invalid arguments, and names registered as a different type.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( metrics_register ( "test.gauge" , METRICS_TYPE_COUNTER , &metric ) );
+    EXPECT_NOT ( metrics_register ( 0 , METRICS_TYPE_COUNTER , &metric ) );
+    EXPECT_NOT ( metrics_register ( "test.counter" , METRICS_TYPE_COUNTER , 0 ) );
+    EXPECT_NOT ( metrics_register ( "" , METRICS_TYPE_COUNTER , &metric ) );
+    EXPECT_NOT ( metrics_register ( "Test.counter" , METRICS_TYPE_COUNTER , &metric ) );
+    EXPECT_NOT ( metrics_register ( "test \"counter\"" , METRICS_TYPE_COUNTER , &metric ) );
+    memory_set ( name , 'a' , METRICS_NAME_MAX_LENGTH + 1 );
+    name[ METRICS_NAME_MAX_LENGTH + 1 ] = 0;
+    EXPECT_NOT ( metrics_register ( name , METRICS_TYPE_COUNTER , &metric ) );
+    name[ METRICS_NAME_MAX_LENGTH ] = 0;
+    EXPECT ( metrics_register ( name , METRICS_TYPE_GAUGE , &metric ) );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT + 5 , metrics_snapshot ( 0 , 0 ) );
+
+    // TEST 4: Updates through a handle of the wrong kind are ignored.
+    metrics_counter_add ( gauge , 1 );
+    metrics_gauge_set ( counter , 1 );
+    metrics_histogram_record ( counter , 1 );
+    metrics_counter_add ( histogram , 1 );
+    metrics_counter_add ( METRICS_CAPACITY , 1 );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT + 5 , metrics_snapshot ( values , METRICS_BUILTIN_COUNT + 4 ) );
+    EXPECT_EQ ( 0 , values[ counter ].count );
+    EXPECT ( values[ gauge ].value == 0 );
+    EXPECT_EQ ( 0 , values[ histogram ].count );
+
+    // TEST 5: Counters and gauges.
+    metrics_counter_add ( counter , 3 );
+    metrics_counter_add ( counter , 4 );
+    metrics_gauge_set ( gauge , 2.5 );
+    metrics_gauge_set ( gauge , -1.25 );
+    metrics_snapshot ( values , METRICS_BUILTIN_COUNT + 4 );
+    EXPECT ( _string_equal ( values[ counter ].name , "test.counter" ) );
+    EXPECT_EQ ( METRICS_TYPE_COUNTER , values[ counter ].type );
+    EXPECT_EQ ( 7 , values[ counter ].count );
+    EXPECT_EQ ( METRICS_TYPE_GAUGE , values[ gauge ].type );
+    EXPECT ( values[ gauge ].value == -1.25 );
+
+    // TEST 6: Histograms count, sum and bound their values, and report quantiles to within a bucket.
+    for ( u64 i = 1; i <= 1000; ++i )
+    {
+        metrics_histogram_record ( histogram , i );
+    }
+    metrics_snapshot ( values , METRICS_BUILTIN_COUNT + 4 );
+    EXPECT_EQ ( METRICS_TYPE_HISTOGRAM , values[ histogram ].type );
+    EXPECT_EQ ( 1000 , values[ histogram ].count );
+    EXPECT_EQ ( 500500 , values[ histogram ].sum );
+    EXPECT_EQ ( 1000 , values[ histogram ].max );
+    EXPECT_EQ ( 511 , values[ histogram ].p50 );     // Bucket [ 480 , 511 ].
+    EXPECT_EQ ( 959 , values[ histogram ].p90 );     // Bucket [ 896 , 959 ].
+    EXPECT_EQ ( 1000 , values[ histogram ].p99 );    // Bucket [ 960 , 1023 ], bounded by the maximum.
+    EXPECT_EQ ( 1000 , values[ histogram ].p999 );
+
+    // TEST 7: Histograms span every u64 value.
+    metrics_histogram_record ( extremes , 0 );
+    metrics_histogram_record ( extremes , ~( ( u64 ) 0 ) );
+    metrics_snapshot ( values , METRICS_BUILTIN_COUNT + 4 );
+    EXPECT_EQ ( 2 , values[ extremes ].count );
+    EXPECT_EQ ( ~( ( u64 ) 0 ) , values[ extremes ].max );
+    EXPECT_EQ ( 0 , values[ extremes ].p50 );
+    EXPECT_EQ ( ~( ( u64 ) 0 ) , values[ extremes ].p99 );
+
+    // TEST 8: A snapshot with a smaller buffer holds the first values, and reports the total.
+    memory_clear ( values , sizeof ( values ) );
+    EXPECT_EQ ( METRICS_BUILTIN_COUNT + 5 , metrics_snapshot ( values , 1 ) );
+    EXPECT ( _string_equal ( values[ 0 ].name , "memory.allocated_bytes" ) );
+    EXPECT_EQ ( 0 , values[ 1 ].name[ 0 ] );
+
+    // TEST 9: metrics_json formats every metric.
+    char* json = metrics_json ();
+    EXPECT_NEQ ( 0 , json );
+    EXPECT_EQ ( '{' , json[ 0 ] );
+    EXPECT ( _string_contains ( json , "\n,\"test.counter\":{\"type\":\"counter\",\"value\":7}\n" , false , &index ) );
+    EXPECT ( _string_contains ( json , "\n,\"test.gauge\":{\"type\":\"gauge\",\"value\":-1.250000}\n" , false , &index ) );
+    EXPECT ( _string_contains ( json , "\n,\"test.histogram_ns\":{\"type\":\"histogram\",\"count\":1000,\"sum\":500500,\"max\":1000,\"p50\":511,\"p90\":959,\"p99\":1000,\"p999\":1000}\n" , false , &index ) );
+    EXPECT ( _string_contains ( json , "\"memory.allocated_bytes\":{\"type\":\"gauge\"" , false , &index ) );
+    EXPECT ( _string_contains ( json , "\n}\n" , true , &index ) );
+    string_destroy ( json );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    metrics_shutdown ();
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( metrics_amount_allocated , memory_amount_allocated ( MEMORY_TAG_METRICS ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_metrics_builtin
+( void )
+{
+    u64 global_amount_allocated;
+    u64 metrics_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    metrics_amount_allocated = memory_amount_allocated ( MEMORY_TAG_METRICS );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    metric_t counter;
+    metrics_value_t before[ METRICS_BUILTIN_COUNT + 1 ];
+    metrics_value_t after[ METRICS_BUILTIN_COUNT + 1 ];
+    file_t file;
+    char buffer[ 64 ];
+    u64 read;
+    u64 written;
+
+    EXPECT ( metrics_startup ( 0 , 0 ) );
+    EXPECT ( metrics_register ( "test.jobs" , METRICS_TYPE_COUNTER , &counter ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: File reads and writes are counted.
+    EXPECT ( file_open ( TEST_METRICS_IN_FILE , FILE_MODE_READ , &file ) );
+    metrics_snapshot ( before , METRICS_BUILTIN_COUNT + 1 );
+    EXPECT ( file_read ( &file , sizeof ( buffer ) , buffer , &read ) );
+    metrics_snapshot ( after , METRICS_BUILTIN_COUNT + 1 );
+    file_close ( &file );
+    EXPECT_NEQ ( 0 , read );
+    EXPECT_EQ ( before[ METRICS_FILE_BYTES_READ ].count + read , after[ METRICS_FILE_BYTES_READ ].count );
+
+    EXPECT ( file_open ( TEST_METRICS_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    metrics_snapshot ( before , METRICS_BUILTIN_COUNT + 1 );
+    EXPECT ( file_write ( &file , read , buffer , &written ) );
+    metrics_snapshot ( after , METRICS_BUILTIN_COUNT + 1 );
+    file_close ( &file );
+    EXPECT_EQ ( read , written );
+    EXPECT_EQ ( before[ METRICS_FILE_BYTES_WRITTEN ].count + written , after[ METRICS_FILE_BYTES_WRITTEN ].count );
+
+    // TEST 2: Memory usage is sampled, and per-thread allocation cache hits and misses are counted.
+    metrics_snapshot ( before , METRICS_BUILTIN_COUNT + 1 );
+    void* block = memory_allocate ( 16 , MEMORY_TAG_APPLICATION );
+    metrics_snapshot ( after , METRICS_BUILTIN_COUNT + 1 );
+    EXPECT_EQ ( memory_amount_allocated ( MEMORY_TAG_ALL ) , ( u64 ) after[ METRICS_MEMORY_ALLOCATED ].value );
+    EXPECT_EQ ( MEMORY_ALLOCATION_COUNT , ( u64 ) after[ METRICS_MEMORY_ALLOCATIONS ].value );
+    memory_free ( block , 16 , MEMORY_TAG_APPLICATION );
+#if MEMORY_THREAD_CACHE_ENABLED == 1
+    EXPECT_NEQ ( before[ METRICS_MEMORY_CACHE_HITS ].count + before[ METRICS_MEMORY_CACHE_MISSES ].count
+               , after[ METRICS_MEMORY_CACHE_HITS ].count + after[ METRICS_MEMORY_CACHE_MISSES ].count
+               );
+#endif
+    EXPECT ( after[ METRICS_MEMORY_FRAGMENTATION ].value >= 0 );
+    EXPECT ( after[ METRICS_MEMORY_FRAGMENTATION ].value <= 1 );
+
+    // TEST 3: Logger flushes are timed.
+    metrics_snapshot ( before , METRICS_BUILTIN_COUNT + 1 );
+    logger_flush ();
+    metrics_snapshot ( after , METRICS_BUILTIN_COUNT + 1 );
+    EXPECT_EQ ( before[ METRICS_LOGGER_FLUSH_TIME ].count + 1 , after[ METRICS_LOGGER_FLUSH_TIME ].count );
+
+    // TEST 4: Job system workers and pending jobs are sampled, and every run of a job is timed; counters sum across threads.
+    EXPECT ( job_system_startup ( 4 , 0 , 0 ) );
+    metrics_snapshot ( before , METRICS_BUILTIN_COUNT + 1 );
+    EXPECT_EQ ( 4 , ( u64 ) before[ METRICS_JOB_WORKERS ].value );
+    job_t jobs[ TEST_METRICS_JOB_COUNT ];
+    for ( u64 i = 0; i < TEST_METRICS_JOB_COUNT; ++i )
+    {
+        jobs[ i ].function = test_metrics_increment;
+        jobs[ i ].args = &counter;
+    }
+    job_counter_t done = { 0 };
+    EXPECT ( job_submit ( jobs , TEST_METRICS_JOB_COUNT , &done ) );
+    job_wait ( &done );
+    metrics_snapshot ( after , METRICS_BUILTIN_COUNT + 1 );
+    EXPECT_EQ ( TEST_METRICS_JOB_COUNT , after[ counter ].count );
+    EXPECT_EQ ( before[ METRICS_JOB_RUN_TIME ].count + TEST_METRICS_JOB_COUNT , after[ METRICS_JOB_RUN_TIME ].count );
+    EXPECT_EQ ( 0 , ( u64 ) after[ METRICS_JOB_PENDING ].value );
+    job_system_shutdown ();
+    metrics_snapshot ( after , METRICS_BUILTIN_COUNT + 1 );
+    EXPECT_EQ ( 0 , ( u64 ) after[ METRICS_JOB_WORKERS ].value );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    metrics_shutdown ();
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( metrics_amount_allocated , memory_amount_allocated ( MEMORY_TAG_METRICS ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_metrics
+( void )
+{
+    test_register_serial ( test_metrics_startup_and_shutdown , "Starting up or shutting down the metrics subsystem." );
+    test_register_serial ( test_metrics_register_and_record , "Registering, updating and reading metrics." );
+    test_register_serial ( test_metrics_builtin , "Reading the metrics fed by the library's subsystems." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_metrics.h
+ * @brief Tests core/metrics.h
+ * (see test/test.h, core/metrics.h for additional details)
+ */
+#ifndef TEST_METRICS_H
+#define TEST_METRICS_H
+
+#include "test/test.h"
+
+#include "core/metrics.h"
+
+void
+test_register_metrics
+( void );
+
+#endif  // TEST_METRICS_H
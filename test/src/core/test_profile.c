@@ -0,0 +1,177 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_profile.c
+ * @brief Implementation of the core/test_profile header.
+ * (see core/test_profile.h for additional details)
+ */
+#include "core/test_profile.h"
+
+#include "test/expect.h"
+
+#include "container/string.h"
+
+#include "core/memory.h"
+
+#include "platform/filesystem.h"
+#include "platform/thread.h"
+
+/** @brief Trace file written by the test. */
+#define TEST_PROFILE_FILEPATH "test/assets/out-profile"
+
+/**
+ * @brief Thread: records a single profiling zone.
+ */
+u32
+test_profile_worker
+(   void* args
+)
+{
+    profile_zone_t zone = profile_zone_begin ( "worker" );
+    profile_zone_end ( &zone );
+    return 0;
+}
+
+/**
+ * @brief Writes the trace, and counts the occurrences of a string in it.
+ *
+ * @param find The string to count.
+ * @return The number of occurrences of find in the trace, or -1 on error.
+ */
+i64
+test_profile_count
+(   const char* find
+)
+{
+    if ( !profile_write ( TEST_PROFILE_FILEPATH ) )
+    {
+        return -1;
+    }
+    file_t file;
+    char* content;
+    u64 read;
+    if ( !file_open ( TEST_PROFILE_FILEPATH , FILE_MODE_READ , &file ) )
+    {
+        return -1;
+    }
+    const bool success = file_read_all ( &file , ( u8** ) &content , &read );
+    file_close ( &file );
+    if ( !success )
+    {
+        return -1;
+    }
+    i64 count = 0;
+    const u64 find_length = _string_length ( find );
+    u64 offset = 0;
+    u64 index;
+    while ( string_contains ( content + offset , read - offset
+                            , find , find_length
+                            , false
+                            , &index
+                            ))
+    {
+        count += 1;
+        offset += index + find_length;
+    }
+    string_free ( content );
+    return count;
+}
+
+u8
+test_profile
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    profile_zone_t outer;
+    profile_zone_t inner;
+    thread_t thread;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: profile_write logs an error and fails if no path is provided.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( profile_write ( 0 ) );
+
+    // TEST 2: Zones are not recorded before profile_start.
+    EXPECT_NOT ( profile_recording () );
+    outer = profile_zone_begin ( "outer" );
+    profile_zone_end ( &outer );
+    EXPECT_EQ ( 0 , test_profile_count ( "\"ph\":\"X\"" ) );
+
+    // TEST 3: Nested zones are recorded between profile_start and profile_stop.
+    profile_start ();
+    EXPECT ( profile_recording () );
+    outer = profile_zone_begin ( "outer" );
+    inner = profile_zone_begin ( "inner \"quoted\"" );
+    profile_zone_end ( &inner );
+    profile_zone_end ( &outer );
+    profile_stop ();
+    EXPECT_NOT ( profile_recording () );
+    outer = profile_zone_begin ( "outer" );
+    profile_zone_end ( &outer );
+    EXPECT_EQ ( 2 , test_profile_count ( "\"ph\":\"X\"" ) );
+    EXPECT_EQ ( 1 , test_profile_count ( "\"name\":\"outer\"" ) );
+    EXPECT_EQ ( 1 , test_profile_count ( "\"name\":\"inner \\\"quoted\\\"\"" ) );
+    EXPECT_EQ ( 1 , test_profile_count ( "\"thread_name\"" ) );
+
+    // TEST 4: Each thread records into its own buffer.
+    profile_start ();
+    EXPECT ( thread_create ( test_profile_worker , 0 , false , &thread ) );
+    EXPECT ( thread_wait ( &thread ) );
+    thread_destroy ( &thread );
+    profile_stop ();
+    EXPECT_EQ ( 1 , test_profile_count ( "\"name\":\"outer\"" ) );
+    EXPECT_EQ ( 1 , test_profile_count ( "\"name\":\"worker\"" ) );
+    EXPECT_EQ ( 2 , test_profile_count ( "\"thread_name\"" ) );
+
+    // TEST 5: profile_clear discards every recorded zone.
+    profile_clear ();
+    EXPECT_EQ ( 0 , test_profile_count ( "\"ph\":\"X\"" ) );
+
+    // TEST 6: Once a buffer is full, its oldest zones are overwritten.
+    profile_start ();
+    for ( u64 i = 0; i < PROFILE_BUFFER_CAPACITY + 10; ++i )
+    {
+        outer = profile_zone_begin ( ( i < 10 ) ? "oldest" : "newest" );
+        profile_zone_end ( &outer );
+    }
+    profile_stop ();
+    EXPECT_EQ ( PROFILE_BUFFER_CAPACITY , test_profile_count ( "\"ph\":\"X\"" ) );
+    EXPECT_EQ ( 0 , test_profile_count ( "\"name\":\"oldest\"" ) );
+
+    // TEST 7: Recording resumes after profile_shutdown.
+    profile_shutdown ();
+    EXPECT_EQ ( 0 , test_profile_count ( "\"ph\":\"X\"" ) );
+    profile_start ();
+    {
+        PROFILE_ZONE ( "scoped" );
+        outer = profile_zone_begin ( "outer" );
+        profile_zone_end ( &outer );
+    }
+    profile_stop ();
+    EXPECT_EQ ( ( PROFILE_ENABLED == 1 ) ? 1 : 0 , test_profile_count ( "\"name\":\"scoped\"" ) );
+    EXPECT_EQ ( 1 , test_profile_count ( "\"name\":\"outer\"" ) );
+    profile_shutdown ();
+
+    // TEST 8: Profiling buffers are not visible to the memory subsystem.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_profile
+( void )
+{
+    test_register_serial ( test_profile , "Testing profiling zones and trace export." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_profile.h
+ * @brief Tests core/profile.h
+ * (see test/test.h, core/profile.h for additional details)
+ */
+#ifndef TEST_PROFILE_H
+#define TEST_PROFILE_H
+
+#include "test/test.h"
+
+#include "core/profile.h"
+
+void
+test_register_profile
+( void );
+
+#endif  // TEST_PROFILE_H
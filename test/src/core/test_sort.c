@@ -0,0 +1,282 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_sort.c
+ * @brief Implementation of the core/test_sort header.
+ * (see core/test_sort.h for additional details)
+ */
+#include "core/test_sort.h"
+
+#include "test/expect.h"
+
+#include "core/array.h"
+#include "core/job.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+/** @brief Record type used by the sort tests. Key precedes the payload. */
+typedef struct
+{
+    u64     key;
+    u64     index;
+    u64     padding;
+}
+test_sort_record_t;
+
+/**
+ * @brief Comparator function for 32-bit integers.
+ *
+ * @param x The address of a 32-bit integer.
+ * @param y The address of a 32-bit integer.
+ * @return < 0 if x < y.
+ *         > 0 if x > y.
+ *         = 0 otherwise.
+ */
+i32
+test_sort_compare_i32
+(   const void* x
+,   const void* y
+)
+{
+    return *( ( i32* ) x ) - *( ( i32* ) y );
+}
+
+/**
+ * @brief Comparator function for the leading u64 of an element (of any size).
+ *
+ * @param x The address of an element.
+ * @param y The address of an element.
+ * @return < 0 if x < y.
+ *         > 0 if x > y.
+ *         = 0 otherwise.
+ */
+i32
+test_sort_compare_u64
+(   const void* x
+,   const void* y
+)
+{
+    const u64 a = *( ( u64* ) x );
+    const u64 b = *( ( u64* ) y );
+    return ( a > b ) - ( a < b );
+}
+
+/**
+ * @brief Compares the radix sort keys of two records.
+ *
+ * @param x A record.
+ * @param y A record.
+ * @param key The type of key stored at the start of each record.
+ * @return < 0 if x < y.
+ *         > 0 if x > y.
+ *         = 0 otherwise.
+ */
+i32
+test_sort_compare_key
+(   const test_sort_record_t*   x
+,   const test_sort_record_t*   y
+,   SORT_KEY                    key
+)
+{
+    #define TEST_SORT_COMPARE(type)                     \
+        {                                               \
+            type a;                                     \
+            type b;                                     \
+            memory_copy ( &a , x , sizeof ( type ) );   \
+            memory_copy ( &b , y , sizeof ( type ) );   \
+            return ( a > b ) - ( a < b );               \
+        }
+    switch ( key )
+    {
+        case SORT_KEY_U8:  TEST_SORT_COMPARE ( u8 )
+        case SORT_KEY_U16: TEST_SORT_COMPARE ( u16 )
+        case SORT_KEY_U32: TEST_SORT_COMPARE ( u32 )
+        case SORT_KEY_U64: TEST_SORT_COMPARE ( u64 )
+        case SORT_KEY_I8:  TEST_SORT_COMPARE ( i8 )
+        case SORT_KEY_I16: TEST_SORT_COMPARE ( i16 )
+        case SORT_KEY_I32: TEST_SORT_COMPARE ( i32 )
+        case SORT_KEY_I64: TEST_SORT_COMPARE ( i64 )
+        case SORT_KEY_F32: TEST_SORT_COMPARE ( f32 )
+        case SORT_KEY_F64: TEST_SORT_COMPARE ( f64 )
+        default:           return 0;
+    }
+    #undef TEST_SORT_COMPARE
+}
+
+u8
+test_sort
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 length = 100000;
+    i32* sorted = memory_allocate ( length * sizeof ( i32 ) , MEMORY_TAG_ARRAY );
+    i32* array = memory_allocate ( length * sizeof ( i32 ) , MEMORY_TAG_ARRAY );
+    test_sort_record_t* records = memory_allocate ( length * sizeof ( test_sort_record_t ) , MEMORY_TAG_ARRAY );
+    test_sort_record_t* scratch = memory_allocate ( length * sizeof ( test_sort_record_t ) , MEMORY_TAG_ARRAY );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , sorted );
+    EXPECT_NEQ ( 0 , array );
+    EXPECT_NEQ ( 0 , records );
+    EXPECT_NEQ ( 0 , scratch );
+
+    for ( u64 i = 0; i < length; ++i )
+    {
+        sorted[ i ] = ( i32 ) i - ( i32 )( length / 2 );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: sort handles an unsorted array of 4-byte elements.
+    array_copy ( sorted , length , sizeof ( i32 ) , array );
+    array_shuffle ( array , length , sizeof ( i32 ) , 0 );
+    sort ( array , length , sizeof ( i32 ) , test_sort_compare_i32 );
+    EXPECT ( memory_equal ( array , sorted , length * sizeof ( i32 ) ) );
+
+    // TEST 2: sort handles an already-sorted array.
+    sort ( array , length , sizeof ( i32 ) , test_sort_compare_i32 );
+    EXPECT ( memory_equal ( array , sorted , length * sizeof ( i32 ) ) );
+
+    // TEST 3: sort handles an array in reverse order.
+    array_reverse ( array , length , sizeof ( i32 ) , 0 );
+    sort ( array , length , sizeof ( i32 ) , test_sort_compare_i32 );
+    EXPECT ( memory_equal ( array , sorted , length * sizeof ( i32 ) ) );
+
+    // TEST 4: sort handles an array with every element equal.
+    for ( u64 i = 0; i < length; ++i )
+    {
+        array[ i ] = 99;
+    }
+    sort ( array , length , sizeof ( i32 ) , test_sort_compare_i32 );
+    for ( u64 i = 0; i < length; ++i )
+    {
+        EXPECT_EQ ( 99 , array[ i ] );
+    }
+
+    // TEST 5: sort handles 8-byte, 16-byte, and 24-byte (generic) elements.
+    for ( u64 stride = 8; stride <= sizeof ( test_sort_record_t ); stride += 8 )
+    {
+        u8* elements = ( u8* ) records;
+        for ( u64 i = 0; i < length; ++i )
+        {
+            test_sort_record_t record;
+            record.key = random2 ( 0 , 1000 );
+            record.index = i;
+            record.padding = 0;
+            memory_copy ( elements + i * stride , &record , stride );
+        }
+        sort ( elements , length , stride , test_sort_compare_u64 );
+        for ( u64 i = 1; i < length; ++i )
+        {
+            EXPECT ( test_sort_compare_u64 ( elements + ( i - 1 ) * stride , elements + i * stride ) <= 0 );
+        }
+    }
+
+    // TEST 6: sort_radix handles every key type, and is stable.
+    for ( SORT_KEY key = 0; key < SORT_KEY_COUNT; ++key )
+    {
+        for ( u64 i = 0; i < length; ++i )
+        {
+            // Few distinct values, so the stability check sees many ties.
+            const i32 value = random2 ( -1000 , 1000 );
+            records[ i ].key = 0;
+            records[ i ].index = i;
+            switch ( key )
+            {
+                case SORT_KEY_U8:  { const u8  v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_U16: { const u16 v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_U32: { const u32 v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_U64: { const u64 v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_I8:  { const i8  v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_I16: { const i16 v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_I32: { const i32 v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_I64: { const i64 v = value; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                case SORT_KEY_F32: { const f32 v = value / 7.0f; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+                default:           { const f64 v = value / 7.0; memory_copy ( &records[ i ].key , &v , sizeof ( v ) ); } break;
+            }
+        }
+        EXPECT ( sort_radix ( records , length , sizeof ( test_sort_record_t ) , 0 , key , 0 ) );
+        for ( u64 i = 1; i < length; ++i )
+        {
+            const i32 result = test_sort_compare_key ( &records[ i - 1 ] , &records[ i ] , key );
+            EXPECT ( result <= 0 );
+            if ( !result )
+            {
+                EXPECT ( records[ i - 1 ].index < records[ i ].index );
+            }
+        }
+    }
+
+    // TEST 7: sort_radix handles a key within each element, and a pre-allocated scratch buffer.
+    array_copy ( sorted , length , sizeof ( i32 ) , array );
+    array_shuffle ( array , length , sizeof ( i32 ) , 0 );
+    for ( u64 i = 0; i < length; ++i )
+    {
+        records[ i ].key = 0;
+        records[ i ].index = array[ i ];
+    }
+    EXPECT ( sort_radix ( records , length , sizeof ( test_sort_record_t ) , 8 , SORT_KEY_I32 , scratch ) );
+    for ( u64 i = 0; i < length; ++i )
+    {
+        EXPECT_EQ ( sorted[ i ] , ( i32 ) records[ i ].index );
+    }
+
+    // TEST 8: sort_radix fails if the key does not fit in an element.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( sort_radix ( records , length , sizeof ( test_sort_record_t ) , 20 , SORT_KEY_U64 , 0 ) );
+    EXPECT_NOT ( sort_radix ( records , length , sizeof ( test_sort_record_t ) , 0 , SORT_KEY_COUNT , 0 ) );
+
+    // TEST 9: sort_parallel is equivalent to sort if the job system is not running.
+    array_copy ( sorted , length , sizeof ( i32 ) , array );
+    array_shuffle ( array , length , sizeof ( i32 ) , 0 );
+    sort_parallel ( array , length , sizeof ( i32 ) , test_sort_compare_i32 , 0 );
+    EXPECT ( memory_equal ( array , sorted , length * sizeof ( i32 ) ) );
+
+    // TEST 10: sort_parallel sorts using the job system.
+    EXPECT ( job_system_startup ( 2 , 0 , 0 ) );
+    array_shuffle ( array , length , sizeof ( i32 ) , 0 );
+    sort_parallel ( array , length , sizeof ( i32 ) , test_sort_compare_i32 , 0 );
+    EXPECT ( memory_equal ( array , sorted , length * sizeof ( i32 ) ) );
+    for ( u64 i = 0; i < length; ++i )
+    {
+        records[ i ].key = random2 ( 0 , 1000 );
+        records[ i ].index = i;
+    }
+    sort_parallel ( records , length , sizeof ( test_sort_record_t ) , test_sort_compare_u64 , scratch );
+    for ( u64 i = 1; i < length; ++i )
+    {
+        EXPECT ( records[ i - 1 ].key <= records[ i ].key );
+    }
+    job_system_shutdown ();
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    memory_free ( sorted , length * sizeof ( i32 ) , MEMORY_TAG_ARRAY );
+    memory_free ( array , length * sizeof ( i32 ) , MEMORY_TAG_ARRAY );
+    memory_free ( records , length * sizeof ( test_sort_record_t ) , MEMORY_TAG_ARRAY );
+    memory_free ( scratch , length * sizeof ( test_sort_record_t ) , MEMORY_TAG_ARRAY );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_sort
+( void )
+{
+    test_register_serial ( test_sort , "Testing introsort, radix sort, and parallel sort." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_sort.h
+ * @brief Tests core/sort.h
+ * (see test/test.h, core/sort.h for additional details)
+ */
+#ifndef TEST_SORT_H
+#define TEST_SORT_H
+
+#include "test/test.h"
+
+#include "core/sort.h"
+
+void
+test_register_sort
+( void );
+
+#endif  // TEST_SORT_H
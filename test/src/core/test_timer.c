@@ -0,0 +1,422 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_timer.c
+ * @brief Implementation of the core/test_timer header.
+ * (see core/test_timer.h for additional details)
+ */
+#include "core/test_timer.h"
+
+#include "test/expect.h"
+
+#include "core/clock.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+#define TEST_TIMER_COUNT ( ( u64 ) 2000 )
+
+/** @brief Type definition for the time as seen by the test timer jobs. */
+typedef struct
+{
+    // Time passed to the current and previous calls to timer_wheel_advance.
+    u64 now;
+    u64 previous;
+}
+now_t;
+
+/** @brief Type definition for a record of when a test timer expired. */
+typedef struct
+{
+    const now_t*    time;
+    u64             deadline;
+    u64             count;
+    u64             now;
+    u64             previous;
+}
+record_t;
+
+/** @brief Type definition for a timer job which reschedules itself. */
+typedef struct
+{
+    timer_wheel_t*  wheel;
+    u64             period;
+    u64             deadline;
+    u64             count;
+    u64             limit;
+}
+periodic_t;
+
+/** @brief Test job: records when the timer expired. */
+void
+test_timer_record
+(   void* args
+)
+{
+    record_t* record = args;
+    ( *record ).count += 1;
+    ( *record ).now = ( *( *record ).time ).now;
+    ( *record ).previous = ( *( *record ).time ).previous;
+}
+
+/** @brief Test job: atomically increments a counter. */
+void
+test_timer_increment
+(   void* args
+)
+{
+    atomic_fetch_add_u64 ( args , 1 , ATOMIC_RELAXED );
+}
+
+/** @brief Test job: reschedules its own timer until it has run limit times. */
+void
+test_timer_periodic
+(   void* args
+)
+{
+    periodic_t* periodic = args;
+    ( *periodic ).count += 1;
+    if ( ( *periodic ).count < ( *periodic ).limit )
+    {
+        ( *periodic ).deadline += ( *periodic ).period;
+        const job_t job = { test_timer_periodic , periodic };
+        timer_wheel_schedule ( ( *periodic ).wheel , ( *periodic ).deadline , job );
+    }
+}
+
+/**
+ * @brief Schedules TEST_TIMER_COUNT timers at random deadlines, advances the
+ * wheel in random steps until all have expired, and verifies that each expired
+ * exactly once, on the first advance at or after its deadline (rounded up to
+ * a whole tick).
+ *
+ * @param resolution The wheel resolution.
+ * @param span The maximum distance of a deadline from the start.
+ * @param step The maximum advance step.
+ * @return true if each timer expired on time; false otherwise.
+ */
+u8
+test_timer_wheel_expire_random
+(   const u64 resolution
+,   const u64 span
+,   const u64 step
+)
+{
+    const u64 start = ( ( u64 ) 1 ) << 40;
+    now_t time = { start - 1 , 0 };
+    timer_wheel_t* wheel;
+    record_t* records = memory_allocate ( TEST_TIMER_COUNT * sizeof ( record_t ) , MEMORY_TAG_ARRAY );
+
+    EXPECT ( timer_wheel_create ( resolution , start , &wheel ) );
+    for ( u64 i = 0; i < TEST_TIMER_COUNT; ++i )
+    {
+        records[ i ].time = &time;
+        records[ i ].deadline = start + random64_2 ( 0 , span );
+        const job_t job = { test_timer_record , &records[ i ] };
+        EXPECT_NEQ ( TIMER_INVALID , timer_wheel_schedule ( wheel , records[ i ].deadline , job ) );
+    }
+    EXPECT_EQ ( TEST_TIMER_COUNT , timer_wheel_length ( wheel ) );
+
+    u64 expired = 0;
+    while ( time.now <= start + span )
+    {
+        time.previous = time.now;
+        time.now += random64_2 ( 0 , step );
+        expired += timer_wheel_advance ( wheel , time.now , 0 );
+    }
+    EXPECT_EQ ( TEST_TIMER_COUNT , expired );
+    EXPECT_EQ ( 0 , timer_wheel_length ( wheel ) );
+
+    for ( u64 i = 0; i < TEST_TIMER_COUNT; ++i )
+    {
+        const u64 due = ( ( records[ i ].deadline + resolution - 1 ) / resolution ) * resolution;
+        EXPECT_EQ ( 1 , records[ i ].count );
+        EXPECT ( records[ i ].now >= records[ i ].deadline );
+        EXPECT ( records[ i ].now >= due );
+        EXPECT ( records[ i ].previous < due );
+    }
+
+    timer_wheel_destroy ( &wheel );
+    memory_free ( records , TEST_TIMER_COUNT * sizeof ( record_t ) , MEMORY_TAG_ARRAY );
+    return true;
+}
+
+u8
+test_timer_wheel_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    timer_wheel_t* wheel;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: timer_wheel_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( timer_wheel_create ( 0 , 0 , &wheel ) );
+    EXPECT_NOT ( timer_wheel_create ( 1000 , 0 , 0 ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: timer_wheel_create creates an empty wheel.
+    wheel = 0;
+    EXPECT ( timer_wheel_create ( 1000 , clock_time () , &wheel ) );
+    EXPECT_NEQ ( 0 , wheel );
+    EXPECT_EQ ( 1000 , timer_wheel_resolution ( wheel ) );
+    EXPECT_EQ ( 0 , timer_wheel_length ( wheel ) );
+    EXPECT_EQ ( 0 , timer_wheel_advance ( wheel , clock_time () , 0 ) );
+    EXPECT_NEQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+
+    // TEST 3: timer_wheel_schedule handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    const job_t job = { 0 , 0 };
+    EXPECT_EQ ( TIMER_INVALID , timer_wheel_schedule ( wheel , 0 , job ) );
+    EXPECT_EQ ( 0 , timer_wheel_length ( wheel ) );
+    EXPECT_NOT ( timer_wheel_pending ( wheel , TIMER_INVALID ) );
+    EXPECT_NOT ( timer_wheel_cancel ( wheel , TIMER_INVALID ) );
+
+    // TEST 4: timer_wheel_destroy frees the wheel and nullifies the handle.
+    timer_wheel_destroy ( &wheel );
+    EXPECT_EQ ( 0 , wheel );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: timer_wheel_destroy handles invalid arguments.
+    timer_wheel_destroy ( 0 );
+    timer_wheel_destroy ( &wheel );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_timer_wheel_expire
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    timer_wheel_t* wheel;
+    now_t time = { 0 , 0 };
+    record_t record = { &time , 0 , 0 , 0 , 0 };
+    const job_t job = { test_timer_record , &record };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A timer expires on the first advance at or after its deadline,
+    //         rounded up to a whole tick.
+    EXPECT ( timer_wheel_create ( 1000 , 0 , &wheel ) );
+    EXPECT_NEQ ( TIMER_INVALID , timer_wheel_schedule ( wheel , 2500 , job ) );
+    EXPECT_EQ ( 0 , timer_wheel_advance ( wheel , 2500 , 0 ) );
+    EXPECT_EQ ( 0 , timer_wheel_advance ( wheel , 2999 , 0 ) );
+    EXPECT_EQ ( 0 , record.count );
+    EXPECT_EQ ( 1 , timer_wheel_advance ( wheel , 3000 , 0 ) );
+    EXPECT_EQ ( 1 , record.count );
+    EXPECT_EQ ( 0 , timer_wheel_advance ( wheel , 1000000 , 0 ) );
+    EXPECT_EQ ( 1 , record.count );
+
+    // TEST 2: A deadline which has already passed expires on the next advance
+    //         which reaches a new tick.
+    EXPECT_NEQ ( TIMER_INVALID , timer_wheel_schedule ( wheel , 0 , job ) );
+    EXPECT_EQ ( 0 , timer_wheel_advance ( wheel , 1000999 , 0 ) );
+    EXPECT_EQ ( 1 , timer_wheel_advance ( wheel , 1001000 , 0 ) );
+    EXPECT_EQ ( 2 , record.count );
+
+    // TEST 3: Advancing to an earlier time has no effect.
+    EXPECT_NEQ ( TIMER_INVALID , timer_wheel_schedule ( wheel , 1500000 , job ) );
+    EXPECT_EQ ( 0 , timer_wheel_advance ( wheel , 0 , 0 ) );
+    EXPECT_EQ ( 1 , timer_wheel_length ( wheel ) );
+    EXPECT_EQ ( 1 , timer_wheel_advance ( wheel , 1500000 , 0 ) );
+    timer_wheel_destroy ( &wheel );
+
+    // TEST 4: Timers expire on time, whether they start in the lowest level
+    //         or are cascaded from higher levels.
+    EXPECT ( test_timer_wheel_expire_random ( 1000 , 10000000 , 5000 ) );
+    EXPECT ( test_timer_wheel_expire_random ( 1 , 1000000 , 64 ) );
+    EXPECT ( test_timer_wheel_expire_random ( 1 , 1000000 , 100000 ) );
+
+    // TEST 5: Timers beyond the span of the top level expire on time, and
+    //         advancing over long idle intervals does not visit every tick.
+    EXPECT ( test_timer_wheel_expire_random ( 1 , ( ( u64 ) 1 ) << 44 , ( ( u64 ) 1 ) << 34 ) );
+
+    // TEST 6: A job may reschedule its own timer.
+    periodic_t periodic = { 0 , 1000 , 1000 , 0 , 10 };
+    EXPECT ( timer_wheel_create ( 100 , 0 , &wheel ) );
+    periodic.wheel = wheel;
+    const job_t periodic_job = { test_timer_periodic , &periodic };
+    timer_wheel_schedule ( wheel , periodic.deadline , periodic_job );
+    for ( u64 now = 0; now <= 20000; now += 100 )
+    {
+        timer_wheel_advance ( wheel , now , 0 );
+        EXPECT_EQ ( ( now < 10000 ) ? now / 1000 : 10 , periodic.count );
+    }
+    EXPECT_EQ ( 0 , timer_wheel_length ( wheel ) );
+    timer_wheel_destroy ( &wheel );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_timer_wheel_cancel
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    timer_wheel_t* wheel;
+    u64 timers[ TEST_TIMER_COUNT ];
+    u64 counts[ TEST_TIMER_COUNT ];
+
+    EXPECT ( timer_wheel_create ( 1000 , 0 , &wheel ) );
+    for ( u64 i = 0; i < TEST_TIMER_COUNT; ++i )
+    {
+        counts[ i ] = 0;
+        const job_t job = { test_timer_increment , &counts[ i ] };
+        timers[ i ] = timer_wheel_schedule ( wheel , random64_2 ( 0 , 1000000000 ) , job );
+        EXPECT_NEQ ( TIMER_INVALID , timers[ i ] );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Every scheduled timer is pending.
+    for ( u64 i = 0; i < TEST_TIMER_COUNT; ++i )
+    {
+        EXPECT ( timer_wheel_pending ( wheel , timers[ i ] ) );
+    }
+
+    // TEST 2: A cancelled timer is no longer pending, and cannot be cancelled
+    //         again.
+    for ( u64 i = 1; i < TEST_TIMER_COUNT; i += 2 )
+    {
+        EXPECT ( timer_wheel_cancel ( wheel , timers[ i ] ) );
+        EXPECT_NOT ( timer_wheel_pending ( wheel , timers[ i ] ) );
+        EXPECT_NOT ( timer_wheel_cancel ( wheel , timers[ i ] ) );
+    }
+    EXPECT_EQ ( TEST_TIMER_COUNT / 2 , timer_wheel_length ( wheel ) );
+
+    // TEST 3: A handle stays invalid after its timer is reused.
+    const job_t job = { test_timer_increment , &counts[ 1 ] };
+    const u64 timer = timer_wheel_schedule ( wheel , 0 , job );
+    EXPECT_NEQ ( TIMER_INVALID , timer );
+    for ( u64 i = 1; i < TEST_TIMER_COUNT; i += 2 )
+    {
+        EXPECT_NEQ ( timers[ i ] , timer );
+        EXPECT_NOT ( timer_wheel_pending ( wheel , timers[ i ] ) );
+    }
+    EXPECT ( timer_wheel_cancel ( wheel , timer ) );
+
+    // TEST 4: Only the timers which were not cancelled expire.
+    EXPECT_EQ ( TEST_TIMER_COUNT / 2 , timer_wheel_advance ( wheel , 1000000000 , 0 ) );
+    for ( u64 i = 0; i < TEST_TIMER_COUNT; ++i )
+    {
+        EXPECT_EQ ( ( i % 2 ) ? ( u64 ) 0 : ( u64 ) 1 , counts[ i ] );
+        EXPECT_NOT ( timer_wheel_pending ( wheel , timers[ i ] ) );
+    }
+    EXPECT_EQ ( 0 , timer_wheel_length ( wheel ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    timer_wheel_destroy ( &wheel );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_timer_wheel_jobs
+( void )
+{
+    u64 global_amount_allocated;
+    u64 job_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    job_amount_allocated = memory_amount_allocated ( MEMORY_TAG_JOB );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    timer_wheel_t* wheel;
+    job_counter_t counter = { 0 };
+    u64 value = 0;
+    const job_t job = { test_timer_increment , &value };
+
+    EXPECT ( job_system_startup ( 2 , 0 , 0 ) );
+    EXPECT ( timer_wheel_create ( 1000 , 0 , &wheel ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Expired timers are submitted to the job system when a counter is
+    //         given.
+    for ( u64 i = 0; i < TEST_TIMER_COUNT; ++i )
+    {
+        EXPECT_NEQ ( TIMER_INVALID , timer_wheel_schedule ( wheel , random64_2 ( 0 , 100000 ) , job ) );
+    }
+    EXPECT_EQ ( TEST_TIMER_COUNT , timer_wheel_advance ( wheel , 100000 , &counter ) );
+    job_wait ( &counter );
+    EXPECT_EQ ( TEST_TIMER_COUNT , atomic_load_u64 ( &value , ATOMIC_ACQUIRE ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    timer_wheel_destroy ( &wheel );
+    job_system_shutdown ();
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( job_amount_allocated , memory_amount_allocated ( MEMORY_TAG_JOB ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_timer
+( void )
+{
+    test_register ( test_timer_wheel_create_and_destroy , "Creating or destroying a timer wheel." );
+    test_register ( test_timer_wheel_expire , "Testing timer wheel expiry." );
+    test_register ( test_timer_wheel_cancel , "Cancelling timers on a timer wheel." );
+    test_register_serial ( test_timer_wheel_jobs , "Dispatching expired timers onto the job system." );
+}
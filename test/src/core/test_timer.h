@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file core/test_timer.h
+ * @brief Tests core/timer.h
+ * (see test/test.h, core/timer.h for additional details)
+ */
+#ifndef TEST_TIMER_H
+#define TEST_TIMER_H
+
+#include "test/test.h"
+
+#include "core/timer.h"
+
+void
+test_register_timer
+( void );
+
+#endif  // TEST_TIMER_H
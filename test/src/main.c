@@ -3,24 +3,64 @@
  * @file main.c
  * @brief Entry point for the test suite program.
  * 
+ * Usage: test [--jobs <n>]
+ *   --jobs : Run up to n tests at a time (0: one per logical core). Default 1.
+ * 
  * SYSTEM REQUIREMENTS: ~6.00 GiB free disk space.
  *                      ~2.81 GiB free RAM.
  */
 #include "test/test.h"
 
+#include "container/string.h"
+
 #include "core/logger.h"
 #include "core/memory.h"
 
 #include "container/test_array.h"
+#include "container/test_soa.h"
 #include "container/test_hashtable.h"
+#include "container/test_concurrent_hashtable.h"
+#include "container/test_cache.h"
+#include "container/test_heap.h"
+#include "container/test_btree.h"
+#include "container/test_list.h"
+#include "container/test_intern.h"
 #include "container/test_freelist.h"
 #include "container/test_queue.h"
+#include "container/test_spsc_queue.h"
+#include "container/test_mpmc_queue.h"
 #include "container/test_string.h"
+#include "container/test_gap_buffer.h"
+
+#include "core/test_bitv.h"
+#include "core/test_checksum.h"
+#include "core/test_compress.h"
+#include "core/test_csv.h"
+#include "core/test_image.h"
+#include "core/test_clock.h"
+#include "core/test_profile.h"
+#include "core/test_timer.h"
+#include "core/test_job.h"
+#include "core/test_logger.h"
+#include "core/test_memory.h"
+#include "core/test_metrics.h"
+#include "core/test_sort.h"
+
+#include "math/test_approx.h"
+#include "math/test_batch.h"
+#include "math/test_prng.h"
 
+#include "memory/test_arena.h"
 #include "memory/test_dynamic_allocator.h"
 #include "memory/test_linear_allocator.h"
+#include "memory/test_pool_allocator.h"
 
 #include "platform/test_filesystem.h"
+#include "platform/test_io_queue.h"
+#include "platform/test_lock.h"
+#include "platform/test_thread.h"
+#include "platform/test_fiber.h"
+#include "platform/test_cpu.h"
 
 /** @brief Rough bound on maximum system memory usage: 2.50 GiB. */
 #define TEST_MEMORY_REQUIREMENT \
@@ -35,25 +75,81 @@
 
 int
 main
-( void )
+(   int     argc
+,   char**  argv
+)
 {
     memory_startup ( TEST_MEMORY_REQUIREMENT );
     logger_startup ( LOG_FILEPATH , 0 , 0 );
 
+    // Parse options.
+    u32 thread_count = 1;
+    for ( int i = 1; i < argc; i += 2 )
+    {
+        i64 value;
+        if (   _string_equal ( argv[ i ] , "--jobs" ) && i + 1 < argc
+            && _string_to_i64 ( argv[ i + 1 ] , 10 , &value , 0 ) == STRING_PARSE_SUCCESS
+            && value >= 0
+           )
+        {
+            thread_count = ( value ) ? value : platform_processor_core_count ();
+        }
+        else
+        {
+            LOGERROR ( "Unrecognized option: %s" , argv[ i ] );
+            logger_shutdown ();
+            memory_shutdown ();
+            return 1;
+        }
+    }
+
     // Initialize tests.
     test_startup ();
+    test_register_memory ();
     test_register_linear_allocator ();
     test_register_freelist ();
     test_register_dynamic_allocator ();
+    test_register_arena ();
+    test_register_pool_allocator ();
     test_register_array ();
+    test_register_soa ();
+    test_register_sort ();
+    test_register_bitv ();
+    test_register_checksum ();
+    test_register_compress ();
+    test_register_csv ();
+    test_register_image ();
+    test_register_clock ();
+    test_register_profile ();
+    test_register_timer ();
+    test_register_prng ();
+    test_register_batch ();
+    test_register_approx ();
     test_register_string ();
+    test_register_gap_buffer ();
     test_register_queue ();
+    test_register_spsc_queue ();
+    test_register_mpmc_queue ();
+    test_register_job ();
+    test_register_logger ();
+    test_register_metrics ();
     test_register_hashtable ();
+    test_register_concurrent_hashtable ();
+    test_register_cache ();
+    test_register_heap ();
+    test_register_btree ();
+    test_register_list ();
+    test_register_intern ();
     test_register_filesystem ();
+    test_register_io_queue ();
+    test_register_lock ();
+    test_register_thread ();
+    test_register_fiber ();
+    test_register_cpu ();
 
     // Run tests.
-    LOGINFO ( "Running test suite. . ." );
-    const bool fail = test_run_all ();
+    LOGINFO ( "Running test suite (%u test%s at a time). . ." , thread_count , ( thread_count == 1 ) ? "" : "s" );
+    const bool fail = _test_run_all ( thread_count );
     if ( !fail )
     {
         PRINT ( COLORED ( "libc ("PLATFORM_STRING") ver. %i.%i.%i: All tests passed." ) "\n\n"
@@ -0,0 +1,177 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/test_approx.c
+ * @brief Implementation of the math/test_approx header.
+ * (see math/test_approx.h for additional details)
+ */
+#include "math/test_approx.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "math/math.h"
+
+/** @brief Number of arguments sampled from each range. */
+#define TEST_APPROX_SAMPLES 100000
+
+/**
+ * @brief Measures the error of an approximation in units in the last place of
+ * the exact result.
+ *
+ * @param approx An approximation.
+ * @param exact The exact result (a normal, non-zero f32 when rounded).
+ * @return The error of approx, in ULP.
+ */
+f64
+_test_approx_ulps
+(   f32 approx
+,   f64 exact
+);
+
+/**
+ * @brief Samples a range evenly, avoiding its endpoints.
+ *
+ * @param min Least value.
+ * @param max Greatest value.
+ * @param i Index of the sample, in [ 0 , TEST_APPROX_SAMPLES ).
+ * @return The ith sample.
+ */
+f32
+_test_approx_sample
+(   f64 min
+,   f64 max
+,   u64 i
+);
+
+u8
+test_approx
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    f64 error;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: math_approx_exp is within 1.1 ULP over its range.
+    error = 0.0;
+    for ( u64 i = 0; i < TEST_APPROX_SAMPLES; ++i )
+    {
+        const f32 x = _test_approx_sample ( MATH_APPROX_EXP_MIN , MATH_APPROX_EXP_MAX , i );
+        error = MAX ( error , _test_approx_ulps ( math_approx_exp ( x ) , exp64 ( x ) ) );
+    }
+    EXPECT ( error <= 1.1 );
+
+    // TEST 2: math_approx_exp is exact at 0, and clamps its argument.
+    EXPECT ( math_approx_exp ( 0.0f ) == 1.0f );
+    EXPECT ( finite ( math_approx_exp ( 1000.0f ) ) );
+    EXPECT ( math_approx_exp ( 1000.0f ) >= 2e38f );
+    EXPECT ( math_approx_exp ( -1000.0f ) > 0.0f );
+    EXPECT ( math_approx_exp ( -1000.0f ) <= 2e-38f );
+
+    // TEST 3: math_approx_ln is within 0.9 ULP, across every binade.
+    error = 0.0;
+    for ( u64 i = 0; i < TEST_APPROX_SAMPLES; ++i )
+    {
+        const f32 x = exp64 ( _test_approx_sample ( -87.0 , 88.0 , i ) );
+        if ( x == 1.0f )
+        {
+            continue;   // ln(1) = 0 has no ULP.
+        }
+        error = MAX ( error , _test_approx_ulps ( math_approx_ln ( x ) , ln64 ( x ) ) );
+    }
+    EXPECT ( error <= 0.9 );
+    EXPECT ( math_approx_ln ( 1.0f ) == 0.0f );
+
+    // TEST 4: math_approx_sin and math_approx_cos are within 1.5 ULP over
+    //         [ -π , π ].
+    error = 0.0;
+    for ( u64 i = 0; i < TEST_APPROX_SAMPLES; ++i )
+    {
+        const f32 x = _test_approx_sample ( -PI , PI , i );
+        error = MAX ( error , _test_approx_ulps ( math_approx_sin ( x ) , sin64 ( x ) ) );
+        error = MAX ( error , _test_approx_ulps ( math_approx_cos ( x ) , cos64 ( x ) ) );
+    }
+    EXPECT ( error <= 1.5 );
+    EXPECT ( math_approx_sin ( 0.0f ) == 0.0f );
+    EXPECT ( math_approx_cos ( 0.0f ) == 1.0f );
+
+    // TEST 5: math_approx_sin and math_approx_cos are within 14 ULP over
+    //         [ -100 , 100 ].
+    error = 0.0;
+    for ( u64 i = 0; i < TEST_APPROX_SAMPLES; ++i )
+    {
+        const f32 x = _test_approx_sample ( -100.0 , 100.0 , i );
+        error = MAX ( error , _test_approx_ulps ( math_approx_sin ( x ) , sin64 ( x ) ) );
+        error = MAX ( error , _test_approx_ulps ( math_approx_cos ( x ) , cos64 ( x ) ) );
+    }
+    EXPECT ( error <= 14.0 );
+
+    // TEST 6: math_approx_sin and math_approx_cos are within 8e-8 (absolute)
+    //         over [ -8192 , 8192 ].
+    error = 0.0;
+    for ( u64 i = 0; i < TEST_APPROX_SAMPLES; ++i )
+    {
+        const f32 x = _test_approx_sample ( -8192.0 , 8192.0 , i );
+        error = MAX ( error , abs64 ( math_approx_sin ( x ) - sin64 ( x ) ) );
+        error = MAX ( error , abs64 ( math_approx_cos ( x ) - cos64 ( x ) ) );
+    }
+    EXPECT ( error <= 8e-8 );
+
+    // TEST 7: math_approx_rsqrt is within a relative error of 1.8e-3, across
+    //         every binade.
+    error = 0.0;
+    for ( u64 i = 0; i < TEST_APPROX_SAMPLES; ++i )
+    {
+        const f32 x = exp64 ( _test_approx_sample ( -87.0 , 88.0 , i ) );
+        const f64 exact = 1.0 / sqrt64 ( x );
+        error = MAX ( error , abs64 ( math_approx_rsqrt ( x ) - exact ) / exact );
+    }
+    EXPECT ( error <= 1.8e-3 );
+
+    // TEST 8: Approximations perform no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_approx
+( void )
+{
+    test_register ( test_approx , "Testing the error bounds of the approximate math functions." );
+}
+
+f64
+_test_approx_ulps
+(   f32 approx
+,   f64 exact
+)
+{
+    // The ULP of a normal number is its binade (exponent bits only) * 2^-23.
+    math_approx_bits_t ulp;
+    ulp.f = ( f32 ) exact;
+    ulp.u &= 0x7F800000;
+    return abs64 ( approx - exact ) / ( ulp.f * FLOAT_EPSILON );
+}
+
+f32
+_test_approx_sample
+(   f64 min
+,   f64 max
+,   u64 i
+)
+{
+    return min + ( max - min ) * ( i + 0.5 ) / TEST_APPROX_SAMPLES;
+}
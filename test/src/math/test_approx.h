@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/test_approx.h
+ * @brief Tests math/approx.h
+ * (see test/test.h, math/approx.h for additional details)
+ */
+#ifndef TEST_APPROX_H
+#define TEST_APPROX_H
+
+#include "test/test.h"
+
+#include "math/approx.h"
+
+void
+test_register_approx
+( void );
+
+#endif  // TEST_APPROX_H
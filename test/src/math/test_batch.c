@@ -0,0 +1,213 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/test_batch.c
+ * @brief Implementation of the math/test_batch header.
+ * (see math/test_batch.h for additional details)
+ */
+#include "math/test_batch.h"
+
+#include "test/expect.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+
+#include "math/math.h"
+
+#include "platform/cpu.h"
+
+/** @brief Maximum array length tested. */
+#define TEST_BATCH_CAPACITY 1000
+
+/**
+ * @brief Measures the distance between two floating point numbers of the same
+ * sign, in units in the last place.
+ *
+ * @param a A floating point number.
+ * @param b A floating point number.
+ * @return The number of f32 values between a and b.
+ */
+u32
+_test_batch_ulps
+(   f32 a
+,   f32 b
+);
+
+u8
+test_batch
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    // Lengths which exercise the vector loops, the scalar tail, or both, for
+    // every vector width.
+    static const u64 counts[] = { 0 , 1 , 3 , 7 , 16 , 33 , 67 , TEST_BATCH_CAPACITY };
+
+    // Instruction sets to test, widest first, as far as the host supports.
+    static const u32 isas[] = { ~0U
+                              , CPU_FEATURE_AVX2 | CPU_FEATURE_FMA | CPU_FEATURE_SSE2
+                              , CPU_FEATURE_SSE2
+                              , CPU_FEATURE_NEON
+                              , 0
+                              };
+
+    // One element of padding, so that the arrays can be misaligned.
+    static f32 x[ TEST_BATCH_CAPACITY + 1 ];
+    static f32 y[ TEST_BATCH_CAPACITY + 1 ];
+    static f32 dst[ TEST_BATCH_CAPACITY + 1 ];
+    static f64 x64[ TEST_BATCH_CAPACITY + 1 ];
+    static f64 y64[ TEST_BATCH_CAPACITY + 1 ];
+    static f64 dst64[ TEST_BATCH_CAPACITY + 1 ];
+    static f32 positive[ TEST_BATCH_CAPACITY + 1 ];
+
+    // Multiples of 0.5 of small magnitude, so that every sum and dot product
+    // below is exact regardless of the order of addition.
+    for ( u64 i = 0; i < TEST_BATCH_CAPACITY + 1; ++i )
+    {
+        x[ i ] = ( f32 )( i % 37 ) - 12.5f;
+        y[ i ] = 7.0f - ( f32 )( i % 23 ) * 0.5f;
+        x64[ i ] = x[ i ];
+        y64[ i ] = y[ i ];
+        positive[ i ] = abs ( x[ i ] ) + 0.25f;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 m = 0; m < sizeof ( isas ) / sizeof ( isas[ 0 ] ); ++m )
+    {
+        const char* isa = math_batch_dispatch ( isas[ m ] & cpu_features () );
+        EXPECT ( isa != 0 );
+        LOGDEBUG ( "test_batch: Testing %s kernels." , isa );
+
+        for ( u64 k = 0; k < sizeof ( counts ) / sizeof ( counts[ 0 ] ); ++k )
+        {
+            const u64 count = counts[ k ];
+            const f32* a = x + 1;   // Misaligned.
+            const f32* b = y;
+            const f64* a64 = x64 + 1;
+            const f64* b64 = y64;
+
+            // TEST 1: math_abs_array matches math_abs for each element.
+            math_abs_array ( dst , a , count );
+            math_abs_array_64 ( dst64 , a64 , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( dst[ i ] == abs ( a[ i ] ) );
+                EXPECT ( dst64[ i ] == abs64 ( a64[ i ] ) );
+            }
+
+            // TEST 2: math_sqrt_array matches math_sqrt for each element (both are
+            // correctly rounded), including in-place.
+            math_sqrt_array ( dst , dst , count );
+            math_sqrt_array_64 ( dst64 , dst64 , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( dst[ i ] == sqrt ( abs ( a[ i ] ) ) );
+                EXPECT ( dst64[ i ] == sqrt64 ( abs64 ( a64[ i ] ) ) );
+            }
+
+            // TEST 3: math_mix_array matches math_mix for each element (to within
+            // the rounding of a fused multiply-add).
+            math_mix_array ( dst , a , b , 0.25f , count );
+            math_mix_array_64 ( dst64 , a64 , b64 , 0.25 , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( abs ( dst[ i ] - mix ( a[ i ] , b[ i ] , 0.25f ) ) <= 1e-5f );
+                EXPECT ( abs64 ( dst64[ i ] - mix64 ( a64[ i ] , b64[ i ] , 0.25 ) ) <= 1e-12 );
+            }
+
+            // TEST 4: Reductions match a sequential loop.
+            f64 sum = 0.0;
+            f64 dot = 0.0;
+            f64 min = INFINITY_64;
+            f64 max = -INFINITY_64;
+            for ( u64 i = 0; i < count; ++i )
+            {
+                sum += a64[ i ];
+                dot += a64[ i ] * b64[ i ];
+                min = MIN ( min , a64[ i ] );
+                max = MAX ( max , a64[ i ] );
+            }
+            EXPECT ( math_sum_array ( a , count ) == ( f32 ) sum );
+            EXPECT ( math_dot_array ( a , b , count ) == ( f32 ) dot );
+            EXPECT ( math_min_array ( a , count ) == ( f32 ) min );
+            EXPECT ( math_max_array ( a , count ) == ( f32 ) max );
+            EXPECT ( math_sum_array_64 ( a64 , count ) == sum );
+            EXPECT ( math_dot_array_64 ( a64 , b64 , count ) == dot );
+            EXPECT ( math_min_array_64 ( a64 , count ) == min );
+            EXPECT ( math_max_array_64 ( a64 , count ) == max );
+
+            // TEST 5: Approximations match the scalar approximations for each
+            //         element (to within the rounding of fused multiply-adds).
+            const f32* c = positive + 1;    // Misaligned.
+            math_approx_exp_array ( dst , a , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( _test_batch_ulps ( dst[ i ] , math_approx_exp ( a[ i ] ) ) <= 2 );
+            }
+            math_approx_ln_array ( dst , c , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( _test_batch_ulps ( dst[ i ] , math_approx_ln ( c[ i ] ) ) <= 2 );
+            }
+            math_approx_sin_array ( dst , a , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( _test_batch_ulps ( dst[ i ] , math_approx_sin ( a[ i ] ) ) <= 2 );
+            }
+            math_approx_cos_array ( dst , a , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( _test_batch_ulps ( dst[ i ] , math_approx_cos ( a[ i ] ) ) <= 2 );
+            }
+            math_approx_rsqrt_array ( dst , c , count );
+            for ( u64 i = 0; i < count; ++i )
+            {
+                EXPECT ( _test_batch_ulps ( dst[ i ] , math_approx_rsqrt ( c[ i ] ) ) <= 2 );
+            }
+        }
+    }
+
+    // Restore the host's widest instruction set.
+    math_batch_dispatch ( cpu_features () );
+
+    // TEST 6: Reductions of an empty array return the identity.
+    EXPECT ( math_sum_array ( x , 0 ) == 0.0f );
+    EXPECT ( math_min_array ( x , 0 ) == INFINITY );
+    EXPECT ( math_max_array ( x , 0 ) == -INFINITY );
+    EXPECT ( math_max_array_64 ( x64 , 0 ) == -INFINITY_64 );
+
+    // TEST 7: Batch operations perform no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_batch
+( void )
+{
+    test_register_serial ( test_batch , "Testing batch math operations over arrays." );
+}
+
+u32
+_test_batch_ulps
+(   f32 a
+,   f32 b
+)
+{
+    math_approx_bits_t a_;
+    math_approx_bits_t b_;
+    a_.f = a;
+    b_.f = b;
+    return ( a_.u > b_.u ) ? a_.u - b_.u : b_.u - a_.u;
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/test_batch.h
+ * @brief Tests math/batch.h
+ * (see test/test.h, math/batch.h for additional details)
+ */
+#ifndef TEST_BATCH_H
+#define TEST_BATCH_H
+
+#include "test/test.h"
+
+#include "math/batch.h"
+
+void
+test_register_batch
+( void );
+
+#endif  // TEST_BATCH_H
@@ -0,0 +1,181 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/test_prng.c
+ * @brief Implementation of the math/test_prng header.
+ * (see math/test_prng.h for additional details)
+ */
+#include "math/test_prng.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "math/math.h"
+
+/** @brief Number of values drawn by the distribution tests. */
+#define TEST_PRNG_SAMPLES 100000
+
+u8
+test_prng
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    prng_t prng;
+    prng_t prng_;
+    u64 u64s[ 64 ];
+    f32 f32s[ 65 ];
+    f64 f64s[ 64 ];
+    u64 counts[ 10 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: xoshiro256** matches the reference implementation.
+    prng_seed ( &prng , 0 );
+    prng.state[ 0 ] = 1;
+    prng.state[ 1 ] = 2;
+    prng.state[ 2 ] = 3;
+    prng.state[ 3 ] = 4;
+    prng_ = prng;
+    EXPECT_EQ ( 0x2D00 , prng_next ( &prng ) );
+    EXPECT_EQ ( 0x0 , prng_next ( &prng ) );
+    EXPECT_EQ ( 0x5A007080 , prng_next ( &prng ) );
+
+    // TEST 2: xoshiro256** jump matches the reference implementation.
+    prng_jump ( &prng_ );
+    EXPECT_EQ ( 0xBBD2F312298443D8ULL , prng_next ( &prng_ ) );
+
+    // TEST 3: PCG64 matches the reference implementation.
+    _prng_seed ( &prng , 0 , PRNG_PCG64 );
+    prng.state[ 0 ] = 1;
+    prng.state[ 1 ] = 0;
+    prng.state[ 2 ] = 3;
+    prng.state[ 3 ] = 0;
+    prng_ = prng;
+    EXPECT_EQ ( 0xEC60E53261800AABULL , prng_next ( &prng ) );
+    EXPECT_EQ ( 0x3EFB1C429CEFD272ULL , prng_next ( &prng ) );
+    EXPECT_EQ ( 0x05322331643FF3D4ULL , prng_next ( &prng ) );
+
+    // TEST 4: PCG64 jump matches the reference implementation.
+    prng_jump ( &prng_ );
+    EXPECT_EQ ( 0x8E52423865220ED9ULL , prng_next ( &prng_ ) );
+
+    // TEST 5: Equal seeds produce equal sequences; different seeds do not.
+    for ( PRNG_ALGORITHM algorithm = 0; algorithm < PRNG_ALGORITHM_COUNT; ++algorithm )
+    {
+        _prng_seed ( &prng , 12345 , algorithm );
+        _prng_seed ( &prng_ , 12345 , algorithm );
+        for ( u32 i = 0; i < 100; ++i )
+        {
+            EXPECT_EQ ( prng_next ( &prng ) , prng_next ( &prng_ ) );
+        }
+        _prng_seed ( &prng_ , 12346 , algorithm );
+        EXPECT_NEQ ( prng_next ( &prng ) , prng_next ( &prng_ ) );
+    }
+
+    // TEST 6: prng_fill_u64 and prng_fill_f64 produce the same values as single draws.
+    for ( PRNG_ALGORITHM algorithm = 0; algorithm < PRNG_ALGORITHM_COUNT; ++algorithm )
+    {
+        _prng_seed ( &prng , 99 , algorithm );
+        prng_ = prng;
+        prng_fill_u64 ( &prng , u64s , 64 );
+        for ( u32 i = 0; i < 64; ++i )
+        {
+            EXPECT_EQ ( prng_next ( &prng_ ) , u64s[ i ] );
+        }
+        prng_fill_f64 ( &prng , f64s , 64 );
+        for ( u32 i = 0; i < 64; ++i )
+        {
+            EXPECT_EQ ( prng_f64 ( &prng_ ) , f64s[ i ] );
+        }
+        EXPECT_EQ ( prng_next ( &prng_ ) , prng_next ( &prng ) );
+    }
+
+    // TEST 7: prng_f32, prng_f64, and prng_fill_f32 produce values in [ 0 , 1 ).
+    prng_seed ( &prng , 7 );
+    for ( u32 i = 0; i < TEST_PRNG_SAMPLES; ++i )
+    {
+        const f32 x = prng_f32 ( &prng );
+        const f64 y = prng_f64 ( &prng );
+        EXPECT ( x >= 0.0f && x < 1.0f );
+        EXPECT ( y >= 0.0 && y < 1.0 );
+    }
+    prng_fill_f32 ( &prng , f32s , 65 );
+    for ( u32 i = 0; i < 65; ++i )
+    {
+        EXPECT ( f32s[ i ] >= 0.0f && f32s[ i ] < 1.0f );
+    }
+
+    // TEST 8: prng_bounded is uniform, and prng_range includes both bounds.
+    memory_clear ( counts , sizeof ( counts ) );
+    for ( u32 i = 0; i < TEST_PRNG_SAMPLES; ++i )
+    {
+        const u64 x = prng_bounded ( &prng , 10 );
+        EXPECT ( x < 10 );
+        counts[ x ] += 1;
+    }
+    for ( u32 i = 0; i < 10; ++i )
+    {
+        // Expected 10000 each; allow a generous margin (about 10 standard deviations).
+        EXPECT ( counts[ i ] > 9000 && counts[ i ] < 11000 );
+    }
+    bool min_seen = false;
+    bool max_seen = false;
+    for ( u32 i = 0; i < 1000; ++i )
+    {
+        const i64 x = prng_range ( &prng , -3 , 3 );
+        EXPECT ( x >= -3 && x <= 3 );
+        min_seen |= ( x == -3 );
+        max_seen |= ( x == 3 );
+    }
+    EXPECT ( min_seen );
+    EXPECT ( max_seen );
+
+    // TEST 9: prng_bounded handles the full 64-bit range and bounds above 2^63.
+    for ( u32 i = 0; i < 1000; ++i )
+    {
+        EXPECT ( prng_bounded ( &prng , 0xC000000000000000ULL ) < 0xC000000000000000ULL );
+    }
+    prng_range ( &prng , ( i64 ) 0x8000000000000000ULL , 0x7FFFFFFFFFFFFFFFLL );
+
+    // TEST 10: The thread-local generator backs the math_random family.
+    EXPECT_NEQ ( 0 , prng_local () );
+    EXPECT_EQ ( prng_local () , prng_local () );
+    for ( u32 i = 0; i < 1000; ++i )
+    {
+        EXPECT ( random () >= 0 );
+        const i32 x = random2 ( -5 , 5 );
+        EXPECT ( x >= -5 && x <= 5 );
+        const f32 y = randomf2 ( -1.0f , 1.0f );
+        EXPECT ( y >= -1.0f && y <= 1.0f );
+        const i64 z = random64_2 ( -5 , 5 );
+        EXPECT ( z >= -5 && z <= 5 );
+    }
+
+    // TEST 11: prng_seed falls back on xoshiro256** for an invalid algorithm.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    _prng_seed ( &prng , 1 , PRNG_ALGORITHM_COUNT );
+    EXPECT_EQ ( PRNG_XOSHIRO256SS , prng.algorithm );
+
+    // TEST 12: prng performs no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_prng
+( void )
+{
+    test_register ( test_prng , "Testing pseudorandom number generators." );
+}
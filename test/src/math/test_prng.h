@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file math/test_prng.h
+ * @brief Tests math/prng.h
+ * (see test/test.h, math/prng.h for additional details)
+ */
+#ifndef TEST_PRNG_H
+#define TEST_PRNG_H
+
+#include "test/test.h"
+
+#include "math/prng.h"
+
+void
+test_register_prng
+( void );
+
+#endif  // TEST_PRNG_H
@@ -0,0 +1,127 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/bench_dynamic_allocator.c
+ * @brief Implementation of the memory/bench_dynamic_allocator header.
+ * (see memory/bench_dynamic_allocator.h for additional details)
+ */
+#include "memory/bench_dynamic_allocator.h"
+
+#include "core/memory.h"
+
+#include "math/prng.h"
+
+/** @brief Maximum size of a block allocated by a dynamic allocator benchmark. */
+#define BENCH_DYNAMIC_ALLOCATOR_BLOCK_MAX 512
+
+/** @brief Number of pregenerated block sizes cycled through by bench_dynamic_allocator_allocate. */
+#define BENCH_DYNAMIC_ALLOCATOR_SIZE_COUNT 64
+
+/**
+ * @brief Type definition for the fixture of a dynamic allocator benchmark.
+ * Setup allocates twice the given number of fragments, then frees every other
+ * one, so that the free space is split into that many holes.
+ */
+typedef struct
+{
+    FREELIST_MODE           mode;
+    u64                     fragments;
+    dynamic_allocator_t*    allocator;
+    u64                     sizes[ BENCH_DYNAMIC_ALLOCATOR_SIZE_COUNT ];
+}
+bench_dynamic_allocator_t;
+
+/** @brief Fixtures for bench_dynamic_allocator_allocate. */
+static bench_dynamic_allocator_t bench_dynamic_allocator_args[] = { { FREELIST_MODE_FIRST_FIT , 0 , 0 , { 0 } }
+                                                                  , { FREELIST_MODE_FIRST_FIT , 1024 , 0 , { 0 } }
+                                                                  , { FREELIST_MODE_FIRST_FIT , 16384 , 0 , { 0 } }
+                                                                  , { FREELIST_MODE_SEGREGATED_FIT , 0 , 0 , { 0 } }
+                                                                  , { FREELIST_MODE_SEGREGATED_FIT , 1024 , 0 , { 0 } }
+                                                                  , { FREELIST_MODE_SEGREGATED_FIT , 16384 , 0 , { 0 } }
+                                                                  };
+
+bool
+bench_dynamic_allocator_setup
+(   void* args
+)
+{
+    bench_dynamic_allocator_t* fixture = args;
+    const u64 capacity = 4 * ( ( *fixture ).fragments + 1 )
+                       * ( BENCH_DYNAMIC_ALLOCATOR_BLOCK_MAX + dynamic_allocator_header_size () )
+                       ;
+    if ( !_dynamic_allocator_create ( capacity , ( *fixture ).mode , 0 , 0 , 0 , &( *fixture ).allocator ) )
+    {
+        return false;
+    }
+
+    prng_t prng;
+    prng_seed ( &prng , ( *fixture ).fragments );
+    for ( u64 i = 0; i < BENCH_DYNAMIC_ALLOCATOR_SIZE_COUNT; ++i )
+    {
+        ( *fixture ).sizes[ i ] = 16 + prng_bounded ( &prng , BENCH_DYNAMIC_ALLOCATOR_BLOCK_MAX - 16 );
+    }
+
+    // Fragment the free space.
+    const u64 count = 2 * ( *fixture ).fragments;
+    void** blocks = memory_allocate ( ( count + 1 ) * sizeof ( void* ) , MEMORY_TAG_ARRAY );
+    bool success = true;
+    for ( u64 i = 0; success && i < count; ++i )
+    {
+        blocks[ i ] = dynamic_allocator_allocate ( ( *fixture ).allocator
+                                                 , ( *fixture ).sizes[ i % BENCH_DYNAMIC_ALLOCATOR_SIZE_COUNT ]
+                                                 );
+        success = blocks[ i ];
+    }
+    for ( u64 i = 0; success && i < count; i += 2 )
+    {
+        success = dynamic_allocator_free ( ( *fixture ).allocator , blocks[ i ] );
+    }
+    memory_free ( blocks , ( count + 1 ) * sizeof ( void* ) , MEMORY_TAG_ARRAY );
+    if ( !success )
+    {
+        dynamic_allocator_destroy ( &( *fixture ).allocator );
+    }
+    return success;
+}
+
+void
+bench_dynamic_allocator_teardown
+(   void* args
+)
+{
+    dynamic_allocator_destroy ( &( *( ( bench_dynamic_allocator_t* ) args ) ).allocator );
+}
+
+bool
+bench_dynamic_allocator_allocate
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_dynamic_allocator_t* fixture = args;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        // Sizes above those freed during setup force a search past the holes.
+        const u64 size = ( *fixture ).sizes[ i % BENCH_DYNAMIC_ALLOCATOR_SIZE_COUNT ]
+                       + ( ( i & 1 ) ? BENCH_DYNAMIC_ALLOCATOR_BLOCK_MAX : 0 )
+                       ;
+        void* memory = dynamic_allocator_allocate ( ( *fixture ).allocator , size );
+        BENCH_DO_NOT_OPTIMIZE ( memory );
+        if ( !memory || !dynamic_allocator_free ( ( *fixture ).allocator , memory ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+bench_register_dynamic_allocator
+( void )
+{
+    _bench_register ( bench_dynamic_allocator_allocate , bench_dynamic_allocator_setup , bench_dynamic_allocator_teardown , &bench_dynamic_allocator_args[ 0 ] , "dynamic_allocator_allocate + dynamic_allocator_free: first-fit, unfragmented." );
+    _bench_register ( bench_dynamic_allocator_allocate , bench_dynamic_allocator_setup , bench_dynamic_allocator_teardown , &bench_dynamic_allocator_args[ 1 ] , "dynamic_allocator_allocate + dynamic_allocator_free: first-fit, 1024 holes." );
+    _bench_register ( bench_dynamic_allocator_allocate , bench_dynamic_allocator_setup , bench_dynamic_allocator_teardown , &bench_dynamic_allocator_args[ 2 ] , "dynamic_allocator_allocate + dynamic_allocator_free: first-fit, 16384 holes." );
+    _bench_register ( bench_dynamic_allocator_allocate , bench_dynamic_allocator_setup , bench_dynamic_allocator_teardown , &bench_dynamic_allocator_args[ 3 ] , "dynamic_allocator_allocate + dynamic_allocator_free: segregated-fit, unfragmented." );
+    _bench_register ( bench_dynamic_allocator_allocate , bench_dynamic_allocator_setup , bench_dynamic_allocator_teardown , &bench_dynamic_allocator_args[ 4 ] , "dynamic_allocator_allocate + dynamic_allocator_free: segregated-fit, 1024 holes." );
+    _bench_register ( bench_dynamic_allocator_allocate , bench_dynamic_allocator_setup , bench_dynamic_allocator_teardown , &bench_dynamic_allocator_args[ 5 ] , "dynamic_allocator_allocate + dynamic_allocator_free: segregated-fit, 16384 holes." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/bench_dynamic_allocator.h
+ * @brief Benchmarks memory/dynamic_allocator.h
+ * (see test/bench.h, memory/dynamic_allocator.h for additional details)
+ */
+#ifndef BENCH_DYNAMIC_ALLOCATOR_H
+#define BENCH_DYNAMIC_ALLOCATOR_H
+
+#include "test/bench.h"
+
+#include "memory/dynamic_allocator.h"
+
+void
+bench_register_dynamic_allocator
+( void );
+
+#endif  // BENCH_DYNAMIC_ALLOCATOR_H
@@ -0,0 +1,76 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/bench_linear_allocator.c
+ * @brief Implementation of the memory/bench_linear_allocator header.
+ * (see memory/bench_linear_allocator.h for additional details)
+ */
+#include "memory/bench_linear_allocator.h"
+
+/** @brief Capacity of the allocator used by bench_linear_allocator_allocate. */
+#define BENCH_LINEAR_ALLOCATOR_CAPACITY MiB ( 1 )
+
+/** @brief Type definition for the fixture of a linear allocator benchmark. */
+typedef struct
+{
+    u64                     size;   // Bytes per allocation.
+    linear_allocator_t*     allocator;
+}
+bench_linear_allocator_t;
+
+/** @brief Fixtures for bench_linear_allocator_allocate. */
+static bench_linear_allocator_t bench_linear_allocator_args[] = { { 16 , 0 } , { 256 , 0 } , { 4096 , 0 } };
+
+bool
+bench_linear_allocator_setup
+(   void* args
+)
+{
+    return linear_allocator_create ( BENCH_LINEAR_ALLOCATOR_CAPACITY
+                                   , 0
+                                   , 0
+                                   , &( *( ( bench_linear_allocator_t* ) args ) ).allocator
+                                   );
+}
+
+void
+bench_linear_allocator_teardown
+(   void* args
+)
+{
+    linear_allocator_destroy ( &( *( ( bench_linear_allocator_t* ) args ) ).allocator );
+}
+
+bool
+bench_linear_allocator_allocate
+(   void*   args
+,   u64     iterations
+)
+{
+    const bench_linear_allocator_t* fixture = args;
+    const u64 capacity = BENCH_LINEAR_ALLOCATOR_CAPACITY / ( *fixture ).size;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        // Free everything whenever the allocator fills.
+        if ( i % capacity == capacity - 1 )
+        {
+            linear_allocator_free ( ( *fixture ).allocator );
+        }
+        void* memory = linear_allocator_allocate ( ( *fixture ).allocator , ( *fixture ).size );
+        if ( !memory )
+        {
+            return false;
+        }
+        BENCH_DO_NOT_OPTIMIZE ( memory );
+    }
+    linear_allocator_free ( ( *fixture ).allocator );
+    return true;
+}
+
+void
+bench_register_linear_allocator
+( void )
+{
+    _bench_register ( bench_linear_allocator_allocate , bench_linear_allocator_setup , bench_linear_allocator_teardown , &bench_linear_allocator_args[ 0 ] , "linear_allocator_allocate: 16 B." );
+    _bench_register ( bench_linear_allocator_allocate , bench_linear_allocator_setup , bench_linear_allocator_teardown , &bench_linear_allocator_args[ 1 ] , "linear_allocator_allocate: 256 B." );
+    _bench_register ( bench_linear_allocator_allocate , bench_linear_allocator_setup , bench_linear_allocator_teardown , &bench_linear_allocator_args[ 2 ] , "linear_allocator_allocate: 4 KiB." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/bench_linear_allocator.h
+ * @brief Benchmarks memory/linear_allocator.h
+ * (see test/bench.h, memory/linear_allocator.h for additional details)
+ */
+#ifndef BENCH_LINEAR_ALLOCATOR_H
+#define BENCH_LINEAR_ALLOCATOR_H
+
+#include "test/bench.h"
+
+#include "memory/linear_allocator.h"
+
+void
+bench_register_linear_allocator
+( void );
+
+#endif  // BENCH_LINEAR_ALLOCATOR_H
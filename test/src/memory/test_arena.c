@@ -0,0 +1,289 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/test_arena.c
+ * @brief Implementation of the memory/test_arena header.
+ * (see memory/test_arena.h for additional details)
+ */
+#include "memory/test_arena.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+u8
+test_arena_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 arena_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    arena_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARENA );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    arena_t* arena;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: arena_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( arena_create ( KiB ( 1 ) , 0 ) );
+    EXPECT_NOT ( arena_create ( 0 , &arena ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: arena_create succeeds, and allocates the first block up front.
+    arena = 0;
+    EXPECT ( arena_create ( KiB ( 1 ) , &arena ) );
+    EXPECT_NEQ ( 0 , arena );
+    EXPECT_EQ ( KiB ( 1 ) , arena_capacity ( arena ) );
+    EXPECT_EQ ( 0 , arena_allocated ( arena ) );
+    EXPECT ( memory_amount_allocated ( MEMORY_TAG_ARENA ) > arena_amount_allocated + KiB ( 1 ) );
+
+    // TEST 3: arena_create rounds the block size up to the default alignment.
+    arena_t* arena_ = 0;
+    EXPECT ( arena_create ( 1 , &arena_ ) );
+    EXPECT_EQ ( ARENA_DEFAULT_ALIGNMENT , arena_capacity ( arena_ ) );
+    arena_destroy ( &arena_ );
+    EXPECT_EQ ( 0 , arena_ );
+
+    // TEST 4: arena_destroy frees every block, and handles invalid arguments.
+    arena_destroy ( &arena );
+    EXPECT_EQ ( 0 , arena );
+    arena_destroy ( &arena );
+    arena_destroy ( 0 );
+
+    // TEST 5: Global allocator state is unchanged.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( arena_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARENA ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_arena_allocate
+( void )
+{
+    u64 global_amount_allocated;
+    u64 arena_amount_allocated;
+    u64 global_allocation_count;
+    u64 global_allocation_count_;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    arena_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARENA );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 block_size = KiB ( 1 );
+
+    arena_t* arena = 0;
+    EXPECT ( arena_create ( block_size , &arena ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: arena_allocate handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , arena_allocate ( arena , 0 ) );
+    EXPECT_EQ ( 0 , arena_allocate_aligned ( arena , 8 , 0 ) );
+    EXPECT_EQ ( 0 , arena_allocate_aligned ( arena , 8 , 24 ) );
+    EXPECT_EQ ( 0 , arena_allocated ( arena ) );
+
+    // TEST 2: arena_allocate serves aligned memory from the current block.
+    global_allocation_count_ = MEMORY_ALLOCATION_COUNT;
+    u8* a = arena_allocate ( arena , 1 );
+    u8* b = arena_allocate ( arena , 1 );
+    EXPECT_NEQ ( 0 , a );
+    EXPECT_NEQ ( 0 , b );
+    EXPECT_EQ ( 0 , ( u64 ) a % ARENA_DEFAULT_ALIGNMENT );
+    EXPECT_EQ ( 0 , ( u64 ) b % ARENA_DEFAULT_ALIGNMENT );
+    EXPECT_EQ ( a + ARENA_DEFAULT_ALIGNMENT , b );
+    u8* c = arena_allocate_aligned ( arena , 1 , 1 );
+    EXPECT_EQ ( b + 1 , c );
+    u8* d = arena_allocate_aligned ( arena , 8 , 256 );
+    EXPECT_EQ ( 0 , ( u64 ) d % 256 );
+    EXPECT_EQ ( global_allocation_count_ , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 3: arena_allocate chains a new block when the current one is full,
+    //         and the memory remains writable.
+    arena_clear ( arena );
+    for ( u64 i = 0; i < 8; ++i )
+    {
+        u8* x = arena_allocate ( arena , block_size / 2 );
+        EXPECT_NEQ ( 0 , x );
+        memory_set ( x , i , block_size / 2 );
+    }
+    EXPECT_EQ ( 4 * block_size , arena_capacity ( arena ) );
+    EXPECT_EQ ( 4 * block_size , arena_allocated ( arena ) );
+    EXPECT_EQ ( global_allocation_count_ + 3 , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 4: arena_allocate serves an oversized allocation from a block of its own.
+    u8* e = arena_allocate ( arena , 4 * block_size );
+    EXPECT_NEQ ( 0 , e );
+    memory_set ( e , 0xFF , 4 * block_size );
+    EXPECT ( arena_capacity ( arena ) >= 8 * block_size );
+    EXPECT_EQ ( global_allocation_count_ + 4 , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: arena_clear releases every allocation, but keeps the blocks.
+    const u64 capacity = arena_capacity ( arena );
+    arena_clear ( arena );
+    EXPECT_EQ ( 0 , arena_allocated ( arena ) );
+    EXPECT_EQ ( capacity , arena_capacity ( arena ) );
+
+    // TEST 6: Refilling a cleared arena reuses its blocks.
+    for ( u64 i = 0; i < 8; ++i )
+    {
+        EXPECT_NEQ ( 0 , arena_allocate ( arena , block_size / 2 ) );
+    }
+    EXPECT_NEQ ( 0 , arena_allocate ( arena , 4 * block_size ) );
+    EXPECT_EQ ( capacity , arena_capacity ( arena ) );
+    EXPECT_EQ ( global_allocation_count_ + 4 , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    arena_destroy ( &arena );
+
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( arena_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARENA ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_arena_mark_and_rewind
+( void )
+{
+    u64 global_amount_allocated;
+    u64 arena_amount_allocated;
+    u64 global_allocation_count;
+    u64 global_allocation_count_;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    arena_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARENA );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 block_size = KiB ( 1 );
+
+    arena_t* arena = 0;
+    EXPECT ( arena_create ( block_size , &arena ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: arena_rewind releases allocations made since a checkpoint.
+    u8* a = arena_allocate ( arena , 64 );
+    EXPECT_NEQ ( 0 , a );
+    const arena_mark_t mark = arena_mark ( arena );
+    u8* b = arena_allocate ( arena , 64 );
+    EXPECT_NEQ ( 0 , b );
+    EXPECT_EQ ( 128 , arena_allocated ( arena ) );
+    arena_rewind ( arena , mark );
+    EXPECT_EQ ( 64 , arena_allocated ( arena ) );
+    EXPECT_EQ ( b , arena_allocate ( arena , 64 ) );
+
+    // TEST 2: Checkpoints nest.
+    arena_rewind ( arena , mark );
+    const arena_mark_t outer = arena_mark ( arena );
+    EXPECT_NEQ ( 0 , arena_allocate ( arena , 100 ) );
+    const arena_mark_t inner = arena_mark ( arena );
+    const u64 allocated = arena_allocated ( arena );
+    EXPECT_NEQ ( 0 , arena_allocate ( arena , 100 ) );
+    arena_rewind ( arena , inner );
+    EXPECT_EQ ( allocated , arena_allocated ( arena ) );
+    arena_rewind ( arena , outer );
+    EXPECT_EQ ( 64 , arena_allocated ( arena ) );
+
+    // TEST 3: arena_rewind releases allocations across blocks, and repeated
+    //         scopes reuse the blocks without allocating.
+    for ( u32 i = 0; i < 4; ++i )
+    {
+        const arena_mark_t scope = arena_mark ( arena );
+        if ( !i )
+        {
+            global_allocation_count_ = MEMORY_ALLOCATION_COUNT;
+        }
+        for ( u32 j = 0; j < 10; ++j )
+        {
+            EXPECT_NEQ ( 0 , arena_allocate ( arena , 300 ) );
+        }
+        arena_rewind ( arena , scope );
+        EXPECT_EQ ( 64 , arena_allocated ( arena ) );
+        EXPECT_EQ ( a , ( u8* ) arena_allocate ( arena , 1 ) - 64 );
+        arena_rewind ( arena , scope );
+    }
+    EXPECT_EQ ( global_allocation_count_ + 3 , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    arena_destroy ( &arena );
+
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( arena_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARENA ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_arena_scratch
+( void )
+{
+    u64 global_amount_allocated;
+    u64 arena_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    arena_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARENA );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: arena_scratch creates the calling thread's scratch arena on first use.
+    arena_t* scratch = arena_scratch ();
+    EXPECT_NEQ ( 0 , scratch );
+    EXPECT_EQ ( scratch , arena_scratch () );
+    EXPECT_EQ ( ARENA_DEFAULT_BLOCK_SIZE , arena_capacity ( scratch ) );
+
+    // TEST 2: The scratch arena supports scoped temporaries.
+    const arena_mark_t mark = arena_mark ( scratch );
+    EXPECT_NEQ ( 0 , arena_allocate ( scratch , 128 ) );
+    arena_rewind ( scratch , mark );
+    EXPECT_EQ ( 0 , arena_allocated ( scratch ) );
+
+    // TEST 3: arena_scratch_destroy frees the scratch arena, and handles a
+    //         thread which has none.
+    arena_scratch_destroy ();
+    arena_scratch_destroy ();
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( arena_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARENA ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_arena
+( void )
+{
+    test_register ( test_arena_create_and_destroy , "Creating or destroying an arena." );
+    test_register ( test_arena_allocate , "Allocating memory from an arena." );
+    test_register ( test_arena_mark_and_rewind , "Rewinding an arena to a checkpoint." );
+    test_register ( test_arena_scratch , "Using the per-thread scratch arena." );
+}
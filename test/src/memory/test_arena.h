@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/test_arena.h
+ * @brief Tests memory/arena.h
+ * (see test/test.h, memory/arena.h for additional details)
+ */
+#ifndef TEST_ARENA_H
+#define TEST_ARENA_H
+
+#include "test/test.h"
+
+#include "memory/arena.h"
+
+void
+test_register_arena
+( void );
+
+#endif  // TEST_ARENA_H
@@ -269,6 +269,23 @@ test_dynamic_allocator_allocate_and_free
     // TEST 4.2: Allocator has correct amount of free space.
     EXPECT_EQ ( total_allocator_size , dynamic_allocator_query_free ( allocator ) );
 
+    // TEST 5: dynamic_allocator_free_sized.
+
+    // TEST 5.1: dynamic_allocator_free_sized fails if the size or alignment does not match the allocation.
+    blk = dynamic_allocator_allocate_aligned ( allocator , 10 , alignment );
+    EXPECT_NEQ ( 0 , blk );
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( dynamic_allocator_free_sized ( allocator , blk , 11 , alignment ) );
+    EXPECT_NOT ( dynamic_allocator_free_sized ( allocator , blk , 10 , alignment * 2 ) );
+    EXPECT_NOT ( dynamic_allocator_free_sized ( allocator , &allocator , 10 , alignment ) );
+    EXPECT_EQ ( allocator_size - 10 , dynamic_allocator_query_free ( allocator ) );
+
+    // TEST 5.2: dynamic_allocator_free_sized succeeds.
+    EXPECT ( dynamic_allocator_free_sized ( allocator , blk , 10 , alignment ) );
+
+    // TEST 5.3: Allocator has correct amount of free space.
+    EXPECT_EQ ( total_allocator_size , dynamic_allocator_query_free ( allocator ) );
+
     // End test.
     ////////////////////////////////////////////////////////////////////////////
 
@@ -1071,12 +1088,168 @@ test_dynamic_allocator_multiple_allocation_and_free_aligned_different_alignments
 
     return true;
 }
+
+u8
+test_dynamic_allocator_reallocate
+( void )
+{
+    u64 global_amount_allocated;
+    u64 allocator_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    allocator_amount_allocated = memory_amount_allocated ( MEMORY_TAG_DYNAMIC_ALLOCATOR );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u16 alignment = 16;
+    const u64 header_size = dynamic_allocator_header_size () + alignment;
+    const u64 total_allocator_size = 1024;
+
+    dynamic_allocator_t* allocator = 0;
+    u64 blk_size;
+    u16 blk_alignment;
+
+    EXPECT ( dynamic_allocator_create ( total_allocator_size , 0 , 0 , &allocator ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , allocator );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    u8* blk0 = dynamic_allocator_allocate_aligned ( allocator , 64 , alignment );
+    EXPECT_NEQ ( 0 , blk0 );
+    for ( u8 i = 0; i < 64; ++i )
+    {
+        blk0[ i ] = i;
+    }
+
+    // TEST 1: dynamic_allocator_reallocate grows a block in place if the following space is free.
+    EXPECT_EQ ( blk0 , dynamic_allocator_reallocate ( allocator , blk0 , 256 ) );
+    EXPECT ( dynamic_allocator_size_alignment ( blk0 , &blk_size , &blk_alignment ) );
+    EXPECT_EQ ( 256 , blk_size );
+    EXPECT_EQ ( alignment , blk_alignment );
+    EXPECT_EQ ( total_allocator_size - 256 - header_size , dynamic_allocator_query_free ( allocator ) );
+
+    // TEST 2: dynamic_allocator_reallocate shrinks a block in place.
+    EXPECT_EQ ( blk0 , dynamic_allocator_reallocate ( allocator , blk0 , 32 ) );
+    EXPECT ( dynamic_allocator_size_alignment ( blk0 , &blk_size , &blk_alignment ) );
+    EXPECT_EQ ( 32 , blk_size );
+    EXPECT_EQ ( total_allocator_size - 32 - header_size , dynamic_allocator_query_free ( allocator ) );
+
+    // TEST 3: dynamic_allocator_resize fails on a block which cannot grow in place; dynamic_allocator_reallocate moves it, preserving its content and alignment.
+    u8* blk1 = dynamic_allocator_allocate_aligned ( allocator , 64 , alignment );
+    EXPECT_NEQ ( 0 , blk1 );
+    EXPECT_NOT ( dynamic_allocator_resize ( allocator , blk0 , 128 ) );
+    EXPECT ( dynamic_allocator_size_alignment ( blk0 , &blk_size , &blk_alignment ) );
+    EXPECT_EQ ( 32 , blk_size );
+    u8* blk2 = dynamic_allocator_reallocate ( allocator , blk0 , 128 );
+    EXPECT_NEQ ( 0 , blk2 );
+    EXPECT_NEQ ( blk0 , blk2 );
+    EXPECT_EQ ( 0 , ( ( u64 ) blk2 ) % alignment );
+    for ( u8 i = 0; i < 32; ++i )
+    {
+        EXPECT_EQ ( i , blk2[ i ] );
+    }
+    EXPECT_EQ ( total_allocator_size - 192 - 2 * header_size , dynamic_allocator_query_free ( allocator ) );
+
+    // TEST 4: dynamic_allocator_reallocate fails without freeing the block if there is no space.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , dynamic_allocator_reallocate ( allocator , blk1 , total_allocator_size ) );
+    EXPECT_EQ ( total_allocator_size - 192 - 2 * header_size , dynamic_allocator_query_free ( allocator ) );
+
+    // TEST 5: Resized blocks can be freed.
+    EXPECT ( dynamic_allocator_free ( allocator , blk1 ) );
+    EXPECT ( dynamic_allocator_free_sized ( allocator , blk2 , 128 , alignment ) );
+    EXPECT_EQ ( total_allocator_size , dynamic_allocator_query_free ( allocator ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    dynamic_allocator_destroy ( &allocator );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( allocator_amount_allocated , memory_amount_allocated ( MEMORY_TAG_DYNAMIC_ALLOCATOR ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_dynamic_allocator_many_holes
+( void )
+{
+    u64 global_amount_allocated;
+    u64 allocator_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    allocator_amount_allocated = memory_amount_allocated ( MEMORY_TAG_DYNAMIC_ALLOCATOR );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    // The backend freelist of an allocator of this capacity initially holds
+    // far fewer nodes than there are holes below.
+    const u64 capacity = KiB ( 64 );
+    const u64 block_count = 1024;
+    const u64 block_size = 16;
+
+    dynamic_allocator_t* allocator = 0;
+    void* blocks[ 1024 ];
+
+    EXPECT ( dynamic_allocator_create ( capacity , 0 , 0 , &allocator ) );
+
+    // Verify there was no memory error prior to the test.
+    EXPECT_NEQ ( 0 , allocator );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    for ( u64 i = 0; i < block_count; ++i )
+    {
+        blocks[ i ] = dynamic_allocator_allocate ( allocator , block_size );
+        EXPECT_NEQ ( 0 , blocks[ i ] );
+    }
+
+    // TEST 1: Freeing into many small holes never runs out of freelist nodes.
+    for ( u64 i = 0; i < block_count; i += 2 )
+    {
+        EXPECT ( dynamic_allocator_free ( allocator , blocks[ i ] ) );
+        EXPECT_NEQ ( 0 , dynamic_allocator_query_unused_nodes ( allocator ) );
+    }
+
+    // TEST 2: The holes coalesce once the remaining blocks are freed, except
+    //         for the node storage carved from the allocator.
+    for ( u64 i = 1; i < block_count; i += 2 )
+    {
+        EXPECT ( dynamic_allocator_free ( allocator , blocks[ i ] ) );
+    }
+    EXPECT ( dynamic_allocator_query_free ( allocator ) < capacity );
+    EXPECT ( dynamic_allocator_query_free ( allocator ) > block_count * block_size );
+    EXPECT_NEQ ( 0 , dynamic_allocator_allocate ( allocator , block_count * block_size ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    dynamic_allocator_destroy ( &allocator );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( allocator_amount_allocated , memory_amount_allocated ( MEMORY_TAG_DYNAMIC_ALLOCATOR ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 void
 test_register_dynamic_allocator
 ( void )
 {
     test_register ( test_dynamic_allocator_create_and_destroy , "Creating or destroying a dynamic allocator." ); 
     test_register ( test_dynamic_allocator_allocate_and_free , "Allocating or freeing memory managed by a dynamic allocator." );
+    test_register ( test_dynamic_allocator_reallocate , "Resizing memory managed by a dynamic allocator." );
     test_register ( test_dynamic_allocator_single_allocation_all_space , "Testing dynamic allocator with a single allocation." );
     test_register ( test_dynamic_allocator_multiple_allocation_all_space , "Testing dynamic allocator with multiple allocations." );
     test_register ( test_dynamic_allocator_multiple_requests_too_many , "Testing dynamic allocator overflow handling (1)." );
@@ -1085,4 +1258,5 @@ test_register_dynamic_allocator
     test_register ( test_dynamic_allocator_multiple_allocation_aligned_different_alignments , "Testing dynamic allocator with multiple aligned allocations, each with different alignments." );
     test_register ( test_dynamic_allocator_multiple_allocation_aligned_different_alignments_random , "Testing dynamic allocator with multiple aligned allocations, each with different alignments, allocated in random order." );
     test_register ( test_dynamic_allocator_multiple_allocation_and_free_aligned_different_alignments_random , "Testing dynamic allocator with multiple aligned allocations, each with different alignments, allocated and freed in random order." );
+    test_register ( test_dynamic_allocator_many_holes , "Testing dynamic allocator with many small free blocks." );
 }
\ No newline at end of file
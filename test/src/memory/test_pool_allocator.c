@@ -0,0 +1,281 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/test_pool_allocator.c
+ * @brief Implementation of the memory/test_pool_allocator header.
+ * (see memory/test_pool_allocator.h for additional details)
+ */
+#include "memory/test_pool_allocator.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+u8
+test_pool_allocator_create_and_destroy
+( void )
+{
+    u64 global_amount_allocated;
+    u64 allocator_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    allocator_amount_allocated = memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    pool_allocator_t* allocator;
+    void* memory;
+    u64 memory_requirement;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: pool_allocator_create handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( pool_allocator_create ( 0 , 8 , 0 , 0 , &allocator ) );
+    EXPECT_NOT ( pool_allocator_create ( 8 , 0 , 0 , 0 , &allocator ) );
+    EXPECT_NOT ( pool_allocator_create ( 8 , 8 , 0 , 0 , 0 ) );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: pool_allocator_create can be used to query the memory requirement.
+    memory_requirement = 0;
+    EXPECT ( pool_allocator_create ( 24 , 8 , &memory_requirement , 0 , 0 ) );
+    EXPECT ( memory_requirement >= 24 * 8 );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 3: Auto-allocated pool allocator.
+    allocator = 0;
+    EXPECT ( pool_allocator_create ( 24 , 8 , 0 , 0 , &allocator ) );
+    EXPECT_NEQ ( 0 , allocator );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+    EXPECT_EQ ( allocator_amount_allocated + memory_requirement , memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR ) );
+    EXPECT ( pool_allocator_owns_memory ( allocator ) );
+    EXPECT_EQ ( 24 , pool_allocator_stride ( allocator ) );
+    EXPECT_EQ ( 8 , pool_allocator_capacity ( allocator ) );
+    EXPECT_EQ ( 0 , pool_allocator_allocated ( allocator ) );
+    pool_allocator_destroy ( &allocator );
+    EXPECT_EQ ( 0 , allocator );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 4: Pre-allocated pool allocator.
+    memory = memory_allocate ( memory_requirement , MEMORY_TAG_POOL_ALLOCATOR );
+    allocator = 0;
+    EXPECT ( pool_allocator_create ( 24 , 8 , 0 , memory , &allocator ) );
+    EXPECT_EQ ( memory , allocator );
+    EXPECT_NOT ( pool_allocator_owns_memory ( allocator ) );
+    pool_allocator_destroy ( &allocator );
+    EXPECT_EQ ( 0 , allocator );
+    memory_free ( memory , memory_requirement , MEMORY_TAG_POOL_ALLOCATOR );
+
+    // TEST 5: pool_allocator_create rounds the stride up to the pointer size.
+    EXPECT ( pool_allocator_create ( 1 , 8 , 0 , 0 , &allocator ) );
+    EXPECT_EQ ( sizeof ( void* ) , pool_allocator_stride ( allocator ) );
+    pool_allocator_destroy ( &allocator );
+
+    // TEST 6: pool_allocator_destroy handles invalid arguments.
+    pool_allocator_destroy ( 0 );
+    pool_allocator_destroy ( &allocator );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( allocator_amount_allocated , memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_pool_allocator_allocate_and_free
+( void )
+{
+    u64 global_amount_allocated;
+    u64 allocator_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    allocator_amount_allocated = memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 capacity = 16;
+
+    pool_allocator_t* allocator = 0;
+    u64* blocks[ 64 ];
+    void* memory;
+    u64 memory_requirement;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    EXPECT ( pool_allocator_create ( sizeof ( u64 ) * 2 , capacity , 0 , 0 , &allocator ) );
+
+    // TEST 1: pool_allocator_allocate returns distinct, writable, 16-byte aligned blocks.
+    for ( u64 i = 0; i < capacity; ++i )
+    {
+        blocks[ i ] = pool_allocator_allocate ( allocator );
+        EXPECT_NEQ ( 0 , blocks[ i ] );
+        EXPECT_EQ ( 0 , ( u64 )( blocks[ i ] ) % 16 );
+        blocks[ i ][ 0 ] = i;
+        blocks[ i ][ 1 ] = ~i;
+    }
+    for ( u64 i = 0; i < capacity; ++i )
+    {
+        EXPECT_EQ ( i , blocks[ i ][ 0 ] );
+        EXPECT_EQ ( ~i , blocks[ i ][ 1 ] );
+    }
+    EXPECT_EQ ( capacity , pool_allocator_allocated ( allocator ) );
+    EXPECT_EQ ( capacity , pool_allocator_capacity ( allocator ) );
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 2: pool_allocator_free returns blocks for reuse (most recent first).
+    pool_allocator_free ( allocator , blocks[ 3 ] );
+    pool_allocator_free ( allocator , blocks[ 7 ] );
+    EXPECT_EQ ( capacity - 2 , pool_allocator_allocated ( allocator ) );
+    EXPECT_EQ ( blocks[ 7 ] , pool_allocator_allocate ( allocator ) );
+    EXPECT_EQ ( blocks[ 3 ] , pool_allocator_allocate ( allocator ) );
+    blocks[ 7 ][ 0 ] = 7;
+    blocks[ 3 ][ 0 ] = 3;
+    EXPECT_EQ ( global_allocation_count + 1 , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 3: A full pool which owns its memory chains another slab.
+    for ( u64 i = capacity; i < 64; ++i )
+    {
+        blocks[ i ] = pool_allocator_allocate ( allocator );
+        EXPECT_NEQ ( 0 , blocks[ i ] );
+        blocks[ i ][ 0 ] = i;
+    }
+    EXPECT_EQ ( 64 , pool_allocator_allocated ( allocator ) );
+    EXPECT_EQ ( 64 , pool_allocator_capacity ( allocator ) );
+    EXPECT_EQ ( global_allocation_count + 4 , MEMORY_ALLOCATION_COUNT );
+    for ( u64 i = 0; i < 64; ++i )
+    {
+        EXPECT_EQ ( i , blocks[ i ][ 0 ] );
+    }
+
+    // TEST 4: Freed blocks are reused before any new slab is chained.
+    for ( u64 i = 0; i < 64; ++i )
+    {
+        pool_allocator_free ( allocator , blocks[ i ] );
+    }
+    EXPECT_EQ ( 0 , pool_allocator_allocated ( allocator ) );
+    for ( u64 i = 0; i < 64; ++i )
+    {
+        EXPECT_NEQ ( 0 , pool_allocator_allocate ( allocator ) );
+    }
+    EXPECT_EQ ( 64 , pool_allocator_capacity ( allocator ) );
+    EXPECT_EQ ( global_allocation_count + 4 , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 5: pool_allocator_destroy frees every slab.
+    pool_allocator_destroy ( &allocator );
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // TEST 6: A full pre-allocated pool cannot grow.
+    EXPECT ( pool_allocator_create ( sizeof ( u64 ) , capacity , &memory_requirement , 0 , 0 ) );
+    memory = memory_allocate ( memory_requirement , MEMORY_TAG_POOL_ALLOCATOR );
+    EXPECT ( pool_allocator_create ( sizeof ( u64 ) , capacity , 0 , memory , &allocator ) );
+    for ( u64 i = 0; i < capacity; ++i )
+    {
+        blocks[ i ] = pool_allocator_allocate ( allocator );
+        EXPECT_NEQ ( 0 , blocks[ i ] );
+    }
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_EQ ( 0 , pool_allocator_allocate ( allocator ) );
+    EXPECT_EQ ( capacity , pool_allocator_allocated ( allocator ) );
+    pool_allocator_free ( allocator , blocks[ 0 ] );
+    EXPECT_EQ ( blocks[ 0 ] , pool_allocator_allocate ( allocator ) );
+    pool_allocator_destroy ( &allocator );
+    memory_free ( memory , memory_requirement , MEMORY_TAG_POOL_ALLOCATOR );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( allocator_amount_allocated , memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_pool_allocator_cache
+( void )
+{
+    u64 global_amount_allocated;
+    u64 allocator_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    allocator_amount_allocated = memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 count = 3 * POOL_ALLOCATOR_CACHE_CAPACITY;
+
+    pool_allocator_t* allocator = 0;
+    pool_allocator_cache_t cache;
+    void* blocks[ 3 * POOL_ALLOCATOR_CACHE_CAPACITY ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    EXPECT ( pool_allocator_create ( 32 , 64 , 0 , 0 , &allocator ) );
+    pool_allocator_cache_init ( &cache , allocator );
+
+    // TEST 1: pool_allocator_cache_allocate refills the cache a batch at a time.
+    blocks[ 0 ] = pool_allocator_cache_allocate ( &cache );
+    EXPECT_NEQ ( 0 , blocks[ 0 ] );
+    EXPECT_EQ ( POOL_ALLOCATOR_CACHE_BATCH_SIZE , pool_allocator_allocated ( allocator ) );
+    EXPECT_EQ ( POOL_ALLOCATOR_CACHE_BATCH_SIZE - 1 , cache.count );
+
+    // TEST 2: pool_allocator_cache_allocate returns distinct blocks.
+    for ( u64 i = 1; i < count; ++i )
+    {
+        blocks[ i ] = pool_allocator_cache_allocate ( &cache );
+        EXPECT_NEQ ( 0 , blocks[ i ] );
+        memory_set ( blocks[ i ] , 0 , 32 );
+        *( ( u64* )( blocks[ i ] ) ) = i;
+    }
+    for ( u64 i = 1; i < count; ++i )
+    {
+        EXPECT_EQ ( i , *( ( u64* )( blocks[ i ] ) ) );
+    }
+
+    // TEST 3: pool_allocator_cache_free drains the cache when it is full.
+    for ( u64 i = 0; i < count; ++i )
+    {
+        pool_allocator_cache_free ( &cache , blocks[ i ] );
+        EXPECT ( cache.count <= POOL_ALLOCATOR_CACHE_CAPACITY );
+    }
+    EXPECT_EQ ( cache.count , pool_allocator_allocated ( allocator ) );
+
+    // TEST 4: pool_allocator_cache_flush returns every cached block to the pool.
+    pool_allocator_cache_flush ( &cache );
+    EXPECT_EQ ( 0 , cache.count );
+    EXPECT_EQ ( 0 , pool_allocator_allocated ( allocator ) );
+    pool_allocator_cache_flush ( &cache );
+
+    pool_allocator_destroy ( &allocator );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( allocator_amount_allocated , memory_amount_allocated ( MEMORY_TAG_POOL_ALLOCATOR ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_pool_allocator
+( void )
+{
+    test_register ( test_pool_allocator_create_and_destroy , "Creating or destroying a pool allocator." );
+    test_register ( test_pool_allocator_allocate_and_free , "Allocating and freeing blocks from a pool allocator." );
+    test_register ( test_pool_allocator_cache , "Allocating and freeing blocks via a pool allocator cache." );
+}
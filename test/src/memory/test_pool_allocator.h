@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file memory/test_pool_allocator.h
+ * @brief Tests memory/pool_allocator.h
+ * (see test/test.h, memory/pool_allocator.h for additional details)
+ */
+#ifndef TEST_POOL_ALLOCATOR_H
+#define TEST_POOL_ALLOCATOR_H
+
+#include "test/test.h"
+
+#include "memory/pool_allocator.h"
+
+void
+test_register_pool_allocator
+( void );
+
+#endif  // TEST_POOL_ALLOCATOR_H
@@ -0,0 +1,180 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/bench_filesystem.c
+ * @brief Implementation of the platform/bench_filesystem header.
+ * (see platform/bench_filesystem.h for additional details)
+ */
+#include "platform/bench_filesystem.h"
+
+#include "container/string.h"
+
+#include "math/prng.h"
+
+/** @brief File generated by bench_filesystem_setup (truncated on teardown). */
+#define FILE_NAME_BENCH_OUT_FILE "test/assets/out-bench-file"
+
+/** @brief Maximum length of a line of the file generated by bench_filesystem_setup. */
+#define BENCH_FILESYSTEM_LINE_MAX 160
+
+/**
+ * @brief Type definition for the fixture of a filesystem benchmark. Setup
+ * writes a text file of (approximately) the given size, with lines of random
+ * length.
+ */
+typedef struct
+{
+    u64 size;
+}
+bench_filesystem_t;
+
+/** @brief Fixtures for filesystem benchmarks. */
+static bench_filesystem_t bench_filesystem_args[] = { { KiB ( 64 ) } , { MiB ( 1 ) } , { MiB ( 16 ) } };
+
+bool
+bench_filesystem_setup
+(   void* args
+)
+{
+    const bench_filesystem_t* fixture = args;
+    file_t file;
+    if ( !file_open ( FILE_NAME_BENCH_OUT_FILE , FILE_MODE_WRITE , &file ) )
+    {
+        return false;
+    }
+    file_writer_t writer;
+    if ( !file_writer_create ( &file , &writer ) )
+    {
+        file_close ( &file );
+        return false;
+    }
+
+    prng_t prng;
+    prng_seed ( &prng , ( *fixture ).size );
+    char line[ BENCH_FILESYSTEM_LINE_MAX ];
+    bool success = true;
+    for ( u64 written = 0; success && written < ( *fixture ).size; )
+    {
+        const u64 length = prng_bounded ( &prng , BENCH_FILESYSTEM_LINE_MAX );
+        for ( u64 i = 0; i < length; ++i )
+        {
+            line[ i ] = ' ' + prng_bounded ( &prng , 95 );
+        }
+        success = file_writer_write_line ( &writer , length , line );
+        written += length + 1;
+    }
+    success &= file_writer_destroy ( &writer );
+    file_close ( &file );
+    return success;
+}
+
+void
+bench_filesystem_teardown
+(   void* args
+)
+{
+    file_t file;
+    if ( file_open ( FILE_NAME_BENCH_OUT_FILE , FILE_MODE_WRITE , &file ) )
+    {
+        file_close ( &file );
+    }
+}
+
+bool
+bench_file_read_line
+(   void*   args
+,   u64     iterations
+)
+{
+    file_t file;
+    char* line;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        if ( !file_open ( FILE_NAME_BENCH_OUT_FILE , FILE_MODE_READ , &file ) )
+        {
+            return false;
+        }
+        const u64 size = file_size ( &file );
+        while ( file_position_get ( &file ) < size )
+        {
+            if ( !file_read_line ( &file , &line ) )
+            {
+                file_close ( &file );
+                return false;
+            }
+            string_destroy ( line );
+        }
+        file_close ( &file );
+    }
+    return true;
+}
+
+bool
+bench_file_reader_next_line
+(   void*   args
+,   u64     iterations
+)
+{
+    file_t file;
+    file_reader_t reader;
+    const char* line;
+    u64 length = 0;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        if ( !file_open ( FILE_NAME_BENCH_OUT_FILE , FILE_MODE_READ , &file ) )
+        {
+            return false;
+        }
+        if ( !file_reader_create ( &file , &reader ) )
+        {
+            file_close ( &file );
+            return false;
+        }
+        while ( file_reader_next_line ( &reader , &line , &length ) );
+        BENCH_DO_NOT_OPTIMIZE ( length );
+        file_reader_destroy ( &reader );
+        file_close ( &file );
+    }
+    return true;
+}
+
+bool
+bench_file_read_all
+(   void*   args
+,   u64     iterations
+)
+{
+    file_t file;
+    u8* content;
+    u64 read;
+    for ( u64 i = 0; i < iterations; ++i )
+    {
+        if ( !file_open ( FILE_NAME_BENCH_OUT_FILE , FILE_MODE_READ , &file ) )
+        {
+            return false;
+        }
+        const bool success = file_read_all ( &file , &content , &read );
+        file_close ( &file );
+        if ( !success )
+        {
+            return false;
+        }
+        BENCH_DO_NOT_OPTIMIZE ( content );
+        string_free ( content );
+    }
+    return true;
+}
+
+void
+bench_register_filesystem
+( void )
+{
+    _bench_register ( bench_file_read_line , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 0 ] , "file_read_line: every line of a 64 KiB file." );
+    _bench_register ( bench_file_read_line , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 1 ] , "file_read_line: every line of a 1 MiB file." );
+    _bench_register ( bench_file_read_line , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 2 ] , "file_read_line: every line of a 16 MiB file." );
+    _bench_register ( bench_file_reader_next_line , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 0 ] , "file_reader_next_line: every line of a 64 KiB file." );
+    _bench_register ( bench_file_reader_next_line , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 1 ] , "file_reader_next_line: every line of a 1 MiB file." );
+    _bench_register ( bench_file_reader_next_line , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 2 ] , "file_reader_next_line: every line of a 16 MiB file." );
+    _bench_register ( bench_file_read_all , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 0 ] , "file_read_all: 64 KiB file." );
+    _bench_register ( bench_file_read_all , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 1 ] , "file_read_all: 1 MiB file." );
+    _bench_register ( bench_file_read_all , bench_filesystem_setup , bench_filesystem_teardown , &bench_filesystem_args[ 2 ] , "file_read_all: 16 MiB file." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/bench_filesystem.h
+ * @brief Benchmarks platform/filesystem.h
+ * (see test/bench.h, platform/filesystem.h for additional details)
+ */
+#ifndef BENCH_FILESYSTEM_H
+#define BENCH_FILESYSTEM_H
+
+#include "test/bench.h"
+
+#include "platform/filesystem.h"
+
+void
+bench_register_filesystem
+( void );
+
+#endif  // BENCH_FILESYSTEM_H
@@ -0,0 +1,174 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_cpu.c
+ * @brief Implementation of the platform/test_cpu header.
+ * (see platform/test_cpu.h for additional details)
+ */
+#include "platform/test_cpu.h"
+
+#include "test/expect.h"
+
+#include "core/logger.h"
+#include "core/memory.h"
+#include "core/string.h"
+
+#include "platform/platform.h"
+
+u8
+test_cpu
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Detection is stable across calls.
+    const u32 features = cpu_features ();
+    EXPECT_EQ ( features , cpu_features () );
+    for ( u32 i = 0; i < 16; ++i )
+    {
+        if ( features & ( 1 << i ) )
+        {
+            LOGDEBUG ( "test_cpu: Host supports %s." , cpu_feature_name ( 1 << i ) );
+        }
+    }
+
+    // TEST 2: cpu_supports requires every requested feature.
+    EXPECT ( cpu_supports ( 0 ) );
+    EXPECT ( cpu_supports ( features ) );
+    EXPECT_NOT ( cpu_supports ( features | 0x8000 ) );
+
+    // TEST 3: The baseline of the architecture is always reported.
+#if defined(__x86_64__) || defined(_M_X64)
+    EXPECT ( cpu_supports ( CPU_FEATURE_SSE2 ) );
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    EXPECT ( cpu_supports ( CPU_FEATURE_NEON ) );
+#endif
+
+    // TEST 4: Extensions imply the ones they extend.
+    if ( cpu_supports ( CPU_FEATURE_AVX2 ) )
+    {
+        EXPECT ( cpu_supports ( CPU_FEATURE_AVX ) );
+    }
+    if ( cpu_supports ( CPU_FEATURE_AVX512BW ) )
+    {
+        EXPECT ( cpu_supports ( CPU_FEATURE_AVX512F ) );
+    }
+    if ( cpu_supports ( CPU_FEATURE_SVE ) )
+    {
+        EXPECT ( cpu_supports ( CPU_FEATURE_NEON ) );
+    }
+
+    // TEST 5: cpu_feature_name names single flags only.
+    EXPECT ( _string_equal ( "AVX2" , cpu_feature_name ( CPU_FEATURE_AVX2 ) ) );
+    EXPECT ( _string_equal ( "NEON" , cpu_feature_name ( CPU_FEATURE_NEON ) ) );
+    EXPECT ( _string_equal ( "unknown" , cpu_feature_name ( CPU_FEATURE_AVX | CPU_FEATURE_AVX2 ) ) );
+
+    // TEST 6: Detection performs no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+u8
+test_cpu_topology
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Detection is performed once, and cached.
+    const cpu_topology_t* topology = cpu_topology ();
+    EXPECT_NEQ ( 0 , topology );
+    EXPECT_EQ ( topology , cpu_topology () );
+    LOGDEBUG ( "test_cpu_topology: %u logical cores, %u physical cores, %u packages, %u NUMA nodes, %u-way SMT."
+             , ( *topology ).logical_core_count
+             , ( *topology ).physical_core_count
+             , ( *topology ).package_count
+             , ( *topology ).numa_node_count
+             , ( *topology ).smt_width
+             );
+    LOGDEBUG ( "test_cpu_topology: L1d %u B, L1i %u B, L2 %u B (shared by %u), L3 %u B (shared by %u), %u B lines."
+             , ( *topology ).l1_data.size
+             , ( *topology ).l1_instruction.size
+             , ( *topology ).l2.size
+             , ( *topology ).l2.shared_by
+             , ( *topology ).l3.size
+             , ( *topology ).l3.shared_by
+             , ( *topology ).cache_line_size
+             );
+
+    // TEST 2: The counts are consistent with each other, and with platform_processor_core_count.
+    EXPECT_EQ ( ( u32 ) platform_processor_core_count () , ( *topology ).logical_core_count );
+    EXPECT ( ( *topology ).physical_core_count >= 1 );
+    EXPECT ( ( *topology ).physical_core_count <= ( *topology ).logical_core_count );
+    EXPECT ( ( *topology ).package_count >= 1 );
+    EXPECT ( ( *topology ).package_count <= ( *topology ).physical_core_count );
+    EXPECT ( ( *topology ).numa_node_count >= 1 );
+    EXPECT ( ( *topology ).smt_width >= 1 );
+    EXPECT ( ( *topology ).smt_width * ( *topology ).physical_core_count >= ( *topology ).logical_core_count );
+
+    // TEST 3: Every described logical core has a distinct id, and physical core and package indices within range.
+    const u32 described = MIN ( ( *topology ).logical_core_count , CPU_MAX_LOGICAL_CORES );
+    for ( u32 i = 0; i < described; ++i )
+    {
+        const cpu_logical_core_t* core = &( *topology ).logical_cores[ i ];
+        EXPECT ( ( *core ).physical_core < ( *topology ).physical_core_count );
+        EXPECT ( ( *core ).package < ( *topology ).package_count );
+        if ( i )
+        {
+            EXPECT ( ( *core ).id > ( *topology ).logical_cores[ i - 1 ].id );
+        }
+    }
+
+    // TEST 4: The cache line size is a power of two, and every cache present has a line size and at least one logical core.
+    EXPECT_NEQ ( 0 , ( *topology ).cache_line_size );
+    EXPECT_EQ ( 0 , ( *topology ).cache_line_size & ( ( *topology ).cache_line_size - 1 ) );
+    const cpu_cache_t* caches[] = { &( *topology ).l1_data
+                                  , &( *topology ).l1_instruction
+                                  , &( *topology ).l2
+                                  , &( *topology ).l3
+                                  };
+    for ( u32 i = 0; i < sizeof ( caches ) / sizeof ( caches[ 0 ] ); ++i )
+    {
+        if ( ( *caches[ i ] ).size )
+        {
+            EXPECT_NEQ ( 0 , ( *caches[ i ] ).line_size );
+            EXPECT_NEQ ( 0 , ( *caches[ i ] ).shared_by );
+        }
+    }
+
+    // TEST 5: Detection performs no memory allocation.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    return true;
+}
+
+void
+test_register_cpu
+( void )
+{
+    test_register ( test_cpu , "Testing runtime processor feature detection." );
+    test_register ( test_cpu_topology , "Testing processor topology detection." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_cpu.h
+ * @brief Tests platform/cpu.h
+ * (see test/test.h, platform/cpu.h for additional details)
+ */
+#ifndef TEST_CPU_H
+#define TEST_CPU_H
+
+#include "test/test.h"
+
+#include "platform/cpu.h"
+
+void
+test_register_cpu
+( void );
+
+#endif  // TEST_CPU_H
@@ -0,0 +1,279 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_fiber.c
+ * @brief Implementation of the platform/test_fiber header.
+ * (see platform/test_fiber.h for additional details)
+ */
+#include "platform/test_fiber.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/thread.h"
+
+/** @brief Number of times the counting fiber yields. */
+#define TEST_FIBER_YIELD_COUNT 3
+
+/** @brief Number of threads the migration test resumes a fiber on. */
+#define TEST_FIBER_THREAD_COUNT 4
+
+/** @brief Type definition for state shared with a test fiber. */
+typedef struct
+{
+    u64         value;
+    fiber_t*    self;
+    fiber_t*    current;
+    fiber_t*    nested;
+    FIBER_STATE nested_state;
+    f64         sum;
+    u64         ids[ TEST_FIBER_THREAD_COUNT ];
+}
+shared_t;
+
+/**
+ * @brief Fiber: increments a value, yielding after each increment.
+ */
+void
+test_fiber_count
+(   void* args
+)
+{
+    shared_t* shared = args;
+    ( *shared ).current = fiber_current ();
+    for ( u64 i = 0; i < TEST_FIBER_YIELD_COUNT; ++i )
+    {
+        ( *shared ).value += 1;
+        fiber_yield ();
+    }
+}
+
+/**
+ * @brief Fiber: accumulates floating point values across yields.
+ */
+void
+test_fiber_sum
+(   void* args
+)
+{
+    shared_t* shared = args;
+    f64 sum = 0.0;
+    for ( u64 i = 1; i <= TEST_FIBER_YIELD_COUNT; ++i )
+    {
+        sum += 1.0 / ( f64 ) i;
+        fiber_yield ();
+    }
+    ( *shared ).sum = sum;
+}
+
+/**
+ * @brief Fiber: resumes the counting fiber once, from within this fiber.
+ */
+void
+test_fiber_outer
+(   void* args
+)
+{
+    shared_t* shared = args;
+    ( *shared ).nested_state = fiber_resume ( ( *shared ).nested );
+    ( *shared ).value += 10;
+}
+
+/**
+ * @brief Fiber: uses a large part of its stack.
+ */
+void
+test_fiber_deep
+(   void* args
+)
+{
+    shared_t* shared = args;
+    volatile u8 stack[ FIBER_DEFAULT_STACK_SIZE / 2 ];
+    for ( u64 i = 0; i < sizeof ( stack ); i += 64 )
+    {
+        stack[ i ] = ( u8 ) i;
+    }
+    ( *shared ).value = stack[ 64 ];
+}
+
+/**
+ * @brief Fiber: records the identifier of each thread it runs on.
+ */
+void
+test_fiber_migrate
+(   void* args
+)
+{
+    shared_t* shared = args;
+    for ( u64 i = 0; i < TEST_FIBER_THREAD_COUNT; ++i )
+    {
+        ( *shared ).ids[ i ] = thread_id ();
+        fiber_yield ();
+    }
+}
+
+/**
+ * @brief Thread: resumes a fiber once.
+ */
+u32
+test_fiber_thread
+(   void* args
+)
+{
+    fiber_resume ( ( *( ( shared_t* ) args ) ).self );
+    return 0;
+}
+
+u8
+test_fiber_resume_and_yield
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    shared_t other = { 0 };
+    fiber_t* fiber;
+    fiber_t* outer;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A fiber does not run until it is resumed.
+    EXPECT ( fiber_create ( test_fiber_count , &shared , &fiber ) );
+    EXPECT_NEQ ( 0 , fiber );
+    EXPECT_EQ ( FIBER_STATE_READY , fiber_state ( fiber ) );
+    EXPECT_EQ ( 0 , shared.value );
+
+    // TEST 2: fiber_resume runs a fiber until it yields, then until it
+    //         finishes.
+    for ( u64 i = 1; i <= TEST_FIBER_YIELD_COUNT; ++i )
+    {
+        EXPECT_EQ ( FIBER_STATE_SUSPENDED , fiber_resume ( fiber ) );
+        EXPECT_EQ ( i , shared.value );
+    }
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_resume ( fiber ) );
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_state ( fiber ) );
+    EXPECT_EQ ( TEST_FIBER_YIELD_COUNT , shared.value );
+
+    // TEST 3: fiber_current is the running fiber, and 0 outside of any fiber.
+    EXPECT_EQ ( fiber , shared.current );
+    EXPECT_EQ ( 0 , fiber_current () );
+
+    // TEST 4: A finished fiber is pooled, and reused by the next fiber_create.
+    fiber_t* finished = fiber;
+    fiber_destroy ( &fiber );
+    EXPECT_EQ ( 0 , fiber );
+    EXPECT ( fiber_create ( test_fiber_sum , &shared , &fiber ) );
+    EXPECT_EQ ( finished , fiber );
+
+    // TEST 5: Floating point state survives a yield.
+    while ( fiber_resume ( fiber ) != FIBER_STATE_FINISHED );
+    EXPECT ( shared.sum > 1.83 && shared.sum < 1.84 );
+    fiber_destroy ( &fiber );
+
+    // TEST 6: A fiber resumed from another fiber yields back to that fiber.
+    shared.value = 0;
+    EXPECT ( fiber_create ( test_fiber_count , &shared , &shared.nested ) );
+    EXPECT ( fiber_create ( test_fiber_outer , &shared , &outer ) );
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_resume ( outer ) );
+    EXPECT_EQ ( FIBER_STATE_SUSPENDED , shared.nested_state );
+    EXPECT_EQ ( 11 , shared.value );
+    EXPECT_EQ ( shared.nested , shared.current );
+    fiber_destroy ( &outer );
+
+    // TEST 7: A suspended fiber may be destroyed.
+    fiber_destroy ( &shared.nested );
+    EXPECT_EQ ( 0 , shared.nested );
+
+    // TEST 8: A fiber with a non-default stack size may use most of it.
+    EXPECT ( _fiber_create ( 2 * FIBER_DEFAULT_STACK_SIZE , test_fiber_deep , &other , &fiber ) );
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_resume ( fiber ) );
+    EXPECT_EQ ( 64 , other.value );
+    fiber_destroy ( &fiber );
+
+    // TEST 9: fiber_yield has no effect outside of any fiber.
+    fiber_yield ();
+
+    // TEST 10: Fiber functions handle invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( fiber_create ( 0 , &shared , &fiber ) );
+    EXPECT_NOT ( fiber_create ( test_fiber_count , &shared , 0 ) );
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_resume ( 0 ) );
+    EXPECT ( fiber_create ( test_fiber_deep , &other , &fiber ) );
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_resume ( fiber ) );
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_resume ( fiber ) );
+    fiber_destroy ( &fiber );
+    fiber_destroy ( 0 );
+
+    // TEST 11: fiber_pool_trim frees every pooled fiber.
+    EXPECT_NEQ ( 0 , fiber_pool_trim () );
+    EXPECT_EQ ( 0 , fiber_pool_trim () );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_fiber_migrate_threads
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    thread_t thread;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A suspended fiber may be resumed on another thread, where it
+    //         continues from where it yielded.
+    EXPECT ( fiber_create ( test_fiber_migrate , &shared , &shared.self ) );
+    for ( u64 i = 0; i < TEST_FIBER_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_fiber_thread , &shared , false , &thread ) );
+        EXPECT ( thread_wait ( &thread ) );
+        thread_destroy ( &thread );
+        EXPECT_NEQ ( 0 , shared.ids[ i ] );
+        EXPECT_EQ ( FIBER_STATE_SUSPENDED , fiber_state ( shared.self ) );
+    }
+    for ( u64 i = 1; i < TEST_FIBER_THREAD_COUNT; ++i )
+    {
+        EXPECT ( shared.ids[ i ] != thread_id () );
+    }
+    EXPECT_EQ ( FIBER_STATE_FINISHED , fiber_resume ( shared.self ) );
+    fiber_destroy ( &shared.self );
+    fiber_pool_trim ();
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_fiber
+( void )
+{
+    test_register_serial ( test_fiber_resume_and_yield , "Creating, resuming and yielding fibers." );
+    test_register_serial ( test_fiber_migrate_threads , "Resuming a suspended fiber on another thread." );
+}
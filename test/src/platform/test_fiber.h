@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_fiber.h
+ * @brief Tests platform/fiber.h
+ * (see test/test.h, platform/fiber.h for additional details)
+ */
+#ifndef TEST_FIBER_H
+#define TEST_FIBER_H
+
+#include "test/test.h"
+
+#include "platform/fiber.h"
+
+void
+test_register_fiber
+( void );
+
+#endif  // TEST_FIBER_H
@@ -13,6 +13,9 @@
 
 #include "container/string.h"
 
+#include "core/checksum.h"
+#include "core/compress.h"
+#include "core/job.h"
 #include "core/memory.h"
 
 #define FILE_NAME_TEST_DNE             "test/assets/file-dne"
@@ -432,6 +435,143 @@ test_file_read
     return true;
 }
 
+u8
+test_file_read_at
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 file_content_length = _string_length ( file_content_test_in_file );
+    char buffer[ 100 ];
+    char buffer2[ 100 ];
+    file_t file;
+    u64 read;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: file_read_at and file_readv_at handle invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    // TEST 1.1: file_read_at fails if no file is provided.
+    EXPECT_NOT ( file_read_at ( 0 , 0 , 1 , buffer , &read ) );
+
+    // TEST 1.2: file_read_at fails if the provided file is invalid.
+    file_t invalid_file;
+    invalid_file.valid = false;
+    invalid_file.handle = 0;
+    EXPECT_NOT ( file_read_at ( &invalid_file , 0 , 1 , buffer , &read ) );
+    EXPECT_EQ ( 0 , read );
+
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE , FILE_MODE_READ , &file ) );
+
+    // TEST 1.3: file_read_at fails if no output buffer is provided for the content.
+    EXPECT_NOT ( file_read_at ( &file , 0 , 1 , 0 , &read ) );
+
+    // TEST 1.4: file_read_at fails if no output buffer is provided for the number of bytes read.
+    EXPECT_NOT ( file_read_at ( &file , 0 , 1 , buffer , 0 ) );
+
+    // TEST 1.5: file_readv_at fails if no output buffers are provided.
+    EXPECT_NOT ( file_readv_at ( &file , 0 , 0 , 1 , &read ) );
+
+    // TEST 1.6: file_readv_at fails if an output buffer is missing.
+    const file_buffer_t missing_buffers[] = { { buffer , 1 } , { 0 , 1 } };
+    EXPECT_NOT ( file_readv_at ( &file , 0 , missing_buffers , 2 , &read ) );
+
+    file_close ( &file );
+
+    // TEST 1.7: file_read_at fails if file is not open for read.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( _file_write ( &file , file_content_test_in_file , &read ) );
+    EXPECT_NOT ( file_read_at ( &file , 0 , 1 , buffer , &read ) );
+    EXPECT_EQ ( 0 , read );
+    file_close ( &file );
+
+    // TEST 2: file_read_at.
+
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE , FILE_MODE_READ , &file ) );
+
+    // TEST 2.1: file_read_at reads from the specified offset.
+    EXPECT ( file_read_at ( &file , 20 , 18 , buffer , &read ) );
+    EXPECT_EQ ( 18 , read );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file + 20 , 18 ) );
+
+    // TEST 2.2: file_read_at does not modify the file position.
+    EXPECT_EQ ( 0 , file_position_get ( &file ) );
+
+    // TEST 2.3: file_read_at does not depend on the file position.
+    EXPECT ( file_read ( &file , 5 , buffer , &read ) );
+    EXPECT ( file_read_at ( &file , 0 , 4 , buffer , &read ) );
+    EXPECT_EQ ( 4 , read );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file , 4 ) );
+    EXPECT_EQ ( 5 , file_position_get ( &file ) );
+
+    // TEST 2.4: A subsequent file_read continues from the file position.
+    EXPECT ( file_read ( &file , 5 , buffer , &read ) );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file + 5 , 5 ) );
+
+    // TEST 2.5: file_read_at stops at the end of the file.
+    EXPECT ( file_read_at ( &file , file_content_length - 10 , sizeof ( buffer ) , buffer , &read ) );
+    EXPECT_EQ ( 10 , read );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file + file_content_length - 10 , 10 ) );
+
+    // TEST 2.6: file_read_at reads nothing from an offset at or past the end of the file.
+    EXPECT ( file_read_at ( &file , file_content_length , sizeof ( buffer ) , buffer , &read ) );
+    EXPECT_EQ ( 0 , read );
+    EXPECT ( file_read_at ( &file , file_content_length + 100 , sizeof ( buffer ) , buffer , &read ) );
+    EXPECT_EQ ( 0 , read );
+
+    // TEST 3: file_readv_at.
+
+    // TEST 3.1: file_readv_at fills each buffer in order, skipping empty buffers.
+    const file_buffer_t buffers[] = { { buffer , 7 }
+                                    , { buffer2 , 0 }
+                                    , { buffer2 , 12 }
+                                    };
+    EXPECT ( file_readv_at ( &file , 1 , buffers , sizeof ( buffers ) / sizeof ( file_buffer_t ) , &read ) );
+    EXPECT_EQ ( 19 , read );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file + 1 , 7 ) );
+    EXPECT ( memory_equal ( buffer2 , file_content_test_in_file + 8 , 12 ) );
+
+    // TEST 3.2: file_readv_at stops at the end of the file.
+    const file_buffer_t buffers_past_end[] = { { buffer , 6 } , { buffer2 , sizeof ( buffer2 ) } };
+    EXPECT ( file_readv_at ( &file , file_content_length - 10 , buffers_past_end , 2 , &read ) );
+    EXPECT_EQ ( 10 , read );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file + file_content_length - 10 , 6 ) );
+    EXPECT ( memory_equal ( buffer2 , file_content_test_in_file + file_content_length - 4 , 4 ) );
+
+    // TEST 3.3: file_readv_at succeeds if there are no buffers to read into.
+    EXPECT ( file_readv_at ( &file , 0 , buffers , 0 , &read ) );
+    EXPECT_EQ ( 0 , read );
+
+    // TEST 3.4: file_readv_at does not modify the file position.
+    EXPECT_EQ ( 10 , file_position_get ( &file ) );
+
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 u8
 test_file_write
 ( void )
@@ -759,6 +899,306 @@ test_file_read_line
     return true;
 }
 
+u8
+test_file_reader
+( void )
+{
+    u64 global_amount_allocated;
+    u64 array_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    array_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ARRAY );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 capacities[] = { 1 , 16 , FILE_READER_DEFAULT_CAPACITY };
+    const u64 line_count = 200;
+    file_t file;
+    file_reader_t reader;
+    u64 written;
+    char* line;
+
+    char* in_lines[ 200 ];
+    for ( u64 i = 0; i < line_count; ++i )
+    {
+        in_lines[ i ] = string_create ();
+        EXPECT_NEQ ( 0 , in_lines[ i ] );
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: file_reader_create and file_reader_read_line handle invalid arguments.
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE , FILE_MODE_READ , &file ) );
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( _file_reader_create ( 0 , 16 , &reader ) );
+    EXPECT_NOT ( _file_reader_create ( &file , 0 , &reader ) );
+    EXPECT_NOT ( _file_reader_create ( &file , 16 , 0 ) );
+    EXPECT ( file_reader_create ( &file , &reader ) );
+    EXPECT_NOT ( file_reader_read_line ( 0 , &line ) );
+    EXPECT_NOT ( file_reader_read_line ( &reader , 0 ) );
+
+    // TEST 2: file_reader_read_line reads a line, excluding the newline.
+    EXPECT ( file_reader_read_line ( &reader , &line ) );
+    EXPECT ( memory_equal ( line , "This is a file with" , string_length ( line ) + 1 ) );
+    string_destroy ( line );
+
+    // TEST 3: file_reader_destroy resets the file position to just past the last line read, so a new reader continues from there (up to a final line with no newline).
+    EXPECT_EQ ( file_size ( &file ) , file_position_get ( &file ) );
+    file_reader_destroy ( &reader );
+    EXPECT_EQ ( _string_length ( "This is a file with\n" ) , file_position_get ( &file ) );
+    EXPECT ( _file_reader_create ( &file , 4 , &reader ) );
+    EXPECT ( file_reader_read_line ( &reader , &line ) );
+    EXPECT ( memory_equal ( line , "three lines and 50" , string_length ( line ) + 1 ) );
+    string_destroy ( line );
+    EXPECT ( file_reader_read_line ( &reader , &line ) );
+    EXPECT ( memory_equal ( line , "characters." , string_length ( line ) + 1 ) );
+    string_destroy ( line );
+
+    // TEST 4: file_reader_read_line fails at the end of the file.
+    line = ( char* ) 1;
+    EXPECT_NOT ( file_reader_read_line ( &reader , &line ) );
+    EXPECT_EQ ( 0 , line );
+    file_reader_destroy ( &reader );
+    file_close ( &file );
+
+    // TEST 5: file_reader_read_line reads lines which are empty or longer than the buffer, for any buffer capacity.
+
+    // Populate the file with random-length lines of (non-zero) random characters.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    for ( u64 i = 0; i < line_count; ++i )
+    {
+        const u64 length = ( i % 10 ) ? random2 ( 1 , 100 ) : 0;
+        for ( u64 j = 0; j < length; ++j )
+        {
+            _string_push ( in_lines[ i ] , string_char ( random2 ( 33 , 126 ) ) );
+        }
+        EXPECT ( file_write ( &file , string_length ( in_lines[ i ] ) , in_lines[ i ] , &written ) );
+        EXPECT ( file_write ( &file , 1 , "\n" , &written ) );
+    }
+    file_close ( &file );
+
+    for ( u64 i = 0; i < sizeof ( capacities ) / sizeof ( capacities[ 0 ] ); ++i )
+    {
+        EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+        EXPECT ( _file_reader_create ( &file , capacities[ i ] , &reader ) );
+        for ( u64 j = 0; j < line_count; ++j )
+        {
+            EXPECT ( file_reader_read_line ( &reader , &line ) );
+            EXPECT_NEQ ( 0 , line ); // Verify there was no memory error prior to the test.
+            EXPECT_EQ ( string_length ( in_lines[ j ] ) , string_length ( line ) );
+            EXPECT ( memory_equal ( in_lines[ j ] , line , string_length ( line ) ) );
+            string_destroy ( line );
+        }
+        EXPECT_NOT ( file_reader_read_line ( &reader , &line ) );
+        file_reader_destroy ( &reader );
+        EXPECT_EQ ( file_size ( &file ) , file_position_get ( &file ) );
+        file_close ( &file );
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    for ( u64 i = 0; i < line_count; ++i )
+    {
+        string_destroy ( in_lines[ i ] );
+    }
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( array_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ARRAY ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_file_reader_next_line
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* content = "first\r\n\r\nthird line is longer than the buffer\n\nlast\r";
+    const char* lines[] = { "first\r" , "\r" , "third line is longer than the buffer" , "" , "last\r" };
+    const u64 line_count = sizeof ( lines ) / sizeof ( lines[ 0 ] );
+    file_t file;
+    file_reader_t reader;
+    u64 written;
+    const char* line;
+    u64 length;
+
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( _file_write ( &file , content , &written ) );
+    file_close ( &file );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: _file_reader_next_line handles invalid arguments.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT ( _file_reader_create ( &file , 8 , &reader ) );
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( file_reader_next_line ( 0 , &line , &length ) );
+    EXPECT_NOT ( file_reader_next_line ( &reader , 0 , &length ) );
+    EXPECT_NOT ( file_reader_next_line ( &reader , &line , 0 ) );
+
+    // TEST 2: file_reader_next_line returns each line in place within the reader's buffer, growing the buffer for a line which does not fit.
+    for ( u64 i = 0; i < line_count; ++i )
+    {
+        EXPECT ( file_reader_next_line ( &reader , &line , &length ) );
+        EXPECT ( ( const u8* ) line >= reader.buffer );
+        EXPECT ( ( const u8* ) line + length <= reader.buffer + reader.capacity );
+        EXPECT_EQ ( _string_length ( lines[ i ] ) , length );
+        EXPECT ( memory_equal ( line , lines[ i ] , length ) );
+    }
+    EXPECT ( reader.capacity >= _string_length ( lines[ 2 ] ) );
+
+    // TEST 3: file_reader_next_line fails at the end of the file.
+    EXPECT_NOT ( file_reader_next_line ( &reader , &line , &length ) );
+    EXPECT_EQ ( 0 , line );
+    EXPECT_EQ ( 0 , length );
+
+    // TEST 4: The reader's checksum is the CRC32C of every byte consumed, including newlines.
+    EXPECT_EQ ( checksum_crc32c ( content , _string_length ( content ) , 0 ) , reader.checksum );
+    file_reader_destroy ( &reader );
+
+    // TEST 5: _file_reader_next_line strips a carriage return preceding each newline (or the end of the file) if requested, and performs no memory allocation once the buffer is large enough.
+    EXPECT ( file_position_set ( &file , 0 ) );
+    EXPECT ( _file_reader_create ( &file , 64 , &reader ) );
+    const u64 allocation_count = MEMORY_ALLOCATION_COUNT;
+    for ( u64 i = 0; i < line_count; ++i )
+    {
+        EXPECT ( _file_reader_next_line ( &reader , true , &line , &length ) );
+        const u64 expected_length = _string_length ( lines[ i ] ) - ( i == 0 || i == 1 || i == 4 );
+        EXPECT_EQ ( expected_length , length );
+        EXPECT ( memory_equal ( line , lines[ i ] , length ) );
+    }
+    EXPECT_NOT ( _file_reader_next_line ( &reader , true , &line , &length ) );
+    EXPECT_EQ ( allocation_count , MEMORY_ALLOCATION_COUNT );
+    file_reader_destroy ( &reader );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_file_map
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    file_t file;
+    file_map_t map;
+    u64 written;
+    u64 read;
+    char buffer[ 64 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: file_map handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( file_map ( 0 , FILE_MODE_READ , FILE_MAP_HINT_NONE , &map ) );
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE , FILE_MODE_READ , &file ) );
+    EXPECT_NOT ( file_map ( &file , FILE_MODE_READ , FILE_MAP_HINT_NONE , 0 ) );
+    EXPECT_NOT ( file_map ( &file , FILE_MODE_WRITE , FILE_MAP_HINT_NONE , &map ) );
+    EXPECT_NOT ( file_map ( &file , FILE_MODE_READ | FILE_MODE_WRITE , FILE_MAP_HINT_NONE , &map ) );
+    EXPECT_EQ ( 0 , map.data );
+    EXPECT_NOT ( file_map_advise ( 0 , FILE_MAP_HINT_NONE ) );
+    EXPECT_NOT ( file_map_flush ( 0 ) );
+
+    // TEST 2: A read-only mapping holds the contents of the file, and does not modify the file position.
+    EXPECT ( file_map ( &file , FILE_MODE_READ , FILE_MAP_HINT_SEQUENTIAL | FILE_MAP_HINT_WILLNEED | FILE_MAP_HINT_HUGE_PAGES , &map ) );
+    EXPECT_NEQ ( 0 , map.data );
+    EXPECT_EQ ( _string_length ( file_content_test_in_file ) , map.size );
+    EXPECT ( memory_equal ( map.data , file_content_test_in_file , map.size ) );
+    EXPECT_EQ ( 0 , file_position_get ( &file ) );
+
+    // TEST 3: file_map_advise accepts every hint, and file_map_flush succeeds on a read-only mapping.
+    EXPECT ( file_map_advise ( &map , FILE_MAP_HINT_RANDOM ) );
+    EXPECT ( file_map_advise ( &map , FILE_MAP_HINT_SEQUENTIAL | FILE_MAP_HINT_WILLNEED ) );
+    EXPECT ( file_map_flush ( &map ) );
+
+    // TEST 4: A mapping remains valid after the file is closed.
+    file_close ( &file );
+    EXPECT ( memory_equal ( map.data , file_content_test_in_file , map.size ) );
+    file_unmap ( &map );
+    EXPECT_EQ ( 0 , map.data );
+    EXPECT_EQ ( 0 , map.size );
+
+    // TEST 5: An empty file produces an empty mapping.
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE_EMPTY , FILE_MODE_READ , &file ) );
+    EXPECT ( file_map ( &file , FILE_MODE_READ , FILE_MAP_HINT_NONE , &map ) );
+    EXPECT_EQ ( 0 , map.data );
+    EXPECT_EQ ( 0 , map.size );
+    file_unmap ( &map );
+    file_close ( &file );
+
+    // TEST 6: Changes made through a read-write mapping are written back to the file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( _file_write ( &file , file_content_test_in_file , &written ) );
+    file_close ( &file );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ | FILE_MODE_WRITE , &file ) );
+    EXPECT ( file_map ( &file , FILE_MODE_READ | FILE_MODE_WRITE , FILE_MAP_HINT_RANDOM , &map ) );
+    EXPECT_EQ ( written , map.size );
+    memory_copy ( map.data , "THAT" , 4 );
+    EXPECT ( file_map_flush ( &map ) );
+    file_unmap ( &map );
+    EXPECT ( file_read ( &file , written , buffer , &read ) );
+    EXPECT_EQ ( written , read );
+    EXPECT ( memory_equal ( buffer , "THAT" , 4 ) );
+    EXPECT ( memory_equal ( buffer + 4 , file_content_test_in_file + 4 , read - 4 ) );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 u8
 test_file_write_line
 ( void )
@@ -909,31 +1349,374 @@ test_file_write_line
 }
 
 u8
-test_file_read_all
+test_file_writer
 ( void )
 {
     u64 global_amount_allocated;
     u64 file_amount_allocated;
-    u64 string_amount_allocated;
     u64 global_allocation_count;
 
     // Copy the current global allocator state prior to the test.
     global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
     file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
-    string_amount_allocated = memory_amount_allocated ( MEMORY_TAG_STRING );
     global_allocation_count = MEMORY_ALLOCATION_COUNT;
 
-    const u64 filesize = MiB ( 100 );
+    const char* in_line = "This is the line to be written to the file.";
+    const u64 in_line_length = _string_length ( in_line );
+    char buffer[ 512 ];
+    char large[ 300 ];
     file_t file;
-    u64 read;
+    file_writer_t writer;
     u64 written;
+    u64 read;
 
-    char* string_in = string_allocate ( filesize + 1 );
-    u8* string_out;
+    for ( u64 i = 0; i < sizeof ( large ); ++i )
+    {
+        large[ i ] = 'a' + i % 26;
+    }
 
     ////////////////////////////////////////////////////////////////////////////
+    // Start test.
 
-    // TEST 1: file_read_all handles invalid arguments.
+    // TEST 1: File writer handles invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    const u64 file_open_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+
+    // TEST 1.1: _file_writer_create fails if no file is provided.
+    EXPECT_NOT ( file_writer_create ( 0 , &writer ) );
+
+    // TEST 1.2: _file_writer_create fails if capacity is 0.
+    EXPECT_NOT ( _file_writer_create ( &file , 0 , 1 , &writer ) );
+
+    // TEST 1.3: _file_writer_create fails if threshold is 0.
+    EXPECT_NOT ( _file_writer_create ( &file , 64 , 0 , &writer ) );
+
+    // TEST 1.4: _file_writer_create fails if threshold exceeds capacity.
+    EXPECT_NOT ( _file_writer_create ( &file , 64 , 65 , &writer ) );
+
+    // TEST 1.5: _file_writer_create fails if no output buffer is provided.
+    EXPECT_NOT ( file_writer_create ( &file , 0 ) );
+
+    // TEST 1.6: _file_writer_create does not allocate memory on failure.
+    EXPECT_EQ ( file_open_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+
+    EXPECT ( file_writer_create ( &file , &writer ) );
+
+    // TEST 1.7: file_writer_write fails if no writer is provided.
+    EXPECT_NOT ( file_writer_write ( 0 , 1 , buffer ) );
+
+    // TEST 1.8: file_writer_write fails if no handle is provided to content to write.
+    EXPECT_NOT ( file_writer_write ( &writer , 1 , 0 ) );
+
+    // TEST 1.9: file_writer_flush fails if no writer is provided.
+    EXPECT_NOT ( file_writer_flush ( 0 ) );
+
+    // TEST 1.10: file_writev fails if no handle is provided to spans to write.
+    EXPECT_NOT ( file_writev ( &file , 0 , 1 , &written ) );
+
+    // TEST 1.11: file_writev fails if no output buffer is provided.
+    const file_span_t span = { buffer , 1 };
+    EXPECT_NOT ( file_writev ( &file , &span , 1 , 0 ) );
+
+    // TEST 1.12: Nothing was written to the file.
+    EXPECT_EQ ( 0 , file_size ( &file ) );
+
+    EXPECT ( file_writer_destroy ( &writer ) );
+    file_close ( &file );
+
+    // TEST 1.13: file_writev fails if file is not open for write.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT_NOT ( file_writev ( &file , &span , 1 , &written ) );
+    file_close ( &file );
+
+    // TEST 2: file_writev.
+
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+
+    // TEST 2.1: file_writev writes each span in order, skipping empty spans.
+    const file_span_t spans[] = { { in_line , 8 }
+                                , { in_line , 0 }
+                                , { in_line + 8 , in_line_length - 8 }
+                                , { "\n" , 1 }
+                                };
+    EXPECT ( file_writev ( &file , spans , sizeof ( spans ) / sizeof ( file_span_t ) , &written ) );
+    EXPECT_EQ ( in_line_length + 1 , written );
+    EXPECT_EQ ( in_line_length + 1 , file_position_get ( &file ) );
+    EXPECT_EQ ( file_position_get ( &file ) , file_size ( &file ) );
+
+    // TEST 2.2: file_writev succeeds if there are no spans to write.
+    EXPECT ( file_writev ( &file , spans , 0 , &written ) );
+    EXPECT_EQ ( 0 , written );
+    EXPECT_EQ ( in_line_length + 1 , file_size ( &file ) );
+
+    file_close ( &file );
+
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT ( file_read ( &file , in_line_length + 1 , buffer , &read ) );
+    EXPECT_EQ ( in_line_length + 1 , read );
+
+    // TEST 2.3: The bytes of the spans are identical to the bytes written to the file.
+    EXPECT ( memory_equal ( buffer , in_line , in_line_length ) );
+    EXPECT_EQ ( '\n' , buffer[ in_line_length ] );
+
+    file_close ( &file );
+
+    // TEST 3: File writer buffers writes.
+
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( _file_writer_create ( &file , 256 , 3 * ( in_line_length + 1 ) , &writer ) );
+
+    // TEST 3.1: _file_writer_create allocates memory for the buffer.
+    EXPECT_EQ ( file_open_amount_allocated + 256 , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+
+    // TEST 3.2: file_writer_write_line succeeds.
+    EXPECT ( _file_writer_write_line ( &writer , in_line ) );
+
+    // TEST 3.3: Below the threshold, nothing is written to the file.
+    EXPECT_EQ ( in_line_length + 1 , writer.length );
+    EXPECT_EQ ( 0 , file_size ( &file ) );
+
+    // TEST 3.4: file_writer_flush writes the buffered content to the file.
+    EXPECT ( file_writer_flush ( &writer ) );
+    EXPECT_EQ ( 0 , writer.length );
+    EXPECT_EQ ( in_line_length + 1 , file_size ( &file ) );
+
+    // TEST 3.5: file_writer_flush succeeds if the buffer is empty.
+    EXPECT ( file_writer_flush ( &writer ) );
+    EXPECT_EQ ( in_line_length + 1 , file_size ( &file ) );
+
+    // TEST 3.6: Reaching the threshold flushes automatically.
+    EXPECT ( _file_writer_write_line ( &writer , in_line ) );
+    EXPECT ( _file_writer_write_line ( &writer , in_line ) );
+    EXPECT_EQ ( in_line_length + 1 , file_size ( &file ) );
+    EXPECT ( _file_writer_write_line ( &writer , in_line ) );
+    EXPECT_EQ ( 0 , writer.length );
+    EXPECT_EQ ( 4 * ( in_line_length + 1 ) , file_size ( &file ) );
+
+    // TEST 3.7: A write which does not fit in the buffer is written to the file immediately, after the buffered content.
+    EXPECT ( _file_writer_write ( &writer , "abc" ) );
+    EXPECT ( file_writer_write ( &writer , sizeof ( large ) , large ) );
+    EXPECT_EQ ( 0 , writer.length );
+    EXPECT_EQ ( 4 * ( in_line_length + 1 ) + 3 + sizeof ( large ) , file_size ( &file ) );
+
+    // TEST 3.8: file_writer_write succeeds if size of input buffer is 0.
+    EXPECT ( file_writer_write ( &writer , 0 , buffer ) );
+    EXPECT_EQ ( 0 , writer.length );
+
+    // TEST 3.9: file_writer_destroy writes the buffered content to the file.
+    EXPECT ( _file_writer_write ( &writer , "xyz" ) );
+    EXPECT_EQ ( 4 * ( in_line_length + 1 ) + 3 + sizeof ( large ) , file_size ( &file ) );
+    const u32 checksum = writer.checksum;
+    EXPECT ( file_writer_destroy ( &writer ) );
+    EXPECT_EQ ( 4 * ( in_line_length + 1 ) + 6 + sizeof ( large ) , file_size ( &file ) );
+
+    // TEST 3.10: file_writer_destroy frees the buffer.
+    EXPECT_EQ ( file_open_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( 0 , writer.buffer );
+
+    // TEST 3.11: file_writer_destroy succeeds if the writer was already destroyed.
+    EXPECT ( file_writer_destroy ( &writer ) );
+
+    file_close ( &file );
+
+    // TEST 3.12: The bytes written via the writer appear in the file in order.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT ( file_read ( &file , file_size ( &file ) , buffer , &read ) );
+    for ( u64 i = 0; i < 4; ++i )
+    {
+        EXPECT ( memory_equal ( buffer + i * ( in_line_length + 1 ) , in_line , in_line_length ) );
+        EXPECT_EQ ( '\n' , buffer[ i * ( in_line_length + 1 ) + in_line_length ] );
+    }
+    EXPECT ( memory_equal ( buffer + 4 * ( in_line_length + 1 ) , "abc" , 3 ) );
+    EXPECT ( memory_equal ( buffer + 4 * ( in_line_length + 1 ) + 3 , large , sizeof ( large ) ) );
+    EXPECT ( memory_equal ( buffer + 4 * ( in_line_length + 1 ) + 3 + sizeof ( large ) , "xyz" , 3 ) );
+
+    // TEST 3.13: The writer's checksum is the CRC32C of every byte written via the writer.
+    EXPECT_EQ ( checksum_crc32c ( buffer , read , 0 ) , checksum );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_file_compressed
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const char* in_line = "This is the line to be written to the file.";
+    const u64 in_line_length = _string_length ( in_line );
+    const u64 line_count = 40;
+    char content[ 4096 ];
+    char large[ 300 ];
+    file_t file;
+    file_writer_t writer;
+    file_reader_t reader;
+    const char* line;
+    u64 length;
+    u64 written;
+    u64 read;
+
+    for ( u64 i = 0; i < sizeof ( large ); ++i )
+    {
+        large[ i ] = 'a' + i % 26;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: _file_writer_create_compressed handles invalid arguments, and does not allocate memory on failure.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    const u64 file_open_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    EXPECT_NOT ( file_writer_create_compressed ( 0 , &writer ) );
+    EXPECT_NOT ( _file_writer_create_compressed ( &file , 64 , 65 , &writer ) );
+    EXPECT_NOT ( file_reader_create_compressed ( &file , 0 ) );
+    EXPECT_EQ ( file_open_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+
+    // TEST 2: A compressing writer writes each buffer it flushes as a frame.
+    EXPECT ( _file_writer_create_compressed ( &file , 256 , 128 , &writer ) );
+    for ( u64 i = 0; i < line_count; ++i )
+    {
+        EXPECT ( _file_writer_write_line ( &writer , in_line ) );
+    }
+    EXPECT ( file_writer_write_line ( &writer , sizeof ( large ) , large ) );
+    EXPECT ( file_size ( &file ) > 0 );
+    const u32 checksum = writer.checksum;
+    EXPECT ( file_writer_destroy ( &writer ) );
+    EXPECT_EQ ( file_open_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+
+    // TEST 3: The file is smaller than the content written to it.
+    const u64 size = file_size ( &file );
+    EXPECT ( size < line_count * ( in_line_length + 1 ) + sizeof ( large ) + 1 );
+    file_close ( &file );
+
+    // TEST 4: A compressed reader reads back every line written, growing its buffer to hold a whole frame.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT ( _file_reader_create_compressed ( &file , 16 , &reader ) );
+    for ( u64 i = 0; i < line_count; ++i )
+    {
+        EXPECT ( file_reader_next_line ( &reader , &line , &length ) );
+        EXPECT_EQ ( in_line_length , length );
+        EXPECT ( memory_equal ( line , in_line , length ) );
+    }
+    EXPECT ( file_reader_next_line ( &reader , &line , &length ) );
+    EXPECT_EQ ( sizeof ( large ) , length );
+    EXPECT ( memory_equal ( line , large , length ) );
+    EXPECT_NOT ( file_reader_next_line ( &reader , &line , &length ) );
+
+    // TEST 5: The reader's checksum matches the writer's.
+    EXPECT_EQ ( checksum , reader.checksum );
+
+    // TEST 6: file_reader_destroy frees the frame buffer.
+    file_reader_destroy ( &reader );
+    EXPECT_EQ ( file_open_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+
+    EXPECT ( file_position_set ( &file , 0 ) );
+    EXPECT ( file_read ( &file , size , content , &read ) );
+    EXPECT_EQ ( size , read );
+    file_close ( &file );
+
+    // TEST 7: A file which ends partway through a frame reads as if it ended before that frame (i.e. partway through the last line).
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( file_write ( &file , size - 5 , content , &written ) );
+    file_close ( &file );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT ( file_reader_create_compressed ( &file , &reader ) );
+    u64 count = 0;
+    while ( file_reader_next_line ( &reader , &line , &length ) )
+    {
+        if ( count < line_count )
+        {
+            EXPECT_EQ ( in_line_length , length );
+            EXPECT ( memory_equal ( line , in_line , length ) );
+        }
+        else
+        {
+            EXPECT ( length < sizeof ( large ) );
+            EXPECT ( memory_equal ( line , large , length ) );
+        }
+        count += 1;
+    }
+    EXPECT ( count > 0 );
+    EXPECT ( count <= line_count + 1 );
+    file_reader_destroy ( &reader );
+    file_close ( &file );
+
+    // TEST 8: A damaged frame is detected.
+    content[ COMPRESS_FRAME_HEADER_SIZE + 1 ] ^= 0x20;
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( file_write ( &file , size , content , &written ) );
+    file_close ( &file );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT ( file_reader_create_compressed ( &file , &reader ) );
+    EXPECT_NOT ( file_reader_next_line ( &reader , &line , &length ) );
+    file_reader_destroy ( &reader );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_file_read_all
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 string_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    string_amount_allocated = memory_amount_allocated ( MEMORY_TAG_STRING );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 filesize = MiB ( 100 );
+    file_t file;
+    u64 read;
+    u64 written;
+
+    char* string_in = string_allocate ( filesize + 1 );
+    u8* string_out;
+
+    ////////////////////////////////////////////////////////////////////////////
+
+    // TEST 1: file_read_all handles invalid arguments.
 
     LOGWARN ( "The following errors are intentionally triggered by a test:" );
 
@@ -1179,16 +1962,641 @@ test_file_read_and_write_large_file
     return true;
 }
 
+u8
+test_file_hints
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    file_t file;
+    u64 read;
+    u64 written;
+
+    // Unaligned total size, so the end of the file needs special handling.
+    const u64 size = 2 * FILE_DIRECT_ALIGNMENT + 100;
+    const u64 capacity = 3 * FILE_DIRECT_ALIGNMENT;
+    u8* content = memory_allocate_aligned ( capacity , FILE_DIRECT_ALIGNMENT , MEMORY_TAG_FILE );
+    u8* buffer = memory_allocate_aligned ( capacity , FILE_DIRECT_ALIGNMENT , MEMORY_TAG_FILE );
+    for ( u64 i = 0; i < capacity; ++i )
+    {
+        content[ i ] = ( u8 )( i * 31 + 7 );
+    }
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: file_preallocate handles invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    // TEST 1.1: file_preallocate fails if no file is provided.
+    EXPECT_NOT ( file_preallocate ( 0 , KiB ( 64 ) ) );
+
+    // TEST 1.2: file_preallocate fails if the provided file is not open for writing.
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE , FILE_MODE_READ , &file ) );
+    EXPECT_NOT ( file_preallocate ( &file , KiB ( 64 ) ) );
+    file_close ( &file );
+
+    // TEST 1.3: file_preallocate fails if the provided file is closed.
+    EXPECT_NOT ( file_preallocate ( &file , KiB ( 64 ) ) );
+
+    // TEST 2: Sequential writes to a preallocated file.
+
+    // TEST 2.1: file_open succeeds with an access pattern hint.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE | FILE_MODE_SEQUENTIAL , &file ) );
+
+    // TEST 2.2: file_preallocate succeeds, and leaves the file size and position unchanged.
+    EXPECT ( file_preallocate ( &file , MiB ( 1 ) ) );
+    EXPECT ( file_preallocate ( &file , 0 ) );
+    EXPECT_EQ ( 0 , file_size ( &file ) );
+    EXPECT_EQ ( 0 , file_position_get ( &file ) );
+
+    // TEST 2.3: Writes to the preallocated file succeed.
+    EXPECT ( file_write ( &file , size , content , &written ) );
+    EXPECT_EQ ( size , written );
+    EXPECT_EQ ( size , file_size ( &file ) );
+    file_close ( &file );
+
+    // TEST 3: Direct reads.
+
+    // TEST 3.1: file_open succeeds in direct mode.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ | FILE_MODE_DIRECT | FILE_MODE_SEQUENTIAL , &file ) );
+    EXPECT_EQ ( size , file_size ( &file ) );
+
+    // TEST 3.2: An aligned read may request past the end of the file.
+    memory_clear ( buffer , capacity );
+    EXPECT ( file_read ( &file , capacity , buffer , &read ) );
+    EXPECT_EQ ( size , read );
+    EXPECT ( memory_equal ( buffer , content , size ) );
+    EXPECT_EQ ( size , file_position_get ( &file ) );
+
+    // TEST 3.3: Aligned positional reads succeed.
+    memory_clear ( buffer , capacity );
+    EXPECT ( file_read_at ( &file , FILE_DIRECT_ALIGNMENT , FILE_DIRECT_ALIGNMENT , buffer , &read ) );
+    EXPECT_EQ ( FILE_DIRECT_ALIGNMENT , read );
+    EXPECT ( memory_equal ( buffer , content + FILE_DIRECT_ALIGNMENT , FILE_DIRECT_ALIGNMENT ) );
+    file_close ( &file );
+
+    // TEST 4: Direct writes.
+
+    // TEST 4.1: Aligned writes, followed by an unaligned write at the end of the file, succeed.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE | FILE_MODE_DIRECT , &file ) );
+    EXPECT ( file_preallocate ( &file , capacity ) );
+    EXPECT ( file_write ( &file , 2 * FILE_DIRECT_ALIGNMENT , content , &written ) );
+    EXPECT_EQ ( 2 * FILE_DIRECT_ALIGNMENT , written );
+    EXPECT ( file_write ( &file , size - written , content + written , &written ) );
+    EXPECT_EQ ( size , file_size ( &file ) );
+    file_close ( &file );
+
+    // TEST 4.2: The written file has the expected content.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ | FILE_MODE_RANDOM , &file ) );
+    EXPECT_EQ ( size , file_size ( &file ) );
+    memory_clear ( buffer , capacity );
+    EXPECT ( file_read_at ( &file , 0 , capacity , buffer , &read ) );
+    EXPECT_EQ ( size , read );
+    EXPECT ( memory_equal ( buffer , content , size ) );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    memory_free_aligned ( content , capacity , FILE_DIRECT_ALIGNMENT , MEMORY_TAG_FILE );
+    memory_free_aligned ( buffer , capacity , FILE_DIRECT_ALIGNMENT , MEMORY_TAG_FILE );
+
+    return true;
+}
+
+u8
+test_file_copy_and_transfer
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    file_t file;
+    file_t src;
+    u64 read;
+    u64 transferred;
+    char buffer[ 256 ];
+
+    const u64 content_length = _string_length ( file_content_test_in_file );
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: file_copy and file_transfer handle invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    // TEST 1.1: file_copy fails if no source filepath is provided.
+    EXPECT_NOT ( file_copy ( 0 , FILE_NAME_TEST_OUT_FILE ) );
+
+    // TEST 1.2: file_copy fails if no destination filepath is provided.
+    EXPECT_NOT ( file_copy ( FILE_NAME_TEST_IN_FILE , 0 ) );
+
+    // TEST 1.3: file_copy fails if the source file does not exist.
+    EXPECT_NOT ( file_copy ( FILE_NAME_TEST_DNE , FILE_NAME_TEST_OUT_FILE ) );
+    EXPECT_NOT ( file_exists ( FILE_NAME_TEST_DNE , FILE_MODE_ACCESS ) );
+
+    // TEST 1.4: file_copy fails if the source and destination are the same file.
+    EXPECT_NOT ( file_copy ( FILE_NAME_TEST_IN_FILE , FILE_NAME_TEST_IN_FILE ) );
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE , FILE_MODE_READ , &src ) );
+    EXPECT_EQ ( content_length , file_size ( &src ) );
+
+    // TEST 1.5: file_transfer fails if no destination file is provided.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT_NOT ( file_transfer ( 0 , &src , 0 , content_length , &transferred ) );
+
+    // TEST 1.6: file_transfer fails if no source file is provided.
+    EXPECT_NOT ( file_transfer ( &file , 0 , 0 , content_length , &transferred ) );
+
+    // TEST 1.7: file_transfer fails if no output buffer is provided.
+    EXPECT_NOT ( file_transfer ( &file , &src , 0 , content_length , 0 ) );
+
+    // TEST 1.8: file_transfer fails if the source file is not open for reading.
+    EXPECT_NOT ( file_transfer ( &file , &file , 0 , content_length , &transferred ) );
+    EXPECT_EQ ( 0 , transferred );
+
+    // TEST 1.9: file_transfer fails if the destination file is not open for writing.
+    EXPECT_NOT ( file_transfer ( &src , &src , 0 , content_length , &transferred ) );
+    EXPECT_EQ ( 0 , transferred );
+
+    // TEST 2: file_transfer.
+
+    // TEST 2.1: file_transfer copies a range from the source file to the destination file position.
+    EXPECT ( file_write ( &file , 3 , "abc" , &read ) );
+    EXPECT ( file_transfer ( &file , &src , 10 , 9 , &transferred ) );
+    EXPECT_EQ ( 9 , transferred );
+    EXPECT_EQ ( 12 , file_position_get ( &file ) );
+    EXPECT_EQ ( 12 , file_size ( &file ) );
+
+    // TEST 2.2: file_transfer stops at the end of the source file.
+    EXPECT ( file_transfer ( &file , &src , content_length - 4 , 100 , &transferred ) );
+    EXPECT_EQ ( 4 , transferred );
+    EXPECT_EQ ( 16 , file_size ( &file ) );
+    EXPECT ( file_transfer ( &file , &src , content_length + 1 , 100 , &transferred ) );
+    EXPECT_EQ ( 0 , transferred );
+
+    // TEST 2.3: file_transfer does not modify the source file position.
+    EXPECT_EQ ( 0 , file_position_get ( &src ) );
+    file_close ( &file );
+
+    // TEST 2.4: The destination file has the expected content.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT_EQ ( 16 , file_size ( &file ) );
+    EXPECT ( file_read ( &file , 16 , buffer , &read ) );
+    EXPECT ( memory_equal ( buffer , "abc" , 3 ) );
+    EXPECT ( memory_equal ( buffer + 3 , file_content_test_in_file + 10 , 9 ) );
+    EXPECT ( memory_equal ( buffer + 12 , file_content_test_in_file + content_length - 4 , 4 ) );
+    file_close ( &file );
+    file_close ( &src );
+
+    // TEST 3: file_copy.
+
+    // TEST 3.1: file_copy replaces the content of an existing file.
+    EXPECT ( file_copy ( FILE_NAME_TEST_IN_FILE , FILE_NAME_TEST_OUT_FILE ) );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT_EQ ( content_length , file_size ( &file ) );
+    EXPECT ( file_read ( &file , content_length , buffer , &read ) );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file , content_length ) );
+    file_close ( &file );
+
+    // TEST 3.2: file_copy copies a binary file.
+    EXPECT ( file_copy ( FILE_NAME_TEST_IN_FILE_BINARY , FILE_NAME_TEST_OUT_FILE ) );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT_EQ ( sizeof ( file_content_test_in_file_binary ) , file_size ( &file ) );
+    EXPECT ( file_read ( &file , sizeof ( file_content_test_in_file_binary ) , buffer , &read ) );
+    EXPECT ( memory_equal ( buffer , file_content_test_in_file_binary , sizeof ( file_content_test_in_file_binary ) ) );
+    file_close ( &file );
+
+    // TEST 3.3: file_copy copies an empty file.
+    EXPECT ( file_copy ( FILE_NAME_TEST_IN_FILE_EMPTY , FILE_NAME_TEST_OUT_FILE ) );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ , &file ) );
+    EXPECT_EQ ( 0 , file_size ( &file ) );
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+/** @brief Type definition for the state of a file stream test. */
+typedef struct
+{
+    const u8*   expected;
+    u64         chunk_size;
+    u64         stop_after;
+    u64         chunks;
+    u64         total;
+    bool        valid;
+}
+test_file_stream_t;
+
+/**
+ * @brief File stream callback: verifies each chunk arrives in order, with the
+ * expected content.
+ */
+bool
+test_file_stream_function
+(   const void* data
+,   u64         size
+,   u64         offset
+,   void*       args
+)
+{
+    test_file_stream_t* state = args;
+    if ( offset != ( *state ).total
+      || size > ( *state ).chunk_size
+      || !memory_equal ( data , ( *state ).expected + offset , size )
+       )
+    {
+        ( *state ).valid = false;
+    }
+    ( *state ).chunks += 1;
+    ( *state ).total += size;
+    return ( *state ).chunks != ( *state ).stop_after;
+}
+
+u8
+test_file_stream
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    file_t file;
+    u64 written;
+    test_file_stream_t state;
+
+    const u64 size = 10 * FILE_DIRECT_ALIGNMENT + 123;
+    u8* content = memory_allocate ( size , MEMORY_TAG_FILE );
+    for ( u64 i = 0; i < size; ++i )
+    {
+        content[ i ] = ( u8 )( i * 131 + ( i >> 8 ) );
+    }
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    EXPECT ( file_write ( &file , size , content , &written ) );
+    EXPECT_EQ ( size , written );
+    file_close ( &file );
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ | FILE_MODE_SEQUENTIAL , &file ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: _file_stream handles invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    // TEST 1.1: _file_stream fails if no file is provided.
+    EXPECT_NOT ( file_stream ( 0 , test_file_stream_function , &state ) );
+
+    // TEST 1.2: _file_stream fails if chunk size is zero.
+    EXPECT_NOT ( _file_stream ( &file , 0 , true , test_file_stream_function , &state ) );
+
+    // TEST 1.3: _file_stream fails if no callback function is provided.
+    EXPECT_NOT ( file_stream ( &file , 0 , &state ) );
+
+    // TEST 2: Streaming a file.
+
+    // TEST 2.1: _file_stream passes every chunk to the callback in order, with or without prefetch.
+    for ( u64 prefetch = 0; prefetch < 2; ++prefetch )
+    {
+        memory_clear ( &state , sizeof ( test_file_stream_t ) );
+        state.expected = content;
+        state.chunk_size = 2 * FILE_DIRECT_ALIGNMENT;
+        state.valid = true;
+        EXPECT ( _file_stream ( &file , 2 * FILE_DIRECT_ALIGNMENT , prefetch , test_file_stream_function , &state ) );
+        EXPECT ( state.valid );
+        EXPECT_EQ ( 6 , state.chunks );
+        EXPECT_EQ ( size , state.total );
+    }
+
+    // TEST 2.2: _file_stream rounds chunk size up to FILE_DIRECT_ALIGNMENT.
+    memory_clear ( &state , sizeof ( test_file_stream_t ) );
+    state.expected = content;
+    state.chunk_size = FILE_DIRECT_ALIGNMENT;
+    state.valid = true;
+    EXPECT ( _file_stream ( &file , 1 , true , test_file_stream_function , &state ) );
+    EXPECT ( state.valid );
+    EXPECT_EQ ( 11 , state.chunks );
+    EXPECT_EQ ( size , state.total );
+
+    // TEST 2.3: file_stream passes a file smaller than the default chunk size in a single chunk.
+    memory_clear ( &state , sizeof ( test_file_stream_t ) );
+    state.expected = content;
+    state.chunk_size = FILE_STREAM_DEFAULT_CHUNK_SIZE;
+    state.valid = true;
+    EXPECT ( file_stream ( &file , test_file_stream_function , &state ) );
+    EXPECT ( state.valid );
+    EXPECT_EQ ( 1 , state.chunks );
+    EXPECT_EQ ( size , state.total );
+
+    // TEST 2.4: _file_stream stops early if the callback returns false.
+    for ( u64 prefetch = 0; prefetch < 2; ++prefetch )
+    {
+        memory_clear ( &state , sizeof ( test_file_stream_t ) );
+        state.expected = content;
+        state.chunk_size = FILE_DIRECT_ALIGNMENT;
+        state.stop_after = 3;
+        state.valid = true;
+        EXPECT ( _file_stream ( &file , FILE_DIRECT_ALIGNMENT , prefetch , test_file_stream_function , &state ) );
+        EXPECT ( state.valid );
+        EXPECT_EQ ( 3 , state.chunks );
+        EXPECT_EQ ( 3 * FILE_DIRECT_ALIGNMENT , state.total );
+    }
+
+    // TEST 2.5: _file_stream does not modify the file position.
+    EXPECT_EQ ( 0 , file_position_get ( &file ) );
+
+    file_close ( &file );
+
+    // TEST 2.6: _file_stream never invokes the callback on an empty file.
+    EXPECT ( file_open ( FILE_NAME_TEST_IN_FILE_EMPTY , FILE_MODE_READ , &file ) );
+    memory_clear ( &state , sizeof ( test_file_stream_t ) );
+    EXPECT ( file_stream ( &file , test_file_stream_function , &state ) );
+    EXPECT_EQ ( 0 , state.chunks );
+    file_close ( &file );
+
+    // TEST 2.7: _file_stream fails if the file is closed.
+    EXPECT_NOT ( file_stream ( &file , test_file_stream_function , &state ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    memory_free ( content , size , MEMORY_TAG_FILE );
+
+    return true;
+}
+
+/** @brief Type definition for the results of a directory walk. */
+typedef struct
+{
+    bool    skip_platform;
+    u64     files;
+    u64     directories;
+    u64     found_main;
+    u64     found_test_filesystem;
+    u64     errors;
+}
+test_directory_walk_t;
+
+/**
+ * @brief Directory walk callback: counts entries and looks for known files.
+ */
+bool
+test_directory_walk_function
+(   const char*                 path
+,   u64                         path_length
+,   const directory_entry_t*    entry
+,   void*                       args
+)
+{
+    test_directory_walk_t* results = args;
+
+    if ( path_length != _string_length ( path ) || ( *entry ).name_length != _string_length ( ( *entry ).name ) )
+    {
+        atomic_fetch_add_u64 ( &( *results ).errors , 1 , ATOMIC_RELAXED );
+    }
+
+    if ( ( *entry ).type == FILE_TYPE_DIRECTORY )
+    {
+        atomic_fetch_add_u64 ( &( *results ).directories , 1 , ATOMIC_RELAXED );
+        return !( ( *results ).skip_platform && _string_equal ( ( *entry ).name , "platform" ) );
+    }
+
+    if ( ( *entry ).type == FILE_TYPE_FILE )
+    {
+        atomic_fetch_add_u64 ( &( *results ).files , 1 , ATOMIC_RELAXED );
+    }
+    if ( _string_equal ( path , "test/src" ) && _string_equal ( ( *entry ).name , "main.c" ) )
+    {
+        atomic_fetch_add_u64 ( &( *results ).found_main , 1 , ATOMIC_RELAXED );
+    }
+    if ( _string_equal ( path , "test/src/platform" ) && _string_equal ( ( *entry ).name , "test_filesystem.c" ) )
+    {
+        atomic_fetch_add_u64 ( &( *results ).found_test_filesystem , 1 , ATOMIC_RELAXED );
+    }
+    return true;
+}
+
+u8
+test_directory
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    directory_t directory;
+    directory_entry_t entry;
+    test_directory_walk_t results;
+    test_directory_walk_t parallel_results;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Directory functions handle invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    // TEST 1.1: directory_open fails if no path is provided.
+    EXPECT_NOT ( directory_open ( 0 , &directory ) );
+    EXPECT_NOT ( directory.valid );
+
+    // TEST 1.2: directory_open fails if no output buffer is provided.
+    EXPECT_NOT ( directory_open ( "test/assets" , 0 ) );
+
+    // TEST 1.3: directory_open fails if the directory does not exist.
+    EXPECT_NOT ( directory_open ( FILE_NAME_TEST_DNE , &directory ) );
+    EXPECT_NOT ( directory.valid );
+
+    // TEST 1.4: directory_open fails if the path is not a directory.
+    EXPECT_NOT ( directory_open ( FILE_NAME_TEST_IN_FILE , &directory ) );
+    EXPECT_NOT ( directory.valid );
+
+    // TEST 1.5: directory_next fails if no directory is provided.
+    EXPECT_NOT ( directory_next ( 0 , &entry ) );
+
+    // TEST 1.6: directory_next fails if the provided directory is invalid.
+    EXPECT_NOT ( directory_next ( &directory , &entry ) );
+
+    // TEST 1.7: directory_next fails if no output buffer is provided.
+    EXPECT ( directory_open ( "test/assets" , &directory ) );
+    EXPECT_NOT ( directory_next ( &directory , 0 ) );
+    directory_close ( &directory );
+
+    // TEST 1.8: directory_walk fails if no path is provided.
+    EXPECT_NOT ( directory_walk ( 0 , false , test_directory_walk_function , &results ) );
+
+    // TEST 1.9: directory_walk fails if no callback function is provided.
+    EXPECT_NOT ( directory_walk ( "test/src" , false , 0 , &results ) );
+
+    // TEST 1.10: directory_walk fails if the directory does not exist.
+    memory_clear ( &results , sizeof ( test_directory_walk_t ) );
+    EXPECT_NOT ( directory_walk ( FILE_NAME_TEST_DNE , false , test_directory_walk_function , &results ) );
+    EXPECT_EQ ( 0 , results.files + results.directories );
+
+    // TEST 2: Enumerating a directory.
+
+    // TEST 2.1: directory_open succeeds.
+    EXPECT ( directory_open ( "test/assets" , &directory ) );
+    EXPECT ( directory.valid );
+
+    // TEST 2.2: directory_next reports every input file with the correct type, and skips `.` and `..`.
+    u64 found = 0;
+    while ( directory_next ( &directory , &entry ) )
+    {
+        EXPECT_EQ ( _string_length ( entry.name ) , entry.name_length );
+        EXPECT_NOT ( _string_equal ( entry.name , "." ) );
+        EXPECT_NOT ( _string_equal ( entry.name , ".." ) );
+        if ( _string_equal ( entry.name , "in-file.txt" )
+          || _string_equal ( entry.name , "in-file-empty.txt" )
+          || _string_equal ( entry.name , "in-file-binary" )
+           )
+        {
+            EXPECT_EQ ( FILE_TYPE_FILE , entry.type );
+            found += 1;
+        }
+    }
+    EXPECT_EQ ( 3 , found );
+
+    // TEST 2.3: directory_next fails once the end of the directory is reached.
+    EXPECT_NOT ( directory_next ( &directory , &entry ) );
+
+    // TEST 2.4: directory_close invalidates the directory.
+    directory_close ( &directory );
+    EXPECT_NOT ( directory.valid );
+    EXPECT_NOT ( directory_next ( &directory , &entry ) );
+
+    // TEST 2.5: directory_close does nothing if the directory was already closed.
+    directory_close ( &directory );
+    directory_close ( 0 );
+
+    // TEST 2.6: _directory_open can report the size of each regular file.
+    EXPECT ( _directory_open ( "test/assets/" , true , &directory ) );
+    found = 0;
+    while ( directory_next ( &directory , &entry ) )
+    {
+        if ( _string_equal ( entry.name , "in-file.txt" ) )
+        {
+            EXPECT_EQ ( _string_length ( file_content_test_in_file ) , entry.size );
+            found += 1;
+        }
+        else if ( _string_equal ( entry.name , "in-file-binary" ) )
+        {
+            EXPECT_EQ ( sizeof ( file_content_test_in_file_binary ) , entry.size );
+            found += 1;
+        }
+        else if ( _string_equal ( entry.name , "in-file-empty.txt" ) )
+        {
+            EXPECT_EQ ( 0 , entry.size );
+            found += 1;
+        }
+    }
+    EXPECT_EQ ( 3 , found );
+    directory_close ( &directory );
+
+    // TEST 3: Walking a directory tree.
+
+    // TEST 3.1: directory_walk visits every entry beneath the directory.
+    memory_clear ( &results , sizeof ( test_directory_walk_t ) );
+    EXPECT ( directory_walk ( "test/src" , false , test_directory_walk_function , &results ) );
+    EXPECT_EQ ( 0 , results.errors );
+    EXPECT_EQ ( 1 , results.found_main );
+    EXPECT_EQ ( 1 , results.found_test_filesystem );
+    EXPECT_NEQ ( 0 , results.directories );
+    EXPECT ( results.files > results.directories );
+
+    // TEST 3.2: directory_walk does not descend into a directory if the callback returns false.
+    memory_clear ( &parallel_results , sizeof ( test_directory_walk_t ) );
+    parallel_results.skip_platform = true;
+    EXPECT ( directory_walk ( "test/src/" , false , test_directory_walk_function , &parallel_results ) );
+    EXPECT_EQ ( 0 , parallel_results.found_test_filesystem );
+    EXPECT ( parallel_results.files < results.files );
+
+    // TEST 3.3: directory_walk visits the same entries when run on the job system.
+    EXPECT ( job_system_startup ( 2 , 0 , 0 ) );
+    memory_clear ( &parallel_results , sizeof ( test_directory_walk_t ) );
+    EXPECT ( directory_walk ( "test/src" , false , test_directory_walk_function , &parallel_results ) );
+    job_system_shutdown ();
+    EXPECT_EQ ( 0 , parallel_results.errors );
+    EXPECT_EQ ( 1 , parallel_results.found_main );
+    EXPECT_EQ ( 1 , parallel_results.found_test_filesystem );
+    EXPECT_EQ ( results.directories , parallel_results.directories );
+    EXPECT_EQ ( results.files , parallel_results.files );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
 void
 test_register_filesystem
 ( void )
 {
-    test_register ( test_file_exists , "Querying the host platform for the existence of a file." );
-    test_register ( test_file_open_and_close , "Opening or closing a file on the host platform." );
-    test_register ( test_file_read , "Reading a file on the host platform into a local buffer." );
-    test_register ( test_file_write , "Writing from a local buffer to a file on the host platform." );
-    test_register ( test_file_read_line , "Reading a line of text from a file on the host platform." );
-    test_register ( test_file_write_line , "Writing a line of text to a file on the host platform." );
-    test_register ( test_file_read_all , "Reading the entire contents of a file on the host platform into program memory." );
-    test_register ( test_file_read_and_write_large_file , "Testing file 'read' and 'write' operations on a file larger than 4 GiB." );
+    test_register_serial ( test_file_exists , "Querying the host platform for the existence of a file." );
+    test_register_serial ( test_file_open_and_close , "Opening or closing a file on the host platform." );
+    test_register_serial ( test_file_read , "Reading a file on the host platform into a local buffer." );
+    test_register_serial ( test_file_read_at , "Reading a file on the host platform at a specified offset, without using the file position." );
+    test_register_serial ( test_file_write , "Writing from a local buffer to a file on the host platform." );
+    test_register_serial ( test_file_read_line , "Reading a line of text from a file on the host platform." );
+    test_register_serial ( test_file_reader , "Reading consecutive lines of text from a file on the host platform through a buffered reader." );
+    test_register_serial ( test_file_reader_next_line , "Iterating over the lines of a file on the host platform without copying them." );
+    test_register_serial ( test_file_write_line , "Writing a line of text to a file on the host platform." );
+    test_register_serial ( test_file_writer , "Writing to a file on the host platform through a buffered writer." );
+    test_register_serial ( test_file_compressed , "Writing a compressed file through a buffered writer, and reading it back." );
+    test_register_serial ( test_file_read_all , "Reading the entire contents of a file on the host platform into program memory." );
+    test_register_serial ( test_file_map , "Mapping the contents of a file on the host platform into program memory." );
+    test_register_serial ( test_file_hints , "Opening a file with access pattern hints or in direct mode, and preallocating it." );
+    test_register_serial ( test_file_copy_and_transfer , "Copying a file, or a range of one file into another." );
+    test_register_serial ( test_file_stream , "Streaming the contents of a file in fixed-size chunks." );
+    test_register_serial ( test_directory , "Enumerating the entries of a directory on the host platform." );
+    test_register_serial ( test_file_read_and_write_large_file , "Testing file 'read' and 'write' operations on a file larger than 4 GiB." );
 }
\ No newline at end of file
@@ -0,0 +1,322 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_io_queue.c
+ * @brief Implementation of the platform/test_io_queue header.
+ * (see platform/test_io_queue.h for additional details)
+ */
+#include "platform/test_io_queue.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#define FILE_NAME_TEST_OUT_FILE "test/assets/out-file"
+
+/** @brief Number of blocks written and read by the test. */
+#define TEST_IO_QUEUE_BLOCK_COUNT 16
+
+/** @brief Size of each block written and read by the test (in bytes). */
+#define TEST_IO_QUEUE_BLOCK_SIZE KiB ( 4 )
+
+/** @brief Computes current global number of unfreed allocations. */
+#define MEMORY_ALLOCATION_COUNT \
+    ( memory_allocation_count () - memory_free_count () )
+
+/** @brief Type definition for the arguments to a checksum job. */
+typedef struct
+{
+    const u8*   data;
+    u64         size;
+    u64         sum;
+}
+checksum_args_t;
+
+/**
+ * @brief Job: sums the bytes of a block which was read.
+ */
+void
+test_io_queue_checksum
+(   void* args
+)
+{
+    checksum_args_t* checksum = args;
+    u64 sum = 0;
+    for ( u64 i = 0; i < ( *checksum ).size; ++i )
+    {
+        sum += ( *checksum ).data[ i ];
+    }
+    ( *checksum ).sum = sum;
+}
+
+/**
+ * @brief Computes the expected content of byte i of the test file.
+ */
+INLINE
+u8
+test_io_queue_byte
+(   u64 i
+)
+{
+    return ( u8 )( ( i * 31 ) ^ ( i >> 12 ) );
+}
+
+u8
+test_io_queue
+( void )
+{
+    u64 global_amount_allocated;
+    u64 file_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    file_amount_allocated = memory_amount_allocated ( MEMORY_TAG_FILE );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    const u64 file_size_expected = TEST_IO_QUEUE_BLOCK_COUNT * TEST_IO_QUEUE_BLOCK_SIZE;
+    u8* content = memory_allocate ( file_size_expected , MEMORY_TAG_ARRAY );
+    u8* blocks = memory_allocate ( file_size_expected , MEMORY_TAG_ARRAY );
+    for ( u64 i = 0; i < file_size_expected; ++i )
+    {
+        content[ i ] = test_io_queue_byte ( i );
+    }
+
+    io_queue_t* queue;
+    io_request_t requests[ TEST_IO_QUEUE_BLOCK_COUNT ];
+    io_request_t* completed[ TEST_IO_QUEUE_BLOCK_COUNT ];
+    file_t file;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: io_queue handles invalid arguments.
+
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+
+    // TEST 1.1: io_queue_create fails if depth is 0.
+    EXPECT_NOT ( io_queue_create ( 0 , &queue ) );
+
+    // TEST 1.2: io_queue_create fails if no output buffer is provided.
+    EXPECT_NOT ( io_queue_create ( 4 , 0 ) );
+
+    EXPECT ( io_queue_create ( 4 , &queue ) );
+
+    // TEST 1.3: io_queue_create clamps depth.
+    io_queue_t* deep_queue;
+    EXPECT ( io_queue_create ( IO_QUEUE_MAX_DEPTH + 1 , &deep_queue ) );
+    EXPECT_EQ ( IO_QUEUE_MAX_DEPTH , io_queue_depth ( deep_queue ) );
+    io_queue_destroy ( &deep_queue );
+    EXPECT_EQ ( 0 , deep_queue );
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_READ | FILE_MODE_WRITE , &file ) );
+
+    memory_clear ( requests , sizeof ( requests ) );
+
+    // TEST 1.4: io_queue_submit fails if no requests are provided.
+    EXPECT_NOT ( io_queue_submit ( queue , 0 , 1 ) );
+
+    // TEST 1.5: io_queue_submit fails if a request has no file.
+    requests[ 0 ].operation = IO_OPERATION_READ;
+    requests[ 0 ].data = blocks;
+    requests[ 0 ].size = 1;
+    EXPECT_NOT ( io_queue_submit ( queue , requests , 1 ) );
+
+    // TEST 1.6: io_queue_submit fails if a request has no data.
+    requests[ 0 ].file = &file;
+    requests[ 0 ].data = 0;
+    EXPECT_NOT ( io_queue_submit ( queue , requests , 1 ) );
+
+    // TEST 1.7: io_queue_submit fails if a request has an invalid operation.
+    requests[ 0 ].data = blocks;
+    requests[ 0 ].operation = 2;
+    EXPECT_NOT ( io_queue_submit ( queue , requests , 1 ) );
+
+    // TEST 1.8: io_queue_submit did not submit any of the invalid requests.
+    EXPECT_EQ ( 0 , io_queue_pending ( queue ) );
+
+    // TEST 1.9: io_queue_poll collects nothing if no requests are in flight.
+    EXPECT_EQ ( 0 , io_queue_poll ( queue , completed , TEST_IO_QUEUE_BLOCK_COUNT ) );
+
+    // TEST 2: Writes.
+
+    // TEST 2.1: io_queue_submit succeeds when submitting more requests than the queue depth.
+    for ( u64 i = 0; i < TEST_IO_QUEUE_BLOCK_COUNT; ++i )
+    {
+        requests[ i ].operation = IO_OPERATION_WRITE;
+        requests[ i ].file = &file;
+        requests[ i ].offset = i * TEST_IO_QUEUE_BLOCK_SIZE;
+        requests[ i ].data = content + i * TEST_IO_QUEUE_BLOCK_SIZE;
+        requests[ i ].size = TEST_IO_QUEUE_BLOCK_SIZE;
+        requests[ i ].job.function = 0;
+    }
+    EXPECT ( io_queue_submit ( queue , requests , TEST_IO_QUEUE_BLOCK_COUNT ) );
+
+    // TEST 2.2: The number of requests in flight never exceeds the queue depth.
+    EXPECT ( io_queue_pending ( queue ) <= io_queue_depth ( queue ) );
+
+    // TEST 2.3: io_queue_flush collects every request.
+    io_queue_flush ( queue );
+    EXPECT_EQ ( 0 , io_queue_pending ( queue ) );
+
+    // TEST 2.4: Every write succeeded.
+    for ( u64 i = 0; i < TEST_IO_QUEUE_BLOCK_COUNT; ++i )
+    {
+        EXPECT ( requests[ i ].success );
+        EXPECT_EQ ( TEST_IO_QUEUE_BLOCK_SIZE , requests[ i ].transferred );
+    }
+
+    // TEST 2.5: The writes extended the file, without modifying the file position.
+    EXPECT_EQ ( file_size_expected , file_size ( &file ) );
+    EXPECT_EQ ( 0 , file_position_get ( &file ) );
+
+    // TEST 3: Reads.
+
+    // TEST 3.1: io_queue_submit succeeds.
+    for ( u64 i = 0; i < TEST_IO_QUEUE_BLOCK_COUNT; ++i )
+    {
+        // Read the blocks in reverse order, into a separate buffer.
+        requests[ i ].operation = IO_OPERATION_READ;
+        requests[ i ].offset = ( TEST_IO_QUEUE_BLOCK_COUNT - 1 - i ) * TEST_IO_QUEUE_BLOCK_SIZE;
+        requests[ i ].data = blocks + requests[ i ].offset;
+    }
+    memory_clear ( blocks , file_size_expected );
+    EXPECT ( io_queue_submit ( queue , requests , 4 ) );
+    EXPECT_EQ ( 4 , io_queue_pending ( queue ) );
+
+    // TEST 3.2: io_queue_wait collects every request exactly once.
+    u64 collected = 0;
+    while ( io_queue_pending ( queue ) )
+    {
+        const u64 count = io_queue_wait ( queue , completed + collected , TEST_IO_QUEUE_BLOCK_COUNT - collected );
+        EXPECT_NEQ ( 0 , count );
+        collected += count;
+    }
+    EXPECT_EQ ( 4 , collected );
+    for ( u64 i = 0; i < 4; ++i )
+    {
+        u64 matches = 0;
+        for ( u64 j = 0; j < collected; ++j )
+        {
+            matches += completed[ j ] == &requests[ i ];
+        }
+        EXPECT_EQ ( 1 , matches );
+    }
+
+    // TEST 3.3: io_queue_wait collects nothing if no requests are in flight.
+    EXPECT_EQ ( 0 , io_queue_wait ( queue , completed , TEST_IO_QUEUE_BLOCK_COUNT ) );
+
+    EXPECT ( io_queue_submit ( queue , requests + 4 , TEST_IO_QUEUE_BLOCK_COUNT - 4 ) );
+    io_queue_flush ( queue );
+
+    // TEST 3.4: Every read succeeded, and read the correct content.
+    for ( u64 i = 0; i < TEST_IO_QUEUE_BLOCK_COUNT; ++i )
+    {
+        EXPECT ( requests[ i ].success );
+        EXPECT_EQ ( TEST_IO_QUEUE_BLOCK_SIZE , requests[ i ].transferred );
+    }
+    EXPECT ( memory_equal ( blocks , content , file_size_expected ) );
+
+    // TEST 3.5: A read stops at the end of the file.
+    requests[ 0 ].offset = file_size_expected - 100;
+    requests[ 0 ].data = blocks;
+    requests[ 0 ].size = TEST_IO_QUEUE_BLOCK_SIZE;
+    EXPECT ( io_queue_submit ( queue , requests , 1 ) );
+    EXPECT_EQ ( 1 , io_queue_wait ( queue , completed , 1 ) );
+    EXPECT_EQ ( &requests[ 0 ] , completed[ 0 ] );
+    EXPECT ( requests[ 0 ].success );
+    EXPECT_EQ ( 100 , requests[ 0 ].transferred );
+    EXPECT ( memory_equal ( blocks , content + file_size_expected - 100 , 100 ) );
+
+    // TEST 3.6: A read of zero bytes succeeds.
+    requests[ 0 ].size = 0;
+    EXPECT ( io_queue_submit ( queue , requests , 1 ) );
+    EXPECT_EQ ( 1 , io_queue_wait ( queue , completed , 1 ) );
+    EXPECT ( requests[ 0 ].success );
+    EXPECT_EQ ( 0 , requests[ 0 ].transferred );
+
+    // TEST 4: Completion jobs.
+
+    EXPECT ( job_system_startup ( 2 , 0 , 0 ) );
+
+    checksum_args_t checksums[ TEST_IO_QUEUE_BLOCK_COUNT ];
+    job_counter_t counter;
+    memory_clear ( &counter , sizeof ( job_counter_t ) );
+    memory_clear ( blocks , file_size_expected );
+    for ( u64 i = 0; i < TEST_IO_QUEUE_BLOCK_COUNT; ++i )
+    {
+        requests[ i ].offset = i * TEST_IO_QUEUE_BLOCK_SIZE;
+        requests[ i ].data = blocks + requests[ i ].offset;
+        requests[ i ].size = TEST_IO_QUEUE_BLOCK_SIZE;
+        checksums[ i ].data = requests[ i ].data;
+        checksums[ i ].size = requests[ i ].size;
+        checksums[ i ].sum = 0;
+        requests[ i ].job.function = test_io_queue_checksum;
+        requests[ i ].job.args = &checksums[ i ];
+        requests[ i ].counter = &counter;
+    }
+
+    // TEST 4.1: The job of each request runs once the request is collected.
+    EXPECT ( io_queue_submit ( queue , requests , TEST_IO_QUEUE_BLOCK_COUNT ) );
+    io_queue_flush ( queue );
+    job_wait ( &counter );
+    EXPECT_EQ ( 0 , job_counter_value ( &counter ) );
+    for ( u64 i = 0; i < TEST_IO_QUEUE_BLOCK_COUNT; ++i )
+    {
+        u64 sum = 0;
+        for ( u64 j = 0; j < TEST_IO_QUEUE_BLOCK_SIZE; ++j )
+        {
+            sum += content[ i * TEST_IO_QUEUE_BLOCK_SIZE + j ];
+        }
+        EXPECT_EQ ( sum , checksums[ i ].sum );
+    }
+
+    job_system_shutdown ();
+
+    // TEST 5: io_queue_destroy.
+
+    // TEST 5.1: io_queue_destroy collects any requests still in flight.
+    for ( u64 i = 0; i < 4; ++i )
+    {
+        requests[ i ].job.function = 0;
+    }
+    EXPECT ( io_queue_submit ( queue , requests , 4 ) );
+    io_queue_destroy ( &queue );
+    EXPECT_EQ ( 0 , queue );
+    for ( u64 i = 0; i < 4; ++i )
+    {
+        EXPECT ( requests[ i ].success );
+    }
+
+    // TEST 5.2: io_queue_destroy does nothing if the queue was already destroyed.
+    io_queue_destroy ( &queue );
+    io_queue_destroy ( 0 );
+
+    file_close ( &file );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Truncate the test file.
+    EXPECT ( file_open ( FILE_NAME_TEST_OUT_FILE , FILE_MODE_WRITE , &file ) );
+    file_close ( &file );
+
+    memory_free ( content , file_size_expected , MEMORY_TAG_ARRAY );
+    memory_free ( blocks , file_size_expected , MEMORY_TAG_ARRAY );
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( file_amount_allocated , memory_amount_allocated ( MEMORY_TAG_FILE ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_io_queue
+( void )
+{
+    test_register_serial ( test_io_queue , "Submitting file reads and writes to the host platform asynchronously." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_io_queue.h
+ * @brief Tests platform/io_queue.h
+ * (see test/test.h, platform/io_queue.h for additional details)
+ */
+#ifndef TEST_IO_QUEUE_H
+#define TEST_IO_QUEUE_H
+
+#include "test/test.h"
+
+#include "platform/io_queue.h"
+
+void
+test_register_io_queue
+( void );
+
+#endif  // TEST_IO_QUEUE_H
@@ -0,0 +1,581 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_lock.c
+ * @brief Implementation of the platform/test_lock header.
+ * (see platform/test_lock.h for additional details)
+ */
+#include "platform/test_lock.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/thread.h"
+
+/** @brief Number of threads contending for a lock. */
+#define TEST_LOCK_THREAD_COUNT 4
+
+/** @brief Number of critical sections entered by each contending thread. */
+#define TEST_LOCK_ITERATIONS ( ( u64 ) 100000 )
+
+/** @brief Type definition for state shared by the contending threads. */
+typedef struct
+{
+    lock_t      lock;
+    spinlock_t  spinlock;
+    rwlock_t    rwlock;
+    condvar_t   condvar;
+    event_t     event;
+    event_t     manual;
+    semaphore_t semaphore;
+    waitgroup_t waitgroup;
+
+    // Guarded by the lock under test.
+    u64         a;
+    u64         b;
+    u64         turn;
+    u64         awake;
+
+    u64         errors;
+}
+shared_t;
+
+/**
+ * @brief Thread: increments a counter under a mutex.
+ */
+u32
+test_lock_mutex_worker
+(   void* args
+)
+{
+    shared_t* shared = args;
+    for ( u64 i = 0; i < TEST_LOCK_ITERATIONS; ++i )
+    {
+        lock_acquire ( &( *shared ).lock );
+        ( *shared ).a += 1;
+        lock_release ( &( *shared ).lock );
+    }
+    return 0;
+}
+
+/**
+ * @brief Thread: increments a counter under a spinlock.
+ */
+u32
+test_lock_spinlock_worker
+(   void* args
+)
+{
+    shared_t* shared = args;
+    for ( u64 i = 0; i < TEST_LOCK_ITERATIONS; ++i )
+    {
+        spinlock_acquire ( &( *shared ).spinlock );
+        ( *shared ).a += 1;
+        spinlock_release ( &( *shared ).spinlock );
+    }
+    return 0;
+}
+
+/**
+ * @brief Thread: increments a pair of counters under a write lock.
+ */
+u32
+test_lock_rwlock_writer
+(   void* args
+)
+{
+    shared_t* shared = args;
+    for ( u64 i = 0; i < TEST_LOCK_ITERATIONS / 10; ++i )
+    {
+        rwlock_acquire_write ( &( *shared ).rwlock );
+        ( *shared ).a += 1;
+        ( *shared ).b += 1;
+        rwlock_release_write ( &( *shared ).rwlock );
+    }
+    return 0;
+}
+
+/**
+ * @brief Thread: verifies a pair of counters are equal under a read lock.
+ */
+u32
+test_lock_rwlock_reader
+(   void* args
+)
+{
+    shared_t* shared = args;
+    for ( u64 i = 0; i < TEST_LOCK_ITERATIONS / 10; ++i )
+    {
+        rwlock_acquire_read ( &( *shared ).rwlock );
+        if ( ( *shared ).a != ( *shared ).b )
+        {
+            atomic_fetch_add_u64 ( &( *shared ).errors , 1 , ATOMIC_RELAXED );
+        }
+        rwlock_release_read ( &( *shared ).rwlock );
+    }
+    return 0;
+}
+
+/**
+ * @brief Thread: takes turns with the main thread, using a condition variable.
+ */
+u32
+test_lock_condvar_ping
+(   void* args
+)
+{
+    shared_t* shared = args;
+    lock_acquire ( &( *shared ).lock );
+    for ( u64 i = 0; i < TEST_LOCK_ITERATIONS / 10; ++i )
+    {
+        while ( ( *shared ).turn % 2 == 0 )
+        {
+            condvar_wait ( &( *shared ).condvar , &( *shared ).lock );
+        }
+        ( *shared ).turn += 1;
+        condvar_signal ( &( *shared ).condvar );
+    }
+    lock_release ( &( *shared ).lock );
+    return 0;
+}
+
+/**
+ * @brief Thread: waits on a condition variable until broadcast to.
+ */
+u32
+test_lock_condvar_sleeper
+(   void* args
+)
+{
+    shared_t* shared = args;
+    lock_acquire ( &( *shared ).lock );
+    ( *shared ).awake += 1;
+    while ( !( *shared ).turn )
+    {
+        condvar_wait ( &( *shared ).condvar , &( *shared ).lock );
+    }
+    ( *shared ).awake -= 1;
+    lock_release ( &( *shared ).lock );
+    return 0;
+}
+
+/**
+ * @brief Thread: waits on an auto-reset event, then counts itself as awake.
+ */
+u32
+test_lock_event_waiter
+(   void* args
+)
+{
+    shared_t* shared = args;
+    event_wait ( &( *shared ).event );
+    atomic_fetch_add_u64 ( &( *shared ).awake , 1 , ATOMIC_SEQ_CST );
+    return 0;
+}
+
+/**
+ * @brief Thread: waits on a manual-reset event, then counts itself as awake.
+ */
+u32
+test_lock_manual_event_waiter
+(   void* args
+)
+{
+    shared_t* shared = args;
+    event_wait ( &( *shared ).manual );
+    atomic_fetch_add_u64 ( &( *shared ).awake , 1 , ATOMIC_SEQ_CST );
+    return 0;
+}
+
+/**
+ * @brief Thread: consumes units of a semaphore, then marks its work in a wait
+ * group as done.
+ */
+u32
+test_lock_semaphore_consumer
+(   void* args
+)
+{
+    shared_t* shared = args;
+    for ( u64 i = 0; i < TEST_LOCK_ITERATIONS / 10; ++i )
+    {
+        semaphore_acquire ( &( *shared ).semaphore );
+        atomic_fetch_add_u64 ( &( *shared ).a , 1 , ATOMIC_RELAXED );
+    }
+    waitgroup_done ( &( *shared ).waitgroup );
+    return 0;
+}
+
+/**
+ * @brief Runs each thread of a batch to completion.
+ */
+u8
+test_lock_run_threads
+(   thread_start_function_t*    functions
+,   u64                         count
+,   shared_t*                   shared
+)
+{
+    thread_t threads[ 2 * TEST_LOCK_THREAD_COUNT ];
+    for ( u64 i = 0; i < count; ++i )
+    {
+        EXPECT ( thread_create ( functions[ i ] , shared , false , &threads[ i ] ) );
+    }
+    for ( u64 i = 0; i < count; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+        thread_destroy ( &threads[ i ] );
+    }
+    return true;
+}
+
+u8
+test_lock_mutex_and_spinlock
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    thread_start_function_t functions[ TEST_LOCK_THREAD_COUNT ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A mutex cannot be acquired again until it is released.
+    EXPECT ( lock_try_acquire ( &shared.lock ) );
+    EXPECT_NOT ( lock_try_acquire ( &shared.lock ) );
+    lock_release ( &shared.lock );
+    lock_acquire ( &shared.lock );
+    EXPECT_NOT ( lock_try_acquire ( &shared.lock ) );
+    lock_release ( &shared.lock );
+    EXPECT ( lock_try_acquire ( &shared.lock ) );
+    lock_release ( &shared.lock );
+
+    // TEST 2: A spinlock cannot be acquired again until it is released.
+    EXPECT ( spinlock_try_acquire ( &shared.spinlock ) );
+    EXPECT_NOT ( spinlock_try_acquire ( &shared.spinlock ) );
+    spinlock_release ( &shared.spinlock );
+    spinlock_acquire ( &shared.spinlock );
+    EXPECT_NOT ( spinlock_try_acquire ( &shared.spinlock ) );
+    spinlock_release ( &shared.spinlock );
+
+    // TEST 3: A mutex provides mutual exclusion between threads.
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        functions[ i ] = test_lock_mutex_worker;
+    }
+    EXPECT ( test_lock_run_threads ( functions , TEST_LOCK_THREAD_COUNT , &shared ) );
+    EXPECT_EQ ( TEST_LOCK_THREAD_COUNT * TEST_LOCK_ITERATIONS , shared.a );
+
+    // TEST 4: A spinlock provides mutual exclusion between threads.
+    shared.a = 0;
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        functions[ i ] = test_lock_spinlock_worker;
+    }
+    EXPECT ( test_lock_run_threads ( functions , TEST_LOCK_THREAD_COUNT , &shared ) );
+    EXPECT_EQ ( TEST_LOCK_THREAD_COUNT * TEST_LOCK_ITERATIONS , shared.a );
+
+    // TEST 5: Both locks are released once every thread has finished.
+    EXPECT ( lock_try_acquire ( &shared.lock ) );
+    EXPECT ( spinlock_try_acquire ( &shared.spinlock ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_lock_rwlock
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    thread_start_function_t functions[ 2 * TEST_LOCK_THREAD_COUNT ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: Several readers may hold a reader-writer lock at once.
+    rwlock_acquire_read ( &shared.rwlock );
+    rwlock_acquire_read ( &shared.rwlock );
+    rwlock_release_read ( &shared.rwlock );
+    rwlock_release_read ( &shared.rwlock );
+
+    // TEST 2: A reader-writer lock can be write-locked once every reader is done.
+    rwlock_acquire_write ( &shared.rwlock );
+    rwlock_release_write ( &shared.rwlock );
+
+    // TEST 3: Readers never observe a writer's update half-done.
+    for ( u64 i = 0; i < 2 * TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        functions[ i ] = ( i % 2 ) ? test_lock_rwlock_writer
+                                   : test_lock_rwlock_reader
+                                   ;
+    }
+    EXPECT ( test_lock_run_threads ( functions , 2 * TEST_LOCK_THREAD_COUNT , &shared ) );
+    EXPECT_EQ ( 0 , shared.errors );
+    EXPECT_EQ ( TEST_LOCK_THREAD_COUNT * ( TEST_LOCK_ITERATIONS / 10 ) , shared.a );
+    EXPECT_EQ ( shared.a , shared.b );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_lock_condvar
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    thread_t threads[ TEST_LOCK_THREAD_COUNT ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: condvar_wait_timeout times out if the condition variable is never signalled.
+    lock_acquire ( &shared.lock );
+    EXPECT_NOT ( condvar_wait_timeout ( &shared.condvar , &shared.lock , 10 ) );
+    EXPECT_NOT ( lock_try_acquire ( &shared.lock ) );
+    lock_release ( &shared.lock );
+
+    // TEST 2: condvar_signal wakes a waiting thread (two threads take turns).
+    EXPECT ( thread_create ( test_lock_condvar_ping , &shared , false , &threads[ 0 ] ) );
+    lock_acquire ( &shared.lock );
+    for ( u64 i = 0; i < TEST_LOCK_ITERATIONS / 10; ++i )
+    {
+        while ( shared.turn % 2 == 1 )
+        {
+            condvar_wait ( &shared.condvar , &shared.lock );
+        }
+        shared.turn += 1;
+        condvar_signal ( &shared.condvar );
+    }
+    while ( shared.turn != 2 * ( TEST_LOCK_ITERATIONS / 10 ) )
+    {
+        condvar_wait ( &shared.condvar , &shared.lock );
+    }
+    lock_release ( &shared.lock );
+    EXPECT ( thread_wait ( &threads[ 0 ] ) );
+    thread_destroy ( &threads[ 0 ] );
+
+    // TEST 3: condvar_broadcast wakes every waiting thread.
+    shared.turn = 0;
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_lock_condvar_sleeper , &shared , false , &threads[ i ] ) );
+    }
+    for (;;)
+    {
+        lock_acquire ( &shared.lock );
+        const bool ready = shared.awake == TEST_LOCK_THREAD_COUNT;
+        if ( ready )
+        {
+            shared.turn = 1;
+            condvar_broadcast ( &shared.condvar );
+        }
+        lock_release ( &shared.lock );
+        if ( ready )
+        {
+            break;
+        }
+        thread_sleep ( 0 , 1 );
+    }
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+        thread_destroy ( &threads[ i ] );
+    }
+    EXPECT_EQ ( 0 , shared.awake );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_lock_event
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    shared.manual.manual_reset = true;
+    thread_t threads[ TEST_LOCK_THREAD_COUNT ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: An auto-reset event releases one wait per event_set.
+    EXPECT_NOT ( event_signalled ( &shared.event ) );
+    EXPECT_NOT ( event_wait_timeout ( &shared.event , 10 ) );
+    event_set ( &shared.event );
+    event_set ( &shared.event );
+    EXPECT ( event_signalled ( &shared.event ) );
+    EXPECT ( event_wait_timeout ( &shared.event , 0 ) );
+    EXPECT_NOT ( event_signalled ( &shared.event ) );
+    EXPECT_NOT ( event_wait_timeout ( &shared.event , 0 ) );
+
+    // TEST 2: A manual-reset event stays signalled until event_reset.
+    event_set ( &shared.manual );
+    EXPECT ( event_wait_timeout ( &shared.manual , 0 ) );
+    EXPECT ( event_wait_timeout ( &shared.manual , 0 ) );
+    EXPECT ( event_signalled ( &shared.manual ) );
+    event_reset ( &shared.manual );
+    EXPECT_NOT ( event_signalled ( &shared.manual ) );
+    EXPECT_NOT ( event_wait_timeout ( &shared.manual , 10 ) );
+
+    // TEST 3: Setting an auto-reset event wakes exactly one waiting thread.
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_lock_event_waiter , &shared , false , &threads[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        event_set ( &shared.event );
+        while ( atomic_load_u64 ( &shared.awake , ATOMIC_SEQ_CST ) != i + 1 )
+        {
+            atomic_pause ();
+        }
+    }
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+        thread_destroy ( &threads[ i ] );
+    }
+    EXPECT_NOT ( event_signalled ( &shared.event ) );
+
+    // TEST 4: Setting a manual-reset event wakes every waiting thread.
+    shared.awake = 0;
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_lock_manual_event_waiter , &shared , false , &threads[ i ] ) );
+    }
+    event_set ( &shared.manual );
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+        thread_destroy ( &threads[ i ] );
+    }
+    EXPECT_EQ ( TEST_LOCK_THREAD_COUNT , shared.awake );
+    EXPECT ( event_signalled ( &shared.manual ) );
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+u8
+test_lock_semaphore_and_waitgroup
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    thread_t threads[ TEST_LOCK_THREAD_COUNT ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: A semaphore can be acquired once per unit released.
+    EXPECT_NOT ( semaphore_try_acquire ( &shared.semaphore ) );
+    EXPECT_NOT ( semaphore_acquire_timeout ( &shared.semaphore , 10 ) );
+    semaphore_release ( &shared.semaphore , 2 );
+    EXPECT ( semaphore_try_acquire ( &shared.semaphore ) );
+    EXPECT ( semaphore_acquire_timeout ( &shared.semaphore , 10 ) );
+    EXPECT_NOT ( semaphore_try_acquire ( &shared.semaphore ) );
+
+    // TEST 2: A wait group with no outstanding work does not wait.
+    EXPECT ( waitgroup_wait_timeout ( &shared.waitgroup , 0 ) );
+    waitgroup_add ( &shared.waitgroup , 1 );
+    EXPECT_NOT ( waitgroup_wait_timeout ( &shared.waitgroup , 10 ) );
+    waitgroup_done ( &shared.waitgroup );
+    EXPECT ( waitgroup_wait_timeout ( &shared.waitgroup , 0 ) );
+
+    // TEST 3: Units released one at a time are each consumed exactly once, and the wait group waits for every consumer.
+    waitgroup_add ( &shared.waitgroup , TEST_LOCK_THREAD_COUNT );
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_create ( test_lock_semaphore_consumer , &shared , false , &threads[ i ] ) );
+    }
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT * ( TEST_LOCK_ITERATIONS / 10 ); ++i )
+    {
+        semaphore_release ( &shared.semaphore , 1 );
+    }
+    waitgroup_wait ( &shared.waitgroup );
+    EXPECT_EQ ( TEST_LOCK_THREAD_COUNT * ( TEST_LOCK_ITERATIONS / 10 ) , atomic_load_u64 ( &shared.a , ATOMIC_SEQ_CST ) );
+    EXPECT_NOT ( semaphore_try_acquire ( &shared.semaphore ) );
+    for ( u64 i = 0; i < TEST_LOCK_THREAD_COUNT; ++i )
+    {
+        EXPECT ( thread_wait ( &threads[ i ] ) );
+        thread_destroy ( &threads[ i ] );
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_lock
+( void )
+{
+    test_register_serial ( test_lock_mutex_and_spinlock , "Testing mutex and spinlock mutual exclusion." );
+    test_register_serial ( test_lock_rwlock , "Testing reader-writer lock shared and exclusive access." );
+    test_register_serial ( test_lock_condvar , "Testing condition variable wait, signal and broadcast." );
+    test_register_serial ( test_lock_event , "Testing auto-reset and manual-reset events." );
+    test_register_serial ( test_lock_semaphore_and_waitgroup , "Testing counting semaphores and wait groups." );
+}
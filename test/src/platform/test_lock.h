@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_lock.h
+ * @brief Tests platform/lock.h
+ * (see test/test.h, platform/lock.h for additional details)
+ */
+#ifndef TEST_LOCK_H
+#define TEST_LOCK_H
+
+#include "test/test.h"
+
+#include "platform/lock.h"
+
+void
+test_register_lock
+( void );
+
+#endif  // TEST_LOCK_H
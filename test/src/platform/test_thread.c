@@ -0,0 +1,128 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_thread.c
+ * @brief Implementation of the platform/test_thread header.
+ * (see platform/test_thread.h for additional details)
+ */
+#include "platform/test_thread.h"
+
+#include "test/expect.h"
+
+#include "core/memory.h"
+
+#include "platform/platform.h"
+
+/** @brief Stack size requested by the thread creation options test (in bytes). */
+#define TEST_THREAD_STACK_SIZE ( MiB ( 2 ) )
+
+/** @brief Type definition for state shared with a test thread. */
+typedef struct
+{
+    u64 id;
+    u64 done;
+}
+shared_t;
+
+/**
+ * @brief Thread: records its identifier, after using a large part of its
+ * stack.
+ */
+u32
+test_thread_worker
+(   void* args
+)
+{
+    shared_t* shared = args;
+    volatile u8 stack[ TEST_THREAD_STACK_SIZE / 2 ];
+    for ( u64 i = 0; i < sizeof ( stack ); i += KiB ( 4 ) )
+    {
+        stack[ i ] = ( u8 ) i;
+    }
+    ( *shared ).id = thread_id ();
+    atomic_fetch_add_u64 ( &( *shared ).done , 1 , ATOMIC_RELEASE );
+    return 0;
+}
+
+u8
+test_thread_create
+( void )
+{
+    u64 global_amount_allocated;
+    u64 global_allocation_count;
+
+    // Copy the current global allocator state prior to the test.
+    global_amount_allocated = memory_amount_allocated ( MEMORY_TAG_ALL );
+    global_allocation_count = MEMORY_ALLOCATION_COUNT;
+
+    shared_t shared = { 0 };
+    thread_t thread;
+    thread_options_t options;
+    memory_clear ( &options , sizeof ( thread_options_t ) );
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Start test.
+
+    // TEST 1: thread_create_ex handles invalid arguments.
+    LOGWARN ( "The following errors are intentionally triggered by a test:" );
+    EXPECT_NOT ( thread_create_ex ( 0 , &shared , &options , &thread ) );
+    EXPECT_NOT ( thread_create_ex ( test_thread_worker , &shared , 0 , &thread ) );
+    EXPECT_NOT ( thread_create_ex ( test_thread_worker , &shared , &options , 0 ) );
+    options.priority = THREAD_PRIORITY_COUNT;
+    EXPECT_NOT ( thread_create_ex ( test_thread_worker , &shared , &options , &thread ) );
+    options.priority = THREAD_PRIORITY_NORMAL;
+
+    // TEST 2: Creating, waiting for and destroying a thread does not allocate memory.
+    const u64 allocation_count = MEMORY_ALLOCATION_COUNT;
+    EXPECT ( thread_create ( test_thread_worker , &shared , false , &thread ) );
+    EXPECT ( thread.valid );
+    EXPECT ( thread_wait ( &thread ) );
+    thread_destroy ( &thread );
+    EXPECT_EQ ( allocation_count , MEMORY_ALLOCATION_COUNT );
+    EXPECT_EQ ( 1 , shared.done );
+    EXPECT_NEQ ( thread_id () , shared.id );
+
+    // TEST 3: A waited-for thread may no longer be waited for, detached or cancelled.
+    EXPECT_NOT ( thread.valid );
+    EXPECT_NOT ( thread_wait ( &thread ) );
+    EXPECT_NOT ( thread_active ( &thread ) );
+    thread_detach ( &thread );
+    thread_cancel ( &thread );
+
+    // TEST 4: thread_create_ex applies a stack size, name, affinity and priority.
+    options.stack_size = TEST_THREAD_STACK_SIZE;
+    options.name = "test_thread_create: worker";
+    const u64 core_count = platform_processor_core_count ();
+    options.affinity = ( core_count < 64 ) ? ( ( ( u64 ) 1 ) << core_count ) - 1
+                                           : ~( ( u64 ) 0 )
+                                           ;
+    options.priority = THREAD_PRIORITY_LOW;
+    EXPECT ( thread_create_ex ( test_thread_worker , &shared , &options , &thread ) );
+    EXPECT ( thread_wait ( &thread ) );
+    thread_destroy ( &thread );
+    EXPECT_EQ ( 2 , shared.done );
+
+    // TEST 5: An auto-detach thread runs to completion without a valid handle.
+    options.auto_detach = true;
+    EXPECT ( thread_create_ex ( test_thread_worker , &shared , &options , &thread ) );
+    EXPECT_NOT ( thread.valid );
+    while ( atomic_load_u64 ( &shared.done , ATOMIC_ACQUIRE ) < 3 )
+    {
+        atomic_pause ();
+    }
+
+    // End test.
+    ////////////////////////////////////////////////////////////////////////////
+
+    // Verify the test allocated and freed all of its memory properly.
+    EXPECT_EQ ( global_amount_allocated , memory_amount_allocated ( MEMORY_TAG_ALL ) );
+    EXPECT_EQ ( global_allocation_count , MEMORY_ALLOCATION_COUNT );
+
+    return true;
+}
+
+void
+test_register_thread
+( void )
+{
+    test_register_serial ( test_thread_create , "Creating a thread with or without creation options." );
+}
@@ -0,0 +1,18 @@
+/**
+ * @author Matthew Weissel (mweissel3@gatech.edu)
+ * @file platform/test_thread.h
+ * @brief Tests platform/thread.h
+ * (see test/test.h, platform/thread.h for additional details)
+ */
+#ifndef TEST_THREAD_H
+#define TEST_THREAD_H
+
+#include "test/test.h"
+
+#include "platform/thread.h"
+
+void
+test_register_thread
+( void );
+
+#endif  // TEST_THREAD_H